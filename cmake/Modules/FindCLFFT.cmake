@@ -0,0 +1,72 @@
+# GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+# This file is part of GNSS-SDR.
+#
+# SPDX-FileCopyrightText: 2011-2020 C. Fernandez-Prades cfernandez(at)cttc.es
+# SPDX-License-Identifier: BSD-3-Clause
+
+#
+# - Try to find clFFT, the OpenCL FFT library (https://github.com/clMathLibraries/clFFT)
+#
+# Once done this will define
+# CLFFT_FOUND - system has clFFT
+# CLFFT_INCLUDE_DIRS - the clFFT include directory
+# CLFFT_LIBRARIES - link these to use clFFT
+
+if(NOT COMMAND feature_summary)
+    include(FeatureSummary)
+endif()
+
+include(FindPackageHandleStandardArgs)
+
+find_path(CLFFT_INCLUDE_DIR
+    NAMES
+        clFFT.h
+    PATHS
+        /usr/include
+        /usr/local/include
+        /opt/local/include
+        ${CLFFT_ROOT}/include
+        $ENV{CLFFT_ROOT}/include
+    PATH_SUFFIXES
+        clFFT
+)
+
+find_library(CLFFT_LIBRARY
+    NAMES
+        clFFT
+    PATHS
+        /usr/lib
+        /usr/lib64
+        /usr/local/lib
+        /usr/local/lib64
+        /opt/local/lib
+        ${CLFFT_ROOT}/lib
+        $ENV{CLFFT_ROOT}/lib
+        /usr/lib/x86_64-linux-gnu
+        /usr/lib/aarch64-linux-gnu
+        /usr/lib/arm-linux-gnueabihf
+        /usr/lib/arm-linux-gnueabi
+)
+
+set(CLFFT_INCLUDE_DIRS ${CLFFT_INCLUDE_DIR})
+set(CLFFT_LIBRARIES ${CLFFT_LIBRARY})
+
+find_package_handle_standard_args(CLFFT DEFAULT_MSG CLFFT_LIBRARIES CLFFT_INCLUDE_DIRS)
+
+mark_as_advanced(
+    CLFFT_INCLUDE_DIRS
+    CLFFT_LIBRARIES
+)
+
+set_package_properties(CLFFT PROPERTIES
+    URL "https://github.com/clMathLibraries/clFFT"
+    DESCRIPTION "Library containing FFT functions written in OpenCL"
+)
+
+if(CLFFT_FOUND AND NOT TARGET clFFT::clFFT)
+    add_library(clFFT::clFFT UNKNOWN IMPORTED)
+    set_target_properties(clFFT::clFFT PROPERTIES
+        IMPORTED_LOCATION "${CLFFT_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${CLFFT_INCLUDE_DIRS}"
+    )
+endif()
@@ -24,6 +24,10 @@
 #include "gps_almanac.h"              // for Gps_Almanac
 #include "gps_ephemeris.h"            // for Gps_Ephemeris
 #include "pvt_conf.h"                 // for Pvt_Conf
+#include "rtklib_ephemeris.h"         // for set_eph_cache
+#include "rtklib_parallel.h"          // for rtklib_set_pvt_threads
+#include "rtklib_pntpos.h"            // for set_incremental_lsq
+#include "rtklib_ppp.h"               // for set_ppp_seq_filter
 #include "rtklib_rtkpos.h"            // for rtkfree, rtkinit
 #include <glog/logging.h>             // for LOG
 #include <iostream>                   // for operator<<
@@ -91,6 +95,45 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     pvt_output_parameters.flag_rtcm_server = configuration->property(role + ".flag_rtcm_server", false);
     pvt_output_parameters.rtcm_tcp_port = configuration->property(role + ".rtcm_tcp_port", 2101);
     pvt_output_parameters.rtcm_station_id = configuration->property(role + ".rtcm_station_id", 1234);
+
+    // RTCM base station input (rover mode): TCP client that feeds the
+    // reference-station observables to the differential positioning modes
+    pvt_output_parameters.rtcm_base_enabled = configuration->property(role + ".enable_rtcm_base", false);
+    pvt_output_parameters.rtcm_base_address = configuration->property(role + ".rtcm_base_address", std::string("127.0.0.1"));
+    pvt_output_parameters.rtcm_base_port = configuration->property(role + ".rtcm_base_port", 2101);
+    pvt_output_parameters.rtcm_base_max_age_s = configuration->property(role + ".rtcm_base_max_age_s", 30.0);
+
+    // Shared-memory position topic, updated in place on every solution
+    pvt_output_parameters.enable_shm_topic = configuration->property(role + ".enable_shm_topic", false);
+    pvt_output_parameters.shm_topic_name = configuration->property(role + ".shm_topic_name", std::string("/gnss_sdr_pvt"));
+
+    // Dual-antenna attitude solver. Channels are assigned to an antenna with
+    // ChannelN.antenna (default 0); the second antenna group is antenna 1
+    pvt_output_parameters.enable_attitude = configuration->property(role + ".enable_attitude", false);
+    pvt_output_parameters.attitude_baseline_m = configuration->property(role + ".attitude_baseline_m", 0.0);
+    if (pvt_output_parameters.enable_attitude)
+        {
+            pvt_output_parameters.antenna_of_channel.reserve(in_streams_);
+            for (unsigned int ch = 0; ch < in_streams_; ch++)
+                {
+                    pvt_output_parameters.antenna_of_channel.push_back(
+                        configuration->property("Channel" + std::to_string(ch) + ".antenna", 0));
+                }
+        }
+
+    // Doppler-aided dead reckoning: keep producing solutions for up to
+    // max_dead_reckoning_s when fewer than four satellites remain usable
+    pvt_output_parameters.enable_dead_reckoning = configuration->property(role + ".enable_dead_reckoning", false);
+    pvt_output_parameters.max_dead_reckoning_s = configuration->property(role + ".max_dead_reckoning_s", 5.0);
+
+    // End-to-end latency budget monitor: per-stage histograms over UDP,
+    // built from the wall-clock stamps carried by each observables epoch
+    pvt_output_parameters.enable_latency_monitor = configuration->property(role + ".enable_latency_monitor", false);
+    pvt_output_parameters.latency_address = configuration->property(role + ".latency_address", std::string("127.0.0.1"));
+    pvt_output_parameters.latency_port = configuration->property(role + ".latency_port", 1266);
+    pvt_output_parameters.latency_budget_ms = configuration->property(role + ".latency_budget_ms", 100.0);
+    pvt_output_parameters.latency_report_interval_epochs = configuration->property(role + ".latency_report_interval_epochs", 100);
+
     // RTCM message rates: least common multiple with output_rate_ms
     const int rtcm_MT1019_rate_ms = bc::lcm(configuration->property(role + ".rtcm_MT1019_rate_ms", 5000), pvt_output_parameters.output_rate_ms);
     const int rtcm_MT1020_rate_ms = bc::lcm(configuration->property(role + ".rtcm_MT1020_rate_ms", 5000), pvt_output_parameters.output_rate_ms);
@@ -773,6 +816,22 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
 
     rtkinit(&rtk, &rtklib_configuration_options);
 
+    // Number of threads for the per-satellite model evaluation inside RTKLIB
+    // (1: serial, the default)
+    rtklib_set_pvt_threads(configuration->property(role + ".threads", 1));
+
+    // Reuse the least-squares normal matrix between epochs while the satellite
+    // set is unchanged (useful at high solution rates, off by default)
+    set_incremental_lsq(configuration->property(role + ".incremental_lsq", false) ? 1 : 0);
+
+    // Memoize broadcast ephemeris evaluations on whole-second nodes and
+    // interpolate in between (off by default)
+    set_eph_cache(configuration->property(role + ".eph_cache", false) ? 1 : 0);
+
+    // Sequential (scalar-at-a-time) Kalman measurement update in the PPP
+    // engine, exact for its diagonal measurement noise (off by default)
+    set_ppp_seq_filter(configuration->property(role + ".ppp_seq_filter", false) ? 1 : 0);
+
     // Outputs
     const bool default_output_enabled = configuration->property(role + ".output_enabled", true);
     pvt_output_parameters.output_enabled = default_output_enabled;
@@ -796,8 +855,16 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
 
     // Read PVT MONITOR Configuration
     pvt_output_parameters.monitor_enabled = configuration->property(role + ".enable_monitor", false);
+    pvt_output_parameters.enable_work_monitor = configuration->property("WorkMonitor.enable_monitor", pvt_output_parameters.enable_work_monitor);
+    pvt_output_parameters.work_monitor_addresses = configuration->property("WorkMonitor.client_addresses", pvt_output_parameters.work_monitor_addresses);
+    pvt_output_parameters.work_monitor_port = configuration->property("WorkMonitor.udp_port", pvt_output_parameters.work_monitor_port);
+    pvt_output_parameters.work_monitor_interval_calls = configuration->property("WorkMonitor.report_interval_calls", pvt_output_parameters.work_monitor_interval_calls);
     pvt_output_parameters.udp_addresses = configuration->property(role + ".monitor_client_addresses", std::string("127.0.0.1"));
     pvt_output_parameters.udp_port = configuration->property(role + ".monitor_udp_port", 1234);
+
+    // Clock steering output
+    pvt_output_parameters.enable_clock_steering_output = configuration->property(role + ".enable_clock_steering_output", pvt_output_parameters.enable_clock_steering_output);
+    pvt_output_parameters.clock_steering_socket = configuration->property(role + ".clock_steering_socket", pvt_output_parameters.clock_steering_socket);
     pvt_output_parameters.protobuf_enabled = configuration->property(role + ".enable_protobuf", true);
     if (configuration->property("Monitor.enable_protobuf", false) == true)
         {
@@ -813,6 +880,13 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     // Set maximum clock offset allowed if pvt_output_parameters.enable_rx_clock_correction = false
     pvt_output_parameters.max_obs_block_rx_clock_offset_ms = configuration->property(role + ".max_clock_offset_ms", pvt_output_parameters.max_obs_block_rx_clock_offset_ms);
 
+    // Run the output printers on a dedicated writer thread, off the signal processing thread
+    pvt_output_parameters.enable_asynchronous_output = configuration->property(role + ".enable_asynchronous_output", false);
+
+    // Key of the System V message queue where the time-to-first-fix is reported.
+    // Overriding the default allows several receiver instances to run on the same machine
+    pvt_output_parameters.sysv_msg_key = configuration->property(role + ".sysv_msg_key", pvt_output_parameters.sysv_msg_key);
+
     // make PVT object
     pvt_ = rtklib_make_pvt_gs(in_streams_, pvt_output_parameters, rtk);
     DLOG(INFO) << "pvt(" << pvt_->unique_id() << ")";
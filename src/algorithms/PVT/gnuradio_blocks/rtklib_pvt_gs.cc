@@ -20,9 +20,11 @@
 #include "beidou_dnav_ephemeris.h"
 #include "beidou_dnav_iono.h"
 #include "beidou_dnav_utc_model.h"
+#include "clock_steering_sink.h"
 #include "display.h"
 #include "galileo_almanac.h"
 #include "galileo_almanac_helper.h"
+#include "galileo_has_data.h"
 #include "galileo_ephemeris.h"
 #include "galileo_iono.h"
 #include "galileo_utc_model.h"
@@ -42,13 +44,20 @@
 #include "gps_utc_model.h"
 #include "gpx_printer.h"
 #include "kml_printer.h"
+#include "attitude_solver.h"
+#include "latency_monitor.h"
 #include "monitor_pvt.h"
+#include "monitor_pvt_shm_sink.h"
 #include "monitor_pvt_udp_sink.h"
 #include "nmea_printer.h"
 #include "pvt_conf.h"
+#include "pvt_geometry_strings.h"
+#include "pvt_writer_queue.h"
 #include "rinex_printer.h"
+#include "rtcm_base_client.h"
 #include "rtcm_printer.h"
 #include "rtklib_solver.h"
+#include "trace_writer.h"
 #include <boost/any.hpp>                   // for any_cast, any
 #include <boost/archive/xml_iarchive.hpp>  // for xml_iarchive
 #include <boost/archive/xml_oarchive.hpp>  // for xml_oarchive
@@ -144,6 +153,15 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
 
     d_max_obs_block_rx_clock_offset_ms = conf_.max_obs_block_rx_clock_offset_ms;
 
+    d_work_monitor.set_identity("pvt", 0);
+    if (conf_.enable_work_monitor)
+        {
+            d_work_monitor.configure("pvt", 0,
+                conf_.work_monitor_addresses,
+                conf_.work_monitor_port,
+                conf_.work_monitor_interval_calls);
+        }
+
     d_output_rate_ms = conf_.output_rate_ms;
     d_display_rate_ms = conf_.display_rate_ms;
     d_report_rate_ms = 1000;  // report every second PVT to gnss_synchro
@@ -412,9 +430,52 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
             d_udp_sink_ptr = nullptr;
         }
 
+    // PVT SHARED-MEMORY TOPIC
+    if (conf_.enable_shm_topic)
+        {
+            d_shm_sink_ptr = std::make_unique<Monitor_Pvt_Shm_Sink>(conf_.shm_topic_name);
+        }
+    else
+        {
+            d_shm_sink_ptr = nullptr;
+        }
+
+    // DUAL-ANTENNA ATTITUDE SOLVER
+    if (conf_.enable_attitude)
+        {
+            d_attitude_solver = std::make_unique<Attitude_Solver>(conf_.antenna_of_channel, conf_.attitude_baseline_m);
+            LOG(INFO) << "Dual-antenna attitude solver enabled"
+                      << (conf_.attitude_baseline_m > 0.0 ? ", baseline length " + std::to_string(conf_.attitude_baseline_m) + " m" : "");
+        }
+    else
+        {
+            d_attitude_solver = nullptr;
+        }
+
+    // END-TO-END LATENCY BUDGET MONITOR
+    if (conf_.enable_latency_monitor)
+        {
+            d_latency_monitor = std::make_unique<Latency_Monitor>();
+            d_latency_monitor->init(conf_.latency_address, conf_.latency_port, conf_.latency_budget_ms, conf_.latency_report_interval_epochs);
+        }
+    else
+        {
+            d_latency_monitor = nullptr;
+        }
+
+    // CLOCK STEERING OUTPUT
+    if (conf_.enable_clock_steering_output)
+        {
+            d_clock_steering_sink = std::make_unique<Clock_Steering_Sink>(conf_.clock_steering_socket);
+        }
+    else
+        {
+            d_clock_steering_sink = nullptr;
+        }
+
     // Create Sys V message queue
     d_first_fix = true;
-    d_sysv_msg_key = 1101;
+    d_sysv_msg_key = conf_.sysv_msg_key;
     const int msgflg = IPC_CREAT | 0666;
     if ((d_sysv_msqid = msgget(d_sysv_msg_key, msgflg)) == -1)
         {
@@ -462,6 +523,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
     d_waiting_obs_block_rx_clock_offset_correction_msg = false;
 
     d_enable_rx_clock_correction = conf_.enable_rx_clock_correction;
+    d_asynchronous_output_enabled = conf_.enable_asynchronous_output;
 
     if (d_enable_rx_clock_correction == true)
         {
@@ -478,6 +540,18 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
             d_internal_pvt_solver->set_averaging_depth(1);
             d_internal_pvt_solver->set_pre_2009_file(conf_.pre_2009_file);
         }
+    else if (d_asynchronous_output_enabled)
+        {
+            // the writer thread needs exclusive ownership of the user solver,
+            // so keep a separate instance for the rx clock sanity check in work()
+            d_user_pvt_solver = std::make_shared<Rtklib_Solver>(rtk, static_cast<int32_t>(nchannels), dump_ls_pvt_filename, d_dump, d_dump_mat);
+            d_user_pvt_solver->set_averaging_depth(1);
+            d_user_pvt_solver->set_pre_2009_file(conf_.pre_2009_file);
+
+            d_internal_pvt_solver = std::make_shared<Rtklib_Solver>(rtk, static_cast<int32_t>(nchannels), dump_ls_pvt_filename, false, false);
+            d_internal_pvt_solver->set_averaging_depth(1);
+            d_internal_pvt_solver->set_pre_2009_file(conf_.pre_2009_file);
+        }
     else
         {
             // only one solver, customized by the user options
@@ -487,6 +561,29 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
             d_user_pvt_solver = d_internal_pvt_solver;
         }
 
+    // RTCM base station input: feed reference-station observables to the
+    // user solver when a differential positioning mode is configured
+    if (conf_.rtcm_base_enabled)
+        {
+            d_user_pvt_solver->set_base_obs_max_age(conf_.rtcm_base_max_age_s);
+            d_rtcm_base_client = std::make_unique<Rtcm_Base_Client>(conf_.rtcm_base_address, conf_.rtcm_base_port, d_user_pvt_solver);
+        }
+    else
+        {
+            d_rtcm_base_client = nullptr;
+        }
+
+    if (conf_.enable_dead_reckoning)
+        {
+            d_user_pvt_solver->enable_dead_reckoning(conf_.max_dead_reckoning_s);
+            LOG(INFO) << "PVT dead reckoning enabled, max age " << conf_.max_dead_reckoning_s << " s";
+        }
+
+    if (d_asynchronous_output_enabled)
+        {
+            d_writer_queue = std::make_unique<Pvt_Writer_Queue>();
+        }
+
     d_gps_ephemeris_sptr_type_hash_code = typeid(std::shared_ptr<Gps_Ephemeris>).hash_code();
     d_gps_iono_sptr_type_hash_code = typeid(std::shared_ptr<Gps_Iono>).hash_code();
     d_gps_utc_model_sptr_type_hash_code = typeid(std::shared_ptr<Gps_Utc_Model>).hash_code();
@@ -499,6 +596,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
     d_galileo_utc_model_sptr_type_hash_code = typeid(std::shared_ptr<Galileo_Utc_Model>).hash_code();
     d_galileo_almanac_helper_sptr_type_hash_code = typeid(std::shared_ptr<Galileo_Almanac_Helper>).hash_code();
     d_galileo_almanac_sptr_type_hash_code = typeid(std::shared_ptr<Galileo_Almanac>).hash_code();
+    d_galileo_has_data_sptr_type_hash_code = typeid(std::shared_ptr<Galileo_HAS_data>).hash_code();
     d_glonass_gnav_ephemeris_sptr_type_hash_code = typeid(std::shared_ptr<Glonass_Gnav_Ephemeris>).hash_code();
     d_glonass_gnav_utc_model_sptr_type_hash_code = typeid(std::shared_ptr<Glonass_Gnav_Utc_Model>).hash_code();
     d_glonass_gnav_almanac_sptr_type_hash_code = typeid(std::shared_ptr<Glonass_Gnav_Almanac>).hash_code();
@@ -514,6 +612,9 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
 rtklib_pvt_gs::~rtklib_pvt_gs()
 {
     DLOG(INFO) << "PVT block destructor called.";
+    // flush pending output epochs and stop the writer thread before the
+    // printers and solvers are destroyed
+    d_writer_queue.reset();
     if (d_sysv_msqid != -1)
         {
             msgctl(d_sysv_msqid, IPC_RMID, nullptr);
@@ -1064,6 +1165,9 @@ rtklib_pvt_gs::~rtklib_pvt_gs()
 
 void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
 {
+    // the writer thread reads the user solver and the printers concurrently
+    // with this handler when asynchronous output is enabled
+    const std::lock_guard<std::mutex> lock(d_user_pvt_solver_mutex);
     try
         {
             const size_t msg_type_hash_code = pmt::any_ref(msg).type().hash_code();
@@ -1101,20 +1205,12 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                 }
                         }
                     d_internal_pvt_solver->gps_ephemeris_map[gps_eph->i_satellite_PRN] = *gps_eph;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->gps_ephemeris_map[gps_eph->i_satellite_PRN] = *gps_eph;
-                        }
                 }
             else if (msg_type_hash_code == d_gps_iono_sptr_type_hash_code)
                 {
                     // ### GPS IONO ###
                     const auto gps_iono = boost::any_cast<std::shared_ptr<Gps_Iono>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->gps_iono = *gps_iono;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->gps_iono = *gps_iono;
-                        }
                     DLOG(INFO) << "New IONO record has arrived ";
                 }
             else if (msg_type_hash_code == d_gps_utc_model_sptr_type_hash_code)
@@ -1122,10 +1218,6 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### GPS UTC MODEL ###
                     const auto gps_utc_model = boost::any_cast<std::shared_ptr<Gps_Utc_Model>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->gps_utc_model = *gps_utc_model;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->gps_utc_model = *gps_utc_model;
-                        }
                     DLOG(INFO) << "New UTC record has arrived ";
                 }
             else if (msg_type_hash_code == d_gps_cnav_ephemeris_sptr_type_hash_code)
@@ -1156,10 +1248,6 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                 }
                         }
                     d_internal_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->i_satellite_PRN] = *gps_cnav_ephemeris;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->i_satellite_PRN] = *gps_cnav_ephemeris;
-                        }
                     DLOG(INFO) << "New GPS CNAV ephemeris record has arrived ";
                 }
             else if (msg_type_hash_code == d_gps_cnav_iono_sptr_type_hash_code)
@@ -1167,10 +1255,6 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### GPS CNAV IONO ###
                     const auto gps_cnav_iono = boost::any_cast<std::shared_ptr<Gps_CNAV_Iono>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->gps_cnav_iono = *gps_cnav_iono;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->gps_cnav_iono = *gps_cnav_iono;
-                        }
                     DLOG(INFO) << "New CNAV IONO record has arrived ";
                 }
             else if (msg_type_hash_code == d_gps_cnav_utc_model_sptr_type_hash_code)
@@ -1178,9 +1262,6 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### GPS CNAV UTC MODEL ###
                     const auto gps_cnav_utc_model = boost::any_cast<std::shared_ptr<Gps_CNAV_Utc_Model>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->gps_cnav_utc_model = *gps_cnav_utc_model;
-                    {
-                        d_user_pvt_solver->gps_cnav_utc_model = *gps_cnav_utc_model;
-                    }
                     DLOG(INFO) << "New CNAV UTC record has arrived ";
                 }
 
@@ -1189,10 +1270,6 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### GPS ALMANAC ###
                     const auto gps_almanac = boost::any_cast<std::shared_ptr<Gps_Almanac>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->gps_almanac_map[gps_almanac->i_satellite_PRN] = *gps_almanac;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->gps_almanac_map[gps_almanac->i_satellite_PRN] = *gps_almanac;
-                        }
                     DLOG(INFO) << "New GPS almanac record has arrived ";
                 }
 
@@ -1229,20 +1306,12 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                 }
                         }
                     d_internal_pvt_solver->galileo_ephemeris_map[galileo_eph->i_satellite_PRN] = *galileo_eph;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->galileo_ephemeris_map[galileo_eph->i_satellite_PRN] = *galileo_eph;
-                        }
                 }
             else if (msg_type_hash_code == d_galileo_iono_sptr_type_hash_code)
                 {
                     // ### Galileo IONO ###
                     const auto galileo_iono = boost::any_cast<std::shared_ptr<Galileo_Iono>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->galileo_iono = *galileo_iono;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->galileo_iono = *galileo_iono;
-                        }
                     DLOG(INFO) << "New IONO record has arrived ";
                 }
             else if (msg_type_hash_code == d_galileo_utc_model_sptr_type_hash_code)
@@ -1250,10 +1319,6 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### Galileo UTC MODEL ###
                     const auto galileo_utc_model = boost::any_cast<std::shared_ptr<Galileo_Utc_Model>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->galileo_utc_model = *galileo_utc_model;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->galileo_utc_model = *galileo_utc_model;
-                        }
                     DLOG(INFO) << "New UTC record has arrived ";
                 }
             else if (msg_type_hash_code == d_galileo_almanac_helper_sptr_type_hash_code)
@@ -1267,26 +1332,14 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     if (sv1.i_satellite_PRN != 0)
                         {
                             d_internal_pvt_solver->galileo_almanac_map[sv1.i_satellite_PRN] = sv1;
-                            if (d_enable_rx_clock_correction == true)
-                                {
-                                    d_user_pvt_solver->galileo_almanac_map[sv1.i_satellite_PRN] = sv1;
-                                }
                         }
                     if (sv2.i_satellite_PRN != 0)
                         {
                             d_internal_pvt_solver->galileo_almanac_map[sv2.i_satellite_PRN] = sv2;
-                            if (d_enable_rx_clock_correction == true)
-                                {
-                                    d_user_pvt_solver->galileo_almanac_map[sv2.i_satellite_PRN] = sv2;
-                                }
                         }
                     if (sv3.i_satellite_PRN != 0)
                         {
                             d_internal_pvt_solver->galileo_almanac_map[sv3.i_satellite_PRN] = sv3;
-                            if (d_enable_rx_clock_correction == true)
-                                {
-                                    d_user_pvt_solver->galileo_almanac_map[sv3.i_satellite_PRN] = sv3;
-                                }
                         }
                     DLOG(INFO) << "New Galileo Almanac data have arrived ";
                 }
@@ -1296,10 +1349,18 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     const auto galileo_alm = boost::any_cast<std::shared_ptr<Galileo_Almanac>>(pmt::any_ref(msg));
                     // update/insert new almanac record to the global almanac map
                     d_internal_pvt_solver->galileo_almanac_map[galileo_alm->i_satellite_PRN] = *galileo_alm;
-                    if (d_enable_rx_clock_correction == true)
+                }
+            else if (msg_type_hash_code == d_galileo_has_data_sptr_type_hash_code)
+                {
+                    // ### Galileo HAS corrections ###
+                    const auto has_data = boost::any_cast<std::shared_ptr<Galileo_HAS_data>>(pmt::any_ref(msg));
+                    d_internal_pvt_solver->update_has_corrections(*has_data);
+                    if (d_internal_pvt_solver != d_user_pvt_solver)
                         {
-                            d_user_pvt_solver->galileo_almanac_map[galileo_alm->i_satellite_PRN] = *galileo_alm;
+                            const std::lock_guard<std::mutex> lock(d_user_pvt_solver_mutex);
+                            d_user_pvt_solver->update_has_corrections(*has_data);
                         }
+                    DLOG(INFO) << "New Galileo HAS correction set has arrived ";
                 }
 
             // **************** GLONASS GNAV Telemetry *************************
@@ -1337,20 +1398,12 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                 }
                         }
                     d_internal_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->i_satellite_PRN] = *glonass_gnav_eph;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->i_satellite_PRN] = *glonass_gnav_eph;
-                        }
                 }
             else if (msg_type_hash_code == d_glonass_gnav_utc_model_sptr_type_hash_code)
                 {
                     // ### GLONASS GNAV UTC MODEL ###
                     const auto glonass_gnav_utc_model = boost::any_cast<std::shared_ptr<Glonass_Gnav_Utc_Model>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->glonass_gnav_utc_model = *glonass_gnav_utc_model;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->glonass_gnav_utc_model = *glonass_gnav_utc_model;
-                        }
                     DLOG(INFO) << "New GLONASS GNAV UTC record has arrived ";
                 }
             else if (msg_type_hash_code == d_glonass_gnav_almanac_sptr_type_hash_code)
@@ -1358,10 +1411,6 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### GLONASS GNAV Almanac ###
                     const auto glonass_gnav_almanac = boost::any_cast<std::shared_ptr<Glonass_Gnav_Almanac>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->glonass_gnav_almanac = *glonass_gnav_almanac;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->glonass_gnav_almanac = *glonass_gnav_almanac;
-                        }
                     DLOG(INFO) << "New GLONASS GNAV Almanac has arrived "
                                << ", GLONASS GNAV Slot Number =" << glonass_gnav_almanac->d_n_A;
                 }
@@ -1400,20 +1449,12 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                 }
                         }
                     d_internal_pvt_solver->beidou_dnav_ephemeris_map[bds_dnav_eph->i_satellite_PRN] = *bds_dnav_eph;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->beidou_dnav_ephemeris_map[bds_dnav_eph->i_satellite_PRN] = *bds_dnav_eph;
-                        }
                 }
             else if (msg_type_hash_code == d_beidou_dnav_iono_sptr_type_hash_code)
                 {
                     // ### BeiDou IONO ###
                     const auto bds_dnav_iono = boost::any_cast<std::shared_ptr<Beidou_Dnav_Iono>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->beidou_dnav_iono = *bds_dnav_iono;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->beidou_dnav_iono = *bds_dnav_iono;
-                        }
                     DLOG(INFO) << "New BeiDou DNAV IONO record has arrived ";
                 }
             else if (msg_type_hash_code == d_beidou_dnav_utc_model_sptr_type_hash_code)
@@ -1421,10 +1462,6 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### BeiDou UTC MODEL ###
                     const auto bds_dnav_utc_model = boost::any_cast<std::shared_ptr<Beidou_Dnav_Utc_Model>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->beidou_dnav_utc_model = *bds_dnav_utc_model;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->beidou_dnav_utc_model = *bds_dnav_utc_model;
-                        }
                     DLOG(INFO) << "New BeiDou DNAV UTC record has arrived ";
                 }
             else if (msg_type_hash_code == d_beidou_dnav_almanac_sptr_type_hash_code)
@@ -1432,10 +1469,6 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### BeiDou ALMANAC ###
                     const auto bds_dnav_almanac = boost::any_cast<std::shared_ptr<Beidou_Dnav_Almanac>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->beidou_dnav_almanac_map[bds_dnav_almanac->i_satellite_PRN] = *bds_dnav_almanac;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->beidou_dnav_almanac_map[bds_dnav_almanac->i_satellite_PRN] = *bds_dnav_almanac;
-                        }
                     DLOG(INFO) << "New BeiDou DNAV almanac record has arrived ";
                 }
             else
@@ -1447,6 +1480,23 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
         {
             LOG(WARNING) << "msg_handler_telemetry Bad any_cast: " << e.what();
         }
+    if (d_user_pvt_solver != d_internal_pvt_solver)
+        {
+            // hand the new records to the user solver as an immutable
+            // snapshot instead of writing into it directly. This covers
+            // both the clock-correction and the asynchronous-output modes;
+            // with a single shared solver there is nothing to hand over
+            publish_ephemeris_snapshot();
+        }
+}
+
+
+void rtklib_pvt_gs::publish_ephemeris_snapshot()
+{
+    d_ephemeris_snapshot_version++;
+    std::shared_ptr<const Pvt_Ephemeris_Snapshot> snapshot =
+        d_internal_pvt_solver->export_ephemeris_snapshot(d_ephemeris_snapshot_version);
+    std::atomic_store(&d_ephemeris_snapshot, std::move(snapshot));
 }
 
 
@@ -1488,13 +1538,14 @@ std::map<int, Beidou_Dnav_Almanac> rtklib_pvt_gs::get_beidou_dnav_almanac_map()
 
 void rtklib_pvt_gs::clear_ephemeris()
 {
+    const std::lock_guard<std::mutex> lock(d_user_pvt_solver_mutex);
     d_internal_pvt_solver->gps_ephemeris_map.clear();
     d_internal_pvt_solver->gps_almanac_map.clear();
     d_internal_pvt_solver->galileo_ephemeris_map.clear();
     d_internal_pvt_solver->galileo_almanac_map.clear();
     d_internal_pvt_solver->beidou_dnav_ephemeris_map.clear();
     d_internal_pvt_solver->beidou_dnav_almanac_map.clear();
-    if (d_enable_rx_clock_correction == true)
+    if (d_user_pvt_solver != d_internal_pvt_solver)
         {
             d_user_pvt_solver->gps_ephemeris_map.clear();
             d_user_pvt_solver->gps_almanac_map.clear();
@@ -1502,6 +1553,7 @@ void rtklib_pvt_gs::clear_ephemeris()
             d_user_pvt_solver->galileo_almanac_map.clear();
             d_user_pvt_solver->beidou_dnav_ephemeris_map.clear();
             d_user_pvt_solver->beidou_dnav_almanac_map.clear();
+            publish_ephemeris_snapshot();
         }
 }
 
@@ -1594,33 +1646,20 @@ bool rtklib_pvt_gs::get_latest_PVT(double* longitude_deg,
     double* course_over_ground_deg,
     time_t* UTC_time) const
 {
-    if (d_enable_rx_clock_correction == true)
+    const std::lock_guard<std::mutex> lock(d_user_pvt_solver_mutex);
+    // the user solver always holds the user-facing solution: it is a
+    // separate instance in the clock-correction and asynchronous-output
+    // modes and an alias of the internal solver otherwise
+    if (d_user_pvt_solver->is_valid_position())
         {
-            if (d_user_pvt_solver->is_valid_position())
-                {
-                    *latitude_deg = d_user_pvt_solver->get_latitude();
-                    *longitude_deg = d_user_pvt_solver->get_longitude();
-                    *height_m = d_user_pvt_solver->get_height();
-                    *ground_speed_kmh = d_user_pvt_solver->get_speed_over_ground() * 3600.0 / 1000.0;
-                    *course_over_ground_deg = d_user_pvt_solver->get_course_over_ground();
-                    *UTC_time = convert_to_time_t(d_user_pvt_solver->get_position_UTC_time());
+            *latitude_deg = d_user_pvt_solver->get_latitude();
+            *longitude_deg = d_user_pvt_solver->get_longitude();
+            *height_m = d_user_pvt_solver->get_height();
+            *ground_speed_kmh = d_user_pvt_solver->get_speed_over_ground() * 3600.0 / 1000.0;
+            *course_over_ground_deg = d_user_pvt_solver->get_course_over_ground();
+            *UTC_time = convert_to_time_t(d_user_pvt_solver->get_position_UTC_time());
 
-                    return true;
-                }
-        }
-    else
-        {
-            if (d_internal_pvt_solver->is_valid_position())
-                {
-                    *latitude_deg = d_internal_pvt_solver->get_latitude();
-                    *longitude_deg = d_internal_pvt_solver->get_longitude();
-                    *height_m = d_internal_pvt_solver->get_height();
-                    *ground_speed_kmh = d_internal_pvt_solver->get_speed_over_ground() * 3600.0 / 1000.0;
-                    *course_over_ground_deg = d_internal_pvt_solver->get_course_over_ground();
-                    *UTC_time = convert_to_time_t(d_internal_pvt_solver->get_position_UTC_time());
-
-                    return true;
-                }
+            return true;
         }
 
     return false;
@@ -1793,17 +1832,14 @@ void rtklib_pvt_gs::initialize_and_apply_carrier_phase_offset()
 int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_items,
     gr_vector_void_star& output_items __attribute__((unused)))
 {
+    Work_Monitor_Scope work_timer(d_work_monitor, static_cast<uint32_t>(noutput_items));
     for (int32_t epoch = 0; epoch < noutput_items; epoch++)
         {
-            bool flag_display_pvt = false;
             bool flag_compute_pvt_output = false;
-            bool flag_write_RTCM_1019_output = false;
-            bool flag_write_RTCM_1020_output = false;
-            bool flag_write_RTCM_1045_output = false;
-            bool flag_write_RTCM_MSM_output = false;
-            bool flag_write_RINEX_obs_output = false;
 
-            d_gnss_observables_map.clear();
+            // d_gnss_observables_map persists across epochs: entries are updated in
+            // place and only channels that appear or disappear touch the allocator,
+            // so the steady-state epoch ingestion makes no heap allocations
             const auto** in = reinterpret_cast<const Gnss_Synchro**>(&input_items[0]);  // Get the input buffer pointer
             // ############ 1. READ PSEUDORANGES ####
             for (uint32_t i = 0; i < d_nchannels; i++)
@@ -1861,11 +1897,27 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
 
                             if (store_valid_observable)
                                 {
-                                    // store valid observables in a map.
-                                    d_gnss_observables_map.insert(std::pair<int, Gnss_Synchro>(i, in[i][epoch]));
+                                    // store valid observables in a map, reusing the channel's node when it exists
+                                    const auto obs_iter = d_gnss_observables_map.find(i);
+                                    if (obs_iter != d_gnss_observables_map.end())
+                                        {
+                                            obs_iter->second = in[i][epoch];
+                                        }
+                                    else
+                                        {
+                                            d_gnss_observables_map.insert(std::pair<int, Gnss_Synchro>(i, in[i][epoch]));
+                                        }
+                                }
+                            else
+                                {
+                                    d_gnss_observables_map.erase(i);
                                 }
 
-                            if (d_rtcm_enabled)
+                            // when asynchronous output is enabled, the lock-time
+                            // bookkeeping moves to the writer thread (see
+                            // update_rtcm_lock_times), which also owns the Rtcm
+                            // state read by Print_Rtcm_Messages
+                            if (d_rtcm_enabled and !d_asynchronous_output_enabled)
                                 {
                                     try
                                         {
@@ -1913,6 +1965,7 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                     else
                         {
                             d_channel_initialized.at(i) = false;  // the current channel is not reporting valid observable
+                            d_gnss_observables_map.erase(i);
                         }
                 }
 
@@ -1924,7 +1977,19 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                     // old_time_debug = d_gnss_observables_map.cbegin()->second.RX_time * 1000.0;
                     uint32_t current_RX_time_ms = 0;
                     // #### solve PVT and store the corrected observable set
-                    if (d_internal_pvt_solver->get_PVT(d_gnss_observables_map, false))
+                    const bool flag_internal_pvt_valid = d_internal_pvt_solver->get_PVT(d_gnss_observables_map, false);
+                    if (d_clock_steering_sink)
+                        {
+                            // published right here on the flowgraph thread, ahead of any
+                            // file or text output, so the delivery latency is bounded
+                            d_clock_steering_sink->write_clock_sample(
+                                d_gnss_observables_map.cbegin()->second.RX_time,
+                                flag_internal_pvt_valid ? d_internal_pvt_solver->get_time_offset_s() : 0.0,
+                                flag_internal_pvt_valid ? d_internal_pvt_solver->get_clock_drift_ppm() : 0.0,
+                                flag_internal_pvt_valid,
+                                std::chrono::steady_clock::now());
+                        }
+                    if (flag_internal_pvt_valid)
                         {
                             const double Rx_clock_offset_s = d_internal_pvt_solver->get_time_offset_s();
                             if (fabs(Rx_clock_offset_s) * 1000.0 > d_max_obs_block_rx_clock_offset_ms)
@@ -1941,7 +2006,7 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                                     if (d_enable_rx_clock_correction == true)
                                         {
                                             d_waiting_obs_block_rx_clock_offset_correction_msg = false;
-                                            d_gnss_observables_map_t0 = d_gnss_observables_map_t1;
+                                            d_gnss_observables_map_t0 = std::move(d_gnss_observables_map_t1);  // refilled from the current epoch right below
                                             apply_rx_clock_offset(d_gnss_observables_map, Rx_clock_offset_s);
                                             d_gnss_observables_map_t1 = d_gnss_observables_map;
 
@@ -1988,236 +2053,406 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                     //         DLOG(INFO) << "Internal PVT solver error";
                     //     }
 
-                    // compute on the fly PVT solution
-                    if (flag_compute_pvt_output == true)
+                    if (flag_compute_pvt_output and Trace_Writer::enabled())
                         {
-                            flag_pvt_valid = d_user_pvt_solver->get_PVT(d_gnss_observables_map, false);
+                            Trace_Writer::instant_event("pvt", "pvt_epoch", 0,
+                                d_gnss_observables_map.empty() ? 0ULL : d_gnss_observables_map.cbegin()->second.Tracking_sample_counter);
                         }
 
-                    if (flag_pvt_valid == true)
+                    // compute on the fly PVT solution
+                    if (d_asynchronous_output_enabled)
                         {
-                            // initialize (if needed) the accumulated phase offset and apply it to the active channels
-                            // required to report accumulated phase cycles comparable to pseudoranges
-                            initialize_and_apply_carrier_phase_offset();
-
-                            const double Rx_clock_offset_s = d_user_pvt_solver->get_time_offset_s();
-                            if (d_enable_rx_clock_correction == true and fabs(Rx_clock_offset_s) > 0.000001)  // 1us !!
+                            // the user solver runs on the writer thread. Apply the carrier
+                            // phase offset before snapshotting the observables; the phase
+                            // initialization is keyed here to the internal solver fix,
+                            // already validated above
+                            if (flag_pvt_valid == true or flag_compute_pvt_output == true)
                                 {
-                                    LOG(INFO) << "Warning: Rx clock offset at interpolated RX time: " << Rx_clock_offset_s * 1000.0 << "[ms]"
-                                              << " at RX time: " << static_cast<uint32_t>(d_rx_time * 1000.0) << " [ms]";
+                                    initialize_and_apply_carrier_phase_offset();
                                 }
-                            else
+                            const std::map<int, Gnss_Synchro> observables_snapshot = d_gnss_observables_map;
+                            const double rx_time_snapshot = d_rx_time;
+                            const bool enqueued = d_writer_queue->try_enqueue([this, observables_snapshot, rx_time_snapshot, current_RX_time_ms, flag_compute_pvt_output, flag_pvt_valid]() {
+                                compute_and_print_pvt_output(observables_snapshot, rx_time_snapshot, current_RX_time_ms, flag_compute_pvt_output, flag_pvt_valid);
+                            });
+                            if (!enqueued)
                                 {
-                                    DLOG(INFO) << "Rx clock offset at interpolated RX time: " << Rx_clock_offset_s * 1000.0 << "[s]"
-                                               << " at RX time: " << static_cast<uint32_t>(d_rx_time * 1000.0) << " [ms]";
-                                    // Optional debug code: export observables snapshot for rtklib unit testing
-                                    // std::cout << "step 1: save gnss_synchro map\n";
-                                    // save_gnss_synchro_map_xml("./gnss_synchro_map.xml");
-                                    // getchar(); // stop the execution
-                                    // end debug
-                                    if (d_display_rate_ms != 0)
-                                        {
-                                            if (current_RX_time_ms % d_display_rate_ms == 0)
-                                                {
-                                                    flag_display_pvt = true;
-                                                }
-                                        }
-                                    if (d_rtcm_MT1019_rate_ms != 0)  // allows deactivating messages by setting rate = 0
-                                        {
-                                            if (current_RX_time_ms % d_rtcm_MT1019_rate_ms == 0)
-                                                {
-                                                    flag_write_RTCM_1019_output = true;
-                                                }
-                                        }
-                                    if (d_rtcm_MT1020_rate_ms != 0)  // allows deactivating messages by setting rate = 0
-                                        {
-                                            if (current_RX_time_ms % d_rtcm_MT1020_rate_ms == 0)
-                                                {
-                                                    flag_write_RTCM_1020_output = true;
-                                                }
-                                        }
-                                    if (d_rtcm_MT1045_rate_ms != 0)
-                                        {
-                                            if (current_RX_time_ms % d_rtcm_MT1045_rate_ms == 0)
-                                                {
-                                                    flag_write_RTCM_1045_output = true;
-                                                }
-                                        }
-                                    // TODO: RTCM 1077, 1087 and 1097 are not used, so, disable the output rates
-                                    // if (current_RX_time_ms % d_rtcm_MT1077_rate_ms==0 and d_rtcm_MT1077_rate_ms != 0)
-                                    //     {
-                                    //         last_RTCM_1077_output_time = current_RX_time;
-                                    //     }
-                                    // if (current_RX_time_ms % d_rtcm_MT1087_rate_ms==0 and d_rtcm_MT1087_rate_ms != 0)
-                                    //     {
-                                    //         last_RTCM_1087_output_time = current_RX_time;
-                                    //     }
-                                    // if (current_RX_time_ms % d_rtcm_MT1097_rate_ms==0 and d_rtcm_MT1097_rate_ms != 0)
-                                    //     {
-                                    //         last_RTCM_1097_output_time = current_RX_time;
-                                    //     }
-                                    if (d_rtcm_MSM_rate_ms != 0)
-                                        {
-                                            if (current_RX_time_ms % d_rtcm_MSM_rate_ms == 0)
-                                                {
-                                                    flag_write_RTCM_MSM_output = true;
-                                                }
-                                        }
-                                    if (d_rinexobs_rate_ms != 0)
-                                        {
-                                            if (current_RX_time_ms % static_cast<uint32_t>(d_rinexobs_rate_ms) == 0)
-                                                {
-                                                    flag_write_RINEX_obs_output = true;
-                                                }
-                                        }
-
-                                    if (d_first_fix == true)
-                                        {
-                                            if (d_show_local_time_zone)
-                                                {
-                                                    const boost::posix_time::ptime time_first_solution = d_user_pvt_solver->get_position_UTC_time() + d_utc_diff_time;
-                                                    std::cout << "First position fix at " << time_first_solution << d_local_time_str;
-                                                }
-                                            else
-                                                {
-                                                    std::cout << "First position fix at " << d_user_pvt_solver->get_position_UTC_time() << " UTC";
-                                                }
-                                            std::cout << " is Lat = " << d_user_pvt_solver->get_latitude() << " [deg], Long = " << d_user_pvt_solver->get_longitude()
-                                                      << " [deg], Height= " << d_user_pvt_solver->get_height() << " [m]\n";
-                                            d_ttff_msgbuf ttff;
-                                            ttff.mtype = 1;
-                                            d_end = std::chrono::system_clock::now();
-                                            std::chrono::duration<double> elapsed_seconds = d_end - d_start;
-                                            ttff.ttff = elapsed_seconds.count();
-                                            send_sys_v_ttff_msg(ttff);
-                                            d_first_fix = false;
-                                        }
-                                    if (d_kml_output_enabled)
-                                        {
-                                            if (current_RX_time_ms % d_kml_rate_ms == 0)
-                                                {
-                                                    d_kml_dump->print_position(d_user_pvt_solver.get(), false);
-                                                }
-                                        }
-                                    if (d_gpx_output_enabled)
-                                        {
-                                            if (current_RX_time_ms % d_gpx_rate_ms == 0)
-                                                {
-                                                    d_gpx_dump->print_position(d_user_pvt_solver.get(), false);
-                                                }
-                                        }
-                                    if (d_geojson_output_enabled)
-                                        {
-                                            if (current_RX_time_ms % d_geojson_rate_ms == 0)
-                                                {
-                                                    d_geojson_printer->print_position(d_user_pvt_solver.get(), false);
-                                                }
-                                        }
-                                    if (d_nmea_output_file_enabled)
-                                        {
-                                            if (current_RX_time_ms % d_nmea_rate_ms == 0)
-                                                {
-                                                    d_nmea_printer->Print_Nmea_Line(d_user_pvt_solver.get(), false);
-                                                }
-                                        }
-                                    if (d_rinex_output_enabled)
-                                        {
-                                            d_rp->print_rinex_annotation(d_user_pvt_solver.get(), d_gnss_observables_map, d_rx_time, d_type_of_rx, flag_write_RINEX_obs_output);
-                                        }
-                                    if (d_rtcm_enabled)
-                                        {
-                                            d_rtcm_printer->Print_Rtcm_Messages(d_user_pvt_solver.get(),
-                                                d_gnss_observables_map,
-                                                d_rx_time,
-                                                d_type_of_rx,
-                                                d_rtcm_MSM_rate_ms,
-                                                d_rtcm_MT1019_rate_ms,
-                                                d_rtcm_MT1020_rate_ms,
-                                                d_rtcm_MT1045_rate_ms,
-                                                d_rtcm_MT1077_rate_ms,
-                                                d_rtcm_MT1097_rate_ms,
-                                                flag_write_RTCM_MSM_output,
-                                                flag_write_RTCM_1019_output,
-                                                flag_write_RTCM_1020_output,
-                                                flag_write_RTCM_1045_output,
-                                                d_enable_rx_clock_correction);
-                                        }
+                                    LOG(WARNING) << "PVT writer queue full, dropping output epoch at RX time " << d_rx_time << " [s]";
                                 }
                         }
-
-                    // DEBUG MESSAGE: Display position in console output
-                    if (d_user_pvt_solver->is_valid_position() and flag_display_pvt)
+                    else
                         {
-                            boost::posix_time::ptime time_solution;
-                            std::string UTC_solution_str;
-                            if (d_show_local_time_zone)
+                            if (flag_compute_pvt_output == true)
                                 {
-                                    time_solution = d_user_pvt_solver->get_position_UTC_time() + d_utc_diff_time;
-                                    UTC_solution_str = d_local_time_str;
+                                    flag_pvt_valid = d_user_pvt_solver->get_PVT(d_gnss_observables_map, false);
                                 }
-                            else
+                            if (flag_pvt_valid == true)
                                 {
-                                    time_solution = d_user_pvt_solver->get_position_UTC_time();
-                                    UTC_solution_str = " UTC";
+                                    // initialize (if needed) the accumulated phase offset and apply it to the active channels
+                                    // required to report accumulated phase cycles comparable to pseudoranges
+                                    initialize_and_apply_carrier_phase_offset();
                                 }
-                            std::streamsize ss = std::cout.precision();  // save current precision
-                            std::cout.setf(std::ios::fixed, std::ios::floatfield);
-                            auto* facet = new boost::posix_time::time_facet("%Y-%b-%d %H:%M:%S.%f %z");
-                            std::cout.imbue(std::locale(std::cout.getloc(), facet));
-                            std::cout
-                                << TEXT_BOLD_GREEN
-                                << "Position at " << time_solution << UTC_solution_str
-                                << " using " << d_user_pvt_solver->get_num_valid_observations()
-                                << std::fixed << std::setprecision(9)
-                                << " observations is Lat = " << d_user_pvt_solver->get_latitude() << " [deg], Long = " << d_user_pvt_solver->get_longitude()
-                                << std::fixed << std::setprecision(3)
-                                << " [deg], Height = " << d_user_pvt_solver->get_height() << " [m]" << TEXT_RESET << '\n';
-
-                            std::cout << std::setprecision(ss);
-                            DLOG(INFO) << "RX clock offset: " << d_user_pvt_solver->get_time_offset_s() << "[s]";
+                            compute_and_print_pvt_output(d_gnss_observables_map, d_rx_time, current_RX_time_ms, false, flag_pvt_valid);
+                        }
+                }
+        }
 
-                            std::cout
-                                << TEXT_BOLD_GREEN
-                                << "Velocity: " << std::fixed << std::setprecision(3)
-                                << "East: " << d_user_pvt_solver->get_rx_vel()[0] << " [m/s], North: " << d_user_pvt_solver->get_rx_vel()[1]
-                                << " [m/s], Up = " << d_user_pvt_solver->get_rx_vel()[2] << " [m/s]" << TEXT_RESET << '\n';
+    return noutput_items;
+}
 
-                            std::cout << std::setprecision(ss);
-                            DLOG(INFO) << "RX clock drift: " << d_user_pvt_solver->get_clock_drift_ppm() << " [ppm]";
 
-                            // boost::posix_time::ptime p_time;
-                            // gtime_t rtklib_utc_time = gpst2time(adjgpsweek(d_user_pvt_solver->gps_ephemeris_map.cbegin()->second.i_GPS_week), d_rx_time);
-                            // p_time = boost::posix_time::from_time_t(rtklib_utc_time.time);
-                            // p_time += boost::posix_time::microseconds(round(rtklib_utc_time.sec * 1e6));
-                            // std::cout << TEXT_MAGENTA << "Observable RX time (GPST) " << boost::posix_time::to_simple_string(p_time) << TEXT_RESET << '\n';
+void rtklib_pvt_gs::update_rtcm_lock_times(const std::map<int, Gnss_Synchro>& gnss_observables_map)
+{
+    // writer-thread counterpart of the per-channel lock-time bookkeeping in
+    // work(): the snapshot only holds observables already matched against an
+    // ephemeris record, so the map lookups mirror the in-line version
+    for (const auto& observable : gnss_observables_map)
+        {
+            const Gnss_Synchro& gnss_observable = observable.second;
+            try
+                {
+                    if (d_internal_pvt_solver->gps_ephemeris_map.empty() == false)
+                        {
+                            const auto tmp_eph_iter_gps = d_internal_pvt_solver->gps_ephemeris_map.find(gnss_observable.PRN);
+                            if (tmp_eph_iter_gps != d_internal_pvt_solver->gps_ephemeris_map.cend())
+                                {
+                                    d_rtcm_printer->lock_time(tmp_eph_iter_gps->second, gnss_observable.RX_time, gnss_observable);  // keep track of locking time
+                                }
+                        }
+                    if (d_internal_pvt_solver->galileo_ephemeris_map.empty() == false)
+                        {
+                            const auto tmp_eph_iter_gal = d_internal_pvt_solver->galileo_ephemeris_map.find(gnss_observable.PRN);
+                            if (tmp_eph_iter_gal != d_internal_pvt_solver->galileo_ephemeris_map.cend())
+                                {
+                                    d_rtcm_printer->lock_time(tmp_eph_iter_gal->second, gnss_observable.RX_time, gnss_observable);  // keep track of locking time
+                                }
+                        }
+                    if (d_internal_pvt_solver->gps_cnav_ephemeris_map.empty() == false)
+                        {
+                            const auto tmp_eph_iter_cnav = d_internal_pvt_solver->gps_cnav_ephemeris_map.find(gnss_observable.PRN);
+                            if (tmp_eph_iter_cnav != d_internal_pvt_solver->gps_cnav_ephemeris_map.cend())
+                                {
+                                    d_rtcm_printer->lock_time(tmp_eph_iter_cnav->second, gnss_observable.RX_time, gnss_observable);  // keep track of locking time
+                                }
+                        }
+                    if (d_internal_pvt_solver->glonass_gnav_ephemeris_map.empty() == false)
+                        {
+                            const auto tmp_eph_iter_glo_gnav = d_internal_pvt_solver->glonass_gnav_ephemeris_map.find(gnss_observable.PRN);
+                            if (tmp_eph_iter_glo_gnav != d_internal_pvt_solver->glonass_gnav_ephemeris_map.cend())
+                                {
+                                    d_rtcm_printer->lock_time(tmp_eph_iter_glo_gnav->second, gnss_observable.RX_time, gnss_observable);  // keep track of locking time
+                                }
+                        }
+                }
+            catch (const boost::exception& ex)
+                {
+                    std::cout << "RTCM boost exception: " << boost::diagnostic_information(ex) << '\n';
+                    LOG(ERROR) << "RTCM boost exception: " << boost::diagnostic_information(ex);
+                }
+            catch (const std::exception& ex)
+                {
+                    std::cout << "RTCM std exception: " << ex.what() << '\n';
+                    LOG(ERROR) << "RTCM std exception: " << ex.what();
+                }
+        }
+}
 
-                            DLOG(INFO) << "Position at " << boost::posix_time::to_simple_string(d_user_pvt_solver->get_position_UTC_time())
-                                       << " UTC using " << d_user_pvt_solver->get_num_valid_observations() << " observations is Lat = " << d_user_pvt_solver->get_latitude() << " [deg], Long = " << d_user_pvt_solver->get_longitude()
-                                       << " [deg], Height = " << d_user_pvt_solver->get_height() << " [m]";
 
-                            /* std::cout << "Dilution of Precision at " << boost::posix_time::to_simple_string(d_user_pvt_solver->get_position_UTC_time())
-                                         << " UTC using "<< d_user_pvt_solver->get_num_valid_observations() <<" observations is HDOP = " << d_user_pvt_solver->get_hdop() << " VDOP = "
-                                         << d_user_pvt_solver->get_vdop()
-                                         << " GDOP = " << d_user_pvt_solver->get_gdop() << '\n'; */
+void rtklib_pvt_gs::compute_and_print_pvt_output(const std::map<int, Gnss_Synchro>& gnss_observables_map,
+    double rx_time,
+    uint32_t current_RX_time_ms,
+    bool flag_compute_pvt_output,
+    bool flag_pvt_valid)
+{
+    // serializes the user solver and the printers against the telemetry message
+    // handlers when this method runs on the writer thread
+    const std::lock_guard<std::mutex> lock(d_user_pvt_solver_mutex);
+    if (d_user_pvt_solver != d_internal_pvt_solver)
+        {
+            // pick up the latest navigation data snapshot; the import is
+            // skipped when the version has not changed since the last epoch
+            const std::shared_ptr<const Pvt_Ephemeris_Snapshot> snapshot = std::atomic_load(&d_ephemeris_snapshot);
+            if (snapshot)
+                {
+                    d_user_pvt_solver->import_ephemeris_snapshot(snapshot);
+                }
+        }
+    bool flag_display_pvt = false;
+    bool flag_write_RTCM_1019_output = false;
+    bool flag_write_RTCM_1020_output = false;
+    bool flag_write_RTCM_1045_output = false;
+    bool flag_write_RTCM_MSM_output = false;
+    bool flag_write_RINEX_obs_output = false;
+
+    if (d_asynchronous_output_enabled and d_rtcm_enabled)
+        {
+            update_rtcm_lock_times(gnss_observables_map);
+        }
+    if (flag_compute_pvt_output == true)
+        {
+            flag_pvt_valid = d_user_pvt_solver->get_PVT(gnss_observables_map, false);
+        }
+    if (flag_pvt_valid == true)
+        {
+            const double Rx_clock_offset_s = d_user_pvt_solver->get_time_offset_s();
+            if (d_enable_rx_clock_correction == true and fabs(Rx_clock_offset_s) > 0.000001)  // 1us !!
+                {
+                    LOG(INFO) << "Warning: Rx clock offset at interpolated RX time: " << Rx_clock_offset_s * 1000.0 << "[ms]"
+                              << " at RX time: " << static_cast<uint32_t>(rx_time * 1000.0) << " [ms]";
+                }
+            else
+                {
+                    DLOG(INFO) << "Rx clock offset at interpolated RX time: " << Rx_clock_offset_s * 1000.0 << "[s]"
+                               << " at RX time: " << static_cast<uint32_t>(rx_time * 1000.0) << " [ms]";
+                    // Optional debug code: export observables snapshot for rtklib unit testing
+                    // std::cout << "step 1: save gnss_synchro map\n";
+                    // save_gnss_synchro_map_xml("./gnss_synchro_map.xml");
+                    // getchar(); // stop the execution
+                    // end debug
+                    if (d_display_rate_ms != 0)
+                        {
+                            if (current_RX_time_ms % d_display_rate_ms == 0)
+                                {
+                                    flag_display_pvt = true;
+                                }
                         }
-
-                    // PVT MONITOR
-                    if (d_user_pvt_solver->is_valid_position())
+                    if (d_rtcm_MT1019_rate_ms != 0)  // allows deactivating messages by setting rate = 0
+                        {
+                            if (current_RX_time_ms % d_rtcm_MT1019_rate_ms == 0)
+                                {
+                                    flag_write_RTCM_1019_output = true;
+                                }
+                        }
+                    if (d_rtcm_MT1020_rate_ms != 0)  // allows deactivating messages by setting rate = 0
+                        {
+                            if (current_RX_time_ms % d_rtcm_MT1020_rate_ms == 0)
+                                {
+                                    flag_write_RTCM_1020_output = true;
+                                }
+                        }
+                    if (d_rtcm_MT1045_rate_ms != 0)
+                        {
+                            if (current_RX_time_ms % d_rtcm_MT1045_rate_ms == 0)
+                                {
+                                    flag_write_RTCM_1045_output = true;
+                                }
+                        }
+                    // TODO: RTCM 1077, 1087 and 1097 are not used, so, disable the output rates
+                    // if (current_RX_time_ms % d_rtcm_MT1077_rate_ms==0 and d_rtcm_MT1077_rate_ms != 0)
+                    //     {
+                    //         last_RTCM_1077_output_time = current_RX_time;
+                    //     }
+                    // if (current_RX_time_ms % d_rtcm_MT1087_rate_ms==0 and d_rtcm_MT1087_rate_ms != 0)
+                    //     {
+                    //         last_RTCM_1087_output_time = current_RX_time;
+                    //     }
+                    // if (current_RX_time_ms % d_rtcm_MT1097_rate_ms==0 and d_rtcm_MT1097_rate_ms != 0)
+                    //     {
+                    //         last_RTCM_1097_output_time = current_RX_time;
+                    //     }
+                    if (d_rtcm_MSM_rate_ms != 0)
+                        {
+                            if (current_RX_time_ms % d_rtcm_MSM_rate_ms == 0)
+                                {
+                                    flag_write_RTCM_MSM_output = true;
+                                }
+                        }
+                    if (d_rinexobs_rate_ms != 0)
                         {
-                            const std::shared_ptr<Monitor_Pvt> monitor_pvt = std::make_shared<Monitor_Pvt>(d_user_pvt_solver->get_monitor_pvt());
+                            if (current_RX_time_ms % static_cast<uint32_t>(d_rinexobs_rate_ms) == 0)
+                                {
+                                    flag_write_RINEX_obs_output = true;
+                                }
+                        }
 
-                            // publish new position to the gnss_flowgraph channel status monitor
-                            if (current_RX_time_ms % d_report_rate_ms == 0)
+                    if (d_first_fix == true)
+                        {
+                            if (d_show_local_time_zone)
                                 {
-                                    this->message_port_pub(pmt::mp("status"), pmt::make_any(monitor_pvt));
+                                    const boost::posix_time::ptime time_first_solution = d_user_pvt_solver->get_position_UTC_time() + d_utc_diff_time;
+                                    std::cout << "First position fix at " << time_first_solution << d_local_time_str;
                                 }
-                            if (d_flag_monitor_pvt_enabled)
+                            else
+                                {
+                                    std::cout << "First position fix at " << d_user_pvt_solver->get_position_UTC_time() << " UTC";
+                                }
+                            std::cout << " is Lat = " << d_user_pvt_solver->get_latitude() << " [deg], Long = " << d_user_pvt_solver->get_longitude()
+                                      << " [deg], Height= " << d_user_pvt_solver->get_height() << " [m]\n";
+                            d_ttff_msgbuf ttff;
+                            ttff.mtype = 1;
+                            d_end = std::chrono::system_clock::now();
+                            std::chrono::duration<double> elapsed_seconds = d_end - d_start;
+                            ttff.ttff = elapsed_seconds.count();
+                            send_sys_v_ttff_msg(ttff);
+                            d_first_fix = false;
+                        }
+                    const bool kml_due = d_kml_output_enabled and (current_RX_time_ms % d_kml_rate_ms == 0);
+                    const bool gpx_due = d_gpx_output_enabled and (current_RX_time_ms % d_gpx_rate_ms == 0);
+                    const bool geojson_due = d_geojson_output_enabled and (current_RX_time_ms % d_geojson_rate_ms == 0);
+                    if (kml_due or gpx_due or geojson_due)
+                        {
+                            // format the fix once and share it among the geometry printers
+                            const Pvt_Geometry_Strings geo(d_user_pvt_solver.get(), false);
+                            if (kml_due)
                                 {
-                                    d_udp_sink_ptr->write_monitor_pvt(monitor_pvt.get());
+                                    d_kml_dump->print_position(geo);
                                 }
+                            if (gpx_due)
+                                {
+                                    d_gpx_dump->print_position(geo);
+                                }
+                            if (geojson_due)
+                                {
+                                    d_geojson_printer->print_position(geo);
+                                }
+                        }
+                    if (d_nmea_output_file_enabled)
+                        {
+                            if (current_RX_time_ms % d_nmea_rate_ms == 0)
+                                {
+                                    d_nmea_printer->Print_Nmea_Line(d_user_pvt_solver.get(), false);
+                                }
+                        }
+                    if (d_rinex_output_enabled)
+                        {
+                            d_rp->print_rinex_annotation(d_user_pvt_solver.get(), gnss_observables_map, rx_time, d_type_of_rx, flag_write_RINEX_obs_output);
+                        }
+                    if (d_rtcm_enabled)
+                        {
+                            d_rtcm_printer->Print_Rtcm_Messages(d_user_pvt_solver.get(),
+                                gnss_observables_map,
+                                rx_time,
+                                d_type_of_rx,
+                                d_rtcm_MSM_rate_ms,
+                                d_rtcm_MT1019_rate_ms,
+                                d_rtcm_MT1020_rate_ms,
+                                d_rtcm_MT1045_rate_ms,
+                                d_rtcm_MT1077_rate_ms,
+                                d_rtcm_MT1097_rate_ms,
+                                flag_write_RTCM_MSM_output,
+                                flag_write_RTCM_1019_output,
+                                flag_write_RTCM_1020_output,
+                                flag_write_RTCM_1045_output,
+                                d_enable_rx_clock_correction);
                         }
                 }
         }
 
-    return noutput_items;
+    // LATENCY BUDGET: close the end-to-end measurement after all the epoch
+    // products (RTCM included) have been written
+    if (d_latency_monitor and !gnss_observables_map.empty())
+        {
+            uint64_t ingest_time_ns = 0;
+            uint64_t obs_time_ns = 0;
+            for (const auto &observable : gnss_observables_map)
+                {
+                    if (observable.second.Ingest_time_ns != 0 and (ingest_time_ns == 0 or observable.second.Ingest_time_ns < ingest_time_ns))
+                        {
+                            ingest_time_ns = observable.second.Ingest_time_ns;
+                        }
+                    if (observable.second.Obs_time_ns > obs_time_ns)
+                        {
+                            obs_time_ns = observable.second.Obs_time_ns;
+                        }
+                }
+            const auto now_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+            d_latency_monitor->record(ingest_time_ns, obs_time_ns, now_ns);
+        }
+
+    // DUAL-ANTENNA ATTITUDE: both antenna groups share the receiver clock,
+    // so the baseline comes out of the observables alone
+    if (d_attitude_solver and d_user_pvt_solver->is_valid_position())
+        {
+            d_attitude_solver->solve(gnss_observables_map, d_user_pvt_solver->pvt_ssat);
+        }
+
+    // DEBUG MESSAGE: Display position in console output
+    if (d_user_pvt_solver->is_valid_position() and flag_display_pvt)
+        {
+            boost::posix_time::ptime time_solution;
+            std::string UTC_solution_str;
+            if (d_show_local_time_zone)
+                {
+                    time_solution = d_user_pvt_solver->get_position_UTC_time() + d_utc_diff_time;
+                    UTC_solution_str = d_local_time_str;
+                }
+            else
+                {
+                    time_solution = d_user_pvt_solver->get_position_UTC_time();
+                    UTC_solution_str = " UTC";
+                }
+            std::streamsize ss = std::cout.precision();  // save current precision
+            std::cout.setf(std::ios::fixed, std::ios::floatfield);
+            auto* facet = new boost::posix_time::time_facet("%Y-%b-%d %H:%M:%S.%f %z");
+            std::cout.imbue(std::locale(std::cout.getloc(), facet));
+            std::cout
+                << TEXT_BOLD_GREEN
+                << "Position at " << time_solution << UTC_solution_str
+                << " using " << d_user_pvt_solver->get_num_valid_observations()
+                << std::fixed << std::setprecision(9)
+                << " observations is Lat = " << d_user_pvt_solver->get_latitude() << " [deg], Long = " << d_user_pvt_solver->get_longitude()
+                << std::fixed << std::setprecision(3)
+                << " [deg], Height = " << d_user_pvt_solver->get_height() << " [m]"
+                << (d_user_pvt_solver->is_dead_reckoning() ? " (DEAD RECKONING)" : "") << TEXT_RESET << '\n';
+
+            std::cout << std::setprecision(ss);
+            DLOG(INFO) << "RX clock offset: " << d_user_pvt_solver->get_time_offset_s() << "[s]";
+
+            std::cout
+                << TEXT_BOLD_GREEN
+                << "Velocity: " << std::fixed << std::setprecision(3)
+                << "East: " << d_user_pvt_solver->get_rx_vel()[0] << " [m/s], North: " << d_user_pvt_solver->get_rx_vel()[1]
+                << " [m/s], Up = " << d_user_pvt_solver->get_rx_vel()[2] << " [m/s]" << TEXT_RESET << '\n';
+
+            std::cout << std::setprecision(ss);
+            DLOG(INFO) << "RX clock drift: " << d_user_pvt_solver->get_clock_drift_ppm() << " [ppm]";
+
+            if (d_attitude_solver and d_attitude_solver->is_valid())
+                {
+                    std::cout
+                        << TEXT_BOLD_GREEN
+                        << "Attitude: " << std::fixed << std::setprecision(2)
+                        << "Heading = " << d_attitude_solver->get_heading_deg() << " [deg], Pitch = "
+                        << d_attitude_solver->get_pitch_deg() << " [deg], Baseline = "
+                        << std::setprecision(3) << d_attitude_solver->get_baseline_length_m() << " [m]" << TEXT_RESET << '\n';
+                    std::cout << std::setprecision(ss);
+                }
+
+            // boost::posix_time::ptime p_time;
+            // gtime_t rtklib_utc_time = gpst2time(adjgpsweek(d_user_pvt_solver->gps_ephemeris_map.cbegin()->second.i_GPS_week), d_rx_time);
+            // p_time = boost::posix_time::from_time_t(rtklib_utc_time.time);
+            // p_time += boost::posix_time::microseconds(round(rtklib_utc_time.sec * 1e6));
+            // std::cout << TEXT_MAGENTA << "Observable RX time (GPST) " << boost::posix_time::to_simple_string(p_time) << TEXT_RESET << '\n';
+
+            DLOG(INFO) << "Position at " << boost::posix_time::to_simple_string(d_user_pvt_solver->get_position_UTC_time())
+                       << " UTC using " << d_user_pvt_solver->get_num_valid_observations() << " observations is Lat = " << d_user_pvt_solver->get_latitude() << " [deg], Long = " << d_user_pvt_solver->get_longitude()
+                       << " [deg], Height = " << d_user_pvt_solver->get_height() << " [m]";
+
+            /* std::cout << "Dilution of Precision at " << boost::posix_time::to_simple_string(d_user_pvt_solver->get_position_UTC_time())
+                         << " UTC using "<< d_user_pvt_solver->get_num_valid_observations() <<" observations is HDOP = " << d_user_pvt_solver->get_hdop() << " VDOP = "
+                         << d_user_pvt_solver->get_vdop()
+                         << " GDOP = " << d_user_pvt_solver->get_gdop() << '\n'; */
+        }
+
+    // PVT MONITOR
+    if (d_user_pvt_solver->is_valid_position())
+        {
+            const std::shared_ptr<Monitor_Pvt> monitor_pvt = std::make_shared<Monitor_Pvt>(d_user_pvt_solver->get_monitor_pvt());
+
+            // publish new position to the gnss_flowgraph channel status monitor
+            if (current_RX_time_ms % d_report_rate_ms == 0)
+                {
+                    this->message_port_pub(pmt::mp("status"), pmt::make_any(monitor_pvt));
+                }
+            if (d_flag_monitor_pvt_enabled)
+                {
+                    d_udp_sink_ptr->write_monitor_pvt(monitor_pvt.get());
+                }
+            // the shared-memory topic is refreshed on every solution, not
+            // at the report rate: local consumers poll it per control cycle
+            if (d_shm_sink_ptr)
+                {
+                    d_shm_sink_ptr->write_monitor_pvt(monitor_pvt.get());
+                }
+        }
 }
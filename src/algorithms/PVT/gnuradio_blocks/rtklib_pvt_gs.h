@@ -18,8 +18,10 @@
 #define GNSS_SDR_RTKLIB_PVT_GS_H
 
 #include "gnss_block_interface.h"
+#include "pvt_ephemeris_snapshot.h"
 #include "gnss_synchro.h"
 #include "rtklib.h"
+#include "work_monitor.h"
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <gnuradio/sync_block.h>  // for sync_block
@@ -31,6 +33,7 @@
 #include <ctime>                  // for time_t
 #include <map>                    // for map
 #include <memory>                 // for shared_ptr, unique_ptr
+#include <mutex>                  // for mutex
 #include <string>                 // for string
 #include <sys/types.h>            // for key_t
 #include <vector>                 // for vector
@@ -44,6 +47,7 @@
 
 class Beidou_Dnav_Almanac;
 class Beidou_Dnav_Ephemeris;
+class Clock_Steering_Sink;
 class Galileo_Almanac;
 class Galileo_Ephemeris;
 class GeoJSON_Printer;
@@ -51,10 +55,15 @@ class Gps_Almanac;
 class Gps_Ephemeris;
 class Gpx_Printer;
 class Kml_Printer;
+class Attitude_Solver;
+class Latency_Monitor;
+class Monitor_Pvt_Shm_Sink;
 class Monitor_Pvt_Udp_Sink;
 class Nmea_Printer;
 class Pvt_Conf;
+class Pvt_Writer_Queue;
 class Rinex_Printer;
+class Rtcm_Base_Client;
 class Rtcm_Printer;
 class Rtklib_Solver;
 class rtklib_pvt_gs;
@@ -132,8 +141,25 @@ private:
 
     void msg_handler_telemetry(const pmt::pmt_t& msg);
 
+    // publishes an immutable copy of the internal solver navigation data,
+    // exchanged with the writer thread through an atomic shared_ptr
+    void publish_ephemeris_snapshot();
+
     void initialize_and_apply_carrier_phase_offset();
 
+    // computes the user PVT solution (when pending) and runs the printers, the
+    // console display and the PVT monitor. Runs inline in work() or, when
+    // asynchronous output is enabled, on the writer thread with a snapshot of
+    // the observables
+    void compute_and_print_pvt_output(const std::map<int, Gnss_Synchro>& gnss_observables_map,
+        double rx_time,
+        uint32_t current_RX_time_ms,
+        bool flag_compute_pvt_output,
+        bool flag_pvt_valid);
+
+    // writer-thread counterpart of the in-line RTCM lock-time bookkeeping of work()
+    void update_rtcm_lock_times(const std::map<int, Gnss_Synchro>& gnss_observables_map);
+
     void apply_rx_clock_offset(std::map<int, Gnss_Synchro>& observables_map,
         double rx_clock_offset_s);
 
@@ -160,6 +186,8 @@ private:
 
     std::shared_ptr<Rtklib_Solver> d_internal_pvt_solver;
     std::shared_ptr<Rtklib_Solver> d_user_pvt_solver;
+    std::shared_ptr<const Pvt_Ephemeris_Snapshot> d_ephemeris_snapshot;  // accessed with std::atomic_load/store
+    uint64_t d_ephemeris_snapshot_version = 0;
 
     std::unique_ptr<Rinex_Printer> d_rp;
     std::unique_ptr<Kml_Printer> d_kml_dump;
@@ -167,7 +195,20 @@ private:
     std::unique_ptr<Nmea_Printer> d_nmea_printer;
     std::unique_ptr<GeoJSON_Printer> d_geojson_printer;
     std::unique_ptr<Rtcm_Printer> d_rtcm_printer;
+    std::unique_ptr<Rtcm_Base_Client> d_rtcm_base_client;
     std::unique_ptr<Monitor_Pvt_Udp_Sink> d_udp_sink_ptr;
+    std::unique_ptr<Monitor_Pvt_Shm_Sink> d_shm_sink_ptr;
+    std::unique_ptr<Attitude_Solver> d_attitude_solver;
+    std::unique_ptr<Latency_Monitor> d_latency_monitor;
+    std::unique_ptr<Clock_Steering_Sink> d_clock_steering_sink;
+    std::unique_ptr<Pvt_Writer_Queue> d_writer_queue;
+
+    Work_Monitor d_work_monitor;
+
+    // serializes the user PVT solver and the printers between the writer
+    // thread and the telemetry message handlers. Uncontended when the
+    // asynchronous output is disabled
+    mutable std::mutex d_user_pvt_solver_mutex;
 
     std::chrono::time_point<std::chrono::system_clock> d_start;
     std::chrono::time_point<std::chrono::system_clock> d_end;
@@ -214,6 +255,7 @@ private:
     size_t d_galileo_utc_model_sptr_type_hash_code;
     size_t d_galileo_almanac_helper_sptr_type_hash_code;
     size_t d_galileo_almanac_sptr_type_hash_code;
+    size_t d_galileo_has_data_sptr_type_hash_code;
     size_t d_glonass_gnav_ephemeris_sptr_type_hash_code;
     size_t d_glonass_gnav_utc_model_sptr_type_hash_code;
     size_t d_glonass_gnav_almanac_sptr_type_hash_code;
@@ -263,6 +305,7 @@ private:
     bool d_show_local_time_zone;
     bool d_waiting_obs_block_rx_clock_offset_correction_msg;
     bool d_enable_rx_clock_correction;
+    bool d_asynchronous_output_enabled;
 };
 
 
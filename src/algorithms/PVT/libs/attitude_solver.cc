@@ -0,0 +1,367 @@
+/*!
+ * \file attitude_solver.cc
+ * \brief Implementation of a dual-antenna baseline/attitude solver fed with
+ * common-clock observables
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "attitude_solver.h"
+#include "MATH_CONSTANTS.h"
+#include "gnss_frequencies.h"
+#include <glog/logging.h>
+#include <cmath>
+#include <string>
+#include <utility>
+
+namespace
+{
+// minimum elevation of a satellite used in a double difference [rad]
+const double min_elevation_rad = 10.0 * D2R;
+// smoothing factor of the epoch-to-epoch baseline filter
+const double baseline_alpha = 0.1;
+// tolerance of the baseline-length validation, relative plus absolute [m]
+const double length_tol_rel = 0.2;
+const double length_tol_abs = 0.05;
+}  // namespace
+
+
+Attitude_Solver::Attitude_Solver(std::vector<int32_t> antenna_of_channel, double baseline_length_m)
+    : d_antenna_of_channel(std::move(antenna_of_channel)),
+      d_baseline_length_m(baseline_length_m)
+{
+}
+
+
+bool Attitude_Solver::is_valid() const
+{
+    return d_valid;
+}
+
+
+double Attitude_Solver::get_heading_deg() const
+{
+    return d_heading_deg;
+}
+
+
+double Attitude_Solver::get_pitch_deg() const
+{
+    return d_pitch_deg;
+}
+
+
+double Attitude_Solver::get_baseline_length_m() const
+{
+    return std::sqrt(d_baseline_enu_m[0] * d_baseline_enu_m[0] +
+                     d_baseline_enu_m[1] * d_baseline_enu_m[1] +
+                     d_baseline_enu_m[2] * d_baseline_enu_m[2]);
+}
+
+
+const std::array<double, 3>& Attitude_Solver::get_baseline_enu_m() const
+{
+    return d_baseline_enu_m;
+}
+
+
+double Attitude_Solver::carrier_frequency_hz(const Gnss_Synchro& obs)
+{
+    const std::string sig(obs.Signal, 2);
+    switch (obs.System)
+        {
+        case 'G':
+            if (sig == "2S")
+                {
+                    return FREQ2;
+                }
+            if (sig == "L5")
+                {
+                    return FREQ5;
+                }
+            return FREQ1;
+        case 'E':
+            if (sig == "5X")
+                {
+                    return FREQ5;
+                }
+            if (sig == "7X")
+                {
+                    return FREQ7;
+                }
+            if (sig == "E6")
+                {
+                    return FREQ6;
+                }
+            return FREQ1;
+        case 'R':
+            if (sig == "2G")
+                {
+                    return FREQ2_GLO;
+                }
+            return FREQ1_GLO;
+        case 'C':
+            if (sig == "B3")
+                {
+                    return FREQ3_BDS;
+                }
+            return FREQ1_BDS;
+        default:
+            return FREQ1;
+        }
+}
+
+
+int Attitude_Solver::rtklib_sat_index(const Gnss_Synchro& obs)
+{
+    switch (obs.System)
+        {
+        case 'G':
+            return static_cast<int>(obs.PRN);
+        case 'R':
+            return static_cast<int>(obs.PRN) + NSATGPS;
+        case 'E':
+            return static_cast<int>(obs.PRN) + NSATGPS + NSATGLO;
+        case 'C':
+            return static_cast<int>(obs.PRN) + NSATGPS + NSATGLO + NSATGAL + NSATQZS;
+        default:
+            return 0;
+        }
+}
+
+
+bool Attitude_Solver::solve_3x3(const double* ata, const double* aty, double* x)
+{
+    // Cramer solution of the 3x3 normal equations (column-major symmetric)
+    const double det = ata[0] * (ata[4] * ata[8] - ata[5] * ata[7]) -
+                       ata[3] * (ata[1] * ata[8] - ata[2] * ata[7]) +
+                       ata[6] * (ata[1] * ata[5] - ata[2] * ata[4]);
+    if (std::fabs(det) < 1e-12)
+        {
+            return false;
+        }
+    x[0] = (aty[0] * (ata[4] * ata[8] - ata[5] * ata[7]) -
+               ata[3] * (aty[1] * ata[8] - aty[2] * ata[7]) +
+               ata[6] * (aty[1] * ata[5] - aty[2] * ata[4])) /
+           det;
+    x[1] = (ata[0] * (aty[1] * ata[8] - aty[2] * ata[7]) -
+               aty[0] * (ata[1] * ata[8] - ata[2] * ata[7]) +
+               ata[6] * (ata[1] * aty[2] - ata[2] * aty[1])) /
+           det;
+    x[2] = (ata[0] * (ata[4] * aty[2] - ata[5] * aty[1]) -
+               ata[3] * (ata[1] * aty[2] - ata[2] * aty[1]) +
+               aty[0] * (ata[1] * ata[5] - ata[2] * ata[4])) /
+           det;
+    return true;
+}
+
+
+bool Attitude_Solver::solve(const std::map<int, Gnss_Synchro>& gnss_observables_map,
+    const std::array<ssat_t, MAXSAT>& ssat)
+{
+    d_valid = false;
+
+    // pair the channels of both antennas tracking the same satellite/signal
+    std::map<std::string, std::pair<const Gnss_Synchro*, const Gnss_Synchro*>> pairs;
+    for (const auto& item : gnss_observables_map)
+        {
+            const Gnss_Synchro& obs = item.second;
+            if (!obs.Flag_valid_pseudorange)
+                {
+                    continue;
+                }
+            int antenna = 0;
+            if (obs.Channel_ID >= 0 and static_cast<size_t>(obs.Channel_ID) < d_antenna_of_channel.size())
+                {
+                    antenna = d_antenna_of_channel[obs.Channel_ID];
+                }
+            if (antenna > 1)
+                {
+                    continue;  // only the first two antennas take part
+                }
+            const std::string key = std::string(1, obs.System) + std::to_string(obs.PRN) + std::string(obs.Signal, 2);
+            if (antenna == 0)
+                {
+                    pairs[key].first = &obs;
+                }
+            else
+                {
+                    pairs[key].second = &obs;
+                }
+        }
+
+    // single differences between antennas, with line-of-sight from the solver
+    std::vector<Dd_Candidate> cand;
+    cand.reserve(pairs.size());
+    for (const auto& item : pairs)
+        {
+            if (item.second.first == nullptr or item.second.second == nullptr)
+                {
+                    continue;
+                }
+            const Gnss_Synchro& a = *item.second.first;
+            const Gnss_Synchro& b = *item.second.second;
+            const int sat = rtklib_sat_index(a);
+            if (sat <= 0 or sat > MAXSAT)
+                {
+                    continue;
+                }
+            const double az = ssat[sat - 1].azel[0];
+            const double el = ssat[sat - 1].azel[1];
+            if (el < min_elevation_rad)
+                {
+                    continue;
+                }
+            Dd_Candidate c{};
+            c.enu[0] = std::sin(az) * std::cos(el);
+            c.enu[1] = std::cos(az) * std::cos(el);
+            c.enu[2] = std::sin(el);
+            c.sd_phase_cycles = (a.Carrier_phase_rads - b.Carrier_phase_rads) / TWO_PI;
+            c.sd_code_m = a.Pseudorange_m - b.Pseudorange_m;
+            c.lambda_m = SPEED_OF_LIGHT_M_S / carrier_frequency_hz(a);
+            c.elevation_rad = el;
+            cand.push_back(c);
+        }
+    if (cand.size() < 4)
+        {
+            return false;  // three double differences for three unknowns
+        }
+
+    // reference satellite: highest elevation
+    size_t ref = 0;
+    for (size_t i = 1; i < cand.size(); i++)
+        {
+            if (cand[i].elevation_rad > cand[ref].elevation_rad)
+                {
+                    ref = i;
+                }
+        }
+
+    // double differences against the reference satellite
+    const size_t nd = cand.size() - 1;
+    std::vector<std::array<double, 3>> de(nd);
+    std::vector<double> dd_phase(nd);
+    std::vector<double> dd_code(nd);
+    std::vector<double> lam(nd);
+    size_t k = 0;
+    for (size_t i = 0; i < cand.size(); i++)
+        {
+            if (i == ref)
+                {
+                    continue;
+                }
+            for (int j = 0; j < 3; j++)
+                {
+                    de[k][j] = cand[i].enu[j] - cand[ref].enu[j];
+                }
+            dd_phase[k] = cand[i].sd_phase_cycles - cand[ref].sd_phase_cycles;
+            dd_code[k] = cand[i].sd_code_m - cand[ref].sd_code_m;
+            lam[k] = cand[i].lambda_m;
+            k++;
+        }
+
+    // float baseline from double-differenced code
+    double ata[9] = {};
+    double aty[3] = {};
+    for (size_t i = 0; i < nd; i++)
+        {
+            for (int r = 0; r < 3; r++)
+                {
+                    for (int c = 0; c < 3; c++)
+                        {
+                            ata[r + 3 * c] += de[i][r] * de[i][c];
+                        }
+                    aty[r] += de[i][r] * dd_code[i];
+                }
+        }
+    double b[3];
+    if (!solve_3x3(ata, aty, b))
+        {
+            return false;
+        }
+    if (d_baseline_length_m > 0.0)
+        {
+            // a known baseline length bounds the noisy code solution
+            const double norm_b = std::sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
+            if (norm_b > 0.0)
+                {
+                    for (double& v : b)
+                        {
+                            v *= d_baseline_length_m / norm_b;
+                        }
+                }
+        }
+
+    // fix the ambiguities by rounding and refine with carrier only; a second
+    // pass re-rounds with the carrier-accurate baseline
+    for (int pass = 0; pass < 2; pass++)
+        {
+            double atac[9] = {};
+            double atyc[3] = {};
+            for (size_t i = 0; i < nd; i++)
+                {
+                    const double geom = de[i][0] * b[0] + de[i][1] * b[1] + de[i][2] * b[2];
+                    const double amb = std::round(dd_phase[i] - geom / lam[i]);
+                    const double y = lam[i] * (dd_phase[i] - amb);
+                    for (int r = 0; r < 3; r++)
+                        {
+                            for (int c = 0; c < 3; c++)
+                                {
+                                    atac[r + 3 * c] += de[i][r] * de[i][c];
+                                }
+                            atyc[r] += de[i][r] * y;
+                        }
+                }
+            if (!solve_3x3(atac, atyc, b))
+                {
+                    return false;
+                }
+        }
+
+    const double length = std::sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
+    if (d_baseline_length_m > 0.0 and
+        std::fabs(length - d_baseline_length_m) > length_tol_rel * d_baseline_length_m + length_tol_abs)
+        {
+            DLOG(INFO) << "Attitude solver: baseline length " << length
+                       << " m out of tolerance (configured " << d_baseline_length_m << " m)";
+            return false;
+        }
+
+    // smooth the baseline vector across epochs; angles are derived from the
+    // smoothed vector so the heading does not wrap through the filter
+    if (d_smoothed_epochs == 0)
+        {
+            for (int i = 0; i < 3; i++)
+                {
+                    d_baseline_smoothed[i] = b[i];
+                }
+        }
+    else
+        {
+            for (int i = 0; i < 3; i++)
+                {
+                    d_baseline_smoothed[i] += baseline_alpha * (b[i] - d_baseline_smoothed[i]);
+                }
+        }
+    d_smoothed_epochs++;
+    d_baseline_enu_m = d_baseline_smoothed;
+    d_heading_deg = std::atan2(d_baseline_enu_m[0], d_baseline_enu_m[1]) * R2D;
+    if (d_heading_deg < 0.0)
+        {
+            d_heading_deg += 360.0;
+        }
+    const double horiz = std::sqrt(d_baseline_enu_m[0] * d_baseline_enu_m[0] +
+                                   d_baseline_enu_m[1] * d_baseline_enu_m[1]);
+    d_pitch_deg = std::atan2(d_baseline_enu_m[2], horiz) * R2D;
+    d_valid = true;
+    return true;
+}
@@ -0,0 +1,95 @@
+/*!
+ * \file attitude_solver.h
+ * \brief Interface of a dual-antenna baseline/attitude solver fed with
+ * common-clock observables
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ATTITUDE_SOLVER_H
+#define GNSS_SDR_ATTITUDE_SOLVER_H
+
+#include "gnss_synchro.h"
+#include "rtklib.h"
+#include <array>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Estimates the baseline vector between two antennas processed in the
+ * same flowgraph, and from it the heading and pitch of the platform.
+ *
+ * Both antenna groups are sampled against the same receiver clock, so the
+ * clock term is already common to all channels and the usual clock-difference
+ * estimation between receivers is skipped entirely. The solver forms
+ * double-differenced carrier phases between antennas and satellites (the
+ * double difference also cancels the RF line biases between the two chains),
+ * initializes the baseline from double-differenced code, fixes the integer
+ * ambiguities by rounding, and refines the baseline with a carrier-only
+ * least-squares fit. An optional known baseline length constrains and
+ * validates the solution.
+ */
+class Attitude_Solver
+{
+public:
+    Attitude_Solver(std::vector<int32_t> antenna_of_channel, double baseline_length_m);
+
+    /*!
+     * \brief Computes the baseline from one epoch of observables. azel per
+     * satellite is taken from the PVT solver satellite status. Returns true
+     * when a valid baseline was obtained.
+     */
+    bool solve(const std::map<int, Gnss_Synchro>& gnss_observables_map,
+        const std::array<ssat_t, MAXSAT>& ssat);
+
+    bool is_valid() const;
+    double get_heading_deg() const;
+    double get_pitch_deg() const;
+    double get_baseline_length_m() const;
+    const std::array<double, 3>& get_baseline_enu_m() const;
+
+private:
+    // one satellite/signal tracked by both antennas
+    struct Dd_Candidate
+    {
+        double enu[3];           // line-of-sight unit vector (ENU)
+        double sd_phase_cycles;  // single-differenced carrier phase
+        double sd_code_m;        // single-differenced pseudorange
+        double lambda_m;         // carrier wavelength
+        double elevation_rad;
+    };
+
+    static double carrier_frequency_hz(const Gnss_Synchro& obs);
+    static int rtklib_sat_index(const Gnss_Synchro& obs);
+    static bool solve_3x3(const double* ata, const double* aty, double* x);
+
+    std::vector<int32_t> d_antenna_of_channel;
+    std::array<double, 3> d_baseline_enu_m{};
+    std::array<double, 3> d_baseline_smoothed{};
+    double d_baseline_length_m;  // configured length, 0 = unconstrained
+    double d_heading_deg = 0.0;
+    double d_pitch_deg = 0.0;
+    int d_smoothed_epochs = 0;
+    bool d_valid = false;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ATTITUDE_SOLVER_H
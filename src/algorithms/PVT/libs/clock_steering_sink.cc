@@ -0,0 +1,109 @@
+/*!
+ * \file clock_steering_sink.cc
+ * \brief Implementation of a class that publishes the receiver clock
+ * solution over a Unix datagram socket for external clock steering
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "clock_steering_sink.h"
+#include <glog/logging.h>
+#include <cstring>
+#include <type_traits>
+
+static_assert(std::is_standard_layout<Clock_Steering_Sample>::value,
+    "Clock_Steering_Sample must be standard-layout, it is sent as raw bytes");
+
+
+Clock_Steering_Sink::Clock_Steering_Sink(const std::string& socket_path) : socket(io_context),
+                                                                           endpoint(socket_path)
+{
+    boost::system::error_code ec;
+    socket.open(boost::asio::local::datagram_protocol(), ec);
+    if (ec)
+        {
+            LOG(WARNING) << "Could not open clock steering socket: " << ec.message();
+            return;
+        }
+    socket.non_blocking(true, ec);
+    if (ec)
+        {
+            LOG(WARNING) << "Could not set clock steering socket non-blocking: " << ec.message();
+        }
+    LOG(INFO) << "Clock steering samples will be sent to " << socket_path;
+}
+
+
+Clock_Steering_Sink::~Clock_Steering_Sink()
+{
+    if (d_sent > 0 or d_failed > 0)
+        {
+            LOG(INFO) << "Clock steering sink: " << d_sent << " samples sent, "
+                      << d_failed << " failed, mean publish latency "
+                      << (d_sent > 0 ? d_latency_sum_us / static_cast<double>(d_sent) : 0.0)
+                      << " us, max " << d_latency_max_us << " us";
+        }
+    boost::system::error_code ec;
+    socket.close(ec);
+}
+
+
+void Clock_Steering_Sink::write_clock_sample(double rx_time_s, double offset_s, double drift_ppm, bool valid,
+    std::chrono::steady_clock::time_point solve_time)
+{
+    if (!socket.is_open())
+        {
+            return;
+        }
+    Clock_Steering_Sample sample{};
+    sample.magic = 0x47534353;  // "GSCS"
+    sample.sequence = d_sequence++;
+    sample.rx_time_s = rx_time_s;
+    sample.offset_s = offset_s;
+    sample.drift_ppm = drift_ppm;
+    sample.valid = valid ? 1 : 0;
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    sample.solve_age_us = std::chrono::duration<double, std::micro>(now - solve_time).count();
+
+    boost::system::error_code ec;
+    socket.send_to(boost::asio::buffer(&sample, sizeof(sample)), endpoint, 0, ec);
+    if (ec)
+        {
+            // no consumer bound to the socket is a normal condition, keep quiet
+            d_failed++;
+            return;
+        }
+    const double latency_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - solve_time).count();
+    d_latency_sum_us += latency_us;
+    if (latency_us > d_latency_max_us)
+        {
+            d_latency_max_us = latency_us;
+        }
+    d_sent++;
+    if (d_sent % 1000 == 0)
+        {
+            DLOG(INFO) << "Clock steering sink: " << d_sent << " samples sent, mean publish latency "
+                       << d_latency_sum_us / static_cast<double>(d_sent) << " us, max " << d_latency_max_us << " us";
+        }
+}
+
+
+uint64_t Clock_Steering_Sink::samples_sent() const
+{
+    return d_sent;
+}
+
+
+uint64_t Clock_Steering_Sink::samples_failed() const
+{
+    return d_failed;
+}
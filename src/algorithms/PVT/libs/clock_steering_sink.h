@@ -0,0 +1,97 @@
+/*!
+ * \file clock_steering_sink.h
+ * \brief Interface of a class that publishes the receiver clock solution
+ * over a Unix datagram socket for external clock steering
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CLOCK_STEERING_SINK_H
+#define GNSS_SDR_CLOCK_STEERING_SINK_H
+
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+#if USE_BOOST_ASIO_IO_CONTEXT
+using b_io_context = boost::asio::io_context;
+#else
+using b_io_context = boost::asio::io_service;
+#endif
+
+/*!
+ * \brief Clock sample datagram sent after every internal PVT solve.
+ *
+ * Plain standard-layout struct, native byte order (producer and consumer
+ * share the host). The consumer disciplines an external clock from it,
+ * in the style of a chrony SOCK refclock feed.
+ */
+struct Clock_Steering_Sample
+{
+    uint32_t magic;       //!< "GSCS" = 0x47534353, sanity check for the consumer
+    uint32_t sequence;    //!< incremented on every sample, gaps reveal losses
+    double rx_time_s;     //!< receiver time of the solution [s]
+    double offset_s;      //!< receiver clock offset [s]
+    double drift_ppm;     //!< receiver clock drift [ppm]
+    double solve_age_us;  //!< elapsed time from the PVT solve to this send [us]
+    uint8_t valid;        //!< 0 when the solver had no fix for this epoch
+    uint8_t reserved[7];
+};
+
+/*!
+ * \brief Publishes (offset, drift, validity) over a Unix datagram socket.
+ *
+ * The sample is sent from the flowgraph thread right after the internal
+ * solver runs, before any file or text output, so the delivery latency is
+ * bounded by a non-blocking sendto() instead of the printer path. Failed
+ * sends (e.g. no consumer listening) are counted and never block.
+ */
+class Clock_Steering_Sink
+{
+public:
+    explicit Clock_Steering_Sink(const std::string& socket_path);
+    ~Clock_Steering_Sink();
+    Clock_Steering_Sink(const Clock_Steering_Sink&) = delete;
+    Clock_Steering_Sink& operator=(const Clock_Steering_Sink&) = delete;
+
+    /*!
+     * Send one clock sample. solve_time is the instant the PVT solve
+     * finished, used for the end-to-end latency counters
+     */
+    void write_clock_sample(double rx_time_s, double offset_s, double drift_ppm, bool valid,
+        std::chrono::steady_clock::time_point solve_time);
+
+    uint64_t samples_sent() const;
+    uint64_t samples_failed() const;
+
+private:
+    b_io_context io_context;
+    boost::asio::local::datagram_protocol::socket socket;
+    boost::asio::local::datagram_protocol::endpoint endpoint;
+    uint64_t d_sent = 0;
+    uint64_t d_failed = 0;
+    double d_latency_sum_us = 0.0;
+    double d_latency_max_us = 0.0;
+    uint32_t d_sequence = 0;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CLOCK_STEERING_SINK_H
@@ -178,34 +178,23 @@ bool GeoJSON_Printer::set_headers(const std::string& filename, bool time_tag_nam
 
 bool GeoJSON_Printer::print_position(const Pvt_Solution* const position, bool print_average_values)
 {
-    double latitude;
-    double longitude;
-    double height;
+    return print_position(Pvt_Geometry_Strings(position, print_average_values));
+}
 
-    if (print_average_values == false)
-        {
-            latitude = position->get_latitude();
-            longitude = position->get_longitude();
-            height = position->get_height();
-        }
-    else
-        {
-            latitude = position->get_avg_latitude();
-            longitude = position->get_avg_longitude();
-            height = position->get_avg_height();
-        }
 
+bool GeoJSON_Printer::print_position(const Pvt_Geometry_Strings& geo)
+{
     if (geojson_file.is_open())
         {
             if (first_pos == true)
                 {
-                    geojson_file << "       [" << longitude << ", " << latitude << ", " << height << "]";
+                    geojson_file << "       [" << geo.longitude << ", " << geo.latitude << ", " << geo.height << "]";
                     first_pos = false;
                 }
             else
                 {
                     geojson_file << ",\n";
-                    geojson_file << "       [" << longitude << ", " << latitude << ", " << height << "]";
+                    geojson_file << "       [" << geo.longitude << ", " << geo.latitude << ", " << geo.height << "]";
                 }
             return true;
         }
@@ -20,6 +20,7 @@
 #define GNSS_SDR_GEOJSON_PRINTER_H
 
 
+#include "pvt_geometry_strings.h"
 #include <fstream>
 #include <string>
 
@@ -43,6 +44,7 @@ public:
     ~GeoJSON_Printer();
     bool set_headers(const std::string& filename, bool time_tag_name = true);
     bool print_position(const Pvt_Solution* const position, bool print_average_values);
+    bool print_position(const Pvt_Geometry_Strings& geo);  //!< Write a fix already formatted by Pvt_Geometry_Strings
     bool close_file();
 
 private:
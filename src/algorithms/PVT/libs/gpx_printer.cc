@@ -163,47 +163,22 @@ bool Gpx_Printer::set_headers(const std::string& filename, bool time_tag_name)
 
 bool Gpx_Printer::print_position(const Pvt_Solution* const position, bool print_average_values)
 {
-    double latitude;
-    double longitude;
-    double height;
-
-    positions_printed = true;
+    return print_position(Pvt_Geometry_Strings(position, print_average_values));
+}
 
-    const double speed_over_ground = position->get_speed_over_ground();    // expressed in m/s
-    const double course_over_ground = position->get_course_over_ground();  // expressed in deg
 
-    const double hdop = position->get_hdop();
-    const double vdop = position->get_vdop();
-    const double pdop = position->get_pdop();
-    std::string utc_time = to_iso_extended_string(position->get_position_UTC_time());
-    if (utc_time.length() < 23)
-        {
-            utc_time += ".";
-        }
-    utc_time.resize(23, '0');  // time up to ms
-    utc_time.append("Z");      // UTC time zone
-
-    if (print_average_values == false)
-        {
-            latitude = position->get_latitude();
-            longitude = position->get_longitude();
-            height = position->get_height();
-        }
-    else
-        {
-            latitude = position->get_avg_latitude();
-            longitude = position->get_avg_longitude();
-            height = position->get_avg_height();
-        }
+bool Gpx_Printer::print_position(const Pvt_Geometry_Strings& geo)
+{
+    positions_printed = true;
 
     if (gpx_file.is_open())
         {
-            gpx_file << indent << indent << indent << "<trkpt lon=\"" << longitude << "\" lat=\"" << latitude << "\"><ele>" << height << "</ele>"
-                     << "<time>" << utc_time << "</time>"
-                     << "<hdop>" << hdop << "</hdop><vdop>" << vdop << "</vdop><pdop>" << pdop << "</pdop>"
+            gpx_file << indent << indent << indent << "<trkpt lon=\"" << geo.longitude << "\" lat=\"" << geo.latitude << "\"><ele>" << geo.height << "</ele>"
+                     << "<time>" << geo.utc_time << "</time>"
+                     << "<hdop>" << geo.hdop << "</hdop><vdop>" << geo.vdop << "</vdop><pdop>" << geo.pdop << "</pdop>"
                      << "<extensions><gpxtpx:TrackPointExtension>"
-                     << "<gpxtpx:speed>" << speed_over_ground << "</gpxtpx:speed>"
-                     << "<gpxtpx:course>" << course_over_ground << "</gpxtpx:course>"
+                     << "<gpxtpx:speed>" << geo.speed_over_ground << "</gpxtpx:speed>"
+                     << "<gpxtpx:course>" << geo.course_over_ground << "</gpxtpx:course>"
                      << "</gpxtpx:TrackPointExtension></extensions></trkpt>\n";
             return true;
         }
@@ -0,0 +1,430 @@
+/*!
+ * \file has_correction_store.cc
+ * \brief Incremental store of Galileo HAS orbit/clock/bias corrections
+ * feeding the RTKLIB SSR correction slots.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "has_correction_store.h"
+#include "rtklib_rtkcmn.h"
+#include <glog/logging.h>
+#include <cmath>  // for fmod
+
+namespace
+{
+// HAS SIS ICD v1.2 scale factors
+constexpr double HAS_DELTA_RADIAL_SCALE_M = 0.0025;
+constexpr double HAS_DELTA_TRACK_SCALE_M = 0.0080;
+constexpr double HAS_DELTA_CLOCK_C0_SCALE_M = 0.0025;
+constexpr double HAS_CODE_BIAS_SCALE_M = 0.02;
+
+// "data not available" sentinels (most negative value of each field)
+constexpr int16_t HAS_RADIAL_NOT_AVAILABLE = -4096;
+constexpr int16_t HAS_TRACK_NOT_AVAILABLE = -2048;
+constexpr int16_t HAS_CLOCK_NOT_AVAILABLE = -4096;
+constexpr int16_t HAS_CODE_BIAS_NOT_AVAILABLE = -1024;
+
+constexpr uint8_t HAS_GNSS_ID_GPS = 0;
+constexpr uint8_t HAS_GNSS_ID_GALILEO = 2;
+
+constexpr int HAS_SATS_PER_MASK = 40;
+constexpr int HAS_SIGNALS_PER_MASK = 16;
+}  // namespace
+
+
+gtime_t Has_Correction_Store::toh_to_time(uint16_t toh)
+{
+    // toh counts seconds within the current hour; anchor it to the hour of
+    // the receiver host clock, which is amply within the +/-30 min window
+    int week = 0;
+    const gtime_t now = utc2gpst(timeget());
+    const double tow = time2gpst(now, &week);
+    double toh_tow = tow - std::fmod(tow, 3600.0) + static_cast<double>(toh);
+    if (toh_tow > tow + 1800.0)
+        {
+            toh_tow -= 3600.0;
+        }
+    else if (toh_tow < tow - 1800.0)
+        {
+            toh_tow += 3600.0;
+        }
+    return gpst2time(week, toh_tow);
+}
+
+
+double Has_Correction_Store::validity_interval_s(uint8_t validity_index)
+{
+    // HAS SIS ICD v1.2, validity interval table (index 15 is reserved)
+    constexpr double table[16] = {5.0, 10.0, 15.0, 20.0, 30.0, 60.0, 90.0, 120.0,
+        180.0, 240.0, 300.0, 600.0, 900.0, 1800.0, 3600.0, 3600.0};
+    return table[validity_index & 0x0F];
+}
+
+
+uint32_t Has_Correction_Store::signal_index_to_code(uint8_t gnss_id, int signal_index)
+{
+    // HAS SIS ICD v1.2 signal masks, mapped to the RTKLIB observation codes
+    if (gnss_id == HAS_GNSS_ID_GPS)
+        {
+            switch (signal_index)
+                {
+                case 0:
+                    return CODE_L1C;  // L1 C/A
+                case 3:
+                    return CODE_L1S;  // L1C(D)
+                case 4:
+                    return CODE_L1L;  // L1C(P)
+                case 5:
+                    return CODE_L1X;  // L1C(D+P)
+                case 6:
+                    return CODE_L2S;  // L2 CM
+                case 7:
+                    return CODE_L2L;  // L2 CL
+                case 8:
+                    return CODE_L2X;  // L2 CM+CL
+                case 9:
+                    return CODE_L2P;  // L2 P
+                case 11:
+                    return CODE_L5I;  // L5 I
+                case 12:
+                    return CODE_L5Q;  // L5 Q
+                case 13:
+                    return CODE_L5X;  // L5 I+Q
+                default:
+                    return CODE_NONE;
+                }
+        }
+    if (gnss_id == HAS_GNSS_ID_GALILEO)
+        {
+            switch (signal_index)
+                {
+                case 0:
+                    return CODE_L1B;  // E1-B
+                case 1:
+                    return CODE_L1C;  // E1-C
+                case 2:
+                    return CODE_L1X;  // E1-B+C
+                case 3:
+                    return CODE_L5I;  // E5a-I
+                case 4:
+                    return CODE_L5Q;  // E5a-Q
+                case 5:
+                    return CODE_L5X;  // E5a-I+Q
+                case 6:
+                    return CODE_L7I;  // E5b-I
+                case 7:
+                    return CODE_L7Q;  // E5b-Q
+                case 8:
+                    return CODE_L7X;  // E5b-I+Q
+                case 9:
+                    return CODE_L8I;  // E5-I
+                case 10:
+                    return CODE_L8Q;  // E5-Q
+                case 11:
+                    return CODE_L8X;  // E5-I+Q
+                case 12:
+                    return CODE_L6B;  // E6-B
+                case 13:
+                    return CODE_L6C;  // E6-C
+                case 14:
+                    return CODE_L6X;  // E6-B+C
+                default:
+                    return CODE_NONE;
+                }
+        }
+    return CODE_NONE;
+}
+
+
+Has_Correction_Store::Has_Mask_Entry Has_Correction_Store::build_mask(const Galileo_HAS_data& has_data) const
+{
+    Has_Mask_Entry entry;
+    entry.signals.resize(has_data.Nsys);
+    entry.cell_mask.resize(has_data.Nsys);
+    entry.cell_mask_available.resize(has_data.Nsys);
+    entry.sats_per_system.resize(has_data.Nsys);
+    for (uint8_t sys = 0; sys < has_data.Nsys; sys++)
+        {
+            const uint8_t gnss_id = has_data.gnss_id_mask[sys];
+            int rtklib_sys = SYS_NONE;
+            if (gnss_id == HAS_GNSS_ID_GPS)
+                {
+                    rtklib_sys = SYS_GPS;
+                }
+            else if (gnss_id == HAS_GNSS_ID_GALILEO)
+                {
+                    rtklib_sys = SYS_GAL;
+                }
+            int sats_this_system = 0;
+            for (int bit = 0; bit < HAS_SATS_PER_MASK; bit++)
+                {
+                    if ((has_data.satellite_mask[sys] & (uint64_t(1) << (HAS_SATS_PER_MASK - 1 - bit))) != 0)
+                        {
+                            // keep a slot even for systems this store cannot map,
+                            // so the correction vectors stay aligned to the mask
+                            entry.sats.push_back(rtklib_sys != SYS_NONE ? satno(rtklib_sys, bit + 1) : 0);
+                            entry.system_of_sat.push_back(sys);
+                            sats_this_system++;
+                        }
+                }
+            entry.sats_per_system[sys] = sats_this_system;
+            for (int bit = 0; bit < HAS_SIGNALS_PER_MASK; bit++)
+                {
+                    if ((has_data.signal_mask[sys] & (uint16_t(1) << (HAS_SIGNALS_PER_MASK - 1 - bit))) != 0)
+                        {
+                            entry.signals[sys].push_back(signal_index_to_code(gnss_id, bit));
+                        }
+                }
+            entry.cell_mask_available[sys] = has_data.cell_mask_availability_flag[sys];
+            if (entry.cell_mask_available[sys])
+                {
+                    entry.cell_mask[sys].resize(sats_this_system);
+                    for (int s = 0; s < sats_this_system; s++)
+                        {
+                            entry.cell_mask[sys][s].resize(entry.signals[sys].size());
+                            for (size_t c = 0; c < entry.signals[sys].size(); c++)
+                                {
+                                    entry.cell_mask[sys][s][c] = has_data.cell_mask[sys][s][c];
+                                }
+                        }
+                }
+        }
+    return entry;
+}
+
+
+void Has_Correction_Store::update(const Galileo_HAS_data& has_data)
+{
+    if (has_data.header.mask_flag)
+        {
+            d_masks[has_data.header.mask_id] = build_mask(has_data);
+        }
+    const auto mask_it = d_masks.find(has_data.header.mask_id);
+    if (mask_it == d_masks.cend())
+        {
+            // the referenced mask was broadcast before this receiver started
+            DLOG(INFO) << "HAS message with unknown mask id " << static_cast<int>(has_data.header.mask_id) << ", waiting for a mask";
+            return;
+        }
+    const Has_Mask_Entry& mask = mask_it->second;
+    const int nsat = static_cast<int>(mask.sats.size());
+    const int iod_set = has_data.header.iod_id;
+
+    if (has_data.header.orbit_correction_flag)
+        {
+            const gtime_t t0 = toh_to_time(has_data.header.toh);
+            const double udi = validity_interval_s(has_data.validity_interval_index_orbit_corrections);
+            for (int i = 0; i < nsat; i++)
+                {
+                    if (mask.sats[i] == 0 || has_data.delta_radial[i] == HAS_RADIAL_NOT_AVAILABLE ||
+                        has_data.delta_along_track[i] == HAS_TRACK_NOT_AVAILABLE ||
+                        has_data.delta_cross_track[i] == HAS_TRACK_NOT_AVAILABLE)
+                        {
+                            continue;
+                        }
+                    Has_Sat_Correction& corr = d_corrections[mask.sats[i]];
+                    corr.t0_orbit = t0;
+                    corr.udi_orbit = udi;
+                    corr.iod_set_orbit = iod_set;
+                    corr.iode = has_data.gnss_iod[i];
+                    corr.deph[0] = static_cast<double>(has_data.delta_radial[i]) * HAS_DELTA_RADIAL_SCALE_M;
+                    corr.deph[1] = static_cast<double>(has_data.delta_along_track[i]) * HAS_DELTA_TRACK_SCALE_M;
+                    corr.deph[2] = static_cast<double>(has_data.delta_cross_track[i]) * HAS_DELTA_TRACK_SCALE_M;
+                    if (corr.has_clock && !corr.has_orbit)
+                        {
+                            d_complete_corrections++;
+                        }
+                    corr.has_orbit = true;
+                }
+        }
+
+    if (has_data.header.clock_fullset_flag)
+        {
+            const gtime_t t0 = toh_to_time(has_data.header.toh);
+            const double udi = validity_interval_s(has_data.validity_interval_index_clock_fullset_corrections);
+            for (int i = 0; i < nsat; i++)
+                {
+                    if (mask.sats[i] == 0 || has_data.delta_clock_c0[i] == HAS_CLOCK_NOT_AVAILABLE)
+                        {
+                            continue;
+                        }
+                    // the clock multiplier is broadcast for all systems but Galileo
+                    const int sys = mask.system_of_sat[i];
+                    double multiplier = 1.0;
+                    if (has_data.gnss_id_mask[sys] != HAS_GNSS_ID_GALILEO)
+                        {
+                            multiplier = static_cast<double>(has_data.delta_clock_c0_multiplier[sys]) + 1.0;
+                        }
+                    Has_Sat_Correction& corr = d_corrections[mask.sats[i]];
+                    corr.t0_clock = t0;
+                    corr.udi_clock = udi;
+                    corr.iod_set_clock = iod_set;
+                    if (corr.has_orbit && !corr.has_clock)
+                        {
+                            d_complete_corrections++;
+                        }
+                    corr.dclk = static_cast<double>(has_data.delta_clock_c0[i]) * HAS_DELTA_CLOCK_C0_SCALE_M * multiplier;
+                    corr.has_clock = true;
+                }
+        }
+
+    if (has_data.header.clock_subset_flag)
+        {
+            const gtime_t t0 = toh_to_time(has_data.header.toh);
+            const double udi = validity_interval_s(has_data.validity_interval_index_clock_subset_corrections);
+            int value_index = 0;
+            for (uint8_t sysprime = 0; sysprime < has_data.Nsysprime; sysprime++)
+                {
+                    // locate the masked system this subset refers to
+                    int sys = -1;
+                    int first_sat_of_sys = 0;
+                    for (uint8_t s = 0; s < has_data.Nsys; s++)
+                        {
+                            if (has_data.gnss_id_mask[s] == has_data.gnss_id_clock_subset[sysprime])
+                                {
+                                    sys = s;
+                                    break;
+                                }
+                            first_sat_of_sys += mask.sats_per_system[s];
+                        }
+                    if (sys < 0)
+                        {
+                            continue;
+                        }
+                    double multiplier = 1.0;
+                    if (has_data.gnss_id_clock_subset[sysprime] != HAS_GNSS_ID_GALILEO)
+                        {
+                            multiplier = static_cast<double>(has_data.delta_clock_c0_multiplier_clock_subset[sysprime]) + 1.0;
+                        }
+                    for (int j = 0; j < mask.sats_per_system[sys]; j++)
+                        {
+                            if (has_data.satellite_submask[sysprime][j] == 0)
+                                {
+                                    continue;
+                                }
+                            const int16_t value = has_data.delta_clock_c0_clock_subset[value_index++];
+                            const int sat = mask.sats[first_sat_of_sys + j];
+                            if (sat == 0 || value == HAS_CLOCK_NOT_AVAILABLE)
+                                {
+                                    continue;
+                                }
+                            Has_Sat_Correction& corr = d_corrections[sat];
+                            corr.t0_clock = t0;
+                            corr.udi_clock = udi;
+                            corr.iod_set_clock = iod_set;
+                            if (corr.has_orbit && !corr.has_clock)
+                                {
+                                    d_complete_corrections++;
+                                }
+                            corr.dclk = static_cast<double>(value) * HAS_DELTA_CLOCK_C0_SCALE_M * multiplier;
+                            corr.has_clock = true;
+                        }
+                }
+        }
+
+    if (has_data.header.code_bias_flag)
+        {
+            const gtime_t t0 = toh_to_time(has_data.header.toh);
+            const double udi = validity_interval_s(has_data.validity_interval_index_code_bias_corrections);
+            std::vector<int> first_sat_of_system(mask.sats_per_system.size(), 0);
+            for (size_t s = 1; s < mask.sats_per_system.size(); s++)
+                {
+                    first_sat_of_system[s] = first_sat_of_system[s - 1] + mask.sats_per_system[s - 1];
+                }
+            for (int i = 0; i < nsat; i++)
+                {
+                    const int sys = mask.system_of_sat[i];
+                    const int sat_in_sys = i - first_sat_of_system[sys];
+                    for (size_t c = 0; c < mask.signals[sys].size(); c++)
+                        {
+                            if (mask.cell_mask_available[sys] && !mask.cell_mask[sys][sat_in_sys][c])
+                                {
+                                    continue;
+                                }
+                            const int16_t value = has_data.code_bias[i][c];
+                            const uint32_t code = mask.signals[sys][c];
+                            if (mask.sats[i] == 0 || code == CODE_NONE || value == HAS_CODE_BIAS_NOT_AVAILABLE)
+                                {
+                                    continue;
+                                }
+                            Has_Sat_Correction& corr = d_corrections[mask.sats[i]];
+                            corr.t0_bias = t0;
+                            corr.udi_bias = udi;
+                            corr.cbias[code - 1] = static_cast<float>(static_cast<double>(value) * HAS_CODE_BIAS_SCALE_M);
+                            corr.has_bias = true;
+                        }
+                }
+        }
+
+    if (has_data.header.ura_flag)
+        {
+            for (int i = 0; i < nsat; i++)
+                {
+                    if (mask.sats[i] == 0)
+                        {
+                            continue;
+                        }
+                    d_corrections[mask.sats[i]].ura = has_data.ura[i];
+                }
+        }
+}
+
+
+int Has_Correction_Store::apply(nav_t* nav) const
+{
+    int applied = 0;
+    for (const auto& item : d_corrections)
+        {
+            const int sat = item.first;
+            if (sat <= 0 || sat > MAXSAT)
+                {
+                    continue;
+                }
+            const Has_Sat_Correction& corr = item.second;
+            if (!corr.has_orbit || !corr.has_clock)
+                {
+                    // satpos_ssr() needs both; keep the partial state cached
+                    // until the missing block arrives
+                    continue;
+                }
+            ssr_t& ssr = nav->ssr[sat - 1];
+            ssr.t0[0] = corr.t0_orbit;
+            ssr.t0[1] = corr.t0_clock;
+            ssr.t0[4] = corr.t0_bias;
+            ssr.udi[0] = corr.udi_orbit;
+            ssr.udi[1] = corr.udi_clock;
+            ssr.udi[4] = corr.udi_bias;
+            ssr.iod[0] = corr.iod_set_orbit;
+            ssr.iod[1] = corr.iod_set_clock;
+            ssr.iode = corr.iode;
+            ssr.deph[0] = corr.deph[0];
+            ssr.deph[1] = corr.deph[1];
+            ssr.deph[2] = corr.deph[2];
+            ssr.ddeph[0] = 0.0;
+            ssr.ddeph[1] = 0.0;
+            ssr.ddeph[2] = 0.0;
+            ssr.dclk[0] = corr.dclk;
+            ssr.dclk[1] = 0.0;
+            ssr.dclk[2] = 0.0;
+            ssr.hrclk = 0.0;
+            for (int c = 0; c < MAXCODE; c++)
+                {
+                    ssr.cbias[c] = corr.cbias[c];
+                }
+            ssr.ura = corr.ura;
+            ssr.refd = 0;
+            ssr.update = 1;
+            applied++;
+        }
+    return applied;
+}
@@ -0,0 +1,108 @@
+/*!
+ * \file has_correction_store.h
+ * \brief Incremental store of Galileo HAS orbit/clock/bias corrections
+ * feeding the RTKLIB SSR correction slots.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_HAS_CORRECTION_STORE_H
+#define GNSS_SDR_HAS_CORRECTION_STORE_H
+
+#include "galileo_has_data.h"
+#include "gnss_obs_codes.h"
+#include "rtklib.h"
+#include <cstdint>
+#include <map>
+#include <set>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Per-satellite cache of Galileo HAS corrections.
+ *
+ * HAS message type 1 carries independent blocks (mask, orbit, clock
+ * full-set, clock subset, code bias) that arrive at different rates and
+ * reference a previously broadcast mask. update() merges each received
+ * block into the cached satellite states, and apply() writes only the
+ * satellites touched since the last call into the ssr array of a RTKLIB
+ * nav_t, where satpos_ssr() consumes them when the solver runs with an
+ * SSR ephemeris option. No full recompute is ever performed.
+ */
+class Has_Correction_Store
+{
+public:
+    Has_Correction_Store() = default;
+
+    //! Merges one HAS message type 1 into the cached satellite states
+    void update(const Galileo_HAS_data& has_data);
+
+    //! Writes the cached corrections into nav->ssr. Returns the number of satellites written
+    int apply(nav_t* nav) const;
+
+    //! True once at least one satellite has a complete orbit + clock correction
+    inline bool has_corrections() const
+    {
+        return d_complete_corrections > 0;
+    }
+
+private:
+    struct Has_Mask_Entry
+    {
+        std::vector<int> sats;                        // RTKLIB satellite numbers, mask order
+        std::vector<int> system_of_sat;               // index into the Nsys systems for each satellite
+        std::vector<std::vector<uint32_t>> signals;   // per system, observation codes in mask order
+        std::vector<std::vector<std::vector<bool>>> cell_mask;
+        std::vector<bool> cell_mask_available;
+        std::vector<int> sats_per_system;
+    };
+
+    struct Has_Sat_Correction
+    {
+        gtime_t t0_orbit{};
+        gtime_t t0_clock{};
+        gtime_t t0_bias{};
+        double udi_orbit = 0.0;
+        double udi_clock = 0.0;
+        double udi_bias = 0.0;
+        int iod_set_orbit = -1;
+        int iod_set_clock = -1;
+        int iode = -1;
+        double deph[3] = {0.0, 0.0, 0.0};
+        double dclk = 0.0;
+        float cbias[MAXCODE] = {};
+        int ura = 0;
+        bool has_orbit = false;
+        bool has_clock = false;
+        bool has_bias = false;
+    };
+
+    static gtime_t toh_to_time(uint16_t toh);
+    static double validity_interval_s(uint8_t validity_index);
+    static uint32_t signal_index_to_code(uint8_t gnss_id, int signal_index);
+
+    Has_Mask_Entry build_mask(const Galileo_HAS_data& has_data) const;
+
+    std::map<uint8_t, Has_Mask_Entry> d_masks;  // keyed by mask_id
+    std::map<int, Has_Sat_Correction> d_corrections;
+    int d_complete_corrections = 0;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_HAS_CORRECTION_STORE_H
@@ -232,38 +232,13 @@ bool Kml_Printer::set_headers(const std::string& filename, bool time_tag_name)
 
 bool Kml_Printer::print_position(const Pvt_Solution* const position, bool print_average_values)
 {
-    double latitude;
-    double longitude;
-    double height;
-
-    positions_printed = true;
+    return print_position(Pvt_Geometry_Strings(position, print_average_values));
+}
 
-    const double speed_over_ground = position->get_speed_over_ground();    // expressed in m/s
-    const double course_over_ground = position->get_course_over_ground();  // expressed in deg
 
-    const double hdop = position->get_hdop();
-    const double vdop = position->get_vdop();
-    const double pdop = position->get_pdop();
-    std::string utc_time = to_iso_extended_string(position->get_position_UTC_time());
-    if (utc_time.length() < 23)
-        {
-            utc_time += ".";
-        }
-    utc_time.resize(23, '0');  // time up to ms
-    utc_time.append("Z");      // UTC time zone
-
-    if (print_average_values == false)
-        {
-            latitude = position->get_latitude();
-            longitude = position->get_longitude();
-            height = position->get_height();
-        }
-    else
-        {
-            latitude = position->get_avg_latitude();
-            longitude = position->get_avg_longitude();
-            height = position->get_avg_height();
-        }
+bool Kml_Printer::print_position(const Pvt_Geometry_Strings& geo)
+{
+    positions_printed = true;
 
     if (kml_file.is_open() && tmp_file.is_open())
         {
@@ -273,29 +248,29 @@ bool Kml_Printer::print_position(const Pvt_Solution* const position, bool print_
                      << indent << indent << indent << indent << "<snippet/>\n"
                      << indent << indent << indent << indent << "<description><![CDATA[\n"
                      << indent << indent << indent << indent << indent << "<table>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Time:</td><td>" << utc_time << "</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Longitude:</td><td>" << longitude << "</td><td>deg</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Latitude:</td><td>" << latitude << "</td><td>deg</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Altitude:</td><td>" << height << "</td><td>m</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Speed:</td><td>" << speed_over_ground << "</td><td>m/s</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Course:</td><td>" << course_over_ground << "</td><td>deg</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>HDOP:</td><td>" << hdop << "</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>VDOP:</td><td>" << vdop << "</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>PDOP:</td><td>" << pdop << "</td></tr>\n"
+                     << indent << indent << indent << indent << indent << indent << "<tr><td>Time:</td><td>" << geo.utc_time << "</td></tr>\n"
+                     << indent << indent << indent << indent << indent << indent << "<tr><td>Longitude:</td><td>" << geo.longitude << "</td><td>deg</td></tr>\n"
+                     << indent << indent << indent << indent << indent << indent << "<tr><td>Latitude:</td><td>" << geo.latitude << "</td><td>deg</td></tr>\n"
+                     << indent << indent << indent << indent << indent << indent << "<tr><td>Altitude:</td><td>" << geo.height << "</td><td>m</td></tr>\n"
+                     << indent << indent << indent << indent << indent << indent << "<tr><td>Speed:</td><td>" << geo.speed_over_ground << "</td><td>m/s</td></tr>\n"
+                     << indent << indent << indent << indent << indent << indent << "<tr><td>Course:</td><td>" << geo.course_over_ground << "</td><td>deg</td></tr>\n"
+                     << indent << indent << indent << indent << indent << indent << "<tr><td>HDOP:</td><td>" << geo.hdop << "</td></tr>\n"
+                     << indent << indent << indent << indent << indent << indent << "<tr><td>VDOP:</td><td>" << geo.vdop << "</td></tr>\n"
+                     << indent << indent << indent << indent << indent << indent << "<tr><td>PDOP:</td><td>" << geo.pdop << "</td></tr>\n"
                      << indent << indent << indent << indent << indent << "</table>\n"
                      << indent << indent << indent << indent << "]]></description>\n"
                      << indent << indent << indent << indent << "<TimeStamp>\n"
-                     << indent << indent << indent << indent << indent << "<when>" << utc_time << "</when>\n"
+                     << indent << indent << indent << indent << indent << "<when>" << geo.utc_time << "</when>\n"
                      << indent << indent << indent << indent << "</TimeStamp>\n"
                      << indent << indent << indent << indent << "<styleUrl>#track</styleUrl>\n"
                      << indent << indent << indent << indent << "<Point>\n"
                      << indent << indent << indent << indent << indent << "<altitudeMode>absolute</altitudeMode>\n"
-                     << indent << indent << indent << indent << indent << "<coordinates>" << longitude << "," << latitude << "," << height << "</coordinates>\n"
+                     << indent << indent << indent << indent << indent << "<coordinates>" << geo.longitude << "," << geo.latitude << "," << geo.height << "</coordinates>\n"
                      << indent << indent << indent << indent << "</Point>\n"
                      << indent << indent << indent << "</Placemark>\n";
 
             tmp_file << indent << indent << indent << indent << indent
-                     << longitude << "," << latitude << "," << height << '\n';
+                     << geo.longitude << "," << geo.latitude << "," << geo.height << '\n';
 
             return true;
         }
@@ -19,6 +19,7 @@
 #ifndef GNSS_SDR_KML_PRINTER_H
 #define GNSS_SDR_KML_PRINTER_H
 
+#include "pvt_geometry_strings.h"
 #include <fstream>  // for ofstream
 #include <string>
 
@@ -42,6 +43,7 @@ public:
     ~Kml_Printer();
     bool set_headers(const std::string& filename, bool time_tag_name = true);
     bool print_position(const Pvt_Solution* const position, bool print_average_values);
+    bool print_position(const Pvt_Geometry_Strings& geo);  //!< Write a fix already formatted by Pvt_Geometry_Strings
     bool close_file();
 
 private:
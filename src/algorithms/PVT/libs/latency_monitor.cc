@@ -0,0 +1,125 @@
+/*!
+ * \file latency_monitor.cc
+ * \brief Tracks the RF-sample-to-solution latency budget and publishes
+ * per-stage histograms over UDP.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "latency_monitor.h"
+#include <glog/logging.h>
+#include <chrono>
+#include <cmath>
+
+
+void Latency_Monitor::init(const std::string& address, uint16_t port, double budget_ms, int32_t report_interval_epochs)
+{
+    if (budget_ms > 0.0)
+        {
+            d_budget_ms = budget_ms;
+        }
+    if (report_interval_epochs > 0)
+        {
+            d_report_interval_epochs = report_interval_epochs;
+        }
+    d_io_context = std::make_unique<b_lat_io_context>();
+    d_socket = std::make_unique<boost::asio::ip::udp::socket>(*d_io_context);
+    boost::system::error_code ec;
+    d_endpoint = boost::asio::ip::udp::endpoint(boost::asio::ip::address::from_string(address, ec), port);
+    if (ec)
+        {
+            LOG(WARNING) << "Invalid latency monitor address " << address << ": " << ec.message();
+            return;
+        }
+    d_socket->open(d_endpoint.protocol(), ec);
+    if (ec)
+        {
+            LOG(WARNING) << "Could not open latency monitor socket: " << ec.message();
+            return;
+        }
+    d_enabled = true;
+    LOG(INFO) << "Latency histograms will be published to " << address << ":" << port
+              << " every " << d_report_interval_epochs << " epochs, budget " << d_budget_ms << " ms";
+}
+
+
+int Latency_Monitor::bin_of(double latency_ms)
+{
+    if (latency_ms < 0.125)
+        {
+            return 0;
+        }
+    const int bin = static_cast<int>(std::floor(std::log2(latency_ms / 0.125)));
+    return bin < LATENCY_HISTOGRAM_BINS ? bin : LATENCY_HISTOGRAM_BINS - 1;
+}
+
+
+void Latency_Monitor::record(uint64_t ingest_time_ns, uint64_t obs_time_ns, uint64_t now_ns)
+{
+    if (!d_enabled or ingest_time_ns == 0 or obs_time_ns < ingest_time_ns or now_ns < obs_time_ns)
+        {
+            return;
+        }
+    d_last_trk_obs_ms = static_cast<double>(obs_time_ns - ingest_time_ns) * 1e-6;
+    d_last_obs_pvt_ms = static_cast<double>(now_ns - obs_time_ns) * 1e-6;
+    d_last_total_ms = static_cast<double>(now_ns - ingest_time_ns) * 1e-6;
+    d_hist_trk_obs[bin_of(d_last_trk_obs_ms)]++;
+    d_hist_obs_pvt[bin_of(d_last_obs_pvt_ms)]++;
+    d_hist_total[bin_of(d_last_total_ms)]++;
+    d_epochs++;
+    if (d_last_total_ms > d_budget_ms)
+        {
+            d_budget_exceeded++;
+            LOG(WARNING) << "Latency budget exceeded: " << d_last_total_ms << " ms end-to-end (budget "
+                         << d_budget_ms << " ms, tracking->observables " << d_last_trk_obs_ms
+                         << " ms, observables->PVT " << d_last_obs_pvt_ms << " ms)";
+        }
+    if (d_epochs >= static_cast<uint32_t>(d_report_interval_epochs))
+        {
+            publish();
+            d_hist_trk_obs.fill(0);
+            d_hist_obs_pvt.fill(0);
+            d_hist_total.fill(0);
+            d_epochs = 0;
+        }
+}
+
+
+void Latency_Monitor::publish()
+{
+    Latency_Report report{};
+    report.magic = 0x4C544359;  // "LTCY"
+    report.version = 1;
+    report.epochs = d_epochs;
+    report.budget_exceeded = d_budget_exceeded;
+    report.budget_ms = d_budget_ms;
+    report.last_trk_obs_ms = d_last_trk_obs_ms;
+    report.last_obs_pvt_ms = d_last_obs_pvt_ms;
+    report.last_total_ms = d_last_total_ms;
+    for (int i = 0; i < LATENCY_HISTOGRAM_BINS; i++)
+        {
+            report.hist_trk_obs[i] = d_hist_trk_obs[i];
+            report.hist_obs_pvt[i] = d_hist_obs_pvt[i];
+            report.hist_total[i] = d_hist_total[i];
+        }
+    report.host_time_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+
+    boost::system::error_code ec;
+    d_socket->send_to(boost::asio::buffer(&report, sizeof(report)), d_endpoint, 0, ec);
+    if (ec)
+        {
+            LOG(WARNING) << "Failed to publish latency report: " << ec.message();
+        }
+}
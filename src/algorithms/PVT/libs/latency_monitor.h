@@ -0,0 +1,112 @@
+/*!
+ * \file latency_monitor.h
+ * \brief Tracks the RF-sample-to-solution latency budget and publishes
+ * per-stage histograms over UDP.
+ *
+ * Certifying end-to-end latency used to require PPS hardware and an
+ * oscilloscope. Every epoch is now stamped with the host wall clock when it
+ * leaves tracking and again when it leaves observables; this class closes
+ * the loop at the PVT output, bins the per-stage latencies into logarithmic
+ * histograms and periodically emits one datagram with the distribution.
+ * Epochs exceeding a configurable budget are counted and logged.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_LATENCY_MONITOR_H
+#define GNSS_SDR_LATENCY_MONITOR_H
+
+#include <boost/asio.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+#if USE_BOOST_ASIO_IO_CONTEXT
+using b_lat_io_context = boost::asio::io_context;
+#else
+using b_lat_io_context = boost::asio::io_service;
+#endif
+
+//! Histogram bins: bin i covers [0.125 * 2^i, 0.125 * 2^(i+1)) ms,
+//! from 125 us up to about 35 minutes; the edge bins absorb the tails
+inline constexpr int LATENCY_HISTOGRAM_BINS = 24;
+
+/*!
+ * \brief One latency report datagram. Native byte order.
+ */
+struct Latency_Report
+{
+    uint32_t magic;            //!< "LTCY" = 0x4C544359
+    uint8_t version;           //!< format version, currently 1
+    uint32_t epochs;           //!< epochs accumulated in this report
+    uint32_t budget_exceeded;  //!< epochs over budget since start-up
+    double budget_ms;          //!< configured end-to-end budget [ms]
+    double last_trk_obs_ms;    //!< latest tracking -> observables latency
+    double last_obs_pvt_ms;    //!< latest observables -> PVT output latency
+    double last_total_ms;      //!< latest end-to-end latency
+    uint32_t hist_trk_obs[LATENCY_HISTOGRAM_BINS];
+    uint32_t hist_obs_pvt[LATENCY_HISTOGRAM_BINS];
+    uint32_t hist_total[LATENCY_HISTOGRAM_BINS];
+    uint64_t host_time_ns;  //!< wall-clock time when the report was built
+};
+
+/*!
+ * \brief Per-stage latency histogram accumulator with a budget contract.
+ *
+ * record() is called once per PVT epoch with the ingestion (tracking) and
+ * observables wall-clock stamps carried by Gnss_Synchro; the cost per epoch
+ * is O(1) and the histograms are published (and reset) every
+ * report_interval_epochs epochs.
+ */
+class Latency_Monitor
+{
+public:
+    Latency_Monitor() = default;
+
+    //! Opens the UDP socket; histograms are streamed to address:port
+    void init(const std::string& address, uint16_t port, double budget_ms, int32_t report_interval_epochs);
+
+    //! Accumulates one epoch; now_ns is taken after all PVT outputs are written
+    void record(uint64_t ingest_time_ns, uint64_t obs_time_ns, uint64_t now_ns);
+
+private:
+    void publish();
+    static int bin_of(double latency_ms);
+
+    std::unique_ptr<b_lat_io_context> d_io_context;
+    std::unique_ptr<boost::asio::ip::udp::socket> d_socket;
+    boost::asio::ip::udp::endpoint d_endpoint;
+
+    std::array<uint32_t, LATENCY_HISTOGRAM_BINS> d_hist_trk_obs{};
+    std::array<uint32_t, LATENCY_HISTOGRAM_BINS> d_hist_obs_pvt{};
+    std::array<uint32_t, LATENCY_HISTOGRAM_BINS> d_hist_total{};
+    double d_budget_ms = 100.0;
+    double d_last_trk_obs_ms = 0.0;
+    double d_last_obs_pvt_ms = 0.0;
+    double d_last_total_ms = 0.0;
+    uint32_t d_epochs = 0;
+    uint32_t d_budget_exceeded = 0;
+    int32_t d_report_interval_epochs = 100;
+    bool d_enabled = false;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_LATENCY_MONITOR_H
@@ -0,0 +1,102 @@
+/*!
+ * \file monitor_pvt_shm_sink.cc
+ * \brief Implementation of a class that publishes the PVT solution on a
+ * shared-memory topic with a seqlock, for lock-free local consumers
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "monitor_pvt_shm_sink.h"
+#include <glog/logging.h>
+#include <fcntl.h>     // for shm_open flags
+#include <sys/mman.h>  // for mmap, shm_open, shm_unlink
+#include <unistd.h>    // for ftruncate, close
+#include <cerrno>
+#include <cstring>  // for strerror
+#include <ctime>    // for clock_gettime
+#include <type_traits>
+
+// the payload is copied into the mapping field by field with plain stores,
+// so it must not have any constructor or ownership semantics
+static_assert(std::is_trivially_copyable<Monitor_Pvt>::value,
+    "Monitor_Pvt must be trivially copyable to be published over shared memory");
+
+
+Monitor_Pvt_Shm_Sink::Monitor_Pvt_Shm_Sink(const std::string& topic_name)
+    : d_topic_name(topic_name)
+{
+    const int fd = shm_open(d_topic_name.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0)
+        {
+            LOG(WARNING) << "Failed to create shared-memory PVT topic " << d_topic_name
+                         << ": " << strerror(errno);
+            return;
+        }
+    if (ftruncate(fd, sizeof(Shm_Pvt_Topic)) != 0)
+        {
+            LOG(WARNING) << "Failed to size shared-memory PVT topic " << d_topic_name
+                         << ": " << strerror(errno);
+            close(fd);
+            shm_unlink(d_topic_name.c_str());
+            return;
+        }
+    void* mapping = mmap(nullptr, sizeof(Shm_Pvt_Topic), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // the mapping keeps the segment alive
+    if (mapping == MAP_FAILED)
+        {
+            LOG(WARNING) << "Failed to map shared-memory PVT topic " << d_topic_name
+                         << ": " << strerror(errno);
+            shm_unlink(d_topic_name.c_str());
+            return;
+        }
+    d_topic = static_cast<Shm_Pvt_Topic*>(mapping);
+    d_topic->sequence.store(0, std::memory_order_relaxed);
+    d_topic->magic = 0x50565453;  // "PVTS"
+    d_topic->version = 1;
+    d_topic->payload_size = sizeof(Monitor_Pvt);
+    d_topic->host_time_ns = 0;
+    d_topic->solve_counter = 0;
+    LOG(INFO) << "PVT shared-memory topic created at " << d_topic_name
+              << " (" << sizeof(Shm_Pvt_Topic) << " bytes)";
+}
+
+
+Monitor_Pvt_Shm_Sink::~Monitor_Pvt_Shm_Sink()
+{
+    if (d_topic != nullptr)
+        {
+            munmap(d_topic, sizeof(Shm_Pvt_Topic));
+            shm_unlink(d_topic_name.c_str());
+        }
+}
+
+
+bool Monitor_Pvt_Shm_Sink::write_monitor_pvt(const Monitor_Pvt* monitor_pvt)
+{
+    if (d_topic == nullptr)
+        {
+            return false;
+        }
+    struct timespec ts
+    {
+    };
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    // seqlock write: readers retry while the sequence is odd or changes
+    // across their copy, so the payload is written with plain stores
+    d_topic->sequence.fetch_add(1, std::memory_order_acquire);
+    d_topic->host_time_ns = static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+    d_topic->solve_counter = ++d_solve_counter;
+    d_topic->pvt = *monitor_pvt;
+    d_topic->sequence.fetch_add(1, std::memory_order_release);
+    return true;
+}
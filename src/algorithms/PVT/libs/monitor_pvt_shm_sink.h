@@ -0,0 +1,77 @@
+/*!
+ * \file monitor_pvt_shm_sink.h
+ * \brief Interface of a class that publishes the PVT solution on a
+ * shared-memory topic with a seqlock, for lock-free local consumers
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MONITOR_PVT_SHM_SINK_H
+#define GNSS_SDR_MONITOR_PVT_SHM_SINK_H
+
+#include "monitor_pvt.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Fixed layout of the shared-memory position topic.
+ *
+ * Readers map the segment read-only and copy the payload between two reads
+ * of \a sequence: an odd value or a value that changed across the copy means
+ * a write was in flight and the copy must be retried. No syscall or lock is
+ * involved on the read side, so a consumer pays well under a microsecond per
+ * fix instead of a serial/socket round trip.
+ */
+struct Shm_Pvt_Topic
+{
+    std::atomic<uint32_t> sequence;  // odd while a write is in progress
+    uint32_t magic;                  // 0x50565453 ("PVTS")
+    uint32_t version;                // layout version, currently 1
+    uint32_t payload_size;           // sizeof(Monitor_Pvt), layout check for readers
+    uint64_t host_time_ns;           // CLOCK_REALTIME at publication [ns]
+    uint64_t solve_counter;          // number of solutions published so far
+    Monitor_Pvt pvt;                 // the solution itself
+};
+
+
+/*!
+ * \brief This class publishes the content of a Monitor_Pvt object in a
+ * POSIX shared-memory segment, updated in place once per solution.
+ */
+class Monitor_Pvt_Shm_Sink
+{
+public:
+    explicit Monitor_Pvt_Shm_Sink(const std::string& topic_name);
+    ~Monitor_Pvt_Shm_Sink();
+
+    Monitor_Pvt_Shm_Sink(const Monitor_Pvt_Shm_Sink&) = delete;
+    Monitor_Pvt_Shm_Sink& operator=(const Monitor_Pvt_Shm_Sink&) = delete;
+
+    bool write_monitor_pvt(const Monitor_Pvt* monitor_pvt);
+
+private:
+    std::string d_topic_name;
+    Shm_Pvt_Topic* d_topic = nullptr;
+    uint64_t d_solve_counter = 0;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MONITOR_PVT_SHM_SINK_H
@@ -27,6 +27,7 @@ Pvt_Conf::Pvt_Conf()
     nmea_rate_ms = 1000;
 
     max_obs_block_rx_clock_offset_ms = 40;
+    sysv_msg_key = 1101;
     rinex_version = 0;
     rinexobs_rate_ms = 0;
     rinex_name = "-";
@@ -34,6 +35,11 @@ Pvt_Conf::Pvt_Conf()
     dump = false;
     dump_mat = true;
 
+    enable_work_monitor = false;
+    work_monitor_addresses = std::string("127.0.0.1");
+    work_monitor_port = 1237;
+    work_monitor_interval_calls = 1000;
+
     flag_nmea_tty_port = false;
 
     flag_rtcm_server = false;
@@ -41,6 +47,11 @@ Pvt_Conf::Pvt_Conf()
     rtcm_tcp_port = 0U;
     rtcm_station_id = 0U;
 
+    rtcm_base_enabled = false;
+    rtcm_base_address = std::string("127.0.0.1");
+    rtcm_base_port = 2101U;
+    rtcm_base_max_age_s = 30.0;
+
     output_enabled = true;
     rinex_output_enabled = true;
     gpx_output_enabled = true;
@@ -60,9 +71,23 @@ Pvt_Conf::Pvt_Conf()
     rtcm_output_file_path = std::string(".");
 
     enable_rx_clock_correction = true;
+    enable_asynchronous_output = false;
     monitor_enabled = false;
     protobuf_enabled = true;
     udp_port = 0;
     pre_2009_file = false;
     show_local_time_zone = false;
+    clock_steering_socket = std::string("/tmp/gnss_sdr_clock.sock");
+    enable_clock_steering_output = false;
+    shm_topic_name = std::string("/gnss_sdr_pvt");
+    enable_shm_topic = false;
+    attitude_baseline_m = 0.0;
+    enable_attitude = false;
+    max_dead_reckoning_s = 5.0;
+    enable_dead_reckoning = false;
+    latency_address = std::string("127.0.0.1");
+    latency_budget_ms = 100.0;
+    latency_report_interval_epochs = 100;
+    latency_port = 1266U;
+    enable_latency_monitor = false;
 }
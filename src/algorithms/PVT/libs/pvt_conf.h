@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 /** \addtogroup PVT
  * \{ */
@@ -59,11 +60,18 @@ public:
     int32_t rinex_version;
     int32_t rinexobs_rate_ms;
     int32_t max_obs_block_rx_clock_offset_ms;
+    int32_t sysv_msg_key;
     int udp_port;
 
     uint16_t rtcm_tcp_port;
     uint16_t rtcm_station_id;
 
+    // RTCM base station input for the differential positioning modes
+    std::string rtcm_base_address;
+    double rtcm_base_max_age_s;
+    uint16_t rtcm_base_port;
+    bool rtcm_base_enabled;
+
     bool flag_nmea_tty_port;
     bool flag_rtcm_server;
     bool flag_rtcm_tty_port;
@@ -78,10 +86,39 @@ public:
     bool monitor_enabled;
     bool protobuf_enabled;
     bool enable_rx_clock_correction;
+    bool enable_asynchronous_output;
     bool show_local_time_zone;
     bool pre_2009_file;
+
+    // shared-memory position topic for local low-latency consumers
+    std::string shm_topic_name;
+    bool enable_shm_topic;
+
+    // dual-antenna baseline/attitude solver
+    std::vector<int32_t> antenna_of_channel;
+    double attitude_baseline_m;
+    bool enable_attitude;
+
+    // Doppler-aided dead reckoning during outages
+    double max_dead_reckoning_s;
+    bool enable_dead_reckoning;
+
+    // end-to-end latency budget monitor
+    std::string latency_address;
+    double latency_budget_ms;
+    int32_t latency_report_interval_epochs;
+    uint16_t latency_port;
+    bool enable_latency_monitor;
     bool dump;
     bool dump_mat;
+
+    std::string work_monitor_addresses;
+    uint32_t work_monitor_interval_calls;
+    uint16_t work_monitor_port;
+    bool enable_work_monitor;
+
+    std::string clock_steering_socket;
+    bool enable_clock_steering_output;
 };
 
 
@@ -0,0 +1,91 @@
+/*!
+ * \file pvt_ephemeris_snapshot.h
+ * \brief Immutable snapshot of the navigation data consumed by a PVT solver.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_EPHEMERIS_SNAPSHOT_H
+#define GNSS_SDR_PVT_EPHEMERIS_SNAPSHOT_H
+
+#include "beidou_dnav_almanac.h"
+#include "beidou_dnav_ephemeris.h"
+#include "beidou_dnav_iono.h"
+#include "beidou_dnav_utc_model.h"
+#include "galileo_almanac.h"
+#include "galileo_ephemeris.h"
+#include "galileo_iono.h"
+#include "galileo_utc_model.h"
+#include "glonass_gnav_almanac.h"
+#include "glonass_gnav_ephemeris.h"
+#include "glonass_gnav_utc_model.h"
+#include "gps_almanac.h"
+#include "gps_cnav_ephemeris.h"
+#include "gps_cnav_iono.h"
+#include "gps_cnav_utc_model.h"
+#include "gps_ephemeris.h"
+#include "gps_iono.h"
+#include "gps_utc_model.h"
+#include <cstdint>
+#include <map>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Versioned, immutable copy of the ephemeris, almanac, ionosphere
+ * and UTC records held by a PVT solver.
+ *
+ * The telemetry message handlers publish a new snapshot after updating
+ * their own solver, and other threads pick it up through an atomic
+ * shared_ptr exchange instead of copying individual records under a lock.
+ * Consumers compare the version to skip the import when nothing changed.
+ */
+class Pvt_Ephemeris_Snapshot
+{
+public:
+    Pvt_Ephemeris_Snapshot() = default;
+
+    uint64_t version = 0;  //!< Monotonic counter incremented by the publisher
+
+    std::map<int, Galileo_Ephemeris> galileo_ephemeris_map;
+    std::map<int, Gps_Ephemeris> gps_ephemeris_map;
+    std::map<int, Gps_CNAV_Ephemeris> gps_cnav_ephemeris_map;
+    std::map<int, Glonass_Gnav_Ephemeris> glonass_gnav_ephemeris_map;
+    std::map<int, Beidou_Dnav_Ephemeris> beidou_dnav_ephemeris_map;
+
+    Galileo_Utc_Model galileo_utc_model;
+    Galileo_Iono galileo_iono;
+    std::map<int, Galileo_Almanac> galileo_almanac_map;
+
+    Gps_Utc_Model gps_utc_model;
+    Gps_Iono gps_iono;
+    std::map<int, Gps_Almanac> gps_almanac_map;
+
+    Gps_CNAV_Iono gps_cnav_iono;
+    Gps_CNAV_Utc_Model gps_cnav_utc_model;
+
+    Glonass_Gnav_Utc_Model glonass_gnav_utc_model;
+    Glonass_Gnav_Almanac glonass_gnav_almanac;
+
+    Beidou_Dnav_Utc_Model beidou_dnav_utc_model;
+    Beidou_Dnav_Iono beidou_dnav_iono;
+    std::map<int, Beidou_Dnav_Almanac> beidou_dnav_almanac_map;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PVT_EPHEMERIS_SNAPSHOT_H
@@ -0,0 +1,62 @@
+/*!
+ * \file pvt_geometry_strings.cc
+ * \brief Implementation of the shared position fix formatting pass
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_geometry_strings.h"
+#include "pvt_solution.h"
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <cstdio>
+
+
+Pvt_Geometry_Strings::Pvt_Geometry_Strings(const Pvt_Solution* position, bool print_average_values)
+{
+    if (print_average_values == false)
+        {
+            latitude = format(position->get_latitude());
+            longitude = format(position->get_longitude());
+            height = format(position->get_height());
+        }
+    else
+        {
+            latitude = format(position->get_avg_latitude());
+            longitude = format(position->get_avg_longitude());
+            height = format(position->get_avg_height());
+        }
+
+    speed_over_ground = format(position->get_speed_over_ground());
+    course_over_ground = format(position->get_course_over_ground());
+
+    hdop = format(position->get_hdop());
+    vdop = format(position->get_vdop());
+    pdop = format(position->get_pdop());
+
+    utc_time = to_iso_extended_string(position->get_position_UTC_time());
+    if (utc_time.length() < 23)
+        {
+            utc_time += ".";
+        }
+    utc_time.resize(23, '0');  // time up to ms
+    utc_time.append("Z");      // UTC time zone
+}
+
+
+std::string Pvt_Geometry_Strings::format(double x)
+{
+    // %.14g renders exactly what an ostream set to std::setprecision(14)
+    // would print for the same value
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.14g", x);
+    return std::string(buf);
+}
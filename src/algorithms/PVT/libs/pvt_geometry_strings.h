@@ -0,0 +1,60 @@
+/*!
+ * \file pvt_geometry_strings.h
+ * \brief Position fix fields formatted once and shared by the KML, GPX and
+ * GeoJSON printers
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_GEOMETRY_STRINGS_H
+#define GNSS_SDR_PVT_GEOMETRY_STRINGS_H
+
+#include <string>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+class Pvt_Solution;
+
+/*!
+ * \brief One formatting pass over a position fix.
+ *
+ * The KML, GPX and GeoJSON printers write the same coordinates, DOPs and
+ * timestamp of every fix; when several formats are enabled each of them
+ * used to format the same values again. This struct renders the shared
+ * fields once (14 significant digits, matching the stream precision the
+ * printers set on their files) so the printers only concatenate strings.
+ */
+struct Pvt_Geometry_Strings
+{
+    Pvt_Geometry_Strings(const Pvt_Solution* position, bool print_average_values);
+
+    std::string latitude;
+    std::string longitude;
+    std::string height;
+    std::string speed_over_ground;    // [m/s]
+    std::string course_over_ground;   // [deg]
+    std::string hdop;
+    std::string vdop;
+    std::string pdop;
+    std::string utc_time;  // ISO extended, millisecond resolution, UTC
+
+private:
+    static std::string format(double x);
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PVT_GEOMETRY_STRINGS_H
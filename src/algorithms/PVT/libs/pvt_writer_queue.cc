@@ -0,0 +1,97 @@
+/*!
+ * \file pvt_writer_queue.cc
+ * \brief Bounded job queue with a dedicated writer thread for PVT output
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_writer_queue.h"
+#include <glog/logging.h>
+#include <exception>
+#include <utility>
+
+
+Pvt_Writer_Queue::Pvt_Writer_Queue(size_t max_queued_epochs)
+    : d_max_queued_epochs(max_queued_epochs),
+      d_dropped_epochs(0),
+      d_shutdown(false)
+{
+    d_writer = std::thread(&Pvt_Writer_Queue::writer_loop, this);
+}
+
+
+Pvt_Writer_Queue::~Pvt_Writer_Queue()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_shutdown = true;
+    }
+    d_cond.notify_all();
+    if (d_writer.joinable())
+        {
+            d_writer.join();
+        }
+    if (d_dropped_epochs > 0)
+        {
+            LOG(WARNING) << "PVT writer queue dropped " << d_dropped_epochs << " output epochs (slow output device?)";
+        }
+}
+
+
+bool Pvt_Writer_Queue::try_enqueue(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (d_jobs.size() >= d_max_queued_epochs)
+            {
+                d_dropped_epochs++;
+                return false;
+            }
+        d_jobs.push_back(std::move(job));
+    }
+    d_cond.notify_one();
+    return true;
+}
+
+
+uint64_t Pvt_Writer_Queue::dropped_epochs() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_dropped_epochs;
+}
+
+
+void Pvt_Writer_Queue::writer_loop()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (true)
+        {
+            d_cond.wait(lock, [this] { return d_shutdown or !d_jobs.empty(); });
+            if (d_jobs.empty())
+                {
+                    // shutdown requested and nothing left to flush
+                    return;
+                }
+            std::function<void()> job = std::move(d_jobs.front());
+            d_jobs.pop_front();
+            lock.unlock();
+            try
+                {
+                    job();
+                }
+            catch (const std::exception& ex)
+                {
+                    LOG(ERROR) << "Exception in PVT writer thread: " << ex.what();
+                }
+            lock.lock();
+        }
+}
@@ -0,0 +1,81 @@
+/*!
+ * \file pvt_writer_queue.h
+ * \brief Bounded job queue with a dedicated writer thread for PVT output
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_WRITER_QUEUE_H
+#define GNSS_SDR_PVT_WRITER_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief This class executes deferred PVT output jobs on a dedicated thread.
+ *
+ * The PVT block enqueues one job per epoch holding a snapshot of the data the
+ * printers need, so all formatting and file/socket I/O runs off the signal
+ * processing thread. The queue is bounded: if the writer falls behind (e.g. a
+ * slow disk or a blocked NTRIP socket), try_enqueue() drops the epoch instead
+ * of blocking the caller. Pending jobs are drained before the destructor
+ * returns, so output files are complete at teardown.
+ */
+class Pvt_Writer_Queue
+{
+public:
+    /*!
+     * Start the writer thread. \p max_queued_epochs bounds the number of
+     * pending jobs; at the usual 20 ms output rate the default rides out
+     * about one second of blocked I/O before epochs are dropped.
+     */
+    explicit Pvt_Writer_Queue(size_t max_queued_epochs = 50);
+
+    //! Drain all pending jobs and stop the writer thread
+    ~Pvt_Writer_Queue();
+
+    /*!
+     * Enqueue a job without blocking. Returns false (and counts a dropped
+     * epoch) if the queue is full.
+     */
+    bool try_enqueue(std::function<void()> job);
+
+    //! Number of epochs dropped so far because the queue was full
+    uint64_t dropped_epochs() const;
+
+private:
+    void writer_loop();
+
+    std::deque<std::function<void()>> d_jobs;
+    std::thread d_writer;
+    mutable std::mutex d_mutex;
+    std::condition_variable d_cond;
+    size_t d_max_queued_epochs;
+    uint64_t d_dropped_epochs;
+    bool d_shutdown;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PVT_WRITER_QUEUE_H
@@ -119,6 +119,9 @@ Rinex_Printer::Rinex_Printer(int32_t conf_version, const std::string& base_path,
     navGlofilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_GLO_NAV", base_name);
     navBdsfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_BDS_NAV", base_name);
 
+    d_obs_iobuf = std::make_unique<char[]>(obs_iobuf_size);
+    Rinex_Printer::obsFile.rdbuf()->pubsetbuf(d_obs_iobuf.get(), obs_iobuf_size);
+
     Rinex_Printer::navFile.open(navfilename, std::ios::out | std::ios::in | std::ios::app);
     Rinex_Printer::obsFile.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
     Rinex_Printer::sbsFile.open(sbsfilename, std::ios::out | std::ios::app);
@@ -9596,6 +9599,7 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_Utc_Model& ut
             out << data[i] << '\n';
         }
     out.close();
+    out.rdbuf()->pubsetbuf(d_obs_iobuf.get(), obs_iobuf_size);
     out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
     out.seekp(0, std::ios_base::end);
 }
@@ -9654,6 +9658,7 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_CNAV_Utc_Mode
             out << data[i] << '\n';
         }
     out.close();
+    out.rdbuf()->pubsetbuf(d_obs_iobuf.get(), obs_iobuf_size);
     out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
     out.seekp(0, std::ios_base::end);
 }
@@ -9713,6 +9718,7 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Galileo_Utc_Model
             out << data[i] << '\n';
         }
     out.close();
+    out.rdbuf()->pubsetbuf(d_obs_iobuf.get(), obs_iobuf_size);
     out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
     out.seekp(0, std::ios_base::end);
 }
@@ -9772,6 +9778,7 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Beidou_Dnav_Utc_M
             out << data[i] << '\n';
         }
     out.close();
+    out.rdbuf()->pubsetbuf(d_obs_iobuf.get(), obs_iobuf_size);
     out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
     out.seekp(0, std::ios_base::end);
 }
@@ -39,11 +39,14 @@
 #define GNSS_SDR_RINEX_PRINTER_H
 
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <cmath>    // for llround, isfinite
 #include <cstdint>  // for int32_t
+#include <cstdio>   // for snprintf
 #include <cstdlib>  // for strtol, strtod
 #include <fstream>  // for fstream
 #include <iomanip>  // for setprecision
 #include <map>      // for map
+#include <memory>   // for unique_ptr
 #include <sstream>  // for stringstream
 #include <string>   // for string
 #include <vector>
@@ -987,6 +990,10 @@ private:
     std::map<std::string, std::string> observationType;  // PSEUDORANGE, CARRIER_PHASE, DOPPLER, SIGNAL_STRENGTH
     std::map<std::string, std::string> observationCode;  // GNSS observation descriptors
 
+    // Size of the stream buffer attached to the observation file, which is
+    // written at the epoch rate. Batches per-line writes into few syscalls
+    static const std::size_t obs_iobuf_size = 1048576;
+
     std::fstream obsFile;     // Output file stream for RINEX observation file
     std::fstream navFile;     // Output file stream for RINEX navigation data file
     std::fstream sbsFile;     // Output file stream for RINEX SBAS raw data file
@@ -995,6 +1002,8 @@ private:
     std::fstream navBdsFile;  // Output file stream for RINEX Galileo navigation data file
     std::fstream navMixFile;  // Output file stream for RINEX Mixed navigation data file
 
+    std::unique_ptr<char[]> d_obs_iobuf;  // Stream buffer backing obsFile
+
     std::string navfilename;                      // Name of RINEX navigation file for GPS L1
     std::string obsfilename;                      // Name of RINEX observation file
     std::string sbsfilename;                      // Name of RINEX SBAS file
@@ -1224,17 +1233,67 @@ inline std::string asString(long double x, std::string::size_type precision)
 
 inline std::string Rinex_Printer::asString(double x, std::string::size_type precision) const
 {
-    std::ostringstream ss;
-    ss << std::fixed << std::setprecision(precision) << x;
-    return ss.str();
+    // Hot path of the observation formatters: fixed-point conversion by
+    // integer digit emission instead of one std::ostringstream (allocation
+    // plus locale facet lookup) per field. The fractional part is split off
+    // before scaling, which keeps it exact and the rounding faithful. Falls
+    // back to snprintf when the value exceeds the exact integer range of a
+    // double
+    static const uint64_t pow10[13] = {1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U,
+        100000000U, 1000000000U, 10000000000U, 100000000000U, 1000000000000U};
+    if (precision < 13 && std::isfinite(x) && std::fabs(x) < 9.0e15)
+        {
+            const bool negative = std::signbit(x);
+            double integral_part;
+            const double fractional_part = std::modf(std::fabs(x), &integral_part);
+            const uint64_t scale = pow10[precision];
+            uint64_t integral = static_cast<uint64_t>(integral_part);
+            uint64_t fractional = static_cast<uint64_t>(std::llround(fractional_part * static_cast<double>(scale)));
+            if (fractional >= scale)
+                {
+                    fractional -= scale;
+                    integral++;
+                }
+            char buf[40];
+            char* p = buf + sizeof(buf);
+            for (std::string::size_type digit = 0; digit < precision; digit++)
+                {
+                    *--p = static_cast<char>('0' + (fractional % 10));
+                    fractional /= 10;
+                }
+            if (precision > 0)
+                {
+                    *--p = '.';
+                }
+            do
+                {
+                    *--p = static_cast<char>('0' + (integral % 10));
+                    integral /= 10;
+                }
+            while (integral != 0);
+            if (negative)
+                {
+                    *--p = '-';
+                }
+            return std::string(p, buf + sizeof(buf) - p);
+        }
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%.*f", static_cast<int>(precision), x);
+    return std::string(buf);
 }
 
 
 inline std::string Rinex_Printer::asFixWidthString(int x, int width, char fill_digit) const
 {
-    std::ostringstream ss;
-    ss << std::setfill(fill_digit) << std::setw(width) << x;
-    return ss.str().substr(ss.str().size() - width);
+    char buf[16];
+    const int len = std::snprintf(buf, sizeof(buf), "%d", x);
+    if (len >= width)
+        {
+            return std::string(buf + len - width, width);
+        }
+    std::string s(static_cast<std::string::size_type>(width - len), fill_digit);
+    s.append(buf, len);
+    return s;
 }
 
 
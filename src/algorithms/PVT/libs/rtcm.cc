@@ -41,6 +41,7 @@ Rtcm::Rtcm(uint16_t port)
     preamble = std::bitset<8>("11010011");
     reserved_field = std::bitset<6>("000000");
     rtcm_message_queue = std::make_shared<Concurrent_Queue<std::string> >();
+    frame_buffer.reserve(1029);  // maximum length of a framed RTCM message
     boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), RTCM_port);
     servers.emplace_back(io_context, endpoint);
     server_is_running = false;
@@ -128,20 +129,33 @@ bool Rtcm::is_server_running() const
 std::string Rtcm::add_CRC(const std::string& message_without_crc) const
 {
     // ******  Computes Qualcomm CRC-24Q ******
-    boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> CRC_RTCM;
-    // 1) Converts the string to a vector of uint8_t:
-    boost::dynamic_bitset<uint8_t> frame_bits(message_without_crc);
-    std::vector<uint8_t> bytes;
-    boost::to_block_range(frame_bits, std::back_inserter(bytes));
-    std::reverse(bytes.begin(), bytes.end());
+    // 1) Packs the frame symbols into the preallocated frame buffer, eight
+    // per byte MSB first, with one branchless shift-or per symbol. The
+    // caller (build_message) has already zero-padded to a byte boundary
+    const std::size_t num_bytes = message_without_crc.length() / 8;
+    frame_buffer.resize(num_bytes + 3);
+    uint8_t* frame = frame_buffer.data();
+    std::size_t bit = 0;
+    for (std::size_t i = 0; i < num_bytes; i++)
+        {
+            uint8_t byte = 0;
+            for (int32_t j = 0; j < 8; j++)
+                {
+                    byte = static_cast<uint8_t>((byte << 1U) | (message_without_crc[bit++] & 1));
+                }
+            frame[i] = byte;
+        }
 
-    // 2) Computes CRC
-    CRC_RTCM.process_bytes(bytes.data(), bytes.size());
-    const auto crc_frame = std::bitset<24>(CRC_RTCM.checksum());
+    // 2) Computes the CRC over the packed bytes and appends it
+    boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> CRC_RTCM;
+    CRC_RTCM.process_bytes(frame, num_bytes);
+    const uint32_t crc = CRC_RTCM.checksum();
+    frame[num_bytes] = static_cast<uint8_t>((crc >> 16U) & 0xFFU);
+    frame[num_bytes + 1] = static_cast<uint8_t>((crc >> 8U) & 0xFFU);
+    frame[num_bytes + 2] = static_cast<uint8_t>(crc & 0xFFU);
 
-    // 3) Builds the complete message
-    const std::string complete_message = message_without_crc + crc_frame.to_string();
-    return bin_to_binary_data(complete_message);
+    // 3) The complete message, ready for the wire
+    return std::string(reinterpret_cast<const char*>(frame), num_bytes + 3);
 }
 
 
@@ -173,35 +187,32 @@ bool Rtcm::check_CRC(const std::string& message) const
 
 std::string Rtcm::bin_to_binary_data(const std::string& s) const
 {
-    std::string s_aux;
-    const auto remainder = static_cast<int32_t>(std::fmod(s.length(), 8));
-    std::vector<uint8_t> c;
-    c.reserve(s.length());
+    const std::size_t remainder = s.length() % 8;
+    std::string ret((s.length() + 7) / 8, '\0');
 
-    uint32_t k = 0;
+    std::size_t k = 0;
+    std::size_t bit = 0;
     if (remainder != 0)
         {
-            s_aux.assign(s, 0, remainder);
-            boost::dynamic_bitset<> rembits(s_aux);
-            const uint64_t n = rembits.to_ulong();
-            c[0] = static_cast<uint8_t>(n);
-            k++;
+            // A leading incomplete byte keeps its bits right-aligned
+            uint8_t byte = 0;
+            while (bit < remainder)
+                {
+                    byte = static_cast<uint8_t>((byte << 1U) | (s[bit++] & 1));
+                }
+            ret[k++] = static_cast<char>(byte);
         }
 
-    const std::size_t start = std::max(remainder, 0);
-    for (std::size_t i = start; i < s.length() - 1; i = i + 8)
+    while (bit + 8 <= s.length())
         {
-            s_aux.assign(s, i, 4);
-            std::bitset<4> bs(s_aux);
-            uint32_t n = bs.to_ulong();
-            s_aux.assign(s, i + 4, 4);
-            const std::bitset<4> bs2(s_aux);
-            const uint32_t n2 = bs2.to_ulong();
-            c[k] = static_cast<uint8_t>(n * 16) + static_cast<uint8_t>(n2);
-            k++;
+            uint8_t byte = 0;
+            for (int32_t j = 0; j < 8; j++)
+                {
+                    byte = static_cast<uint8_t>((byte << 1U) | (s[bit++] & 1));
+                }
+            ret[k++] = static_cast<char>(byte);
         }
 
-    std::string ret(c.begin(), c.begin() + k);
     return ret;
 }
 
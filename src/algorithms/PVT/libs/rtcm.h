@@ -645,8 +645,24 @@ private:
     {
     public:
         Rtcm_Session(boost::asio::ip::tcp::socket socket, Rtcm_Listener_Room& room) : socket_(std::move(socket)), room_(room) {}
+
+        ~Rtcm_Session() override
+        {
+            LOG(INFO) << "RTCM client " << remote_endpoint_ << " disconnected. Messages sent: " << sent_msgs_
+                      << ", bytes sent: " << bytes_sent_ << ", messages dropped: " << dropped_msgs_;
+        }
+
         inline void start()
         {
+            boost::system::error_code ec;
+            // stream small correction messages as they are produced instead
+            // of waiting for Nagle coalescing
+            socket_.set_option(boost::asio::ip::tcp::no_delay(true), ec);
+            const auto remote = socket_.remote_endpoint(ec);
+            if (!ec)
+                {
+                    remote_endpoint_ = remote.address().to_string() + ":" + std::to_string(remote.port());
+                }
             room_.join(shared_from_this());
             do_read_message_header();
         }
@@ -654,6 +670,20 @@ private:
         inline void deliver(const Rtcm_Message& msg)
         {
             bool write_in_progress = !write_msgs_.empty();
+            if (write_msgs_.size() >= max_write_queue_size)
+                {
+                    // This client is not draining its socket. Drop the oldest
+                    // queued message (the front one is owned by the write in
+                    // progress) so a laggard never delays the other clients
+                    // and always receives the freshest corrections on resume
+                    write_msgs_.erase(write_msgs_.begin() + 1);
+                    dropped_msgs_++;
+                    if (dropped_msgs_ % 1000 == 1)
+                        {
+                            LOG(WARNING) << "RTCM client " << remote_endpoint_ << " is lagging, dropped "
+                                         << dropped_msgs_ << " messages so far";
+                        }
+                }
             write_msgs_.push_back(msg);
             if (!write_in_progress)
                 {
@@ -723,9 +753,11 @@ private:
             auto self(shared_from_this());
             boost::asio::async_write(socket_,
                 boost::asio::buffer(write_msgs_.front().body(), write_msgs_.front().body_length()),
-                [this, self](boost::system::error_code ec, std::size_t /*length*/) {
+                [this, self](boost::system::error_code ec, std::size_t length) {
                     if (!ec)
                         {
+                            sent_msgs_++;
+                            bytes_sent_ += length;
                             write_msgs_.pop_front();
                             if (!write_msgs_.empty())
                                 {
@@ -743,8 +775,16 @@ private:
         boost::asio::ip::tcp::socket socket_;
         Rtcm_Listener_Room& room_;
         Rtcm_Message read_msg_;
+        enum : std::size_t
+        {
+            max_write_queue_size = 64  // per-client backlog before the drop-oldest policy kicks in
+        };
         std::deque<Rtcm_Message> write_msgs_;
         std::string client_says;
+        std::string remote_endpoint_;
+        uint64_t sent_msgs_ = 0;
+        uint64_t bytes_sent_ = 0;
+        uint64_t dropped_msgs_ = 0;
     };
 
 
@@ -958,6 +998,7 @@ private:
     //
     std::bitset<8> preamble;
     std::bitset<6> reserved_field;
+    mutable std::vector<uint8_t> frame_buffer;  // preallocated scratch for add_CRC, holds the packed frame plus its CRC
     std::string add_CRC(const std::string& m) const;
     std::string build_message(const std::string& data) const;  // adds 0s to complete a byte and adds the CRC
 
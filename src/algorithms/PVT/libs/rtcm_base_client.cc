@@ -0,0 +1,293 @@
+/*!
+ * \file rtcm_base_client.cc
+ * \brief Implementation of a class that receives RTCM 3 frames from a
+ * reference station over TCP and feeds the decoded observables to the PVT
+ * solver
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtcm_base_client.h"
+#include "rtklib_rtcm.h"
+#include "rtklib_rtkcmn.h"
+#include "rtklib_solver.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+
+
+Rtcm_Base_Client::Rtcm_Base_Client(std::string address, uint16_t port, std::shared_ptr<Rtklib_Solver> solver)
+    : d_solver(std::move(solver)),
+      d_address(std::move(address)),
+      d_port(port)
+{
+    if (init_rtcm(&d_rtcm) == 0)
+        {
+            LOG(WARNING) << "RTCM base client: could not allocate the decoder buffers";
+            return;
+        }
+    d_thread = std::thread(&Rtcm_Base_Client::client_loop, this);
+}
+
+
+Rtcm_Base_Client::~Rtcm_Base_Client()
+{
+    d_stop = true;
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+    disconnect();
+    free_rtcm(&d_rtcm);
+}
+
+
+uint64_t Rtcm_Base_Client::frames_received() const
+{
+    return d_frames_received;
+}
+
+
+uint64_t Rtcm_Base_Client::crc_failures() const
+{
+    return d_crc_failures;
+}
+
+
+uint64_t Rtcm_Base_Client::obs_epochs() const
+{
+    return d_obs_epochs;
+}
+
+
+bool Rtcm_Base_Client::connect_to_base()
+{
+    struct addrinfo hints{};
+    struct addrinfo* result = nullptr;
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(d_address.c_str(), std::to_string(d_port).c_str(), &hints, &result) != 0 or result == nullptr)
+        {
+            return false;
+        }
+    d_fd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    if (d_fd < 0)
+        {
+            freeaddrinfo(result);
+            return false;
+        }
+    fcntl(d_fd, F_SETFL, fcntl(d_fd, F_GETFL, 0) | O_NONBLOCK);
+    int ret = connect(d_fd, result->ai_addr, result->ai_addrlen);
+    freeaddrinfo(result);
+    if (ret < 0 and errno != EINPROGRESS)
+        {
+            disconnect();
+            return false;
+        }
+    if (ret < 0)
+        {
+            // non-blocking connect: wait for writability, bounded
+            struct pollfd pfd
+            {
+                d_fd, POLLOUT, 0
+            };
+            if (poll(&pfd, 1, 5000) <= 0)
+                {
+                    disconnect();
+                    return false;
+                }
+            int so_error = 0;
+            socklen_t len = sizeof(so_error);
+            getsockopt(d_fd, SOL_SOCKET, SO_ERROR, &so_error, &len);
+            if (so_error != 0)
+                {
+                    disconnect();
+                    return false;
+                }
+        }
+    LOG(INFO) << "RTCM base client: connected to " << d_address << ":" << d_port;
+    return true;
+}
+
+
+void Rtcm_Base_Client::disconnect()
+{
+    if (d_fd >= 0)
+        {
+            close(d_fd);
+            d_fd = -1;
+        }
+}
+
+
+size_t Rtcm_Base_Client::ring_available() const
+{
+    return d_ring_write - d_ring_read;
+}
+
+
+unsigned char Rtcm_Base_Client::ring_peek(size_t offset) const
+{
+    return d_ring[(d_ring_read + offset) % ring_size];
+}
+
+
+void Rtcm_Base_Client::fill_ring()
+{
+    unsigned char chunk[2048];
+    size_t room = ring_size - ring_available();
+    if (room == 0)
+        {
+            // a full ring without a valid frame means garbage; restart the framer
+            d_ring_read = d_ring_write;
+            room = ring_size;
+        }
+    const ssize_t nbytes = recv(d_fd, chunk, std::min(sizeof(chunk), room), 0);
+    if (nbytes == 0 or (nbytes < 0 and errno != EAGAIN and errno != EWOULDBLOCK))
+        {
+            LOG(INFO) << "RTCM base client: connection to " << d_address << ":" << d_port << " lost, reconnecting";
+            disconnect();
+            return;
+        }
+    for (ssize_t i = 0; i < nbytes; i++)
+        {
+            d_ring[d_ring_write % ring_size] = chunk[i];
+            d_ring_write++;
+        }
+}
+
+
+void Rtcm_Base_Client::extract_frames()
+{
+    while (ring_available() >= 6)
+        {
+            if (ring_peek(0) != 0xD3)
+                {
+                    d_ring_read++;  // resync on the next preamble candidate
+                    continue;
+                }
+            const size_t payload_len = (static_cast<size_t>(ring_peek(1) & 0x03) << 8) | ring_peek(2);
+            const size_t frame_len = 3 + payload_len + 3;  // header + payload + CRC-24Q
+            if (ring_available() < frame_len)
+                {
+                    return;  // incomplete frame, wait for more bytes
+                }
+            for (size_t i = 0; i < frame_len; i++)
+                {
+                    d_frame[i] = ring_peek(i);
+                }
+            const unsigned int crc_received = (static_cast<unsigned int>(d_frame[frame_len - 3]) << 16) |
+                                              (static_cast<unsigned int>(d_frame[frame_len - 2]) << 8) |
+                                              static_cast<unsigned int>(d_frame[frame_len - 1]);
+            if (rtk_crc24q(d_frame.data(), static_cast<int>(frame_len - 3)) != crc_received)
+                {
+                    d_crc_failures++;
+                    d_ring_read++;  // corrupted or false preamble, resync
+                    continue;
+                }
+            d_ring_read += frame_len;
+            d_frames_received++;
+            decode_frame(frame_len);
+        }
+}
+
+
+void Rtcm_Base_Client::decode_frame(size_t frame_len)
+{
+    int ret = 0;
+    for (size_t i = 0; i < frame_len; i++)
+        {
+            ret = input_rtcm3(&d_rtcm, d_frame[i]);
+        }
+    if (ret == 1 and d_rtcm.obs.n > 0)
+        {
+            // complete observation epoch: tag as reference station data and
+            // hand the preallocated slab to the solver
+            for (int i = 0; i < d_rtcm.obs.n; i++)
+                {
+                    d_rtcm.obs.data[i].rcv = 2;
+                }
+            d_solver->set_base_observables(d_rtcm.obs.data, d_rtcm.obs.n);
+            d_obs_epochs++;
+        }
+    else if (ret == 5)
+        {
+            // station antenna position (message type 1005/1006)
+            if (d_rtcm.sta.pos[0] != 0.0 or d_rtcm.sta.pos[1] != 0.0 or d_rtcm.sta.pos[2] != 0.0)
+                {
+                    d_solver->set_base_station_position(d_rtcm.sta.pos);
+                    if (!d_base_position_reported)
+                        {
+                            LOG(INFO) << "RTCM base client: station " << d_rtcm.staid
+                                      << " position " << d_rtcm.sta.pos[0] << ", "
+                                      << d_rtcm.sta.pos[1] << ", " << d_rtcm.sta.pos[2] << " (ECEF [m])";
+                            d_base_position_reported = true;
+                        }
+                }
+        }
+}
+
+
+void Rtcm_Base_Client::client_loop()
+{
+    while (!d_stop)
+        {
+            if (d_fd < 0)
+                {
+                    if (!connect_to_base())
+                        {
+                            // retry with a pause, responsive to shutdown
+                            for (int i = 0; i < 10 and !d_stop; i++)
+                                {
+                                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                                }
+                            continue;
+                        }
+                }
+            struct pollfd pfd
+            {
+                d_fd, POLLIN, 0
+            };
+            const int ret = poll(&pfd, 1, 200);
+            if (ret < 0)
+                {
+                    disconnect();
+                    continue;
+                }
+            if (ret == 0)
+                {
+                    continue;  // timeout, check the stop flag again
+                }
+            if ((pfd.revents & (POLLERR | POLLHUP)) != 0)
+                {
+                    disconnect();
+                    continue;
+                }
+            fill_ring();
+            if (d_fd >= 0)
+                {
+                    extract_frames();
+                }
+        }
+    LOG(INFO) << "RTCM base client stopped: " << d_frames_received << " frames, "
+              << d_obs_epochs << " observation epochs, " << d_crc_failures << " CRC failures";
+}
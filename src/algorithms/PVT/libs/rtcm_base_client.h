@@ -0,0 +1,97 @@
+/*!
+ * \file rtcm_base_client.h
+ * \brief Interface of a class that receives RTCM 3 frames from a reference
+ * station over TCP and feeds the decoded observables to the PVT solver
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RTCM_BASE_CLIENT_H
+#define GNSS_SDR_RTCM_BASE_CLIENT_H
+
+#include "rtklib.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+class Rtklib_Solver;
+
+/*!
+ * \brief TCP client that ingests base station RTCM 3 for the differential
+ * positioning modes.
+ *
+ * The socket is non-blocking and serviced with poll() from a dedicated
+ * thread, so a stalled or dead base station never blocks the receiver and
+ * reconnection is automatic. Incoming bytes land in a fixed reassembly ring
+ * where frames are delimited by the RTCM 3 preamble plus length field and
+ * validated with CRC-24Q before decoding, so a corrupted stream costs a
+ * resync instead of a decoder error. Decoding uses the bundled RTKLIB
+ * decoder, whose observation buffer is allocated once at start-up; complete
+ * observation epochs are handed to the solver as reference-station (rcv=2)
+ * observables without further copies or allocations.
+ */
+class Rtcm_Base_Client
+{
+public:
+    Rtcm_Base_Client(std::string address, uint16_t port, std::shared_ptr<Rtklib_Solver> solver);
+    ~Rtcm_Base_Client();
+    Rtcm_Base_Client(const Rtcm_Base_Client&) = delete;
+    Rtcm_Base_Client& operator=(const Rtcm_Base_Client&) = delete;
+
+    uint64_t frames_received() const;
+    uint64_t crc_failures() const;
+    uint64_t obs_epochs() const;
+
+private:
+    // ring capacity; RTCM 3 frames are at most 3 + 1023 + 3 bytes
+    static const size_t ring_size = 4096;
+
+    void client_loop();
+    bool connect_to_base();
+    void disconnect();
+    void fill_ring();
+    void extract_frames();
+    void decode_frame(size_t frame_len);
+    size_t ring_available() const;
+    unsigned char ring_peek(size_t offset) const;
+
+    std::array<unsigned char, ring_size> d_ring{};
+    std::array<unsigned char, 1200> d_frame{};
+    rtcm_t d_rtcm{};
+    std::shared_ptr<Rtklib_Solver> d_solver;
+    std::string d_address;
+    std::thread d_thread;
+    uint64_t d_frames_received = 0;
+    uint64_t d_crc_failures = 0;
+    uint64_t d_obs_epochs = 0;
+    size_t d_ring_write = 0;  // total bytes ever written, index modulo ring_size
+    size_t d_ring_read = 0;   // total bytes ever consumed
+    std::atomic<bool> d_stop{false};
+    int d_fd = -1;
+    uint16_t d_port;
+    bool d_base_position_reported = false;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RTCM_BASE_CLIENT_H
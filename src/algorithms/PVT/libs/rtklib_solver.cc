@@ -33,10 +33,12 @@
 #include "rtklib_solver.h"
 #include "Beidou_DNAV.h"
 #include "rtklib_conversions.h"
+#include "rtklib_ephemeris.h"
 #include "rtklib_rtkpos.h"
 #include "rtklib_solution.h"
 #include <glog/logging.h>
 #include <matio.h>
+#include <algorithm>
 #include <exception>
 #include <utility>
 #include <vector>
@@ -399,6 +401,272 @@ Monitor_Pvt Rtklib_Solver::get_monitor_pvt() const
 }
 
 
+std::shared_ptr<const Pvt_Ephemeris_Snapshot> Rtklib_Solver::export_ephemeris_snapshot(uint64_t version) const
+{
+    auto snapshot = std::make_shared<Pvt_Ephemeris_Snapshot>();
+    snapshot->version = version;
+    snapshot->galileo_ephemeris_map = galileo_ephemeris_map;
+    snapshot->gps_ephemeris_map = gps_ephemeris_map;
+    snapshot->gps_cnav_ephemeris_map = gps_cnav_ephemeris_map;
+    snapshot->glonass_gnav_ephemeris_map = glonass_gnav_ephemeris_map;
+    snapshot->beidou_dnav_ephemeris_map = beidou_dnav_ephemeris_map;
+    snapshot->galileo_utc_model = galileo_utc_model;
+    snapshot->galileo_iono = galileo_iono;
+    snapshot->galileo_almanac_map = galileo_almanac_map;
+    snapshot->gps_utc_model = gps_utc_model;
+    snapshot->gps_iono = gps_iono;
+    snapshot->gps_almanac_map = gps_almanac_map;
+    snapshot->gps_cnav_iono = gps_cnav_iono;
+    snapshot->gps_cnav_utc_model = gps_cnav_utc_model;
+    snapshot->glonass_gnav_utc_model = glonass_gnav_utc_model;
+    snapshot->glonass_gnav_almanac = glonass_gnav_almanac;
+    snapshot->beidou_dnav_utc_model = beidou_dnav_utc_model;
+    snapshot->beidou_dnav_iono = beidou_dnav_iono;
+    snapshot->beidou_dnav_almanac_map = beidou_dnav_almanac_map;
+    return snapshot;
+}
+
+
+void Rtklib_Solver::import_ephemeris_snapshot(const std::shared_ptr<const Pvt_Ephemeris_Snapshot> &snapshot)
+{
+    if (snapshot->version == d_imported_ephemeris_version)
+        {
+            return;
+        }
+    galileo_ephemeris_map = snapshot->galileo_ephemeris_map;
+    gps_ephemeris_map = snapshot->gps_ephemeris_map;
+    gps_cnav_ephemeris_map = snapshot->gps_cnav_ephemeris_map;
+    glonass_gnav_ephemeris_map = snapshot->glonass_gnav_ephemeris_map;
+    beidou_dnav_ephemeris_map = snapshot->beidou_dnav_ephemeris_map;
+    galileo_utc_model = snapshot->galileo_utc_model;
+    galileo_iono = snapshot->galileo_iono;
+    galileo_almanac_map = snapshot->galileo_almanac_map;
+    gps_utc_model = snapshot->gps_utc_model;
+    gps_iono = snapshot->gps_iono;
+    gps_almanac_map = snapshot->gps_almanac_map;
+    gps_cnav_iono = snapshot->gps_cnav_iono;
+    gps_cnav_utc_model = snapshot->gps_cnav_utc_model;
+    glonass_gnav_utc_model = snapshot->glonass_gnav_utc_model;
+    glonass_gnav_almanac = snapshot->glonass_gnav_almanac;
+    beidou_dnav_utc_model = snapshot->beidou_dnav_utc_model;
+    beidou_dnav_iono = snapshot->beidou_dnav_iono;
+    beidou_dnav_almanac_map = snapshot->beidou_dnav_almanac_map;
+    d_imported_ephemeris_version = snapshot->version;
+}
+
+
+void Rtklib_Solver::update_has_corrections(const Galileo_HAS_data &has_data)
+{
+    d_has_correction_store.update(has_data);
+}
+
+
+void Rtklib_Solver::set_base_observables(const obsd_t *obs, int n)
+{
+    std::lock_guard<std::mutex> lock(d_base_mutex);
+    d_base_obs_count = std::min(n, static_cast<int>(MAXOBS));
+    std::copy_n(obs, d_base_obs_count, d_base_obs_data.data());
+    d_base_obs_arrival = std::chrono::steady_clock::now();
+}
+
+
+void Rtklib_Solver::set_base_station_position(const double *pos_ecef_m)
+{
+    std::lock_guard<std::mutex> lock(d_base_mutex);
+    d_base_pos_ecef = {pos_ecef_m[0], pos_ecef_m[1], pos_ecef_m[2]};
+    d_base_pos_valid = true;
+}
+
+
+void Rtklib_Solver::set_base_obs_max_age(double max_age_s)
+{
+    std::lock_guard<std::mutex> lock(d_base_mutex);
+    d_base_obs_max_age_s = max_age_s;
+}
+
+
+void Rtklib_Solver::enable_dead_reckoning(double max_age_s)
+{
+    d_dr_enabled = true;
+    d_dr_max_age_s = max_age_s;
+}
+
+
+bool Rtklib_Solver::is_dead_reckoning() const
+{
+    return d_dr_active;
+}
+
+
+bool Rtklib_Solver::dead_reckon(const std::map<int, Gnss_Synchro> &gnss_observables_map, int num_obs, const nav_t *nav_data)
+{
+    if (!d_dr_enabled or !d_dr_state_valid or gnss_observables_map.empty())
+        {
+            return false;
+        }
+    const double rx_time = gnss_observables_map.cbegin()->second.RX_time;
+    const double dt = rx_time - d_dr_last_rx_time;
+    if (dt <= 0.0 or (d_dr_age_s + dt) > d_dr_max_age_s)
+        {
+            if (d_dr_active)
+                {
+                    LOG(INFO) << "Dead-reckoning window exhausted after " << d_dr_age_s << " s without a full PVT solution";
+                    d_dr_active = false;
+                }
+            d_dr_state_valid = false;
+            return false;
+        }
+
+    // constant-velocity propagation of the last known state
+    for (int i = 0; i < 3; i++)
+        {
+            d_dr_pos_ecef[i] += d_dr_vel_ecef[i] * dt;
+        }
+    d_dr_time = timeadd(d_dr_time, dt);
+    d_dr_time_offset_s += d_dr_clock_drift_mps / SPEED_OF_LIGHT_M_S * dt;
+    d_dr_last_rx_time = rx_time;
+    d_dr_age_s += dt;
+
+    // velocity correction from the Doppler of the channels still tracking:
+    // damped least squares on the predicted range-rate residuals, so that a
+    // single satellite still constrains the along-LOS velocity component
+    int used_sats = 0;
+    if (num_obs > 0 and nav_data != nullptr)
+        {
+            std::array<double, 6 * MAXOBS> rs{};
+            std::array<double, 2 * MAXOBS> dts{};
+            std::array<double, MAXOBS> var{};
+            std::array<int, MAXOBS> svh{};
+            satposs(obs_data[0].time, obs_data.data(), num_obs, nav_data, EPHOPT_BRDC, rs.data(), dts.data(), var.data(), svh.data());
+
+            std::array<double, 3 * MAXOBS> los{};
+            std::array<double, MAXOBS> res{};
+            for (int i = 0; i < num_obs; i++)
+                {
+                    const int sat = obs_data[i].sat;
+                    const double lam = nav_data->lam[sat - 1][0];
+                    if (svh[i] < 0 or obs_data[i].D[0] == 0.0 or lam <= 0.0)
+                        {
+                            continue;
+                        }
+                    std::array<double, 3> e{};
+                    double range = 0.0;
+                    for (int k = 0; k < 3; k++)
+                        {
+                            e[k] = rs[6 * i + k] - d_dr_pos_ecef[k];
+                            range += e[k] * e[k];
+                        }
+                    range = sqrt(range);
+                    if (range < 1.0)
+                        {
+                            continue;
+                        }
+                    double predicted_rate = 0.0;
+                    for (int k = 0; k < 3; k++)
+                        {
+                            e[k] /= range;
+                            predicted_rate += (rs[6 * i + 3 + k] - d_dr_vel_ecef[k]) * e[k];
+                        }
+                    // Earth-rotation (Sagnac) correction, as in resdop()
+                    predicted_rate += GNSS_OMEGA_EARTH_DOT / SPEED_OF_LIGHT_M_S * (rs[6 * i + 4] * d_dr_pos_ecef[0] + rs[6 * i + 1] * d_dr_vel_ecef[0] - rs[6 * i + 3] * d_dr_pos_ecef[1] - rs[6 * i] * d_dr_vel_ecef[1]);
+                    predicted_rate += d_dr_clock_drift_mps - SPEED_OF_LIGHT_M_S * dts[2 * i + 1];
+
+                    const double measured_rate = -lam * obs_data[i].D[0];
+                    los[3 * used_sats] = e[0];
+                    los[3 * used_sats + 1] = e[1];
+                    los[3 * used_sats + 2] = e[2];
+                    res[used_sats] = measured_rate - predicted_rate;
+                    used_sats++;
+                }
+
+            if (used_sats > 0)
+                {
+                    // normal equations with Tikhonov damping: with fewer than
+                    // three satellites the unobserved velocity components stay
+                    // at their propagated values
+                    std::array<double, 9> A{};
+                    std::array<double, 3> b{};
+                    std::array<double, 3> dv{};
+                    const double damping = 0.01;
+                    for (int i = 0; i < used_sats; i++)
+                        {
+                            for (int j = 0; j < 3; j++)
+                                {
+                                    b[j] += los[3 * i + j] * res[i];
+                                    for (int k = 0; k < 3; k++)
+                                        {
+                                            A[j + 3 * k] += los[3 * i + j] * los[3 * i + k];
+                                        }
+                                }
+                        }
+                    for (int j = 0; j < 3; j++)
+                        {
+                            A[j + 3 * j] += damping;
+                        }
+                    if (solve("N", A.data(), b.data(), 3, 1, dv.data()) == 0 and norm_rtk(dv.data(), 3) < 50.0)
+                        {
+                            for (int k = 0; k < 3; k++)
+                                {
+                                    d_dr_vel_ecef[k] += dv[k];
+                                }
+                        }
+                }
+        }
+
+    // publish the propagated state, flagged as dead-reckoned
+    for (int i = 0; i < 3; i++)
+        {
+            pvt_sol.rr[i] = d_dr_pos_ecef[i];
+            pvt_sol.rr[i + 3] = d_dr_vel_ecef[i];
+        }
+    pvt_sol.time = d_dr_time;
+    pvt_sol.stat = SOLQ_DR;
+    pvt_sol.type = 0;
+    pvt_sol.ns = static_cast<uint8_t>(used_sats);
+
+    this->set_num_valid_observations(used_sats);
+    this->set_valid_position(true);
+    this->set_rx_pos({d_dr_pos_ecef[0], d_dr_pos_ecef[1], d_dr_pos_ecef[2]});
+
+    std::array<double, 3> pos{};
+    std::array<double, 3> enuv{};
+    ecef2pos(pvt_sol.rr, pos.data());
+    ecef2enu(pos.data(), &pvt_sol.rr[3], enuv.data());
+    this->set_speed_over_ground(norm_rtk(enuv.data(), 2));
+    this->set_rx_vel({enuv[0], enuv[1], enuv[2]});
+    this->set_time_offset_s(d_dr_time_offset_s);
+
+    const gtime_t rtklib_time = timeadd(pvt_sol.time, d_dr_time_offset_s);
+    const gtime_t rtklib_utc_time = gpst2utc(rtklib_time);
+    boost::posix_time::ptime p_time = boost::posix_time::from_time_t(rtklib_utc_time.time);
+    p_time += boost::posix_time::microseconds(static_cast<long>(round(rtklib_utc_time.sec * 1e6)));  // NOLINT(google-runtime-int)
+    this->set_position_UTC_time(p_time);
+
+    monitor_pvt.TOW_at_current_symbol_ms = gnss_observables_map.cbegin()->second.TOW_at_current_symbol_ms;
+    monitor_pvt.RX_time = rx_time;
+    monitor_pvt.user_clk_offset = d_dr_time_offset_s;
+    monitor_pvt.pos_x = pvt_sol.rr[0];
+    monitor_pvt.pos_y = pvt_sol.rr[1];
+    monitor_pvt.pos_z = pvt_sol.rr[2];
+    monitor_pvt.vel_x = pvt_sol.rr[3];
+    monitor_pvt.vel_y = pvt_sol.rr[4];
+    monitor_pvt.vel_z = pvt_sol.rr[5];
+    monitor_pvt.latitude = this->get_latitude();
+    monitor_pvt.longitude = this->get_longitude();
+    monitor_pvt.height = this->get_height();
+    monitor_pvt.valid_sats = pvt_sol.ns;
+    monitor_pvt.solution_status = pvt_sol.stat;
+    monitor_pvt.solution_type = pvt_sol.type;
+
+    if (!d_dr_active)
+        {
+            LOG(INFO) << "PVT dead reckoning engaged with " << used_sats << " Doppler measurements";
+            d_dr_active = true;
+        }
+    return true;
+}
+
+
 bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_map, bool flag_averaging)
 {
     std::map<int, Gnss_Synchro>::const_iterator gnss_observables_iter;
@@ -419,8 +687,8 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
     int glo_valid_obs = 0;  // GLONASS L1/L2 valid observations counter
 
     obs_data.fill({});
-    std::vector<eph_t> eph_data(MAXOBS);
-    std::vector<geph_t> geph_data(MAXOBS);
+    eph_data.fill({});
+    geph_data.fill({});
 
     // Workaround for NAV/CNAV clash problem
     bool gps_dual_band = false;
@@ -889,6 +1157,13 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     nav_data.leaps = beidou_dnav_utc_model.i_DeltaT_LS;
                 }
 
+            if (d_has_correction_store.has_corrections())
+                {
+                    // consumed by satpos_ssr() when the solver runs with an
+                    // SSR satellite ephemeris option
+                    d_has_correction_store.apply(&nav_data);
+                }
+
             /* update carrier wave length using native function call in RTKlib */
             for (int i = 0; i < MAXSAT; i++)
                 {
@@ -898,14 +1173,41 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                         }
                 }
 
-            result = rtkpos(&rtk_, obs_data.data(), valid_obs + glo_valid_obs, &nav_data);
+            // append the reference-station observables received from the
+            // RTCM base client, if any and fresh enough, right after the
+            // rover observables (rtkpos expects rcv=1 first, then rcv=2)
+            int base_obs = 0;
+            if (rtk_.opt.mode >= PMODE_DGPS and rtk_.opt.mode <= PMODE_FIXED)
+                {
+                    std::lock_guard<std::mutex> lock(d_base_mutex);
+                    if (d_base_pos_valid and rtk_.opt.rb[0] == 0.0 and rtk_.opt.rb[1] == 0.0 and rtk_.opt.rb[2] == 0.0)
+                        {
+                            rtk_.opt.rb[0] = d_base_pos_ecef[0];
+                            rtk_.opt.rb[1] = d_base_pos_ecef[1];
+                            rtk_.opt.rb[2] = d_base_pos_ecef[2];
+                        }
+                    if (d_base_obs_count > 0)
+                        {
+                            const double base_age_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - d_base_obs_arrival).count();
+                            if (base_age_s <= d_base_obs_max_age_s)
+                                {
+                                    base_obs = std::min(d_base_obs_count, static_cast<int>(MAXOBS) - (valid_obs + glo_valid_obs));
+                                    std::copy_n(d_base_obs_data.data(), base_obs, obs_data.data() + valid_obs + glo_valid_obs);
+                                }
+                        }
+                }
+
+            result = rtkpos(&rtk_, obs_data.data(), valid_obs + glo_valid_obs + base_obs, &nav_data);
 
             if (result == 0)
                 {
                     LOG(INFO) << "RTKLIB rtkpos error: " << rtk_.errbuf;
-                    rtk_.neb = 0;                  // clear error buffer to avoid repeating the error message
-                    this->set_time_offset_s(0.0);  // reset rx time estimation
-                    this->set_num_valid_observations(0);
+                    rtk_.neb = 0;  // clear error buffer to avoid repeating the error message
+                    if (!dead_reckon(gnss_observables_map, valid_obs + glo_valid_obs, &nav_data))
+                        {
+                            this->set_time_offset_s(0.0);  // reset rx time estimation
+                            this->set_num_valid_observations(0);
+                        }
                 }
             else
                 {
@@ -1054,6 +1356,24 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     // User clock drift [ppm]
                     monitor_pvt.user_clk_drift_ppm = clock_drift_ppm;
 
+                    // refresh the dead-reckoning state with the full solution
+                    if (d_dr_enabled)
+                        {
+                            d_dr_pos_ecef = {pvt_sol.rr[0], pvt_sol.rr[1], pvt_sol.rr[2]};
+                            d_dr_vel_ecef = {pvt_sol.rr[3], pvt_sol.rr[4], pvt_sol.rr[5]};
+                            d_dr_time = pvt_sol.time;
+                            d_dr_last_rx_time = gnss_observables_map.cbegin()->second.RX_time;
+                            d_dr_clock_drift_mps = pvt_sol.dtr[5];
+                            d_dr_time_offset_s = rx_position_and_time[3];
+                            d_dr_age_s = 0.0;
+                            d_dr_state_valid = true;
+                            if (d_dr_active)
+                                {
+                                    LOG(INFO) << "PVT solution recovered, dead reckoning disengaged";
+                                    d_dr_active = false;
+                                }
+                        }
+
                     // ######## LOG FILE #########
                     if (d_flag_dump_enabled == true)
                         {
@@ -1137,5 +1457,23 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                         }
                 }
         }
+    else if (d_dr_enabled and d_dr_state_valid)
+        {
+            // fewer than four usable satellites: dead-reckon the last
+            // solution on whatever Doppler measurements are left
+            nav_t nav_data{};
+            nav_data.eph = eph_data.data();
+            nav_data.geph = geph_data.data();
+            nav_data.n = valid_obs;
+            nav_data.ng = glo_valid_obs;
+            for (int i = 0; i < MAXSAT; i++)
+                {
+                    for (int j = 0; j < NFREQ; j++)
+                        {
+                            nav_data.lam[i][j] = satwavelen(i + 1, j, &nav_data);
+                        }
+                }
+            dead_reckon(gnss_observables_map, valid_obs + glo_valid_obs, &nav_data);
+        }
     return this->is_valid_position();
 }
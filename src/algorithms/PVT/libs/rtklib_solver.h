@@ -54,12 +54,18 @@
 #include "gps_ephemeris.h"
 #include "gps_iono.h"
 #include "gps_utc_model.h"
+#include "has_correction_store.h"
 #include "monitor_pvt.h"
+#include "pvt_ephemeris_snapshot.h"
 #include "pvt_solution.h"
 #include "rtklib.h"
 #include <array>
+#include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 
 /** \addtogroup PVT
@@ -80,6 +86,52 @@ public:
 
     bool get_PVT(const std::map<int, Gnss_Synchro>& gnss_observables_map, bool flag_averaging);
 
+    /*!
+     * \brief Copies the current navigation data into an immutable snapshot
+     * carrying the given version number.
+     */
+    std::shared_ptr<const Pvt_Ephemeris_Snapshot> export_ephemeris_snapshot(uint64_t version) const;
+
+    /*!
+     * \brief Replaces the navigation data with the snapshot contents.
+     * Does nothing when the snapshot version was already imported.
+     */
+    void import_ephemeris_snapshot(const std::shared_ptr<const Pvt_Ephemeris_Snapshot>& snapshot);
+
+    /*!
+     * \brief Merges a Galileo HAS message into the cached satellite
+     * correction states applied at every positioning epoch.
+     */
+    void update_has_corrections(const Galileo_HAS_data& has_data);
+
+    /*!
+     * \brief Replaces the reference-station observables used by the
+     * differential positioning modes. Called from the RTCM base client
+     * thread; obs must already be tagged with rcv=2.
+     */
+    void set_base_observables(const obsd_t* obs, int n);
+
+    /*!
+     * \brief Sets the reference-station antenna position (ECEF [m]), as
+     * decoded from RTCM message type 1005/1006. Applied only when no base
+     * position was configured.
+     */
+    void set_base_station_position(const double* pos_ecef_m);
+
+    //! Reference-station observables older than this are not used when solving
+    void set_base_obs_max_age(double max_age_s);
+
+    /*!
+     * \brief Enables dead-reckoning output during outages: when fewer than
+     * four satellites are usable (or the solver fails), the last solution is
+     * propagated with a constant-velocity model aided by the Doppler of the
+     * remaining channels, for at most max_age_s seconds.
+     */
+    void enable_dead_reckoning(double max_age_s);
+
+    //! True when the current solution is dead-reckoned rather than solved
+    bool is_dead_reckoning() const;
+
     double get_hdop() const override;
     double get_vdop() const override;
     double get_pdop() const override;
@@ -115,14 +167,44 @@ public:
 
 private:
     bool save_matfile() const;
+    bool dead_reckon(const std::map<int, Gnss_Synchro> &gnss_observables_map, int num_obs, const nav_t *nav_data);
 
     std::array<obsd_t, MAXOBS> obs_data{};
+    std::array<eph_t, MAXOBS> eph_data{};
+    std::array<geph_t, MAXOBS> geph_data{};
     std::array<double, 4> dop_{};
     rtk_t rtk_{};
+
+    // reference-station data fed by the RTCM base client, guarded by
+    // d_base_mutex (written from the client thread, read when solving)
+    mutable std::mutex d_base_mutex;
+    std::array<obsd_t, MAXOBS> d_base_obs_data{};
+    std::array<double, 3> d_base_pos_ecef{};
+    std::chrono::steady_clock::time_point d_base_obs_arrival;
+    double d_base_obs_max_age_s = 30.0;
+    int d_base_obs_count = 0;
+    bool d_base_pos_valid = false;
+
+    Has_Correction_Store d_has_correction_store;
     Monitor_Pvt monitor_pvt{};
+
+    // dead-reckoning state: last full solution, refreshed every valid epoch
+    std::array<double, 3> d_dr_pos_ecef{};
+    std::array<double, 3> d_dr_vel_ecef{};
+    gtime_t d_dr_time{};
+    double d_dr_last_rx_time = 0.0;
+    double d_dr_clock_drift_mps = 0.0;
+    double d_dr_time_offset_s = 0.0;
+    double d_dr_max_age_s = 0.0;
+    double d_dr_age_s = 0.0;
+    bool d_dr_enabled = false;
+    bool d_dr_state_valid = false;
+    bool d_dr_active = false;
+
     std::string d_dump_filename;
     std::ofstream d_dump_file;
     int d_nchannels;  // Number of available channels for positioning
+    uint64_t d_imported_ephemeris_version = 0;
     bool d_flag_dump_enabled;
     bool d_flag_dump_mat_enabled;
 };
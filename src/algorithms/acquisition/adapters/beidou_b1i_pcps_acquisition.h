@@ -150,6 +150,11 @@ public:
      */
     void set_resampler_latency(uint32_t latency_samples) override;
 
+    /*!
+     * \brief Arms the diagnostic export for the next n_attempts acquisition attempts
+     */
+    void arm_diagnostics(unsigned int n_attempts) override;
+
 private:
     pcps_acquisition_sptr acquisition_;
     std::vector<std::complex<float>> code_;
@@ -232,3 +232,9 @@ void BeidouB3iPcpsAcquisition::set_resampler_latency(uint32_t latency_samples)
 {
     acquisition_->set_resampler_latency(latency_samples);
 }
+
+
+void BeidouB3iPcpsAcquisition::arm_diagnostics(unsigned int n_attempts)
+{
+    acquisition_->arm_diagnostics(n_attempts);
+}
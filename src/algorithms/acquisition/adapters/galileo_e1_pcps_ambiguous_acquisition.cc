@@ -21,6 +21,7 @@
 #include "configuration_interface.h"
 #include "galileo_e1_signal_replica.h"
 #include "gnss_sdr_flags.h"
+#include "prn_code_cache.h"
 #include <boost/math/distributions/exponential.hpp>
 #include <glog/logging.h>
 #include <algorithm>
@@ -152,45 +153,33 @@ void GalileoE1PcpsAmbiguousAcquisition::set_local_code()
     bool cboc = configuration_->property(
         "Acquisition" + std::to_string(channel_) + ".cboc", false);
 
-    std::vector<std::complex<float>> code(code_length_);
-
+    std::array<char, 3> signal_id{};
     if (acquire_pilot_ == true)
         {
             // set local signal generator to Galileo E1 pilot component (1C)
-            std::array<char, 3> pilot_signal = {{'1', 'C', '\0'}};
-            if (acq_parameters_.use_automatic_resampler)
-                {
-                    galileo_e1_code_gen_complex_sampled(code, pilot_signal,
-                        cboc, gnss_synchro_->PRN, acq_parameters_.resampled_fs, 0, false);
-                }
-            else
-                {
-                    galileo_e1_code_gen_complex_sampled(code, pilot_signal,
-                        cboc, gnss_synchro_->PRN, fs_in_, 0, false);
-                }
+            signal_id = {{'1', 'C', '\0'}};
         }
     else
         {
-            std::array<char, 3> Signal_{};
-            Signal_[0] = gnss_synchro_->Signal[0];
-            Signal_[1] = gnss_synchro_->Signal[1];
-            Signal_[2] = '\0';
-            if (acq_parameters_.use_automatic_resampler)
-                {
-                    galileo_e1_code_gen_complex_sampled(code, Signal_,
-                        cboc, gnss_synchro_->PRN, acq_parameters_.resampled_fs, 0, false);
-                }
-            else
-                {
-                    galileo_e1_code_gen_complex_sampled(code, Signal_,
-                        cboc, gnss_synchro_->PRN, fs_in_, 0, false);
-                }
+            signal_id[0] = gnss_synchro_->Signal[0];
+            signal_id[1] = gnss_synchro_->Signal[1];
+            signal_id[2] = '\0';
         }
+    const int64_t fs = acq_parameters_.use_automatic_resampler ? acq_parameters_.resampled_fs : fs_in_;
+
+    // Reuse the shared replica built by the first channel that acquired this
+    // signal/PRN pair, instead of regenerating it per channel and retarget
+    const std::string key = std::string("E") + signal_id.data() + (cboc ? "_cboc" : "");
+    const auto code = Prn_Code_Cache::get_instance().get_or_build(key, gnss_synchro_->PRN, fs, 0, code_length_,
+        [&](own::span<std::complex<float>> dest) {
+            galileo_e1_code_gen_complex_sampled(dest, signal_id,
+                cboc, gnss_synchro_->PRN, fs, 0, false);
+        });
 
     own::span<gr_complex> code_span(code_.data(), vector_length_);
     for (unsigned int i = 0; i < sampled_ms_ / 4; i++)
         {
-            std::copy_n(code.data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
+            std::copy_n(code->data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
         }
 
     acquisition_->set_local_code(code_.data());
@@ -275,3 +264,9 @@ void GalileoE1PcpsAmbiguousAcquisition::set_resampler_latency(uint32_t latency_s
 {
     acquisition_->set_resampler_latency(latency_samples);
 }
+
+
+void GalileoE1PcpsAmbiguousAcquisition::arm_diagnostics(unsigned int n_attempts)
+{
+    acquisition_->arm_diagnostics(n_attempts);
+}
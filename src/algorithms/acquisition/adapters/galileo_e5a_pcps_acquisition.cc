@@ -235,3 +235,9 @@ void GalileoE5aPcpsAcquisition::set_resampler_latency(uint32_t latency_samples)
 {
     acquisition_->set_resampler_latency(latency_samples);
 }
+
+
+void GalileoE5aPcpsAcquisition::arm_diagnostics(unsigned int n_attempts)
+{
+    acquisition_->arm_diagnostics(n_attempts);
+}
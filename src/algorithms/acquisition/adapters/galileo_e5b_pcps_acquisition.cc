@@ -233,3 +233,9 @@ void GalileoE5bPcpsAcquisition::set_resampler_latency(uint32_t latency_samples)
 {
     acquisition_->set_resampler_latency(latency_samples);
 }
+
+
+void GalileoE5bPcpsAcquisition::arm_diagnostics(unsigned int n_attempts)
+{
+    acquisition_->arm_diagnostics(n_attempts);
+}
@@ -94,6 +94,12 @@ void GlonassL1CaPcpsAcquisition::stop_acquisition()
 }
 
 
+void GlonassL1CaPcpsAcquisition::arm_diagnostics(unsigned int n_attempts)
+{
+    acquisition_->arm_diagnostics(n_attempts);
+}
+
+
 void GlonassL1CaPcpsAcquisition::set_threshold(float threshold)
 {
     threshold_ = threshold;
@@ -93,6 +93,12 @@ void GlonassL2CaPcpsAcquisition::stop_acquisition()
 }
 
 
+void GlonassL2CaPcpsAcquisition::arm_diagnostics(unsigned int n_attempts)
+{
+    acquisition_->arm_diagnostics(n_attempts);
+}
+
+
 void GlonassL2CaPcpsAcquisition::set_threshold(float threshold)
 {
     threshold_ = threshold;
@@ -23,8 +23,8 @@
 #include "GPS_L1_CA.h"
 #include "acq_conf.h"
 #include "configuration_interface.h"
+#include "gnss_packed_code.h"
 #include "gnss_sdr_flags.h"
-#include "gps_sdr_signal_replica.h"
 #include <glog/logging.h>
 #include <algorithm>
 
@@ -152,13 +152,15 @@ void GpsL1CaPcpsAcquisition::set_local_code()
 {
     std::vector<std::complex<float>> code(code_length_);
 
+    // Expand the shared bit-packed replica instead of regenerating the chips
+    const Gnss_Packed_Code& packed_code = Gnss_Code_Table::get_instance().gps_l1_ca(gnss_synchro_->PRN);
     if (acq_parameters_.use_automatic_resampler)
         {
-            gps_l1_ca_code_gen_complex_sampled(code, gnss_synchro_->PRN, acq_parameters_.resampled_fs, 0);
+            packed_code.expand_complex_sampled(code, static_cast<int32_t>(GPS_L1_CA_CODE_RATE_CPS), static_cast<int32_t>(acq_parameters_.resampled_fs));
         }
     else
         {
-            gps_l1_ca_code_gen_complex_sampled(code, gnss_synchro_->PRN, acq_parameters_.fs_in, 0);
+            packed_code.expand_complex_sampled(code, static_cast<int32_t>(GPS_L1_CA_CODE_RATE_CPS), static_cast<int32_t>(acq_parameters_.fs_in));
         }
     own::span<gr_complex> code_span(code_.data(), vector_length_);
     for (unsigned int i = 0; i < sampled_ms_; i++)
@@ -248,3 +250,9 @@ void GpsL1CaPcpsAcquisition::set_resampler_latency(uint32_t latency_samples)
 {
     acquisition_->set_resampler_latency(latency_samples);
 }
+
+
+void GpsL1CaPcpsAcquisition::arm_diagnostics(unsigned int n_attempts)
+{
+    acquisition_->arm_diagnostics(n_attempts);
+}
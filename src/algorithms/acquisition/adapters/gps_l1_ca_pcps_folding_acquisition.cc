@@ -0,0 +1,266 @@
+/*!
+ * \file gps_l1_ca_pcps_folding_acquisition.cc
+ * \brief Adapts a coherent-folding PCPS acquisition block to an
+ * AcquisitionInterface for GPS L1 C/A signals.
+ * \author Carles Fernandez, 2020. cfernandez(at)cttc.es
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gps_l1_ca_pcps_folding_acquisition.h"
+#include "GPS_L1_CA.h"
+#include "configuration_interface.h"
+#include "gnss_sdr_flags.h"
+#include "gps_sdr_signal_replica.h"
+#include <boost/math/distributions/exponential.hpp>
+#include <glog/logging.h>
+#include <algorithm>
+
+GpsL1CaPcpsFoldingAcquisition::GpsL1CaPcpsFoldingAcquisition(
+    const ConfigurationInterface* configuration,
+    const std::string& role,
+    unsigned int in_streams,
+    unsigned int out_streams) : role_(role),
+                                in_streams_(in_streams),
+                                out_streams_(out_streams)
+{
+    configuration_ = configuration;
+    const std::string default_item_type("gr_complex");
+    std::string default_dump_filename = "./data/acquisition.dat";
+
+    DLOG(INFO) << "role " << role;
+
+    item_type_ = configuration_->property(role + ".item_type", default_item_type);
+    int64_t fs_in_deprecated = configuration_->property("GNSS-SDR.internal_fs_hz", 2048000);
+    fs_in_ = configuration_->property("GNSS-SDR.internal_fs_sps", fs_in_deprecated);
+    dump_ = configuration_->property(role + ".dump", false);
+    doppler_max_ = configuration->property(role + ".doppler_max", 5000);
+    if (FLAGS_doppler_max != 0)
+        {
+            doppler_max_ = FLAGS_doppler_max;
+        }
+
+    // The coherent integration time directly sets the number of code periods
+    // that are coherently folded; the FFT stays at one code period
+    sampled_ms_ = configuration_->property(role + ".coherent_integration_time_ms", 20);
+    folding_factor_ = sampled_ms_;
+    max_dwells_ = configuration_->property(role + ".max_dwells", 1);
+
+    // -- Find number of samples per spreading code -------------------------
+    code_length_ = static_cast<unsigned int>(round(fs_in_ / (GPS_L1_CA_CODE_RATE_CPS / GPS_L1_CA_CODE_LENGTH_CHIPS)));
+
+    vector_length_ = code_length_ * folding_factor_;
+
+    dump_filename_ = configuration_->property(role + ".dump_filename", default_dump_filename);
+
+    bool enable_monitor_output = configuration_->property("AcquisitionMonitor.enable_monitor", false);
+
+    int samples_per_ms = round(code_length_);
+    code_ = std::vector<std::complex<float>>(code_length_);
+    LOG(INFO) << "Implementation: " << this->implementation()
+              << ", Vector Length: " << vector_length_
+              << ", Samples per ms: " << samples_per_ms
+              << ", Folding factor: " << folding_factor_
+              << ", Code Length: " << code_length_;
+
+    if (item_type_ == "gr_complex")
+        {
+            item_size_ = sizeof(gr_complex);
+            acquisition_cc_ = pcps_folding_make_acquisition_cc(folding_factor_,
+                max_dwells_, doppler_max_, fs_in_,
+                samples_per_ms, code_length_,
+                dump_, dump_filename_, enable_monitor_output);
+
+            stream_to_vector_ = gr::blocks::stream_to_vector::make(item_size_,
+                code_length_ * folding_factor_);
+
+            DLOG(INFO) << "stream_to_vector_folding(" << stream_to_vector_->unique_id() << ")";
+            DLOG(INFO) << "acquisition(" << acquisition_cc_->unique_id() << ")";
+        }
+    else
+        {
+            item_size_ = sizeof(gr_complex);
+            LOG(WARNING) << item_type_ << " unknown acquisition item type";
+        }
+
+    channel_ = 0;
+    threshold_ = 0.0;
+    doppler_step_ = 0;
+    gnss_synchro_ = nullptr;
+
+    if (in_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one input stream";
+        }
+    if (out_streams_ > 0)
+        {
+            LOG(ERROR) << "This implementation does not provide an output stream";
+        }
+}
+
+
+void GpsL1CaPcpsFoldingAcquisition::stop_acquisition()
+{
+    acquisition_cc_->set_state(0);
+    acquisition_cc_->set_active(false);
+}
+
+
+void GpsL1CaPcpsFoldingAcquisition::set_threshold(float threshold)
+{
+    float pfa = configuration_->property(role_ + std::to_string(channel_) + ".pfa", static_cast<float>(0.0));
+
+    if (pfa == 0.0)
+        {
+            pfa = configuration_->property(role_ + ".pfa", static_cast<float>(0.0));
+        }
+    if (pfa == 0.0)
+        {
+            threshold_ = threshold;
+        }
+    else
+        {
+            threshold_ = calculate_threshold(pfa);
+        }
+
+    DLOG(INFO) << "Channel " << channel_ << " Threshold = " << threshold_;
+
+    if (item_type_ == "gr_complex")
+        {
+            acquisition_cc_->set_threshold(threshold_);
+        }
+}
+
+
+void GpsL1CaPcpsFoldingAcquisition::set_doppler_max(unsigned int doppler_max)
+{
+    doppler_max_ = doppler_max;
+    if (item_type_ == "gr_complex")
+        {
+            acquisition_cc_->set_doppler_max(doppler_max_);
+        }
+}
+
+
+void GpsL1CaPcpsFoldingAcquisition::set_doppler_step(unsigned int doppler_step)
+{
+    doppler_step_ = doppler_step;
+    if (item_type_ == "gr_complex")
+        {
+            acquisition_cc_->set_doppler_step(doppler_step_);
+        }
+}
+
+
+void GpsL1CaPcpsFoldingAcquisition::set_gnss_synchro(Gnss_Synchro* gnss_synchro)
+{
+    gnss_synchro_ = gnss_synchro;
+    if (item_type_ == "gr_complex")
+        {
+            acquisition_cc_->set_gnss_synchro(gnss_synchro_);
+        }
+}
+
+
+signed int GpsL1CaPcpsFoldingAcquisition::mag()
+{
+    if (item_type_ == "gr_complex")
+        {
+            return acquisition_cc_->mag();
+        }
+    return 0;
+}
+
+
+void GpsL1CaPcpsFoldingAcquisition::init()
+{
+    acquisition_cc_->init();
+}
+
+
+void GpsL1CaPcpsFoldingAcquisition::set_local_code()
+{
+    if (item_type_ == "gr_complex")
+        {
+            gps_l1_ca_code_gen_complex_sampled(code_, gnss_synchro_->PRN, fs_in_, 0);
+
+            acquisition_cc_->set_local_code(code_.data());
+        }
+}
+
+
+void GpsL1CaPcpsFoldingAcquisition::reset()
+{
+    if (item_type_ == "gr_complex")
+        {
+            acquisition_cc_->set_active(true);
+        }
+}
+
+
+void GpsL1CaPcpsFoldingAcquisition::set_state(int state)
+{
+    if (item_type_ == "gr_complex")
+        {
+            acquisition_cc_->set_state(state);
+        }
+}
+
+
+float GpsL1CaPcpsFoldingAcquisition::calculate_threshold(float pfa) const
+{
+    // Calculate the threshold
+    unsigned int frequency_bins = 0;
+    for (int doppler = static_cast<int>(-doppler_max_); doppler <= static_cast<int>(doppler_max_); doppler += static_cast<int>(doppler_step_))
+        {
+            frequency_bins++;
+        }
+    DLOG(INFO) << "Channel " << channel_ << "  Pfa = " << pfa;
+    unsigned int ncells = code_length_ * frequency_bins;
+    double exponent = 1.0 / static_cast<double>(ncells);
+    double val = pow(1.0 - pfa, exponent);
+    auto lambda = static_cast<double>(code_length_);
+    boost::math::exponential_distribution<double> mydist(lambda);
+    auto threshold = static_cast<float>(quantile(mydist, val));
+
+    return threshold;
+}
+
+
+void GpsL1CaPcpsFoldingAcquisition::connect(gr::top_block_sptr top_block)
+{
+    if (item_type_ == "gr_complex")
+        {
+            top_block->connect(stream_to_vector_, 0, acquisition_cc_, 0);
+        }
+}
+
+
+void GpsL1CaPcpsFoldingAcquisition::disconnect(gr::top_block_sptr top_block)
+{
+    if (item_type_ == "gr_complex")
+        {
+            top_block->disconnect(stream_to_vector_, 0, acquisition_cc_, 0);
+        }
+}
+
+
+gr::basic_block_sptr GpsL1CaPcpsFoldingAcquisition::get_left_block()
+{
+    return stream_to_vector_;
+}
+
+
+gr::basic_block_sptr GpsL1CaPcpsFoldingAcquisition::get_right_block()
+{
+    return acquisition_cc_;
+}
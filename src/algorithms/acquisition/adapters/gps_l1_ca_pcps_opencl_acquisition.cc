@@ -60,6 +60,7 @@ GpsL1CaPcpsOpenClAcquisition::GpsL1CaPcpsOpenClAcquisition(
     sampled_ms_ = configuration->property(role + ".coherent_integration_time_ms", 1);
 
     bit_transition_flag_ = configuration->property("Acquisition.bit_transition_flag", false);
+    use_CFAR_algorithm_flag_ = configuration->property(role + ".use_CFAR_algorithm", true);
 
     if (!bit_transition_flag_)
         {
@@ -75,6 +76,7 @@ GpsL1CaPcpsOpenClAcquisition::GpsL1CaPcpsOpenClAcquisition(
 
     // -- Find number of samples per spreading code -------------------------
     code_length_ = static_cast<unsigned int>(round(fs_in_ / (GPS_L1_CA_CODE_RATE_CPS / GPS_L1_CA_CODE_LENGTH_CHIPS)));
+    samples_per_chip_ = static_cast<unsigned int>(ceil(static_cast<double>(fs_in_) / GPS_L1_CA_CODE_RATE_CPS));
 
     vector_length_ = code_length_ * sampled_ms_;
 
@@ -84,8 +86,8 @@ GpsL1CaPcpsOpenClAcquisition::GpsL1CaPcpsOpenClAcquisition(
         {
             item_size_ = sizeof(gr_complex);
             acquisition_cc_ = pcps_make_opencl_acquisition_cc(sampled_ms_, max_dwells_,
-                doppler_max_, fs_in_, code_length_, code_length_,
-                bit_transition_flag_, dump_, dump_filename_, false);
+                doppler_max_, fs_in_, code_length_, code_length_, samples_per_chip_,
+                bit_transition_flag_, use_CFAR_algorithm_flag_, dump_, dump_filename_, false);
 
             stream_to_vector_ = gr::blocks::stream_to_vector::make(item_size_, vector_length_);
 
@@ -165,6 +165,7 @@ private:
 
     unsigned int vector_length_;
     unsigned int code_length_;
+    unsigned int samples_per_chip_;
     unsigned int channel_;
     unsigned int doppler_max_;
     unsigned int doppler_step_;
@@ -173,6 +174,7 @@ private:
     unsigned int in_streams_;
     unsigned int out_streams_;
     bool bit_transition_flag_;
+    bool use_CFAR_algorithm_flag_;
     bool dump_;
 };
 
@@ -17,6 +17,7 @@
 
 #include "galileo_pcps_8ms_acquisition_cc.h"
 #include "MATH_CONSTANTS.h"
+#include "gnss_message_ids.h"
 #include "gnss_sdr_make_unique.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
@@ -77,17 +78,10 @@ galileo_pcps_8ms_acquisition_cc::galileo_pcps_8ms_acquisition_cc(
     d_fft_code_B = std::vector<gr_complex>(d_fft_size, lv_cmake(0.0F, 0.0F));
     d_magnitude = std::vector<float>(d_fft_size, 0.0F);
 
-#if GNURADIO_FFT_USES_TEMPLATES
-    // Direct FFT
-    d_fft_if = std::make_unique<gr::fft::fft_complex_fwd>(d_fft_size);
-    // Inverse FFT
-    d_ifft = std::make_unique<gr::fft::fft_complex_rev>(d_fft_size);
-#else
-    // Direct FFT
-    d_fft_if = std::make_unique<gr::fft::fft_complex>(d_fft_size, true);
-    // Inverse FFT
-    d_ifft = std::make_unique<gr::fft::fft_complex>(d_fft_size, false);
-#endif
+    // Direct FFT, with a plan drawn from the process-wide cache
+    d_fft_if = std::make_unique<Acq_Fft>(d_fft_size, true);
+    // Inverse FFT, with a plan drawn from the process-wide cache
+    d_ifft = std::make_unique<Acq_Fft>(d_fft_size, false);
 
     // For dumping samples into a file
     d_dump = dump;
@@ -386,7 +380,7 @@ int galileo_pcps_8ms_acquisition_cc::general_work(int noutput_items,
                 consume_each(ninput_items[0]);
 
                 acquisition_message = 1;
-                this->message_port_pub(pmt::mp("events"), pmt::from_long(acquisition_message));
+                this->message_port_pub(msg_ids::events_port(), msg_ids::event(acquisition_message));
 
                 // Copy and push current Gnss_Synchro to monitor queue
                 if (d_enable_monitor_output)
@@ -421,7 +415,7 @@ int galileo_pcps_8ms_acquisition_cc::general_work(int noutput_items,
                 consume_each(ninput_items[0]);
 
                 acquisition_message = 2;
-                this->message_port_pub(pmt::mp("events"), pmt::from_long(acquisition_message));
+                this->message_port_pub(msg_ids::events_port(), msg_ids::event(acquisition_message));
 
                 break;
             }
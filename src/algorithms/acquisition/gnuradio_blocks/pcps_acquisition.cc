@@ -20,12 +20,18 @@
  */
 
 #include "pcps_acquisition.h"
+#include "acq_code_cache.h"
+#include "acq_worker_pool.h"
 #include "GLONASS_L1_L2_CA.h"  // for GLONASS_PRN
 #include "MATH_CONSTANTS.h"    // for TWO_PI
+#include "cross_ambiguity_screen.h"
+#include "dump_budget.h"
 #include "gnss_frequencies.h"
+#include "gnss_message_ids.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_make_unique.h"
 #include "gnss_synchro.h"
+#include "memory_registry.h"
 #if HAS_STD_FILESYSTEM
 #if HAS_STD_FILESYSTEM_EXPERIMENTAL
 #include <experimental/filesystem>
@@ -79,6 +85,7 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_) : gr::block("pcps_acqu
     d_state = 0;
     d_doppler_bias = 0;
     d_num_noncoherent_integrations_counter = 0U;
+    d_tong_count = d_acq_parameters.tong_init_val;
     d_consumed_samples = d_acq_parameters.sampled_ms * d_acq_parameters.samples_per_ms * (d_acq_parameters.bit_transition_flag ? 2.0 : 1.0);
     if (d_acq_parameters.sampled_ms == d_acq_parameters.ms_per_code)
         {
@@ -123,28 +130,79 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_) : gr::block("pcps_acqu
     //  d_acq_parameters.max_dwells = 1;  // Activation of d_acq_parameters.bit_transition_flag invalidates the value of d_acq_parameters.max_dwells
     // }
 
-    d_tmp_buffer = volk_gnsssdr::vector<float>(d_fft_size);
-    d_fft_codes = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
-    d_input_signal = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
+    d_tmp_buffer = volk_gnsssdr::pool_vector<float>(d_fft_size);
+    d_input_signal = volk_gnsssdr::pool_vector<std::complex<float>>(d_fft_size);
 
-#if GNURADIO_FFT_USES_TEMPLATES
-    // Direct FFT
-    d_fft_if = std::make_unique<gr::fft::fft_complex_fwd>(d_fft_size);
-    // Inverse FFT
-    d_ifft = std::make_unique<gr::fft::fft_complex_rev>(d_fft_size);
-#else
-    // Direct FFT
-    d_fft_if = std::make_unique<gr::fft::fft_complex>(d_fft_size, true);
-    // Inverse FFT
-    d_ifft = std::make_unique<gr::fft::fft_complex>(d_fft_size, false);
-#endif
+    // Direct FFT, with a plan drawn from the process-wide cache
+    d_fft_if = std::make_unique<Acq_Fft>(d_fft_size, true);
+    // Inverse FFT, with a plan drawn from the process-wide cache
+    d_ifft = std::make_unique<Acq_Fft>(d_fft_size, false);
+
+    // Decimated coarse search: the first-step grid runs on boxcar
+    // pre-integrated samples, and the existing second step verifies the
+    // candidate at full rate
+    d_decim_factor = 1U;
+    d_fft_size_decim = d_fft_size;
+    if (d_acq_parameters.enable_decimated_search)
+        {
+            uint32_t factor = d_acq_parameters.decimation_factor;
+            if (factor == 0U)
+                {
+                    // Automatic selection: the stronger the expected signal,
+                    // the more pre-integration loss the coarse stage tolerates
+                    if (d_acq_parameters.expected_cn0_dB_hz >= 50.0)
+                        {
+                            factor = 8U;
+                        }
+                    else if (d_acq_parameters.expected_cn0_dB_hz >= 45.0)
+                        {
+                            factor = 4U;
+                        }
+                    else if (d_acq_parameters.expected_cn0_dB_hz >= 40.0)
+                        {
+                            factor = 2U;
+                        }
+                    else
+                        {
+                            factor = 1U;
+                        }
+                }
+            // Keep the decimated grid commensurate with the full-rate one and
+            // leave at least two samples per chip after pre-integration
+            while ((factor > 1U) and (((d_fft_size % factor) != 0U) or ((d_consumed_samples % factor) != 0U) or ((d_acq_parameters.samples_per_chip / factor) < 2U)))
+                {
+                    factor--;
+                }
+            if (factor > 1U)
+                {
+                    d_decim_factor = factor;
+                    d_fft_size_decim = d_fft_size / factor;
+                    d_fft_if_decim = std::make_unique<Acq_Fft>(d_fft_size_decim, true);
+                    d_ifft_decim = std::make_unique<Acq_Fft>(d_fft_size_decim, false);
+                    d_input_decim = volk_gnsssdr::pool_vector<std::complex<float>>(d_fft_size_decim);
+                    d_fft_codes_decim = volk_gnsssdr::pool_vector<std::complex<float>>(d_fft_size_decim);
+                    if (!d_acq_parameters.make_2_steps)
+                        {
+                            LOG(WARNING) << "The decimated acquisition search requires the full-rate verification step. Enabling make_two_steps";
+                            d_acq_parameters.make_2_steps = true;
+                        }
+                    DLOG(INFO) << "Decimated acquisition search enabled, decimation factor " << d_decim_factor;
+                }
+            else
+                {
+                    LOG(WARNING) << "Decimated acquisition search requested, but no suitable decimation factor exists for this sampling geometry. Running the search at full rate";
+                }
+        }
+
+    d_batch_fwd_plan = nullptr;
+    d_batch_inv_plan = nullptr;
 
     d_gnss_synchro = nullptr;
     d_worker_active = false;
-    d_data_buffer = volk_gnsssdr::vector<std::complex<float>>(d_consumed_samples);
+    d_data_buffer = volk_gnsssdr::pool_vector<std::complex<float>>(d_consumed_samples);
     if (d_cshort)
         {
-            d_data_buffer_sc = volk_gnsssdr::vector<lv_16sc_t>(d_consumed_samples);
+            d_data_buffer_sc = volk_gnsssdr::pool_vector<lv_16sc_t>(d_consumed_samples);
         }
     d_grid = arma::fmat();
     d_narrow_grid = arma::fmat();
@@ -157,6 +215,29 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_) : gr::block("pcps_acqu
     d_dump_number = 0LL;
     d_dump_channel = d_acq_parameters.dump_channel;
     d_dump = d_acq_parameters.dump;
+    d_diag_attempts_armed = 0;
+    d_offload_warned = false;
+    if (!d_acq_parameters.offload_address.empty())
+        {
+            d_offload = std::make_unique<Acq_Offload_Client>(d_acq_parameters.offload_address, d_acq_parameters.offload_port);
+            DLOG(INFO) << "Acquisition offload enabled, server " << d_acq_parameters.offload_address << ":" << d_acq_parameters.offload_port;
+        }
+    if (d_acq_parameters.accelerator == "sycl")
+        {
+#if USE_SYCL_GRID_SEARCH
+            try
+                {
+                    d_sycl_search = std::make_unique<Sycl_Grid_Search>(d_fft_size);
+                    LOG(INFO) << "Acquisition grid search running on SYCL device: " << d_sycl_search->device_name();
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "SYCL accelerator requested but unavailable (" << e.what() << "), falling back to the CPU grid search";
+                }
+#else
+            LOG(WARNING) << "SYCL accelerator requested but this build was configured without SYCL grid search support, falling back to the CPU grid search";
+#endif
+        }
     d_dump_filename = d_acq_parameters.dump_filename;
     if (d_dump)
         {
@@ -192,6 +273,98 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_) : gr::block("pcps_acqu
 }
 
 
+pcps_acquisition::~pcps_acquisition()
+{
+    Memory_Registry::release(this);
+    Dump_Budget::release(this);
+    destroy_batch_fft_plans();
+}
+
+
+void pcps_acquisition::destroy_batch_fft_plans()
+{
+    gr::fft::planner::scoped_lock lock(gr::fft::planner::mutex());  // protect the FFTW planner, it is not thread-safe
+    if (d_batch_fwd_plan != nullptr)
+        {
+            fftwf_destroy_plan(d_batch_fwd_plan);
+            d_batch_fwd_plan = nullptr;
+        }
+    if (d_batch_inv_plan != nullptr)
+        {
+            fftwf_destroy_plan(d_batch_inv_plan);
+            d_batch_inv_plan = nullptr;
+        }
+}
+
+
+void pcps_acquisition::update_batch_fft_plans()
+{
+    // Pack the whole Doppler grid into one contiguous buffer and plan a single
+    // many-transform FFT over it, so all bins are computed in one FFTW call
+    destroy_batch_fft_plans();
+    d_batch_inbuf = volk_gnsssdr::pool_vector<std::complex<float>>(static_cast<size_t>(d_num_doppler_bins) * d_fft_size);
+    d_batch_outbuf = volk_gnsssdr::pool_vector<std::complex<float>>(static_cast<size_t>(d_num_doppler_bins) * d_fft_size);
+
+    gr::fft::planner::scoped_lock lock(gr::fft::planner::mutex());  // protect the FFTW planner, it is not thread-safe
+    const int fft_size = static_cast<int>(d_fft_size);
+    const int howmany = static_cast<int>(d_num_doppler_bins);
+    auto* inbuf = reinterpret_cast<fftwf_complex*>(d_batch_inbuf.data());
+    auto* outbuf = reinterpret_cast<fftwf_complex*>(d_batch_outbuf.data());
+    d_batch_fwd_plan = fftwf_plan_many_dft(1, &fft_size, howmany,
+        inbuf, &fft_size, 1, fft_size,
+        outbuf, &fft_size, 1, fft_size,
+        FFTW_FORWARD, FFTW_MEASURE);
+    d_batch_inv_plan = fftwf_plan_many_dft(1, &fft_size, howmany,
+        outbuf, &fft_size, 1, fft_size,
+        inbuf, &fft_size, 1, fft_size,
+        FFTW_BACKWARD, FFTW_MEASURE);
+}
+
+
+void pcps_acquisition::compute_doppler_grid_batched(const gr_complex* in, int32_t effective_fft_size)
+{
+    // Remove Doppler from all bins into one contiguous batch
+    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+        {
+            volk_32fc_x2_multiply_32fc(d_batch_inbuf.data() + static_cast<size_t>(doppler_index) * d_fft_size, in, d_grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
+        }
+
+    // Single many-transform FFT covering the whole Doppler grid
+    fftwf_execute(d_batch_fwd_plan);
+
+    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
+    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+        {
+            gr_complex* row = d_batch_outbuf.data() + static_cast<size_t>(doppler_index) * d_fft_size;
+            volk_32fc_x2_multiply_32fc(row, row, d_fft_codes->data(), d_fft_size);
+        }
+
+    // Single many-transform inverse FFT, results go back to d_batch_inbuf
+    fftwf_execute(d_batch_inv_plan);
+
+    // Compute squared magnitude (and accumulate in case of non-coherent integration)
+    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
+    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+        {
+            const gr_complex* row = d_batch_inbuf.data() + static_cast<size_t>(doppler_index) * d_fft_size;
+            if (d_num_noncoherent_integrations_counter == 1)
+                {
+                    volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), row + offset, effective_fft_size);
+                }
+            else
+                {
+                    volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), row + offset, effective_fft_size);
+                    volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
+                }
+            // Record results to file if required
+            if (d_dump and d_channel == d_dump_channel)
+                {
+                    memcpy(d_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
+                }
+        }
+}
+
+
 void pcps_acquisition::set_resampler_latency(uint32_t latency_samples)
 {
     gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
@@ -211,6 +384,41 @@ void pcps_acquisition::set_local_code(std::complex<float>* code)
     // [ 0 0 0 ... 0 c_0 c_1 ... c_L]
     // where c_i is the local code and there are L zeros and L chips
     gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+
+    if (d_decim_factor > 1U)
+        {
+            // Boxcar-decimated replica for the coarse search; it is cheap to
+            // rebuild, so it bypasses the process-wide code cache
+            gr_complex* inbuf = d_fft_if_decim->get_inbuf();
+            const uint32_t consumed_decim = d_consumed_samples / d_decim_factor;
+            const uint32_t offset_decim = d_fft_size_decim - consumed_decim;
+            std::fill_n(inbuf, offset_decim, gr_complex(0.0, 0.0));
+            for (uint32_t i = 0; i < consumed_decim; i++)
+                {
+                    gr_complex acc(0.0, 0.0);
+                    for (uint32_t k = 0; k < d_decim_factor; k++)
+                        {
+                            acc += code[i * d_decim_factor + k];
+                        }
+                    inbuf[offset_decim + i] = acc;
+                }
+            d_fft_if_decim->execute();
+            volk_32fc_conjugate_32fc(d_fft_codes_decim.data(), d_fft_if_decim->get_outbuf(), d_fft_size_decim);
+        }
+
+    // The conjugated FFT'd replica only depends on the signal, the PRN and the
+    // sampling geometry, so draw it from the process-wide cache when possible
+    std::string cache_key;
+    if (d_gnss_synchro != nullptr)
+        {
+            cache_key = std::string(d_gnss_synchro->Signal, 2) + '_' + std::to_string(d_gnss_synchro->PRN) + '_' + std::to_string(d_fft_size) + '_' + std::to_string(d_acq_parameters.resampled_fs) + '_' + (d_acq_parameters.bit_transition_flag ? '1' : '0');
+            d_fft_codes = Acq_Code_Cache::get_instance().get(cache_key);
+            if (d_fft_codes != nullptr)
+                {
+                    return;
+                }
+        }
+
     if (d_acq_parameters.bit_transition_flag)
         {
             const int32_t offset = d_fft_size / 2;
@@ -231,7 +439,16 @@ void pcps_acquisition::set_local_code(std::complex<float>* code)
         }
 
     d_fft_if->execute();  // We need the FFT of local code
-    volk_32fc_conjugate_32fc(d_fft_codes.data(), d_fft_if->get_outbuf(), d_fft_size);
+    auto fft_codes = std::make_shared<Acq_Code_Cache::code_vector>(d_fft_size);
+    volk_32fc_conjugate_32fc(fft_codes->data(), d_fft_if->get_outbuf(), d_fft_size);
+    if (!cache_key.empty())
+        {
+            d_fft_codes = Acq_Code_Cache::get_instance().insert(cache_key, std::move(fft_codes));
+        }
+    else
+        {
+            d_fft_codes = std::move(fft_codes);
+        }
 }
 
 
@@ -290,31 +507,98 @@ void pcps_acquisition::init()
     // Create the carrier Doppler wipeoff signals
     if (d_grid_doppler_wipeoffs.empty())
         {
-            d_grid_doppler_wipeoffs = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(d_num_doppler_bins, volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
+            d_grid_doppler_wipeoffs = volk_gnsssdr::pool_vector<volk_gnsssdr::pool_vector<std::complex<float>>>(d_num_doppler_bins, volk_gnsssdr::pool_vector<std::complex<float>>(d_fft_size));
         }
     if (d_acq_parameters.make_2_steps && (d_grid_doppler_wipeoffs_step_two.empty()))
         {
-            d_grid_doppler_wipeoffs_step_two = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(d_num_doppler_bins_step2, volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
+            d_grid_doppler_wipeoffs_step_two = volk_gnsssdr::pool_vector<volk_gnsssdr::pool_vector<std::complex<float>>>(d_num_doppler_bins_step2, volk_gnsssdr::pool_vector<std::complex<float>>(d_fft_size));
+        }
+    if ((d_decim_factor > 1U) and d_grid_doppler_wipeoffs_decim.empty())
+        {
+            d_grid_doppler_wipeoffs_decim = volk_gnsssdr::pool_vector<volk_gnsssdr::pool_vector<std::complex<float>>>(d_num_doppler_bins, volk_gnsssdr::pool_vector<std::complex<float>>(d_fft_size_decim));
         }
 
     if (d_magnitude_grid.empty())
         {
-            d_magnitude_grid = volk_gnsssdr::vector<volk_gnsssdr::vector<float>>(d_num_doppler_bins, volk_gnsssdr::vector<float>(d_fft_size));
+            d_magnitude_grid = volk_gnsssdr::pool_vector<volk_gnsssdr::pool_vector<float>>(d_num_doppler_bins, volk_gnsssdr::pool_vector<float>(d_fft_size));
         }
+    d_grid_rows.resize(d_num_doppler_bins);
 
     for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
         {
             std::fill(d_magnitude_grid[doppler_index].begin(), d_magnitude_grid[doppler_index].end(), 0.0);
         }
 
+    // Doppler bin visiting order: center-out around the assisted Doppler when
+    // early exit is enabled (the grid is already centered on d_doppler_center),
+    // natural order otherwise
+    d_doppler_bin_order.resize(d_num_doppler_bins);
+    if (d_acq_parameters.enable_early_exit)
+        {
+            const auto num_bins = static_cast<int32_t>(d_num_doppler_bins);
+            const int32_t center = num_bins / 2;
+            uint32_t i = 0;
+            for (int32_t k = 0; k <= num_bins; k++)
+                {
+                    if ((center + k) < num_bins)
+                        {
+                            d_doppler_bin_order[i++] = static_cast<uint32_t>(center + k);
+                        }
+                    if ((k > 0) and ((center - k) >= 0))
+                        {
+                            d_doppler_bin_order[i++] = static_cast<uint32_t>(center - k);
+                        }
+                }
+        }
+    else
+        {
+            for (uint32_t i = 0; i < d_num_doppler_bins; i++)
+                {
+                    d_doppler_bin_order[i] = i;
+                }
+        }
+
     update_grid_doppler_wipeoffs();
+
+    if (d_acq_parameters.use_batched_fft and (d_batch_inbuf.size() != static_cast<size_t>(d_num_doppler_bins) * d_fft_size))
+        {
+            update_batch_fft_plans();
+        }
+
     d_worker_active = false;
 
     if (d_dump)
         {
             const uint32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? (d_fft_size / 2) : d_fft_size);
-            d_grid = arma::fmat(effective_fft_size, d_num_doppler_bins, arma::fill::zeros);
-            d_narrow_grid = arma::fmat(effective_fft_size, d_num_doppler_bins_step2, arma::fill::zeros);
+            const size_t grid_bytes = sizeof(float) * effective_fft_size * (d_num_doppler_bins + d_num_doppler_bins_step2);
+            // the dump keeps a full copy of the search grids resident; a
+            // decimated grant is of no use here, so anything short of a
+            // full grant disables the grid dump
+            const Dump_Budget::Grant grant = Dump_Budget::request(this, "Acquisition", grid_bytes);
+            if (!grant.enabled or grant.decimation > 1)
+                {
+                    Dump_Budget::release(this);
+                    LOG(WARNING) << "Acquisition grid dump disabled on channel " << d_channel
+                                 << ": the search grid copy does not fit in the dump budget";
+                    d_dump = false;
+                }
+            else
+                {
+                    d_grid = arma::fmat(effective_fft_size, d_num_doppler_bins, arma::fill::zeros);
+                    d_narrow_grid = arma::fmat(effective_fft_size, d_num_doppler_bins_step2, arma::fill::zeros);
+                    Memory_Registry::report(this, "Acquisition", "dump grids", grid_bytes);
+                }
+        }
+
+    // report the dominant buffers to the memory accounting registry
+    Memory_Registry::report(this, "Acquisition", "Doppler wipeoff grid",
+        sizeof(std::complex<float>) * d_fft_size * (d_num_doppler_bins + (d_acq_parameters.make_2_steps ? d_num_doppler_bins_step2 : 0U)));
+    Memory_Registry::report(this, "Acquisition", "magnitude grid",
+        sizeof(float) * d_fft_size * d_num_doppler_bins);
+    if (d_acq_parameters.use_batched_fft)
+        {
+            Memory_Registry::report(this, "Acquisition", "batched FFT buffers",
+                sizeof(std::complex<float>) * (d_batch_inbuf.size() + d_batch_outbuf.size()));
         }
 }
 
@@ -325,6 +609,13 @@ void pcps_acquisition::update_grid_doppler_wipeoffs()
         {
             const int32_t doppler = -static_cast<int32_t>(d_acq_parameters.doppler_max) + d_doppler_center + d_doppler_step * doppler_index;
             update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], static_cast<float>(d_doppler_bias + doppler));
+            if ((d_decim_factor > 1U) and !d_grid_doppler_wipeoffs_decim.empty())
+                {
+                    // The carrier generator advances one full-rate phase step
+                    // per sample, so scaling the frequency by the decimation
+                    // factor yields the wipeoff at the decimated rate
+                    update_local_carrier(d_grid_doppler_wipeoffs_decim[doppler_index], static_cast<float>((d_doppler_bias + doppler) * static_cast<int32_t>(d_decim_factor)));
+                }
         }
 }
 
@@ -365,6 +656,29 @@ void pcps_acquisition::set_state(int32_t state)
 
 void pcps_acquisition::send_positive_acquisition()
 {
+    if (d_acq_parameters.enable_xcorr_screening)
+        {
+            // Reject peaks better explained as cross-correlation aliases of a
+            // strong satellite already being tracked on the same signal
+            uint32_t culprit_prn = 0U;
+            if (Cross_Ambiguity_Screen::get_instance().is_probable_alias(d_gnss_synchro->System,
+                    std::string(d_gnss_synchro->Signal),
+                    d_gnss_synchro->PRN,
+                    d_gnss_synchro->Acq_doppler_hz,
+                    static_cast<double>(d_acq_parameters.ms_per_code) * 0.001,
+                    static_cast<double>(d_acq_parameters.xcorr_doppler_tolerance_hz),
+                    static_cast<double>(d_acq_parameters.xcorr_alias_floor_cn0_db_hz),
+                    &culprit_prn))
+                {
+                    LOG(INFO) << "Discarding probable cross-correlation false acquisition"
+                              << ", satellite " << d_gnss_synchro->System << " " << d_gnss_synchro->PRN
+                              << ", doppler " << d_gnss_synchro->Acq_doppler_hz
+                              << ", aliased from tracked PRN " << culprit_prn;
+                    send_negative_acquisition();
+                    return;
+                }
+        }
+
     // Declare positive acquisition using a message port
     // 0=STOP_CHANNEL 1=ACQ_SUCCEES 2=ACQ_FAIL
     DLOG(INFO) << "positive acquisition"
@@ -386,7 +700,7 @@ void pcps_acquisition::send_positive_acquisition()
         }
     else
         {
-            this->message_port_pub(pmt::mp("events"), pmt::from_long(1));
+            this->message_port_pub(msg_ids::events_port(), msg_ids::positive_acquisition());
         }
 
     // Copy and push current Gnss_Synchro to monitor queue
@@ -413,7 +727,64 @@ void pcps_acquisition::send_negative_acquisition()
                << ", magnitude " << d_mag
                << ", input signal power " << d_input_power;
     d_positive_acq = 0;
-    this->message_port_pub(pmt::mp("events"), pmt::from_long(2));
+    this->message_port_pub(msg_ids::events_port(), msg_ids::negative_acquisition());
+}
+
+
+void pcps_acquisition::arm_diagnostics(uint32_t n_attempts)
+{
+    d_diag_attempts_armed.store(static_cast<int32_t>(std::min(n_attempts, 1000U)), std::memory_order_relaxed);
+    LOG(INFO) << "Acquisition diagnostics armed for the next " << n_attempts << " attempts on channel " << d_channel;
+}
+
+
+void pcps_acquisition::diag_export(int32_t effective_fft_size)
+{
+    if (!d_diag_sink)
+        {
+            d_diag_sink = std::make_unique<Acq_Diag_Sink>(d_acq_parameters.diag_address, d_acq_parameters.diag_port);
+        }
+    // max-pool the magnitude grid down to at most 32 x 64 bins so the
+    // record fits comfortably in a single datagram
+    const uint32_t max_doppler_bins = 32U;
+    const uint32_t max_code_bins = 64U;
+    const uint32_t dop_factor = (d_num_doppler_bins + max_doppler_bins - 1U) / max_doppler_bins;
+    const auto code_size = static_cast<uint32_t>(effective_fft_size);
+    const uint32_t code_factor = (code_size + max_code_bins - 1U) / max_code_bins;
+    const uint32_t out_rows = (d_num_doppler_bins + dop_factor - 1U) / dop_factor;
+    const uint32_t out_cols = (code_size + code_factor - 1U) / code_factor;
+    std::vector<float> grid(static_cast<std::size_t>(out_rows) * out_cols, 0.0);
+    for (uint32_t row = 0; row < d_num_doppler_bins; row++)
+        {
+            float* out_row = grid.data() + static_cast<std::size_t>(row / dop_factor) * out_cols;
+            const float* in_row = d_magnitude_grid[row].data();
+            for (uint32_t col = 0; col < code_size; col++)
+                {
+                    float& cell = out_row[col / code_factor];
+                    cell = std::max(cell, in_row[col]);
+                }
+        }
+
+    Acq_Diag_Record record{};
+    record.magic = 0x47534151;  // "GSAQ"
+    record.version = 1;
+    record.positive_acq = static_cast<uint8_t>(d_positive_acq);
+    record.prn = static_cast<uint8_t>(d_gnss_synchro->PRN);
+    record.system = d_gnss_synchro->System;
+    record.signal[0] = d_gnss_synchro->Signal[0];
+    record.signal[1] = d_gnss_synchro->Signal[1];
+    record.channel = static_cast<uint16_t>(d_channel);
+    record.doppler_bins = out_rows;
+    record.code_bins = out_cols;
+    record.doppler_max = d_acq_parameters.doppler_max;
+    record.doppler_step = static_cast<float>(d_doppler_step);
+    record.test_statistic = d_test_statistics;
+    record.threshold = d_threshold;
+    record.doppler_hz = static_cast<float>(d_gnss_synchro->Acq_doppler_hz);
+    record.code_phase_samples = static_cast<float>(d_gnss_synchro->Acq_delay_samples);
+    record.input_power = d_input_power;
+    record.sample_counter = d_sample_counter;
+    d_diag_sink->write_record(record, grid);
 }
 
 
@@ -523,22 +894,17 @@ void pcps_acquisition::dump_results(int32_t effective_fft_size)
 float pcps_acquisition::max_to_input_power_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step)
 {
     float grid_maximum = 0.0;
+    float second_peak = 0.0;
     uint32_t index_doppler = 0U;
-    uint32_t tmp_intex_t = 0U;
     uint32_t index_time = 0U;
     const int32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
 
-    // Find the correlation peak and the carrier frequency
+    // Find the correlation peak and the carrier frequency in a single grid scan
     for (uint32_t i = 0; i < num_doppler_bins; i++)
         {
-            volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_magnitude_grid[i].data(), effective_fft_size);
-            if (d_magnitude_grid[i][tmp_intex_t] > grid_maximum)
-                {
-                    grid_maximum = d_magnitude_grid[i][tmp_intex_t];
-                    index_doppler = i;
-                    index_time = tmp_intex_t;
-                }
+            d_grid_rows[i] = d_magnitude_grid[i].data();
         }
+    volk_gnsssdr_32f_xn_grid_peak_32u(&grid_maximum, &second_peak, &index_doppler, &index_time, d_grid_rows.data(), 0U, num_doppler_bins, effective_fft_size);
     indext = index_time;
     if (!d_step_two)
         {
@@ -555,6 +921,43 @@ float pcps_acquisition::max_to_input_power_statistic(uint32_t& indext, int32_t&
 }
 
 
+double pcps_acquisition::refine_doppler_estimate(uint32_t indext, int32_t doppler) const
+{
+    // Quadratic interpolation of the correlation peak across the step-two
+    // Doppler bins at the detected code delay. The three magnitudes around
+    // the winning bin are already in the narrow grid, so the fitted vertex
+    // delivers a carrier estimate well below the bin spacing at no extra
+    // correlation cost, shortening the tracking pull-in
+    uint32_t best_bin = 0;
+    float best_mag = 0.0F;
+    for (uint32_t k = 0; k < d_num_doppler_bins_step2; k++)
+        {
+            if (d_magnitude_grid[k][indext] > best_mag)
+                {
+                    best_mag = d_magnitude_grid[k][indext];
+                    best_bin = k;
+                }
+        }
+    if (best_bin == 0 or best_bin >= d_num_doppler_bins_step2 - 1)
+        {
+            return static_cast<double>(doppler);
+        }
+    const float left = d_magnitude_grid[best_bin - 1][indext];
+    const float peak = d_magnitude_grid[best_bin][indext];
+    const float right = d_magnitude_grid[best_bin + 1][indext];
+    const float denom = left - 2.0F * peak + right;
+    if (denom >= 0.0F)
+        {
+            // not a local maximum, keep the bin estimate
+            return static_cast<double>(doppler);
+        }
+    // the vertex of a genuine peak lies within half a bin of the maximum
+    float offset = 0.5F * (left - right) / denom;
+    offset = std::max(std::min(offset, 0.5F), -0.5F);
+    return static_cast<double>(doppler) + static_cast<double>(offset * d_acq_parameters.doppler_step2);
+}
+
+
 float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step)
 {
     // Look for correlation peaks in the results
@@ -562,21 +965,18 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
     // The second peak is chosen not closer than 1 chip to the highest peak
 
     float firstPeak = 0.0;
+    float secondPeak = 0.0;
     uint32_t index_doppler = 0U;
-    uint32_t tmp_intex_t = 0U;
     uint32_t index_time = 0U;
 
-    // Find the correlation peak and the carrier frequency
+    // Find the first and second correlation peaks and the carrier frequency
+    // in a single grid scan. The second peak is taken from the same freq. bin,
+    // not closer than 1 chip (circularly) to the highest peak.
     for (uint32_t i = 0; i < num_doppler_bins; i++)
         {
-            volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_magnitude_grid[i].data(), d_fft_size);
-            if (d_magnitude_grid[i][tmp_intex_t] > firstPeak)
-                {
-                    firstPeak = d_magnitude_grid[i][tmp_intex_t];
-                    index_doppler = i;
-                    index_time = tmp_intex_t;
-                }
+            d_grid_rows[i] = d_magnitude_grid[i].data();
         }
+    volk_gnsssdr_32f_xn_grid_peak_32u(&firstPeak, &secondPeak, &index_doppler, &index_time, d_grid_rows.data(), d_samplesPerChip, num_doppler_bins, d_fft_size);
     indext = index_time;
 
     if (!d_step_two)
@@ -588,40 +988,118 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
             doppler = static_cast<int32_t>(d_doppler_center_step_two + (static_cast<float>(index_doppler) - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0))) * d_acq_parameters.doppler_step2);
         }
 
-    // Find 1 chip wide code phase exclude range around the peak
-    int32_t excludeRangeIndex1 = index_time - d_samplesPerChip;
-    int32_t excludeRangeIndex2 = index_time + d_samplesPerChip;
+    // Compute the test statistics and compare to the threshold
+    return firstPeak / secondPeak;
+}
+
 
-    // Correct code phase exclude range if the range includes array boundaries
-    if (excludeRangeIndex1 < 0)
+bool pcps_acquisition::try_offload_acquisition(const gr_complex* in, uint32_t& indext, int32_t& doppler)
+{
+    Acq_Offload_Reply reply{};
+    const int64_t fs = (d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in);
+    // The server sweeps absolute wipeoff frequencies, so the FDMA bias is
+    // folded into the grid start and removed again from the reply
+    const int32_t doppler_min = -d_acq_parameters.doppler_max + d_doppler_center + d_doppler_bias;
+    if (!d_offload->grid_search(in, d_fft_size, d_fft_codes->data(), fs,
+            doppler_min, static_cast<int32_t>(d_doppler_step), d_num_doppler_bins, &reply))
         {
-            excludeRangeIndex1 = d_fft_size + excludeRangeIndex1;
+            if (!d_offload_warned)
+                {
+                    LOG(WARNING) << "Acquisition offload to " << d_acq_parameters.offload_address << ":" << d_acq_parameters.offload_port
+                                 << " unavailable, channel " << d_channel << " falls back to the local grid search";
+                    d_offload_warned = true;
+                }
+            return false;
         }
-    else if (excludeRangeIndex2 >= static_cast<int32_t>(d_fft_size))
+    d_offload_warned = false;
+    d_test_statistics = reply.test_statistic;
+    d_input_power = reply.input_power;
+    d_mag = reply.peak_magnitude;
+    indext = reply.delay_index;
+    doppler = reply.doppler_hz - d_doppler_bias;
+    return true;
+}
+
+
+bool pcps_acquisition::decimated_grid_search(const gr_complex* in, uint32_t& indext, int32_t& doppler)
+{
+    // Boxcar pre-integration: the coarse statistic tolerates the associated
+    // code-phase smearing and scalloping loss, because the second step
+    // re-estimates delay and Doppler at full rate around the candidate
+    for (uint32_t i = 0; i < d_fft_size_decim; i++)
         {
-            excludeRangeIndex2 = excludeRangeIndex2 - d_fft_size;
+            gr_complex acc(0.0, 0.0);
+            for (uint32_t k = 0; k < d_decim_factor; k++)
+                {
+                    acc += in[i * d_decim_factor + k];
+                }
+            d_input_decim[i] = acc;
         }
 
-    int32_t idx = excludeRangeIndex1;
-    memcpy(d_tmp_buffer.data(), d_magnitude_grid[index_doppler].data(), d_fft_size * sizeof(float));
-    do
+    float grid_maximum = 0.0;
+    float power_sum = 0.0;
+    uint32_t index_time = 0U;
+    int32_t doppler_hz_max = 0;
+    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
         {
-            d_tmp_buffer[idx] = 0.0;
-            idx++;
-            if (idx == static_cast<int32_t>(d_fft_size))
+            const int32_t doppler_hz = -static_cast<int32_t>(d_acq_parameters.doppler_max) + d_doppler_center + d_doppler_step * static_cast<int32_t>(doppler_index);
+
+            // Remove Doppler at the decimated rate
+            volk_32fc_x2_multiply_32fc(d_fft_if_decim->get_inbuf(), d_input_decim.data(), d_grid_doppler_wipeoffs_decim[doppler_index].data(), d_fft_size_decim);
+
+            // FFT-based circular correlation against the decimated replica
+            d_fft_if_decim->execute();
+            volk_32fc_x2_multiply_32fc(d_ifft_decim->get_inbuf(), d_fft_if_decim->get_outbuf(), d_fft_codes_decim.data(), d_fft_size_decim);
+            d_ifft_decim->execute();
+
+            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft_decim->get_outbuf(), d_fft_size_decim);
+            uint32_t row_indext = 0U;
+            float row_sum = 0.0;
+            volk_gnsssdr_32f_index_max_32u(&row_indext, d_tmp_buffer.data(), d_fft_size_decim);
+            volk_32f_accumulator_s32f(&row_sum, d_tmp_buffer.data(), d_fft_size_decim);
+            power_sum += row_sum;
+            if (d_tmp_buffer[row_indext] > grid_maximum)
                 {
-                    idx = 0;
+                    grid_maximum = d_tmp_buffer[row_indext];
+                    index_time = row_indext;
+                    doppler_hz_max = doppler_hz;
                 }
         }
-    while (idx != excludeRangeIndex2);
 
-    // Find the second highest correlation peak in the same freq. bin ---
-    volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_tmp_buffer.data(), d_fft_size);
-    const float secondPeak = d_tmp_buffer[tmp_intex_t];
+    // Peak-to-mean statistic over the decimated grid, with the peak cell
+    // excluded from the noise-floor estimate. Each dwell stands on its own:
+    // this engine does not integrate noncoherently across dwells
+    d_mag = grid_maximum;
+    d_input_power = (power_sum - grid_maximum) / (static_cast<float>(d_fft_size_decim) * static_cast<float>(d_num_doppler_bins) - 1.0F) / 2.0F;
+    d_test_statistics = grid_maximum / d_input_power;
+    indext = index_time * d_decim_factor;  // back to full-rate sample units
+    doppler = doppler_hz_max;
+    return true;
+}
+
 
-    // Compute the test statistics and compare to the threshold
-    return firstPeak / secondPeak;
+#if USE_SYCL_GRID_SEARCH
+bool pcps_acquisition::try_sycl_grid_search(const gr_complex* in, uint32_t& indext, int32_t& doppler)
+{
+    Sycl_Acq_Result result{};
+    const int64_t fs = (d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in);
+    // The device sweeps absolute wipeoff frequencies, so the FDMA bias is
+    // folded into the grid start and removed again from the result
+    const int32_t doppler_min = -d_acq_parameters.doppler_max + d_doppler_center + d_doppler_bias;
+    if (!d_sycl_search->grid_search(in, d_fft_codes->data(), fs,
+            doppler_min, static_cast<int32_t>(d_doppler_step), d_num_doppler_bins, &result))
+        {
+            LOG(WARNING) << "SYCL grid search failed on channel " << d_channel << ", falling back to the CPU grid search";
+            return false;
+        }
+    d_test_statistics = result.test_statistic;
+    d_input_power = result.input_power;
+    d_mag = result.peak_magnitude;
+    indext = result.delay_index;
+    doppler = result.doppler_hz - d_doppler_bias;
+    return true;
 }
+#endif
 
 
 void pcps_acquisition::acquisition_core(uint64_t samp_count)
@@ -631,6 +1109,7 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
     // Initialize acquisition algorithm
     int32_t doppler = 0;
     uint32_t indext = 0U;
+    bool early_exit_triggered = false;
     const int32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
     if (d_cshort)
         {
@@ -664,41 +1143,156 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
     // Doppler frequency grid loop
     if (!d_step_two)
         {
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+            bool remote_done = false;
+            bool decim_done = false;
+            if (d_offload and !d_acq_parameters.bit_transition_flag and
+                !d_acq_parameters.split_two_halves and !d_acq_parameters.accumulate_dwells)
                 {
-                    // Remove Doppler
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
-
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
-
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
+                    // Ship the snapshot to the acquisition server; any failure
+                    // falls back to the local grid search below
+                    remote_done = try_offload_acquisition(in, indext, doppler);
+                }
+#if USE_SYCL_GRID_SEARCH
+            if (!remote_done and d_sycl_search and !d_acq_parameters.bit_transition_flag and
+                !d_acq_parameters.split_two_halves and !d_acq_parameters.accumulate_dwells and
+                (d_acq_parameters.max_dwells == 1))
+                {
+                    // The device returns the statistics of a single dwell, so
+                    // noncoherent integration across dwells stays on the CPU path
+                    remote_done = try_sycl_grid_search(in, indext, doppler);
+                }
+#endif
+            if (remote_done)
+                {
+                    // (delay, Doppler, test statistic) already set from the
+                    // server reply or the accelerator result
+                }
+            else if ((d_decim_factor > 1U) and !d_acq_parameters.accumulate_dwells)
+                {
+                    // Coarse stage of the decimated search; the candidate is
+                    // verified at full rate by the second step
+                    decim_done = decimated_grid_search(in, indext, doppler);
+                }
+            else if (d_acq_parameters.use_batched_fft and !d_acq_parameters.split_two_halves)
+                {
+                    // Batched engine: all Doppler bins in one many-transform FFT
+                    compute_doppler_grid_batched(in, effective_fft_size);
+                }
+            else
+                {
+                    for (uint32_t bin = 0; bin < d_num_doppler_bins; bin++)
+                        {
+                            // Center-out order around the assisted Doppler when early exit is enabled
+                            const uint32_t doppler_index = d_doppler_bin_order[bin];
 
-                    // Compute the inverse FFT
-                    d_ifft->execute();
+                            if (d_acq_parameters.split_two_halves)
+                                {
+                                    // Correlate two half-length coherent segments and combine them
+                                    // noncoherently, so a nav-bit edge can corrupt at most one of
+                                    // the halves instead of nulling the whole coherent integration
+                                    const uint32_t half_size = d_fft_size / 2;
+                                    for (uint32_t half = 0; half < 2; half++)
+                                        {
+                                            const uint32_t half_offset = half * half_size;
+                                            std::fill(d_fft_if->get_inbuf(), d_fft_if->get_inbuf() + d_fft_size, gr_complex(0.0, 0.0));
+                                            volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf() + half_offset, in + half_offset, d_grid_doppler_wipeoffs[doppler_index].data() + half_offset, half_size);
+                                            d_fft_if->execute();
+                                            volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes->data(), d_fft_size);
+                                            d_ifft->execute();
+                                            if ((d_num_noncoherent_integrations_counter == 1) and (half == 0))
+                                                {
+                                                    volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf(), effective_fft_size);
+                                                }
+                                            else
+                                                {
+                                                    volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf(), effective_fft_size);
+                                                    volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
+                                                }
+                                        }
+                                }
+                            else
+                                {
+                                    // Remove Doppler
+                                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
+
+                                    // Perform the FFT-based convolution  (parallel time search)
+                                    // Compute the FFT of the carrier wiped--off incoming signal
+                                    d_fft_if->execute();
+
+                                    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
+                                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes->data(), d_fft_size);
+
+                                    // Compute the inverse FFT
+                                    d_ifft->execute();
+
+                                    // Compute squared magnitude (and accumulate in case of non-coherent integration)
+                                    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
+                                    if (d_num_noncoherent_integrations_counter == 1)
+                                        {
+                                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, effective_fft_size);
+                                        }
+                                    else
+                                        {
+                                            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf() + offset, effective_fft_size);
+                                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
+                                        }
+                                }
+                            // Record results to file if required
+                            if (d_dump and d_channel == d_dump_channel)
+                                {
+                                    memcpy(d_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
+                                }
 
-                    // Compute squared magnitude (and accumulate in case of non-coherent integration)
-                    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
-                        {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                        }
-                    else
-                        {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
+                            // Early exit: if this bin already clears the threshold by the
+                            // configured margin, skip the rest of the Doppler grid
+                            if (d_acq_parameters.enable_early_exit)
+                                {
+                                    uint32_t row_indext = 0U;
+                                    float row_sum = 0.0;
+                                    volk_gnsssdr_32f_index_max_32u(&row_indext, d_magnitude_grid[doppler_index].data(), effective_fft_size);
+                                    volk_32f_accumulator_s32f(&row_sum, d_magnitude_grid[doppler_index].data(), effective_fft_size);
+                                    const float row_peak = d_magnitude_grid[doppler_index][row_indext];
+                                    const float row_power = (row_sum - row_peak) / static_cast<float>(effective_fft_size - 1) / 2.0F / static_cast<float>(d_num_noncoherent_integrations_counter);
+                                    const float row_statistic = row_peak / row_power;
+                                    if (row_statistic > d_threshold * d_acq_parameters.early_exit_margin)
+                                        {
+                                            d_test_statistics = row_statistic;
+                                            d_input_power = row_power;
+                                            indext = row_indext;
+                                            doppler = -static_cast<int32_t>(d_acq_parameters.doppler_max) + d_doppler_center + d_doppler_step * static_cast<int32_t>(doppler_index);
+                                            early_exit_triggered = true;
+                                            DLOG(INFO) << "Early exit after " << bin + 1 << " of " << d_num_doppler_bins
+                                                       << " Doppler bins, test statistics " << row_statistic;
+                                            break;
+                                        }
+                                }
                         }
-                    // Record results to file if required
-                    if (d_dump and d_channel == d_dump_channel)
+                }
+
+            // Accumulation-grid mode: the magnitude grid keeps integrating
+            // noncoherently across dwells, so the full peak search runs only
+            // once, on the last dwell, instead of after every dwell
+            if (d_acq_parameters.accumulate_dwells and !early_exit_triggered and
+                (d_num_noncoherent_integrations_counter < d_acq_parameters.max_dwells))
+                {
+                    if (d_acq_parameters.blocking)
                         {
-                            memcpy(d_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
+                            lk.lock();
                         }
+                    d_buffer_count = 0U;
+                    d_state = 1;
+                    d_worker_active = false;
+                    return;
                 }
 
             // Compute the test statistic
-            if (d_use_CFAR_algorithm_flag)
+            if (early_exit_triggered or remote_done or decim_done)
+                {
+                    // already computed on the bin that triggered the exit,
+                    // received from the acquisition server, or computed on
+                    // the decimated grid
+                }
+            else if (d_use_CFAR_algorithm_flag)
                 {
                     d_test_statistics = max_to_input_power_statistic(indext, doppler, d_num_doppler_bins, d_acq_parameters.doppler_max, d_doppler_step);
                 }
@@ -733,7 +1327,7 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
 
                     // Multiply carrier wiped--off, Fourier transformed incoming signal
                     // with the local FFT'd code reference using SIMD operations with VOLK library
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
+                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes->data(), d_fft_size);
 
                     // compute the inverse FFT
                     d_ifft->execute();
@@ -769,14 +1363,14 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                     // take into account the acquisition resampler ratio
                     d_gnss_synchro->Acq_delay_samples = static_cast<double>(std::fmod(static_cast<float>(indext), d_acq_parameters.samples_per_code)) * d_acq_parameters.resampler_ratio;
                     d_gnss_synchro->Acq_delay_samples -= static_cast<double>(d_acq_parameters.resampler_latency_samples);  // account the resampler filter latency
-                    d_gnss_synchro->Acq_doppler_hz = static_cast<double>(doppler);
+                    d_gnss_synchro->Acq_doppler_hz = refine_doppler_estimate(indext, doppler);
                     d_gnss_synchro->Acq_samplestamp_samples = rint(static_cast<double>(samp_count) * d_acq_parameters.resampler_ratio);
                     d_gnss_synchro->Acq_doppler_step = d_acq_parameters.doppler_step2;
                 }
             else
                 {
                     d_gnss_synchro->Acq_delay_samples = static_cast<double>(std::fmod(static_cast<float>(indext), d_acq_parameters.samples_per_code));
-                    d_gnss_synchro->Acq_doppler_hz = static_cast<double>(doppler);
+                    d_gnss_synchro->Acq_doppler_hz = refine_doppler_estimate(indext, doppler);
                     d_gnss_synchro->Acq_samplestamp_samples = samp_count;
                     d_gnss_synchro->Acq_doppler_step = d_acq_parameters.doppler_step2;
                 }
@@ -787,7 +1381,53 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
             lk.lock();
         }
 
-    if (!d_acq_parameters.bit_transition_flag)
+    if (d_acq_parameters.use_tong_detector and !d_acq_parameters.bit_transition_flag and !d_step_two)
+        {
+            // Tong sequential detector: the per-dwell threshold crossing
+            // drives an up/down counter instead of deciding on its own; the
+            // cell is declared present at tong_max_val, dismissed when the
+            // counter drains to zero or max_dwells is exhausted
+            if (d_test_statistics > d_threshold)
+                {
+                    d_tong_count++;
+                }
+            else if (d_tong_count > 0)
+                {
+                    d_tong_count--;
+                }
+            if (d_tong_count >= d_acq_parameters.tong_max_val)
+                {
+                    d_active = false;
+                    if (d_acq_parameters.make_2_steps)
+                        {
+                            d_step_two = true;  // Clear input buffer and make small grid acquisition
+                            d_num_noncoherent_integrations_counter = 0;
+                            d_positive_acq = 0;
+                            d_state = 0;
+                            calculate_threshold();
+                        }
+                    else
+                        {
+                            send_positive_acquisition();
+                            d_state = 0;  // Positive acquisition
+                        }
+                }
+            else if (d_tong_count == 0 or d_num_noncoherent_integrations_counter == d_acq_parameters.max_dwells)
+                {
+                    send_negative_acquisition();
+                    d_state = 0;
+                    d_active = false;
+                    // mark the attempt as complete so the epilogue resets the
+                    // dwell counters and dumps the grid if requested
+                    d_num_noncoherent_integrations_counter = d_acq_parameters.max_dwells;
+                }
+            else
+                {
+                    d_buffer_count = 0;
+                    d_state = 1;  // keep dwelling on this cell
+                }
+        }
+    else if (!d_acq_parameters.bit_transition_flag)
         {
             if (d_test_statistics > d_threshold)
                 {
@@ -885,8 +1525,14 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                 {
                     pcps_acquisition::dump_results(effective_fft_size);
                 }
+            if (d_diag_attempts_armed.load(std::memory_order_relaxed) > 0)
+                {
+                    diag_export(effective_fft_size);
+                    d_diag_attempts_armed.fetch_sub(1, std::memory_order_relaxed);
+                }
             d_num_noncoherent_integrations_counter = 0U;
             d_positive_acq = 0;
+            d_tong_count = d_acq_parameters.tong_init_val;
         }
 }
 
@@ -1020,8 +1666,12 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
                     }
                 else
                     {
-                        gr::thread::thread d_worker(&pcps_acquisition::acquisition_core, this, d_sample_counter);
+                        // Hand the grid search to the shared worker pool, so a burst
+                        // of acquisitions cannot oversubscribe the CPU and starve
+                        // the tracking channels
                         d_worker_active = true;
+                        const uint64_t sample_counter = d_sample_counter;
+                        Acq_Worker_Pool::get_instance().enqueue([this, sample_counter] { acquisition_core(sample_counter); });
                     }
                 consume_each(0);
                 d_buffer_count = 0U;
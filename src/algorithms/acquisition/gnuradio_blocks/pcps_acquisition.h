@@ -43,7 +43,13 @@
 #endif
 
 #include "acq_conf.h"
+#include "acq_diag_sink.h"
+#include "acq_fft.h"
+#include "acq_offload.h"
 #include "channel_fsm.h"
+#if USE_SYCL_GRID_SEARCH
+#include "sycl_grid_search.h"
+#endif
 #include <armadillo>
 #include <glog/logging.h>
 #include <gnuradio/block.h>
@@ -53,10 +59,12 @@
 #include <gnuradio/types.h>                   // for gr_vector_const_void_star
 #include <volk/volk_complex.h>                // for lv_16sc_t
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <atomic>
 #include <complex>
 #include <cstdint>
 #include <memory>
 #include <queue>
+#include <vector>
 #include <string>
 #include <utility>
 
@@ -92,7 +100,7 @@ pcps_acquisition_sptr pcps_make_acquisition(const Acq_Conf& conf_);
 class pcps_acquisition : public gr::block
 {
 public:
-    ~pcps_acquisition() = default;
+    ~pcps_acquisition();
 
     /*!
      * \brief Initializes acquisition algorithm and reserves memory.
@@ -125,6 +133,14 @@ public:
 
     void set_resampler_latency(uint32_t latency_samples);
 
+    /*!
+     * \brief Arms the diagnostic export: the next n_attempts concluded
+     * acquisition attempts send their test statistics and a downsampled
+     * search grid over UDP (AcquisitionDiag.client_address / udp_port).
+     * Costs one relaxed atomic load per attempt when not armed.
+     */
+    void arm_diagnostics(uint32_t n_attempts);
+
     /*!
      * \brief Returns the maximum peak of grid search.
      */
@@ -219,34 +235,59 @@ private:
     explicit pcps_acquisition(const Acq_Conf& conf_);
 
     void update_local_carrier(own::span<gr_complex> carrier_vector, float freq) const;
+    void update_batch_fft_plans();
+    void destroy_batch_fft_plans();
+    void compute_doppler_grid_batched(const gr_complex* in, int32_t effective_fft_size);
     void update_grid_doppler_wipeoffs();
     void update_grid_doppler_wipeoffs_step2();
     void acquisition_core(uint64_t samp_count);
+    bool try_offload_acquisition(const gr_complex* in, uint32_t& indext, int32_t& doppler);
+    bool decimated_grid_search(const gr_complex* in, uint32_t& indext, int32_t& doppler);
+#if USE_SYCL_GRID_SEARCH
+    bool try_sycl_grid_search(const gr_complex* in, uint32_t& indext, int32_t& doppler);
+#endif
     void send_negative_acquisition();
     void send_positive_acquisition();
     void dump_results(int32_t effective_fft_size);
+    void diag_export(int32_t effective_fft_size);
     bool is_fdma();
     bool start();
     void calculate_threshold(void);
     float first_vs_second_peak_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
     float max_to_input_power_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
-
-    volk_gnsssdr::vector<volk_gnsssdr::vector<float>> d_magnitude_grid;
-    volk_gnsssdr::vector<float> d_tmp_buffer;
-    volk_gnsssdr::vector<std::complex<float>> d_input_signal;
-    volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_grid_doppler_wipeoffs;
-    volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_grid_doppler_wipeoffs_step_two;
-    volk_gnsssdr::vector<std::complex<float>> d_fft_codes;
-    volk_gnsssdr::vector<std::complex<float>> d_data_buffer;
-    volk_gnsssdr::vector<lv_16sc_t> d_data_buffer_sc;
-
-#if GNURADIO_FFT_USES_TEMPLATES
-    std::unique_ptr<gr::fft::fft_complex_fwd> d_fft_if;
-    std::unique_ptr<gr::fft::fft_complex_rev> d_ifft;
-#else
-    std::unique_ptr<gr::fft::fft_complex> d_fft_if;
-    std::unique_ptr<gr::fft::fft_complex> d_ifft;
-#endif
+    double refine_doppler_estimate(uint32_t indext, int32_t doppler) const;
+
+    // Work buffers go through the volk_gnsssdr block pool: they are rebuilt on
+    // every acquisition reconfiguration, so their storage is recycled instead
+    // of going back to the operating system. d_fft_codes stays on the plain
+    // allocator because its type is shared with Acq_Code_Cache.
+    volk_gnsssdr::pool_vector<volk_gnsssdr::pool_vector<float>> d_magnitude_grid;
+    std::vector<uint32_t> d_doppler_bin_order;
+    std::vector<const float*> d_grid_rows;
+    volk_gnsssdr::pool_vector<float> d_tmp_buffer;
+    volk_gnsssdr::pool_vector<std::complex<float>> d_input_signal;
+    volk_gnsssdr::pool_vector<std::complex<float>> d_input_decim;
+    volk_gnsssdr::pool_vector<std::complex<float>> d_fft_codes_decim;
+    volk_gnsssdr::pool_vector<volk_gnsssdr::pool_vector<std::complex<float>>> d_grid_doppler_wipeoffs_decim;
+    volk_gnsssdr::pool_vector<volk_gnsssdr::pool_vector<std::complex<float>>> d_grid_doppler_wipeoffs;
+    volk_gnsssdr::pool_vector<volk_gnsssdr::pool_vector<std::complex<float>>> d_grid_doppler_wipeoffs_step_two;
+    std::shared_ptr<const volk_gnsssdr::vector<std::complex<float>>> d_fft_codes;
+    volk_gnsssdr::pool_vector<std::complex<float>> d_data_buffer;
+    volk_gnsssdr::pool_vector<lv_16sc_t> d_data_buffer_sc;
+    volk_gnsssdr::pool_vector<std::complex<float>> d_batch_inbuf;
+    volk_gnsssdr::pool_vector<std::complex<float>> d_batch_outbuf;
+
+    std::unique_ptr<Acq_Fft> d_fft_if;
+    std::unique_ptr<Acq_Fft> d_ifft;
+
+    // Reduced-size FFT pair serving the decimated coarse search
+    std::unique_ptr<Acq_Fft> d_fft_if_decim;
+    std::unique_ptr<Acq_Fft> d_ifft_decim;
+
+    // Many-transform FFTW plans covering the whole Doppler grid (batched engine).
+    // fftwf_plan is available through <gnuradio/fft/fft.h>
+    fftwf_plan d_batch_fwd_plan;
+    fftwf_plan d_batch_inv_plan;
 
     std::weak_ptr<ChannelFsm> d_channel_fsm;
 
@@ -258,6 +299,16 @@ private:
     std::queue<Gnss_Synchro> d_monitor_queue;
     std::string d_dump_filename;
 
+    // created lazily by the worker on the first armed attempt
+    std::unique_ptr<Acq_Diag_Sink> d_diag_sink;
+    std::atomic<int32_t> d_diag_attempts_armed;
+
+    std::unique_ptr<Acq_Offload_Client> d_offload;
+
+#if USE_SYCL_GRID_SEARCH
+    std::unique_ptr<Sycl_Grid_Search> d_sycl_search;
+#endif
+
     int64_t d_dump_number;
     uint64_t d_sample_counter;
 
@@ -275,7 +326,10 @@ private:
     uint32_t d_samplesPerChip;
     uint32_t d_doppler_step;
     uint32_t d_num_noncoherent_integrations_counter;
+    uint32_t d_tong_count;  // up/down counter of the Tong sequential detector
     uint32_t d_fft_size;
+    uint32_t d_decim_factor;  // boxcar pre-integration length of the decimated coarse search (1: full rate)
+    uint32_t d_fft_size_decim;  // FFT size of the decimated coarse search
     uint32_t d_consumed_samples;
     uint32_t d_num_doppler_bins;
     uint32_t d_num_doppler_bins_step2;
@@ -287,6 +341,7 @@ private:
     bool d_cshort;
     bool d_step_two;
     bool d_use_CFAR_algorithm_flag;
+    bool d_offload_warned;
     bool d_dump;
 };
 
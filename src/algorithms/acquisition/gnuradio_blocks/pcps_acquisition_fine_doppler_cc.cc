@@ -18,6 +18,7 @@
 
 #include "pcps_acquisition_fine_doppler_cc.h"
 #include "GPS_L1_CA.h"  // for GPS_L1_CA_CHIP_PERIOD_S
+#include "gnss_message_ids.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_make_unique.h"
 #include "gps_sdr_signal_replica.h"
@@ -77,17 +78,10 @@ pcps_acquisition_fine_doppler_cc::pcps_acquisition_fine_doppler_cc(const Acq_Con
     d_fft_codes.reserve(d_fft_size);
     d_magnitude.reserve(d_fft_size);
     d_10_ms_buffer.reserve(50 * d_samples_per_ms);
-#if GNURADIO_FFT_USES_TEMPLATES
-    // Direct FFT
-    d_fft_if = std::make_unique<gr::fft::fft_complex_fwd>(d_fft_size);
-    // Inverse FFT
-    d_ifft = std::make_unique<gr::fft::fft_complex_rev>(d_fft_size);
-#else
-    // Direct FFT
-    d_fft_if = std::make_unique<gr::fft::fft_complex>(d_fft_size, true);
-    // Inverse FFT
-    d_ifft = std::make_unique<gr::fft::fft_complex>(d_fft_size, false);
-#endif
+    // Direct FFT, with a plan drawn from the process-wide cache
+    d_fft_if = std::make_unique<Acq_Fft>(d_fft_size, true);
+    // Inverse FFT, with a plan drawn from the process-wide cache
+    d_ifft = std::make_unique<Acq_Fft>(d_fft_size, false);
 
     // For dumping samples into a file
     d_dump = conf_.dump;
@@ -383,11 +377,7 @@ int pcps_acquisition_fine_doppler_cc::estimate_Doppler()
     int signal_samples = prn_replicas * d_fft_size;
     // int fft_size_extended = nextPowerOf2(signal_samples * zero_padding_factor);
     int fft_size_extended = signal_samples * zero_padding_factor;
-#if GNURADIO_FFT_USES_TEMPLATES
-    auto fft_operator = std::make_unique<gr::fft::fft_complex_fwd>(fft_size_extended);
-#else
-    auto fft_operator = std::make_unique<gr::fft::fft_complex>(fft_size_extended, true);
-#endif
+    auto fft_operator = std::make_unique<Acq_Fft>(fft_size_extended, true);
     // zero padding the entire vector
     std::fill_n(fft_operator->get_inbuf(), fft_size_extended, gr_complex(0.0, 0.0));
 
@@ -586,7 +576,7 @@ int pcps_acquisition_fine_doppler_cc::general_work(int noutput_items,
                     dump_results(d_fft_size);
                 }
             // Send message to channel port //0=STOP_CHANNEL 1=ACQ_SUCCEES 2=ACQ_FAIL
-            this->message_port_pub(pmt::mp("events"), pmt::from_long(1));
+            this->message_port_pub(msg_ids::events_port(), msg_ids::positive_acquisition());
             d_state = 0;
             if (!acq_parameters.blocking_on_standby)
                 {
@@ -619,7 +609,7 @@ int pcps_acquisition_fine_doppler_cc::general_work(int noutput_items,
                     dump_results(d_fft_size);
                 }
             // Send message to channel port //0=STOP_CHANNEL 1=ACQ_SUCCEES 2=ACQ_FAIL
-            this->message_port_pub(pmt::mp("events"), pmt::from_long(2));
+            this->message_port_pub(msg_ids::events_port(), msg_ids::negative_acquisition());
             d_state = 0;
             if (!acq_parameters.blocking_on_standby)
                 {
@@ -19,6 +19,7 @@
 #include "pcps_assisted_acquisition_cc.h"
 #include "MATH_CONSTANTS.h"
 #include "concurrent_map.h"
+#include "gnss_message_ids.h"
 #include "gnss_sdr_make_unique.h"
 #include "gps_acq_assist.h"
 #include <glog/logging.h>
@@ -428,7 +429,7 @@ int pcps_assisted_acquisition_cc::general_work(int noutput_items,
             DLOG(INFO) << "input signal power " << d_input_power;
             d_active = false;
             // Send message to channel port //0=STOP_CHANNEL 1=ACQ_SUCCESS 2=ACQ_FAIL
-            this->message_port_pub(pmt::mp("events"), pmt::from_long(1));
+            this->message_port_pub(msg_ids::events_port(), msg_ids::positive_acquisition());
             // consume samples to not block the GNU Radio flowgraph
             d_sample_counter += static_cast<uint64_t>(ninput_items[0]);  // sample counter
             consume_each(ninput_items[0]);
@@ -454,7 +455,7 @@ int pcps_assisted_acquisition_cc::general_work(int noutput_items,
             DLOG(INFO) << "input signal power " << d_input_power;
             d_active = false;
             // Send message to channel port //0=STOP_CHANNEL 1=ACQ_SUCCESS 2=ACQ_FAIL
-            this->message_port_pub(pmt::mp("events"), pmt::from_long(2));
+            this->message_port_pub(msg_ids::events_port(), msg_ids::negative_acquisition());
             // consume samples to not block the GNU Radio flowgraph
             d_sample_counter += static_cast<uint64_t>(ninput_items[0]);  // sample counter
             consume_each(ninput_items[0]);
@@ -22,6 +22,7 @@
 
 #include "pcps_cccwsr_acquisition_cc.h"
 #include "MATH_CONSTANTS.h"  // TWO_PI
+#include "gnss_message_ids.h"
 #include "gnss_sdr_make_unique.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
@@ -405,7 +406,7 @@ int pcps_cccwsr_acquisition_cc::general_work(int noutput_items,
                 consume_each(ninput_items[0]);
 
                 acquisition_message = 1;
-                this->message_port_pub(pmt::mp("events"), pmt::from_long(acquisition_message));
+                this->message_port_pub(msg_ids::events_port(), msg_ids::event(acquisition_message));
 
                 // Copy and push current Gnss_Synchro to monitor queue
                 if (d_enable_monitor_output)
@@ -440,7 +441,7 @@ int pcps_cccwsr_acquisition_cc::general_work(int noutput_items,
                 consume_each(ninput_items[0]);
 
                 acquisition_message = 2;
-                this->message_port_pub(pmt::mp("events"), pmt::from_long(acquisition_message));
+                this->message_port_pub(msg_ids::events_port(), msg_ids::event(acquisition_message));
 
                 break;
             }
@@ -0,0 +1,392 @@
+/*!
+ * \file pcps_folding_acquisition_cc.cc
+ * \brief This class implements a Parallel Code Phase Search Acquisition with
+ * coherent folding (partial matched filtering) for long integration times
+ * \author Carles Fernandez, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pcps_folding_acquisition_cc.h"
+#include "MATH_CONSTANTS.h"
+#include "gnss_message_ids.h"
+#include "gnss_sdr_make_unique.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+
+pcps_folding_acquisition_cc_sptr pcps_folding_make_acquisition_cc(
+    uint32_t folding_factor,
+    uint32_t max_dwells,
+    uint32_t doppler_max,
+    int64_t fs_in,
+    int32_t samples_per_ms,
+    int32_t samples_per_code,
+    bool dump,
+    const std::string& dump_filename,
+    bool enable_monitor_output)
+{
+    return pcps_folding_acquisition_cc_sptr(
+        new pcps_folding_acquisition_cc(
+            folding_factor, max_dwells, doppler_max,
+            fs_in, samples_per_ms, samples_per_code,
+            dump, dump_filename,
+            enable_monitor_output));
+}
+
+
+pcps_folding_acquisition_cc::pcps_folding_acquisition_cc(
+    uint32_t folding_factor,
+    uint32_t max_dwells,
+    uint32_t doppler_max, int64_t fs_in,
+    int32_t samples_per_ms, int32_t samples_per_code,
+    bool dump,
+    const std::string& dump_filename,
+    bool enable_monitor_output) : gr::block("pcps_folding_acquisition_cc",
+                                      gr::io_signature::make(1, 1, static_cast<int>(sizeof(gr_complex) * samples_per_code * folding_factor)),
+                                      gr::io_signature::make(0, 1, sizeof(Gnss_Synchro)))
+{
+    this->message_port_register_out(pmt::mp("events"));
+    d_sample_counter = 0ULL;  // SAMPLE COUNTER
+    d_active = false;
+    d_state = 0;
+    d_fs_in = fs_in;
+    d_samples_per_ms = samples_per_ms;
+    d_samples_per_code = samples_per_code;
+    d_max_dwells = max_dwells;
+    d_well_count = 0;
+    d_doppler_max = doppler_max;
+    d_mag = 0;
+    d_input_power = 0.0;
+    d_num_doppler_bins = 0;
+    d_folding_factor = (folding_factor == 0 ? 1 : folding_factor);
+
+    // The FFT stays at one code period regardless of the integration time
+    d_fft_size = d_samples_per_code;
+
+    d_fft_codes = volk_gnsssdr::vector<gr_complex>(d_fft_size);
+    d_wiped_signal = volk_gnsssdr::vector<gr_complex>(d_samples_per_code * d_folding_factor);
+    d_magnitude = volk_gnsssdr::vector<float>(d_samples_per_code * d_folding_factor);
+    d_magnitude_folded = volk_gnsssdr::vector<float>(d_fft_size);
+
+    // Direct FFT, with a plan drawn from the process-wide cache
+    d_fft_if = std::make_unique<Acq_Fft>(d_fft_size, true);
+    // Inverse FFT, with a plan drawn from the process-wide cache
+    d_ifft = std::make_unique<Acq_Fft>(d_fft_size, false);
+
+    // For dumping samples into a file
+    d_dump = dump;
+    d_dump_filename = dump_filename;
+
+    d_enable_monitor_output = enable_monitor_output;
+
+    d_threshold = 0;
+    d_doppler_step = 0;
+    d_gnss_synchro = nullptr;
+    d_test_statistics = 0;
+    d_channel = 0;
+}
+
+
+void pcps_folding_acquisition_cc::set_local_code(std::complex<float>* code)
+{
+    memcpy(d_fft_if->get_inbuf(), code, sizeof(gr_complex) * d_fft_size);
+
+    d_fft_if->execute();  // We need the FFT of local code
+
+    // Conjugate the local code
+    volk_32fc_conjugate_32fc(d_fft_codes.data(), d_fft_if->get_outbuf(), d_fft_size);
+}
+
+
+void pcps_folding_acquisition_cc::init()
+{
+    d_gnss_synchro->Flag_valid_acquisition = false;
+    d_gnss_synchro->Flag_valid_symbol_output = false;
+    d_gnss_synchro->Flag_valid_pseudorange = false;
+    d_gnss_synchro->Flag_valid_word = false;
+    d_gnss_synchro->Acq_delay_samples = 0.0;
+    d_gnss_synchro->Acq_doppler_hz = 0.0;
+    d_gnss_synchro->Acq_samplestamp_samples = 0ULL;
+    d_gnss_synchro->Acq_doppler_step = 0U;
+    d_mag = 0.0;
+    d_input_power = 0.0;
+
+    if (d_doppler_step == 0)
+        {
+            // Folding N code periods narrows the Doppler response by N, so
+            // use half-bin spacing over the extended coherent time by default
+            d_doppler_step = std::max(static_cast<uint32_t>(500 / (2 * d_folding_factor)), 1U);
+        }
+
+    // Count the number of bins
+    d_num_doppler_bins = 0;
+    for (auto doppler = static_cast<int32_t>(-d_doppler_max);
+         doppler <= static_cast<int32_t>(d_doppler_max);
+         doppler += d_doppler_step)
+        {
+            d_num_doppler_bins++;
+        }
+
+    // Create the carrier Doppler wipeoff signals, spanning the full-length block
+    d_grid_doppler_wipeoffs = volk_gnsssdr::vector<volk_gnsssdr::vector<gr_complex>>(d_num_doppler_bins, volk_gnsssdr::vector<gr_complex>(d_samples_per_code * d_folding_factor));
+    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+        {
+            const int32_t doppler = -static_cast<int32_t>(d_doppler_max) + d_doppler_step * doppler_index;
+            const float phase_step_rad = static_cast<float>(TWO_PI) * doppler / static_cast<float>(d_fs_in);
+            std::array<float, 1> _phase{};
+            volk_gnsssdr_s32f_sincos_32fc(d_grid_doppler_wipeoffs[doppler_index].data(), -phase_step_rad, _phase.data(), d_samples_per_code * d_folding_factor);
+        }
+}
+
+
+void pcps_folding_acquisition_cc::set_state(int32_t state)
+{
+    d_state = state;
+    if (d_state == 1)
+        {
+            d_gnss_synchro->Acq_delay_samples = 0.0;
+            d_gnss_synchro->Acq_doppler_hz = 0.0;
+            d_gnss_synchro->Acq_samplestamp_samples = 0ULL;
+            d_gnss_synchro->Acq_doppler_step = 0U;
+            d_well_count = 0;
+            d_mag = 0.0;
+            d_input_power = 0.0;
+            d_test_statistics = 0.0;
+            d_active = true;
+        }
+    else if (d_state == 0)
+        {
+        }
+    else
+        {
+            LOG(ERROR) << "State can only be set to 0 or 1";
+        }
+}
+
+
+int pcps_folding_acquisition_cc::general_work(int noutput_items,
+    gr_vector_int& ninput_items, gr_vector_const_void_star& input_items,
+    gr_vector_void_star& output_items)
+{
+    /*
+     * Acquisition strategy (folded PCPS):
+     * 1. Compute the input signal power estimation over the full-length block
+     * 2. Doppler serial search loop, wiping the carrier off at full length
+     * 3. Fold the wiped-off signal modulo one code period (coherent sum)
+     * 4. Perform the FFT-based circular convolution over one code period
+     * 5. Record the maximum peak and the associated synchronization parameters
+     * 6. Declare positive or negative acquisition using a message port
+     */
+    int32_t acquisition_message = -1;  // 0=STOP_CHANNEL 1=ACQ_SUCCEES 2=ACQ_FAIL
+    const uint32_t block_size = d_samples_per_code * d_folding_factor;
+    switch (d_state)
+        {
+        case 0:
+            {
+                if (d_active)
+                    {
+                        // restart acquisition variables
+                        d_gnss_synchro->Acq_delay_samples = 0.0;
+                        d_gnss_synchro->Acq_doppler_hz = 0.0;
+                        d_gnss_synchro->Acq_samplestamp_samples = 0ULL;
+                        d_gnss_synchro->Acq_doppler_step = 0U;
+                        d_well_count = 0;
+                        d_mag = 0.0;
+                        d_input_power = 0.0;
+                        d_test_statistics = 0.0;
+
+                        d_state = 1;
+                    }
+
+                d_sample_counter += static_cast<uint64_t>(block_size) * ninput_items[0];  // sample counter
+                consume_each(ninput_items[0]);
+                break;
+            }
+
+        case 1:
+            {
+                int32_t doppler;
+                uint32_t indext = 0;
+                float magt = 0.0;
+                const auto* in = reinterpret_cast<const gr_complex*>(input_items[0]);  // Get the input samples pointer
+                const float fft_normalization_factor = static_cast<float>(d_fft_size) * static_cast<float>(d_fft_size);
+
+                d_input_power = 0.0;
+                d_mag = 0.0;
+
+                d_sample_counter += static_cast<uint64_t>(block_size);  // sample counter
+
+                d_well_count++;
+
+                DLOG(INFO) << "Channel: " << d_channel
+                           << " , doing acquisition of satellite: "
+                           << d_gnss_synchro->System << " " << d_gnss_synchro->PRN
+                           << " ,algorithm: pcps_folding_acquisition"
+                           << " ,folding factor: " << d_folding_factor
+                           << " ,sample stamp: " << d_sample_counter << ", threshold: "
+                           << d_threshold << ", doppler_max: " << d_doppler_max
+                           << ", doppler_step: " << d_doppler_step;
+
+                // 1- Compute the input signal power estimation over the whole block
+                volk_32fc_magnitude_squared_32f(d_magnitude.data(), in, block_size);
+                volk_32f_accumulator_s32f(&d_input_power, d_magnitude.data(), block_size);
+                d_input_power /= static_cast<float>(block_size);
+
+                // 2- Doppler frequency search loop
+                for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+                    {
+                        doppler = -static_cast<int32_t>(d_doppler_max) + d_doppler_step * doppler_index;
+
+                        // Remove Doppler over the full-length block, so the coherent
+                        // sum of code periods below does not lose the narrowband gain
+                        volk_32fc_x2_multiply_32fc(d_wiped_signal.data(), in,
+                            d_grid_doppler_wipeoffs[doppler_index].data(), block_size);
+
+                        // 3- Fold the wiped-off signal modulo one code period
+                        memcpy(d_fft_if->get_inbuf(), d_wiped_signal.data(), sizeof(gr_complex) * d_fft_size);
+                        for (uint32_t i = 1; i < d_folding_factor; i++)
+                            {
+                                volk_32fc_x2_add_32fc(d_fft_if->get_inbuf(),
+                                    d_fft_if->get_inbuf(),
+                                    d_wiped_signal.data() + static_cast<size_t>(i) * d_fft_size,
+                                    d_fft_size);
+                            }
+
+                        // 4- Perform the FFT-based convolution (parallel time search)
+                        d_fft_if->execute();
+
+                        // Multiply carrier wiped--off, Fourier transformed incoming
+                        // signal with the local FFT'd code reference
+                        volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
+                            d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
+
+                        // compute the inverse FFT
+                        d_ifft->execute();
+
+                        // Compute the magnitude and get the maximum value with its index
+                        volk_32fc_magnitude_squared_32f(d_magnitude_folded.data(),
+                            d_ifft->get_outbuf(), d_fft_size);
+                        volk_gnsssdr_32f_index_max_32u(&indext, d_magnitude_folded.data(), d_fft_size);
+
+                        // Normalize the maximum value to correct the scale factor
+                        // introduced by FFTW, and the folding gain
+                        magt = d_magnitude_folded[indext] / (fft_normalization_factor * fft_normalization_factor * static_cast<float>(d_folding_factor) * static_cast<float>(d_folding_factor));
+
+                        // 5- record the maximum peak and the associated synchronization parameters
+                        if (d_mag < magt)
+                            {
+                                d_mag = magt;
+                                d_gnss_synchro->Acq_delay_samples = static_cast<double>(indext % d_samples_per_code);
+                                d_gnss_synchro->Acq_doppler_hz = static_cast<double>(doppler);
+                                d_gnss_synchro->Acq_samplestamp_samples = d_sample_counter;
+                                d_gnss_synchro->Acq_doppler_step = d_doppler_step;
+                                d_test_statistics = d_mag / d_input_power;
+                            }
+
+                        // Record results to file if required
+                        if (d_dump)
+                            {
+                                std::ofstream dump_file;
+                                std::stringstream filename;
+                                const std::streamsize n = sizeof(float) * (d_fft_size);
+                                filename << "../data/test_statistics_" << d_gnss_synchro->System
+                                         << "_" << d_gnss_synchro->Signal[0] << d_gnss_synchro->Signal[1] << "_sat_"
+                                         << d_gnss_synchro->PRN << "_doppler_" << doppler << ".dat";
+                                dump_file.open(filename.str().c_str(), std::ios::out | std::ios::binary);
+                                dump_file.write(reinterpret_cast<char*>(d_magnitude_folded.data()), n);
+                                dump_file.close();
+                            }
+                    }
+
+                if (d_test_statistics > d_threshold)
+                    {
+                        d_state = 2;  // Positive acquisition
+                    }
+                else if (d_well_count == d_max_dwells)
+                    {
+                        d_state = 3;  // Negative acquisition
+                    }
+
+                consume_each(1);
+
+                break;
+            }
+
+        case 2:
+            {
+                // 6.1- Declare positive acquisition using a message port
+                DLOG(INFO) << "positive acquisition";
+                DLOG(INFO) << "satellite " << d_gnss_synchro->System << " " << d_gnss_synchro->PRN;
+                DLOG(INFO) << "sample_stamp " << d_sample_counter;
+                DLOG(INFO) << "test statistics value " << d_test_statistics;
+                DLOG(INFO) << "test statistics threshold " << d_threshold;
+                DLOG(INFO) << "folding factor " << d_folding_factor;
+                DLOG(INFO) << "code phase " << d_gnss_synchro->Acq_delay_samples;
+                DLOG(INFO) << "doppler " << d_gnss_synchro->Acq_doppler_hz;
+                DLOG(INFO) << "magnitude folded " << d_mag;
+                DLOG(INFO) << "input signal power " << d_input_power;
+
+                d_active = false;
+                d_state = 0;
+
+                d_sample_counter += static_cast<uint64_t>(block_size) * ninput_items[0];  // sample counter
+                consume_each(ninput_items[0]);
+
+                acquisition_message = 1;
+                this->message_port_pub(msg_ids::events_port(), msg_ids::event(acquisition_message));
+
+                // Copy and push current Gnss_Synchro to monitor queue
+                if (d_enable_monitor_output)
+                    {
+                        auto** out = reinterpret_cast<Gnss_Synchro**>(&output_items[0]);
+                        Gnss_Synchro current_synchro_data = Gnss_Synchro();
+                        current_synchro_data = *d_gnss_synchro;
+                        *out[0] = current_synchro_data;
+                        noutput_items = 1;  // Number of Gnss_Synchro objects produced
+                    }
+
+                break;
+            }
+
+        case 3:
+            {
+                // 6.2- Declare negative acquisition using a message port
+                DLOG(INFO) << "negative acquisition";
+                DLOG(INFO) << "satellite " << d_gnss_synchro->System << " " << d_gnss_synchro->PRN;
+                DLOG(INFO) << "sample_stamp " << d_sample_counter;
+                DLOG(INFO) << "test statistics value " << d_test_statistics;
+                DLOG(INFO) << "test statistics threshold " << d_threshold;
+                DLOG(INFO) << "folding factor " << d_folding_factor;
+                DLOG(INFO) << "code phase " << d_gnss_synchro->Acq_delay_samples;
+                DLOG(INFO) << "doppler " << d_gnss_synchro->Acq_doppler_hz;
+                DLOG(INFO) << "magnitude folded " << d_mag;
+                DLOG(INFO) << "input signal power " << d_input_power;
+
+                d_active = false;
+                d_state = 0;
+
+                d_sample_counter += static_cast<uint64_t>(block_size) * ninput_items[0];  // sample counter
+                consume_each(ninput_items[0]);
+
+                acquisition_message = 2;
+                this->message_port_pub(msg_ids::events_port(), msg_ids::event(acquisition_message));
+                break;
+            }
+        }
+    return noutput_items;
+}
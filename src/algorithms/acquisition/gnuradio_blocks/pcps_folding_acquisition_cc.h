@@ -0,0 +1,243 @@
+/*!
+ * \file pcps_folding_acquisition_cc.h
+ * \brief This class implements a Parallel Code Phase Search Acquisition with
+ * coherent folding (partial matched filtering) for long integration times
+ *
+ *  Acquisition strategy:
+ *  <ol>
+ *  <li> Compute the input signal power estimation
+ *  <li> Doppler serial search loop over the full-length block
+ *  <li> Fold the carrier wiped-off signal modulo one code period, coherently
+ *       summing all code periods of the block
+ *  <li> Perform the FFT-based circular convolution over one code period
+ *  <li> Record the maximum peak and the associated synchronization parameters
+ *  <li> Compute the test statistics and compare to the threshold
+ *  <li> Declare positive or negative acquisition using a message port
+ *  </ol>
+ *
+ * Unlike raising coherent_integration_time_ms in the standard PCPS block,
+ * which grows the FFT with the integration time, here the FFT stays at one
+ * code period: a block of N code periods is carrier wiped-off at full length
+ * (so narrow Doppler bins remain meaningful) and then folded, giving the
+ * coherent integration gain at a fraction of the FFT cost and memory.
+ *
+ * \date 2020
+ * \author Carles Fernandez, cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PCPS_FOLDING_ACQUISITION_CC_H
+#define GNSS_SDR_PCPS_FOLDING_ACQUISITION_CC_H
+
+#include "acq_fft.h"
+#include "channel_fsm.h"
+#include "gnss_synchro.h"
+#include <gnuradio/block.h>
+#include <gnuradio/gr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstdint>
+#include <memory>  // for weak_ptr
+#include <string>
+#include <utility>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup Acq_gnuradio_blocks
+ * \{ */
+
+
+class pcps_folding_acquisition_cc;
+
+using pcps_folding_acquisition_cc_sptr = gnss_shared_ptr<pcps_folding_acquisition_cc>;
+
+pcps_folding_acquisition_cc_sptr pcps_folding_make_acquisition_cc(
+    uint32_t folding_factor,
+    uint32_t max_dwells,
+    uint32_t doppler_max,
+    int64_t fs_in,
+    int32_t samples_per_ms,
+    int32_t samples_per_code,
+    bool dump,
+    const std::string& dump_filename,
+    bool enable_monitor_output);
+
+/*!
+ * \brief This class implements a Parallel Code Phase Search Acquisition with
+ * coherent folding of long integration blocks into a single code period.
+ */
+class pcps_folding_acquisition_cc : public gr::block
+{
+public:
+    /*!
+     * \brief Default destructor.
+     */
+    ~pcps_folding_acquisition_cc() = default;
+
+    /*!
+     * \brief Set acquisition/tracking common Gnss_Synchro object pointer
+     * to exchange synchronization data between acquisition and tracking blocks.
+     * \param p_gnss_synchro Satellite information shared by the processing blocks.
+     */
+    inline void set_gnss_synchro(Gnss_Synchro* p_gnss_synchro)
+    {
+        d_gnss_synchro = p_gnss_synchro;
+    }
+
+    /*!
+     * \brief Returns the maximum peak of grid search.
+     */
+    inline uint32_t mag() const
+    {
+        return d_mag;
+    }
+
+    /*!
+     * \brief Initializes acquisition algorithm.
+     */
+    void init();
+
+    /*!
+     * \brief Sets local code for PCPS acquisition algorithm.
+     * \param code - Pointer to the PRN code (one code period).
+     */
+    void set_local_code(std::complex<float>* code);
+
+    /*!
+     * \brief Starts acquisition algorithm, turning from standby mode to
+     * active mode
+     * \param active - bool that activates/deactivates the block.
+     */
+    inline void set_active(bool active)
+    {
+        d_active = active;
+    }
+
+    /*!
+     * \brief If set to 1, ensures that acquisition starts at the
+     * first available sample.
+     * \param state - int=1 forces start of acquisition
+     */
+    void set_state(int32_t state);
+
+    /*!
+     * \brief Set acquisition channel unique ID
+     * \param channel - receiver channel.
+     */
+    inline void set_channel(uint32_t channel)
+    {
+        d_channel = channel;
+    }
+
+    /*!
+     * \brief Set channel fsm associated to this acquisition instance
+     */
+    inline void set_channel_fsm(std::weak_ptr<ChannelFsm> channel_fsm)
+    {
+        d_channel_fsm = std::move(channel_fsm);
+    }
+
+    /*!
+     * \brief Set statistics threshold of PCPS algorithm.
+     * \param threshold - Threshold for signal detection.
+     */
+    inline void set_threshold(float threshold)
+    {
+        d_threshold = threshold;
+    }
+
+    /*!
+     * \brief Set maximum Doppler grid search
+     * \param doppler_max - Maximum Doppler shift considered in the grid search [Hz].
+     */
+    inline void set_doppler_max(uint32_t doppler_max)
+    {
+        d_doppler_max = doppler_max;
+    }
+
+    /*!
+     * \brief Set Doppler steps for the grid search
+     * \param doppler_step - Frequency bin of the search grid [Hz].
+     */
+    inline void set_doppler_step(uint32_t doppler_step)
+    {
+        d_doppler_step = doppler_step;
+    }
+
+    /*!
+     * \brief Coherent folding acquisition signal processing.
+     */
+    int general_work(int noutput_items, gr_vector_int& ninput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+private:
+    friend pcps_folding_acquisition_cc_sptr
+    pcps_folding_make_acquisition_cc(uint32_t folding_factor,
+        uint32_t max_dwells,
+        uint32_t doppler_max, int64_t fs_in,
+        int32_t samples_per_ms, int32_t samples_per_code,
+        bool dump,
+        const std::string& dump_filename,
+        bool enable_monitor_output);
+
+    pcps_folding_acquisition_cc(uint32_t folding_factor,
+        uint32_t max_dwells,
+        uint32_t doppler_max, int64_t fs_in,
+        int32_t samples_per_ms, int32_t samples_per_code,
+        bool dump,
+        const std::string& dump_filename,
+        bool enable_monitor_output);
+
+    std::weak_ptr<ChannelFsm> d_channel_fsm;
+
+    std::unique_ptr<Acq_Fft> d_fft_if;
+    std::unique_ptr<Acq_Fft> d_ifft;
+
+    volk_gnsssdr::vector<volk_gnsssdr::vector<gr_complex>> d_grid_doppler_wipeoffs;
+    volk_gnsssdr::vector<gr_complex> d_fft_codes;
+    volk_gnsssdr::vector<gr_complex> d_wiped_signal;
+    volk_gnsssdr::vector<float> d_magnitude;
+    volk_gnsssdr::vector<float> d_magnitude_folded;
+
+    std::string d_dump_filename;
+
+    Gnss_Synchro* d_gnss_synchro;
+
+    int64_t d_fs_in;
+    uint64_t d_sample_counter;
+
+    float d_threshold;
+    float d_mag;
+    float d_input_power;
+    float d_test_statistics;
+
+    int32_t d_samples_per_ms;
+    int32_t d_samples_per_code;
+    int32_t d_state;
+    uint32_t d_channel;
+    uint32_t d_folding_factor;  // number of code periods coherently folded
+    uint32_t d_doppler_max;
+    uint32_t d_doppler_step;
+    uint32_t d_max_dwells;
+    uint32_t d_well_count;
+    uint32_t d_fft_size;
+    uint32_t d_num_doppler_bins;
+
+    bool d_active;
+    bool d_dump;
+    bool d_enable_monitor_output;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PCPS_FOLDING_ACQUISITION_CC_H
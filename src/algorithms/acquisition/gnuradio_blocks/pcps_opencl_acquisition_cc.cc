@@ -36,9 +36,12 @@
 
 #include "pcps_opencl_acquisition_cc.h"
 #include "MATH_CONSTANTS.h"  // TWO_PI
+#include "gnss_message_ids.h"
 #include "gnss_sdr_make_unique.h"
+#if !USE_CLFFT
 #include "opencl/fft_base_kernels.h"
 #include "opencl/fft_internal.h"
+#endif
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
@@ -56,14 +59,17 @@ pcps_opencl_acquisition_cc_sptr pcps_make_opencl_acquisition_cc(
     uint32_t sampled_ms, uint32_t max_dwells,
     uint32_t doppler_max, int64_t fs_in,
     int samples_per_ms, int samples_per_code,
+    uint32_t samples_per_chip,
     bool bit_transition_flag,
+    bool use_CFAR_algorithm_flag,
     bool dump,
     const std::string &dump_filename,
     bool enable_monitor_output)
 {
     return pcps_opencl_acquisition_cc_sptr(
         new pcps_opencl_acquisition_cc(sampled_ms, max_dwells, doppler_max, fs_in, samples_per_ms,
-            samples_per_code, bit_transition_flag, dump, dump_filename, enable_monitor_output));
+            samples_per_code, samples_per_chip, bit_transition_flag, use_CFAR_algorithm_flag,
+            dump, dump_filename, enable_monitor_output));
 }
 
 
@@ -74,7 +80,9 @@ pcps_opencl_acquisition_cc::pcps_opencl_acquisition_cc(
     int64_t fs_in,
     int samples_per_ms,
     int samples_per_code,
+    uint32_t samples_per_chip,
     bool bit_transition_flag,
+    bool use_CFAR_algorithm_flag,
     bool dump,
     const std::string &dump_filename,
     bool enable_monitor_output) : gr::block("pcps_opencl_acquisition_cc",
@@ -99,6 +107,8 @@ pcps_opencl_acquisition_cc::pcps_opencl_acquisition_cc(
     d_input_power = 0.0;
     d_num_doppler_bins = 0;
     d_bit_transition_flag = bit_transition_flag;
+    d_use_CFAR_algorithm_flag = use_CFAR_algorithm_flag;
+    d_samples_per_chip = samples_per_chip;
     d_in_dwell_count = 0;
     d_cl_fft_batch_size = 1;
 
@@ -130,18 +140,34 @@ pcps_opencl_acquisition_cc::~pcps_opencl_acquisition_cc()
 {
     if (d_opencl == 0)
         {
+            // release the persistent mappings before the staging buffers
+            d_cl_queue->enqueueUnmapMemObject(*d_cl_buffer_in_pinned, d_in_pinned);
+            d_cl_queue->enqueueUnmapMemObject(*d_cl_buffer_magnitude_pinned[0], d_magnitude_pinned[0]);
+            d_cl_queue->enqueueUnmapMemObject(*d_cl_buffer_magnitude_pinned[1], d_magnitude_pinned[1]);
+            d_cl_queue->finish();
+
             delete d_cl_queue;
             delete d_cl_buffer_in;
+            delete d_cl_buffer_in_pinned;
             delete d_cl_buffer_1;
             delete d_cl_buffer_2;
-            delete d_cl_buffer_magnitude;
+            delete d_cl_buffer_fft_tmp;
+            delete d_cl_buffer_magnitude[0];
+            delete d_cl_buffer_magnitude[1];
+            delete d_cl_buffer_magnitude_pinned[0];
+            delete d_cl_buffer_magnitude_pinned[1];
             delete d_cl_buffer_fft_codes;
             if (d_num_doppler_bins > 0)
                 {
                     delete[] d_cl_buffer_grid_doppler_wipeoffs;
                 }
 
+#if USE_CLFFT
+            clfftDestroyPlan(&d_clfft_plan);
+            clfftTeardown();
+#else
             clFFT_DestroyPlan(d_cl_fft_plan);
+#endif
         }
 
     try
@@ -222,17 +248,40 @@ int pcps_opencl_acquisition_cc::init_opencl_environment(const std::string &kerne
     d_cl_buffer_fft_codes = new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(gr_complex) * d_fft_size_pow2);
     d_cl_buffer_1 = new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(gr_complex) * d_fft_size_pow2);
     d_cl_buffer_2 = new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(gr_complex) * d_fft_size_pow2);
-    d_cl_buffer_magnitude = new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(float) * d_fft_size);
+    d_cl_buffer_fft_tmp = new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(gr_complex) * d_fft_size_pow2);
+    d_cl_buffer_magnitude[0] = new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(float) * d_fft_size);
+    d_cl_buffer_magnitude[1] = new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(float) * d_fft_size);
 
     // create queue to which we will push commands for the device.
     d_cl_queue = new cl::CommandQueue(d_cl_context, d_cl_device);
 
     // create FFT plan
     cl_int err;
+#if USE_CLFFT
+    clfftSetupData fft_setup;
+    clfftInitSetupData(&fft_setup);
+    clfftSetup(&fft_setup);
+
+    size_t fft_length = d_fft_size_pow2;
+    err = clfftCreateDefaultPlan(&d_clfft_plan, d_cl_context(), CLFFT_1D, &fft_length);
+    if (err == CL_SUCCESS)
+        {
+            clfftSetPlanPrecision(d_clfft_plan, CLFFT_SINGLE);
+            clfftSetLayout(d_clfft_plan, CLFFT_COMPLEX_INTERLEAVED, CLFFT_COMPLEX_INTERLEAVED);
+            clfftSetResultLocation(d_clfft_plan, CLFFT_OUTOFPLACE);
+            // clFFT scales the backward transform by 1/N by default; keep it
+            // unscaled like the FFT it replaces, so the peak normalization
+            // factor does not depend on the backend
+            clfftSetPlanScale(d_clfft_plan, CLFFT_BACKWARD, 1.0F);
+            cl_command_queue bake_queue = (*d_cl_queue)();
+            err = clfftBakePlan(d_clfft_plan, 1, &bake_queue, nullptr, nullptr);
+        }
+#else
     clFFT_Dim3 dim = {d_fft_size_pow2, 1, 1};
 
     d_cl_fft_plan = clFFT_CreatePlan(d_cl_context(), dim, clFFT_1D,
         clFFT_InterleavedComplexFormat, &err);
+#endif
 
     if (err != 0)
         {
@@ -240,17 +289,49 @@ int pcps_opencl_acquisition_cc::init_opencl_environment(const std::string &kerne
             delete d_cl_buffer_in;
             delete d_cl_buffer_1;
             delete d_cl_buffer_2;
-            delete d_cl_buffer_magnitude;
+            delete d_cl_buffer_fft_tmp;
+            delete d_cl_buffer_magnitude[0];
+            delete d_cl_buffer_magnitude[1];
             delete d_cl_buffer_fft_codes;
 
             std::cout << "Error creating OpenCL FFT plan.\n";
             return 4;
         }
 
+    // pinned host staging memory, mapped once and kept mapped: transfers
+    // from/to pageable host memory make the driver stage through an internal
+    // bounce buffer, which is where most of the per-dwell time went on the
+    // integrated GPUs. Transfers from pinned memory can be truly asynchronous
+    d_cl_buffer_in_pinned = new cl::Buffer(d_cl_context, CL_MEM_READ_ONLY | CL_MEM_ALLOC_HOST_PTR, sizeof(gr_complex) * d_fft_size);
+    d_in_pinned = reinterpret_cast<gr_complex *>(d_cl_queue->enqueueMapBuffer(*d_cl_buffer_in_pinned,
+        CL_TRUE, CL_MAP_WRITE, 0, sizeof(gr_complex) * d_fft_size));
+    for (int i = 0; i < 2; i++)
+        {
+            d_cl_buffer_magnitude_pinned[i] = new cl::Buffer(d_cl_context, CL_MEM_WRITE_ONLY | CL_MEM_ALLOC_HOST_PTR, sizeof(float) * d_fft_size);
+            d_magnitude_pinned[i] = reinterpret_cast<float *>(d_cl_queue->enqueueMapBuffer(*d_cl_buffer_magnitude_pinned[i],
+                CL_TRUE, CL_MAP_READ, 0, sizeof(float) * d_fft_size));
+        }
+
     return 0;
 }
 
 
+void pcps_opencl_acquisition_cc::enqueue_fft(bool forward, cl::Buffer &buffer_in, cl::Buffer &buffer_out)
+{
+#if USE_CLFFT
+    cl_mem in_mem = buffer_in();
+    cl_mem out_mem = buffer_out();
+    cl_command_queue queue = (*d_cl_queue)();
+    clfftEnqueueTransform(d_clfft_plan, forward ? CLFFT_FORWARD : CLFFT_BACKWARD, 1, &queue,
+        0, nullptr, nullptr, &in_mem, &out_mem, nullptr);
+#else
+    clFFT_ExecuteInterleaved((*d_cl_queue)(), d_cl_fft_plan, d_cl_fft_batch_size,
+        forward ? clFFT_Forward : clFFT_Inverse, buffer_in(), buffer_out(),
+        0, nullptr, nullptr);
+#endif
+}
+
+
 void pcps_opencl_acquisition_cc::init()
 {
     d_gnss_synchro->Flag_valid_acquisition = false;
@@ -321,13 +402,11 @@ void pcps_opencl_acquisition_cc::set_local_code(std::complex<float> *code)
             d_cl_queue->enqueueWriteBuffer(*d_cl_buffer_2, CL_TRUE, sizeof(gr_complex) * (d_fft_size_pow2 - d_fft_size),
                 sizeof(gr_complex) * d_fft_size, code);
 
-            clFFT_ExecuteInterleaved((*d_cl_queue)(), d_cl_fft_plan, d_cl_fft_batch_size,
-                clFFT_Forward, (*d_cl_buffer_2)(), (*d_cl_buffer_2)(),
-                0, nullptr, nullptr);
+            enqueue_fft(true, *d_cl_buffer_2, *d_cl_buffer_fft_tmp);
 
             // Conjucate the local code
             cl::Kernel kernel = cl::Kernel(d_cl_program, "conj_vector");
-            kernel.setArg(0, *d_cl_buffer_2);          // input
+            kernel.setArg(0, *d_cl_buffer_fft_tmp);    // input
             kernel.setArg(1, *d_cl_buffer_fft_codes);  // output
             d_cl_queue->enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(d_fft_size_pow2), cl::NullRange);
         }
@@ -343,6 +422,28 @@ void pcps_opencl_acquisition_cc::set_local_code(std::complex<float> *code)
 }
 
 
+float pcps_opencl_acquisition_cc::first_vs_second_peak_statistic(const float *magnitude, uint32_t index_time)
+{
+    // Compare the highest peak of the current Doppler bin to the second
+    // highest peak of the same bin, chosen not closer than 1 chip
+    // (circularly) to the first one
+    float second_peak = 0.0;
+    for (uint32_t i = 0; i < d_fft_size; i++)
+        {
+            uint32_t distance = (i > index_time) ? (i - index_time) : (index_time - i);
+            if (distance > d_fft_size / 2)
+                {
+                    distance = d_fft_size - distance;
+                }
+            if ((distance > d_samples_per_chip) && (magnitude[i] > second_peak))
+                {
+                    second_peak = magnitude[i];
+                }
+        }
+    return magnitude[index_time] / second_peak;
+}
+
+
 void pcps_opencl_acquisition_cc::acquisition_core_volk()
 {
     // initialize acquisition algorithm
@@ -401,14 +502,18 @@ void pcps_opencl_acquisition_cc::acquisition_core_volk()
                 {
                     d_mag = magt;
 
+                    // The test statistics for this bin: either the CFAR
+                    // max-to-input-power ratio or the first-vs-second-peak ratio
+                    const float bin_statistics = (d_use_CFAR_algorithm_flag ? (d_mag / d_input_power) : first_vs_second_peak_statistic(d_magnitude.data(), indext));
+
                     // In case that d_bit_transition_flag = true, we compare the potentially
-                    // new maximum test statistics (d_mag/d_input_power) with the value in
-                    // d_test_statistics. When the second dwell is being processed, the value
-                    // of d_mag/d_input_power could be lower than d_test_statistics (i.e,
-                    // the maximum test statistics in the previous dwell is greater than
-                    // current d_mag/d_input_power). Note that d_test_statistics is not
-                    // restarted between consecutive dwells in multidwell operation.
-                    if (d_test_statistics < (d_mag / d_input_power) || !d_bit_transition_flag)
+                    // new maximum test statistics with the value in d_test_statistics.
+                    // When the second dwell is being processed, the new value could be
+                    // lower than d_test_statistics (i.e, the maximum test statistics in
+                    // the previous dwell is greater than the current one). Note that
+                    // d_test_statistics is not restarted between consecutive dwells in
+                    // multidwell operation.
+                    if (d_test_statistics < bin_statistics || !d_bit_transition_flag)
                         {
                             d_gnss_synchro->Acq_delay_samples = static_cast<double>(indext % d_samples_per_code);
                             d_gnss_synchro->Acq_doppler_hz = static_cast<double>(doppler);
@@ -416,8 +521,7 @@ void pcps_opencl_acquisition_cc::acquisition_core_volk()
                             d_gnss_synchro->Acq_doppler_step = d_doppler_step;
 
                             // 5- Compute the test statistics and compare to the threshold
-                            // d_test_statistics = 2 * d_fft_size * d_mag / d_input_power;
-                            d_test_statistics = d_mag / d_input_power;
+                            d_test_statistics = bin_statistics;
                         }
                 }
 
@@ -478,8 +582,11 @@ void pcps_opencl_acquisition_cc::acquisition_core_opencl()
     d_input_power = 0.0;
     d_mag = 0.0;
 
-    // write input vector in buffer of OpenCL device
-    d_cl_queue->enqueueWriteBuffer(*d_cl_buffer_in, CL_TRUE, 0, sizeof(gr_complex) * d_fft_size, d_in_buffer[d_well_count].data());
+    // stage the dwell in pinned memory and upload it without blocking: the
+    // transfer overlaps with the input power estimation below
+    memcpy(d_in_pinned, d_in_buffer[d_well_count].data(), sizeof(gr_complex) * d_fft_size);
+    d_cl_queue->enqueueWriteBuffer(*d_cl_buffer_in, CL_FALSE, 0, sizeof(gr_complex) * d_fft_size, d_in_pinned);
+    d_cl_queue->flush();
 
     d_well_count++;
 
@@ -503,11 +610,71 @@ void pcps_opencl_acquisition_cc::acquisition_core_opencl()
 
     cl::Kernel kernel;
 
-    // 2- Doppler frequency search loop
+    // host-side processing of one finished Doppler bin: peak search, test
+    // statistics bookkeeping and the optional dump
+    const auto process_bin = [&](const float *magnitude, int bin_doppler) {
+        // Search maximum
+        volk_gnsssdr_32f_index_max_32u(&indext, magnitude, d_fft_size);
+
+        // Normalize the maximum value to correct the scale factor introduced by FFTW
+        magt = magnitude[indext] / (fft_normalization_factor * fft_normalization_factor);
+
+        // 4- record the maximum peak and the associated synchronization parameters
+        if (d_mag < magt)
+            {
+                d_mag = magt;
+
+                // The test statistics for this bin: either the CFAR
+                // max-to-input-power ratio or the first-vs-second-peak ratio
+                const float bin_statistics = (d_use_CFAR_algorithm_flag ? (d_mag / d_input_power) : first_vs_second_peak_statistic(magnitude, indext));
+
+                // In case that d_bit_transition_flag = true, we compare the potentially
+                // new maximum test statistics with the value in d_test_statistics.
+                // When the second dwell is being processed, the new value could be
+                // lower than d_test_statistics (i.e, the maximum test statistics in
+                // the previous dwell is greater than the current one). Note that
+                // d_test_statistics is not restarted between consecutive dwells in
+                // multidwell operation.
+                if (d_test_statistics < bin_statistics || !d_bit_transition_flag)
+                    {
+                        d_gnss_synchro->Acq_delay_samples = static_cast<double>(indext % d_samples_per_code);
+                        d_gnss_synchro->Acq_doppler_hz = static_cast<double>(bin_doppler);
+                        d_gnss_synchro->Acq_samplestamp_samples = samplestamp;
+                        d_gnss_synchro->Acq_doppler_step = d_doppler_step;
+
+                        // 5- Compute the test statistics and compare to the threshold
+                        d_test_statistics = bin_statistics;
+                    }
+            }
+
+        // Record results to file if required
+        if (d_dump)
+            {
+                std::stringstream filename;
+                std::streamsize n = sizeof(float) * (d_fft_size);
+                filename.str("");
+                filename << "../data/test_statistics_" << d_gnss_synchro->System
+                         << "_" << d_gnss_synchro->Signal[0] << d_gnss_synchro->Signal[1] << "_sat_"
+                         << d_gnss_synchro->PRN << "_doppler_" << bin_doppler << ".dat";
+                d_dump_file.open(filename.str().c_str(), std::ios::out | std::ios::binary);
+                d_dump_file.write(reinterpret_cast<const char *>(magnitude), n);  // |abs(x)|^2 in this Doppler bin
+                d_dump_file.close();
+            }
+    };
+
+    cl::Event read_done[2];
+    int prev_doppler = 0;
+
+    // 2- Doppler frequency search loop, double buffered: while the device
+    // computes and transfers bin n into one pinned magnitude buffer, the host
+    // searches the peak of bin n-1 in the other one. The command queue is
+    // in-order, so a magnitude buffer is never overwritten before its
+    // previous read-back has completed
     for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
         {
             // doppler search steps
             doppler = -static_cast<int>(d_doppler_max) + d_doppler_step * doppler_index;
+            const int buf = doppler_index & 1;
 
             // Multiply input signal with doppler wipe-off
             kernel = cl::Kernel(d_cl_program, "mult_vectors");
@@ -520,9 +687,7 @@ void pcps_opencl_acquisition_cc::acquisition_core_opencl()
             // In the previous operation, we store the result in the first d_fft_size positions
             // of d_cl_buffer_1. The rest d_fft_size_pow2-d_fft_size already have zeros
             // (zero-padding is made in init() for optimization purposes).
-            clFFT_ExecuteInterleaved((*d_cl_queue)(), d_cl_fft_plan, d_cl_fft_batch_size,
-                clFFT_Forward, (*d_cl_buffer_1)(), (*d_cl_buffer_2)(),
-                0, nullptr, nullptr);
+            enqueue_fft(true, *d_cl_buffer_1, *d_cl_buffer_2);
 
             // Multiply carrier wiped--off, Fourier transformed incoming signal
             // with the local FFT'd code reference
@@ -534,69 +699,34 @@ void pcps_opencl_acquisition_cc::acquisition_core_opencl()
                 cl::NullRange);
 
             // compute the inverse FFT
-            clFFT_ExecuteInterleaved((*d_cl_queue)(), d_cl_fft_plan, d_cl_fft_batch_size,
-                clFFT_Inverse, (*d_cl_buffer_2)(), (*d_cl_buffer_2)(),
-                0, nullptr, nullptr);
+            enqueue_fft(false, *d_cl_buffer_2, *d_cl_buffer_fft_tmp);
 
             // Compute magnitude
             kernel = cl::Kernel(d_cl_program, "magnitude_squared");
-            kernel.setArg(0, *d_cl_buffer_2);          // input 1
-            kernel.setArg(1, *d_cl_buffer_magnitude);  // output
+            kernel.setArg(0, *d_cl_buffer_fft_tmp);         // input 1
+            kernel.setArg(1, *d_cl_buffer_magnitude[buf]);  // output
             d_cl_queue->enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(d_fft_size),
                 cl::NullRange);
 
-            // This is the only function that blocks this thread until all previously enqueued
-            // OpenCL commands are completed.
-            d_cl_queue->enqueueReadBuffer(*d_cl_buffer_magnitude, CL_TRUE, 0,
-                sizeof(float) * d_fft_size, d_magnitude.data());
+            // asynchronous read-back into pinned memory; the event signals
+            // when this bin can be processed on the host
+            d_cl_queue->enqueueReadBuffer(*d_cl_buffer_magnitude[buf], CL_FALSE, 0,
+                sizeof(float) * d_fft_size, d_magnitude_pinned[buf], nullptr, &read_done[buf]);
+            d_cl_queue->flush();
 
-            // Search maximum
-            // @TODO: find an efficient way to search the maximum with OpenCL in the GPU.
-            volk_gnsssdr_32f_index_max_32u(&indext, d_magnitude.data(), d_fft_size);
-
-            // Normalize the maximum value to correct the scale factor introduced by FFTW
-            magt = d_magnitude[indext] / (fft_normalization_factor * fft_normalization_factor);
-
-            // 4- record the maximum peak and the associated synchronization parameters
-            if (d_mag < magt)
-                {
-                    d_mag = magt;
-
-                    // In case that d_bit_transition_flag = true, we compare the potentially
-                    // new maximum test statistics (d_mag/d_input_power) with the value in
-                    // d_test_statistics. When the second dwell is being processed, the value
-                    // of d_mag/d_input_power could be lower than d_test_statistics (i.e,
-                    // the maximum test statistics in the previous dwell is greater than
-                    // current d_mag/d_input_power). Note that d_test_statistics is not
-                    // restarted between consecutive dwells in multidwell operation.
-                    if (d_test_statistics < (d_mag / d_input_power) || !d_bit_transition_flag)
-                        {
-                            d_gnss_synchro->Acq_delay_samples = static_cast<double>(indext % d_samples_per_code);
-                            d_gnss_synchro->Acq_doppler_hz = static_cast<double>(doppler);
-                            d_gnss_synchro->Acq_samplestamp_samples = samplestamp;
-                            d_gnss_synchro->Acq_doppler_step = d_doppler_step;
-
-                            // 5- Compute the test statistics and compare to the threshold
-                            // d_test_statistics = 2 * d_fft_size * d_mag / d_input_power;
-                            d_test_statistics = d_mag / d_input_power;
-                        }
-                }
-
-            // Record results to file if required
-            if (d_dump)
+            if (doppler_index > 0)
                 {
-                    std::stringstream filename;
-                    std::streamsize n = 2 * sizeof(float) * (d_fft_size);  // complex file write
-                    filename.str("");
-                    filename << "../data/test_statistics_" << d_gnss_synchro->System
-                             << "_" << d_gnss_synchro->Signal[0] << d_gnss_synchro->Signal[1] << "_sat_"
-                             << d_gnss_synchro->PRN << "_doppler_" << doppler << ".dat";
-                    d_dump_file.open(filename.str().c_str(), std::ios::out | std::ios::binary);
-                    d_dump_file.write(reinterpret_cast<char *>(d_ifft->get_outbuf()), n);  // write directly |abs(x)|^2 in this Doppler bin?
-                    d_dump_file.close();
+                    read_done[1 - buf].wait();
+                    process_bin(d_magnitude_pinned[1 - buf], prev_doppler);
                 }
+            prev_doppler = doppler;
         }
 
+    // drain the pipeline: the last bin is still in flight
+    const int last_buf = (d_num_doppler_bins - 1) & 1;
+    read_done[last_buf].wait();
+    process_bin(d_magnitude_pinned[last_buf], prev_doppler);
+
     //    gettimeofday(&tv, NULL);
     //    end = tv.tv_sec *1e6 + tv.tv_usec;
     //    std::cout << "Acq time = " << (end-begin) << " us\n";
@@ -760,7 +890,7 @@ int pcps_opencl_acquisition_cc::general_work(int noutput_items,
                 d_sample_counter += static_cast<uint64_t>(d_fft_size * ninput_items[0]);  // sample counter
 
                 acquisition_message = 1;
-                this->message_port_pub(pmt::mp("events"), pmt::from_long(acquisition_message));
+                this->message_port_pub(msg_ids::events_port(), msg_ids::event(acquisition_message));
 
                 // Copy and push current Gnss_Synchro to monitor queue
                 if (d_enable_monitor_output)
@@ -794,7 +924,7 @@ int pcps_opencl_acquisition_cc::general_work(int noutput_items,
                 d_sample_counter += static_cast<uint64_t>(d_fft_size * ninput_items[0]);  // sample counter
 
                 acquisition_message = 2;
-                this->message_port_pub(pmt::mp("events"), pmt::from_long(acquisition_message));
+                this->message_port_pub(msg_ids::events_port(), msg_ids::event(acquisition_message));
 
                 break;
             }
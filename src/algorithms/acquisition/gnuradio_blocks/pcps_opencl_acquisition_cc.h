@@ -41,7 +41,11 @@
 #include "channel_fsm.h"
 #include "gnss_block_interface.h"
 #include "gnss_synchro.h"
-#include "opencl/fft_internal.h"
+#if USE_CLFFT
+#include <clFFT.h>  // modern clFFT library backend
+#else
+#include "opencl/fft_internal.h"  // legacy FFT from the Apple OpenCL sample
+#endif
 #include <gnuradio/block.h>
 #include <gnuradio/fft/fft.h>
 #include <gnuradio/gr_complex.h>
@@ -69,7 +73,9 @@ pcps_opencl_acquisition_cc_sptr pcps_make_opencl_acquisition_cc(
     int64_t fs_in,
     int samples_per_ms,
     int samples_per_code,
+    uint32_t samples_per_chip,
     bool bit_transition_flag,
+    bool use_CFAR_algorithm_flag,
     bool dump,
     const std::string& dump_filename,
     bool enable_monitor_output);
@@ -205,7 +211,9 @@ private:
     pcps_make_opencl_acquisition_cc(uint32_t sampled_ms, uint32_t max_dwells,
         uint32_t doppler_max, int64_t fs_in,
         int samples_per_ms, int samples_per_code,
+        uint32_t samples_per_chip,
         bool bit_transition_flag,
+        bool use_CFAR_algorithm_flag,
         bool dump,
         const std::string& dump_filename,
         bool enable_monitor_output);
@@ -213,7 +221,9 @@ private:
     pcps_opencl_acquisition_cc(uint32_t sampled_ms, uint32_t max_dwells,
         uint32_t doppler_max, int64_t fs_in,
         int samples_per_ms, int samples_per_code,
+        uint32_t samples_per_chip,
         bool bit_transition_flag,
+        bool use_CFAR_algorithm_flag,
         bool dump,
         const std::string& dump_filename,
         bool enable_monitor_output);
@@ -221,8 +231,14 @@ private:
     void calculate_magnitudes(gr_complex* fft_begin, int doppler_shift,
         int doppler_offset);
 
+    float first_vs_second_peak_statistic(const float* magnitude, uint32_t index_time);
+
     int init_opencl_environment(const std::string& kernel_filename);
 
+    //! Queues one FFT on the device, dispatching to the configured backend.
+    //! All transforms are out-of-place so both backends share one plan
+    void enqueue_fft(bool forward, cl::Buffer& buffer_in, cl::Buffer& buffer_out);
+
     cl::Platform d_cl_platform;
     cl::Device d_cl_device;
     cl::Context d_cl_context;
@@ -231,10 +247,22 @@ private:
     cl::Buffer* d_cl_buffer_fft_codes;
     cl::Buffer* d_cl_buffer_1;
     cl::Buffer* d_cl_buffer_2;
-    cl::Buffer* d_cl_buffer_magnitude;
+    cl::Buffer* d_cl_buffer_fft_tmp;
+    // double-buffered magnitude outputs: while the host searches the peak of
+    // one Doppler bin, the device computes and transfers the next one
+    cl::Buffer* d_cl_buffer_magnitude[2];
+    cl::Buffer* d_cl_buffer_magnitude_pinned[2];
+    cl::Buffer* d_cl_buffer_in_pinned;
     cl::Buffer** d_cl_buffer_grid_doppler_wipeoffs;
     cl::CommandQueue* d_cl_queue;
+    // pinned host-side views of the staging buffers (mapped once, kept mapped)
+    gr_complex* d_in_pinned;
+    float* d_magnitude_pinned[2];
+#if USE_CLFFT
+    clfftPlanHandle d_clfft_plan;
+#else
     clFFT_Plan d_cl_fft_plan;
+#endif
     cl_int d_cl_fft_batch_size;
 
     std::weak_ptr<ChannelFsm> d_channel_fsm;
@@ -284,8 +312,10 @@ private:
     uint32_t d_code_phase;
     uint32_t d_channel;
     uint32_t d_in_dwell_count;
+    uint32_t d_samples_per_chip;
 
     bool d_bit_transition_flag;
+    bool d_use_CFAR_algorithm_flag;
     bool d_active;
     bool d_core_working;
     bool d_dump;
@@ -16,6 +16,7 @@
 
 #include "pcps_quicksync_acquisition_cc.h"
 #include "MATH_CONSTANTS.h"
+#include "gnss_message_ids.h"
 #include "gnss_sdr_make_unique.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
@@ -514,7 +515,7 @@ int pcps_quicksync_acquisition_cc::general_work(int noutput_items,
                 consume_each(ninput_items[0]);
 
                 acquisition_message = 1;
-                this->message_port_pub(pmt::mp("events"), pmt::from_long(acquisition_message));
+                this->message_port_pub(msg_ids::events_port(), msg_ids::event(acquisition_message));
                 // DLOG(INFO) << "END CASE 2";
 
                 // Copy and push current Gnss_Synchro to monitor queue
@@ -557,7 +558,7 @@ int pcps_quicksync_acquisition_cc::general_work(int noutput_items,
                 consume_each(ninput_items[0]);
 
                 acquisition_message = 2;
-                this->message_port_pub(pmt::mp("events"), pmt::from_long(acquisition_message));
+                this->message_port_pub(msg_ids::events_port(), msg_ids::event(acquisition_message));
                 // DLOG(INFO) << "END CASE 3";
                 break;
             }
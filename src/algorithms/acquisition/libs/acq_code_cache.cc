@@ -0,0 +1,49 @@
+/*!
+ * \file acq_code_cache.cc
+ * \brief Process-wide cache of conjugated, FFT-transformed PRN replicas.
+ * \author Carles Fernandez, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_code_cache.h"
+#include <utility>
+
+
+Acq_Code_Cache& Acq_Code_Cache::get_instance()
+{
+    static Acq_Code_Cache instance;
+    return instance;
+}
+
+
+std::shared_ptr<const Acq_Code_Cache::code_vector> Acq_Code_Cache::get(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto it = d_codes.find(key);
+    if (it != d_codes.end())
+        {
+            return it->second;
+        }
+    return nullptr;
+}
+
+
+std::shared_ptr<const Acq_Code_Cache::code_vector> Acq_Code_Cache::insert(const std::string& key, std::shared_ptr<code_vector> code)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    auto& slot = d_codes[key];
+    if (slot == nullptr)
+        {
+            slot = std::move(code);
+        }
+    return slot;
+}
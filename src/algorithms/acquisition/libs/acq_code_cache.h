@@ -0,0 +1,71 @@
+/*!
+ * \file acq_code_cache.h
+ * \brief Process-wide cache of conjugated, FFT-transformed PRN replicas.
+ *
+ * When the acquisition manager retargets a channel to a new PRN the local
+ * code is FFT-transformed again even if another channel already did the
+ * same transform this session. This cache keys the conjugated frequency
+ * domain replica by signal, PRN and sampling geometry, so hot-swapping
+ * satellites among channels reuses codes transformed earlier and the
+ * replica storage is shared instead of duplicated per channel.
+ * \author Carles Fernandez, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_CODE_CACHE_H
+#define GNSS_SDR_ACQ_CODE_CACHE_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Process-wide cache of conjugated FFT'd PRN replicas, keyed by a
+ * string encoding signal, PRN and sampling geometry.
+ */
+class Acq_Code_Cache
+{
+public:
+    using code_vector = volk_gnsssdr::vector<std::complex<float>>;
+
+    static Acq_Code_Cache& get_instance();
+
+    //! Returns the cached replica for \p key, or nullptr if not present.
+    std::shared_ptr<const code_vector> get(const std::string& key);
+
+    //! Stores a freshly transformed replica and returns the shared copy.
+    std::shared_ptr<const code_vector> insert(const std::string& key, std::shared_ptr<code_vector> code);
+
+    Acq_Code_Cache(const Acq_Code_Cache&) = delete;
+    Acq_Code_Cache& operator=(const Acq_Code_Cache&) = delete;
+
+private:
+    Acq_Code_Cache() = default;
+    ~Acq_Code_Cache() = default;
+
+    std::map<std::string, std::shared_ptr<const code_vector>> d_codes;
+    std::mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_CODE_CACHE_H
@@ -16,6 +16,7 @@
  */
 
 #include "acq_conf.h"
+#include "acq_worker_pool.h"
 #include "item_type_helpers.h"
 #include <glog/logging.h>
 #include <gnuradio/gr_complex.h>
@@ -27,6 +28,12 @@ Acq_Conf::Acq_Conf()
     sampled_ms = 1U;
     ms_per_code = 1U;
     max_dwells = 1U;
+    tong_init_val = 1U;
+    tong_max_val = 2U;
+    decimation_factor = 0U;  // 0: chosen automatically from expected_cn0_dB_hz
+    expected_cn0_dB_hz = 45.0;
+    xcorr_doppler_tolerance_hz = 100.0;
+    xcorr_alias_floor_cn0_db_hz = 28.0;
     samples_per_chip = 2U;
     chips_per_second = 1023000;
     doppler_max = 5000;
@@ -40,6 +47,14 @@ Acq_Conf::Acq_Conf()
     samples_per_ms = 0.0;
     samples_per_code = 0.0;
     bit_transition_flag = false;
+    split_two_halves = false;
+    accumulate_dwells = false;
+    use_tong_detector = false;
+    enable_decimated_search = false;
+    enable_xcorr_screening = false;
+    enable_early_exit = false;
+    early_exit_margin = 1.2;
+    use_batched_fft = false;
     use_CFAR_algorithm_flag = true;
     dump = false;
     blocking = true;
@@ -54,6 +69,11 @@ Acq_Conf::Acq_Conf()
     resampled_fs = 0LL;
     resampler_latency_samples = 0U;
     enable_monitor_output = false;
+    diag_address = "127.0.0.1";
+    diag_port = 1261;
+    offload_address = "";
+    offload_port = 1262;
+    accelerator = "cpu";
 }
 
 
@@ -73,7 +93,60 @@ void Acq_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
     doppler_max = configuration->property(role + ".doppler_max", doppler_max);
     sampled_ms = configuration->property(role + ".coherent_integration_time_ms", sampled_ms);
     bit_transition_flag = configuration->property(role + ".bit_transition_flag", bit_transition_flag);
+    split_two_halves = configuration->property(role + ".split_two_halves", split_two_halves);
+    if (split_two_halves and bit_transition_flag)
+        {
+            LOG(WARNING) << "Parameters split_two_halves and bit_transition_flag are mutually exclusive. Disabling split_two_halves";
+            split_two_halves = false;
+        }
+    accumulate_dwells = configuration->property(role + ".accumulate_dwells", accumulate_dwells);
+    if (accumulate_dwells and bit_transition_flag)
+        {
+            LOG(WARNING) << "Parameters accumulate_dwells and bit_transition_flag are mutually exclusive. Disabling accumulate_dwells";
+            accumulate_dwells = false;
+        }
+    use_batched_fft = configuration->property(role + ".batch_fft", use_batched_fft);
+    enable_early_exit = configuration->property(role + ".early_exit", enable_early_exit);
+    early_exit_margin = configuration->property(role + ".early_exit_margin", early_exit_margin);
+    if (early_exit_margin < 1.0)
+        {
+            LOG(WARNING) << "Parameter early_exit_margin should be >= 1.0. Setting it to 1.0";
+            early_exit_margin = 1.0;
+        }
     max_dwells = configuration->property(role + ".max_dwells", max_dwells);
+    // Tong sequential detector: a per-cell up/down counter decides across
+    // dwells instead of a single-dwell threshold test; keys keep the names
+    // used by the legacy Tong blocks
+    use_tong_detector = configuration->property(role + ".use_tong_detector", use_tong_detector);
+    tong_init_val = configuration->property(role + ".tong_init_val", tong_init_val);
+    tong_max_val = configuration->property(role + ".tong_max_val", tong_max_val);
+    if (use_tong_detector and bit_transition_flag)
+        {
+            LOG(WARNING) << "Parameters use_tong_detector and bit_transition_flag are mutually exclusive. Disabling use_tong_detector";
+            use_tong_detector = false;
+        }
+    if (use_tong_detector and max_dwells <= tong_max_val)
+        {
+            LOG(WARNING) << "With use_tong_detector, max_dwells should exceed tong_max_val. Setting max_dwells to tong_max_val + 1";
+            max_dwells = tong_max_val + 1U;
+        }
+    // Decimated coarse search: the first-step grid search runs on boxcar
+    // pre-integrated samples and the second step verifies the candidate at
+    // full rate; the factor defaults to a choice driven by the expected CN0
+    enable_decimated_search = configuration->property(role + ".enable_decimated_search", enable_decimated_search);
+    decimation_factor = configuration->property(role + ".decimation_factor", decimation_factor);
+    expected_cn0_dB_hz = configuration->property(role + ".expected_cn0_dB_hz", expected_cn0_dB_hz);
+    if (enable_decimated_search and (bit_transition_flag or split_two_halves))
+        {
+            LOG(WARNING) << "Parameter enable_decimated_search is incompatible with bit_transition_flag and split_two_halves. Disabling enable_decimated_search";
+            enable_decimated_search = false;
+        }
+    // Cross-correlation screening: a positive acquisition whose Doppler
+    // falls on a cross-correlation line of a strong satellite already being
+    // tracked on the same signal is rejected before tracking spin-up
+    enable_xcorr_screening = configuration->property(role + ".enable_xcorr_screening", enable_xcorr_screening);
+    xcorr_doppler_tolerance_hz = configuration->property(role + ".xcorr_doppler_tolerance_hz", xcorr_doppler_tolerance_hz);
+    xcorr_alias_floor_cn0_db_hz = configuration->property(role + ".xcorr_alias_floor_cn0_db_hz", xcorr_alias_floor_cn0_db_hz);
     dump = configuration->property(role + ".dump", dump);
     dump_channel = configuration->property(role + ".dump_channel", dump_channel);
     blocking = configuration->property(role + ".blocking", blocking);
@@ -81,6 +154,14 @@ void Acq_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
 
     use_automatic_resampler = configuration->property("GNSS-SDR.use_acquisition_resampler", use_automatic_resampler);
 
+    // Size of the shared worker pool serving all non-blocking acquisitions.
+    // It only takes effect before the first acquisition job is queued.
+    const int acq_worker_threads = configuration->property("GNSS-SDR.acq_worker_threads", 0);
+    if (acq_worker_threads > 0)
+        {
+            Acq_Worker_Pool::get_instance().set_num_workers(static_cast<uint32_t>(acq_worker_threads));
+        }
+
     if ((sampled_ms % ms_per_code) != 0)
         {
             LOG(WARNING) << "Parameter coherent_integration_time_ms should be a multiple of "
@@ -121,6 +202,15 @@ void Acq_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
 
     enable_monitor_output = configuration->property("AcquisitionMonitor.enable_monitor", false);
 
+    diag_address = configuration->property("AcquisitionDiag.client_address", diag_address);
+    diag_port = configuration->property("AcquisitionDiag.udp_port", diag_port);
+
+    offload_address = configuration->property("AcquisitionOffload.server_address", offload_address);
+    offload_port = configuration->property("AcquisitionOffload.server_port", offload_port);
+
+    // Compute backend for the grid search: "cpu" (default) or "sycl"
+    accelerator = configuration->property(role + ".accelerator", accelerator);
+
     SetDerivedParams();
 }
 
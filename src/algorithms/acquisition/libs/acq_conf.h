@@ -39,6 +39,9 @@ public:
     /* PCPS Acquisition configuration */
     std::string item_type;
     std::string dump_filename;
+    std::string diag_address;
+    std::string offload_address;
+    std::string accelerator;
 
     int64_t fs_in;
     int64_t resampled_fs;
@@ -52,19 +55,35 @@ public:
     float pfa2;
     float samples_per_code;
     float resampler_ratio;
+    float early_exit_margin;
+    float expected_cn0_dB_hz;
+    float xcorr_doppler_tolerance_hz;
+    float xcorr_alias_floor_cn0_db_hz;
 
     uint32_t sampled_ms;
     uint32_t ms_per_code;
     uint32_t samples_per_chip;
     uint32_t chips_per_second;
     uint32_t max_dwells;
+    uint32_t tong_init_val;
+    uint32_t tong_max_val;
+    uint32_t decimation_factor;
     uint32_t num_doppler_bins_step2;
     uint32_t resampler_latency_samples;
     uint32_t dump_channel;
+    uint16_t diag_port;
+    uint16_t offload_port;
     int32_t doppler_max;
     int32_t doppler_min;
 
     bool bit_transition_flag;
+    bool split_two_halves;
+    bool accumulate_dwells;
+    bool use_tong_detector;
+    bool enable_decimated_search;
+    bool enable_xcorr_screening;
+    bool enable_early_exit;
+    bool use_batched_fft;
     bool use_CFAR_algorithm_flag;
     bool dump;
     bool blocking;
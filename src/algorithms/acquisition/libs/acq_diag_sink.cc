@@ -0,0 +1,64 @@
+/*!
+ * \file acq_diag_sink.cc
+ * \brief Implementation of a class that sends acquisition diagnostic
+ * records (test statistics and a downsampled search grid) over UDP
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_diag_sink.h"
+#include <glog/logging.h>
+#include <cstring>
+#include <type_traits>
+
+static_assert(std::is_standard_layout<Acq_Diag_Record>::value,
+    "Acq_Diag_Record must be standard-layout, it is sent as raw bytes");
+
+
+Acq_Diag_Sink::Acq_Diag_Sink(const std::string& address, const uint16_t& port) : socket{io_context}
+{
+    boost::system::error_code ec;
+    endpoint = boost::asio::ip::udp::endpoint(boost::asio::ip::address::from_string(address, ec), port);
+    if (ec)
+        {
+            LOG(WARNING) << "Invalid acquisition diagnostics address " << address << ": " << ec.message();
+            return;
+        }
+    socket.open(endpoint.protocol(), ec);
+    if (ec)
+        {
+            LOG(WARNING) << "Could not open acquisition diagnostics socket: " << ec.message();
+            return;
+        }
+    LOG(INFO) << "Acquisition diagnostic records will be sent to " << address << ":" << port;
+}
+
+
+bool Acq_Diag_Sink::write_record(const Acq_Diag_Record& record, const std::vector<float>& grid)
+{
+    if (!socket.is_open() or grid.size() != static_cast<std::size_t>(record.doppler_bins) * record.code_bins)
+        {
+            return false;
+        }
+    outbound_data.resize(sizeof(Acq_Diag_Record) + grid.size() * sizeof(float));
+    std::memcpy(outbound_data.data(), &record, sizeof(Acq_Diag_Record));
+    std::memcpy(outbound_data.data() + sizeof(Acq_Diag_Record), grid.data(), grid.size() * sizeof(float));
+
+    boost::system::error_code ec;
+    socket.send_to(boost::asio::buffer(outbound_data), endpoint, 0, ec);
+    if (ec)
+        {
+            LOG(WARNING) << "Problem sending acquisition diagnostic record: " << ec.message();
+            return false;
+        }
+    return true;
+}
@@ -0,0 +1,89 @@
+/*!
+ * \file acq_diag_sink.h
+ * \brief Interface of a class that sends acquisition diagnostic records
+ * (test statistics and a downsampled search grid) over UDP
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_DIAG_SINK_H
+#define GNSS_SDR_ACQ_DIAG_SINK_H
+
+#include <boost/asio.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+#if USE_BOOST_ASIO_IO_CONTEXT
+using b_io_context = boost::asio::io_context;
+#else
+using b_io_context = boost::asio::io_service;
+#endif
+
+/*!
+ * \brief Fixed header of an acquisition diagnostic datagram.
+ *
+ * Native byte order, followed by doppler_bins x code_bins float32 grid
+ * values in Doppler-major order. The grid is the max-pooled magnitude
+ * search grid of the concluded acquisition attempt.
+ */
+struct Acq_Diag_Record
+{
+    uint32_t magic;    //!< "GSAQ" = 0x47534151
+    uint8_t version;   //!< format version, currently 1
+    uint8_t positive_acq;
+    uint8_t prn;
+    char system;
+    char signal[2];
+    uint16_t channel;
+    uint32_t doppler_bins;  //!< grid rows after downsampling
+    uint32_t code_bins;     //!< grid columns after downsampling
+    int32_t doppler_max;    //!< search span [Hz]
+    float doppler_step;     //!< original (not downsampled) bin width [Hz]
+    float test_statistic;
+    float threshold;
+    float doppler_hz;          //!< Doppler of the grid maximum [Hz]
+    float code_phase_samples;  //!< code phase of the grid maximum
+    float input_power;
+    uint64_t sample_counter;
+};
+
+/*!
+ * \brief Sends one UDP datagram per concluded acquisition attempt.
+ *
+ * Instantiated lazily by pcps_acquisition the first time a diagnostic
+ * export is armed, so the regular acquisition path carries no cost.
+ */
+class Acq_Diag_Sink
+{
+public:
+    Acq_Diag_Sink(const std::string& address, const uint16_t& port);
+    //! Send one record. grid holds record.doppler_bins x record.code_bins floats
+    bool write_record(const Acq_Diag_Record& record, const std::vector<float>& grid);
+
+private:
+    b_io_context io_context;
+    boost::asio::ip::udp::socket socket;
+    boost::asio::ip::udp::endpoint endpoint;
+    std::vector<char> outbound_data;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_DIAG_SINK_H
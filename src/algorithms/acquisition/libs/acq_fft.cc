@@ -0,0 +1,106 @@
+/*!
+ * \file acq_fft.cc
+ * \brief Process-wide FFT plan cache for the acquisition blocks.
+ * \author Carles Fernandez, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_fft.h"
+
+
+Acq_Fft::Acq_Fft(uint32_t fft_size, bool forward)
+    : d_inbuf(fft_size),
+      d_outbuf(fft_size),
+      d_plan(Acq_Fft_Plan_Cache::get_instance().get_plan(fft_size, forward))
+{
+}
+
+
+void Acq_Fft::execute()
+{
+    // New-array execution: the shared plan only fixes size, direction and
+    // alignment; the buffers are per-instance, so channels do not contend
+    fftwf_execute_dft(d_plan,
+        reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
+        reinterpret_cast<fftwf_complex*>(d_outbuf.data()));
+}
+
+
+Acq_Fft_Plan_Cache& Acq_Fft_Plan_Cache::get_instance()
+{
+    static Acq_Fft_Plan_Cache instance;
+    return instance;
+}
+
+
+fftwf_plan Acq_Fft_Plan_Cache::get_plan(uint32_t fft_size, bool forward)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto key = std::make_pair(fft_size, forward);
+    const auto it = d_plans.find(key);
+    if (it != d_plans.end())
+        {
+            return it->second;
+        }
+
+    // Plan over volk-aligned scratch buffers, so any volk-allocated buffer
+    // passed later to fftwf_execute_dft satisfies the planned alignment
+    volk_gnsssdr::vector<gr_complex> scratch_in(fft_size);
+    volk_gnsssdr::vector<gr_complex> scratch_out(fft_size);
+
+    gr::fft::planner::scoped_lock planner_lock(gr::fft::planner::mutex());  // the FFTW planner is not thread-safe
+    fftwf_plan plan = fftwf_plan_dft_1d(static_cast<int>(fft_size),
+        reinterpret_cast<fftwf_complex*>(scratch_in.data()),
+        reinterpret_cast<fftwf_complex*>(scratch_out.data()),
+        forward ? FFTW_FORWARD : FFTW_BACKWARD,
+        FFTW_MEASURE);
+
+    d_plans[key] = plan;
+    return plan;
+}
+
+
+bool Acq_Fft_Plan_Cache::load_wisdom(const std::string& filename)
+{
+    gr::fft::planner::scoped_lock planner_lock(gr::fft::planner::mutex());  // the FFTW planner is not thread-safe
+    return fftwf_import_wisdom_from_filename(filename.c_str()) != 0;
+}
+
+
+bool Acq_Fft_Plan_Cache::save_wisdom(const std::string& filename)
+{
+    gr::fft::planner::scoped_lock planner_lock(gr::fft::planner::mutex());  // the FFTW planner is not thread-safe
+    return fftwf_export_wisdom_to_filename(filename.c_str()) != 0;
+}
+
+
+void Acq_Fft_Plan_Cache::preplan(const std::vector<uint32_t>& fft_sizes)
+{
+    for (const auto fft_size : fft_sizes)
+        {
+            if (fft_size > 0)
+                {
+                    get_plan(fft_size, true);
+                    get_plan(fft_size, false);
+                }
+        }
+}
+
+
+Acq_Fft_Plan_Cache::~Acq_Fft_Plan_Cache()
+{
+    gr::fft::planner::scoped_lock planner_lock(gr::fft::planner::mutex());  // the FFTW planner is not thread-safe
+    for (auto& entry : d_plans)
+        {
+            fftwf_destroy_plan(entry.second);
+        }
+}
@@ -0,0 +1,129 @@
+/*!
+ * \file acq_fft.h
+ * \brief Process-wide FFT plan cache for the acquisition blocks.
+ *
+ * Every acquisition channel of a given signal needs forward and inverse
+ * FFTs of the same size. Instead of planning (and holding twiddle tables
+ * for) one FFTW plan per channel, Acq_Fft draws a shared plan from a
+ * process-wide cache keyed by (size, direction) and executes it with the
+ * new-array interface over per-instance buffers, so concurrent channels
+ * never contend on data while startup latency and resident memory stay
+ * flat with the number of channels.
+ * \author Carles Fernandez, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_FFT_H
+#define GNSS_SDR_ACQ_FFT_H
+
+#include <gnuradio/fft/fft.h>  // for fftwf_plan and the FFTW planner lock
+#include <gnuradio/gr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief FFT with per-instance buffers and a plan drawn from a shared cache.
+ *
+ * The interface mirrors gr::fft::fft_complex_fwd / fft_complex_rev so the
+ * acquisition blocks can use it as a drop-in replacement.
+ */
+class Acq_Fft
+{
+public:
+    //! Builds an FFT of the given size. \p forward selects FFT/IFFT direction.
+    Acq_Fft(uint32_t fft_size, bool forward);
+    ~Acq_Fft() = default;
+
+    Acq_Fft(const Acq_Fft&) = delete;
+    Acq_Fft& operator=(const Acq_Fft&) = delete;
+
+    inline gr_complex* get_inbuf()
+    {
+        return d_inbuf.data();
+    }
+
+    inline gr_complex* get_outbuf()
+    {
+        return d_outbuf.data();
+    }
+
+    //! Executes the transform over the per-instance buffers.
+    void execute();
+
+private:
+    volk_gnsssdr::vector<gr_complex> d_inbuf;
+    volk_gnsssdr::vector<gr_complex> d_outbuf;
+    fftwf_plan d_plan;  // owned by the cache, shared between instances
+};
+
+
+/*!
+ * \brief Process-wide cache of FFTW plans keyed by (size, direction).
+ *
+ * Plans are created once under the FFTW planner lock and live for the
+ * whole process; fftwf_execute_dft() on a shared plan is thread-safe.
+ */
+class Acq_Fft_Plan_Cache
+{
+public:
+    static Acq_Fft_Plan_Cache& get_instance();
+
+    //! Returns the shared plan for the given size and direction, planning it on first use.
+    fftwf_plan get_plan(uint32_t fft_size, bool forward);
+
+    /*!
+     * \brief Imports accumulated FFTW wisdom from a file, so the
+     * FFTW_MEASURE planning of already-seen sizes completes almost
+     * instantaneously. Returns false if the file is missing or unreadable.
+     */
+    bool load_wisdom(const std::string& filename);
+
+    /*!
+     * \brief Exports the wisdom accumulated by the plans made so far, for
+     * reuse by the next run. Returns false if the file cannot be written.
+     */
+    bool save_wisdom(const std::string& filename);
+
+    /*!
+     * \brief Plans the forward and inverse transforms of the given sizes up
+     * front, before any block is instantiated. The FFTW planner is
+     * process-global and serialized, so the sizes are planned one after the
+     * other; with wisdom loaded this is a fast warm-up pass.
+     */
+    void preplan(const std::vector<uint32_t>& fft_sizes);
+
+    Acq_Fft_Plan_Cache(const Acq_Fft_Plan_Cache&) = delete;
+    Acq_Fft_Plan_Cache& operator=(const Acq_Fft_Plan_Cache&) = delete;
+
+private:
+    Acq_Fft_Plan_Cache() = default;
+    ~Acq_Fft_Plan_Cache();
+
+    std::map<std::pair<uint32_t, bool>, fftwf_plan> d_plans;
+    std::mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_FFT_H
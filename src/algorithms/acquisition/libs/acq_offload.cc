@@ -0,0 +1,345 @@
+/*!
+ * \file acq_offload.cc
+ * \brief Remote execution of the acquisition grid search over TCP.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_offload.h"
+#include "MATH_CONSTANTS.h"
+#include "acq_fft.h"
+#include <glog/logging.h>
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+constexpr uint32_t ACQ_OFFLOAD_MAGIC = 0x47414F46;  // "GAOF"
+constexpr uint8_t ACQ_OFFLOAD_VERSION = 1;
+constexpr uint32_t ACQ_OFFLOAD_MAX_FFT_SIZE = 1U << 24U;
+constexpr uint32_t ACQ_OFFLOAD_MAX_DOPPLER_BINS = 1U << 16U;
+}  // namespace
+
+
+uint64_t acq_offload_code_key(const std::complex<float>* fft_codes, uint32_t fft_size)
+{
+    // 64-bit FNV-1a over the replica bytes
+    const auto* bytes = reinterpret_cast<const unsigned char*>(fft_codes);
+    const size_t num_bytes = static_cast<size_t>(fft_size) * sizeof(std::complex<float>);
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < num_bytes; i++)
+        {
+            hash ^= static_cast<uint64_t>(bytes[i]);
+            hash *= 0x100000001B3ULL;
+        }
+    return hash;
+}
+
+
+Acq_Offload_Client::Acq_Offload_Client(std::string address, uint16_t port)
+    : d_address(std::move(address)),
+      d_socket(d_io_context),
+      d_port(port),
+      d_connected(false)
+{
+}
+
+
+Acq_Offload_Client::~Acq_Offload_Client()
+{
+    drop_connection();
+}
+
+
+bool Acq_Offload_Client::ensure_connected()
+{
+    if (d_connected)
+        {
+            return true;
+        }
+    try
+        {
+            boost::asio::ip::tcp::resolver resolver(d_io_context);
+            boost::asio::connect(d_socket, resolver.resolve(d_address, std::to_string(d_port)));
+            d_socket.set_option(boost::asio::ip::tcp::no_delay(true));
+            d_connected = true;
+            // A fresh connection may face a restarted server with an empty cache
+            d_uploaded_codes.clear();
+        }
+    catch (const boost::system::system_error& e)
+        {
+            DLOG(INFO) << "Acquisition offload: cannot connect to " << d_address << ":" << d_port << " (" << e.what() << ")";
+            drop_connection();
+            return false;
+        }
+    return true;
+}
+
+
+void Acq_Offload_Client::drop_connection()
+{
+    boost::system::error_code ec;
+    d_socket.close(ec);
+    d_connected = false;
+    d_uploaded_codes.clear();
+}
+
+
+bool Acq_Offload_Client::grid_search(const std::complex<float>* in, uint32_t fft_size,
+    const std::complex<float>* fft_codes, int64_t fs,
+    int32_t doppler_min, int32_t doppler_step, uint32_t num_doppler_bins,
+    Acq_Offload_Reply* reply)
+{
+    if (!ensure_connected())
+        {
+            return false;
+        }
+
+    // Quantize the snapshot to int8 IQ, four times smaller on the wire
+    // than the native complex<float> samples
+    float max_abs = 0.0F;
+    for (uint32_t i = 0; i < fft_size; i++)
+        {
+            max_abs = std::max(max_abs, std::max(std::fabs(in[i].real()), std::fabs(in[i].imag())));
+        }
+    const float scale = (max_abs > 0.0F ? max_abs / 127.0F : 1.0F);
+    d_quantized.resize(2 * static_cast<size_t>(fft_size));
+    for (uint32_t i = 0; i < fft_size; i++)
+        {
+            d_quantized[2 * i] = static_cast<int8_t>(std::lround(in[i].real() / scale));
+            d_quantized[2 * i + 1] = static_cast<int8_t>(std::lround(in[i].imag() / scale));
+        }
+
+    Acq_Offload_Request request{};
+    request.magic = ACQ_OFFLOAD_MAGIC;
+    request.version = ACQ_OFFLOAD_VERSION;
+    request.fft_size = fft_size;
+    request.num_samples = fft_size;
+    request.doppler_min = doppler_min;
+    request.doppler_step = doppler_step;
+    request.num_doppler_bins = num_doppler_bins;
+    request.fs = fs;
+    request.code_key = acq_offload_code_key(fft_codes, fft_size);
+    request.sample_scale = scale;
+    request.has_code = (d_uploaded_codes.count(request.code_key) == 0 ? 1 : 0);
+
+    try
+        {
+            for (int attempt = 0; attempt < 2; attempt++)
+                {
+                    std::vector<boost::asio::const_buffer> buffers;
+                    buffers.emplace_back(boost::asio::buffer(&request, sizeof(request)));
+                    buffers.emplace_back(boost::asio::buffer(d_quantized.data(), d_quantized.size()));
+                    if (request.has_code != 0)
+                        {
+                            buffers.emplace_back(boost::asio::buffer(fft_codes, fft_size * sizeof(std::complex<float>)));
+                        }
+                    boost::asio::write(d_socket, buffers);
+                    boost::asio::read(d_socket, boost::asio::buffer(reply, sizeof(*reply)));
+                    if (reply->magic != ACQ_OFFLOAD_MAGIC or reply->version != ACQ_OFFLOAD_VERSION)
+                        {
+                            LOG(WARNING) << "Acquisition offload: malformed reply from " << d_address << ":" << d_port;
+                            drop_connection();
+                            return false;
+                        }
+                    if (reply->status == 1 and request.has_code == 0)
+                        {
+                            // The server evicted the replica: upload it and retry once
+                            request.has_code = 1;
+                            continue;
+                        }
+                    if (reply->status != 0)
+                        {
+                            return false;
+                        }
+                    d_uploaded_codes.insert(request.code_key);
+                    return true;
+                }
+        }
+    catch (const boost::system::system_error& e)
+        {
+            DLOG(INFO) << "Acquisition offload: request to " << d_address << ":" << d_port << " failed (" << e.what() << ")";
+            drop_connection();
+        }
+    return false;
+}
+
+
+Acq_Offload_Server::Acq_Offload_Server(uint16_t port)
+    : d_acceptor(d_io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port)),
+      d_running(false)
+{
+}
+
+
+Acq_Offload_Server::~Acq_Offload_Server()
+{
+    stop();
+    for (auto& connection : d_connections)
+        {
+            if (connection.joinable())
+                {
+                    connection.join();
+                }
+        }
+}
+
+
+void Acq_Offload_Server::run()
+{
+    d_running = true;
+    while (d_running)
+        {
+            boost::asio::ip::tcp::socket socket(d_io_context);
+            boost::system::error_code ec;
+            d_acceptor.accept(socket, ec);
+            if (ec)
+                {
+                    if (d_running)
+                        {
+                            LOG(WARNING) << "Acquisition offload server: accept failed (" << ec.message() << ")";
+                        }
+                    break;
+                }
+            d_connections.emplace_back(&Acq_Offload_Server::serve_connection, this, std::move(socket));
+        }
+}
+
+
+void Acq_Offload_Server::stop()
+{
+    d_running = false;
+    boost::system::error_code ec;
+    d_acceptor.close(ec);
+}
+
+
+void Acq_Offload_Server::serve_connection(boost::asio::ip::tcp::socket socket)
+{
+    try
+        {
+            socket.set_option(boost::asio::ip::tcp::no_delay(true));
+            while (d_running and handle_request(socket))
+                {
+                }
+        }
+    catch (const boost::system::system_error& e)
+        {
+            DLOG(INFO) << "Acquisition offload server: connection closed (" << e.what() << ")";
+        }
+}
+
+
+bool Acq_Offload_Server::handle_request(boost::asio::ip::tcp::socket& socket)
+{
+    Acq_Offload_Request request{};
+    boost::asio::read(socket, boost::asio::buffer(&request, sizeof(request)));
+
+    Acq_Offload_Reply reply{};
+    reply.magic = ACQ_OFFLOAD_MAGIC;
+    reply.version = ACQ_OFFLOAD_VERSION;
+
+    if (request.magic != ACQ_OFFLOAD_MAGIC or request.version != ACQ_OFFLOAD_VERSION or
+        request.fft_size == 0 or request.fft_size > ACQ_OFFLOAD_MAX_FFT_SIZE or
+        request.num_samples > request.fft_size or
+        request.num_doppler_bins == 0 or request.num_doppler_bins > ACQ_OFFLOAD_MAX_DOPPLER_BINS or
+        request.fs <= 0)
+        {
+            reply.status = 2;
+            boost::asio::write(socket, boost::asio::buffer(&reply, sizeof(reply)));
+            return false;
+        }
+
+    std::vector<int8_t> quantized(2 * static_cast<size_t>(request.num_samples));
+    boost::asio::read(socket, boost::asio::buffer(quantized.data(), quantized.size()));
+
+    if (request.has_code != 0)
+        {
+            std::vector<std::complex<float>> code(request.fft_size);
+            boost::asio::read(socket, boost::asio::buffer(code.data(), code.size() * sizeof(std::complex<float>)));
+            std::lock_guard<std::mutex> lock(d_cache_mutex);
+            d_code_cache[request.code_key] = std::move(code);
+        }
+
+    std::vector<std::complex<float>> fft_codes;
+    {
+        std::lock_guard<std::mutex> lock(d_cache_mutex);
+        const auto it = d_code_cache.find(request.code_key);
+        if (it == d_code_cache.end())
+            {
+                reply.status = 1;
+                boost::asio::write(socket, boost::asio::buffer(&reply, sizeof(reply)));
+                return true;
+            }
+        fft_codes = it->second;
+    }
+
+    // De-quantize and zero-pad the snapshot
+    std::vector<std::complex<float>> input(request.fft_size, std::complex<float>(0.0F, 0.0F));
+    for (uint32_t i = 0; i < request.num_samples; i++)
+        {
+            input[i] = std::complex<float>(static_cast<float>(quantized[2 * i]) * request.sample_scale,
+                static_cast<float>(quantized[2 * i + 1]) * request.sample_scale);
+        }
+
+    // PCPS grid search: Doppler wipeoff, FFT, circular correlation with
+    // the cached replica, IFFT, peak search over the whole grid
+    Acq_Fft fft_fwd(request.fft_size, true);
+    Acq_Fft fft_inv(request.fft_size, false);
+    volk_gnsssdr::vector<std::complex<float>> wipeoff(request.fft_size);
+    volk_gnsssdr::vector<float> magnitude(request.fft_size);
+
+    float peak = 0.0F;
+    uint32_t peak_index = 0U;
+    int32_t peak_doppler = request.doppler_min;
+    double grid_sum = 0.0;
+    for (uint32_t bin = 0; bin < request.num_doppler_bins; bin++)
+        {
+            const int32_t doppler = request.doppler_min + request.doppler_step * static_cast<int32_t>(bin);
+            const float phase_step_rad = static_cast<float>(TWO_PI) * static_cast<float>(doppler) / static_cast<float>(request.fs);
+            std::array<float, 1> phase{};
+            volk_gnsssdr_s32f_sincos_32fc(wipeoff.data(), -phase_step_rad, phase.data(), request.fft_size);
+            volk_32fc_x2_multiply_32fc(fft_fwd.get_inbuf(), input.data(), wipeoff.data(), request.fft_size);
+            fft_fwd.execute();
+            volk_32fc_x2_multiply_32fc(fft_inv.get_inbuf(), fft_fwd.get_outbuf(), fft_codes.data(), request.fft_size);
+            fft_inv.execute();
+            volk_32fc_magnitude_squared_32f(magnitude.data(), fft_inv.get_outbuf(), request.fft_size);
+
+            uint32_t bin_index = 0U;
+            float bin_sum = 0.0F;
+            volk_gnsssdr_32f_index_max_32u(&bin_index, magnitude.data(), request.fft_size);
+            volk_32f_accumulator_s32f(&bin_sum, magnitude.data(), request.fft_size);
+            grid_sum += static_cast<double>(bin_sum);
+            if (magnitude[bin_index] > peak)
+                {
+                    peak = magnitude[bin_index];
+                    peak_index = bin_index;
+                    peak_doppler = doppler;
+                }
+        }
+
+    const double num_cells = static_cast<double>(request.fft_size) * static_cast<double>(request.num_doppler_bins);
+    const double input_power = (grid_sum - static_cast<double>(peak)) / (num_cells - 1.0);
+
+    reply.status = 0;
+    reply.delay_index = peak_index;
+    reply.doppler_hz = peak_doppler;
+    reply.peak_magnitude = peak;
+    reply.input_power = static_cast<float>(input_power);
+    reply.test_statistic = (input_power > 0.0 ? static_cast<float>(static_cast<double>(peak) / input_power) : 0.0F);
+    boost::asio::write(socket, boost::asio::buffer(&reply, sizeof(reply)));
+    return true;
+}
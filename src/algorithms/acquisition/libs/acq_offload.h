@@ -0,0 +1,170 @@
+/*!
+ * \file acq_offload.h
+ * \brief Remote execution of the acquisition grid search over TCP.
+ *
+ * One well-provisioned acquisition server can run the cold-start grid
+ * searches of several edge receivers, so the edge CPUs only pay for
+ * tracking. The edge ships a quantized snapshot of the input together
+ * with the Doppler grid geometry; the conjugated frequency-domain
+ * replica is uploaded once per retarget and cached server-side by a
+ * content hash, so steady-state requests carry only the snapshot. The
+ * server answers with (delay, Doppler, test statistic), which the
+ * requesting block feeds into the usual ChannelFsm message path. Any
+ * transport failure makes the client report the request as failed and
+ * the block falls back to the local grid search.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_OFFLOAD_H
+#define GNSS_SDR_ACQ_OFFLOAD_H
+
+#include <boost/asio.hpp>
+#include <atomic>
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+#if USE_BOOST_ASIO_IO_CONTEXT
+using b_io_context = boost::asio::io_context;
+#else
+using b_io_context = boost::asio::io_service;
+#endif
+
+/*!
+ * \brief Fixed header of an offloaded grid-search request.
+ *
+ * Native byte order. Followed by 2 x num_samples int8 IQ samples and,
+ * if has_code is set, by fft_size complex<float> values holding the
+ * conjugated frequency-domain replica.
+ */
+struct Acq_Offload_Request
+{
+    uint32_t magic;    //!< "GAOF" = 0x47414F46
+    uint8_t version;   //!< format version, currently 1
+    uint8_t has_code;  //!< 1 if the replica follows the samples
+    uint16_t reserved;
+    uint32_t fft_size;
+    uint32_t num_samples;  //!< quantized samples that follow, zero-padded to fft_size server-side
+    int32_t doppler_min;   //!< first Doppler bin [Hz]
+    int32_t doppler_step;  //!< bin width [Hz]
+    uint32_t num_doppler_bins;
+    int64_t fs;            //!< sampling frequency of the snapshot [Hz]
+    uint64_t code_key;     //!< content hash identifying the replica in the server cache
+    float sample_scale;    //!< int8 to float de-quantization factor
+};
+
+/*!
+ * \brief Reply to an offloaded grid-search request. Native byte order.
+ */
+struct Acq_Offload_Reply
+{
+    uint32_t magic;
+    uint8_t version;
+    uint8_t status;  //!< 0 = result valid, 1 = replica not cached, 2 = malformed request
+    uint16_t reserved;
+    uint32_t delay_index;  //!< sample index of the grid maximum
+    int32_t doppler_hz;    //!< Doppler of the grid maximum [Hz]
+    float test_statistic;  //!< peak to input power ratio over the grid
+    float input_power;
+    float peak_magnitude;
+};
+
+/*!
+ * \brief Client side of the acquisition offload: quantizes the snapshot,
+ * uploads the replica on first use and runs one blocking request per
+ * grid search. One instance per acquisition block; requests already run
+ * outside the GNU Radio scheduler, on the acquisition worker pool.
+ */
+class Acq_Offload_Client
+{
+public:
+    Acq_Offload_Client(std::string address, uint16_t port);
+    ~Acq_Offload_Client();
+
+    /*!
+     * \brief Runs the grid search remotely. Returns false on any
+     * transport or server error, leaving the caller to fall back to the
+     * local search.
+     */
+    bool grid_search(const std::complex<float>* in, uint32_t fft_size,
+        const std::complex<float>* fft_codes, int64_t fs,
+        int32_t doppler_min, int32_t doppler_step, uint32_t num_doppler_bins,
+        Acq_Offload_Reply* reply);
+
+    Acq_Offload_Client(const Acq_Offload_Client&) = delete;
+    Acq_Offload_Client& operator=(const Acq_Offload_Client&) = delete;
+
+private:
+    bool ensure_connected();
+    void drop_connection();
+
+    std::string d_address;
+    b_io_context d_io_context;
+    boost::asio::ip::tcp::socket d_socket;
+    std::set<uint64_t> d_uploaded_codes;  // replicas the server has seen on this connection
+    std::vector<int8_t> d_quantized;
+    uint16_t d_port;
+    bool d_connected;
+};
+
+/*!
+ * \brief Server side of the acquisition offload: accepts edge
+ * connections and runs the PCPS grid search on their snapshots, caching
+ * uploaded replicas by content hash so retargeting among the served
+ * receivers reuses codes seen earlier.
+ */
+class Acq_Offload_Server
+{
+public:
+    explicit Acq_Offload_Server(uint16_t port);
+    ~Acq_Offload_Server();
+
+    //! Accepts connections until stop() is called; one thread per edge receiver
+    void run();
+
+    //! Makes run() return after the pending accepts
+    void stop();
+
+    Acq_Offload_Server(const Acq_Offload_Server&) = delete;
+    Acq_Offload_Server& operator=(const Acq_Offload_Server&) = delete;
+
+private:
+    void serve_connection(boost::asio::ip::tcp::socket socket);
+    bool handle_request(boost::asio::ip::tcp::socket& socket);
+
+    std::map<uint64_t, std::vector<std::complex<float>>> d_code_cache;
+    std::mutex d_cache_mutex;
+    std::vector<std::thread> d_connections;
+    b_io_context d_io_context;
+    boost::asio::ip::tcp::acceptor d_acceptor;
+    std::atomic<bool> d_running;
+};
+
+//! Content hash (64-bit FNV-1a) used as the replica cache key
+uint64_t acq_offload_code_key(const std::complex<float>* fft_codes, uint32_t fft_size);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_OFFLOAD_H
@@ -0,0 +1,115 @@
+/*!
+ * \file acq_worker_pool.cc
+ * \brief Process-wide worker pool executing acquisition grid searches
+ * outside the GNU Radio scheduler threads.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_worker_pool.h"
+#include <glog/logging.h>
+#include <utility>
+
+
+Acq_Worker_Pool& Acq_Worker_Pool::get_instance()
+{
+    static Acq_Worker_Pool instance;
+    return instance;
+}
+
+
+Acq_Worker_Pool::Acq_Worker_Pool()
+{
+    const uint32_t hw = std::thread::hardware_concurrency();
+    d_num_workers = (hw > 1 ? hw / 2 : 1);
+    d_running = false;
+    d_shutdown = false;
+}
+
+
+Acq_Worker_Pool::~Acq_Worker_Pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_shutdown = true;
+    }
+    d_cond.notify_all();
+    for (auto& worker : d_workers)
+        {
+            if (worker.joinable())
+                {
+                    worker.join();
+                }
+        }
+}
+
+
+void Acq_Worker_Pool::set_num_workers(uint32_t num_workers)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_running)
+        {
+            LOG(WARNING) << "Acquisition worker pool already running, ignoring new size " << num_workers;
+            return;
+        }
+    if (num_workers > 0)
+        {
+            d_num_workers = num_workers;
+        }
+}
+
+
+void Acq_Worker_Pool::enqueue(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (!d_running)
+            {
+                start_workers();
+            }
+        d_jobs.push(std::move(job));
+    }
+    d_cond.notify_one();
+}
+
+
+void Acq_Worker_Pool::start_workers()
+{
+    // called with d_mutex held
+    d_workers.reserve(d_num_workers);
+    for (uint32_t i = 0; i < d_num_workers; i++)
+        {
+            d_workers.emplace_back(&Acq_Worker_Pool::worker_loop, this);
+        }
+    d_running = true;
+    DLOG(INFO) << "Acquisition worker pool started with " << d_num_workers << " threads";
+}
+
+
+void Acq_Worker_Pool::worker_loop()
+{
+    while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait(lock, [this] { return d_shutdown or !d_jobs.empty(); });
+                if (d_shutdown and d_jobs.empty())
+                    {
+                        return;
+                    }
+                job = std::move(d_jobs.front());
+                d_jobs.pop();
+            }
+            job();
+        }
+}
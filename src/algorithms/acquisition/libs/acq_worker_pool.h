@@ -0,0 +1,82 @@
+/*!
+ * \file acq_worker_pool.h
+ * \brief Process-wide worker pool executing acquisition grid searches
+ * outside the GNU Radio scheduler threads.
+ *
+ * In non-blocking mode each acquisition block used to detach a fresh
+ * thread per dwell. A burst of cold-start acquisitions then oversubscribes
+ * small CPUs and starves the tracking channels. This pool bounds the
+ * concurrency: general_work() only snapshots the input and enqueues a job,
+ * and results come back through the usual ChannelFsm / message port path.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_WORKER_POOL_H
+#define GNSS_SDR_ACQ_WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Fixed-size worker pool shared by all acquisition channels.
+ *
+ * Threads are started lazily on the first enqueued job. The number of
+ * workers can be set through the GNSS-SDR.acq_worker_threads configuration
+ * parameter before the first job is queued; it defaults to half the
+ * hardware concurrency (at least one).
+ */
+class Acq_Worker_Pool
+{
+public:
+    static Acq_Worker_Pool& get_instance();
+
+    //! Queues a grid-search job for execution on a pool worker.
+    void enqueue(std::function<void()> job);
+
+    //! Sets the number of workers. It has no effect once the pool is running.
+    void set_num_workers(uint32_t num_workers);
+
+    Acq_Worker_Pool(const Acq_Worker_Pool&) = delete;
+    Acq_Worker_Pool& operator=(const Acq_Worker_Pool&) = delete;
+
+private:
+    Acq_Worker_Pool();
+    ~Acq_Worker_Pool();
+
+    void worker_loop();
+    void start_workers();
+
+    std::vector<std::thread> d_workers;
+    std::queue<std::function<void()>> d_jobs;
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    uint32_t d_num_workers;
+    bool d_running;
+    bool d_shutdown;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_WORKER_POOL_H
@@ -0,0 +1,237 @@
+/*!
+ * \file sycl_grid_search.cc
+ * \brief Delay-Doppler grid search on a SYCL device with oneMKL FFTs
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "sycl_grid_search.h"
+#include <CL/sycl.hpp>
+#include <oneapi/mkl/dfti.hpp>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+// partial reductions per Doppler bin; the host finishes the last step
+constexpr int SYCL_GS_GROUPS = 64;
+constexpr int SYCL_GS_GROUP_SIZE = 128;
+
+using dft_descriptor = oneapi::mkl::dft::descriptor<oneapi::mkl::dft::precision::SINGLE,
+    oneapi::mkl::dft::domain::COMPLEX>;
+}  // namespace
+
+
+struct Sycl_Grid_Search::Impl
+{
+    cl::sycl::queue queue;
+    std::unique_ptr<dft_descriptor> fft_plan;
+
+    uint32_t fft_size = 0;
+
+    // device-resident data
+    cl::sycl::float2* in_dev = nullptr;
+    cl::sycl::float2* codes_dev = nullptr;
+    cl::sycl::float2* work_dev = nullptr;
+    // per-group partial reductions, in shared USM so the host reads them directly
+    float* partial_max = nullptr;
+    uint32_t* partial_idx = nullptr;
+    float* partial_sum = nullptr;
+};
+
+
+Sycl_Grid_Search::Sycl_Grid_Search(uint32_t fft_size)
+    : d_impl(std::make_unique<Impl>())
+{
+    try
+        {
+            d_impl->queue = cl::sycl::queue(cl::sycl::default_selector());
+            d_impl->fft_plan = std::make_unique<dft_descriptor>(static_cast<std::int64_t>(fft_size));
+            // in-place single-precision complex transform; the backward pass is
+            // left unscaled, which does not matter for the peak to power ratio
+            d_impl->fft_plan->commit(d_impl->queue);
+        }
+    catch (const std::exception& e)
+        {
+            throw std::runtime_error(std::string("SYCL grid search unavailable: ") + e.what());
+        }
+    d_impl->fft_size = fft_size;
+    d_impl->in_dev = cl::sycl::malloc_device<cl::sycl::float2>(fft_size, d_impl->queue);
+    d_impl->codes_dev = cl::sycl::malloc_device<cl::sycl::float2>(fft_size, d_impl->queue);
+    d_impl->work_dev = cl::sycl::malloc_device<cl::sycl::float2>(fft_size, d_impl->queue);
+    d_impl->partial_max = cl::sycl::malloc_shared<float>(SYCL_GS_GROUPS, d_impl->queue);
+    d_impl->partial_idx = cl::sycl::malloc_shared<uint32_t>(SYCL_GS_GROUPS, d_impl->queue);
+    d_impl->partial_sum = cl::sycl::malloc_shared<float>(SYCL_GS_GROUPS, d_impl->queue);
+    if (d_impl->in_dev == nullptr or d_impl->codes_dev == nullptr or d_impl->work_dev == nullptr or
+        d_impl->partial_max == nullptr or d_impl->partial_idx == nullptr or d_impl->partial_sum == nullptr)
+        {
+            throw std::runtime_error("SYCL grid search unavailable: device allocation failed");
+        }
+}
+
+
+Sycl_Grid_Search::~Sycl_Grid_Search()
+{
+    if (d_impl->in_dev != nullptr)
+        {
+            cl::sycl::free(d_impl->in_dev, d_impl->queue);
+            cl::sycl::free(d_impl->codes_dev, d_impl->queue);
+            cl::sycl::free(d_impl->work_dev, d_impl->queue);
+            cl::sycl::free(d_impl->partial_max, d_impl->queue);
+            cl::sycl::free(d_impl->partial_idx, d_impl->queue);
+            cl::sycl::free(d_impl->partial_sum, d_impl->queue);
+        }
+}
+
+
+std::string Sycl_Grid_Search::device_name() const
+{
+    return d_impl->queue.get_device().get_info<cl::sycl::info::device::name>();
+}
+
+
+bool Sycl_Grid_Search::grid_search(const std::complex<float>* in,
+    const std::complex<float>* fft_codes,
+    int64_t fs,
+    int32_t doppler_min,
+    int32_t doppler_step,
+    uint32_t num_doppler_bins,
+    Sycl_Acq_Result* result)
+{
+    Impl* impl = d_impl.get();
+    const auto fft_size = static_cast<int>(impl->fft_size);
+    cl::sycl::float2* sig = impl->in_dev;
+    cl::sycl::float2* codes = impl->codes_dev;
+    cl::sycl::float2* work = impl->work_dev;
+    float* partial_max = impl->partial_max;
+    uint32_t* partial_idx = impl->partial_idx;
+    float* partial_sum = impl->partial_sum;
+
+    float peak = 0.0F;
+    float grid_sum = 0.0F;
+    uint32_t peak_index = 0U;
+    uint32_t peak_bin = 0U;
+
+    try
+        {
+            impl->queue.memcpy(sig, in, fft_size * sizeof(cl::sycl::float2));
+            impl->queue.memcpy(codes, fft_codes, fft_size * sizeof(cl::sycl::float2));
+            impl->queue.wait();
+
+            for (uint32_t bin = 0; bin < num_doppler_bins; bin++)
+                {
+                    const float doppler_hz = static_cast<float>(doppler_min) + static_cast<float>(doppler_step) * static_cast<float>(bin);
+                    const float phase_step_rad = 2.0F * static_cast<float>(M_PI) * doppler_hz / static_cast<float>(fs);
+
+                    // carrier wipe-off into the FFT work buffer
+                    impl->queue.parallel_for(cl::sycl::range<1>(fft_size), [=](cl::sycl::id<1> idx) {
+                        const int n = static_cast<int>(idx[0]);
+                        const float phase = phase_step_rad * static_cast<float>(n);
+                        const float c = cl::sycl::cos(phase);
+                        const float s = cl::sycl::sin(phase);
+                        const cl::sycl::float2 x = sig[n];
+                        // x * exp(-j*phase)
+                        work[n] = cl::sycl::float2(x.x() * c + x.y() * s, x.y() * c - x.x() * s);
+                    });
+
+                    oneapi::mkl::dft::compute_forward(*impl->fft_plan, reinterpret_cast<float*>(work));
+
+                    // multiply with the conjugated local code spectrum
+                    impl->queue.parallel_for(cl::sycl::range<1>(fft_size), [=](cl::sycl::id<1> idx) {
+                        const int n = static_cast<int>(idx[0]);
+                        const cl::sycl::float2 a = work[n];
+                        const cl::sycl::float2 b = codes[n];
+                        work[n] = cl::sycl::float2(a.x() * b.x() - a.y() * b.y(), a.x() * b.y() + a.y() * b.x());
+                    });
+
+                    oneapi::mkl::dft::compute_backward(*impl->fft_plan, reinterpret_cast<float*>(work));
+
+                    // squared-magnitude max and sum, reduced per work-group
+                    impl->queue.submit([&](cl::sycl::handler& cgh) {
+                        cl::sycl::accessor<float, 1, cl::sycl::access::mode::read_write, cl::sycl::access::target::local>
+                            local_max(cl::sycl::range<1>(SYCL_GS_GROUP_SIZE), cgh);
+                        cl::sycl::accessor<uint32_t, 1, cl::sycl::access::mode::read_write, cl::sycl::access::target::local>
+                            local_idx(cl::sycl::range<1>(SYCL_GS_GROUP_SIZE), cgh);
+                        cl::sycl::accessor<float, 1, cl::sycl::access::mode::read_write, cl::sycl::access::target::local>
+                            local_sum(cl::sycl::range<1>(SYCL_GS_GROUP_SIZE), cgh);
+                        cgh.parallel_for(
+                            cl::sycl::nd_range<1>(cl::sycl::range<1>(SYCL_GS_GROUPS * SYCL_GS_GROUP_SIZE),
+                                cl::sycl::range<1>(SYCL_GS_GROUP_SIZE)),
+                            [=](cl::sycl::nd_item<1> item) {
+                                const int group = static_cast<int>(item.get_group(0));
+                                const int lane = static_cast<int>(item.get_local_id(0));
+
+                                float best = -1.0F;
+                                uint32_t best_idx = 0U;
+                                float acc = 0.0F;
+                                for (int n = group * SYCL_GS_GROUP_SIZE + lane; n < fft_size; n += SYCL_GS_GROUPS * SYCL_GS_GROUP_SIZE)
+                                    {
+                                        const cl::sycl::float2 x = work[n];
+                                        const float mag = x.x() * x.x() + x.y() * x.y();
+                                        acc += mag;
+                                        if (mag > best)
+                                            {
+                                                best = mag;
+                                                best_idx = static_cast<uint32_t>(n);
+                                            }
+                                    }
+                                local_max[lane] = best;
+                                local_idx[lane] = best_idx;
+                                local_sum[lane] = acc;
+                                for (int stride = SYCL_GS_GROUP_SIZE / 2; stride > 0; stride >>= 1)
+                                    {
+                                        item.barrier(cl::sycl::access::fence_space::local_space);
+                                        if (lane < stride)
+                                            {
+                                                if (local_max[lane + stride] > local_max[lane])
+                                                    {
+                                                        local_max[lane] = local_max[lane + stride];
+                                                        local_idx[lane] = local_idx[lane + stride];
+                                                    }
+                                                local_sum[lane] += local_sum[lane + stride];
+                                            }
+                                    }
+                                if (lane == 0)
+                                    {
+                                        partial_max[group] = local_max[0];
+                                        partial_idx[group] = local_idx[0];
+                                        partial_sum[group] = local_sum[0];
+                                    }
+                            });
+                    });
+                    impl->queue.wait();
+
+                    for (int g = 0; g < SYCL_GS_GROUPS; g++)
+                        {
+                            grid_sum += partial_sum[g];
+                            if (partial_max[g] > peak)
+                                {
+                                    peak = partial_max[g];
+                                    peak_index = partial_idx[g];
+                                    peak_bin = bin;
+                                }
+                        }
+                }
+        }
+    catch (const std::exception&)
+        {
+            return false;
+        }
+
+    const auto num_cells = static_cast<float>(static_cast<uint64_t>(fft_size) * num_doppler_bins);
+    result->peak_magnitude = peak;
+    result->input_power = (grid_sum - peak) / (num_cells - 1.0F);
+    result->test_statistic = (result->input_power > 0.0F ? peak / result->input_power : 0.0F);
+    result->delay_index = peak_index;
+    result->doppler_hz = doppler_min + doppler_step * static_cast<int32_t>(peak_bin);
+    return true;
+}
@@ -0,0 +1,86 @@
+/*!
+ * \file sycl_grid_search.h
+ * \brief Delay-Doppler grid search on a SYCL device with oneMKL FFTs
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * Accelerator backend for the PCPS acquisition grid search targeting SYCL
+ * devices (Intel integrated GPUs through oneAPI). The whole grid is evaluated
+ * on the device and only the peak location and the decision statistics travel
+ * back to the host.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SYCL_GRID_SEARCH_H
+#define GNSS_SDR_SYCL_GRID_SEARCH_H
+
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+//! Result of a device-side grid search, mirrors the fields of Acq_Offload_Reply
+struct Sycl_Acq_Result
+{
+    uint32_t delay_index;  //!< sample index of the grid maximum
+    int32_t doppler_hz;    //!< Doppler of the grid maximum [Hz]
+    float test_statistic;  //!< peak to input power ratio over the grid
+    float input_power;
+    float peak_magnitude;
+};
+
+
+/*!
+ * \brief Evaluates a PCPS delay-Doppler search grid on a SYCL device.
+ *
+ * Per Doppler bin: carrier wipe-off, forward FFT, multiplication with the
+ * (conjugated) local code spectrum, backward FFT and a squared-magnitude
+ * reduction, all without leaving device memory. The FFTs run through the
+ * oneMKL DFT interface. The SYCL and MKL headers stay behind an opaque
+ * implementation so that including files do not need the SYCL compiler.
+ */
+class Sycl_Grid_Search
+{
+public:
+    //! Throws std::runtime_error if no SYCL device is available or the FFT plan fails
+    explicit Sycl_Grid_Search(uint32_t fft_size);
+    ~Sycl_Grid_Search();
+
+    /*!
+     * Runs the full grid search. \a fft_codes holds the conjugated FFT of the
+     * local code replica, exactly as fed to the CPU convolution. Returns false
+     * if the device rejected the work, leaving \a result untouched.
+     */
+    bool grid_search(const std::complex<float>* in,
+        const std::complex<float>* fft_codes,
+        int64_t fs,
+        int32_t doppler_min,
+        int32_t doppler_step,
+        uint32_t num_doppler_bins,
+        Sycl_Acq_Result* result);
+
+    //! Name of the selected SYCL device, for logging
+    std::string device_name() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> d_impl;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SYCL_GRID_SEARCH_H
@@ -23,6 +23,7 @@
 #include "telemetry_decoder_interface.h"
 #include "tracking_interface.h"
 #include <glog/logging.h>
+#include <sstream>  // for std::stringstream
 #include <utility>  // for std::move
 
 
@@ -87,6 +88,10 @@ Channel::Channel(const ConfigurationInterface* configuration,
 
     acq_->set_threshold(threshold);
 
+    // published acquisition parameters, available for runtime get/set
+    acq_parameters_["doppler_step"] = static_cast<double>(doppler_step);
+    acq_parameters_["threshold"] = static_cast<double>(threshold);
+
     acq_->init();
 
     repeat_ = configuration->property("Acquisition_" + signal_str + std::to_string(channel_) + ".repeat_satellite", false);
@@ -103,6 +108,27 @@ Channel::Channel(const ConfigurationInterface* configuration,
     gnss_signal_ = Gnss_Signal(signal_str);
 
     channel_msg_rx_ = channel_msg_receiver_make_cc(channel_fsm_, repeat_);
+
+    // Optional comma-separated list of CPU cores the tracking threads of all
+    // channels are pinned to, so they share caches instead of migrating
+    // across cores (e.g. GNSS-SDR.tracking_core_affinity=0,1)
+    const std::string affinity_str = configuration->property("GNSS-SDR.tracking_core_affinity", std::string(""));
+    if (!affinity_str.empty())
+        {
+            std::stringstream ss(affinity_str);
+            std::string core;
+            while (std::getline(ss, core, ','))
+                {
+                    try
+                        {
+                            tracking_core_affinity_.push_back(std::stoi(core));
+                        }
+                    catch (const std::exception& e)
+                        {
+                            LOG(WARNING) << "Ignoring malformed GNSS-SDR.tracking_core_affinity entry " << core;
+                        }
+                }
+        }
 }
 
 
@@ -129,6 +155,16 @@ void Channel::connect(gr::top_block_sptr top_block)
         }
     top_block->msg_connect(trk_->get_right_block(), pmt::mp("events"), channel_msg_rx_, pmt::mp("events"));
 
+    if (!tracking_core_affinity_.empty())
+        {
+            auto trk_block = std::dynamic_pointer_cast<gr::block>(trk_->get_right_block());
+            if (trk_block)
+                {
+                    trk_block->set_processor_affinity(tracking_core_affinity_);
+                    DLOG(INFO) << "Channel " << channel_ << " tracking pinned to " << tracking_core_affinity_.size() << " core(s)";
+                }
+        }
+
     connected_ = true;
 }
 
@@ -224,6 +260,7 @@ void Channel::stop_channel()
             LOG(WARNING) << "Invalid channel event";
             return;
         }
+    LOG(INFO) << channel_fsm_->get_dwell_time_report();
     DLOG(INFO) << "Channel stop_channel()";
 }
 
@@ -234,6 +271,65 @@ void Channel::assist_acquisition_doppler(double Carrier_Doppler_hz)
 }
 
 
+bool Channel::set_runtime_parameter(const std::string& name, double value)
+{
+    std::lock_guard<std::mutex> lk(mx_);
+    // tracking loop parameters are handled by the tracking block itself
+    if (trk_->set_runtime_parameter(name, value))
+        {
+            return true;
+        }
+    if (name == "threshold")
+        {
+            acq_->set_threshold(static_cast<float>(value));
+        }
+    else if (name == "doppler_max")
+        {
+            acq_->set_doppler_max(static_cast<unsigned int>(value));
+        }
+    else if (name == "doppler_step")
+        {
+            acq_->set_doppler_step(static_cast<unsigned int>(value));
+        }
+    else if (name == "doppler_center")
+        {
+            acq_->set_doppler_center(static_cast<int>(value));
+        }
+    else if (name == "acq_diag_arm")
+        {
+            // arms the diagnostic export for the next <value> attempts; not
+            // stored, it is a one-shot command rather than a parameter
+            acq_->arm_diagnostics(static_cast<unsigned int>(value));
+            LOG(INFO) << "Channel " << channel_ << ": acquisition diagnostics armed for " << static_cast<unsigned int>(value) << " attempts";
+            return true;
+        }
+    else
+        {
+            return false;
+        }
+    acq_parameters_[name] = value;
+    LOG(INFO) << "Channel " << channel_ << ": runtime update " << name << "=" << value;
+    return true;
+}
+
+
+bool Channel::get_runtime_parameter(const std::string& name, double* value)
+{
+    std::lock_guard<std::mutex> lk(mx_);
+    if (trk_->get_runtime_parameter(name, value))
+        {
+            return true;
+        }
+    const auto it = acq_parameters_.find(name);
+    if (it == acq_parameters_.cend())
+        {
+            return false;
+        }
+    *value = it->second;
+    return true;
+}
+
+
 void Channel::start_acquisition()
 {
     std::lock_guard<std::mutex> lk(mx_);
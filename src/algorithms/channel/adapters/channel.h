@@ -31,9 +31,11 @@
 #include <pmt/pmt.h>
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 /** \addtogroup Channel
  * Classes containing a GNSS channel.
@@ -91,6 +93,18 @@ public:
 
     void assist_acquisition_doppler(double Carrier_Doppler_hz) override;
 
+    /*!
+     * \brief Updates a published acquisition or tracking parameter while the
+     * receiver is running. Returns false if the parameter is not published
+     */
+    bool set_runtime_parameter(const std::string& name, double value) override;
+
+    /*!
+     * \brief Gets the current value of a published acquisition or tracking
+     * parameter. Returns false if the parameter is not published
+     */
+    bool get_runtime_parameter(const std::string& name, double* value) override;
+
     inline std::shared_ptr<AcquisitionInterface> acquisition() const { return acq_; }
     inline std::shared_ptr<TrackingInterface> tracking() const { return trk_; }
     inline std::shared_ptr<TelemetryDecoderInterface> telemetry() const { return nav_; }
@@ -103,6 +117,8 @@ private:
     channel_msg_receiver_cc_sptr channel_msg_rx_;
     Gnss_Synchro gnss_synchro_{};
     Gnss_Signal gnss_signal_;
+    std::vector<int> tracking_core_affinity_;
+    std::map<std::string, double> acq_parameters_;
     std::string role_;
     std::mutex mx_;
     uint32_t channel_;
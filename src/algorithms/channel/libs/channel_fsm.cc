@@ -18,7 +18,9 @@
 
 #include "channel_fsm.h"
 #include "channel_event.h"
+#include "trace_writer.h"
 #include <glog/logging.h>
+#include <sstream>
 #include <utility>
 
 ChannelFsm::ChannelFsm()
@@ -28,6 +30,7 @@ ChannelFsm::ChannelFsm()
     channel_ = 0U;
     state_ = 0U;
     queue_ = nullptr;
+    state_entry_time_ = std::chrono::steady_clock::now();
 }
 
 
@@ -37,6 +40,7 @@ ChannelFsm::ChannelFsm(std::shared_ptr<AcquisitionInterface> acquisition) : acq_
     channel_ = 0U;
     state_ = 0U;
     queue_ = nullptr;
+    state_entry_time_ = std::chrono::steady_clock::now();
 }
 
 
@@ -49,11 +53,11 @@ bool ChannelFsm::Event_stop_channel()
         case 0:  // already in stanby
             break;
         case 1:  // acquisition
-            state_ = 0;
+            enter_state(0);
             stop_acquisition();
             break;
         case 2:  // tracking
-            state_ = 0;
+            enter_state(0);
             stop_tracking();
             break;
         default:
@@ -70,7 +74,7 @@ bool ChannelFsm::Event_start_acquisition_fpga()
         {
             return false;
         }
-    state_ = 1;
+    enter_state(1);
     DLOG(INFO) << "CH = " << channel_ << ". Ev start acquisition FPGA";
     return true;
 }
@@ -83,7 +87,7 @@ bool ChannelFsm::Event_start_acquisition()
         {
             return false;
         }
-    state_ = 1;
+    enter_state(1);
     start_acquisition();
     DLOG(INFO) << "CH = " << channel_ << ". Ev start acquisition";
     return true;
@@ -97,9 +101,11 @@ bool ChannelFsm::Event_valid_acquisition()
         {
             return false;
         }
-    state_ = 2;
+    last_turnaround_ = std::chrono::steady_clock::now() - state_entry_time_;
+    enter_state(2);
     start_tracking();
-    DLOG(INFO) << "CH = " << channel_ << ". Ev valid acquisition";
+    DLOG(INFO) << "CH = " << channel_ << ". Ev valid acquisition. Channel turnaround (acquisition start to tracking start) took "
+               << std::chrono::duration_cast<std::chrono::microseconds>(last_turnaround_).count() << " us";
     return true;
 }
 
@@ -111,7 +117,7 @@ bool ChannelFsm::Event_failed_acquisition_repeat()
         {
             return false;
         }
-    state_ = 1;
+    enter_state(1);
     start_acquisition();
     DLOG(INFO) << "CH = " << channel_ << ". Ev failed acquisition repeat";
     return true;
@@ -125,7 +131,7 @@ bool ChannelFsm::Event_failed_acquisition_no_repeat()
         {
             return false;
         }
-    state_ = 3;
+    enter_state(3);
     request_satellite();
     DLOG(INFO) << "CH = " << channel_ << ". Ev failed acquisition no repeat";
     return true;
@@ -139,7 +145,7 @@ bool ChannelFsm::Event_failed_tracking_standby()
         {
             return false;
         }
-    state_ = 0U;
+    enter_state(0);
     notify_stop_tracking();
     DLOG(INFO) << "CH = " << channel_ << ". Ev failed tracking standby";
     return true;
@@ -217,3 +223,39 @@ void ChannelFsm::notify_stop_tracking()
 {
     queue_->push(pmt::make_any(channel_event_make(channel_, 2)));
 }
+
+
+void ChannelFsm::enter_state(uint32_t new_state)
+{
+    const auto now = std::chrono::steady_clock::now();
+    state_dwell_time_[state_] += now - state_entry_time_;
+    state_entry_time_ = now;
+    state_ = new_state;
+    state_entries_[new_state]++;
+    if (Trace_Writer::enabled())
+        {
+            static const std::array<std::string, 4> state_names = {"standby", "acquisition", "tracking", "waiting"};
+            Trace_Writer::instant_event("channel_fsm", state_names[new_state], channel_, 0ULL);
+        }
+}
+
+
+std::string ChannelFsm::get_dwell_time_report()
+{
+    std::lock_guard<std::mutex> lk(mx_);
+    const auto now = std::chrono::steady_clock::now();
+    auto dwell = state_dwell_time_;
+    dwell[state_] += now - state_entry_time_;
+    const auto ms = [](std::chrono::steady_clock::duration d) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+    };
+    std::ostringstream report;
+    report << "CH " << channel_
+           << " dwell times [ms]: standby=" << ms(dwell[0]) << " (x" << state_entries_[0] << ")"
+           << " acquisition=" << ms(dwell[1]) << " (x" << state_entries_[1] << ")"
+           << " tracking=" << ms(dwell[2]) << " (x" << state_entries_[2] << ")"
+           << " waiting=" << ms(dwell[3]) << " (x" << state_entries_[3] << ")"
+           << ", last channel turnaround (acquisition start to tracking start): "
+           << std::chrono::duration_cast<std::chrono::microseconds>(last_turnaround_).count() << " us";
+    return report.str();
+}
@@ -24,9 +24,12 @@
 #include "telemetry_decoder_interface.h"
 #include "tracking_interface.h"
 #include <pmt/pmt.h>
+#include <array>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <string>
 
 /** \addtogroup Channel
  * \{ */
@@ -61,12 +64,23 @@ public:
     virtual bool Event_failed_acquisition_repeat();
     virtual bool Event_failed_acquisition_no_repeat();
 
+    /*!
+     * \brief Returns a one-line report with the accumulated dwell time per
+     * state, the number of entries into each state, and the duration of the
+     * last channel turnaround (acquisition start to tracking start)
+     */
+    std::string get_dwell_time_report();
+
 private:
+    // States: 0 standby, 1 acquisition, 2 tracking, 3 waiting for satellite
+    static const uint32_t NUM_STATES = 4;
+
     void start_tracking();
     void stop_acquisition();
     void stop_tracking();
     void request_satellite();
     void notify_stop_tracking();
+    void enter_state(uint32_t new_state);  // updates the dwell-time accounting; caller holds mx_
 
     std::shared_ptr<AcquisitionInterface> acq_;
     std::shared_ptr<TrackingInterface> trk_;
@@ -76,6 +90,11 @@ private:
 
     Concurrent_Queue<pmt::pmt_t>* queue_;
 
+    std::array<std::chrono::steady_clock::duration, NUM_STATES> state_dwell_time_{};
+    std::array<uint64_t, NUM_STATES> state_entries_{};
+    std::chrono::steady_clock::time_point state_entry_time_;
+    std::chrono::steady_clock::duration last_turnaround_{};
+
     uint32_t channel_;
     uint32_t state_;
 };
@@ -24,15 +24,56 @@
 SignalConditioner::SignalConditioner(std::shared_ptr<GNSSBlockInterface> data_type_adapt,
     std::shared_ptr<GNSSBlockInterface> in_filt,
     std::shared_ptr<GNSSBlockInterface> res,
-    std::string role) : data_type_adapt_(std::move(data_type_adapt)),
-                        in_filt_(std::move(in_filt)),
-                        res_(std::move(res)),
-                        role_(std::move(role))
+    std::string role,
+    gr::basic_block_sptr stats_probe,
+    gr::basic_block_sptr shm_publisher) : data_type_adapt_(std::move(data_type_adapt)),
+                                          in_filt_(std::move(in_filt)),
+                                          res_(std::move(res)),
+                                          stats_probe_(std::move(stats_probe)),
+                                          shm_publisher_(std::move(shm_publisher)),
+                                          role_(std::move(role))
 {
+    // identity stages (Pass_Through) just copy the buffer at the ingest
+    // rate, so they are spliced out of the graph instead of connected
+    bypass_data_type_adapt_ = (data_type_adapt_->implementation() == "Pass_Through");
+    bypass_in_filt_ = (in_filt_->implementation() == "Pass_Through");
+    bypass_res_ = (res_->implementation() == "Pass_Through");
+    if (bypass_data_type_adapt_ and bypass_in_filt_ and bypass_res_ and !stats_probe_ and !shm_publisher_)
+        {
+            // the conditioner must expose at least one block to its neighbors
+            bypass_res_ = false;
+        }
     connected_ = false;
 }
 
 
+std::vector<std::pair<gr::basic_block_sptr, gr::basic_block_sptr>> SignalConditioner::active_endpoints()
+{
+    std::vector<std::pair<gr::basic_block_sptr, gr::basic_block_sptr>> endpoints;
+    if (!bypass_data_type_adapt_)
+        {
+            endpoints.emplace_back(data_type_adapt_->get_left_block(), data_type_adapt_->get_right_block());
+        }
+    if (stats_probe_)
+        {
+            endpoints.emplace_back(stats_probe_, stats_probe_);
+        }
+    if (!bypass_in_filt_)
+        {
+            endpoints.emplace_back(in_filt_->get_left_block(), in_filt_->get_right_block());
+        }
+    if (!bypass_res_)
+        {
+            endpoints.emplace_back(res_->get_left_block(), res_->get_right_block());
+        }
+    if (shm_publisher_)
+        {
+            endpoints.emplace_back(shm_publisher_, shm_publisher_);
+        }
+    return endpoints;
+}
+
+
 void SignalConditioner::connect(gr::top_block_sptr top_block)
 {
     if (connected_)
@@ -40,15 +81,36 @@ void SignalConditioner::connect(gr::top_block_sptr top_block)
             LOG(WARNING) << "Signal conditioner already connected internally";
             return;
         }
-    data_type_adapt_->connect(top_block);
-    in_filt_->connect(top_block);
-    res_->connect(top_block);
-
-    top_block->connect(data_type_adapt_->get_right_block(), 0, in_filt_->get_left_block(), 0);
-    DLOG(INFO) << "data_type_adapter -> input_filter";
+    if (bypass_data_type_adapt_)
+        {
+            LOG(INFO) << "Splicing " << data_type_adapt_->role() << " (Pass_Through) out of the graph";
+        }
+    else
+        {
+            data_type_adapt_->connect(top_block);
+        }
+    if (bypass_in_filt_)
+        {
+            LOG(INFO) << "Splicing " << in_filt_->role() << " (Pass_Through) out of the graph";
+        }
+    else
+        {
+            in_filt_->connect(top_block);
+        }
+    if (bypass_res_)
+        {
+            LOG(INFO) << "Splicing " << res_->role() << " (Pass_Through) out of the graph";
+        }
+    else
+        {
+            res_->connect(top_block);
+        }
 
-    top_block->connect(in_filt_->get_right_block(), 0, res_->get_left_block(), 0);
-    DLOG(INFO) << "input_filter -> resampler";
+    const auto endpoints = active_endpoints();
+    for (size_t stage = 1; stage < endpoints.size(); stage++)
+        {
+            top_block->connect(endpoints[stage - 1].second, 0, endpoints[stage].first, 0);
+        }
     connected_ = true;
 }
 
@@ -61,14 +123,24 @@ void SignalConditioner::disconnect(gr::top_block_sptr top_block)
             return;
         }
 
-    top_block->disconnect(data_type_adapt_->get_right_block(), 0,
-        in_filt_->get_left_block(), 0);
-    top_block->disconnect(in_filt_->get_right_block(), 0,
-        res_->get_left_block(), 0);
+    const auto endpoints = active_endpoints();
+    for (size_t stage = 1; stage < endpoints.size(); stage++)
+        {
+            top_block->disconnect(endpoints[stage - 1].second, 0, endpoints[stage].first, 0);
+        }
 
-    data_type_adapt_->disconnect(top_block);
-    in_filt_->disconnect(top_block);
-    res_->disconnect(top_block);
+    if (!bypass_data_type_adapt_)
+        {
+            data_type_adapt_->disconnect(top_block);
+        }
+    if (!bypass_in_filt_)
+        {
+            in_filt_->disconnect(top_block);
+        }
+    if (!bypass_res_)
+        {
+            res_->disconnect(top_block);
+        }
 
     connected_ = false;
 }
@@ -76,11 +148,11 @@ void SignalConditioner::disconnect(gr::top_block_sptr top_block)
 
 gr::basic_block_sptr SignalConditioner::get_left_block()
 {
-    return data_type_adapt_->get_left_block();
+    return active_endpoints().front().first;
 }
 
 
 gr::basic_block_sptr SignalConditioner::get_right_block()
 {
-    return res_->get_right_block();
+    return active_endpoints().back().second;
 }
@@ -23,6 +23,8 @@
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 /** \addtogroup Signal_Conditioner Signal Conditioner
  * Signal Conditioner wrapper block
@@ -39,11 +41,17 @@
 class SignalConditioner : public GNSSBlockInterface
 {
 public:
-    //! Constructor
+    //! Constructor. If stats_probe is not empty, the block is inserted
+    //! between the data type adapter and the input filter, where the
+    //! gr_complex stream is still hot in cache. If shm_publisher is not
+    //! empty, the block is appended after the resampler so that other
+    //! processes receive the fully conditioned stream.
     SignalConditioner(std::shared_ptr<GNSSBlockInterface> data_type_adapt,
         std::shared_ptr<GNSSBlockInterface> in_filt,
         std::shared_ptr<GNSSBlockInterface> res,
-        std::string role);
+        std::string role,
+        gr::basic_block_sptr stats_probe = gr::basic_block_sptr(),
+        gr::basic_block_sptr shm_publisher = gr::basic_block_sptr());
 
     //! Destructor
     ~SignalConditioner() = default;
@@ -64,10 +72,18 @@ public:
     inline std::shared_ptr<GNSSBlockInterface> resampler() { return res_; }
 
 private:
+    //! Left/right endpoints of the stages that stay in the graph, in order
+    std::vector<std::pair<gr::basic_block_sptr, gr::basic_block_sptr>> active_endpoints();
+
     std::shared_ptr<GNSSBlockInterface> data_type_adapt_;
     std::shared_ptr<GNSSBlockInterface> in_filt_;
     std::shared_ptr<GNSSBlockInterface> res_;
+    gr::basic_block_sptr stats_probe_;
+    gr::basic_block_sptr shm_publisher_;
     std::string role_;
+    bool bypass_data_type_adapt_;
+    bool bypass_in_filt_;
+    bool bypass_res_;
     bool connected_;
 };
 
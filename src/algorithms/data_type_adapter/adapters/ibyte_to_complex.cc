@@ -33,16 +33,30 @@ IbyteToComplex::IbyteToComplex(const ConfigurationInterface* configuration, cons
     dump_ = configuration->property(role_ + ".dump", false);
     dump_filename_ = configuration->property(role_ + ".dump_filename", default_dump_filename);
     inverted_spectrum = configuration->property(role + ".inverted_spectrum", false);
+    // scaling, DC-offset removal (and the spectrum inversion, if requested)
+    // fused into the conversion pass instead of one full-rate block each
+    const float scale = configuration->property(role + ".scale", 1.0F);
+    const bool remove_dc = configuration->property(role + ".remove_dc", false);
+    const float dc_alpha = configuration->property(role + ".dc_alpha", 0.01F);
+    fused_ = (scale != 1.0F) or remove_dc;
 
     const size_t item_size = sizeof(gr_complex);
 
-    gr_interleaved_char_to_complex_ = gr::blocks::interleaved_char_to_complex::make();
+    if (fused_)
+        {
+            fused_converter_ = make_interleaved_byte_to_complex_fused(scale, remove_dc, dc_alpha, inverted_spectrum);
+            DLOG(INFO) << "data_type_adapter_(" << fused_converter_->unique_id() << ")";
+        }
+    else
+        {
+            gr_interleaved_char_to_complex_ = gr::blocks::interleaved_char_to_complex::make();
 
-    DLOG(INFO) << "data_type_adapter_(" << gr_interleaved_char_to_complex_->unique_id() << ")";
+            DLOG(INFO) << "data_type_adapter_(" << gr_interleaved_char_to_complex_->unique_id() << ")";
 
-    if (inverted_spectrum)
-        {
-            conjugate_cc_ = make_conjugate_cc();
+            if (inverted_spectrum)
+                {
+                    conjugate_cc_ = make_conjugate_cc();
+                }
         }
     if (dump_)
         {
@@ -62,6 +76,18 @@ IbyteToComplex::IbyteToComplex(const ConfigurationInterface* configuration, cons
 
 void IbyteToComplex::connect(gr::top_block_sptr top_block)
 {
+    if (fused_)
+        {
+            if (dump_)
+                {
+                    top_block->connect(fused_converter_, 0, file_sink_, 0);
+                }
+            else
+                {
+                    DLOG(INFO) << "Nothing to connect internally";
+                }
+            return;
+        }
     if (dump_)
         {
             if (inverted_spectrum)
@@ -90,6 +116,14 @@ void IbyteToComplex::connect(gr::top_block_sptr top_block)
 
 void IbyteToComplex::disconnect(gr::top_block_sptr top_block)
 {
+    if (fused_)
+        {
+            if (dump_)
+                {
+                    top_block->disconnect(fused_converter_, 0, file_sink_, 0);
+                }
+            return;
+        }
     if (dump_)
         {
             if (inverted_spectrum)
@@ -114,12 +148,20 @@ void IbyteToComplex::disconnect(gr::top_block_sptr top_block)
 
 gr::basic_block_sptr IbyteToComplex::get_left_block()
 {
+    if (fused_)
+        {
+            return fused_converter_;
+        }
     return gr_interleaved_char_to_complex_;
 }
 
 
 gr::basic_block_sptr IbyteToComplex::get_right_block()
 {
+    if (fused_)
+        {
+            return fused_converter_;
+        }
     if (inverted_spectrum)
         {
             return conjugate_cc_;
@@ -19,6 +19,7 @@
 
 #include "conjugate_cc.h"
 #include "gnss_block_interface.h"
+#include "interleaved_short_to_complex_fused.h"
 #include <gnuradio/blocks/file_sink.h>
 #include <gnuradio/blocks/interleaved_short_to_complex.h>
 #include <cstdint>
@@ -68,6 +69,7 @@ public:
 
 private:
     gr::blocks::interleaved_short_to_complex::sptr gr_interleaved_short_to_complex_;
+    interleaved_short_to_complex_fused_sptr fused_converter_;
     conjugate_cc_sptr conjugate_cc_;
     gr::blocks::file_sink::sptr file_sink_;
     std::string dump_filename_;
@@ -77,6 +79,7 @@ private:
     unsigned int in_streams_;
     unsigned int out_streams_;
     bool inverted_spectrum;
+    bool fused_;
     bool dump_;
 };
 
@@ -0,0 +1,94 @@
+/*!
+ * \file interleaved_byte_to_complex_fused.cc
+ * \brief Adapts a byte (8-bits) interleaved sample stream into a
+ *        gr_complex stream, applying gain, DC-offset removal and optional
+ *        spectrum inversion in the same pass
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#include "interleaved_byte_to_complex_fused.h"
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>  // for max
+
+
+interleaved_byte_to_complex_fused_sptr make_interleaved_byte_to_complex_fused(
+    float scale, bool remove_dc, float dc_alpha, bool invert_spectrum)
+{
+    return interleaved_byte_to_complex_fused_sptr(new interleaved_byte_to_complex_fused(scale, remove_dc, dc_alpha, invert_spectrum));
+}
+
+
+interleaved_byte_to_complex_fused::interleaved_byte_to_complex_fused(
+    float scale,
+    bool remove_dc,
+    float dc_alpha,
+    bool invert_spectrum) : sync_decimator("interleaved_byte_to_complex_fused",
+                                gr::io_signature::make(1, 1, sizeof(int8_t)),
+                                gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                                2),
+                            d_dc(0.0, 0.0),
+                            d_scale(scale),
+                            d_dc_alpha(dc_alpha),
+                            d_remove_dc(remove_dc),
+                            d_invert_spectrum(invert_spectrum)
+{
+    const auto alignment_multiple = static_cast<int>(volk_get_alignment() / sizeof(gr_complex));
+    set_alignment(std::max(1, alignment_multiple));
+}
+
+
+int interleaved_byte_to_complex_fused::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    const auto *in = reinterpret_cast<const int8_t *>(input_items[0]);
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
+
+    // the VOLK kernel divides by its scalar, so the gain goes inverted
+    volk_8i_s32f_convert_32f(reinterpret_cast<float *>(out), in, 1.0F / d_scale, 2 * noutput_items);
+
+    if (d_remove_dc)
+        {
+            // accumulate the block mean and subtract the running estimate
+            // while the samples are still hot in cache
+            gr_complex acc(0.0, 0.0);
+            if (d_invert_spectrum)
+                {
+                    for (int number = 0; number < noutput_items; number++)
+                        {
+                            const gr_complex sample = std::conj(out[number]);
+                            acc += sample;
+                            out[number] = sample - d_dc;
+                        }
+                }
+            else
+                {
+                    for (int number = 0; number < noutput_items; number++)
+                        {
+                            acc += out[number];
+                            out[number] -= d_dc;
+                        }
+                }
+            d_dc += d_dc_alpha * (acc / static_cast<float>(noutput_items) - d_dc);
+        }
+    else if (d_invert_spectrum)
+        {
+            for (int number = 0; number < noutput_items; number++)
+                {
+                    out[number] = std::conj(out[number]);
+                }
+        }
+    return noutput_items;
+}
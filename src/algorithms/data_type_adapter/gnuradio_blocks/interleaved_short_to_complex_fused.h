@@ -0,0 +1,74 @@
+/*!
+ * \file interleaved_short_to_complex_fused.h
+ * \brief Adapts a short (16-bits) interleaved sample stream into a
+ *        gr_complex stream, applying gain, DC-offset removal and optional
+ *        spectrum inversion in the same pass
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_INTERLEAVED_SHORT_TO_COMPLEX_FUSED_H
+#define GNSS_SDR_INTERLEAVED_SHORT_TO_COMPLEX_FUSED_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/sync_decimator.h>
+
+/** \addtogroup Data_Type
+ * \{ */
+/** \addtogroup Data_type_gnuradio_blocks
+ * \{ */
+
+
+class interleaved_short_to_complex_fused;
+
+using interleaved_short_to_complex_fused_sptr = gnss_shared_ptr<interleaved_short_to_complex_fused>;
+
+interleaved_short_to_complex_fused_sptr make_interleaved_short_to_complex_fused(
+    float scale,
+    bool remove_dc,
+    float dc_alpha,
+    bool invert_spectrum);
+
+/*!
+ * \brief This class adapts a short (16-bits) interleaved sample stream
+ * into a gr_complex stream, fusing the scaling, the running DC-offset
+ * removal and the spectrum inversion that would otherwise need one
+ * full-rate pass each into the conversion pass.
+ *
+ * The DC offset is tracked with a single-pole IIR fed by the mean of
+ * every work() call: dc += dc_alpha * (mean - dc).
+ */
+class interleaved_short_to_complex_fused : public gr::sync_decimator
+{
+public:
+    ~interleaved_short_to_complex_fused() = default;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend interleaved_short_to_complex_fused_sptr make_interleaved_short_to_complex_fused(float scale, bool remove_dc, float dc_alpha, bool invert_spectrum);
+    interleaved_short_to_complex_fused(float scale, bool remove_dc, float dc_alpha, bool invert_spectrum);
+
+    gr_complex d_dc;
+    float d_scale;
+    float d_dc_alpha;
+    bool d_remove_dc;
+    bool d_invert_spectrum;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_INTERLEAVED_SHORT_TO_COMPLEX_FUSED_H
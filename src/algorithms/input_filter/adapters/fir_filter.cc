@@ -32,8 +32,19 @@ FirFilter::FirFilter(const ConfigurationInterface* configuration, std::string ro
     if ((taps_item_type_ == "float") && (input_item_type_ == "gr_complex") && (output_item_type_ == "gr_complex"))
         {
             item_size_ = sizeof(gr_complex);
-            fir_filter_ccf_ = gr::filter::fir_filter_ccf::make(1, taps_);
-            DLOG(INFO) << "input_filter(" << fir_filter_ccf_->unique_id() << ")";
+            if (decimation_factor_ > 1)
+                {
+                    // decimating filter with unrolled kernels for the common
+                    // tap counts; the GNU Radio filter stays in charge of the
+                    // non-decimating case
+                    fir_filter_decim_cc_ = make_fir_filter_decim_cc(decimation_factor_, taps_);
+                    DLOG(INFO) << "input_filter(" << fir_filter_decim_cc_->unique_id() << ")";
+                }
+            else
+                {
+                    fir_filter_ccf_ = gr::filter::fir_filter_ccf::make(1, taps_);
+                    DLOG(INFO) << "input_filter(" << fir_filter_ccf_->unique_id() << ")";
+                }
             if (dump_)
                 {
                     DLOG(INFO) << "Dumping output into file " << dump_filename_;
@@ -148,6 +159,7 @@ void FirFilter::init()
     taps_item_type_ = config_->property(role_ + ".taps_item_type", default_taps_item_type);
     dump_ = config_->property(role_ + ".dump", false);
     dump_filename_ = config_->property(role_ + ".dump_filename", default_dump_filename);
+    decimation_factor_ = config_->property(role_ + ".decimation_factor", 1);
     const int number_of_taps = config_->property(role_ + ".number_of_taps", default_number_of_taps);
     const unsigned int number_of_bands = config_->property(role_ + ".number_of_bands", default_number_of_bands);
 
@@ -201,7 +213,14 @@ void FirFilter::connect(gr::top_block_sptr top_block)
         {
             if (dump_)
                 {
-                    top_block->connect(fir_filter_ccf_, 0, file_sink_, 0);
+                    if (decimation_factor_ > 1)
+                        {
+                            top_block->connect(fir_filter_decim_cc_, 0, file_sink_, 0);
+                        }
+                    else
+                        {
+                            top_block->connect(fir_filter_ccf_, 0, file_sink_, 0);
+                        }
                 }
             else
                 {
@@ -269,7 +288,14 @@ void FirFilter::disconnect(gr::top_block_sptr top_block)
         {
             if (dump_)
                 {
-                    top_block->disconnect(fir_filter_ccf_, 0, file_sink_, 0);
+                    if (decimation_factor_ > 1)
+                        {
+                            top_block->disconnect(fir_filter_decim_cc_, 0, file_sink_, 0);
+                        }
+                    else
+                        {
+                            top_block->disconnect(fir_filter_ccf_, 0, file_sink_, 0);
+                        }
                 }
         }
     else if ((taps_item_type_ == "float") && (input_item_type_ == "cbyte") && (output_item_type_ == "gr_complex"))
@@ -331,6 +357,10 @@ gr::basic_block_sptr FirFilter::get_left_block()
 {
     if ((taps_item_type_ == "float") && (input_item_type_ == "gr_complex") && (output_item_type_ == "gr_complex"))
         {
+            if (decimation_factor_ > 1)
+                {
+                    return fir_filter_decim_cc_;
+                }
             return fir_filter_ccf_;
         }
     if ((taps_item_type_ == "float") && (input_item_type_ == "cshort") && (output_item_type_ == "cshort"))
@@ -358,6 +388,10 @@ gr::basic_block_sptr FirFilter::get_right_block()
 {
     if ((taps_item_type_ == "float") && (input_item_type_ == "gr_complex") && (output_item_type_ == "gr_complex"))
         {
+            if (decimation_factor_ > 1)
+                {
+                    return fir_filter_decim_cc_;
+                }
             return fir_filter_ccf_;
         }
     if ((taps_item_type_ == "float") && (input_item_type_ == "cshort") && (output_item_type_ == "cshort"))
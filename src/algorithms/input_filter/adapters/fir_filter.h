@@ -21,6 +21,7 @@
 #include "byte_x2_to_complex_byte.h"
 #include "complex_byte_to_float_x2.h"
 #include "cshort_to_float_x2.h"
+#include "fir_filter_decim_cc.h"
 #include "gnss_block_interface.h"
 #include "short_x2_to_cshort.h"
 #include <gnuradio/blocks/file_sink.h>
@@ -93,6 +94,7 @@ private:
     void init();
 
     gr::filter::fir_filter_ccf::sptr fir_filter_ccf_;
+    fir_filter_decim_cc_sptr fir_filter_decim_cc_;
     gr::filter::fir_filter_fff::sptr fir_filter_fff_1_;
     gr::filter::fir_filter_fff::sptr fir_filter_fff_2_;
     gr::blocks::float_to_complex::sptr float_to_complex_;
@@ -113,6 +115,7 @@ private:
     std::string taps_item_type_;
     std::string role_;
     size_t item_size_;
+    int decimation_factor_;
     unsigned int in_streams_;
     unsigned int out_streams_;
     bool dump_;
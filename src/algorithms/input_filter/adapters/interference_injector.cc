@@ -0,0 +1,104 @@
+/*!
+ * \file interference_injector.cc
+ * \brief Adapts a scripted interference injection stage
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "interference_injector.h"
+#include "configuration_interface.h"
+#include "interference_injector_cc.h"
+#include <glog/logging.h>
+
+
+InterferenceInjectorFilter::InterferenceInjectorFilter(const ConfigurationInterface* configuration, const std::string& role,
+    unsigned int in_streams, unsigned int out_streams) : role_(role), in_streams_(in_streams), out_streams_(out_streams)
+{
+    const std::string default_item_type("gr_complex");
+    const std::string default_dump_file("./data/input_filter.dat");
+    const std::string default_timeline_file("./interference_timeline.txt");
+    item_type_ = configuration->property(role + ".item_type", default_item_type);
+    dump_ = configuration->property(role + ".dump", false);
+    DLOG(INFO) << "dump_ is " << dump_;
+    dump_filename_ = configuration->property(role + ".dump_filename", default_dump_file);
+    const std::string timeline_filename = configuration->property(role + ".timeline_filename", default_timeline_file);
+    // the event timestamps refer to the sampling rate seen by this stage
+    const auto default_fs = configuration->property("GNSS-SDR.internal_fs_sps", static_cast<int64_t>(0));
+    const auto sampling_frequency = configuration->property(role + ".sampling_frequency", default_fs);
+    if (sampling_frequency <= 0)
+        {
+            LOG(ERROR) << "Interference injector requires " << role
+                       << ".sampling_frequency or GNSS-SDR.internal_fs_sps to be set";
+        }
+    if (item_type_ == "gr_complex")
+        {
+            item_size_ = sizeof(gr_complex);
+            interference_injector_ = make_interference_injector(static_cast<double>(sampling_frequency), timeline_filename);
+            DLOG(INFO) << "Item size " << item_size_;
+            DLOG(INFO) << "input filter(" << interference_injector_->unique_id() << ")";
+        }
+    else
+        {
+            LOG(WARNING) << item_type_ << " unrecognized item type for interference injector";
+            item_size_ = sizeof(gr_complex);
+        }
+    if (dump_)
+        {
+            DLOG(INFO) << "Dumping output into file " << dump_filename_;
+            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+            DLOG(INFO) << "file_sink(" << file_sink_->unique_id() << ")";
+        }
+    if (in_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one input stream";
+        }
+    if (out_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+void InterferenceInjectorFilter::connect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->connect(interference_injector_, 0, file_sink_, 0);
+            DLOG(INFO) << "connected interference injector output to file sink";
+        }
+    else
+        {
+            DLOG(INFO) << "nothing to connect internally";
+        }
+}
+
+
+void InterferenceInjectorFilter::disconnect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->disconnect(interference_injector_, 0, file_sink_, 0);
+        }
+}
+
+
+gr::basic_block_sptr InterferenceInjectorFilter::get_left_block()
+{
+    return interference_injector_;
+}
+
+
+gr::basic_block_sptr InterferenceInjectorFilter::get_right_block()
+{
+    return interference_injector_;
+}
@@ -0,0 +1,84 @@
+/*!
+ * \file interference_injector.h
+ * \brief Adapts a scripted interference injection stage
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_INTERFERENCE_INJECTOR_H
+#define GNSS_SDR_INTERFERENCE_INJECTOR_H
+
+#include "gnss_block_interface.h"
+#include "interference_injector_cc.h"
+#include <gnuradio/blocks/file_sink.h>
+#include <string>
+
+/** \addtogroup Input_Filter
+ * \{ */
+/** \addtogroup Input_filter_adapters
+ * \{ */
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Mixes scripted interference (CW/chirp/pulse jammers, power steps
+ * and phase jumps) into the stream, for reproducible stress campaigns on
+ * file replays. The event timeline is read from <role>.timeline_filename
+ */
+class InterferenceInjectorFilter : public GNSSBlockInterface
+{
+public:
+    InterferenceInjectorFilter(const ConfigurationInterface* configuration,
+        const std::string& role, unsigned int in_streams,
+        unsigned int out_streams);
+
+    ~InterferenceInjectorFilter() = default;
+
+    std::string role()
+    {
+        return role_;
+    }
+
+    //! Returns "Interference_Injector"
+    std::string implementation()
+    {
+        return "Interference_Injector";
+    }
+
+    size_t item_size()
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block);
+    void disconnect(gr::top_block_sptr top_block);
+    gr::basic_block_sptr get_left_block();
+    gr::basic_block_sptr get_right_block();
+
+private:
+    interference_injector_sptr interference_injector_;
+    gr::blocks::file_sink::sptr file_sink_;
+    std::string dump_filename_;
+    std::string role_;
+    std::string item_type_;
+    size_t item_size_;
+    unsigned int in_streams_;
+    unsigned int out_streams_;
+    bool dump_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_INTERFERENCE_INJECTOR_H
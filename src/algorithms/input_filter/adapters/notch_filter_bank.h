@@ -0,0 +1,79 @@
+/*!
+ * \file notch_filter_bank.h
+ * \brief Adapts a multi-tone notch filter bank
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_NOTCH_FILTER_BANK_H
+#define GNSS_SDR_NOTCH_FILTER_BANK_H
+
+#include "gnss_block_interface.h"
+#include "notch_bank_cc.h"
+#include <gnuradio/blocks/file_sink.h>
+#include <string>
+
+/** \addtogroup Input_Filter
+ * \{ */
+/** \addtogroup Input_filter_adapters
+ * \{ */
+
+
+class ConfigurationInterface;
+
+class NotchFilterBank : public GNSSBlockInterface
+{
+public:
+    NotchFilterBank(const ConfigurationInterface* configuration,
+        const std::string& role, unsigned int in_streams,
+        unsigned int out_streams);
+
+    ~NotchFilterBank() = default;
+
+    std::string role()
+    {
+        return role_;
+    }
+
+    //! Returns "Notch_Filter_Bank"
+    std::string implementation()
+    {
+        return "Notch_Filter_Bank";
+    }
+
+    size_t item_size()
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block);
+    void disconnect(gr::top_block_sptr top_block);
+    gr::basic_block_sptr get_left_block();
+    gr::basic_block_sptr get_right_block();
+
+private:
+    notch_bank_sptr notch_filter_bank_;
+    gr::blocks::file_sink::sptr file_sink_;
+    std::string dump_filename_;
+    std::string role_;
+    std::string item_type_;
+    size_t item_size_;
+    unsigned int in_streams_;
+    unsigned int out_streams_;
+    bool dump_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_NOTCH_FILTER_BANK_H
@@ -49,11 +49,13 @@ PulseBlankingFilter::PulseBlankingFilter(const ConfigurationInterface* configura
     const int n_segments_est = configuration->property(role_ + ".segments_est", default_n_segments_est);
     const int default_n_segments_reset = 5000000;
     const int n_segments_reset = configuration->property(role_ + ".segments_reset", default_n_segments_reset);
+    // 0 disables the periodic blanked-ratio report on the stats message port
+    const int64_t report_interval_samples = configuration->property(role_ + ".report_interval_samples", static_cast<int64_t>(0));
     if (input_item_type_ == "gr_complex")
         {
             item_size = sizeof(gr_complex);    // output
             input_size_ = sizeof(gr_complex);  // input
-            pulse_blanking_cc_ = make_pulse_blanking_cc(pfa, length_, n_segments_est, n_segments_reset);
+            pulse_blanking_cc_ = make_pulse_blanking_cc(pfa, length_, n_segments_est, n_segments_reset, static_cast<uint64_t>(report_interval_samples));
         }
     else
         {
@@ -0,0 +1,112 @@
+/*!
+ * \file spectral_excision_filter.cc
+ * \brief Adapts a frequency-domain interference excisor
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "spectral_excision_filter.h"
+#include "configuration_interface.h"
+#include "spectral_excision_cc.h"
+#include <glog/logging.h>
+
+
+SpectralExcisionFilter::SpectralExcisionFilter(const ConfigurationInterface* configuration, const std::string& role,
+    unsigned int in_streams, unsigned int out_streams) : role_(role), in_streams_(in_streams), out_streams_(out_streams)
+{
+    const int default_fft_length = 512;
+    const float default_threshold_db = 10.0;
+    const float default_smoothing_factor = 0.1;
+    const std::string default_item_type("gr_complex");
+    const std::string default_dump_file("./data/input_filter.dat");
+    item_type_ = configuration->property(role + ".item_type", default_item_type);
+    dump_ = configuration->property(role + ".dump", false);
+    DLOG(INFO) << "dump_ is " << dump_;
+    dump_filename_ = configuration->property(role + ".dump_filename", default_dump_file);
+    int fft_length = configuration->property(role + ".fft_length", default_fft_length);
+    const float threshold_db = configuration->property(role + ".threshold_db", default_threshold_db);
+    const float smoothing_factor = configuration->property(role + ".smoothing_factor", default_smoothing_factor);
+    // the overlap-add segmentation requires an even transform length, and the
+    // FFT is fastest for powers of two
+    int rounded_fft_length = 1;
+    while (rounded_fft_length < fft_length)
+        {
+            rounded_fft_length <<= 1;
+        }
+    if (rounded_fft_length != fft_length)
+        {
+            LOG(WARNING) << "Spectral excision fft_length rounded up to " << rounded_fft_length;
+            fft_length = rounded_fft_length;
+        }
+    if (item_type_ == "gr_complex")
+        {
+            item_size_ = sizeof(gr_complex);
+            spectral_excision_ = make_spectral_excision(fft_length, threshold_db, smoothing_factor);
+            DLOG(INFO) << "Item size " << item_size_;
+            DLOG(INFO) << "input filter(" << spectral_excision_->unique_id() << ")";
+        }
+    else
+        {
+            LOG(WARNING) << item_type_ << " unrecognized item type for spectral excision filter";
+            item_size_ = sizeof(gr_complex);
+        }
+    if (dump_)
+        {
+            DLOG(INFO) << "Dumping output into file " << dump_filename_;
+            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+            DLOG(INFO) << "file_sink(" << file_sink_->unique_id() << ")";
+        }
+    if (in_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one input stream";
+        }
+    if (out_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+void SpectralExcisionFilter::connect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->connect(spectral_excision_, 0, file_sink_, 0);
+            DLOG(INFO) << "connected spectral excision filter output to file sink";
+        }
+    else
+        {
+            DLOG(INFO) << "nothing to connect internally";
+        }
+}
+
+
+void SpectralExcisionFilter::disconnect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->disconnect(spectral_excision_, 0, file_sink_, 0);
+        }
+}
+
+
+gr::basic_block_sptr SpectralExcisionFilter::get_left_block()
+{
+    return spectral_excision_;
+}
+
+
+gr::basic_block_sptr SpectralExcisionFilter::get_right_block()
+{
+    return spectral_excision_;
+}
@@ -0,0 +1,117 @@
+/*!
+ * \file fir_filter_decim_cc.cc
+ * \brief Decimating FIR filter with compile-time specialized tap counts
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ *
+ */
+
+#include "fir_filter_decim_cc.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>  // for max
+#include <stdexcept>
+
+namespace
+{
+// inner loop with a compile-time trip count, so the compiler unrolls and
+// vectorizes it without any runtime tap-count bookkeeping
+template <int32_t NTAPS>
+void fir_filter_fixed_ntaps(gr_complex *out, const gr_complex *in, const float *taps, int noutput_items, int32_t decimation)
+{
+    for (int number = 0; number < noutput_items; number++)
+        {
+            const gr_complex *window = in + static_cast<int64_t>(number) * decimation;
+            float acc_real = 0.0F;
+            float acc_imag = 0.0F;
+            for (int32_t k = 0; k < NTAPS; k++)
+                {
+                    acc_real += taps[k] * window[k].real();
+                    acc_imag += taps[k] * window[k].imag();
+                }
+            out[number] = gr_complex(acc_real, acc_imag);
+        }
+}
+}  // namespace
+
+
+fir_filter_decim_cc_sptr make_fir_filter_decim_cc(int32_t decimation, const std::vector<float> &taps)
+{
+    return fir_filter_decim_cc_sptr(new fir_filter_decim_cc(decimation, taps));
+}
+
+
+fir_filter_decim_cc::fir_filter_decim_cc(int32_t decimation,
+    const std::vector<float> &taps) : sync_decimator("fir_filter_decim_cc",
+                                          gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                                          gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                                          decimation),
+                                      d_ntaps(static_cast<int32_t>(taps.size())),
+                                      d_decimation(decimation)
+{
+    if (decimation < 1)
+        {
+            throw std::invalid_argument("FIR decimation factor must be >= 1");
+        }
+    if (taps.empty())
+        {
+            throw std::invalid_argument("FIR filter needs at least one tap");
+        }
+    const auto alignment_multiple = static_cast<int>(volk_get_alignment() / sizeof(gr_complex));
+    set_alignment(std::max(1, alignment_multiple));
+    set_history(d_ntaps);
+    d_taps.assign(taps.begin(), taps.end());
+
+    switch (d_ntaps)
+        {
+        case 8:
+            d_specialized_filter = fir_filter_fixed_ntaps<8>;
+            break;
+        case 16:
+            d_specialized_filter = fir_filter_fixed_ntaps<16>;
+            break;
+        case 32:
+            d_specialized_filter = fir_filter_fixed_ntaps<32>;
+            break;
+        case 64:
+            d_specialized_filter = fir_filter_fixed_ntaps<64>;
+            break;
+        default:
+            d_specialized_filter = nullptr;
+            break;
+        }
+    DLOG(INFO) << "FIR filter with " << d_ntaps << " taps, decimation " << d_decimation
+               << (d_specialized_filter != nullptr ? " (specialized kernel)" : " (generic kernel)");
+}
+
+
+int fir_filter_decim_cc::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
+
+    if (d_specialized_filter != nullptr)
+        {
+            d_specialized_filter(out, in, d_taps.data(), noutput_items, d_decimation);
+        }
+    else
+        {
+            for (int number = 0; number < noutput_items; number++)
+                {
+                    volk_32fc_32f_dot_prod_32fc(out + number, in + static_cast<int64_t>(number) * d_decimation, d_taps.data(), d_ntaps);
+                }
+        }
+    return noutput_items;
+}
@@ -0,0 +1,76 @@
+/*!
+ * \file fir_filter_decim_cc.h
+ * \brief Decimating FIR filter with compile-time specialized tap counts
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ *
+ */
+
+#ifndef GNSS_SDR_FIR_FILTER_DECIM_CC_H
+#define GNSS_SDR_FIR_FILTER_DECIM_CC_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/sync_decimator.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Input_Filter
+ * \{ */
+/** \addtogroup Input_filter_gnuradio_blocks
+ * \{ */
+
+
+class fir_filter_decim_cc;
+
+using fir_filter_decim_cc_sptr = gnss_shared_ptr<fir_filter_decim_cc>;
+
+fir_filter_decim_cc_sptr make_fir_filter_decim_cc(
+    int32_t decimation,
+    const std::vector<float> &taps);
+
+/*!
+ * \brief This class implements a decimating FIR filter for complex data
+ * with float taps.
+ *
+ * The tap counts of the usual conditioner profiles (8, 16, 32 and 64
+ * taps) are dispatched at construction time to template instantiations
+ * whose inner loop has a compile-time trip count, so the compiler can
+ * fully unroll and vectorize them; any other tap count falls back to the
+ * generic VOLK dot product.
+ */
+class fir_filter_decim_cc : public gr::sync_decimator
+{
+public:
+    ~fir_filter_decim_cc() = default;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend fir_filter_decim_cc_sptr make_fir_filter_decim_cc(int32_t decimation, const std::vector<float> &taps);
+    fir_filter_decim_cc(int32_t decimation, const std::vector<float> &taps);
+
+    using filter_function = void (*)(gr_complex *out, const gr_complex *in, const float *taps, int noutput_items, int32_t decimation);
+
+    volk_gnsssdr::vector<float> d_taps;
+    filter_function d_specialized_filter;  // nullptr selects the generic VOLK path
+    int32_t d_ntaps;
+    int32_t d_decimation;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_FIR_FILTER_DECIM_CC_H
@@ -0,0 +1,279 @@
+/*!
+ * \file interference_injector_cc.cc
+ * \brief Injects scripted interference events into a sample stream
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "interference_injector_cc.h"
+#include "MATH_CONSTANTS.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+// Chirp synthesis keeps the instantaneous frequency piecewise constant over
+// sub-blocks of this many samples, aligned to the event start so the result
+// does not depend on the scheduler's buffer sizes
+namespace
+{
+constexpr uint64_t CHIRP_CHUNK_SAMPLES = 512;
+}
+
+
+interference_injector_sptr make_interference_injector(double sampling_frequency, const std::string &timeline_filename)
+{
+    return interference_injector_sptr(new InterferenceInjector(sampling_frequency, timeline_filename));
+}
+
+
+InterferenceInjector::InterferenceInjector(double sampling_frequency,
+    const std::string &timeline_filename) : gr::sync_block("interference_injector_cc",
+                                                gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                                                gr::io_signature::make(1, 1, sizeof(gr_complex))),
+                                            residual_rotation_(1.0, 0.0),
+                                            sample_counter_(0),
+                                            fs_(sampling_frequency)
+{
+    parse_timeline(timeline_filename);
+}
+
+
+void InterferenceInjector::parse_timeline(const std::string &timeline_filename)
+{
+    std::ifstream timeline(timeline_filename);
+    if (!timeline.is_open())
+        {
+            LOG(WARNING) << "Interference injector could not open timeline file "
+                         << timeline_filename << ", the stage is a pass-through";
+            return;
+        }
+    std::string line;
+    int line_number = 0;
+    while (std::getline(timeline, line))
+        {
+            line_number++;
+            const auto comment = line.find('#');
+            if (comment != std::string::npos)
+                {
+                    line.erase(comment);
+                }
+            std::istringstream fields(line);
+            double start_s = 0.0;
+            double duration_s = 0.0;
+            std::string type;
+            std::string parameters;
+            if (!(fields >> start_s >> duration_s >> type))
+                {
+                    continue;  // blank or comment-only line
+                }
+            fields >> parameters;
+
+            std::map<std::string, double> params;
+            std::stringstream pairs(parameters);
+            std::string pair;
+            while (std::getline(pairs, pair, ','))
+                {
+                    const auto equal = pair.find('=');
+                    if (equal == std::string::npos)
+                        {
+                            continue;
+                        }
+                    try
+                        {
+                            params[pair.substr(0, equal)] = std::stod(pair.substr(equal + 1));
+                        }
+                    catch (const std::exception &)
+                        {
+                            LOG(WARNING) << "Interference injector: invalid parameter '"
+                                         << pair << "' in line " << line_number;
+                        }
+                }
+            const auto param = [&params](const std::string &key, double default_value) {
+                const auto it = params.find(key);
+                return (it != params.end()) ? it->second : default_value;
+            };
+
+            Injection_Event event{};
+            event.start_sample = static_cast<uint64_t>(std::llround(start_s * fs_));
+            event.end_sample = static_cast<uint64_t>(std::llround((start_s + duration_s) * fs_));
+            event.applied = false;
+            if (type == "cw")
+                {
+                    event.type = Event_Type::cw;
+                    event.freq_hz = param("freq_hz", 0.0);
+                    event.amplitude = std::pow(10.0F, static_cast<float>(param("power_dbfs", -20.0)) / 20.0F);
+                }
+            else if (type == "chirp")
+                {
+                    event.type = Event_Type::chirp;
+                    event.freq_hz = param("f0_hz", 0.0);
+                    event.freq_end_hz = param("f1_hz", event.freq_hz);
+                    event.period_s = param("period_s", std::max(duration_s, 1e-3));
+                    event.amplitude = std::pow(10.0F, static_cast<float>(param("power_dbfs", -20.0)) / 20.0F);
+                }
+            else if (type == "pulse")
+                {
+                    event.type = Event_Type::pulse;
+                    event.freq_hz = param("freq_hz", 0.0);
+                    event.prf_hz = param("prf_hz", 1000.0);
+                    event.duty = std::min(std::max(param("duty", 0.5), 1e-3), 1.0);
+                    event.amplitude = std::pow(10.0F, static_cast<float>(param("power_dbfs", -20.0)) / 20.0F);
+                }
+            else if (type == "step")
+                {
+                    event.type = Event_Type::step;
+                    event.amplitude = std::pow(10.0F, static_cast<float>(param("gain_db", 0.0)) / 20.0F);
+                }
+            else if (type == "phase")
+                {
+                    event.type = Event_Type::phase;
+                    event.end_sample = event.start_sample + 1;
+                    event.jump_rad = static_cast<float>(param("jump_deg", 90.0) * GNSS_PI / 180.0);
+                }
+            else
+                {
+                    LOG(WARNING) << "Interference injector: unknown event type '"
+                                 << type << "' in line " << line_number;
+                    continue;
+                }
+            events_.push_back(event);
+        }
+    std::sort(events_.begin(), events_.end(), [](const Injection_Event &a, const Injection_Event &b) {
+        return a.start_sample < b.start_sample;
+    });
+    LOG(INFO) << "Interference injector: loaded " << events_.size()
+              << " events from " << timeline_filename;
+}
+
+
+void InterferenceInjector::synthesize_tone(gr_complex *out, Injection_Event &event,
+    uint64_t abs_sample, unsigned int num_samples)
+{
+    if (tone_.size() < num_samples)
+        {
+            tone_.resize(num_samples);
+        }
+    unsigned int offset = 0;
+    while (offset < num_samples)
+        {
+            const uint64_t rel = abs_sample + offset - event.start_sample;
+            unsigned int segment = num_samples - offset;
+            double f_inst = event.freq_hz;
+            double phase0;
+            if (event.type == Event_Type::chirp)
+                {
+                    segment = std::min(segment, static_cast<unsigned int>(CHIRP_CHUNK_SAMPLES - (rel % CHIRP_CHUNK_SAMPLES)));
+                    const double period_samples = std::max(event.period_s * fs_, 1.0);
+                    const double tau = std::fmod(static_cast<double>(rel), period_samples);
+                    const double sweep_hz = event.freq_end_hz - event.freq_hz;
+                    f_inst = event.freq_hz + sweep_hz * tau / period_samples;
+                    phase0 = TWO_PI * (event.freq_hz * tau + 0.5 * sweep_hz * tau * tau / period_samples) / fs_;
+                }
+            else
+                {
+                    phase0 = TWO_PI * event.freq_hz * static_cast<double>(rel) / fs_;
+                }
+            const float phase_step = static_cast<float>(TWO_PI * f_inst / fs_);
+            std::array<float, 1> phase{static_cast<float>(std::fmod(phase0, TWO_PI))};
+            volk_gnsssdr_s32f_sincos_32fc(tone_.data(), phase_step, phase.data(), segment);
+            volk_32fc_s32fc_multiply_32fc(tone_.data(), tone_.data(), gr_complex(event.amplitude, 0.0), segment);
+
+            if (event.type == Event_Type::pulse)
+                {
+                    // blank the samples between pulses
+                    const double pri_samples = std::max(fs_ / event.prf_hz, 1.0);
+                    const double on_samples = event.duty * pri_samples;
+                    double position = std::fmod(static_cast<double>(rel), pri_samples);
+                    for (unsigned int i = 0; i < segment; i++)
+                        {
+                            if (position >= on_samples)
+                                {
+                                    tone_[i] = gr_complex(0.0, 0.0);
+                                }
+                            position += 1.0;
+                            if (position >= pri_samples)
+                                {
+                                    position -= pri_samples;
+                                }
+                        }
+                }
+
+            volk_32f_x2_add_32f(reinterpret_cast<float *>(&out[offset]),
+                reinterpret_cast<float *>(&out[offset]),
+                reinterpret_cast<float *>(tone_.data()),
+                2 * segment);
+            offset += segment;
+        }
+}
+
+
+int InterferenceInjector::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
+    const auto num_samples = static_cast<unsigned int>(noutput_items);
+
+    std::memcpy(out, in, num_samples * sizeof(gr_complex));
+
+    const uint64_t first_sample = sample_counter_;
+    const uint64_t last_sample = first_sample + num_samples;
+
+    // accumulated phase jumps rotate every sample; a jump crossed inside this
+    // buffer rotates its tail and is then folded into the accumulator
+    if (residual_rotation_ != gr_complex(1.0, 0.0))
+        {
+            volk_32fc_s32fc_multiply_32fc(out, out, residual_rotation_, num_samples);
+        }
+    for (auto &event : events_)
+        {
+            if ((event.type != Event_Type::phase) or event.applied or (event.start_sample >= last_sample))
+                {
+                    continue;
+                }
+            const auto offset = static_cast<unsigned int>((event.start_sample > first_sample) ? (event.start_sample - first_sample) : 0);
+            const gr_complex rotation(std::cos(event.jump_rad), std::sin(event.jump_rad));
+            volk_32fc_s32fc_multiply_32fc(&out[offset], &out[offset], rotation, num_samples - offset);
+            residual_rotation_ *= rotation;
+            event.applied = true;
+        }
+
+    for (auto &event : events_)
+        {
+            if ((event.type == Event_Type::phase) or (event.start_sample >= last_sample) or (event.end_sample <= first_sample))
+                {
+                    continue;
+                }
+            const auto a = static_cast<unsigned int>((event.start_sample > first_sample) ? (event.start_sample - first_sample) : 0);
+            const auto b = static_cast<unsigned int>((event.end_sample < last_sample) ? (event.end_sample - first_sample) : num_samples);
+            if (event.type == Event_Type::step)
+                {
+                    volk_32fc_s32fc_multiply_32fc(&out[a], &out[a], gr_complex(event.amplitude, 0.0), b - a);
+                }
+            else
+                {
+                    synthesize_tone(&out[a], event, first_sample + a, b - a);
+                }
+        }
+
+    sample_counter_ = last_sample;
+    return noutput_items;
+}
@@ -0,0 +1,111 @@
+/*!
+ * \file interference_injector_cc.h
+ * \brief Injects scripted interference events into a sample stream
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * Mixes parameterized jammers (CW, chirp, pulsed) and receiver impairments
+ * (power steps, phase jumps) into the stream at full rate, following a
+ * timeline read from a text file. All event timing is derived from the
+ * absolute sample counter, so replays of the same capture produce
+ * bit-identical stressed streams.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_INTERFERENCE_INJECTOR_CC_H
+#define GNSS_SDR_INTERFERENCE_INJECTOR_CC_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Input_Filter
+ * \{ */
+/** \addtogroup Input_filter_gnuradio_blocks
+ * \{ */
+
+
+class InterferenceInjector;
+
+using interference_injector_sptr = gnss_shared_ptr<InterferenceInjector>;
+
+interference_injector_sptr make_interference_injector(
+    double sampling_frequency,
+    const std::string &timeline_filename);
+
+/*!
+ * \brief This class injects scripted interference into a sample stream
+ *
+ * The timeline file holds one event per line ('#' starts a comment):
+ *
+ *   start_s duration_s type key=value[,key=value...]
+ *
+ * Supported types: cw (freq_hz, power_dbfs), chirp (f0_hz, f1_hz, period_s,
+ * power_dbfs), pulse (freq_hz, prf_hz, duty, power_dbfs), step (gain_db,
+ * applied to the incoming signal while active) and phase (jump_deg, applied
+ * from start_s onwards, duration ignored). Jammer synthesis and mixing use
+ * volk kernels segment-wise, so the stage sustains full replay rate.
+ */
+class InterferenceInjector : public gr::sync_block
+{
+public:
+    ~InterferenceInjector() = default;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend interference_injector_sptr make_interference_injector(double sampling_frequency, const std::string &timeline_filename);
+    InterferenceInjector(double sampling_frequency, const std::string &timeline_filename);
+
+    enum class Event_Type
+    {
+        cw,
+        chirp,
+        pulse,
+        step,
+        phase
+    };
+
+    struct Injection_Event
+    {
+        Event_Type type;
+        uint64_t start_sample;
+        uint64_t end_sample;
+        double freq_hz;      // cw/pulse carrier, chirp start frequency
+        double freq_end_hz;  // chirp end frequency
+        double period_s;     // chirp sweep period
+        double prf_hz;       // pulse repetition frequency
+        double duty;         // pulse duty cycle (0..1]
+        float amplitude;     // linear amplitude (cw/chirp/pulse) or gain (step)
+        float jump_rad;      // phase jump
+        bool applied;        // one-shot events (phase)
+    };
+
+    void parse_timeline(const std::string &timeline_filename);
+    void synthesize_tone(gr_complex *out, Injection_Event &event,
+        uint64_t abs_sample, unsigned int num_samples);
+
+    std::vector<Injection_Event> events_;
+    volk_gnsssdr::vector<gr_complex> tone_;
+    gr_complex residual_rotation_;  // accumulated phase jumps, applied to every sample
+    uint64_t sample_counter_;
+    double fs_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_INTERFERENCE_INJECTOR_CC_H
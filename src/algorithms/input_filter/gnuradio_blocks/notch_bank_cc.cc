@@ -0,0 +1,266 @@
+/*!
+ * \file notch_bank_cc.cc
+ * \brief Implements a multi-tone notch filter bank with decimated
+ * frequency estimation and lazy coefficient updates
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ *
+ */
+
+#include "notch_bank_cc.h"
+#include "MATH_CONSTANTS.h"  // for TWO_PI
+#include "gnss_sdr_make_unique.h"
+#include <boost/math/distributions/chi_squared.hpp>
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+notch_bank_sptr make_notch_filter_bank(float p_c_factor, float pfa, float peak_threshold_db, int32_t length, int32_t max_notches, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff)
+{
+    return notch_bank_sptr(new NotchBank(p_c_factor, pfa, peak_threshold_db, length, max_notches, n_segments_est, n_segments_reset, n_segments_coeff));
+}
+
+
+NotchBank::NotchBank(float p_c_factor,
+    float pfa,
+    float peak_threshold_db,
+    int32_t length,
+    int32_t max_notches,
+    int32_t n_segments_est,
+    int32_t n_segments_reset,
+    int32_t n_segments_coeff) : gr::block("NotchBank",
+                                    gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                                    gr::io_signature::make(1, 1, sizeof(gr_complex)))
+{
+    const int32_t alignment_multiple = volk_get_alignment() / sizeof(gr_complex);
+    set_alignment(std::max(1, alignment_multiple));
+    p_c_factor_ = gr_complex(p_c_factor, 0.0);
+    pfa_ = pfa;
+    peak_threshold_db_ = peak_threshold_db;
+    length_ = length;
+    max_notches_ = max_notches;
+    n_active_ = 0;
+    n_segments_ = 0;
+    n_segments_est_ = n_segments_est;
+    n_segments_reset_ = n_segments_reset;
+    n_segments_coeff_reset_ = n_segments_coeff;
+    n_segments_coeff_ = 0;
+    n_deg_fred_ = 2 * length_;
+    noise_pow_est_ = 0.0;
+    noise_floor_db_ = 0.0;
+    filter_state_ = false;
+    boost::math::chi_squared_distribution<float> my_dist_(n_deg_fred_);
+    thres_ = boost::math::quantile(boost::math::complement(my_dist_, pfa_));
+    notches_ = std::vector<Notch_State>(max_notches_, {gr_complex(0.0, 0.0), gr_complex(0.0, 0.0), gr_complex(0.0, 0.0), 0, false});
+    peak_bins_.reserve(max_notches_);
+    power_spect_ = volk_gnsssdr::vector<float>(length_);
+#if GNURADIO_FFT_USES_TEMPLATES
+    d_fft_ = std::make_unique<gr::fft::fft_complex_fwd>(length_);
+#else
+    d_fft_ = std::make_unique<gr::fft::fft_complex>(length_, true);
+#endif
+}
+
+
+void NotchBank::update_coefficients(const gr_complex *segment)
+{
+    memcpy(d_fft_->get_inbuf(), segment, sizeof(gr_complex) * length_);
+    d_fft_->execute();
+    volk_32fc_s32f_power_spectrum_32f(power_spect_.data(), d_fft_->get_outbuf(), 1.0, length_);
+
+    // pick up to max_notches local maxima rising more than peak_threshold_db
+    // over the noise floor, strongest first
+    const float gate_db = noise_floor_db_ + peak_threshold_db_;
+    peak_bins_.clear();
+    for (int32_t n = 0; n < length_; n++)
+        {
+            const float power = power_spect_[n];
+            if (power <= gate_db)
+                {
+                    continue;
+                }
+            const int32_t prev = (n == 0) ? (length_ - 1) : (n - 1);
+            const int32_t next = (n == length_ - 1) ? 0 : (n + 1);
+            if ((power < power_spect_[prev]) or (power < power_spect_[next]))
+                {
+                    continue;
+                }
+            auto it = peak_bins_.begin();
+            while ((it != peak_bins_.end()) && (power_spect_[*it] >= power))
+                {
+                    ++it;
+                }
+            peak_bins_.insert(it, n);
+            if (static_cast<int32_t>(peak_bins_.size()) > max_notches_)
+                {
+                    peak_bins_.pop_back();
+                }
+        }
+
+    // match every peak to the stage already tracking it (within one bin of
+    // drift the old coefficient is kept, so a steady tone never triggers a
+    // recomputation); leftover peaks take over the free stages
+    std::vector<bool> stage_kept(max_notches_, false);
+    std::vector<int32_t> new_tones;
+    for (const int32_t bin : peak_bins_)
+        {
+            bool matched = false;
+            for (int32_t j = 0; j < max_notches_; j++)
+                {
+                    if (!notches_[j].active or stage_kept[j])
+                        {
+                            continue;
+                        }
+                    int32_t distance = std::abs(bin - notches_[j].bin);
+                    distance = std::min(distance, length_ - distance);
+                    if (distance <= 1)
+                        {
+                            stage_kept[j] = true;
+                            matched = true;
+                            break;
+                        }
+                }
+            if (!matched)
+                {
+                    new_tones.push_back(bin);
+                }
+        }
+    for (const int32_t bin : new_tones)
+        {
+            for (int32_t j = 0; j < max_notches_; j++)
+                {
+                    if (notches_[j].active and stage_kept[j])
+                        {
+                            continue;
+                        }
+                    const int32_t signed_bin = (bin > length_ / 2) ? (bin - length_) : bin;
+                    const float angle = static_cast<float>(TWO_PI) * static_cast<float>(signed_bin) / static_cast<float>(length_);
+                    notches_[j].z_0 = std::exp(gr_complex(0, 1) * angle);
+                    if (!notches_[j].active)
+                        {
+                            notches_[j].prev_in = gr_complex(0.0, 0.0);
+                            notches_[j].last_out = gr_complex(0.0, 0.0);
+                            notches_[j].active = true;
+                        }
+                    notches_[j].bin = bin;
+                    stage_kept[j] = true;
+                    DLOG(INFO) << "Notch bank stage " << j << " tuned to bin " << bin;
+                    break;
+                }
+        }
+    for (int32_t j = 0; j < max_notches_; j++)
+        {
+            if (notches_[j].active and !stage_kept[j])
+                {
+                    notches_[j].active = false;
+                }
+        }
+    n_active_ = 0;
+    for (int32_t j = 0; j < max_notches_; j++)
+        {
+            if (notches_[j].active)
+                {
+                    n_active_++;
+                }
+        }
+}
+
+
+int NotchBank::general_work(int noutput_items, gr_vector_int &ninput_items __attribute__((unused)),
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    int32_t index_out = 0;
+    float sig2dB = 0.0;
+    float sig2lin = 0.0;
+    lv_32fc_t dot_prod_;
+    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
+    while ((index_out + length_) < noutput_items)
+        {
+            if ((n_segments_ < n_segments_est_) && (filter_state_ == false))
+                {
+                    memcpy(d_fft_->get_inbuf(), in, sizeof(gr_complex) * length_);
+                    d_fft_->execute();
+                    volk_32fc_s32f_power_spectrum_32f(power_spect_.data(), d_fft_->get_outbuf(), 1.0, length_);
+                    volk_32f_s32f_calc_spectral_noise_floor_32f(&sig2dB, power_spect_.data(), 15.0, length_);
+                    sig2lin = std::pow(10.0F, (sig2dB / 10.0F)) / static_cast<float>(n_deg_fred_);
+                    noise_pow_est_ = (static_cast<float>(n_segments_) * noise_pow_est_ + sig2lin) / static_cast<float>(n_segments_ + 1);
+                    noise_floor_db_ = sig2dB;
+                    memcpy(out, in, sizeof(gr_complex) * length_);
+                }
+            else
+                {
+                    volk_32fc_x2_conjugate_dot_prod_32fc(&dot_prod_, in, in, length_);
+                    if ((lv_creal(dot_prod_) / noise_pow_est_) > thres_)
+                        {
+                            if (filter_state_ == false)
+                                {
+                                    filter_state_ = true;
+                                    n_segments_coeff_ = 0;
+                                }
+                            if (n_segments_coeff_ == 0)
+                                {
+                                    update_coefficients(in);
+                                }
+                            if (n_active_ > 0)
+                                {
+                                    for (int32_t aux = 0; aux < length_; aux++)
+                                        {
+                                            gr_complex x = *(in + aux);
+                                            for (auto &stage : notches_)
+                                                {
+                                                    if (!stage.active)
+                                                        {
+                                                            continue;
+                                                        }
+                                                    const gr_complex y = x - stage.z_0 * stage.prev_in + p_c_factor_ * stage.z_0 * stage.last_out;
+                                                    stage.prev_in = x;
+                                                    stage.last_out = y;
+                                                    x = y;
+                                                }
+                                            *(out + aux) = x;
+                                        }
+                                }
+                            else
+                                {
+                                    memcpy(out, in, sizeof(gr_complex) * length_);
+                                }
+                            n_segments_coeff_++;
+                            n_segments_coeff_ = n_segments_coeff_ % n_segments_coeff_reset_;
+                        }
+                    else
+                        {
+                            if (n_segments_ > n_segments_reset_)
+                                {
+                                    n_segments_ = 0;
+                                }
+                            filter_state_ = false;
+                            for (auto &stage : notches_)
+                                {
+                                    stage.active = false;
+                                }
+                            n_active_ = 0;
+                            memcpy(out, in, sizeof(gr_complex) * length_);
+                        }
+                }
+            index_out += length_;
+            n_segments_++;
+            in += length_;
+            out += length_;
+        }
+    consume_each(index_out);
+    return index_out;
+}
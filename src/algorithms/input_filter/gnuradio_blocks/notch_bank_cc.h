@@ -0,0 +1,114 @@
+/*!
+ * \file notch_bank_cc.h
+ * \brief Implements a multi-tone notch filter bank with decimated
+ * frequency estimation and lazy coefficient updates
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ *
+ */
+
+#ifndef GNSS_SDR_NOTCH_BANK_CC_H
+#define GNSS_SDR_NOTCH_BANK_CC_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/block.h>
+#include <gnuradio/fft/fft.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/** \addtogroup Input_Filter
+ * \{ */
+/** \addtogroup Input_filter_gnuradio_blocks
+ * \{ */
+
+
+class NotchBank;
+
+using notch_bank_sptr = gnss_shared_ptr<NotchBank>;
+
+notch_bank_sptr make_notch_filter_bank(
+    float p_c_factor,
+    float pfa,
+    float peak_threshold_db,
+    int32_t length,
+    int32_t max_notches,
+    int32_t n_segments_est,
+    int32_t n_segments_reset,
+    int32_t n_segments_coeff);
+
+/*!
+ * \brief This class implements a cascade of software-defined notch filters
+ * that can remove several continuous-wave interferers at once.
+ *
+ * Tone frequencies are estimated from the power spectrum of one segment
+ * every n_segments_coeff segments, not per sample, and the coefficient of
+ * each notch in the cascade is recomputed only when its estimated tone has
+ * moved by more than one FFT bin, so steady interference costs no
+ * trigonometry at all in the sample loop.
+ */
+class NotchBank : public gr::block
+{
+public:
+    ~NotchBank() = default;
+
+    int general_work(int noutput_items, gr_vector_int &ninput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend notch_bank_sptr make_notch_filter_bank(float p_c_factor, float pfa, float peak_threshold_db, int32_t length, int32_t max_notches, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff);
+    NotchBank(float p_c_factor, float pfa, float peak_threshold_db, int32_t length, int32_t max_notches, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff);
+
+    //! One stage of the cascade, tracking a single tone
+    struct Notch_State
+    {
+        gr_complex z_0;
+        gr_complex prev_in;   // previous input sample of this stage
+        gr_complex last_out;  // previous output sample of this stage
+        int32_t bin;          // FFT bin the stage is currently tuned to
+        bool active;
+    };
+
+    void update_coefficients(const gr_complex *segment);
+
+#if GNURADIO_FFT_USES_TEMPLATES
+    std::unique_ptr<gr::fft::fft_complex_fwd> d_fft_;
+#else
+    std::unique_ptr<gr::fft::fft_complex> d_fft_;
+#endif
+    std::vector<Notch_State> notches_;
+    std::vector<int32_t> peak_bins_;
+    volk_gnsssdr::vector<float> power_spect_;
+    gr_complex p_c_factor_;
+    float pfa_;
+    float thres_;
+    float noise_pow_est_;
+    float noise_floor_db_;
+    float peak_threshold_db_;
+    int32_t length_;
+    int32_t max_notches_;
+    int32_t n_active_;
+    int32_t n_segments_;
+    int32_t n_segments_est_;
+    int32_t n_segments_reset_;
+    int32_t n_segments_coeff_reset_;
+    int32_t n_segments_coeff_;
+    int32_t n_deg_fred_;
+    bool filter_state_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_NOTCH_BANK_CC_H
@@ -18,24 +18,28 @@
 
 #include "pulse_blanking_cc.h"
 #include <boost/math/distributions/chi_squared.hpp>
+#include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
 #include <algorithm>
+#include <iomanip>
+#include <sstream>
 
 
 pulse_blanking_cc_sptr make_pulse_blanking_cc(float pfa, int32_t length,
-    int32_t n_segments_est, int32_t n_segments_reset)
+    int32_t n_segments_est, int32_t n_segments_reset, uint64_t report_interval_samples)
 {
-    return pulse_blanking_cc_sptr(new pulse_blanking_cc(pfa, length, n_segments_est, n_segments_reset));
+    return pulse_blanking_cc_sptr(new pulse_blanking_cc(pfa, length, n_segments_est, n_segments_reset, report_interval_samples));
 }
 
 
 pulse_blanking_cc::pulse_blanking_cc(float pfa,
     int32_t length,
     int32_t n_segments_est,
-    int32_t n_segments_reset) : gr::block("pulse_blanking_cc",
-                                    gr::io_signature::make(1, 1, sizeof(gr_complex)),
-                                    gr::io_signature::make(1, 1, sizeof(gr_complex)))
+    int32_t n_segments_reset,
+    uint64_t report_interval_samples) : gr::block("pulse_blanking_cc",
+                                            gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                                            gr::io_signature::make(1, 1, sizeof(gr_complex)))
 {
     const int32_t alignment_multiple = volk_get_alignment() / sizeof(gr_complex);
     set_alignment(std::max(1, alignment_multiple));
@@ -49,7 +53,30 @@ pulse_blanking_cc::pulse_blanking_cc(float pfa,
     n_deg_fred_ = 2 * length_;
     boost::math::chi_squared_distribution<float> my_dist_(n_deg_fred_);
     thres_ = boost::math::quantile(boost::math::complement(my_dist_, pfa_));
-    zeros_ = volk_gnsssdr::vector<gr_complex>(length_);
+    samples_processed_ = 0;
+    samples_blanked_ = 0;
+    report_interval_samples_ = report_interval_samples;
+    last_report_samples_ = 0;
+    last_report_blanked_ = 0;
+    message_port_register_out(pmt::mp("stats"));
+}
+
+
+void pulse_blanking_cc::publish_report()
+{
+    const uint64_t interval_samples = samples_processed_ - last_report_samples_;
+    const uint64_t interval_blanked = samples_blanked_ - last_report_blanked_;
+    std::ostringstream summary;
+    summary << "Pulse blanking: "
+            << std::fixed << std::setprecision(2)
+            << 100.0 * static_cast<double>(interval_blanked) / static_cast<double>(interval_samples)
+            << "% of the last " << interval_samples << " samples blanked ("
+            << 100.0 * static_cast<double>(samples_blanked_) / static_cast<double>(samples_processed_)
+            << "% since start)";
+    LOG(INFO) << summary.str();
+    message_port_pub(pmt::mp("stats"), pmt::mp(summary.str()));
+    last_report_samples_ = samples_processed_;
+    last_report_blanked_ = samples_blanked_;
 }
 
 
@@ -58,28 +85,48 @@ int pulse_blanking_cc::general_work(int noutput_items, gr_vector_int &ninput_ite
 {
     const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
     auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
-    auto magnitude = volk_gnsssdr::vector<float>(noutput_items);
-    volk_32fc_magnitude_squared_32f(magnitude.data(), in, noutput_items);
-    int32_t sample_index = 0;
-    float segment_energy;
-    while ((sample_index + length_) < noutput_items)
+    const int32_t n_work_segments = noutput_items / length_;
+    const int32_t n_samples = n_work_segments * length_;
+    if (n_samples == 0)
         {
-            volk_32f_accumulator_s32f(&segment_energy, (magnitude.data() + sample_index), length_);
+            consume_each(0);
+            return 0;
+        }
+    if (magnitude_.size() < static_cast<size_t>(n_samples))
+        {
+            magnitude_.resize(n_samples);
+        }
+    volk_32fc_magnitude_squared_32f(magnitude_.data(), in, n_samples);
+
+    // copy the whole buffer once and only clear the segments declared as
+    // pulses afterwards, instead of choosing copy or zero segment by segment
+    memcpy(out, in, sizeof(gr_complex) * n_samples);
+
+    const float *magnitude = magnitude_.data();
+    for (int32_t segment = 0; segment < n_work_segments; segment++)
+        {
+            // short contiguous accumulation the compiler can vectorize,
+            // without one kernel-dispatch call per segment
+            float segment_energy = 0.0F;
+            for (int32_t k = 0; k < length_; k++)
+                {
+                    segment_energy += magnitude[k];
+                }
+            magnitude += length_;
             if ((n_segments_ < n_segments_est_) && (last_filtered_ == false))
                 {
                     noise_power_estimation_ = (static_cast<float>(n_segments_) * noise_power_estimation_ + segment_energy / static_cast<float>(n_deg_fred_)) / static_cast<float>(n_segments_ + 1);
-                    memcpy(out, in, sizeof(gr_complex) * length_);
                 }
             else
                 {
                     if ((segment_energy / noise_power_estimation_) > thres_)
                         {
-                            memcpy(out, zeros_.data(), sizeof(gr_complex) * length_);
+                            std::fill_n(out + segment * length_, length_, gr_complex(0.0F, 0.0F));
+                            samples_blanked_ += static_cast<uint64_t>(length_);
                             last_filtered_ = true;
                         }
                     else
                         {
-                            memcpy(out, in, sizeof(gr_complex) * length_);
                             last_filtered_ = false;
                             if (n_segments_ > n_segments_reset_)
                                 {
@@ -87,11 +134,14 @@ int pulse_blanking_cc::general_work(int noutput_items, gr_vector_int &ninput_ite
                                 }
                         }
                 }
-            in += length_;
-            out += length_;
-            sample_index += length_;
             n_segments_++;
         }
-    consume_each(sample_index);
-    return sample_index;
+
+    samples_processed_ += static_cast<uint64_t>(n_samples);
+    if ((report_interval_samples_ > 0) && (samples_processed_ - last_report_samples_ >= report_interval_samples_))
+        {
+            publish_report();
+        }
+    consume_each(n_samples);
+    return n_samples;
 }
@@ -39,7 +39,8 @@ pulse_blanking_cc_sptr make_pulse_blanking_cc(
     float pfa,
     int32_t length,
     int32_t n_segments_est,
-    int32_t n_segments_reset);
+    int32_t n_segments_reset,
+    uint64_t report_interval_samples);
 
 class pulse_blanking_cc : public gr::block
 {
@@ -49,10 +50,28 @@ public:
     int general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
+    //! Total number of samples that went through the block
+    inline uint64_t samples_processed() const
+    {
+        return samples_processed_;
+    }
+
+    //! Number of samples zeroed by the blanker
+    inline uint64_t samples_blanked() const
+    {
+        return samples_blanked_;
+    }
+
 private:
-    friend pulse_blanking_cc_sptr make_pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset);
-    pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset);
-    volk_gnsssdr::vector<gr_complex> zeros_;
+    friend pulse_blanking_cc_sptr make_pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, uint64_t report_interval_samples);
+    pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, uint64_t report_interval_samples);
+    void publish_report();
+    volk_gnsssdr::vector<float> magnitude_;
+    uint64_t samples_processed_;
+    uint64_t samples_blanked_;
+    uint64_t report_interval_samples_;  // 0 disables the periodic report
+    uint64_t last_report_samples_;
+    uint64_t last_report_blanked_;
     float noise_power_estimation_;
     float thres_;
     float pfa_;
@@ -0,0 +1,137 @@
+/*!
+ * \file spectral_excision_cc.cc
+ * \brief Implements a frequency-domain interference excisor with overlap-add
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "spectral_excision_cc.h"
+#include "MATH_CONSTANTS.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>  // for nth_element, copy
+#include <cmath>      // for cos, pow, sqrt
+#include <cstring>    // for memcpy
+
+
+spectral_excision_sptr make_spectral_excision(int32_t fft_length, float threshold_db, float smoothing_factor)
+{
+    return spectral_excision_sptr(new SpectralExcision(fft_length, threshold_db, smoothing_factor));
+}
+
+
+SpectralExcision::SpectralExcision(int32_t fft_length, float threshold_db, float smoothing_factor)
+    : gr::sync_block("SpectralExcision",
+          gr::io_signature::make(1, 1, sizeof(gr_complex)),
+          gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      segments_processed_(0),
+      bins_excised_(0),
+      noise_floor_(0.0),
+      threshold_(std::pow(10.0F, threshold_db / 10.0F)),
+      smoothing_factor_(smoothing_factor),
+      length_(fft_length),
+      hop_(fft_length / 2)
+{
+#if GNURADIO_FFT_USES_TEMPLATES
+    d_fft_ = std::make_unique<gr::fft::fft_complex_fwd>(length_);
+    d_ifft_ = std::make_unique<gr::fft::fft_complex_rev>(length_);
+#else
+    d_fft_ = std::make_unique<gr::fft::fft_complex>(length_, true);
+    d_ifft_ = std::make_unique<gr::fft::fft_complex>(length_, false);
+#endif
+    window_ = volk_gnsssdr::vector<float>(length_);
+    synthesis_window_ = volk_gnsssdr::vector<float>(length_);
+    power_spect_ = volk_gnsssdr::vector<float>(length_);
+    sorted_power_ = volk_gnsssdr::vector<float>(length_);
+    windowed_out_ = volk_gnsssdr::vector<gr_complex>(length_);
+    overlap_ = volk_gnsssdr::vector<gr_complex>(hop_, gr_complex(0.0, 0.0));
+    for (int32_t n = 0; n < length_; n++)
+        {
+            // periodic sqrt-Hann: the squared analysis/synthesis pair adds up
+            // to one at 50 % overlap, so an untouched spectrum passes through
+            const auto hann = static_cast<float>(0.5 - 0.5 * cos(TWO_PI * static_cast<double>(n) / static_cast<double>(length_)));
+            window_[n] = std::sqrt(hann);
+            synthesis_window_[n] = window_[n] / static_cast<float>(length_);
+        }
+    set_history(hop_ + 1);
+    set_output_multiple(hop_);
+    DLOG(INFO) << "SPECTRAL EXCISION CHANNEL CONSTRUCTOR";
+}
+
+
+int SpectralExcision::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
+    const int32_t n_segments = noutput_items / hop_;
+    for (int32_t seg = 0; seg < n_segments; seg++)
+        {
+            // analysis window spans the hop_ history samples plus the new hop
+            const gr_complex *segment = in + static_cast<size_t>(seg) * hop_;
+            volk_32fc_32f_multiply_32fc(d_fft_->get_inbuf(), segment, window_.data(), length_);
+            d_fft_->execute();
+            volk_32fc_magnitude_squared_32f(power_spect_.data(), d_fft_->get_outbuf(), length_);
+
+            // the median power is a noise floor estimate that the interference
+            // itself barely biases, even when it occupies many bins
+            std::copy(power_spect_.begin(), power_spect_.end(), sorted_power_.begin());
+            std::nth_element(sorted_power_.begin(), sorted_power_.begin() + length_ / 2, sorted_power_.end());
+            const float median_power = sorted_power_[length_ / 2];
+            if (noise_floor_ > 0.0F)
+                {
+                    noise_floor_ += smoothing_factor_ * (median_power - noise_floor_);
+                }
+            else
+                {
+                    noise_floor_ = median_power;
+                }
+            const float excision_threshold = noise_floor_ * threshold_;
+
+            const gr_complex *bins = d_fft_->get_outbuf();
+            gr_complex *masked_bins = d_ifft_->get_inbuf();
+            for (int32_t k = 0; k < length_; k++)
+                {
+                    if (power_spect_[k] > excision_threshold)
+                        {
+                            masked_bins[k] = gr_complex(0.0, 0.0);
+                            bins_excised_++;
+                        }
+                    else
+                        {
+                            masked_bins[k] = bins[k];
+                        }
+                }
+            d_ifft_->execute();
+
+            // weighted overlap-add: the first half of the synthesized segment
+            // completes the half kept from the previous one
+            volk_32fc_32f_multiply_32fc(windowed_out_.data(), d_ifft_->get_outbuf(), synthesis_window_.data(), length_);
+            gr_complex *segment_out = out + static_cast<size_t>(seg) * hop_;
+            for (int32_t n = 0; n < hop_; n++)
+                {
+                    segment_out[n] = overlap_[n] + windowed_out_[n];
+                }
+            memcpy(overlap_.data(), windowed_out_.data() + hop_, hop_ * sizeof(gr_complex));
+
+            segments_processed_++;
+            if ((segments_processed_ % 100000) == 0)
+                {
+                    DLOG(INFO) << "Spectral excision: " << bins_excised_
+                               << " bins excised out of " << segments_processed_ * static_cast<uint64_t>(length_)
+                               << ", noise floor estimate " << noise_floor_;
+                }
+        }
+    return n_segments * hop_;
+}
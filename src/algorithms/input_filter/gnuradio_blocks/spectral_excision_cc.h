@@ -0,0 +1,93 @@
+/*!
+ * \file spectral_excision_cc.h
+ * \brief Implements a frequency-domain interference excisor with overlap-add
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * Streaming FFT -> spectral thresholding -> IFFT with windowed overlap-add
+ * reconstruction. Bins whose power exceeds the estimated noise floor by a
+ * configurable margin are blanked, which removes wideband and sweeping
+ * interferers (e.g. chirp jammers) that a notch filter cannot follow.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SPECTRAL_EXCISION_CC_H
+#define GNSS_SDR_SPECTRAL_EXCISION_CC_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/fft/fft.h>
+#include <gnuradio/sync_block.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstdint>
+#include <memory>
+
+/** \addtogroup Input_Filter
+ * \{ */
+/** \addtogroup Input_filter_gnuradio_blocks
+ * \{ */
+
+
+class SpectralExcision;
+
+using spectral_excision_sptr = gnss_shared_ptr<SpectralExcision>;
+
+spectral_excision_sptr make_spectral_excision(
+    int32_t fft_length,
+    float threshold_db,
+    float smoothing_factor);
+
+/*!
+ * \brief This class implements a frequency-domain excisor of wideband interference
+ *
+ * The input stream is processed in 50 % overlapped segments weighted with a
+ * square-root Hann window, so the overlap-add of the analysis/synthesis pair
+ * reconstructs the signal exactly when no bin is excised. The noise floor is
+ * tracked with the median of the segment power spectrum, which is insensitive
+ * to the interference itself.
+ */
+class SpectralExcision : public gr::sync_block
+{
+public:
+    ~SpectralExcision() = default;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend spectral_excision_sptr make_spectral_excision(int32_t fft_length, float threshold_db, float smoothing_factor);
+    SpectralExcision(int32_t fft_length, float threshold_db, float smoothing_factor);
+#if GNURADIO_FFT_USES_TEMPLATES
+    std::unique_ptr<gr::fft::fft_complex_fwd> d_fft_;
+    std::unique_ptr<gr::fft::fft_complex_rev> d_ifft_;
+#else
+    std::unique_ptr<gr::fft::fft_complex> d_fft_;
+    std::unique_ptr<gr::fft::fft_complex> d_ifft_;
+#endif
+    volk_gnsssdr::vector<float> window_;            // sqrt-Hann analysis window
+    volk_gnsssdr::vector<float> synthesis_window_;  // sqrt-Hann window with the 1/N IFFT scaling folded in
+    volk_gnsssdr::vector<float> power_spect_;
+    volk_gnsssdr::vector<float> sorted_power_;
+    volk_gnsssdr::vector<gr_complex> windowed_out_;
+    volk_gnsssdr::vector<gr_complex> overlap_;
+    uint64_t segments_processed_;
+    uint64_t bins_excised_;
+    float noise_floor_;
+    float threshold_;  // linear power margin over the noise floor
+    float smoothing_factor_;
+    int32_t length_;
+    int32_t hop_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SPECTRAL_EXCISION_CC_H
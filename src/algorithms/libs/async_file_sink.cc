@@ -0,0 +1,290 @@
+/*!
+ * \file async_file_sink.cc
+ * \brief Implementation of a file sink that writes raw sample dumps from a
+ * dedicated thread
+ * \author Javier Arribas, 2011. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "async_file_sink.h"
+#include <gnuradio/io_signature.h>
+#include <glog/logging.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+
+async_file_sink_sptr async_make_file_sink(
+    size_t item_size,
+    const std::string &filename,
+    size_t buffer_size_bytes,
+    size_t num_buffers,
+    uint64_t items_per_file)
+{
+    return async_file_sink_sptr(new async_file_sink(item_size, filename, buffer_size_bytes, num_buffers, items_per_file));
+}
+
+
+async_file_sink::async_file_sink(size_t item_size,
+    const std::string &filename,
+    size_t buffer_size_bytes,
+    size_t num_buffers,
+    uint64_t items_per_file)
+    : gr::sync_block("async_file_sink",
+          gr::io_signature::make(1, 1, item_size),
+          gr::io_signature::make(0, 0, 0)),
+      d_filename(filename),
+      d_dropped_items(0),
+      d_bytes_per_file(items_per_file * item_size),
+      d_bytes_in_file(0),
+      d_item_size(item_size),
+      d_buffer_size(buffer_size_bytes),
+      d_current_fill(0),
+      d_file_index(0),
+      d_fd(-1),
+      d_next_fd(-1),
+      d_shutdown(false),
+      d_drop_reported(false)
+{
+    d_fd = open(rotated_filename(0).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (d_fd < 0)
+        {
+            throw std::runtime_error("async_file_sink: can't open file " + rotated_filename(0) + ": " + std::strerror(errno));
+        }
+    if (d_bytes_per_file > 0)
+        {
+            d_next_fd = open(rotated_filename(1).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (d_next_fd < 0)
+                {
+                    LOG(WARNING) << "async_file_sink: can't preopen file " << rotated_filename(1) << ": " << std::strerror(errno) << ". Rotation disabled";
+                    d_bytes_per_file = 0;
+                }
+        }
+
+    d_pool.resize(num_buffers);
+    for (size_t i = 0; i < num_buffers; i++)
+        {
+            d_pool[i].resize(d_buffer_size);
+            d_free.push_back(i);
+        }
+    d_current = d_free.front();
+    d_free.pop_front();
+
+    d_writer = std::thread(&async_file_sink::writer_loop, this);
+    DLOG(INFO) << "async_file_sink: dumping to " << filename << " with "
+               << num_buffers << " buffers of " << d_buffer_size << " bytes";
+}
+
+
+async_file_sink::~async_file_sink()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        // flush the partial buffer owned by the flowgraph thread
+        if (d_current != no_buffer and d_current_fill > 0)
+            {
+                d_filled.push_back({d_current, d_current_fill});
+                d_current = no_buffer;
+            }
+        d_shutdown = true;
+    }
+    d_cond.notify_one();
+    if (d_writer.joinable())
+        {
+            d_writer.join();
+        }
+    if (d_fd >= 0)
+        {
+            close(d_fd);
+        }
+    if (d_next_fd >= 0)
+        {
+            // discard the preopened rotation target, which never received data
+            close(d_next_fd);
+            unlink(rotated_filename(d_file_index + 1).c_str());
+        }
+    if (d_dropped_items > 0)
+        {
+            LOG(WARNING) << "async_file_sink: dropped " << d_dropped_items
+                         << " items while dumping to " << d_filename
+                         << " because the disk could not keep up";
+        }
+}
+
+
+uint64_t async_file_sink::dropped_items() const
+{
+    return d_dropped_items;
+}
+
+
+std::string async_file_sink::rotated_filename(uint32_t index) const
+{
+    if (d_bytes_per_file == 0)
+        {
+            return d_filename;
+        }
+    std::string suffix = std::to_string(index);
+    while (suffix.size() < 3)
+        {
+            suffix.insert(0, "0");
+        }
+    const size_t dot = d_filename.find_last_of('.');
+    if (dot == std::string::npos)
+        {
+            return d_filename + '_' + suffix;
+        }
+    return d_filename.substr(0, dot) + '_' + suffix + d_filename.substr(dot);
+}
+
+
+void async_file_sink::submit_current_buffer()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_filled.push_back({d_current, d_current_fill});
+    d_current_fill = 0;
+    if (d_free.empty())
+        {
+            d_current = no_buffer;
+        }
+    else
+        {
+            d_current = d_free.front();
+            d_free.pop_front();
+        }
+    d_cond.notify_one();
+}
+
+
+int async_file_sink::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items __attribute__((unused)))
+{
+    const auto *in = reinterpret_cast<const char *>(input_items[0]);
+    uint64_t bytes_left = static_cast<uint64_t>(noutput_items) * d_item_size;
+
+    while (bytes_left > 0)
+        {
+            if (d_current == no_buffer)
+                {
+                    // try to recover a buffer returned by the writer thread
+                    std::lock_guard<std::mutex> lock(d_mutex);
+                    if (d_free.empty())
+                        {
+                            break;
+                        }
+                    d_current = d_free.front();
+                    d_free.pop_front();
+                }
+            const uint64_t space = d_buffer_size - d_current_fill;
+            const uint64_t chunk = std::min(bytes_left, space);
+            memcpy(d_pool[d_current].data() + d_current_fill, in, chunk);
+            d_current_fill += chunk;
+            in += chunk;
+            bytes_left -= chunk;
+            if (d_current_fill == d_buffer_size)
+                {
+                    submit_current_buffer();
+                }
+        }
+
+    if (bytes_left > 0)
+        {
+            // the ring is full: drop instead of stalling the flowgraph thread
+            d_dropped_items += bytes_left / d_item_size;
+            if (!d_drop_reported)
+                {
+                    d_drop_reported = true;
+                    LOG(WARNING) << "async_file_sink: buffer ring full, dropping samples of the dump to " << d_filename;
+                }
+        }
+    return noutput_items;
+}
+
+
+void async_file_sink::writer_loop()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (true)
+        {
+            d_cond.wait(lock, [this] { return d_shutdown or !d_filled.empty(); });
+            if (d_filled.empty())
+                {
+                    // shutdown with everything flushed
+                    return;
+                }
+            const Filled_Buffer buf = d_filled.front();
+            d_filled.pop_front();
+            lock.unlock();
+            const char *data = d_pool[buf.index].data();
+            if (d_bytes_per_file == 0)
+                {
+                    write_to_current_file(data, buf.len);
+                }
+            else
+                {
+                    // split the buffer exactly on the file boundary, so every
+                    // rotated file holds exactly items_per_file items
+                    size_t offset = 0;
+                    while (offset < buf.len)
+                        {
+                            const uint64_t space = d_bytes_per_file - d_bytes_in_file;
+                            const size_t part = std::min(static_cast<uint64_t>(buf.len - offset), space);
+                            write_to_current_file(data + offset, part);
+                            offset += part;
+                            d_bytes_in_file += part;
+                            if (d_bytes_in_file == d_bytes_per_file)
+                                {
+                                    // switch to the preopened descriptor and
+                                    // finalize the full file in the background
+                                    close(d_fd);
+                                    d_fd = d_next_fd;
+                                    d_file_index++;
+                                    d_bytes_in_file = 0;
+                                    d_next_fd = open(rotated_filename(d_file_index + 1).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+                                    if (d_next_fd < 0)
+                                        {
+                                            LOG(WARNING) << "async_file_sink: can't preopen file " << rotated_filename(d_file_index + 1) << ": " << std::strerror(errno) << ". Rotation disabled";
+                                            d_bytes_per_file = 0;
+                                            write_to_current_file(data + offset, buf.len - offset);
+                                            break;
+                                        }
+                                }
+                        }
+                }
+            lock.lock();
+            d_free.push_back(buf.index);
+        }
+}
+
+
+void async_file_sink::write_to_current_file(const char *data, size_t len)
+{
+    size_t written = 0;
+    while (written < len)
+        {
+            const ssize_t ret = write(d_fd, data + written, len - written);
+            if (ret < 0)
+                {
+                    if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                    LOG(ERROR) << "async_file_sink: write to " << d_filename << " failed: " << std::strerror(errno);
+                    break;
+                }
+            written += static_cast<size_t>(ret);
+        }
+}
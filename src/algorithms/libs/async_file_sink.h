@@ -0,0 +1,131 @@
+/*!
+ * \file async_file_sink.h
+ * \brief Interface of a file sink that writes raw sample dumps from a
+ * dedicated thread
+ * \author Javier Arribas, 2011. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ASYNC_FILE_SINK_H
+#define GNSS_SDR_ASYNC_FILE_SINK_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+class async_file_sink;
+
+using async_file_sink_sptr = gnss_shared_ptr<async_file_sink>;
+
+async_file_sink_sptr async_make_file_sink(
+    size_t item_size,
+    const std::string &filename,
+    size_t buffer_size_bytes = 1048576,
+    size_t num_buffers = 64,
+    uint64_t items_per_file = 0);
+
+/*!
+ * \brief This class writes raw sample dumps from a dedicated writer thread.
+ *
+ * Drop-in replacement for gr::blocks::file_sink on the capture dump paths.
+ * The flowgraph thread only copies samples into a ring of preallocated
+ * buffers; a writer thread flushes full buffers to disk. When the disk
+ * cannot keep up and the ring fills, samples are dropped instead of stalling
+ * the flowgraph, and the number of dropped items is accounted and reported.
+ *
+ * A nonzero items_per_file enables deterministic sample-count rotation into
+ * files named <base>_000<ext>, <base>_001<ext>, ... The next file descriptor
+ * is always preopened, the writer thread splits a buffer exactly on the item
+ * boundary when switching, and the previous file is finalized in the
+ * background, so every rotated file holds exactly items_per_file items and
+ * no sample is lost at the handover.
+ */
+class async_file_sink : public gr::sync_block
+{
+public:
+    ~async_file_sink();
+
+    //! Number of items dropped because the buffer ring was full
+    uint64_t dropped_items() const;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend async_file_sink_sptr async_make_file_sink(
+        size_t item_size,
+        const std::string &filename,
+        size_t buffer_size_bytes,
+        size_t num_buffers,
+        uint64_t items_per_file);
+
+    async_file_sink(size_t item_size,
+        const std::string &filename,
+        size_t buffer_size_bytes,
+        size_t num_buffers,
+        uint64_t items_per_file);
+
+    void writer_loop();
+    void submit_current_buffer();
+    std::string rotated_filename(uint32_t index) const;
+    void write_to_current_file(const char *data, size_t len);
+
+    // a filled buffer handed to the writer thread (len covers the final
+    // partial flush; every other buffer is submitted full)
+    struct Filled_Buffer
+    {
+        size_t index;
+        size_t len;
+    };
+
+    std::vector<std::vector<char>> d_pool;
+    std::deque<Filled_Buffer> d_filled;
+    std::deque<size_t> d_free;
+    std::thread d_writer;
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::string d_filename;
+    std::atomic<uint64_t> d_dropped_items;
+    uint64_t d_bytes_per_file;  // 0: no rotation
+    uint64_t d_bytes_in_file;   // owned by the writer thread
+    size_t d_item_size;
+    size_t d_buffer_size;
+    size_t d_current;       // buffer owned by the flowgraph thread, or no_buffer
+    size_t d_current_fill;  // bytes already copied into the current buffer
+    uint32_t d_file_index;
+    int d_fd;
+    int d_next_fd;  // preopened rotation target, or -1
+    bool d_shutdown;
+    bool d_drop_reported;
+
+    static const size_t no_buffer = static_cast<size_t>(-1);
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ASYNC_FILE_SINK_H
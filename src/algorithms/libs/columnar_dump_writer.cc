@@ -0,0 +1,348 @@
+/*!
+ * \file columnar_dump_writer.cc
+ * \brief Implementation of a streaming columnar dump writer with a
+ * background flush thread
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "columnar_dump_writer.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <cstdio>  // for std::remove
+#include <cstring>
+#include <utility>
+
+
+Columnar_Dump_Writer::~Columnar_Dump_Writer()
+{
+    try
+        {
+            close();
+        }
+    catch (const std::exception& ex)
+        {
+            LOG(WARNING) << "Exception closing columnar dump: " << ex.what();
+        }
+}
+
+
+uint8_t Columnar_Dump_Writer::type_size(Column_Type type)
+{
+    switch (type)
+        {
+        case Column_Type::f32:
+        case Column_Type::i32:
+        case Column_Type::u32:
+            return 4;
+        case Column_Type::f64:
+        case Column_Type::i64:
+        case Column_Type::u64:
+            return 8;
+        default:
+            return 0;
+        }
+}
+
+
+void Columnar_Dump_Writer::add_column(const std::string& name, Column_Type type)
+{
+    if (d_open)
+        {
+            LOG(ERROR) << "Columnar dump: columns cannot be added after open()";
+            return;
+        }
+    Column col;
+    col.name = name.substr(0, 255);
+    col.type = type;
+    col.elem_size = type_size(type);
+    d_columns.push_back(std::move(col));
+}
+
+
+bool Columnar_Dump_Writer::open(const std::string& filename, uint32_t rows_per_chunk, uint64_t rows_per_file)
+{
+    if (d_open or d_columns.empty())
+        {
+            return false;
+        }
+    d_rows_per_chunk = std::max(rows_per_chunk, static_cast<uint32_t>(1));
+    d_rows_in_chunk = 0;
+    d_put_index = 0;
+    d_base_filename = filename;
+    d_file_index = 0;
+    d_rows_in_file = 0;
+    // rotation happens between chunks, so the file boundary is rounded up to
+    // a whole number of chunks and stays deterministic across runs
+    d_rows_per_file = 0;
+    if (rows_per_file > 0)
+        {
+            const uint64_t chunks = (rows_per_file + d_rows_per_chunk - 1) / d_rows_per_chunk;
+            d_rows_per_file = chunks * d_rows_per_chunk;
+        }
+
+    // File header, kept around so rotated files can reproduce it
+    const char magic[4] = {'G', 'S', 'C', 'D'};
+    const uint8_t version = 1;
+    const uint8_t codec = 0;  // uncompressed; reserved for future codecs
+    const auto column_count = static_cast<uint16_t>(d_columns.size());
+    d_header.clear();
+    d_header.insert(d_header.end(), magic, magic + 4);
+    d_header.push_back(version);
+    d_header.push_back(codec);
+    d_header.insert(d_header.end(), reinterpret_cast<const uint8_t*>(&column_count), reinterpret_cast<const uint8_t*>(&column_count) + 2);
+    d_header.insert(d_header.end(), reinterpret_cast<const uint8_t*>(&d_rows_per_chunk), reinterpret_cast<const uint8_t*>(&d_rows_per_chunk) + 4);
+    for (auto& col : d_columns)
+        {
+            const auto type = static_cast<uint8_t>(col.type);
+            const auto name_len = static_cast<uint8_t>(col.name.size());
+            d_header.push_back(type);
+            d_header.push_back(name_len);
+            d_header.insert(d_header.end(), col.name.begin(), col.name.end());
+            col.data.reserve(static_cast<std::size_t>(d_rows_per_chunk) * col.elem_size);
+        }
+
+    d_file.open(rotated_filename(0), std::ios::out | std::ios::binary);
+    if (!d_file.is_open())
+        {
+            LOG(WARNING) << "Could not open columnar dump file " << rotated_filename(0);
+            return false;
+        }
+    d_file.write(reinterpret_cast<const char*>(d_header.data()), static_cast<std::streamsize>(d_header.size()));
+    if (d_rows_per_file > 0)
+        {
+            preopen_next_file();
+        }
+
+    d_shutdown = false;
+    d_open = true;
+    d_writer = std::thread(&Columnar_Dump_Writer::writer_loop, this);
+    return true;
+}
+
+
+std::string Columnar_Dump_Writer::rotated_filename(uint32_t index) const
+{
+    if (d_rows_per_file == 0)
+        {
+            return d_base_filename;
+        }
+    std::string suffix = std::to_string(index);
+    while (suffix.size() < 3)
+        {
+            suffix.insert(0, "0");
+        }
+    const std::size_t dot = d_base_filename.find_last_of('.');
+    if (dot == std::string::npos)
+        {
+            return d_base_filename + '_' + suffix;
+        }
+    return d_base_filename.substr(0, dot) + '_' + suffix + d_base_filename.substr(dot);
+}
+
+
+void Columnar_Dump_Writer::preopen_next_file()
+{
+    d_next_file.open(rotated_filename(d_file_index + 1), std::ios::out | std::ios::binary);
+    if (d_next_file.is_open())
+        {
+            d_next_file.write(reinterpret_cast<const char*>(d_header.data()), static_cast<std::streamsize>(d_header.size()));
+        }
+    else
+        {
+            LOG(WARNING) << "Could not preopen columnar dump file " << rotated_filename(d_file_index + 1);
+        }
+}
+
+
+bool Columnar_Dump_Writer::is_open() const
+{
+    return d_open;
+}
+
+
+void Columnar_Dump_Writer::append_raw(const void* value, Column_Type type)
+{
+    if (!d_open or d_put_index >= d_columns.size())
+        {
+            return;
+        }
+    Column& col = d_columns[d_put_index++];
+    const std::size_t offset = col.data.size();
+    col.data.resize(offset + col.elem_size);
+    if (col.type == type or type_size(type) == col.elem_size)
+        {
+            // same-size reinterpretation keeps the columns aligned even if a
+            // caller mixes e.g. i32 and u32; a real mismatch is reported once
+            if (col.type != type and !d_type_mismatch_reported)
+                {
+                    d_type_mismatch_reported = true;
+                    LOG(ERROR) << "Columnar dump: value type does not match the declared type of column " << col.name;
+                }
+            std::memcpy(col.data.data() + offset, value, col.elem_size);
+        }
+    else
+        {
+            if (!d_type_mismatch_reported)
+                {
+                    d_type_mismatch_reported = true;
+                    LOG(ERROR) << "Columnar dump: value size does not match the declared type of column " << col.name;
+                }
+            std::memset(col.data.data() + offset, 0, col.elem_size);
+        }
+}
+
+
+void Columnar_Dump_Writer::put(float value) { append_raw(&value, Column_Type::f32); }
+void Columnar_Dump_Writer::put(double value) { append_raw(&value, Column_Type::f64); }
+void Columnar_Dump_Writer::put(int32_t value) { append_raw(&value, Column_Type::i32); }
+void Columnar_Dump_Writer::put(uint32_t value) { append_raw(&value, Column_Type::u32); }
+void Columnar_Dump_Writer::put(int64_t value) { append_raw(&value, Column_Type::i64); }
+void Columnar_Dump_Writer::put(uint64_t value) { append_raw(&value, Column_Type::u64); }
+
+
+void Columnar_Dump_Writer::end_row()
+{
+    if (!d_open)
+        {
+            return;
+        }
+    if (d_put_index != d_columns.size())
+        {
+            if (!d_type_mismatch_reported)
+                {
+                    d_type_mismatch_reported = true;
+                    LOG(ERROR) << "Columnar dump: row has " << d_put_index << " values but " << d_columns.size() << " columns are declared";
+                }
+            // pad the missing columns so the chunk stays rectangular
+            while (d_put_index < d_columns.size())
+                {
+                    Column& col = d_columns[d_put_index++];
+                    col.data.resize(col.data.size() + col.elem_size, 0);
+                }
+        }
+    d_put_index = 0;
+    d_rows_in_chunk++;
+    if (d_rows_in_chunk >= d_rows_per_chunk)
+        {
+            seal_chunk();
+        }
+}
+
+
+void Columnar_Dump_Writer::seal_chunk()
+{
+    if (d_rows_in_chunk == 0)
+        {
+            return;
+        }
+    std::size_t chunk_size = 4;
+    for (const auto& col : d_columns)
+        {
+            chunk_size += col.data.size();
+        }
+    std::vector<uint8_t> chunk;
+    chunk.reserve(chunk_size);
+    chunk.resize(4);
+    std::memcpy(chunk.data(), &d_rows_in_chunk, 4);
+    for (auto& col : d_columns)
+        {
+            chunk.insert(chunk.end(), col.data.begin(), col.data.end());
+            col.data.clear();  // keeps the capacity for the next chunk
+        }
+    d_rows_in_chunk = 0;
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_pending.size() >= max_pending_chunks)
+        {
+            // the disk cannot keep up; dropping is preferred over stalling
+            // the flowgraph thread, as in async_file_sink
+            const uint64_t dropped = d_dropped_chunks.fetch_add(1) + 1;
+            if (dropped == 1)
+                {
+                    LOG(WARNING) << "Columnar dump: disk cannot keep up, dropping chunks";
+                }
+            return;
+        }
+    d_pending.push_back(std::move(chunk));
+    d_cond.notify_one();
+}
+
+
+void Columnar_Dump_Writer::writer_loop()
+{
+    for (;;)
+        {
+            std::vector<uint8_t> chunk;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait(lock, [this] { return !d_pending.empty() or d_shutdown; });
+                if (d_pending.empty() and d_shutdown)
+                    {
+                        return;
+                    }
+                chunk = std::move(d_pending.front());
+                d_pending.pop_front();
+            }
+            uint32_t chunk_rows = 0;
+            std::memcpy(&chunk_rows, chunk.data(), 4);
+            if (d_rows_per_file > 0 and d_rows_in_file > 0 and d_rows_in_file + chunk_rows > d_rows_per_file)
+                {
+                    // switch to the preopened file between two chunks; the old
+                    // stream is finalized here, off the flowgraph thread
+                    d_file.close();
+                    d_file = std::move(d_next_file);
+                    d_file_index++;
+                    d_rows_in_file = 0;
+                    preopen_next_file();
+                }
+            d_file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+            d_rows_in_file += chunk_rows;
+        }
+}
+
+
+void Columnar_Dump_Writer::close()
+{
+    if (!d_open)
+        {
+            return;
+        }
+    seal_chunk();
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_shutdown = true;
+        d_cond.notify_one();
+    }
+    if (d_writer.joinable())
+        {
+            d_writer.join();
+        }
+    d_file.close();
+    if (d_next_file.is_open())
+        {
+            // discard the preopened rotation target, which holds only a header
+            d_next_file.close();
+            std::remove(rotated_filename(d_file_index + 1).c_str());
+        }
+    d_open = false;
+    if (d_dropped_chunks > 0)
+        {
+            LOG(WARNING) << "Columnar dump closed with " << d_dropped_chunks << " dropped chunks";
+        }
+}
+
+
+uint64_t Columnar_Dump_Writer::dropped_chunks() const
+{
+    return d_dropped_chunks;
+}
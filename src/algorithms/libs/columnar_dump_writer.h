@@ -0,0 +1,151 @@
+/*!
+ * \file columnar_dump_writer.h
+ * \brief Interface of a streaming columnar dump writer with a background
+ * flush thread
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_COLUMNAR_DUMP_WRITER_H
+#define GNSS_SDR_COLUMNAR_DUMP_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Streaming columnar dump writer.
+ *
+ * Alternative to the per-block .mat dump paths, which buffer whole runs in
+ * memory when converting at shutdown. Values are staged row by row into
+ * per-column buffers; every rows_per_chunk rows the buffers are sealed into
+ * an append-only chunk that a background thread flushes to disk, so memory
+ * use is bounded by the chunk size regardless of the run length. Files can
+ * be converted to .mat offline with the columnar_dump_to_mat tool under
+ * src/utils/columnar-dump.
+ *
+ * File layout (all fields little-endian):
+ *   header:  "GSCD", version (u8), codec (u8, 0 = uncompressed),
+ *            column count (u16), rows per chunk (u32), then per column:
+ *            type (u8), name length (u8), name bytes
+ *   chunks:  row count (u32), then the column buffers in declaration order.
+ * A truncated trailing chunk (e.g. after a crash) is ignored by readers.
+ *
+ * When rows_per_file is nonzero the dump rotates deterministically every
+ * rows_per_file rows (rounded up to a whole number of chunks) into files
+ * named <base>_000<ext>, <base>_001<ext>, ... The next file is preopened
+ * with its header already written, so the flush thread switches streams
+ * between two chunks and finalizes the previous file in the background; the
+ * flowgraph-side put()/end_row() path never notices the rotation.
+ */
+class Columnar_Dump_Writer
+{
+public:
+    enum class Column_Type : uint8_t
+    {
+        f32 = 1,
+        f64 = 2,
+        i32 = 3,
+        u32 = 4,
+        i64 = 5,
+        u64 = 6
+    };
+
+    Columnar_Dump_Writer() = default;
+    ~Columnar_Dump_Writer();
+
+    Columnar_Dump_Writer(const Columnar_Dump_Writer&) = delete;  // owns a thread
+    Columnar_Dump_Writer& operator=(const Columnar_Dump_Writer&) = delete;
+
+    //! Declares a column. All columns must be declared before open()
+    void add_column(const std::string& name, Column_Type type);
+
+    //! Writes the file header and starts the flush thread. A nonzero
+    //! rows_per_file enables deterministic rotation into numbered files
+    bool open(const std::string& filename, uint32_t rows_per_chunk = 4096, uint64_t rows_per_file = 0);
+
+    bool is_open() const;
+
+    //! \{ Appends one value to the next column of the current row, in declaration order
+    void put(float value);
+    void put(double value);
+    void put(int32_t value);
+    void put(uint32_t value);
+    void put(int64_t value);
+    void put(uint64_t value);
+    //! \}
+
+    //! Completes the current row; seals a chunk every rows_per_chunk rows
+    void end_row();
+
+    //! Flushes the partial chunk, stops the flush thread and closes the file
+    void close();
+
+    //! Number of chunks dropped because the disk could not keep up
+    uint64_t dropped_chunks() const;
+
+private:
+    struct Column
+    {
+        std::string name;
+        std::vector<uint8_t> data;
+        Column_Type type;
+        uint8_t elem_size;
+    };
+
+    static uint8_t type_size(Column_Type type);
+
+    void append_raw(const void* value, Column_Type type);
+    void seal_chunk();
+    void writer_loop();
+    std::string rotated_filename(uint32_t index) const;
+    void preopen_next_file();
+
+    std::vector<Column> d_columns;
+    std::deque<std::vector<uint8_t>> d_pending;  // sealed chunks awaiting the flush thread
+    std::thread d_writer;
+    mutable std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::ofstream d_file;
+    std::ofstream d_next_file;  // preopened rotation target, header already written
+    std::vector<uint8_t> d_header;
+    std::string d_base_filename;
+    std::atomic<uint64_t> d_dropped_chunks{0};
+    uint64_t d_rows_per_file = 0;  // 0: no rotation
+    uint64_t d_rows_in_file = 0;   // owned by the flush thread after open()
+    uint32_t d_file_index = 0;
+    uint32_t d_rows_per_chunk = 4096;
+    uint32_t d_rows_in_chunk = 0;
+    std::size_t d_put_index = 0;
+    bool d_open = false;
+    bool d_shutdown = false;
+    bool d_type_mismatch_reported = false;
+
+    static const std::size_t max_pending_chunks = 16;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_COLUMNAR_DUMP_WRITER_H
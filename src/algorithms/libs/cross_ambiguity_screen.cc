@@ -0,0 +1,150 @@
+/*!
+ * \file cross_ambiguity_screen.cc
+ * \brief Process-wide screen for cross-correlation false acquisitions.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "cross_ambiguity_screen.h"
+#include "gps_sdr_signal_replica.h"
+#include <array>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+// registry entries not refreshed within this interval are considered stale
+constexpr std::chrono::seconds CROSS_AMBIGUITY_MAX_AGE(2);
+
+// protection assumed for signal pairs without a dedicated table
+constexpr double CROSS_AMBIGUITY_DEFAULT_PROTECTION_DB = 30.0;
+
+std::string make_signal_key(char system, const std::string& signal)
+{
+    return std::string(1, system) + ' ' + signal;
+}
+}  // namespace
+
+
+Cross_Ambiguity_Screen& Cross_Ambiguity_Screen::get_instance()
+{
+    static Cross_Ambiguity_Screen instance;
+    return instance;
+}
+
+
+void Cross_Ambiguity_Screen::report_tracked(char system, const std::string& signal, uint32_t prn, double doppler_hz, double cn0_db_hz)
+{
+    const std::string key = make_signal_key(system, signal) + ' ' + std::to_string(prn);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Tracked_Entry& entry = tracked_[key];
+    entry.doppler_hz = doppler_hz;
+    entry.cn0_db_hz = cn0_db_hz;
+    entry.prn = prn;
+    entry.updated = std::chrono::steady_clock::now();
+}
+
+
+bool Cross_Ambiguity_Screen::is_probable_alias(char system, const std::string& signal, uint32_t prn,
+    double doppler_hz, double code_period_s,
+    double doppler_tolerance_hz, double alias_floor_cn0_db_hz,
+    uint32_t* culprit_prn)
+{
+    if (code_period_s <= 0.0)
+        {
+            return false;
+        }
+    const double line_spacing_hz = 1.0 / code_period_s;
+    const std::string prefix = make_signal_key(system, signal) + ' ';
+    const auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tracked_.begin();
+    while (it != tracked_.end())
+        {
+            if (now - it->second.updated > CROSS_AMBIGUITY_MAX_AGE)
+                {
+                    it = tracked_.erase(it);
+                    continue;
+                }
+            const Tracked_Entry& entry = it->second;
+            if (entry.prn != prn and it->first.compare(0, prefix.size(), prefix) == 0)
+                {
+                    // distance of the candidate Doppler to the nearest
+                    // cross-correlation line of the tracked satellite
+                    const double delta_hz = doppler_hz - entry.doppler_hz;
+                    const double line_offset_hz = std::abs(delta_hz - std::round(delta_hz / line_spacing_hz) * line_spacing_hz);
+                    if (line_offset_hz <= doppler_tolerance_hz)
+                        {
+                            const double leaked_cn0_db_hz = entry.cn0_db_hz - pair_protection_db(system, signal, prn, entry.prn);
+                            if (leaked_cn0_db_hz >= alias_floor_cn0_db_hz)
+                                {
+                                    if (culprit_prn != nullptr)
+                                        {
+                                            *culprit_prn = entry.prn;
+                                        }
+                                    return true;
+                                }
+                        }
+                }
+            ++it;
+        }
+    return false;
+}
+
+
+double Cross_Ambiguity_Screen::pair_protection_db(char system, const std::string& signal, uint32_t prn_a, uint32_t prn_b)
+{
+    // A dedicated table is only built for GPS L1 C/A, whose short code makes
+    // cross-correlation false acquisitions a practical problem; the longer
+    // codes of the other signals get a conservative default
+    if (!(system == 'G' and signal == "1C") or prn_a == 0U or prn_b == 0U or prn_a > 32U or prn_b > 32U)
+        {
+            return CROSS_AMBIGUITY_DEFAULT_PROTECTION_DB;
+        }
+    if (prn_a > prn_b)
+        {
+            std::swap(prn_a, prn_b);
+        }
+    const std::string key = std::to_string(prn_a) + ' ' + std::to_string(prn_b);
+    const auto it = protection_table_.find(key);
+    if (it != protection_table_.end())
+        {
+            return it->second;
+        }
+
+    // Build the pair entry: maximum circular cross-correlation of the two
+    // C/A codes over all relative code phases, at zero Doppler offset
+    constexpr int code_length = 1023;
+    std::array<float, code_length> code_a{};
+    std::array<float, code_length> code_b{};
+    gps_l1_ca_code_gen_float(code_a, static_cast<int32_t>(prn_a), 0U);
+    gps_l1_ca_code_gen_float(code_b, static_cast<int32_t>(prn_b), 0U);
+    double max_xcorr = 0.0;
+    for (int lag = 0; lag < code_length; lag++)
+        {
+            double acc = 0.0;
+            for (int i = 0; i < code_length; i++)
+                {
+                    int j = i + lag;
+                    if (j >= code_length)
+                        {
+                            j -= code_length;
+                        }
+                    acc += static_cast<double>(code_a[i]) * static_cast<double>(code_b[j]);
+                }
+            max_xcorr = std::max(max_xcorr, std::abs(acc));
+        }
+    const double protection_db = 20.0 * std::log10(static_cast<double>(code_length) / max_xcorr);
+    protection_table_[key] = protection_db;
+    return protection_db;
+}
@@ -0,0 +1,99 @@
+/*!
+ * \file cross_ambiguity_screen.h
+ * \brief Process-wide screen for cross-correlation false acquisitions.
+ *
+ * A strong satellite leaks energy into the acquisition grid of every other
+ * PRN of the same signal, on Doppler lines spaced by the code repetition
+ * rate. When such a leaked peak passes the detection threshold, the channel
+ * spins up tracking, fails the lock tests and drops back to acquisition,
+ * wasting more than a second of channel time. This screen keeps a registry
+ * of the signals currently being tracked, fed by the tracking channels, and
+ * lets acquisition check a candidate peak against the strong ones before
+ * declaring it positive: a candidate whose Doppler falls on a
+ * cross-correlation line of a tracked satellite that is strong enough to
+ * leak above the detection floor is rejected as an alias. The per-pair
+ * cross-correlation protection is computed once on first use and cached.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CROSS_AMBIGUITY_SCREEN_H
+#define GNSS_SDR_CROSS_AMBIGUITY_SCREEN_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Registry of tracked signals and cached cross-correlation
+ * protections, used to reject acquisition peaks that are better explained
+ * as aliases of a stronger satellite already being tracked.
+ */
+class Cross_Ambiguity_Screen
+{
+public:
+    static Cross_Ambiguity_Screen& get_instance();
+
+    //! Called by the tracking channels to keep the registry of live signals fresh
+    void report_tracked(char system, const std::string& signal, uint32_t prn, double doppler_hz, double cn0_db_hz);
+
+    /*!
+     * \brief Returns true if the candidate acquisition peak is better
+     * explained as a cross-correlation alias of a satellite currently
+     * tracked on the same signal.
+     *
+     * The candidate is an alias of a tracked satellite when its Doppler sits
+     * within \p doppler_tolerance_hz of a cross-correlation line of that
+     * satellite (lines are spaced by the code repetition rate, the inverse
+     * of \p code_period_s) and the tracked C/N0 minus the cross-correlation
+     * protection of the PRN pair still exceeds \p alias_floor_cn0_db_hz.
+     * On rejection, \p culprit_prn reports the offending satellite.
+     */
+    bool is_probable_alias(char system, const std::string& signal, uint32_t prn,
+        double doppler_hz, double code_period_s,
+        double doppler_tolerance_hz, double alias_floor_cn0_db_hz,
+        uint32_t* culprit_prn);
+
+    Cross_Ambiguity_Screen(const Cross_Ambiguity_Screen&) = delete;
+    Cross_Ambiguity_Screen& operator=(const Cross_Ambiguity_Screen&) = delete;
+
+private:
+    Cross_Ambiguity_Screen() = default;
+    ~Cross_Ambiguity_Screen() = default;
+
+    double pair_protection_db(char system, const std::string& signal, uint32_t prn_a, uint32_t prn_b);
+
+    struct Tracked_Entry
+    {
+        double doppler_hz;
+        double cn0_db_hz;
+        uint32_t prn;
+        std::chrono::steady_clock::time_point updated;
+    };
+
+    std::map<std::string, Tracked_Entry> tracked_;
+    std::map<std::string, double> protection_table_;
+    std::mutex mutex_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CROSS_AMBIGUITY_SCREEN_H
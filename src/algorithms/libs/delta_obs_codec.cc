@@ -0,0 +1,264 @@
+/*!
+ * \file delta_obs_codec.cc
+ * \brief Implementation of the delta + varint codec for observables dumps
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "delta_obs_codec.h"
+#include <glog/logging.h>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+// quantization steps for RX_time, TOW, Carrier Doppler, carrier phase,
+// pseudorange, PRN and the valid flag (see the format description in
+// delta_obs_codec.h)
+const std::array<double, Delta_Obs_Writer::fields_per_channel> field_steps = {
+    1.0e-9, 1.0e-9, 1.0e-4, 1.0e-4, 1.0e-4, 1.0, 1.0};
+
+inline uint64_t zigzag_encode(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzag_decode(uint64_t value)
+{
+    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+}  // namespace
+
+
+Delta_Obs_Writer::~Delta_Obs_Writer()
+{
+    try
+        {
+            close();
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Exception closing delta observables dump: " << e.what();
+        }
+}
+
+
+bool Delta_Obs_Writer::open(const std::string& filename, uint16_t nchannels, uint32_t keyframe_interval)
+{
+    if (d_file.is_open() or nchannels == 0)
+        {
+            return false;
+        }
+    d_file.open(filename, std::ios::out | std::ios::binary);
+    if (!d_file.is_open())
+        {
+            return false;
+        }
+    d_nchannels = nchannels;
+    d_keyframe_interval = std::max(keyframe_interval, 1U);
+    d_epochs_since_keyframe = 0;
+    d_epochs_written = 0;
+    d_previous.assign(static_cast<std::size_t>(d_nchannels) * fields_per_channel, 0);
+
+    const uint8_t version = 1;
+    const uint8_t num_fields = fields_per_channel;
+    d_file.write("GSDO", 4);
+    d_file.write(reinterpret_cast<const char*>(&version), 1);
+    d_file.write(reinterpret_cast<const char*>(&num_fields), 1);
+    d_file.write(reinterpret_cast<const char*>(&d_nchannels), 2);
+    d_file.write(reinterpret_cast<const char*>(&d_keyframe_interval), 4);
+    for (const double step : field_steps)
+        {
+            d_file.write(reinterpret_cast<const char*>(&step), sizeof(double));
+        }
+    return d_file.good();
+}
+
+
+bool Delta_Obs_Writer::is_open() const
+{
+    return d_file.is_open();
+}
+
+
+void Delta_Obs_Writer::put_varint(int64_t value)
+{
+    uint64_t u = zigzag_encode(value);
+    do
+        {
+            uint8_t byte = u & 0x7FU;
+            u >>= 7;
+            if (u != 0)
+                {
+                    byte |= 0x80U;
+                }
+            d_epoch_buffer.push_back(byte);
+        }
+    while (u != 0);
+}
+
+
+bool Delta_Obs_Writer::write_epoch(const std::vector<double>& row)
+{
+    if (!d_file.is_open() or row.size() != d_previous.size())
+        {
+            return false;
+        }
+    const bool keyframe = (d_epochs_since_keyframe == 0);
+    d_epoch_buffer.clear();
+    d_epoch_buffer.push_back(keyframe ? 1 : 0);
+    for (std::size_t i = 0; i < row.size(); i++)
+        {
+            const double step = field_steps[i % fields_per_channel];
+            const auto q = static_cast<int64_t>(std::llround(row[i] / step));
+            put_varint(keyframe ? q : q - d_previous[i]);
+            d_previous[i] = q;
+        }
+    d_file.write(reinterpret_cast<const char*>(d_epoch_buffer.data()), static_cast<std::streamsize>(d_epoch_buffer.size()));
+    d_epochs_written++;
+    d_epochs_since_keyframe++;
+    if (d_epochs_since_keyframe >= d_keyframe_interval)
+        {
+            d_epochs_since_keyframe = 0;
+        }
+    return d_file.good();
+}
+
+
+uint64_t Delta_Obs_Writer::epochs_written() const
+{
+    return d_epochs_written;
+}
+
+
+void Delta_Obs_Writer::close()
+{
+    if (d_file.is_open())
+        {
+            d_file.close();
+        }
+}
+
+
+bool Delta_Obs_Reader::open(const std::string& filename)
+{
+    if (d_file.is_open())
+        {
+            return false;
+        }
+    d_file.open(filename, std::ios::in | std::ios::binary);
+    if (!d_file.is_open())
+        {
+            return false;
+        }
+    std::array<char, 4> magic{};
+    uint8_t version = 0;
+    uint8_t num_fields = 0;
+    uint32_t keyframe_interval = 0;
+    d_file.read(magic.data(), 4);
+    d_file.read(reinterpret_cast<char*>(&version), 1);
+    d_file.read(reinterpret_cast<char*>(&num_fields), 1);
+    d_file.read(reinterpret_cast<char*>(&d_nchannels), 2);
+    d_file.read(reinterpret_cast<char*>(&keyframe_interval), 4);
+    if (!d_file.good() or std::memcmp(magic.data(), "GSDO", 4) != 0 or version != 1 or
+        num_fields != Delta_Obs_Writer::fields_per_channel or d_nchannels == 0)
+        {
+            LOG(WARNING) << filename << " is not a readable delta observables dump";
+            close();
+            return false;
+        }
+    d_steps.resize(num_fields);
+    for (auto& step : d_steps)
+        {
+            d_file.read(reinterpret_cast<char*>(&step), sizeof(double));
+        }
+    if (!d_file.good())
+        {
+            close();
+            return false;
+        }
+    d_previous.assign(static_cast<std::size_t>(d_nchannels) * num_fields, 0);
+    return true;
+}
+
+
+bool Delta_Obs_Reader::is_open() const
+{
+    return d_file.is_open();
+}
+
+
+uint16_t Delta_Obs_Reader::nchannels() const
+{
+    return d_nchannels;
+}
+
+
+bool Delta_Obs_Reader::get_varint(int64_t* value)
+{
+    uint64_t u = 0;
+    int shift = 0;
+    for (;;)
+        {
+            const int byte = d_file.get();
+            if (byte == std::ifstream::traits_type::eof() or shift > 63)
+                {
+                    return false;
+                }
+            u |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                {
+                    break;
+                }
+            shift += 7;
+        }
+    *value = zigzag_decode(u);
+    return true;
+}
+
+
+bool Delta_Obs_Reader::read_epoch(std::vector<double>& row)
+{
+    if (!d_file.is_open())
+        {
+            return false;
+        }
+    const int marker = d_file.get();
+    if (marker == std::ifstream::traits_type::eof())
+        {
+            return false;
+        }
+    row.resize(d_previous.size());
+    for (std::size_t i = 0; i < d_previous.size(); i++)
+        {
+            int64_t v = 0;
+            if (!get_varint(&v))
+                {
+                    // truncated trailing epoch
+                    return false;
+                }
+            const int64_t q = (marker == 1) ? v : d_previous[i] + v;
+            d_previous[i] = q;
+            row[i] = static_cast<double>(q) * d_steps[i % d_steps.size()];
+        }
+    return true;
+}
+
+
+void Delta_Obs_Reader::close()
+{
+    if (d_file.is_open())
+        {
+            d_file.close();
+        }
+}
@@ -0,0 +1,118 @@
+/*!
+ * \file delta_obs_codec.h
+ * \brief Delta + varint codec for high-rate observables dumps
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_DELTA_OBS_CODEC_H
+#define GNSS_SDR_DELTA_OBS_CODEC_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_common_libs
+ * \{ */
+
+/*!
+ * \brief Compressed recording format for the observables dump.
+ *
+ * The flat observables dump stores seven doubles per channel per epoch.
+ * At high observable rates (e.g. 100 Hz experiments) the quantities
+ * evolve smoothly, so consecutive epochs differ in a few low-order
+ * digits only. This codec quantizes each field to a fixed resolution,
+ * delta-encodes it against the previous epoch and stores the deltas as
+ * ZigZag LEB128 varints, cutting the dump volume roughly an order of
+ * magnitude. A keyframe with absolute values is emitted periodically so
+ * a truncated or damaged recording loses at most one keyframe interval.
+ *
+ * File layout (GSDO, version 1, little-endian):
+ *  - header: magic "GSDO", version (uint8), fields per channel (uint8),
+ *    channel count (uint16), keyframe interval in epochs (uint32),
+ *    then one float64 quantization step per field
+ *  - epochs: marker byte (1 = keyframe with absolute values,
+ *    0 = delta against the previous epoch) followed by
+ *    channels x fields ZigZag LEB128 varints in channel-major order
+ *
+ * Decoded values are the quantized ones: field value = varint * step.
+ * The field order and quantization steps match the flat dump columns:
+ * RX_time [1 ns], TOW [1 ns], Carrier Doppler [0.1 mHz], carrier phase
+ * [1e-4 cycles], pseudorange [0.1 mm], PRN [1], valid flag [1].
+ */
+class Delta_Obs_Writer
+{
+public:
+    Delta_Obs_Writer() = default;
+    ~Delta_Obs_Writer();
+    Delta_Obs_Writer(const Delta_Obs_Writer&) = delete;
+    Delta_Obs_Writer& operator=(const Delta_Obs_Writer&) = delete;
+
+    static const uint8_t fields_per_channel = 7;
+
+    //! Create the dump file and write its header. Returns true on success
+    bool open(const std::string& filename, uint16_t nchannels, uint32_t keyframe_interval = 100);
+    bool is_open() const;
+    //! Append one epoch. row holds nchannels x fields_per_channel doubles, channel-major
+    bool write_epoch(const std::vector<double>& row);
+    uint64_t epochs_written() const;
+    void close();
+
+private:
+    void put_varint(int64_t value);
+
+    std::ofstream d_file;
+    std::vector<int64_t> d_previous;
+    std::vector<uint8_t> d_epoch_buffer;
+    uint64_t d_epochs_written = 0;
+    uint32_t d_keyframe_interval = 100;
+    uint32_t d_epochs_since_keyframe = 0;
+    uint16_t d_nchannels = 0;
+};
+
+
+/*!
+ * \brief Reads dumps produced by Delta_Obs_Writer epoch by epoch.
+ */
+class Delta_Obs_Reader
+{
+public:
+    Delta_Obs_Reader() = default;
+
+    //! Open a GSDO file and parse its header. Returns true on success
+    bool open(const std::string& filename);
+    bool is_open() const;
+    uint16_t nchannels() const;
+    /*!
+     * Decode the next epoch into row (resized to nchannels x fields per
+     * channel, channel-major). Returns false at end of file or on a
+     * truncated trailing epoch
+     */
+    bool read_epoch(std::vector<double>& row);
+    void close();
+
+private:
+    bool get_varint(int64_t* value);
+
+    std::ifstream d_file;
+    std::vector<int64_t> d_previous;
+    std::vector<double> d_steps;
+    uint16_t d_nchannels = 0;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_DELTA_OBS_CODEC_H
@@ -0,0 +1,144 @@
+/*!
+ * \file dump_budget.cc
+ * \brief Implementation of a process-wide byte budget for the block dump paths
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "dump_budget.h"
+#include <glog/logging.h>
+#include <map>
+#include <mutex>
+
+namespace
+{
+uint64_t budget_ = 0;       // 0 = enforcement disabled
+uint64_t block_quota_ = 0;  // 0 = no per-block quota
+uint64_t reserved_ = 0;
+std::map<const void*, uint64_t> reservations_;
+
+std::mutex& budget_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+}  // namespace
+
+
+void Dump_Budget::configure(uint64_t budget_bytes, uint64_t block_quota_bytes)
+{
+    std::lock_guard<std::mutex> lock(budget_mutex());
+    budget_ = budget_bytes;
+    block_quota_ = block_quota_bytes;
+    if (budget_ > 0)
+        {
+            LOG(INFO) << "Dump budget set to " << budget_ << " bytes ("
+                      << block_quota_ << " bytes per block)";
+        }
+}
+
+
+Dump_Budget::Grant Dump_Budget::request(const void* owner, const std::string& subsystem, size_t resident_bytes)
+{
+    std::lock_guard<std::mutex> lock(budget_mutex());
+    // a re-request (e.g. after a block reconfiguration) replaces the
+    // previous reservation instead of accumulating
+    const auto previous = reservations_.find(owner);
+    if (previous != reservations_.end())
+        {
+            reserved_ -= previous->second;
+            reservations_.erase(previous);
+        }
+    if (budget_ == 0)
+        {
+            reservations_[owner] = resident_bytes;
+            reserved_ += resident_bytes;
+            return Grant{true, 1};
+        }
+
+    // downgrade by powers of two until the request fits both the per-block
+    // quota and the remaining global budget
+    const uint64_t remaining = (budget_ > reserved_) ? (budget_ - reserved_) : 0;
+    uint64_t effective = resident_bytes;
+    uint32_t decimation = 1;
+    while (((block_quota_ > 0 and effective > block_quota_) or (effective > remaining)) and (decimation < max_decimation))
+        {
+            decimation *= 2;
+            effective = resident_bytes / decimation;
+        }
+
+    if ((block_quota_ > 0 and effective > block_quota_) or (effective > remaining) or (remaining == 0))
+        {
+            LOG(WARNING) << subsystem << " dump disabled: " << resident_bytes
+                         << " bytes requested but only " << remaining
+                         << " bytes of the dump budget remain";
+            return Grant{false, 0};
+        }
+
+    reservations_[owner] = effective;
+    reserved_ += effective;
+    if (decimation > 1)
+        {
+            LOG(WARNING) << subsystem << " dump downgraded to 1/" << decimation
+                         << " of the records to fit the dump budget ("
+                         << effective << " of " << resident_bytes << " bytes granted)";
+        }
+    return Grant{true, decimation};
+}
+
+
+void Dump_Budget::release(const void* owner)
+{
+    std::lock_guard<std::mutex> lock(budget_mutex());
+    const auto it = reservations_.find(owner);
+    if (it != reservations_.end())
+        {
+            reserved_ -= it->second;
+            reservations_.erase(it);
+        }
+}
+
+
+bool Dump_Budget::mat_conversion_allowed(size_t file_bytes)
+{
+    std::lock_guard<std::mutex> lock(budget_mutex());
+    if (budget_ == 0)
+        {
+            return true;
+        }
+    // the conversion loads the whole dump plus the matio staging buffers
+    const uint64_t needed = static_cast<uint64_t>(file_bytes) * 2;
+    const uint64_t remaining = (budget_ > reserved_) ? (budget_ - reserved_) : 0;
+    if (needed > remaining)
+        {
+            LOG(WARNING) << ".mat conversion skipped: it needs about " << needed
+                         << " bytes but only " << remaining
+                         << " bytes of the dump budget remain. The raw dump "
+                            "file is kept for offline conversion";
+            return false;
+        }
+    return true;
+}
+
+
+uint64_t Dump_Budget::budget_bytes()
+{
+    std::lock_guard<std::mutex> lock(budget_mutex());
+    return budget_;
+}
+
+
+uint64_t Dump_Budget::reserved_bytes()
+{
+    std::lock_guard<std::mutex> lock(budget_mutex());
+    return reserved_;
+}
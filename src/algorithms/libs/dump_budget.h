@@ -0,0 +1,93 @@
+/*!
+ * \file dump_budget.h
+ * \brief Interface of a process-wide byte budget for the block dump paths
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * Every block allocates its dump buffering independently, so enabling the
+ * dump options on a many-channel configuration can multiply the memory use
+ * of the receiver without warning. This manager holds a global budget and a
+ * per-block quota taken from the configuration; blocks ask for a grant
+ * before setting up their dump path, and the manager downgrades the grant
+ * (record decimation, smaller buffers, or disabling the dump) instead of
+ * letting observability exhaust the memory of a production unit.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_DUMP_BUDGET_H
+#define GNSS_SDR_DUMP_BUDGET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Process-wide byte budget for the block dump paths.
+ *
+ * configure() is called once from the flowgraph with the configured budget;
+ * blocks call request() while setting up their dump path and honor the
+ * returned grant. All methods are thread safe; requests happen at block
+ * construction only, so the lock is uncontended during signal processing.
+ */
+class Dump_Budget
+{
+public:
+    //! What a block is allowed to dump after budget enforcement
+    struct Grant
+    {
+        bool enabled;         //!< false: the dump must stay disabled
+        uint32_t decimation;  //!< log one of every decimation records (1 = full rate)
+    };
+
+    /*!
+     * \brief Sets the global dump budget and the per-block quota, in bytes.
+     * A budget of 0 disables enforcement (every request is fully granted).
+     */
+    static void configure(uint64_t budget_bytes, uint64_t block_quota_bytes);
+
+    /*!
+     * \brief Reserves dump buffering for a block. \a resident_bytes is the
+     * buffering the dump path keeps allocated while running. When the quota
+     * or the remaining budget would be exceeded, the grant carries a
+     * power-of-two decimation factor the block must apply (shrinking its
+     * buffers accordingly); if even the strongest downgrade does not fit,
+     * the dump is denied. Each downgrade is logged.
+     */
+    static Grant request(const void* owner, const std::string& subsystem, size_t resident_bytes);
+
+    //! Returns the reservation of the given owner (call from the destructor)
+    static void release(const void* owner);
+
+    /*!
+     * \brief Checks whether an end-of-run .mat conversion, which loads the
+     * whole dump into memory, fits in the remaining budget. Blocks skip the
+     * conversion (leaving the raw dump for offline processing) when it does
+     * not.
+     */
+    static bool mat_conversion_allowed(size_t file_bytes);
+
+    static uint64_t budget_bytes();
+    static uint64_t reserved_bytes();
+
+private:
+    static const uint32_t max_decimation = 64;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_DUMP_BUDGET_H
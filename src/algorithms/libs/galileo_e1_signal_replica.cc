@@ -21,7 +21,9 @@
 #include "gnss_signal_replica.h"
 #include <cmath>
 #include <cstddef>  // for size_t
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -115,29 +117,90 @@ void galileo_e1_gen_float(own::span<float> dest, own::span<int> prn, const std::
     const float beta = std::sqrt(1.0F / 11.0F);
     const std::string galileo_signal = signal_id.data();
 
-    std::vector<int32_t> sinboc_11(codeLength);
-    std::vector<int32_t> sinboc_61(codeLength);
-
-    galileo_e1_sinboc_11_gen_int(sinboc_11, prn);  // generate sinboc(1,1) 12 samples per chip
-    galileo_e1_sinboc_61_gen_int(sinboc_61, prn);  // generate sinboc(6,1) 12 samples per chip
+    constexpr uint32_t length_in = GALILEO_E1_B_CODE_LENGTH_CHIPS;
+    const auto period = static_cast<uint32_t>(codeLength / length_in);
 
+    float data_pilot_sign;
     if (galileo_signal.rfind("1B") != std::string::npos && galileo_signal.length() >= 2)
         {
-            for (size_t i = 0; i < codeLength; i++)
+            data_pilot_sign = 1.0F;  // the data component adds the sinBOC(6,1) term
+        }
+    else if (galileo_signal.rfind("1C") != std::string::npos && galileo_signal.length() >= 2)
+        {
+            data_pilot_sign = -1.0F;  // the pilot component subtracts it
+        }
+    else
+        {
+            return;
+        }
+
+    // The CBOC subcarrier repeats every chip, so the combination of sinboc(1,1)
+    // and sinboc(6,1) is evaluated once into a single-chip tile of 12 samples
+    // and then scaled by each chip value
+    std::vector<float> tile(period);
+    for (uint32_t j = 0; j < period; j++)
+        {
+            const float sinboc_11 = (j < period / 2) ? 1.0F : -1.0F;
+            const float sinboc_61 = (j % 2 == 0) ? 1.0F : -1.0F;
+            tile[j] = alpha * sinboc_11 + data_pilot_sign * beta * sinboc_61;
+        }
+
+    for (uint32_t i = 0; i < length_in; i++)
+        {
+            for (uint32_t j = 0; j < period; j++)
                 {
-                    dest[i] = alpha * static_cast<float>(sinboc_11[i]) +
-                              beta * static_cast<float>(sinboc_61[i]);
+                    dest[i * period + j] = static_cast<float>(prn[i]) * tile[j];
                 }
         }
-    else if (galileo_signal.rfind("1C") != std::string::npos && galileo_signal.length() >= 2)
+}
+
+
+namespace
+{
+/*
+ * Process-wide cache of the chip-rate E1 waveforms (12 samples per chip for
+ * CBOC, 2 for sinboc(1,1)). Channel retargeting regenerates replicas for the
+ * same satellites over and over, so each (signal, PRN, waveform) combination
+ * is synthesized only once per process. Entries are immutable once inserted
+ * and map nodes are stable, so the returned reference outlives the lock.
+ */
+const std::vector<float>& galileo_e1_cached_waveform(const std::array<char, 3>& signal_id, bool cboc, uint32_t prn)
+{
+    static std::map<uint32_t, std::vector<float>> waveform_cache;
+    static std::mutex waveform_cache_mutex;
+    const std::string galileo_signal = signal_id.data();
+    const bool is_pilot = galileo_signal.rfind("1C") != std::string::npos && galileo_signal.length() >= 2;
+    const uint32_t key = (prn << 2U) | (static_cast<uint32_t>(cboc) << 1U) | static_cast<uint32_t>(is_pilot);
+
+    std::lock_guard<std::mutex> lock(waveform_cache_mutex);
+    auto it = waveform_cache.find(key);
+    if (it == waveform_cache.end())
         {
-            for (size_t i = 0; i < codeLength; i++)
+            const int32_t samplesPerChip = (cboc == true) ? 12 : 2;
+            const uint32_t codeLength = samplesPerChip * GALILEO_E1_B_CODE_LENGTH_CHIPS;
+            std::vector<int32_t> primary_code_E1_chips(static_cast<int32_t>(GALILEO_E1_B_CODE_LENGTH_CHIPS));
+            galileo_e1_code_gen_int(primary_code_E1_chips, signal_id, prn);  // generate Galileo E1 code, 1 sample per chip
+
+            std::vector<float> signal_E1(codeLength);
+            if (cboc == true)
                 {
-                    dest[i] = alpha * static_cast<float>(sinboc_11[i]) -
-                              beta * static_cast<float>(sinboc_61[i]);
+                    galileo_e1_gen_float(signal_E1, primary_code_E1_chips, signal_id);  // generate cboc 12 samples per chip
                 }
+            else
+                {
+                    std::vector<int32_t> signal_E1_int(static_cast<int32_t>(codeLength));
+                    galileo_e1_sinboc_11_gen_int(signal_E1_int, primary_code_E1_chips);  // generate sinboc(1,1) 2 samples per chip
+
+                    for (uint32_t ii = 0; ii < codeLength; ++ii)
+                        {
+                            signal_E1[ii] = static_cast<float>(signal_E1_int[ii]);
+                        }
+                }
+            it = waveform_cache.emplace(key, std::move(signal_E1)).first;
         }
+    return it->second;
 }
+}  // namespace
 
 
 void galileo_e1_code_gen_float_sampled(own::span<float> dest, const std::array<char, 3>& signal_id,
@@ -146,31 +209,11 @@ void galileo_e1_code_gen_float_sampled(own::span<float> dest, const std::array<c
 {
     constexpr int32_t codeFreqBasis = GALILEO_E1_CODE_CHIP_RATE_CPS;  // chips per second
     const int32_t samplesPerChip = (cboc == true) ? 12 : 2;
-    const uint32_t codeLength = samplesPerChip * GALILEO_E1_B_CODE_LENGTH_CHIPS;
     const std::string galileo_signal = signal_id.data();
     auto samplesPerCode = static_cast<uint32_t>(static_cast<double>(sampling_freq) / (static_cast<double>(codeFreqBasis) / GALILEO_E1_B_CODE_LENGTH_CHIPS));
     const uint32_t delay = ((static_cast<int32_t>(GALILEO_E1_B_CODE_LENGTH_CHIPS) - chip_shift) % static_cast<int32_t>(GALILEO_E1_B_CODE_LENGTH_CHIPS)) * samplesPerCode / GALILEO_E1_B_CODE_LENGTH_CHIPS;
 
-    std::vector<int32_t> primary_code_E1_chips(static_cast<int32_t>(GALILEO_E1_B_CODE_LENGTH_CHIPS));
-
-    galileo_e1_code_gen_int(primary_code_E1_chips, signal_id, prn);  // generate Galileo E1 code, 1 sample per chip
-
-    std::vector<float> signal_E1(codeLength);
-
-    if (cboc == true)
-        {
-            galileo_e1_gen_float(signal_E1, primary_code_E1_chips, signal_id);  // generate cboc 12 samples per chip
-        }
-    else
-        {
-            std::vector<int32_t> signal_E1_int(static_cast<int32_t>(codeLength));
-            galileo_e1_sinboc_11_gen_int(signal_E1_int, primary_code_E1_chips);  // generate sinboc(1,1) 2 samples per chip
-
-            for (uint32_t ii = 0; ii < codeLength; ++ii)
-                {
-                    signal_E1[ii] = static_cast<float>(signal_E1_int[ii]);
-                }
-        }
+    std::vector<float> signal_E1 = galileo_e1_cached_waveform(signal_id, cboc, prn);
 
     if (sampling_freq != samplesPerChip * codeFreqBasis)
         {
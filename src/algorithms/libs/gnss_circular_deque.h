@@ -19,6 +19,7 @@
 #define GNSS_SDR_CIRCULAR_DEQUE_H
 
 #include <boost/circular_buffer.hpp>
+#include <memory>
 #include <vector>
 
 /** \addtogroup Algorithms_Library
@@ -27,12 +28,13 @@
  * \{ */
 
 
-template <class T>
+template <class T, class Alloc = std::allocator<T>>
 class Gnss_circular_deque
 {
 public:
     Gnss_circular_deque();                                            //!< Default constructor
     Gnss_circular_deque(unsigned int max_size, unsigned int nchann);  //!< nchann = number of channels; max_size = channel capacity
+    Gnss_circular_deque(unsigned int max_size, unsigned int nchann, const Alloc& alloc);  //!< As above, backing each channel with the given allocator
     unsigned int size(unsigned int ch) const;                         //!< Returns the number of available elements in a channel
     T& at(unsigned int ch, unsigned int pos);                         //!< Returns a reference to an element with bound checking
     const T& get(unsigned int ch, unsigned int pos) const;            //!< Returns a const reference to an element without bound checking
@@ -45,96 +47,105 @@ public:
     void reset();                                                     //!< Removes all the channels (Sets nchann to 0)
 
 private:
-    std::vector<boost::circular_buffer<T>> d_data;
+    std::vector<boost::circular_buffer<T, Alloc>> d_data;
+    Alloc d_alloc;
 };
 
 
-template <class T>
-Gnss_circular_deque<T>::Gnss_circular_deque()
+template <class T, class Alloc>
+Gnss_circular_deque<T, Alloc>::Gnss_circular_deque()
 {
     reset();
 }
 
 
-template <class T>
-Gnss_circular_deque<T>::Gnss_circular_deque(unsigned int max_size, unsigned int nchann)
+template <class T, class Alloc>
+Gnss_circular_deque<T, Alloc>::Gnss_circular_deque(unsigned int max_size, unsigned int nchann)
 {
     reset(max_size, nchann);
 }
 
 
-template <class T>
-unsigned int Gnss_circular_deque<T>::size(unsigned int ch) const
+template <class T, class Alloc>
+Gnss_circular_deque<T, Alloc>::Gnss_circular_deque(unsigned int max_size, unsigned int nchann, const Alloc& alloc)
+    : d_alloc(alloc)
+{
+    reset(max_size, nchann);
+}
+
+
+template <class T, class Alloc>
+unsigned int Gnss_circular_deque<T, Alloc>::size(unsigned int ch) const
 {
     return d_data[ch].size();
 }
 
 
-template <class T>
-T& Gnss_circular_deque<T>::back(unsigned int ch)
+template <class T, class Alloc>
+T& Gnss_circular_deque<T, Alloc>::back(unsigned int ch)
 {
     return d_data[ch].back();
 }
 
 
-template <class T>
-T& Gnss_circular_deque<T>::front(unsigned int ch)
+template <class T, class Alloc>
+T& Gnss_circular_deque<T, Alloc>::front(unsigned int ch)
 {
     return d_data[ch].front();
 }
 
 
-template <class T>
-T& Gnss_circular_deque<T>::at(unsigned int ch, unsigned int pos)
+template <class T, class Alloc>
+T& Gnss_circular_deque<T, Alloc>::at(unsigned int ch, unsigned int pos)
 {
     return d_data.at(ch).at(pos);
 }
 
 
-template <class T>
-const T& Gnss_circular_deque<T>::get(unsigned int ch, unsigned int pos) const
+template <class T, class Alloc>
+const T& Gnss_circular_deque<T, Alloc>::get(unsigned int ch, unsigned int pos) const
 {
     return d_data[ch][pos];
 }
 
 
-template <class T>
-void Gnss_circular_deque<T>::clear(unsigned int ch)
+template <class T, class Alloc>
+void Gnss_circular_deque<T, Alloc>::clear(unsigned int ch)
 {
     d_data[ch].clear();
 }
 
 
-template <class T>
-void Gnss_circular_deque<T>::reset(unsigned int max_size, unsigned int nchann)
+template <class T, class Alloc>
+void Gnss_circular_deque<T, Alloc>::reset(unsigned int max_size, unsigned int nchann)
 {
     d_data.clear();
     if (max_size > 0 and nchann > 0)
         {
             for (unsigned int i = 0; i < nchann; i++)
                 {
-                    d_data.push_back(boost::circular_buffer<T>(max_size));
+                    d_data.push_back(boost::circular_buffer<T, Alloc>(max_size, d_alloc));
                 }
         }
 }
 
 
-template <class T>
-void Gnss_circular_deque<T>::reset()
+template <class T, class Alloc>
+void Gnss_circular_deque<T, Alloc>::reset()
 {
     d_data.clear();
 }
 
 
-template <class T>
-void Gnss_circular_deque<T>::pop_front(unsigned int ch)
+template <class T, class Alloc>
+void Gnss_circular_deque<T, Alloc>::pop_front(unsigned int ch)
 {
     d_data[ch].pop_front();
 }
 
 
-template <class T>
-void Gnss_circular_deque<T>::push_back(unsigned int ch, const T& new_data)
+template <class T, class Alloc>
+void Gnss_circular_deque<T, Alloc>::push_back(unsigned int ch, const T& new_data)
 {
     d_data[ch].push_back(new_data);
 }
@@ -0,0 +1,81 @@
+/*!
+ * \file gnss_packed_code.cc
+ * \brief Bit-packed storage of binary PRN codes with on-the-fly expansion.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_packed_code.h"
+#include "gps_sdr_signal_replica.h"
+#include <array>
+
+const auto AUX_CEIL = [](float x) { return static_cast<int32_t>(static_cast<int64_t>((x) + 1)); };
+
+
+Gnss_Packed_Code::Gnss_Packed_Code(own::span<const int32_t> chips)
+    : d_words((chips.size() + 63) / 64, 0ULL),
+      d_length(static_cast<uint32_t>(chips.size()))
+{
+    for (uint32_t ii = 0; ii < d_length; ++ii)
+        {
+            if (chips[ii] > 0)
+                {
+                    d_words[ii >> 6U] |= (1ULL << (ii & 63U));
+                }
+        }
+}
+
+
+void Gnss_Packed_Code::expand_complex_sampled(own::span<std::complex<float>> dest, int32_t chip_rate_cps, int32_t sampling_freq) const
+{
+    // Same digitizing semantics as the complex sampled replica generators:
+    // the number of samples per code period is rounded towards zero.
+    const auto code_length = static_cast<int32_t>(d_length);
+    const float tc = 1.0F / static_cast<float>(chip_rate_cps);   // chip period in sec
+    const float ts = 1.0F / static_cast<float>(sampling_freq);   // sampling period in sec
+    const auto samplesPerCode = static_cast<int32_t>(static_cast<double>(sampling_freq) / (static_cast<double>(chip_rate_cps) / static_cast<double>(code_length)));
+    int32_t codeValueIndex;
+    float aux;
+
+    for (int32_t i = 0; i < samplesPerCode; i++)
+        {
+            aux = (ts * (static_cast<float>(i) + 1)) / tc;
+            codeValueIndex = AUX_CEIL(aux) - 1;
+            if (i == samplesPerCode - 1)
+                {
+                    // Correct the last index (due to number rounding issues)
+                    codeValueIndex = code_length - 1;
+                }
+            dest[i] = std::complex<float>(0.0F, chip(static_cast<uint32_t>(codeValueIndex)));
+        }
+}
+
+
+Gnss_Code_Table& Gnss_Code_Table::get_instance()
+{
+    static Gnss_Code_Table instance;
+    return instance;
+}
+
+
+const Gnss_Packed_Code& Gnss_Code_Table::gps_l1_ca(uint32_t prn)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    auto it = d_gps_l1_ca.find(prn);
+    if (it == d_gps_l1_ca.end())
+        {
+            std::array<int32_t, 1023> ca_code_int{};
+            gps_l1_ca_code_gen_int(ca_code_int, static_cast<int32_t>(prn), 0);
+            it = d_gps_l1_ca.emplace(prn, Gnss_Packed_Code(own::span<const int32_t>(ca_code_int.data(), ca_code_int.size()))).first;
+        }
+    return it->second;
+}
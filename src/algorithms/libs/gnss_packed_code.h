@@ -0,0 +1,109 @@
+/*!
+ * \file gnss_packed_code.h
+ * \brief Bit-packed storage of binary PRN codes with on-the-fly expansion.
+ *
+ * The signal replica generators materialize one float (or complex float)
+ * per chip per channel, so retargeting a channel regenerates and stores
+ * the full code again. This class keeps a binary code packed at one bit
+ * per chip and expands it directly into the destination buffer at the
+ * requested sampling frequency, so the whole code universe can stay
+ * resident in a few kilobytes and retargeting never regenerates chips.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_PACKED_CODE_H
+#define GNSS_SDR_GNSS_PACKED_CODE_H
+
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+#if HAS_STD_SPAN
+#include <span>
+namespace own = std;
+#else
+#include <gsl/gsl>
+namespace own = gsl;
+#endif
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief A binary (+1/-1) PRN code stored at one bit per chip.
+ */
+class Gnss_Packed_Code
+{
+public:
+    Gnss_Packed_Code() = default;
+
+    //! Packs a +1/-1 chip sequence at one bit per chip
+    explicit Gnss_Packed_Code(own::span<const int32_t> chips);
+
+    //! Number of chips in the code
+    inline uint32_t length() const
+    {
+        return d_length;
+    }
+
+    //! Value of the chip at \p index (+1.0 or -1.0)
+    inline float chip(uint32_t index) const
+    {
+        return ((d_words[index >> 6U] >> (index & 63U)) & 1U) != 0U ? 1.0F : -1.0F;
+    }
+
+    /*!
+     * \brief Expands the packed chips into a complex replica sampled at
+     * \p sampling_freq, one code period long, without materializing the
+     * unpacked code. The chips go on the imaginary axis, as the complex
+     * replica generators do.
+     */
+    void expand_complex_sampled(own::span<std::complex<float>> dest, int32_t chip_rate_cps, int32_t sampling_freq) const;
+
+private:
+    std::vector<uint64_t> d_words;
+    uint32_t d_length = 0;
+};
+
+
+/*!
+ * \brief Process-wide read-only table of packed PRN codes, generated on
+ * first use and shared by all channels.
+ */
+class Gnss_Code_Table
+{
+public:
+    static Gnss_Code_Table& get_instance();
+
+    //! Packed GPS L1 C/A (or SBAS L1) code for the given PRN
+    const Gnss_Packed_Code& gps_l1_ca(uint32_t prn);
+
+    Gnss_Code_Table(const Gnss_Code_Table&) = delete;
+    Gnss_Code_Table& operator=(const Gnss_Code_Table&) = delete;
+
+private:
+    Gnss_Code_Table() = default;
+    ~Gnss_Code_Table() = default;
+
+    std::map<uint32_t, Gnss_Packed_Code> d_gps_l1_ca;
+    std::mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_PACKED_CODE_H
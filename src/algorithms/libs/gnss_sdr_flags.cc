@@ -47,6 +47,17 @@ DEFINE_string(signal_source, "-",
 
 DEFINE_bool(rf_shutdown, true, "If set to false, AD9361 RF channels are not shut down when exiting the program. Useful to leave the AD9361 configured and running.");
 
+DEFINE_string(batch_manifest, "-",
+    "If defined, path to a manifest with one capture file per line. Enables batch mode: every capture is processed with the configured receiver, several flowgraphs run concurrently in the same process.");
+
+DEFINE_string(batch_results, "./batch_results.csv", "Path to the consolidated batch results file (CSV, one row per capture).");
+
+DEFINE_int32(batch_jobs, 2, "Maximum number of concurrent flowgraphs in batch mode.");
+
+DEFINE_int32(batch_mem_budget_mb, 0, "Memory budget for concurrent batch jobs, in MB. Jobs wait until their footprint estimate fits. Set to 0 for no limit.");
+
+DEFINE_int32(batch_job_mem_mb, 512, "Default per-job memory footprint estimate in batch mode, in MB. A manifest line can override it with mem_mb=<value>.");
+
 DEFINE_int32(doppler_max, 0, "If defined, sets the maximum Doppler value in the search grid, in Hz (overrides the configuration file).");
 
 DEFINE_int32(doppler_step, 0, "If defined, sets the frequency step in the search grid, in Hz (overrides the configuration file).");
@@ -118,6 +129,29 @@ static bool ValidateSignalSource(const char* flagname, const std::string& value)
     return false;
 }
 
+static bool ValidateBatchManifest(const char* flagname, const std::string& value)
+{
+    if (fs::exists(value) or value == "-")
+        {  // value is ok
+            return true;
+        }
+    std::cout << "Invalid value for flag -" << flagname << ". The file '" << value << "' does not exist.\n";
+    std::cout << "GNSS-SDR program ended.\n";
+    return false;
+}
+
+static bool ValidateBatchJobs(const char* flagname, int32_t value)
+{
+    const int32_t max_value = 256;
+    if (value > 0 && value <= max_value)
+        {  // value is ok
+            return true;
+        }
+    std::cout << "Invalid value for flag -" << flagname << ": " << value << ". Allowed range is 0 < " << flagname << " <= " << max_value << " jobs.\n";
+    std::cout << "GNSS-SDR program ended.\n";
+    return false;
+}
+
 static bool ValidateDopplerMax(const char* flagname, int32_t value)
 {
     const int32_t max_value = 1000000;
@@ -231,6 +265,8 @@ DEFINE_validator(c, &ValidateC);
 DEFINE_validator(config_file, &ValidateConfigFile);
 DEFINE_validator(s, &ValidateS);
 DEFINE_validator(signal_source, &ValidateSignalSource);
+DEFINE_validator(batch_manifest, &ValidateBatchManifest);
+DEFINE_validator(batch_jobs, &ValidateBatchJobs);
 DEFINE_validator(doppler_max, &ValidateDopplerMax);
 DEFINE_validator(doppler_step, &ValidateDopplerStep);
 DEFINE_validator(cn0_samples, &ValidateCn0Samples);
@@ -39,6 +39,13 @@ DECLARE_string(s);              //!< Path to the file containing the signal samp
 DECLARE_string(signal_source);  //!< Path to the file containing the signal samples.
 DECLARE_bool(rf_shutdown);      //!< Shutdown RF when program exits.
 
+// Declare flags for the batch reprocessing orchestrator
+DECLARE_string(batch_manifest);       //!< Path to a manifest with one capture file per line. If defined, enables batch mode.
+DECLARE_string(batch_results);        //!< Path to the consolidated batch results file (CSV).
+DECLARE_int32(batch_jobs);            //!< Maximum number of concurrent flowgraphs in batch mode.
+DECLARE_int32(batch_mem_budget_mb);   //!< Memory budget for concurrent batch jobs, in MB (0 means no limit).
+DECLARE_int32(batch_job_mem_mb);      //!< Default per-job memory footprint estimate, in MB.
+
 // Declare flags for acquisition blocks
 DECLARE_int32(doppler_max);   //!< If defined, maximum Doppler value in the search grid, in Hz (overrides the configuration file).
 DECLARE_int32(doppler_step);  //!< If defined, sets the frequency step in the search grid, in Hz, in Hz (overrides the configuration file).
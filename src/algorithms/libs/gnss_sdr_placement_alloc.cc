@@ -0,0 +1,123 @@
+/*!
+ * \file gnss_sdr_placement_alloc.cc
+ * \brief Placement-aware memory allocation for large receiver buffers
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_placement_alloc.h"
+#include <glog/logging.h>
+#include <cstring>
+#include <new>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+#ifdef __linux__
+namespace
+{
+size_t round_to_page(size_t bytes)
+{
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return ((bytes + page - 1) / page) * page;
+}
+
+
+// Touch every page of the region from the given core, so the kernel places
+// the pages on that core's NUMA node. The calling thread's affinity is
+// restored afterwards.
+void first_touch_from_core(void* ptr, size_t bytes, int core)
+{
+    cpu_set_t previous;
+    CPU_ZERO(&previous);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(previous), &previous) != 0)
+        {
+            memset(ptr, 0, bytes);
+            return;
+        }
+    cpu_set_t target;
+    CPU_ZERO(&target);
+    CPU_SET(core, &target);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(target), &target) != 0)
+        {
+            LOG(WARNING) << "Could not first-touch buffer from core " << core
+                         << ", pages stay on the allocating thread's node";
+            memset(ptr, 0, bytes);
+            return;
+        }
+    memset(ptr, 0, bytes);
+    pthread_setaffinity_np(pthread_self(), sizeof(previous), &previous);
+}
+}  // namespace
+
+
+void* gnss_sdr_placement_alloc(size_t bytes, bool use_hugepages, int first_touch_core)
+{
+    if (bytes == 0)
+        {
+            bytes = 1;
+        }
+    const size_t rounded = round_to_page(bytes);
+    void* ptr = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+    if (use_hugepages)
+        {
+#ifdef MADV_HUGEPAGE
+            if (madvise(ptr, rounded, MADV_HUGEPAGE) != 0)
+                {
+                    LOG(WARNING) << "Transparent hugepage backing not available for a "
+                                 << rounded << "-byte buffer";
+                }
+#endif
+        }
+    if (first_touch_core >= 0)
+        {
+            first_touch_from_core(ptr, rounded, first_touch_core);
+        }
+    return ptr;
+}
+
+
+void gnss_sdr_placement_free(void* ptr, size_t bytes)
+{
+    if (ptr == nullptr)
+        {
+            return;
+        }
+    munmap(ptr, round_to_page(bytes == 0 ? 1 : bytes));
+}
+
+#else  // non-Linux fallback
+
+void* gnss_sdr_placement_alloc(size_t bytes, bool use_hugepages, int first_touch_core)
+{
+    (void)use_hugepages;
+    (void)first_touch_core;
+    return ::operator new(bytes);
+}
+
+
+void gnss_sdr_placement_free(void* ptr, size_t bytes)
+{
+    (void)bytes;
+    ::operator delete(ptr);
+}
+
+#endif
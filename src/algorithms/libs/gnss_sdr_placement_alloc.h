@@ -0,0 +1,110 @@
+/*!
+ * \file gnss_sdr_placement_alloc.h
+ * \brief Placement-aware memory allocation for large receiver buffers
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * The channel history rings and other large long-lived buffers end up
+ * wherever malloc put them: on multi-socket machines half the channels pay
+ * cross-node traffic, and hundreds of MB of ring storage thrash the TLB.
+ * This layer allocates page-aligned regions straight from the kernel,
+ * optionally advising transparent hugepage backing, and optionally
+ * first-touching the region from a given core so the pages are placed on
+ * that core's NUMA node — configured alongside the CPU-affinity policy.
+ * On non-Linux platforms it degrades to plain allocation.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_PLACEMENT_ALLOC_H
+#define GNSS_SDR_GNSS_SDR_PLACEMENT_ALLOC_H
+
+#include <cstddef>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Allocate \a bytes of page-aligned memory. If \a use_hugepages is
+ * true the region is advised for transparent hugepage backing. If
+ * \a first_touch_core is non-negative the region is first-touched from that
+ * core, binding its pages to the core's NUMA node. Throws std::bad_alloc
+ * on failure.
+ */
+void* gnss_sdr_placement_alloc(size_t bytes, bool use_hugepages, int first_touch_core);
+
+/*!
+ * \brief Release a region obtained from gnss_sdr_placement_alloc(). The
+ * original allocation size must be passed back.
+ */
+void gnss_sdr_placement_free(void* ptr, size_t bytes);
+
+
+/*!
+ * \brief Standard-library-compatible allocator over
+ * gnss_sdr_placement_alloc(), for backing containers such as the channel
+ * history rings. Default-constructed it behaves as a plain page allocator.
+ */
+template <class T>
+class Placement_Allocator
+{
+public:
+    using value_type = T;
+
+    Placement_Allocator() = default;
+
+    Placement_Allocator(bool use_hugepages, int first_touch_core)
+        : use_hugepages_(use_hugepages), first_touch_core_(first_touch_core)
+    {
+    }
+
+    template <class U>
+    explicit Placement_Allocator(const Placement_Allocator<U>& other)
+        : use_hugepages_(other.use_hugepages()), first_touch_core_(other.first_touch_core())
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(gnss_sdr_placement_alloc(n * sizeof(T), use_hugepages_, first_touch_core_));
+    }
+
+    void deallocate(T* p, size_t n)
+    {
+        gnss_sdr_placement_free(p, n * sizeof(T));
+    }
+
+    bool use_hugepages() const { return use_hugepages_; }
+    int first_touch_core() const { return first_touch_core_; }
+
+private:
+    bool use_hugepages_ = false;
+    int first_touch_core_ = -1;
+};
+
+template <class T, class U>
+bool operator==(const Placement_Allocator<T>& a, const Placement_Allocator<U>& b)
+{
+    return (a.use_hugepages() == b.use_hugepages()) && (a.first_touch_core() == b.first_touch_core());
+}
+
+template <class T, class U>
+bool operator!=(const Placement_Allocator<T>& a, const Placement_Allocator<U>& b)
+{
+    return !(a == b);
+}
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_PLACEMENT_ALLOC_H
@@ -0,0 +1,158 @@
+/*!
+ * \file gnss_spsc_ring.h
+ * \brief This class implements a set of lock-free single-producer
+ * single-consumer rings
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SPSC_RING_H
+#define GNSS_SDR_SPSC_RING_H
+
+#include "gnss_sdr_make_unique.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Set of wait-free single-producer single-consumer rings, one per
+ * channel.
+ *
+ * Lock-free companion to Gnss_circular_deque for hand-offs that cross
+ * threads: each channel is a fixed-capacity ring written by exactly one
+ * producer thread and drained by exactly one consumer thread, synchronized
+ * only through acquire / release operations on the read and write counters.
+ * Neither side ever blocks: try_push() reports failure when the ring is
+ * full and try_pop() when it is empty, so a stalled consumer cannot stop a
+ * producer (and vice versa). The capacity is rounded up to a power of two.
+ */
+template <class T>
+class Gnss_spsc_ring
+{
+public:
+    Gnss_spsc_ring();                                            //!< Default constructor
+    Gnss_spsc_ring(unsigned int max_size, unsigned int nchann);  //!< nchann = number of channels; max_size = channel capacity (rounded up to a power of two)
+    bool try_push(unsigned int ch, const T& new_data);           //!< Inserts an element at the end of a channel ring. Returns false if the ring is full. Producer side only
+    bool try_pop(unsigned int ch, T& data);                      //!< Extracts the oldest element of a channel ring. Returns false if the ring is empty. Consumer side only
+    unsigned int size(unsigned int ch) const;                    //!< Returns a snapshot of the number of queued elements in a channel
+    void reset(unsigned int max_size, unsigned int nchann);      //!< Discards all the elements in all the channels. Re-sets the number of channels and their capacity. Not thread-safe
+    void reset();                                                //!< Removes all the channels (Sets nchann to 0). Not thread-safe
+
+private:
+    // One ring per channel. The read and write counters grow monotonically
+    // and are masked on access; keeping them on separate cache lines avoids
+    // false sharing between the producer and the consumer threads.
+    struct Ring
+    {
+        std::vector<T> data;
+        unsigned int mask{0};
+        alignas(64) std::atomic<unsigned int> write_idx{0};
+        alignas(64) std::atomic<unsigned int> read_idx{0};
+    };
+    std::vector<std::unique_ptr<Ring>> d_rings;
+};
+
+
+template <class T>
+Gnss_spsc_ring<T>::Gnss_spsc_ring()
+{
+    reset();
+}
+
+
+template <class T>
+Gnss_spsc_ring<T>::Gnss_spsc_ring(unsigned int max_size, unsigned int nchann)
+{
+    reset(max_size, nchann);
+}
+
+
+template <class T>
+bool Gnss_spsc_ring<T>::try_push(unsigned int ch, const T& new_data)
+{
+    Ring& ring = *d_rings[ch];
+    const unsigned int write_idx = ring.write_idx.load(std::memory_order_relaxed);
+    const unsigned int read_idx = ring.read_idx.load(std::memory_order_acquire);
+    if (write_idx - read_idx > ring.mask)
+        {
+            return false;  // full
+        }
+    ring.data[write_idx & ring.mask] = new_data;
+    ring.write_idx.store(write_idx + 1, std::memory_order_release);
+    return true;
+}
+
+
+template <class T>
+bool Gnss_spsc_ring<T>::try_pop(unsigned int ch, T& data)
+{
+    Ring& ring = *d_rings[ch];
+    const unsigned int read_idx = ring.read_idx.load(std::memory_order_relaxed);
+    const unsigned int write_idx = ring.write_idx.load(std::memory_order_acquire);
+    if (read_idx == write_idx)
+        {
+            return false;  // empty
+        }
+    data = ring.data[read_idx & ring.mask];
+    ring.read_idx.store(read_idx + 1, std::memory_order_release);
+    return true;
+}
+
+
+template <class T>
+unsigned int Gnss_spsc_ring<T>::size(unsigned int ch) const
+{
+    const Ring& ring = *d_rings[ch];
+    return ring.write_idx.load(std::memory_order_acquire) - ring.read_idx.load(std::memory_order_acquire);
+}
+
+
+template <class T>
+void Gnss_spsc_ring<T>::reset(unsigned int max_size, unsigned int nchann)
+{
+    d_rings.clear();
+    if (max_size > 0 and nchann > 0)
+        {
+            unsigned int capacity = 1;
+            while (capacity < max_size)
+                {
+                    capacity <<= 1U;
+                }
+            for (unsigned int i = 0; i < nchann; i++)
+                {
+                    auto ring = std::make_unique<Ring>();
+                    ring->data.resize(capacity);
+                    ring->mask = capacity - 1;
+                    d_rings.push_back(std::move(ring));
+                }
+        }
+}
+
+
+template <class T>
+void Gnss_spsc_ring<T>::reset()
+{
+    d_rings.clear();
+}
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SPSC_RING_H
@@ -20,13 +20,42 @@
 #include "item_type_helpers.h"
 #include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <atomic>
 #include <cstring>  // memcpy
+#include <mutex>
+
+namespace
+{
+// Two's complement sign extension of a nibble, kept branch-free so the
+// compiler can vectorize the packed unpacking loops
+const int8_t nibble_lut[16] = {0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1};
+
+// Per-conversion usage counters. Entries are created once per conversion in
+// make_vector_converter and updated with relaxed atomics on the hot path;
+// std::map node stability keeps the references handed to the converters valid
+struct Conversion_Counters
+{
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> bytes_in{0};
+};
+
+std::mutex conversion_stats_mutex;
+std::map<std::string, Conversion_Counters> conversion_stats_map;
+
+Conversion_Counters &conversion_counters(const std::string &input_type,
+    const std::string &output_type)
+{
+    std::lock_guard<std::mutex> lock(conversion_stats_mutex);
+    return conversion_stats_map[input_type + "->" + output_type];
+}
+}  // namespace
+
 
 bool item_type_valid(const std::string &item_type)
 {
     if (item_type != "byte" and item_type != "cbyte" and item_type != "ibyte" and
         item_type != "short" and item_type != "cshort" and item_type != "ishort" and
-        item_type != "float" and item_type != "gr_complex")
+        item_type != "float" and item_type != "gr_complex" and item_type != "c4bits")
         {
             return false;
         }
@@ -61,6 +90,11 @@ size_t item_type_size(const std::string &item_type)
         {
             return 2 * sizeof(float);
         }
+    else if (item_type == "c4bits")
+        {
+            // one packed complex sample (4-bit I + 4-bit Q) per byte
+            return sizeof(int8_t);
+        }
     else
         {
             return 0;
@@ -70,7 +104,7 @@ size_t item_type_size(const std::string &item_type)
 
 bool item_type_is_complex(const std::string &item_type)
 {
-    return (item_type == "ibyte") or (item_type == "cbyte") or (item_type == "ishort") or (item_type == "cshort") or (item_type == "gr_complex");
+    return (item_type == "ibyte") or (item_type == "cbyte") or (item_type == "ishort") or (item_type == "cshort") or (item_type == "gr_complex") or (item_type == "c4bits");
 }
 
 
@@ -164,7 +198,46 @@ void convert_32fc_16ic(void *dest, const void *src, uint32_t num_items)
 }
 
 
-item_type_converter_t make_vector_converter(const std::string &input_type,
+// Packed nibbles have no volk kernel. The table lookup keeps the loops
+// branch-free, so the compiler auto-vectorizes them; the nibble order matches
+// unpack_byte_4bit_samples (real part in the low nibble)
+void convert_4ic_8ic(void *dest, const void *src, uint32_t num_items)
+{
+    auto *out = reinterpret_cast<int8_t *>(dest);
+    const auto *in = reinterpret_cast<const uint8_t *>(src);
+    for (uint32_t i = 0; i < num_items; i++)
+        {
+            out[2 * i] = nibble_lut[in[i] & 0x0F];
+            out[2 * i + 1] = nibble_lut[(in[i] >> 4) & 0x0F];
+        }
+}
+
+
+void convert_4ic_16ic(void *dest, const void *src, uint32_t num_items)
+{
+    auto *out = reinterpret_cast<int16_t *>(dest);
+    const auto *in = reinterpret_cast<const uint8_t *>(src);
+    for (uint32_t i = 0; i < num_items; i++)
+        {
+            out[2 * i] = nibble_lut[in[i] & 0x0F];
+            out[2 * i + 1] = nibble_lut[(in[i] >> 4) & 0x0F];
+        }
+}
+
+
+void convert_4ic_32fc(void *dest, const void *src, uint32_t num_items)
+{
+    auto *out = reinterpret_cast<float *>(dest);
+    const auto *in = reinterpret_cast<const uint8_t *>(src);
+    for (uint32_t i = 0; i < num_items; i++)
+        {
+            out[2 * i] = static_cast<float>(nibble_lut[in[i] & 0x0F]);
+            out[2 * i + 1] = static_cast<float>(nibble_lut[(in[i] >> 4) & 0x0F]);
+        }
+}
+
+
+item_type_converter_t make_vector_converter_impl(const std::string &input_type,
     const std::string &output_type)
 {
     if (not item_type_valid(input_type) or not item_type_valid(output_type))
@@ -367,9 +440,75 @@ item_type_converter_t make_vector_converter(const std::string &input_type,
                     return std::bind(convert_32fc_16ic, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
 #else
                     return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_32fc_16ic(arg1, arg2, arg3); };
+#endif
+                }
+        }
+    else if (input_type == "c4bits")
+        {
+            if (output_type == "cbyte" or output_type == "ibyte")
+                {
+#ifdef DO_NOT_USE_LAMBDAS
+                    return std::bind(convert_4ic_8ic, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
+#else
+                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_4ic_8ic(arg1, arg2, arg3); };
+#endif
+                }
+            else if (output_type == "cshort" or output_type == "ishort")
+                {
+#ifdef DO_NOT_USE_LAMBDAS
+                    return std::bind(convert_4ic_16ic, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
+#else
+                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_4ic_16ic(arg1, arg2, arg3); };
+#endif
+                }
+            else if (output_type == "gr_complex")
+                {
+#ifdef DO_NOT_USE_LAMBDAS
+                    return std::bind(convert_4ic_32fc, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
+#else
+                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_4ic_32fc(arg1, arg2, arg3); };
 #endif
                 }
         }
 
     throw std::runtime_error("make_vector_converter: invalid conversion : " + input_type + " to " + output_type);
 }
+
+
+item_type_converter_t make_vector_converter(const std::string &input_type,
+    const std::string &output_type)
+{
+    item_type_converter_t converter = make_vector_converter_impl(input_type, output_type);
+    const size_t input_size = item_type_size(input_type);
+    Conversion_Counters *counters = &conversion_counters(input_type, output_type);
+    // the wrapper takes explicit argument types, so it compiles even where
+    // generic lambdas are not available and needs no DO_NOT_USE_LAMBDAS path
+    return [converter, counters, input_size](void *dest, const void *src, uint32_t num_items) {
+        counters->calls.fetch_add(1, std::memory_order_relaxed);
+        counters->bytes_in.fetch_add(static_cast<uint64_t>(num_items) * input_size, std::memory_order_relaxed);
+        converter(dest, src, num_items);
+    };
+}
+
+
+std::map<std::string, Item_Type_Conversion_Stats> item_type_conversion_stats()
+{
+    std::map<std::string, Item_Type_Conversion_Stats> stats;
+    std::lock_guard<std::mutex> lock(conversion_stats_mutex);
+    for (const auto &entry : conversion_stats_map)
+        {
+            stats[entry.first] = {entry.second.calls.load(), entry.second.bytes_in.load()};
+        }
+    return stats;
+}
+
+
+void item_type_conversion_stats_reset()
+{
+    std::lock_guard<std::mutex> lock(conversion_stats_mutex);
+    for (auto &entry : conversion_stats_map)
+        {
+            entry.second.calls = 0;
+            entry.second.bytes_in = 0;
+        }
+}
@@ -23,6 +23,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <string>
 
 /** \addtogroup Algorithms_Library
@@ -37,7 +38,8 @@ using item_type_converter_t = std::function<void(void *, const void *, uint32_t)
  * \brief Check if a string is a valid item type
  *
  * \description Valid item types include:
- *     "byte", "short", "float", "ibyte", "ishort", "cbyte", "cshort", "gr_complex"
+ *     "byte", "short", "float", "ibyte", "ishort", "cbyte", "cshort",
+ *     "gr_complex", "c4bits"
  *
  */
 bool item_type_valid(const std::string &item_type);
@@ -71,6 +73,9 @@ bool item_type_is_complex(const std::string &item_type);
  *  6. "ishort" for complex (interleaved) 16 bit integers
  *  7. "float" for 32 bit floating point values
  *  8. "gr_complex" for complex (interleaved) 32 bit floating point values
+ *  9. "c4bits" for packed complex 4 bit integers, one sample per byte with
+ *     the real part in the low nibble. Accepted as input type only, in the
+ *     packing order of unpack_byte_4bit_samples
  *
  * \returns A function object with the following prototype:
  *  void convert_fun( void *dest, void *src, int num_items );
@@ -79,6 +84,30 @@ bool item_type_is_complex(const std::string &item_type);
 item_type_converter_t make_vector_converter(const std::string &input_type,
     const std::string &output_type);
 
+/*!
+ * \brief Usage counters of one conversion created by make_vector_converter
+ */
+struct Item_Type_Conversion_Stats
+{
+    uint64_t calls;     //!< number of times the converter was invoked
+    uint64_t bytes_in;  //!< input bytes processed across all invocations
+};
+
+/*!
+ * \brief Snapshot of the per-conversion usage counters, keyed by
+ * "input_type->output_type"
+ *
+ * \description Every converter returned by make_vector_converter counts its
+ * invocations and input bytes, so the monitoring side can tell which
+ * ingest-path conversions are actually exercised and at what rate
+ */
+std::map<std::string, Item_Type_Conversion_Stats> item_type_conversion_stats();
+
+/*!
+ * \brief Reset the per-conversion usage counters to zero
+ */
+void item_type_conversion_stats_reset();
+
 
 /** \} */
 /** \} */
@@ -0,0 +1,146 @@
+/*!
+ * \file memory_registry.cc
+ * \brief Implementation of a process-wide registry of the major buffer
+ * allocations made by the receiver blocks
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "memory_registry.h"
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <utility>
+
+namespace
+{
+struct Buffer_Entry
+{
+    std::string subsystem;
+    std::string buffer;
+    size_t bytes;
+};
+
+// entries keyed by owner and buffer name, so re-reports update in place
+std::map<std::pair<const void*, std::string>, Buffer_Entry>& entries()
+{
+    static std::map<std::pair<const void*, std::string>, Buffer_Entry> registry;
+    return registry;
+}
+
+std::mutex& registry_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::string format_bytes(uint64_t bytes)
+{
+    if (bytes >= 1048576)
+        {
+            return std::to_string(bytes / 1048576) + "." + std::to_string((bytes % 1048576) * 10 / 1048576) + " MiB";
+        }
+    if (bytes >= 1024)
+        {
+            return std::to_string(bytes / 1024) + " KiB";
+        }
+    return std::to_string(bytes) + " B";
+}
+}  // namespace
+
+
+void Memory_Registry::report(const void* owner, const std::string& subsystem, const std::string& buffer, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    entries()[std::make_pair(owner, buffer)] = Buffer_Entry{subsystem, buffer, bytes};
+}
+
+
+void Memory_Registry::release(const void* owner)
+{
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    auto& registry = entries();
+    auto it = registry.lower_bound(std::make_pair(owner, std::string()));
+    while (it != registry.end() && it->first.first == owner)
+        {
+            it = registry.erase(it);
+        }
+}
+
+
+uint64_t Memory_Registry::subsystem_bytes(const std::string& subsystem)
+{
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    uint64_t total = 0;
+    for (const auto& entry : entries())
+        {
+            if (entry.second.subsystem == subsystem)
+                {
+                    total += entry.second.bytes;
+                }
+        }
+    return total;
+}
+
+
+uint64_t Memory_Registry::total_bytes()
+{
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    uint64_t total = 0;
+    for (const auto& entry : entries())
+        {
+            total += entry.second.bytes;
+        }
+    return total;
+}
+
+
+void Memory_Registry::print_budget(std::ostream& os)
+{
+    std::lock_guard<std::mutex> lock(registry_mutex());
+
+    // aggregate per subsystem and buffer type
+    struct Aggregate
+    {
+        uint64_t bytes = 0;
+        uint32_t instances = 0;
+    };
+    std::map<std::string, std::map<std::string, Aggregate>> budget;
+    for (const auto& entry : entries())
+        {
+            auto& aggregate = budget[entry.second.subsystem][entry.second.buffer];
+            aggregate.bytes += entry.second.bytes;
+            aggregate.instances++;
+        }
+
+    os << "Memory budget of the accounted receiver buffers:\n";
+    uint64_t receiver_total = 0;
+    for (const auto& subsystem : budget)
+        {
+            uint64_t subsystem_total = 0;
+            for (const auto& buffer : subsystem.second)
+                {
+                    subsystem_total += buffer.second.bytes;
+                }
+            os << "  " << subsystem.first << ": " << format_bytes(subsystem_total) << '\n';
+            for (const auto& buffer : subsystem.second)
+                {
+                    os << "    " << std::left << std::setw(40) << buffer.first
+                       << std::right << std::setw(4) << buffer.second.instances << " x "
+                       << format_bytes(buffer.second.bytes / ((buffer.second.instances > 0) ? buffer.second.instances : 1))
+                       << " = " << format_bytes(buffer.second.bytes) << '\n';
+                }
+            receiver_total += subsystem_total;
+        }
+    os << "  Total: " << format_bytes(receiver_total) << '\n';
+}
@@ -0,0 +1,74 @@
+/*!
+ * \file memory_registry.h
+ * \brief Interface of a process-wide registry of the major buffer
+ * allocations made by the receiver blocks
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * Block constructors report their dominant allocations (acquisition grids,
+ * local code tables, observables history) to this registry, so the memory
+ * budget of a configuration can be printed at start-up and queried at
+ * runtime instead of being guessed from the configuration parameters.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MEMORY_REGISTRY_H
+#define GNSS_SDR_MEMORY_REGISTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Process-wide accounting of the major buffer allocations of the
+ * receiver blocks, aggregated by subsystem.
+ *
+ * Reporting is keyed by the owning object and the buffer name, so a block
+ * that re-initializes its buffers (e.g. after a reconfiguration) updates its
+ * entry instead of accumulating, and releasing an owner removes all of its
+ * entries. All methods are thread safe; blocks report from their
+ * constructors and init() methods only, so the lock is uncontended during
+ * signal processing.
+ */
+class Memory_Registry
+{
+public:
+    //! Records (or updates) a buffer allocation of the given owner
+    static void report(const void* owner, const std::string& subsystem, const std::string& buffer, size_t bytes);
+
+    //! Removes all the entries of the given owner (call from the destructor)
+    static void release(const void* owner);
+
+    //! Returns the accounted bytes of one subsystem
+    static uint64_t subsystem_bytes(const std::string& subsystem);
+
+    //! Returns the accounted bytes of the whole receiver
+    static uint64_t total_bytes();
+
+    /*!
+     * \brief Prints the memory budget: one line per subsystem and buffer
+     * type with the number of instances and the accounted bytes, followed
+     * by the subsystem and receiver totals.
+     */
+    static void print_budget(std::ostream& os);
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MEMORY_REGISTRY_H
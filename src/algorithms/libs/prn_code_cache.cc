@@ -0,0 +1,88 @@
+/*!
+ * \file prn_code_cache.cc
+ * \brief Process-wide immutable cache of sampled PRN code replicas.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "prn_code_cache.h"
+#include <mutex>  // for std::unique_lock
+#include <utility>
+
+
+Prn_Code_Cache& Prn_Code_Cache::get_instance()
+{
+    static Prn_Code_Cache instance;
+    return instance;
+}
+
+
+std::string Prn_Code_Cache::make_key(const std::string& signal, uint32_t prn, int64_t sampling_freq, int32_t chip_shift, uint32_t num_samples)
+{
+    return signal + '|' + std::to_string(prn) + '|' + std::to_string(sampling_freq) + '|' + std::to_string(chip_shift) + '|' + std::to_string(num_samples);
+}
+
+
+std::shared_ptr<const Prn_Code_Cache::complex_vector> Prn_Code_Cache::get_or_build(const std::string& signal,
+    uint32_t prn,
+    int64_t sampling_freq,
+    int32_t chip_shift,
+    uint32_t num_samples,
+    const std::function<void(own::span<std::complex<float>>)>& builder)
+{
+    const std::string key = make_key(signal, prn, sampling_freq, chip_shift, num_samples);
+    {
+        std::shared_lock<std::shared_mutex> lock(d_mutex);
+        const auto it = d_complex_codes.find(key);
+        if (it != d_complex_codes.end())
+            {
+                return it->second;
+            }
+    }
+    auto code = std::make_shared<complex_vector>(num_samples);
+    builder(own::span<std::complex<float>>(code->data(), num_samples));
+    std::unique_lock<std::shared_mutex> lock(d_mutex);
+    auto& slot = d_complex_codes[key];
+    if (slot == nullptr)
+        {
+            slot = std::move(code);
+        }
+    return slot;
+}
+
+
+std::shared_ptr<const Prn_Code_Cache::float_vector> Prn_Code_Cache::get_or_build_float(const std::string& signal,
+    uint32_t prn,
+    int64_t sampling_freq,
+    int32_t chip_shift,
+    uint32_t num_samples,
+    const std::function<void(own::span<float>)>& builder)
+{
+    const std::string key = make_key(signal, prn, sampling_freq, chip_shift, num_samples);
+    {
+        std::shared_lock<std::shared_mutex> lock(d_mutex);
+        const auto it = d_float_codes.find(key);
+        if (it != d_float_codes.end())
+            {
+                return it->second;
+            }
+    }
+    auto code = std::make_shared<float_vector>(num_samples);
+    builder(own::span<float>(code->data(), num_samples));
+    std::unique_lock<std::shared_mutex> lock(d_mutex);
+    auto& slot = d_float_codes[key];
+    if (slot == nullptr)
+        {
+            slot = std::move(code);
+        }
+    return slot;
+}
@@ -0,0 +1,99 @@
+/*!
+ * \file prn_code_cache.h
+ * \brief Process-wide immutable cache of sampled PRN code replicas.
+ *
+ * Every channel regenerates its sampled replica at instantiation and at
+ * each retarget, although the result only depends on the signal, the PRN
+ * and the sampling geometry. This cache builds each replica once, on
+ * first request, and hands out shared read-only copies afterwards, so
+ * identical tables are stored once per process instead of once per
+ * channel. Lookups of already-built entries only take a shared lock.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PRN_CODE_CACHE_H
+#define GNSS_SDR_PRN_CODE_CACHE_H
+
+#include <complex>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#if HAS_STD_SPAN
+#include <span>
+namespace own = std;
+#else
+#include <gsl/gsl>
+namespace own = gsl;
+#endif
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Process-wide immutable cache of sampled PRN replicas, keyed by
+ * signal, PRN, sampling frequency and chip shift.
+ *
+ * The builder callback fills the destination span with the replica; it
+ * runs at most once per key for the lifetime of the process, outside of
+ * any lock. Entries are never modified after insertion, so callers can
+ * keep the returned shared pointer for as long as they need the table.
+ */
+class Prn_Code_Cache
+{
+public:
+    using complex_vector = std::vector<std::complex<float>>;
+    using float_vector = std::vector<float>;
+
+    static Prn_Code_Cache& get_instance();
+
+    //! Shared complex replica, built by \p builder on the first request
+    std::shared_ptr<const complex_vector> get_or_build(const std::string& signal,
+        uint32_t prn,
+        int64_t sampling_freq,
+        int32_t chip_shift,
+        uint32_t num_samples,
+        const std::function<void(own::span<std::complex<float>>)>& builder);
+
+    //! Shared chip-spaced (or sampled) float replica, see get_or_build
+    std::shared_ptr<const float_vector> get_or_build_float(const std::string& signal,
+        uint32_t prn,
+        int64_t sampling_freq,
+        int32_t chip_shift,
+        uint32_t num_samples,
+        const std::function<void(own::span<float>)>& builder);
+
+    Prn_Code_Cache(const Prn_Code_Cache&) = delete;
+    Prn_Code_Cache& operator=(const Prn_Code_Cache&) = delete;
+
+private:
+    Prn_Code_Cache() = default;
+    ~Prn_Code_Cache() = default;
+
+    static std::string make_key(const std::string& signal, uint32_t prn, int64_t sampling_freq, int32_t chip_shift, uint32_t num_samples);
+
+    std::map<std::string, std::shared_ptr<const complex_vector>> d_complex_codes;
+    std::map<std::string, std::shared_ptr<const float_vector>> d_float_codes;
+    std::shared_mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PRN_CODE_CACHE_H
@@ -1064,6 +1064,14 @@ typedef struct
 } ambc_t;
 
 
+typedef struct
+{                 /* LAMBDA decorrelation warm-start cache */
+    int n;        /* dimension of the cached transformation */
+    uint32_t key; /* signature of the ambiguity set */
+    double *Z;    /* cached Z-transformation (n x n) */
+} lambdacache_t;
+
+
 typedef struct
 {                           /* RTK control/result type */
     sol_t sol;              /* RTK solution */
@@ -1077,6 +1085,7 @@ typedef struct
     ssat_t ssat[MAXSAT];    /* satellite status */
     int neb;                /* bytes in error message buffer */
     char errbuf[MAXERRMSG]; /* error message buffer */
+    lambdacache_t lamcache; /* LAMBDA warm-start cache */
     prcopt_t opt;           /* processing options */
 } rtk_t;
 
@@ -118,6 +118,13 @@ obsd_t insert_obs_to_rtklib(obsd_t& rtklib_obs, const Gnss_Synchro& gnss_synchro
             rtklib_obs.time = timeadd(rtklib_obs.time, 604800);
         }
 
+    // a cycle slip flagged by the observables block becomes a loss-of-lock
+    // indicator, so the solver resets the affected ambiguity right away
+    if (gnss_synchro.Flag_cycle_slip)
+        {
+            rtklib_obs.LLI[band] = 1;
+        }
+
     rtklib_obs.rcv = 1;
     return rtklib_obs;
 }
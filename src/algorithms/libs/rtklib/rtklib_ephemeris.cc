@@ -31,6 +31,7 @@
  */
 
 #include "rtklib_ephemeris.h"
+#include "rtklib_parallel.h"
 #include "rtklib_preceph.h"
 #include "rtklib_rtkcmn.h"
 #include "rtklib_sbas.h"
@@ -199,7 +200,7 @@ double eph2clk(gtime_t time, const eph_t *eph)
  *          satellite clock includes relativity correction without code bias
  *          (tgd or bgd)
  *-----------------------------------------------------------------------------*/
-void eph2pos(gtime_t time, const eph_t *eph, double *rs, double *dts,
+static void eph2pos_core(gtime_t time, const eph_t *eph, double *rs, double *dts,
     double *var)
 {
     double tk;
@@ -318,6 +319,107 @@ void eph2pos(gtime_t time, const eph_t *eph, double *rs, double *dts,
 }
 
 
+/* ephemeris evaluation cache ---------------------------------------------------
+ * the Kepler iteration is solved only on whole GPS seconds and stored per
+ * satellite together with a finite-difference velocity; queries in between are
+ * served by cubic Hermite interpolation of the two bracketing nodes (error is
+ * far below the ephemeris accuracy for smooth orbital arcs). Nodes are keyed
+ * on the issuing ephemeris (iode and toe), so a data set update invalidates
+ * them immediately. The cache is per-thread, which keeps it lock-free under
+ * the satposs() worker pool.
+ *-----------------------------------------------------------------------------*/
+static int eph_cache_on = 0;
+
+const double EPH_CACHE_VEL_DT = 1e-3; /* finite-difference step for node velocity (s) */
+
+typedef struct
+{
+    int valid;
+    int iode;
+    time_t toe;
+    time_t t; /* node epoch (whole gps second) */
+    double pos[3];
+    double vel[3];
+    double dts;
+    double dts_dot;
+    double var;
+} eph_cache_node_t;
+
+static thread_local eph_cache_node_t eph_cache[MAXSAT][2] = {};
+
+
+void set_eph_cache(int on)
+{
+    eph_cache_on = on;
+}
+
+
+/* evaluate or reuse the cache node at the whole second tn -------------------*/
+static eph_cache_node_t *eph_cache_node(time_t tn, const eph_t *eph)
+{
+    eph_cache_node_t *node = &eph_cache[eph->sat - 1][tn & 1];
+    double pos1[3];
+    double dts1;
+    int k;
+
+    if (node->valid && node->t == tn && node->iode == eph->iode &&
+        node->toe == eph->toe.time)
+        {
+            return node;
+        }
+    eph2pos_core(gtime_t{tn, 0.0}, eph, node->pos, &node->dts, &node->var);
+    eph2pos_core(gtime_t{tn, EPH_CACHE_VEL_DT}, eph, pos1, &dts1, &node->var);
+    for (k = 0; k < 3; k++)
+        {
+            node->vel[k] = (pos1[k] - node->pos[k]) / EPH_CACHE_VEL_DT;
+        }
+    node->dts_dot = (dts1 - node->dts) / EPH_CACHE_VEL_DT;
+    node->t = tn;
+    node->iode = eph->iode;
+    node->toe = eph->toe.time;
+    node->valid = 1;
+    return node;
+}
+
+
+void eph2pos(gtime_t time, const eph_t *eph, double *rs, double *dts,
+    double *var)
+{
+    const eph_cache_node_t *n0;
+    const eph_cache_node_t *n1;
+    double s;
+    double h00;
+    double h10;
+    double h01;
+    double h11;
+    int k;
+
+    if (!eph_cache_on || eph->A <= 0.0 || eph->sat < 1 || eph->sat > MAXSAT ||
+        time.sec < 0.0 || time.sec >= 1.0)
+        {
+            eph2pos_core(time, eph, rs, dts, var);
+            return;
+        }
+    n0 = eph_cache_node(time.time, eph);
+    n1 = eph_cache_node(time.time + 1, eph);
+
+    /* cubic hermite basis over the one-second node interval */
+    s = time.sec;
+    h00 = (1.0 + 2.0 * s) * (1.0 - s) * (1.0 - s);
+    h10 = s * (1.0 - s) * (1.0 - s);
+    h01 = s * s * (3.0 - 2.0 * s);
+    h11 = s * s * (s - 1.0);
+
+    for (k = 0; k < 3; k++)
+        {
+            rs[k] = h00 * n0->pos[k] + h10 * n0->vel[k] +
+                    h01 * n1->pos[k] + h11 * n1->vel[k];
+        }
+    *dts = h00 * n0->dts + h10 * n0->dts_dot + h01 * n1->dts + h11 * n1->dts_dot;
+    *var = n0->var;
+}
+
+
 /* glonass orbit differential equations --------------------------------------*/
 void deq(const double *x, double *xdot, const double *acc)
 {
@@ -1024,69 +1126,72 @@ void satposs(gtime_t teph, const obsd_t *obs, int n, const nav_t *nav,
     int ephopt, double *rs, double *dts, double *var, int *svh)
 {
     gtime_t time[MAXOBS] = {};
-    double dt;
-    double pr;
     int i;
-    int j;
 
     trace(3, "satposs : teph=%s n=%d ephopt=%d\n", time_str(teph, 3), n, ephopt);
 
-    for (i = 0; i < n && i < MAXOBS; i++)
-        {
-            for (j = 0; j < 6; j++)
-                {
-                    rs[j + i * 6] = 0.0;
-                }
-            for (j = 0; j < 2; j++)
-                {
-                    dts[j + i * 2] = 0.0;
-                }
-            var[i] = 0.0;
-            svh[i] = 0;
-
-            /* search any pseudorange */
-            for (j = 0, pr = 0.0; j < NFREQ; j++)
-                {
-                    if ((pr = obs[i].P[j]) != 0.0)
-                        {
-                            break;
-                        }
-                }
-
-            if (j >= NFREQ)
-                {
-                    trace(2, "no pseudorange %s sat=%2d\n", time_str(obs[i].time, 3), obs[i].sat);
-                    continue;
-                }
-            /* transmission time by satellite clock */
-            time[i] = timeadd(obs[i].time, -pr / SPEED_OF_LIGHT_M_S);
-
-            /* satellite clock bias by broadcast ephemeris */
-            if (!ephclk(time[i], teph, obs[i].sat, nav, &dt))
-                {
-                    trace(3, "no broadcast clock %s sat=%2d\n", time_str(time[i], 3), obs[i].sat);
-                    continue;
-                }
-            time[i] = timeadd(time[i], -dt);
-
-            /* satellite position and clock at transmission time */
-            if (!satpos(time[i], teph, obs[i].sat, ephopt, nav, rs + i * 6, dts + i * 2, var + i,
-                    svh + i))
-                {
-                    trace(3, "no ephemeris %s sat=%2d\n", time_str(time[i], 3), obs[i].sat);
-                    continue;
-                }
-            /* if no precise clock available, use broadcast clock instead */
-            if (dts[i * 2] == 0.0)
-                {
-                    if (!ephclk(time[i], teph, obs[i].sat, nav, dts + i * 2))
-                        {
-                            continue;
-                        }
-                    dts[1 + i * 2] = 0.0;
-                    *var = std::pow(STD_BRDCCLK, 2.0);
-                }
-        }
+    /* satellites are independent until the least-squares stack-up, so the
+     * model evaluation is spread over the worker pool (see rtklib_parallel.h);
+     * each iteration only writes the slots indexed by its own i */
+    rtklib_parallel_for(n < MAXOBS ? n : MAXOBS, [&](int i) {
+        double dt;
+        double pr;
+        int j;
+
+        for (j = 0; j < 6; j++)
+            {
+                rs[j + i * 6] = 0.0;
+            }
+        for (j = 0; j < 2; j++)
+            {
+                dts[j + i * 2] = 0.0;
+            }
+        var[i] = 0.0;
+        svh[i] = 0;
+
+        /* search any pseudorange */
+        for (j = 0, pr = 0.0; j < NFREQ; j++)
+            {
+                if ((pr = obs[i].P[j]) != 0.0)
+                    {
+                        break;
+                    }
+            }
+
+        if (j >= NFREQ)
+            {
+                trace(2, "no pseudorange %s sat=%2d\n", time_str(obs[i].time, 3), obs[i].sat);
+                return;
+            }
+        /* transmission time by satellite clock */
+        time[i] = timeadd(obs[i].time, -pr / SPEED_OF_LIGHT_M_S);
+
+        /* satellite clock bias by broadcast ephemeris */
+        if (!ephclk(time[i], teph, obs[i].sat, nav, &dt))
+            {
+                trace(3, "no broadcast clock %s sat=%2d\n", time_str(time[i], 3), obs[i].sat);
+                return;
+            }
+        time[i] = timeadd(time[i], -dt);
+
+        /* satellite position and clock at transmission time */
+        if (!satpos(time[i], teph, obs[i].sat, ephopt, nav, rs + i * 6, dts + i * 2, var + i,
+                svh + i))
+            {
+                trace(3, "no ephemeris %s sat=%2d\n", time_str(time[i], 3), obs[i].sat);
+                return;
+            }
+        /* if no precise clock available, use broadcast clock instead */
+        if (dts[i * 2] == 0.0)
+            {
+                if (!ephclk(time[i], teph, obs[i].sat, nav, dts + i * 2))
+                    {
+                        return;
+                    }
+                dts[1 + i * 2] = 0.0;
+                var[i] = std::pow(STD_BRDCCLK, 2.0);
+            }
+    });
     for (i = 0; i < n && i < MAXOBS; i++)
         {
             trace(4, "%s sat=%2d rs=%13.3f %13.3f %13.3f dts=%12.3f var=%7.3f svh=%02X\n",
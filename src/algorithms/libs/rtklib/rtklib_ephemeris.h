@@ -43,6 +43,7 @@ void alm2pos(gtime_t time, const alm_t *alm, double *rs, double *dts);
 double eph2clk(gtime_t time, const eph_t *eph);
 void eph2pos(gtime_t time, const eph_t *eph, double *rs, double *dts,
     double *var);
+void set_eph_cache(int on);
 void deq(const double *x, double *xdot, const double *acc);
 void glorbit(double t, double *x, const double *acc);
 double geph2clk(gtime_t time, const geph_t *geph);
@@ -69,7 +69,7 @@ int LD(int n, const double *Q, double *L, double *D)
                     L[i + j * n] /= L[i + i * n];
                 }
         }
-    free(A);
+    matfree(A);
     if (info)
         {
             fprintf(stderr, "%s : LD factorization error\n", __FILE__);
@@ -272,11 +272,11 @@ int search(int n, int m, const double *L, const double *D,
                         }
                 }
         }
-    free(S);
-    free(dist);
-    free(zb);
-    free(z);
-    free(step);
+    matfree(S);
+    matfree(dist);
+    matfree(zb);
+    matfree(z);
+    matfree(step);
 
     if (c >= LOOPMAX)
         {
@@ -332,15 +332,138 @@ int lambda(int n, int m, const double *a, const double *Q, double *F,
                     info = solve("T", Z, E, n, m, F); /* F=Z'\E */
                 }
         }
-    free(L);
-    free(D);
-    free(Z);
-    free(z);
-    free(E);
+    matfree(L);
+    matfree(D);
+    matfree(Z);
+    matfree(z);
+    matfree(E);
     return info;
 }
 
 
+/* warm-started lambda/mlambda integer least-square estimation -----------------
+ * same as lambda(), but the Z-transformation of the previous call is kept in
+ * a cache and reused when the ambiguity set did not change. the decorrelation
+ * then starts from an already (nearly) reduced covariance, so reduction() only
+ * re-visits the dimensions whose correlation actually moved since the last
+ * epoch instead of re-running the full sweep, and the search tree stays small.
+ * args   : lambdacache_t *cache IO warm-start cache (reset with lambda_cache_free)
+ *          uint32_t key  I  signature of the ambiguity set; a key or dimension
+ *                           mismatch invalidates the cache (cold start)
+ *          int    n      I  number of float parameters
+ *          int    m      I  number of fixed solutions
+ *          double *a     I  float parameters (n x 1)
+ *          double *Q     I  covariance matrix of float parameters (n x n)
+ *          double *F     O  fixed solutions (n x m)
+ *          double *s     O  sum of squared residulas of fixed solutions (1 x m)
+ * return : status (0:ok,other:error)
+ *-----------------------------------------------------------------------------*/
+int lambda_warm(lambdacache_t *cache, uint32_t key, int n, int m,
+    const double *a, const double *Q, double *F, double *s)
+{
+    int i;
+    int info;
+    int warm;
+    double *L;
+    double *D;
+    double *Z;
+    double *z;
+    double *E;
+
+    if (n <= 0 || m <= 0)
+        {
+            return -1;
+        }
+    L = zeros(n, n);
+    D = mat(n, 1);
+    Z = eye(n);
+    z = mat(n, 1);
+    E = mat(n, m);
+
+    warm = cache && cache->Z && cache->n == n && cache->key == key;
+    info = -1;
+    if (warm)
+        {
+            /* start from the cached transformation: Qz=Z0'*Q*Z0 */
+            double *QZ = mat(n, n);
+            double *Qz = mat(n, n);
+            matmul("NN", n, n, n, 1.0, Q, cache->Z, 0.0, QZ);
+            matmul("TN", n, n, n, 1.0, cache->Z, QZ, 0.0, Qz);
+            if (!(info = LD(n, Qz, L, D)))
+                {
+                    /* finish the reduction of the residual correlation and
+                       compose the full transformation Z=Z0*Z1 */
+                    reduction(n, L, D, Z);
+                    double *Zc = mat(n, n);
+                    matmul("NN", n, n, n, 1.0, cache->Z, Z, 0.0, Zc);
+                    memcpy(Z, Zc, sizeof(double) * n * n);
+                    matfree(Zc);
+                }
+            matfree(QZ);
+            matfree(Qz);
+        }
+    if (info)
+        {
+            /* cold start: cache miss or the warm factorization failed */
+            for (i = 0; i < n * n; i++)
+                {
+                    Z[i] = 0.0;
+                }
+            for (i = 0; i < n; i++)
+                {
+                    Z[i + i * n] = 1.0;
+                }
+            if (!(info = LD(n, Q, L, D)))
+                {
+                    reduction(n, L, D, Z);
+                }
+        }
+    if (!info)
+        {
+            matmul("TN", n, 1, n, 1.0, Z, a, 0.0, z); /* z=Z'*a */
+            if (!(info = search(n, m, L, D, z, E, s)))
+                {
+                    info = solve("T", Z, E, n, m, F); /* F=Z'\E */
+                }
+        }
+    /* refresh the cache with the transformation just used */
+    if (!info && cache)
+        {
+            if (cache->n != n)
+                {
+                    lambda_cache_free(cache);
+                    cache->Z = mat(n, n);
+                    cache->n = n;
+                }
+            memcpy(cache->Z, Z, sizeof(double) * n * n);
+            cache->key = key;
+        }
+    matfree(L);
+    matfree(D);
+    matfree(Z);
+    matfree(z);
+    matfree(E);
+    return info;
+}
+
+
+/* free lambda warm-start cache ------------------------------------------------
+ * release the cached Z-transformation and leave the cache invalid
+ * args   : lambdacache_t *cache IO warm-start cache
+ * return : none
+ *-----------------------------------------------------------------------------*/
+void lambda_cache_free(lambdacache_t *cache)
+{
+    if (cache->Z)
+        {
+            matfree(cache->Z);
+            cache->Z = nullptr;
+        }
+    cache->n = 0;
+    cache->key = 0;
+}
+
+
 /* lambda reduction ------------------------------------------------------------
  * reduction by lambda (ref [1]) for integer least square
  * args   : int    n      I  number of float parameters
@@ -374,15 +497,15 @@ int lambda_reduction(int n, const double *Q, double *Z)
     /* LD factorization */
     if ((info = LD(n, Q, L, D)))
         {
-            free(L);
-            free(D);
+            matfree(L);
+            matfree(D);
             return info;
         }
     /* lambda reduction */
     reduction(n, L, D, Z);
 
-    free(L);
-    free(D);
+    matfree(L);
+    matfree(D);
     return 0;
 }
 
@@ -415,14 +538,14 @@ int lambda_search(int n, int m, const double *a, const double *Q,
     /* LD factorization */
     if ((info = LD(n, Q, L, D)))
         {
-            free(L);
-            free(D);
+            matfree(L);
+            matfree(D);
             return info;
         }
     /* mlambda search */
     info = search(n, m, L, D, a, F, s);
 
-    free(L);
-    free(D);
+    matfree(L);
+    matfree(D);
     return info;
 }
@@ -66,6 +66,11 @@ int search(int n, int m, const double *L, const double *D,
 
 int lambda(int n, int m, const double *a, const double *Q, double *F, double *s);
 
+int lambda_warm(lambdacache_t *cache, uint32_t key, int n, int m,
+    const double *a, const double *Q, double *F, double *s);
+
+void lambda_cache_free(lambdacache_t *cache);
+
 int lambda_reduction(int n, const double *Q, double *Z);
 
 int lambda_search(int n, int m, const double *a, const double *Q,
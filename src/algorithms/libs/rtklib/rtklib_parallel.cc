@@ -0,0 +1,180 @@
+/*!
+ * \file rtklib_parallel.cc
+ * \brief Worker pool for parallel per-satellite model evaluation
+ * \author 2020, Javier Arribas
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_parallel.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Below this iteration count the wake-up/join hand-shake costs more than the
+// loop body, so the loop stays on the calling thread
+const int MIN_PARALLEL_ITERATIONS = 8;
+
+class Pvt_Worker_Pool
+{
+public:
+    ~Pvt_Worker_Pool()
+    {
+        stop_workers();
+    }
+
+    void set_num_threads(int nthreads)
+    {
+        std::lock_guard<std::mutex> dispatch_lock(dispatch_mtx_);
+        stop_workers();
+        if (nthreads > 1)
+            {
+                start_workers(nthreads - 1);  // the calling thread also works
+            }
+    }
+
+    void run(int n, const std::function<void(int)> &body)
+    {
+        if (workers_.empty() || n < MIN_PARALLEL_ITERATIONS)
+            {
+                for (int i = 0; i < n; i++)
+                    {
+                        body(i);
+                    }
+                return;
+            }
+        // The pool is process-wide but the job state below is single-slot,
+        // so only one dispatch can own the workers at a time. A concurrent
+        // caller (e.g. a second PVT block in multi-instance mode) runs its
+        // loop serially instead of waiting for the pool to free up
+        std::unique_lock<std::mutex> dispatch_lock(dispatch_mtx_, std::try_to_lock);
+        if (!dispatch_lock.owns_lock())
+            {
+                for (int i = 0; i < n; i++)
+                    {
+                        body(i);
+                    }
+                return;
+            }
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            job_ = &body;
+            job_size_ = n;
+            next_index_.store(0, std::memory_order_relaxed);
+            busy_workers_ = static_cast<int>(workers_.size());
+            generation_++;
+        }
+        cv_start_.notify_all();
+
+        // the calling thread drains indices alongside the workers
+        int i;
+        while ((i = next_index_.fetch_add(1, std::memory_order_relaxed)) < n)
+            {
+                (*job_)(i);
+            }
+
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_done_.wait(lock, [this] { return busy_workers_ == 0; });
+        job_ = nullptr;
+    }
+
+private:
+    void start_workers(int nworkers)
+    {
+        workers_.reserve(nworkers);
+        for (int w = 0; w < nworkers; w++)
+            {
+                // each worker starts at the current generation so that the
+                // increments issued by earlier stop_workers() calls do not
+                // look like a pending job to a freshly spawned thread
+                workers_.emplace_back([this, spawn_generation = generation_] { worker_loop(spawn_generation); });
+            }
+    }
+
+    void stop_workers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            shutdown_ = true;
+            generation_++;
+        }
+        cv_start_.notify_all();
+        for (auto &worker : workers_)
+            {
+                worker.join();
+            }
+        workers_.clear();
+        shutdown_ = false;
+    }
+
+    void worker_loop(uint64_t last_generation)
+    {
+        while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mtx_);
+                    cv_start_.wait(lock, [this, last_generation] { return shutdown_ || generation_ != last_generation; });
+                    if (shutdown_)
+                        {
+                            return;
+                        }
+                    last_generation = generation_;
+                }
+                int i;
+                while ((i = next_index_.fetch_add(1, std::memory_order_relaxed)) < job_size_)
+                    {
+                        (*job_)(i);
+                    }
+                {
+                    std::lock_guard<std::mutex> lock(mtx_);
+                    busy_workers_--;
+                }
+                cv_done_.notify_one();
+            }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex dispatch_mtx_;  // serializes run() dispatches and pool reconfiguration
+    std::mutex mtx_;
+    std::condition_variable cv_start_;
+    std::condition_variable cv_done_;
+    const std::function<void(int)> *job_{nullptr};
+    std::atomic<int> next_index_{0};
+    int job_size_{0};
+    int busy_workers_{0};
+    uint64_t generation_{0};
+    bool shutdown_{false};
+};
+
+
+Pvt_Worker_Pool &pvt_worker_pool()
+{
+    static Pvt_Worker_Pool pool;
+    return pool;
+}
+}  // namespace
+
+
+void rtklib_set_pvt_threads(int nthreads)
+{
+    pvt_worker_pool().set_num_threads(nthreads);
+}
+
+
+void rtklib_parallel_for(int n, const std::function<void(int)> &body)
+{
+    pvt_worker_pool().run(n, body);
+}
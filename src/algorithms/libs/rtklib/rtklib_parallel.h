@@ -0,0 +1,50 @@
+/*!
+ * \file rtklib_parallel.h
+ * \brief Worker pool for parallel per-satellite model evaluation
+ * \author 2020, Javier Arribas
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RTKLIB_PARALLEL_H
+#define GNSS_SDR_RTKLIB_PARALLEL_H
+
+#include <functional>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup RTKLIB_Library
+ * \{ */
+
+/*!
+ * \brief Set the number of threads used by rtklib_parallel_for().
+ *
+ * A value of 0 or 1 disables the worker pool and all loops run serially
+ * (the default). The setting is process-wide and is expected to be applied
+ * once, at flowgraph configuration time, before any positioning call.
+ */
+void rtklib_set_pvt_threads(int nthreads);
+
+/*!
+ * \brief Run body(i) for every i in [0, n), possibly in parallel.
+ *
+ * The call blocks until every iteration has completed, so the caller can
+ * treat it as a drop-in replacement for a serial loop. Iterations must be
+ * independent: body must only write to locations indexed by its own i.
+ * When the pool is disabled, or n is too small for the hand-off to pay
+ * off, the loop runs serially on the calling thread.
+ */
+void rtklib_parallel_for(int n, const std::function<void(int)> &body);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RTKLIB_PARALLEL_H
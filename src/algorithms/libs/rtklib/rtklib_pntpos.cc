@@ -598,6 +598,89 @@ int valsol(const double *azel, const int *vsat, int n,
 }
 
 
+/* incremental least-squares cache ---------------------------------------------
+ * at high solution rates the satellite set and geometry barely change between
+ * epochs, so the inverse normal matrix Q=(H*H')^-1 computed by lsq() is reused
+ * as a constant gain: dx=Q*H*v only needs two small matrix products. The
+ * residuals v are always recomputed, so the converged solution is the same
+ * fixed point; one full lsq() is run after convergence to refresh Q and the
+ * reported covariance. Any change in the participating satellites invalidates
+ * the cache and falls back to the full recomputation.
+ *-----------------------------------------------------------------------------*/
+static int incremental_lsq_on = 0;
+
+const int MAX_LSQ_CACHE_AGE = 100; /* epochs before a cached gain is recomputed */
+
+typedef struct
+{
+    int valid;
+    int age;
+    int nsat;
+    unsigned char sats[MAXOBS];
+    double Q[NX * NX];
+} lsq_cache_t;
+
+/* rescode() evaluates the first iteration with broadcast iono / Saastamoinen
+ * tropo models regardless of the processing options, which changes the row
+ * weights, so the first iteration and the follow-up iterations each get their
+ * own cache slot */
+static thread_local lsq_cache_t lsq_cache[2] = {};
+
+
+void set_incremental_lsq(int on)
+{
+    incremental_lsq_on = on;
+}
+
+
+/* signature of the satellites used by the current residual set --------------*/
+static int lsq_signature(const obsd_t *obs, int n, const int *vsat,
+    unsigned char *sats)
+{
+    int i;
+    int k = 0;
+
+    for (i = 0; i < n && i < MAXOBS; i++)
+        {
+            if (vsat[i])
+                {
+                    sats[k++] = obs[i].sat;
+                }
+        }
+    return k;
+}
+
+
+static int lsq_cache_match(lsq_cache_t *cache, const obsd_t *obs, int n,
+    const int *vsat)
+{
+    unsigned char sats[MAXOBS];
+    int nsat = lsq_signature(obs, n, vsat, sats);
+
+    if (!cache->valid || nsat != cache->nsat ||
+        memcmp(sats, cache->sats, nsat) != 0)
+        {
+            return 0;
+        }
+    if (++cache->age > MAX_LSQ_CACHE_AGE)
+        {
+            cache->valid = 0; /* force a periodic full recomputation */
+            return 0;
+        }
+    return 1;
+}
+
+
+static void lsq_cache_store(lsq_cache_t *cache, const obsd_t *obs, int n,
+    const int *vsat, const double *Q)
+{
+    cache->nsat = lsq_signature(obs, n, vsat, cache->sats);
+    matcpy(cache->Q, Q, NX, NX);
+    cache->age = 0;
+    cache->valid = 1;
+}
+
+
 /* estimate receiver position ------------------------------------------------*/
 int estpos(const obsd_t *obs, int n, const double *rs, const double *dts,
     const double *vare, const int *svh, const nav_t *nav,
@@ -607,6 +690,7 @@ int estpos(const obsd_t *obs, int n, const double *rs, const double *dts,
     double x[NX] = {0};
     double dx[NX];
     double Q[NX * NX];
+    double Hv[NX];
     double *v;
     double *H;
     double *var;
@@ -618,6 +702,8 @@ int estpos(const obsd_t *obs, int n, const double *rs, const double *dts,
     int stat;
     int nv;
     int ns;
+    int inc_step = 0;
+    lsq_cache_t *cache = nullptr;
     char msg_aux[128];
 
     trace(3, "estpos  : n=%d\n", n);
@@ -652,11 +738,23 @@ int estpos(const obsd_t *obs, int n, const double *rs, const double *dts,
                         }
                 }
             /* least square estimation */
-            if ((info = lsq(H, v, NX, nv, dx, Q)))
+            cache = &lsq_cache[i == 0 ? 0 : 1];
+            inc_step = incremental_lsq_on && lsq_cache_match(cache, obs, n, vsat);
+            if (inc_step)
+                {
+                    /* gain-only step with the cached inverse normal matrix */
+                    matmul("NN", NX, 1, nv, 1.0, H, v, 0.0, Hv);
+                    matmul("NN", NX, 1, NX, 1.0, cache->Q, Hv, 0.0, dx);
+                }
+            else if ((info = lsq(H, v, NX, nv, dx, Q)))
                 {
                     std::snprintf(msg_aux, sizeof(msg_aux), "lsq error info=%d", info);
                     break;
                 }
+            else if (incremental_lsq_on)
+                {
+                    lsq_cache_store(cache, obs, n, vsat, Q);
+                }
             for (j = 0; j < NX; j++)
                 {
                     x[j] += dx[j];
@@ -664,6 +762,18 @@ int estpos(const obsd_t *obs, int n, const double *rs, const double *dts,
 
             if (norm_rtk(dx, NX) < 1e-4)
                 {
+                    /* refresh Q for the covariance output and the next epoch */
+                    if (inc_step)
+                        {
+                            if (!lsq(H, v, NX, nv, dx, Q))
+                                {
+                                    lsq_cache_store(cache, obs, n, vsat, Q);
+                                }
+                            else
+                                {
+                                    matcpy(Q, cache->Q, NX, NX); /* keep last known covariance */
+                                }
+                        }
                     sol->type = 0;
                     sol->time = timeadd(obs[0].time, -x[3] / SPEED_OF_LIGHT_M_S);
                     sol->dtr[0] = x[3] / SPEED_OF_LIGHT_M_S; /* receiver clock bias (s) */
@@ -689,9 +799,9 @@ int estpos(const obsd_t *obs, int n, const double *rs, const double *dts,
                         {
                             sol->stat = opt->sateph == EPHOPT_SBAS ? SOLQ_SBAS : SOLQ_SINGLE;
                         }
-                    free(v);
-                    free(H);
-                    free(var);
+                    matfree(v);
+                    matfree(H);
+                    matfree(var);
                     msg = msg_aux;
                     return stat;
                 }
@@ -701,9 +811,9 @@ int estpos(const obsd_t *obs, int n, const double *rs, const double *dts,
             std::snprintf(msg_aux, sizeof(msg_aux), "iteration divergent i=%d", i);
         }
 
-    free(v);
-    free(H);
-    free(var);
+    matfree(v);
+    matfree(H);
+    matfree(var);
     msg = msg_aux;
 
     return 0;
@@ -822,13 +932,13 @@ int raim_fde(const obsd_t *obs, int n, const double *rs,
             trace(2, "%s: %s excluded by raim\n", tstr + 11, name);
         }
     free(obs_e);
-    free(rs_e);
-    free(dts_e);
-    free(vare_e);
-    free(azel_e);
-    free(svh_e);
-    free(vsat_e);
-    free(resp_e);
+    matfree(rs_e);
+    matfree(dts_e);
+    matfree(vare_e);
+    matfree(azel_e);
+    matfree(svh_e);
+    matfree(vsat_e);
+    matfree(resp_e);
 
     return stat;
 }
@@ -955,8 +1065,8 @@ void estvel(const obsd_t *obs, int n, const double *rs, const double *dts,
                     break;
                 }
         }
-    free(v);
-    free(H);
+    matfree(v);
+    matfree(H);
 }
 
 
@@ -1064,10 +1174,10 @@ int pntpos(const obsd_t *obs, int n, const nav_t *nav,
                     ssat[obs[i].sat - 1].resp[0] = resp[i];
                 }
         }
-    free(rs);
-    free(dts);
-    free(var);
-    free(azel_);
-    free(resp);
+    matfree(rs);
+    matfree(dts);
+    matfree(var);
+    matfree(azel_);
+    matfree(resp);
     return stat;
 }
@@ -43,6 +43,13 @@ const double ERR_ION = 5.0;   //!< ionospheric delay std (m)
 const double ERR_TROP = 3.0;  //!< tropspheric delay std (m)
 
 
+/* incremental least-squares mode ----------------------------------------------
+* enable/disable reuse of the inverse normal matrix between epochs in estpos()
+* when the participating satellite set is unchanged (0:off, the default). A
+* constellation change always falls back to the full recomputation.
+*-----------------------------------------------------------------------------*/
+void set_incremental_lsq(int on);
+
 /* pseudorange measurement error variance ------------------------------------*/
 double varerr(const prcopt_t *opt, double el, int sys);
 
@@ -34,11 +34,28 @@
 #include "rtklib_ephemeris.h"
 #include "rtklib_ionex.h"
 #include "rtklib_lambda.h"
+#include "rtklib_parallel.h"
 #include "rtklib_rtkcmn.h"
 #include "rtklib_sbas.h"
 #include "rtklib_tides.h"
 #include <cstring>
 
+
+/* use the sequential measurement update (filter_diag) in pppos() (0:off) */
+static int ppp_seq_filter = 0;
+
+
+/* enable/disable the sequential measurement update in pppos() -----------------
+* the ppp measurement noise matrix built by res_ppp() is diagonal, so the
+* measurements can be processed one scalar at a time (see filter_diag()),
+* avoiding the O(nv^3) innovation matrix inversion of filter() (0:off, the
+* default)
+*-----------------------------------------------------------------------------*/
+void set_ppp_seq_filter(int on)
+{
+    ppp_seq_filter = on;
+}
+
 /* wave length of LC (m) -----------------------------------------------------*/
 double lam_LC(int i, int j, int k)
 {
@@ -1553,19 +1570,18 @@ int res_ppp(int iter __attribute__((unused)), const obsd_t *obs, int n, const do
     double *H, double *R, double *azel)
 {
     prcopt_t *opt = &rtk->opt;
-    double r;
     double rr[3];
     double disp[3];
     double pos[3];
-    double e[3];
-    double meas[2];
-    double dtdx[3];
-    double dantr[NFREQ] = {0};
-    double dants[NFREQ] = {0};
     double var[MAXOBS * 2];
-    double dtrp = 0.0;
-    double vart = 0.0;
-    double varm[2] = {0};
+    double r_sat[MAXOBS];
+    double e_sat[MAXOBS * 3];
+    double dtrp_sat[MAXOBS];
+    double vart_sat[MAXOBS];
+    double dtdx_sat[MAXOBS * 3];
+    double meas_sat[MAXOBS * 2];
+    double varm_sat[MAXOBS * 2];
+    int ok_sat[MAXOBS];
     int i;
     int j;
     int k;
@@ -1573,7 +1589,6 @@ int res_ppp(int iter __attribute__((unused)), const obsd_t *obs, int n, const do
     int sys;
     int nv = 0;
     int nx = rtk->nx;
-    int brk;
     int tideopt;
 
     trace(3, "res_ppp : n=%d nx=%d\n", n, nx);
@@ -1602,74 +1617,93 @@ int res_ppp(int iter __attribute__((unused)), const obsd_t *obs, int n, const do
         }
     ecef2pos(rr, pos);
 
-    for (i = 0; i < n && i < MAXOBS; i++)
-        {
-            sat = obs[i].sat;
-            if (!(sys = satsys(sat, nullptr)) || !rtk->ssat[sat - 1].vs)
-                {
-                    continue;
-                }
+    /* per-satellite models evaluated on the worker pool: each iteration only
+       writes its own i-indexed slots and the phw slot of its satellite */
+    rtklib_parallel_for(n < MAXOBS ? n : MAXOBS, [&](int i) {
+        double dantr_i[NFREQ] = {0};
+        double dants_i[NFREQ] = {0};
+        int brk_i;
+        const int sat_i = obs[i].sat;
+        ok_sat[i] = 0;
+        dtrp_sat[i] = 0.0;
+        vart_sat[i] = 0.0;
+        if (!satsys(sat_i, nullptr) || !rtk->ssat[sat_i - 1].vs)
+            {
+                return;
+            }
 
-            /* geometric distance/azimuth/elevation angle */
-            if ((r = geodist(rs + i * 6, rr, e)) <= 0.0 ||
-                satazel(pos, e, azel + i * 2) < opt->elmin)
-                {
-                    continue;
-                }
+        /* geometric distance/azimuth/elevation angle */
+        if ((r_sat[i] = geodist(rs + i * 6, rr, e_sat + i * 3)) <= 0.0 ||
+            satazel(pos, e_sat + i * 3, azel + i * 2) < opt->elmin)
+            {
+                return;
+            }
 
-            /* excluded satellite? */
-            if (satexclude(obs[i].sat, svh[i], opt))
-                {
-                    continue;
-                }
+        /* excluded satellite? */
+        if (satexclude(obs[i].sat, svh[i], opt))
+            {
+                return;
+            }
 
-            /* tropospheric delay correction */
-            if (opt->tropopt == TROPOPT_SAAS)
-                {
-                    dtrp = tropmodel(obs[i].time, pos, azel + i * 2, REL_HUMI);
-                    vart = std::pow(ERR_SAAS, 2.0);
-                }
-            else if (opt->tropopt == TROPOPT_SBAS)
-                {
-                    dtrp = sbstropcorr(obs[i].time, pos, azel + i * 2, &vart);
-                }
-            else if (opt->tropopt == TROPOPT_EST || opt->tropopt == TROPOPT_ESTG)
-                {
-                    dtrp = prectrop(obs[i].time, pos, azel + i * 2, opt, x + IT_PPP(opt), dtdx, &vart);
-                }
-            else if (opt->tropopt == TROPOPT_COR || opt->tropopt == TROPOPT_CORG)
-                {
-                    dtrp = prectrop(obs[i].time, pos, azel + i * 2, opt, x, dtdx, &vart);
-                }
-            /* satellite antenna model */
-            if (opt->posopt[0])
-                {
-                    satantpcv(rs + i * 6, rr, nav->pcvs + sat - 1, dants);
-                }
-            /* receiver antenna model */
-            antmodel(opt->pcvr, opt->antdel[0], azel + i * 2, opt->posopt[1], dantr);
+        /* tropospheric delay correction */
+        if (opt->tropopt == TROPOPT_SAAS)
+            {
+                dtrp_sat[i] = tropmodel(obs[i].time, pos, azel + i * 2, REL_HUMI);
+                vart_sat[i] = std::pow(ERR_SAAS, 2.0);
+            }
+        else if (opt->tropopt == TROPOPT_SBAS)
+            {
+                dtrp_sat[i] = sbstropcorr(obs[i].time, pos, azel + i * 2, &vart_sat[i]);
+            }
+        else if (opt->tropopt == TROPOPT_EST || opt->tropopt == TROPOPT_ESTG)
+            {
+                dtrp_sat[i] = prectrop(obs[i].time, pos, azel + i * 2, opt, x + IT_PPP(opt), dtdx_sat + i * 3, &vart_sat[i]);
+            }
+        else if (opt->tropopt == TROPOPT_COR || opt->tropopt == TROPOPT_CORG)
+            {
+                dtrp_sat[i] = prectrop(obs[i].time, pos, azel + i * 2, opt, x, dtdx_sat + i * 3, &vart_sat[i]);
+            }
+        /* satellite antenna model */
+        if (opt->posopt[0])
+            {
+                satantpcv(rs + i * 6, rr, nav->pcvs + sat_i - 1, dants_i);
+            }
+        /* receiver antenna model */
+        antmodel(opt->pcvr, opt->antdel[0], azel + i * 2, opt->posopt[1], dantr_i);
 
-            /* phase windup correction */
-            if (opt->posopt[2])
-                {
-                    windupcorr(rtk->sol.time, rs + i * 6, rr, &rtk->ssat[sat - 1].phw);
-                }
-            /* ionosphere and antenna phase corrected measurements */
-            if (!corrmeas(obs + i, nav, pos, azel + i * 2, &rtk->opt, dantr, dants,
-                    rtk->ssat[sat - 1].phw, meas, varm, &brk))
+        /* phase windup correction */
+        if (opt->posopt[2])
+            {
+                windupcorr(rtk->sol.time, rs + i * 6, rr, &rtk->ssat[sat_i - 1].phw);
+            }
+        /* ionosphere and antenna phase corrected measurements */
+        if (!corrmeas(obs + i, nav, pos, azel + i * 2, &rtk->opt, dantr_i, dants_i,
+                rtk->ssat[sat_i - 1].phw, meas_sat + i * 2, varm_sat + i * 2, &brk_i))
+            {
+                return;
+            }
+        /* satellite clock and tropospheric delay */
+        r_sat[i] += -SPEED_OF_LIGHT_M_S * dts[i * 2] + dtrp_sat[i];
+
+        trace(5, "sat=%2d azel=%6.1f %5.1f dtrp=%.3f dantr=%6.3f %6.3f dants=%6.3f %6.3f phw=%6.3f\n",
+            sat_i, azel[i * 2] * R2D, azel[1 + i * 2] * R2D, dtrp_sat[i], dantr_i[0], dantr_i[1], dants_i[0],
+            dants_i[1], rtk->ssat[sat_i - 1].phw);
+        ok_sat[i] = 1;
+    });
+
+    /* serial assembly of the measurement rows */
+    for (i = 0; i < n && i < MAXOBS; i++)
+        {
+            if (!ok_sat[i])
                 {
                     continue;
                 }
-            /* satellite clock and tropospheric delay */
-            r += -SPEED_OF_LIGHT_M_S * dts[i * 2] + dtrp;
-
-            trace(5, "sat=%2d azel=%6.1f %5.1f dtrp=%.3f dantr=%6.3f %6.3f dants=%6.3f %6.3f phw=%6.3f\n",
-                sat, azel[i * 2] * R2D, azel[1 + i * 2] * R2D, dtrp, dantr[0], dantr[1], dants[0],
-                dants[1], rtk->ssat[sat - 1].phw);
+            sat = obs[i].sat;
+            sys = satsys(sat, nullptr);
 
             for (j = 0; j < 2; j++)
                 { /* for phase and code */
-                    if (meas[j] == 0.0)
+                    if (meas_sat[j + i * 2] == 0.0)
                         {
                             continue;
                         }
@@ -1679,11 +1713,11 @@ int res_ppp(int iter __attribute__((unused)), const obsd_t *obs, int n, const do
                             H[k + nx * nv] = 0.0;
                         }
 
-                    v[nv] = meas[j] - r;
+                    v[nv] = meas_sat[j + i * 2] - r_sat[i];
 
                     for (k = 0; k < 3; k++)
                         {
-                            H[k + nx * nv] = -e[k];
+                            H[k + nx * nv] = -e_sat[k + i * 3];
                         }
 
                     if (sys != SYS_GLO)
@@ -1700,7 +1734,7 @@ int res_ppp(int iter __attribute__((unused)), const obsd_t *obs, int n, const do
                         {
                             for (k = 0; k < (opt->tropopt >= TROPOPT_ESTG ? 3 : 1); k++)
                                 {
-                                    H[IT_PPP(opt) + k + nx * nv] = dtdx[k];
+                                    H[IT_PPP(opt) + k + nx * nv] = dtdx_sat[k + i * 3];
                                 }
                         }
                     if (j == 0)
@@ -1708,7 +1742,7 @@ int res_ppp(int iter __attribute__((unused)), const obsd_t *obs, int n, const do
                             v[nv] -= x[IB_PPP(obs[i].sat, opt)];
                             H[IB_PPP(obs[i].sat, opt) + nx * nv] = 1.0;
                         }
-                    var[nv] = varerr(obs[i].sat, sys, azel[1 + i * 2], j, opt) + varm[j] + vare[i] + vart;
+                    var[nv] = varerr(obs[i].sat, sys, azel[1 + i * 2], j, opt) + varm_sat[j + i * 2] + vare[i] + vart_sat[i];
 
                     if (j == 0)
                         {
@@ -1826,10 +1860,11 @@ void pppos(rtk_t *rtk, const obsd_t *obs, int n, const nav_t *nav)
                     break;
                 }
 
-            /* measurement update */
+            /* measurement update: R is diagonal by construction in res_ppp(),
+               so the sequential update is exact when enabled */
             matcpy(Pp, rtk->P, rtk->nx, rtk->nx);
 
-            if ((info = filter(xp, Pp, H, v, R, rtk->nx, nv)))
+            if ((info = ppp_seq_filter ? filter_diag(xp, Pp, H, v, R, rtk->nx, nv) : filter(xp, Pp, H, v, R, rtk->nx, nv)))
                 {
                     trace(2, "ppp filter error %s info=%d\n", time_str(rtk->sol.time, 0), info);
                     break;
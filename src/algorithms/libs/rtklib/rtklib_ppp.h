@@ -159,6 +159,13 @@ int res_ppp(int iter, const obsd_t *obs, int n, const double *rs,
 
 int pppnx(const prcopt_t *opt);
 
+/* sequential measurement update mode ------------------------------------------
+* enable/disable the scalar-at-a-time kalman update (filter_diag) in pppos(),
+* exact for the diagonal measurement noise built by res_ppp() (0:off, the
+* default)
+*-----------------------------------------------------------------------------*/
+void set_ppp_seq_filter(int on);
+
 void pppos(rtk_t *rtk, const obsd_t *obs, int n, const nav_t *nav);
 
 #endif
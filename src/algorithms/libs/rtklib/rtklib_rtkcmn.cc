@@ -34,11 +34,13 @@
 #include <cstring>
 #include <dirent.h>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <string>
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <vector>
 
 
 const double GPST0[] = {1980, 1, 6, 0, 0, 0}; /* gps time reference */
@@ -955,6 +957,61 @@ int decode_word(unsigned int word, unsigned char *data)
 }
 
 
+/* matrix buffer ---------------------------------------------------------------
+ * per-thread cache of matrix blocks, so the mat()/zeros()/imat() calls on the
+ * positioning critical path stop hitting the heap every epoch. mat() serves
+ * blocks from the cache when a matching size is available; matfree() returns
+ * them to it. The cached blocks are plain malloc() blocks, so call sites that
+ * still release with free() remain correct (they just bypass the cache).
+ *-----------------------------------------------------------------------------*/
+namespace
+{
+const size_t MATBUF_MAX_BLOCKS_PER_SIZE = 8; /* beyond this the block goes back to the heap */
+
+struct matbuf_t
+{
+    ~matbuf_t()
+    {
+        for (auto &entry : freelists)
+            {
+                for (auto *p : entry.second)
+                    {
+                        free(p);
+                    }
+            }
+    }
+    std::map<size_t, std::vector<void *>> freelists; /* reusable blocks, keyed by byte size */
+    std::map<void *, size_t> live;                   /* byte size of every block handed out */
+};
+
+
+matbuf_t &matbuf()
+{
+    static thread_local matbuf_t buf;
+    return buf;
+}
+
+
+void *matbuf_get(size_t bytes)
+{
+    matbuf_t &buf = matbuf();
+    void *p;
+    auto it = buf.freelists.find(bytes);
+    if (it != buf.freelists.end() && !it->second.empty())
+        {
+            p = it->second.back();
+            it->second.pop_back();
+        }
+    else if (!(p = malloc(bytes)))
+        {
+            return nullptr;
+        }
+    buf.live[p] = bytes;
+    return p;
+}
+}  // namespace
+
+
 /* new matrix ------------------------------------------------------------------
  * allocate memory of matrix
  * args   : int    n,m       I   number of rows and columns of matrix
@@ -968,7 +1025,7 @@ double *mat(int n, int m)
         {
             return nullptr;
         }
-    if (!(p = static_cast<double *>(malloc(sizeof(double) * n * m))))
+    if (!(p = static_cast<double *>(matbuf_get(sizeof(double) * n * m))))
         {
             fatalerr("matrix memory allocation error: n=%d,m=%d\n", n, m);
         }
@@ -989,7 +1046,7 @@ int *imat(int n, int m)
         {
             return nullptr;
         }
-    if (!(p = static_cast<int *>(malloc(sizeof(int) * n * m))))
+    if (!(p = static_cast<int *>(matbuf_get(sizeof(int) * n * m))))
         {
             fatalerr("integer matrix memory allocation error: n=%d,m=%d\n", n, m);
         }
@@ -1006,19 +1063,11 @@ double *zeros(int n, int m)
 {
     double *p;
 
-#if NOCALLOC
+    /* recycled blocks hold stale values, so zero unconditionally */
     if ((p = mat(n, m)))
-        for (n = n * m - 1; n >= 0; n--) p[n] = 0.0;
-#else
-    if (n <= 0 || m <= 0)
         {
-            return nullptr;
-        }
-    if (!(p = static_cast<double *>(calloc(sizeof(double), n * m))))
-        {
-            fatalerr("matrix memory allocation error: n=%d,m=%d\n", n, m);
+            memset(p, 0, sizeof(double) * n * m);
         }
-#endif
     return p;
 }
 
@@ -1044,6 +1093,39 @@ double *eye(int n)
 }
 
 
+/* free matrix -----------------------------------------------------------------
+ * return a block obtained from mat()/imat()/zeros()/eye() to the per-thread
+ * matrix buffer so the next allocation of the same size reuses it
+ * args   : void   *p        I   matrix pointer (NULL is accepted)
+ * return : none
+ * notes  : must be called from the thread that allocated the block
+ *-----------------------------------------------------------------------------*/
+void matfree(void *p)
+{
+    if (!p)
+        {
+            return;
+        }
+    matbuf_t &buf = matbuf();
+    auto it = buf.live.find(p);
+    if (it == buf.live.end())
+        {
+            free(p); /* not tracked by this thread's buffer */
+            return;
+        }
+    std::vector<void *> &blocks = buf.freelists[it->second];
+    if (blocks.size() < MATBUF_MAX_BLOCKS_PER_SIZE)
+        {
+            blocks.push_back(p);
+        }
+    else
+        {
+            free(p);
+        }
+    buf.live.erase(it);
+}
+
+
 /* inner product ---------------------------------------------------------------
  * inner product of vectors
  * args   : double *a,*b     I   vector a,b (n x 1)
@@ -1163,8 +1245,8 @@ int matinv(double *A, int n)
         {
             dgetri_(&n, A, &n, ipiv, work, &lwork, &info);
         }
-    free(ipiv);
-    free(work);
+    matfree(ipiv);
+    matfree(work);
     return info;
 }
 
@@ -1194,8 +1276,8 @@ int solve(const char *tr, const double *A, const double *Y, int n,
         {
             dgetrs_(const_cast<char *>(tr), &n, &m, B, &n, ipiv, X, &n, &info);
         }
-    free(ipiv);
-    free(B);
+    matfree(ipiv);
+    matfree(B);
     return info;
 }
 
@@ -1230,7 +1312,7 @@ int lsq(const double *A, const double *y, int n, int m, double *x,
         {
             matmul("NN", n, 1, n, 1.0, Q, Ay, 0.0, x); /* x=Q^-1*Ay */
         }
-    free(Ay);
+    matfree(Ay);
     return info;
 }
 
@@ -1273,10 +1355,10 @@ int filter_(const double *x, const double *P, const double *H,
             matmul("NT", n, n, m, -1.0, K, H, 1.0, I); /* Pp=(I-K*H')*P */
             matmul("NN", n, n, n, 1.0, I, P, 0.0, Pp);
         }
-    free(F);
-    free(Q);
-    free(K);
-    free(I);
+    matfree(F);
+    matfree(Q);
+    matfree(K);
+    matfree(I);
     return info;
 }
 
@@ -1336,12 +1418,140 @@ int filter(double *x, double *P, const double *H, const double *v,
                     P[ix[i] + ix[j] * n] = Pp_[i + j * k];
                 }
         }
-    free(ix);
-    free(x_);
-    free(xp_);
-    free(P_);
-    free(Pp_);
-    free(H_);
+    matfree(ix);
+    matfree(x_);
+    matfree(xp_);
+    matfree(P_);
+    matfree(Pp_);
+    matfree(H_);
+    return info;
+}
+
+
+/* kalman filter measurement update (diagonal measurement noise) ---------------
+* sequential form of filter() for uncorrelated measurements: only the diagonal
+* of R is used, off-diagonal terms are ignored. The measurements are processed
+* one scalar at a time, which avoids the m x m innovation matrix inversion of
+* filter_() and exploits the sparsity of each measurement row of H (a few
+* non-zero partials per satellite). Numerically equivalent to filter() up to
+* rounding when R is diagonal.
+* args   : (same as filter())
+* return : status (0:ok,<0:error)
+*-----------------------------------------------------------------------------*/
+int filter_diag(double *x, double *P, const double *H, const double *v,
+    const double *R, int n, int m)
+{
+    double *P_;
+    double *H_;
+    double *Ph;
+    double *dx;
+    double hj;
+    double vj;
+    double S;
+    double g;
+    int i;
+    int j;
+    int k;
+    int c;
+    int nnz;
+    int info = 0;
+    int *ix;
+    int *nz;
+
+    /* compress to the active states, as filter() does */
+    ix = imat(n, 1);
+    for (i = k = 0; i < n; i++)
+        {
+            if (x[i] != 0.0 && P[i + i * n] > 0.0)
+                {
+                    ix[k++] = i;
+                }
+        }
+    P_ = mat(k, k);
+    H_ = mat(k, m);
+    Ph = mat(k, 1);
+    dx = mat(k, 1);
+    nz = imat(k, 1);
+    for (i = 0; i < k; i++)
+        {
+            dx[i] = 0.0;
+            for (j = 0; j < k; j++)
+                {
+                    P_[i + j * k] = P[ix[i] + ix[j] * n];
+                }
+            for (j = 0; j < m; j++)
+                {
+                    H_[i + j * k] = H[ix[i] + j * n];
+                }
+        }
+    for (j = 0; j < m; j++)
+        {
+            /* non-zero partials of this measurement */
+            for (i = nnz = 0; i < k; i++)
+                {
+                    if (H_[i + j * k] != 0.0)
+                        {
+                            nz[nnz++] = i;
+                        }
+                }
+            if (nnz == 0)
+                {
+                    continue;
+                }
+            /* innovation corrected for the previous scalar updates */
+            vj = v[j];
+            for (i = 0; i < nnz; i++)
+                {
+                    vj -= H_[nz[i] + j * k] * dx[nz[i]];
+                }
+            /* Ph=P*h, S=h'*P*h+r */
+            S = R[j + j * m];
+            for (i = 0; i < k; i++)
+                {
+                    Ph[i] = 0.0;
+                    for (c = 0; c < nnz; c++)
+                        {
+                            Ph[i] += P_[i + nz[c] * k] * H_[nz[c] + j * k];
+                        }
+                }
+            for (i = 0; i < nnz; i++)
+                {
+                    S += H_[nz[i] + j * k] * Ph[nz[i]];
+                }
+            if (S <= 0.0)
+                {
+                    info = -1;
+                    break;
+                }
+            g = 1.0 / S;
+            /* dx+=K*vj, P-=K*Ph' with K=Ph/S */
+            for (i = 0; i < k; i++)
+                {
+                    dx[i] += Ph[i] * g * vj;
+                }
+            for (c = 0; c < k; c++)
+                {
+                    hj = Ph[c] * g;
+                    for (i = 0; i < k; i++)
+                        {
+                            P_[i + c * k] -= Ph[i] * hj;
+                        }
+                }
+        }
+    for (i = 0; i < k; i++)
+        {
+            x[ix[i]] += dx[i];
+            for (j = 0; j < k; j++)
+                {
+                    P[ix[i] + ix[j] * n] = P_[i + j * k];
+                }
+        }
+    matfree(ix);
+    matfree(P_);
+    matfree(H_);
+    matfree(Ph);
+    matfree(dx);
+    matfree(nz);
     return info;
 }
 
@@ -1386,9 +1596,9 @@ int smoother(const double *xf, const double *Qf, const double *xb,
                     matmul("NN", n, 1, n, 1.0, Qs, xx, 0.0, xs);
                 }
         }
-    free(invQf);
-    free(invQb);
-    free(xx);
+    matfree(invQf);
+    matfree(invQb);
+    matfree(xx);
     return info;
 }
 
@@ -2066,7 +2276,9 @@ void time2str(gtime_t t, char *s, int n)
  *-----------------------------------------------------------------------------*/
 char *time_str(gtime_t t, int n)
 {
-    static char buff[64];
+    /* thread-local so trace() calls from the satposs/zdres worker pool do not
+     * race on the buffer */
+    static thread_local char buff[64];
     time2str(t, buff, n);
     return buff;
 }
@@ -120,6 +120,7 @@ double *mat(int n, int m);
 int *imat(int n, int m);
 double *zeros(int n, int m);
 double *eye(int n);
+void matfree(void *p);
 double dot(const double *a, const double *b, int n);
 double norm_rtk(const double *a, int n);
 void cross3(const double *a, const double *b, double *c);
@@ -137,6 +138,8 @@ int filter_(const double *x, const double *P, const double *H,
     double *xp, double *Pp);
 int filter(double *x, double *P, const double *H, const double *v,
     const double *R, int n, int m);
+int filter_diag(double *x, double *P, const double *H, const double *v,
+    const double *R, int n, int m);
 int smoother(const double *xf, const double *Qf, const double *xb,
     const double *Qb, int n, double *xs, double *Qs);
 void matfprint(const double A[], int n, int m, int p, int q, FILE *fp);
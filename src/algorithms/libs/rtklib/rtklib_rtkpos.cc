@@ -32,6 +32,7 @@
 #include "rtklib_rtkpos.h"
 #include "rtklib_ephemeris.h"
 #include "rtklib_lambda.h"
+#include "rtklib_parallel.h"
 #include "rtklib_pntpos.h"
 #include "rtklib_ppp.h"
 #include "rtklib_tides.h"
@@ -757,9 +758,9 @@ void udpos(rtk_t *rtk, double tt)
                     rtk->P[i + 6 + (j + 6) * rtk->nx] += Qv[i + j * 3];
                 }
         }
-    free(F);
-    free(FP);
-    free(xp);
+    matfree(F);
+    matfree(FP);
+    matfree(xp);
 }
 
 
@@ -1185,7 +1186,7 @@ void udbias(rtk_t *rtk, double tt, const obsd_t *obs, const int *sat,
                         }
                     initx_rtk(rtk, bias[i], std::pow(rtk->opt.std[0], 2.0), IB_RTK(sat[i], f, &rtk->opt));
                 }
-            free(bias);
+            matfree(bias);
         }
 }
 
@@ -1303,12 +1304,9 @@ int zdres(int base, const obsd_t *obs, int n, const double *rs,
     const double *rr, const prcopt_t *opt, int index, double *y,
     double *e, double *azel)
 {
-    double r;
     double rr_[3];
     double pos[3];
-    double dant[NFREQ] = {0};
     double disp[3];
-    double zhd;
     double zazel[] = {0.0, 90.0 * D2R};
     int i;
     int nf = NF_RTK(opt);
@@ -1342,38 +1340,44 @@ int zdres(int base, const obsd_t *obs, int n, const double *rs,
         }
     ecef2pos(rr_, pos);
 
-    for (i = 0; i < n; i++)
-        {
-            /* compute geometric-range and azimuth/elevation angle */
-            if ((r = geodist(rs + i * 6, rr_, e + i * 3)) <= 0.0)
-                {
-                    continue;
-                }
-            if (satazel(pos, e + i * 3, azel + i * 2) < opt->elmin)
-                {
-                    continue;
-                }
-
-            /* excluded satellite? */
-            if (satexclude(obs[i].sat, svh[i], opt))
-                {
-                    continue;
-                }
-
-            /* satellite clock-bias */
-            r += -SPEED_OF_LIGHT_M_S * dts[i * 2];
-
-            /* troposphere delay model (hydrostatic) */
-            zhd = tropmodel(obs[0].time, pos, zazel, 0.0);
-            r += tropmapf(obs[i].time, pos, azel + i * 2, nullptr) * zhd;
-
-            /* receiver antenna phase center correction */
-            antmodel(opt->pcvr + index, opt->antdel[index], azel + i * 2, opt->posopt[1],
-                dant);
-
-            /* undifferenced phase/code residual for satellite */
-            zdres_sat(base, r, obs + i, nav, azel + i * 2, dant, opt, y + i * nf * 2);
-        }
+    /* per-satellite model evaluation is independent, so it is spread over the
+     * worker pool (see rtklib_parallel.h); each iteration only writes the
+     * slots of y, e and azel indexed by its own i */
+    rtklib_parallel_for(n, [&](int i) {
+        double r;
+        double zhd;
+        double dant[NFREQ] = {0};
+
+        /* compute geometric-range and azimuth/elevation angle */
+        if ((r = geodist(rs + i * 6, rr_, e + i * 3)) <= 0.0)
+            {
+                return;
+            }
+        if (satazel(pos, e + i * 3, azel + i * 2) < opt->elmin)
+            {
+                return;
+            }
+
+        /* excluded satellite? */
+        if (satexclude(obs[i].sat, svh[i], opt))
+            {
+                return;
+            }
+
+        /* satellite clock-bias */
+        r += -SPEED_OF_LIGHT_M_S * dts[i * 2];
+
+        /* troposphere delay model (hydrostatic) */
+        zhd = tropmodel(obs[0].time, pos, zazel, 0.0);
+        r += tropmapf(obs[i].time, pos, azel + i * 2, nullptr) * zhd;
+
+        /* receiver antenna phase center correction */
+        antmodel(opt->pcvr + index, opt->antdel[index], azel + i * 2, opt->posopt[1],
+            dant);
+
+        /* undifferenced phase/code residual for satellite */
+        zdres_sat(base, r, obs + i, nav, azel + i * 2, dant, opt, y + i * nf * 2);
+    });
     trace(4, "rr_=%.3f %.3f %.3f\n", rr_[0], rr_[1], rr_[2]);
     trace(4, "pos=%.9f %.9f %.3f\n", pos[0] * R2D, pos[1] * R2D, pos[2]);
     for (i = 0; i < n; i++)
@@ -1854,13 +1858,13 @@ int ddres(rtk_t *rtk, const nav_t *nav, double dt, const double *x,
     /* double-differenced measurement error covariance */
     ddcov(nb, b, Ri, Rj, nv, R);
 
-    free(Ri);
-    free(Rj);
-    free(im);
-    free(tropu);
-    free(tropr);
-    free(dtdxu);
-    free(dtdxr);
+    matfree(Ri);
+    matfree(Rj);
+    matfree(im);
+    matfree(tropu);
+    matfree(tropr);
+    matfree(dtdxu);
+    matfree(dtdxr);
 
     return nv;
 }
@@ -2131,10 +2135,10 @@ void holdamb(rtk_t *rtk, const double *xa)
                 {
                     errmsg(rtk, "filter error (info=%d)\n", info);
                 }
-            free(R);
+            matfree(R);
         }
-    free(v);
-    free(H);
+    matfree(v);
+    matfree(H);
 }
 
 
@@ -2149,6 +2153,7 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
     int info;
     int nx = rtk->nx;
     int na = rtk->na;
+    uint32_t key;
     double *D;
     double *DP;
     double *y;
@@ -2174,7 +2179,7 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
     if ((nb = ddmat(rtk, D)) <= 0)
         {
             errmsg(rtk, "no valid double-difference\n");
-            free(D);
+            matfree(D);
             return 0;
         }
     ny = na + nb;
@@ -2211,8 +2216,23 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
     trace(4, "N(0)=");
     tracemat(4, y + na, 1, nb, 10, 3);
 
-    /* lambda/mlambda integer least-square estimation */
-    if (!(info = lambda(nb, 2, y + na, Qb, b, s)))
+    /* signature of the ambiguity set selected by ddmat(), to validate the
+       LAMBDA warm-start cache across epochs */
+    key = 5381;
+    for (i = 0; i < MAXSAT; i++)
+        {
+            for (j = 0; j < NF_RTK(opt); j++)
+                {
+                    if (rtk->ssat[i].fix[j] == 2)
+                        {
+                            key = key * 33U + static_cast<uint32_t>(i * NFREQ + j + 1);
+                        }
+                }
+        }
+
+    /* lambda/mlambda integer least-square estimation, warm-started with the
+       decorrelation of the previous epoch when the ambiguity set is stable */
+    if (!(info = lambda_warm(&rtk->lamcache, key, nb, 2, y + na, Qb, b, s)))
         {
             trace(4, "N(1)=");
             tracemat(4, b, 1, nb, 10, 3);
@@ -2273,15 +2293,15 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
         {
             errmsg(rtk, "lambda error (info=%d)\n", info);
         }
-    free(D);
-    free(y);
-    free(Qy);
-    free(DP);
-    free(b);
-    free(db);
-    free(Qb);
-    free(Qab);
-    free(QQ);
+    matfree(D);
+    matfree(y);
+    matfree(Qy);
+    matfree(DP);
+    matfree(b);
+    matfree(db);
+    matfree(Qb);
+    matfree(Qab);
+    matfree(QQ);
 
     return nb; /* number of ambiguities */
 }
@@ -2409,12 +2429,12 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
         {
             errmsg(rtk, "initial base station position error\n");
 
-            free(rs);
-            free(dts);
-            free(var);
-            free(y);
-            free(e);
-            free(azel);
+            matfree(rs);
+            matfree(dts);
+            matfree(var);
+            matfree(y);
+            matfree(e);
+            matfree(azel);
             return 0;
         }
     /* time-interpolation of residuals (for post-processing) */
@@ -2427,12 +2447,12 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
         {
             errmsg(rtk, "no common satellite\n");
 
-            free(rs);
-            free(dts);
-            free(var);
-            free(y);
-            free(e);
-            free(azel);
+            matfree(rs);
+            matfree(dts);
+            matfree(var);
+            matfree(y);
+            matfree(e);
+            matfree(azel);
             return 0;
         }
     /* temporal update of states */
@@ -2619,19 +2639,19 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
                         }
                 }
         }
-    free(rs);
-    free(dts);
-    free(var);
-    free(y);
-    free(e);
-    free(azel);
-    free(xp);
-    free(Pp);
-    free(xa);
-    free(v);
-    free(H);
-    free(R);
-    free(bias);
+    matfree(rs);
+    matfree(dts);
+    matfree(var);
+    matfree(y);
+    matfree(e);
+    matfree(azel);
+    matfree(xp);
+    matfree(Pp);
+    matfree(xa);
+    matfree(v);
+    matfree(H);
+    matfree(R);
+    matfree(bias);
 
     if (stat != SOLQ_NONE)
         {
@@ -2679,6 +2699,9 @@ void rtkinit(rtk_t *rtk, const prcopt_t *opt)
         {
             rtk->errbuf[i] = 0;
         }
+    rtk->lamcache.n = 0;
+    rtk->lamcache.key = 0;
+    rtk->lamcache.Z = nullptr;
     rtk->opt = *opt;
 }
 
@@ -2693,14 +2716,15 @@ void rtkfree(rtk_t *rtk)
     trace(3, "rtkfree :\n");
 
     rtk->nx = rtk->na = 0;
-    free(rtk->x);
+    matfree(rtk->x);
     rtk->x = nullptr;
-    free(rtk->P);
+    matfree(rtk->P);
     rtk->P = nullptr;
-    free(rtk->xa);
+    matfree(rtk->xa);
     rtk->xa = nullptr;
-    free(rtk->Pa);
+    matfree(rtk->Pa);
     rtk->Pa = nullptr;
+    lambda_cache_free(&rtk->lamcache);
 }
 
 
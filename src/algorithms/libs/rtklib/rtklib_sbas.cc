@@ -1106,9 +1106,11 @@ double sbstropcorr(gtime_t time, const double *pos, const double *azel,
     const double rd = 287.054;
     const double gm = 9.784;
     const double g = 9.80665;
-    static double pos_[3] = {};
-    static double zh = 0.0;
-    static double zw = 0.0;
+    /* per-thread zenith delay cache: res_ppp() evaluates satellites on the
+     * worker pool (see rtklib_parallel.h) */
+    static thread_local double pos_[3] = {};
+    static thread_local double zh = 0.0;
+    static thread_local double zw = 0.0;
     int i;
     double c;
     double met[10];
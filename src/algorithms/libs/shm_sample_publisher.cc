@@ -0,0 +1,63 @@
+/*!
+ * \file shm_sample_publisher.cc
+ * \brief Pass-through block that publishes the conditioned gr_complex stream
+ * into a shared-memory sample ring for band receiver processes
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "shm_sample_publisher.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <cstring>  // for memcpy
+
+
+shm_sample_publisher_sptr make_shm_sample_publisher(const std::string& shm_name,
+    size_t capacity_items,
+    double sample_rate)
+{
+    return shm_sample_publisher_sptr(new shm_sample_publisher(shm_name, capacity_items, sample_rate));
+}
+
+
+shm_sample_publisher::shm_sample_publisher(const std::string& shm_name,
+    size_t capacity_items,
+    double sample_rate) : gr::sync_block("shm_sample_publisher",
+                              gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                              gr::io_signature::make(1, 1, sizeof(gr_complex)))
+{
+    if (d_ring.create(shm_name, sizeof(gr_complex), capacity_items, sample_rate))
+        {
+            LOG(INFO) << "Publishing conditioned samples to shared memory ring " << shm_name
+                      << " (" << capacity_items << " samples deep)";
+        }
+    else
+        {
+            LOG(WARNING) << "Could not create shared memory ring " << shm_name
+                         << ", the stream will not be published";
+        }
+}
+
+
+int shm_sample_publisher::work(int noutput_items,
+    gr_vector_const_void_star& input_items,
+    gr_vector_void_star& output_items)
+{
+    const auto* in = reinterpret_cast<const gr_complex*>(input_items[0]);
+    auto* out = reinterpret_cast<gr_complex*>(output_items[0]);
+    memcpy(out, in, noutput_items * sizeof(gr_complex));
+    if (d_ring.valid())
+        {
+            d_ring.write(in, static_cast<size_t>(noutput_items));
+        }
+    return noutput_items;
+}
@@ -0,0 +1,71 @@
+/*!
+ * \file shm_sample_publisher.h
+ * \brief Pass-through block that publishes the conditioned gr_complex stream
+ * into a shared-memory sample ring for band receiver processes
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SHM_SAMPLE_PUBLISHER_H
+#define GNSS_SDR_SHM_SAMPLE_PUBLISHER_H
+
+#include "gnss_block_interface.h"
+#include "shm_sample_ring.h"
+#include <gnuradio/sync_block.h>
+#include <gnuradio/types.h>  // for gr_vector_const_void_star
+#include <cstddef>
+#include <string>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+class shm_sample_publisher;
+
+using shm_sample_publisher_sptr = gnss_shared_ptr<shm_sample_publisher>;
+
+shm_sample_publisher_sptr make_shm_sample_publisher(const std::string& shm_name,
+    size_t capacity_items,
+    double sample_rate);
+
+/*!
+ * \brief This class copies its gr_complex input to its output while writing
+ * the same samples into a shared-memory ring (see Shm_Sample_Ring), making
+ * the stream available to SharedMemory_Signal_Source instances running in
+ * other processes. The ring write never blocks, so a slow or crashed
+ * consumer cannot stall the ingest flowgraph.
+ */
+class shm_sample_publisher : public gr::sync_block
+{
+public:
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+private:
+    friend shm_sample_publisher_sptr make_shm_sample_publisher(const std::string& shm_name,
+        size_t capacity_items,
+        double sample_rate);
+
+    shm_sample_publisher(const std::string& shm_name,
+        size_t capacity_items,
+        double sample_rate);
+
+    Shm_Sample_Ring d_ring;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SHM_SAMPLE_PUBLISHER_H
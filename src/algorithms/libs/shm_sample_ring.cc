@@ -0,0 +1,210 @@
+/*!
+ * \file shm_sample_ring.cc
+ * \brief Sequence-numbered single-producer sample ring in POSIX shared
+ * memory, the transport of the multi-process sharding mode
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "shm_sample_ring.h"
+#include <glog/logging.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+namespace
+{
+constexpr uint32_t SHM_RING_MAGIC = 0x53525347;  // "GSRS"
+constexpr uint16_t SHM_RING_VERSION = 1;
+// the payload starts on its own page so that producer-side header updates
+// and bulk sample copies never share a cache line
+constexpr size_t SHM_RING_HEADER_BYTES = 4096;
+}  // namespace
+
+
+struct Shm_Sample_Ring::Ring_Header
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint64_t item_size;
+    uint64_t capacity_items;
+    double sample_rate;
+    std::atomic<uint64_t> write_seq;  //!< total items ever written
+};
+
+
+Shm_Sample_Ring::~Shm_Sample_Ring()
+{
+    if (d_header != nullptr)
+        {
+            munmap(d_header, SHM_RING_HEADER_BYTES + d_item_size * d_capacity_items);
+        }
+    if (d_fd >= 0)
+        {
+            close(d_fd);
+        }
+    if (d_owner)
+        {
+            shm_unlink(d_name.c_str());
+        }
+}
+
+
+bool Shm_Sample_Ring::create(const std::string& name, size_t item_size, size_t capacity_items, double sample_rate)
+{
+    d_name = name;
+    // a stale segment from a crashed ingest run would confuse the consumer
+    // sequence tracking, so always start from a fresh one
+    shm_unlink(name.c_str());
+    d_fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (d_fd < 0)
+        {
+            LOG(WARNING) << "Could not create shared memory ring " << name << ": " << strerror(errno);
+            return false;
+        }
+    const size_t total_size = SHM_RING_HEADER_BYTES + item_size * capacity_items;
+    if (ftruncate(d_fd, static_cast<off_t>(total_size)) != 0)
+        {
+            LOG(WARNING) << "Could not size shared memory ring " << name << ": " << strerror(errno);
+            return false;
+        }
+    void* base = mmap(nullptr, total_size, PROT_READ | PROT_WRITE, MAP_SHARED, d_fd, 0);
+    if (base == MAP_FAILED)
+        {
+            LOG(WARNING) << "Could not map shared memory ring " << name << ": " << strerror(errno);
+            return false;
+        }
+    d_header = static_cast<Ring_Header*>(base);
+    d_payload = static_cast<uint8_t*>(base) + SHM_RING_HEADER_BYTES;
+    d_item_size = item_size;
+    d_capacity_items = capacity_items;
+    d_owner = true;
+
+    d_header->item_size = item_size;
+    d_header->capacity_items = capacity_items;
+    d_header->sample_rate = sample_rate;
+    d_header->version = SHM_RING_VERSION;
+    d_header->reserved = 0;
+    d_header->write_seq.store(0, std::memory_order_relaxed);
+    // the magic is published last, so a consumer polling for the segment
+    // never sees a half-initialized header
+    std::atomic_thread_fence(std::memory_order_release);
+    d_header->magic = SHM_RING_MAGIC;
+    return true;
+}
+
+
+bool Shm_Sample_Ring::open(const std::string& name, size_t item_size)
+{
+    d_name = name;
+    d_fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (d_fd < 0)
+        {
+            return false;
+        }
+    struct stat st
+    {
+    };
+    if (fstat(d_fd, &st) != 0)
+        {
+            close(d_fd);
+            d_fd = -1;
+            return false;
+        }
+    if (static_cast<size_t>(st.st_size) < SHM_RING_HEADER_BYTES)
+        {
+            close(d_fd);
+            d_fd = -1;
+            return false;
+        }
+    void* base = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, d_fd, 0);
+    if (base == MAP_FAILED)
+        {
+            close(d_fd);
+            d_fd = -1;
+            return false;
+        }
+    auto* header = static_cast<Ring_Header*>(base);
+    if (header->magic != SHM_RING_MAGIC or header->version != SHM_RING_VERSION or
+        header->item_size != item_size or
+        static_cast<size_t>(st.st_size) < SHM_RING_HEADER_BYTES + header->item_size * header->capacity_items)
+        {
+            LOG(WARNING) << "Shared memory ring " << name << " has an incompatible layout";
+            munmap(base, static_cast<size_t>(st.st_size));
+            close(d_fd);
+            d_fd = -1;
+            return false;
+        }
+    d_header = header;
+    d_payload = static_cast<uint8_t*>(base) + SHM_RING_HEADER_BYTES;
+    d_item_size = item_size;
+    d_capacity_items = header->capacity_items;
+    // join at the live edge of the stream
+    d_read_seq = d_header->write_seq.load(std::memory_order_acquire);
+    return true;
+}
+
+
+void Shm_Sample_Ring::write(const void* items, size_t num_items)
+{
+    const uint64_t seq = d_header->write_seq.load(std::memory_order_relaxed);
+    const size_t pos = seq % d_capacity_items;
+    const size_t first = std::min(num_items, d_capacity_items - pos);
+    memcpy(d_payload + pos * d_item_size, items, first * d_item_size);
+    if (first < num_items)
+        {
+            memcpy(d_payload, static_cast<const uint8_t*>(items) + first * d_item_size, (num_items - first) * d_item_size);
+        }
+    d_header->write_seq.store(seq + num_items, std::memory_order_release);
+}
+
+
+size_t Shm_Sample_Ring::read(void* out, size_t max_items)
+{
+    const uint64_t wr = d_header->write_seq.load(std::memory_order_acquire);
+    uint64_t available = wr - d_read_seq;
+    if (available == 0)
+        {
+            return 0;
+        }
+    if (available > d_capacity_items)
+        {
+            // the producer lapped us; resync to the middle of the ring so the
+            // next reads stay well clear of the write position
+            const uint64_t resync_seq = wr - d_capacity_items / 2;
+            d_overrun_items += resync_seq - d_read_seq;
+            d_read_seq = resync_seq;
+            available = wr - d_read_seq;
+        }
+    const size_t num_items = static_cast<size_t>(std::min<uint64_t>(available, max_items));
+    const size_t pos = d_read_seq % d_capacity_items;
+    const size_t first = std::min(num_items, d_capacity_items - pos);
+    memcpy(out, d_payload + pos * d_item_size, first * d_item_size);
+    if (first < num_items)
+        {
+            memcpy(static_cast<uint8_t*>(out) + first * d_item_size, d_payload, (num_items - first) * d_item_size);
+        }
+    d_read_seq += num_items;
+    return num_items;
+}
+
+
+double Shm_Sample_Ring::sample_rate() const
+{
+    return (d_header != nullptr ? d_header->sample_rate : 0.0);
+}
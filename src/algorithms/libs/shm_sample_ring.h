@@ -0,0 +1,88 @@
+/*!
+ * \file shm_sample_ring.h
+ * \brief Sequence-numbered single-producer sample ring in POSIX shared
+ * memory, the transport of the multi-process sharding mode
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SHM_SAMPLE_RING_H
+#define GNSS_SDR_SHM_SAMPLE_RING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Single-producer / single-consumer sample ring mapped in POSIX
+ * shared memory (shm_open + mmap), used to hand per-band sample streams
+ * from an ingest process to band receiver processes without copies through
+ * the kernel.
+ *
+ * The producer never blocks: the write sequence number grows monotonically
+ * and a lagging consumer detects the overrun from the sequence gap, resyncs
+ * to the middle of the ring and counts the lost samples instead of stalling
+ * the ingest. The consumer starts at the live edge of the stream. One
+ * producer and one consumer per ring; fan-out uses one ring per consumer.
+ */
+class Shm_Sample_Ring
+{
+public:
+    Shm_Sample_Ring() = default;
+    ~Shm_Sample_Ring();
+
+    Shm_Sample_Ring(const Shm_Sample_Ring&) = delete;
+    Shm_Sample_Ring& operator=(const Shm_Sample_Ring&) = delete;
+
+    //! Producer side: creates (or re-creates) the shared segment. The segment
+    //! is unlinked when this object is destroyed.
+    bool create(const std::string& name, size_t item_size, size_t capacity_items, double sample_rate);
+
+    //! Consumer side: maps an existing segment and validates its layout
+    bool open(const std::string& name, size_t item_size);
+
+    //! Producer: copies num_items items into the ring and publishes the new sequence
+    void write(const void* items, size_t num_items);
+
+    //! Consumer: copies up to max_items pending items into out, returns the
+    //! number of items delivered (0 if the producer has not advanced)
+    size_t read(void* out, size_t max_items);
+
+    bool valid() const { return d_header != nullptr; }
+    uint64_t overrun_items() const { return d_overrun_items; }
+    size_t capacity_items() const { return d_capacity_items; }
+    double sample_rate() const;
+
+private:
+    struct Ring_Header;
+
+    Ring_Header* d_header = nullptr;
+    uint8_t* d_payload = nullptr;
+    size_t d_item_size = 0;
+    size_t d_capacity_items = 0;
+    uint64_t d_read_seq = 0;
+    uint64_t d_overrun_items = 0;
+    std::string d_name;
+    int d_fd = -1;
+    bool d_owner = false;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SHM_SAMPLE_RING_H
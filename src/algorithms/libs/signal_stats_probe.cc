@@ -0,0 +1,135 @@
+/*!
+ * \file signal_stats_probe.cc
+ * \brief Pass-through block that accumulates sample statistics of the
+ * conditioned baseband stream (DC offset, RMS level, saturation ratio and
+ * an amplitude histogram) and reports them periodically
+ * \author Carles Fernandez Prades, cfernandez(at)cttc.es
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "signal_stats_probe.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <pmt/pmt.h>        // for mp
+#include <pmt/pmt_sugar.h>  // for mp
+#include <cmath>            // for sqrt, fabs
+#include <iostream>         // for operator<<
+#include <sstream>          // for ostringstream
+#include <string>           // for string
+
+
+signal_stats_probe_sptr make_signal_stats_probe(uint64_t report_interval_samples,
+    float saturation_value)
+{
+    return signal_stats_probe_sptr(new signal_stats_probe(report_interval_samples, saturation_value));
+}
+
+
+signal_stats_probe::signal_stats_probe(uint64_t report_interval_samples,
+    float saturation_value) : gr::sync_block("signal_stats_probe",
+                                  gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                                  gr::io_signature::make(1, 1, sizeof(gr_complex))),
+                              d_report_interval_samples(report_interval_samples),
+                              d_saturation_value(saturation_value)
+{
+    // map [-saturation_value, saturation_value) onto the histogram bins
+    d_bins_per_unit = static_cast<float>(NUM_BINS) / (2.0F * d_saturation_value);
+    message_port_register_out(pmt::mp("stats"));
+}
+
+
+int signal_stats_probe::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
+    double acc_i = 0.0;
+    double acc_q = 0.0;
+    double acc_pwr = 0.0;
+    uint64_t saturated = 0;
+    const float sat_level = d_saturation_value;
+    const float bins_per_unit = d_bins_per_unit;
+    for (int i = 0; i < noutput_items; i++)
+        {
+            const float re = in[i].real();
+            const float im = in[i].imag();
+            out[i] = in[i];
+            acc_i += static_cast<double>(re);
+            acc_q += static_cast<double>(im);
+            acc_pwr += static_cast<double>(re) * static_cast<double>(re) + static_cast<double>(im) * static_cast<double>(im);
+            if (std::fabs(re) >= sat_level || std::fabs(im) >= sat_level)
+                {
+                    saturated++;
+                }
+            // histogram is computed on the in-phase branch only; both
+            // branches come out of the same ADC and share its distribution
+            int bin = static_cast<int>((re + sat_level) * bins_per_unit);
+            if (bin < 0)
+                {
+                    bin = 0;
+                }
+            else if (bin >= NUM_BINS)
+                {
+                    bin = NUM_BINS - 1;
+                }
+            d_histogram[bin]++;
+        }
+    d_acc_i += acc_i;
+    d_acc_q += acc_q;
+    d_acc_pwr += acc_pwr;
+    d_saturated_count += saturated;
+    d_sample_count += static_cast<uint64_t>(noutput_items);
+    if (d_sample_count >= d_report_interval_samples)
+        {
+            publish_report();
+        }
+    return noutput_items;
+}
+
+
+void signal_stats_probe::publish_report()
+{
+    const auto n = static_cast<double>(d_sample_count);
+    const double mean_i = d_acc_i / n;
+    const double mean_q = d_acc_q / n;
+    const double rms = std::sqrt(d_acc_pwr / n);
+    const double sat_ratio = static_cast<double>(d_saturated_count) / n;
+
+    std::ostringstream summary;
+    summary << "Signal statistics: DC offset I=" << mean_i
+            << " Q=" << mean_q
+            << ", RMS=" << rms
+            << ", saturation=" << sat_ratio * 100.0 << " %";
+    std::cout << summary.str() << '\n';
+    message_port_pub(pmt::mp("stats"), pmt::mp(summary.str()));
+
+    std::ostringstream histogram;
+    for (int bin = 0; bin < NUM_BINS; bin++)
+        {
+            histogram << d_histogram[bin];
+            if (bin != NUM_BINS - 1)
+                {
+                    histogram << ' ';
+                }
+        }
+    LOG(INFO) << summary.str() << ", histogram over [-" << d_saturation_value
+              << ", " << d_saturation_value << "): " << histogram.str();
+
+    d_acc_i = 0.0;
+    d_acc_q = 0.0;
+    d_acc_pwr = 0.0;
+    d_saturated_count = 0;
+    d_sample_count = 0;
+    d_histogram.fill(0);
+}
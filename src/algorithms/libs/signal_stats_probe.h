@@ -0,0 +1,81 @@
+/*!
+ * \file signal_stats_probe.h
+ * \brief Pass-through block that accumulates sample statistics of the
+ * conditioned baseband stream (DC offset, RMS level, saturation ratio and
+ * an amplitude histogram) and reports them periodically
+ * \author Carles Fernandez Prades, cfernandez(at)cttc.es
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SIGNAL_STATS_PROBE_H
+#define GNSS_SDR_SIGNAL_STATS_PROBE_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <gnuradio/types.h>  // for gr_vector_const_void_star
+#include <array>
+#include <cstdint>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+class signal_stats_probe;
+
+using signal_stats_probe_sptr = gnss_shared_ptr<signal_stats_probe>;
+
+signal_stats_probe_sptr make_signal_stats_probe(uint64_t report_interval_samples,
+    float saturation_value);
+
+/*!
+ * \brief This class copies its gr_complex input to its output while
+ * accumulating first- and second-order moments, a saturation counter and a
+ * histogram of the in-phase component in the same loop, so the statistics
+ * ride on data that is already in cache. Every report_interval_samples it
+ * prints a summary, logs the histogram, and publishes the summary on the
+ * asynchronous "stats" message port.
+ */
+class signal_stats_probe : public gr::sync_block
+{
+public:
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend signal_stats_probe_sptr make_signal_stats_probe(uint64_t report_interval_samples,
+        float saturation_value);
+
+    signal_stats_probe(uint64_t report_interval_samples, float saturation_value);
+
+    void publish_report();
+
+    static const int NUM_BINS = 64;
+
+    std::array<uint64_t, NUM_BINS> d_histogram{};
+    double d_acc_i{0.0};
+    double d_acc_q{0.0};
+    double d_acc_pwr{0.0};
+    uint64_t d_sample_count{0};
+    uint64_t d_saturated_count{0};
+    uint64_t d_report_interval_samples;
+    float d_saturation_value;
+    float d_bins_per_unit;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SIGNAL_STATS_PROBE_H
@@ -0,0 +1,39 @@
+# GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+# This file is part of GNSS-SDR.
+#
+# SPDX-FileCopyrightText: 2010-2020 C. Fernandez-Prades cfernandez(at)cttc.es
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+########################################################################
+# Converts a volk_gnsssdr_config file written by volk_gnsssdr_profile
+# into a C header that embeds its contents, so the kernel preferences
+# can be compiled into the library. Invoked in script mode:
+#
+#   cmake -DCONFIG_FILE=<path> -DHEADER_FILE=<path> -P VolkBakeProfile.cmake
+########################################################################
+
+if(NOT EXISTS "${CONFIG_FILE}")
+    message(FATAL_ERROR "VolkBakeProfile: config file '${CONFIG_FILE}' not found")
+endif()
+
+file(READ "${CONFIG_FILE}" config_contents)
+string(REPLACE "\\" "\\\\" config_contents "${config_contents}")
+string(REPLACE "\"" "\\\"" config_contents "${config_contents}")
+string(REPLACE "\n" "\\n\"\n    \"" config_contents "${config_contents}")
+
+file(WRITE "${HEADER_FILE}.new" "/* Generated by VolkBakeProfile.cmake from ${CONFIG_FILE} -- do not edit */
+
+#ifndef INCLUDED_VOLK_GNSSSDR_BAKED_PROFILE_H
+#define INCLUDED_VOLK_GNSSSDR_BAKED_PROFILE_H
+
+static const char volk_gnsssdr_baked_profile[] =
+    \"${config_contents}\";
+
+#endif /* INCLUDED_VOLK_GNSSSDR_BAKED_PROFILE_H */
+")
+
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different
+    "${HEADER_FILE}.new" "${HEADER_FILE}"
+)
+execute_process(COMMAND ${CMAKE_COMMAND} -E remove "${HEADER_FILE}.new")
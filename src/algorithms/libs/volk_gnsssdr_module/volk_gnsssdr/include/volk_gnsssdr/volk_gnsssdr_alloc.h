@@ -15,8 +15,11 @@
 #define INCLUDED_VOLK_GNSSSDR_ALLOC_H
 
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <cstddef>
 #include <cstdlib>
 #include <limits>
+#include <map>
+#include <mutex>
 #include <new>
 #include <vector>
 
@@ -68,6 +71,182 @@ bool operator!=(alloc<T> const&, alloc<U> const&) { return false; }
 template <class T>
 using vector = std::vector<T, alloc<T> >;
 
+
+/*!
+ * \brief Size-bucketed pool of aligned blocks on top of volk_gnsssdr_malloc
+ *
+ * \details
+ * Blocks released through the pool are kept in per-size free lists and handed
+ * back on the next request of the same bucket, so buffers that are repeatedly
+ * created and destroyed (e.g. on channel stop / start cycles) do not go back
+ * to the operating system between uses. Requests are rounded up to the next
+ * power of two, 64 bytes minimum; requests above 16 MiB bypass the free lists
+ * and are served and released directly. All blocks carry the platform VOLK
+ * alignment. The pool is process-wide and thread-safe; cached blocks are
+ * returned to the system when the process exits. Opt-in: call sites keep
+ * using volk_gnsssdr_malloc / volk_gnsssdr_free unless they ask for the pool
+ * explicitly.
+ */
+class pool
+{
+public:
+    static pool& instance()
+    {
+        static pool the_pool;
+        return the_pool;
+    }
+
+    void* allocate(std::size_t size)
+    {
+        if (size == 0) return nullptr;
+        const std::size_t bucket = bucket_for(size);
+        if (bucket == 0)
+            {
+                // oversize: serve directly, remember it so deallocate() does not cache it
+                void* p = volk_gnsssdr_malloc(size, volk_gnsssdr_get_alignment());
+                if (p == nullptr) throw std::bad_alloc();
+                std::lock_guard<std::mutex> lock(mutex_);
+                live_[p] = 0;
+                return p;
+            }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::vector<void*>& free_list = free_lists_[bucket];
+            if (!free_list.empty())
+                {
+                    void* p = free_list.back();
+                    free_list.pop_back();
+                    live_[p] = bucket;
+                    return p;
+                }
+        }
+        void* p = volk_gnsssdr_malloc(bucket, volk_gnsssdr_get_alignment());
+        if (p == nullptr) throw std::bad_alloc();
+        std::lock_guard<std::mutex> lock(mutex_);
+        live_[p] = bucket;
+        return p;
+    }
+
+    void deallocate(void* p) noexcept
+    {
+        if (p == nullptr) return;
+        std::size_t bucket = 0;
+        bool pooled = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = live_.find(p);
+            if (it != live_.end())
+                {
+                    bucket = it->second;
+                    live_.erase(it);
+                    if (bucket != 0)
+                        {
+                            free_lists_[bucket].push_back(p);
+                            pooled = true;
+                        }
+                }
+        }
+        if (!pooled)
+            {
+                // oversize block, or a pointer that never came from the pool
+                volk_gnsssdr_free(p);
+            }
+    }
+
+    pool(pool const&) = delete;
+    pool& operator=(pool const&) = delete;
+
+private:
+    pool() = default;
+
+    ~pool()
+    {
+        for (auto& entry : free_lists_)
+            {
+                for (void* p : entry.second)
+                    {
+                        volk_gnsssdr_free(p);
+                    }
+            }
+    }
+
+    static std::size_t bucket_for(std::size_t size)
+    {
+        if (size > max_pooled_size) return 0;
+        std::size_t bucket = min_bucket_size;
+        while (bucket < size)
+            {
+                bucket <<= 1U;
+            }
+        return bucket;
+    }
+
+    static const std::size_t min_bucket_size = 64;
+    static const std::size_t max_pooled_size = std::size_t(1) << 24U;  // 16 MiB
+
+    std::map<std::size_t, std::vector<void*> > free_lists_;
+    std::map<void*, std::size_t> live_;
+    std::mutex mutex_;
+};
+
+
+/*!
+ * \brief Drop-in replacement for volk_gnsssdr_malloc backed by the block pool
+ */
+inline void* pool_malloc(std::size_t size)
+{
+    return pool::instance().allocate(size);
+}
+
+/*!
+ * \brief Drop-in replacement for volk_gnsssdr_free backed by the block pool
+ */
+inline void pool_free(void* p) noexcept
+{
+    pool::instance().deallocate(p);
+}
+
+
+/*!
+ * \brief C++11 allocator using the volk_gnsssdr::pool block pool
+ */
+template <class T>
+struct pool_alloc
+{
+    typedef T value_type;
+
+    pool_alloc() = default;
+
+    template <class U>
+    constexpr pool_alloc(pool_alloc<U> const&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) throw std::bad_alloc();
+
+        return static_cast<T*>(pool_malloc(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept { pool_free(p); }
+};
+
+template <class T, class U>
+bool operator==(pool_alloc<T> const&, pool_alloc<U> const&) { return true; }
+
+template <class T, class U>
+bool operator!=(pool_alloc<T> const&, pool_alloc<U> const&) { return false; }
+
+
+/*!
+ * \brief type alias for std::vector using volk_gnsssdr::pool_alloc
+ *
+ * \details
+ * example code:
+ *   volk_gnsssdr::pool_vector<float> v(100); // vector whose storage is recycled through the pool
+ */
+template <class T>
+using pool_vector = std::vector<T, pool_alloc<T> >;
+
 }  // namespace volk_gnsssdr
 
 #endif  // INCLUDED_VOLK_GNSSSDR_ALLOC_H
@@ -0,0 +1,69 @@
+/*!
+ * \file volk_gnsssdr_audit.h
+ * \brief Runtime auditing of the per-kernel dispatch decisions
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * The dispatchers generated by volk_gnsssdr pick a protokernel per kernel
+ * and alignment silently, so when a deployment underperforms there is no
+ * record of what actually ran. Each dispatcher registers an audit entry on
+ * its first invocation recording the chosen implementations, the reason for
+ * the choice (profile entry, best available for the machine, fallback) and
+ * counters of aligned/unaligned dispatches. Setting the VOLK_GNSSSDR_AUDIT
+ * environment variable additionally logs each decision to stderr as the
+ * kernels come online and prints a summary at exit.
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_VOLK_GNSSSDR_AUDIT_H
+#define INCLUDED_VOLK_GNSSSDR_AUDIT_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+__VOLK_DECL_BEGIN
+
+typedef struct volk_gnsssdr_audit_entry
+{
+    const char *kernel_name;                // name of the dispatched kernel
+    const char *impl_a_name;                // implementation chosen for aligned buffers
+    const char *impl_u_name;                // implementation chosen for unaligned buffers
+    const char *reason_a;                   // why the aligned implementation was chosen
+    const char *reason_u;                   // why the unaligned implementation was chosen
+    uint64_t aligned_calls;                 // dispatches that took the aligned path
+    uint64_t unaligned_calls;               // dispatches that fell back to the unaligned path
+    struct volk_gnsssdr_audit_entry *next;  // next kernel used by this session
+} volk_gnsssdr_audit_entry_t;
+
+////////////////////////////////////////////////////////////////////////
+// true if the VOLK_GNSSSDR_AUDIT environment variable is set
+////////////////////////////////////////////////////////////////////////
+VOLK_API bool volk_gnsssdr_audit_enabled(void);
+
+////////////////////////////////////////////////////////////////////////
+// called by the generated dispatchers on first invocation of a kernel;
+// registering an already registered entry is a no-op
+////////////////////////////////////////////////////////////////////////
+VOLK_API void volk_gnsssdr_audit_register(volk_gnsssdr_audit_entry_t *entry);
+
+////////////////////////////////////////////////////////////////////////
+// head of the list of kernels dispatched so far, NULL if none
+////////////////////////////////////////////////////////////////////////
+VOLK_API const volk_gnsssdr_audit_entry_t *volk_gnsssdr_audit_entries(void);
+
+////////////////////////////////////////////////////////////////////////
+// print one line per dispatched kernel with the chosen implementations,
+// the selection reasons and the aligned/unaligned invocation counters
+////////////////////////////////////////////////////////////////////////
+VOLK_API void volk_gnsssdr_audit_print(FILE *fp);
+
+__VOLK_DECL_END
+
+#endif /* INCLUDED_VOLK_GNSSSDR_AUDIT_H */
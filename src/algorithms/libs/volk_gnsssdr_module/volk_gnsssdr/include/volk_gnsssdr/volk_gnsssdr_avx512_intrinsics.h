@@ -0,0 +1,52 @@
+/*!
+ * \file volk_gnsssdr_avx512_intrinsics.h
+ * \brief This file is intended to hold AVX512F intrinsics of intrinsics.
+ * They should be used in VOLK kernels to avoid copy-paste.
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#ifndef INCLUDED_VOLK_VOLK_AVX512_INTRINSICS_H
+#define INCLUDED_VOLK_VOLK_AVX512_INTRINSICS_H
+#include <immintrin.h>
+
+static inline __m512
+_mm512_complexmul_ps(__m512 x, __m512 y)
+{
+    __m512 yl, yh, tmp;
+    yl = _mm512_moveldup_ps(y);           // Load yl with cr,cr,dr,dr ...
+    yh = _mm512_movehdup_ps(y);           // Load yh with ci,ci,di,di ...
+    tmp = _mm512_mul_ps(x, yh);           // tmp = ar*ci,ai*ci,br*di,bi*di ...
+    tmp = _mm512_permute_ps(tmp, 0xB1);   // Re-arrange tmp to be ai*ci,ar*ci,bi*di,br*di ...
+    return _mm512_fmaddsub_ps(x, yl, tmp);  // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+}
+
+static inline __m512
+_mm512_conjugate_ps(__m512 x)
+{
+    const __m512 conjugator = _mm512_setr4_ps(0, -0.f, 0, -0.f);
+    return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(x), _mm512_castps_si512(conjugator)));  // conjugate y
+}
+
+static inline __m512
+_mm512_complexconjugatemul_ps(__m512 x, __m512 y)
+{
+    y = _mm512_conjugate_ps(y);
+    return _mm512_complexmul_ps(x, y);
+}
+
+static inline __m512 _mm512_complexnormalise_ps(__m512 z)
+{
+    __m512 tmp1 = _mm512_mul_ps(z, z);
+    __m512 tmp2 = _mm512_permute_ps(tmp1, 0xB1);
+    tmp1 = _mm512_add_ps(tmp1, tmp2);  // Square modulus duplicated in both components
+    tmp1 = _mm512_sqrt_ps(tmp1);
+    return _mm512_div_ps(z, tmp1);
+}
+
+#endif /* INCLUDED_VOLK_VOLK_AVX512_INTRINSICS_H */
@@ -0,0 +1,132 @@
+/*!
+ * \file volk_gnsssdr_32f_grid_peakxnpuppet_32u.h
+ * \brief Volk puppet for the 2D acquisition grid peak search kernel.
+ * \authors <ul>
+ *          <li> Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *          </ul>
+ *
+ * Volk puppet for integrating the 2D grid peak search into volk's test
+ * system. The test input vector is carved into rows of a magnitude grid,
+ * and the peak values and indices are packed into the output vector: the
+ * peak position as plain integers, the peak values bit-copied, which is an
+ * exact comparison because the kernel selects elements of the grid without
+ * arithmetic on them.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32f_grid_peakxnpuppet_32u_H
+#define INCLUDED_volk_gnsssdr_32f_grid_peakxnpuppet_32u_H
+
+#include "volk_gnsssdr/volk_gnsssdr_32f_xn_grid_peak_32u.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <string.h>
+
+#define PUPPET_GRID_MAX_ROWS 8
+#define PUPPET_GRID_EXCLUDE_RADIUS 2
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32f_grid_peakxnpuppet_32u_generic(uint32_t* result, const float* input, unsigned int num_points)
+{
+    uint32_t num_rows = PUPPET_GRID_MAX_ROWS;
+    const float* rows[PUPPET_GRID_MAX_ROWS];
+    uint32_t row_points;
+    uint32_t i;
+    float peak;
+    float second_peak;
+    uint32_t row_index;
+    uint32_t col_index;
+    if (num_points < 4 * PUPPET_GRID_MAX_ROWS)
+        {
+            return;
+        }
+    row_points = num_points / num_rows;
+    for (i = 0; i < num_rows; i++)
+        {
+            rows[i] = input + i * row_points;
+        }
+    volk_gnsssdr_32f_xn_grid_peak_32u_generic(&peak, &second_peak, &row_index, &col_index, rows, PUPPET_GRID_EXCLUDE_RADIUS, num_rows, row_points);
+    result[0] = row_index;
+    result[1] = col_index;
+    memcpy(&result[2], &peak, sizeof(float));
+    memcpy(&result[3], &second_peak, sizeof(float));
+}
+
+#endif  // Generic
+
+
+#ifdef LV_HAVE_AVX2
+
+static inline void volk_gnsssdr_32f_grid_peakxnpuppet_32u_u_avx2(uint32_t* result, const float* input, unsigned int num_points)
+{
+    uint32_t num_rows = PUPPET_GRID_MAX_ROWS;
+    const float* rows[PUPPET_GRID_MAX_ROWS];
+    uint32_t row_points;
+    uint32_t i;
+    float peak;
+    float second_peak;
+    uint32_t row_index;
+    uint32_t col_index;
+    if (num_points < 4 * PUPPET_GRID_MAX_ROWS)
+        {
+            return;
+        }
+    row_points = num_points / num_rows;
+    for (i = 0; i < num_rows; i++)
+        {
+            rows[i] = input + i * row_points;
+        }
+#ifndef WIN32
+    volk_gnsssdr_32f_xn_grid_peak_32u_u_avx2(&peak, &second_peak, &row_index, &col_index, rows, PUPPET_GRID_EXCLUDE_RADIUS, num_rows, row_points);
+#else
+    volk_gnsssdr_32f_xn_grid_peak_32u_generic(&peak, &second_peak, &row_index, &col_index, rows, PUPPET_GRID_EXCLUDE_RADIUS, num_rows, row_points);
+#endif
+    result[0] = row_index;
+    result[1] = col_index;
+    memcpy(&result[2], &peak, sizeof(float));
+    memcpy(&result[3], &second_peak, sizeof(float));
+}
+
+#endif  // AVX2
+
+
+#ifdef LV_HAVE_NEON
+
+static inline void volk_gnsssdr_32f_grid_peakxnpuppet_32u_neon(uint32_t* result, const float* input, unsigned int num_points)
+{
+    uint32_t num_rows = PUPPET_GRID_MAX_ROWS;
+    const float* rows[PUPPET_GRID_MAX_ROWS];
+    uint32_t row_points;
+    uint32_t i;
+    float peak;
+    float second_peak;
+    uint32_t row_index;
+    uint32_t col_index;
+    if (num_points < 4 * PUPPET_GRID_MAX_ROWS)
+        {
+            return;
+        }
+    row_points = num_points / num_rows;
+    for (i = 0; i < num_rows; i++)
+        {
+            rows[i] = input + i * row_points;
+        }
+    volk_gnsssdr_32f_xn_grid_peak_32u_neon(&peak, &second_peak, &row_index, &col_index, rows, PUPPET_GRID_EXCLUDE_RADIUS, num_rows, row_points);
+    result[0] = row_index;
+    result[1] = col_index;
+    memcpy(&result[2], &peak, sizeof(float));
+    memcpy(&result[3], &second_peak, sizeof(float));
+}
+
+#endif  // NEON
+
+#endif  // INCLUDED_volk_gnsssdr_32f_grid_peakxnpuppet_32u_H
@@ -734,4 +734,224 @@ static inline void volk_gnsssdr_32f_sincos_32fc_neon(lv_32fc_t* out, const float
 #endif /* LV_HAVE_NEONV7  */
 
 
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+#include <volk_gnsssdr/volk_gnsssdr_sine_table.h>
+#include <stdint.h>
+/* Table-based variant: vectorized range reduction and linear interpolation,
+ * with the same 10-bit sine table (8 kB, L1-resident) as the generic_fxpt
+ * implementation. Max absolute error is that of the table, 2.4e-6. */
+static inline void volk_gnsssdr_32f_sincos_32fc_u_sse2_fxpt(lv_32fc_t* out, const float* in, unsigned int num_points)
+{
+    lv_32fc_t* bPtr = out;
+    const float* aPtr = in;
+    const unsigned int sse_iters = num_points / 4;
+    unsigned int number = 0;
+    unsigned int k = 0;
+
+    const float PI = 3.14159265358979323846;
+    const float TWO_TO_THE_31_DIV_PI = 2147483648.0 / PI;
+    const float TWO_PI = PI * 2;
+    const int32_t bitlength = 32;
+    const int32_t Nbits = 10;
+    const int32_t diffbits = bitlength - Nbits;
+
+    const __m128 two_pi_reg = _mm_set1_ps(TWO_PI);
+    const __m128 inv_two_pi_reg = _mm_set1_ps(1.0f / TWO_PI);
+    const __m128 half_reg = _mm_set1_ps(0.5f);
+    const __m128 fones = _mm_set1_ps(1.0f);
+    const __m128 scale_reg = _mm_set1_ps(TWO_TO_THE_31_DIV_PI);
+    const __m128i cos_offset_reg = _mm_set1_epi32(0x40000000);
+
+    __m128 x, y, yf, igx, r, arg_sin, arg_cos, sine, cosine;
+    __m128i d, ux_sin, ux_cos;
+
+    __VOLK_ATTR_ALIGNED(16)
+    uint32_t sin_index[4];
+    __VOLK_ATTR_ALIGNED(16)
+    uint32_t cos_index[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float sin_slope[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float sin_icpt[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float cos_slope[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float cos_icpt[4];
+
+    float _in;
+    int32_t xs, sin_index_, cos_index_, ds;
+    uint32_t uxs;
+    float s, c;
+
+    for (; number < sse_iters; number++)
+        {
+            x = _mm_loadu_ps(aPtr);
+            __VOLK_GNSSSDR_PREFETCH(aPtr + 8);
+
+            // d = floor(x / (2 * PI) + 0.5)
+            y = _mm_add_ps(_mm_mul_ps(x, inv_two_pi_reg), half_reg);
+            d = _mm_cvttps_epi32(y);
+            yf = _mm_cvtepi32_ps(d);
+            igx = _mm_cmpgt_ps(yf, y);
+            yf = _mm_sub_ps(yf, _mm_and_ps(igx, fones));
+
+            // reduce to [-PI, PI) and convert to fixed point
+            r = _mm_sub_ps(x, _mm_mul_ps(yf, two_pi_reg));
+            ux_sin = _mm_cvttps_epi32(_mm_mul_ps(r, scale_reg));
+            ux_cos = _mm_add_epi32(ux_sin, cos_offset_reg);
+
+            _mm_store_si128((__m128i*)sin_index, _mm_srli_epi32(ux_sin, diffbits));
+            _mm_store_si128((__m128i*)cos_index, _mm_srli_epi32(ux_cos, diffbits));
+
+            // interpolation argument: (ux >> 1) always fits in a positive int32
+            arg_sin = _mm_cvtepi32_ps(_mm_srli_epi32(ux_sin, 1));
+            arg_cos = _mm_cvtepi32_ps(_mm_srli_epi32(ux_cos, 1));
+
+            for (k = 0; k < 4; k++)
+                {
+                    sin_slope[k] = sine_table_10bits[sin_index[k]][0];
+                    sin_icpt[k] = sine_table_10bits[sin_index[k]][1];
+                    cos_slope[k] = sine_table_10bits[cos_index[k]][0];
+                    cos_icpt[k] = sine_table_10bits[cos_index[k]][1];
+                }
+
+            sine = _mm_add_ps(_mm_mul_ps(_mm_load_ps(sin_slope), arg_sin), _mm_load_ps(sin_icpt));
+            cosine = _mm_add_ps(_mm_mul_ps(_mm_load_ps(cos_slope), arg_cos), _mm_load_ps(cos_icpt));
+
+            _mm_storeu_ps((float*)bPtr, _mm_unpacklo_ps(cosine, sine));
+            _mm_storeu_ps((float*)(bPtr + 2), _mm_unpackhi_ps(cosine, sine));
+            bPtr += 4;
+            aPtr += 4;
+        }
+
+    for (number = sse_iters * 4; number < num_points; number++)
+        {
+            _in = *aPtr++;
+            ds = (int32_t)floor(_in / TWO_PI + 0.5);
+            _in -= ds * TWO_PI;
+            xs = (int32_t)((float)_in * TWO_TO_THE_31_DIV_PI);
+
+            uxs = xs;
+            sin_index_ = uxs >> diffbits;
+            s = sine_table_10bits[sin_index_][0] * (uxs >> 1) + sine_table_10bits[sin_index_][1];
+
+            uxs = xs + 0x40000000;
+            cos_index_ = uxs >> diffbits;
+            c = sine_table_10bits[cos_index_][0] * (uxs >> 1) + sine_table_10bits[cos_index_][1];
+
+            *bPtr++ = lv_cmake((float)c, (float)s);
+        }
+}
+
+#endif /* LV_HAVE_SSE2  */
+
+
+#ifdef LV_HAVE_NEONV7
+#include <arm_neon.h>
+#include <volk_gnsssdr/volk_gnsssdr_sine_table.h>
+#include <stdint.h>
+/* Table-based variant: vectorized range reduction and linear interpolation,
+ * with the same 10-bit sine table (8 kB, L1-resident) as the generic_fxpt
+ * implementation. Max absolute error is that of the table, 2.4e-6. */
+static inline void volk_gnsssdr_32f_sincos_32fc_neon_fxpt(lv_32fc_t* out, const float* in, unsigned int num_points)
+{
+    lv_32fc_t* bPtr = out;
+    const float* aPtr = in;
+    const unsigned int neon_iters = num_points / 4;
+    unsigned int number = 0;
+    unsigned int k = 0;
+
+    const float PI = 3.14159265358979323846;
+    const float TWO_TO_THE_31_DIV_PI = 2147483648.0 / PI;
+    const float TWO_PI = PI * 2;
+    const int32_t bitlength = 32;
+    const int32_t Nbits = 10;
+    const int32_t diffbits = bitlength - Nbits;
+
+    float32x4_t x, y, yf, r, arg_sin, arg_cos;
+    int32x4_t d;
+    uint32x4_t igx, ux_sin, ux_cos;
+    float32x4x2_t result;
+
+    __VOLK_ATTR_ALIGNED(16)
+    uint32_t sin_index[4];
+    __VOLK_ATTR_ALIGNED(16)
+    uint32_t cos_index[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float sin_slope[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float sin_icpt[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float cos_slope[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float cos_icpt[4];
+
+    float _in;
+    int32_t xs, sin_index_, cos_index_, ds;
+    uint32_t uxs;
+    float s, c;
+
+    for (; number < neon_iters; number++)
+        {
+            x = vld1q_f32(aPtr);
+            __VOLK_GNSSSDR_PREFETCH(aPtr + 8);
+
+            // d = floor(x / (2 * PI) + 0.5)
+            y = vmlaq_n_f32(vdupq_n_f32(0.5f), x, 1.0f / TWO_PI);
+            d = vcvtq_s32_f32(y);
+            yf = vcvtq_f32_s32(d);
+            igx = vcgtq_f32(yf, y);
+            yf = vsubq_f32(yf, vreinterpretq_f32_u32(vandq_u32(igx, vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+
+            // reduce to [-PI, PI) and convert to fixed point
+            r = vmlsq_n_f32(x, yf, TWO_PI);
+            ux_sin = vreinterpretq_u32_s32(vcvtq_s32_f32(vmulq_n_f32(r, TWO_TO_THE_31_DIV_PI)));
+            ux_cos = vaddq_u32(ux_sin, vdupq_n_u32(0x40000000));
+
+            vst1q_u32(sin_index, vshrq_n_u32(ux_sin, 22));
+            vst1q_u32(cos_index, vshrq_n_u32(ux_cos, 22));
+
+            // interpolation argument: (ux >> 1) always fits in a positive int32
+            arg_sin = vcvtq_f32_u32(vshrq_n_u32(ux_sin, 1));
+            arg_cos = vcvtq_f32_u32(vshrq_n_u32(ux_cos, 1));
+
+            for (k = 0; k < 4; k++)
+                {
+                    sin_slope[k] = sine_table_10bits[sin_index[k]][0];
+                    sin_icpt[k] = sine_table_10bits[sin_index[k]][1];
+                    cos_slope[k] = sine_table_10bits[cos_index[k]][0];
+                    cos_icpt[k] = sine_table_10bits[cos_index[k]][1];
+                }
+
+            result.val[0] = vmlaq_f32(vld1q_f32(cos_icpt), vld1q_f32(cos_slope), arg_cos);
+            result.val[1] = vmlaq_f32(vld1q_f32(sin_icpt), vld1q_f32(sin_slope), arg_sin);
+
+            vst2q_f32((float32_t*)bPtr, result);
+            bPtr += 4;
+            aPtr += 4;
+        }
+
+    for (number = neon_iters * 4; number < num_points; number++)
+        {
+            _in = *aPtr++;
+            ds = (int32_t)floor(_in / TWO_PI + 0.5);
+            _in -= ds * TWO_PI;
+            xs = (int32_t)((float)_in * TWO_TO_THE_31_DIV_PI);
+
+            uxs = xs;
+            sin_index_ = uxs >> diffbits;
+            s = sine_table_10bits[sin_index_][0] * (uxs >> 1) + sine_table_10bits[sin_index_][1];
+
+            uxs = xs + 0x40000000;
+            cos_index_ = uxs >> diffbits;
+            c = sine_table_10bits[cos_index_][0] * (uxs >> 1) + sine_table_10bits[cos_index_][1];
+
+            *bPtr++ = lv_cmake((float)c, (float)s);
+        }
+}
+
+#endif /* LV_HAVE_NEONV7  */
+
+
 #endif /* INCLUDED_volk_gnsssdr_32f_sincos_32fc_H  */
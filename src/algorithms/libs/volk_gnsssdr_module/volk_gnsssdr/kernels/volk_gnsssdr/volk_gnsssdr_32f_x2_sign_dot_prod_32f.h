@@ -0,0 +1,153 @@
+/*!
+ * \file volk_gnsssdr_32f_x2_sign_dot_prod_32f.h
+ * \brief VOLK_GNSSSDR kernel: Hard-limited dot product between a symbol
+ * vector and a reference sequence.
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+/*!
+ * \page volk_gnsssdr_32f_x2_sign_dot_prod_32f.h
+ *
+ * \b Overview
+ *
+ * Computes the dot product between the signs of the input symbols and a
+ * reference sequence: result = sum_i sign(symbols[i]) * reference[i],
+ * with sign(0) = +1. This is the matched filter used by the telemetry
+ * decoders to correlate the hard-limited symbol history against the
+ * frame preamble.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * volk_gnsssdr_32f_x2_sign_dot_prod_32f(float* result, const float* symbols, const float* reference, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li symbols: The soft symbols; only their signs are used.
+ * \li reference: The reference sequence (typically +1/-1 preamble samples).
+ * \li num_points: The number of values in both input vectors.
+ *
+ * \b Outputs
+ * \li result: The hard-limited correlation value.
+ *
+ */
+
+
+#ifndef INCLUDED_volk_gnsssdr_32f_x2_sign_dot_prod_32f_H
+#define INCLUDED_volk_gnsssdr_32f_x2_sign_dot_prod_32f_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32f_x2_sign_dot_prod_32f_generic(float* result, const float* symbols, const float* reference, unsigned int num_points)
+{
+    float sum = 0.0f;
+    unsigned int i;
+    for (i = 0; i < num_points; i++)
+        {
+            if (symbols[i] < 0.0f)
+                {
+                    sum -= reference[i];
+                }
+            else
+                {
+                    sum += reference[i];
+                }
+        }
+    *result = sum;
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_32f_x2_sign_dot_prod_32f_u_sse2(float* result, const float* symbols, const float* reference, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    unsigned int i;
+    // sign(s) * r is r with its sign bit flipped wherever s is negative
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+    __m128 acc = _mm_setzero_ps();
+
+    for (i = 0; i < sse_iters; i++)
+        {
+            const __m128 s = _mm_loadu_ps(symbols + 4 * i);
+            const __m128 r = _mm_loadu_ps(reference + 4 * i);
+            acc = _mm_add_ps(acc, _mm_xor_ps(r, _mm_and_ps(s, sign_mask)));
+        }
+
+    __VOLK_ATTR_ALIGNED(16)
+    float acc_vector[4];
+    _mm_store_ps(acc_vector, acc);
+    float sum = acc_vector[0] + acc_vector[1] + acc_vector[2] + acc_vector[3];
+
+    for (i = sse_iters * 4; i < num_points; i++)
+        {
+            if (symbols[i] < 0.0f)
+                {
+                    sum -= reference[i];
+                }
+            else
+                {
+                    sum += reference[i];
+                }
+        }
+    *result = sum;
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32f_x2_sign_dot_prod_32f_neon(float* result, const float* symbols, const float* reference, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 4;
+    unsigned int i;
+    const uint32x4_t sign_mask = vdupq_n_u32(0x80000000);
+    float32x4_t acc = vdupq_n_f32(0.0f);
+
+    for (i = 0; i < neon_iters; i++)
+        {
+            const uint32x4_t s = vreinterpretq_u32_f32(vld1q_f32(symbols + 4 * i));
+            const uint32x4_t r = vreinterpretq_u32_f32(vld1q_f32(reference + 4 * i));
+            acc = vaddq_f32(acc, vreinterpretq_f32_u32(veorq_u32(r, vandq_u32(s, sign_mask))));
+        }
+
+    __VOLK_ATTR_ALIGNED(16)
+    float acc_vector[4];
+    vst1q_f32(acc_vector, acc);
+    float sum = acc_vector[0] + acc_vector[1] + acc_vector[2] + acc_vector[3];
+
+    for (i = neon_iters * 4; i < num_points; i++)
+        {
+            if (symbols[i] < 0.0f)
+                {
+                    sum -= reference[i];
+                }
+            else
+                {
+                    sum += reference[i];
+                }
+        }
+    *result = sum;
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32f_x2_sign_dot_prod_32f_H */
@@ -0,0 +1,328 @@
+/*!
+ * \file volk_gnsssdr_32f_xn_grid_peak_32u.h
+ * \brief VOLK_GNSSSDR kernel: Finds the peak of a 2D acquisition magnitude grid,
+ * together with the second peak outside an exclusion zone of the peak row.
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+/*!
+ * \page volk_gnsssdr_32f_xn_grid_peak_32u.h
+ *
+ * \b Overview
+ *
+ * Reduces a whole Doppler/code-phase magnitude grid in one pass, returning
+ * the global peak value with its (row, column) position and the second
+ * highest value of the peak row outside a circular exclusion zone around
+ * the peak column. The second peak is the denominator of the
+ * peak-to-second-peak acquisition test statistic, which otherwise costs a
+ * second full scan of the peak row.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * volk_gnsssdr_32f_xn_grid_peak_32u(float* peak, float* second_peak, uint32_t* row_index, uint32_t* col_index, const float** grid, uint32_t exclude_radius, uint32_t num_rows, uint32_t num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li grid: Array of num_rows pointers, each to a row of num_points floats.
+ * \li exclude_radius: Radius (in columns, circular) excluded around the peak when searching the second peak.
+ * \li num_rows: The number of rows (Doppler bins).
+ * \li num_points: The number of columns (code phases) per row.
+ *
+ * \b Outputs
+ * \li peak: The maximum value of the grid.
+ * \li second_peak: The maximum value of the peak row outside the exclusion zone.
+ * \li row_index: Row of the peak.
+ * \li col_index: Column of the peak.
+ *
+ */
+
+
+#ifndef INCLUDED_volk_gnsssdr_32f_xn_grid_peak_32u_H
+#define INCLUDED_volk_gnsssdr_32f_xn_grid_peak_32u_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <inttypes.h>
+
+
+static inline void volk_gnsssdr_32f_xn_grid_peak_32u_row_max(uint32_t* target, float* max_value, const float* src0, uint32_t num_points)
+{
+    // scalar single-row reduction, shared by the protokernels below for the
+    // rows where the SIMD path is not worth dispatching
+    uint32_t index = 0;
+    float max = src0[0];
+    uint32_t i;
+    for (i = 1; i < num_points; i++)
+        {
+            if (src0[i] > max)
+                {
+                    index = i;
+                    max = src0[i];
+                }
+        }
+    *target = index;
+    *max_value = max;
+}
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32f_xn_grid_peak_32u_generic(float* peak, float* second_peak, uint32_t* row_index, uint32_t* col_index, const float** grid, uint32_t exclude_radius, uint32_t num_rows, uint32_t num_points)
+{
+    uint32_t row;
+    uint32_t col;
+    uint32_t best_row = 0;
+    uint32_t best_col = 0;
+    float best = grid[0][0];
+
+    for (row = 0; row < num_rows; row++)
+        {
+            uint32_t row_col;
+            float row_max;
+            volk_gnsssdr_32f_xn_grid_peak_32u_row_max(&row_col, &row_max, grid[row], num_points);
+            if (row_max > best)
+                {
+                    best = row_max;
+                    best_row = row;
+                    best_col = row_col;
+                }
+        }
+
+    // Second peak of the winning row, skipping the circular exclusion zone
+    float second = 0.0f;
+    const float* best_row_ptr = grid[best_row];
+    for (col = 0; col < num_points; col++)
+        {
+            uint32_t distance = (col > best_col) ? (col - best_col) : (best_col - col);
+            if (distance > num_points / 2)
+                {
+                    distance = num_points - distance;
+                }
+            if (distance > exclude_radius)
+                {
+                    if (best_row_ptr[col] > second)
+                        {
+                            second = best_row_ptr[col];
+                        }
+                }
+        }
+
+    *peak = best;
+    *second_peak = second;
+    *row_index = best_row;
+    *col_index = best_col;
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32f_xn_grid_peak_32u_u_avx2(float* peak, float* second_peak, uint32_t* row_index, uint32_t* col_index, const float** grid, uint32_t exclude_radius, uint32_t num_rows, uint32_t num_points)
+{
+    const uint32_t eighthPoints = num_points / 8;
+    uint32_t row;
+    uint32_t i;
+    uint32_t best_row = 0;
+    uint32_t best_col = 0;
+    float best = grid[0][0];
+
+    __VOLK_ATTR_ALIGNED(32)
+    float maxValuesBuffer[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float maxIndexesBuffer[8];
+
+    for (row = 0; row < num_rows; row++)
+        {
+            const float* inputPtr = grid[row];
+            const __m256 indexIncrementValues = _mm256_set1_ps(8);
+            __m256 currentIndexes = _mm256_set_ps(-1, -2, -3, -4, -5, -6, -7, -8);
+            float row_max = inputPtr[0];
+            uint32_t row_col = 0;
+            __m256 maxValues = _mm256_set1_ps(row_max);
+            __m256 maxValuesIndex = _mm256_setzero_ps();
+            __m256 compareResults;
+            __m256 currentValues;
+            uint32_t number;
+
+            for (number = 0; number < eighthPoints; number++)
+                {
+                    currentValues = _mm256_loadu_ps(inputPtr);
+                    inputPtr += 8;
+                    currentIndexes = _mm256_add_ps(currentIndexes, indexIncrementValues);
+                    compareResults = _mm256_cmp_ps(maxValues, currentValues, 0x1e);
+                    maxValuesIndex = _mm256_blendv_ps(currentIndexes, maxValuesIndex, compareResults);
+                    maxValues = _mm256_blendv_ps(currentValues, maxValues, compareResults);
+                }
+
+            _mm256_store_ps(maxValuesBuffer, maxValues);
+            _mm256_store_ps(maxIndexesBuffer, maxValuesIndex);
+
+            for (i = 0; i < 8; i++)
+                {
+                    if (maxValuesBuffer[i] > row_max)
+                        {
+                            row_col = (uint32_t)maxIndexesBuffer[i];
+                            row_max = maxValuesBuffer[i];
+                        }
+                }
+
+            for (number = eighthPoints * 8; number < num_points; number++)
+                {
+                    if (grid[row][number] > row_max)
+                        {
+                            row_col = number;
+                            row_max = grid[row][number];
+                        }
+                }
+
+            if (row_max > best)
+                {
+                    best = row_max;
+                    best_row = row;
+                    best_col = row_col;
+                }
+        }
+
+    // Second peak of the winning row: a scalar pass with a circular distance
+    // test, since the row is scanned once and the branchy exclusion zone does
+    // not map well to the blend-based vector max above
+    {
+        const float* best_row_ptr = grid[best_row];
+        float second = 0.0f;
+        uint32_t col;
+        for (col = 0; col < num_points; col++)
+            {
+                uint32_t distance = (col > best_col) ? (col - best_col) : (best_col - col);
+                if (distance > num_points / 2)
+                    {
+                        distance = num_points - distance;
+                    }
+                if (distance > exclude_radius)
+                    {
+                        if (best_row_ptr[col] > second)
+                            {
+                                second = best_row_ptr[col];
+                            }
+                    }
+            }
+        *second_peak = second;
+    }
+
+    *peak = best;
+    *row_index = best_row;
+    *col_index = best_col;
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32f_xn_grid_peak_32u_neon(float* peak, float* second_peak, uint32_t* row_index, uint32_t* col_index, const float** grid, uint32_t exclude_radius, uint32_t num_rows, uint32_t num_points)
+{
+    const uint32_t quarterPoints = num_points / 4;
+    uint32_t row;
+    uint32_t i;
+    uint32_t best_row = 0;
+    uint32_t best_col = 0;
+    float best = grid[0][0];
+
+    __VOLK_ATTR_ALIGNED(16)
+    float maxValuesBuffer[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float maxIndexesBuffer[4];
+
+    for (row = 0; row < num_rows; row++)
+        {
+            const float* inputPtr = grid[row];
+            float row_max = inputPtr[0];
+            uint32_t row_col = 0;
+            uint32_t number;
+
+            const float32x4_t indexIncrementValues = vdupq_n_f32(4);
+            float32x4_t currentIndexes = {-4.0f, -3.0f, -2.0f, -1.0f};
+            float32x4_t maxValues = vdupq_n_f32(row_max);
+            float32x4_t maxValuesIndex = vdupq_n_f32(0);
+
+            for (number = 0; number < quarterPoints; number++)
+                {
+                    const float32x4_t currentValues = vld1q_f32(inputPtr);
+                    inputPtr += 4;
+                    currentIndexes = vaddq_f32(currentIndexes, indexIncrementValues);
+                    const uint32x4_t greater = vcgtq_f32(currentValues, maxValues);
+                    maxValuesIndex = vbslq_f32(greater, currentIndexes, maxValuesIndex);
+                    maxValues = vbslq_f32(greater, currentValues, maxValues);
+                }
+
+            vst1q_f32(maxValuesBuffer, maxValues);
+            vst1q_f32(maxIndexesBuffer, maxValuesIndex);
+
+            for (i = 0; i < 4; i++)
+                {
+                    if (maxValuesBuffer[i] > row_max)
+                        {
+                            row_col = (uint32_t)maxIndexesBuffer[i];
+                            row_max = maxValuesBuffer[i];
+                        }
+                }
+
+            for (number = quarterPoints * 4; number < num_points; number++)
+                {
+                    if (grid[row][number] > row_max)
+                        {
+                            row_col = number;
+                            row_max = grid[row][number];
+                        }
+                }
+
+            if (row_max > best)
+                {
+                    best = row_max;
+                    best_row = row;
+                    best_col = row_col;
+                }
+        }
+
+    {
+        const float* best_row_ptr = grid[best_row];
+        float second = 0.0f;
+        uint32_t col;
+        for (col = 0; col < num_points; col++)
+            {
+                uint32_t distance = (col > best_col) ? (col - best_col) : (best_col - col);
+                if (distance > num_points / 2)
+                    {
+                        distance = num_points - distance;
+                    }
+                if (distance > exclude_radius)
+                    {
+                        if (best_row_ptr[col] > second)
+                            {
+                                second = best_row_ptr[col];
+                            }
+                    }
+            }
+        *second_peak = second;
+    }
+
+    *peak = best;
+    *row_index = best_row;
+    *col_index = best_col;
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32f_xn_grid_peak_32u_H */
@@ -0,0 +1,173 @@
+/*!
+ * \file volk_gnsssdr_32f_xn_multichannel_resampler_32f_xn.h
+ * \brief VOLK_GNSSSDR kernel: Resamples N 32 bits float vectors for M channels
+ * using zero hold resample algorithm.
+ * \authors <ul>
+ *          <li> Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *          </ul>
+ *
+ * VOLK_GNSSSDR kernel that resamples N 32 bits float vectors for M channels
+ * in a single call, using the zero hold resample algorithm. Each channel has
+ * its own local code, remnant code phase and code phase step, so the whole
+ * correlator bank of a multi-channel receiver is refreshed with one dispatch.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32f_xn_multichannel_resampler_32f_xn
+ *
+ * \b Overview
+ *
+ * Resamples N complex 32-bit float vectors for M channels using zero hold
+ * resample algorithm. It is optimized to resample the local code vectors of
+ * several tracking channels in one call, amortizing the per-call dispatch and
+ * loop setup over the whole channel bank. All channels share the code length,
+ * the tap shifts and the number of output points.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32f_xn_multichannel_resampler_32f_xn(float** result, const float** local_codes, const float* rem_code_phase_chips, const float* code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, int num_channels, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li local_codes:           Vector of pointers to one code per channel, replicas of the desired code. The code is generated at 1 sample/chip.
+ * \li rem_code_phase_chips:  Vector of \p num_channels remnant code phases, in chips.
+ * \li code_phase_step_chips: Vector of \p num_channels phase increments per sample, in chips.
+ * \li shifts_chips:          Vector of \p num_out_vectors offsets of the first sample, in chips, shared by all channels.
+ * \li code_length_chips:     Code length in chips.
+ * \li num_out_vectors:       Number of output vectors per channel.
+ * \li num_channels:          Number of channels.
+ * \li num_points:            Number of samples of each output vector.
+ *
+ * \b Outputs
+ * \li result:                Vector of \p num_channels x \p num_out_vectors pointers, channel-major, with the resampled codes.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32f_xn_multichannel_resampler_32f_xn_H
+#define INCLUDED_volk_gnsssdr_32f_xn_multichannel_resampler_32f_xn_H
+
+#include "volk_gnsssdr/volk_gnsssdr_32f_xn_resampler_32f_xn.h"
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32f_xn_multichannel_resampler_32f_xn_generic(float** result, const float** local_codes, const float* rem_code_phase_chips, const float* code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, int num_channels, unsigned int num_points)
+{
+    int ch;
+    for (ch = 0; ch < num_channels; ch++)
+        {
+            volk_gnsssdr_32f_xn_resampler_32f_xn_generic(&result[ch * num_out_vectors], local_codes[ch], rem_code_phase_chips[ch], code_phase_step_chips[ch], shifts_chips, code_length_chips, num_out_vectors, num_points);
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE3
+
+static inline void volk_gnsssdr_32f_xn_multichannel_resampler_32f_xn_a_sse3(float** result, const float** local_codes, const float* rem_code_phase_chips, const float* code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, int num_channels, unsigned int num_points)
+{
+    int ch;
+    for (ch = 0; ch < num_channels; ch++)
+        {
+            volk_gnsssdr_32f_xn_resampler_32f_xn_a_sse3(&result[ch * num_out_vectors], local_codes[ch], rem_code_phase_chips[ch], code_phase_step_chips[ch], shifts_chips, code_length_chips, num_out_vectors, num_points);
+        }
+}
+
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_SSE3
+
+static inline void volk_gnsssdr_32f_xn_multichannel_resampler_32f_xn_u_sse3(float** result, const float** local_codes, const float* rem_code_phase_chips, const float* code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, int num_channels, unsigned int num_points)
+{
+    int ch;
+    for (ch = 0; ch < num_channels; ch++)
+        {
+            volk_gnsssdr_32f_xn_resampler_32f_xn_u_sse3(&result[ch * num_out_vectors], local_codes[ch], rem_code_phase_chips[ch], code_phase_step_chips[ch], shifts_chips, code_length_chips, num_out_vectors, num_points);
+        }
+}
+
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void volk_gnsssdr_32f_xn_multichannel_resampler_32f_xn_a_sse4_1(float** result, const float** local_codes, const float* rem_code_phase_chips, const float* code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, int num_channels, unsigned int num_points)
+{
+    int ch;
+    for (ch = 0; ch < num_channels; ch++)
+        {
+            volk_gnsssdr_32f_xn_resampler_32f_xn_a_sse4_1(&result[ch * num_out_vectors], local_codes[ch], rem_code_phase_chips[ch], code_phase_step_chips[ch], shifts_chips, code_length_chips, num_out_vectors, num_points);
+        }
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void volk_gnsssdr_32f_xn_multichannel_resampler_32f_xn_u_sse4_1(float** result, const float** local_codes, const float* rem_code_phase_chips, const float* code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, int num_channels, unsigned int num_points)
+{
+    int ch;
+    for (ch = 0; ch < num_channels; ch++)
+        {
+            volk_gnsssdr_32f_xn_resampler_32f_xn_u_sse4_1(&result[ch * num_out_vectors], local_codes[ch], rem_code_phase_chips[ch], code_phase_step_chips[ch], shifts_chips, code_length_chips, num_out_vectors, num_points);
+        }
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_AVX
+
+static inline void volk_gnsssdr_32f_xn_multichannel_resampler_32f_xn_a_avx(float** result, const float** local_codes, const float* rem_code_phase_chips, const float* code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, int num_channels, unsigned int num_points)
+{
+    int ch;
+    for (ch = 0; ch < num_channels; ch++)
+        {
+            volk_gnsssdr_32f_xn_resampler_32f_xn_a_avx(&result[ch * num_out_vectors], local_codes[ch], rem_code_phase_chips[ch], code_phase_step_chips[ch], shifts_chips, code_length_chips, num_out_vectors, num_points);
+        }
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_AVX
+
+static inline void volk_gnsssdr_32f_xn_multichannel_resampler_32f_xn_u_avx(float** result, const float** local_codes, const float* rem_code_phase_chips, const float* code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, int num_channels, unsigned int num_points)
+{
+    int ch;
+    for (ch = 0; ch < num_channels; ch++)
+        {
+            volk_gnsssdr_32f_xn_resampler_32f_xn_u_avx(&result[ch * num_out_vectors], local_codes[ch], rem_code_phase_chips[ch], code_phase_step_chips[ch], shifts_chips, code_length_chips, num_out_vectors, num_points);
+        }
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_NEONV7
+
+static inline void volk_gnsssdr_32f_xn_multichannel_resampler_32f_xn_neon(float** result, const float** local_codes, const float* rem_code_phase_chips, const float* code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, int num_channels, unsigned int num_points)
+{
+    int ch;
+    for (ch = 0; ch < num_channels; ch++)
+        {
+            volk_gnsssdr_32f_xn_resampler_32f_xn_neon(&result[ch * num_out_vectors], local_codes[ch], rem_code_phase_chips[ch], code_phase_step_chips[ch], shifts_chips, code_length_chips, num_out_vectors, num_points);
+        }
+}
+
+#endif /* LV_HAVE_NEONV7 */
+
+#endif /* INCLUDED_volk_gnsssdr_32f_xn_multichannel_resampler_32f_xn_H */
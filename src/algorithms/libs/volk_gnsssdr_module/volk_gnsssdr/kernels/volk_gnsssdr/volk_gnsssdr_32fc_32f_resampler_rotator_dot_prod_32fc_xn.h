@@ -0,0 +1,464 @@
+/*!
+ * \file volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn.h
+ * \brief VOLK_GNSSSDR kernel: resamples a real reference code, rotates a complex vector
+ * and multiplies both, accumulating the results in N float complex outputs.
+ * \authors <ul>
+ *          <li> Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *          </ul>
+ *
+ * VOLK_GNSSSDR kernel that fuses the zero-hold code resampler with the phase
+ * rotator and multiple correlator. The resampled code value is generated on
+ * the fly inside the correlation loop, so the N intermediate resampled code
+ * vectors never touch memory.
+ * It is optimized to perform the N tap correlation process in GNSS receivers.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn
+ *
+ * \b Overview
+ *
+ * Rotates the reference complex vector, resamples a single real local code into
+ * an arbitrary number of fractional-delayed replicas (zero hold algorithm),
+ * multiplies the rotated vector with each replica, accumulates the results and
+ * stores them in the output vector. Equivalent to calling
+ * volk_gnsssdr_32f_xn_resampler_32f_xn followed by
+ * volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn, without materializing the
+ * intermediate resampled code vectors.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_a_vectors, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li in_common:             Pointer to the complex vector to be rotated, multiplied and accumulated (reference vector).
+ * \li phase_inc:             Phase increment = lv_cmake(cos(phase_step_rad), sin(phase_step_rad))
+ * \li phase:                 Initial phase = lv_cmake(cos(initial_phase_rad), sin(initial_phase_rad))
+ * \li local_code:            Vector with the real code to be resampled.
+ * \li rem_code_phase_chips:  Remnant code phase [chips].
+ * \li code_phase_step_chips: Phase increment per sample [chips/sample].
+ * \li shifts_chips:          Vector of floats that defines the spacing (in chips) between the replicas of \p local_code.
+ * \li code_length_chips:     Code length in chips.
+ * \li num_a_vectors:         Number of replicas to be correlated against the reference vector.
+ * \li num_points:            Number of complex values to be rotated, multiplied together, accumulated and stored into \p result.
+ *
+ * \b Outputs
+ * \li phase:                 Final phase.
+ * \li result:                Vector of \p num_a_vectors components with the rotated reference vector correlated against the resampled replicas.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_H
+#define INCLUDED_volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_H
+
+
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <math.h>
+#include <stdlib.h> /* abs */
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_generic(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_a_vectors, unsigned int num_points)
+{
+    lv_32fc_t tmp32_1;
+    int local_code_chip_index;
+    int n_vec;
+    unsigned int n;
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            result[n_vec] = lv_cmake(0.0f, 0.0f);
+        }
+    for (n = 0; n < num_points; n++)
+        {
+            tmp32_1 = *in_common++ * (*phase);
+
+            // Regenerate phase
+            if (n % 256 == 0)
+                {
+#ifdef __cplusplus
+                    (*phase) /= std::abs((*phase));
+#else
+                    (*phase) /= hypotf(lv_creal(*phase), lv_cimag(*phase));
+#endif
+                }
+
+            (*phase) *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index = (int)floor(code_phase_step_chips * (float)n + shifts_chips[n_vec] - rem_code_phase_chips);
+                    // Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index < 0) local_code_chip_index += (int)code_length_chips * (abs(local_code_chip_index) / code_length_chips + 1);
+                    local_code_chip_index = local_code_chip_index % code_length_chips;
+                    result[n_vec] += tmp32_1 * local_code[local_code_chip_index];
+                }
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_AVX2
+#include <volk_gnsssdr/volk_gnsssdr_avx_intrinsics.h>
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_u_avx2(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_a_vectors, unsigned int num_points)
+{
+#ifndef WIN32
+    unsigned int number = 0;
+    int vec_ind = 0;
+    unsigned int i = 0;
+    unsigned int k = 0;
+    const unsigned int eighthPoints = num_points / 8;
+
+    const float* aPtr = (float*)in_common;
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+    int local_code_chip_index_;
+
+    const __m256 eights = _mm256_set1_ps(8.0f);
+    const __m256 rem_code_phase_chips_reg = _mm256_set1_ps(rem_code_phase_chips);
+    const __m256 code_phase_step_chips_reg = _mm256_set1_ps(code_phase_step_chips);
+    const __m256 zeros = _mm256_setzero_ps();
+    const __m256 code_length_chips_reg_f = _mm256_set1_ps((float)code_length_chips);
+    const __m256 n0 = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+
+    __VOLK_ATTR_ALIGNED(32)
+    int local_code_chip_index[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float local_code_taps[8];
+
+    __m256i local_code_chip_index_reg, it;
+    __m256 aux, aux3, c, cTrunc, base, negatives;
+    __m256 a0Val, a1Val;
+    __m256 xVal, xloVal, xhiVal, b0Val, b1Val;
+
+    __m256 aux2[num_a_vectors];
+    __m256 dotProdVal0[num_a_vectors];
+    __m256 dotProdVal1[num_a_vectors];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            aux2[vec_ind] = _mm256_sub_ps(_mm256_set1_ps(shifts_chips[vec_ind]), rem_code_phase_chips_reg);
+            dotProdVal0[vec_ind] = _mm256_setzero_ps();
+            dotProdVal1[vec_ind] = _mm256_setzero_ps();
+        }
+
+    // Set up the complex rotator
+    __m256 z0, z1;
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t phase_vec[8];
+    for (vec_ind = 0; vec_ind < 8; ++vec_ind)
+        {
+            phase_vec[vec_ind] = _phase;
+            _phase *= phase_inc;
+        }
+
+    z0 = _mm256_load_ps((float*)phase_vec);
+    z1 = _mm256_load_ps((float*)(phase_vec + 4));
+
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^8;
+
+    for (vec_ind = 0; vec_ind < 4; ++vec_ind)
+        {
+            phase_vec[vec_ind] = dz;
+        }
+
+    __m256 dz_reg = _mm256_load_ps((float*)phase_vec);
+    dz_reg = _mm256_complexnormalise_ps(dz_reg);
+
+    __m256 indexn = n0;
+
+    for (; number < eighthPoints; number++)
+        {
+            a0Val = _mm256_loadu_ps(aPtr);
+            a1Val = _mm256_loadu_ps(aPtr + 8);
+
+            a0Val = _mm256_complexmul_ps(a0Val, z0);
+            a1Val = _mm256_complexmul_ps(a1Val, z1);
+
+            z0 = _mm256_complexmul_ps(z0, dz_reg);
+            z1 = _mm256_complexmul_ps(z1, dz_reg);
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    // resample the code for the current tap, in-register
+                    aux = _mm256_fmadd_ps(code_phase_step_chips_reg, indexn, aux2[vec_ind]);
+                    // floor
+                    aux = _mm256_floor_ps(aux);
+                    // fmod
+                    c = _mm256_div_ps(aux, code_length_chips_reg_f);
+                    it = _mm256_cvttps_epi32(c);
+                    cTrunc = _mm256_cvtepi32_ps(it);
+                    base = _mm256_fnmadd_ps(cTrunc, code_length_chips_reg_f, aux);
+                    local_code_chip_index_reg = _mm256_cvttps_epi32(base);
+
+                    // no negatives
+                    c = _mm256_cvtepi32_ps(local_code_chip_index_reg);
+                    negatives = _mm256_cmp_ps(c, zeros, 0x01);
+                    aux3 = _mm256_and_ps(code_length_chips_reg_f, negatives);
+                    aux = _mm256_add_ps(c, aux3);
+                    local_code_chip_index_reg = _mm256_cvttps_epi32(aux);
+
+                    _mm256_store_si256((__m256i*)local_code_chip_index, local_code_chip_index_reg);
+                    for (k = 0; k < 8; ++k)
+                        {
+                            local_code_taps[k] = local_code[local_code_chip_index[k]];
+                        }
+
+                    xVal = _mm256_load_ps(local_code_taps);                 // t0|t1|t2|t3|t4|t5|t6|t7
+                    xloVal = _mm256_unpacklo_ps(xVal, xVal);                // t0|t0|t1|t1|t4|t4|t5|t5
+                    xhiVal = _mm256_unpackhi_ps(xVal, xVal);                // t2|t2|t3|t3|t6|t6|t7|t7
+                    b0Val = _mm256_permute2f128_ps(xloVal, xhiVal, 0x20);   // t0|t0|t1|t1|t2|t2|t3|t3
+                    b1Val = _mm256_permute2f128_ps(xloVal, xhiVal, 0x31);   // t4|t4|t5|t5|t6|t6|t7|t7
+
+                    dotProdVal0[vec_ind] = _mm256_fmadd_ps(a0Val, b0Val, dotProdVal0[vec_ind]);
+                    dotProdVal1[vec_ind] = _mm256_fmadd_ps(a1Val, b1Val, dotProdVal1[vec_ind]);
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    z0 = _mm256_complexnormalise_ps(z0);
+                    z1 = _mm256_complexnormalise_ps(z1);
+                }
+
+            indexn = _mm256_add_ps(indexn, eights);
+            aPtr += 16;
+        }
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t dotProductVector[4];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            dotProdVal0[vec_ind] = _mm256_add_ps(dotProdVal0[vec_ind], dotProdVal1[vec_ind]);
+
+            _mm256_store_ps((float*)dotProductVector, dotProdVal0[vec_ind]);  // Store the results back into the dot product vector
+
+            result[vec_ind] = lv_cmake(0.0f, 0.0f);
+            for (i = 0; i < 4; ++i)
+                {
+                    result[vec_ind] += dotProductVector[i];
+                }
+        }
+
+    z0 = _mm256_complexnormalise_ps(z0);
+    _mm256_store_ps((float*)phase_vec, z0);
+    _phase = phase_vec[0];
+
+    number = eighthPoints * 8;
+    for (; number < num_points; number++)
+        {
+            wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)number + shifts_chips[vec_ind] - rem_code_phase_chips);
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    result[vec_ind] += wo * local_code[local_code_chip_index_];
+                }
+        }
+
+    *phase = _phase;
+#else
+    volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_generic(result, in_common, phase_inc, phase, local_code, rem_code_phase_chips, code_phase_step_chips, shifts_chips, code_length_chips, num_a_vectors, num_points);
+#endif
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <volk_gnsssdr/volk_gnsssdr_avx_intrinsics.h>
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_a_avx2(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_a_vectors, unsigned int num_points)
+{
+#ifndef WIN32
+    unsigned int number = 0;
+    int vec_ind = 0;
+    unsigned int i = 0;
+    unsigned int k = 0;
+    const unsigned int eighthPoints = num_points / 8;
+
+    const float* aPtr = (float*)in_common;
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+    int local_code_chip_index_;
+
+    const __m256 eights = _mm256_set1_ps(8.0f);
+    const __m256 rem_code_phase_chips_reg = _mm256_set1_ps(rem_code_phase_chips);
+    const __m256 code_phase_step_chips_reg = _mm256_set1_ps(code_phase_step_chips);
+    const __m256 zeros = _mm256_setzero_ps();
+    const __m256 code_length_chips_reg_f = _mm256_set1_ps((float)code_length_chips);
+    const __m256 n0 = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+
+    __VOLK_ATTR_ALIGNED(32)
+    int local_code_chip_index[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float local_code_taps[8];
+
+    __m256i local_code_chip_index_reg, it;
+    __m256 aux, aux3, c, cTrunc, base, negatives;
+    __m256 a0Val, a1Val;
+    __m256 xVal, xloVal, xhiVal, b0Val, b1Val;
+
+    __m256 aux2[num_a_vectors];
+    __m256 dotProdVal0[num_a_vectors];
+    __m256 dotProdVal1[num_a_vectors];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            aux2[vec_ind] = _mm256_sub_ps(_mm256_set1_ps(shifts_chips[vec_ind]), rem_code_phase_chips_reg);
+            dotProdVal0[vec_ind] = _mm256_setzero_ps();
+            dotProdVal1[vec_ind] = _mm256_setzero_ps();
+        }
+
+    // Set up the complex rotator
+    __m256 z0, z1;
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t phase_vec[8];
+    for (vec_ind = 0; vec_ind < 8; ++vec_ind)
+        {
+            phase_vec[vec_ind] = _phase;
+            _phase *= phase_inc;
+        }
+
+    z0 = _mm256_load_ps((float*)phase_vec);
+    z1 = _mm256_load_ps((float*)(phase_vec + 4));
+
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^8;
+
+    for (vec_ind = 0; vec_ind < 4; ++vec_ind)
+        {
+            phase_vec[vec_ind] = dz;
+        }
+
+    __m256 dz_reg = _mm256_load_ps((float*)phase_vec);
+    dz_reg = _mm256_complexnormalise_ps(dz_reg);
+
+    __m256 indexn = n0;
+
+    for (; number < eighthPoints; number++)
+        {
+            a0Val = _mm256_load_ps(aPtr);
+            a1Val = _mm256_load_ps(aPtr + 8);
+
+            a0Val = _mm256_complexmul_ps(a0Val, z0);
+            a1Val = _mm256_complexmul_ps(a1Val, z1);
+
+            z0 = _mm256_complexmul_ps(z0, dz_reg);
+            z1 = _mm256_complexmul_ps(z1, dz_reg);
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    // resample the code for the current tap, in-register
+                    aux = _mm256_fmadd_ps(code_phase_step_chips_reg, indexn, aux2[vec_ind]);
+                    // floor
+                    aux = _mm256_floor_ps(aux);
+                    // fmod
+                    c = _mm256_div_ps(aux, code_length_chips_reg_f);
+                    it = _mm256_cvttps_epi32(c);
+                    cTrunc = _mm256_cvtepi32_ps(it);
+                    base = _mm256_fnmadd_ps(cTrunc, code_length_chips_reg_f, aux);
+                    local_code_chip_index_reg = _mm256_cvttps_epi32(base);
+
+                    // no negatives
+                    c = _mm256_cvtepi32_ps(local_code_chip_index_reg);
+                    negatives = _mm256_cmp_ps(c, zeros, 0x01);
+                    aux3 = _mm256_and_ps(code_length_chips_reg_f, negatives);
+                    aux = _mm256_add_ps(c, aux3);
+                    local_code_chip_index_reg = _mm256_cvttps_epi32(aux);
+
+                    _mm256_store_si256((__m256i*)local_code_chip_index, local_code_chip_index_reg);
+                    for (k = 0; k < 8; ++k)
+                        {
+                            local_code_taps[k] = local_code[local_code_chip_index[k]];
+                        }
+
+                    xVal = _mm256_load_ps(local_code_taps);                 // t0|t1|t2|t3|t4|t5|t6|t7
+                    xloVal = _mm256_unpacklo_ps(xVal, xVal);                // t0|t0|t1|t1|t4|t4|t5|t5
+                    xhiVal = _mm256_unpackhi_ps(xVal, xVal);                // t2|t2|t3|t3|t6|t6|t7|t7
+                    b0Val = _mm256_permute2f128_ps(xloVal, xhiVal, 0x20);   // t0|t0|t1|t1|t2|t2|t3|t3
+                    b1Val = _mm256_permute2f128_ps(xloVal, xhiVal, 0x31);   // t4|t4|t5|t5|t6|t6|t7|t7
+
+                    dotProdVal0[vec_ind] = _mm256_fmadd_ps(a0Val, b0Val, dotProdVal0[vec_ind]);
+                    dotProdVal1[vec_ind] = _mm256_fmadd_ps(a1Val, b1Val, dotProdVal1[vec_ind]);
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    z0 = _mm256_complexnormalise_ps(z0);
+                    z1 = _mm256_complexnormalise_ps(z1);
+                }
+
+            indexn = _mm256_add_ps(indexn, eights);
+            aPtr += 16;
+        }
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t dotProductVector[4];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            dotProdVal0[vec_ind] = _mm256_add_ps(dotProdVal0[vec_ind], dotProdVal1[vec_ind]);
+
+            _mm256_store_ps((float*)dotProductVector, dotProdVal0[vec_ind]);  // Store the results back into the dot product vector
+
+            result[vec_ind] = lv_cmake(0.0f, 0.0f);
+            for (i = 0; i < 4; ++i)
+                {
+                    result[vec_ind] += dotProductVector[i];
+                }
+        }
+
+    z0 = _mm256_complexnormalise_ps(z0);
+    _mm256_store_ps((float*)phase_vec, z0);
+    _phase = phase_vec[0];
+
+    number = eighthPoints * 8;
+    for (; number < num_points; number++)
+        {
+            wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)number + shifts_chips[vec_ind] - rem_code_phase_chips);
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    result[vec_ind] += wo * local_code[local_code_chip_index_];
+                }
+        }
+
+    *phase = _phase;
+#else
+    volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_generic(result, in_common, phase_inc, phase, local_code, rem_code_phase_chips, code_phase_step_chips, shifts_chips, code_length_chips, num_a_vectors, num_points);
+#endif
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_H */
@@ -0,0 +1,288 @@
+/*!
+ * \file volk_gnsssdr_32fc_moments_32f.h
+ * \brief VOLK_GNSSSDR kernel: Accumulates the statistical moments of a complex
+ * vector used by the C/N0 estimators and the carrier lock detector.
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+/*!
+ * \page volk_gnsssdr_32fc_moments_32f.h
+ *
+ * \b Overview
+ *
+ * Computes in a single pass over a vector of prompt correlator outputs the
+ * five accumulators needed by the SNV and M2M4 C/N0 estimators and by the
+ * carrier phase lock detector: the sum of the absolute values of the real
+ * parts, the second and fourth moments of the magnitude, and the sums of
+ * the real and imaginary parts.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * volk_gnsssdr_32fc_moments_32f(float* sum_abs_re, float* sum_mag2, float* sum_mag4, float* sum_re, float* sum_im, const lv_32fc_t* vector, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li vector: The complex input vector (prompt correlator outputs).
+ * \li num_points: The number of complex values in the vector.
+ *
+ * \b Outputs
+ * \li sum_abs_re: \f$ \sum |Re(x_i)| \f$.
+ * \li sum_mag2: \f$ \sum |x_i|^2 \f$.
+ * \li sum_mag4: \f$ \sum |x_i|^4 \f$.
+ * \li sum_re: \f$ \sum Re(x_i) \f$.
+ * \li sum_im: \f$ \sum Im(x_i) \f$.
+ *
+ */
+
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_moments_32f_H
+#define INCLUDED_volk_gnsssdr_32fc_moments_32f_H
+
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <math.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32fc_moments_32f_generic(float* sum_abs_re, float* sum_mag2, float* sum_mag4, float* sum_re, float* sum_im, const lv_32fc_t* vector, unsigned int num_points)
+{
+    float abs_re = 0.0f;
+    float m_2 = 0.0f;
+    float m_4 = 0.0f;
+    float re_acc = 0.0f;
+    float im_acc = 0.0f;
+    unsigned int i;
+    for (i = 0; i < num_points; i++)
+        {
+            const float re = lv_creal(vector[i]);
+            const float im = lv_cimag(vector[i]);
+            const float mag2 = re * re + im * im;
+            abs_re += fabsf(re);
+            m_2 += mag2;
+            m_4 += mag2 * mag2;
+            re_acc += re;
+            im_acc += im;
+        }
+    *sum_abs_re = abs_re;
+    *sum_mag2 = m_2;
+    *sum_mag4 = m_4;
+    *sum_re = re_acc;
+    *sum_im = im_acc;
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_moments_32f_u_avx(float* sum_abs_re, float* sum_mag2, float* sum_mag4, float* sum_re, float* sum_im, const lv_32fc_t* vector, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 8;
+    const float* in = (const float*)vector;
+    const __m256 sign_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+    // interleaved re/im accumulators; the lanes are separated at the end
+    __m256 acc_ri = _mm256_setzero_ps();
+    __m256 acc_abs_ri = _mm256_setzero_ps();
+    __m256 acc_m2 = _mm256_setzero_ps();
+    __m256 acc_m4 = _mm256_setzero_ps();
+
+    unsigned int i;
+    for (i = 0; i < avx_iters; i++)
+        {
+            const __m256 a = _mm256_loadu_ps(in);
+            const __m256 b = _mm256_loadu_ps(in + 8);
+            acc_ri = _mm256_add_ps(acc_ri, _mm256_add_ps(a, b));
+            acc_abs_ri = _mm256_add_ps(acc_abs_ri, _mm256_add_ps(_mm256_and_ps(a, sign_mask), _mm256_and_ps(b, sign_mask)));
+            const __m256 sqa = _mm256_mul_ps(a, a);
+            const __m256 sqb = _mm256_mul_ps(b, b);
+            // lane order after the horizontal add is irrelevant for a sum
+            const __m256 mag2 = _mm256_hadd_ps(sqa, sqb);
+            acc_m2 = _mm256_add_ps(acc_m2, mag2);
+            acc_m4 = _mm256_add_ps(acc_m4, _mm256_mul_ps(mag2, mag2));
+            in += 16;
+        }
+
+    __VOLK_ATTR_ALIGNED(32)
+    float tmp_ri[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float tmp_abs_ri[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float tmp_m2[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float tmp_m4[8];
+    _mm256_store_ps(tmp_ri, acc_ri);
+    _mm256_store_ps(tmp_abs_ri, acc_abs_ri);
+    _mm256_store_ps(tmp_m2, acc_m2);
+    _mm256_store_ps(tmp_m4, acc_m4);
+
+    float abs_re = tmp_abs_ri[0] + tmp_abs_ri[2] + tmp_abs_ri[4] + tmp_abs_ri[6];
+    float re_acc = tmp_ri[0] + tmp_ri[2] + tmp_ri[4] + tmp_ri[6];
+    float im_acc = tmp_ri[1] + tmp_ri[3] + tmp_ri[5] + tmp_ri[7];
+    float m_2 = tmp_m2[0] + tmp_m2[1] + tmp_m2[2] + tmp_m2[3] + tmp_m2[4] + tmp_m2[5] + tmp_m2[6] + tmp_m2[7];
+    float m_4 = tmp_m4[0] + tmp_m4[1] + tmp_m4[2] + tmp_m4[3] + tmp_m4[4] + tmp_m4[5] + tmp_m4[6] + tmp_m4[7];
+
+    for (i = avx_iters * 8; i < num_points; i++)
+        {
+            const float re = lv_creal(vector[i]);
+            const float im = lv_cimag(vector[i]);
+            const float mag2 = re * re + im * im;
+            abs_re += fabsf(re);
+            m_2 += mag2;
+            m_4 += mag2 * mag2;
+            re_acc += re;
+            im_acc += im;
+        }
+    *sum_abs_re = abs_re;
+    *sum_mag2 = m_2;
+    *sum_mag4 = m_4;
+    *sum_re = re_acc;
+    *sum_im = im_acc;
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_moments_32f_a_avx(float* sum_abs_re, float* sum_mag2, float* sum_mag4, float* sum_re, float* sum_im, const lv_32fc_t* vector, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 8;
+    const float* in = (const float*)vector;
+    const __m256 sign_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+    __m256 acc_ri = _mm256_setzero_ps();
+    __m256 acc_abs_ri = _mm256_setzero_ps();
+    __m256 acc_m2 = _mm256_setzero_ps();
+    __m256 acc_m4 = _mm256_setzero_ps();
+
+    unsigned int i;
+    for (i = 0; i < avx_iters; i++)
+        {
+            const __m256 a = _mm256_load_ps(in);
+            const __m256 b = _mm256_load_ps(in + 8);
+            acc_ri = _mm256_add_ps(acc_ri, _mm256_add_ps(a, b));
+            acc_abs_ri = _mm256_add_ps(acc_abs_ri, _mm256_add_ps(_mm256_and_ps(a, sign_mask), _mm256_and_ps(b, sign_mask)));
+            const __m256 sqa = _mm256_mul_ps(a, a);
+            const __m256 sqb = _mm256_mul_ps(b, b);
+            const __m256 mag2 = _mm256_hadd_ps(sqa, sqb);
+            acc_m2 = _mm256_add_ps(acc_m2, mag2);
+            acc_m4 = _mm256_add_ps(acc_m4, _mm256_mul_ps(mag2, mag2));
+            in += 16;
+        }
+
+    __VOLK_ATTR_ALIGNED(32)
+    float tmp_ri[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float tmp_abs_ri[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float tmp_m2[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float tmp_m4[8];
+    _mm256_store_ps(tmp_ri, acc_ri);
+    _mm256_store_ps(tmp_abs_ri, acc_abs_ri);
+    _mm256_store_ps(tmp_m2, acc_m2);
+    _mm256_store_ps(tmp_m4, acc_m4);
+
+    float abs_re = tmp_abs_ri[0] + tmp_abs_ri[2] + tmp_abs_ri[4] + tmp_abs_ri[6];
+    float re_acc = tmp_ri[0] + tmp_ri[2] + tmp_ri[4] + tmp_ri[6];
+    float im_acc = tmp_ri[1] + tmp_ri[3] + tmp_ri[5] + tmp_ri[7];
+    float m_2 = tmp_m2[0] + tmp_m2[1] + tmp_m2[2] + tmp_m2[3] + tmp_m2[4] + tmp_m2[5] + tmp_m2[6] + tmp_m2[7];
+    float m_4 = tmp_m4[0] + tmp_m4[1] + tmp_m4[2] + tmp_m4[3] + tmp_m4[4] + tmp_m4[5] + tmp_m4[6] + tmp_m4[7];
+
+    for (i = avx_iters * 8; i < num_points; i++)
+        {
+            const float re = lv_creal(vector[i]);
+            const float im = lv_cimag(vector[i]);
+            const float mag2 = re * re + im * im;
+            abs_re += fabsf(re);
+            m_2 += mag2;
+            m_4 += mag2 * mag2;
+            re_acc += re;
+            im_acc += im;
+        }
+    *sum_abs_re = abs_re;
+    *sum_mag2 = m_2;
+    *sum_mag4 = m_4;
+    *sum_re = re_acc;
+    *sum_im = im_acc;
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32fc_moments_32f_neon(float* sum_abs_re, float* sum_mag2, float* sum_mag4, float* sum_re, float* sum_im, const lv_32fc_t* vector, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 4;
+    const float* in = (const float*)vector;
+
+    float32x4_t acc_re = vdupq_n_f32(0.0f);
+    float32x4_t acc_im = vdupq_n_f32(0.0f);
+    float32x4_t acc_abs_re = vdupq_n_f32(0.0f);
+    float32x4_t acc_m2 = vdupq_n_f32(0.0f);
+    float32x4_t acc_m4 = vdupq_n_f32(0.0f);
+
+    unsigned int i;
+    for (i = 0; i < neon_iters; i++)
+        {
+            // de-interleaving load: val[0] holds the real parts, val[1] the imaginary parts
+            const float32x4x2_t x = vld2q_f32(in);
+            const float32x4_t mag2 = vmlaq_f32(vmulq_f32(x.val[0], x.val[0]), x.val[1], x.val[1]);
+            acc_re = vaddq_f32(acc_re, x.val[0]);
+            acc_im = vaddq_f32(acc_im, x.val[1]);
+            acc_abs_re = vaddq_f32(acc_abs_re, vabsq_f32(x.val[0]));
+            acc_m2 = vaddq_f32(acc_m2, mag2);
+            acc_m4 = vmlaq_f32(acc_m4, mag2, mag2);
+            in += 8;
+        }
+
+    __VOLK_ATTR_ALIGNED(16)
+    float tmp[4];
+    vst1q_f32(tmp, acc_abs_re);
+    float abs_re = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+    vst1q_f32(tmp, acc_m2);
+    float m_2 = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+    vst1q_f32(tmp, acc_m4);
+    float m_4 = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+    vst1q_f32(tmp, acc_re);
+    float re_acc = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+    vst1q_f32(tmp, acc_im);
+    float im_acc = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+
+    for (i = neon_iters * 4; i < num_points; i++)
+        {
+            const float re = lv_creal(vector[i]);
+            const float im = lv_cimag(vector[i]);
+            const float mag2 = re * re + im * im;
+            abs_re += fabsf(re);
+            m_2 += mag2;
+            m_4 += mag2 * mag2;
+            re_acc += re;
+            im_acc += im;
+        }
+    *sum_abs_re = abs_re;
+    *sum_mag2 = m_2;
+    *sum_mag4 = m_4;
+    *sum_re = re_acc;
+    *sum_im = im_acc;
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_moments_32f_H */
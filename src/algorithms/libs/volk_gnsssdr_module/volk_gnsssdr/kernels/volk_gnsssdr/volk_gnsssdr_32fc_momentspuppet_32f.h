@@ -0,0 +1,85 @@
+/*!
+ * \file volk_gnsssdr_32fc_momentspuppet_32f.h
+ * \brief Volk puppet for the complex sample moments kernel.
+ * \authors <ul>
+ *          <li> Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *          </ul>
+ *
+ * Volk puppet for integrating the one-pass moments reduction into volk's
+ * test system. The five scalar accumulators of the kernel are packed into
+ * the first elements of the output vector so the SIMD accumulation orders
+ * can be compared against the generic implementation.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_momentspuppet_32f_H
+#define INCLUDED_volk_gnsssdr_32fc_momentspuppet_32f_H
+
+#include "volk_gnsssdr/volk_gnsssdr_32fc_moments_32f.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32fc_momentspuppet_32f_generic(float* result, const lv_32fc_t* input, unsigned int num_points)
+{
+    if (num_points < 5)
+        {
+            return;
+        }
+    volk_gnsssdr_32fc_moments_32f_generic(&result[0], &result[1], &result[2], &result[3], &result[4], input, num_points);
+}
+
+#endif  // Generic
+
+
+#ifdef LV_HAVE_AVX
+
+static inline void volk_gnsssdr_32fc_momentspuppet_32f_u_avx(float* result, const lv_32fc_t* input, unsigned int num_points)
+{
+    if (num_points < 5)
+        {
+            return;
+        }
+    volk_gnsssdr_32fc_moments_32f_u_avx(&result[0], &result[1], &result[2], &result[3], &result[4], input, num_points);
+}
+
+#endif  // AVX
+
+
+#ifdef LV_HAVE_AVX
+
+static inline void volk_gnsssdr_32fc_momentspuppet_32f_a_avx(float* result, const lv_32fc_t* input, unsigned int num_points)
+{
+    if (num_points < 5)
+        {
+            return;
+        }
+    volk_gnsssdr_32fc_moments_32f_a_avx(&result[0], &result[1], &result[2], &result[3], &result[4], input, num_points);
+}
+
+#endif  // AVX
+
+
+#ifdef LV_HAVE_NEON
+
+static inline void volk_gnsssdr_32fc_momentspuppet_32f_neon(float* result, const lv_32fc_t* input, unsigned int num_points)
+{
+    if (num_points < 5)
+        {
+            return;
+        }
+    volk_gnsssdr_32fc_moments_32f_neon(&result[0], &result[1], &result[2], &result[3], &result[4], input, num_points);
+}
+
+#endif  // NEON
+
+#endif  // INCLUDED_volk_gnsssdr_32fc_momentspuppet_32f_H
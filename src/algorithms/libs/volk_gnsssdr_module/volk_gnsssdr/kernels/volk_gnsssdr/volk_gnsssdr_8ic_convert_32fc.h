@@ -0,0 +1,152 @@
+/*!
+ * \file volk_gnsssdr_8ic_convert_32fc.h
+ * \brief VOLK_GNSSSDR kernel: converts 8 bit integer complex values to 32 bits float complex values.
+ * \authors <ul>
+ *          <li> Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *          </ul>
+ *
+ * VOLK_GNSSSDR kernel that converts 8 bit integer complex values to 32 bits float complex values.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8ic_convert_32fc
+ *
+ * \b Overview
+ *
+ * Converts a complex vector of 8-bits integer each component
+ * into a complex vector of 32-bits float each component.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8ic_convert_32fc(lv_32fc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li inputVector: The vector of 8-bits integer each component data.
+ * \li num_points: The number of complex values.
+ *
+ * \b Outputs
+ * \li outputVector: The vector of 32-bits float each component data.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8ic_convert_32fc_H
+#define INCLUDED_volk_gnsssdr_8ic_convert_32fc_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8ic_convert_32fc_generic(lv_32fc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    unsigned int i;
+    const lv_8sc_t* _in = inputVector;
+    lv_32fc_t* _out = outputVector;
+    for (i = 0; i < num_points; i++)
+        {
+            *_out++ = lv_cmake((float)lv_creal(*_in), (float)lv_cimag(*_in));
+            _in++;
+        }
+}
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_8ic_convert_32fc_a_sse4_1(lv_32fc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    unsigned int i;
+    const lv_8sc_t* _in = inputVector;
+    lv_32fc_t* _out = outputVector;
+    __m128i a8, a16;
+
+    for (i = 0; i < sse_iters; i++)
+        {
+            a8 = _mm_loadl_epi64((const __m128i*)_in);  // load (1 byte imag, 1 byte real) x 4 into the low 64 bits
+            a16 = _mm_cvtepi8_epi16(a8);                // sign-extend to 16-bit lanes
+            _mm_store_ps((float*)_out, _mm_cvtepi32_ps(_mm_cvtepi16_epi32(a16)));
+            _mm_store_ps((float*)(_out + 2), _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(a16, 8))));
+            _in += 4;
+            _out += 4;
+        }
+    for (i = 0; i < (num_points % 4); ++i)
+        {
+            *_out++ = lv_cmake((float)lv_creal(*_in), (float)lv_cimag(*_in));
+            _in++;
+        }
+}
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_8ic_convert_32fc_u_sse4_1(lv_32fc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    unsigned int i;
+    const lv_8sc_t* _in = inputVector;
+    lv_32fc_t* _out = outputVector;
+    __m128i a8, a16;
+
+    for (i = 0; i < sse_iters; i++)
+        {
+            a8 = _mm_loadl_epi64((const __m128i*)_in);  // load (1 byte imag, 1 byte real) x 4 into the low 64 bits
+            a16 = _mm_cvtepi8_epi16(a8);                // sign-extend to 16-bit lanes
+            _mm_storeu_ps((float*)_out, _mm_cvtepi32_ps(_mm_cvtepi16_epi32(a16)));
+            _mm_storeu_ps((float*)(_out + 2), _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(a16, 8))));
+            _in += 4;
+            _out += 4;
+        }
+    for (i = 0; i < (num_points % 4); ++i)
+        {
+            *_out++ = lv_cmake((float)lv_creal(*_in), (float)lv_cimag(*_in));
+            _in++;
+        }
+}
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_NEONV7
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8ic_convert_32fc_neon(lv_32fc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 4;
+    unsigned int i;
+    const lv_8sc_t* _in = inputVector;
+    lv_32fc_t* _out = outputVector;
+    int8x8_t a8;
+    int16x8_t a16;
+
+    for (i = 0; i < neon_iters; i++)
+        {
+            a8 = vld1_s8((const int8_t*)_in);  // load (1 byte imag, 1 byte real) x 4
+            a16 = vmovl_s8(a8);                // sign-extend to 16-bit lanes
+            vst1q_f32((float32_t*)_out, vcvtq_f32_s32(vmovl_s16(vget_low_s16(a16))));
+            vst1q_f32((float32_t*)(_out + 2), vcvtq_f32_s32(vmovl_s16(vget_high_s16(a16))));
+            _in += 4;
+            _out += 4;
+        }
+    for (i = 0; i < (num_points % 4); ++i)
+        {
+            *_out++ = lv_cmake((float)lv_creal(*_in), (float)lv_cimag(*_in));
+            _in++;
+        }
+}
+#endif /* LV_HAVE_NEONV7 */
+
+#endif /* INCLUDED_volk_gnsssdr_8ic_convert_32fc_H */
@@ -0,0 +1,429 @@
+/*!
+ * \file volk_gnsssdr_8ic_x2_rotator_dot_prod_32ic_xn.h
+ * \brief VOLK_GNSSSDR kernel: multiplies N 8 bits vectors by a common vector
+ * phase rotated and accumulates the results in N 32 bits int complex outputs.
+ * \authors <ul>
+ *          <li> Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *          </ul>
+ *
+ * VOLK_GNSSSDR kernel that multiplies N 8 bits vectors by a common vector, which is
+ * phase-rotated by phase offset and phase increment, and accumulates the results
+ * in N 32 bits int complex outputs.
+ * It is optimized to perform the N tap correlation process in GNSS receivers
+ * fed by byte-wide front ends, without converting the sample stream to float.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8ic_x2_rotator_dot_prod_32ic_xn
+ *
+ * \b Overview
+ *
+ * Rotates and multiplies the reference complex vector with an arbitrary number of other complex vectors,
+ * accumulates the results and stores them in the output vector.
+ * The rotation is done at a fixed rate per sample, from an initial \p phase offset.
+ * This function can be used for Doppler wipe-off and multiple correlator.
+ * The rotated reference samples are kept at 16-bit resolution (the rotation of an
+ * 8-bit sample does not fit back into 8 bits without clipping), and the products
+ * are accumulated in 32-bit integers, so no saturation occurs for correlation
+ * lengths of up to ~40000 samples at full-scale inputs.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8ic_x2_rotator_dot_prod_32ic_xn(lv_32sc_t* result, const lv_8sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_8sc_t** in_a, int num_a_vectors, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li in_common:     Pointer to one of the vectors to be rotated, multiplied and accumulated (reference vector).
+ * \li phase_inc:     Phase increment = lv_cmake(cos(phase_step_rad), sin(phase_step_rad))
+ * \li phase:         Initial phase = lv_cmake(cos(initial_phase_rad), sin(initial_phase_rad))
+ * \li in_a:          Pointer to an array of pointers to multiple vectors to be multiplied and accumulated.
+ * \li num_a_vectors: Number of vectors to be multiplied by the reference vector and accumulated.
+ * \li num_points:    Number of complex values to be multiplied together, accumulated and stored into \p result.
+ *
+ * \b Outputs
+ * \li phase:         Final phase.
+ * \li result:        Vector of \p num_a_vectors components with the multiple vectors of \p in_a rotated, multiplied by \p in_common and accumulated.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8ic_x2_rotator_dot_prod_32ic_xn_H
+#define INCLUDED_volk_gnsssdr_8ic_x2_rotator_dot_prod_32ic_xn_H
+
+
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_malloc.h>
+#include <math.h>
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8ic_x2_rotator_dot_prod_32ic_xn_generic(lv_32sc_t* result, const lv_8sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_8sc_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    lv_8sc_t tmp8;
+    lv_16sc_t rot16;
+    lv_32fc_t tmp32;
+    int n_vec;
+    unsigned int n;
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            result[n_vec] = lv_cmake(0, 0);
+        }
+    for (n = 0; n < num_points; n++)
+        {
+            tmp8 = *in_common++;
+            tmp32 = lv_cmake((float)lv_creal(tmp8), (float)lv_cimag(tmp8)) * (*phase);
+            rot16 = lv_cmake((int16_t)rintf(lv_creal(tmp32)), (int16_t)rintf(lv_cimag(tmp32)));
+
+            // Regenerate phase
+            if (n % 256 == 0)
+                {
+#ifdef __cplusplus
+                    (*phase) /= std::abs((*phase));
+#else
+                    (*phase) /= hypotf(lv_creal(*phase), lv_cimag(*phase));
+#endif
+                }
+
+            (*phase) *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    result[n_vec] = lv_cmake(
+                        lv_creal(result[n_vec]) + ((int32_t)lv_creal(rot16) * (int32_t)lv_creal(in_a[n_vec][n]) - (int32_t)lv_cimag(rot16) * (int32_t)lv_cimag(in_a[n_vec][n])),
+                        lv_cimag(result[n_vec]) + ((int32_t)lv_creal(rot16) * (int32_t)lv_cimag(in_a[n_vec][n]) + (int32_t)lv_cimag(rot16) * (int32_t)lv_creal(in_a[n_vec][n])));
+                }
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_8ic_x2_rotator_dot_prod_32ic_xn_a_sse4_1(lv_32sc_t* result, const lv_8sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_8sc_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    int n_vec;
+    int i;
+    unsigned int number;
+    unsigned int n;
+    const lv_8sc_t** _in_a = in_a;
+    const lv_8sc_t* _in_common = in_common;
+    lv_32sc_t* _out = result;
+
+    __VOLK_ATTR_ALIGNED(16)
+    int32_t realVector[4];
+    __VOLK_ATTR_ALIGNED(16)
+    int32_t imagVector[4];
+
+    __m128i* realcacc = (__m128i*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m128i), volk_gnsssdr_get_alignment());
+    __m128i* imagcacc = (__m128i*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m128i), volk_gnsssdr_get_alignment());
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            realcacc[n_vec] = _mm_setzero_si128();
+            imagcacc[n_vec] = _mm_setzero_si128();
+        }
+
+    __m128i a8, a, a_sw, b;
+    __m128i pc1, pc2;
+
+    // negates the imaginary lanes, so that _mm_madd_epi16 yields the real part
+    const __m128i conj_sign = _mm_set_epi16(-1, 1, -1, 1, -1, 1, -1, 1);
+
+    // phase rotation registers
+    __m128 pa, pb, two_phase_acc_reg, two_phase_inc_reg;
+    __VOLK_ATTR_ALIGNED(16)
+    lv_32fc_t two_phase_inc[2];
+    two_phase_inc[0] = phase_inc * phase_inc;
+    two_phase_inc[1] = phase_inc * phase_inc;
+    two_phase_inc_reg = _mm_load_ps((float*)two_phase_inc);
+    __VOLK_ATTR_ALIGNED(16)
+    lv_32fc_t two_phase_acc[2];
+    two_phase_acc[0] = (*phase);
+    two_phase_acc[1] = (*phase) * phase_inc;
+    two_phase_acc_reg = _mm_load_ps((float*)two_phase_acc);
+    __m128 yl, yh, tmp1, tmp2, tmp3;
+    lv_8sc_t tmp8;
+    lv_16sc_t rot16;
+    lv_32fc_t tmp32;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            // Phase rotation on operand in_common starts here:
+            pa = _mm_set_ps((float)(lv_cimag(_in_common[1])), (float)(lv_creal(_in_common[1])), (float)(lv_cimag(_in_common[0])), (float)(lv_creal(_in_common[0])));  // load (1 byte imag, 1 byte real) x 2 into 128 bits reg
+            // complex 32fc multiplication b=a*two_phase_acc_reg
+            yl = _mm_moveldup_ps(two_phase_acc_reg);  // Load yl with cr,cr,dr,dr
+            yh = _mm_movehdup_ps(two_phase_acc_reg);  // Load yh with ci,ci,di,di
+            tmp1 = _mm_mul_ps(pa, yl);                // tmp1 = ar*cr,ai*cr,br*dr,bi*dr
+            pa = _mm_shuffle_ps(pa, pa, 0xB1);        // Re-arrange x to be ai,ar,bi,br
+            tmp2 = _mm_mul_ps(pa, yh);                // tmp2 = ai*ci,ar*ci,bi*di,br*di
+            pb = _mm_addsub_ps(tmp1, tmp2);           // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+            pc1 = _mm_cvtps_epi32(pb);                // convert from 32fc to 32ic
+
+            // complex 32fc multiplication two_phase_acc_reg=two_phase_acc_reg*two_phase_inc_reg
+            yl = _mm_moveldup_ps(two_phase_acc_reg);                            // Load yl with cr,cr,dr,dr
+            yh = _mm_movehdup_ps(two_phase_acc_reg);                            // Load yh with ci,ci,di,di
+            tmp1 = _mm_mul_ps(two_phase_inc_reg, yl);                           // tmp1 = ar*cr,ai*cr,br*dr,bi*dr
+            tmp3 = _mm_shuffle_ps(two_phase_inc_reg, two_phase_inc_reg, 0xB1);  // Re-arrange x to be ai,ar,bi,br
+            tmp2 = _mm_mul_ps(tmp3, yh);                                        // tmp2 = ai*ci,ar*ci,bi*di,br*di
+            two_phase_acc_reg = _mm_addsub_ps(tmp1, tmp2);                      // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+
+            // next two samples
+            _in_common += 2;
+            pa = _mm_set_ps((float)(lv_cimag(_in_common[1])), (float)(lv_creal(_in_common[1])), (float)(lv_cimag(_in_common[0])), (float)(lv_creal(_in_common[0])));  // load (1 byte imag, 1 byte real) x 2 into 128 bits reg
+            __VOLK_GNSSSDR_PREFETCH(_in_common + 8);
+            // complex 32fc multiplication b=a*two_phase_acc_reg
+            yl = _mm_moveldup_ps(two_phase_acc_reg);  // Load yl with cr,cr,dr,dr
+            yh = _mm_movehdup_ps(two_phase_acc_reg);  // Load yh with ci,ci,di,di
+            tmp1 = _mm_mul_ps(pa, yl);                // tmp1 = ar*cr,ai*cr,br*dr,bi*dr
+            pa = _mm_shuffle_ps(pa, pa, 0xB1);        // Re-arrange x to be ai,ar,bi,br
+            tmp2 = _mm_mul_ps(pa, yh);                // tmp2 = ai*ci,ar*ci,bi*di,br*di
+            pb = _mm_addsub_ps(tmp1, tmp2);           // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+            pc2 = _mm_cvtps_epi32(pb);                // convert from 32fc to 32ic
+
+            // complex 32fc multiplication two_phase_acc_reg=two_phase_acc_reg*two_phase_inc_reg
+            yl = _mm_moveldup_ps(two_phase_acc_reg);                            // Load yl with cr,cr,dr,dr
+            yh = _mm_movehdup_ps(two_phase_acc_reg);                            // Load yh with ci,ci,di,di
+            tmp1 = _mm_mul_ps(two_phase_inc_reg, yl);                           // tmp1 = ar*cr,ai*cr,br*dr,bi*dr
+            tmp3 = _mm_shuffle_ps(two_phase_inc_reg, two_phase_inc_reg, 0xB1);  // Re-arrange x to be ai,ar,bi,br
+            tmp2 = _mm_mul_ps(tmp3, yh);                                        // tmp2 = ai*ci,ar*ci,bi*di,br*di
+            two_phase_acc_reg = _mm_addsub_ps(tmp1, tmp2);                      // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+
+            // store four rotated in_common samples in the register b
+            b = _mm_packs_epi32(pc1, pc2);  // convert from 32ic to 16ic
+
+            // next two samples
+            _in_common += 2;
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    a8 = _mm_loadl_epi64((const __m128i*)&(_in_a[n_vec][number * 4]));  // load (1 byte imag, 1 byte real) x 4 into the low 64 bits
+                    a = _mm_cvtepi8_epi16(a8);                                          // sign-extend to (2 byte imag, 2 byte real) x 4
+
+                    realcacc[n_vec] = _mm_add_epi32(realcacc[n_vec], _mm_madd_epi16(b, _mm_sign_epi16(a, conj_sign)));  // b.r*a.r - b.i*a.i
+
+                    a_sw = _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, 0xB1), 0xB1);             // swap real and imag lanes
+                    imagcacc[n_vec] = _mm_add_epi32(imagcacc[n_vec], _mm_madd_epi16(b, a_sw));  // b.r*a.i + b.i*a.r
+                }
+            // Regenerate phase
+            if ((number % 64) == 0)
+                {
+                    tmp1 = _mm_mul_ps(two_phase_acc_reg, two_phase_acc_reg);
+                    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+                    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+                    tmp2 = _mm_sqrt_ps(tmp1);
+                    two_phase_acc_reg = _mm_div_ps(two_phase_acc_reg, tmp2);
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            _mm_store_si128((__m128i*)realVector, realcacc[n_vec]);
+            _mm_store_si128((__m128i*)imagVector, imagcacc[n_vec]);
+            _out[n_vec] = lv_cmake(0, 0);
+            for (i = 0; i < 4; ++i)
+                {
+                    _out[n_vec] = lv_cmake(lv_creal(_out[n_vec]) + realVector[i], lv_cimag(_out[n_vec]) + imagVector[i]);
+                }
+        }
+    volk_gnsssdr_free(realcacc);
+    volk_gnsssdr_free(imagcacc);
+
+    tmp1 = _mm_mul_ps(two_phase_acc_reg, two_phase_acc_reg);
+    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+    tmp2 = _mm_sqrt_ps(tmp1);
+    two_phase_acc_reg = _mm_div_ps(two_phase_acc_reg, tmp2);
+
+    _mm_store_ps((float*)two_phase_acc, two_phase_acc_reg);
+    (*phase) = two_phase_acc[0];
+
+    for (n = sse_iters * 4; n < num_points; n++)
+        {
+            tmp8 = in_common[n];
+            tmp32 = lv_cmake((float)lv_creal(tmp8), (float)lv_cimag(tmp8)) * (*phase);
+            rot16 = lv_cmake((int16_t)rintf(lv_creal(tmp32)), (int16_t)rintf(lv_cimag(tmp32)));
+            (*phase) *= phase_inc;
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    _out[n_vec] = lv_cmake(
+                        lv_creal(_out[n_vec]) + ((int32_t)lv_creal(rot16) * (int32_t)lv_creal(in_a[n_vec][n]) - (int32_t)lv_cimag(rot16) * (int32_t)lv_cimag(in_a[n_vec][n])),
+                        lv_cimag(_out[n_vec]) + ((int32_t)lv_creal(rot16) * (int32_t)lv_cimag(in_a[n_vec][n]) + (int32_t)lv_cimag(rot16) * (int32_t)lv_creal(in_a[n_vec][n])));
+                }
+        }
+}
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_8ic_x2_rotator_dot_prod_32ic_xn_u_sse4_1(lv_32sc_t* result, const lv_8sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_8sc_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    int n_vec;
+    int i;
+    unsigned int number;
+    unsigned int n;
+    const lv_8sc_t** _in_a = in_a;
+    const lv_8sc_t* _in_common = in_common;
+    lv_32sc_t* _out = result;
+
+    __VOLK_ATTR_ALIGNED(16)
+    int32_t realVector[4];
+    __VOLK_ATTR_ALIGNED(16)
+    int32_t imagVector[4];
+
+    __m128i* realcacc = (__m128i*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m128i), volk_gnsssdr_get_alignment());
+    __m128i* imagcacc = (__m128i*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m128i), volk_gnsssdr_get_alignment());
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            realcacc[n_vec] = _mm_setzero_si128();
+            imagcacc[n_vec] = _mm_setzero_si128();
+        }
+
+    __m128i a8, a, a_sw, b;
+    __m128i pc1, pc2;
+
+    // negates the imaginary lanes, so that _mm_madd_epi16 yields the real part
+    const __m128i conj_sign = _mm_set_epi16(-1, 1, -1, 1, -1, 1, -1, 1);
+
+    // phase rotation registers
+    __m128 pa, pb, two_phase_acc_reg, two_phase_inc_reg;
+    __VOLK_ATTR_ALIGNED(16)
+    lv_32fc_t two_phase_inc[2];
+    two_phase_inc[0] = phase_inc * phase_inc;
+    two_phase_inc[1] = phase_inc * phase_inc;
+    two_phase_inc_reg = _mm_load_ps((float*)two_phase_inc);
+    __VOLK_ATTR_ALIGNED(16)
+    lv_32fc_t two_phase_acc[2];
+    two_phase_acc[0] = (*phase);
+    two_phase_acc[1] = (*phase) * phase_inc;
+    two_phase_acc_reg = _mm_load_ps((float*)two_phase_acc);
+    __m128 yl, yh, tmp1, tmp2, tmp3;
+    lv_8sc_t tmp8;
+    lv_16sc_t rot16;
+    lv_32fc_t tmp32;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            // Phase rotation on operand in_common starts here:
+            pa = _mm_set_ps((float)(lv_cimag(_in_common[1])), (float)(lv_creal(_in_common[1])), (float)(lv_cimag(_in_common[0])), (float)(lv_creal(_in_common[0])));  // load (1 byte imag, 1 byte real) x 2 into 128 bits reg
+            // complex 32fc multiplication b=a*two_phase_acc_reg
+            yl = _mm_moveldup_ps(two_phase_acc_reg);  // Load yl with cr,cr,dr,dr
+            yh = _mm_movehdup_ps(two_phase_acc_reg);  // Load yh with ci,ci,di,di
+            tmp1 = _mm_mul_ps(pa, yl);                // tmp1 = ar*cr,ai*cr,br*dr,bi*dr
+            pa = _mm_shuffle_ps(pa, pa, 0xB1);        // Re-arrange x to be ai,ar,bi,br
+            tmp2 = _mm_mul_ps(pa, yh);                // tmp2 = ai*ci,ar*ci,bi*di,br*di
+            pb = _mm_addsub_ps(tmp1, tmp2);           // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+            pc1 = _mm_cvtps_epi32(pb);                // convert from 32fc to 32ic
+
+            // complex 32fc multiplication two_phase_acc_reg=two_phase_acc_reg*two_phase_inc_reg
+            yl = _mm_moveldup_ps(two_phase_acc_reg);                            // Load yl with cr,cr,dr,dr
+            yh = _mm_movehdup_ps(two_phase_acc_reg);                            // Load yh with ci,ci,di,di
+            tmp1 = _mm_mul_ps(two_phase_inc_reg, yl);                           // tmp1 = ar*cr,ai*cr,br*dr,bi*dr
+            tmp3 = _mm_shuffle_ps(two_phase_inc_reg, two_phase_inc_reg, 0xB1);  // Re-arrange x to be ai,ar,bi,br
+            tmp2 = _mm_mul_ps(tmp3, yh);                                        // tmp2 = ai*ci,ar*ci,bi*di,br*di
+            two_phase_acc_reg = _mm_addsub_ps(tmp1, tmp2);                      // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+
+            // next two samples
+            _in_common += 2;
+            pa = _mm_set_ps((float)(lv_cimag(_in_common[1])), (float)(lv_creal(_in_common[1])), (float)(lv_cimag(_in_common[0])), (float)(lv_creal(_in_common[0])));  // load (1 byte imag, 1 byte real) x 2 into 128 bits reg
+            __VOLK_GNSSSDR_PREFETCH(_in_common + 8);
+            // complex 32fc multiplication b=a*two_phase_acc_reg
+            yl = _mm_moveldup_ps(two_phase_acc_reg);  // Load yl with cr,cr,dr,dr
+            yh = _mm_movehdup_ps(two_phase_acc_reg);  // Load yh with ci,ci,di,di
+            tmp1 = _mm_mul_ps(pa, yl);                // tmp1 = ar*cr,ai*cr,br*dr,bi*dr
+            pa = _mm_shuffle_ps(pa, pa, 0xB1);        // Re-arrange x to be ai,ar,bi,br
+            tmp2 = _mm_mul_ps(pa, yh);                // tmp2 = ai*ci,ar*ci,bi*di,br*di
+            pb = _mm_addsub_ps(tmp1, tmp2);           // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+            pc2 = _mm_cvtps_epi32(pb);                // convert from 32fc to 32ic
+
+            // complex 32fc multiplication two_phase_acc_reg=two_phase_acc_reg*two_phase_inc_reg
+            yl = _mm_moveldup_ps(two_phase_acc_reg);                            // Load yl with cr,cr,dr,dr
+            yh = _mm_movehdup_ps(two_phase_acc_reg);                            // Load yh with ci,ci,di,di
+            tmp1 = _mm_mul_ps(two_phase_inc_reg, yl);                           // tmp1 = ar*cr,ai*cr,br*dr,bi*dr
+            tmp3 = _mm_shuffle_ps(two_phase_inc_reg, two_phase_inc_reg, 0xB1);  // Re-arrange x to be ai,ar,bi,br
+            tmp2 = _mm_mul_ps(tmp3, yh);                                        // tmp2 = ai*ci,ar*ci,bi*di,br*di
+            two_phase_acc_reg = _mm_addsub_ps(tmp1, tmp2);                      // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+
+            // store four rotated in_common samples in the register b
+            b = _mm_packs_epi32(pc1, pc2);  // convert from 32ic to 16ic
+
+            // next two samples
+            _in_common += 2;
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    a8 = _mm_loadl_epi64((const __m128i*)&(_in_a[n_vec][number * 4]));  // load (1 byte imag, 1 byte real) x 4 into the low 64 bits
+                    a = _mm_cvtepi8_epi16(a8);                                          // sign-extend to (2 byte imag, 2 byte real) x 4
+
+                    realcacc[n_vec] = _mm_add_epi32(realcacc[n_vec], _mm_madd_epi16(b, _mm_sign_epi16(a, conj_sign)));  // b.r*a.r - b.i*a.i
+
+                    a_sw = _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, 0xB1), 0xB1);             // swap real and imag lanes
+                    imagcacc[n_vec] = _mm_add_epi32(imagcacc[n_vec], _mm_madd_epi16(b, a_sw));  // b.r*a.i + b.i*a.r
+                }
+            // Regenerate phase
+            if ((number % 64) == 0)
+                {
+                    tmp1 = _mm_mul_ps(two_phase_acc_reg, two_phase_acc_reg);
+                    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+                    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+                    tmp2 = _mm_sqrt_ps(tmp1);
+                    two_phase_acc_reg = _mm_div_ps(two_phase_acc_reg, tmp2);
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            _mm_store_si128((__m128i*)realVector, realcacc[n_vec]);
+            _mm_store_si128((__m128i*)imagVector, imagcacc[n_vec]);
+            _out[n_vec] = lv_cmake(0, 0);
+            for (i = 0; i < 4; ++i)
+                {
+                    _out[n_vec] = lv_cmake(lv_creal(_out[n_vec]) + realVector[i], lv_cimag(_out[n_vec]) + imagVector[i]);
+                }
+        }
+    volk_gnsssdr_free(realcacc);
+    volk_gnsssdr_free(imagcacc);
+
+    tmp1 = _mm_mul_ps(two_phase_acc_reg, two_phase_acc_reg);
+    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+    tmp2 = _mm_sqrt_ps(tmp1);
+    two_phase_acc_reg = _mm_div_ps(two_phase_acc_reg, tmp2);
+
+    _mm_store_ps((float*)two_phase_acc, two_phase_acc_reg);
+    (*phase) = two_phase_acc[0];
+
+    for (n = sse_iters * 4; n < num_points; n++)
+        {
+            tmp8 = in_common[n];
+            tmp32 = lv_cmake((float)lv_creal(tmp8), (float)lv_cimag(tmp8)) * (*phase);
+            rot16 = lv_cmake((int16_t)rintf(lv_creal(tmp32)), (int16_t)rintf(lv_cimag(tmp32)));
+            (*phase) *= phase_inc;
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    _out[n_vec] = lv_cmake(
+                        lv_creal(_out[n_vec]) + ((int32_t)lv_creal(rot16) * (int32_t)lv_creal(in_a[n_vec][n]) - (int32_t)lv_cimag(rot16) * (int32_t)lv_cimag(in_a[n_vec][n])),
+                        lv_cimag(_out[n_vec]) + ((int32_t)lv_creal(rot16) * (int32_t)lv_cimag(in_a[n_vec][n]) + (int32_t)lv_cimag(rot16) * (int32_t)lv_creal(in_a[n_vec][n])));
+                }
+        }
+}
+#endif /* LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_gnsssdr_8ic_x2_rotator_dot_prod_32ic_xn_H */
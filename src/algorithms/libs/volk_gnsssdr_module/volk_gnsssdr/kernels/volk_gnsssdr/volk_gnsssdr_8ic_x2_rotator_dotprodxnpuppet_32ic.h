@@ -0,0 +1,120 @@
+/*!
+ * \file volk_gnsssdr_8ic_x2_rotator_dotprodxnpuppet_32ic.h
+ * \brief VOLK_GNSSSDR puppet for the multiple 8 bits complex rotator dot product kernel.
+ * \authors <ul>
+ *          <li> Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *          </ul>
+ *
+ * VOLK_GNSSSDR puppet for integrating the rotator multiple dot product kernel into the test system
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8ic_x2_rotator_dotprodxnpuppet_32ic_H
+#define INCLUDED_volk_gnsssdr_8ic_x2_rotator_dotprodxnpuppet_32ic_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8ic_x2_rotator_dot_prod_32ic_xn.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_malloc.h>
+#include <string.h>
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_8ic_x2_rotator_dotprodxnpuppet_32ic_generic(lv_32sc_t* result, const lv_8sc_t* local_code, const lv_8sc_t* in, unsigned int num_points)
+{
+    // phases must be normalized. Phase rotator expects a complex exponential input!
+    float rem_carrier_phase_in_rad = 0.345;
+    float phase_step_rad = 0.1;
+    lv_32fc_t phase[1];
+    phase[0] = lv_cmake(cos(rem_carrier_phase_in_rad), sin(rem_carrier_phase_in_rad));
+    lv_32fc_t phase_inc[1];
+    phase_inc[0] = lv_cmake(cos(phase_step_rad), sin(phase_step_rad));
+    int n;
+    int num_a_vectors = 3;
+    lv_8sc_t** in_a = (lv_8sc_t**)volk_gnsssdr_malloc(sizeof(lv_8sc_t*) * num_a_vectors, volk_gnsssdr_get_alignment());
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            in_a[n] = (lv_8sc_t*)volk_gnsssdr_malloc(sizeof(lv_8sc_t) * num_points, volk_gnsssdr_get_alignment());
+            memcpy((lv_8sc_t*)in_a[n], (lv_8sc_t*)in, sizeof(lv_8sc_t) * num_points);
+        }
+    volk_gnsssdr_8ic_x2_rotator_dot_prod_32ic_xn_generic(result, local_code, phase_inc[0], phase, (const lv_8sc_t**)in_a, num_a_vectors, num_points);
+
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            volk_gnsssdr_free(in_a[n]);
+        }
+    volk_gnsssdr_free(in_a);
+}
+
+#endif  // Generic
+
+
+#ifdef LV_HAVE_SSE4_1
+static inline void volk_gnsssdr_8ic_x2_rotator_dotprodxnpuppet_32ic_a_sse4_1(lv_32sc_t* result, const lv_8sc_t* local_code, const lv_8sc_t* in, unsigned int num_points)
+{
+    // phases must be normalized. Phase rotator expects a complex exponential input!
+    float rem_carrier_phase_in_rad = 0.345;
+    float phase_step_rad = 0.1;
+    lv_32fc_t phase[1];
+    phase[0] = lv_cmake(cos(rem_carrier_phase_in_rad), sin(rem_carrier_phase_in_rad));
+    lv_32fc_t phase_inc[1];
+    phase_inc[0] = lv_cmake(cos(phase_step_rad), sin(phase_step_rad));
+    int n;
+    int num_a_vectors = 3;
+    lv_8sc_t** in_a = (lv_8sc_t**)volk_gnsssdr_malloc(sizeof(lv_8sc_t*) * num_a_vectors, volk_gnsssdr_get_alignment());
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            in_a[n] = (lv_8sc_t*)volk_gnsssdr_malloc(sizeof(lv_8sc_t) * num_points, volk_gnsssdr_get_alignment());
+            memcpy((lv_8sc_t*)in_a[n], (lv_8sc_t*)in, sizeof(lv_8sc_t) * num_points);
+        }
+
+    volk_gnsssdr_8ic_x2_rotator_dot_prod_32ic_xn_a_sse4_1(result, local_code, phase_inc[0], phase, (const lv_8sc_t**)in_a, num_a_vectors, num_points);
+
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            volk_gnsssdr_free(in_a[n]);
+        }
+    volk_gnsssdr_free(in_a);
+}
+
+#endif  // SSE4.1
+
+
+#ifdef LV_HAVE_SSE4_1
+static inline void volk_gnsssdr_8ic_x2_rotator_dotprodxnpuppet_32ic_u_sse4_1(lv_32sc_t* result, const lv_8sc_t* local_code, const lv_8sc_t* in, unsigned int num_points)
+{
+    // phases must be normalized. Phase rotator expects a complex exponential input!
+    float rem_carrier_phase_in_rad = 0.345;
+    float phase_step_rad = 0.1;
+    lv_32fc_t phase[1];
+    phase[0] = lv_cmake(cos(rem_carrier_phase_in_rad), sin(rem_carrier_phase_in_rad));
+    lv_32fc_t phase_inc[1];
+    phase_inc[0] = lv_cmake(cos(phase_step_rad), sin(phase_step_rad));
+    int n;
+    int num_a_vectors = 3;
+    lv_8sc_t** in_a = (lv_8sc_t**)volk_gnsssdr_malloc(sizeof(lv_8sc_t*) * num_a_vectors, volk_gnsssdr_get_alignment());
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            in_a[n] = (lv_8sc_t*)volk_gnsssdr_malloc(sizeof(lv_8sc_t) * num_points, volk_gnsssdr_get_alignment());
+            memcpy((lv_8sc_t*)in_a[n], (lv_8sc_t*)in, sizeof(lv_8sc_t) * num_points);
+        }
+
+    volk_gnsssdr_8ic_x2_rotator_dot_prod_32ic_xn_u_sse4_1(result, local_code, phase_inc[0], phase, (const lv_8sc_t**)in_a, num_a_vectors, num_points);
+
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            volk_gnsssdr_free(in_a[n]);
+        }
+    volk_gnsssdr_free(in_a);
+}
+
+#endif  // SSE4.1
+
+#endif  // INCLUDED_volk_gnsssdr_8ic_x2_rotator_dotprodxnpuppet_32ic_H
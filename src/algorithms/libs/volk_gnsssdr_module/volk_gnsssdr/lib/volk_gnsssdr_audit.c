@@ -0,0 +1,86 @@
+/*
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020 (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <volk_gnsssdr/volk_gnsssdr_audit.h>
+#include <inttypes.h>
+#include <stdlib.h>
+
+static volk_gnsssdr_audit_entry_t *audit_head = NULL;
+
+
+bool volk_gnsssdr_audit_enabled(void)
+{
+    static int enabled = -1;
+    if (enabled < 0)
+        {
+            enabled = (getenv("VOLK_GNSSSDR_AUDIT") != NULL) ? 1 : 0;
+        }
+    return enabled == 1;
+}
+
+
+static void volk_gnsssdr_audit_print_at_exit(void)
+{
+    fprintf(stderr, "VOLK_GNSSSDR dispatch audit:\n");
+    volk_gnsssdr_audit_print(stderr);
+}
+
+
+void volk_gnsssdr_audit_register(volk_gnsssdr_audit_entry_t *entry)
+{
+    volk_gnsssdr_audit_entry_t *e;
+    for (e = audit_head; e != NULL; e = e->next)
+        {
+            if (e == entry) return;  // lazy init may run more than once per kernel
+        }
+    entry->next = audit_head;
+    audit_head = entry;
+    if (volk_gnsssdr_audit_enabled())
+        {
+            static int handler_installed = 0;
+            if (!handler_installed)
+                {
+                    atexit(volk_gnsssdr_audit_print_at_exit);
+                    handler_installed = 1;
+                }
+            fprintf(stderr, "VOLK_GNSSSDR audit: %s: aligned %s (%s), unaligned %s (%s)\n",
+                entry->kernel_name,
+                entry->impl_a_name, entry->reason_a,
+                entry->impl_u_name, entry->reason_u);
+        }
+}
+
+
+const volk_gnsssdr_audit_entry_t *volk_gnsssdr_audit_entries(void)
+{
+    return audit_head;
+}
+
+
+void volk_gnsssdr_audit_print(FILE *fp)
+{
+    const volk_gnsssdr_audit_entry_t *e;
+    if (!fp) return;
+    for (e = audit_head; e != NULL; e = e->next)
+        {
+            const uint64_t total = e->aligned_calls + e->unaligned_calls;
+            fprintf(fp, "%s: aligned %s (%s), unaligned %s (%s), %" PRIu64 " calls",
+                e->kernel_name,
+                e->impl_a_name, e->reason_a,
+                e->impl_u_name, e->reason_u,
+                total);
+            if (e->unaligned_calls > 0)
+                {
+                    fprintf(fp, ", %" PRIu64 " unaligned (%.1f%%)",
+                        e->unaligned_calls,
+                        100.0 * (double)e->unaligned_calls / (double)total);
+                }
+            fprintf(fp, "\n");
+        }
+}
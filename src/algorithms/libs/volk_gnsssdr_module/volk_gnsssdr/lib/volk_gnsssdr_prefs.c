@@ -20,6 +20,10 @@
 #endif
 #include <volk_gnsssdr/volk_gnsssdr_prefs.h>
 
+#ifdef VOLK_GNSSSDR_BAKED_PROFILE
+#include "volk_gnsssdr_baked_profile.h"
+#endif
+
 
 void volk_gnsssdr_get_config_path(char *path, bool read)
 {
@@ -86,6 +90,49 @@ void volk_gnsssdr_get_config_path(char *path, bool read)
 }
 
 
+// Load the preferences compiled into the library at build time, if any.
+// They are used as a fallback when no config file is found on disk, so
+// freshly deployed systems start from a profiled configuration instead
+// of the generic kernels.
+static size_t volk_gnsssdr_load_baked_preferences(volk_gnsssdr_arch_pref_t **prefs_res)
+{
+#ifdef VOLK_GNSSSDR_BAKED_PROFILE
+    const char *cursor = volk_gnsssdr_baked_profile;
+    char line[512];
+    size_t len;
+    size_t n_arch_prefs = 0;
+    volk_gnsssdr_arch_pref_t *prefs = NULL;
+
+    while (*cursor)
+        {
+            len = strcspn(cursor, "\n");
+            if (len >= sizeof(line)) len = sizeof(line) - 1;
+            memcpy(line, cursor, len);
+            line[len] = 0;
+            cursor += len;
+            if (*cursor == '\n') cursor++;
+            void *new_prefs = realloc(prefs, (n_arch_prefs + 1) * sizeof(*prefs));
+            if (!new_prefs)
+                {
+                    printf("volk_gnsssdr_load_baked_preferences: bad malloc\n");
+                    break;
+                }
+            prefs = (volk_gnsssdr_arch_pref_t *)new_prefs;
+            volk_gnsssdr_arch_pref_t *p = prefs + n_arch_prefs;
+            if (sscanf(line, "%s %s %s", p->name, p->impl_a, p->impl_u) == 3 && !strncmp(p->name, "volk_gnsssdr_", 5))
+                {
+                    n_arch_prefs++;
+                }
+        }
+    *prefs_res = prefs;
+    return n_arch_prefs;
+#else
+    (void)prefs_res;
+    return 0;
+#endif
+}
+
+
 size_t volk_gnsssdr_load_preferences(volk_gnsssdr_arch_pref_t **prefs_res)
 {
     FILE *config_file;
@@ -95,9 +142,9 @@ size_t volk_gnsssdr_load_preferences(volk_gnsssdr_arch_pref_t **prefs_res)
 
     // get the config path
     volk_gnsssdr_get_config_path(path, true);
-    if (!path[0]) return n_arch_prefs;  //no prefs found
+    if (!path[0]) return volk_gnsssdr_load_baked_preferences(prefs_res);  //no prefs found on disk
     config_file = fopen(path, "r");
-    if (!config_file) return n_arch_prefs;  //no prefs found
+    if (!config_file) return volk_gnsssdr_load_baked_preferences(prefs_res);  //no prefs found on disk
 
     // reset the file pointer and write the prefs into volk_gnsssdr_arch_prefs
     while (fgets(line, sizeof(line), config_file) != NULL)
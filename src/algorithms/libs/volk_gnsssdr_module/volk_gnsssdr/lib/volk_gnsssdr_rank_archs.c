@@ -44,6 +44,20 @@ int volk_gnsssdr_rank_archs(
     size_t n_impls,            // number of implementations available
     const bool align           // if false, filter aligned implementations
 )
+{
+    return volk_gnsssdr_rank_archs_reason(kern_name, impl_names, impl_deps, alignment, n_impls, align, NULL);
+}
+
+
+int volk_gnsssdr_rank_archs_reason(
+    const char *kern_name,     // name of the kernel to rank
+    const char *impl_names[],  // list of implementations by name
+    const int *impl_deps,      // requirement mask per implementation
+    const bool *alignment,     // alignment status of each implementation
+    size_t n_impls,            // number of implementations available
+    const bool align,          // if false, filter aligned implementations
+    const char **reason        // receives a static string describing why, may be NULL
+)
 {
     size_t i;
     static volk_gnsssdr_arch_pref_t *volk_gnsssdr_arch_prefs;
@@ -60,6 +74,7 @@ int volk_gnsssdr_rank_archs(
     char *gen_env = getenv("VOLK_GENERIC");
     if (gen_env)
         {
+            if (reason) *reason = "forced generic via VOLK_GENERIC";
             return volk_gnsssdr_get_index(impl_names, n_impls, "generic");
         }
 
@@ -69,6 +84,7 @@ int volk_gnsssdr_rank_archs(
             if (!strncmp(kern_name, volk_gnsssdr_arch_prefs[i].name, sizeof(volk_gnsssdr_arch_prefs[i].name)))  //found it
                 {
                     const char *impl_name = align ? volk_gnsssdr_arch_prefs[i].impl_a : volk_gnsssdr_arch_prefs[i].impl_u;
+                    if (reason) *reason = "profile entry";
                     return volk_gnsssdr_get_index(impl_names, n_impls, impl_name);
                 }
         }
@@ -94,8 +110,13 @@ int volk_gnsssdr_rank_archs(
         }
 
     // when align and we found a best aligned, use it
-    if (align && best_value_a != -1) return best_index_a;
+    if (align && best_value_a != -1)
+        {
+            if (reason) *reason = "best available for machine";
+            return best_index_a;
+        }
 
     // otherwise return the best unaligned
+    if (reason) *reason = (align ? "no aligned impl, unaligned fallback" : "best available for machine");
     return best_index_u;
 }
@@ -33,6 +33,16 @@ extern "C"
         const bool align           // if false, filter aligned implementations
     );
 
+    int volk_gnsssdr_rank_archs_reason(
+        const char *kern_name,     // name of the kernel to rank
+        const char *impl_names[],  // list of implementations by name
+        const int *impl_deps,      // requirement mask per implementation
+        const bool *alignment,     // alignment status of each implementation
+        size_t n_impls,            // number of implementations available
+        const bool align,          // if false, filter aligned implementations
+        const char **reason        // receives a static string describing why, may be NULL
+    );
+
 #ifdef __cplusplus
 }
 #endif
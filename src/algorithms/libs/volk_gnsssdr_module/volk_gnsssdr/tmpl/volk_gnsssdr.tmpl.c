@@ -14,6 +14,7 @@
 #include <volk_gnsssdr/volk_gnsssdr_cpu.h>
 #include "volk_gnsssdr_rank_archs.h"
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_audit.h>
 #include <assert.h>
 #include <stdio.h>
 #include <string.h>
@@ -121,6 +122,8 @@ bool volk_gnsssdr_is_aligned(const void *ptr)
 #include <volk_gnsssdr/${kern.name}.h> //pulls in the dispatcher
 %endif
 
+static volk_gnsssdr_audit_entry_t __${kern.name}_audit;
+
 static inline void __${kern.name}_d(${kern.arglist_full})
 {
     %if kern.has_dispatcher:
@@ -136,9 +139,11 @@ static inline void __${kern.name}_d(${kern.arglist_full})
     %endfor
         0<% end_open_parens = ')'*num_open_parens %>${end_open_parens}
     )){
+        __${kern.name}_audit.aligned_calls++;
         ${kern.name}_a(${kern.arglist_names});
     }
     else{
+        __${kern.name}_audit.unaligned_calls++;
         ${kern.name}_u(${kern.arglist_names});
     }
 }
@@ -150,14 +155,23 @@ static inline void __init_${kern.name}(void)
     const int *impl_deps = get_machine()->${kern.name}_impl_deps;
     const bool *alignment = get_machine()->${kern.name}_impl_alignment;
     const size_t n_impls = get_machine()->${kern.name}_n_impls;
-    const size_t index_a = volk_gnsssdr_rank_archs(name, impl_names, impl_deps, alignment, n_impls, true/*aligned*/);
-    const size_t index_u = volk_gnsssdr_rank_archs(name, impl_names, impl_deps, alignment, n_impls, false/*unaligned*/);
+    const char *reason_a = NULL;
+    const char *reason_u = NULL;
+    const size_t index_a = volk_gnsssdr_rank_archs_reason(name, impl_names, impl_deps, alignment, n_impls, true/*aligned*/, &reason_a);
+    const size_t index_u = volk_gnsssdr_rank_archs_reason(name, impl_names, impl_deps, alignment, n_impls, false/*unaligned*/, &reason_u);
     ${kern.name}_a = get_machine()->${kern.name}_impls[index_a];
     ${kern.name}_u = get_machine()->${kern.name}_impls[index_u];
 
     assert(${kern.name}_a);
     assert(${kern.name}_u);
 
+    __${kern.name}_audit.kernel_name = name;
+    __${kern.name}_audit.impl_a_name = impl_names[index_a];
+    __${kern.name}_audit.impl_u_name = impl_names[index_u];
+    __${kern.name}_audit.reason_a = reason_a;
+    __${kern.name}_audit.reason_u = reason_u;
+    volk_gnsssdr_audit_register(&__${kern.name}_audit);
+
     ${kern.name} = &__${kern.name}_d;
 }
 
@@ -35,10 +35,31 @@ HybridObservables::HybridObservables(const ConfigurationInterface* configuration
 
     conf.dump = dump_;
     conf.dump_mat = dump_mat_;
+    conf.dump_delta = configuration->property(role + ".dump_delta", conf.dump_delta);
     conf.dump_filename = dump_filename_;
     conf.nchannels_in = in_streams_;
     conf.nchannels_out = out_streams_;
     conf.enable_carrier_smoothing = configuration->property(role + ".enable_carrier_smoothing", conf.enable_carrier_smoothing);
+    conf.enable_work_monitor = configuration->property("WorkMonitor.enable_monitor", conf.enable_work_monitor);
+    conf.work_monitor_addresses = configuration->property("WorkMonitor.client_addresses", conf.work_monitor_addresses);
+    conf.work_monitor_port = configuration->property("WorkMonitor.udp_port", conf.work_monitor_port);
+    conf.work_monitor_interval_calls = configuration->property("WorkMonitor.report_interval_calls", conf.work_monitor_interval_calls);
+    conf.enable_doppler_smoothing = configuration->property(role + ".enable_doppler_smoothing", conf.enable_doppler_smoothing);
+    conf.history_use_hugepages = configuration->property(role + ".use_hugepages", conf.history_use_hugepages);
+    conf.history_first_touch_core = configuration->property(role + ".first_touch_core", conf.history_first_touch_core);
+    conf.epoch_sink_address = configuration->property(role + ".epoch_sink_address", conf.epoch_sink_address);
+    conf.epoch_sink_port = configuration->property(role + ".epoch_sink_port", conf.epoch_sink_port);
+    conf.epoch_sink_receiver_id = configuration->property(role + ".epoch_sink_receiver_id", conf.epoch_sink_receiver_id);
+    conf.enable_integrity_monitor = configuration->property(role + ".enable_integrity_monitor", conf.enable_integrity_monitor);
+    conf.integrity_monitor_address = configuration->property(role + ".integrity_monitor_address", conf.integrity_monitor_address);
+    conf.integrity_monitor_port = configuration->property(role + ".integrity_monitor_port", conf.integrity_monitor_port);
+    conf.integrity_innovation_sigma = configuration->property(role + ".integrity_innovation_sigma", conf.integrity_innovation_sigma);
+    conf.integrity_clock_jump_m = configuration->property(role + ".integrity_clock_jump_m", conf.integrity_clock_jump_m);
+    conf.integrity_cn0_step_db = configuration->property(role + ".integrity_cn0_step_db", conf.integrity_cn0_step_db);
+    conf.enable_cycle_slip_detector = configuration->property(role + ".enable_cycle_slip_detector", conf.enable_cycle_slip_detector);
+    conf.slip_phase_threshold_cycles = configuration->property(role + ".slip_phase_threshold_cycles", conf.slip_phase_threshold_cycles);
+    conf.slip_gf_threshold_m = configuration->property(role + ".slip_gf_threshold_m", conf.slip_gf_threshold_m);
+    conf.slip_mw_sigma = configuration->property(role + ".slip_mw_sigma", conf.slip_mw_sigma);
 
     if (FLAGS_carrier_smoothing_factor == DEFAULT_CARRIER_SMOOTHING_FACTOR)
         {
@@ -47,7 +68,8 @@ HybridObservables::HybridObservables(const ConfigurationInterface* configuration
 
     if (conf.enable_carrier_smoothing == true)
         {
-            LOG(INFO) << "Observables carrier smoothing enabled with smoothing factor " << conf.smoothing_factor;
+            LOG(INFO) << "Observables carrier smoothing enabled with smoothing factor " << conf.smoothing_factor
+                      << (conf.enable_doppler_smoothing ? ", Doppler-aided" : "");
         }
     observables_ = hybrid_observables_gs_make(conf);
     DLOG(INFO) << "Observables block ID (" << observables_->unique_id() << ")";
@@ -17,15 +17,18 @@
 
 #include "hybrid_observables_gs.h"
 #include "MATH_CONSTANTS.h"  // for SPEED_OF_LIGHT_M_S, TWO_PI
+#include "dump_budget.h"
 #include "gnss_circular_deque.h"
-#include "gnss_frequencies.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_make_unique.h"
+#include "gnss_sdr_placement_alloc.h"
 #include "gnss_synchro.h"
+#include "memory_registry.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <matio.h>
 #include <array>
+#include <chrono>     // for the epoch output timestamp
 #include <cmath>      // for round
 #include <cstdlib>    // for size_t, llabs
 #include <exception>  // for exception
@@ -90,9 +93,65 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_) : gr::block(
     d_dump_filename = conf_.dump_filename;
     d_nchannels_out = conf_.nchannels_out;
     d_nchannels_in = conf_.nchannels_in;
-    d_gnss_synchro_history = std::make_unique<Gnss_circular_deque<Gnss_Synchro>>(1000, d_nchannels_out);
+    d_gnss_synchro_history = std::make_unique<Gnss_circular_deque<Gnss_Synchro, Placement_Allocator<Gnss_Synchro>>>(1000, d_nchannels_out,
+        Placement_Allocator<Gnss_Synchro>(conf_.history_use_hugepages, conf_.history_first_touch_core));
+    // report the dominant buffer to the memory accounting registry
+    Memory_Registry::report(this, "Observables", "channel history deques",
+        sizeof(Gnss_Synchro) * 1000 * d_nchannels_out);
+
+    d_work_monitor.set_identity("observables", 0);
+    if (conf_.enable_work_monitor)
+        {
+            d_work_monitor.configure("observables", 0,
+                conf_.work_monitor_addresses,
+                conf_.work_monitor_port,
+                conf_.work_monitor_interval_calls);
+        }
+    d_pvt_clock_offset_ring.reset(8, 1);  // single producer: the PVT message thread
+
+    if (!conf_.epoch_sink_address.empty())
+        {
+            d_epoch_sink = std::make_unique<Obs_Epoch_Sink>(conf_.epoch_sink_address,
+                conf_.epoch_sink_port,
+                conf_.epoch_sink_receiver_id);
+            LOG(INFO) << "Observables epoch sink enabled, receiver id " << conf_.epoch_sink_receiver_id
+                      << ", publishing to " << conf_.epoch_sink_address << ":" << conf_.epoch_sink_port;
+        }
+    if (conf_.enable_integrity_monitor)
+        {
+            d_integrity_monitor = std::make_unique<Obs_Integrity_Monitor>(conf_.integrity_monitor_address,
+                conf_.integrity_monitor_port,
+                conf_.integrity_innovation_sigma,
+                conf_.integrity_clock_jump_m,
+                conf_.integrity_cn0_step_db);
+            LOG(INFO) << "Observables integrity monitor enabled: innovation test at "
+                      << conf_.integrity_innovation_sigma << " sigma, clock jump threshold "
+                      << conf_.integrity_clock_jump_m << " m, C/N0 step threshold "
+                      << conf_.integrity_cn0_step_db << " dB";
+        }
+    if (conf_.enable_cycle_slip_detector)
+        {
+            d_cycle_slip_detector = std::make_unique<Cycle_Slip_Detector>(conf_.slip_phase_threshold_cycles,
+                conf_.slip_gf_threshold_m,
+                conf_.slip_mw_sigma);
+            LOG(INFO) << "Observables cycle-slip detector enabled: phase threshold "
+                      << conf_.slip_phase_threshold_cycles << " cycles, geometry-free threshold "
+                      << conf_.slip_gf_threshold_m << " m, Melbourne-Wubbena test at "
+                      << conf_.slip_mw_sigma << " sigma";
+        }
 
     // ############# ENABLE DATA FILE LOG #################
+    if (d_dump)
+        {
+            // one record of doubles per channel and epoch, plus stream buffering
+            const Dump_Budget::Grant grant = Dump_Budget::request(this, "Observables",
+                65536 + sizeof(double) * 7 * d_nchannels_out);
+            if (!grant.enabled)
+                {
+                    d_dump = false;
+                    d_dump_mat = false;
+                }
+        }
     if (d_dump)
         {
             std::string dump_path;
@@ -116,7 +175,7 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_) : gr::block(
                 {
                     d_dump_filename = d_dump_filename.substr(0, d_dump_filename.find_last_of('.'));
                 }
-            d_dump_filename.append(".dat");
+            d_dump_filename.append(conf_.dump_delta ? ".gsdo" : ".dat");
             d_dump_filename = dump_path + fs::path::preferred_separator + d_dump_filename;
             // create directory
             if (!gnss_sdr_create_directory(dump_path))
@@ -124,16 +183,31 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_) : gr::block(
                     std::cerr << "GNSS-SDR cannot create dump file for the Observables block. Wrong permissions?\n";
                     d_dump = false;
                 }
-            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-            try
+            if (d_dump and conf_.dump_delta)
                 {
-                    d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
-                    LOG(INFO) << "Observables dump enabled Log file: " << d_dump_filename.c_str();
+                    if (d_delta_dump.open(d_dump_filename, static_cast<uint16_t>(d_nchannels_out)))
+                        {
+                            LOG(INFO) << "Observables delta-encoded dump enabled Log file: " << d_dump_filename.c_str();
+                        }
+                    else
+                        {
+                            LOG(WARNING) << "Problem opening observables delta dump file " << d_dump_filename.c_str();
+                            d_dump = false;
+                        }
                 }
-            catch (const std::ifstream::failure &e)
+            else if (d_dump)
                 {
-                    LOG(WARNING) << "Exception opening observables dump file " << e.what();
-                    d_dump = false;
+                    d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+                    try
+                        {
+                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
+                            LOG(INFO) << "Observables dump enabled Log file: " << d_dump_filename.c_str();
+                        }
+                    catch (const std::ifstream::failure &e)
+                        {
+                            LOG(WARNING) << "Exception opening observables dump file " << e.what();
+                            d_dump = false;
+                        }
                 }
         }
     d_T_rx_TOW_ms = 0U;
@@ -144,29 +218,32 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_) : gr::block(
     d_Rx_clock_buffer.set_capacity(10);  // 10*20 ms = 200 ms of data in buffer
     d_Rx_clock_buffer.clear();           // Clear all the elements in the buffer
 
-    d_channel_last_pll_lock = std::vector<bool>(d_nchannels_out, false);
-    d_channel_last_pseudorange_smooth = std::vector<double>(d_nchannels_out, 0.0);
-    d_channel_last_carrier_phase_rads = std::vector<double>(d_nchannels_out, 0.0);
-
-    d_smooth_filter_M = static_cast<double>(conf_.smoothing_factor);
-    d_mapStringValues["1C"] = evGPS_1C;
-    d_mapStringValues["2S"] = evGPS_2S;
-    d_mapStringValues["L5"] = evGPS_L5;
-    d_mapStringValues["1B"] = evGAL_1B;
-    d_mapStringValues["5X"] = evGAL_5X;
-    d_mapStringValues["E6"] = evGAL_E6;
-    d_mapStringValues["7X"] = evGAL_7X;
-    d_mapStringValues["1G"] = evGLO_1G;
-    d_mapStringValues["2G"] = evGLO_2G;
-    d_mapStringValues["B1"] = evBDS_B1;
-    d_mapStringValues["B2"] = evBDS_B2;
-    d_mapStringValues["B3"] = evBDS_B3;
+    d_channel_history_cursor = std::vector<uint32_t>(d_nchannels_out, 0);
+
+    d_carrier_smoother.init(d_nchannels_out, static_cast<double>(conf_.smoothing_factor),
+        static_cast<double>(d_T_rx_step_ms) / 1000.0, conf_.enable_doppler_smoothing);
 }
 
 
 hybrid_observables_gs::~hybrid_observables_gs()
 {
     DLOG(INFO) << "Observables block destructor called.";
+    Memory_Registry::release(this);
+    Dump_Budget::release(this);
+    if (d_delta_dump.is_open())
+        {
+            const bool empty = (d_delta_dump.epochs_written() == 0);
+            d_delta_dump.close();
+            if (empty)
+                {
+                    errorlib::error_code ec;
+                    if (!fs::remove(fs::path(d_dump_filename), ec))
+                        {
+                            std::cerr << "Problem removing temporary file " << d_dump_filename << '\n';
+                        }
+                    d_dump_mat = false;
+                }
+        }
     if (d_dump_file.is_open())
         {
             const auto pos = d_dump_file.tellp();
@@ -204,25 +281,18 @@ hybrid_observables_gs::~hybrid_observables_gs()
 
 void hybrid_observables_gs::msg_handler_pvt_to_observables(const pmt::pmt_t &msg)
 {
-    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    // Lock-free hand-off to general_work(): pushing the offset into the ring
+    // never blocks, so this handler does not contend with the work function
+    // for the block lock while it processes an epoch
     try
         {
             if (pmt::any_ref(msg).type().hash_code() == d_double_type_hash_code)
                 {
                     const auto new_rx_clock_offset_s = boost::any_cast<double>(pmt::any_ref(msg));
-                    d_T_rx_TOW_ms = d_T_rx_TOW_ms - static_cast<int>(round(new_rx_clock_offset_s * 1000.0));
-                    // align the receiver clock to integer multiple of 20 ms
-                    if (d_T_rx_TOW_ms % 20)
-                        {
-                            d_T_rx_TOW_ms += 20 - d_T_rx_TOW_ms % 20;
-                        }
-                    // d_Rx_clock_buffer.clear();  // Clear all the elements in the buffer
-                    for (uint32_t n = 0; n < d_nchannels_out; n++)
+                    if (!d_pvt_clock_offset_ring.try_push(0, new_rx_clock_offset_s))
                         {
-                            d_gnss_synchro_history->clear(n);
+                            LOG(WARNING) << "Receiver clock offset correction dropped: ring full";
                         }
-
-                    LOG(INFO) << "Corrected new RX Time offset: " << static_cast<int>(round(new_rx_clock_offset_s * 1000.0)) << "[ms]";
                 }
         }
     catch (const boost::bad_any_cast &e)
@@ -232,70 +302,133 @@ void hybrid_observables_gs::msg_handler_pvt_to_observables(const pmt::pmt_t &msg
 }
 
 
+void hybrid_observables_gs::apply_rx_clock_offset(double new_rx_clock_offset_s)
+{
+    d_T_rx_TOW_ms = d_T_rx_TOW_ms - static_cast<int>(round(new_rx_clock_offset_s * 1000.0));
+    // align the receiver clock to integer multiple of 20 ms
+    if (d_T_rx_TOW_ms % 20)
+        {
+            d_T_rx_TOW_ms += 20 - d_T_rx_TOW_ms % 20;
+        }
+    // d_Rx_clock_buffer.clear();  // Clear all the elements in the buffer
+    for (uint32_t n = 0; n < d_nchannels_out; n++)
+        {
+            d_gnss_synchro_history->clear(n);
+            d_channel_history_cursor[n] = 0;
+        }
+
+    LOG(INFO) << "Corrected new RX Time offset: " << static_cast<int>(round(new_rx_clock_offset_s * 1000.0)) << "[ms]";
+}
+
+
 int32_t hybrid_observables_gs::save_matfile() const
 {
     // READ DUMP FILE
     const std::string dump_filename = d_dump_filename;
-    std::ifstream::pos_type size;
     const int32_t number_of_double_vars = 7;
-    const int32_t epoch_size_bytes = sizeof(double) * number_of_double_vars * d_nchannels_out;
-    std::ifstream dump_file;
     std::cout << "Generating .mat file for " << dump_filename << '\n';
-    dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try
-        {
-            dump_file.open(dump_filename.c_str(), std::ios::binary | std::ios::ate);
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem opening dump file:" << e.what() << '\n';
-            return 1;
-        }
-    // count number of epochs and rewind
     int64_t num_epoch = 0LL;
-    if (dump_file.is_open())
+
+    auto RX_time = std::vector<std::vector<double>>(d_nchannels_out);
+    auto TOW_at_current_symbol_s = std::vector<std::vector<double>>(d_nchannels_out);
+    auto Carrier_Doppler_hz = std::vector<std::vector<double>>(d_nchannels_out);
+    auto Carrier_phase_cycles = std::vector<std::vector<double>>(d_nchannels_out);
+    auto Pseudorange_m = std::vector<std::vector<double>>(d_nchannels_out);
+    auto PRN = std::vector<std::vector<double>>(d_nchannels_out);
+    auto Flag_valid_pseudorange = std::vector<std::vector<double>>(d_nchannels_out);
+
+    if (d_conf.dump_delta)
         {
-            size = dump_file.tellg();
-            num_epoch = static_cast<int64_t>(size) / static_cast<int64_t>(epoch_size_bytes);
-            dump_file.seekg(0, std::ios::beg);
+            Delta_Obs_Reader reader;
+            if (!reader.open(dump_filename) or reader.nchannels() != d_nchannels_out)
+                {
+                    std::cerr << "Problem opening delta dump file " << dump_filename << '\n';
+                    return 1;
+                }
+            std::vector<double> row;
+            while (reader.read_epoch(row))
+                {
+                    std::size_t k = 0;
+                    for (uint32_t chan = 0; chan < d_nchannels_out; chan++)
+                        {
+                            RX_time[chan].push_back(row[k++]);
+                            TOW_at_current_symbol_s[chan].push_back(row[k++]);
+                            Carrier_Doppler_hz[chan].push_back(row[k++]);
+                            Carrier_phase_cycles[chan].push_back(row[k++]);
+                            Pseudorange_m[chan].push_back(row[k++]);
+                            PRN[chan].push_back(row[k++]);
+                            Flag_valid_pseudorange[chan].push_back(row[k++]);
+                        }
+                    num_epoch++;
+                }
         }
     else
         {
-            return 1;
-        }
+            std::ifstream::pos_type size;
+            const int32_t epoch_size_bytes = sizeof(double) * number_of_double_vars * d_nchannels_out;
+            std::ifstream dump_file;
+            dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+            try
+                {
+                    dump_file.open(dump_filename.c_str(), std::ios::binary | std::ios::ate);
+                }
+            catch (const std::ifstream::failure &e)
+                {
+                    std::cerr << "Problem opening dump file:" << e.what() << '\n';
+                    return 1;
+                }
+            // count number of epochs and rewind
+            if (dump_file.is_open())
+                {
+                    size = dump_file.tellg();
+                    num_epoch = static_cast<int64_t>(size) / static_cast<int64_t>(epoch_size_bytes);
+                    dump_file.seekg(0, std::ios::beg);
+                }
+            else
+                {
+                    return 1;
+                }
+            if (!Dump_Budget::mat_conversion_allowed(static_cast<size_t>(size)))
+                {
+                    return 1;
+                }
 
-    auto RX_time = std::vector<std::vector<double>>(d_nchannels_out, std::vector<double>(num_epoch));
-    auto TOW_at_current_symbol_s = std::vector<std::vector<double>>(d_nchannels_out, std::vector<double>(num_epoch));
-    auto Carrier_Doppler_hz = std::vector<std::vector<double>>(d_nchannels_out, std::vector<double>(num_epoch));
-    auto Carrier_phase_cycles = std::vector<std::vector<double>>(d_nchannels_out, std::vector<double>(num_epoch));
-    auto Pseudorange_m = std::vector<std::vector<double>>(d_nchannels_out, std::vector<double>(num_epoch));
-    auto PRN = std::vector<std::vector<double>>(d_nchannels_out, std::vector<double>(num_epoch));
-    auto Flag_valid_pseudorange = std::vector<std::vector<double>>(d_nchannels_out, std::vector<double>(num_epoch));
+            for (uint32_t chan = 0; chan < d_nchannels_out; chan++)
+                {
+                    RX_time[chan].resize(num_epoch);
+                    TOW_at_current_symbol_s[chan].resize(num_epoch);
+                    Carrier_Doppler_hz[chan].resize(num_epoch);
+                    Carrier_phase_cycles[chan].resize(num_epoch);
+                    Pseudorange_m[chan].resize(num_epoch);
+                    PRN[chan].resize(num_epoch);
+                    Flag_valid_pseudorange[chan].resize(num_epoch);
+                }
 
-    try
-        {
-            if (dump_file.is_open())
+            try
                 {
-                    for (int64_t i = 0; i < num_epoch; i++)
+                    if (dump_file.is_open())
                         {
-                            for (uint32_t chan = 0; chan < d_nchannels_out; chan++)
+                            for (int64_t i = 0; i < num_epoch; i++)
                                 {
-                                    dump_file.read(reinterpret_cast<char *>(&RX_time[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&TOW_at_current_symbol_s[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Carrier_Doppler_hz[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Carrier_phase_cycles[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Pseudorange_m[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&PRN[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Flag_valid_pseudorange[chan][i]), sizeof(double));
+                                    for (uint32_t chan = 0; chan < d_nchannels_out; chan++)
+                                        {
+                                            dump_file.read(reinterpret_cast<char *>(&RX_time[chan][i]), sizeof(double));
+                                            dump_file.read(reinterpret_cast<char *>(&TOW_at_current_symbol_s[chan][i]), sizeof(double));
+                                            dump_file.read(reinterpret_cast<char *>(&Carrier_Doppler_hz[chan][i]), sizeof(double));
+                                            dump_file.read(reinterpret_cast<char *>(&Carrier_phase_cycles[chan][i]), sizeof(double));
+                                            dump_file.read(reinterpret_cast<char *>(&Pseudorange_m[chan][i]), sizeof(double));
+                                            dump_file.read(reinterpret_cast<char *>(&PRN[chan][i]), sizeof(double));
+                                            dump_file.read(reinterpret_cast<char *>(&Flag_valid_pseudorange[chan][i]), sizeof(double));
+                                        }
                                 }
                         }
+                    dump_file.close();
+                }
+            catch (const std::ifstream::failure &e)
+                {
+                    std::cerr << "Problem reading dump file:" << e.what() << '\n';
+                    return 1;
                 }
-            dump_file.close();
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem reading dump file:" << e.what() << '\n';
-            return 1;
         }
 
     auto RX_time_aux = std::vector<double>(d_nchannels_out * num_epoch);
@@ -326,9 +459,10 @@ int32_t hybrid_observables_gs::save_matfile() const
     mat_t *matfp;
     matvar_t *matvar;
     std::string filename = d_dump_filename;
-    if (filename.size() > 4)
+    const std::string::size_type extension = filename.find_last_of('.');
+    if (extension != std::string::npos)
         {
-            filename.erase(filename.end() - 4, filename.end());
+            filename.erase(extension);
         }
     filename.append(".mat");
     matfp = Mat_CreateVer(filename.c_str(), nullptr, MAT_FT_MAT73);
@@ -375,23 +509,42 @@ double hybrid_observables_gs::compute_T_rx_s(const Gnss_Synchro &a) const
 }
 
 
-bool hybrid_observables_gs::interp_trk_obs(Gnss_Synchro &interpolated_obs, uint32_t ch, uint64_t rx_clock) const
+bool hybrid_observables_gs::interp_trk_obs(Gnss_Synchro &interpolated_obs, uint32_t ch, uint64_t rx_clock)
 {
     int32_t nearest_element = -1;
     int64_t old_abs_diff = std::numeric_limits<int64_t>::max();
-    for (uint32_t i = 0; i < d_gnss_synchro_history->size(ch); i++)
+    const uint32_t history_size = d_gnss_synchro_history->size(ch);
+    if (history_size > 0)
         {
-            const int64_t abs_diff = llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(d_gnss_synchro_history->get(ch, i).Tracking_sample_counter));
-            if (old_abs_diff > abs_diff)
+            // The history is ordered by Tracking_sample_counter, so the distance
+            // to rx_clock is V-shaped over the indices and a local descent from
+            // the cursor reaches the nearest element. rx_clock advances
+            // monotonically between calls, which makes the walk O(1) amortized
+            const auto abs_diff_at = [&](uint32_t i) {
+                return llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(d_gnss_synchro_history->get(ch, i).Tracking_sample_counter));
+            };
+            uint32_t cursor = d_channel_history_cursor[ch];
+            if (cursor >= history_size)
                 {
-                    old_abs_diff = abs_diff;
-                    nearest_element = static_cast<int32_t>(i);
+                    cursor = history_size - 1;
                 }
+            while (cursor + 1 < history_size and abs_diff_at(cursor + 1) <= abs_diff_at(cursor))
+                {
+                    cursor++;
+                }
+            while (cursor > 0 and abs_diff_at(cursor - 1) < abs_diff_at(cursor))
+                {
+                    cursor--;
+                }
+            d_channel_history_cursor[ch] = cursor;
+            nearest_element = static_cast<int32_t>(cursor);
+            old_abs_diff = abs_diff_at(cursor);
         }
 
     if (nearest_element != -1 and nearest_element != static_cast<int32_t>(d_gnss_synchro_history->size(ch)))
         {
-            if ((static_cast<double>(old_abs_diff) / static_cast<double>(d_gnss_synchro_history->get(ch, nearest_element).fs)) < 0.02)
+            // proximity gate (20 ms), exact in integer sample ticks
+            if (old_abs_diff * 50 < d_gnss_synchro_history->get(ch, nearest_element).fs)
                 {
                     int32_t neighbor_element;
                     if (rx_clock > d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter)
@@ -425,11 +578,16 @@ bool hybrid_observables_gs::interp_trk_obs(Gnss_Synchro &interpolated_obs, uint3
                             interpolated_obs = d_gnss_synchro_history->get(ch, nearest_element);
 
                             // 2nd: Linear interpolation: y(t) = y(t1) + (y(t2) - y(t1)) * (t - t1) / (t2 - t1)
-                            const double T_rx_s = static_cast<double>(rx_clock) / static_cast<double>(interpolated_obs.fs);
-
-                            const double time_factor = (T_rx_s - d_gnss_synchro_history->get(ch, t1_idx).RX_time) /
-                                                       (d_gnss_synchro_history->get(ch, t2_idx).RX_time -
-                                                           d_gnss_synchro_history->get(ch, t1_idx).RX_time);
+                            // The factor is computed in sample ticks: the int64 counter
+                            // differences stay exact however long the run, while the former
+                            // quotient of nearly equal RX_time doubles lost significance as
+                            // the counters grew (slow drift in week-long static runs). The
+                            // sub-sample code phases only enter as small corrections
+                            const Gnss_Synchro &obs_t1 = d_gnss_synchro_history->get(ch, t1_idx);
+                            const Gnss_Synchro &obs_t2 = d_gnss_synchro_history->get(ch, t2_idx);
+                            const double ticks_from_t1 = static_cast<double>(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(obs_t1.Tracking_sample_counter)) - obs_t1.Code_phase_samples;
+                            const double ticks_span = static_cast<double>(static_cast<int64_t>(obs_t2.Tracking_sample_counter) - static_cast<int64_t>(obs_t1.Tracking_sample_counter)) + (obs_t2.Code_phase_samples - obs_t1.Code_phase_samples);
+                            const double time_factor = ticks_from_t1 / ticks_span;
 
                             // CARRIER PHASE INTERPOLATION
                             interpolated_obs.Carrier_phase_rads = d_gnss_synchro_history->get(ch, t1_idx).Carrier_phase_rads + (d_gnss_synchro_history->get(ch, t2_idx).Carrier_phase_rads - d_gnss_synchro_history->get(ch, t1_idx).Carrier_phase_rads) * time_factor;
@@ -552,83 +710,22 @@ void hybrid_observables_gs::compute_pranges(std::vector<Gnss_Synchro> &data) con
 }
 
 
-void hybrid_observables_gs::smooth_pseudoranges(std::vector<Gnss_Synchro> &data)
-{
-    std::vector<Gnss_Synchro>::iterator it;
-    for (it = data.begin(); it != data.end(); it++)
-        {
-            if (it->Flag_valid_pseudorange)
-                {
-                    // 0. get wavelength for the current signal
-                    double wavelength_m = 0;
-                    switch (d_mapStringValues[it->Signal])
-                        {
-                        case evGPS_1C:
-                        case evSBAS_1C:
-                        case evGAL_1B:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1;
-                            break;
-                        case evGPS_L5:
-                        case evGAL_5X:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ5;
-                            break;
-                        case evGAL_E6:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ6;
-                            break;
-                        case evGAL_7X:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ7;
-                            break;
-                        case evGPS_2S:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ2;
-                            break;
-                        case evBDS_B3:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ3_BDS;
-                            break;
-                        case evGLO_1G:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1_GLO;
-                            break;
-                        case evGLO_2G:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ2_GLO;
-                            break;
-                        case evBDS_B1:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1_BDS;
-                            break;
-                        case evBDS_B2:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ2_BDS;
-                            break;
-                        default:
-                            break;
-                        }
-
-                    // todo: propagate the PLL lock status in Gnss_Synchro
-                    // 1. check if last PLL lock status was false and initialize last d_channel_last_pseudorange_smooth
-                    if (d_channel_last_pll_lock[it->Channel_ID] == true)
-                        {
-                            // 2. Compute the smoothed pseudorange for this channel
-                            // Hatch filter algorithm (https://insidegnss.com/can-you-list-all-the-properties-of-the-carrier-smoothing-filter/)
-                            const double r_sm = d_channel_last_pseudorange_smooth[it->Channel_ID];
-                            const double factor = ((d_smooth_filter_M - 1.0) / d_smooth_filter_M);
-                            it->Pseudorange_m = factor * r_sm + (1.0 / d_smooth_filter_M) * it->Pseudorange_m + wavelength_m * (factor / TWO_PI) * (it->Carrier_phase_rads - d_channel_last_carrier_phase_rads[it->Channel_ID]);
-                        }
-                    d_channel_last_pseudorange_smooth[it->Channel_ID] = it->Pseudorange_m;
-                    d_channel_last_carrier_phase_rads[it->Channel_ID] = it->Carrier_phase_rads;
-                    d_channel_last_pll_lock[it->Channel_ID] = it->Flag_valid_pseudorange;
-                }
-            else
-                {
-                    d_channel_last_pll_lock[it->Channel_ID] = false;
-                }
-        }
-}
-
-
 int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)),
     gr_vector_int &ninput_items, gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
     const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);
+    Work_Monitor_Scope work_timer(d_work_monitor, static_cast<uint32_t>(ninput_items[0]),
+        (ninput_items[d_nchannels_in - 1] > 0) ? in[d_nchannels_in - 1][0].Tracking_sample_counter : 0ULL);
     auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
 
+    // Apply the receiver clock corrections queued by the PVT message handler
+    double new_rx_clock_offset_s;
+    while (d_pvt_clock_offset_ring.try_pop(0, new_rx_clock_offset_s))
+        {
+            apply_rx_clock_offset(new_rx_clock_offset_s);
+        }
+
     // Push receiver clock into history buffer (connected to the last of the input channels)
     // The clock buffer gives time to the channels to compute the tracking observables
     if (ninput_items[d_nchannels_in - 1] > 0)
@@ -652,10 +749,17 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
                                     if (d_gnss_synchro_history->front(n).PRN != in[n][m].PRN)
                                         {
                                             d_gnss_synchro_history->clear(n);
+                                            d_channel_history_cursor[n] = 0;
                                             // LOG(INFO) << "Channel " << d_gnss_synchro_history->front(n).Channel_ID << " changed satellite to PRN " << in[n][m].PRN;
                                         }
                                 }
+                            const uint32_t size_before_push = d_gnss_synchro_history->size(n);
                             d_gnss_synchro_history->push_back(n, in[n][m]);
+                            // a push into a full deque drops the front element, shifting the cursor position
+                            if (d_gnss_synchro_history->size(n) == size_before_push and d_channel_history_cursor[n] > 0)
+                                {
+                                    d_channel_history_cursor[n]--;
+                                }
                             d_gnss_synchro_history->back(n).RX_time = compute_T_rx_s(in[n][m]);
                         }
                 }
@@ -701,18 +805,35 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
             if (n_valid > 0)
                 {
                     compute_pranges(epoch_data);
+                    // flag carrier-phase cycle slips before the epoch leaves the block
+                    if (d_cycle_slip_detector)
+                        {
+                            d_cycle_slip_detector->check_epoch(epoch_data);
+                        }
                 }
 
             // Carrier smoothing (optional)
             if (d_conf.enable_carrier_smoothing == true)
                 {
-                    smooth_pseudoranges(epoch_data);
+                    d_carrier_smoother.smooth(epoch_data);
                 }
             // output the observables set to the PVT block
+            const auto obs_time_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
             for (uint32_t n = 0; n < d_nchannels_out; n++)
                 {
+                    epoch_data[n].Obs_time_ns = obs_time_ns;
                     out[n][0] = epoch_data[n];
                 }
+            // integrity screening of the epoch that was just delivered
+            if (d_integrity_monitor)
+                {
+                    d_integrity_monitor->check_epoch(epoch_data);
+                }
+            // publish the epoch to the aggregation network, if configured
+            if (d_epoch_sink)
+                {
+                    d_epoch_sink->write_epoch(epoch_data);
+                }
             // report channel status every second
             d_T_status_report_timer_ms += d_T_rx_step_ms;
             if (d_T_status_report_timer_ms >= 1000)
@@ -726,7 +847,28 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
                     d_T_status_report_timer_ms = 0;
                 }
 
-            if (d_dump)
+            if (d_dump and d_conf.dump_delta)
+                {
+                    // delta + varint encoded recording, same columns as the flat dump
+                    std::vector<double> row(static_cast<std::size_t>(d_nchannels_out) * Delta_Obs_Writer::fields_per_channel);
+                    std::size_t k = 0;
+                    for (uint32_t i = 0; i < d_nchannels_out; i++)
+                        {
+                            row[k++] = out[i][0].RX_time;
+                            row[k++] = out[i][0].interp_TOW_ms / 1000.0;
+                            row[k++] = out[i][0].Carrier_Doppler_hz;
+                            row[k++] = out[i][0].Carrier_phase_rads / TWO_PI;
+                            row[k++] = out[i][0].Pseudorange_m;
+                            row[k++] = static_cast<double>(out[i][0].PRN);
+                            row[k++] = static_cast<double>(out[i][0].Flag_valid_pseudorange);
+                        }
+                    if (!d_delta_dump.write_epoch(row))
+                        {
+                            LOG(WARNING) << "Problem writing observables delta dump file";
+                            d_dump = false;
+                        }
+                }
+            else if (d_dump)
                 {
                     // MULTIPLEXED FILE RECORDING - Record results to file
                     try
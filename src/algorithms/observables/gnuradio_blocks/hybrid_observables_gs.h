@@ -20,15 +20,21 @@
 #ifndef GNSS_SDR_HYBRID_OBSERVABLES_GS_H
 #define GNSS_SDR_HYBRID_OBSERVABLES_GS_H
 
+#include "carrier_smoother.h"
+#include "cycle_slip_detector.h"
+#include "delta_obs_codec.h"
 #include "gnss_block_interface.h"
+#include "gnss_spsc_ring.h"
 #include "obs_conf.h"
+#include "obs_epoch_sink.h"
+#include "obs_integrity_monitor.h"
+#include "work_monitor.h"
 #include <boost/circular_buffer.hpp>  // for boost::circular_buffer
 #include <gnuradio/block.h>           // for block
 #include <gnuradio/types.h>           // for gr_vector_int
 #include <cstddef>                    // for size_t
 #include <cstdint>                    // for int32_t
 #include <fstream>                    // for std::ofstream
-#include <map>                        // for std::map
 #include <memory>                     // for std::shared, std:unique_ptr
 #include <string>                     // for std::string
 #include <typeinfo>                   // for typeid
@@ -44,9 +50,12 @@
 class Gnss_Synchro;
 class hybrid_observables_gs;
 
-template <class T>
+template <class T, class Alloc>
 class Gnss_circular_deque;
 
+template <class T>
+class Placement_Allocator;
+
 using hybrid_observables_gs_sptr = gnss_shared_ptr<hybrid_observables_gs>;
 
 hybrid_observables_gs_sptr hybrid_observables_gs_make(const Obs_Conf& conf_);
@@ -70,46 +79,46 @@ private:
     const size_t d_double_type_hash_code = typeid(double).hash_code();
 
     void msg_handler_pvt_to_observables(const pmt::pmt_t& msg);
+    void apply_rx_clock_offset(double new_rx_clock_offset_s);
     double compute_T_rx_s(const Gnss_Synchro& a) const;
-    bool interp_trk_obs(Gnss_Synchro& interpolated_obs, uint32_t ch, uint64_t rx_clock) const;
+    bool interp_trk_obs(Gnss_Synchro& interpolated_obs, uint32_t ch, uint64_t rx_clock);
     void update_TOW(const std::vector<Gnss_Synchro>& data);
     void compute_pranges(std::vector<Gnss_Synchro>& data) const;
-    void smooth_pseudoranges(std::vector<Gnss_Synchro>& data);
     int32_t save_matfile() const;
 
     Obs_Conf d_conf;
 
-    enum StringValue_
-    {
-        evGPS_1C,
-        evGPS_2S,
-        evGPS_L5,
-        evSBAS_1C,
-        evGAL_1B,
-        evGAL_5X,
-        evGAL_E6,
-        evGAL_7X,
-        evGLO_1G,
-        evGLO_2G,
-        evBDS_B1,
-        evBDS_B2,
-        evBDS_B3
-    };
-    std::map<std::string, StringValue_> d_mapStringValues;
-
-    std::unique_ptr<Gnss_circular_deque<Gnss_Synchro>> d_gnss_synchro_history;  // Tracking observable history
+    Work_Monitor d_work_monitor;
+
+    Carrier_Smoother d_carrier_smoother;
+
+    std::unique_ptr<Gnss_circular_deque<Gnss_Synchro, Placement_Allocator<Gnss_Synchro>>> d_gnss_synchro_history;  // Tracking observable history
 
     boost::circular_buffer<uint64_t> d_Rx_clock_buffer;  // time history
 
-    std::vector<bool> d_channel_last_pll_lock;
-    std::vector<double> d_channel_last_pseudorange_smooth;
-    std::vector<double> d_channel_last_carrier_phase_rads;
+    // Receiver clock corrections from PVT are handed over through a wait-free
+    // ring, so the message handler never contends with general_work() for the
+    // block lock
+    Gnss_spsc_ring<double> d_pvt_clock_offset_ring;
+
+    // Per-channel cursor into the synchro history where the last bracketing
+    // search ended. The rx clock advances monotonically, so the next search
+    // resumes there instead of re-scanning the whole history
+    std::vector<uint32_t> d_channel_history_cursor;
 
     std::string d_dump_filename;
 
     std::ofstream d_dump_file;
 
-    double d_smooth_filter_M;
+    // delta + varint encoded dump, used instead of d_dump_file when
+    // Observables.dump_delta is set
+    Delta_Obs_Writer d_delta_dump;
+
+    // created when Observables.epoch_sink_address is set; publishes one
+    // sequence-numbered datagram per epoch for multi-node aggregation
+    std::unique_ptr<Obs_Epoch_Sink> d_epoch_sink;
+    std::unique_ptr<Obs_Integrity_Monitor> d_integrity_monitor;
+    std::unique_ptr<Cycle_Slip_Detector> d_cycle_slip_detector;
 
     uint32_t d_T_rx_TOW_ms;
     uint32_t d_T_rx_step_ms;
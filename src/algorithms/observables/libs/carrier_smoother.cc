@@ -0,0 +1,150 @@
+/*!
+ * \file carrier_smoother.cc
+ * \brief Carrier smoothing engine for pseudorange observables
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "carrier_smoother.h"
+#include "MATH_CONSTANTS.h"  // for SPEED_OF_LIGHT_M_S, TWO_PI
+#include "gnss_frequencies.h"
+
+
+void Carrier_Smoother::init(uint32_t nchannels, double smoothing_factor, double epoch_interval_s, bool doppler_aided)
+{
+    d_nchannels = nchannels;
+    d_smooth_filter_M = smoothing_factor;
+    d_epoch_interval_s = epoch_interval_s;
+    d_doppler_aided = doppler_aided;
+
+    d_last_pseudorange_smooth = std::vector<double>(nchannels, 0.0);
+    d_last_carrier_phase_rads = std::vector<double>(nchannels, 0.0);
+    d_last_doppler_hz = std::vector<double>(nchannels, 0.0);
+    d_wavelength_m = std::vector<double>(nchannels, 0.0);
+    d_last_lock = std::vector<uint8_t>(nchannels, 0);
+
+    d_epoch_pseudorange = std::vector<double>(nchannels, 0.0);
+    d_epoch_carrier_advance_rads = std::vector<double>(nchannels, 0.0);
+    d_epoch_valid = std::vector<uint8_t>(nchannels, 0);
+
+    d_mapStringValues["1C"] = evGPS_1C;
+    d_mapStringValues["2S"] = evGPS_2S;
+    d_mapStringValues["L5"] = evGPS_L5;
+    d_mapStringValues["1B"] = evGAL_1B;
+    d_mapStringValues["5X"] = evGAL_5X;
+    d_mapStringValues["E6"] = evGAL_E6;
+    d_mapStringValues["7X"] = evGAL_7X;
+    d_mapStringValues["1G"] = evGLO_1G;
+    d_mapStringValues["2G"] = evGLO_2G;
+    d_mapStringValues["B1"] = evBDS_B1;
+    d_mapStringValues["B2"] = evBDS_B2;
+    d_mapStringValues["B3"] = evBDS_B3;
+}
+
+
+double Carrier_Smoother::get_wavelength_m(const Gnss_Synchro& obs)
+{
+    switch (d_mapStringValues[obs.Signal])
+        {
+        case evGPS_1C:
+        case evSBAS_1C:
+        case evGAL_1B:
+            return SPEED_OF_LIGHT_M_S / FREQ1;
+        case evGPS_L5:
+        case evGAL_5X:
+            return SPEED_OF_LIGHT_M_S / FREQ5;
+        case evGAL_E6:
+            return SPEED_OF_LIGHT_M_S / FREQ6;
+        case evGAL_7X:
+            return SPEED_OF_LIGHT_M_S / FREQ7;
+        case evGPS_2S:
+            return SPEED_OF_LIGHT_M_S / FREQ2;
+        case evBDS_B3:
+            return SPEED_OF_LIGHT_M_S / FREQ3_BDS;
+        case evGLO_1G:
+            return SPEED_OF_LIGHT_M_S / FREQ1_GLO;
+        case evGLO_2G:
+            return SPEED_OF_LIGHT_M_S / FREQ2_GLO;
+        case evBDS_B1:
+            return SPEED_OF_LIGHT_M_S / FREQ1_BDS;
+        case evBDS_B2:
+            return SPEED_OF_LIGHT_M_S / FREQ2_BDS;
+        default:
+            return 0.0;
+        }
+}
+
+
+void Carrier_Smoother::smooth(std::vector<Gnss_Synchro>& epoch_data)
+{
+    // 1. Gather the epoch into the contiguous state arrays. The carrier
+    //    advance since the previous epoch comes from the accumulated phase or,
+    //    in Doppler-aided mode, from the trapezoidal integral of the Doppler
+    //    shift over the epoch interval (both share the carrier NCO sign
+    //    convention). The last_* arrays are advanced here because the batch
+    //    update below only reads the gathered values.
+    for (const auto& obs : epoch_data)
+        {
+            const uint32_t ch = obs.Channel_ID;
+            if (ch >= d_nchannels)
+                {
+                    continue;
+                }
+            if (obs.Flag_valid_pseudorange)
+                {
+                    d_epoch_pseudorange[ch] = obs.Pseudorange_m;
+                    if (d_doppler_aided)
+                        {
+                            d_epoch_carrier_advance_rads[ch] = TWO_PI * 0.5 * (obs.Carrier_Doppler_hz + d_last_doppler_hz[ch]) * d_epoch_interval_s;
+                        }
+                    else
+                        {
+                            d_epoch_carrier_advance_rads[ch] = obs.Carrier_phase_rads - d_last_carrier_phase_rads[ch];
+                        }
+                    d_wavelength_m[ch] = get_wavelength_m(obs);
+                    d_last_carrier_phase_rads[ch] = obs.Carrier_phase_rads;
+                    d_last_doppler_hz[ch] = obs.Carrier_Doppler_hz;
+                    d_epoch_valid[ch] = 1;
+                }
+            else
+                {
+                    d_epoch_valid[ch] = 0;
+                }
+        }
+
+    // 2. Hatch filter update over the whole bank in one arithmetic pass
+    //    (https://insidegnss.com/can-you-list-all-the-properties-of-the-carrier-smoothing-filter/).
+    //    Channels without a previous lock pass their raw pseudorange through
+    const double factor = (d_smooth_filter_M - 1.0) / d_smooth_filter_M;
+    for (uint32_t ch = 0; ch < d_nchannels; ch++)
+        {
+            const double apply = (d_epoch_valid[ch] != 0 and d_last_lock[ch] != 0) ? 1.0 : 0.0;
+            const double pr = d_epoch_pseudorange[ch];
+            d_epoch_pseudorange[ch] = pr + apply * (factor * (d_last_pseudorange_smooth[ch] - pr) + d_wavelength_m[ch] * (factor / TWO_PI) * d_epoch_carrier_advance_rads[ch]);
+        }
+
+    // 3. Scatter the smoothed pseudoranges back and refresh the lock states
+    for (auto& obs : epoch_data)
+        {
+            const uint32_t ch = obs.Channel_ID;
+            if (ch >= d_nchannels)
+                {
+                    continue;
+                }
+            if (d_epoch_valid[ch] != 0)
+                {
+                    obs.Pseudorange_m = d_epoch_pseudorange[ch];
+                    d_last_pseudorange_smooth[ch] = d_epoch_pseudorange[ch];
+                }
+            d_last_lock[ch] = d_epoch_valid[ch];
+        }
+}
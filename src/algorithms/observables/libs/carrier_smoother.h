@@ -0,0 +1,96 @@
+/*!
+ * \file carrier_smoother.h
+ * \brief Carrier smoothing engine for pseudorange observables
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CARRIER_SMOOTHER_H
+#define GNSS_SDR_CARRIER_SMOOTHER_H
+
+#include "gnss_synchro.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/** \addtogroup Observables
+ * \{ */
+/** \addtogroup Observables_libs observables_libs
+ * \{ */
+
+
+/*!
+ * \brief Hatch-filter pseudorange smoother for a whole channel bank.
+ *
+ * The filter state of all channels lives in contiguous per-field arrays, so
+ * one epoch is smoothed in a single pass over the bank: the observables are
+ * gathered into the state arrays, the update runs as a tight arithmetic loop
+ * the compiler can vectorize, and the smoothed pseudoranges are scattered
+ * back. The carrier advance driving the filter comes either from the
+ * accumulated carrier phase (default) or, when Doppler aiding is selected,
+ * from the integrated Doppler shift, which is immune to half-cycle phase
+ * jumps at the cost of slightly noisier aiding.
+ */
+class Carrier_Smoother
+{
+public:
+    Carrier_Smoother() = default;
+
+    //! Sizes the state arrays and sets the filter parameters. epoch_interval_s is only used by the Doppler-aided mode
+    void init(uint32_t nchannels, double smoothing_factor, double epoch_interval_s, bool doppler_aided);
+
+    //! Smooths the valid pseudoranges of one epoch in place and updates the filter bank state
+    void smooth(std::vector<Gnss_Synchro>& epoch_data);
+
+private:
+    double get_wavelength_m(const Gnss_Synchro& obs);
+
+    enum StringValue_
+    {
+        evGPS_1C,
+        evGPS_2S,
+        evGPS_L5,
+        evSBAS_1C,
+        evGAL_1B,
+        evGAL_5X,
+        evGAL_E6,
+        evGAL_7X,
+        evGLO_1G,
+        evGLO_2G,
+        evBDS_B1,
+        evBDS_B2,
+        evBDS_B3
+    };
+    std::map<std::string, StringValue_> d_mapStringValues;
+
+    // Filter bank state, one contiguous array per field, indexed by channel
+    std::vector<double> d_last_pseudorange_smooth;
+    std::vector<double> d_last_carrier_phase_rads;
+    std::vector<double> d_last_doppler_hz;
+    std::vector<double> d_wavelength_m;
+    std::vector<uint8_t> d_last_lock;
+
+    // Per-epoch gather buffers, refilled on each call to smooth()
+    std::vector<double> d_epoch_pseudorange;
+    std::vector<double> d_epoch_carrier_advance_rads;
+    std::vector<uint8_t> d_epoch_valid;
+
+    double d_smooth_filter_M{0.0};
+    double d_epoch_interval_s{0.0};
+    uint32_t d_nchannels{0};
+    bool d_doppler_aided{false};
+};
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CARRIER_SMOOTHER_H
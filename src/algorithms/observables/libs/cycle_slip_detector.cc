@@ -0,0 +1,235 @@
+/*!
+ * \file cycle_slip_detector.cc
+ * \brief Implementation of a carrier-phase cycle-slip detector running at
+ * the observables stage
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "cycle_slip_detector.h"
+#include "MATH_CONSTANTS.h"
+#include "gnss_frequencies.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace
+{
+// largest epoch gap over which the incremental tests remain valid [s]
+const double max_gap_s = 1.0;
+// exponential factor of the Melbourne-Wübbena running statistics
+const double mw_alpha = 0.02;
+// Melbourne-Wübbena sigma floor, in wide-lane cycles
+const double mw_sigma_floor_cycles = 0.25;
+// epochs of statistics before the Melbourne-Wübbena test fires
+const int mw_warmup_epochs = 20;
+}  // namespace
+
+
+Cycle_Slip_Detector::Cycle_Slip_Detector(double phase_threshold_cycles, double gf_threshold_m, double mw_sigma)
+    : d_phase_threshold_cycles(phase_threshold_cycles),
+      d_gf_threshold_m(gf_threshold_m),
+      d_mw_sigma(mw_sigma)
+{
+}
+
+
+uint64_t Cycle_Slip_Detector::slips_detected() const
+{
+    return d_slips_detected;
+}
+
+
+double Cycle_Slip_Detector::carrier_frequency_hz(const Gnss_Synchro& obs)
+{
+    const std::string sig(obs.Signal, 2);
+    switch (obs.System)
+        {
+        case 'G':
+            if (sig == "2S")
+                {
+                    return FREQ2;
+                }
+            if (sig == "L5")
+                {
+                    return FREQ5;
+                }
+            return FREQ1;
+        case 'E':
+            if (sig == "5X")
+                {
+                    return FREQ5;
+                }
+            if (sig == "7X")
+                {
+                    return FREQ7;
+                }
+            if (sig == "E6")
+                {
+                    return FREQ6;
+                }
+            return FREQ1;
+        case 'R':
+            if (sig == "2G")
+                {
+                    return FREQ2_GLO;
+                }
+            return FREQ1_GLO;
+        case 'C':
+            if (sig == "B3")
+                {
+                    return FREQ3_BDS;
+                }
+            return FREQ1_BDS;
+        default:
+            return FREQ1;
+        }
+}
+
+
+int Cycle_Slip_Detector::check_epoch(std::vector<Gnss_Synchro>& epoch_data)
+{
+    if (d_channels.size() < epoch_data.size())
+        {
+            d_channels.resize(epoch_data.size());
+        }
+    int slips = 0;
+    d_primary_channel.clear();
+
+    // ******** single-frequency test and satellite pairing ********
+    for (size_t ch = 0; ch < epoch_data.size(); ch++)
+        {
+            Gnss_Synchro& obs = epoch_data[ch];
+            Channel_State& state = d_channels[ch];
+            obs.Flag_cycle_slip = false;
+            if (!obs.Flag_valid_pseudorange)
+                {
+                    state.has_previous = false;
+                    continue;
+                }
+            if (state.prev_prn != obs.PRN)
+                {
+                    state = Channel_State();
+                    state.prev_prn = obs.PRN;
+                }
+            const double phase_cycles = obs.Carrier_phase_rads / TWO_PI;
+            const double dt_s = obs.RX_time - state.prev_rx_time;
+            if (state.has_previous and dt_s > 0.0 and dt_s <= max_gap_s)
+                {
+                    // the accumulated carrier phase decreases with positive
+                    // Doppler (same convention as the pseudorange rate), so
+                    // the Doppler-propagated prediction uses a negative sign
+                    const double predicted_delta_cycles = -0.5 * (obs.Carrier_Doppler_hz + state.prev_doppler_hz) * dt_s;
+                    const double residual_cycles = (phase_cycles - state.prev_phase_cycles) - predicted_delta_cycles;
+                    if (std::fabs(residual_cycles) > d_phase_threshold_cycles)
+                        {
+                            obs.Flag_cycle_slip = true;
+                        }
+                }
+            state.prev_rx_time = obs.RX_time;
+            state.prev_phase_cycles = phase_cycles;
+            state.prev_doppler_hz = obs.Carrier_Doppler_hz;
+            state.has_previous = true;
+
+            // remember the first band of each satellite for the
+            // dual-frequency combinations below
+            const int sat_key = (static_cast<int>(obs.System) << 16) | static_cast<int>(obs.PRN);
+            const auto primary = d_primary_channel.find(sat_key);
+            if (primary == d_primary_channel.end())
+                {
+                    d_primary_channel[sat_key] = static_cast<int>(ch);
+                    continue;
+                }
+
+            // ******** dual-frequency combinations, O(1) per satellite ********
+            Gnss_Synchro& obs1 = epoch_data[primary->second];
+            Gnss_Synchro& obs2 = obs;
+            const double f1 = carrier_frequency_hz(obs1);
+            const double f2 = carrier_frequency_hz(obs2);
+            if (f1 == f2)
+                {
+                    continue;  // same band twice, no combination available
+                }
+            const double lambda1 = SPEED_OF_LIGHT_M_S / f1;
+            const double lambda2 = SPEED_OF_LIGHT_M_S / f2;
+            const double phi1 = obs1.Carrier_phase_rads / TWO_PI;
+            const double phi2 = obs2.Carrier_phase_rads / TWO_PI;
+            // geometry-free: geometry, clocks and troposphere cancel
+            const double gf_m = lambda1 * phi1 - lambda2 * phi2;
+            // Melbourne-Wübbena: wide-lane phase minus narrow-lane code
+            const double lambda_wl = SPEED_OF_LIGHT_M_S / (f1 - f2);
+            const double mw_cycles = (phi1 - phi2) -
+                                     (f1 * obs1.Pseudorange_m + f2 * obs2.Pseudorange_m) / ((f1 + f2) * lambda_wl);
+            Sat_State& sat = d_satellites[sat_key];
+            const double sat_dt_s = obs.RX_time - sat.prev_rx_time;
+            bool slip_found = false;
+            if (sat.epochs > 0 and sat_dt_s > 0.0 and sat_dt_s <= max_gap_s)
+                {
+                    if (std::fabs(gf_m - sat.prev_gf_m) > d_gf_threshold_m)
+                        {
+                            slip_found = true;
+                            DLOG(INFO) << "Cycle slip: geometry-free step of " << (gf_m - sat.prev_gf_m)
+                                       << " m on " << obs.System << " PRN " << obs.PRN << " at RX time " << obs.RX_time;
+                        }
+                    const double mw_sigma_cycles = std::max(std::sqrt(sat.mw_var_cycles2), mw_sigma_floor_cycles);
+                    const double mw_dev_cycles = mw_cycles - sat.mw_mean_cycles;
+                    if (sat.epochs >= mw_warmup_epochs and std::fabs(mw_dev_cycles) > d_mw_sigma * mw_sigma_cycles)
+                        {
+                            slip_found = true;
+                            DLOG(INFO) << "Cycle slip: Melbourne-Wubbena jump of " << mw_dev_cycles
+                                       << " wide-lane cycles on " << obs.System << " PRN " << obs.PRN
+                                       << " at RX time " << obs.RX_time;
+                        }
+                }
+            if (slip_found)
+                {
+                    // the combinations cannot attribute the slip to one band
+                    obs1.Flag_cycle_slip = true;
+                    obs2.Flag_cycle_slip = true;
+                    // restart the running statistics from the post-slip level
+                    sat.mw_mean_cycles = mw_cycles;
+                    sat.mw_var_cycles2 = 0.0;
+                    sat.epochs = 0;
+                }
+            else if (sat.epochs == 0)
+                {
+                    sat.mw_mean_cycles = mw_cycles;
+                    sat.mw_var_cycles2 = 0.0;
+                }
+            else
+                {
+                    const double mw_dev_cycles = mw_cycles - sat.mw_mean_cycles;
+                    sat.mw_mean_cycles += mw_alpha * mw_dev_cycles;
+                    sat.mw_var_cycles2 = (1.0 - mw_alpha) * sat.mw_var_cycles2 + mw_alpha * mw_dev_cycles * mw_dev_cycles;
+                }
+            sat.prev_gf_m = gf_m;
+            sat.prev_rx_time = obs.RX_time;
+            sat.epochs++;
+        }
+
+    // count and report once per epoch
+    for (const auto& obs : epoch_data)
+        {
+            if (obs.Flag_valid_pseudorange and obs.Flag_cycle_slip)
+                {
+                    slips++;
+                }
+        }
+    if (slips > 0)
+        {
+            d_slips_detected += slips;
+            LOG(INFO) << "Cycle-slip detector flagged " << slips << " observable(s) at RX time "
+                      << epoch_data[0].RX_time;
+        }
+    return slips;
+}
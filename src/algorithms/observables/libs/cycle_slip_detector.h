@@ -0,0 +1,102 @@
+/*!
+ * \file cycle_slip_detector.h
+ * \brief Interface of a carrier-phase cycle-slip detector running at the
+ * observables stage, with incremental geometry-free and Melbourne-Wübbena
+ * combinations
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CYCLE_SLIP_DETECTOR_H
+#define GNSS_SDR_CYCLE_SLIP_DETECTOR_H
+
+#include "gnss_synchro.h"
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/** \addtogroup Observables
+ * \{ */
+/** \addtogroup Observables_libs observables_libs
+ * \{ */
+
+/*!
+ * \brief Detects carrier-phase cycle slips one epoch after they happen,
+ * before the observables reach the PVT solver.
+ *
+ * Two complementary tests run with O(1) incremental updates per satellite
+ * and epoch:
+ *
+ *  - Single-frequency: the carrier phase is propagated with the average
+ *    Doppler over the epoch gap; a residual beyond the threshold that the
+ *    Doppler cannot explain is a slip on that channel.
+ *  - Dual-frequency (when the same satellite is tracked on two bands): the
+ *    geometry-free combination cancels geometry, clock and troposphere,
+ *    leaving the slowly drifting ionosphere, so a step flags a slip; the
+ *    Melbourne-Wübbena combination adds code observations and catches the
+ *    slips that are (near) proportional between bands and therefore
+ *    invisible to the geometry-free test. Both keep one running state per
+ *    satellite, no history buffers.
+ *
+ * Flagged observables get Gnss_Synchro::Flag_cycle_slip set, which the
+ * RTKLIB bridge translates into a loss-of-lock indicator so the solver
+ * resets the affected ambiguity immediately instead of burning filter
+ * iterations on a corrupted one. The flag also reaches the channel status
+ * monitor with the rest of the epoch.
+ */
+class Cycle_Slip_Detector
+{
+public:
+    Cycle_Slip_Detector(double phase_threshold_cycles, double gf_threshold_m, double mw_sigma);
+
+    //! Screen one epoch, setting Flag_cycle_slip on the affected
+    //! observables. Returns the number of slips flagged
+    int check_epoch(std::vector<Gnss_Synchro>& epoch_data);
+
+    uint64_t slips_detected() const;
+
+private:
+    // single-frequency propagation state, one per channel
+    struct Channel_State
+    {
+        double prev_rx_time = 0.0;
+        double prev_phase_cycles = 0.0;
+        double prev_doppler_hz = 0.0;
+        uint32_t prev_prn = 0;
+        bool has_previous = false;
+    };
+
+    // dual-frequency combination state, one per satellite
+    struct Sat_State
+    {
+        double prev_rx_time = 0.0;
+        double prev_gf_m = 0.0;
+        double mw_mean_cycles = 0.0;
+        double mw_var_cycles2 = 0.0;
+        int epochs = 0;
+    };
+
+    static double carrier_frequency_hz(const Gnss_Synchro& obs);
+
+    std::vector<Channel_State> d_channels;
+    std::map<int, Sat_State> d_satellites;  // keyed by (System << 16) | PRN
+    std::map<int, int> d_primary_channel;   // scratch: satellite -> first band channel
+    uint64_t d_slips_detected = 0;
+    double d_phase_threshold_cycles = 0.8;
+    double d_gf_threshold_m = 0.05;
+    double d_mw_sigma = 4.0;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CYCLE_SLIP_DETECTOR_H
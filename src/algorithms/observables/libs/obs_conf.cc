@@ -25,6 +25,27 @@ Obs_Conf::Obs_Conf()
     nchannels_in = 0;
     nchannels_out = 0;
     enable_carrier_smoothing = false;
+    enable_doppler_smoothing = false;
     dump = false;
     dump_mat = false;
+    dump_delta = false;
+    enable_work_monitor = false;
+    work_monitor_addresses = "127.0.0.1";
+    work_monitor_port = 1237;
+    work_monitor_interval_calls = 1000;
+    history_use_hugepages = false;
+    history_first_touch_core = -1;
+    epoch_sink_address = "";
+    epoch_sink_port = 1263;
+    epoch_sink_receiver_id = 0;
+    enable_integrity_monitor = false;
+    integrity_monitor_address = "127.0.0.1";
+    integrity_monitor_port = 1264;
+    integrity_innovation_sigma = 6.0;
+    integrity_clock_jump_m = 15.0;
+    integrity_cn0_step_db = 5.0;
+    enable_cycle_slip_detector = false;
+    slip_phase_threshold_cycles = 0.8;
+    slip_gf_threshold_m = 0.05;
+    slip_mw_sigma = 4.0;
 }
@@ -33,12 +33,33 @@ public:
     Obs_Conf();
 
     std::string dump_filename;
+    std::string work_monitor_addresses;
     int32_t smoothing_factor;
     uint32_t nchannels_in;
     uint32_t nchannels_out;
     bool enable_carrier_smoothing;
+    bool enable_doppler_smoothing;
     bool dump;
     bool dump_mat;
+    bool dump_delta;
+    bool enable_work_monitor;
+    uint16_t work_monitor_port;
+    uint32_t work_monitor_interval_calls;
+    bool history_use_hugepages;
+    int32_t history_first_touch_core;
+    std::string epoch_sink_address;
+    uint16_t epoch_sink_port;
+    uint16_t epoch_sink_receiver_id;
+    std::string integrity_monitor_address;
+    uint16_t integrity_monitor_port;
+    float integrity_innovation_sigma;
+    float integrity_clock_jump_m;
+    float integrity_cn0_step_db;
+    bool enable_integrity_monitor;
+    float slip_phase_threshold_cycles;
+    float slip_gf_threshold_m;
+    float slip_mw_sigma;
+    bool enable_cycle_slip_detector;
 };
 
 /** \} */
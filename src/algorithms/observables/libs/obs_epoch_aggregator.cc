@@ -0,0 +1,127 @@
+/*!
+ * \file obs_epoch_aggregator.cc
+ * \brief Time-aligns observables epoch streams from N receivers.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "obs_epoch_aggregator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+Obs_Epoch_Aggregator::Obs_Epoch_Aggregator(uint32_t num_receivers, double tolerance_s, size_t max_pending)
+    : d_lost_datagrams(0),
+      d_tolerance_s(tolerance_s),
+      d_max_pending(max_pending),
+      d_num_receivers(num_receivers)
+{
+}
+
+
+bool Obs_Epoch_Aggregator::parse_datagram(const char* data, size_t size, Obs_Epoch& epoch)
+{
+    if (size < sizeof(Obs_Epoch_Header))
+        {
+            return false;
+        }
+    std::memcpy(&epoch.header, data, sizeof(Obs_Epoch_Header));
+    if (epoch.header.magic != 0x474F4245 or epoch.header.version != 1)
+        {
+            return false;
+        }
+    const size_t expected = sizeof(Obs_Epoch_Header) + static_cast<size_t>(epoch.header.num_obs) * sizeof(Obs_Epoch_Entry);
+    if (size < expected)
+        {
+            return false;
+        }
+    epoch.entries.resize(epoch.header.num_obs);
+    if (epoch.header.num_obs > 0)
+        {
+            std::memcpy(epoch.entries.data(), data + sizeof(Obs_Epoch_Header), epoch.entries.size() * sizeof(Obs_Epoch_Entry));
+        }
+    return true;
+}
+
+
+void Obs_Epoch_Aggregator::push(const Obs_Epoch& epoch)
+{
+    const uint16_t receiver = epoch.header.receiver_id;
+    const auto last = d_last_sequence.find(receiver);
+    if (last != d_last_sequence.end() and epoch.header.sequence > last->second + 1)
+        {
+            d_lost_datagrams += epoch.header.sequence - last->second - 1;
+        }
+    d_last_sequence[receiver] = epoch.header.sequence;
+    d_pending[receiver].push_back(epoch);
+}
+
+
+bool Obs_Epoch_Aggregator::get_aligned(std::vector<Obs_Epoch>& aligned)
+{
+    if (d_pending.empty())
+        {
+            return false;
+        }
+
+    // The alignment reference is the oldest epoch still pending
+    double reference = 0.0;
+    bool have_reference = false;
+    size_t deepest_queue = 0;
+    for (const auto& stream : d_pending)
+        {
+            deepest_queue = std::max(deepest_queue, stream.second.size());
+            if (!stream.second.empty() and (!have_reference or stream.second.front().header.rx_time < reference))
+                {
+                    reference = stream.second.front().header.rx_time;
+                    have_reference = true;
+                }
+        }
+    if (!have_reference)
+        {
+            return false;
+        }
+
+    uint32_t contributors = 0;
+    for (const auto& stream : d_pending)
+        {
+            if (!stream.second.empty() and std::fabs(stream.second.front().header.rx_time - reference) <= d_tolerance_s)
+                {
+                    contributors++;
+                }
+        }
+
+    // Wait for the missing receivers unless a queue is already so deep
+    // that waiting longer would only add latency
+    if (contributors < d_num_receivers and deepest_queue <= d_max_pending)
+        {
+            return false;
+        }
+
+    aligned.clear();
+    for (auto& stream : d_pending)
+        {
+            if (!stream.second.empty() and std::fabs(stream.second.front().header.rx_time - reference) <= d_tolerance_s)
+                {
+                    aligned.push_back(stream.second.front());
+                    stream.second.pop_front();
+                }
+        }
+    return !aligned.empty();
+}
+
+
+uint64_t Obs_Epoch_Aggregator::lost_datagrams() const
+{
+    return d_lost_datagrams;
+}
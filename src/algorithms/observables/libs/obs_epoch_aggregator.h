@@ -0,0 +1,95 @@
+/*!
+ * \file obs_epoch_aggregator.h
+ * \brief Time-aligns observables epoch streams from N receivers.
+ *
+ * Counterpart of Obs_Epoch_Sink for network-RTK base clusters: parses
+ * the epoch datagrams published by each receiver and groups, across
+ * receivers, the epochs that fall within a configurable time tolerance,
+ * so downstream processing gets complete epoch-aligned sets directly
+ * instead of re-aligning the streams in an external script pipeline.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_OBS_EPOCH_AGGREGATOR_H
+#define GNSS_SDR_OBS_EPOCH_AGGREGATOR_H
+
+#include "obs_epoch_sink.h"  // for Obs_Epoch_Header / Obs_Epoch_Entry
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+/** \addtogroup Observables
+ * \{ */
+/** \addtogroup Observables_libs observables_libs
+ * \{ */
+
+
+/*!
+ * \brief One parsed epoch datagram.
+ */
+struct Obs_Epoch
+{
+    Obs_Epoch_Header header;
+    std::vector<Obs_Epoch_Entry> entries;
+};
+
+/*!
+ * \brief Groups the epoch streams of N receivers into time-aligned sets.
+ *
+ * Epochs are pushed as they arrive, in any receiver order. An aligned
+ * set is emitted as soon as every expected receiver has contributed an
+ * epoch within the alignment tolerance of the oldest pending one; if a
+ * receiver stalls, the set is emitted incomplete once the pending
+ * queues exceed the configured depth, so one dead station does not
+ * stop the cluster.
+ */
+class Obs_Epoch_Aggregator
+{
+public:
+    /*!
+     * \param num_receivers expected stations in the cluster
+     * \param tolerance_s   maximum RX time distance inside one aligned set [s]
+     * \param max_pending   queued epochs per receiver before an incomplete set is forced out
+     */
+    Obs_Epoch_Aggregator(uint32_t num_receivers, double tolerance_s, size_t max_pending = 16);
+
+    //! Parses one datagram. Returns false if it is malformed or truncated
+    static bool parse_datagram(const char* data, size_t size, Obs_Epoch& epoch);
+
+    //! Feeds one epoch. Sequence gaps per receiver are counted as losses
+    void push(const Obs_Epoch& epoch);
+
+    /*!
+     * \brief Retrieves the next time-aligned set, one epoch per
+     * contributing receiver. Returns false if no set is ready yet.
+     */
+    bool get_aligned(std::vector<Obs_Epoch>& aligned);
+
+    //! Datagrams lost so far, from the per-receiver sequence numbers
+    uint64_t lost_datagrams() const;
+
+private:
+    std::map<uint16_t, std::deque<Obs_Epoch>> d_pending;
+    std::map<uint16_t, uint32_t> d_last_sequence;
+    uint64_t d_lost_datagrams;
+    double d_tolerance_s;
+    size_t d_max_pending;
+    uint32_t d_num_receivers;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_OBS_EPOCH_AGGREGATOR_H
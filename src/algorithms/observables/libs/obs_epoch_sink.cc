@@ -0,0 +1,112 @@
+/*!
+ * \file obs_epoch_sink.cc
+ * \brief Publishes epoch-aligned observable sets over UDP for multi-node
+ * aggregation.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "obs_epoch_sink.h"
+#include "MATH_CONSTANTS.h"
+#include <glog/logging.h>
+#include <chrono>
+#include <cstring>
+#include <type_traits>
+
+static_assert(std::is_standard_layout<Obs_Epoch_Header>::value,
+    "Obs_Epoch_Header must be standard-layout, it is sent as raw bytes");
+static_assert(std::is_standard_layout<Obs_Epoch_Entry>::value,
+    "Obs_Epoch_Entry must be standard-layout, it is sent as raw bytes");
+
+
+Obs_Epoch_Sink::Obs_Epoch_Sink(const std::string& address, const uint16_t& port, uint16_t receiver_id_)
+    : socket{io_context},
+      sequence(0),
+      receiver_id(receiver_id_)
+{
+    boost::system::error_code ec;
+    endpoint = boost::asio::ip::udp::endpoint(boost::asio::ip::address::from_string(address, ec), port);
+    if (ec)
+        {
+            LOG(WARNING) << "Invalid observables epoch sink address " << address << ": " << ec.message();
+            return;
+        }
+    socket.open(endpoint.protocol(), ec);
+    if (ec)
+        {
+            LOG(WARNING) << "Could not open observables epoch sink socket: " << ec.message();
+            return;
+        }
+    LOG(INFO) << "Observables epochs will be published to " << address << ":" << port
+              << " as receiver " << receiver_id;
+}
+
+
+bool Obs_Epoch_Sink::write_epoch(const std::vector<Gnss_Synchro>& epoch_data)
+{
+    if (!socket.is_open())
+        {
+            return false;
+        }
+
+    Obs_Epoch_Header header{};
+    header.magic = 0x474F4245;  // "GOBE"
+    header.version = 1;
+    header.receiver_id = receiver_id;
+    header.sequence = sequence++;
+    header.nchannels = static_cast<uint16_t>(epoch_data.size());
+    header.host_time_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+
+    std::vector<Obs_Epoch_Entry> entries;
+    entries.reserve(epoch_data.size());
+    for (const auto& obs : epoch_data)
+        {
+            if (!obs.Flag_valid_pseudorange)
+                {
+                    continue;
+                }
+            Obs_Epoch_Entry entry{};
+            entry.system = obs.System;
+            entry.signal[0] = obs.Signal[0];
+            entry.signal[1] = obs.Signal[1];
+            entry.valid_pseudorange = 1;
+            entry.prn = obs.PRN;
+            entry.channel_id = static_cast<uint32_t>(obs.Channel_ID);
+            entry.tow_ms = static_cast<uint32_t>(obs.interp_TOW_ms);
+            entry.pseudorange_m = obs.Pseudorange_m;
+            entry.carrier_phase_cycles = obs.Carrier_phase_rads / TWO_PI;
+            entry.carrier_doppler_hz = obs.Carrier_Doppler_hz;
+            entry.cn0_db_hz = obs.CN0_dB_hz;
+            header.rx_time = obs.RX_time;
+            entries.push_back(entry);
+        }
+    header.num_obs = static_cast<uint16_t>(entries.size());
+
+    outbound_data.resize(sizeof(Obs_Epoch_Header) + entries.size() * sizeof(Obs_Epoch_Entry));
+    std::memcpy(outbound_data.data(), &header, sizeof(Obs_Epoch_Header));
+    if (!entries.empty())
+        {
+            std::memcpy(outbound_data.data() + sizeof(Obs_Epoch_Header), entries.data(), entries.size() * sizeof(Obs_Epoch_Entry));
+        }
+
+    boost::system::error_code ec;
+    socket.send_to(boost::asio::buffer(outbound_data), endpoint, 0, ec);
+    if (ec)
+        {
+            LOG(WARNING) << "Problem publishing observables epoch: " << ec.message();
+            return false;
+        }
+    return true;
+}
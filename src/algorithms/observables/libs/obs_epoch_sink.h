@@ -0,0 +1,106 @@
+/*!
+ * \file obs_epoch_sink.h
+ * \brief Publishes epoch-aligned observable sets over UDP for multi-node
+ * aggregation.
+ *
+ * Reference-network deployments merge the observables of several
+ * receivers downstream for network-RTK processing. Instead of scraping
+ * the per-channel monitor feed, this sink publishes one binary datagram
+ * per observables epoch, carrying a per-receiver sequence number and a
+ * nanosecond host timestamp, so the aggregation side (see
+ * Obs_Epoch_Aggregator) can time-align the streams of N receivers
+ * without reconstructing the epochs itself.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_OBS_EPOCH_SINK_H
+#define GNSS_SDR_OBS_EPOCH_SINK_H
+
+#include "gnss_synchro.h"
+#include <boost/asio.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Observables
+ * \{ */
+/** \addtogroup Observables_libs observables_libs
+ * \{ */
+
+
+#if USE_BOOST_ASIO_IO_CONTEXT
+using b_io_context = boost::asio::io_context;
+#else
+using b_io_context = boost::asio::io_service;
+#endif
+
+/*!
+ * \brief Fixed header of an observables epoch datagram. Native byte
+ * order, followed by num_obs Obs_Epoch_Entry records.
+ */
+struct Obs_Epoch_Header
+{
+    uint32_t magic;    //!< "GOBE" = 0x474F4245
+    uint8_t version;   //!< format version, currently 1
+    uint8_t reserved;
+    uint16_t receiver_id;  //!< station identifier inside the cluster
+    uint32_t sequence;     //!< per-receiver datagram counter, detects losses
+    uint16_t num_obs;      //!< valid observables in this epoch
+    uint16_t nchannels;    //!< receiver channel count
+    double rx_time;        //!< receiver epoch time [s]
+    uint64_t host_time_ns;  //!< wall-clock capture time, nanoseconds since the UNIX epoch
+};
+
+/*!
+ * \brief One observable inside an epoch datagram. Native byte order.
+ */
+struct Obs_Epoch_Entry
+{
+    char system;
+    char signal[2];
+    uint8_t valid_pseudorange;
+    uint32_t prn;
+    uint32_t channel_id;
+    uint32_t tow_ms;
+    double pseudorange_m;
+    double carrier_phase_cycles;
+    double carrier_doppler_hz;
+    double cn0_db_hz;
+};
+
+/*!
+ * \brief Sends one UDP datagram per observables epoch, valid
+ * observables only. Empty epochs are published too, keeping the
+ * sequence numbers contiguous for loss detection.
+ */
+class Obs_Epoch_Sink
+{
+public:
+    Obs_Epoch_Sink(const std::string& address, const uint16_t& port, uint16_t receiver_id);
+
+    //! Publish one epoch. Returns false if the datagram could not be sent
+    bool write_epoch(const std::vector<Gnss_Synchro>& epoch_data);
+
+private:
+    b_io_context io_context;
+    boost::asio::ip::udp::socket socket;
+    boost::asio::ip::udp::endpoint endpoint;
+    std::vector<char> outbound_data;
+    uint32_t sequence;
+    uint16_t receiver_id;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_OBS_EPOCH_SINK_H
@@ -0,0 +1,301 @@
+/*!
+ * \file obs_integrity_monitor.cc
+ * \brief Implementation of the real-time integrity screening of the
+ * observables stream
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "obs_integrity_monitor.h"
+#include "MATH_CONSTANTS.h"
+#include "gnss_frequencies.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+// innovation statistics settle over this many epochs before tests fire
+const int warmup_epochs = 20;
+// exponential factors of the per-channel running statistics
+const float variance_alpha = 0.05F;
+const float cn0_alpha = 0.01F;
+// minimum residual sigma, so a quiet channel does not alarm on noise [m]
+const float sigma_floor_m = 0.5F;
+// epochs a reporter stays quiet after an event, bounding the event rate
+const int quiet_epochs_after_event = 50;
+// largest epoch gap over which the Doppler propagation is still meaningful [s]
+const double max_propagation_gap_s = 0.5;
+}  // namespace
+
+
+Obs_Integrity_Monitor::Obs_Integrity_Monitor(const std::string& address, uint16_t port,
+    float innovation_sigma, float clock_jump_m, float cn0_step_db)
+    : socket{io_context},
+      d_innovation_sigma(innovation_sigma),
+      d_clock_jump_m(clock_jump_m),
+      d_cn0_step_db(cn0_step_db)
+{
+    boost::system::error_code ec;
+    endpoint = boost::asio::ip::udp::endpoint(boost::asio::ip::address::from_string(address, ec), port);
+    if (ec)
+        {
+            LOG(WARNING) << "Invalid integrity monitor address " << address << ": " << ec.message();
+            return;
+        }
+    socket.open(endpoint.protocol(), ec);
+    if (ec)
+        {
+            LOG(WARNING) << "Could not open integrity monitor socket: " << ec.message();
+            return;
+        }
+    LOG(INFO) << "Observables integrity events will be published to " << address << ":" << port;
+}
+
+
+uint64_t Obs_Integrity_Monitor::events_raised() const
+{
+    return d_events_raised;
+}
+
+
+double Obs_Integrity_Monitor::carrier_frequency_hz(char system, const char signal[3])
+{
+    const std::string sig(signal, 2);
+    switch (system)
+        {
+        case 'G':
+            if (sig == "2S")
+                {
+                    return FREQ2;
+                }
+            if (sig == "L5")
+                {
+                    return FREQ5;
+                }
+            return FREQ1;
+        case 'E':
+            if (sig == "5X")
+                {
+                    return FREQ5;
+                }
+            if (sig == "7X")
+                {
+                    return FREQ7;
+                }
+            if (sig == "E6")
+                {
+                    return FREQ6;
+                }
+            return FREQ1;
+        case 'R':
+            if (sig == "2G")
+                {
+                    return FREQ2_GLO;
+                }
+            return FREQ1_GLO;
+        case 'C':
+            if (sig == "B3")
+                {
+                    return FREQ3_BDS;
+                }
+            return FREQ1_BDS;
+        default:
+            return FREQ1;
+        }
+}
+
+
+void Obs_Integrity_Monitor::publish_event(uint8_t event_type, const Gnss_Synchro& obs, uint16_t affected,
+    double metric, double threshold)
+{
+    d_events_raised++;
+    if (!socket.is_open())
+        {
+            return;
+        }
+    Obs_Integrity_Event event{};
+    event.magic = 0x47494556;  // "GIEV"
+    event.version = 1;
+    event.event_type = event_type;
+    event.affected_channels = affected;
+    event.channel_id = static_cast<uint32_t>(obs.Channel_ID);
+    event.prn = obs.PRN;
+    event.system = obs.System;
+    event.signal[0] = obs.Signal[0];
+    event.signal[1] = obs.Signal[1];
+    event.metric = metric;
+    event.threshold = threshold;
+    event.rx_time = obs.RX_time;
+    event.host_time_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+
+    boost::system::error_code ec;
+    socket.send_to(boost::asio::buffer(&event, sizeof(event)), endpoint, 0, ec);
+    if (ec)
+        {
+            LOG(WARNING) << "Problem publishing integrity event: " << ec.message();
+        }
+}
+
+
+int Obs_Integrity_Monitor::check_epoch(const std::vector<Gnss_Synchro>& epoch_data)
+{
+    if (d_channels.size() < epoch_data.size())
+        {
+            d_channels.resize(epoch_data.size());
+        }
+    int events = 0;
+    d_innovations_m.clear();
+    d_innovation_channel.clear();
+
+    // ******** pass 1: per-channel innovations and C/N0 statistics ********
+    int cn0_steps = 0;
+    int cn0_first_channel = -1;
+    float cn0_largest_step_db = 0.0F;
+    int active_channels = 0;
+    for (size_t ch = 0; ch < epoch_data.size(); ch++)
+        {
+            const Gnss_Synchro& obs = epoch_data[ch];
+            Channel_State& state = d_channels[ch];
+            if (!obs.Flag_valid_pseudorange)
+                {
+                    state.has_previous = false;
+                    state.epochs_tracked = 0;
+                    continue;
+                }
+            active_channels++;
+            if (state.quiet_epochs > 0)
+                {
+                    state.quiet_epochs--;
+                }
+            if (state.prev_prn != obs.PRN)
+                {
+                    // channel re-assigned: restart its statistics
+                    state = Channel_State();
+                    state.prev_prn = obs.PRN;
+                }
+            const double dt_s = obs.RX_time - state.prev_rx_time;
+            if (state.has_previous and dt_s > 0.0 and dt_s <= max_propagation_gap_s)
+                {
+                    // code-carrier consistency: propagate the previous
+                    // pseudorange with the average carrier Doppler
+                    const double lambda_m = SPEED_OF_LIGHT_M_S / carrier_frequency_hz(obs.System, obs.Signal);
+                    const double range_rate_m_s = -0.5 * (obs.Carrier_Doppler_hz + state.prev_doppler_hz) * lambda_m;
+                    const double predicted_m = state.prev_pseudorange_m + range_rate_m_s * dt_s;
+                    d_innovations_m.push_back(static_cast<float>(obs.Pseudorange_m - predicted_m));
+                    d_innovation_channel.push_back(static_cast<int>(ch));
+                }
+            // C/N0 baseline and step detection
+            if (state.epochs_tracked == 0)
+                {
+                    state.cn0_baseline_db_hz = static_cast<float>(obs.CN0_dB_hz);
+                }
+            const float cn0_dev_db = static_cast<float>(obs.CN0_dB_hz) - state.cn0_baseline_db_hz;
+            if (state.epochs_tracked >= warmup_epochs and std::fabs(cn0_dev_db) > d_cn0_step_db)
+                {
+                    cn0_steps++;
+                    if (cn0_first_channel < 0)
+                        {
+                            cn0_first_channel = static_cast<int>(ch);
+                        }
+                    if (std::fabs(cn0_dev_db) > std::fabs(cn0_largest_step_db))
+                        {
+                            cn0_largest_step_db = cn0_dev_db;
+                        }
+                }
+            state.cn0_baseline_db_hz += cn0_alpha * cn0_dev_db;
+            state.prev_rx_time = obs.RX_time;
+            state.prev_pseudorange_m = obs.Pseudorange_m;
+            state.prev_doppler_hz = obs.Carrier_Doppler_hz;
+            state.prev_prn = obs.PRN;
+            state.epochs_tracked++;
+            state.has_previous = true;
+        }
+
+    if (d_innovations_m.empty())
+        {
+            return events;
+        }
+
+    // ******** pass 2: common-mode term (receiver clock) ********
+    // the median innovation absorbs a receiver clock step, leaving the
+    // per-satellite residuals sensitive to single-signal anomalies only
+    std::vector<float> sorted = d_innovations_m;
+    const size_t mid = sorted.size() / 2;
+    std::nth_element(sorted.begin(), sorted.begin() + mid, sorted.end());
+    const float common_mode_m = sorted[mid];
+    if (d_clock_quiet_epochs > 0)
+        {
+            d_clock_quiet_epochs--;
+        }
+    if (d_innovations_m.size() >= 4 and std::fabs(common_mode_m) > d_clock_jump_m and d_clock_quiet_epochs == 0)
+        {
+            const Gnss_Synchro& obs = epoch_data[d_innovation_channel[0]];
+            LOG(WARNING) << "Integrity: receiver clock jump of " << common_mode_m
+                         << " m (" << common_mode_m / SPEED_OF_LIGHT_M_S * 1.0e9 << " ns) detected at RX time "
+                         << obs.RX_time << " across " << d_innovations_m.size() << " channels";
+            publish_event(2, obs, static_cast<uint16_t>(d_innovations_m.size()), common_mode_m, d_clock_jump_m);
+            d_clock_quiet_epochs = quiet_epochs_after_event;
+            events++;
+        }
+
+    // ******** pass 3: per-satellite residual tests ********
+    for (size_t k = 0; k < d_innovations_m.size(); k++)
+        {
+            const int ch = d_innovation_channel[k];
+            Channel_State& state = d_channels[ch];
+            const float residual_m = d_innovations_m[k] - common_mode_m;
+            if (state.epochs_tracked <= warmup_epochs)
+                {
+                    state.innovation_var_m2 = std::max(residual_m * residual_m, sigma_floor_m * sigma_floor_m);
+                    continue;
+                }
+            const float sigma_m = std::max(std::sqrt(state.innovation_var_m2), sigma_floor_m);
+            if (std::fabs(residual_m) > d_innovation_sigma * sigma_m and state.quiet_epochs == 0)
+                {
+                    const Gnss_Synchro& obs = epoch_data[ch];
+                    LOG(WARNING) << "Integrity: pseudorange innovation of " << residual_m
+                                 << " m (" << residual_m / sigma_m << " sigma) on channel " << obs.Channel_ID
+                                 << " [" << obs.System << " PRN " << obs.PRN << "] at RX time " << obs.RX_time;
+                    publish_event(1, obs, 1, residual_m, d_innovation_sigma * sigma_m);
+                    state.quiet_epochs = quiet_epochs_after_event;
+                    events++;
+                    // keep the outlier out of the variance estimate
+                    continue;
+                }
+            state.innovation_var_m2 = (1.0F - variance_alpha) * state.innovation_var_m2 + variance_alpha * residual_m * residual_m;
+        }
+
+    // ******** pass 4: cross-channel C/N0 anomaly ********
+    if (d_cn0_quiet_epochs > 0)
+        {
+            d_cn0_quiet_epochs--;
+        }
+    const int cn0_quorum = std::max(2, active_channels / 2);
+    if (cn0_steps >= cn0_quorum and d_cn0_quiet_epochs == 0)
+        {
+            const Gnss_Synchro& obs = epoch_data[cn0_first_channel];
+            LOG(WARNING) << "Integrity: simultaneous C/N0 step of up to " << cn0_largest_step_db
+                         << " dB on " << cn0_steps << " of " << active_channels
+                         << " channels at RX time " << obs.RX_time;
+            publish_event(3, obs, static_cast<uint16_t>(cn0_steps), cn0_largest_step_db, d_cn0_step_db);
+            d_cn0_quiet_epochs = quiet_epochs_after_event;
+            events++;
+        }
+
+    return events;
+}
@@ -0,0 +1,130 @@
+/*!
+ * \file obs_integrity_monitor.h
+ * \brief Real-time integrity screening of the observables stream: innovation
+ * tests, receiver clock-jump detection and cross-channel C/N0 anomaly
+ * scoring, with events published over UDP
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_OBS_INTEGRITY_MONITOR_H
+#define GNSS_SDR_OBS_INTEGRITY_MONITOR_H
+
+#include "gnss_synchro.h"
+#include <boost/asio.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Observables
+ * \{ */
+/** \addtogroup Observables_libs observables_libs
+ * \{ */
+
+
+#if USE_BOOST_ASIO_IO_CONTEXT
+using b_io_context = boost::asio::io_context;
+#else
+using b_io_context = boost::asio::io_service;
+#endif
+
+/*!
+ * \brief One integrity event datagram. Native byte order (producer and
+ * consumer share the deployment).
+ */
+struct Obs_Integrity_Event
+{
+    uint32_t magic;     //!< "GIEV" = 0x47494556
+    uint8_t version;    //!< format version, currently 1
+    uint8_t event_type;  //!< 1: pseudorange innovation, 2: clock jump, 3: C/N0 anomaly
+    uint16_t affected_channels;
+    uint32_t channel_id;  //!< offending channel, or first affected one for common-mode events
+    uint32_t prn;
+    char system;
+    char signal[2];
+    uint8_t reserved;
+    double metric;     //!< measured test statistic (meters or dB-Hz)
+    double threshold;  //!< threshold the statistic exceeded
+    double rx_time;    //!< receiver epoch time [s]
+    uint64_t host_time_ns;  //!< wall-clock detection time, nanoseconds since the UNIX epoch
+};
+
+/*!
+ * \brief Screens every observables epoch before it reaches the PVT block.
+ *
+ * Three tests run per epoch at O(channels) cost, all on data already in the
+ * Gnss_Synchro epoch vector:
+ *
+ *  - Pseudorange innovation: the measured pseudorange is compared against
+ *    the previous epoch propagated with the carrier Doppler (code-carrier
+ *    consistency). Residuals are taken against the epoch median so a common
+ *    receiver clock step does not fire every channel, and are normalized by
+ *    a per-channel running sigma.
+ *  - Clock jump: the median innovation itself is the common-mode term; a
+ *    step beyond the configured threshold is reported as a single receiver
+ *    clock event.
+ *  - C/N0 anomaly: each channel keeps a smoothed C/N0 baseline; a
+ *    simultaneous step on several channels is the classic signature of a
+ *    spoofing or jamming onset and is reported as one cross-channel event.
+ *
+ * Events are logged and published as one UDP datagram each on the monitor
+ * path, rate-limited per channel, so a downstream watchdog can raise the
+ * alarm within one epoch instead of scraping files after the fact.
+ */
+class Obs_Integrity_Monitor
+{
+public:
+    Obs_Integrity_Monitor(const std::string& address, uint16_t port,
+        float innovation_sigma, float clock_jump_m, float cn0_step_db);
+
+    //! Screen one observables epoch. Returns the number of events raised
+    int check_epoch(const std::vector<Gnss_Synchro>& epoch_data);
+
+    uint64_t events_raised() const;
+
+private:
+    // per-channel screening state
+    struct Channel_State
+    {
+        double prev_rx_time = 0.0;
+        double prev_pseudorange_m = 0.0;
+        double prev_doppler_hz = 0.0;
+        float innovation_var_m2 = 0.0F;  // running variance of the innovation residual
+        float cn0_baseline_db_hz = 0.0F;
+        uint32_t prev_prn = 0;
+        int epochs_tracked = 0;
+        int quiet_epochs = 0;  // rate limiting: epochs until this channel may report again
+        bool has_previous = false;
+    };
+
+    static double carrier_frequency_hz(char system, const char signal[3]);
+    void publish_event(uint8_t event_type, const Gnss_Synchro& obs, uint16_t affected,
+        double metric, double threshold);
+
+    b_io_context io_context;
+    boost::asio::ip::udp::socket socket;
+    boost::asio::ip::udp::endpoint endpoint;
+    std::vector<Channel_State> d_channels;
+    std::vector<float> d_innovations_m;  // scratch, reused every epoch
+    std::vector<int> d_innovation_channel;
+    uint64_t d_events_raised = 0;
+    float d_innovation_sigma = 6.0F;
+    float d_clock_jump_m = 15.0F;
+    float d_cn0_step_db = 5.0F;
+    int d_clock_quiet_epochs = 0;
+    int d_cn0_quiet_epochs = 0;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_OBS_INTEGRITY_MONITOR_H
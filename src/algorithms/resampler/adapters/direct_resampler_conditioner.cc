@@ -16,6 +16,7 @@
  */
 
 #include "direct_resampler_conditioner.h"
+#include "async_file_sink.h"
 #include "configuration_interface.h"
 #include "direct_resampler_conditioner_cb.h"
 #include "direct_resampler_conditioner_cc.h"
@@ -48,6 +49,12 @@ DirectResamplerConditioner::DirectResamplerConditioner(
     dump_ = configuration->property(role + ".dump", false);
     DLOG(INFO) << "dump_ is " << dump_;
     dump_filename_ = configuration->property(role + ".dump_filename", default_dump_file);
+    // write the dump from a dedicated thread, dropping (and accounting)
+    // samples instead of stalling the flowgraph when the disk hiccups
+    dump_async_ = configuration->property(role + ".dump_async", false);
+    // deterministic sample-count rotation of the async dump into numbered
+    // files; 0 keeps a single file for the whole run
+    dump_items_per_file_ = static_cast<uint64_t>(configuration->property(role + ".dump_items_per_file", static_cast<int64_t>(0)));
 
     if (item_type_ == "gr_complex")
         {
@@ -84,7 +91,14 @@ DirectResamplerConditioner::DirectResamplerConditioner(
     if (dump_)
         {
             DLOG(INFO) << "Dumping output into file " << dump_filename_;
-            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+            if (dump_async_)
+                {
+                    file_sink_ = async_make_file_sink(item_size_, dump_filename_, 1048576, 64, dump_items_per_file_);
+                }
+            else
+                {
+                    file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+                }
             DLOG(INFO) << "file_sink(" << file_sink_->unique_id() << ")";
         }
     if (in_stream_ > 1)
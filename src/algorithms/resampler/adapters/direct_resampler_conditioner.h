@@ -21,6 +21,7 @@
 
 #include "gnss_block_interface.h"
 #include <gnuradio/hier_block2.h>
+#include <cstdint>
 #include <string>
 
 /** \addtogroup Resampler
@@ -74,9 +75,11 @@ private:
     double sample_freq_in_;
     double sample_freq_out_;
     size_t item_size_;
+    uint64_t dump_items_per_file_;
     unsigned int in_stream_;
     unsigned int out_stream_;
     bool dump_;
+    bool dump_async_;
 };
 
 
@@ -16,6 +16,7 @@
  */
 
 #include "mmse_resampler_conditioner.h"
+#include "async_file_sink.h"
 #include "configuration_interface.h"
 #include <glog/logging.h>
 #include <gnuradio/blocks/file_sink.h>
@@ -43,28 +44,47 @@ MmseResamplerConditioner::MmseResamplerConditioner(
     dump_ = configuration->property(role + ".dump", false);
     DLOG(INFO) << "dump_ is " << dump_;
     dump_filename_ = configuration->property(role + ".dump_filename", default_dump_file);
+    // write the dump from a dedicated thread, dropping (and accounting)
+    // samples instead of stalling the flowgraph when the disk hiccups
+    dump_async_ = configuration->property(role + ".dump_async", false);
+    // deterministic sample-count rotation of the async dump into numbered
+    // files; 0 keeps a single file for the whole run
+    dump_items_per_file_ = static_cast<uint64_t>(configuration->property(role + ".dump_items_per_file", static_cast<int64_t>(0)));
+    // single-pass polyphase resampler instead of the lowpass filter /
+    // fractional resampler pair
+    use_polyphase_ = configuration->property(role + ".use_polyphase", false);
 
     if (item_type_ == "gr_complex")
         {
             item_size_ = sizeof(gr_complex);
 
-            // create a FIR low pass filter
-            std::vector<float> taps = gr::filter::firdes::low_pass(1.0,
-                sample_freq_in_,
-                sample_freq_out_ / 2.1,
-                sample_freq_out_ / 5);
-            std::cout << "Enabled fractional resampler low pass filter with " << taps.size() << " taps\n";
-            fir_filter_ccf_ = gr::filter::fir_filter_ccf::make(1, taps);
+            if (use_polyphase_)
+                {
+                    const int nfilts = configuration->property(role + ".nfilts", 32);
+                    polyphase_resampler_ = polyphase_make_resampler_cc(sample_freq_in_, sample_freq_out_, nfilts);
+                    std::cout << "Enabled polyphase resampler with " << nfilts << " phases\n";
+                    DLOG(INFO) << "polyphase resampler(" << polyphase_resampler_->unique_id() << ")";
+                }
+            else
+                {
+                    // create a FIR low pass filter
+                    std::vector<float> taps = gr::filter::firdes::low_pass(1.0,
+                        sample_freq_in_,
+                        sample_freq_out_ / 2.1,
+                        sample_freq_out_ / 5);
+                    std::cout << "Enabled fractional resampler low pass filter with " << taps.size() << " taps\n";
+                    fir_filter_ccf_ = gr::filter::fir_filter_ccf::make(1, taps);
 
 #ifdef GR_GREATER_38
-            resampler_ = gr::filter::mmse_resampler_cc::make(0.0, static_cast<float>(sample_freq_in_ / sample_freq_out_));
+                    resampler_ = gr::filter::mmse_resampler_cc::make(0.0, static_cast<float>(sample_freq_in_ / sample_freq_out_));
 #else
-            resampler_ = gr::filter::fractional_resampler_cc::make(0.0, static_cast<float>(sample_freq_in_ / sample_freq_out_));
+                    resampler_ = gr::filter::fractional_resampler_cc::make(0.0, static_cast<float>(sample_freq_in_ / sample_freq_out_));
 #endif
+                    DLOG(INFO) << "resampler(" << resampler_->unique_id() << ")";
+                }
             DLOG(INFO) << "sample_freq_in " << sample_freq_in_;
             DLOG(INFO) << "sample_freq_out" << sample_freq_out_;
             DLOG(INFO) << "Item size " << item_size_;
-            DLOG(INFO) << "resampler(" << resampler_->unique_id() << ")";
         }
     else
         {
@@ -74,7 +94,14 @@ MmseResamplerConditioner::MmseResamplerConditioner(
     if (dump_)
         {
             DLOG(INFO) << "Dumping output into file " << dump_filename_;
-            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+            if (dump_async_)
+                {
+                    file_sink_ = async_make_file_sink(item_size_, dump_filename_, 1048576, 64, dump_items_per_file_);
+                }
+            else
+                {
+                    file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+                }
             DLOG(INFO) << "file_sink(" << file_sink_->unique_id() << ")";
         }
     if (in_stream_ > 1)
@@ -90,6 +117,19 @@ MmseResamplerConditioner::MmseResamplerConditioner(
 
 void MmseResamplerConditioner::connect(gr::top_block_sptr top_block)
 {
+    if (use_polyphase_)
+        {
+            if (dump_)
+                {
+                    top_block->connect(polyphase_resampler_, 0, file_sink_, 0);
+                    DLOG(INFO) << "connected resampler to file sink";
+                }
+            else
+                {
+                    DLOG(INFO) << "nothing to connect internally";
+                }
+            return;
+        }
     if (dump_)
         {
             top_block->connect(fir_filter_ccf_, 0, resampler_, 0);
@@ -105,6 +145,14 @@ void MmseResamplerConditioner::connect(gr::top_block_sptr top_block)
 
 void MmseResamplerConditioner::disconnect(gr::top_block_sptr top_block)
 {
+    if (use_polyphase_)
+        {
+            if (dump_)
+                {
+                    top_block->disconnect(polyphase_resampler_, 0, file_sink_, 0);
+                }
+            return;
+        }
     if (dump_)
         {
             top_block->disconnect(fir_filter_ccf_, 0, resampler_, 0);
@@ -119,11 +167,19 @@ void MmseResamplerConditioner::disconnect(gr::top_block_sptr top_block)
 
 gr::basic_block_sptr MmseResamplerConditioner::get_left_block()
 {
+    if (use_polyphase_)
+        {
+            return polyphase_resampler_;
+        }
     return fir_filter_ccf_;
 }
 
 
 gr::basic_block_sptr MmseResamplerConditioner::get_right_block()
 {
+    if (use_polyphase_)
+        {
+            return polyphase_resampler_;
+        }
     return resampler_;
 }
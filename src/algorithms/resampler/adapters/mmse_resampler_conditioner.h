@@ -20,6 +20,7 @@
 #define GNSS_SDR_MMSE_RESAMPLER_CONDITIONER_H
 
 #include "gnss_block_interface.h"
+#include "polyphase_resampler_cc.h"
 #ifdef GR_GREATER_38
 #include <gnuradio/filter/fir_filter_blk.h>
 #include <gnuradio/filter/mmse_resampler_cc.h>
@@ -29,6 +30,7 @@
 #endif
 
 #include <gnuradio/filter/firdes.h>
+#include <cstdint>
 #include <string>
 
 /** \addtogroup Resampler
@@ -81,16 +83,20 @@ private:
     gr::filter::fractional_resampler_cc::sptr resampler_;
 #endif
     gr::filter::fir_filter_ccf::sptr fir_filter_ccf_;
+    polyphase_resampler_cc_sptr polyphase_resampler_;
     gr::block_sptr file_sink_;
     std::string role_;
     std::string item_type_;
     std::string dump_filename_;
     size_t item_size_;
+    uint64_t dump_items_per_file_;
     double sample_freq_in_;
     double sample_freq_out_;
     unsigned int in_stream_;
     unsigned int out_stream_;
     bool dump_;
+    bool dump_async_;
+    bool use_polyphase_;
 };
 
 
@@ -0,0 +1,139 @@
+/*!
+ * \file polyphase_resampler_cc.cc
+ * \brief Polyphase arbitrary resampler with a precomputed filter bank
+ *        and fixed-point phase-increment arithmetic
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "polyphase_resampler_cc.h"
+#include "MATH_CONSTANTS.h"  // for GNSS_PI, TWO_PI
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>  // for max, min
+#include <cmath>
+#include <stdexcept>
+
+polyphase_resampler_cc_sptr polyphase_make_resampler_cc(
+    double sample_freq_in, double sample_freq_out, int32_t nfilts)
+{
+    return polyphase_resampler_cc_sptr(
+        new polyphase_resampler_cc(sample_freq_in,
+            sample_freq_out, nfilts));
+}
+
+
+polyphase_resampler_cc::polyphase_resampler_cc(
+    double sample_freq_in,
+    double sample_freq_out,
+    int32_t nfilts) : gr::block("polyphase_resampler_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)), gr::io_signature::make(1, 1, sizeof(gr_complex))),
+                      d_sample_freq_in(sample_freq_in),
+                      d_sample_freq_out(sample_freq_out),
+                      d_acc(0),
+                      d_nfilts(nfilts)
+{
+    if ((sample_freq_in <= 0.0) or (sample_freq_out <= 0.0) or (sample_freq_out > sample_freq_in))
+        {
+            throw std::invalid_argument("Polyphase resampler only supports decimating rate changes");
+        }
+    if (d_nfilts < 2)
+        {
+            throw std::invalid_argument("Polyphase resampler needs at least two phases");
+        }
+    const int32_t alignment_multiple = volk_get_alignment() / sizeof(gr_complex);
+    set_alignment(std::max(1, alignment_multiple));
+
+    // Computes the phase step multiplying the resampling ratio by 2^32 = 4294967296
+    const double two_32 = 4294967296.0;
+    d_acc_step = static_cast<uint64_t>(std::llround(two_32 * sample_freq_in / sample_freq_out));
+
+    // Hamming-windowed sinc lowpass with the same passband as the filter the
+    // MMSE conditioner places in front of the fractional resampler (cutoff at
+    // fs_out / 2.1, transition band fs_out / 5), designed at nfilts times the
+    // input rate and split into nfilts phases that all run at the input rate
+    const double transition = sample_freq_out / 5.0;
+    int32_t taps_per_phase = static_cast<int32_t>(std::ceil(3.3 * sample_freq_in / transition));
+    if ((taps_per_phase % 2) == 0)
+        {
+            taps_per_phase++;
+        }
+    d_taps_per_phase = std::max(taps_per_phase, 7);
+    const int32_t ntaps = d_taps_per_phase * d_nfilts;
+    const double fc = (sample_freq_out / 2.1) / (sample_freq_in * static_cast<double>(d_nfilts));
+    std::vector<double> prototype(ntaps);
+    double taps_sum = 0.0;
+    for (int32_t n = 0; n < ntaps; n++)
+        {
+            const double m = static_cast<double>(n) - static_cast<double>(ntaps - 1) / 2.0;
+            const double sinc = (m == 0.0) ? 2.0 * fc : std::sin(TWO_PI * fc * m) / (GNSS_PI * m);
+            const double window = 0.54 - 0.46 * std::cos(TWO_PI * static_cast<double>(n) / static_cast<double>(ntaps - 1));
+            prototype[n] = sinc * window;
+            taps_sum += prototype[n];
+        }
+    // unit DC gain per phase: every phase sums roughly taps_sum / nfilts
+    const double gain = static_cast<double>(d_nfilts) / taps_sum;
+
+    // phase p holds prototype[k * nfilts + p], stored reversed so that the
+    // dot product against a forward input window implements the convolution
+    d_taps.resize(d_nfilts);
+    for (int32_t p = 0; p < d_nfilts; p++)
+        {
+            d_taps[p].resize(d_taps_per_phase);
+            for (int32_t k = 0; k < d_taps_per_phase; k++)
+                {
+                    d_taps[p][k] = static_cast<float>(gain * prototype[(d_taps_per_phase - 1 - k) * d_nfilts + p]);
+                }
+        }
+
+    set_relative_rate(sample_freq_out / sample_freq_in);
+    set_output_multiple(1);
+}
+
+
+void polyphase_resampler_cc::forecast(int noutput_items,
+    gr_vector_int &ninput_items_required)
+{
+    const int nreqd = static_cast<int>(static_cast<double>(noutput_items + 1) * d_sample_freq_in / d_sample_freq_out) + d_taps_per_phase + 1;
+    for (auto &nreq : ninput_items_required)
+        {
+            nreq = nreqd;
+        }
+}
+
+
+int polyphase_resampler_cc::general_work(int noutput_items,
+    gr_vector_int &ninput_items, gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
+
+    int lcv = 0;
+    while (lcv < noutput_items)
+        {
+            const auto window_start = static_cast<int32_t>(d_acc >> 32);
+            if ((window_start + d_taps_per_phase) > ninput_items[0])
+                {
+                    break;
+                }
+            // the top bits of the fractional part select the phase
+            const auto phase = static_cast<int32_t>(((d_acc & 0xFFFFFFFFULL) * static_cast<uint64_t>(d_nfilts)) >> 32);
+            volk_32fc_32f_dot_prod_32fc(out + lcv, in + window_start, d_taps[phase].data(), d_taps_per_phase);
+            d_acc += d_acc_step;
+            lcv++;
+        }
+
+    const auto consumed = std::min(static_cast<int32_t>(d_acc >> 32), ninput_items[0]);
+    d_acc -= static_cast<uint64_t>(consumed) << 32;
+    consume_each(consumed);
+    return lcv;
+}
@@ -0,0 +1,102 @@
+/*!
+ * \file polyphase_resampler_cc.h
+ * \brief Polyphase arbitrary resampler with a precomputed filter bank
+ *        and fixed-point phase-increment arithmetic
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * The fractional output instant is tracked with a 32.32 fixed-point
+ * accumulator, exactly as the direct resampler does: the integer part
+ * indexes the input stream and the fractional part selects one of the
+ * precomputed polyphase filters, so the inner loop runs without any
+ * floating-point phase bookkeeping. Each output sample costs one aligned
+ * dot product between the input window and the selected phase.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_POLYPHASE_RESAMPLER_CC_H
+#define GNSS_SDR_POLYPHASE_RESAMPLER_CC_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/block.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Resampler
+ * \{ */
+/** \addtogroup Resampler_gnuradio_blocks resampler_gr_blocks
+ * \{ */
+
+
+class polyphase_resampler_cc;
+
+using polyphase_resampler_cc_sptr = gnss_shared_ptr<polyphase_resampler_cc>;
+
+polyphase_resampler_cc_sptr polyphase_make_resampler_cc(
+    double sample_freq_in,
+    double sample_freq_out,
+    int32_t nfilts);
+
+/*!
+ * \brief This class implements a polyphase resampler for complex data
+ *
+ * The anti-alias lowpass filter is designed once at construction time for
+ * an oversampled rate of nfilts times the input rate and split into nfilts
+ * phases, so the block replaces the lowpass filter / fractional resampler
+ * pair of the MMSE conditioner with a single filtering pass.
+ */
+class polyphase_resampler_cc : public gr::block
+{
+public:
+    ~polyphase_resampler_cc() = default;
+
+    inline double sample_freq_in() const
+    {
+        return d_sample_freq_in;
+    }
+
+    inline double sample_freq_out() const
+    {
+        return d_sample_freq_out;
+    }
+
+    void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+
+    int general_work(int noutput_items, gr_vector_int &ninput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend polyphase_resampler_cc_sptr polyphase_make_resampler_cc(
+        double sample_freq_in,
+        double sample_freq_out,
+        int32_t nfilts);
+
+    polyphase_resampler_cc(
+        double sample_freq_in,
+        double sample_freq_out,
+        int32_t nfilts);
+
+    std::vector<volk_gnsssdr::vector<float>> d_taps;  // one reversed tap set per phase
+
+    double d_sample_freq_in;
+    double d_sample_freq_out;
+    uint64_t d_acc;        // 32.32 fixed-point position of the next output
+    uint64_t d_acc_step;   // 32.32 fixed-point input samples per output
+    int32_t d_nfilts;      // number of polyphase branches
+    int32_t d_taps_per_phase;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_POLYPHASE_RESAMPLER_CC_H
@@ -26,11 +26,16 @@
 #include "galileo_e6_signal_replica.h"
 #include "glonass_l1_signal_replica.h"
 #include "gps_sdr_signal_replica.h"
+#include "prn_code_cache.h"
 #include <gnuradio/io_signature.h>
+#include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <fstream>
+#include <thread>
 #include <utility>
 
 
@@ -87,7 +92,16 @@ void signal_generator_c::init()
 {
     work_counter_ = 0;
 
-    complex_phase_.reserve(vector_length_);
+    // Per-satellite scratch buffers, so the satellites of one work() call
+    // can be synthesized concurrently and mixed afterwards
+    sat_buffer_ = std::vector<std::vector<gr_complex>>(num_sats_, std::vector<gr_complex>(vector_length_));
+    sat_phase_ = std::vector<std::vector<gr_complex>>(num_sats_, std::vector<gr_complex>(vector_length_));
+    num_workers_ = std::max(std::thread::hardware_concurrency(), 1U);
+    if (num_sats_ > 0 and num_workers_ > num_sats_)
+        {
+            num_workers_ = num_sats_;
+        }
+
     start_phase_rad_.reserve(num_sats_);
     current_data_bit_int_.reserve(num_sats_);
     ms_counter_.reserve(num_sats_);
@@ -165,239 +179,285 @@ void signal_generator_c::generate_codes()
     sampled_code_data_ = std::vector<std::vector<gr_complex>>(num_sats_, std::vector<gr_complex>(vector_length_));
     sampled_code_pilot_ = std::vector<std::vector<gr_complex>>(num_sats_, std::vector<gr_complex>(vector_length_));
 
+    auto& code_cache = Prn_Code_Cache::get_instance();
+
     for (unsigned int sat = 0; sat < num_sats_; sat++)
         {
-            std::array<gr_complex, 64000> code{};
+            // Scaled copy of a shared cached replica, concatenated
+            // "num_codes" times. The cache holds the unscaled table, so
+            // satellites sharing a replica store it once per process
+            const auto scale_and_concat = [&](std::vector<gr_complex>& destination,
+                                              const std::shared_ptr<const Prn_Code_Cache::complex_vector>& code,
+                                              unsigned int num_codes, unsigned int code_samples, float amplitude) {
+                for (unsigned int i = 0; i < num_codes; i++)
+                    {
+                        for (unsigned int k = 0; k < code_samples; k++)
+                            {
+                                destination[i * code_samples + k] = (*code)[k] * amplitude;
+                            }
+                    }
+            };
 
             if (system_[sat] == "G")
                 {
-                    // Generate one code-period of 1C signal
-                    gps_l1_ca_code_gen_complex_sampled(code, PRN_[sat], fs_in_,
-                        static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS) - delay_chips_[sat]);
+                    // One code-period of 1C signal
+                    const uint32_t chip_shift = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS) - delay_chips_[sat];
+                    const auto code = code_cache.get_or_build("G1C", PRN_[sat], fs_in_, static_cast<int32_t>(chip_shift), samples_per_code_[sat],
+                        [&](own::span<std::complex<float>> dest) {
+                            gps_l1_ca_code_gen_complex_sampled(dest, PRN_[sat], fs_in_, chip_shift);
+                        });
 
                     // Obtain the desired CN0 assuming that Pn = 1.
-                    if (noise_flag_)
-                        {
-                            for (unsigned int i = 0; i < samples_per_code_[sat]; i++)
-                                {
-                                    code[i] *= std::sqrt(std::pow(10.0F, CN0_dB_[sat] / 10.0F) / BW_BB_);
-                                }
-                        }
-
-                    // Concatenate "num_of_codes_per_vector_" codes
-                    for (unsigned int i = 0; i < num_of_codes_per_vector_[sat]; i++)
-                        {
-                            memcpy(&(sampled_code_data_[sat][i * samples_per_code_[sat]]),
-                                code.data(), sizeof(gr_complex) * samples_per_code_[sat]);
-                        }
+                    const float amplitude = noise_flag_ ? std::sqrt(std::pow(10.0F, CN0_dB_[sat] / 10.0F) / BW_BB_) : 1.0F;
+                    scale_and_concat(sampled_code_data_[sat], code, num_of_codes_per_vector_[sat], samples_per_code_[sat], amplitude);
                 }
             else if (system_[sat] == "R")
                 {
-                    // Generate one code-period of 1G signal
-                    glonass_l1_ca_code_gen_complex_sampled(code, /*PRN_[sat],*/ fs_in_,
-                        static_cast<int>(GLONASS_L1_CA_CODE_LENGTH_CHIPS) - delay_chips_[sat]);
+                    // One code-period of 1G signal (the C/A code is common to all satellites)
+                    const uint32_t chip_shift = static_cast<int>(GLONASS_L1_CA_CODE_LENGTH_CHIPS) - delay_chips_[sat];
+                    const auto code = code_cache.get_or_build("R1G", 0, fs_in_, static_cast<int32_t>(chip_shift), samples_per_code_[sat],
+                        [&](own::span<std::complex<float>> dest) {
+                            glonass_l1_ca_code_gen_complex_sampled(dest, fs_in_, chip_shift);
+                        });
 
                     // Obtain the desired CN0 assuming that Pn = 1.
-                    if (noise_flag_)
-                        {
-                            for (unsigned int i = 0; i < samples_per_code_[sat]; i++)
-                                {
-                                    code[i] *= std::sqrt(std::pow(10.0F, CN0_dB_[sat] / 10.0F) / BW_BB_);
-                                }
-                        }
-
-                    // Concatenate "num_of_codes_per_vector_" codes
-                    for (unsigned int i = 0; i < num_of_codes_per_vector_[sat]; i++)
-                        {
-                            memcpy(&(sampled_code_data_[sat][i * samples_per_code_[sat]]),
-                                code.data(), sizeof(gr_complex) * samples_per_code_[sat]);
-                        }
+                    const float amplitude = noise_flag_ ? std::sqrt(std::pow(10.0F, CN0_dB_[sat] / 10.0F) / BW_BB_) : 1.0F;
+                    scale_and_concat(sampled_code_data_[sat], code, num_of_codes_per_vector_[sat], samples_per_code_[sat], amplitude);
                 }
             else if (system_[sat] == "E")
                 {
+                    const float amplitude = noise_flag_ ? std::sqrt(std::pow(10.0F, CN0_dB_[sat] / 10.0F) / BW_BB_ / 2.0F) : 1.0F;
+
                     if (signal_[sat].at(0) == '5')
                         {
-                            std::array<char, 3> signal = {{'5', 'X', '\0'}};
-
-                            galileo_e5_a_code_gen_complex_sampled(sampled_code_data_[sat], PRN_[sat], signal, fs_in_,
-                                static_cast<int>(GALILEO_E5A_CODE_LENGTH_CHIPS) - delay_chips_[sat]);
-                            // noise
-                            if (noise_flag_)
-                                {
-                                    for (unsigned int i = 0; i < vector_length_; i++)
-                                        {
-                                            sampled_code_data_[sat][i] *= std::sqrt(std::pow(10.0F, CN0_dB_[sat] / 10.0F) / BW_BB_ / 2.0F);
-                                        }
-                                }
+                            const uint32_t chip_shift = static_cast<int>(GALILEO_E5A_CODE_LENGTH_CHIPS) - delay_chips_[sat];
+                            const auto code = code_cache.get_or_build("E5X", PRN_[sat], fs_in_, static_cast<int32_t>(chip_shift), vector_length_,
+                                [&](own::span<std::complex<float>> dest) {
+                                    std::array<char, 3> signal = {{'5', 'X', '\0'}};
+                                    galileo_e5_a_code_gen_complex_sampled(dest, PRN_[sat], signal, fs_in_, chip_shift);
+                                });
+                            scale_and_concat(sampled_code_data_[sat], code, 1, vector_length_, amplitude);
                         }
                     else if (signal_[sat].at(0) == '7')
                         {
-                            std::array<char, 3> signal = {{'7', 'X', '\0'}};
-
-                            galileo_e5_b_code_gen_complex_sampled(sampled_code_data_[sat], PRN_[sat], signal, fs_in_,
-                                static_cast<int>(GALILEO_E5B_CODE_LENGTH_CHIPS) - delay_chips_[sat]);
-                            // noise
-                            if (noise_flag_)
-                                {
-                                    for (unsigned int i = 0; i < vector_length_; i++)
-                                        {
-                                            sampled_code_data_[sat][i] *= std::sqrt(std::pow(10.0F, CN0_dB_[sat] / 10.0F) / BW_BB_ / 2.0F);
-                                        }
-                                }
+                            const uint32_t chip_shift = static_cast<int>(GALILEO_E5B_CODE_LENGTH_CHIPS) - delay_chips_[sat];
+                            const auto code = code_cache.get_or_build("E7X", PRN_[sat], fs_in_, static_cast<int32_t>(chip_shift), vector_length_,
+                                [&](own::span<std::complex<float>> dest) {
+                                    std::array<char, 3> signal = {{'7', 'X', '\0'}};
+                                    galileo_e5_b_code_gen_complex_sampled(dest, PRN_[sat], signal, fs_in_, chip_shift);
+                                });
+                            scale_and_concat(sampled_code_data_[sat], code, 1, vector_length_, amplitude);
                         }
                     else if (signal_[sat].at(1) == '6')
                         {
-                            // Generate one code-period of E&B signal
-                            galileo_e6_b_code_gen_complex_sampled(code, PRN_[sat], fs_in_,
-                                static_cast<int>(GALILEO_E6_B_CODE_LENGTH_CHIPS) - delay_chips_[sat]);
-                            // Obtain the desired CN0 assuming that Pn = 1.
-                            if (noise_flag_)
-                                {
-                                    for (unsigned int i = 0; i < samples_per_code_[sat]; i++)
-                                        {
-                                            code[i] *= std::sqrt(std::pow(10.0F, CN0_dB_[sat] / 10.0F) / BW_BB_ / 2.0F);
-                                        }
-                                }
-                            // Concatenate "num_of_codes_per_vector_" codes
-                            for (unsigned int i = 0; i < num_of_codes_per_vector_[sat]; i++)
-                                {
-                                    memcpy(&(sampled_code_data_[sat][i * samples_per_code_[sat]]),
-                                        code.data(), sizeof(gr_complex) * samples_per_code_[sat]);
-                                }
-                            // Generate E6C signal (100 code-periods, with secondary code)
-                            galileo_e6_c_code_gen_complex_sampled(sampled_code_pilot_[sat], PRN_[sat], fs_in_,
-                                static_cast<int>(GALILEO_E6_C_CODE_LENGTH_CHIPS) - delay_chips_[sat]);
-                            // Obtain the desired CN0 assuming that Pn = 1.
-                            if (noise_flag_)
-                                {
-                                    for (unsigned int i = 0; i < vector_length_; i++)
-                                        {
-                                            sampled_code_pilot_[sat][i] *= sqrt(std::pow(10.0F, CN0_dB_[sat] / 10.0F) / BW_BB_ / 2.0F);
-                                        }
-                                }
+                            // One code-period of E6B signal
+                            const uint32_t chip_shift_data = static_cast<int>(GALILEO_E6_B_CODE_LENGTH_CHIPS) - delay_chips_[sat];
+                            const auto code_data = code_cache.get_or_build("E6B", PRN_[sat], fs_in_, static_cast<int32_t>(chip_shift_data), samples_per_code_[sat],
+                                [&](own::span<std::complex<float>> dest) {
+                                    galileo_e6_b_code_gen_complex_sampled(dest, PRN_[sat], fs_in_, chip_shift_data);
+                                });
+                            scale_and_concat(sampled_code_data_[sat], code_data, num_of_codes_per_vector_[sat], samples_per_code_[sat], amplitude);
+
+                            // E6C signal (100 code-periods, with secondary code)
+                            const uint32_t chip_shift_pilot = static_cast<int>(GALILEO_E6_C_CODE_LENGTH_CHIPS) - delay_chips_[sat];
+                            const auto code_pilot = code_cache.get_or_build("E6C", PRN_[sat], fs_in_, static_cast<int32_t>(chip_shift_pilot), vector_length_,
+                                [&](own::span<std::complex<float>> dest) {
+                                    galileo_e6_c_code_gen_complex_sampled(dest, PRN_[sat], fs_in_, chip_shift_pilot);
+                                });
+                            scale_and_concat(sampled_code_pilot_[sat], code_pilot, 1, vector_length_, amplitude);
                         }
                     else
                         {
-                            // Generate one code-period of E1B signal
-                            bool cboc = true;
-                            std::array<char, 3> signal = {{'1', 'B', '\0'}};
-
-                            galileo_e1_code_gen_complex_sampled(code, signal, cboc, PRN_[sat], fs_in_,
-                                static_cast<int>(GALILEO_E1_B_CODE_LENGTH_CHIPS) - delay_chips_[sat]);
-
-                            // Obtain the desired CN0 assuming that Pn = 1.
-                            if (noise_flag_)
-                                {
-                                    for (unsigned int i = 0; i < samples_per_code_[sat]; i++)
-                                        {
-                                            code[i] *= std::sqrt(std::pow(10.0F, CN0_dB_[sat] / 10.0F) / BW_BB_ / 2.0F);
-                                        }
-                                }
-
-                            // Concatenate "num_of_codes_per_vector_" codes
-                            for (unsigned int i = 0; i < num_of_codes_per_vector_[sat]; i++)
-                                {
-                                    memcpy(&(sampled_code_data_[sat][i * samples_per_code_[sat]]),
-                                        code.data(), sizeof(gr_complex) * samples_per_code_[sat]);
-                                }
-
-                            // Generate E1C signal (25 code-periods, with secondary code)
-
-                            std::array<char, 3> signal_1C = {{'1', 'C', '\0'}};
-
-                            galileo_e1_code_gen_complex_sampled(sampled_code_pilot_[sat], signal_1C, cboc, PRN_[sat], fs_in_,
-                                static_cast<int>(GALILEO_E1_B_CODE_LENGTH_CHIPS) - delay_chips_[sat], true);
-
-                            // Obtain the desired CN0 assuming that Pn = 1.
-                            if (noise_flag_)
-                                {
-                                    for (unsigned int i = 0; i < vector_length_; i++)
-                                        {
-                                            sampled_code_pilot_[sat][i] *= sqrt(std::pow(10.0F, CN0_dB_[sat] / 10.0F) / BW_BB_ / 2.0F);
-                                        }
-                                }
+                            // One code-period of E1B signal
+                            const bool cboc = true;
+                            const uint32_t chip_shift = static_cast<int>(GALILEO_E1_B_CODE_LENGTH_CHIPS) - delay_chips_[sat];
+                            const auto code_data = code_cache.get_or_build("E1B_cboc", PRN_[sat], fs_in_, static_cast<int32_t>(chip_shift), samples_per_code_[sat],
+                                [&](own::span<std::complex<float>> dest) {
+                                    std::array<char, 3> signal = {{'1', 'B', '\0'}};
+                                    galileo_e1_code_gen_complex_sampled(dest, signal, cboc, PRN_[sat], fs_in_, chip_shift);
+                                });
+                            scale_and_concat(sampled_code_data_[sat], code_data, num_of_codes_per_vector_[sat], samples_per_code_[sat], amplitude);
+
+                            // E1C signal (25 code-periods, with secondary code)
+                            const auto code_pilot = code_cache.get_or_build("E1C_cboc_sec", PRN_[sat], fs_in_, static_cast<int32_t>(chip_shift), vector_length_,
+                                [&](own::span<std::complex<float>> dest) {
+                                    std::array<char, 3> signal_1C = {{'1', 'C', '\0'}};
+                                    galileo_e1_code_gen_complex_sampled(dest, signal_1C, cboc, PRN_[sat], fs_in_, chip_shift, true);
+                                });
+                            scale_and_concat(sampled_code_pilot_[sat], code_pilot, 1, vector_length_, amplitude);
                         }
                 }
         }
 }
 
 
-int signal_generator_c::general_work(int noutput_items __attribute__((unused)),
-    gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items __attribute__((unused)),
-    gr_vector_void_star &output_items)
+void signal_generator_c::generate_satellite(unsigned int sat, std::default_random_engine &e1)
 {
-    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
-
-    work_counter_++;
-
-    std::default_random_engine e1(r());
-    std::default_random_engine e2(r());
+    gr_complex *buffer = sat_buffer_[sat].data();
+    gr_complex *phase = sat_phase_[sat].data();
+    std::uniform_int_distribution<int> uniform_dist;
     unsigned int out_idx = 0;
     unsigned int i = 0;
-    unsigned int k = 0;
     // the intermediate frequency must be set by the user
     unsigned int freq = 4e6;
 
-    for (out_idx = 0; out_idx < vector_length_; out_idx++)
+    float phase_step_rad = -static_cast<float>(TWO_PI) * doppler_Hz_[sat] / static_cast<float>(fs_in_);
+    std::array<float, 1> _phase{};
+    _phase[0] = -start_phase_rad_[sat];
+    volk_gnsssdr_s32f_sincos_32fc(phase, -phase_step_rad, _phase.data(), vector_length_);
+    start_phase_rad_[sat] += static_cast<float>(vector_length_) * phase_step_rad;
+
+    // Multiplies one code segment by the carrier and scales it by a +/-1 data
+    // bit. The segments of one work() call cover the satellite buffer exactly
+    // once, so no accumulation is needed
+    const auto mix_segment = [&](unsigned int offset, unsigned int num_samples, float bit) {
+        if (num_samples == 0)
+            {
+                return;
+            }
+        volk_32fc_x2_multiply_32fc(&buffer[offset], &sampled_code_data_[sat][offset], &phase[offset], num_samples);
+        if (bit < 0.0F)
+            {
+                volk_32fc_s32fc_multiply_32fc(&buffer[offset], &buffer[offset], gr_complex(-1.0, 0.0), num_samples);
+            }
+    };
+
+    // E5 signals carry independent +/-1 symbols on the I (data) and Q (pilot)
+    // components: equal signs reduce to +/-code, opposite signs to +/-conj(code)
+    const auto mix_e5_segment = [&](unsigned int offset, unsigned int num_samples) {
+        if (num_samples == 0)
+            {
+                return;
+            }
+        if (data_modulation_[sat] == pilot_modulation_[sat])
+            {
+                volk_32fc_x2_multiply_32fc(&buffer[offset], &sampled_code_data_[sat][offset], &phase[offset], num_samples);
+            }
+        else
+            {
+                volk_32fc_x2_multiply_conjugate_32fc(&buffer[offset], &phase[offset], &sampled_code_data_[sat][offset], num_samples);
+            }
+        if (data_modulation_[sat] < 0)
+            {
+                volk_32fc_s32fc_multiply_32fc(&buffer[offset], &buffer[offset], gr_complex(-1.0, 0.0), num_samples);
+            }
+    };
+
+    // E1/E6 signals combine a data and a pilot code before the carrier
+    const auto mix_data_pilot_segment = [&](unsigned int offset, unsigned int num_samples) {
+        if (num_samples == 0)
+            {
+                return;
+            }
+        for (unsigned int k = offset; k < offset + num_samples; k++)
+            {
+                buffer[k] = sampled_code_data_[sat][k] * current_data_bits_[sat] - sampled_code_pilot_[sat][k];
+            }
+        volk_32fc_x2_multiply_32fc(&buffer[offset], &buffer[offset], &phase[offset], num_samples);
+    };
+
+    if (system_[sat] == "G")
         {
-            out[out_idx] = gr_complex(0.0, 0.0);
+            auto delay_samples = static_cast<unsigned int>((delay_chips_[sat] % static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GPS_L1_CA_CODE_LENGTH_CHIPS);
+
+            for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
+                {
+                    mix_segment(out_idx, delay_samples, current_data_bits_[sat].real());
+                    out_idx += delay_samples;
+
+                    if (ms_counter_[sat] == 0 && data_flag_)
+                        {
+                            // New random data bit
+                            current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
+                        }
+
+                    mix_segment(out_idx, samples_per_code_[sat] - delay_samples, current_data_bits_[sat].real());
+                    out_idx += samples_per_code_[sat] - delay_samples;
+
+                    ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * GPS_L1_CA_CODE_PERIOD_S))) % data_bit_duration_ms_[sat];
+                }
         }
 
-    for (unsigned int sat = 0; sat < num_sats_; sat++)
+    else if (system_[sat] == "R")
         {
-            float phase_step_rad = -static_cast<float>(TWO_PI) * doppler_Hz_[sat] / static_cast<float>(fs_in_);
-            std::array<float, 1> _phase{};
+            phase_step_rad = -static_cast<float>(TWO_PI) * (static_cast<float>(freq) + (static_cast<float>(DFRQ1_GLO) * GLONASS_PRN.at(PRN_[sat])) + doppler_Hz_[sat]) / static_cast<float>(fs_in_);
+            // std::cout << "sat " << PRN_[sat] << " SG - Freq = " << (freq + (DFRQ1_GLO * GLONASS_PRN.at(PRN_[sat]))) << " Doppler = " << doppler_Hz_[sat] << '\n';
             _phase[0] = -start_phase_rad_[sat];
-            volk_gnsssdr_s32f_sincos_32fc(complex_phase_.data(), -phase_step_rad, _phase.data(), vector_length_);
-            start_phase_rad_[sat] += static_cast<float>(vector_length_) * phase_step_rad;
+            volk_gnsssdr_s32f_sincos_32fc(phase, -phase_step_rad, _phase.data(), vector_length_);
 
-            out_idx = 0;
+            auto delay_samples = static_cast<unsigned int>((delay_chips_[sat] % static_cast<int>(GLONASS_L1_CA_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GLONASS_L1_CA_CODE_LENGTH_CHIPS);
 
-            if (system_[sat] == "G")
+            for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
                 {
-                    auto delay_samples = static_cast<unsigned int>((delay_chips_[sat] % static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GPS_L1_CA_CODE_LENGTH_CHIPS);
+                    mix_segment(out_idx, delay_samples, current_data_bits_[sat].real());
+                    out_idx += delay_samples;
 
-                    for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
+                    if (ms_counter_[sat] == 0 && data_flag_)
                         {
-                            for (k = 0; k < delay_samples; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+                            // New random data bit
+                            current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
+                        }
 
-                            if (ms_counter_[sat] == 0 && data_flag_)
-                                {
-                                    // New random data bit
-                                    current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
-                                }
+                    mix_segment(out_idx, samples_per_code_[sat] - delay_samples, current_data_bits_[sat].real());
+                    out_idx += samples_per_code_[sat] - delay_samples;
 
-                            for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+                    ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * GLONASS_L1_CA_CODE_PERIOD_S))) % data_bit_duration_ms_[sat];
+                }
+        }
 
-                            ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * GPS_L1_CA_CODE_PERIOD_S))) % data_bit_duration_ms_[sat];
+    else if (system_[sat] == "E")
+        {
+            if (signal_[sat].at(0) == '5')
+                {
+                    // EACH WORK outputs 1 modulated primary code
+                    int codelen = static_cast<int>(GALILEO_E5A_CODE_LENGTH_CHIPS);
+                    unsigned int delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
+                    mix_e5_segment(out_idx, delay_samples);
+                    out_idx += delay_samples;
+
+                    if (ms_counter_[sat] % data_bit_duration_ms_[sat] == 0 && data_flag_)
+                        {
+                            // New random data bit
+                            current_data_bit_int_[sat] = (uniform_dist(e1) % 2) == 0 ? 1 : -1;
                         }
-                }
+                    data_modulation_[sat] = current_data_bit_int_[sat] * (GALILEO_E5A_I_SECONDARY_CODE[(ms_counter_[sat] + delay_sec_[sat]) % 20] == '0' ? 1 : -1);
+                    pilot_modulation_[sat] = (GALILEO_E5A_Q_SECONDARY_CODE[PRN_[sat] - 1][((ms_counter_[sat] + delay_sec_[sat]) % 100)] == '0' ? 1 : -1);
 
-            else if (system_[sat] == "R")
+                    ms_counter_[sat] = ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E5A_CODE_PERIOD_S));
+
+                    mix_e5_segment(out_idx, samples_per_code_[sat] - delay_samples);
+                    out_idx += samples_per_code_[sat] - delay_samples;
+                }
+            else if (signal_[sat].at(0) == '7')
                 {
-                    phase_step_rad = -static_cast<float>(TWO_PI) * (static_cast<float>(freq) + (static_cast<float>(DFRQ1_GLO) * GLONASS_PRN.at(PRN_[sat])) + doppler_Hz_[sat]) / static_cast<float>(fs_in_);
-                    // std::cout << "sat " << PRN_[sat] << " SG - Freq = " << (freq + (DFRQ1_GLO * GLONASS_PRN.at(PRN_[sat]))) << " Doppler = " << doppler_Hz_[sat] << '\n';
-                    _phase[0] = -start_phase_rad_[sat];
-                    volk_gnsssdr_s32f_sincos_32fc(complex_phase_.data(), -phase_step_rad, _phase.data(), vector_length_);
+                    // EACH WORK outputs 1 modulated primary code
+                    int codelen = static_cast<int>(GALILEO_E5B_CODE_LENGTH_CHIPS);
+                    unsigned int delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
+                    mix_e5_segment(out_idx, delay_samples);
+                    out_idx += delay_samples;
+
+                    if (ms_counter_[sat] % data_bit_duration_ms_[sat] == 0 && data_flag_)
+                        {
+                            // New random data bit
+                            current_data_bit_int_[sat] = (uniform_dist(e1) % 2) == 0 ? 1 : -1;
+                        }
+                    data_modulation_[sat] = current_data_bit_int_[sat] * (GALILEO_E5B_I_SECONDARY_CODE[((ms_counter_[sat] + delay_sec_[sat]) % 4)] == '0' ? 1 : -1);
+                    pilot_modulation_[sat] = (GALILEO_E5B_Q_SECONDARY_CODE[PRN_[sat] - 1][((ms_counter_[sat] + delay_sec_[sat]) % 100)] == '0' ? 1 : -1);
 
-                    auto delay_samples = static_cast<unsigned int>((delay_chips_[sat] % static_cast<int>(GLONASS_L1_CA_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GLONASS_L1_CA_CODE_LENGTH_CHIPS);
+                    ms_counter_[sat] = ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E5B_CODE_PERIOD_S));
 
+                    mix_e5_segment(out_idx, samples_per_code_[sat] - delay_samples);
+                    out_idx += samples_per_code_[sat] - delay_samples;
+                }
+            else if (signal_[sat].at(1) == '6')
+                {
+                    // EACH WORK outputs 1 modulated primary code
+                    int codelen = static_cast<int>(GALILEO_E6_C_CODE_LENGTH_CHIPS);
+                    unsigned int delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
                     for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
                         {
-                            for (k = 0; k < delay_samples; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+                            mix_data_pilot_segment(out_idx, delay_samples);
+                            out_idx += delay_samples;
 
                             if (ms_counter_[sat] == 0 && data_flag_)
                                 {
@@ -405,136 +465,110 @@ int signal_generator_c::general_work(int noutput_items __attribute__((unused)),
                                     current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
                                 }
 
-                            for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+                            mix_data_pilot_segment(out_idx, samples_per_code_[sat] - delay_samples);
+                            out_idx += samples_per_code_[sat] - delay_samples;
 
-                            ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * GLONASS_L1_CA_CODE_PERIOD_S))) % data_bit_duration_ms_[sat];
+                            ms_counter_[sat] = (ms_counter_[sat] + 1) % data_bit_duration_ms_[sat];
                         }
                 }
-
-            else if (system_[sat] == "E")
+            else
                 {
-                    if (signal_[sat].at(0) == '5')
+                    auto delay_samples = static_cast<unsigned int>((delay_chips_[sat] % static_cast<int>(GALILEO_E1_B_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GALILEO_E1_B_CODE_LENGTH_CHIPS);
+
+                    for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
                         {
-                            // EACH WORK outputs 1 modulated primary code
-                            int codelen = static_cast<int>(GALILEO_E5A_CODE_LENGTH_CHIPS);
-                            unsigned int delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
-                            for (k = 0; k < delay_samples; k++)
-                                {
-                                    out[out_idx] += (gr_complex(sampled_code_data_[sat][out_idx].real() * data_modulation_[sat],
-                                                        sampled_code_data_[sat][out_idx].imag() * pilot_modulation_[sat])) *
-                                                    complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+                            mix_data_pilot_segment(out_idx, delay_samples);
+                            out_idx += delay_samples;
 
-                            if (ms_counter_[sat] % data_bit_duration_ms_[sat] == 0 && data_flag_)
+                            if (ms_counter_[sat] == 0 && data_flag_)
                                 {
                                     // New random data bit
-                                    current_data_bit_int_[sat] = (uniform_dist(e1) % 2) == 0 ? 1 : -1;
+                                    current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
                                 }
-                            data_modulation_[sat] = current_data_bit_int_[sat] * (GALILEO_E5A_I_SECONDARY_CODE[(ms_counter_[sat] + delay_sec_[sat]) % 20] == '0' ? 1 : -1);
-                            pilot_modulation_[sat] = (GALILEO_E5A_Q_SECONDARY_CODE[PRN_[sat] - 1][((ms_counter_[sat] + delay_sec_[sat]) % 100)] == '0' ? 1 : -1);
 
-                            ms_counter_[sat] = ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E5A_CODE_PERIOD_S));
+                            mix_data_pilot_segment(out_idx, samples_per_code_[sat] - delay_samples);
+                            out_idx += samples_per_code_[sat] - delay_samples;
 
-                            for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                {
-                                    out[out_idx] += (gr_complex(sampled_code_data_[sat][out_idx].real() * data_modulation_[sat],
-                                                        sampled_code_data_[sat][out_idx].imag() * pilot_modulation_[sat])) *
-                                                    complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+                            ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E1_CODE_PERIOD_S))) % data_bit_duration_ms_[sat];
                         }
-                    else if (signal_[sat].at(0) == '7')
-                        {
-                            // EACH WORK outputs 1 modulated primary code
-                            int codelen = static_cast<int>(GALILEO_E5B_CODE_LENGTH_CHIPS);
-                            unsigned int delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
-                            for (k = 0; k < delay_samples; k++)
-                                {
-                                    out[out_idx] += (gr_complex(sampled_code_data_[sat][out_idx].real() * data_modulation_[sat],
-                                                        sampled_code_data_[sat][out_idx].imag() * pilot_modulation_[sat])) *
-                                                    complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+                }
+        }
 
-                            if (ms_counter_[sat] % data_bit_duration_ms_[sat] == 0 && data_flag_)
-                                {
-                                    // New random data bit
-                                    current_data_bit_int_[sat] = (uniform_dist(e1) % 2) == 0 ? 1 : -1;
-                                }
-                            data_modulation_[sat] = current_data_bit_int_[sat] * (GALILEO_E5B_I_SECONDARY_CODE[((ms_counter_[sat] + delay_sec_[sat]) % 4)] == '0' ? 1 : -1);
-                            pilot_modulation_[sat] = (GALILEO_E5B_Q_SECONDARY_CODE[PRN_[sat] - 1][((ms_counter_[sat] + delay_sec_[sat]) % 100)] == '0' ? 1 : -1);
+    // Zero the tail not covered by complete code periods
+    if (out_idx < vector_length_)
+        {
+            std::fill(sat_buffer_[sat].begin() + out_idx, sat_buffer_[sat].end(), gr_complex(0.0, 0.0));
+        }
+}
 
-                            ms_counter_[sat] = ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E5B_CODE_PERIOD_S));
 
-                            for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                {
-                                    out[out_idx] += (gr_complex(sampled_code_data_[sat][out_idx].real() * data_modulation_[sat],
-                                                        sampled_code_data_[sat][out_idx].imag() * pilot_modulation_[sat])) *
-                                                    complex_phase_[out_idx];
-                                    out_idx++;
-                                }
-                        }
-                    else if (signal_[sat].at(1) == '6')
-                        {
-                            // EACH WORK outputs 1 modulated primary code
-                            int codelen = static_cast<int>(GALILEO_E6_C_CODE_LENGTH_CHIPS);
-                            unsigned int delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
-                            for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
-                                {
-                                    for (k = 0; k < delay_samples; k++)
-                                        {
-                                            out[out_idx] += (sampled_code_data_[sat][out_idx] * current_data_bits_[sat] - sampled_code_pilot_[sat][out_idx]) * complex_phase_[out_idx];
-                                            out_idx++;
-                                        }
-
-                                    if (ms_counter_[sat] == 0 && data_flag_)
-                                        {
-                                            // New random data bit
-                                            current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
-                                        }
-
-                                    for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                        {
-                                            out[out_idx] += (sampled_code_data_[sat][out_idx] * current_data_bits_[sat] - sampled_code_pilot_[sat][out_idx]) * complex_phase_[out_idx];
-                                            out_idx++;
-                                        }
-                                    ms_counter_[sat] = (ms_counter_[sat] + 1) % data_bit_duration_ms_[sat];
-                                }
-                        }
-                    else
-                        {
-                            auto delay_samples = static_cast<unsigned int>((delay_chips_[sat] % static_cast<int>(GALILEO_E1_B_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GALILEO_E1_B_CODE_LENGTH_CHIPS);
+int signal_generator_c::general_work(int noutput_items __attribute__((unused)),
+    gr_vector_int &ninput_items __attribute__((unused)),
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
 
-                            for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
-                                {
-                                    for (k = 0; k < delay_samples; k++)
-                                        {
-                                            out[out_idx] += (sampled_code_data_[sat][out_idx] * current_data_bits_[sat] - sampled_code_pilot_[sat][out_idx]) * complex_phase_[out_idx];
-                                            out_idx++;
-                                        }
-
-                                    if (ms_counter_[sat] == 0 && data_flag_)
-                                        {
-                                            // New random data bit
-                                            current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
-                                        }
-
-                                    for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                        {
-                                            out[out_idx] += (sampled_code_data_[sat][out_idx] * current_data_bits_[sat] - sampled_code_pilot_[sat][out_idx]) * complex_phase_[out_idx];
-                                            out_idx++;
-                                        }
-
-                                    ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E1_CODE_PERIOD_S))) % data_bit_duration_ms_[sat];
-                                }
-                        }
+    work_counter_++;
+
+    std::default_random_engine e1(r());
+    std::default_random_engine e2(r());
+    unsigned int out_idx = 0;
+
+    // One random engine per satellite, seeded here because std::random_device
+    // is not guaranteed to be thread-safe
+    std::vector<std::default_random_engine> sat_engines;
+    sat_engines.reserve(num_sats_);
+    for (unsigned int sat = 0; sat < num_sats_; sat++)
+        {
+            sat_engines.emplace_back(r());
+        }
+
+    // Each satellite synthesizes its contribution into its own buffer
+    if (num_workers_ > 1 and num_sats_ > 1)
+        {
+            std::atomic<unsigned int> next_sat(0);
+            std::vector<std::thread> workers;
+            workers.reserve(num_workers_);
+            for (unsigned int n = 0; n < num_workers_; n++)
+                {
+                    workers.emplace_back([this, &next_sat, &sat_engines]() {
+                        unsigned int sat;
+                        while ((sat = next_sat.fetch_add(1)) < num_sats_)
+                            {
+                                generate_satellite(sat, sat_engines[sat]);
+                            }
+                    });
+                }
+            for (auto &worker : workers)
+                {
+                    worker.join();
+                }
+        }
+    else
+        {
+            for (unsigned int sat = 0; sat < num_sats_; sat++)
+                {
+                    generate_satellite(sat, sat_engines[sat]);
+                }
+        }
+
+    // Mix the satellite contributions into the output vector
+    if (num_sats_ > 0)
+        {
+            memcpy(out, sat_buffer_[0].data(), sizeof(gr_complex) * vector_length_);
+            for (unsigned int sat = 1; sat < num_sats_; sat++)
+                {
+                    volk_32f_x2_add_32f(reinterpret_cast<float *>(out),
+                        reinterpret_cast<float *>(out),
+                        reinterpret_cast<float *>(sat_buffer_[sat].data()),
+                        2 * vector_length_);
                 }
         }
+    else
+        {
+            std::fill(out, out + vector_length_, gr_complex(0.0, 0.0));
+        }
 
     if (noise_flag_)
         {
@@ -99,6 +99,13 @@ private:
 
     void generate_codes();
 
+    /*
+     * Synthesizes the contribution of one satellite (carrier wipe-on, code
+     * modulation and data bits) into sat_buffer_[sat]. Each satellite writes
+     * its own buffer, so the satellites of one work() call run in parallel
+     */
+    void generate_satellite(unsigned int sat, std::default_random_engine &e1);
+
     std::random_device r;
     std::uniform_int_distribution<int> uniform_dist;
     std::normal_distribution<float> normal_dist;
@@ -107,7 +114,8 @@ private:
     std::vector<std::vector<gr_complex>> sampled_code_data_;
     std::vector<std::vector<gr_complex>> sampled_code_pilot_;
     std::vector<gr_complex> current_data_bits_;
-    std::vector<gr_complex> complex_phase_;
+    std::vector<std::vector<gr_complex>> sat_buffer_;  // per-satellite contribution
+    std::vector<std::vector<gr_complex>> sat_phase_;   // per-satellite carrier phase
     std::vector<float> CN0_dB_;
     std::vector<float> doppler_Hz_;
     std::vector<float> start_phase_rad_;
@@ -125,6 +133,7 @@ private:
     unsigned int work_counter_{};
     unsigned int fs_in_;
     unsigned int num_sats_;
+    unsigned int num_workers_;
     unsigned int vector_length_;
     bool data_flag_;
     bool noise_flag_;
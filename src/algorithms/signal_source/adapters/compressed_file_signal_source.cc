@@ -0,0 +1,196 @@
+/*!
+ * \file compressed_file_signal_source.cc
+ * \brief Implementation of a class that reads signal samples from a GSZ1
+ * compressed capture file and adapts it to a SignalSourceInterface
+ * \author Javier Arribas, 2011. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "compressed_file_signal_source.h"
+#include "configuration_interface.h"
+#include "gnss_sdr_flags.h"
+#include "gnss_sdr_valve.h"
+#include <glog/logging.h>
+#include <exception>
+#include <iostream>  // for std::cerr
+
+
+CompressedFileSignalSource::CompressedFileSignalSource(const ConfigurationInterface* configuration,
+    const std::string& role, unsigned int in_streams, unsigned int out_streams,
+    Concurrent_Queue<pmt::pmt_t>* queue) : role_(role), in_streams_(in_streams), out_streams_(out_streams)
+{
+    const std::string default_filename("./example_capture.gsz");
+    const std::string default_dump_filename("./my_capture.dat");
+    const double default_seconds_to_skip = 0.0;
+
+    samples_ = configuration->property(role + ".samples", static_cast<uint64_t>(0));
+    sampling_frequency_ = configuration->property(role + ".sampling_frequency", static_cast<int64_t>(0));
+    filename_ = configuration->property(role + ".filename", default_filename);
+
+    // override value with commandline flag, if present
+    if (FLAGS_signal_source != "-")
+        {
+            filename_ = FLAGS_signal_source;
+        }
+    if (FLAGS_s != "-")
+        {
+            filename_ = FLAGS_s;
+        }
+
+    repeat_ = configuration->property(role + ".repeat", false);
+    dump_ = configuration->property(role + ".dump", false);
+    dump_filename_ = configuration->property(role + ".dump_filename", default_dump_filename);
+    enable_throttle_control_ = configuration->property(role + ".enable_throttle_control", false);
+
+    const double seconds_to_skip = configuration->property(role + ".seconds_to_skip", default_seconds_to_skip);
+
+    // the decoded stream is always int16 items
+    item_size_ = sizeof(int16_t);
+
+    try
+        {
+            source_ = compressed_make_file_source(filename_, repeat_);
+        }
+    catch (const std::exception& e)
+        {
+            std::cerr
+                << "The receiver was configured to work with a compressed capture file\n"
+                << "but the specified file is unreachable by GNSS-SDR or is not a GSZ1 capture.\n"
+                << "Please modify your configuration file\n"
+                << "and point SignalSource.filename to a valid capture. Then:\n"
+                << "$ gnss-sdr --config_file=/path/to/my_GNSS_SDR_configuration.conf\n";
+            LOG(INFO) << "compressed_file_signal_source: Unable to open the samples file "
+                      << filename_.c_str() << ", exiting the program.";
+            throw(e);
+        }
+
+    DLOG(INFO) << "compressed_file_source(" << source_->unique_id() << ")";
+
+    if (sampling_frequency_ == 0)
+        {
+            sampling_frequency_ = static_cast<int64_t>(source_->sampling_frequency());
+        }
+    else if (source_->sampling_frequency() != 0 and
+             static_cast<int64_t>(source_->sampling_frequency()) != sampling_frequency_)
+        {
+            LOG(WARNING) << "The sampling frequency recorded in " << filename_ << " ("
+                         << source_->sampling_frequency() << " Sps) does not match "
+                         << role << ".sampling_frequency";
+        }
+
+    if (seconds_to_skip > 0)
+        {
+            const auto samples_to_skip = static_cast<uint64_t>(seconds_to_skip * static_cast<double>(sampling_frequency_));
+            if (samples_to_skip > 0)
+                {
+                    LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file";
+                    if (not source_->seek(samples_to_skip))
+                        {
+                            LOG(INFO) << "Error skipping samples!";
+                        }
+                }
+        }
+
+    if (samples_ == 0)  // read all file
+        {
+            samples_ = source_->total_samples();
+            std::cout << "Processing file " << filename_ << ", which contains " << samples_ << " samples\n";
+        }
+
+    CHECK(samples_ > 0) << "File does not contain enough samples to process.";
+    const double signal_duration_s = static_cast<double>(samples_) * (1 / static_cast<double>(sampling_frequency_));
+    DLOG(INFO) << "Total number samples to be processed= " << samples_ << " GNSS signal duration= " << signal_duration_s << " [s]";
+    std::cout << "GNSS signal recorded time to be processed: " << signal_duration_s << " [s]\n";
+
+    valve_ = gnss_sdr_make_valve(item_size_, samples_, queue);
+    DLOG(INFO) << "valve(" << valve_->unique_id() << ")";
+
+    if (dump_)
+        {
+            sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+            DLOG(INFO) << "file_sink(" << sink_->unique_id() << ")";
+        }
+
+    if (enable_throttle_control_)
+        {
+            throttle_ = gr::blocks::throttle::make(item_size_, sampling_frequency_);
+        }
+
+    DLOG(INFO) << "File source filename " << filename_;
+    DLOG(INFO) << "Samples " << samples_;
+    DLOG(INFO) << "Sampling frequency " << sampling_frequency_;
+    DLOG(INFO) << "Item size " << item_size_;
+    DLOG(INFO) << "Repeat " << repeat_;
+    DLOG(INFO) << "Dump " << dump_;
+    DLOG(INFO) << "Dump filename " << dump_filename_;
+    if (in_streams_ > 0)
+        {
+            LOG(ERROR) << "A signal source does not have an input stream";
+        }
+    if (out_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+void CompressedFileSignalSource::connect(gr::top_block_sptr top_block)
+{
+    if (enable_throttle_control_ == true)
+        {
+            top_block->connect(source_, 0, throttle_, 0);
+            DLOG(INFO) << "connected compressed file source to throttle";
+            top_block->connect(throttle_, 0, valve_, 0);
+            DLOG(INFO) << "connected throttle to valve";
+        }
+    else
+        {
+            top_block->connect(source_, 0, valve_, 0);
+            DLOG(INFO) << "connected compressed file source to valve";
+        }
+    if (dump_)
+        {
+            top_block->connect(valve_, 0, sink_, 0);
+            DLOG(INFO) << "connected valve to file sink";
+        }
+}
+
+
+void CompressedFileSignalSource::disconnect(gr::top_block_sptr top_block)
+{
+    if (enable_throttle_control_ == true)
+        {
+            top_block->disconnect(source_, 0, throttle_, 0);
+            top_block->disconnect(throttle_, 0, valve_, 0);
+        }
+    else
+        {
+            top_block->disconnect(source_, 0, valve_, 0);
+        }
+    if (dump_)
+        {
+            top_block->disconnect(valve_, 0, sink_, 0);
+        }
+}
+
+
+gr::basic_block_sptr CompressedFileSignalSource::get_left_block()
+{
+    LOG(WARNING) << "Left block of a signal source should not be retrieved";
+    return compressed_file_source_sptr();
+}
+
+
+gr::basic_block_sptr CompressedFileSignalSource::get_right_block()
+{
+    return valve_;
+}
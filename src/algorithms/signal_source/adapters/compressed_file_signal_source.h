@@ -0,0 +1,116 @@
+/*!
+ * \file compressed_file_signal_source.h
+ * \brief Interface of a class that reads signal samples from a GSZ1
+ * compressed capture file and adapts it to a SignalSourceInterface
+ * \author Javier Arribas, 2011. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_COMPRESSED_FILE_SIGNAL_SOURCE_H
+#define GNSS_SDR_COMPRESSED_FILE_SIGNAL_SOURCE_H
+
+#include "compressed_file_source.h"
+#include "concurrent_queue.h"
+#include "gnss_block_interface.h"
+#include <gnuradio/blocks/file_sink.h>
+#include <gnuradio/blocks/throttle.h>
+#include <gnuradio/hier_block2.h>
+#include <pmt/pmt.h>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_adapters
+ * \{ */
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Class that reads signal samples from a GSZ1 compressed capture file
+ * (see gnss_sdr_capture_codec.h) and adapts it to a SignalSourceInterface.
+ * The decoded stream is delivered as short items.
+ */
+class CompressedFileSignalSource : public GNSSBlockInterface
+{
+public:
+    CompressedFileSignalSource(const ConfigurationInterface* configuration, const std::string& role,
+        unsigned int in_streams, unsigned int out_streams,
+        Concurrent_Queue<pmt::pmt_t>* queue);
+
+    ~CompressedFileSignalSource() = default;
+
+    inline std::string role() override
+    {
+        return role_;
+    }
+
+    /*!
+     * \brief Returns "Compressed_File_Signal_Source".
+     */
+    inline std::string implementation() override
+    {
+        return "Compressed_File_Signal_Source";
+    }
+
+    inline size_t item_size() override
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+    inline std::string filename() const
+    {
+        return filename_;
+    }
+
+    inline int64_t sampling_frequency() const
+    {
+        return sampling_frequency_;
+    }
+
+    inline uint64_t samples() const
+    {
+        return samples_;
+    }
+
+private:
+    compressed_file_source_sptr source_;
+    gnss_shared_ptr<gr::block> valve_;
+    gr::blocks::file_sink::sptr sink_;
+    gr::blocks::throttle::sptr throttle_;
+
+    std::string role_;
+    std::string filename_;
+    std::string dump_filename_;
+
+    uint64_t samples_;
+    int64_t sampling_frequency_;
+    size_t item_size_;
+
+    uint32_t in_streams_;
+    uint32_t out_streams_;
+
+    bool enable_throttle_control_;
+    bool repeat_;
+    bool dump_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_COMPRESSED_FILE_SIGNAL_SOURCE_H
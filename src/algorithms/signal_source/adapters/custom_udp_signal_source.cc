@@ -44,6 +44,12 @@ CustomUDPSignalSource::CustomUDPSignalSource(const ConfigurationInterface* confi
     channels_in_udp_ = configuration->property(role + ".channels_in_udp", 1);
     IQ_swap_ = configuration->property(role + ".IQ_swap", false);
 
+    // batched datagram reception (Linux only): pulls up to 64 datagrams per
+    // recvmmsg() syscall instead of one per pcap callback, optionally pinning
+    // the capture thread to a CPU core
+    const bool use_recvmmsg = configuration->property(role + ".use_recvmmsg", false);
+    const int capture_cpu = configuration->property(role + ".capture_cpu", -1);
+
     const std::string default_sample_type("cbyte");
     const std::string sample_type = configuration->property(role + ".sample_type", default_sample_type);
     item_type_ = configuration->property(role + ".item_type", default_item_type);
@@ -57,7 +63,9 @@ CustomUDPSignalSource::CustomUDPSignalSource(const ConfigurationInterface* confi
         channels_in_udp_,
         sample_type,
         item_size_,
-        IQ_swap_);
+        IQ_swap_,
+        use_recvmmsg,
+        capture_cpu);
 
     if (channels_in_udp_ >= RF_channels_)
         {
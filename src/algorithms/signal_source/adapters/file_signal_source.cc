@@ -57,6 +57,11 @@ FileSignalSource::FileSignalSource(const ConfigurationInterface* configuration,
     dump_ = configuration->property(role + ".dump", false);
     dump_filename_ = configuration->property(role + ".dump_filename", default_dump_filename);
     enable_throttle_control_ = configuration->property(role + ".enable_throttle_control", false);
+    // Memory-mapped reading avoids the read() syscall path of
+    // gr::blocks::file_source in long post-processing runs. The readahead
+    // window (in MiB) is kept warm ahead of the read position
+    enable_mmap_ = configuration->property(role + ".enable_mmap", false);
+    const int64_t mmap_readahead_mb = configuration->property(role + ".mmap_readahead_mb", static_cast<int64_t>(64));
 
     const double seconds_to_skip = configuration->property(role + ".seconds_to_skip", default_seconds_to_skip);
     const size_t header_size = configuration->property(role + ".header_size", 0);
@@ -98,7 +103,15 @@ FileSignalSource::FileSignalSource(const ConfigurationInterface* configuration,
         }
     try
         {
-            file_source_ = gr::blocks::file_source::make(item_size_, filename_.c_str(), repeat_);
+            if (enable_mmap_)
+                {
+                    mmap_source_ = mmap_make_file_source(item_size_, filename_, repeat_,
+                        static_cast<uint64_t>(mmap_readahead_mb) * 1024ULL * 1024ULL);
+                }
+            else
+                {
+                    file_source_ = gr::blocks::file_source::make(item_size_, filename_.c_str(), repeat_);
+                }
 
             if (seconds_to_skip > 0)
                 {
@@ -117,7 +130,8 @@ FileSignalSource::FileSignalSource(const ConfigurationInterface* configuration,
             if (samples_to_skip > 0)
                 {
                     LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file";
-                    if (not file_source_->seek(samples_to_skip, SEEK_SET))
+                    const bool seek_ok = enable_mmap_ ? mmap_source_->seek(samples_to_skip) : file_source_->seek(samples_to_skip, SEEK_SET);
+                    if (not seek_ok)
                         {
                             LOG(INFO) << "Error skipping bytes!";
                         }
@@ -150,7 +164,14 @@ FileSignalSource::FileSignalSource(const ConfigurationInterface* configuration,
             throw(e);
         }
 
-    DLOG(INFO) << "file_source(" << file_source_->unique_id() << ")";
+    if (enable_mmap_)
+        {
+            DLOG(INFO) << "mmap_file_source(" << mmap_source_->unique_id() << ")";
+        }
+    else
+        {
+            DLOG(INFO) << "file_source(" << file_source_->unique_id() << ")";
+        }
 
     if (samples_ == 0)  // read all file
         {
@@ -216,6 +237,7 @@ FileSignalSource::FileSignalSource(const ConfigurationInterface* configuration,
     DLOG(INFO) << "Item type " << item_type_;
     DLOG(INFO) << "Item size " << item_size_;
     DLOG(INFO) << "Repeat " << repeat_;
+    DLOG(INFO) << "Mmap " << enable_mmap_;
     DLOG(INFO) << "Dump " << dump_;
     DLOG(INFO) << "Dump filename " << dump_filename_;
     if (in_streams_ > 0)
@@ -229,13 +251,23 @@ FileSignalSource::FileSignalSource(const ConfigurationInterface* configuration,
 }
 
 
+gr::basic_block_sptr FileSignalSource::source_block()
+{
+    if (enable_mmap_)
+        {
+            return mmap_source_;
+        }
+    return file_source_;
+}
+
+
 void FileSignalSource::connect(gr::top_block_sptr top_block)
 {
     if (samples_ > 0)
         {
             if (enable_throttle_control_ == true)
                 {
-                    top_block->connect(file_source_, 0, throttle_, 0);
+                    top_block->connect(source_block(), 0, throttle_, 0);
                     DLOG(INFO) << "connected file source to throttle";
                     top_block->connect(throttle_, 0, valve_, 0);
                     DLOG(INFO) << "connected throttle to valve";
@@ -247,7 +279,7 @@ void FileSignalSource::connect(gr::top_block_sptr top_block)
                 }
             else
                 {
-                    top_block->connect(file_source_, 0, valve_, 0);
+                    top_block->connect(source_block(), 0, valve_, 0);
                     DLOG(INFO) << "connected file source to valve";
                     if (dump_)
                         {
@@ -260,11 +292,11 @@ void FileSignalSource::connect(gr::top_block_sptr top_block)
         {
             if (enable_throttle_control_ == true)
                 {
-                    top_block->connect(file_source_, 0, throttle_, 0);
+                    top_block->connect(source_block(), 0, throttle_, 0);
                     DLOG(INFO) << "connected file source to throttle";
                     if (dump_)
                         {
-                            top_block->connect(file_source_, 0, sink_, 0);
+                            top_block->connect(source_block(), 0, sink_, 0);
                             DLOG(INFO) << "connected file source to sink";
                         }
                 }
@@ -272,7 +304,7 @@ void FileSignalSource::connect(gr::top_block_sptr top_block)
                 {
                     if (dump_)
                         {
-                            top_block->connect(file_source_, 0, sink_, 0);
+                            top_block->connect(source_block(), 0, sink_, 0);
                             DLOG(INFO) << "connected file source to sink";
                         }
                 }
@@ -286,7 +318,7 @@ void FileSignalSource::disconnect(gr::top_block_sptr top_block)
         {
             if (enable_throttle_control_ == true)
                 {
-                    top_block->disconnect(file_source_, 0, throttle_, 0);
+                    top_block->disconnect(source_block(), 0, throttle_, 0);
                     DLOG(INFO) << "disconnected file source to throttle";
                     top_block->disconnect(throttle_, 0, valve_, 0);
                     DLOG(INFO) << "disconnected throttle to valve";
@@ -298,7 +330,7 @@ void FileSignalSource::disconnect(gr::top_block_sptr top_block)
                 }
             else
                 {
-                    top_block->disconnect(file_source_, 0, valve_, 0);
+                    top_block->disconnect(source_block(), 0, valve_, 0);
                     DLOG(INFO) << "disconnected file source to valve";
                     if (dump_)
                         {
@@ -311,11 +343,11 @@ void FileSignalSource::disconnect(gr::top_block_sptr top_block)
         {
             if (enable_throttle_control_ == true)
                 {
-                    top_block->disconnect(file_source_, 0, throttle_, 0);
+                    top_block->disconnect(source_block(), 0, throttle_, 0);
                     DLOG(INFO) << "disconnected file source to throttle";
                     if (dump_)
                         {
-                            top_block->disconnect(file_source_, 0, sink_, 0);
+                            top_block->disconnect(source_block(), 0, sink_, 0);
                             DLOG(INFO) << "disconnected file source to sink";
                         }
                 }
@@ -323,7 +355,7 @@ void FileSignalSource::disconnect(gr::top_block_sptr top_block)
                 {
                     if (dump_)
                         {
-                            top_block->disconnect(file_source_, 0, sink_, 0);
+                            top_block->disconnect(source_block(), 0, sink_, 0);
                             DLOG(INFO) << "disconnected file source to sink";
                         }
                 }
@@ -348,5 +380,5 @@ gr::basic_block_sptr FileSignalSource::get_right_block()
         {
             return throttle_;
         }
-    return file_source_;
+    return source_block();
 }
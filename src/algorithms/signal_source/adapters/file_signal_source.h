@@ -23,6 +23,7 @@
 
 #include "concurrent_queue.h"
 #include "gnss_block_interface.h"
+#include "mmap_file_source.h"
 #include <gnuradio/blocks/file_sink.h>
 #include <gnuradio/blocks/file_source.h>
 #include <gnuradio/blocks/throttle.h>
@@ -103,7 +104,11 @@ public:
     }
 
 private:
+    //! Returns the block actually reading the file (mmap-backed or gr::blocks::file_source)
+    gr::basic_block_sptr source_block();
+
     gr::blocks::file_source::sptr file_source_;
+    mmap_file_source_sptr mmap_source_;
     gnss_shared_ptr<gr::block> valve_;
     gr::blocks::file_sink::sptr sink_;
     gr::blocks::throttle::sptr throttle_;
@@ -121,6 +126,7 @@ private:
     uint32_t out_streams_;
 
     bool enable_throttle_control_;
+    bool enable_mmap_;
     bool repeat_;
     bool dump_;
 };
@@ -17,6 +17,7 @@
 
 #include "multichannel_file_signal_source.h"
 #include "configuration_interface.h"
+#include "multichannel_prefetch_file_source.h"
 #include "gnss_sdr_flags.h"
 #include "gnss_sdr_valve.h"
 #include <glog/logging.h>
@@ -48,6 +49,12 @@ MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationIn
     item_type_ = configuration->property(role + ".item_type", default_item_type);
     repeat_ = configuration->property(role + ".repeat", false);
     enable_throttle_control_ = configuration->property(role + ".enable_throttle_control", false);
+    // If set, all the files are serviced by a single reader thread doing
+    // large sequential reads into a shared prefetch cache, instead of N
+    // file_source blocks competing for the disk
+    enable_prefetch_ = configuration->property(role + ".enable_prefetch", false);
+    const int prefetch_chunk_mb = configuration->property(role + ".prefetch_chunk_mb", 4);
+    const int prefetch_chunks_per_band = configuration->property(role + ".prefetch_chunks_per_band", 4);
 
     const double seconds_to_skip = configuration->property(role + ".seconds_to_skip", default_seconds_to_skip);
     size_t header_size = configuration->property(role + ".header_size", 0);
@@ -87,32 +94,47 @@ MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationIn
                          << " unrecognized item type. Using gr_complex.";
             item_size_ = sizeof(gr_complex);
         }
-    try
+    if (seconds_to_skip > 0)
         {
-            for (int32_t n = 0; n < n_channels_; n++)
+            samples_to_skip = static_cast<int64_t>(seconds_to_skip * sampling_frequency_);
+
+            if (is_complex)
                 {
-                    file_source_vec_.push_back(gr::blocks::file_source::make(item_size_, filename_vec_.at(n).c_str(), repeat_));
+                    samples_to_skip *= 2;
+                }
+        }
+    if (header_size > 0)
+        {
+            samples_to_skip += header_size;
+        }
 
-                    if (seconds_to_skip > 0)
+    try
+        {
+            if (enable_prefetch_)
+                {
+                    prefetch_source_ = multichannel_prefetch_make_file_source(item_size_,
+                        filename_vec_, repeat_,
+                        static_cast<uint64_t>(samples_to_skip) * item_size_,
+                        static_cast<size_t>(prefetch_chunk_mb) * 1024ULL * 1024ULL,
+                        static_cast<size_t>(prefetch_chunks_per_band));
+                    if (samples_to_skip > 0)
                         {
-                            samples_to_skip = static_cast<int64_t>(seconds_to_skip * sampling_frequency_);
-
-                            if (is_complex)
-                                {
-                                    samples_to_skip *= 2;
-                                }
+                            LOG(INFO) << "Skipping " << samples_to_skip << " samples of each input file";
                         }
-                    if (header_size > 0)
+                }
+            else
+                {
+                    for (int32_t n = 0; n < n_channels_; n++)
                         {
-                            samples_to_skip += header_size;
-                        }
+                            file_source_vec_.push_back(gr::blocks::file_source::make(item_size_, filename_vec_.at(n).c_str(), repeat_));
 
-                    if (samples_to_skip > 0)
-                        {
-                            LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file #" << n;
-                            if (not file_source_vec_.back()->seek(samples_to_skip, SEEK_SET))
+                            if (samples_to_skip > 0)
                                 {
-                                    LOG(INFO) << "Error skipping bytes!";
+                                    LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file #" << n;
+                                    if (not file_source_vec_.back()->seek(samples_to_skip, SEEK_SET))
+                                        {
+                                            LOG(INFO) << "Error skipping bytes!";
+                                        }
                                 }
                         }
                 }
@@ -222,13 +244,26 @@ MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationIn
 }
 
 
+gr::basic_block_sptr MultichannelFileSignalSource::source_block(int32_t n)
+{
+    if (enable_prefetch_)
+        {
+            return prefetch_source_;
+        }
+    return file_source_vec_.at(n);
+}
+
+
 void MultichannelFileSignalSource::connect(gr::top_block_sptr top_block)
 {
+    // with the prefetching source all the bands come out of different ports
+    // of the same block; with independent file sources, out of port 0 of
+    // different blocks
     if (enable_throttle_control_ == true)
         {
             for (int32_t n = 0; n < n_channels_; n++)
                 {
-                    top_block->connect(file_source_vec_.at(n), 0, throttle_vec_.at(n), 0);
+                    top_block->connect(source_block(n), (enable_prefetch_ ? n : 0), throttle_vec_.at(n), 0);
                     DLOG(INFO) << "connected file_source #" << n << " to throttle";
                     top_block->connect(throttle_vec_.at(n), 0, valve_, n);
                     DLOG(INFO) << "connected throttle #" << n << " to valve_";
@@ -238,7 +273,7 @@ void MultichannelFileSignalSource::connect(gr::top_block_sptr top_block)
         {
             for (int32_t n = 0; n < n_channels_; n++)
                 {
-                    top_block->connect(file_source_vec_.at(n), 0, valve_, n);
+                    top_block->connect(source_block(n), (enable_prefetch_ ? n : 0), valve_, n);
                     DLOG(INFO) << "connected file_source #" << n << " to valve_";
                 }
         }
@@ -251,7 +286,7 @@ void MultichannelFileSignalSource::disconnect(gr::top_block_sptr top_block)
         {
             for (int32_t n = 0; n < n_channels_; n++)
                 {
-                    top_block->disconnect(file_source_vec_.at(n), 0, throttle_vec_.at(n), 0);
+                    top_block->disconnect(source_block(n), (enable_prefetch_ ? n : 0), throttle_vec_.at(n), 0);
                     DLOG(INFO) << "disconnected file_source #" << n << " to throttle";
                     top_block->disconnect(throttle_vec_.at(n), 0, valve_, n);
                     DLOG(INFO) << "disconnected throttle #" << n << " to valve_";
@@ -261,7 +296,7 @@ void MultichannelFileSignalSource::disconnect(gr::top_block_sptr top_block)
         {
             for (int32_t n = 0; n < n_channels_; n++)
                 {
-                    top_block->disconnect(file_source_vec_.at(n), 0, valve_, n);
+                    top_block->disconnect(source_block(n), (enable_prefetch_ ? n : 0), valve_, n);
                     DLOG(INFO) << "disconnected file_source #" << n << " to valve_";
                 }
         }
@@ -23,6 +23,7 @@
 
 #include "concurrent_queue.h"
 #include "gnss_block_interface.h"
+#include "multichannel_prefetch_file_source.h"
 #include <gnuradio/blocks/file_sink.h>
 #include <gnuradio/blocks/file_source.h>
 #include <gnuradio/blocks/throttle.h>
@@ -103,7 +104,13 @@ public:
     }
 
 private:
+    // the bands are delivered either by independent file_source blocks or,
+    // when <role>.enable_prefetch is set, by a single-reader prefetching
+    // source with one synchronized output per band
+    gr::basic_block_sptr source_block(int32_t n);
+
     std::vector<gr::blocks::file_source::sptr> file_source_vec_;
+    multichannel_prefetch_file_source_sptr prefetch_source_;
     gnss_shared_ptr<gr::block> valve_;
     gr::blocks::file_sink::sptr sink_;
     std::vector<gr::blocks::throttle::sptr> throttle_vec_;
@@ -117,6 +124,7 @@ private:
     uint32_t in_streams_;
     uint32_t out_streams_;
     bool repeat_;
+    bool enable_prefetch_;
     // Throttle control
     bool enable_throttle_control_;
 };
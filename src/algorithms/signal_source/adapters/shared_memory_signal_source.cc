@@ -0,0 +1,107 @@
+/*!
+ * \file shared_memory_signal_source.cc
+ * \brief Signal source that consumes a per-band sample stream published in
+ * shared memory by an ingest process (multi-process sharding mode)
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#include "shared_memory_signal_source.h"
+#include "configuration_interface.h"
+#include <glog/logging.h>
+#include <cmath>  // for fabs
+
+
+SharedMemorySignalSource::SharedMemorySignalSource(const ConfigurationInterface* configuration,
+    const std::string& role, unsigned int in_stream, unsigned int out_stream,
+    Concurrent_Queue<pmt::pmt_t>* queue __attribute__((unused))) : role_(role), in_stream_(in_stream), out_stream_(out_stream)
+{
+    const std::string default_dump_file("./data/signal_source.dat");
+    const std::string default_shm_name("/gnsssdr_band_0");
+    dump_ = configuration->property(role + ".dump", false);
+    dump_filename_ = configuration->property(role + ".dump_filename", default_dump_file);
+    shm_name_ = configuration->property(role + ".shm_name", default_shm_name);
+    const double attach_timeout_s = configuration->property(role + ".attach_timeout_s", 30.0);
+
+    const std::string default_item_type("gr_complex");
+    const std::string item_type = configuration->property(role + ".item_type", default_item_type);
+    if (item_type != "gr_complex")
+        {
+            LOG(WARNING) << item_type << " unrecognized item type. Using gr_complex.";
+        }
+    // the conditioned stream is published as gr_complex
+    item_size_ = sizeof(gr_complex);
+
+    shm_source_ = make_shm_sample_source_cc(shm_name_, attach_timeout_s);
+
+    // the published stream is already conditioned, so a mismatch between the
+    // ingest rate and this process' configuration is a deployment error
+    const double fs_conf = configuration->property("GNSS-SDR.internal_fs_sps", 0.0);
+    const double fs_ring = shm_source_->publisher_sample_rate();
+    if (fs_conf > 0.0 and fs_ring > 0.0 and std::fabs(fs_conf - fs_ring) > 1.0)
+        {
+            LOG(WARNING) << "GNSS-SDR.internal_fs_sps=" << fs_conf
+                         << " but the ingest process publishes " << fs_ring
+                         << " Sps on " << shm_name_ << ". Check the band configurations.";
+        }
+
+    if (dump_)
+        {
+            DLOG(INFO) << "Dumping output into file " << dump_filename_;
+            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+        }
+    if (in_stream_ > 0)
+        {
+            LOG(ERROR) << "A signal source does not have an input stream";
+        }
+    if (out_stream_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+void SharedMemorySignalSource::connect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->connect(shm_source_, 0, file_sink_, 0);
+            DLOG(INFO) << "connected shm_source to file sink";
+        }
+    else
+        {
+            DLOG(INFO) << "nothing to connect internally";
+        }
+}
+
+
+void SharedMemorySignalSource::disconnect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->disconnect(shm_source_, 0, file_sink_, 0);
+        }
+}
+
+
+gr::basic_block_sptr SharedMemorySignalSource::get_left_block()
+{
+    LOG(WARNING) << "Left block of a signal source should not be retrieved";
+    return gr::block_sptr();
+}
+
+
+gr::basic_block_sptr SharedMemorySignalSource::get_right_block()
+{
+    return shm_source_;
+}
@@ -0,0 +1,93 @@
+/*!
+ * \file shared_memory_signal_source.h
+ * \brief Signal source that consumes a per-band sample stream published in
+ * shared memory by an ingest process (multi-process sharding mode)
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SHARED_MEMORY_SIGNAL_SOURCE_H
+#define GNSS_SDR_SHARED_MEMORY_SIGNAL_SOURCE_H
+
+#include "concurrent_queue.h"
+#include "gnss_block_interface.h"
+#include "shm_sample_source_cc.h"
+#include <gnuradio/blocks/file_sink.h>
+#include <pmt/pmt.h>
+#include <cstddef>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_adapters
+ * \{ */
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief This class reads gr_complex samples from a shared-memory ring
+ * created by a SignalConditioner with enable_shm_publish set in another
+ * process, giving each band receiver process a zero-copy local sample feed.
+ */
+class SharedMemorySignalSource : public GNSSBlockInterface
+{
+public:
+    SharedMemorySignalSource(const ConfigurationInterface* configuration,
+        const std::string& role, unsigned int in_stream,
+        unsigned int out_stream, Concurrent_Queue<pmt::pmt_t>* queue);
+
+    ~SharedMemorySignalSource() = default;
+
+    inline std::string role() override
+    {
+        return role_;
+    }
+
+    /*!
+     * \brief Returns "SharedMemory_Signal_Source"
+     */
+    inline std::string implementation() override
+    {
+        return "SharedMemory_Signal_Source";
+    }
+
+    inline size_t item_size() override
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+private:
+    shm_sample_source_cc_sptr shm_source_;
+    gnss_shared_ptr<gr::block> file_sink_;
+
+    std::string role_;
+    std::string shm_name_;
+    std::string dump_filename_;
+
+    size_t item_size_;
+
+    unsigned int in_stream_;
+    unsigned int out_stream_;
+
+    bool dump_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SHARED_MEMORY_SIGNAL_SOURCE_H
@@ -122,6 +122,11 @@ public:
         return reverse_interleaving_;
     }
 
+    inline bool byte_output() const
+    {
+        return byte_output_;
+    }
+
 private:
     gr::blocks::file_source::sptr file_source_;
     unpack_2bit_samples_sptr unpack_samples_;
@@ -143,6 +148,7 @@ private:
     bool big_endian_bytes_;
     bool is_complex_;
     bool reverse_interleaving_;
+    bool byte_output_;
     bool repeat_;
     bool dump_;
     // Throttle control
@@ -118,6 +118,31 @@ UhdSignalSource::UhdSignalSource(const ConfigurationInterface* configuration,
             uhd_stream_args_ = uhd::stream_args_t("sc16");
         }
 
+    // Over-the-wire format (the device native sc16 when left empty). With
+    // item_type=cshort the host-side converter then degenerates into a plain
+    // copy into the flowgraph buffer, so the int16 wire samples reach the
+    // conditioner untouched. sc8 halves the link load at the expense of
+    // dynamic range
+    const std::string wire_format = configuration->property(role + ".wire_format", empty);
+    if (empty != wire_format)
+        {
+            uhd_stream_args_.otw_format = wire_format;
+        }
+
+    // Transport tuning: bigger / more receive frames reduce the per-packet
+    // overhead at high sample rates (values are transport dependent, see the
+    // UHD transport notes)
+    const std::string recv_frame_size = configuration->property(role + ".recv_frame_size", empty);
+    if (empty != recv_frame_size)
+        {
+            dev_addr["recv_frame_size"] = recv_frame_size;
+        }
+    const std::string num_recv_frames = configuration->property(role + ".num_recv_frames", empty);
+    if (empty != num_recv_frames)
+        {
+            dev_addr["num_recv_frames"] = num_recv_frames;
+        }
+
     // select the number of channels and the subdevice specifications
     for (int i = 0; i < RF_channels_; i++)
         {
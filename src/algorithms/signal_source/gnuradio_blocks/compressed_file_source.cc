@@ -0,0 +1,87 @@
+/*!
+ * \file compressed_file_source.cc
+ *
+ * \brief Streams int16 samples out of a GSZ1 compressed capture file
+ * \author Javier Arribas jarribas (at) cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "compressed_file_source.h"
+#include <gnuradio/io_signature.h>
+#include <stdexcept>
+
+
+compressed_file_source_sptr compressed_make_file_source(
+    const std::string &filename,
+    bool repeat)
+{
+    return compressed_file_source_sptr(new compressed_file_source(filename, repeat));
+}
+
+
+compressed_file_source::compressed_file_source(const std::string &filename, bool repeat)
+    : gr::sync_block("compressed_file_source",
+          gr::io_signature::make(0, 0, 0),
+          gr::io_signature::make(1, 1, sizeof(int16_t))),
+      d_reader(filename),
+      d_repeat(repeat)
+{
+    if (!d_reader.is_open())
+        {
+            throw std::runtime_error("compressed_file_source: can't open GSZ1 capture file " + filename);
+        }
+}
+
+
+uint64_t compressed_file_source::total_samples() const
+{
+    return d_reader.total_samples();
+}
+
+
+uint64_t compressed_file_source::sampling_frequency() const
+{
+    return d_reader.sampling_frequency();
+}
+
+
+bool compressed_file_source::seek(uint64_t sample_offset)
+{
+    return d_reader.seek_to_sample(sample_offset);
+}
+
+
+int compressed_file_source::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    auto *out = reinterpret_cast<int16_t *>(output_items[0]);
+    uint32_t produced = 0;
+    while (produced < static_cast<uint32_t>(noutput_items))
+        {
+            const uint32_t got = d_reader.read_samples(out + produced, static_cast<uint32_t>(noutput_items) - produced);
+            if (got == 0)
+                {
+                    if (!d_repeat or !d_reader.seek_to_sample(0))
+                        {
+                            break;
+                        }
+                    continue;
+                }
+            produced += got;
+        }
+    if (produced == 0)
+        {
+            return -1;  // end of file, signal done to the scheduler
+        }
+    return static_cast<int>(produced);
+}
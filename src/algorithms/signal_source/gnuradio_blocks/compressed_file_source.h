@@ -0,0 +1,78 @@
+/*!
+ * \file compressed_file_source.h
+ *
+ * \brief Streams int16 samples out of a GSZ1 compressed capture file
+ * \author Javier Arribas jarribas (at) cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_COMPRESSED_FILE_SOURCE_H
+#define GNSS_SDR_COMPRESSED_FILE_SOURCE_H
+
+#include "gnss_block_interface.h"
+#include "gnss_sdr_capture_codec.h"
+#include <gnuradio/sync_block.h>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class compressed_file_source;
+
+using compressed_file_source_sptr = gnss_shared_ptr<compressed_file_source>;
+
+compressed_file_source_sptr compressed_make_file_source(
+    const std::string &filename,
+    bool repeat);
+
+/*!
+ * \brief This class streams the int16 samples of a GSZ1 compressed capture
+ * file, decoding one bit-packed frame at a time (see
+ * gnss_sdr_capture_codec.h for the container format).
+ */
+class compressed_file_source : public gr::sync_block
+{
+public:
+    ~compressed_file_source() = default;
+
+    //! Total number of samples stored in the capture
+    uint64_t total_samples() const;
+
+    //! Sampling frequency recorded in the capture header, 0 if unset
+    uint64_t sampling_frequency() const;
+
+    //! Moves the read position to the given sample offset
+    bool seek(uint64_t sample_offset);
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend compressed_file_source_sptr compressed_make_file_source(
+        const std::string &filename,
+        bool repeat);
+
+    compressed_file_source(const std::string &filename, bool repeat);
+
+    Gnss_Sdr_Capture_File_Reader d_reader;
+    bool d_repeat;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_COMPRESSED_FILE_SOURCE_H
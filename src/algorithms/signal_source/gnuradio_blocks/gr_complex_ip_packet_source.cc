@@ -19,15 +19,29 @@
 
 #include "gr_complex_ip_packet_source.h"
 #include <gnuradio/io_signature.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
 #include <array>
+#include <cerrno>
 #include <cstdint>
 #include <utility>
+#include <vector>
 #if HAS_GENERIC_LAMBDA
 #else
 #include <boost/bind/bind.hpp>
 #endif
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
 
 const int FIFO_SIZE = 1472000;
+const int RECVMMSG_BATCH = 64;  // datagrams pulled per syscall in recvmmsg mode
 
 
 /* 4 bytes IP address */
@@ -75,7 +89,9 @@ Gr_Complex_Ip_Packet_Source::make(std::string src_device,
     int n_baseband_channels,
     const std::string &wire_sample_type,
     size_t item_size,
-    bool IQ_swap_)
+    bool IQ_swap_,
+    bool use_recvmmsg,
+    int capture_cpu)
 {
     return gnuradio::get_initial_sptr(new Gr_Complex_Ip_Packet_Source(std::move(src_device),
         origin_address,
@@ -84,7 +100,9 @@ Gr_Complex_Ip_Packet_Source::make(std::string src_device,
         n_baseband_channels,
         wire_sample_type,
         item_size,
-        IQ_swap_));
+        IQ_swap_,
+        use_recvmmsg,
+        capture_cpu));
 }
 
 
@@ -98,7 +116,9 @@ Gr_Complex_Ip_Packet_Source::Gr_Complex_Ip_Packet_Source(std::string src_device,
     int n_baseband_channels,
     const std::string &wire_sample_type,
     size_t item_size,
-    bool IQ_swap_)
+    bool IQ_swap_,
+    bool use_recvmmsg,
+    int capture_cpu)
     : gr::sync_block("gr_complex_ip_packet_source",
           gr::io_signature::make(0, 0, 0),
           gr::io_signature::make(1, 4, item_size))  // 1 to 4 baseband complex channels
@@ -131,9 +151,21 @@ Gr_Complex_Ip_Packet_Source::Gr_Complex_Ip_Packet_Source(std::string src_device,
     d_udp_port = udp_port;
     d_udp_payload_size = udp_packet_size;
     d_fifo_full = false;
-
-    // allocate signal samples buffer
-    fifo_buff = new char[FIFO_SIZE];
+    d_use_recvmmsg = use_recvmmsg;
+    d_capture_cpu = capture_cpu;
+    d_capture_stop = false;
+
+    // allocate signal samples buffer, backed by transparent hugepages when
+    // the kernel provides them (fewer TLB misses on the capture hot path)
+    fifo_buff = static_cast<char *>(mmap(nullptr, FIFO_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (fifo_buff == MAP_FAILED)
+        {
+            std::cout << "Error allocating the sample FIFO\n";
+            exit(0);
+        }
+#ifdef MADV_HUGEPAGE
+    madvise(fifo_buff, FIFO_SIZE, MADV_HUGEPAGE);
+#endif
     fifo_read_ptr = 0;
     fifo_write_ptr = 0;
     fifo_items = 0;
@@ -151,6 +183,29 @@ Gr_Complex_Ip_Packet_Source::Gr_Complex_Ip_Packet_Source(std::string src_device,
 bool Gr_Complex_Ip_Packet_Source::start()
 {
     std::cout << "gr_complex_ip_packet_source START\n";
+#if defined(__linux__)
+    if (d_use_recvmmsg)
+        {
+            // batched UDP reception: no pcap device, read straight from the socket
+            if (open_udp_socket() == false)
+                {
+                    return false;
+                }
+            d_capture_stop = false;
+            d_pcap_thread = new boost::thread(
+#if HAS_GENERIC_LAMBDA
+                [this] { my_recvmmsg_loop(); });
+#else
+                boost::bind(&Gr_Complex_Ip_Packet_Source::my_recvmmsg_loop, this));
+#endif
+            return true;
+        }
+#else
+    if (d_use_recvmmsg)
+        {
+            std::cout << "recvmmsg mode is only available on Linux, falling back to pcap capture\n";
+        }
+#endif
     // open the ethernet device
     if (open() == true)
         {
@@ -171,6 +226,15 @@ bool Gr_Complex_Ip_Packet_Source::start()
 bool Gr_Complex_Ip_Packet_Source::stop()
 {
     std::cout << "gr_complex_ip_packet_source STOP\n";
+    if (d_use_recvmmsg and d_pcap_thread != nullptr)
+        {
+            d_capture_stop = true;
+            // unblock the capture thread waiting on recvmmsg()
+            shutdown(d_sock_raw, SHUT_RDWR);
+            d_pcap_thread->join();
+            close(d_sock_raw);
+            return true;
+        }
     if (descr != nullptr)
         {
             pcap_breakloop(descr);
@@ -194,6 +258,12 @@ bool Gr_Complex_Ip_Packet_Source::open()
             return false;
         }
     // bind UDP port to avoid automatic reply with ICMP port unreachable packets from kernel
+    return open_udp_socket();
+}
+
+
+bool Gr_Complex_Ip_Packet_Source::open_udp_socket()
+{
     d_sock_raw = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
     if (d_sock_raw == -1)
         {
@@ -214,6 +284,12 @@ bool Gr_Complex_Ip_Packet_Source::open()
             std::cout << "Error opening UDP socket\n";
             return false;
         }
+    if (d_use_recvmmsg)
+        {
+            // a deep kernel queue absorbs scheduling jitter at high packet rates
+            int rcvbuf = 8 * 1024 * 1024;
+            setsockopt(d_sock_raw, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+        }
     return true;
 }
 
@@ -224,7 +300,7 @@ Gr_Complex_Ip_Packet_Source::~Gr_Complex_Ip_Packet_Source()
         {
             delete d_pcap_thread;
         }
-    delete fifo_buff;
+    munmap(fifo_buff, FIFO_SIZE);
     std::cout << "Stop Ethernet packet capture\n";
 }
 
@@ -281,36 +357,42 @@ void Gr_Complex_Ip_Packet_Source::pcap_callback(__attribute__((unused)) u_char *
                     int payload_length_bytes = ntohs(uh->len) - 8;  // total udp packet length minus the header length
                     // read the payload bytes and insert them into the shared circular buffer
                     const u_char *udp_payload = (reinterpret_cast<const u_char *>(uh) + sizeof(gr_udp_header));
-                    if (fifo_items <= (FIFO_SIZE - payload_length_bytes))
-                        {
-                            int aligned_write_items = FIFO_SIZE - fifo_write_ptr;
-                            if (aligned_write_items >= payload_length_bytes)
-                                {
-                                    // write all in a single memcpy
-                                    memcpy(&fifo_buff[fifo_write_ptr], &udp_payload[0], payload_length_bytes);  // size in bytes
-                                    fifo_write_ptr += payload_length_bytes;
-                                    if (fifo_write_ptr == FIFO_SIZE)
-                                        {
-                                            fifo_write_ptr = 0;
-                                        }
-                                    fifo_items += payload_length_bytes;
-                                }
-                            else
-                                {
-                                    // two step wrap write
-                                    memcpy(&fifo_buff[fifo_write_ptr], &udp_payload[0], aligned_write_items);  // size in bytes
-                                    fifo_write_ptr = payload_length_bytes - aligned_write_items;
-                                    memcpy(&fifo_buff[0], &udp_payload[aligned_write_items], fifo_write_ptr);  // size in bytes
-                                    fifo_items += payload_length_bytes;
-                                }
-                        }
-                    else
+                    fifo_push(udp_payload, payload_length_bytes);
+                }
+        }
+}
+
+
+void Gr_Complex_Ip_Packet_Source::fifo_push(const u_char *payload, int length)
+{
+    if (fifo_items <= (FIFO_SIZE - length))
+        {
+            int aligned_write_items = FIFO_SIZE - fifo_write_ptr;
+            if (aligned_write_items >= length)
+                {
+                    // write all in a single memcpy
+                    memcpy(&fifo_buff[fifo_write_ptr], &payload[0], length);  // size in bytes
+                    fifo_write_ptr += length;
+                    if (fifo_write_ptr == FIFO_SIZE)
                         {
-                            // notify overflow
-                            std::cout << "O" << std::flush;
+                            fifo_write_ptr = 0;
                         }
+                    fifo_items += length;
+                }
+            else
+                {
+                    // two step wrap write
+                    memcpy(&fifo_buff[fifo_write_ptr], &payload[0], aligned_write_items);  // size in bytes
+                    fifo_write_ptr = length - aligned_write_items;
+                    memcpy(&fifo_buff[0], &payload[aligned_write_items], fifo_write_ptr);  // size in bytes
+                    fifo_items += length;
                 }
         }
+    else
+        {
+            // notify overflow
+            std::cout << "O" << std::flush;
+        }
 }
 
 
@@ -320,6 +402,53 @@ void Gr_Complex_Ip_Packet_Source::my_pcap_loop_thread(pcap_t *pcap_handle)
 }
 
 
+void Gr_Complex_Ip_Packet_Source::my_recvmmsg_loop()
+{
+#if defined(__linux__)
+    if (d_capture_cpu >= 0)
+        {
+            cpu_set_t cpuset;
+            CPU_ZERO(&cpuset);
+            CPU_SET(d_capture_cpu, &cpuset);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0)
+                {
+                    std::cout << "Could not pin the capture thread to CPU " << d_capture_cpu << '\n';
+                }
+        }
+    // preallocated reception slots, reused across recvmmsg() calls
+    std::vector<std::vector<u_char>> payloads(RECVMMSG_BATCH, std::vector<u_char>(d_udp_payload_size));
+    std::vector<struct iovec> iovecs(RECVMMSG_BATCH);
+    std::vector<struct mmsghdr> msgs(RECVMMSG_BATCH);
+    for (int i = 0; i < RECVMMSG_BATCH; i++)
+        {
+            iovecs[i].iov_base = payloads[i].data();
+            iovecs[i].iov_len = payloads[i].size();
+            memset(&msgs[i], 0, sizeof(struct mmsghdr));
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+    while (!d_capture_stop)
+        {
+            const int received = recvmmsg(d_sock_raw, msgs.data(), RECVMMSG_BATCH, MSG_WAITFORONE, nullptr);
+            if (received < 0)
+                {
+                    if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                    break;  // the socket was shut down in stop()
+                }
+            // one lock per batch instead of one lock per datagram
+            boost::mutex::scoped_lock lock(d_mutex);
+            for (int i = 0; i < received; i++)
+                {
+                    fifo_push(payloads[i].data(), static_cast<int>(msgs[i].msg_len));
+                }
+        }
+#endif
+}
+
+
 void Gr_Complex_Ip_Packet_Source::demux_samples(const gr_vector_void_star &output_items, int num_samples_readed)
 {
     for (int n = 0; n < num_samples_readed; n++)
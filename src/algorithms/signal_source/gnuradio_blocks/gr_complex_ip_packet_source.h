@@ -24,6 +24,7 @@
 #include <boost/thread.hpp>
 #include <gnuradio/sync_block.h>
 #include <arpa/inet.h>
+#include <atomic>
 #include <net/ethernet.h>
 #include <net/if.h>
 #include <netinet/if_ether.h>
@@ -49,7 +50,9 @@ public:
         int n_baseband_channels,
         const std::string &wire_sample_type,
         size_t item_size,
-        bool IQ_swap_);
+        bool IQ_swap_,
+        bool use_recvmmsg = false,
+        int capture_cpu = -1);
     Gr_Complex_Ip_Packet_Source(std::string src_device,
         const std::string &origin_address,
         int udp_port,
@@ -57,7 +60,9 @@ public:
         int n_baseband_channels,
         const std::string &wire_sample_type,
         size_t item_size,
-        bool IQ_swap_);
+        bool IQ_swap_,
+        bool use_recvmmsg = false,
+        int capture_cpu = -1);
     ~Gr_Complex_Ip_Packet_Source();
 
     // Called by gnuradio to enable drivers, etc for i/o devices.
@@ -74,13 +79,18 @@ public:
 private:
     void demux_samples(const gr_vector_void_star &output_items, int num_samples_readed);
     void my_pcap_loop_thread(pcap_t *pcap_handle);
+    void my_recvmmsg_loop();
     void pcap_callback(u_char *args, const struct pcap_pkthdr *pkthdr, const u_char *packet);
     static void static_pcap_callback(u_char *args, const struct pcap_pkthdr *pkthdr, const u_char *packet);
+    // inserts one UDP payload into the sample FIFO. The caller holds d_mutex
+    void fifo_push(const u_char *payload, int length);
     /*
      * Opens the ethernet device using libpcap raw capture mode
      * If any of these fail, the function returns the error and exits.
      */
     bool open();
+    // Opens and binds the UDP socket (also used to silence ICMP replies in pcap mode)
+    bool open_udp_socket();
 
     boost::thread *d_pcap_thread;
     boost::mutex d_mutex;
@@ -101,6 +111,9 @@ private:
     int d_n_baseband_channels;
     int d_wire_sample_type;
     int d_bytes_per_sample;
+    int d_capture_cpu;
+    std::atomic<bool> d_capture_stop;
+    bool d_use_recvmmsg;
     bool d_IQ_swap;
     bool d_fifo_full;
 };
@@ -21,6 +21,7 @@
 #include <boost/any.hpp>
 #include <gnuradio/io_signature.h>
 #include <array>
+#include <cstring>
 #include <exception>
 #include <iostream>
 #include <sstream>
@@ -55,6 +56,8 @@ labsat23_source::labsat23_source(const char *signal_file_basename,
     d_channel_selector = 0;
     d_signal_file_basename = std::string(signal_file_basename);
 
+    build_decode_tables();
+
     std::string signal_file;
     this->set_output_multiple(8);
     signal_file = generate_filename();
@@ -189,6 +192,59 @@ void labsat23_source::decode_samples_one_channel(int16_t input_short, gr_complex
 }
 
 
+void labsat23_source::build_decode_tables()
+{
+    // The bit fields of samples 4..7 (2 bits per sample) and 2..3 (4 bits)
+    // within an int16 mirror those of the first half one byte down, so a
+    // single 256-entry table per mode covers both halves. Reuse the scalar
+    // decoder on synthetic shorts with only the high byte set
+    std::array<gr_complex, 8> decoded{};
+    for (int b = 0; b < 256; b++)
+        {
+            const auto input = static_cast<int16_t>(b << 8);
+            decode_samples_one_channel(input, decoded.data(), 2);
+            for (int i = 0; i < 4; i++)
+                {
+                    d_lut_2bit[b][i] = decoded[i];
+                }
+            decode_samples_one_channel(input, decoded.data(), 4);
+            for (int i = 0; i < 2; i++)
+                {
+                    d_lut_4bit[b][i] = decoded[i];
+                }
+        }
+}
+
+
+void labsat23_source::decode_block(const int16_t *input, int n_int16, gr_complex *out)
+{
+    // table copies instead of per-bit extraction; the compiler turns each
+    // one into a pair of vector loads/stores
+    if (d_bits_per_sample == 2)
+        {
+            for (int i = 0; i < n_int16; i++)
+                {
+                    const auto hi = static_cast<uint8_t>(static_cast<uint16_t>(input[i]) >> 8);
+                    const auto lo = static_cast<uint8_t>(input[i] & 0xFF);
+                    std::memcpy(out, d_lut_2bit[hi].data(), 4 * sizeof(gr_complex));
+                    std::memcpy(out + 4, d_lut_2bit[lo].data(), 4 * sizeof(gr_complex));
+                    out += 8;
+                }
+        }
+    else
+        {
+            for (int i = 0; i < n_int16; i++)
+                {
+                    const auto hi = static_cast<uint8_t>(static_cast<uint16_t>(input[i]) >> 8);
+                    const auto lo = static_cast<uint8_t>(input[i] & 0xFF);
+                    std::memcpy(out, d_lut_4bit[hi].data(), 2 * sizeof(gr_complex));
+                    std::memcpy(out + 2, d_lut_4bit[lo].data(), 2 * sizeof(gr_complex));
+                    out += 4;
+                }
+        }
+}
+
+
 int labsat23_source::general_work(int noutput_items,
     __attribute__((unused)) gr_vector_int &ninput_items,
     __attribute__((unused)) gr_vector_const_void_star &input_items,
@@ -419,13 +475,8 @@ int labsat23_source::general_work(int noutput_items,
                             n_int16_to_read = static_cast<int>(binary_input_file.gcount()) / 2;  // from bytes to int16
                             if (n_int16_to_read > 0)
                                 {
-                                    int output_pointer = 0;
-                                    for (int i = 0; i < n_int16_to_read; i++)
-                                        {
-                                            decode_samples_one_channel(memblock[i], &out[output_pointer], d_bits_per_sample);
-                                            output_pointer += 8;
-                                        }
-                                    return output_pointer;
+                                    decode_block(memblock.data(), n_int16_to_read, out);
+                                    return n_int16_to_read * 8;
                                 }
 
                             // trigger the read of the next file in the sequence
@@ -477,13 +528,8 @@ int labsat23_source::general_work(int noutput_items,
                             n_int16_to_read = static_cast<int>(binary_input_file.gcount()) / 2;  // from bytes to int16
                             if (n_int16_to_read > 0)
                                 {
-                                    int output_pointer = 0;
-                                    for (int i = 0; i < n_int16_to_read; i++)
-                                        {
-                                            decode_samples_one_channel(memblock[i], &out[output_pointer], d_bits_per_sample);
-                                            output_pointer += 4;
-                                        }
-                                    return output_pointer;
+                                    decode_block(memblock.data(), n_int16_to_read, out);
+                                    return n_int16_to_read * 4;
                                 }
 
                             // trigger the read of the next file in the sequence
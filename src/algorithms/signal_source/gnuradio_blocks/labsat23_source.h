@@ -22,6 +22,7 @@
 #include "gnss_block_interface.h"
 #include <gnuradio/block.h>
 #include <pmt/pmt.h>
+#include <array>
 #include <cstdint>
 #include <fstream>
 #include <string>
@@ -66,8 +67,16 @@ private:
 
     std::string generate_filename();
     void decode_samples_one_channel(int16_t input_short, gr_complex *out, int type);
+    void build_decode_tables();
+    void decode_block(const int16_t *input, int n_int16, gr_complex *out);
     int getBit(uint8_t byte, int position);
 
+    // Each byte of the packed stream decodes independently (4 samples at 2
+    // bits per sample, 2 samples at 4), so the bit expansion reduces to one
+    // table copy per byte
+    std::array<std::array<gr_complex, 4>, 256> d_lut_2bit{};
+    std::array<std::array<gr_complex, 2>, 256> d_lut_4bit{};
+
     std::ifstream binary_input_file;
     std::string d_signal_file_basename;
     Concurrent_Queue<pmt::pmt_t> *d_queue;
@@ -0,0 +1,187 @@
+/*!
+ * \file mmap_file_source.cc
+ *
+ * \brief Reads raw sample files through a memory mapping of the capture
+ * \author Javier Arribas jarribas (at) cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "mmap_file_source.h"
+#include <gnuradio/io_signature.h>
+#include <glog/logging.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+
+mmap_file_source_sptr mmap_make_file_source(
+    size_t item_size,
+    const std::string &filename,
+    bool repeat,
+    uint64_t readahead_bytes)
+{
+    return mmap_file_source_sptr(new mmap_file_source(item_size, filename, repeat, readahead_bytes));
+}
+
+
+mmap_file_source::mmap_file_source(size_t item_size,
+    const std::string &filename,
+    bool repeat,
+    uint64_t readahead_bytes)
+    : gr::sync_block("mmap_file_source",
+          gr::io_signature::make(0, 0, 0),
+          gr::io_signature::make(1, 1, item_size)),
+      d_base(nullptr),
+      d_length(0),
+      d_position(0),
+      d_advised_until(0),
+      d_released_until(0),
+      d_readahead_bytes(readahead_bytes),
+      d_item_size(item_size),
+      d_page_size(static_cast<size_t>(sysconf(_SC_PAGESIZE))),
+      d_fd(-1),
+      d_repeat(repeat)
+{
+    d_fd = open(filename.c_str(), O_RDONLY);
+    if (d_fd < 0)
+        {
+            throw std::runtime_error("mmap_file_source: can't open file " + filename + ": " + std::strerror(errno));
+        }
+
+    struct stat st
+    {
+    };
+    if (fstat(d_fd, &st) < 0 or st.st_size <= 0)
+        {
+            close(d_fd);
+            throw std::runtime_error("mmap_file_source: can't stat file " + filename);
+        }
+    d_length = static_cast<uint64_t>(st.st_size);
+
+    void *base = mmap(nullptr, d_length, PROT_READ, MAP_SHARED, d_fd, 0);
+    if (base == MAP_FAILED)
+        {
+            close(d_fd);
+            throw std::runtime_error("mmap_file_source: can't mmap file " + filename + ": " + std::strerror(errno));
+        }
+    d_base = static_cast<const char *>(base);
+
+    if (madvise(const_cast<char *>(d_base), d_length, MADV_SEQUENTIAL) != 0)
+        {
+            LOG(WARNING) << "mmap_file_source: madvise(MADV_SEQUENTIAL) failed: " << std::strerror(errno);
+        }
+
+    DLOG(INFO) << "mmap_file_source: mapped " << d_length << " bytes of " << filename
+               << ", readahead window " << d_readahead_bytes << " bytes";
+}
+
+
+mmap_file_source::~mmap_file_source()
+{
+    if (d_base != nullptr)
+        {
+            munmap(const_cast<char *>(d_base), d_length);
+        }
+    if (d_fd >= 0)
+        {
+            close(d_fd);
+        }
+}
+
+
+bool mmap_file_source::seek(uint64_t item_offset)
+{
+    const uint64_t byte_offset = item_offset * d_item_size;
+    if (byte_offset >= d_length)
+        {
+            LOG(WARNING) << "mmap_file_source: seek beyond the end of the file";
+            return false;
+        }
+    d_position = byte_offset;
+    d_advised_until = byte_offset;
+    d_released_until = byte_offset;
+    return true;
+}
+
+
+void mmap_file_source::advise_readahead()
+{
+    if (d_readahead_bytes == 0)
+        {
+            return;
+        }
+    // keep the readahead window warm ahead of the read position
+    if (d_position + d_readahead_bytes / 2 >= d_advised_until)
+        {
+            const uint64_t begin = (d_advised_until / d_page_size) * d_page_size;
+            const uint64_t end = std::min(d_position + d_readahead_bytes, d_length);
+            if (end > begin)
+                {
+                    madvise(const_cast<char *>(d_base) + begin, end - begin, MADV_WILLNEED);
+                    d_advised_until = end;
+                }
+        }
+    // release pages consumed long ago so the resident set stays bounded.
+    // The mapping is read-only, so re-reading them (repeat mode) just
+    // faults them back in from the page cache or the disk
+    if (d_position > d_released_until + 2 * d_readahead_bytes)
+        {
+            const uint64_t begin = (d_released_until / d_page_size) * d_page_size;
+            const uint64_t end = ((d_position - d_readahead_bytes) / d_page_size) * d_page_size;
+            if (end > begin)
+                {
+                    madvise(const_cast<char *>(d_base) + begin, end - begin, MADV_DONTNEED);
+                    d_released_until = end;
+                }
+        }
+}
+
+
+int mmap_file_source::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    auto *out = reinterpret_cast<char *>(output_items[0]);
+    int produced = 0;
+
+    while (produced < noutput_items)
+        {
+            uint64_t bytes_left = d_length - d_position;
+            if (bytes_left < d_item_size)
+                {
+                    if (!d_repeat)
+                        {
+                            break;
+                        }
+                    d_position = 0;
+                    d_advised_until = 0;
+                    d_released_until = 0;
+                    bytes_left = d_length;
+                }
+            advise_readahead();
+            const uint64_t items = std::min(static_cast<uint64_t>(noutput_items - produced), bytes_left / d_item_size);
+            memcpy(out + static_cast<size_t>(produced) * d_item_size, d_base + d_position, items * d_item_size);
+            d_position += items * d_item_size;
+            produced += static_cast<int>(items);
+        }
+
+    if (produced == 0)
+        {
+            return -1;  // end of file, signal done to the scheduler
+        }
+    return produced;
+}
@@ -0,0 +1,97 @@
+/*!
+ * \file mmap_file_source.h
+ *
+ * \brief Reads raw sample files through a memory mapping of the capture
+ * \author Javier Arribas jarribas (at) cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MMAP_FILE_SOURCE_H
+#define GNSS_SDR_MMAP_FILE_SOURCE_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class mmap_file_source;
+
+using mmap_file_source_sptr = gnss_shared_ptr<mmap_file_source>;
+
+mmap_file_source_sptr mmap_make_file_source(
+    size_t item_size,
+    const std::string &filename,
+    bool repeat,
+    uint64_t readahead_bytes);
+
+/*!
+ * \brief This class reads a raw sample file through a memory mapping.
+ *
+ * The whole capture is mapped read-only and advised as sequential, so the
+ * samples are served straight from the page cache without going through the
+ * read() syscall path of gr::blocks::file_source. A configurable readahead
+ * window is kept warm ahead of the read position, and pages far behind it
+ * are released so that multi-hour runs over very large captures do not grow
+ * the resident set.
+ */
+class mmap_file_source : public gr::sync_block
+{
+public:
+    ~mmap_file_source();
+
+    /*!
+     * \brief Moves the read position to the given item offset from the
+     * beginning of the file. Returns false if the offset is out of range.
+     */
+    bool seek(uint64_t item_offset);
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend mmap_file_source_sptr mmap_make_file_source(
+        size_t item_size,
+        const std::string &filename,
+        bool repeat,
+        uint64_t readahead_bytes);
+
+    mmap_file_source(size_t item_size,
+        const std::string &filename,
+        bool repeat,
+        uint64_t readahead_bytes);
+
+    void advise_readahead();
+
+    const char *d_base;
+    uint64_t d_length;
+    uint64_t d_position;
+    uint64_t d_advised_until;
+    uint64_t d_released_until;
+    uint64_t d_readahead_bytes;
+    size_t d_item_size;
+    size_t d_page_size;
+    int d_fd;
+    bool d_repeat;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MMAP_FILE_SOURCE_H
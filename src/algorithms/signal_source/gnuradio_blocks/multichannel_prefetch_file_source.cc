@@ -0,0 +1,239 @@
+/*!
+ * \file multichannel_prefetch_file_source.cc
+ * \brief A single-reader file source for multi-band captures. One thread
+ * fills a shared prefetch cache with large sequential reads and the bands
+ * are delivered in lockstep, one output stream per file
+ * \author Javier Arribas, 2019 jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "multichannel_prefetch_file_source.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+
+multichannel_prefetch_file_source_sptr multichannel_prefetch_make_file_source(
+    size_t item_size,
+    const std::vector<std::string>& filenames,
+    bool repeat,
+    uint64_t start_offset_bytes,
+    size_t chunk_size_bytes,
+    size_t chunks_per_band)
+{
+    return multichannel_prefetch_file_source_sptr(new multichannel_prefetch_file_source(
+        item_size, filenames, repeat, start_offset_bytes, chunk_size_bytes, chunks_per_band));
+}
+
+
+multichannel_prefetch_file_source::multichannel_prefetch_file_source(
+    size_t item_size,
+    const std::vector<std::string>& filenames,
+    bool repeat,
+    uint64_t start_offset_bytes,
+    size_t chunk_size_bytes,
+    size_t chunks_per_band)
+    : gr::sync_block("multichannel_prefetch_file_source",
+          gr::io_signature::make(0, 0, 0),
+          gr::io_signature::make(static_cast<int>(filenames.size()), static_cast<int>(filenames.size()), item_size)),
+      d_start_offset_bytes(start_offset_bytes),
+      d_item_size(item_size),
+      d_chunk_size_bytes(std::max(item_size, chunk_size_bytes - (chunk_size_bytes % item_size))),
+      d_max_buffered_bytes(std::max(static_cast<size_t>(1), chunks_per_band) * d_chunk_size_bytes),
+      d_repeat(repeat),
+      d_stop(false)
+{
+    d_bands.resize(filenames.size());
+    for (size_t n = 0; n < filenames.size(); n++)
+        {
+            d_bands[n].fp = std::fopen(filenames[n].c_str(), "rb");
+            if (d_bands[n].fp == nullptr)
+                {
+                    for (auto& band : d_bands)
+                        {
+                            if (band.fp != nullptr)
+                                {
+                                    std::fclose(band.fp);
+                                }
+                        }
+                    throw std::runtime_error("multichannel_prefetch_file_source: cannot open " + filenames[n]);
+                }
+            if (d_start_offset_bytes > 0)
+                {
+                    if (std::fseek(d_bands[n].fp, static_cast<long>(d_start_offset_bytes), SEEK_SET) != 0)
+                        {
+                            LOG(WARNING) << "multichannel_prefetch_file_source: error skipping "
+                                         << d_start_offset_bytes << " bytes of " << filenames[n];
+                        }
+                }
+        }
+
+    d_reader_thread = std::thread(&multichannel_prefetch_file_source::reader_loop, this);
+}
+
+
+multichannel_prefetch_file_source::~multichannel_prefetch_file_source()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_space_cond.notify_all();
+    d_data_cond.notify_all();
+    if (d_reader_thread.joinable())
+        {
+            d_reader_thread.join();
+        }
+    for (auto& band : d_bands)
+        {
+            if (band.fp != nullptr)
+                {
+                    std::fclose(band.fp);
+                }
+        }
+}
+
+
+void multichannel_prefetch_file_source::reader_loop()
+{
+    // Service the bands round-robin, always with whole chunks, so the
+    // drive sees a few large sequential requests per file instead of the
+    // interleaved small reads of independent file_source blocks
+    std::vector<char> chunk;
+    while (true)
+        {
+            bool progress = false;
+            for (auto& band : d_bands)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(d_mutex);
+                        if (d_stop)
+                            {
+                                return;
+                            }
+                        if (band.eof or (band.buffered_bytes >= d_max_buffered_bytes))
+                            {
+                                continue;
+                            }
+                    }
+                    chunk.resize(d_chunk_size_bytes);
+                    size_t bytes_read = std::fread(chunk.data(), 1, d_chunk_size_bytes, band.fp);
+                    if (bytes_read < d_chunk_size_bytes)
+                        {
+                            if (d_repeat)
+                                {
+                                    // wrap around and keep the chunk full so the
+                                    // bands stay aligned across the file boundary
+                                    std::fseek(band.fp, static_cast<long>(d_start_offset_bytes), SEEK_SET);
+                                    bytes_read += std::fread(chunk.data() + bytes_read, 1, d_chunk_size_bytes - bytes_read, band.fp);
+                                }
+                        }
+                    chunk.resize(bytes_read);
+                    {
+                        std::lock_guard<std::mutex> lock(d_mutex);
+                        if (bytes_read > 0)
+                            {
+                                band.buffered_bytes += bytes_read;
+                                band.chunks.push_back(std::move(chunk));
+                                chunk = std::vector<char>();
+                            }
+                        if (bytes_read < d_chunk_size_bytes)
+                            {
+                                band.eof = true;
+                            }
+                    }
+                    d_data_cond.notify_one();
+                    progress = true;
+                }
+            if (!progress)
+                {
+                    // all bands are either full or at end-of-file
+                    std::unique_lock<std::mutex> lock(d_mutex);
+                    d_space_cond.wait(lock, [&] {
+                        if (d_stop)
+                            {
+                                return true;
+                            }
+                        return std::any_of(d_bands.begin(), d_bands.end(), [&](const band_buffer& b) {
+                            return !b.eof and (b.buffered_bytes < d_max_buffered_bytes);
+                        });
+                    });
+                    if (d_stop)
+                        {
+                            return;
+                        }
+                }
+        }
+}
+
+
+int multichannel_prefetch_file_source::work(int noutput_items,
+    gr_vector_const_void_star& input_items __attribute__((unused)),
+    gr_vector_void_star& output_items)
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    // the outputs advance in lockstep, so wait until every band can
+    // deliver at least one item (or has nothing left to deliver)
+    d_data_cond.wait(lock, [&] {
+        if (d_stop)
+            {
+                return true;
+            }
+        return std::all_of(d_bands.begin(), d_bands.end(), [&](const band_buffer& b) {
+            return b.eof or (b.buffered_bytes >= d_item_size);
+        });
+    });
+    if (d_stop)
+        {
+            return -1;
+        }
+
+    size_t nitems = static_cast<size_t>(noutput_items);
+    for (const auto& band : d_bands)
+        {
+            nitems = std::min(nitems, band.buffered_bytes / d_item_size);
+        }
+    if (nitems == 0)
+        {
+            // the shortest file is exhausted
+            return -1;  // WORK_DONE
+        }
+
+    for (size_t n = 0; n < d_bands.size(); n++)
+        {
+            auto* out = reinterpret_cast<char*>(output_items[n]);
+            size_t bytes_left = nitems * d_item_size;
+            band_buffer& band = d_bands[n];
+            while (bytes_left > 0)
+                {
+                    std::vector<char>& front = band.chunks.front();
+                    const size_t available = front.size() - band.front_offset;
+                    const size_t bytes_to_copy = std::min(available, bytes_left);
+                    std::memcpy(out, front.data() + band.front_offset, bytes_to_copy);
+                    out += bytes_to_copy;
+                    band.front_offset += bytes_to_copy;
+                    band.buffered_bytes -= bytes_to_copy;
+                    bytes_left -= bytes_to_copy;
+                    if (band.front_offset == front.size())
+                        {
+                            band.chunks.pop_front();
+                            band.front_offset = 0;
+                        }
+                }
+        }
+    lock.unlock();
+    d_space_cond.notify_one();
+    return static_cast<int>(nitems);
+}
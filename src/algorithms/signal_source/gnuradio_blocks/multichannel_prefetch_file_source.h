@@ -0,0 +1,115 @@
+/*!
+ * \file multichannel_prefetch_file_source.h
+ * \brief A single-reader file source for multi-band captures. One thread
+ * fills a shared prefetch cache with large sequential reads and the bands
+ * are delivered in lockstep, one output stream per file
+ * \author Javier Arribas, 2019 jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MULTICHANNEL_PREFETCH_FILE_SOURCE_H
+#define GNSS_SDR_MULTICHANNEL_PREFETCH_FILE_SOURCE_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class multichannel_prefetch_file_source;
+
+using multichannel_prefetch_file_source_sptr = gnss_shared_ptr<multichannel_prefetch_file_source>;
+
+multichannel_prefetch_file_source_sptr multichannel_prefetch_make_file_source(
+    size_t item_size,
+    const std::vector<std::string>& filenames,
+    bool repeat,
+    uint64_t start_offset_bytes = 0,
+    size_t chunk_size_bytes = 4194304,
+    size_t chunks_per_band = 4);
+
+/*!
+ * \brief Reads N files of equal-rate sample streams and outputs them on N
+ * synchronized streams.
+ *
+ * A single reader thread services all the files with large sequential reads
+ * into per-band chunk queues, so the drive sees one quasi-sequential access
+ * pattern instead of N competing readers. work() consumes the same number of
+ * items from every band, keeping the outputs aligned by sample index, and
+ * signals end-of-data when the shortest file is exhausted.
+ */
+class multichannel_prefetch_file_source : public gr::sync_block
+{
+public:
+    ~multichannel_prefetch_file_source();
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items) override;
+
+private:
+    friend multichannel_prefetch_file_source_sptr multichannel_prefetch_make_file_source(
+        size_t item_size,
+        const std::vector<std::string>& filenames,
+        bool repeat,
+        uint64_t start_offset_bytes,
+        size_t chunk_size_bytes,
+        size_t chunks_per_band);
+
+    multichannel_prefetch_file_source(
+        size_t item_size,
+        const std::vector<std::string>& filenames,
+        bool repeat,
+        uint64_t start_offset_bytes,
+        size_t chunk_size_bytes,
+        size_t chunks_per_band);
+
+    struct band_buffer
+    {
+        FILE* fp = nullptr;
+        std::deque<std::vector<char>> chunks;
+        size_t front_offset = 0;    // bytes of chunks.front() already consumed
+        size_t buffered_bytes = 0;  // total unconsumed bytes in the queue
+        bool eof = false;
+    };
+
+    void reader_loop();
+
+    std::vector<band_buffer> d_bands;
+    std::thread d_reader_thread;
+    std::mutex d_mutex;
+    std::condition_variable d_data_cond;   // reader -> work(): new chunk available
+    std::condition_variable d_space_cond;  // work() -> reader: cache has room again
+    uint64_t d_start_offset_bytes;
+    size_t d_item_size;
+    size_t d_chunk_size_bytes;
+    size_t d_max_buffered_bytes;  // per band
+    bool d_repeat;
+    bool d_stop;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MULTICHANNEL_PREFETCH_FILE_SOURCE_H
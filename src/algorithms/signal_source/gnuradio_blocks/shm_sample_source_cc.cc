@@ -0,0 +1,79 @@
+/*!
+ * \file shm_sample_source_cc.cc
+ * \brief Source block that consumes a gr_complex stream from a
+ * shared-memory sample ring published by an ingest process
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "shm_sample_source_cc.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+
+shm_sample_source_cc_sptr make_shm_sample_source_cc(const std::string& shm_name,
+    double timeout_s)
+{
+    return shm_sample_source_cc_sptr(new shm_sample_source_cc(shm_name, timeout_s));
+}
+
+
+shm_sample_source_cc::shm_sample_source_cc(const std::string& shm_name,
+    double timeout_s) : gr::sync_block("shm_sample_source_cc",
+                            gr::io_signature::make(0, 0, 0),
+                            gr::io_signature::make(1, 1, sizeof(gr_complex)))
+{
+    // the ingest process may still be starting up; poll for the segment
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(static_cast<int64_t>(timeout_s * 1000.0));
+    while (!d_ring.open(shm_name, sizeof(gr_complex)))
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+                {
+                    throw std::runtime_error("Shared memory ring " + shm_name + " not found. Is the ingest process running?");
+                }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    LOG(INFO) << "Attached to shared memory ring " << shm_name
+              << " (" << d_ring.capacity_items() << " samples deep, "
+              << d_ring.sample_rate() << " Sps)";
+}
+
+
+double shm_sample_source_cc::publisher_sample_rate() const
+{
+    return d_ring.sample_rate();
+}
+
+
+int shm_sample_source_cc::work(int noutput_items,
+    gr_vector_const_void_star& input_items __attribute__((unused)),
+    gr_vector_void_star& output_items)
+{
+    auto* out = reinterpret_cast<gr_complex*>(output_items[0]);
+    size_t num_items = 0;
+    while ((num_items = d_ring.read(out, static_cast<size_t>(noutput_items))) == 0)
+        {
+            // ring empty: the publisher runs at the ingest rate, so a short
+            // nap is cheaper than spinning on the shared sequence number
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    if (d_ring.overrun_items() != d_reported_overruns)
+        {
+            LOG(WARNING) << "Shared memory ring overrun: " << (d_ring.overrun_items() - d_reported_overruns)
+                         << " samples lost (this receiver process is not keeping up with the ingest)";
+            d_reported_overruns = d_ring.overrun_items();
+        }
+    return static_cast<int>(num_items);
+}
@@ -0,0 +1,75 @@
+/*!
+ * \file shm_sample_source_cc.h
+ * \brief Source block that consumes a gr_complex stream from a
+ * shared-memory sample ring published by an ingest process
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SHM_SAMPLE_SOURCE_CC_H
+#define GNSS_SDR_SHM_SAMPLE_SOURCE_CC_H
+
+#include "gnss_block_interface.h"
+#include "shm_sample_ring.h"
+#include <gnuradio/sync_block.h>
+#include <gnuradio/types.h>  // for gr_vector_const_void_star
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class shm_sample_source_cc;
+
+using shm_sample_source_cc_sptr = gnss_shared_ptr<shm_sample_source_cc>;
+
+//! Waits up to timeout_s for the publisher to create the ring; throws
+//! std::runtime_error if it does not appear
+shm_sample_source_cc_sptr make_shm_sample_source_cc(const std::string& shm_name,
+    double timeout_s);
+
+/*!
+ * \brief Source block that reads gr_complex samples from a Shm_Sample_Ring.
+ *
+ * The block delivers whatever the publisher has produced since the last
+ * call; when the ring is empty it naps briefly instead of busy-waiting.
+ * Overruns (the ingest lapping this process) are detected from the sequence
+ * numbers and reported, and the stream continues from the resynchronized
+ * position.
+ */
+class shm_sample_source_cc : public gr::sync_block
+{
+public:
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+    //! Sample rate advertised by the publisher, for configuration cross-checks
+    double publisher_sample_rate() const;
+
+private:
+    friend shm_sample_source_cc_sptr make_shm_sample_source_cc(const std::string& shm_name,
+        double timeout_s);
+
+    shm_sample_source_cc(const std::string& shm_name, double timeout_s);
+
+    Shm_Sample_Ring d_ring;
+    uint64_t d_reported_overruns{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SHM_SAMPLE_SOURCE_CC_H
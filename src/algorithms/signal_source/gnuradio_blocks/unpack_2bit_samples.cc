@@ -18,6 +18,7 @@
 
 #include "unpack_2bit_samples.h"
 #include <gnuradio/io_signature.h>
+#include <cstring>
 
 struct byte_2bit_struct
 {
@@ -117,6 +118,56 @@ unpack_2bit_samples::unpack_2bit_samples(bool big_endian_bytes,
     bool big_endian_bytes_system = systemBytesAreBigEndian();
 
     swap_endian_bytes_ = (big_endian_bytes_system != big_endian_bytes_);
+
+    // Precompute the decoded samples for all 256 possible input bytes, with
+    // the byte endianness and interleaving corrections already applied, so
+    // the per-byte work in work() reduces to one table lookup
+    byte_and_samples raw_byte{};
+    for (int b = 0; b < 256; ++b)
+        {
+            raw_byte.byte = static_cast<int8_t>(b);
+            const auto s0 = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
+            const auto s1 = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
+            const auto s2 = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
+            const auto s3 = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
+
+            int8_t decoded[4];
+            if (!reverse_interleaving_)
+                {
+                    if (swap_endian_bytes_)
+                        {
+                            decoded[0] = s3;
+                            decoded[1] = s2;
+                            decoded[2] = s1;
+                            decoded[3] = s0;
+                        }
+                    else
+                        {
+                            decoded[0] = s0;
+                            decoded[1] = s1;
+                            decoded[2] = s2;
+                            decoded[3] = s3;
+                        }
+                }
+            else
+                {
+                    if (swap_endian_bytes_)
+                        {
+                            decoded[0] = s2;
+                            decoded[1] = s3;
+                            decoded[2] = s0;
+                            decoded[3] = s1;
+                        }
+                    else
+                        {
+                            decoded[0] = s1;
+                            decoded[1] = s0;
+                            decoded[2] = s3;
+                            decoded[3] = s2;
+                        }
+                }
+            std::memcpy(&lut_[b], decoded, sizeof(decoded));
+        }
 }
 
 
@@ -140,70 +191,12 @@ int unpack_2bit_samples::work(int noutput_items,
         }
 
     // Here the in pointer can be interpreted as a stream of bytes to be
-    // converted. But we now have two possibilities:
-    // 1) The samples in a byte are in big endian order
-    // 2) The samples in a byte are in little endian order
-
-    byte_and_samples raw_byte{};
-    int n = 0;
-
-    if (!reverse_interleaving_)
-        {
-            if (swap_endian_bytes_)
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                        }
-                }
-            else
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                        }
-                }
-        }
-    else
+    // converted. The byte endianness and interleaving corrections are baked
+    // into the lookup table, so every input byte expands to four decoded
+    // samples with a single unaligned 32-bit store
+    for (size_t i = 0; i < ninput_bytes; ++i)
         {
-            if (swap_endian_bytes_)
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                        }
-                }
-            else
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                        }
-                }
+            std::memcpy(out + 4 * i, &lut_[static_cast<uint8_t>(in[i])], sizeof(uint32_t));
         }
 
     return noutput_items;
@@ -57,6 +57,7 @@
 
 #include "gnss_block_interface.h"
 #include <gnuradio/sync_interpolator.h>
+#include <array>
 #include <cstdint>
 #include <vector>
 
@@ -103,6 +104,10 @@ private:
         bool reverse_interleaving);
 
     std::vector<int8_t> work_buffer_;
+    // Maps each packed input byte to its four decoded samples, already in
+    // output order, so work() is a single table lookup and 32-bit store per
+    // input byte
+    std::array<uint32_t, 256> lut_{};
     size_t item_size_;
     bool big_endian_bytes_;
     bool big_endian_items_;
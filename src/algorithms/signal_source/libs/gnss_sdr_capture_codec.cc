@@ -0,0 +1,359 @@
+/*!
+ * \file gnss_sdr_capture_codec.cc
+ * \brief Frame-chunked, seekable container for compressed int16 IQ captures
+ * \author Javier Arribas, 2011. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_capture_codec.h"
+#include <glog/logging.h>
+#include <cstring>
+
+namespace
+{
+// per-frame header, stored in front of each bit-packed payload
+struct Capture_Frame_Header
+{
+    uint32_t payload_bytes;
+    uint32_t nsamples;
+    uint8_t bits;
+    uint8_t pad[3];
+};
+
+static_assert(sizeof(Capture_Frame_Header) == 12, "Capture_Frame_Header must pack to 12 bytes");
+}  // namespace
+
+
+int capture_codec_frame_bits(const int16_t *samples, uint32_t nsamples)
+{
+    // OR the magnitudes together so a single scan yields the widest sample;
+    // the loop is branch-free and auto-vectorizes
+    uint16_t mask = 0;
+    for (uint32_t i = 0; i < nsamples; i++)
+        {
+            const int16_t v = samples[i];
+            mask |= static_cast<uint16_t>(v < 0 ? ~v : v);
+        }
+    int bits = 1;  // sign bit
+    while (mask != 0)
+        {
+            bits++;
+            mask >>= 1U;
+        }
+    return bits > 16 ? 16 : bits;
+}
+
+
+uint32_t capture_codec_packed_size(uint32_t nsamples, int bits)
+{
+    // payloads are written in whole little-endian 64-bit words
+    const uint64_t total_bits = static_cast<uint64_t>(nsamples) * static_cast<uint64_t>(bits);
+    return static_cast<uint32_t>(((total_bits + 63U) / 64U) * 8U);
+}
+
+
+uint32_t capture_codec_pack_frame(const int16_t *samples, uint32_t nsamples, int bits, uint8_t *packed)
+{
+    const uint64_t mask = (bits == 64) ? ~0ULL : ((1ULL << bits) - 1ULL);
+    uint64_t acc = 0;
+    int fill = 0;
+    uint8_t *out = packed;
+    for (uint32_t i = 0; i < nsamples; i++)
+        {
+            acc |= (static_cast<uint64_t>(static_cast<uint16_t>(samples[i])) & mask) << fill;
+            fill += bits;
+            if (fill >= 64)
+                {
+                    memcpy(out, &acc, sizeof(acc));
+                    out += 8;
+                    fill -= 64;
+                    // bits that did not fit in the flushed word
+                    acc = (fill == 0) ? 0 : static_cast<uint64_t>(static_cast<uint16_t>(samples[i])) >> (bits - fill);
+                    acc &= (fill == 0) ? 0 : ((1ULL << fill) - 1ULL);
+                }
+        }
+    if (fill > 0)
+        {
+            memcpy(out, &acc, sizeof(acc));
+            out += 8;
+        }
+    return static_cast<uint32_t>(out - packed);
+}
+
+
+void capture_codec_unpack_frame(const uint8_t *packed, uint32_t nsamples, int bits, int16_t *samples)
+{
+    const uint64_t mask = (1ULL << bits) - 1ULL;
+    const uint64_t sign_bit = 1ULL << (bits - 1);
+    uint64_t acc = 0;
+    int fill = 0;
+    const uint8_t *in = packed;
+    for (uint32_t i = 0; i < nsamples; i++)
+        {
+            if (fill < bits)
+                {
+                    uint64_t next;
+                    memcpy(&next, in, sizeof(next));
+                    in += 8;
+                    const uint64_t v = (acc | (next << fill)) & mask;
+                    // sign-extend from bits to 16
+                    samples[i] = static_cast<int16_t>((v ^ sign_bit) - sign_bit);
+                    // the old accumulator is fully consumed (fill < bits), so
+                    // the remainder of the stream lives in the fresh word
+                    acc = next >> (bits - fill);
+                    fill = 64 - (bits - fill);
+                }
+            else
+                {
+                    uint64_t v = acc & mask;
+                    samples[i] = static_cast<int16_t>((v ^ sign_bit) - sign_bit);
+                    acc >>= bits;
+                    fill -= bits;
+                }
+        }
+}
+
+
+Gnss_Sdr_Capture_File_Writer::Gnss_Sdr_Capture_File_Writer(const std::string &filename,
+    uint64_t sampling_frequency,
+    uint32_t samples_per_frame,
+    uint64_t start_time_utc_ns)
+    : d_fp(nullptr),
+      d_samples_per_frame(samples_per_frame)
+{
+    d_fp = fopen(filename.c_str(), "wb");
+    if (d_fp == nullptr)
+        {
+            LOG(WARNING) << "capture_codec: could not create " << filename;
+            return;
+        }
+    Capture_File_Header hdr{};
+    memcpy(hdr.magic, "GSZ1", 4);
+    hdr.version = 1;
+    hdr.item_bits = 16;
+    hdr.sampling_frequency = sampling_frequency;
+    hdr.start_time_utc_ns = start_time_utc_ns;
+    hdr.samples_per_frame = samples_per_frame;
+    fwrite(&hdr, sizeof(hdr), 1, d_fp);
+    d_pending.reserve(samples_per_frame);
+    d_packed.resize(capture_codec_packed_size(samples_per_frame, 16));
+}
+
+
+Gnss_Sdr_Capture_File_Writer::~Gnss_Sdr_Capture_File_Writer()
+{
+    close();
+}
+
+
+bool Gnss_Sdr_Capture_File_Writer::write_samples(const int16_t *samples, uint32_t nsamples)
+{
+    if (d_fp == nullptr)
+        {
+            return false;
+        }
+    for (uint32_t i = 0; i < nsamples; i++)
+        {
+            d_pending.push_back(samples[i]);
+            if (d_pending.size() == d_samples_per_frame)
+                {
+                    if (!flush_frame())
+                        {
+                            return false;
+                        }
+                }
+        }
+    return true;
+}
+
+
+bool Gnss_Sdr_Capture_File_Writer::flush_frame()
+{
+    const auto nsamples = static_cast<uint32_t>(d_pending.size());
+    const int bits = capture_codec_frame_bits(d_pending.data(), nsamples);
+    Capture_Frame_Header fh{};
+    fh.nsamples = nsamples;
+    fh.bits = static_cast<uint8_t>(bits);
+    fh.payload_bytes = capture_codec_pack_frame(d_pending.data(), nsamples, bits, d_packed.data());
+    d_pending.clear();
+    if (fwrite(&fh, sizeof(fh), 1, d_fp) != 1)
+        {
+            return false;
+        }
+    return fwrite(d_packed.data(), 1, fh.payload_bytes, d_fp) == fh.payload_bytes;
+}
+
+
+void Gnss_Sdr_Capture_File_Writer::close()
+{
+    if (d_fp != nullptr)
+        {
+            if (!d_pending.empty())
+                {
+                    flush_frame();
+                }
+            fclose(d_fp);
+            d_fp = nullptr;
+        }
+}
+
+
+Gnss_Sdr_Capture_File_Reader::Gnss_Sdr_Capture_File_Reader(const std::string &filename)
+    : d_fp(nullptr),
+      d_total_samples(0),
+      d_current_frame(0),
+      d_frame_pos(0)
+{
+    d_fp = fopen(filename.c_str(), "rb");
+    if (d_fp == nullptr)
+        {
+            LOG(WARNING) << "capture_codec: could not open " << filename;
+            return;
+        }
+    if (fread(&d_header, sizeof(d_header), 1, d_fp) != 1 or
+        memcmp(d_header.magic, "GSZ1", 4) != 0 or
+        d_header.version != 1 or
+        d_header.item_bits != 16 or
+        d_header.samples_per_frame == 0)
+        {
+            LOG(WARNING) << "capture_codec: " << filename << " is not a GSZ1 capture file";
+            fclose(d_fp);
+            d_fp = nullptr;
+            return;
+        }
+    // build the frame offset table from the frame headers. Only the headers
+    // are visited, so this is a fast forward scan even on multi-hour files
+    uint64_t offset = sizeof(Capture_File_Header);
+    Capture_Frame_Header fh{};
+    while (fread(&fh, sizeof(fh), 1, d_fp) == 1)
+        {
+            if (fh.bits < 1 or fh.bits > 16 or fh.nsamples > d_header.samples_per_frame)
+                {
+                    LOG(WARNING) << "capture_codec: corrupt frame header in " << filename << ", truncating";
+                    break;
+                }
+            d_frame_offsets.push_back(offset);
+            d_total_samples += fh.nsamples;
+            offset += sizeof(Capture_Frame_Header) + fh.payload_bytes;
+            if (fseek(d_fp, static_cast<long>(fh.payload_bytes), SEEK_CUR) != 0)
+                {
+                    break;
+                }
+        }
+    d_frame.reserve(d_header.samples_per_frame);
+    d_packed.resize(capture_codec_packed_size(d_header.samples_per_frame, 16) + 8);
+    if (!d_frame_offsets.empty())
+        {
+            load_frame(0);
+        }
+}
+
+
+Gnss_Sdr_Capture_File_Reader::~Gnss_Sdr_Capture_File_Reader()
+{
+    if (d_fp != nullptr)
+        {
+            fclose(d_fp);
+        }
+}
+
+
+bool Gnss_Sdr_Capture_File_Reader::is_open() const
+{
+    return d_fp != nullptr;
+}
+
+
+uint64_t Gnss_Sdr_Capture_File_Reader::total_samples() const
+{
+    return d_total_samples;
+}
+
+
+uint64_t Gnss_Sdr_Capture_File_Reader::sampling_frequency() const
+{
+    return d_header.sampling_frequency;
+}
+
+
+uint64_t Gnss_Sdr_Capture_File_Reader::start_time_utc_ns() const
+{
+    return d_header.start_time_utc_ns;
+}
+
+
+bool Gnss_Sdr_Capture_File_Reader::load_frame(uint64_t frame_index)
+{
+    if (frame_index >= d_frame_offsets.size())
+        {
+            return false;
+        }
+    if (fseek(d_fp, static_cast<long>(d_frame_offsets[frame_index]), SEEK_SET) != 0)
+        {
+            return false;
+        }
+    Capture_Frame_Header fh{};
+    if (fread(&fh, sizeof(fh), 1, d_fp) != 1)
+        {
+            return false;
+        }
+    if (fread(d_packed.data(), 1, fh.payload_bytes, d_fp) != fh.payload_bytes)
+        {
+            return false;
+        }
+    d_frame.resize(fh.nsamples);
+    capture_codec_unpack_frame(d_packed.data(), fh.nsamples, fh.bits, d_frame.data());
+    d_current_frame = frame_index;
+    d_frame_pos = 0;
+    return true;
+}
+
+
+bool Gnss_Sdr_Capture_File_Reader::seek_to_sample(uint64_t sample_index)
+{
+    if (sample_index >= d_total_samples)
+        {
+            return false;
+        }
+    const uint64_t frame_index = sample_index / d_header.samples_per_frame;
+    if (frame_index != d_current_frame or d_frame.empty())
+        {
+            if (!load_frame(frame_index))
+                {
+                    return false;
+                }
+        }
+    d_frame_pos = static_cast<uint32_t>(sample_index % d_header.samples_per_frame);
+    return true;
+}
+
+
+uint32_t Gnss_Sdr_Capture_File_Reader::read_samples(int16_t *samples, uint32_t nsamples)
+{
+    uint32_t delivered = 0;
+    while (delivered < nsamples)
+        {
+            if (d_frame_pos >= d_frame.size())
+                {
+                    if (!load_frame(d_current_frame + 1))
+                        {
+                            break;  // end of file
+                        }
+                }
+            const uint32_t available = static_cast<uint32_t>(d_frame.size()) - d_frame_pos;
+            const uint32_t chunk = available < (nsamples - delivered) ? available : (nsamples - delivered);
+            memcpy(samples + delivered, d_frame.data() + d_frame_pos, chunk * sizeof(int16_t));
+            d_frame_pos += chunk;
+            delivered += chunk;
+        }
+    return delivered;
+}
@@ -0,0 +1,141 @@
+/*!
+ * \file gnss_sdr_capture_codec.h
+ * \brief Frame-chunked, seekable container for compressed int16 IQ captures
+ * \author Javier Arribas, 2011. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CAPTURE_CODEC_H
+#define GNSS_SDR_CAPTURE_CODEC_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs signal_source_libs
+ * \{ */
+
+
+/*!
+ * \brief GSZ1 capture container.
+ *
+ * Raw int16 sample streams (real or interleaved IQ) are stored as a fixed
+ * 32-byte file header followed by frames of a fixed number of samples. Each
+ * frame is bit-packed to the smallest signed width that holds its largest
+ * sample, which removes the zero padding of low-resolution front-ends stored
+ * as int16 (2x for 8 effective bits, >3x for 4) while remaining trivially
+ * seekable: the sample index of a frame is its ordinal times the frame
+ * length, and the reader builds a frame offset table from the frame headers
+ * when the file is opened.
+ */
+struct Capture_File_Header
+{
+    char magic[4];                // "GSZ1"
+    uint8_t version;              // format version, currently 1
+    uint8_t item_bits;            // bits of the unpacked item, currently 16
+    uint16_t reserved;            //
+    uint64_t sampling_frequency;  // samples per second, informative
+    uint64_t start_time_utc_ns;   // capture start time, 0 if unknown
+    uint32_t samples_per_frame;   // all frames but the last hold this many samples
+    uint32_t reserved2;           //
+};
+
+static_assert(sizeof(Capture_File_Header) == 32, "Capture_File_Header must pack to 32 bytes");
+
+//! Bits needed to bit-pack the given frame (two's complement, 1..16)
+int capture_codec_frame_bits(const int16_t *samples, uint32_t nsamples);
+
+/*!
+ * \brief Packs nsamples int16 values to bits-wide two's complement words.
+ * \returns the payload size in bytes. packed must hold at least
+ * capture_codec_packed_size(nsamples, bits) bytes.
+ */
+uint32_t capture_codec_pack_frame(const int16_t *samples, uint32_t nsamples, int bits, uint8_t *packed);
+
+//! Payload size in bytes of a packed frame
+uint32_t capture_codec_packed_size(uint32_t nsamples, int bits);
+
+//! Unpacks a frame produced by capture_codec_pack_frame()
+void capture_codec_unpack_frame(const uint8_t *packed, uint32_t nsamples, int bits, int16_t *samples);
+
+
+/*!
+ * \brief Writes a GSZ1 capture file frame by frame.
+ */
+class Gnss_Sdr_Capture_File_Writer
+{
+public:
+    Gnss_Sdr_Capture_File_Writer(const std::string &filename,
+        uint64_t sampling_frequency,
+        uint32_t samples_per_frame = 65536,
+        uint64_t start_time_utc_ns = 0);
+    ~Gnss_Sdr_Capture_File_Writer();
+
+    //! Appends samples to the file, framing and packing them as needed
+    bool write_samples(const int16_t *samples, uint32_t nsamples);
+
+    //! Flushes the pending partial frame and closes the file
+    void close();
+
+private:
+    bool flush_frame();
+
+    std::vector<int16_t> d_pending;
+    std::vector<uint8_t> d_packed;
+    FILE *d_fp;
+    uint32_t d_samples_per_frame;
+};
+
+
+/*!
+ * \brief Reads a GSZ1 capture file with random access at sample granularity.
+ */
+class Gnss_Sdr_Capture_File_Reader
+{
+public:
+    explicit Gnss_Sdr_Capture_File_Reader(const std::string &filename);
+    ~Gnss_Sdr_Capture_File_Reader();
+
+    bool is_open() const;
+    uint64_t total_samples() const;
+    uint64_t sampling_frequency() const;
+    uint64_t start_time_utc_ns() const;
+
+    //! Moves the read position to an absolute sample index
+    bool seek_to_sample(uint64_t sample_index);
+
+    /*!
+     * \brief Decodes up to nsamples items from the current position.
+     * \returns the number of samples delivered, 0 at end of file.
+     */
+    uint32_t read_samples(int16_t *samples, uint32_t nsamples);
+
+private:
+    bool load_frame(uint64_t frame_index);
+
+    std::vector<uint64_t> d_frame_offsets;  // file offset of each frame header
+    std::vector<int16_t> d_frame;           // decoded samples of the current frame
+    std::vector<uint8_t> d_packed;
+    Capture_File_Header d_header{};
+    FILE *d_fp;
+    uint64_t d_total_samples;
+    uint64_t d_current_frame;
+    uint32_t d_frame_pos;  // read position inside the decoded frame
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CAPTURE_CODEC_H
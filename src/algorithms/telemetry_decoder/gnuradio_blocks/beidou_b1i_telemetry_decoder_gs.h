@@ -24,7 +24,8 @@
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
 #include "tlm_conf.h"
-#include <boost/circular_buffer.hpp>
+#include "tlm_preamble_correlator.h"
+#include "tlm_symbol_ring.h"
 #include <gnuradio/block.h>  // for block
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <array>
@@ -78,11 +79,12 @@ private:
 
     // Preamble decoding
     std::array<int32_t, BEIDOU_DNAV_PREAMBLE_LENGTH_SYMBOLS> d_preamble_samples{};
+    Tlm_Preamble_Correlator d_preamble_correlator;
 
     std::array<float, BEIDOU_DNAV_PREAMBLE_PERIOD_SYMBOLS> d_subframe_symbols{};
 
     // Storage for incoming data
-    boost::circular_buffer<float> d_symbol_history;
+    Tlm_Symbol_Ring d_symbol_history;
 
     // Navigation Message variable
     Beidou_Dnav_Navigation_Message d_nav;
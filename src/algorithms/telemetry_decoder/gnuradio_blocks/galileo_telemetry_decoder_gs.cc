@@ -26,9 +26,13 @@
 #include "display.h"
 #include "galileo_almanac_helper.h"  // for Galileo_Almanac_Helper
 #include "galileo_ephemeris.h"       // for Galileo_Ephemeris
+#include "galileo_has_data.h"        // for Galileo_HAS_data
 #include "galileo_iono.h"            // for Galileo_Iono
 #include "galileo_utc_model.h"       // for Galileo_Utc_Model
+#include "gnss_message_ids.h"
 #include "gnss_synchro.h"
+#include "tlm_decode_service.h"
+#include "tlm_event_journal.h"
 #include "tlm_utils.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
@@ -73,6 +77,8 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
     d_dump = conf.dump;
     d_dump_mat = conf.dump_mat;
     d_remove_dat = conf.remove_dat;
+    d_use_decode_service = conf.use_decode_service;
+    d_decode_quality_gate = conf.decode_quality_gate;
     d_satellite = Gnss_Satellite(satellite.get_system(), satellite.get_PRN());
     d_frame_type = frame_type;
     DLOG(INFO) << "Initializing GALILEO UNIFIED TELEMETRY DECODER";
@@ -140,6 +146,38 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
         }
 
     d_page_part_symbols.reserve(d_frame_length_symbols);
+
+    // deinterleaved symbols plus decoded bits, with room for alignment padding
+    d_scratch.reserve(d_frame_length_symbols * (sizeof(float) + sizeof(int32_t)) + 64);
+
+    // precompute the deinterleaver permutation for this frame type
+    int32_t deint_rows = 0;
+    int32_t deint_cols = 0;
+    switch (d_frame_type)
+        {
+        case 1:  // INAV
+            deint_rows = GALILEO_INAV_INTERLEAVER_ROWS;
+            deint_cols = GALILEO_INAV_INTERLEAVER_COLS;
+            break;
+        case 2:  // FNAV
+            deint_rows = GALILEO_FNAV_INTERLEAVER_ROWS;
+            deint_cols = GALILEO_FNAV_INTERLEAVER_COLS;
+            break;
+        case 3:  // CNAV
+            deint_rows = GALILEO_CNAV_INTERLEAVER_ROWS;
+            deint_cols = GALILEO_CNAV_INTERLEAVER_COLS;
+            break;
+        default:
+            break;
+        }
+    d_deint_index.resize(static_cast<size_t>(deint_rows) * static_cast<size_t>(deint_cols));
+    for (int32_t r = 0; r < deint_rows; r++)
+        {
+            for (int32_t c = 0; c < deint_cols; c++)
+                {
+                    d_deint_index[c * deint_rows + r] = r * deint_cols + c;
+                }
+        }
     for (int32_t i = 0; i < d_bits_per_preamble; i++)
         {
             switch (d_frame_type)
@@ -199,17 +237,14 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
     d_flag_PLL_180_deg_phase_locked = false;
     d_symbol_history.set_capacity(d_required_symbols + 1);
 
+    if (!conf.journal_filename.empty())
+        {
+            Tlm_Event_Journal::get_instance().enable(conf.journal_filename, static_cast<uint32_t>(conf.journal_records));
+        }
+
     // vars for Viterbi decoder
-    const int32_t max_states = 1U << static_cast<uint32_t>(d_mm);  // 2^d_mm
-    std::array<int32_t, 2> g_encoder{{121, 91}};                   // Polynomial G1 and G2
-    d_out0.reserve(max_states);
-    d_out1.reserve(max_states);
-    d_state0.reserve(max_states);
-    d_state1.reserve(max_states);
-
-    // create appropriate transition matrices
-    nsc_transit(d_out0.data(), d_state0.data(), 0, g_encoder.data(), d_KK, d_nn);
-    nsc_transit(d_out1.data(), d_state1.data(), 1, g_encoder.data(), d_KK, d_nn);
+    std::array<int32_t, 2> g_encoder{{121, 91}};  // Polynomial G1 and G2
+    d_viterbi = std::make_unique<Viterbi_Fast>(g_encoder.data(), d_KK, d_nn);
 }
 
 
@@ -252,28 +287,56 @@ galileo_telemetry_decoder_gs::~galileo_telemetry_decoder_gs()
 
 void galileo_telemetry_decoder_gs::viterbi_decoder(float *page_part_symbols, int32_t *page_part_bits)
 {
-    Viterbi(page_part_bits, d_out0.data(), d_state0.data(), d_out1.data(), d_state1.data(),
-        page_part_symbols, d_KK, d_nn, d_datalength);
+    if (d_use_decode_service)
+        {
+            Tlm_Decode_Service::get_instance().decode(*d_viterbi, page_part_bits, page_part_symbols, d_datalength);
+        }
+    else
+        {
+            d_viterbi->decode(page_part_bits, page_part_symbols, d_datalength);
+        }
 }
 
 
-void galileo_telemetry_decoder_gs::deinterleaver(int32_t rows, int32_t cols, const float *in, float *out)
+void galileo_telemetry_decoder_gs::deinterleaver(const float *in, float *out) const
 {
-    for (int32_t r = 0; r < rows; r++)
+    const auto len = static_cast<int32_t>(d_deint_index.size());
+    for (int32_t i = 0; i < len; i++)
         {
-            for (int32_t c = 0; c < cols; c++)
-                {
-                    out[c * rows + r] = in[r * cols + c];
-                }
+            out[i] = in[d_deint_index[i]];
         }
 }
 
 
+bool galileo_telemetry_decoder_gs::page_quality_ok(const float *page_symbols, int32_t nsymbols) const
+{
+    if (d_decode_quality_gate <= 0.0F)
+        {
+            return true;
+        }
+    float abs_sum = 0.0F;
+    float sq_sum = 0.0F;
+    for (int32_t i = 0; i < nsymbols; i++)
+        {
+            abs_sum += std::fabs(page_symbols[i]);
+            sq_sum += page_symbols[i] * page_symbols[i];
+        }
+    if (sq_sum <= 0.0F)
+        {
+            return false;
+        }
+    // mean(|s|) / rms(s) approaches 1 for clean BPSK symbols and
+    // sqrt(2/pi) (about 0.8) for pure noise, independently of the symbol scale
+    const float quality = (abs_sum / static_cast<float>(nsymbols)) / std::sqrt(sq_sum / static_cast<float>(nsymbols));
+    return quality >= d_decode_quality_gate;
+}
+
+
 void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, int32_t frame_length)
 {
     // 1. De-interleave
-    std::vector<float> page_part_symbols_deint(frame_length);
-    deinterleaver(GALILEO_INAV_INTERLEAVER_ROWS, GALILEO_INAV_INTERLEAVER_COLS, page_part_symbols, page_part_symbols_deint.data());
+    float* page_part_symbols_deint = d_scratch.allocate<float>(frame_length);
+    deinterleaver(page_part_symbols, page_part_symbols_deint);
 
     // 2. Viterbi decoder
     // 2.1 Take into account the NOT gate in G2 polynomial (Galileo ICD Figure 13, FEC encoder)
@@ -286,8 +349,8 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
                 }
         }
     const int32_t decoded_length = frame_length / 2;
-    std::vector<int32_t> page_part_bits(decoded_length);
-    viterbi_decoder(page_part_symbols_deint.data(), page_part_bits.data());
+    int32_t* page_part_bits = d_scratch.allocate<int32_t>(decoded_length);
+    viterbi_decoder(page_part_symbols_deint, page_part_bits);
 
     // 3. Call the Galileo page decoder
     std::string page_String;
@@ -352,7 +415,7 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
                 {
                     std::cout << TEXT_BLUE << "New Galileo E5b I/NAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << TEXT_RESET << '\n';
                 }
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            this->message_port_pub(msg_ids::telemetry_port(), pmt::make_any(tmp_obj));
         }
     if (d_inav_nav.have_new_iono_and_GST() == true)
         {
@@ -366,7 +429,7 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
                 {
                     std::cout << TEXT_BLUE << "New Galileo E5b I/NAV message received in channel " << d_channel << ": iono/GST model parameters from satellite " << d_satellite << TEXT_RESET << '\n';
                 }
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            this->message_port_pub(msg_ids::telemetry_port(), pmt::make_any(tmp_obj));
         }
     if (d_inav_nav.have_new_utc_model() == true)
         {
@@ -380,14 +443,14 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
                 {
                     std::cout << TEXT_BLUE << "New Galileo E5b I/NAV message received in channel " << d_channel << ": UTC model parameters from satellite " << d_satellite << TEXT_RESET << '\n';
                 }
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            this->message_port_pub(msg_ids::telemetry_port(), pmt::make_any(tmp_obj));
             d_delta_t = tmp_obj->A_0G_10 + tmp_obj->A_1G_10 * (static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0 - tmp_obj->t_0G_10 + 604800 * (std::fmod(static_cast<float>(d_inav_nav.get_Galileo_week() - tmp_obj->WN_0G_10), 64.0)));
             DLOG(INFO) << "delta_t=" << d_delta_t << "[s]";
         }
     if (d_inav_nav.have_new_almanac() == true)
         {
             const std::shared_ptr<Galileo_Almanac_Helper> tmp_obj = std::make_shared<Galileo_Almanac_Helper>(d_inav_nav.get_almanac());
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            this->message_port_pub(msg_ids::telemetry_port(), pmt::make_any(tmp_obj));
             // debug
             if (d_band == '1')
                 {
@@ -407,8 +470,8 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
 void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t frame_length)
 {
     // 1. De-interleave
-    std::vector<float> page_symbols_deint(frame_length);
-    deinterleaver(GALILEO_FNAV_INTERLEAVER_ROWS, GALILEO_FNAV_INTERLEAVER_COLS, page_symbols, page_symbols_deint.data());
+    float* page_symbols_deint = d_scratch.allocate<float>(frame_length);
+    deinterleaver(page_symbols, page_symbols_deint);
 
     // 2. Viterbi decoder
     // 2.1 Take into account the NOT gate in G2 polynomial (Galileo ICD Figure 13, FEC encoder)
@@ -422,8 +485,8 @@ void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t
         }
 
     const int32_t decoded_length = frame_length / 2;
-    std::vector<int32_t> page_bits(decoded_length);
-    viterbi_decoder(page_symbols_deint.data(), page_bits.data());
+    int32_t* page_bits = d_scratch.allocate<int32_t>(decoded_length);
+    viterbi_decoder(page_symbols_deint, page_bits);
 
     // 3. Call the Galileo page decoder
     std::string page_String;
@@ -456,19 +519,19 @@ void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t
         {
             const std::shared_ptr<Galileo_Ephemeris> tmp_obj = std::make_shared<Galileo_Ephemeris>(d_fnav_nav.get_ephemeris());
             std::cout << TEXT_MAGENTA << "New Galileo E5a F/NAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << TEXT_RESET << '\n';
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            this->message_port_pub(msg_ids::telemetry_port(), pmt::make_any(tmp_obj));
         }
     if (d_fnav_nav.have_new_iono_and_GST() == true)
         {
             const std::shared_ptr<Galileo_Iono> tmp_obj = std::make_shared<Galileo_Iono>(d_fnav_nav.get_iono());
             std::cout << TEXT_MAGENTA << "New Galileo E5a F/NAV message received in channel " << d_channel << ": iono/GST model parameters from satellite " << d_satellite << TEXT_RESET << '\n';
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            this->message_port_pub(msg_ids::telemetry_port(), pmt::make_any(tmp_obj));
         }
     if (d_fnav_nav.have_new_utc_model() == true)
         {
             const std::shared_ptr<Galileo_Utc_Model> tmp_obj = std::make_shared<Galileo_Utc_Model>(d_fnav_nav.get_utc_model());
             std::cout << TEXT_MAGENTA << "New Galileo E5a F/NAV message received in channel " << d_channel << ": UTC model parameters from satellite " << d_satellite << TEXT_RESET << '\n';
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            this->message_port_pub(msg_ids::telemetry_port(), pmt::make_any(tmp_obj));
         }
 }
 
@@ -476,8 +539,8 @@ void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t
 void galileo_telemetry_decoder_gs::decode_CNAV_word(float *page_symbols, int32_t page_length)
 {
     // 1. De-interleave
-    std::vector<float> page_symbols_deint(page_length);
-    deinterleaver(GALILEO_CNAV_INTERLEAVER_ROWS, GALILEO_CNAV_INTERLEAVER_COLS, page_symbols, page_symbols_deint.data());
+    float* page_symbols_deint = d_scratch.allocate<float>(page_length);
+    deinterleaver(page_symbols, page_symbols_deint);
 
     // 2. Viterbi decoder
     // 2.1 Take into account the NOT gate in G2 polynomial (Galileo ICD Figure 13, FEC encoder)
@@ -490,8 +553,8 @@ void galileo_telemetry_decoder_gs::decode_CNAV_word(float *page_symbols, int32_t
                 }
         }
     const int32_t decoded_length = page_length / 2;
-    std::vector<int32_t> page_bits(decoded_length);
-    viterbi_decoder(page_symbols_deint.data(), page_bits.data());
+    int32_t* page_bits = d_scratch.allocate<int32_t>(decoded_length);
+    viterbi_decoder(page_symbols_deint, page_bits);
 
     // 3. Call the Galileo page decoder
     std::string page_String;
@@ -509,18 +572,18 @@ void galileo_telemetry_decoder_gs::decode_CNAV_word(float *page_symbols, int32_t
         }
     d_cnav_nav.read_HAS_page(page_String);
 
-    // 4. If we have a new full message, read it
+    // 4. If we have a new full message, send it to PVT
     if (d_cnav_nav.have_new_HAS_message() == true)
         {
-            // TODO: Retrieve data from message and send it somewhere
-            // Galileo_HAS_data has_data = d_cnav_nav.get_HAS_data();
             if (d_cnav_nav.is_HAS_message_dummy())
                 {
-                    std::cout << TEXT_MAGENTA << "New Galileo E6 HAS message received in channel " << d_channel << " from satellite " << d_satellite << TEXT_RESET << '\n';
+                    std::cout << TEXT_MAGENTA << "New Galileo E6 HAS dummy message received in channel " << d_channel << " from satellite " << d_satellite << TEXT_RESET << '\n';
                 }
             else
                 {
-                    std::cout << TEXT_MAGENTA << "New Galileo E6 HAS dummy message received in channel " << d_channel << " from satellite " << d_satellite << TEXT_RESET << '\n';
+                    const std::shared_ptr<Galileo_HAS_data> tmp_obj = std::make_shared<Galileo_HAS_data>(d_cnav_nav.get_HAS_data());
+                    this->message_port_pub(msg_ids::telemetry_port(), pmt::make_any(tmp_obj));
+                    std::cout << TEXT_MAGENTA << "New Galileo E6 HAS message received in channel " << d_channel << " from satellite " << d_satellite << TEXT_RESET << '\n';
                 }
         }
 }
@@ -682,6 +745,7 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                                     {
                                         // try to decode frame
                                         DLOG(INFO) << "Starting page decoder for Galileo satellite " << this->d_satellite;
+                                        Tlm_Event_Journal::get_instance().record(Tlm_Event::preamble_detected, 'E', d_satellite.get_PRN(), d_channel, d_sample_counter, 0);
                                         d_preamble_index = d_sample_counter;  // record the preamble sample stamp
                                         d_CRC_error_counter = 0;
                                         if (corr_value < 0)
@@ -726,40 +790,54 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                                         d_page_part_symbols[i] = -d_symbol_history[i + d_samples_per_preamble];  // because last symbol of the preamble is just received now!
                                     }
                             }
-                        switch (d_frame_type)
+                        bool page_decoded = false;
+                        if (page_quality_ok(d_page_part_symbols.data(), static_cast<int32_t>(d_frame_length_symbols)))
                             {
-                            case 1:  // INAV
-                                decode_INAV_word(d_page_part_symbols.data(), d_frame_length_symbols);
-                                break;
-                            case 2:  // FNAV
-                                decode_FNAV_word(d_page_part_symbols.data(), d_frame_length_symbols);
-                                break;
-                            case 3:  // CNAV
-                                decode_CNAV_word(d_page_part_symbols.data(), d_frame_length_symbols);
-                                break;
-                            default:
-                                return -1;
-                                break;
+                                switch (d_frame_type)
+                                    {
+                                    case 1:  // INAV
+                                        decode_INAV_word(d_page_part_symbols.data(), d_frame_length_symbols);
+                                        break;
+                                    case 2:  // FNAV
+                                        decode_FNAV_word(d_page_part_symbols.data(), d_frame_length_symbols);
+                                        break;
+                                    case 3:  // CNAV
+                                        decode_CNAV_word(d_page_part_symbols.data(), d_frame_length_symbols);
+                                        break;
+                                    default:
+                                        return -1;
+                                        break;
+                                    }
+                                d_scratch.reset();  // the page decode scratch is dead now
+                                page_decoded = true;
+                            }
+                        else
+                            {
+                                DLOG(INFO) << "Page candidate below decode quality gate for Galileo satellite " << this->d_satellite;
                             }
                         d_preamble_index = d_sample_counter;  // record the preamble sample stamp (t_P)
-                        if (d_inav_nav.get_flag_CRC_test() == true or d_fnav_nav.get_flag_CRC_test() == true)
+                        if (page_decoded and (d_inav_nav.get_flag_CRC_test() == true or d_fnav_nav.get_flag_CRC_test() == true))
                             {
                                 d_CRC_error_counter = 0;
                                 d_flag_preamble = true;  // valid preamble indicator (initialized to false every work())
+                                Tlm_Event_Journal::get_instance().record(Tlm_Event::crc_pass, 'E', d_satellite.get_PRN(), d_channel, d_sample_counter, 0);
                                 gr::thread::scoped_lock lock(d_setlock);
                                 d_last_valid_preamble = d_sample_counter;
                                 if (!d_flag_frame_sync)
                                     {
                                         d_flag_frame_sync = true;
                                         DLOG(INFO) << " Frame sync SAT " << this->d_satellite;
+                                        Tlm_Event_Journal::get_instance().record(Tlm_Event::frame_sync, 'E', d_satellite.get_PRN(), d_channel, d_sample_counter, 0);
                                     }
                             }
                         else
                             {
                                 d_CRC_error_counter++;
+                                Tlm_Event_Journal::get_instance().record(Tlm_Event::crc_fail, 'E', d_satellite.get_PRN(), d_channel, d_sample_counter, 0);
                                 if ((d_CRC_error_counter > CRC_ERROR_LIMIT) and (d_frame_type != 3))
                                     {
                                         DLOG(INFO) << "Lost of frame sync SAT " << this->d_satellite;
+                                        Tlm_Event_Journal::get_instance().record(Tlm_Event::frame_sync_lost, 'E', d_satellite.get_PRN(), d_channel, d_sample_counter, 0);
                                         d_flag_frame_sync = false;
                                         d_stat = 0;
                                         d_TOW_at_current_symbol_ms = 0;
@@ -790,6 +868,7 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                                         d_TOW_at_Preamble_ms = static_cast<uint32_t>(d_inav_nav.get_TOW5() * 1000.0);
                                         d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>(GALILEO_INAV_PAGE_PART_MS + (d_required_symbols + 1) * d_PRN_code_period_ms);
                                         d_inav_nav.set_TOW5_flag(false);
+                                        Tlm_Event_Journal::get_instance().record(Tlm_Event::tow_update, 'E', d_satellite.get_PRN(), d_channel, d_sample_counter, d_TOW_at_current_symbol_ms);
                                     }
 
                                 else if (d_inav_nav.is_TOW6_set() == true)  // page 6 arrived and decoded, so we are in the odd page (since Tow refers to the even page, we have to add 1 sec)
@@ -798,6 +877,7 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                                         d_TOW_at_Preamble_ms = static_cast<uint32_t>(d_inav_nav.get_TOW6() * 1000.0);
                                         d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>(GALILEO_INAV_PAGE_PART_MS + (d_required_symbols + 1) * d_PRN_code_period_ms);
                                         d_inav_nav.set_TOW6_flag(false);
+                                        Tlm_Event_Journal::get_instance().record(Tlm_Event::tow_update, 'E', d_satellite.get_PRN(), d_channel, d_sample_counter, d_TOW_at_current_symbol_ms);
                                     }
                                 else
                                     {
@@ -817,6 +897,7 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                                         d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((d_required_symbols + 1) * GALILEO_FNAV_CODES_PER_SYMBOL * GALILEO_E5A_CODE_PERIOD_MS);
                                         // d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((GALILEO_FNAV_CODES_PER_PAGE + GALILEO_FNAV_CODES_PER_PREAMBLE) * GALILEO_E5a_CODE_PERIOD_MS);
                                         d_fnav_nav.set_TOW1_flag(false);
+                                        Tlm_Event_Journal::get_instance().record(Tlm_Event::tow_update, 'E', d_satellite.get_PRN(), d_channel, d_sample_counter, d_TOW_at_current_symbol_ms);
                                     }
                                 else if (d_fnav_nav.is_TOW2_set() == true)
                                     {
@@ -824,6 +905,7 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                                         // d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((GALILEO_FNAV_CODES_PER_PAGE + GALILEO_FNAV_CODES_PER_PREAMBLE) * GALILEO_E5a_CODE_PERIOD_MS);
                                         d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((d_required_symbols + 1) * GALILEO_FNAV_CODES_PER_SYMBOL * GALILEO_E5A_CODE_PERIOD_MS);
                                         d_fnav_nav.set_TOW2_flag(false);
+                                        Tlm_Event_Journal::get_instance().record(Tlm_Event::tow_update, 'E', d_satellite.get_PRN(), d_channel, d_sample_counter, d_TOW_at_current_symbol_ms);
                                     }
                                 else if (d_fnav_nav.is_TOW3_set() == true)
                                     {
@@ -831,6 +913,7 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                                         // d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((GALILEO_FNAV_CODES_PER_PAGE + GALILEO_FNAV_CODES_PER_PREAMBLE) * GALILEO_E5a_CODE_PERIOD_MS);
                                         d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((d_required_symbols + 1) * GALILEO_FNAV_CODES_PER_SYMBOL * GALILEO_E5A_CODE_PERIOD_MS);
                                         d_fnav_nav.set_TOW3_flag(false);
+                                        Tlm_Event_Journal::get_instance().record(Tlm_Event::tow_update, 'E', d_satellite.get_PRN(), d_channel, d_sample_counter, d_TOW_at_current_symbol_ms);
                                     }
                                 else if (d_fnav_nav.is_TOW4_set() == true)
                                     {
@@ -838,6 +921,7 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                                         // d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((GALILEO_FNAV_CODES_PER_PAGE + GALILEO_FNAV_CODES_PER_PREAMBLE) * GALILEO_E5a_CODE_PERIOD_MS);
                                         d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((d_required_symbols + 1) * GALILEO_FNAV_CODES_PER_SYMBOL * GALILEO_E5A_CODE_PERIOD_MS);
                                         d_fnav_nav.set_TOW4_flag(false);
+                                        Tlm_Event_Journal::get_instance().record(Tlm_Event::tow_update, 'E', d_satellite.get_PRN(), d_channel, d_sample_counter, d_TOW_at_current_symbol_ms);
                                     }
                                 else
                                     {
@@ -26,11 +26,14 @@
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
 #include "tlm_conf.h"
+#include "tlm_scratch_arena.h"
+#include "viterbi_fast.h"
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>  // for block
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <cstdint>
 #include <fstream>
+#include <memory>  // for unique_ptr
 #include <string>
 #include <vector>
 
@@ -80,18 +83,19 @@ private:
     const int32_t d_KK = 7;  // Constraint Length
 
     void viterbi_decoder(float *page_part_symbols, int32_t *page_part_bits);
-    void deinterleaver(int32_t rows, int32_t cols, const float *in, float *out);
+    void deinterleaver(const float *in, float *out) const;
+    bool page_quality_ok(const float *page_symbols, int32_t nsymbols) const;
     void decode_INAV_word(float *page_part_symbols, int32_t frame_length);
     void decode_FNAV_word(float *page_symbols, int32_t frame_length);
     void decode_CNAV_word(float *page_symbols, int32_t page_length);
 
     // vars for Viterbi decoder
     std::vector<int32_t> d_preamble_samples;
+    std::vector<int32_t> d_deint_index;  // precomputed deinterleaver permutation
     std::vector<float> d_page_part_symbols;
-    std::vector<int32_t> d_out0;
-    std::vector<int32_t> d_out1;
-    std::vector<int32_t> d_state0;
-    std::vector<int32_t> d_state1;
+    std::unique_ptr<Viterbi_Fast> d_viterbi;
+
+    Tlm_Scratch_Arena d_scratch;  // page decode scratch, rewound after each page
 
     std::string d_dump_filename;
     std::ofstream d_dump_file;
@@ -129,6 +133,8 @@ private:
     uint32_t d_TOW_at_current_symbol_ms;
     uint32_t d_max_symbols_without_valid_frame;
 
+    float d_decode_quality_gate;
+
     char d_band;  // This variable will store which band we are dealing with (Galileo E1 or E5b)
 
     bool d_sent_tlm_failed_msg;
@@ -139,6 +145,7 @@ private:
     bool d_dump;
     bool d_dump_mat;
     bool d_remove_dat;
+    bool d_use_decode_service;
 };
 
 
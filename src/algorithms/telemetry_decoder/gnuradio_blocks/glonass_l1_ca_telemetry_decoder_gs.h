@@ -25,6 +25,7 @@
 #include "gnss_satellite.h"
 #include "gnss_synchro.h"
 #include "tlm_conf.h"
+#include "tlm_preamble_correlator.h"
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>  // for block
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
@@ -32,6 +33,7 @@
 #include <cstdint>
 #include <fstream>  // for ofstream
 #include <string>
+#include <vector>
 
 /** \addtogroup Telemetry_Decoder
  * \{ */
@@ -86,6 +88,8 @@ private:
 
     // Preamble decoding
     std::array<int32_t, GLONASS_GNAV_PREAMBLE_LENGTH_SYMBOLS> d_preambles_symbols{};
+    Tlm_Preamble_Correlator d_preamble_correlator;
+    std::vector<float> d_corr_symbols;
 
     // Storage for incoming data
     boost::circular_buffer<Gnss_Synchro> d_symbol_history;
@@ -24,6 +24,7 @@
 #include "gnss_satellite.h"
 #include "gnss_synchro.h"
 #include "tlm_conf.h"
+#include "tlm_preamble_correlator.h"
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
@@ -31,6 +32,7 @@
 #include <cstdint>
 #include <fstream>
 #include <string>
+#include <vector>
 
 /** \addtogroup Telemetry_Decoder
  * \{ */
@@ -84,6 +86,8 @@ private:
     boost::circular_buffer<Gnss_Synchro> d_symbol_history;
 
     std::array<int32_t, GLONASS_GNAV_PREAMBLE_LENGTH_SYMBOLS> d_preambles_symbols{};
+    Tlm_Preamble_Correlator d_preamble_correlator;
+    std::vector<float> d_corr_symbols;
 
     // Navigation Message variable
     Glonass_Gnav_Navigation_Message d_nav;
@@ -19,9 +19,12 @@
 */
 
 #include "gps_l1_ca_telemetry_decoder_gs.h"
+#include "gnss_message_ids.h"
 #include "gps_ephemeris.h"  // for Gps_Ephemeris
 #include "gps_iono.h"       // for Gps_Iono
 #include "gps_utc_model.h"  // for Gps_Utc_Model
+#include "tlm_event_journal.h"
+#include "tlm_tow_consensus.h"
 #include "tlm_utils.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
@@ -76,6 +79,11 @@ gps_l1_ca_telemetry_decoder_gs::gps_l1_ca_telemetry_decoder_gs(
     d_dump = conf.dump;
     d_dump_mat = conf.dump_mat;
     d_remove_dat = conf.remove_dat;
+    d_use_tow_consensus = conf.tow_consensus;
+    if (!conf.journal_filename.empty())
+        {
+            Tlm_Event_Journal::get_instance().enable(conf.journal_filename, static_cast<uint32_t>(conf.journal_records));
+        }
 
     d_satellite = Gnss_Satellite(satellite.get_system(), satellite.get_PRN());
     DLOG(INFO) << "Initializing GPS L1 TELEMETRY DECODER";
@@ -102,6 +110,7 @@ gps_l1_ca_telemetry_decoder_gs::gps_l1_ca_telemetry_decoder_gs(
                     n++;
                 }
         }
+    d_preamble_correlator.set_preamble(d_preamble_samples.data(), d_samples_per_preamble);
     d_sample_counter = 0ULL;
     d_stat = 0;
     d_preamble_index = 0ULL;
@@ -115,6 +124,7 @@ gps_l1_ca_telemetry_decoder_gs::gps_l1_ca_telemetry_decoder_gs(
     d_flag_preamble = false;
     d_channel = 0;
     d_flag_TOW_set = false;
+    d_flag_TOW_derived = false;
     d_flag_PLL_180_deg_phase_locked = false;
     d_prev_GPS_frame_4bytes = 0;
     d_symbol_history.set_capacity(d_required_symbols);
@@ -229,8 +239,10 @@ bool gps_l1_ca_telemetry_decoder_gs::decode_subframe()
     int32_t word_index = 0;
     uint32_t GPS_frame_4bytes = 0;
     bool subframe_synchro_confirmation = true;
-    for (float subframe_symbol : d_symbol_history)
+    const size_t history_size = d_symbol_history.size();
+    for (size_t symbol_index = 0; symbol_index < history_size; symbol_index++)
         {
+            const float subframe_symbol = d_symbol_history[symbol_index];
             // ******* SYMBOL TO BIT *******
             // symbol to bit
             if (subframe_symbol > 0)
@@ -299,19 +311,19 @@ bool gps_l1_ca_telemetry_decoder_gs::decode_subframe()
                                 {
                                     // get ephemeris object for this SV (mandatory)
                                     const std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(d_nav.get_ephemeris());
-                                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                                    this->message_port_pub(msg_ids::telemetry_port(), pmt::make_any(tmp_obj));
                                 }
                             break;
                         case 4:  // Possible IONOSPHERE and UTC model update (page 18)
                             if (d_nav.get_flag_iono_valid() == true)
                                 {
                                     const std::shared_ptr<Gps_Iono> tmp_obj = std::make_shared<Gps_Iono>(d_nav.get_iono());
-                                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                                    this->message_port_pub(msg_ids::telemetry_port(), pmt::make_any(tmp_obj));
                                 }
                             if (d_nav.get_flag_utc_model_valid() == true)
                                 {
                                     const std::shared_ptr<Gps_Utc_Model> tmp_obj = std::make_shared<Gps_Utc_Model>(d_nav.get_utc_model());
-                                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                                    this->message_port_pub(msg_ids::telemetry_port(), pmt::make_any(tmp_obj));
                                 }
                             break;
                         case 5:
@@ -333,6 +345,7 @@ void gps_l1_ca_telemetry_decoder_gs::reset()
     d_last_valid_preamble = d_sample_counter;
     d_sent_tlm_failed_msg = false;
     d_flag_TOW_set = false;
+    d_flag_TOW_derived = false;
     d_symbol_history.clear();
     d_stat = 0;
     DLOG(INFO) << "Telemetry decoder reset for satellite " << d_satellite;
@@ -374,22 +387,13 @@ int gps_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribute__
                 if (d_symbol_history.size() >= GPS_CA_PREAMBLE_LENGTH_BITS)
                     {
                         // ******* preamble correlation ********
-                        for (int32_t i = 0; i < GPS_CA_PREAMBLE_LENGTH_BITS; i++)
-                            {
-                                if (d_symbol_history[i] < 0.0)  // symbols clipping
-                                    {
-                                        corr_value -= d_preamble_samples[i];
-                                    }
-                                else
-                                    {
-                                        corr_value += d_preamble_samples[i];
-                                    }
-                            }
+                        corr_value = d_preamble_correlator.correlate(d_symbol_history);
                     }
                 if (abs(corr_value) >= d_samples_per_preamble)
                     {
                         d_preamble_index = d_sample_counter;  // record the preamble sample stamp
                         DLOG(INFO) << "Preamble detection for GPS L1 satellite " << this->d_satellite;
+                        Tlm_Event_Journal::get_instance().record(Tlm_Event::preamble_detected, 'G', d_satellite.get_PRN(), d_channel, d_sample_counter, 0);
                         decode_subframe();
                         d_stat = 1;  // enter into frame pre-detection status
                     }
@@ -403,17 +407,7 @@ int gps_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribute__
                 if (d_symbol_history.size() >= GPS_CA_PREAMBLE_LENGTH_BITS)
                     {
                         // ******* preamble correlation ********
-                        for (int32_t i = 0; i < GPS_CA_PREAMBLE_LENGTH_BITS; i++)
-                            {
-                                if (d_symbol_history[i] < 0.0)  // symbols clipping
-                                    {
-                                        corr_value -= d_preamble_samples[i];
-                                    }
-                                else
-                                    {
-                                        corr_value += d_preamble_samples[i];
-                                    }
-                            }
+                        corr_value = d_preamble_correlator.correlate(d_symbol_history);
                     }
                 if (abs(corr_value) >= d_samples_per_preamble)
                     {
@@ -458,26 +452,35 @@ int gps_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribute__
                             {
                                 d_CRC_error_counter = 0;
                                 d_flag_preamble = true;  // valid preamble indicator (initialized to false every work())
+                                Tlm_Event_Journal::get_instance().record(Tlm_Event::crc_pass, 'G', d_satellite.get_PRN(), d_channel, d_sample_counter, 0);
                                 gr::thread::scoped_lock lock(d_setlock);
                                 d_last_valid_preamble = d_sample_counter;
                                 if (!d_flag_frame_sync)
                                     {
                                         d_flag_frame_sync = true;
                                         DLOG(INFO) << " Frame sync SAT " << this->d_satellite;
+                                        Tlm_Event_Journal::get_instance().record(Tlm_Event::frame_sync, 'G', d_satellite.get_PRN(), d_channel, d_sample_counter, 0);
                                     }
                             }
                         else
                             {
                                 d_CRC_error_counter++;
+                                Tlm_Event_Journal::get_instance().record(Tlm_Event::crc_fail, 'G', d_satellite.get_PRN(), d_channel, d_sample_counter, 0);
                                 if (d_CRC_error_counter > 2)
                                     {
                                         DLOG(INFO) << "Lost of frame sync SAT " << this->d_satellite;
+                                        Tlm_Event_Journal::get_instance().record(Tlm_Event::frame_sync_lost, 'G', d_satellite.get_PRN(), d_channel, d_sample_counter, 0);
                                         d_flag_frame_sync = false;
                                         d_stat = 0;
                                         d_TOW_at_current_symbol_ms = 0;
                                         d_TOW_at_Preamble_ms = 0;
                                         d_CRC_error_counter = 0;
                                         d_flag_TOW_set = false;
+                                        d_flag_TOW_derived = false;
+                                        if (d_use_tow_consensus)
+                                            {
+                                                Tlm_Tow_Consensus::get_instance().invalidate(d_channel);
+                                            }
                                     }
                             }
                     }
@@ -490,9 +493,32 @@ int gps_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribute__
         {
             if (!(d_nav.get_TOW() == 0))
                 {
+                    if (d_flag_TOW_derived)
+                        {
+                            // first decoded subframe after a consensus re-seed: the
+                            // provisional TOW was never published and is only logged here
+                            const uint32_t predicted_tow_ms = d_TOW_at_current_symbol_ms + GPS_L1_CA_BIT_PERIOD_MS;
+                            if (predicted_tow_ms != static_cast<uint32_t>(d_nav.get_TOW() * 1000.0))
+                                {
+                                    LOG(WARNING) << "Provisional TOW of channel " << d_channel
+                                                 << " did not match the decoded TOW and has been discarded";
+                                }
+                            else
+                                {
+                                    DLOG(INFO) << "Provisional TOW of channel " << d_channel
+                                               << " confirmed by the decoded TOW";
+                                }
+                            d_flag_TOW_derived = false;
+                        }
                     d_TOW_at_current_symbol_ms = static_cast<uint32_t>(d_nav.get_TOW() * 1000.0);
                     d_TOW_at_Preamble_ms = static_cast<uint32_t>(d_nav.get_TOW() * 1000.0);
                     d_flag_TOW_set = true;
+                    Tlm_Event_Journal::get_instance().record(Tlm_Event::tow_update, 'G', d_satellite.get_PRN(), d_channel, d_sample_counter, d_TOW_at_current_symbol_ms);
+                    if (d_use_tow_consensus)
+                        {
+                            Tlm_Tow_Consensus::get_instance().publish(d_channel, d_TOW_at_current_symbol_ms,
+                                current_symbol.Tracking_sample_counter, static_cast<double>(current_symbol.fs));
+                        }
                 }
             else
                 {
@@ -501,10 +527,28 @@ int gps_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribute__
         }
     else
         {
-            if (d_flag_TOW_set == true)
+            if (d_flag_TOW_set == true or d_flag_TOW_derived == true)
                 {
                     d_TOW_at_current_symbol_ms += GPS_L1_CA_BIT_PERIOD_MS;
                 }
+            else if (d_use_tow_consensus and d_stat == 2)
+                {
+                    // frame sync is back but the next subframe is still seconds
+                    // away: re-seed the TOW from channels with valid time. The
+                    // projection carries the requester-vs-anchor travel-time
+                    // difference (up to a full data bit), so the derived TOW
+                    // stays provisional and no observables are published with
+                    // it until the next decoded HOW confirms it
+                    uint32_t derived_tow_ms = 0;
+                    if (Tlm_Tow_Consensus::get_instance().derive(d_channel, current_symbol.Tracking_sample_counter,
+                            static_cast<double>(current_symbol.fs), GPS_L1_CA_BIT_PERIOD_MS, &derived_tow_ms))
+                        {
+                            d_TOW_at_current_symbol_ms = derived_tow_ms;
+                            d_flag_TOW_derived = true;
+                            LOG(INFO) << "Channel " << d_channel << " provisional TOW derived by cross-channel consensus"
+                                      << " for satellite " << d_satellite;
+                        }
+                }
         }
 
     if (d_flag_TOW_set == true)
@@ -23,7 +23,8 @@
 #include "gnss_synchro.h"
 #include "gps_navigation_message.h"
 #include "tlm_conf.h"
-#include <boost/circular_buffer.hpp>
+#include "tlm_preamble_correlator.h"
+#include "tlm_symbol_ring.h"
 #include <gnuradio/block.h>  // for block
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <array>             // for array
@@ -77,11 +78,12 @@ private:
     Gnss_Satellite d_satellite;
 
     std::array<int32_t, GPS_CA_PREAMBLE_LENGTH_BITS> d_preamble_samples{};
+    Tlm_Preamble_Correlator d_preamble_correlator;
 
     std::string d_dump_filename;
     std::ofstream d_dump_file;
 
-    boost::circular_buffer<float> d_symbol_history;
+    Tlm_Symbol_Ring d_symbol_history;
 
     uint64_t d_sample_counter;
     uint64_t d_preamble_index;
@@ -107,6 +109,8 @@ private:
     bool d_sent_tlm_failed_msg;
     bool d_flag_PLL_180_deg_phase_locked;
     bool d_flag_TOW_set;
+    bool d_flag_TOW_derived;
+    bool d_use_tow_consensus;
     bool d_dump;
     bool d_dump_mat;
     bool d_remove_dat;
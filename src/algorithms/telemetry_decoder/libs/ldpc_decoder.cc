@@ -0,0 +1,164 @@
+/*!
+ * \file ldpc_decoder.cc
+ * \brief Layered normalized min-sum LDPC decoder for navigation messages.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "ldpc_decoder.h"
+#include <algorithm>  // for copy
+#include <cmath>      // for fabs
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+
+Ldpc_Decoder::Ldpc_Decoder(const std::vector<std::vector<int32_t>>& check_nodes,
+    int32_t codeword_length,
+    int32_t max_iterations,
+    float normalization)
+    : d_codeword_length(codeword_length),
+      d_num_checks(static_cast<int32_t>(check_nodes.size())),
+      d_max_iterations(max_iterations),
+      d_normalization(normalization)
+{
+    d_row_start.reserve(d_num_checks + 1);
+    d_row_start.push_back(0);
+    for (const auto& row : check_nodes)
+        {
+            for (const auto col : row)
+                {
+                    d_col_index.push_back(col);
+                }
+            d_row_start.push_back(static_cast<int32_t>(d_col_index.size()));
+        }
+    d_check_messages.resize(d_col_index.size());
+    d_posterior.resize(d_codeword_length);
+}
+
+
+void Ldpc_Decoder::hard_decision(uint8_t output_bits[]) const
+{
+    int32_t n = 0;
+#if defined(__SSE2__)
+    // a bit is 1 when its posterior LLR is negative: extract the sign bits
+    for (; n + 4 <= d_codeword_length; n += 4)
+        {
+            const int mask = _mm_movemask_ps(_mm_loadu_ps(&d_posterior[n]));
+            output_bits[n] = static_cast<uint8_t>(mask & 1);
+            output_bits[n + 1] = static_cast<uint8_t>((mask >> 1) & 1);
+            output_bits[n + 2] = static_cast<uint8_t>((mask >> 2) & 1);
+            output_bits[n + 3] = static_cast<uint8_t>((mask >> 3) & 1);
+        }
+#elif defined(__ARM_NEON)
+    for (; n + 4 <= d_codeword_length; n += 4)
+        {
+            const uint32x4_t sign = vshrq_n_u32(vreinterpretq_u32_f32(vld1q_f32(&d_posterior[n])), 31);
+            uint32_t lanes[4];
+            vst1q_u32(lanes, sign);
+            output_bits[n] = static_cast<uint8_t>(lanes[0]);
+            output_bits[n + 1] = static_cast<uint8_t>(lanes[1]);
+            output_bits[n + 2] = static_cast<uint8_t>(lanes[2]);
+            output_bits[n + 3] = static_cast<uint8_t>(lanes[3]);
+        }
+#endif
+    for (; n < d_codeword_length; n++)
+        {
+            output_bits[n] = (d_posterior[n] < 0.0F ? 1 : 0);
+        }
+}
+
+
+bool Ldpc_Decoder::syndrome_ok(const uint8_t bits[]) const
+{
+    for (int32_t m = 0; m < d_num_checks; m++)
+        {
+            uint8_t parity = 0;
+            for (int32_t e = d_row_start[m]; e < d_row_start[m + 1]; e++)
+                {
+                    parity ^= bits[d_col_index[e]];
+                }
+            if (parity != 0)
+                {
+                    return false;
+                }
+        }
+    return true;
+}
+
+
+bool Ldpc_Decoder::decode(const float input_llr[], uint8_t output_bits[])
+{
+    std::copy(input_llr, input_llr + d_codeword_length, d_posterior.begin());
+    std::fill(d_check_messages.begin(), d_check_messages.end(), 0.0F);
+
+    for (int32_t iteration = 0; iteration < d_max_iterations; iteration++)
+        {
+            // layered sweep: each check row reads the current posteriors,
+            // so later rows already see the corrections of earlier ones
+            for (int32_t m = 0; m < d_num_checks; m++)
+                {
+                    const int32_t row_begin = d_row_start[m];
+                    const int32_t row_end = d_row_start[m + 1];
+
+                    // two-minimum search over the extrinsic magnitudes
+                    float min1 = 1.0e30F;
+                    float min2 = 1.0e30F;
+                    int32_t min_edge = -1;
+                    uint32_t total_sign = 0;
+                    for (int32_t e = row_begin; e < row_end; e++)
+                        {
+                            const float extrinsic = d_posterior[d_col_index[e]] - d_check_messages[e];
+                            const float magnitude = std::fabs(extrinsic);
+                            if (extrinsic < 0.0F)
+                                {
+                                    total_sign ^= 1U;
+                                }
+                            if (magnitude < min1)
+                                {
+                                    min2 = min1;
+                                    min1 = magnitude;
+                                    min_edge = e;
+                                }
+                            else if (magnitude < min2)
+                                {
+                                    min2 = magnitude;
+                                }
+                        }
+
+                    for (int32_t e = row_begin; e < row_end; e++)
+                        {
+                            const int32_t col = d_col_index[e];
+                            const float extrinsic = d_posterior[col] - d_check_messages[e];
+                            const float magnitude = d_normalization * (e == min_edge ? min2 : min1);
+                            uint32_t sign = total_sign;
+                            if (extrinsic < 0.0F)
+                                {
+                                    sign ^= 1U;
+                                }
+                            const float message = (sign != 0U ? -magnitude : magnitude);
+                            d_check_messages[e] = message;
+                            d_posterior[col] = extrinsic + message;
+                        }
+                }
+
+            hard_decision(output_bits);
+            if (syndrome_ok(output_bits))
+                {
+                    return true;
+                }
+        }
+    return false;
+}
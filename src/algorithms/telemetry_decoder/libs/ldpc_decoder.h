@@ -0,0 +1,82 @@
+/*!
+ * \file ldpc_decoder.h
+ * \brief Layered normalized min-sum LDPC decoder for navigation messages.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_LDPC_DECODER_H
+#define GNSS_SDR_LDPC_DECODER_H
+
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs
+ * \{ */
+
+
+/*!
+ * \brief Layered normalized min-sum decoder for binary LDPC codes.
+ *
+ * The parity-check matrix is given at construction as one list of
+ * variable-node indices per check node and is stored in compressed
+ * row form, so the decoder is sized once for a given code (e.g. the
+ * GPS L1C subframe-2 (1200,600) code or the BeiDou B-CNAV codes) and
+ * then reused for every page. Layered scheduling updates the posterior
+ * LLRs after each check row, which roughly halves the iterations needed
+ * compared to a flooding schedule; decoding stops as soon as all parity
+ * checks are satisfied.
+ */
+class Ldpc_Decoder
+{
+public:
+    /*!
+     * \brief Builds the decoder for one code.
+     * \param[in] check_nodes      One vector of variable-node indices per parity check.
+     * \param[in] codeword_length  Number of variable nodes (coded bits).
+     * \param[in] max_iterations   Iteration cap when the syndrome does not clear.
+     * \param[in] normalization    Min-sum normalization factor (typically 0.75).
+     */
+    Ldpc_Decoder(const std::vector<std::vector<int32_t>>& check_nodes,
+        int32_t codeword_length,
+        int32_t max_iterations,
+        float normalization = 0.75F);
+
+    /*!
+     * \brief Decodes one codeword.
+     * \param[in]  input_llr  codeword_length channel LLRs (positive means bit 0).
+     * \param[out] output_bits  codeword_length hard decisions.
+     * \return true if all parity checks are satisfied, false if the
+     * iteration cap was reached (output_bits still holds the best guess).
+     */
+    bool decode(const float input_llr[], uint8_t output_bits[]);
+
+private:
+    void hard_decision(uint8_t output_bits[]) const;
+    bool syndrome_ok(const uint8_t bits[]) const;
+
+    std::vector<int32_t> d_row_start;      // CSR row offsets, one per check node
+    std::vector<int32_t> d_col_index;      // variable-node index of each edge
+    std::vector<float> d_check_messages;   // last check-to-variable message per edge
+    std::vector<float> d_posterior;        // posterior LLR per variable node
+    int32_t d_codeword_length;
+    int32_t d_num_checks;
+    int32_t d_max_iterations;
+    float d_normalization;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_LDPC_DECODER_H
@@ -22,6 +22,10 @@ Tlm_Conf::Tlm_Conf()
     dump = false;
     dump_mat = false;
     remove_dat = false;
+    use_decode_service = false;
+    tow_consensus = false;
+    decode_quality_gate = 0.0;
+    journal_records = 65536;
 }
 
 
@@ -33,4 +37,9 @@ void Tlm_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
     dump = configuration->property(role + ".dump", false);
     dump_mat = configuration->property(role + ".dump_mat", dump);
     remove_dat = configuration->property(role + ".remove_dat", false);
+    use_decode_service = configuration->property(role + ".use_decode_service", false);
+    decode_quality_gate = configuration->property(role + ".decode_quality_gate", static_cast<float>(0.0));
+    tow_consensus = configuration->property("GNSS-SDR.telemetry_tow_consensus", false);
+    journal_filename = configuration->property("GNSS-SDR.telemetry_journal_filename", std::string(""));
+    journal_records = configuration->property("GNSS-SDR.telemetry_journal_records", 65536);
 }
@@ -19,6 +19,7 @@
 #define GNSS_SDR_TLM_CONF_H
 
 #include "configuration_interface.h"
+#include <cstdint>
 #include <string>
 
 /** \addtogroup Telemetry_Decoder
@@ -35,9 +36,14 @@ public:
     void SetFromConfiguration(const ConfigurationInterface *configuration, const std::string &role);
 
     std::string dump_filename;
+    std::string journal_filename;
     bool dump;
     bool dump_mat;
     bool remove_dat;
+    bool use_decode_service;
+    bool tow_consensus;
+    float decode_quality_gate;
+    int32_t journal_records;
 };
 
 
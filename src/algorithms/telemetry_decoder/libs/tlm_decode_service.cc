@@ -0,0 +1,108 @@
+/*!
+ * \file tlm_decode_service.cc
+ * \brief Process-wide service that batches navigation page decodes from
+ * all telemetry channels on a single worker thread.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_decode_service.h"
+#include <glog/logging.h>
+#include <vector>
+
+
+Tlm_Decode_Service& Tlm_Decode_Service::get_instance()
+{
+    static Tlm_Decode_Service instance;
+    return instance;
+}
+
+
+Tlm_Decode_Service::Tlm_Decode_Service()
+{
+    d_running = false;
+    d_shutdown = false;
+}
+
+
+Tlm_Decode_Service::~Tlm_Decode_Service()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_shutdown = true;
+    }
+    d_cond.notify_all();
+    if (d_worker.joinable())
+        {
+            d_worker.join();
+        }
+}
+
+
+void Tlm_Decode_Service::decode(Viterbi_Fast& decoder, int output_u_int[], const float input_c[], int LL)
+{
+    Decode_Job job{&decoder, output_u_int, input_c, LL, false};
+    std::unique_lock<std::mutex> lock(d_mutex);
+    if (!d_running)
+        {
+            start_worker();
+        }
+    d_jobs.push_back(&job);
+    d_cond.notify_one();
+    d_done_cond.wait(lock, [&job] { return job.done; });
+}
+
+
+void Tlm_Decode_Service::start_worker()
+{
+    // called with d_mutex held
+    d_worker = std::thread(&Tlm_Decode_Service::worker_loop, this);
+    d_running = true;
+    LOG(INFO) << "Telemetry decode service started";
+}
+
+
+void Tlm_Decode_Service::worker_loop()
+{
+    std::vector<Decode_Job*> batch;
+    while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait(lock, [this] { return d_shutdown || !d_jobs.empty(); });
+                if (d_shutdown && d_jobs.empty())
+                    {
+                        return;
+                    }
+                // drain the whole queue so pages arriving together are
+                // decoded in one wakeup
+                while (!d_jobs.empty())
+                    {
+                        batch.push_back(d_jobs.front());
+                        d_jobs.pop_front();
+                    }
+            }
+            for (auto* job : batch)
+                {
+                    job->decoder->decode(job->output, job->input, job->LL);
+                }
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                for (auto* job : batch)
+                    {
+                        job->done = true;
+                    }
+            }
+            d_done_cond.notify_all();
+            batch.clear();
+        }
+}
@@ -0,0 +1,87 @@
+/*!
+ * \file tlm_decode_service.h
+ * \brief Process-wide service that batches navigation page decodes from
+ * all telemetry channels on a single worker thread.
+ *
+ * Each telemetry decoder block runs on its own GNU Radio scheduler thread
+ * and decodes a page in a few microseconds, so with many channels the
+ * per-page scheduler wakeups cost more than the decoding itself. This
+ * service funnels the page decodes of all channels through one worker:
+ * the worker drains every queued page per wakeup, so pages that arrive
+ * together (channels are frame-synchronized to within a few symbols) are
+ * decoded back-to-back with warm decoder state.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TLM_DECODE_SERVICE_H
+#define GNSS_SDR_TLM_DECODE_SERVICE_H
+
+#include "viterbi_fast.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs
+ * \{ */
+
+
+/*!
+ * \brief Shared single-worker decode service for telemetry channels.
+ *
+ * The worker thread is started lazily on the first submitted page.
+ * decode() blocks the calling channel until its bits are ready, so the
+ * call is a drop-in replacement for an inline Viterbi_Fast::decode().
+ */
+class Tlm_Decode_Service
+{
+public:
+    static Tlm_Decode_Service& get_instance();
+
+    //! Queues one page for the shared worker and waits for the decoded bits.
+    void decode(Viterbi_Fast& decoder, int output_u_int[], const float input_c[], int LL);
+
+    Tlm_Decode_Service(const Tlm_Decode_Service&) = delete;
+    Tlm_Decode_Service& operator=(const Tlm_Decode_Service&) = delete;
+
+private:
+    Tlm_Decode_Service();
+    ~Tlm_Decode_Service();
+
+    struct Decode_Job
+    {
+        Viterbi_Fast* decoder;
+        int* output;
+        const float* input;
+        int LL;
+        bool done;
+    };
+
+    void worker_loop();
+    void start_worker();
+
+    std::thread d_worker;
+    std::deque<Decode_Job*> d_jobs;
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::condition_variable d_done_cond;
+    bool d_running;
+    bool d_shutdown;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TLM_DECODE_SERVICE_H
@@ -0,0 +1,123 @@
+/*!
+ * \file tlm_event_journal.cc
+ * \brief Binary journal of telemetry decoding events backed by a
+ * memory-mapped ring file.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_event_journal.h"
+#include <glog/logging.h>
+#include <cstring>  // for memcpy, memset
+
+#if !defined(_WIN32)
+#include <fcntl.h>     // for open
+#include <sys/mman.h>  // for mmap, munmap, msync
+#include <unistd.h>    // for close, ftruncate
+#endif
+
+
+Tlm_Event_Journal& Tlm_Event_Journal::get_instance()
+{
+    static Tlm_Event_Journal instance;
+    return instance;
+}
+
+
+Tlm_Event_Journal::~Tlm_Event_Journal()
+{
+#if !defined(_WIN32)
+    if (d_map != nullptr)
+        {
+            d_header->total_records = d_write_index.load();
+            msync(d_map, d_map_size, MS_SYNC);
+            munmap(d_map, d_map_size);
+        }
+#endif
+}
+
+
+bool Tlm_Event_Journal::enable(const std::string& filename, uint32_t capacity_records)
+{
+#if defined(_WIN32)
+    LOG(WARNING) << "The telemetry event journal is not available on this platform";
+    return false;
+#else
+    if (d_enable_attempted.exchange(true))
+        {
+            return d_enabled.load();
+        }
+    if (capacity_records == 0)
+        {
+            capacity_records = 1;
+        }
+    const uint64_t map_size = sizeof(Tlm_Journal_Header) + static_cast<uint64_t>(capacity_records) * sizeof(Tlm_Journal_Record);
+    const int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        {
+            LOG(WARNING) << "Could not create telemetry journal file " << filename;
+            return false;
+        }
+    if (ftruncate(fd, static_cast<off_t>(map_size)) != 0)
+        {
+            LOG(WARNING) << "Could not size telemetry journal file " << filename;
+            close(fd);
+            return false;
+        }
+    void* map = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // the mapping keeps its own reference
+    if (map == MAP_FAILED)
+        {
+            LOG(WARNING) << "Could not map telemetry journal file " << filename;
+            return false;
+        }
+    std::memset(map, 0, sizeof(Tlm_Journal_Header));
+    d_map = map;
+    d_map_size = map_size;
+    d_header = static_cast<Tlm_Journal_Header*>(map);
+    d_ring = reinterpret_cast<Tlm_Journal_Record*>(static_cast<char*>(map) + sizeof(Tlm_Journal_Header));
+    std::memcpy(d_header->magic, "GSTJ", 4);
+    d_header->version = 1;
+    d_header->capacity = capacity_records;
+    d_header->record_size = sizeof(Tlm_Journal_Record);
+    d_header->total_records = 0;
+    d_capacity = capacity_records;
+    d_enabled.store(true, std::memory_order_release);
+    LOG(INFO) << "Telemetry event journal enabled: " << filename
+              << " (" << capacity_records << " records)";
+    return true;
+#endif
+}
+
+
+void Tlm_Event_Journal::record(Tlm_Event event, char system, uint16_t prn, int32_t channel,
+    uint64_t sample_counter, uint32_t value)
+{
+    if (!d_enabled.load(std::memory_order_acquire))
+        {
+            return;
+        }
+    const uint64_t index = d_write_index.fetch_add(1, std::memory_order_relaxed);
+    Tlm_Journal_Record* slot = &d_ring[index % d_capacity];
+    slot->seq = 0;
+    slot->sample_counter = sample_counter;
+    slot->value = value;
+    slot->channel = channel;
+    slot->event = static_cast<uint8_t>(event);
+    slot->system = system;
+    slot->prn = prn;
+    slot->pad = 0;
+    // publish the record: the non-zero sequence number marks it complete
+    std::atomic_thread_fence(std::memory_order_release);
+    slot->seq = index + 1;
+    d_header->total_records = index + 1;
+}
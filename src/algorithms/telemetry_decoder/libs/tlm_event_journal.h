@@ -0,0 +1,115 @@
+/*!
+ * \file tlm_event_journal.h
+ * \brief Binary journal of telemetry decoding events backed by a
+ * memory-mapped ring file.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TLM_EVENT_JOURNAL_H
+#define GNSS_SDR_TLM_EVENT_JOURNAL_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs
+ * \{ */
+
+
+//! Event codes stored in the journal records
+enum class Tlm_Event : uint8_t
+{
+    preamble_detected = 1,
+    frame_sync = 2,
+    frame_sync_lost = 3,
+    crc_pass = 4,
+    crc_fail = 5,
+    tow_update = 6,
+};
+
+
+//! Fixed 32-byte on-disk record. seq is written last and is zero while a
+//! writer is filling the slot, so readers can detect torn records.
+struct Tlm_Journal_Record
+{
+    uint64_t seq;
+    uint64_t sample_counter;
+    uint32_t value;
+    int32_t channel;
+    uint8_t event;
+    char system;
+    uint16_t prn;
+    uint32_t pad;
+};
+
+
+//! File header preceding the ring of records
+struct Tlm_Journal_Header
+{
+    char magic[4];  // "GSTJ"
+    uint32_t version;
+    uint32_t capacity;     // number of record slots
+    uint32_t record_size;  // sizeof(Tlm_Journal_Record)
+    uint64_t total_records;
+};
+
+
+/*!
+ * \brief Process-wide journal of telemetry decoding decisions.
+ *
+ * Preamble detections, CRC results and TOW updates are appended as
+ * fixed-size binary records to a memory-mapped ring file, timestamped
+ * with the channel sample counter. Writers reserve a slot with one
+ * atomic fetch-add and never block each other, so the journal is cheap
+ * enough to stay enabled in production; record() is a no-op until
+ * enable() has mapped the file. The journal is read offline with the
+ * tlm_journal_dump tool under src/utils/tlm-journal.
+ */
+class Tlm_Event_Journal
+{
+public:
+    static Tlm_Event_Journal& get_instance();
+
+    /*!
+     * \brief Creates and maps the journal file. The first successful call
+     * wins; later calls (e.g. from other channels) are no-ops returning true.
+     */
+    bool enable(const std::string& filename, uint32_t capacity_records);
+
+    //! Appends one event record. No-op when the journal is not enabled.
+    void record(Tlm_Event event, char system, uint16_t prn, int32_t channel,
+        uint64_t sample_counter, uint32_t value);
+
+    Tlm_Event_Journal(const Tlm_Event_Journal&) = delete;
+    Tlm_Event_Journal& operator=(const Tlm_Event_Journal&) = delete;
+
+private:
+    Tlm_Event_Journal() = default;
+    ~Tlm_Event_Journal();
+
+    Tlm_Journal_Header* d_header = nullptr;
+    Tlm_Journal_Record* d_ring = nullptr;
+    void* d_map = nullptr;
+    uint64_t d_map_size = 0;
+    uint32_t d_capacity = 0;
+    std::atomic<uint64_t> d_write_index{0};
+    std::atomic<bool> d_enabled{false};
+    std::atomic<bool> d_enable_attempted{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TLM_EVENT_JOURNAL_H
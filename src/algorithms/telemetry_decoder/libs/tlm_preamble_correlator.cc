@@ -0,0 +1,71 @@
+/*!
+ * \file tlm_preamble_correlator.cc
+ * \brief Matched filter correlating the hard-limited symbol history
+ * against a frame preamble, shared by the telemetry decoders.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_preamble_correlator.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>  // for min
+#include <bitset>     // for popcount
+
+
+void Tlm_Preamble_Correlator::set_preamble(const int32_t preamble_samples[], int32_t length)
+{
+    d_preamble.resize(length);
+    d_preamble_bits = 0;
+    d_length = length;
+    for (int32_t i = 0; i < length; i++)
+        {
+            d_preamble[i] = static_cast<float>(preamble_samples[i]);
+            if (preamble_samples[i] > 0)
+                {
+                    d_preamble_bits |= uint64_t(1) << i;
+                }
+        }
+}
+
+
+int32_t Tlm_Preamble_Correlator::correlate(const Tlm_Symbol_Ring& symbol_history) const
+{
+    const uint64_t mismatches = std::bitset<64>(symbol_history.sign_word(0, d_length) ^ d_preamble_bits).count();
+    return d_length - 2 * static_cast<int32_t>(mismatches);
+}
+
+
+int32_t Tlm_Preamble_Correlator::correlate(const boost::circular_buffer<float>& symbol_history) const
+{
+    const auto len = d_preamble.size();
+    float sum = 0.0F;
+    // the circular buffer exposes at most two contiguous segments
+    const auto segment_one = symbol_history.array_one();
+    const size_t n = std::min(len, segment_one.second);
+    volk_gnsssdr_32f_x2_sign_dot_prod_32f(&sum, segment_one.first, d_preamble.data(), n);
+    if (n < len)
+        {
+            float sum_two = 0.0F;
+            const auto segment_two = symbol_history.array_two();
+            volk_gnsssdr_32f_x2_sign_dot_prod_32f(&sum_two, segment_two.first, &d_preamble[n], len - n);
+            sum += sum_two;
+        }
+    return static_cast<int32_t>(sum);
+}
+
+
+int32_t Tlm_Preamble_Correlator::correlate(const float symbols[]) const
+{
+    float sum = 0.0F;
+    volk_gnsssdr_32f_x2_sign_dot_prod_32f(&sum, symbols, d_preamble.data(), d_preamble.size());
+    return static_cast<int32_t>(sum);
+}
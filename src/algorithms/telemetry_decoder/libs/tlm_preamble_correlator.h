@@ -0,0 +1,70 @@
+/*!
+ * \file tlm_preamble_correlator.h
+ * \brief Matched filter correlating the hard-limited symbol history
+ * against a frame preamble, shared by the telemetry decoders.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TLM_PREAMBLE_CORRELATOR_H
+#define GNSS_SDR_TLM_PREAMBLE_CORRELATOR_H
+
+#include "tlm_symbol_ring.h"
+#include <boost/circular_buffer.hpp>
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs
+ * \{ */
+
+
+/*!
+ * \brief Preamble matched filter over the telemetry symbol history.
+ *
+ * The preamble is stored once as a float sequence so that the per-symbol
+ * correlation runs as a single vectorized hard-limited dot product
+ * instead of a scalar compare-and-accumulate loop. The result is
+ * identical to the classic sliding correlation with symbol clipping.
+ */
+class Tlm_Preamble_Correlator
+{
+public:
+    Tlm_Preamble_Correlator() = default;
+
+    //! Sets the preamble sequence (+1/-1 samples)
+    void set_preamble(const int32_t preamble_samples[], int32_t length);
+
+    //! Correlates the oldest preamble-length symbols of the ring against the preamble
+    int32_t correlate(const boost::circular_buffer<float>& symbol_history) const;
+
+    /*!
+     * \brief Correlates the oldest preamble-length symbols of the ring
+     * against the preamble using the packed hard decisions: a single XOR
+     * plus population count per symbol, valid for preambles up to 64 bits
+     */
+    int32_t correlate(const Tlm_Symbol_Ring& symbol_history) const;
+
+    //! Correlates a contiguous array of preamble-length symbols against the preamble
+    int32_t correlate(const float symbols[]) const;
+
+private:
+    std::vector<float> d_preamble;
+    uint64_t d_preamble_bits = 0;
+    int32_t d_length = 0;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TLM_PREAMBLE_CORRELATOR_H
@@ -0,0 +1,62 @@
+/*!
+ * \file tlm_scratch_arena.cc
+ * \brief Per-channel bump arena for telemetry decode scratch buffers.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_scratch_arena.h"
+
+
+void Tlm_Scratch_Arena::reserve(size_t capacity_bytes)
+{
+    d_buffer.resize(capacity_bytes);
+    d_offset = 0;
+    d_overflow.clear();
+    d_overflow_bytes = 0;
+}
+
+
+void* Tlm_Scratch_Arena::allocate_bytes(size_t bytes, size_t alignment)
+{
+    const size_t aligned_offset = (d_offset + alignment - 1) & ~(alignment - 1);
+    if (aligned_offset + bytes <= d_buffer.size())
+        {
+            d_offset = aligned_offset + bytes;
+            return d_buffer.data() + aligned_offset;
+        }
+    // Undersized arena: serve the request from the heap and remember the
+    // shortfall, so reset() can grow the arena for the next page.
+    d_overflow.emplace_back(new unsigned char[bytes + alignment]);
+    d_overflow_bytes += bytes + alignment;
+    auto addr = reinterpret_cast<size_t>(d_overflow.back().get());
+    const size_t aligned_addr = (addr + alignment - 1) & ~(alignment - 1);
+    return reinterpret_cast<void*>(aligned_addr);
+}
+
+
+void Tlm_Scratch_Arena::reset()
+{
+    if (!d_overflow.empty())
+        {
+            d_buffer.resize(d_buffer.size() + d_overflow_bytes);
+            d_overflow.clear();
+            d_overflow_bytes = 0;
+        }
+    d_offset = 0;
+}
+
+
+size_t Tlm_Scratch_Arena::used() const
+{
+    return d_offset + d_overflow_bytes;
+}
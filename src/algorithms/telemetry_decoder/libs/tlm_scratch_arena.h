@@ -0,0 +1,74 @@
+/*!
+ * \file tlm_scratch_arena.h
+ * \brief Per-channel bump arena for telemetry decode scratch buffers.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TLM_SCRATCH_ARENA_H
+#define GNSS_SDR_TLM_SCRATCH_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs
+ * \{ */
+
+
+/*!
+ * \brief Bump allocator for the short-lived scratch buffers of a page
+ * decode (deinterleaved symbols, decoded bits).
+ *
+ * The decoder reserves the arena once when the channel is set up and
+ * rewinds it with reset() after each page, so the decode path performs
+ * no heap allocations in steady state and does not contend on the
+ * global allocator lock with the tracking threads. If a page needs more
+ * scratch than reserved, the overflow is served from the heap and the
+ * arena grows on the next reset().
+ */
+class Tlm_Scratch_Arena
+{
+public:
+    Tlm_Scratch_Arena() = default;
+
+    //! Reserves \p capacity_bytes of scratch storage
+    void reserve(size_t capacity_bytes);
+
+    //! Returns scratch for \p count elements of type T, valid until reset()
+    template <typename T>
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(allocate_bytes(count * sizeof(T), alignof(T)));
+    }
+
+    //! Rewinds the arena; all pointers handed out so far become invalid
+    void reset();
+
+    //! Bytes handed out since the last reset(), including overflow
+    size_t used() const;
+
+private:
+    void* allocate_bytes(size_t bytes, size_t alignment);
+
+    std::vector<unsigned char> d_buffer;
+    std::vector<std::unique_ptr<unsigned char[]>> d_overflow;
+    size_t d_offset = 0;
+    size_t d_overflow_bytes = 0;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TLM_SCRATCH_ARENA_H
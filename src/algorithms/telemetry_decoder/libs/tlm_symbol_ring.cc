@@ -0,0 +1,61 @@
+/*!
+ * \file tlm_symbol_ring.cc
+ * \brief Fixed-size power-of-two ring of telemetry symbols with packed
+ * hard-decision sign bits.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_symbol_ring.h"
+#include <algorithm>  // for fill
+
+
+void Tlm_Symbol_Ring::set_capacity(size_t window)
+{
+    d_window = window;
+    // round the allocation up to a power of two not smaller than 64 slots,
+    // so slot wrap-around coincides with the wrap of the packed sign words
+    size_t capacity = 64;
+    while (capacity < window)
+        {
+            capacity <<= 1U;
+        }
+    d_mask = capacity - 1;
+    d_buffer.assign(capacity, 0.0F);
+    d_signs.assign(capacity >> 6U, 0ULL);
+    d_count = 0;
+}
+
+
+void Tlm_Symbol_Ring::clear()
+{
+    std::fill(d_signs.begin(), d_signs.end(), 0ULL);
+    d_count = 0;
+}
+
+
+uint64_t Tlm_Symbol_Ring::sign_word(size_t index, int32_t nbits) const
+{
+    const size_t slot = (d_count - size() + index) & d_mask;
+    const size_t word = slot >> 6U;
+    const size_t bit = slot & 63U;
+    uint64_t result = d_signs[word] >> bit;
+    if (bit != 0 && (64 - bit) < static_cast<size_t>(nbits))
+        {
+            result |= d_signs[(word + 1) & (d_signs.size() - 1)] << (64U - bit);
+        }
+    if (nbits < 64)
+        {
+            result &= (uint64_t(1) << nbits) - 1;
+        }
+    return result;
+}
@@ -0,0 +1,99 @@
+/*!
+ * \file tlm_symbol_ring.h
+ * \brief Fixed-size power-of-two ring of telemetry symbols with packed
+ * hard-decision sign bits.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TLM_SYMBOL_RING_H
+#define GNSS_SDR_TLM_SYMBOL_RING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs
+ * \{ */
+
+
+/*!
+ * \brief Sliding window of soft telemetry symbols stored in a fixed
+ * power-of-two ring.
+ *
+ * Replaces boost::circular_buffer in the per-symbol hot path of the
+ * telemetry decoders: indexing uses a bit mask instead of a modulo, the
+ * storage is allocated once in set_capacity(), and the hard decision of
+ * every symbol is kept packed one bit per slot so a preamble correlation
+ * over the window head reduces to an XOR plus population count
+ * (see Tlm_Preamble_Correlator::correlate(const Tlm_Symbol_Ring&)).
+ * Indexing follows boost::circular_buffer: operator[](0) is the oldest
+ * symbol of the window.
+ */
+class Tlm_Symbol_Ring
+{
+public:
+    //! Sets the window length and allocates the ring. Discards previous content.
+    void set_capacity(size_t window);
+
+    //! Appends a symbol, dropping the oldest one once the window is full
+    inline void push_back(float symbol)
+    {
+        const size_t slot = d_count & d_mask;
+        d_buffer[slot] = symbol;
+        const uint64_t bit = uint64_t(1) << (slot & 63U);
+        if (symbol < 0.0F)
+            {
+                d_signs[slot >> 6U] &= ~bit;
+            }
+        else
+            {
+                d_signs[slot >> 6U] |= bit;
+            }
+        d_count++;
+    }
+
+    //! Number of symbols currently in the window
+    inline size_t size() const
+    {
+        return (d_count < d_window ? d_count : d_window);
+    }
+
+    //! Oldest-first access within the window
+    inline float operator[](size_t index) const
+    {
+        return d_buffer[(d_count - size() + index) & d_mask];
+    }
+
+    //! Empties the window without releasing the storage
+    void clear();
+
+    /*!
+     * \brief Returns up to 64 packed hard decisions (bit i set when the
+     * symbol at oldest-first position index + i is non-negative)
+     */
+    uint64_t sign_word(size_t index, int32_t nbits) const;
+
+private:
+    std::vector<float> d_buffer;
+    std::vector<uint64_t> d_signs;
+    size_t d_window = 0;
+    size_t d_mask = 0;
+    size_t d_count = 0;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TLM_SYMBOL_RING_H
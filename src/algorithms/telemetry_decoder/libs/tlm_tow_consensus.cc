@@ -0,0 +1,106 @@
+/*!
+ * \file tlm_tow_consensus.cc
+ * \brief Cross-channel consensus service re-seeding the TOW of a
+ * resynchronized channel from channels with valid time.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_tow_consensus.h"
+#include <algorithm>  // for sort
+#include <cmath>      // for round, abs
+#include <vector>
+
+namespace
+{
+// anchors older than this are considered stale and are not projected
+constexpr double MAX_ANCHOR_AGE_S = 10.0;
+// two projections must fall this close to the median to form a consensus
+constexpr double CONSENSUS_TOLERANCE_MS = 10.0;
+}  // namespace
+
+
+Tlm_Tow_Consensus& Tlm_Tow_Consensus::get_instance()
+{
+    static Tlm_Tow_Consensus instance;
+    return instance;
+}
+
+
+void Tlm_Tow_Consensus::publish(int32_t channel, uint32_t tow_ms, uint64_t sample_stamp, double fs)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_anchors[channel] = {tow_ms, sample_stamp, fs};
+}
+
+
+void Tlm_Tow_Consensus::invalidate(int32_t channel)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_anchors.erase(channel);
+}
+
+
+bool Tlm_Tow_Consensus::derive(int32_t channel, uint64_t sample_stamp, double fs,
+    uint32_t symbol_period_ms, uint32_t* tow_ms)
+{
+    if (fs <= 0.0 || symbol_period_ms == 0)
+        {
+            return false;
+        }
+    std::vector<double> projections;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        projections.reserve(d_anchors.size());
+        for (const auto& anchor : d_anchors)
+            {
+                if (anchor.first == channel)
+                    {
+                        continue;
+                    }
+                // project the anchor to the requested sample stamp. The sample
+                // counters of all channels count samples of the same front-end
+                // stream, so the elapsed time is just the stamp difference
+                const double elapsed_s = (static_cast<double>(sample_stamp) - static_cast<double>(anchor.second.sample_stamp)) / anchor.second.fs;
+                if (std::abs(elapsed_s) > MAX_ANCHOR_AGE_S)
+                    {
+                        continue;
+                    }
+                projections.push_back(static_cast<double>(anchor.second.tow_ms) + elapsed_s * 1000.0);
+            }
+    }
+    if (projections.size() < 2)
+        {
+            return false;
+        }
+    std::sort(projections.begin(), projections.end());
+    const double median = projections[projections.size() / 2];
+    int32_t agreeing = 0;
+    for (const double projection : projections)
+        {
+            if (std::abs(projection - median) <= CONSENSUS_TOLERANCE_MS)
+                {
+                    agreeing++;
+                }
+        }
+    if (agreeing < 2)
+        {
+            return false;
+        }
+    // snap to the symbol grid of the requesting channel. The projection does
+    // not model the requester-vs-anchor travel-time difference, so the snap
+    // can pick a neighbouring data bit: the result is provisional by contract
+    // and must be confirmed by a decoded subframe before it is published
+    const auto period = static_cast<double>(symbol_period_ms);
+    *tow_ms = static_cast<uint32_t>(std::round(median / period)) * symbol_period_ms;
+    return true;
+}
@@ -0,0 +1,85 @@
+/*!
+ * \file tlm_tow_consensus.h
+ * \brief Cross-channel consensus service re-seeding the TOW of a
+ * resynchronized channel from channels with valid time.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TLM_TOW_CONSENSUS_H
+#define GNSS_SDR_TLM_TOW_CONSENSUS_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs
+ * \{ */
+
+
+/*!
+ * \brief Receiver-wide TOW consensus across telemetry channels.
+ *
+ * Channels with decoded time publish their TOW anchored to the absolute
+ * tracking sample counter. A channel that has just regained frame sync
+ * can then derive its TOW immediately instead of waiting for the next
+ * subframe: every fresh anchor is projected to the requesting sample
+ * stamp and the median projection is accepted when at least two anchors
+ * agree, snapped to the requesting channel's symbol grid. The projection
+ * ignores the requester-vs-anchor signal travel-time difference, which
+ * can reach tens of ms, so the snap can land on the wrong data bit:
+ * callers must treat the derived TOW as provisional and must not
+ * publish observables with it until a decoded subframe confirms it.
+ */
+class Tlm_Tow_Consensus
+{
+public:
+    static Tlm_Tow_Consensus& get_instance();
+
+    //! Publishes the decoded TOW of a channel at a given sample stamp
+    void publish(int32_t channel, uint32_t tow_ms, uint64_t sample_stamp, double fs);
+
+    //! Removes the anchor of a channel that lost its time reference
+    void invalidate(int32_t channel);
+
+    /*!
+     * \brief Derives the TOW at sample_stamp for a channel without time.
+     * Returns true and writes tow_ms when at least two other channels
+     * project a consistent TOW; tow_ms is a multiple of symbol_period_ms.
+     */
+    bool derive(int32_t channel, uint64_t sample_stamp, double fs,
+        uint32_t symbol_period_ms, uint32_t* tow_ms);
+
+    Tlm_Tow_Consensus(const Tlm_Tow_Consensus&) = delete;
+    Tlm_Tow_Consensus& operator=(const Tlm_Tow_Consensus&) = delete;
+
+private:
+    Tlm_Tow_Consensus() = default;
+    ~Tlm_Tow_Consensus() = default;
+
+    struct Tow_Anchor
+    {
+        uint32_t tow_ms;
+        uint64_t sample_stamp;
+        double fs;
+    };
+
+    std::map<int32_t, Tow_Anchor> d_anchors;
+    std::mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TLM_TOW_CONSENSUS_H
@@ -0,0 +1,197 @@
+/*!
+ * \file viterbi_fast.cc
+ * \brief Implementation of a vectorized Viterbi decoder for block decoding.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "viterbi_fast.h"
+#include "convolutional.h"
+#include <algorithm>  // for fill
+#include <cstddef>    // for size_t
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+
+Viterbi_Fast::Viterbi_Fast(const int g_encoder[], int KK, int nn)
+    : d_KK(KK),
+      d_nn(nn),
+      d_mm(KK - 1),
+      d_states(1 << (KK - 1)),
+      d_number_symbols(1 << nn)
+{
+    d_out0.resize(d_states);
+    d_state0.resize(d_states);
+    d_out1.resize(d_states);
+    d_state1.resize(d_states);
+    std::vector<int> g(g_encoder, g_encoder + nn);
+    nsc_transit(d_out0.data(), d_state0.data(), 0, g.data(), d_KK, d_nn);
+    nsc_transit(d_out1.data(), d_state1.data(), 1, g.data(), d_KK, d_nn);
+
+    // the butterfly layout requires the feedforward state update
+    // next = (input << (KK - 2)) | (state >> 1), so that the two
+    // predecessors of state n are 2*(n mod states/2) and 2*(n mod states/2)+1
+    // and the input bit that leads into n is its most significant state bit
+    d_butterfly = true;
+    for (int state = 0; state < d_states; state++)
+        {
+            if ((d_state0[state] != (state >> 1)) ||
+                (d_state1[state] != ((state >> 1) | (1 << (d_KK - 2)))))
+                {
+                    d_butterfly = false;
+                    break;
+                }
+        }
+
+    if (d_butterfly)
+        {
+            d_pm.resize(d_states);
+            d_pm_next.resize(d_states);
+            d_pm_even.resize(d_states / 2);
+            d_pm_odd.resize(d_states / 2);
+            d_bm0.resize(d_states);
+            d_bm1.resize(d_states);
+            d_metric_c.resize(d_number_symbols);
+            d_sym0.resize(d_states);
+            d_sym1.resize(d_states);
+            const int half_mask = (d_states / 2) - 1;
+            for (int n = 0; n < d_states; n++)
+                {
+                    const int bit = n >> (d_mm - 1);
+                    const int pred_even = 2 * (n & half_mask);
+                    const int pred_odd = pred_even + 1;
+                    d_sym0[n] = (bit ? d_out1[pred_even] : d_out0[pred_even]);
+                    d_sym1[n] = (bit ? d_out1[pred_odd] : d_out0[pred_odd]);
+                }
+        }
+}
+
+
+void Viterbi_Fast::acs_span(const float* pm_even, const float* pm_odd,
+    const float* bm0, const float* bm1,
+    float* pm_next, uint8_t* decisions, int len)
+{
+    int n = 0;
+#if defined(__SSE2__)
+    for (; n + 4 <= len; n += 4)
+        {
+            const __m128 cand0 = _mm_add_ps(_mm_loadu_ps(pm_even + n), _mm_loadu_ps(bm0 + n));
+            const __m128 cand1 = _mm_add_ps(_mm_loadu_ps(pm_odd + n), _mm_loadu_ps(bm1 + n));
+            _mm_storeu_ps(pm_next + n, _mm_max_ps(cand0, cand1));
+            const int mask = _mm_movemask_ps(_mm_cmpgt_ps(cand1, cand0));
+            decisions[n] = static_cast<uint8_t>(mask & 1);
+            decisions[n + 1] = static_cast<uint8_t>((mask >> 1) & 1);
+            decisions[n + 2] = static_cast<uint8_t>((mask >> 2) & 1);
+            decisions[n + 3] = static_cast<uint8_t>((mask >> 3) & 1);
+        }
+#elif defined(__ARM_NEON)
+    for (; n + 4 <= len; n += 4)
+        {
+            const float32x4_t cand0 = vaddq_f32(vld1q_f32(pm_even + n), vld1q_f32(bm0 + n));
+            const float32x4_t cand1 = vaddq_f32(vld1q_f32(pm_odd + n), vld1q_f32(bm1 + n));
+            vst1q_f32(pm_next + n, vmaxq_f32(cand0, cand1));
+            const uint32x4_t greater = vcgtq_f32(cand1, cand0);
+            uint32_t lanes[4];
+            vst1q_u32(lanes, greater);
+            decisions[n] = static_cast<uint8_t>(lanes[0] & 1U);
+            decisions[n + 1] = static_cast<uint8_t>(lanes[1] & 1U);
+            decisions[n + 2] = static_cast<uint8_t>(lanes[2] & 1U);
+            decisions[n + 3] = static_cast<uint8_t>(lanes[3] & 1U);
+        }
+#endif
+    for (; n < len; n++)
+        {
+            const float cand0 = pm_even[n] + bm0[n];
+            const float cand1 = pm_odd[n] + bm1[n];
+            pm_next[n] = (cand0 >= cand1 ? cand0 : cand1);
+            decisions[n] = (cand1 > cand0 ? 1 : 0);
+        }
+}
+
+
+void Viterbi_Fast::decode(int output_u_int[], const float input_c[], int LL)
+{
+    if (!d_butterfly)
+        {
+            // generator polynomials outside the expected structure: scalar engine
+            Viterbi(output_u_int, d_out0.data(), d_state0.data(), d_out1.data(), d_state1.data(),
+                input_c, d_KK, d_nn, LL);
+            return;
+        }
+
+    const int sections = LL + d_mm;
+    const int half = d_states / 2;
+    const int half_mask = half - 1;
+    d_decisions.resize(static_cast<size_t>(sections) * d_states);
+
+    std::fill(d_pm.begin(), d_pm.end(), -MAXLOG);
+    d_pm[0] = 0.0F;  // start in all-zeros state
+
+    for (int t = 0; t < sections; t++)
+        {
+            const float* rec_array = &input_c[d_nn * t];
+
+            /* precompute all possible branch metrics */
+            for (int i = 0; i < d_number_symbols; i++)
+                {
+                    d_metric_c[i] = Gamma(rec_array, i, d_nn);
+                }
+            for (int n = 0; n < d_states; n++)
+                {
+                    d_bm0[n] = d_metric_c[d_sym0[n]];
+                    d_bm1[n] = d_metric_c[d_sym1[n]];
+                }
+
+            // predecessor metrics in butterfly order
+            for (int k = 0; k < half; k++)
+                {
+                    d_pm_even[k] = d_pm[2 * k];
+                    d_pm_odd[k] = d_pm[2 * k + 1];
+                }
+
+            // the predecessor index wraps at states/2, so the two halves of
+            // the state range see the same contiguous predecessor metrics
+            uint8_t* decisions_t = &d_decisions[static_cast<size_t>(t) * d_states];
+            acs_span(d_pm_even.data(), d_pm_odd.data(), d_bm0.data(), d_bm1.data(),
+                d_pm_next.data(), decisions_t, half);
+            acs_span(d_pm_even.data(), d_pm_odd.data(), &d_bm0[half], &d_bm1[half],
+                &d_pm_next[half], decisions_t + half, half);
+
+            /* normalize */
+            uint32_t max_index = 0;
+            volk_gnsssdr_32f_index_max_32u(&max_index, d_pm_next.data(), d_states);
+            const float max_val = d_pm_next[max_index];
+            for (int n = 0; n < d_states; n++)
+                {
+                    d_pm[n] = d_pm_next[n] - max_val;
+                }
+        }
+
+    /* trace-back operation */
+    int state = 0;
+
+    /* tail, no need to output */
+    for (int t = sections - 1; t >= LL; t--)
+        {
+            state = 2 * (state & half_mask) + d_decisions[static_cast<size_t>(t) * d_states + state];
+        }
+
+    for (int t = LL - 1; t >= 0; t--)
+        {
+            output_u_int[t] = state >> (d_mm - 1);
+            state = 2 * (state & half_mask) + d_decisions[static_cast<size_t>(t) * d_states + state];
+        }
+}
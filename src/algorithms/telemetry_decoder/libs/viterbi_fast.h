@@ -0,0 +1,103 @@
+/*!
+ * \file viterbi_fast.h
+ * \brief Interface of a vectorized Viterbi decoder for block decoding.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * The nonsystematic feedforward codes used by the navigation messages have a
+ * butterfly trellis: every state has exactly two predecessors at consecutive
+ * indices, and the input bit is given by the state index itself. Laying the
+ * add-compare-select out in predecessor order turns the inner loop into a
+ * streaming max/select over contiguous arrays that is computed four states at
+ * a time with SSE2 or NEON, with one decision bit per state for the
+ * trace-back, instead of the scalar scattered writes of Viterbi().
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_VITERBI_FAST_H
+#define GNSS_SDR_VITERBI_FAST_H
+
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs telemetry_decoder_libs
+ * \{ */
+
+
+/*!
+ * \brief Vectorized hard-decision Viterbi decoder for rate 1/n
+ * nonsystematic feedforward convolutional codes.
+ *
+ * Drop-in replacement for the block decoding done by Viterbi() in
+ * convolutional.h. If the generator polynomials do not produce the expected
+ * butterfly trellis structure, decode() falls back to the scalar engine.
+ */
+class Viterbi_Fast
+{
+public:
+    /*!
+     * \brief Builds the trellis for the given generator polynomials.
+     * \param[in] g_encoder  n-element vector with the code generators in binary form
+     * \param[in] KK         Constraint length of the convolutional code
+     * \param[in] nn         Number of symbols per data bit (coding rate 1/nn)
+     */
+    Viterbi_Fast(const int g_encoder[], int KK, int nn);
+    ~Viterbi_Fast() = default;
+
+    /*!
+     * \brief Uses the Viterbi algorithm to perform hard-decision decoding of
+     * a convolutional code, with the same semantics as Viterbi().
+     *
+     * \param[in]  input_c  The received signal in LLR-form, nn*(LL+KK-1) values
+     * \param[in]  LL       The number of data bits to be decoded (without the zero-tail bits)
+     * \param[out] output_u_int  Hard decisions on the LL data bits
+     */
+    void decode(int output_u_int[], const float input_c[], int LL);
+
+private:
+    // add-compare-select over a span of states with contiguous predecessor metrics
+    static void acs_span(const float* pm_even, const float* pm_odd,
+        const float* bm0, const float* bm1,
+        float* pm_next, uint8_t* decisions, int len);
+
+    std::vector<float> d_pm;       // path metrics of the previous trellis section
+    std::vector<float> d_pm_next;  // path metrics of the current trellis section
+    std::vector<float> d_pm_even;  // metrics of the even predecessors, in butterfly order
+    std::vector<float> d_pm_odd;   // metrics of the odd predecessors, in butterfly order
+    std::vector<float> d_bm0;      // branch metric of the even-predecessor transition, per state
+    std::vector<float> d_bm1;      // branch metric of the odd-predecessor transition, per state
+    std::vector<float> d_metric_c;
+    std::vector<uint8_t> d_decisions;  // one surviving-predecessor bit per state and trellis section
+
+    // per-state symbol of the transition from each predecessor
+    std::vector<int> d_sym0;
+    std::vector<int> d_sym1;
+
+    // trellis definition, kept for the scalar fallback
+    std::vector<int> d_out0;
+    std::vector<int> d_state0;
+    std::vector<int> d_out1;
+    std::vector<int> d_state1;
+
+    int d_KK;
+    int d_nn;
+    int d_mm;
+    int d_states;
+    int d_number_symbols;
+    bool d_butterfly;  // the trellis matches the butterfly structure
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_VITERBI_FAST_H
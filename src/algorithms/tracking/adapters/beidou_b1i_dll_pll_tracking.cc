@@ -27,6 +27,7 @@
 #include "dll_pll_conf.h"
 #include "gnss_sdr_flags.h"
 #include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>  // for lv_16sc_t
 #include <array>
 
 
@@ -70,6 +71,11 @@ BeidouB1iDllPllTracking::BeidouB1iDllPllTracking(
             item_size_ = sizeof(gr_complex);
             tracking_ = dll_pll_veml_make_tracking(trk_params);
         }
+    else if (trk_params.item_type == "cshort")
+        {
+            item_size_ = sizeof(lv_16sc_t);
+            tracking_ = dll_pll_veml_make_tracking(trk_params);
+        }
     else
         {
             item_size_ = sizeof(gr_complex);
@@ -100,6 +106,18 @@ void BeidouB1iDllPllTracking::stop_tracking()
 }
 
 
+bool BeidouB1iDllPllTracking::set_runtime_parameter(const std::string& name, double value)
+{
+    return tracking_->set_runtime_parameter(name, value);
+}
+
+
+bool BeidouB1iDllPllTracking::get_runtime_parameter(const std::string& name, double* value)
+{
+    return tracking_->get_runtime_parameter(name, value);
+}
+
+
 /*
  * Set tracking channel unique ID
  */
@@ -87,6 +87,16 @@ public:
      */
     void stop_tracking() override;
 
+    /*!
+     * \brief Updates a published loop parameter while the loop is running
+     */
+    bool set_runtime_parameter(const std::string& name, double value) override;
+
+    /*!
+     * \brief Gets the current value of a published loop parameter
+     */
+    bool get_runtime_parameter(const std::string& name, double* value) override;
+
 private:
     dll_pll_veml_tracking_sptr tracking_;
     size_t item_size_;
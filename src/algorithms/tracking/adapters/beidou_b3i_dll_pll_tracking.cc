@@ -27,6 +27,7 @@
 #include "dll_pll_conf.h"
 #include "gnss_sdr_flags.h"
 #include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>  // for lv_16sc_t
 #include <array>
 
 using google::LogMessage;
@@ -62,6 +63,11 @@ BeidouB3iDllPllTracking::BeidouB3iDllPllTracking(
             item_size_ = sizeof(gr_complex);
             tracking_ = dll_pll_veml_make_tracking(trk_params);
         }
+    else if (trk_params.item_type == "cshort")
+        {
+            item_size_ = sizeof(lv_16sc_t);
+            tracking_ = dll_pll_veml_make_tracking(trk_params);
+        }
     else
         {
             item_size_ = sizeof(gr_complex);
@@ -92,6 +98,18 @@ void BeidouB3iDllPllTracking::stop_tracking()
 }
 
 
+bool BeidouB3iDllPllTracking::set_runtime_parameter(const std::string& name, double value)
+{
+    return tracking_->set_runtime_parameter(name, value);
+}
+
+
+bool BeidouB3iDllPllTracking::get_runtime_parameter(const std::string& name, double* value)
+{
+    return tracking_->get_runtime_parameter(name, value);
+}
+
+
 /*
  * Set tracking channel unique ID
  */
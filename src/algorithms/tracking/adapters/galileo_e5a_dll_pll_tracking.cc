@@ -27,6 +27,7 @@
 #include "dll_pll_conf.h"
 #include "gnss_sdr_flags.h"
 #include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>  // for lv_16sc_t
 #include <array>
 
 GalileoE5aDllPllTracking::GalileoE5aDllPllTracking(
@@ -63,6 +64,11 @@ GalileoE5aDllPllTracking::GalileoE5aDllPllTracking(
             item_size_ = sizeof(gr_complex);
             tracking_ = dll_pll_veml_make_tracking(trk_params);
         }
+    else if (trk_params.item_type == "cshort")
+        {
+            item_size_ = sizeof(lv_16sc_t);
+            tracking_ = dll_pll_veml_make_tracking(trk_params);
+        }
     else
         {
             item_size_ = sizeof(gr_complex);
@@ -87,6 +93,18 @@ void GalileoE5aDllPllTracking::stop_tracking()
 }
 
 
+bool GalileoE5aDllPllTracking::set_runtime_parameter(const std::string& name, double value)
+{
+    return tracking_->set_runtime_parameter(name, value);
+}
+
+
+bool GalileoE5aDllPllTracking::get_runtime_parameter(const std::string& name, double* value)
+{
+    return tracking_->get_runtime_parameter(name, value);
+}
+
+
 void GalileoE5aDllPllTracking::start_tracking()
 {
     tracking_->start_tracking();
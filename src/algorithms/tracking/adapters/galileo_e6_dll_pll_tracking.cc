@@ -23,6 +23,7 @@
 #include "dll_pll_conf.h"
 #include "gnss_sdr_flags.h"
 #include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>  // for lv_16sc_t
 #include <array>
 
 GalileoE6DllPllTracking::GalileoE6DllPllTracking(
@@ -59,6 +60,11 @@ GalileoE6DllPllTracking::GalileoE6DllPllTracking(
             item_size_ = sizeof(gr_complex);
             tracking_ = dll_pll_veml_make_tracking(trk_params);
         }
+    else if (trk_params.item_type == "cshort")
+        {
+            item_size_ = sizeof(lv_16sc_t);
+            tracking_ = dll_pll_veml_make_tracking(trk_params);
+        }
     else
         {
             item_size_ = sizeof(gr_complex);
@@ -83,6 +89,18 @@ void GalileoE6DllPllTracking::stop_tracking()
 }
 
 
+bool GalileoE6DllPllTracking::set_runtime_parameter(const std::string& name, double value)
+{
+    return tracking_->set_runtime_parameter(name, value);
+}
+
+
+bool GalileoE6DllPllTracking::get_runtime_parameter(const std::string& name, double* value)
+{
+    return tracking_->get_runtime_parameter(name, value);
+}
+
+
 void GalileoE6DllPllTracking::start_tracking()
 {
     tracking_->start_tracking();
@@ -33,16 +33,22 @@
 #include "MATH_CONSTANTS.h"
 #include "beidou_b1i_signal_replica.h"
 #include "beidou_b3i_signal_replica.h"
+#include "cross_ambiguity_screen.h"
+#include "dump_budget.h"
 #include "galileo_e1_signal_replica.h"
 #include "galileo_e5_signal_replica.h"
 #include "galileo_e6_signal_replica.h"
+#include "gnss_message_ids.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_synchro.h"
 #include "gps_l2c_signal_replica.h"
 #include "gps_l5_signal_replica.h"
 #include "gps_sdr_signal_replica.h"
+#include "prn_code_cache.h"
 #include "lock_detectors.h"
+#include "memory_registry.h"
+#include "multiband_nco_registry.h"
 #include "tracking_discriminators.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>   // for io_signature
@@ -52,6 +58,7 @@
 #include <volk_gnsssdr/volk_gnsssdr.h>
 #include <algorithm>  // for fill_n
 #include <array>
+#include <chrono>     // for the epoch ingestion timestamp
 #include <cmath>      // for fmod, round, floor
 #include <exception>  // for exception
 #include <iostream>   // for cout, cerr
@@ -84,7 +91,7 @@ dll_pll_veml_tracking_sptr dll_pll_veml_make_tracking(const Dll_Pll_Conf &conf_)
 }
 
 
-dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, sizeof(gr_complex)),
+dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, conf_.item_type == "cshort" ? sizeof(lv_16sc_t) : (conf_.item_type == "cbyte" ? sizeof(lv_8sc_t) : sizeof(gr_complex))),
                                                                               gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)))
 {
     // prevent telemetry symbols accumulation in output buffers
@@ -94,6 +101,15 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
     this->message_port_register_out(pmt::mp("events"));
     this->set_relative_rate(1.0 / static_cast<double>(d_trk_parameters.vector_length));
 
+    d_work_monitor.set_identity("dll_pll_trk", 0);
+    if (d_trk_parameters.enable_work_monitor)
+        {
+            d_work_monitor.configure("dll_pll_trk", 0,
+                d_trk_parameters.work_monitor_addresses,
+                d_trk_parameters.work_monitor_port,
+                d_trk_parameters.work_monitor_interval_calls);
+        }
+
     // Telemetry message port input
     this->message_port_register_in(pmt::mp("telemetry_to_trk"));
     this->set_msg_handler(
@@ -113,6 +129,10 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
     d_veml = false;
     d_cloop = true;
     d_pull_in_transitory = true;
+    d_coasting = false;
+    d_coasting_epochs_counter = 0;
+    d_max_coasting_epochs = 0;
+    d_multiband_nco_master = false;
     d_code_chip_rate = 0.0;
     d_secondary_code_length = 0U;
     d_data_secondary_code_length = 0U;
@@ -445,6 +465,11 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
             // Early, Prompt, Late
             d_n_correlator_taps = 3;
         }
+    // extra taps sampling the correlation function for the multipath
+    // estimator, appended after the tracking taps so the E/P/L mapping and
+    // the narrow-spacing transitions are unaffected
+    d_n_multipath_taps = d_trk_parameters.enable_multipath_estimator ? 6 : 0;
+    d_n_correlator_taps += d_n_multipath_taps;
 
     d_correlator_outs.reserve(d_n_correlator_taps);
     d_local_code_shift_chips.reserve(d_n_correlator_taps);
@@ -476,8 +501,47 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
             d_prompt_data_shift = &d_local_code_shift_chips[1];
         }
 
+    if (d_n_multipath_taps > 0)
+        {
+            // offsets chosen to sample the late slope of the correlation
+            // function, where close-in reflections distort it the most
+            static const std::array<float, 6> multipath_tap_offsets_chips = {-0.6F, -0.35F, 0.15F, 0.35F, 0.65F, 0.9F};
+            const int32_t base = d_n_correlator_taps - d_n_multipath_taps;
+            std::vector<float> estimator_offsets_chips;
+            estimator_offsets_chips.reserve(d_n_multipath_taps + 1);
+            estimator_offsets_chips.push_back(0.0F);  // prompt, for normalization
+            for (int32_t k = 0; k < d_n_multipath_taps; k++)
+                {
+                    d_local_code_shift_chips[base + k] = multipath_tap_offsets_chips[k] * static_cast<float>(d_code_samples_per_chip);
+                    estimator_offsets_chips.push_back(multipath_tap_offsets_chips[k]);
+                }
+            d_multipath_estimator.init(estimator_offsets_chips,
+                d_trk_parameters.spc,
+                d_trk_parameters.slope,
+                d_trk_parameters.y_intercept,
+                d_trk_parameters.multipath_budget_per_epoch,
+                d_trk_parameters.multipath_smoother_alpha);
+        }
+
+    if (d_trk_parameters.enable_scintillation_monitor)
+        {
+            d_scint_monitor.init(d_trk_parameters.scint_address,
+                d_trk_parameters.scint_port,
+                d_trk_parameters.scint_window_s);
+        }
+
+    d_multicorrelator_cpu.set_accelerator(d_trk_parameters.accelerator);
     d_multicorrelator_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), d_n_correlator_taps);
 
+    // cshort / cbyte input: samples arrive as integer complex and are converted
+    // to float just before the correlators, shrinking the input stream bandwidth
+    d_cshort = (d_trk_parameters.item_type == "cshort");
+    d_cbyte = (d_trk_parameters.item_type == "cbyte");
+    if (d_cshort || d_cbyte)
+        {
+            d_input_buffer = volk_gnsssdr::vector<gr_complex>(2 * d_trk_parameters.vector_length);
+        }
+
     if (d_trk_parameters.extend_correlation_symbols > 1)
         {
             d_enable_extended_integration = true;
@@ -487,31 +551,52 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
             d_enable_extended_integration = false;
             d_trk_parameters.extend_correlation_symbols = 1;
         }
+    d_current_extension_symbols = d_trk_parameters.extend_correlation_symbols;
 
     // Enable Data component prompt correlator (slave to Pilot prompt) if tracking uses Pilot signal
     if (d_trk_parameters.track_pilot)
         {
             // Extra correlator for the data component
+            d_correlator_data_cpu.set_accelerator(d_trk_parameters.accelerator);
             d_correlator_data_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), 1);
             d_correlator_data_cpu.set_high_dynamics_resampler(d_trk_parameters.high_dyn);
+            d_correlator_data_cpu.set_resampler_epsilon(d_trk_parameters.resampler_epsilon_chips);
             d_data_code.resize(2 * d_code_length_chips, 0.0);
         }
 
+    // complex code generation scratch, so start_tracking() does not allocate
+    if (d_signal_type == "5X" or d_signal_type == "7X")
+        {
+            d_aux_code = volk_gnsssdr::vector<gr_complex>(d_code_length_chips);
+        }
+
+    // report the dominant buffers to the memory accounting registry
+    Memory_Registry::report(this, "Tracking", "local code replicas",
+        sizeof(float) * (d_tracking_code.size() + d_data_code.size()) + sizeof(gr_complex) * d_aux_code.size());
+    Memory_Registry::report(this, "Tracking", "multicorrelator resampled codes",
+        sizeof(float) * 2 * d_trk_parameters.vector_length * (d_n_correlator_taps + (d_trk_parameters.track_pilot ? 1 : 0)));
+    if (d_cshort || d_cbyte)
+        {
+            Memory_Registry::report(this, "Tracking", "input conversion buffer",
+                sizeof(gr_complex) * d_input_buffer.size());
+        }
+
     // --- Initializations ---
     d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
     d_multicorrelator_cpu.set_high_dynamics_resampler(d_trk_parameters.high_dyn);
+    d_multicorrelator_cpu.set_resampler_epsilon(d_trk_parameters.resampler_epsilon_chips);
     // Initial code frequency basis of NCO
-    d_code_freq_chips = d_code_chip_rate;
+    d_hot.code_freq_chips = d_code_chip_rate;
     // Residual code phase (in chips)
-    d_rem_code_phase_samples = 0.0;
+    d_hot.rem_code_phase_samples = 0.0;
     // Residual carrier phase
-    d_rem_carr_phase_rad = 0.0;
+    d_hot.rem_carr_phase_rad = 0.0;
 
     // sample synchronization
     d_sample_counter = 0ULL;
     d_acq_sample_stamp = 0ULL;
 
-    d_current_prn_length_samples = static_cast<int32_t>(d_trk_parameters.vector_length);
+    d_hot.current_prn_length_samples = static_cast<int32_t>(d_trk_parameters.vector_length);
     d_current_correlation_time_s = 0.0;
 
     // CN0 estimation and lock detector buffers
@@ -541,15 +626,15 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
     d_channel = 0;
     d_acq_code_phase_samples = 0.0;
     d_acq_carrier_doppler_hz = 0.0;
-    d_carrier_doppler_hz = 0.0;
-    d_acc_carrier_phase_rad = 0.0;
+    d_hot.carrier_doppler_hz = 0.0;
+    d_hot.acc_carrier_phase_rad = 0.0;
 
     d_extend_correlation_symbols_count = 0;
-    d_code_phase_step_chips = 0.0;
-    d_code_phase_rate_step_chips = 0.0;
-    d_carrier_phase_step_rad = 0.0;
-    d_carrier_phase_rate_step_rad = 0.0;
-    d_rem_code_phase_chips = 0.0;
+    d_hot.code_phase_step_chips = 0.0;
+    d_hot.code_phase_rate_step_chips = 0.0;
+    d_hot.carrier_phase_step_rad = 0.0;
+    d_hot.carrier_phase_rate_step_rad = 0.0;
+    d_hot.rem_code_phase_chips = 0.0;
     d_state = 0;  // initial state: standby
     clear_tracking_vars();
     if (d_trk_parameters.smoother_length > 0)
@@ -565,6 +650,8 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
 
     d_dump = d_trk_parameters.dump;
     d_dump_mat = d_trk_parameters.dump_mat and d_dump;
+    d_dump_decimation = 1;
+    d_dump_record_counter = 0;
     if (d_dump)
         {
             d_dump_filename = d_trk_parameters.dump_filename;
@@ -643,9 +730,9 @@ void dll_pll_veml_tracking::start_tracking()
     d_acq_carrier_doppler_hz = d_acquisition_gnss_synchro->Acq_doppler_hz;
     d_acq_sample_stamp = d_acquisition_gnss_synchro->Acq_samplestamp_samples;
 
-    d_carrier_doppler_hz = d_acq_carrier_doppler_hz;
-    d_carrier_phase_step_rad = TWO_PI * d_carrier_doppler_hz / d_trk_parameters.fs_in;
-    d_carrier_phase_rate_step_rad = 0.0;
+    d_hot.carrier_doppler_hz = d_acq_carrier_doppler_hz;
+    d_hot.carrier_phase_step_rad = TWO_PI * d_hot.carrier_doppler_hz / d_trk_parameters.fs_in;
+    d_hot.carrier_phase_rate_step_rad = 0.0;
     d_carr_ph_history.clear();
     d_code_ph_history.clear();
     std::array<char, 3> Signal_{};
@@ -653,9 +740,20 @@ void dll_pll_veml_tracking::start_tracking()
     Signal_[1] = d_acquisition_gnss_synchro->Signal[1];
     Signal_[2] = d_acquisition_gnss_synchro->Signal[2];
 
+    if (d_trk_parameters.enable_scintillation_monitor)
+        {
+            d_scint_monitor.start(d_channel, d_trk_parameters.system, Signal_.data(), d_acquisition_gnss_synchro->PRN);
+        }
+
     if (d_systemName == "GPS" and d_signal_type == "1C")
         {
-            gps_l1_ca_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN, 0);
+            // chip-spaced replicas are shared process-wide; the working copy
+            // stays local because the multicorrelator resamples in place
+            const uint32_t prn = d_acquisition_gnss_synchro->PRN;
+            const auto shared_code = Prn_Code_Cache::get_instance().get_or_build_float("G1C_chips", prn, 0, 0,
+                static_cast<uint32_t>(d_tracking_code.size()),
+                [prn](own::span<float> dest) { gps_l1_ca_code_gen_float(dest, prn, 0); });
+            std::copy(shared_code->begin(), shared_code->end(), d_tracking_code.begin());
         }
     else if (d_systemName == "GPS" and d_signal_type == "2S")
         {
@@ -677,31 +775,39 @@ void dll_pll_veml_tracking::start_tracking()
         }
     else if (d_systemName == "Galileo" and d_signal_type == "1B")
         {
+            const uint32_t prn = d_acquisition_gnss_synchro->PRN;
+            const auto sinboc_code = [prn](const std::array<char, 3>& signal_id) {
+                return Prn_Code_Cache::get_instance().get_or_build_float(std::string("E") + signal_id.data() + "_sinboc", prn, 0, 0,
+                    static_cast<uint32_t>(2 * GALILEO_E1_B_CODE_LENGTH_CHIPS),
+                    [prn, signal_id](own::span<float> dest) { galileo_e1_code_gen_sinboc11_float(dest, signal_id, prn); });
+            };
             if (d_trk_parameters.track_pilot)
                 {
                     const std::array<char, 3> pilot_signal = {{'1', 'C', '\0'}};
-                    galileo_e1_code_gen_sinboc11_float(d_tracking_code, pilot_signal, d_acquisition_gnss_synchro->PRN);
-                    galileo_e1_code_gen_sinboc11_float(d_data_code, Signal_, d_acquisition_gnss_synchro->PRN);
+                    const auto pilot_code = sinboc_code(pilot_signal);
+                    std::copy(pilot_code->begin(), pilot_code->end(), d_tracking_code.begin());
+                    const auto data_code = sinboc_code(Signal_);
+                    std::copy(data_code->begin(), data_code->end(), d_data_code.begin());
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
                     d_correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
                 }
             else
                 {
-                    galileo_e1_code_gen_sinboc11_float(d_tracking_code, Signal_, d_acquisition_gnss_synchro->PRN);
+                    const auto data_code = sinboc_code(Signal_);
+                    std::copy(data_code->begin(), data_code->end(), d_tracking_code.begin());
                 }
         }
     else if (d_systemName == "Galileo" and d_signal_type == "5X")
         {
-            volk_gnsssdr::vector<gr_complex> aux_code(d_code_length_chips);
             const std::array<char, 3> signal_type_ = {{'5', 'X', '\0'}};
-            galileo_e5_a_code_gen_complex_primary(aux_code, d_acquisition_gnss_synchro->PRN, signal_type_);
+            galileo_e5_a_code_gen_complex_primary(d_aux_code, d_acquisition_gnss_synchro->PRN, signal_type_);
             if (d_trk_parameters.track_pilot)
                 {
                     d_secondary_code_string = GALILEO_E5A_Q_SECONDARY_CODE[d_acquisition_gnss_synchro->PRN - 1];
                     for (int32_t i = 0; i < d_code_length_chips; i++)
                         {
-                            d_tracking_code[i] = aux_code[i].imag();
-                            d_data_code[i] = aux_code[i].real();  // the same because it is generated the full signal (E5aI + E5aQ)
+                            d_tracking_code[i] = d_aux_code[i].imag();
+                            d_data_code[i] = d_aux_code[i].real();  // the same because it is generated the full signal (E5aI + E5aQ)
                         }
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
                     d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
@@ -710,22 +816,21 @@ void dll_pll_veml_tracking::start_tracking()
                 {
                     for (int32_t i = 0; i < d_code_length_chips; i++)
                         {
-                            d_tracking_code[i] = aux_code[i].real();
+                            d_tracking_code[i] = d_aux_code[i].real();
                         }
                 }
         }
     else if (d_systemName == "Galileo" and d_signal_type == "7X")
         {
-            volk_gnsssdr::vector<gr_complex> aux_code(d_code_length_chips);
             const std::array<char, 3> signal_type_ = {{'7', 'X', '\0'}};
-            galileo_e5_b_code_gen_complex_primary(aux_code, d_acquisition_gnss_synchro->PRN, signal_type_);
+            galileo_e5_b_code_gen_complex_primary(d_aux_code, d_acquisition_gnss_synchro->PRN, signal_type_);
             if (d_trk_parameters.track_pilot)
                 {
                     d_secondary_code_string = GALILEO_E5B_Q_SECONDARY_CODE[d_acquisition_gnss_synchro->PRN - 1];
                     for (int32_t i = 0; i < d_code_length_chips; i++)
                         {
-                            d_tracking_code[i] = aux_code[i].imag();
-                            d_data_code[i] = aux_code[i].real();  // the same because it is generated the full signal (E5bI + E5bsQ)
+                            d_tracking_code[i] = d_aux_code[i].imag();
+                            d_data_code[i] = d_aux_code[i].real();  // the same because it is generated the full signal (E5bI + E5bsQ)
                         }
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
                     d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
@@ -734,7 +839,7 @@ void dll_pll_veml_tracking::start_tracking()
                 {
                     for (int32_t i = 0; i < d_code_length_chips; i++)
                         {
-                            d_tracking_code[i] = aux_code[i].real();
+                            d_tracking_code[i] = d_aux_code[i].real();
                         }
                 }
         }
@@ -821,13 +926,17 @@ void dll_pll_veml_tracking::start_tracking()
 
     d_multicorrelator_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code.data(), d_local_code_shift_chips.data());
     std::fill_n(d_correlator_outs.begin(), d_n_correlator_taps, gr_complex(0.0, 0.0));
+    if (d_n_multipath_taps > 0)
+        {
+            d_multipath_estimator.reset();
+        }
 
     d_carrier_lock_fail_counter = 0;
     d_code_lock_fail_counter = 0;
-    d_rem_code_phase_samples = 0.0;
-    d_rem_carr_phase_rad = 0.0;
-    d_rem_code_phase_chips = 0.0;
-    d_acc_carrier_phase_rad = 0.0;
+    d_hot.rem_code_phase_samples = 0.0;
+    d_hot.rem_carr_phase_rad = 0.0;
+    d_hot.rem_code_phase_chips = 0.0;
+    d_hot.acc_carrier_phase_rad = 0.0;
     d_cn0_estimation_counter = 0;
     d_carrier_lock_test = 1.0;
     d_CN0_SNV_dB_Hz = 0.0;
@@ -851,6 +960,28 @@ void dll_pll_veml_tracking::start_tracking()
     d_carrier_loop_filter.set_params(d_trk_parameters.fll_bw_hz, d_trk_parameters.pll_bw_hz, d_trk_parameters.pll_filter_order);
     d_code_loop_filter.set_noise_bandwidth(d_trk_parameters.dll_bw_hz);
     d_code_loop_filter.set_update_interval(static_cast<float>(d_code_period));
+    // Shared multiband NCO: claim the master role for this satellite or, as a
+    // secondary band, seed the carrier loop from the accumulator the master
+    // band is already tracking (scaled to this carrier), which is more
+    // accurate than the local acquisition estimate
+    if (d_trk_parameters.share_multiband_nco)
+        {
+            if (d_multiband_nco_master and !d_multiband_sat_key.empty())
+                {
+                    Multiband_Nco_Registry::get_instance().release(d_multiband_sat_key, d_channel);
+                }
+            d_multiband_sat_key = d_systemName + ' ' + std::to_string(d_acquisition_gnss_synchro->PRN);
+            d_multiband_nco_master = Multiband_Nco_Registry::get_instance().try_acquire(d_multiband_sat_key, d_channel);
+            double range_rate_hz_per_hz = 0.0;
+            if (!d_multiband_nco_master and Multiband_Nco_Registry::get_instance().lookup(d_multiband_sat_key, range_rate_hz_per_hz))
+                {
+                    d_acq_carrier_doppler_hz = range_rate_hz_per_hz * d_signal_carrier_freq;
+                    d_hot.carrier_doppler_hz = d_acq_carrier_doppler_hz;
+                    d_hot.carrier_phase_step_rad = TWO_PI * d_hot.carrier_doppler_hz / d_trk_parameters.fs_in;
+                    DLOG(INFO) << "Channel " << d_channel << " carrier loop seeded from the multiband NCO of " << d_multiband_sat_key;
+                }
+        }
+
     // DLL/PLL filter initialization
     d_carrier_loop_filter.initialize(static_cast<float>(d_acq_carrier_doppler_hz));  // initialize the carrier filter
     d_code_loop_filter.initialize();                                                 // initialize the code filter
@@ -863,6 +994,8 @@ void dll_pll_veml_tracking::start_tracking()
     d_state = 1;
     d_cloop = true;
     d_pull_in_transitory = true;
+    d_coasting = false;
+    d_coasting_epochs_counter = 0;
     d_Prompt_circular_buffer.clear();
     d_corrected_doppler = false;
     d_acc_carrier_phase_initialized = false;
@@ -871,6 +1004,12 @@ void dll_pll_veml_tracking::start_tracking()
 
 dll_pll_veml_tracking::~dll_pll_veml_tracking()
 {
+    Memory_Registry::release(this);
+    Dump_Budget::release(this);
+    if (d_multiband_nco_master and !d_multiband_sat_key.empty())
+        {
+            Multiband_Nco_Registry::get_instance().release(d_multiband_sat_key, d_channel);
+        }
     if (d_dump_file.is_open())
         {
             try
@@ -882,8 +1021,9 @@ dll_pll_veml_tracking::~dll_pll_veml_tracking()
                     LOG(WARNING) << "Exception in Tracking block destructor: " << ex.what();
                 }
         }
-    if (d_dump_mat)
+    if (d_dump_mat and !d_trk_parameters.dump_columnar)
         {
+            // the columnar dump is converted offline with columnar_dump_to_mat
             try
                 {
                     save_matfile();
@@ -947,24 +1087,76 @@ bool dll_pll_veml_tracking::acquire_secondary()
 }
 
 
+int32_t dll_pll_veml_tracking::acquire_secondary_all_phases()
+{
+    // Evaluates every cyclic phase hypothesis of the secondary code over one
+    // buffered period of prompt outputs in a single batch, instead of testing
+    // a single alignment per incoming symbol. Lock is declared as soon as the
+    // first full period is buffered, so the channel reaches full coherent
+    // integration within two secondary-code periods of entering pull-in.
+    // Returns the secondary code index of the next incoming symbol, or -1
+    const auto length = static_cast<int32_t>(d_secondary_code_length);
+    std::vector<int32_t> symbol_signs(length);
+    std::vector<int32_t> code_signs(length);
+    for (int32_t i = 0; i < length; i++)
+        {
+            symbol_signs[i] = (d_Prompt_circular_buffer[i].real() < 0.0) ? -1 : 1;  // symbols clipping
+            code_signs[i] = (d_secondary_code_string[i] == '0') ? -1 : 1;
+        }
+    int32_t best_phase = -1;
+    for (int32_t phase = 0; phase < length; phase++)
+        {
+            int32_t corr_value = 0;
+            for (int32_t i = 0; i < length; i++)
+                {
+                    corr_value += symbol_signs[i] * code_signs[(i + phase) % length];
+                }
+            if (abs(corr_value) == length)
+                {
+                    if (best_phase >= 0)
+                        {
+                            return -1;  // ambiguous match, should not happen with real secondary codes
+                        }
+                    best_phase = phase;
+                }
+        }
+    return best_phase;
+}
+
+
 bool dll_pll_veml_tracking::cn0_and_tracking_lock_status(double coh_integration_time_s)
 {
     // ####### CN0 ESTIMATION AND LOCK DETECTORS ######
     if (d_cn0_estimation_counter < d_trk_parameters.cn0_samples)
         {
             // fill buffer with prompt correlator output values
-            d_Prompt_buffer[d_cn0_estimation_counter] = d_P_accu;
+            d_Prompt_buffer[d_cn0_estimation_counter] = d_hot.P_accu;
             d_cn0_estimation_counter++;
             return true;
         }
 
-    d_Prompt_buffer[d_cn0_estimation_counter % d_trk_parameters.cn0_samples] = d_P_accu;
+    d_Prompt_buffer[d_cn0_estimation_counter % d_trk_parameters.cn0_samples] = d_hot.P_accu;
     d_cn0_estimation_counter++;
+    if (d_trk_parameters.cn0_decimation > 1 and (d_cn0_estimation_counter % d_trk_parameters.cn0_decimation) != 0)
+        {
+            // the detectors keep their last values on decimated epochs
+            if (d_coasting)
+                {
+                    d_coasting_epochs_counter++;
+                }
+            return true;
+        }
     // Code lock indicator
     const float d_CN0_SNV_dB_Hz_raw = cn0_m2m4_estimator(d_Prompt_buffer.data(), d_trk_parameters.cn0_samples, static_cast<float>(coh_integration_time_s));
     d_CN0_SNV_dB_Hz = d_cn0_smoother.smooth(d_CN0_SNV_dB_Hz_raw);
     // Carrier lock indicator
     d_carrier_lock_test = d_carrier_lock_test_smoother.smooth(carrier_lock_detector(d_Prompt_buffer.data(), 1));
+    if (!d_pull_in_transitory and !d_coasting)
+        {
+            // keep the acquisition cross-correlation screen aware of this channel
+            Cross_Ambiguity_Screen::get_instance().report_tracked(d_acquisition_gnss_synchro->System, d_signal_type,
+                d_acquisition_gnss_synchro->PRN, d_hot.carrier_doppler_hz, d_CN0_SNV_dB_Hz);
+        }
     // Loss of lock detection
     if (!d_pull_in_transitory)
         {
@@ -992,13 +1184,51 @@ bool dll_pll_veml_tracking::cn0_and_tracking_lock_status(double coh_integration_
                         }
                 }
         }
+    if (d_coasting)
+        {
+            d_coasting_epochs_counter++;
+            if (d_CN0_SNV_dB_Hz > d_trk_parameters.cn0_min and d_carrier_lock_test > d_carrier_lock_threshold)
+                {
+                    // The signal came back: close the loops again around the coasted NCO commands
+                    d_carrier_loop_filter.initialize(static_cast<float>(d_hot.carrier_doppler_hz));
+                    d_code_loop_filter.initialize();
+                    d_carrier_lock_fail_counter = 0;
+                    d_code_lock_fail_counter = 0;
+                    d_coasting = false;
+                    LOG(INFO) << "Channel " << d_channel << " re-locked after coasting "
+                              << d_coasting_epochs_counter << " epochs on sat " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN);
+                }
+            else if (d_coasting_epochs_counter > d_max_coasting_epochs)
+                {
+                    d_coasting = false;
+                    std::cout << "Loss of lock in channel " << d_channel << "!\n";
+                    LOG(INFO) << "Loss of lock in channel " << d_channel << " after coasting "
+                              << d_coasting_epochs_counter << " epochs";
+                    this->message_port_pub(msg_ids::events_port(), msg_ids::telemetry_failure());  // 3 -> loss of lock
+                    d_carrier_lock_fail_counter = 0;
+                    d_code_lock_fail_counter = 0;
+                    return false;
+                }
+            return true;
+        }
     if (d_carrier_lock_fail_counter > d_trk_parameters.max_carrier_lock_fail or d_code_lock_fail_counter > d_trk_parameters.max_code_lock_fail)
         {
+            if (d_trk_parameters.enable_coasting and !d_pull_in_transitory)
+                {
+                    // Keep the NCOs running open-loop on the last closed-loop commands
+                    // instead of dropping the channel to re-acquisition
+                    d_coasting = true;
+                    d_coasting_epochs_counter = 0;
+                    d_max_coasting_epochs = static_cast<int32_t>(static_cast<double>(d_trk_parameters.coasting_time_s) / coh_integration_time_s);
+                    LOG(INFO) << "Channel " << d_channel << " coasting on sat " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN)
+                              << " (holding " << d_hot.carrier_doppler_hz << " Hz for up to " << d_trk_parameters.coasting_time_s << " s)";
+                    return true;
+                }
             std::cout << "Loss of lock in channel " << d_channel << "!\n";
             LOG(INFO) << "Loss of lock in channel " << d_channel
                       << " (carrier_lock_fail_counter:" << d_carrier_lock_fail_counter
                       << " code_lock_fail_counter : " << d_code_lock_fail_counter << ")";
-            this->message_port_pub(pmt::mp("events"), pmt::from_long(3));  // 3 -> loss of lock
+            this->message_port_pub(msg_ids::events_port(), msg_ids::telemetry_failure());  // 3 -> loss of lock
             d_carrier_lock_fail_counter = 0;
             d_code_lock_fail_counter = 0;
             return false;
@@ -1009,20 +1239,20 @@ bool dll_pll_veml_tracking::cn0_and_tracking_lock_status(double coh_integration_
 
 // correlation requires:
 // - updated remnant carrier phase in radians (rem_carr_phase_rad)
-// - updated remnant code phase in samples (d_rem_code_phase_samples)
-// - d_code_freq_chips
-// - d_carrier_doppler_hz
+// - updated remnant code phase in samples (d_hot.rem_code_phase_samples)
+// - d_hot.code_freq_chips
+// - d_hot.carrier_doppler_hz
 void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
 {
     // ################# CARRIER WIPEOFF AND CORRELATORS ##############################
     // perform carrier wipe-off and compute Early, Prompt and Late correlation
     d_multicorrelator_cpu.set_input_output_vectors(d_correlator_outs.data(), input_samples);
     d_multicorrelator_cpu.Carrier_wipeoff_multicorrelator_resampler(
-        d_rem_carr_phase_rad,
-        static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
-        static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
-        static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
-        static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
+        d_hot.rem_carr_phase_rad,
+        static_cast<float>(d_hot.carrier_phase_step_rad), static_cast<float>(d_hot.carrier_phase_rate_step_rad),
+        static_cast<float>(d_hot.rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
+        static_cast<float>(d_hot.code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
+        static_cast<float>(d_hot.code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
         d_trk_parameters.vector_length);
 
     // DATA CORRELATOR (if tracking tracks the pilot signal)
@@ -1030,11 +1260,11 @@ void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
         {
             d_correlator_data_cpu.set_input_output_vectors(d_Prompt_Data.data(), input_samples);
             d_correlator_data_cpu.Carrier_wipeoff_multicorrelator_resampler(
-                d_rem_carr_phase_rad,
-                static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
-                static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
-                static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
-                static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                d_hot.rem_carr_phase_rad,
+                static_cast<float>(d_hot.carrier_phase_step_rad), static_cast<float>(d_hot.carrier_phase_rate_step_rad),
+                static_cast<float>(d_hot.rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<float>(d_hot.code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<float>(d_hot.code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
                 d_trk_parameters.vector_length);
         }
 }
@@ -1042,26 +1272,45 @@ void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
 
 void dll_pll_veml_tracking::run_dll_pll()
 {
+    if (d_coasting)
+        {
+            // Open-loop NCO propagation: hold the last closed-loop carrier Doppler
+            // and derive the code rate from it through carrier aiding, so a faded
+            // channel keeps its code and carrier phase aligned with the dynamics
+            // instead of being driven by noise-only discriminators
+            if (d_trk_parameters.share_multiband_nco and !d_multiband_nco_master)
+                {
+                    // while this band fades, follow the live accumulator of the
+                    // master band instead of the last local closed-loop value
+                    double range_rate_hz_per_hz = 0.0;
+                    if (Multiband_Nco_Registry::get_instance().lookup(d_multiband_sat_key, range_rate_hz_per_hz))
+                        {
+                            d_hot.carrier_doppler_hz = range_rate_hz_per_hz * d_signal_carrier_freq;
+                        }
+                }
+            d_hot.code_freq_chips = d_code_chip_rate + d_hot.carrier_doppler_hz * d_code_chip_rate / d_signal_carrier_freq;
+            return;
+        }
     // ################## PLL ##########################################################
     // PLL discriminator
     if (d_cloop)
         {
             // Costas loop discriminator, insensitive to 180 deg phase transitions
-            d_carr_phase_error_hz = pll_cloop_two_quadrant_atan(d_P_accu) / TWO_PI;
+            d_carr_phase_error_hz = pll_cloop_two_quadrant_atan(d_hot.P_accu) / TWO_PI;
         }
     else
         {
             // Secondary code acquired. No symbols transition should be present in the signal
-            d_carr_phase_error_hz = pll_four_quadrant_atan(d_P_accu) / TWO_PI;
+            d_carr_phase_error_hz = pll_four_quadrant_atan(d_hot.P_accu) / TWO_PI;
         }
 
     if ((d_pull_in_transitory == true and d_trk_parameters.enable_fll_pull_in == true) or d_trk_parameters.enable_fll_steady_state)
         {
             // FLL discriminator
-            // d_carr_freq_error_hz = fll_four_quadrant_atan(d_P_accu_old, d_P_accu, 0, d_current_correlation_time_s) / TWO_PI;
-            d_carr_freq_error_hz = fll_diff_atan(d_P_accu_old, d_P_accu, 0, d_current_correlation_time_s) / TWO_PI;
+            // d_carr_freq_error_hz = fll_four_quadrant_atan(d_hot.P_accu_old, d_hot.P_accu, 0, d_current_correlation_time_s) / TWO_PI;
+            d_carr_freq_error_hz = fll_diff_atan(d_hot.P_accu_old, d_hot.P_accu, 0, d_current_correlation_time_s) / TWO_PI;
 
-            d_P_accu_old = d_P_accu;
+            d_hot.P_accu_old = d_hot.P_accu;
             // std::cout << "d_carr_freq_error_hz: " << d_carr_freq_error_hz << '\n';
             // Carrier discriminator filter
             if ((d_pull_in_transitory == true and d_trk_parameters.enable_fll_pull_in == true))
@@ -1082,28 +1331,49 @@ void dll_pll_veml_tracking::run_dll_pll()
         }
 
     // New carrier Doppler frequency estimation
-    d_carrier_doppler_hz = d_carr_error_filt_hz;
+    d_hot.carrier_doppler_hz = d_carr_error_filt_hz;
+
+    if (d_trk_parameters.share_multiband_nco and d_multiband_nco_master)
+        {
+            // publish the accumulator normalized by the carrier frequency, so
+            // the channels of the other bands scale it by their own
+            Multiband_Nco_Registry::get_instance().publish(d_multiband_sat_key, d_channel, d_hot.carrier_doppler_hz / d_signal_carrier_freq);
+        }
 
-    //    std::cout << "d_carrier_doppler_hz: " << d_carrier_doppler_hz << '\n';
+    //    std::cout << "d_hot.carrier_doppler_hz: " << d_hot.carrier_doppler_hz << '\n';
     //    std::cout << "d_CN0_SNV_dB_Hz: " << this->d_CN0_SNV_dB_Hz << '\n';
 
     // ################## DLL ##########################################################
     // DLL discriminator
     if (d_veml)
         {
-            d_code_error_chips = dll_nc_vemlp_normalized(d_VE_accu, d_E_accu, d_L_accu, d_VL_accu);  // [chips/Ti]
+            d_code_error_chips = dll_nc_vemlp_normalized(d_hot.VE_accu, d_hot.E_accu, d_hot.L_accu, d_hot.VL_accu);  // [chips/Ti]
         }
     else
         {
-            d_code_error_chips = dll_nc_e_minus_l_normalized(d_E_accu, d_L_accu, d_trk_parameters.spc, d_trk_parameters.slope, d_trk_parameters.y_intercept);  // [chips/Ti]
+            d_code_error_chips = dll_nc_e_minus_l_normalized(d_hot.E_accu, d_hot.L_accu, d_trk_parameters.spc, d_trk_parameters.slope, d_trk_parameters.y_intercept);  // [chips/Ti]
+        }
+    if (d_n_multipath_taps > 0)
+        {
+            // feed the per-epoch correlation function snapshot to the
+            // multipath estimator and remove the estimated reflection-induced
+            // bias from the code discriminator
+            std::array<float, 7> multipath_mags{};
+            multipath_mags[0] = std::abs(*d_Prompt);
+            const int32_t base = d_n_correlator_taps - d_n_multipath_taps;
+            for (int32_t k = 0; k < d_n_multipath_taps; k++)
+                {
+                    multipath_mags[k + 1] = std::abs(d_correlator_outs[base + k]);
+                }
+            d_code_error_chips -= d_multipath_estimator.update(multipath_mags.data(), d_n_multipath_taps + 1);
         }
     // Code discriminator filter
     d_code_error_filt_chips = d_code_loop_filter.apply(static_cast<float>(d_code_error_chips));  // [chips/second]
     // New code Doppler frequency estimation
-    d_code_freq_chips = d_code_chip_rate - d_code_error_filt_chips;
+    d_hot.code_freq_chips = d_code_chip_rate - d_code_error_filt_chips;
     if (d_trk_parameters.carrier_aiding)
         {
-            d_code_freq_chips += d_carrier_doppler_hz * d_code_chip_rate / d_signal_carrier_freq;
+            d_hot.code_freq_chips += d_hot.carrier_doppler_hz * d_code_chip_rate / d_signal_carrier_freq;
         }
 
     // Experimental: detect Carrier Doppler vs. Code Doppler incoherence and correct the Carrier Doppler
@@ -1120,13 +1390,21 @@ void dll_pll_veml_tracking::run_dll_pll()
                                 {
                                     const float carrier_doppler_error_hz = static_cast<float>(d_signal_carrier_freq) * avg_code_error_chips_s / static_cast<float>(d_code_chip_rate);
                                     LOG(INFO) << "Detected and corrected carrier doppler error: " << carrier_doppler_error_hz << " [Hz] on sat " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN);
-                                    d_carrier_loop_filter.initialize(static_cast<float>(d_carrier_doppler_hz) - carrier_doppler_error_hz);
+                                    d_carrier_loop_filter.initialize(static_cast<float>(d_hot.carrier_doppler_hz) - carrier_doppler_error_hz);
                                     d_corrected_doppler = true;
                                 }
                             d_dll_filt_history.clear();
                         }
                 }
         }
+
+    if (d_trk_parameters.enable_scintillation_monitor)
+        {
+            d_scint_monitor.push(std::abs(d_hot.P_accu),
+                d_hot.acc_carrier_phase_rad,
+                d_CN0_SNV_dB_Hz,
+                d_current_correlation_time_s);
+        }
 }
 
 
@@ -1134,7 +1412,7 @@ void dll_pll_veml_tracking::check_carrier_phase_coherent_initialization()
 {
     if (d_acc_carrier_phase_initialized == false)
         {
-            d_acc_carrier_phase_rad = -d_rem_carr_phase_rad;
+            d_hot.acc_carrier_phase_rad = -d_hot.rem_carr_phase_rad;
             d_acc_carrier_phase_initialized = true;
         }
 }
@@ -1146,9 +1424,9 @@ void dll_pll_veml_tracking::clear_tracking_vars()
     if (d_trk_parameters.track_pilot)
         {
             d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-            d_P_data_accu = gr_complex(0.0, 0.0);
+            d_hot.P_data_accu = gr_complex(0.0, 0.0);
         }
-    d_P_accu_old = gr_complex(0.0, 0.0);
+    d_hot.P_accu_old = gr_complex(0.0, 0.0);
     d_carr_phase_error_hz = 0.0;
     d_carr_freq_error_hz = 0.0;
     d_carr_error_filt_hz = 0.0;
@@ -1157,8 +1435,8 @@ void dll_pll_veml_tracking::clear_tracking_vars()
     d_current_symbol = 0;
     d_current_data_symbol = 0;
     d_Prompt_circular_buffer.clear();
-    d_carrier_phase_rate_step_rad = 0.0;
-    d_code_phase_rate_step_chips = 0.0;
+    d_hot.carrier_phase_rate_step_rad = 0.0;
+    d_hot.code_phase_rate_step_chips = 0.0;
     d_carr_ph_history.clear();
     d_code_ph_history.clear();
 }
@@ -1166,23 +1444,23 @@ void dll_pll_veml_tracking::clear_tracking_vars()
 
 void dll_pll_veml_tracking::update_tracking_vars()
 {
-    d_T_chip_seconds = 1.0 / d_code_freq_chips;
+    d_T_chip_seconds = 1.0 / d_hot.code_freq_chips;
     d_T_prn_seconds = d_T_chip_seconds * static_cast<double>(d_code_length_chips);
 
     // ################## CARRIER AND CODE NCO BUFFER ALIGNMENT #######################
     // keep alignment parameters for the next input buffer
     // Compute the next buffer length based in the new period of the PRN sequence and the code phase error estimation
     d_T_prn_samples = d_T_prn_seconds * d_trk_parameters.fs_in;
-    d_K_blk_samples = d_T_prn_samples + d_rem_code_phase_samples;
-    d_current_prn_length_samples = static_cast<int32_t>(std::floor(d_K_blk_samples));  // round to a discrete number of samples
+    d_K_blk_samples = d_T_prn_samples + d_hot.rem_code_phase_samples;
+    d_hot.current_prn_length_samples = static_cast<int32_t>(std::floor(d_K_blk_samples));  // round to a discrete number of samples
 
     // ################### PLL COMMANDS #################################################
     // carrier phase step (NCO phase increment per sample) [rads/sample]
-    d_carrier_phase_step_rad = TWO_PI * d_carrier_doppler_hz / d_trk_parameters.fs_in;
+    d_hot.carrier_phase_step_rad = TWO_PI * d_hot.carrier_doppler_hz / d_trk_parameters.fs_in;
     // carrier phase rate step (NCO phase increment rate per sample) [rads/sample^2]
     if (d_trk_parameters.high_dyn)
         {
-            d_carr_ph_history.push_back(std::pair<double, double>(d_carrier_phase_step_rad, static_cast<double>(d_current_prn_length_samples)));
+            d_carr_ph_history.push_back(std::pair<double, double>(d_hot.carrier_phase_step_rad, static_cast<double>(d_hot.current_prn_length_samples)));
             if (d_carr_ph_history.full())
                 {
                     double tmp_cp1 = 0.0;
@@ -1196,26 +1474,26 @@ void dll_pll_veml_tracking::update_tracking_vars()
                         }
                     tmp_cp1 /= static_cast<double>(d_trk_parameters.smoother_length);
                     tmp_cp2 /= static_cast<double>(d_trk_parameters.smoother_length);
-                    d_carrier_phase_rate_step_rad = (tmp_cp2 - tmp_cp1) / tmp_samples;
+                    d_hot.carrier_phase_rate_step_rad = (tmp_cp2 - tmp_cp1) / tmp_samples;
                 }
         }
-    // std::cout << d_carrier_phase_rate_step_rad * d_trk_parameters.fs_in * d_trk_parameters.fs_in / TWO_PI << '\n';
+    // std::cout << d_hot.carrier_phase_rate_step_rad * d_trk_parameters.fs_in * d_trk_parameters.fs_in / TWO_PI << '\n';
     // remnant carrier phase to prevent overflow in the code NCO
-    d_rem_carr_phase_rad += static_cast<float>(d_carrier_phase_step_rad * static_cast<double>(d_current_prn_length_samples) + 0.5 * d_carrier_phase_rate_step_rad * static_cast<double>(d_current_prn_length_samples) * static_cast<double>(d_current_prn_length_samples));
-    d_rem_carr_phase_rad = fmod(d_rem_carr_phase_rad, TWO_PI);
+    d_hot.rem_carr_phase_rad += static_cast<float>(d_hot.carrier_phase_step_rad * static_cast<double>(d_hot.current_prn_length_samples) + 0.5 * d_hot.carrier_phase_rate_step_rad * static_cast<double>(d_hot.current_prn_length_samples) * static_cast<double>(d_hot.current_prn_length_samples));
+    d_hot.rem_carr_phase_rad = fmod(d_hot.rem_carr_phase_rad, TWO_PI);
 
     // carrier phase accumulator
-    // double a = d_carrier_phase_step_rad * static_cast<double>(d_current_prn_length_samples);
-    // double b = 0.5 * d_carrier_phase_rate_step_rad * static_cast<double>(d_current_prn_length_samples) * static_cast<double>(d_current_prn_length_samples);
+    // double a = d_hot.carrier_phase_step_rad * static_cast<double>(d_hot.current_prn_length_samples);
+    // double b = 0.5 * d_hot.carrier_phase_rate_step_rad * static_cast<double>(d_hot.current_prn_length_samples) * static_cast<double>(d_hot.current_prn_length_samples);
     // std::cout << fmod(b, TWO_PI) / fmod(a, TWO_PI) << '\n';
-    d_acc_carrier_phase_rad -= (d_carrier_phase_step_rad * static_cast<double>(d_current_prn_length_samples) + 0.5 * d_carrier_phase_rate_step_rad * static_cast<double>(d_current_prn_length_samples) * static_cast<double>(d_current_prn_length_samples));
+    d_hot.acc_carrier_phase_rad -= (d_hot.carrier_phase_step_rad * static_cast<double>(d_hot.current_prn_length_samples) + 0.5 * d_hot.carrier_phase_rate_step_rad * static_cast<double>(d_hot.current_prn_length_samples) * static_cast<double>(d_hot.current_prn_length_samples));
 
     // ################### DLL COMMANDS #################################################
     // code phase step (Code resampler phase increment per sample) [chips/sample]
-    d_code_phase_step_chips = d_code_freq_chips / d_trk_parameters.fs_in;
+    d_hot.code_phase_step_chips = d_hot.code_freq_chips / d_trk_parameters.fs_in;
     if (d_trk_parameters.high_dyn)
         {
-            d_code_ph_history.push_back(std::pair<double, double>(d_code_phase_step_chips, static_cast<double>(d_current_prn_length_samples)));
+            d_code_ph_history.push_back(std::pair<double, double>(d_hot.code_phase_step_chips, static_cast<double>(d_hot.current_prn_length_samples)));
             if (d_code_ph_history.full())
                 {
                     double tmp_cp1 = 0.0;
@@ -1229,12 +1507,12 @@ void dll_pll_veml_tracking::update_tracking_vars()
                         }
                     tmp_cp1 /= static_cast<double>(d_trk_parameters.smoother_length);
                     tmp_cp2 /= static_cast<double>(d_trk_parameters.smoother_length);
-                    d_code_phase_rate_step_chips = (tmp_cp2 - tmp_cp1) / tmp_samples;
+                    d_hot.code_phase_rate_step_chips = (tmp_cp2 - tmp_cp1) / tmp_samples;
                 }
         }
     // remnant code phase [chips]
-    d_rem_code_phase_samples = d_K_blk_samples - static_cast<double>(d_current_prn_length_samples);  // rounding error < 1 sample
-    d_rem_code_phase_chips = d_code_freq_chips * d_rem_code_phase_samples / d_trk_parameters.fs_in;
+    d_hot.rem_code_phase_samples = d_K_blk_samples - static_cast<double>(d_hot.current_prn_length_samples);  // rounding error < 1 sample
+    d_hot.rem_code_phase_chips = d_hot.code_freq_chips * d_hot.rem_code_phase_samples / d_trk_parameters.fs_in;
 }
 
 
@@ -1246,23 +1524,23 @@ void dll_pll_veml_tracking::save_correlation_results()
                 {
                     if (d_veml)
                         {
-                            d_VE_accu += *d_Very_Early;
-                            d_VL_accu += *d_Very_Late;
+                            d_hot.VE_accu += *d_Very_Early;
+                            d_hot.VL_accu += *d_Very_Late;
                         }
-                    d_E_accu += *d_Early;
-                    d_P_accu += *d_Prompt;
-                    d_L_accu += *d_Late;
+                    d_hot.E_accu += *d_Early;
+                    d_hot.P_accu += *d_Prompt;
+                    d_hot.L_accu += *d_Late;
                 }
             else
                 {
                     if (d_veml)
                         {
-                            d_VE_accu -= *d_Very_Early;
-                            d_VL_accu -= *d_Very_Late;
+                            d_hot.VE_accu -= *d_Very_Early;
+                            d_hot.VL_accu -= *d_Very_Late;
                         }
-                    d_E_accu -= *d_Early;
-                    d_P_accu -= *d_Prompt;
-                    d_L_accu -= *d_Late;
+                    d_hot.E_accu -= *d_Early;
+                    d_hot.P_accu -= *d_Prompt;
+                    d_hot.L_accu -= *d_Late;
                 }
             d_current_symbol++;
             // secondary code roll-up
@@ -1272,12 +1550,12 @@ void dll_pll_veml_tracking::save_correlation_results()
         {
             if (d_veml)
                 {
-                    d_VE_accu += *d_Very_Early;
-                    d_VL_accu += *d_Very_Late;
+                    d_hot.VE_accu += *d_Very_Early;
+                    d_hot.VL_accu += *d_Very_Late;
                 }
-            d_E_accu += *d_Early;
-            d_P_accu += *d_Prompt;
-            d_L_accu += *d_Late;
+            d_hot.E_accu += *d_Early;
+            d_hot.P_accu += *d_Prompt;
+            d_hot.L_accu += *d_Late;
         }
 
     // data secondary code roll-up
@@ -1289,22 +1567,22 @@ void dll_pll_veml_tracking::save_correlation_results()
                         {
                             if (d_data_secondary_code_string[d_current_data_symbol] == '0')
                                 {
-                                    d_P_data_accu += d_Prompt_Data[0];
+                                    d_hot.P_data_accu += d_Prompt_Data[0];
                                 }
                             else
                                 {
-                                    d_P_data_accu -= d_Prompt_Data[0];
+                                    d_hot.P_data_accu -= d_Prompt_Data[0];
                                 }
                         }
                     else
                         {
                             if (d_data_secondary_code_string[d_current_data_symbol] == '0')
                                 {
-                                    d_P_data_accu += *d_Prompt;
+                                    d_hot.P_data_accu += *d_Prompt;
                                 }
                             else
                                 {
-                                    d_P_data_accu -= *d_Prompt;
+                                    d_hot.P_data_accu -= *d_Prompt;
                                 }
                         }
 
@@ -1316,11 +1594,11 @@ void dll_pll_veml_tracking::save_correlation_results()
                 {
                     if (d_trk_parameters.track_pilot)
                         {
-                            d_P_data_accu += d_Prompt_Data[0];
+                            d_hot.P_data_accu += d_Prompt_Data[0];
                         }
                     else
                         {
-                            d_P_data_accu += *d_Prompt;
+                            d_hot.P_data_accu += *d_Prompt;
                             // std::cout << "s[" << d_current_data_symbol << "]=" << (int)((*d_Prompt).real() > 0) << '\n';
                         }
                     d_current_data_symbol++;
@@ -1331,11 +1609,11 @@ void dll_pll_veml_tracking::save_correlation_results()
         {
             if (d_trk_parameters.track_pilot)
                 {
-                    d_P_data_accu = d_Prompt_Data[0];
+                    d_hot.P_data_accu = d_Prompt_Data[0];
                 }
             else
                 {
-                    d_P_data_accu = *d_Prompt;
+                    d_hot.P_data_accu = *d_Prompt;
                 }
         }
 
@@ -1355,6 +1633,14 @@ void dll_pll_veml_tracking::log_data()
 {
     if (d_dump)
         {
+            if (d_dump_decimation > 1)
+                {
+                    // budget-enforced downgrade: log one of every d_dump_decimation epochs
+                    if ((d_dump_record_counter++ % static_cast<uint64_t>(d_dump_decimation)) != 0)
+                        {
+                            return;
+                        }
+                }
             // Dump results to file
             float prompt_I;
             float prompt_Q;
@@ -1378,17 +1664,45 @@ void dll_pll_veml_tracking::log_data()
                 }
             if (d_veml)
                 {
-                    tmp_VE = std::abs<float>(d_VE_accu);
-                    tmp_VL = std::abs<float>(d_VL_accu);
+                    tmp_VE = std::abs<float>(d_hot.VE_accu);
+                    tmp_VL = std::abs<float>(d_hot.VL_accu);
                 }
             else
                 {
                     tmp_VE = 0.0;
                     tmp_VL = 0.0;
                 }
-            tmp_E = std::abs<float>(d_E_accu);
-            tmp_P = std::abs<float>(d_P_accu);
-            tmp_L = std::abs<float>(d_L_accu);
+            tmp_E = std::abs<float>(d_hot.E_accu);
+            tmp_P = std::abs<float>(d_hot.P_accu);
+            tmp_L = std::abs<float>(d_hot.L_accu);
+
+            if (d_columnar_dump.is_open())
+                {
+                    d_columnar_dump.put(tmp_VE);
+                    d_columnar_dump.put(tmp_E);
+                    d_columnar_dump.put(tmp_P);
+                    d_columnar_dump.put(tmp_L);
+                    d_columnar_dump.put(tmp_VL);
+                    d_columnar_dump.put(prompt_I);
+                    d_columnar_dump.put(prompt_Q);
+                    d_columnar_dump.put(d_sample_counter + static_cast<uint64_t>(d_hot.current_prn_length_samples));
+                    d_columnar_dump.put(static_cast<float>(d_hot.acc_carrier_phase_rad));
+                    d_columnar_dump.put(static_cast<float>(d_hot.carrier_doppler_hz));
+                    d_columnar_dump.put(static_cast<float>(d_hot.carrier_phase_rate_step_rad * d_trk_parameters.fs_in * d_trk_parameters.fs_in / TWO_PI));
+                    d_columnar_dump.put(static_cast<float>(d_hot.code_freq_chips));
+                    d_columnar_dump.put(static_cast<float>(d_hot.code_phase_rate_step_chips * d_trk_parameters.fs_in * d_trk_parameters.fs_in));
+                    d_columnar_dump.put(static_cast<float>(d_carr_phase_error_hz));
+                    d_columnar_dump.put(static_cast<float>(d_carr_error_filt_hz));
+                    d_columnar_dump.put(static_cast<float>(d_code_error_chips));
+                    d_columnar_dump.put(static_cast<float>(d_code_error_filt_chips));
+                    d_columnar_dump.put(static_cast<float>(d_CN0_SNV_dB_Hz));
+                    d_columnar_dump.put(static_cast<float>(d_carrier_lock_test));
+                    d_columnar_dump.put(static_cast<float>(d_hot.rem_code_phase_samples));
+                    d_columnar_dump.put(static_cast<double>(d_sample_counter + d_hot.current_prn_length_samples));
+                    d_columnar_dump.put(d_acquisition_gnss_synchro->PRN);
+                    d_columnar_dump.end_row();
+                    return;
+                }
 
             try
                 {
@@ -1402,21 +1716,21 @@ void dll_pll_veml_tracking::log_data()
                     d_dump_file.write(reinterpret_cast<char *>(&prompt_I), sizeof(float));
                     d_dump_file.write(reinterpret_cast<char *>(&prompt_Q), sizeof(float));
                     // PRN start sample stamp
-                    tmp_long_int = d_sample_counter + static_cast<uint64_t>(d_current_prn_length_samples);
+                    tmp_long_int = d_sample_counter + static_cast<uint64_t>(d_hot.current_prn_length_samples);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_long_int), sizeof(uint64_t));
                     // accumulated carrier phase
-                    tmp_float = static_cast<float>(d_acc_carrier_phase_rad);
+                    tmp_float = static_cast<float>(d_hot.acc_carrier_phase_rad);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
                     // carrier and code frequency
-                    tmp_float = static_cast<float>(d_carrier_doppler_hz);
+                    tmp_float = static_cast<float>(d_hot.carrier_doppler_hz);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
                     // carrier phase rate [Hz/s]
-                    tmp_float = static_cast<float>(d_carrier_phase_rate_step_rad * d_trk_parameters.fs_in * d_trk_parameters.fs_in / TWO_PI);
+                    tmp_float = static_cast<float>(d_hot.carrier_phase_rate_step_rad * d_trk_parameters.fs_in * d_trk_parameters.fs_in / TWO_PI);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_code_freq_chips);
+                    tmp_float = static_cast<float>(d_hot.code_freq_chips);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
                     // code phase rate [chips/s^2]
-                    tmp_float = static_cast<float>(d_code_phase_rate_step_chips * d_trk_parameters.fs_in * d_trk_parameters.fs_in);
+                    tmp_float = static_cast<float>(d_hot.code_phase_rate_step_chips * d_trk_parameters.fs_in * d_trk_parameters.fs_in);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
                     // PLL commands
                     tmp_float = static_cast<float>(d_carr_phase_error_hz);
@@ -1434,9 +1748,9 @@ void dll_pll_veml_tracking::log_data()
                     tmp_float = static_cast<float>(d_carrier_lock_test);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
                     // AUX vars (for debug purposes)
-                    tmp_float = static_cast<float>(d_rem_code_phase_samples);
+                    tmp_float = static_cast<float>(d_hot.rem_code_phase_samples);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_double = static_cast<double>(d_sample_counter + d_current_prn_length_samples);
+                    tmp_double = static_cast<double>(d_sample_counter + d_hot.current_prn_length_samples);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
                     // PRN
                     uint32_t prn_ = d_acquisition_gnss_synchro->PRN;
@@ -1487,6 +1801,10 @@ int32_t dll_pll_veml_tracking::save_matfile() const
         {
             return 1;
         }
+    if (!Dump_Budget::mat_conversion_allowed(static_cast<size_t>(size)))
+        {
+            return 1;
+        }
     auto abs_VE = std::vector<float>(num_epoch);
     auto abs_E = std::vector<float>(num_epoch);
     auto abs_P = std::vector<float>(num_epoch);
@@ -1654,9 +1972,64 @@ void dll_pll_veml_tracking::set_channel(uint32_t channel)
 {
     gr::thread::scoped_lock l(d_setlock);
     d_channel = channel;
+    d_work_monitor.set_instance(channel);
     LOG(INFO) << "Tracking Channel set to " << d_channel;
     // ############# ENABLE DATA FILE LOG #################
     if (d_dump)
+        {
+            // ask the dump budget for a grant before allocating any dump
+            // buffering: 100 bytes per epoch record, chunked in batches of
+            // 4096 rows with a few chunks in flight towards the disk
+            const uint32_t dump_rows_per_chunk = 4096;
+            const size_t dump_row_bytes = 100;
+            const Dump_Budget::Grant grant = Dump_Budget::request(this, "Tracking",
+                d_trk_parameters.dump_columnar ? dump_rows_per_chunk * dump_row_bytes * 4 : 65536);
+            if (!grant.enabled)
+                {
+                    d_dump = false;
+                    d_dump_mat = false;
+                }
+            else
+                {
+                    d_dump_decimation = grant.decimation;
+                }
+        }
+    if (d_dump and d_trk_parameters.dump_columnar)
+        {
+            // streaming columnar dump: bounded memory, no shutdown
+            // conversion pass. Columns keep the names used by save_matfile()
+            const uint32_t dump_rows_per_chunk = 4096 / d_dump_decimation;
+            std::string dump_filename_ = d_dump_filename;
+            dump_filename_.append(std::to_string(d_channel));
+            dump_filename_.append(".gscd");
+            d_columnar_dump.add_column("abs_VE", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("abs_E", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("abs_P", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("abs_L", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("abs_VL", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("Prompt_I", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("Prompt_Q", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("PRN_start_sample_count", Columnar_Dump_Writer::Column_Type::u64);
+            d_columnar_dump.add_column("acc_carrier_phase_rad", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("carrier_doppler_hz", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("carrier_doppler_rate_hz", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("code_freq_chips", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("code_freq_rate_chips", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("carr_error_hz", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("carr_error_filt_hz", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("code_error_chips", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("code_error_filt_chips", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("CN0_SNV_dB_Hz", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("carrier_lock_test", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("aux1", Columnar_Dump_Writer::Column_Type::f32);
+            d_columnar_dump.add_column("aux2", Columnar_Dump_Writer::Column_Type::f64);
+            d_columnar_dump.add_column("PRN", Columnar_Dump_Writer::Column_Type::u32);
+            if (d_columnar_dump.open(dump_filename_, dump_rows_per_chunk, d_trk_parameters.dump_rows_per_file))
+                {
+                    LOG(INFO) << "Tracking columnar dump enabled on channel " << d_channel << " Log file: " << dump_filename_;
+                }
+        }
+    else if (d_dump)
         {
             std::string dump_filename_ = d_dump_filename;
             // add channel number to the filename
@@ -1695,11 +2068,99 @@ void dll_pll_veml_tracking::stop_tracking()
 }
 
 
+bool dll_pll_veml_tracking::set_runtime_parameter(const std::string &name, double value)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    if (name == "pll_bw_hz")
+        {
+            d_trk_parameters.pll_bw_hz = static_cast<float>(value);
+        }
+    else if (name == "pll_bw_narrow_hz")
+        {
+            d_trk_parameters.pll_bw_narrow_hz = static_cast<float>(value);
+        }
+    else if (name == "dll_bw_hz")
+        {
+            d_trk_parameters.dll_bw_hz = static_cast<float>(value);
+        }
+    else if (name == "dll_bw_narrow_hz")
+        {
+            d_trk_parameters.dll_bw_narrow_hz = static_cast<float>(value);
+        }
+    else if (name == "fll_bw_hz")
+        {
+            d_trk_parameters.fll_bw_hz = static_cast<float>(value);
+        }
+    else
+        {
+            return false;
+        }
+    // Re-apply the bandwidth set that corresponds to the current tracking
+    // state. The filter states are kept, only the gains are recomputed
+    const bool narrow = (d_state == 3) || (d_state == 4);
+    d_code_loop_filter.set_noise_bandwidth(narrow ? d_trk_parameters.dll_bw_narrow_hz : d_trk_parameters.dll_bw_hz);
+    d_carrier_loop_filter.set_params(d_trk_parameters.fll_bw_hz, narrow ? d_trk_parameters.pll_bw_narrow_hz : d_trk_parameters.pll_bw_hz, d_trk_parameters.pll_filter_order);
+    LOG(INFO) << "Tracking channel " << d_channel << ": runtime update " << name << "=" << value;
+    return true;
+}
+
+
+bool dll_pll_veml_tracking::get_runtime_parameter(const std::string &name, double *value)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    if (name == "pll_bw_hz")
+        {
+            *value = static_cast<double>(d_trk_parameters.pll_bw_hz);
+        }
+    else if (name == "pll_bw_narrow_hz")
+        {
+            *value = static_cast<double>(d_trk_parameters.pll_bw_narrow_hz);
+        }
+    else if (name == "dll_bw_hz")
+        {
+            *value = static_cast<double>(d_trk_parameters.dll_bw_hz);
+        }
+    else if (name == "dll_bw_narrow_hz")
+        {
+            *value = static_cast<double>(d_trk_parameters.dll_bw_narrow_hz);
+        }
+    else if (name == "fll_bw_hz")
+        {
+            *value = static_cast<double>(d_trk_parameters.fll_bw_hz);
+        }
+    else
+        {
+            return false;
+        }
+    return true;
+}
+
+
 int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items,
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
     gr::thread::scoped_lock l(d_setlock);
-    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    Work_Monitor_Scope work_timer(d_work_monitor, static_cast<uint32_t>(ninput_items[0]), d_sample_counter);
+    tracking_hot_state_prefetch(&d_hot);
+    const gr_complex *in;
+    if (d_cshort)
+        {
+            const auto *in_sc = reinterpret_cast<const lv_16sc_t *>(input_items[0]);
+            const auto num_samples = std::min(static_cast<size_t>(ninput_items[0]), d_input_buffer.size());
+            volk_gnsssdr_16ic_convert_32fc(d_input_buffer.data(), in_sc, num_samples);
+            in = d_input_buffer.data();
+        }
+    else if (d_cbyte)
+        {
+            const auto *in_sb = reinterpret_cast<const lv_8sc_t *>(input_items[0]);
+            const auto num_samples = std::min(static_cast<size_t>(ninput_items[0]), d_input_buffer.size());
+            volk_gnsssdr_8ic_convert_32fc(d_input_buffer.data(), in_sb, num_samples);
+            in = d_input_buffer.data();
+        }
+    else
+        {
+            in = reinterpret_cast<const gr_complex *>(input_items[0]);
+        }
     auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
     Gnss_Synchro current_synchro_data = Gnss_Synchro();
     current_synchro_data.Flag_valid_symbol_output = false;
@@ -1730,25 +2191,25 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 const double acq_trk_diff_seconds = static_cast<double>(acq_trk_diff_samples) / d_trk_parameters.fs_in;
                 const double delta_trk_to_acq_prn_start_samples = static_cast<double>(acq_trk_diff_samples) - d_acq_code_phase_samples;
 
-                d_code_freq_chips = d_code_chip_rate;
-                d_code_phase_step_chips = d_code_freq_chips / d_trk_parameters.fs_in;
-                d_code_phase_rate_step_chips = 0.0;
-                const double T_chip_mod_seconds = 1.0 / d_code_freq_chips;
+                d_hot.code_freq_chips = d_code_chip_rate;
+                d_hot.code_phase_step_chips = d_hot.code_freq_chips / d_trk_parameters.fs_in;
+                d_hot.code_phase_rate_step_chips = 0.0;
+                const double T_chip_mod_seconds = 1.0 / d_hot.code_freq_chips;
                 const double T_prn_mod_seconds = T_chip_mod_seconds * static_cast<double>(d_code_length_chips);
                 const double T_prn_mod_samples = T_prn_mod_seconds * d_trk_parameters.fs_in;
 
                 d_acq_code_phase_samples = T_prn_mod_samples - std::fmod(delta_trk_to_acq_prn_start_samples, T_prn_mod_samples);
-                d_current_prn_length_samples = round(T_prn_mod_samples);
+                d_hot.current_prn_length_samples = round(T_prn_mod_samples);
 
                 const int32_t samples_offset = round(d_acq_code_phase_samples);
-                d_acc_carrier_phase_rad -= d_carrier_phase_step_rad * static_cast<double>(samples_offset);
+                d_hot.acc_carrier_phase_rad -= d_hot.carrier_phase_step_rad * static_cast<double>(samples_offset);
                 d_state = 2;
                 d_sample_counter += samples_offset;  // count for the processed samples
                 d_cn0_smoother.reset();
                 d_carrier_lock_test_smoother.reset();
 
                 LOG(INFO) << "Number of samples between Acquisition and Tracking = " << acq_trk_diff_samples << " ( " << acq_trk_diff_seconds << " s)";
-                DLOG(INFO) << "PULL-IN Doppler [Hz] = " << d_carrier_doppler_hz
+                DLOG(INFO) << "PULL-IN Doppler [Hz] = " << d_hot.carrier_doppler_hz
                            << ". PULL-IN Code Phase [samples] = " << d_acq_code_phase_samples;
 
                 consume_each(samples_offset);  // shift input to perform alignment with local replica
@@ -1760,12 +2221,12 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 // Save single correlation step variables
                 if (d_veml)
                     {
-                        d_VE_accu = *d_Very_Early;
-                        d_VL_accu = *d_Very_Late;
+                        d_hot.VE_accu = *d_Very_Early;
+                        d_hot.VL_accu = *d_Very_Late;
                     }
-                d_E_accu = *d_Early;
-                d_P_accu = *d_Prompt;
-                d_L_accu = *d_Late;
+                d_hot.E_accu = *d_Early;
+                d_hot.P_accu = *d_Prompt;
+                d_hot.L_accu = *d_Late;
                 d_trk_parameters.spc = d_trk_parameters.early_late_space_chips;
                 // if (std::string(d_trk_parameters.signal) == "E1")
                 //    {
@@ -1791,6 +2252,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 else
                     {
                         bool next_state = false;
+                        int32_t secondary_phase = 0;  // secondary code index of the next symbol once locked
                         // Perform DLL/PLL tracking loop computations. Costas Loop enabled
                         run_dll_pll();
                         update_tracking_vars();
@@ -1806,7 +2268,8 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                                         d_Prompt_circular_buffer.push_back(*d_Prompt);
                                         if (d_Prompt_circular_buffer.size() == d_secondary_code_length)
                                             {
-                                                next_state = acquire_secondary();
+                                                secondary_phase = acquire_secondary_all_phases();
+                                                next_state = (secondary_phase >= 0);
                                                 if (next_state)
                                                     {
                                                         LOG(INFO) << d_systemName << " " << d_signal_pretty_name << " secondary code locked in channel " << d_channel
@@ -1843,21 +2306,35 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                             }
                         if (next_state)
                             {  // reset extended correlator
-                                d_VE_accu = gr_complex(0.0, 0.0);
-                                d_E_accu = gr_complex(0.0, 0.0);
-                                d_P_accu = gr_complex(0.0, 0.0);
-                                d_P_data_accu = gr_complex(0.0, 0.0);
-                                d_L_accu = gr_complex(0.0, 0.0);
-                                d_VL_accu = gr_complex(0.0, 0.0);
+                                d_hot.VE_accu = gr_complex(0.0, 0.0);
+                                d_hot.E_accu = gr_complex(0.0, 0.0);
+                                d_hot.P_accu = gr_complex(0.0, 0.0);
+                                d_hot.P_data_accu = gr_complex(0.0, 0.0);
+                                d_hot.L_accu = gr_complex(0.0, 0.0);
+                                d_hot.VL_accu = gr_complex(0.0, 0.0);
                                 d_Prompt_circular_buffer.clear();
-                                d_current_symbol = 0;
-                                d_current_data_symbol = 0;
+                                // start at the detected secondary code phase instead of
+                                // waiting for the next period boundary
+                                d_current_symbol = secondary_phase;
+                                if (d_data_secondary_code_length > 0)
+                                    {
+                                        d_current_data_symbol = secondary_phase % static_cast<int32_t>(d_data_secondary_code_length);
+                                    }
+                                else if (d_symbols_per_bit > 1)
+                                    {
+                                        d_current_data_symbol = secondary_phase % d_symbols_per_bit;
+                                    }
+                                else
+                                    {
+                                        d_current_data_symbol = 0;
+                                    }
 
                                 if (d_enable_extended_integration)
                                     {
                                         // UPDATE INTEGRATION TIME
                                         d_extend_correlation_symbols_count = 0;
-                                        d_current_correlation_time_s = static_cast<float>(d_trk_parameters.extend_correlation_symbols) * static_cast<float>(d_code_period);
+                                        d_current_extension_symbols = d_trk_parameters.extend_correlation_symbols;
+                                        d_current_correlation_time_s = static_cast<float>(d_current_extension_symbols) * static_cast<float>(d_code_period);
                                         d_state = 3;  // next state is the extended correlator integrator
                                         LOG(INFO) << "Enabled " << d_trk_parameters.extend_correlation_symbols * static_cast<int32_t>(d_code_period * 1000.0) << " ms extended correlator in channel "
                                                   << d_channel
@@ -1911,24 +2388,24 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                         current_synchro_data = *d_acquisition_gnss_synchro;
                         if (d_interchange_iq)
                             {
-                                current_synchro_data.Prompt_I = static_cast<double>(d_P_data_accu.imag());
-                                current_synchro_data.Prompt_Q = static_cast<double>(d_P_data_accu.real());
+                                current_synchro_data.Prompt_I = static_cast<double>(d_hot.P_data_accu.imag());
+                                current_synchro_data.Prompt_Q = static_cast<double>(d_hot.P_data_accu.real());
                             }
                         else
                             {
-                                current_synchro_data.Prompt_I = static_cast<double>(d_P_data_accu.real());
-                                current_synchro_data.Prompt_Q = static_cast<double>(d_P_data_accu.imag());
+                                current_synchro_data.Prompt_I = static_cast<double>(d_hot.P_data_accu.real());
+                                current_synchro_data.Prompt_Q = static_cast<double>(d_hot.P_data_accu.imag());
                             }
-                        current_synchro_data.Code_phase_samples = d_rem_code_phase_samples;
-                        current_synchro_data.Carrier_phase_rads = d_acc_carrier_phase_rad;
-                        current_synchro_data.Carrier_Doppler_hz = d_carrier_doppler_hz;
+                        current_synchro_data.Code_phase_samples = d_hot.rem_code_phase_samples;
+                        current_synchro_data.Carrier_phase_rads = d_hot.acc_carrier_phase_rad;
+                        current_synchro_data.Carrier_Doppler_hz = d_hot.carrier_doppler_hz;
                         current_synchro_data.CN0_dB_hz = d_CN0_SNV_dB_Hz;
                         current_synchro_data.correlation_length_ms = d_correlation_length_ms;
                         current_synchro_data.Flag_valid_symbol_output = true;
-                        d_P_data_accu = gr_complex(0.0, 0.0);
+                        d_hot.P_data_accu = gr_complex(0.0, 0.0);
                     }
                 d_extend_correlation_symbols_count++;
-                if (d_extend_correlation_symbols_count == (d_trk_parameters.extend_correlation_symbols - 1))
+                if (d_extend_correlation_symbols_count == (d_current_extension_symbols - 1))
                     {
                         d_extend_correlation_symbols_count = 0;
                         d_state = 4;
@@ -1942,7 +2419,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 save_correlation_results();
 
                 // check lock status
-                if (!cn0_and_tracking_lock_status(d_code_period * static_cast<double>(d_trk_parameters.extend_correlation_symbols)))
+                if (!cn0_and_tracking_lock_status(d_code_period * static_cast<double>(d_current_extension_symbols)))
                     {
                         clear_tracking_vars();
                         d_state = 0;                                         // loss-of-lock detected
@@ -1963,42 +2440,69 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                                 current_synchro_data = *d_acquisition_gnss_synchro;
                                 if (d_interchange_iq)
                                     {
-                                        current_synchro_data.Prompt_I = static_cast<double>(d_P_data_accu.imag());
-                                        current_synchro_data.Prompt_Q = static_cast<double>(d_P_data_accu.real());
+                                        current_synchro_data.Prompt_I = static_cast<double>(d_hot.P_data_accu.imag());
+                                        current_synchro_data.Prompt_Q = static_cast<double>(d_hot.P_data_accu.real());
                                     }
                                 else
                                     {
-                                        current_synchro_data.Prompt_I = static_cast<double>(d_P_data_accu.real());
-                                        current_synchro_data.Prompt_Q = static_cast<double>(d_P_data_accu.imag());
+                                        current_synchro_data.Prompt_I = static_cast<double>(d_hot.P_data_accu.real());
+                                        current_synchro_data.Prompt_Q = static_cast<double>(d_hot.P_data_accu.imag());
                                     }
-                                current_synchro_data.Code_phase_samples = d_rem_code_phase_samples;
-                                current_synchro_data.Carrier_phase_rads = d_acc_carrier_phase_rad;
-                                current_synchro_data.Carrier_Doppler_hz = d_carrier_doppler_hz;
+                                current_synchro_data.Code_phase_samples = d_hot.rem_code_phase_samples;
+                                current_synchro_data.Carrier_phase_rads = d_hot.acc_carrier_phase_rad;
+                                current_synchro_data.Carrier_Doppler_hz = d_hot.carrier_doppler_hz;
                                 current_synchro_data.CN0_dB_hz = d_CN0_SNV_dB_Hz;
                                 current_synchro_data.correlation_length_ms = d_correlation_length_ms;
                                 current_synchro_data.Flag_valid_symbol_output = true;
-                                d_P_data_accu = gr_complex(0.0, 0.0);
+                                d_hot.P_data_accu = gr_complex(0.0, 0.0);
                             }
 
                         // reset extended correlator
-                        d_VE_accu = gr_complex(0.0, 0.0);
-                        d_E_accu = gr_complex(0.0, 0.0);
-                        d_P_accu = gr_complex(0.0, 0.0);
-                        d_L_accu = gr_complex(0.0, 0.0);
-                        d_VL_accu = gr_complex(0.0, 0.0);
-                        if (d_enable_extended_integration)
+                        d_hot.VE_accu = gr_complex(0.0, 0.0);
+                        d_hot.E_accu = gr_complex(0.0, 0.0);
+                        d_hot.P_accu = gr_complex(0.0, 0.0);
+                        d_hot.L_accu = gr_complex(0.0, 0.0);
+                        d_hot.VL_accu = gr_complex(0.0, 0.0);
+
+                        // ####### ADAPTIVE CORRELATION EXTENSION #####
+                        // switch between single-symbol and extended epochs depending on the
+                        // estimated C/N0, changing the integration time only at symbol boundaries
+                        if (d_trk_parameters.auto_extend_correlation and d_enable_extended_integration and
+                            !d_coasting and d_current_data_symbol == 0)
+                            {
+                                if (d_current_extension_symbols == 1 and d_CN0_SNV_dB_Hz < d_trk_parameters.auto_extend_cn0_low)
+                                    {
+                                        d_current_extension_symbols = d_trk_parameters.extend_correlation_symbols;
+                                        d_current_correlation_time_s = static_cast<float>(d_current_extension_symbols) * static_cast<float>(d_code_period);
+                                        d_code_loop_filter.set_update_interval(static_cast<float>(d_current_correlation_time_s));
+                                        d_extend_correlation_symbols_count = 0;
+                                        DLOG(INFO) << "Channel " << d_channel << " extended the integration to "
+                                                   << d_current_extension_symbols << " symbols (C/N0 " << d_CN0_SNV_dB_Hz << " dB-Hz)";
+                                    }
+                                else if (d_current_extension_symbols > 1 and d_CN0_SNV_dB_Hz > d_trk_parameters.auto_extend_cn0_high)
+                                    {
+                                        d_current_extension_symbols = 1;
+                                        d_current_correlation_time_s = static_cast<float>(d_code_period);
+                                        d_code_loop_filter.set_update_interval(static_cast<float>(d_current_correlation_time_s));
+                                        d_extend_correlation_symbols_count = 0;
+                                        DLOG(INFO) << "Channel " << d_channel << " back to single-symbol integration (C/N0 "
+                                                   << d_CN0_SNV_dB_Hz << " dB-Hz)";
+                                    }
+                            }
+                        if (d_enable_extended_integration and d_current_extension_symbols > 1)
                             {
                                 d_state = 3;  // new coherent integration (correlation time extension) cycle
                             }
                     }
             }
         }
-    consume_each(d_current_prn_length_samples);
-    d_sample_counter += static_cast<uint64_t>(d_current_prn_length_samples);
+    consume_each(d_hot.current_prn_length_samples);
+    d_sample_counter += static_cast<uint64_t>(d_hot.current_prn_length_samples);
     if (current_synchro_data.Flag_valid_symbol_output || loss_of_lock)
         {
             current_synchro_data.fs = static_cast<int64_t>(d_trk_parameters.fs_in);
             current_synchro_data.Tracking_sample_counter = d_sample_counter;
+            current_synchro_data.Ingest_time_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
             current_synchro_data.Flag_valid_symbol_output = !loss_of_lock;
             *out[0] = current_synchro_data;
             return 1;
@@ -18,12 +18,17 @@
 #ifndef GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 #define GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 
+#include "columnar_dump_writer.h"  // for Columnar_Dump_Writer
 #include "cpu_multicorrelator_real_codes.h"
 #include "dll_pll_conf.h"
 #include "exponential_smoother.h"
 #include "gnss_block_interface.h"
+#include "multipath_estimator.h"      // for Multipath_Estimator
+#include "scintillation_monitor.h"    // for Scintillation_Monitor
 #include "tracking_FLL_PLL_filter.h"  // for PLL/FLL filter
+#include "tracking_hot_state.h"       // for Tracking_Hot_State
 #include "tracking_loop_filter.h"     // for DLL filter
+#include "work_monitor.h"             // for Work_Monitor
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>                   // for block
 #include <gnuradio/gr_complex.h>              // for gr_complex
@@ -64,6 +69,20 @@ public:
     void start_tracking();
     void stop_tracking();
 
+    /*!
+     * \brief Updates a published loop parameter (pll_bw_hz, pll_bw_narrow_hz,
+     * dll_bw_hz, dll_bw_narrow_hz or fll_bw_hz) while the loop is running.
+     * The loop filter states are preserved, so the channel does not lose lock.
+     * Returns false if the parameter is not published.
+     */
+    bool set_runtime_parameter(const std::string &name, double value);
+
+    /*!
+     * \brief Gets the current value of a published loop parameter.
+     * Returns false if the parameter is not published.
+     */
+    bool get_runtime_parameter(const std::string &name, double *value);
+
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
@@ -83,8 +102,11 @@ private:
     void log_data();
     bool cn0_and_tracking_lock_status(double coh_integration_time_s);
     bool acquire_secondary();
+    int32_t acquire_secondary_all_phases();
     int32_t save_matfile() const;
 
+    Tracking_Hot_State d_hot;  // per-sample loop state, kept in its own cache lines
+
     Cpu_Multicorrelator_Real_Codes d_multicorrelator_cpu;
     Cpu_Multicorrelator_Real_Codes d_correlator_data_cpu;  // for data channel
 
@@ -93,17 +115,24 @@ private:
     Exponential_Smoother d_cn0_smoother;
     Exponential_Smoother d_carrier_lock_test_smoother;
 
+    Multipath_Estimator d_multipath_estimator;
+    Scintillation_Monitor d_scint_monitor;
+
     Tracking_loop_filter d_code_loop_filter;
     Tracking_FLL_PLL_filter d_carrier_loop_filter;
 
+    Work_Monitor d_work_monitor;
+
     Gnss_Synchro *d_acquisition_gnss_synchro;
 
     volk_gnsssdr::vector<float> d_tracking_code;
     volk_gnsssdr::vector<float> d_data_code;
+    volk_gnsssdr::vector<gr_complex> d_aux_code;
     volk_gnsssdr::vector<float> d_local_code_shift_chips;
     volk_gnsssdr::vector<gr_complex> d_correlator_outs;
     volk_gnsssdr::vector<gr_complex> d_Prompt_Data;
     volk_gnsssdr::vector<gr_complex> d_Prompt_buffer;
+    volk_gnsssdr::vector<gr_complex> d_input_buffer;
 
     boost::circular_buffer<float> d_dll_filt_history;
     boost::circular_buffer<std::pair<double, double>> d_code_ph_history;
@@ -123,10 +152,6 @@ private:
     double d_carr_error_filt_hz;
     double d_code_error_chips;
     double d_code_error_filt_chips;
-    double d_code_freq_chips;
-    double d_carrier_doppler_hz;
-    double d_acc_carrier_phase_rad;
-    double d_rem_code_phase_chips;
     double d_T_chip_seconds;
     double d_T_prn_seconds;
     double d_T_prn_samples;
@@ -134,11 +159,6 @@ private:
     double d_carrier_lock_test;
     double d_CN0_SNV_dB_Hz;
     double d_carrier_lock_threshold;
-    double d_carrier_phase_step_rad;
-    double d_carrier_phase_rate_step_rad;
-    double d_code_phase_step_chips;
-    double d_code_phase_rate_step_chips;
-    double d_rem_code_phase_samples;
 
     gr_complex *d_Very_Early;
     gr_complex *d_Early;
@@ -146,39 +166,36 @@ private:
     gr_complex *d_Late;
     gr_complex *d_Very_Late;
 
-    gr_complex d_VE_accu;
-    gr_complex d_E_accu;
-    gr_complex d_P_accu;
-    gr_complex d_P_accu_old;
-    gr_complex d_L_accu;
-    gr_complex d_VL_accu;
-    gr_complex d_P_data_accu;
-
     std::string d_secondary_code_string;
     std::string d_data_secondary_code_string;
     std::string d_systemName;
     std::string d_signal_type;
     std::string d_signal_pretty_name;
     std::string d_dump_filename;
+    std::string d_multiband_sat_key;  // "System PRN" key into the shared multiband NCO registry
 
     std::ofstream d_dump_file;
+    Columnar_Dump_Writer d_columnar_dump;
 
     uint64_t d_sample_counter;
     uint64_t d_acq_sample_stamp;
+    uint64_t d_dump_record_counter;
 
     float *d_prompt_data_shift;
-    float d_rem_carr_phase_rad;
 
     int32_t d_symbols_per_bit;
     int32_t d_preamble_length_symbols;
     int32_t d_state;
     int32_t d_correlation_length_ms;
     int32_t d_n_correlator_taps;
-    int32_t d_current_prn_length_samples;
+    int32_t d_n_multipath_taps;  // extra taps feeding the multipath estimator
     int32_t d_extend_correlation_symbols_count;
+    int32_t d_current_extension_symbols;
     int32_t d_current_symbol;
     int32_t d_current_data_symbol;
     int32_t d_cn0_estimation_counter;
+    int32_t d_coasting_epochs_counter;
+    int32_t d_max_coasting_epochs;
     int32_t d_carrier_lock_fail_counter;
     int32_t d_code_lock_fail_counter;
     int32_t d_code_samples_per_chip;  // All signals have 1 sample per chip code except Gal. E1 which has 2 (CBOC disabled) or 12 (CBOC enabled)
@@ -187,8 +204,12 @@ private:
     uint32_t d_channel;
     uint32_t d_secondary_code_length;
     uint32_t d_data_secondary_code_length;
+    uint32_t d_dump_decimation;  // log one of every d_dump_decimation epochs, set by the dump budget
 
     bool d_pull_in_transitory;
+    bool d_coasting;
+    bool d_cshort;
+    bool d_cbyte;
     bool d_corrected_doppler;
     bool d_interchange_iq;
     bool d_veml;
@@ -198,6 +219,7 @@ private:
     bool d_dump_mat;
     bool d_acc_carrier_phase_initialized;
     bool d_enable_extended_integration;
+    bool d_multiband_nco_master;  // this channel publishes the shared multiband NCO accumulator
 };
 
 
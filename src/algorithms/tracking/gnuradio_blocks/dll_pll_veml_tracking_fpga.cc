@@ -28,6 +28,7 @@
 #include "Galileo_E5a.h"
 #include "MATH_CONSTANTS.h"
 #include "fpga_multicorrelator.h"
+#include "gnss_message_ids.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_synchro.h"
@@ -653,7 +654,7 @@ bool dll_pll_veml_tracking_fpga::cn0_and_tracking_lock_status(double coh_integra
             LOG(INFO) << "Loss of lock in channel " << d_channel
                       << " (carrier_lock_fail_counter:" << d_carrier_lock_fail_counter
                       << " code_lock_fail_counter : " << d_code_lock_fail_counter << ")";
-            this->message_port_pub(pmt::mp("events"), pmt::from_long(3));  // 3 -> loss of lock
+            this->message_port_pub(msg_ids::events_port(), msg_ids::telemetry_failure());  // 3 -> loss of lock
             d_carrier_lock_fail_counter = 0;
             d_code_lock_fail_counter = 0;
             d_multicorrelator_fpga->unlock_channel();
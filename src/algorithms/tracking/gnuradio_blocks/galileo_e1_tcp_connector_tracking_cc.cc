@@ -26,6 +26,7 @@
 #include "GPS_L1_CA.h"
 #include "Galileo_E1.h"
 #include "galileo_e1_signal_replica.h"
+#include "gnss_message_ids.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_flags.h"
 #include "lock_detectors.h"
@@ -414,7 +415,7 @@ int Galileo_E1_Tcp_Connector_Tracking_cc::general_work(int noutput_items __attri
                         {
                             std::cout << "Loss of lock in channel " << d_channel << "!\n";
                             LOG(INFO) << "Loss of lock in channel " << d_channel << "!";
-                            this->message_port_pub(pmt::mp("events"), pmt::from_long(3));  // 3 -> loss of lock
+                            this->message_port_pub(msg_ids::events_port(), msg_ids::telemetry_failure());  // 3 -> loss of lock
 
                             d_carrier_lock_fail_counter = 0;
                             d_enable_tracking = false;  // TODO: check if disabling tracking is consistent with the channel state machine
@@ -26,6 +26,7 @@
 #include "GLONASS_L1_L2_CA.h"
 #include "MATH_CONSTANTS.h"
 #include "glonass_l1_signal_replica.h"
+#include "gnss_message_ids.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_flags.h"
 #include "lock_detectors.h"
@@ -775,7 +776,7 @@ int glonass_l1_ca_dll_pll_c_aid_tracking_cc::general_work(int noutput_items __at
                                 {
                                     std::cout << "Loss of lock in channel " << d_channel << "!\n";
                                     LOG(INFO) << "Loss of lock in channel " << d_channel << "!";
-                                    this->message_port_pub(pmt::mp("events"), pmt::from_long(3));  // 3 -> loss of lock
+                                    this->message_port_pub(msg_ids::events_port(), msg_ids::telemetry_failure());  // 3 -> loss of lock
                                     d_carrier_lock_fail_counter = 0;
                                     d_enable_tracking = false;  // TODO: check if disabling tracking is consistent with the channel state machine
                                     loss_of_lock = true;
@@ -16,6 +16,7 @@
 
 #include "gps_l1_ca_dll_pll_tracking_gpu_cc.h"
 #include "GPS_L1_CA.h"
+#include "gnss_message_ids.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_flags.h"
 #include "gps_sdr_signal_replica.h"
@@ -39,10 +40,11 @@ gps_l1_ca_dll_pll_make_tracking_gpu_cc(
     std::string dump_filename,
     float pll_bw_hz,
     float dll_bw_hz,
-    float early_late_space_chips)
+    float early_late_space_chips,
+    bool gpu_resident)
 {
     return gps_l1_ca_dll_pll_tracking_gpu_cc_sptr(new Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc(
-        fs_in, vector_length, dump, dump_filename, pll_bw_hz, dll_bw_hz, early_late_space_chips));
+        fs_in, vector_length, dump, dump_filename, pll_bw_hz, dll_bw_hz, early_late_space_chips, gpu_resident));
 }
 
 
@@ -63,7 +65,8 @@ Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc::Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc(
     std::string dump_filename,
     float pll_bw_hz,
     float dll_bw_hz,
-    float early_late_space_chips) : gr::block("Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)),
+    float early_late_space_chips,
+    bool gpu_resident) : gr::block("Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)),
                                         gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)))
 {
     // Telemetry bit synchronization message port input
@@ -108,6 +111,20 @@ Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc::Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc(
     multicorrelator_gpu->init_cuda_integrated_resampler(2 * d_vector_length, GPS_L1_CA_CODE_LENGTH_CHIPS, d_n_correlator_taps);
     multicorrelator_gpu->set_input_output_vectors(d_correlator_outs, in_gpu);
 
+    // device-resident mode: the input window is uploaded once per epoch into
+    // a device buffer shared by all channels, and the wipe-off + correlation
+    // run fused on that buffer. Falls back to the per-channel host-mapped
+    // buffer if the shared windows cannot be allocated
+    d_gpu_resident = gpu_resident;
+    if (d_gpu_resident)
+        {
+            d_gpu_resident = cuda_channel_pipeline::get_instance().init(2 * d_vector_length);
+            if (!d_gpu_resident)
+                {
+                    LOG(WARNING) << "GPU-resident tracking mode requested but unavailable, using per-channel sample copies";
+                }
+        }
+
     // define initial code frequency basis of NCO
     d_code_freq_chips = GPS_L1_CA_CODE_RATE_CPS;
     // define residual code phase (in chips)
@@ -251,6 +268,10 @@ Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc::~Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc()
         }
     try
         {
+            if (d_gpu_resident)
+                {
+                    cuda_channel_pipeline::get_instance().release();
+                }
             cudaFreeHost(in_gpu);
             cudaFreeHost(d_correlator_outs);
             cudaFreeHost(d_local_code_shift_chips);
@@ -350,14 +371,41 @@ int Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc::general_work(int noutput_items __attribut
             // ################# CARRIER WIPEOFF AND CORRELATORS ##############################
             // perform carrier wipe-off and compute Early, Prompt and Late correlation
 
-            memcpy(in_gpu, in, sizeof(gr_complex) * d_correlation_length_samples);
-            cudaProfilerStart();
-            multicorrelator_gpu->Carrier_wipeoff_multicorrelator_resampler_cuda(static_cast<float>(d_rem_carrier_phase_rad),
-                static_cast<float>(d_carrier_phase_step_rad),
-                static_cast<float>(d_code_phase_step_chips),
-                static_cast<float>(d_rem_code_phase_chips),
-                d_correlation_length_samples, d_n_correlator_taps);
-            cudaProfilerStop();
+            bool device_resident_done = false;
+            if (d_gpu_resident)
+                {
+                    // lease the device-resident window covering this epoch;
+                    // forecast() guarantees 2 * d_vector_length samples at in,
+                    // so the first channel uploads the full stretch and the
+                    // remaining channels hit the shared window cache
+                    cuda_signal_window window{};
+                    if (cuda_channel_pipeline::get_instance().acquire_window(in, d_sample_counter,
+                            d_correlation_length_samples, static_cast<int32_t>(2 * d_vector_length),
+                            multicorrelator_gpu->get_stream(), window))
+                        {
+                            cudaProfilerStart();
+                            multicorrelator_gpu->Carrier_wipeoff_multicorrelator_resampler_device_cuda(window.dev_ptr,
+                                static_cast<float>(d_rem_carrier_phase_rad),
+                                static_cast<float>(d_carrier_phase_step_rad),
+                                static_cast<float>(d_code_phase_step_chips),
+                                static_cast<float>(d_rem_code_phase_chips),
+                                d_correlation_length_samples, d_n_correlator_taps);
+                            cudaProfilerStop();
+                            cuda_channel_pipeline::get_instance().release_window(window);
+                            device_resident_done = true;
+                        }
+                }
+            if (!device_resident_done)
+                {
+                    memcpy(in_gpu, in, sizeof(gr_complex) * d_correlation_length_samples);
+                    cudaProfilerStart();
+                    multicorrelator_gpu->Carrier_wipeoff_multicorrelator_resampler_cuda(static_cast<float>(d_rem_carrier_phase_rad),
+                        static_cast<float>(d_carrier_phase_step_rad),
+                        static_cast<float>(d_code_phase_step_chips),
+                        static_cast<float>(d_rem_code_phase_chips),
+                        d_correlation_length_samples, d_n_correlator_taps);
+                    cudaProfilerStop();
+                }
             // std::cout<<"c_out[0]="<<d_correlator_outs[0]<<"c_out[1]="<<d_correlator_outs[1]<<"c_out[2]="<<d_correlator_outs[2]<< '\n';
 
             // UPDATE INTEGRATION TIME
@@ -442,7 +490,7 @@ int Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc::general_work(int noutput_items __attribut
                         {
                             std::cout << "Loss of lock in channel " << d_channel << "!\n";
                             LOG(INFO) << "Loss of lock in channel " << d_channel << "!";
-                            this->message_port_pub(pmt::mp("events"), pmt::from_long(3));  // 3 -> loss of lock
+                            this->message_port_pub(msg_ids::events_port(), msg_ids::telemetry_failure());  // 3 -> loss of lock
                             d_carrier_lock_fail_counter = 0;
                             d_enable_tracking = false;  // TODO: check if disabling tracking is consistent with the channel state machine
                             loss_of_lock = true;
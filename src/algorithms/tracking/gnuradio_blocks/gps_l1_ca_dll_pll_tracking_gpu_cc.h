@@ -22,6 +22,7 @@
 #ifndef GNSS_SDR_GPS_L1_CA_DLL_PLL_TRACKING_GPU_CC_H
 #define GNSS_SDR_GPS_L1_CA_DLL_PLL_TRACKING_GPU_CC_H
 
+#include "cuda_channel_pipeline.h"
 #include "cuda_multicorrelator.h"
 #include "gnss_block_interface.h"
 #include "gnss_synchro.h"
@@ -51,7 +52,8 @@ gps_l1_ca_dll_pll_make_tracking_gpu_cc(
     std::string dump_filename,
     float pll_bw_hz,
     float dll_bw_hz,
-    float early_late_space_chips);
+    float early_late_space_chips,
+    bool gpu_resident);
 
 
 /*!
@@ -80,7 +82,8 @@ private:
         std::string dump_filename,
         float pll_bw_hz,
         float dll_bw_hz,
-        float early_late_space_chips);
+        float early_late_space_chips,
+        bool gpu_resident);
 
     Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc(
         int64_t fs_in,
@@ -89,7 +92,8 @@ private:
         std::string dump_filename,
         float pll_bw_hz,
         float dll_bw_hz,
-        float early_late_space_chips);
+        float early_late_space_chips,
+        bool gpu_resident);
     void update_local_code();
     void update_local_carrier();
     void check_carrier_phase_coherent_initialization();
@@ -165,6 +169,8 @@ private:
     bool d_enable_tracking;
     bool d_pull_in;
     bool d_dump;
+    // samples stay in device memory, shared by all channels (Jetson mode)
+    bool d_gpu_resident;
 };
 
 
@@ -25,6 +25,7 @@
 
 #include "gps_l1_ca_kf_tracking_cc.h"
 #include "GPS_L1_CA.h"
+#include "gnss_message_ids.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_flags.h"
 #include "gps_sdr_signal_replica.h"
@@ -235,6 +236,11 @@ Gps_L1_Ca_Kf_Tracking_cc::Gps_L1_Ca_Kf_Tracking_cc(
             kf_x(2, 0) = 0.0;
         }
 
+    // Constant factors of the measurement update, precomputed so the per-epoch
+    // filter iteration does not rebuild them
+    kf_Ht = kf_H.t();
+    kf_iden = arma::eye(arma::size(kf_P_x_ini));
+
     // Bayesian covariance estimator initialization
     kf_iter = 0;
     bayes_run = bce_run;
@@ -705,18 +711,21 @@ int Gps_L1_Ca_Kf_Tracking_cc::general_work(int noutput_items __attribute__((unus
                 {
                     // TODO: Resolve segmentation fault
                     kf_P_y = bayes_estimator.get_Psi_est();
-                    kf_R_est = kf_P_y - kf_H * kf_P_x_pre * kf_H.t();
+                    kf_R_est = kf_P_y - kf_H * kf_P_x_pre * kf_Ht;
                 }
             else
                 {
-                    kf_P_y = kf_H * kf_P_x_pre * kf_H.t() + kf_R;  // innovation covariance matrix
+                    kf_P_y = kf_H * kf_P_x_pre * kf_Ht + kf_R;  // innovation covariance matrix
                     kf_R_est = kf_R;
                 }
 
             // Kalman filter update step
-            kf_K = (kf_P_x_pre * kf_H.t()) * arma::inv(kf_P_y);                 // Kalman gain
-            kf_x = kf_x_pre + kf_K * kf_y;                                      // updated state estimation
-            kf_P_x = (arma::eye(size(kf_P_x_pre)) - kf_K * kf_H) * kf_P_x_pre;  // update state estimation error covariance matrix
+            // The innovation is scalar, so the gain is a division instead of a
+            // matrix inversion
+            kf_K = (kf_P_x_pre * kf_Ht) / kf_P_y(0, 0);      // Kalman gain
+            kf_x = kf_x_pre + kf_K * kf_y;                   // updated state estimation
+            kf_P_x = (kf_iden - kf_K * kf_H) * kf_P_x_pre;   // update state estimation error covariance matrix
+            kf_P_x = 0.5 * (kf_P_x + kf_P_x.t());            // enforce symmetry to keep the covariance well conditioned
 
             // Store Kalman filter results
             d_rem_carr_phase_rad = kf_x(0);  // set a new carrier Phase estimation to the NCO
@@ -795,7 +804,7 @@ int Gps_L1_Ca_Kf_Tracking_cc::general_work(int noutput_items __attribute__((unus
                         {
                             std::cout << "Loss of lock in channel " << d_channel << "!\n";
                             LOG(INFO) << "Loss of lock in channel " << d_channel << "!";
-                            this->message_port_pub(pmt::mp("events"), pmt::from_long(3));  // 3 -> loss of lock
+                            this->message_port_pub(msg_ids::events_port(), msg_ids::telemetry_failure());  // 3 -> loss of lock
                             d_carrier_lock_fail_counter = 0;
                             d_enable_tracking = false;
                             loss_of_lock = true;
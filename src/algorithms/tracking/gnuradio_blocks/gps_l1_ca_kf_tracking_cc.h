@@ -146,6 +146,8 @@ private:
     arma::colvec kf_x_pre;  // predicted state vector
     arma::colvec kf_y;      // measurement vector
     arma::mat kf_K;         // Kalman gain matrix
+    arma::mat kf_Ht;        // transposed system matrix (constant, precomputed)
+    arma::mat kf_iden;      // identity matrix sized as the state covariance
 
     // Bayesian estimator
     Bayesian_estimator bayes_estimator;
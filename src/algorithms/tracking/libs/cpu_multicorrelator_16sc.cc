@@ -19,6 +19,7 @@
  */
 
 #include "cpu_multicorrelator_16sc.h"
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
 #include <cmath>
 
 
@@ -27,14 +28,16 @@ bool Cpu_Multicorrelator_16sc::init(
     int n_correlators)
 {
     // ALLOCATE MEMORY FOR INTERNAL vectors
+    // These buffers are torn down and rebuilt on every channel restart, so
+    // they go through the block pool instead of straight to volk_gnsssdr_malloc
     size_t size = max_signal_length_samples * sizeof(lv_16sc_t);
 
     d_n_correlators = n_correlators;
 
-    d_local_codes_resampled = static_cast<lv_16sc_t**>(volk_gnsssdr_malloc(n_correlators * sizeof(lv_16sc_t*), volk_gnsssdr_get_alignment()));
+    d_local_codes_resampled = static_cast<lv_16sc_t**>(volk_gnsssdr::pool_malloc(n_correlators * sizeof(lv_16sc_t*)));
     for (int n = 0; n < n_correlators; n++)
         {
-            d_local_codes_resampled[n] = static_cast<lv_16sc_t*>(volk_gnsssdr_malloc(size, volk_gnsssdr_get_alignment()));
+            d_local_codes_resampled[n] = static_cast<lv_16sc_t*>(volk_gnsssdr::pool_malloc(size));
         }
     return true;
 }
@@ -119,9 +122,9 @@ bool Cpu_Multicorrelator_16sc::free()
         {
             for (int n = 0; n < d_n_correlators; n++)
                 {
-                    volk_gnsssdr_free(d_local_codes_resampled[n]);
+                    volk_gnsssdr::pool_free(d_local_codes_resampled[n]);
                 }
-            volk_gnsssdr_free(d_local_codes_resampled);
+            volk_gnsssdr::pool_free(d_local_codes_resampled);
             d_local_codes_resampled = nullptr;
         }
     return true;
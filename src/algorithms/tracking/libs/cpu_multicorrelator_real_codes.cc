@@ -20,8 +20,14 @@
  */
 
 #include "cpu_multicorrelator_real_codes.h"
+#include <glog/logging.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
 #include <cmath>
+#if ENABLE_SYCL
+#include "sycl_multicorrelator_real_codes.h"
+#include <exception>
+#endif
 
 Cpu_Multicorrelator_Real_Codes::Cpu_Multicorrelator_Real_Codes()
 {
@@ -30,9 +36,16 @@ Cpu_Multicorrelator_Real_Codes::Cpu_Multicorrelator_Real_Codes()
     d_shifts_chips = nullptr;
     d_corr_out = nullptr;
     d_local_codes_resampled = nullptr;
+    d_local_codes_buffer = nullptr;
     d_code_length_chips = 0;
     d_n_correlators = 0;
     d_use_high_dynamics_resampler = true;
+    d_resampler_epsilon_chips = 0.0;
+    d_last_rem_code_phase_chips = 0.0;
+    d_last_code_phase_step_chips = 0.0;
+    d_last_code_phase_rate_step_chips = 0.0;
+    d_last_correlator_length_samples = 0;
+    d_local_codes_valid = false;
 }
 
 
@@ -45,17 +58,60 @@ Cpu_Multicorrelator_Real_Codes::~Cpu_Multicorrelator_Real_Codes()
 }
 
 
+void Cpu_Multicorrelator_Real_Codes::set_accelerator(const std::string& accelerator)
+{
+    if (accelerator.empty() or accelerator == "cpu")
+        {
+            d_sycl.reset();
+            return;
+        }
+    if (accelerator == "sycl")
+        {
+#if ENABLE_SYCL
+            try
+                {
+                    d_sycl = std::make_shared<Sycl_Multicorrelator_Real_Codes>();
+                    LOG(INFO) << "Multicorrelator running on SYCL device: " << d_sycl->device_name();
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "SYCL accelerator requested but unavailable (" << e.what() << "), falling back to CPU correlator";
+                    d_sycl.reset();
+                }
+#else
+            LOG(WARNING) << "SYCL accelerator requested but this build was configured without ENABLE_SYCL, falling back to CPU correlator";
+#endif
+            return;
+        }
+    LOG(WARNING) << "Unknown accelerator '" << accelerator << "', falling back to CPU correlator";
+}
+
+
 bool Cpu_Multicorrelator_Real_Codes::init(
     int max_signal_length_samples,
     int n_correlators)
 {
+#if ENABLE_SYCL
+    if (d_sycl)
+        {
+            return d_sycl->init(max_signal_length_samples, n_correlators);
+        }
+#endif
     // ALLOCATE MEMORY FOR INTERNAL vectors
-    size_t size = max_signal_length_samples * sizeof(float);
+    // All the resampled replicas live in a single tiled allocation, with each
+    // row padded to the VOLK alignment. Keeping the E/P/L rows adjacent lets
+    // the correlation hot loop walk one contiguous region instead of
+    // n_correlators scattered heap blocks.
+    const size_t alignment = volk_gnsssdr_get_alignment();
+    const size_t row_size = ((max_signal_length_samples * sizeof(float) + alignment - 1) / alignment) * alignment;
 
-    d_local_codes_resampled = static_cast<float**>(volk_gnsssdr_malloc(n_correlators * sizeof(float*), volk_gnsssdr_get_alignment()));
+    // Both allocations are torn down and rebuilt on every channel restart, so
+    // they go through the block pool instead of straight to volk_gnsssdr_malloc
+    d_local_codes_resampled = static_cast<float**>(volk_gnsssdr::pool_malloc(n_correlators * sizeof(float*)));
+    d_local_codes_buffer = static_cast<float*>(volk_gnsssdr::pool_malloc(n_correlators * row_size));
     for (int n = 0; n < n_correlators; n++)
         {
-            d_local_codes_resampled[n] = static_cast<float*>(volk_gnsssdr_malloc(size, volk_gnsssdr_get_alignment()));
+            d_local_codes_resampled[n] = d_local_codes_buffer + n * (row_size / sizeof(float));
         }
     d_n_correlators = n_correlators;
     return true;
@@ -67,9 +123,16 @@ bool Cpu_Multicorrelator_Real_Codes::set_local_code_and_taps(
     const float* local_code_in,
     float* shifts_chips)
 {
+#if ENABLE_SYCL
+    if (d_sycl)
+        {
+            return d_sycl->set_local_code_and_taps(code_length_chips, local_code_in, shifts_chips);
+        }
+#endif
     d_local_code_in = local_code_in;
     d_shifts_chips = shifts_chips;
     d_code_length_chips = code_length_chips;
+    d_local_codes_valid = false;
 
     return true;
 }
@@ -77,6 +140,12 @@ bool Cpu_Multicorrelator_Real_Codes::set_local_code_and_taps(
 
 bool Cpu_Multicorrelator_Real_Codes::set_input_output_vectors(std::complex<float>* corr_out, const std::complex<float>* sig_in)
 {
+#if ENABLE_SYCL
+    if (d_sycl)
+        {
+            return d_sycl->set_input_output_vectors(corr_out, sig_in);
+        }
+#endif
     // Save CPU pointers
     d_sig_in = sig_in;
     d_corr_out = corr_out;
@@ -86,6 +155,27 @@ bool Cpu_Multicorrelator_Real_Codes::set_input_output_vectors(std::complex<float
 
 void Cpu_Multicorrelator_Real_Codes::update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips)
 {
+    if (d_resampler_epsilon_chips > 0.0)
+        {
+            // Lazy mode: reuse the cached replicas if the worst-case code phase
+            // deviation over the whole integration stays below the epsilon
+            if (d_local_codes_valid && (correlator_length_samples == d_last_correlator_length_samples))
+                {
+                    const auto num_samples = static_cast<float>(correlator_length_samples);
+                    const float max_deviation_chips = std::fabs(rem_code_phase_chips - d_last_rem_code_phase_chips) +
+                                                      std::fabs(code_phase_step_chips - d_last_code_phase_step_chips) * num_samples +
+                                                      std::fabs(code_phase_rate_step_chips - d_last_code_phase_rate_step_chips) * num_samples * num_samples;
+                    if (max_deviation_chips < d_resampler_epsilon_chips)
+                        {
+                            return;
+                        }
+                }
+            d_last_rem_code_phase_chips = rem_code_phase_chips;
+            d_last_code_phase_step_chips = code_phase_step_chips;
+            d_last_code_phase_rate_step_chips = code_phase_rate_step_chips;
+            d_last_correlator_length_samples = correlator_length_samples;
+            d_local_codes_valid = true;
+        }
     if (d_use_high_dynamics_resampler)
         {
             volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn(d_local_codes_resampled,
@@ -121,6 +211,12 @@ bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
     float code_phase_rate_step_chips,
     int signal_length_samples)
 {
+#if ENABLE_SYCL
+    if (d_sycl)
+        {
+            return d_sycl->Carrier_wipeoff_multicorrelator_resampler(rem_carrier_phase_in_rad, phase_step_rad, phase_rate_step_rad, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips, signal_length_samples);
+        }
+#endif
     update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips);
     // Regenerate phase at each call in order to avoid numerical issues
     lv_32fc_t phase_offset_as_complex[1];
@@ -146,11 +242,26 @@ bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
     float code_phase_rate_step_chips,
     int signal_length_samples)
 {
-    update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips);
+#if ENABLE_SYCL
+    if (d_sycl)
+        {
+            return d_sycl->Carrier_wipeoff_multicorrelator_resampler(rem_carrier_phase_in_rad, phase_step_rad, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips, signal_length_samples);
+        }
+#endif
     // Regenerate phase at each call in order to avoid numerical issues
     lv_32fc_t phase_offset_as_complex[1];
     phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
     // call VOLK_GNSSSDR kernel
+    if (!d_use_high_dynamics_resampler && d_resampler_epsilon_chips <= 0.0)
+        {
+            // Fused path: the resampled code values are generated on the fly
+            // inside the correlation loop, so the intermediate replicas never
+            // touch memory. Not used in lazy mode, which amortizes the
+            // resampling cost across epochs by caching the replicas instead.
+            volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, d_local_code_in, rem_code_phase_chips, code_phase_step_chips, d_shifts_chips, static_cast<unsigned int>(d_code_length_chips), d_n_correlators, signal_length_samples);
+            return true;
+        }
+    update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips);
     volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
     return true;
 }
@@ -158,14 +269,18 @@ bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
 
 bool Cpu_Multicorrelator_Real_Codes::free()
 {
+#if ENABLE_SYCL
+    if (d_sycl)
+        {
+            return d_sycl->free();
+        }
+#endif
     // Free memory
     if (d_local_codes_resampled != nullptr)
         {
-            for (int n = 0; n < d_n_correlators; n++)
-                {
-                    volk_gnsssdr_free(d_local_codes_resampled[n]);
-                }
-            volk_gnsssdr_free(d_local_codes_resampled);
+            volk_gnsssdr::pool_free(d_local_codes_buffer);
+            volk_gnsssdr::pool_free(d_local_codes_resampled);
+            d_local_codes_buffer = nullptr;
             d_local_codes_resampled = nullptr;
         }
     return true;
@@ -175,5 +290,18 @@ bool Cpu_Multicorrelator_Real_Codes::free()
 void Cpu_Multicorrelator_Real_Codes::set_high_dynamics_resampler(
     bool use_high_dynamics_resampler)
 {
+#if ENABLE_SYCL
+    if (d_sycl)
+        {
+            d_sycl->set_high_dynamics_resampler(use_high_dynamics_resampler);
+        }
+#endif
     d_use_high_dynamics_resampler = use_high_dynamics_resampler;
 }
+
+
+void Cpu_Multicorrelator_Real_Codes::set_resampler_epsilon(float epsilon_chips)
+{
+    d_resampler_epsilon_chips = epsilon_chips;
+    d_local_codes_valid = false;
+}
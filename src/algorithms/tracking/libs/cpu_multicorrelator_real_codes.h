@@ -24,12 +24,15 @@
 
 
 #include <complex>
+#include <memory>
+#include <string>
 
 /** \addtogroup Tracking
  * \{ */
 /** \addtogroup Tracking_libs
  * \{ */
 
+class Sycl_Multicorrelator_Real_Codes;
 
 /*!
  * \brief Class that implements carrier wipe-off and correlators.
@@ -39,6 +42,13 @@ class Cpu_Multicorrelator_Real_Codes
 public:
     Cpu_Multicorrelator_Real_Codes();
     void set_high_dynamics_resampler(bool use_high_dynamics_resampler);
+    void set_resampler_epsilon(float epsilon_chips);
+    /*!
+     * Selects the compute backend ("cpu" or "sycl"). Must be called before
+     * init(). Falls back to the CPU path with a warning if the requested
+     * accelerator is not compiled in or no device is available.
+     */
+    void set_accelerator(const std::string &accelerator);
     ~Cpu_Multicorrelator_Real_Codes();
     bool init(int max_signal_length_samples, int n_correlators);
     bool set_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
@@ -49,15 +59,26 @@ public:
     bool free();
 
 private:
+    // Optional accelerator backend; when set, the public methods delegate to
+    // it and the CPU buffers stay unused. shared_ptr keeps the type opaque
+    // here so that including files never see the SYCL headers.
+    std::shared_ptr<Sycl_Multicorrelator_Real_Codes> d_sycl;
     // Allocate the device input vectors
     const std::complex<float> *d_sig_in;
     const float *d_local_code_in;
     std::complex<float> *d_corr_out;
     float **d_local_codes_resampled;
+    float *d_local_codes_buffer;
     float *d_shifts_chips;
+    float d_resampler_epsilon_chips;
+    float d_last_rem_code_phase_chips;
+    float d_last_code_phase_step_chips;
+    float d_last_code_phase_rate_step_chips;
+    int d_last_correlator_length_samples;
     int d_code_length_chips;
     int d_n_correlators;
     bool d_use_high_dynamics_resampler;
+    bool d_local_codes_valid;
 };
 
 
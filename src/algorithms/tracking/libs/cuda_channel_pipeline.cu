@@ -0,0 +1,183 @@
+/*!
+ * \file cuda_channel_pipeline.cu
+ * \brief Shared device-resident sample window for GPU tracking channels
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "cuda_channel_pipeline.h"
+#include <stdio.h>
+#include <cuda_runtime.h>
+
+
+cuda_channel_pipeline& cuda_channel_pipeline::get_instance()
+{
+    static cuda_channel_pipeline instance;
+    return instance;
+}
+
+
+bool cuda_channel_pipeline::init(int max_window_samples)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (max_window_samples > d_slot_capacity)
+        {
+            if (d_num_users > 0)
+                {
+                    // growing the slots would invalidate windows leased by the
+                    // channels already registered; all channels of a receiver
+                    // share the sampling frequency, so this should not happen
+                    printf("cuda_channel_pipeline: window of %i samples exceeds the configured slot capacity\n", max_window_samples);
+                    return false;
+                }
+            for (int i = 0; i < NUM_SLOTS; i++)
+                {
+                    if (d_slots[i].dev_ptr != nullptr)
+                        {
+                            cudaFree(d_slots[i].dev_ptr);
+                            cudaEventDestroy(d_slots[i].ready);
+                            d_slots[i] = window_slot();
+                        }
+                    if (cudaMalloc(reinterpret_cast<void**>(&d_slots[i].dev_ptr), max_window_samples * sizeof(GPU_Complex)) != cudaSuccess)
+                        {
+                            printf("cuda_channel_pipeline: cudaMalloc error allocating the shared signal windows\n");
+                            d_slots[i].dev_ptr = nullptr;
+                            return false;
+                        }
+                    cudaEventCreateWithFlags(&d_slots[i].ready, cudaEventDisableTiming);
+                }
+            d_slot_capacity = max_window_samples;
+        }
+    if (d_upload_stream == nullptr)
+        {
+            if (cudaStreamCreate(&d_upload_stream) != cudaSuccess)
+                {
+                    printf("cuda_channel_pipeline: cudaStreamCreate error\n");
+                    return false;
+                }
+        }
+    d_num_users++;
+    return true;
+}
+
+
+void cuda_channel_pipeline::release()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_num_users--;
+    if (d_num_users > 0)
+        {
+            return;
+        }
+    for (int i = 0; i < NUM_SLOTS; i++)
+        {
+            if (d_slots[i].dev_ptr != nullptr)
+                {
+                    cudaFree(d_slots[i].dev_ptr);
+                    cudaEventDestroy(d_slots[i].ready);
+                    d_slots[i] = window_slot();
+                }
+        }
+    if (d_upload_stream != nullptr)
+        {
+            cudaStreamDestroy(d_upload_stream);
+            d_upload_stream = nullptr;
+        }
+    d_slot_capacity = 0;
+}
+
+
+bool cuda_channel_pipeline::acquire_window(const std::complex<float>* sig_in,
+    uint64_t first_sample,
+    int num_samples,
+    int available_samples,
+    cudaStream_t consumer_stream,
+    cuda_signal_window& window)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_slot_capacity == 0 or num_samples > d_slot_capacity)
+        {
+            return false;
+        }
+    d_use_counter++;
+
+    // cache lookup: any slot whose window contains the requested range
+    for (int i = 0; i < NUM_SLOTS; i++)
+        {
+            window_slot& slot = d_slots[i];
+            if (slot.num_samples > 0 and
+                first_sample >= slot.first_sample and
+                first_sample + static_cast<uint64_t>(num_samples) <= slot.first_sample + static_cast<uint64_t>(slot.num_samples))
+                {
+                    cudaStreamWaitEvent(consumer_stream, slot.ready, 0);
+                    slot.last_use = d_use_counter;
+                    slot.users++;
+                    d_hits++;
+                    window.dev_ptr = slot.dev_ptr + (first_sample - slot.first_sample);
+                    window.slot = i;
+                    return true;
+                }
+        }
+
+    // miss: recycle the least recently used slot that nobody is reading
+    int victim = -1;
+    for (int i = 0; i < NUM_SLOTS; i++)
+        {
+            if (d_slots[i].users == 0 and (victim < 0 or d_slots[i].last_use < d_slots[victim].last_use))
+                {
+                    victim = i;
+                }
+        }
+    if (victim < 0)
+        {
+            return false;
+        }
+
+    window_slot& slot = d_slots[victim];
+    int upload_samples = available_samples;
+    if (upload_samples > d_slot_capacity)
+        {
+            upload_samples = d_slot_capacity;
+        }
+    if (upload_samples < num_samples)
+        {
+            upload_samples = num_samples;
+        }
+    if (cudaMemcpyAsync(slot.dev_ptr, sig_in, upload_samples * sizeof(GPU_Complex),
+            cudaMemcpyHostToDevice, d_upload_stream) != cudaSuccess)
+        {
+            printf("cuda_channel_pipeline: cudaMemcpyAsync error uploading the signal window\n");
+            slot.num_samples = 0;
+            return false;
+        }
+    cudaEventRecord(slot.ready, d_upload_stream);
+    cudaStreamWaitEvent(consumer_stream, slot.ready, 0);
+    slot.first_sample = first_sample;
+    slot.num_samples = upload_samples;
+    slot.last_use = d_use_counter;
+    slot.users = 1;
+    d_misses++;
+
+    window.dev_ptr = slot.dev_ptr;
+    window.slot = victim;
+    return true;
+}
+
+
+void cuda_channel_pipeline::release_window(const cuda_signal_window& window)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (window.slot >= 0 and window.slot < NUM_SLOTS and d_slots[window.slot].users > 0)
+        {
+            d_slots[window.slot].users--;
+        }
+}
@@ -0,0 +1,115 @@
+/*!
+ * \file cuda_channel_pipeline.h
+ * \brief Shared device-resident sample window for GPU tracking channels
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * Process-wide cache of input signal windows kept in device memory, so that
+ * samples are copied host->device once per epoch instead of once per channel.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CUDA_CHANNEL_PIPELINE_H
+#define GNSS_SDR_CUDA_CHANNEL_PIPELINE_H
+
+#include "cuda_multicorrelator.h"
+#include <complex>
+#include <cstdint>
+#include <mutex>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+//! Handle to a device-resident signal window leased from the pipeline.
+//! The device pointer is valid until release_window() is called on it.
+struct cuda_signal_window
+{
+    const GPU_Complex* dev_ptr;
+    int slot;
+};
+
+/*!
+ * \brief Device-resident input window shared by all GPU tracking channels.
+ *
+ * Every tracking channel correlates against (almost) the same stretch of the
+ * input stream, shifted by less than one PRN period. This class uploads the
+ * window once per epoch and hands out device pointers into it, keyed by the
+ * absolute sample counter: the first channel that reaches a new epoch pays
+ * the single DMA transfer and the remaining channels hit the cache. Only the
+ * per-epoch correlator outputs (a few complex scalars per channel) travel
+ * back to the host for the loop filters.
+ */
+class cuda_channel_pipeline
+{
+public:
+    static cuda_channel_pipeline& get_instance();
+
+    //! Registers a channel. Allocates (or grows) the device window slots so
+    //! that windows of up to max_window_samples fit. Returns false if the
+    //! device memory could not be allocated; callers must then fall back to
+    //! their private host-mapped buffers
+    bool init(int max_window_samples);
+
+    //! Unregisters a channel. Device memory is freed with the last user
+    void release();
+
+    //! Leases a device pointer to samples [first_sample, first_sample +
+    //! num_samples). On a cache miss the window is uploaded from sig_in,
+    //! extended to available_samples so that channels with nearby sample
+    //! counters can reuse it. The upload is ordered before any work
+    //! subsequently queued on consumer_stream. Returns false when no slot
+    //! can be recycled (all leased) or on a CUDA error
+    bool acquire_window(const std::complex<float>* sig_in,
+        uint64_t first_sample,
+        int num_samples,
+        int available_samples,
+        cudaStream_t consumer_stream,
+        cuda_signal_window& window);
+
+    //! Returns a leased window to the pipeline, making its slot evictable
+    void release_window(const cuda_signal_window& window);
+
+private:
+    cuda_channel_pipeline() = default;
+    ~cuda_channel_pipeline() = default;
+
+    // four slots cover one epoch of skew between the fastest and the slowest
+    // channel with room to spare: a slot completes all its reads (the
+    // correlate calls are synchronous) long before it cycles back for reuse
+    static const int NUM_SLOTS = 4;
+
+    struct window_slot
+    {
+        GPU_Complex* dev_ptr = nullptr;
+        cudaEvent_t ready = nullptr;
+        uint64_t first_sample = 0;
+        int num_samples = 0;
+        uint64_t last_use = 0;
+        int users = 0;
+    };
+
+    window_slot d_slots[NUM_SLOTS];
+    std::mutex d_mutex;
+    cudaStream_t d_upload_stream = nullptr;
+    uint64_t d_use_counter = 0;
+    uint64_t d_hits = 0;
+    uint64_t d_misses = 0;
+    int d_slot_capacity = 0;
+    int d_num_users = 0;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CUDA_CHANNEL_PIPELINE_H
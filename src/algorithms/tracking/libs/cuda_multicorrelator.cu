@@ -29,24 +29,14 @@
 
 #define ACCUM_N 128
 
-__global__ void Doppler_wippe_scalarProdGPUCPXxN_shifts_chips(
-    GPU_Complex *d_corr_out,
+__global__ void Doppler_wipeoff_GPUCPXxN(
     GPU_Complex *d_sig_in,
     GPU_Complex *d_sig_wiped,
-    GPU_Complex *d_local_code_in,
-    float *d_shifts_chips,
-    int code_length_chips,
-    float code_phase_step_chips,
-    float rem_code_phase_chips,
-    int vectorN,
     int elementN,
     float rem_carrier_phase_in_rad,
     float phase_step_rad)
 {
-    //Accumulators cache
-    __shared__ GPU_Complex accumResult[ACCUM_N];
-
-    // CUDA version of floating point NCO and vector dot product integrated
+    // CUDA version of the floating point NCO and carrier wipe-off
     float sin;
     float cos;
     for (int i = blockIdx.x * blockDim.x + threadIdx.x;
@@ -56,8 +46,23 @@ __global__ void Doppler_wippe_scalarProdGPUCPXxN_shifts_chips(
             __sincosf(rem_carrier_phase_in_rad + i * phase_step_rad, &sin, &cos);
             d_sig_wiped[i] = d_sig_in[i] * GPU_Complex(cos, -sin);
         }
+}
+
+
+__global__ void scalarProdGPUCPXxN_shifts_chips(
+    GPU_Complex *d_corr_out,
+    GPU_Complex *d_sig_wiped,
+    GPU_Complex *d_local_code_in,
+    float *d_shifts_chips,
+    int code_length_chips,
+    float code_phase_step_chips,
+    float rem_code_phase_chips,
+    int vectorN,
+    int elementN)
+{
+    //Accumulators cache
+    __shared__ GPU_Complex accumResult[ACCUM_N];
 
-    __syncthreads();
     ////////////////////////////////////////////////////////////////////////////
     // Cycle through every pair of vectors,
     // taking into account that vector counts can be different
@@ -123,6 +128,73 @@ __global__ void Doppler_wippe_scalarProdGPUCPXxN_shifts_chips(
 }
 
 
+__global__ void wipeoff_scalarProdGPUCPXxN_shifts_chips(
+    GPU_Complex *d_corr_out,
+    const GPU_Complex *d_sig_in,
+    GPU_Complex *d_local_code_in,
+    float *d_shifts_chips,
+    int code_length_chips,
+    float code_phase_step_chips,
+    float rem_code_phase_chips,
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    int vectorN,
+    int elementN)
+{
+    // Fused carrier wipe-off + multitap correlator for device-resident input.
+    // The NCO is recomputed for every tap reading a sample, which trades a few
+    // extra FMAs per sample for removing the global-memory round trip of the
+    // Doppler-free vector: a net win on bandwidth-limited integrated devices
+    // (Jetson), where arithmetic is cheap and DRAM traffic is shared with the
+    // CPU. It also reads the shared signal window without modifying it, so
+    // several channels can correlate against the same window concurrently.
+
+    //Accumulators cache
+    __shared__ GPU_Complex accumResult[ACCUM_N];
+
+    float sin;
+    float cos;
+
+    for (int vec = blockIdx.x; vec < vectorN; vec += gridDim.x)
+        {
+            for (int iAccum = threadIdx.x; iAccum < ACCUM_N; iAccum += blockDim.x)
+                {
+                    GPU_Complex sum = GPU_Complex(0, 0);
+                    float local_code_chip_index = 0.0;
+                    for (int pos = iAccum; pos < elementN; pos += ACCUM_N)
+                        {
+                            // 1.carrier wipe-off (NCO computed on-the-fly)
+                            __sincosf(rem_carrier_phase_in_rad + pos * phase_step_rad, &sin, &cos);
+                            GPU_Complex sig_wiped = d_sig_in[pos] * GPU_Complex(cos, -sin);
+
+                            // 2.resample local code for the current shift
+                            local_code_chip_index = fmodf(code_phase_step_chips * __int2float_rd(pos) + d_shifts_chips[vec] - rem_code_phase_chips, code_length_chips);
+                            if (local_code_chip_index < 0.0) local_code_chip_index += (code_length_chips - 1);
+
+                            // 3.correlate
+                            sum.multiply_acc(sig_wiped, d_local_code_in[__float2int_rd(local_code_chip_index)]);
+                        }
+                    accumResult[iAccum] = sum;
+                }
+
+            for (int stride = ACCUM_N / 2; stride > 0; stride >>= 1)
+                {
+                    __syncthreads();
+
+                    for (int iAccum = threadIdx.x; iAccum < stride; iAccum += blockDim.x)
+                        {
+                            accumResult[iAccum] += accumResult[stride + iAccum];
+                        }
+                }
+
+            if (threadIdx.x == 0)
+                {
+                    d_corr_out[vec] = accumResult[0];
+                }
+        }
+}
+
+
 bool cuda_multicorrelator::init_cuda_integrated_resampler(
     int signal_length_samples,
     int code_length_chips,
@@ -301,7 +373,7 @@ inline void gpuAssert(cudaError_t code, const char *file, int line, bool abort =
 }
 
 
-bool cuda_multicorrelator::Carrier_wipeoff_multicorrelator_resampler_cuda(
+bool cuda_multicorrelator::Carrier_wipeoff_multicorrelator_resampler_cuda_async(
     float rem_carrier_phase_in_rad,
     float phase_step_rad,
     float code_phase_step_chips,
@@ -310,18 +382,23 @@ bool cuda_multicorrelator::Carrier_wipeoff_multicorrelator_resampler_cuda(
     int n_correlators)
 {
     cudaSetDevice(selected_gps_device);
-    // cudaMemCpy version
-    //size_t memSize = signal_length_samples * sizeof(std::complex<float>);
-    // input signal CPU -> GPU copy memory
-    //cudaMemcpyAsync(d_sig_in, d_sig_in_cpu, memSize,
-    //                               cudaMemcpyHostToDevice, stream2);
     //***** NOTICE: NCO is computed on-the-fly, not need to copy NCO into GPU! ****
 
-    //launch the multitap correlator with integrated local code resampler!
+    // The carrier wipe-off runs as a separate kernel: the correlator reads the
+    // whole Doppler-free vector, so the wipe-off must be complete grid-wide
+    // before the correlation starts (a __syncthreads() only orders one block).
+    // Both kernels are queued on this instance's stream, so the split does not
+    // add a host synchronization and channels on different streams overlap.
+    Doppler_wipeoff_GPUCPXxN<<<blocksPerGrid, threadsPerBlock, 0, stream1>>>(
+        d_sig_in,
+        d_sig_doppler_wiped,
+        signal_length_samples,
+        rem_carrier_phase_in_rad,
+        phase_step_rad);
 
-    Doppler_wippe_scalarProdGPUCPXxN_shifts_chips<<<blocksPerGrid, threadsPerBlock, 0, stream1>>>(
+    //launch the multitap correlator with integrated local code resampler!
+    scalarProdGPUCPXxN_shifts_chips<<<blocksPerGrid, threadsPerBlock, 0, stream1>>>(
         d_corr_out,
-        d_sig_in,
         d_sig_doppler_wiped,
         d_local_codes_in,
         d_shifts_chips,
@@ -329,23 +406,70 @@ bool cuda_multicorrelator::Carrier_wipeoff_multicorrelator_resampler_cuda(
         code_phase_step_chips,
         rem_code_phase_chips,
         n_correlators,
-        signal_length_samples,
-        rem_carrier_phase_in_rad,
-        phase_step_rad);
+        signal_length_samples);
 
     gpuErrchk(cudaPeekAtLastError());
-    gpuErrchk(cudaStreamSynchronize(stream1));
+    return true;
+}
 
-    // cudaMemCpy version
-    // Copy the device result vector in device memory to the host result vector
-    // in host memory.
-    //scalar products (correlators outputs)
-    //cudaMemcpyAsync(d_corr_out_cpu, d_corr_out, sizeof(std::complex<float>)*n_correlators,
-    //        cudaMemcpyDeviceToHost,stream1);
+
+bool cuda_multicorrelator::wait_results()
+{
+    cudaSetDevice(selected_gps_device);
+    gpuErrchk(cudaStreamSynchronize(stream1));
     return true;
 }
 
 
+bool cuda_multicorrelator::Carrier_wipeoff_multicorrelator_resampler_device_cuda(
+    const GPU_Complex *dev_sig_in,
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float code_phase_step_chips,
+    float rem_code_phase_chips,
+    int signal_length_samples,
+    int n_correlators)
+{
+    cudaSetDevice(selected_gps_device);
+    // single fused kernel: the input already lives in device memory, so no
+    // host->device copy and no intermediate Doppler-free vector are needed
+    wipeoff_scalarProdGPUCPXxN_shifts_chips<<<blocksPerGrid, threadsPerBlock, 0, stream1>>>(
+        d_corr_out,
+        dev_sig_in,
+        d_local_codes_in,
+        d_shifts_chips,
+        d_code_length_chips,
+        code_phase_step_chips,
+        rem_code_phase_chips,
+        rem_carrier_phase_in_rad,
+        phase_step_rad,
+        n_correlators,
+        signal_length_samples);
+
+    gpuErrchk(cudaPeekAtLastError());
+    return wait_results();
+}
+
+
+bool cuda_multicorrelator::Carrier_wipeoff_multicorrelator_resampler_cuda(
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float code_phase_step_chips,
+    float rem_code_phase_chips,
+    int signal_length_samples,
+    int n_correlators)
+{
+    Carrier_wipeoff_multicorrelator_resampler_cuda_async(
+        rem_carrier_phase_in_rad,
+        phase_step_rad,
+        code_phase_step_chips,
+        rem_code_phase_chips,
+        signal_length_samples,
+        n_correlators);
+    return wait_results();
+}
+
+
 cuda_multicorrelator::cuda_multicorrelator()
 {
     d_sig_in = NULL;
@@ -371,12 +495,9 @@ bool cuda_multicorrelator::free_cuda()
     if (d_corr_out != NULL) cudaFree(d_corr_out);
     if (d_shifts_samples != NULL) cudaFree(d_shifts_samples);
     if (d_shifts_chips != NULL) cudaFree(d_shifts_chips);
-    // Reset the device and exit
-    // cudaDeviceReset causes the driver to clean up all state. While
-    // not mandatory in normal operation, it is good practice.  It is also
-    // needed to ensure correct operation when the application is being
-    // profiled. Calling cudaDeviceReset causes all profile data to be
-    // flushed before the application exits
-    cudaDeviceReset();
+    cudaStreamDestroy(stream1);
+    // NOTE: do not call cudaDeviceReset() here: it tears down the CUDA context
+    // of the whole process, killing the correlators of every other channel
+    // that shares the device
     return true;
 }
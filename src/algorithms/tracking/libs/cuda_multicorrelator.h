@@ -134,6 +134,37 @@ public:
         int signal_length_samples,
         int n_correlators);
 
+    //! Launches the correlation epoch on this instance's stream without blocking,
+    //! so several channels can queue their epochs before any of them synchronizes
+    bool Carrier_wipeoff_multicorrelator_resampler_cuda_async(
+        float rem_carrier_phase_in_rad,
+        float phase_step_rad,
+        float code_phase_step_chips,
+        float rem_code_phase_chips,
+        int signal_length_samples,
+        int n_correlators);
+
+    //! Blocks until the epoch launched with the _async method has finished
+    bool wait_results();
+
+    //! Device-resident variant: correlates against a signal window that
+    //! already lives in device memory (see cuda_channel_pipeline), fusing the
+    //! carrier wipe-off into the correlation kernel so no intermediate
+    //! Doppler-free vector is written. Only the correlator outputs travel
+    //! back to the host
+    bool Carrier_wipeoff_multicorrelator_resampler_device_cuda(
+        const GPU_Complex* dev_sig_in,
+        float rem_carrier_phase_in_rad,
+        float phase_step_rad,
+        float code_phase_step_chips,
+        float rem_code_phase_chips,
+        int signal_length_samples,
+        int n_correlators);
+
+    //! Stream where this instance queues its kernels, so that shared-window
+    //! uploads can be ordered before them
+    cudaStream_t get_stream() const { return stream1; }
+
 private:
     cudaStream_t stream1;
     // cudaStream_t stream2;
@@ -30,7 +30,13 @@ Dll_Pll_Conf::Dll_Pll_Conf()
     vector_length = 0U;
     dump = false;
     dump_mat = true;
+    dump_columnar = false;
+    dump_rows_per_file = 0;
     dump_filename = std::string("./dll_pll_dump.dat");
+    enable_work_monitor = false;
+    work_monitor_addresses = std::string("127.0.0.1");
+    work_monitor_port = 1237;
+    work_monitor_interval_calls = 1000;
     enable_fll_pull_in = false;
     enable_fll_steady_state = false;
     pull_in_time_s = 10;
@@ -51,10 +57,23 @@ Dll_Pll_Conf::Dll_Pll_Conf()
     very_early_late_space_narrow_chips = 0.5;
     slope = 1.0;
     spc = 0.5;
+    resampler_epsilon_chips = 0.0;
     y_intercept = 1.0;
+    enable_multipath_estimator = false;
+    multipath_budget_per_epoch = 32;
+    multipath_smoother_alpha = 0.02;
+    enable_scintillation_monitor = false;
+    scint_address = std::string("127.0.0.1");
+    scint_port = 1265;
+    scint_window_s = 60.0;
     carrier_aiding = true;
+    share_multiband_nco = false;
     extend_correlation_symbols = 1;
+    auto_extend_correlation = false;
+    auto_extend_cn0_low = 32.0;
+    auto_extend_cn0_high = 38.0;
     cn0_samples = FLAGS_cn0_samples;
+    cn0_decimation = 1;
     cn0_smoother_samples = 200;
     cn0_smoother_alpha = 0.002;
     carrier_lock_test_smoother_alpha = 0.002;
@@ -65,11 +84,14 @@ Dll_Pll_Conf::Dll_Pll_Conf()
     carrier_lock_th = FLAGS_carrier_lock_th;
     track_pilot = true;
     enable_doppler_correction = false;
+    enable_coasting = false;
+    coasting_time_s = 5;
     system = 'G';
     signal[0] = '1';
     signal[1] = 'C';
     signal[2] = '\0';
     item_type = "gr_complex";
+    accelerator = "cpu";
 }
 
 
@@ -86,9 +108,22 @@ void Dll_Pll_Conf::SetFromConfiguration(const ConfigurationInterface *configurat
     double fs_in_deprecated = configuration->property("GNSS-SDR.internal_fs_hz", fs_in);
     fs_in = configuration->property("GNSS-SDR.internal_fs_sps", fs_in_deprecated);
     high_dyn = configuration->property(role + ".high_dyn", high_dyn);
+    // Code replicas are re-resampled only when the accumulated code phase
+    // deviation exceeds this value (0 disables the lazy resampling mode)
+    resampler_epsilon_chips = configuration->property(role + ".resampler_epsilon_chips", resampler_epsilon_chips);
+    // Compute backend for the multicorrelator: "cpu" (default) or "sycl"
+    accelerator = configuration->property(role + ".accelerator", accelerator);
     dump = configuration->property(role + ".dump", dump);
     dump_filename = configuration->property(role + ".dump_filename", dump_filename);
     dump_mat = configuration->property(role + ".dump_mat", dump_mat);
+    dump_columnar = configuration->property(role + ".dump_columnar", dump_columnar);
+    // deterministic rotation of the columnar dump into numbered files every
+    // dump_rows_per_file logged epochs; 0 keeps a single file per run
+    dump_rows_per_file = configuration->property(role + ".dump_rows_per_file", dump_rows_per_file);
+    enable_work_monitor = configuration->property("WorkMonitor.enable_monitor", enable_work_monitor);
+    work_monitor_addresses = configuration->property("WorkMonitor.client_addresses", work_monitor_addresses);
+    work_monitor_port = configuration->property("WorkMonitor.udp_port", work_monitor_port);
+    work_monitor_interval_calls = configuration->property("WorkMonitor.report_interval_calls", work_monitor_interval_calls);
     pll_bw_hz = configuration->property(role + ".pll_bw_hz", pll_bw_hz);
     if (FLAGS_pll_bw_hz != 0.0)
         {
@@ -143,14 +178,53 @@ void Dll_Pll_Conf::SetFromConfiguration(const ConfigurationInterface *configurat
     early_late_space_narrow_chips = configuration->property(role + ".early_late_space_narrow_chips", early_late_space_narrow_chips);
     very_early_late_space_chips = configuration->property(role + ".very_early_late_space_chips", very_early_late_space_chips);
     very_early_late_space_narrow_chips = configuration->property(role + ".very_early_late_space_narrow_chips", very_early_late_space_narrow_chips);
+    // MEDLL-style multipath estimator: extra correlator taps feeding a
+    // budgeted maximum-likelihood fit that removes the multipath-induced
+    // bias from the code discriminator
+    enable_multipath_estimator = configuration->property(role + ".enable_multipath_estimator", enable_multipath_estimator);
+    multipath_budget_per_epoch = configuration->property(role + ".multipath_budget_per_epoch", multipath_budget_per_epoch);
+    multipath_smoother_alpha = configuration->property(role + ".multipath_smoother_alpha", multipath_smoother_alpha);
+    // Scintillation monitoring: S4/sigma-phi computed from the prompt
+    // correlator with running sums and streamed over UDP once per window
+    enable_scintillation_monitor = configuration->property(role + ".enable_scintillation_monitor", enable_scintillation_monitor);
+    scint_address = configuration->property(role + ".scint_address", scint_address);
+    scint_port = configuration->property(role + ".scint_port", scint_port);
+    scint_window_s = configuration->property(role + ".scint_window_s", scint_window_s);
     extend_correlation_symbols = configuration->property(role + ".extend_correlation_symbols", extend_correlation_symbols);
+    // Engage the extended integration only while the estimated C/N0 stays
+    // below auto_extend_cn0_low, and fall back to single-symbol epochs when
+    // it recovers above auto_extend_cn0_high
+    auto_extend_correlation = configuration->property(role + ".auto_extend_correlation", auto_extend_correlation);
+    auto_extend_cn0_low = configuration->property(role + ".auto_extend_cn0_low", auto_extend_cn0_low);
+    auto_extend_cn0_high = configuration->property(role + ".auto_extend_cn0_high", auto_extend_cn0_high);
+    if (auto_extend_cn0_high < auto_extend_cn0_low)
+        {
+            LOG(WARNING) << "auto_extend_cn0_high must not be smaller than auto_extend_cn0_low. Automatic correlation extension disabled";
+            auto_extend_correlation = false;
+        }
     track_pilot = configuration->property(role + ".track_pilot", track_pilot);
     cn0_samples = configuration->property(role + ".cn0_samples", cn0_samples);
+    // Run the C/N0 estimator and the lock detectors once every cn0_decimation
+    // tracking epochs instead of every epoch
+    cn0_decimation = configuration->property(role + ".cn0_decimation", cn0_decimation);
+    if (cn0_decimation < 1)
+        {
+            LOG(WARNING) << "cn0_decimation must be 1 or greater. It has been set to 1";
+            cn0_decimation = 1;
+        }
     cn0_min = configuration->property(role + ".cn0_min", cn0_min);
     max_code_lock_fail = configuration->property(role + ".max_lock_fail", max_code_lock_fail);
     max_carrier_lock_fail = configuration->property(role + ".max_carrier_lock_fail", max_carrier_lock_fail);
     carrier_lock_th = configuration->property(role + ".carrier_lock_th", carrier_lock_th);
     carrier_aiding = configuration->property(role + ".carrier_aiding", carrier_aiding);
+    // Share the carrier NCO accumulator between the bands of one satellite:
+    // the master band publishes its Doppler normalized by the carrier
+    // frequency, the other bands read it back scaled by their own
+    share_multiband_nco = configuration->property(role + ".share_multiband_nco", share_multiband_nco);
+    // When the lock detectors trip, keep the channel running open-loop on the
+    // last closed-loop NCO commands instead of dropping to re-acquisition
+    enable_coasting = configuration->property(role + ".enable_coasting", enable_coasting);
+    coasting_time_s = configuration->property(role + ".coasting_time_s", coasting_time_s);
 
     // tracking lock tests smoother parameters
     cn0_smoother_samples = configuration->property(role + ".cn0_smoother_samples", cn0_smoother_samples);
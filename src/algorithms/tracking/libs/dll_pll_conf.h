@@ -38,6 +38,9 @@ public:
     /* DLL/PLL tracking configuration */
     std::string item_type;
     std::string dump_filename;
+    std::string work_monitor_addresses;
+    std::string accelerator;
+    std::string scint_address;
     double fs_in;
     double carrier_lock_th;
     float pll_pull_in_bw_hz;
@@ -53,9 +56,15 @@ public:
     float very_early_late_space_narrow_chips;
     float slope;
     float spc;
+    float auto_extend_cn0_low;
+    float auto_extend_cn0_high;
+    float resampler_epsilon_chips;
     float y_intercept;
+    float multipath_smoother_alpha;
+    float scint_window_s;
     float cn0_smoother_alpha;
     float carrier_lock_test_smoother_alpha;
+    uint32_t dump_rows_per_file;
     uint32_t pull_in_time_s;
     uint32_t bit_synchronization_time_limit_s;
     uint32_t vector_length;
@@ -65,21 +74,34 @@ public:
     int32_t dll_filter_order;
     int32_t extend_correlation_symbols;
     int32_t cn0_samples;
+    int32_t cn0_decimation;
     int32_t cn0_smoother_samples;
     int32_t carrier_lock_test_smoother_samples;
     int32_t cn0_min;
+    int32_t multipath_budget_per_epoch;
     int32_t max_code_lock_fail;
     int32_t max_carrier_lock_fail;
+    int32_t coasting_time_s;
     char signal[3]{};
     char system;
     bool enable_fll_pull_in;
     bool enable_fll_steady_state;
     bool track_pilot;
     bool enable_doppler_correction;
+    bool enable_coasting;
+    bool auto_extend_correlation;
     bool carrier_aiding;
+    bool share_multiband_nco;
+    bool enable_multipath_estimator;
+    bool enable_scintillation_monitor;
     bool high_dyn;
     bool dump;
     bool dump_mat;
+    bool dump_columnar;
+    bool enable_work_monitor;
+    uint16_t work_monitor_port;
+    uint16_t scint_port;
+    uint32_t work_monitor_interval_calls;
 };
 
 
@@ -24,24 +24,9 @@
 #include <glog/logging.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
 #include <cmath>
-#include <fcntl.h>  // for O_RDWR, O_RSYNC
 #include <string>
-#include <sys/mman.h>  // for PROT_READ, PROT_WRITE, MAP_SHARED
 #include <utility>
 
-#ifndef TEMP_FAILURE_RETRY
-#define TEMP_FAILURE_RETRY(exp)              \
-    ({                                       \
-        decltype(exp) _rc;                   \
-        do                                   \
-            {                                \
-                _rc = (exp);                 \
-            }                                \
-        while (_rc == -1 && errno == EINTR); \
-        _rc;                                 \
-    })
-#endif
-
 // floating point math constants related to the parameters that are written in the FPGA
 const float PHASE_CARR_MAX_DIV_PI = 683565275.5764316;  // 2^(31)/pi
 const float TWO_PI = 6.283185307179586;
@@ -55,7 +40,7 @@ Fpga_Multicorrelator_8sc::Fpga_Multicorrelator_8sc(int32_t n_correlators,
 {
     d_n_correlators = n_correlators;
     d_track_pilot = track_pilot;
-    d_device_descriptor = 0;
+    d_transport = std::make_unique<Uio_Fpga_Transport>(page_size);
     d_map_base = nullptr;
 
     // instantiate variable length vectors
@@ -162,13 +147,11 @@ void Fpga_Multicorrelator_8sc::Carrier_wipeoff_multicorrelator_resampler(
     Fpga_Multicorrelator_8sc::fpga_compute_signal_parameters_in_fpga();
     Fpga_Multicorrelator_8sc::fpga_configure_signal_parameters_in_fpga();
     Fpga_Multicorrelator_8sc::fpga_launch_multicorrelator_fpga();
-    int32_t irq_count;
-    ssize_t nb;
-    nb = read(d_device_descriptor, &irq_count, sizeof(irq_count));
-    if (nb != sizeof(irq_count))
+    // adaptive wait: the transport sleeps on the interrupt through the bulk
+    // of the integration and spins only through the last microseconds
+    if (!d_transport->wait_for_completion())
         {
-            std::cout << "Tracking_module Read failed to retrieve 4 bytes!\n";
-            std::cout << "Tracking_module Interrupt number " << irq_count << '\n';
+            std::cout << "Tracking_module failed to wait for the FPGA interrupt!\n";
         }
 
     // release secondary code indices, keep channel locked
@@ -196,20 +179,13 @@ void Fpga_Multicorrelator_8sc::open_channel(std::string device_io_name, uint32_t
 {
     std::cout << "trk device_io_name = " << device_io_name << '\n';
 
-    if ((d_device_descriptor = open(device_io_name.c_str(), O_RDWR | O_SYNC)) == -1)
+    if (d_transport->open_device_file(device_io_name) < 0)
         {
-            LOG(WARNING) << "Cannot open deviceio" << device_io_name;
+            LOG(WARNING) << "Cannot open the FPGA tracking module "
+                         << channel << " through " << device_io_name;
             std::cout << "Cannot open deviceio" << device_io_name << '\n';
         }
-    d_map_base = reinterpret_cast<volatile uint32_t *>(mmap(nullptr, page_size,
-        PROT_READ | PROT_WRITE, MAP_SHARED, d_device_descriptor, 0));
-
-    if (d_map_base == reinterpret_cast<void *>(-1))
-        {
-            LOG(WARNING) << "Cannot map the FPGA tracking module "
-                         << channel << "into user memory";
-            std::cout << "Cannot map deviceio" << device_io_name << '\n';
-        }
+    d_map_base = d_transport->register_map();
 
     // sanity check: check test register
     uint32_t writeval = test_register_track_writeval;
@@ -363,12 +339,7 @@ void Fpga_Multicorrelator_8sc::fpga_configure_signal_parameters_in_fpga()
 void Fpga_Multicorrelator_8sc::fpga_launch_multicorrelator_fpga()
 {
     // enable interrupts
-    int32_t reenable = 1;
-    ssize_t nbytes = TEMP_FAILURE_RETRY(write(d_device_descriptor, reinterpret_cast<void *>(&reenable), sizeof(int32_t)));
-    if (nbytes != sizeof(int32_t))
-        {
-            std::cerr << "Error launching the FPGA multicorrelator\n";
-        }
+    d_transport->arm_interrupt();
     // writing 1 to reg 14 launches the tracking
     d_map_base[start_flag_addr] = 1;
 }
@@ -405,12 +376,8 @@ void Fpga_Multicorrelator_8sc::unlock_channel()
 
 void Fpga_Multicorrelator_8sc::close_device()
 {
-    auto *aux = const_cast<uint32_t *>(d_map_base);
-    if (munmap(static_cast<void *>(aux), page_size) == -1)
-        {
-            std::cout << "Failed to unmap memory uio\n";
-        }
-    close(d_device_descriptor);
+    d_transport->close_device();
+    d_map_base = nullptr;
 }
 
 
@@ -23,9 +23,11 @@
 #ifndef GNSS_SDR_FPGA_MULTICORRELATOR_H
 #define GNSS_SDR_FPGA_MULTICORRELATOR_H
 
+#include "uio_fpga_transport.h"
 #include <gnuradio/block.h>
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>
 #include <cstdint>
+#include <memory>
 #include <string>
 
 /** \addtogroup Tracking
@@ -226,8 +228,8 @@ private:
     uint32_t d_n_correlators;  // number of correlators
 
     // data related to the hardware module and the driver
-    int32_t d_device_descriptor;    // driver descriptor
-    volatile uint32_t *d_map_base;  // driver memory map
+    std::unique_ptr<Uio_Fpga_Transport> d_transport;  // transport to the accelerator
+    volatile uint32_t *d_map_base;                    // register map of the accelerator
 
     // configuration data received from the interface
     uint32_t d_correlator_length_samples;
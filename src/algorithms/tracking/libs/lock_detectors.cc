@@ -33,6 +33,7 @@
  */
 
 #include "lock_detectors.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include <cmath>
 
 /*
@@ -57,11 +58,10 @@ float cn0_svn_estimator(const gr_complex* Prompt_buffer, int length, float coh_i
     float SNR_dB_Hz = 0.0;
     float Psig = 0.0;
     float Ptot = 0.0;
-    for (int i = 0; i < length; i++)
-        {
-            Psig += std::abs(Prompt_buffer[i].real());
-            Ptot += Prompt_buffer[i].imag() * Prompt_buffer[i].imag() + Prompt_buffer[i].real() * Prompt_buffer[i].real();
-        }
+    float m_4 = 0.0;
+    float sum_re = 0.0;
+    float sum_im = 0.0;
+    volk_gnsssdr_32fc_moments_32f(&Psig, &Ptot, &m_4, &sum_re, &sum_im, Prompt_buffer, static_cast<unsigned int>(length));
     Psig /= static_cast<float>(length);
     Psig = Psig * Psig;
     Ptot /= static_cast<float>(length);
@@ -94,15 +94,11 @@ float cn0_m2m4_estimator(const gr_complex* Prompt_buffer, int length, float coh_
     float Psig = 0.0;
     float m_2 = 0.0;
     float m_4 = 0.0;
+    float sum_re = 0.0;
+    float sum_im = 0.0;
     float aux;
     const auto n = static_cast<float>(length);
-    for (int i = 0; i < length; i++)
-        {
-            Psig += std::abs(Prompt_buffer[i].real());
-            aux = Prompt_buffer[i].imag() * Prompt_buffer[i].imag() + Prompt_buffer[i].real() * Prompt_buffer[i].real();
-            m_2 += aux;
-            m_4 += (aux * aux);
-        }
+    volk_gnsssdr_32fc_moments_32f(&Psig, &m_2, &m_4, &sum_re, &sum_im, Prompt_buffer, static_cast<unsigned int>(length));
     Psig /= n;
     Psig = Psig * Psig;
     m_2 /= n;
@@ -137,11 +133,10 @@ float carrier_lock_detector(gr_complex* Prompt_buffer, int length)
     float tmp_sum_Q = 0.0;
     float NBD = 0.0;
     float NBP = 0.0;
-    for (int i = 0; i < length; i++)
-        {
-            tmp_sum_I += Prompt_buffer[i].real();
-            tmp_sum_Q += Prompt_buffer[i].imag();
-        }
+    float abs_re = 0.0;
+    float m_2 = 0.0;
+    float m_4 = 0.0;
+    volk_gnsssdr_32fc_moments_32f(&abs_re, &m_2, &m_4, &tmp_sum_I, &tmp_sum_Q, Prompt_buffer, static_cast<unsigned int>(length));
     NBP = tmp_sum_I * tmp_sum_I + tmp_sum_Q * tmp_sum_Q;
     NBD = tmp_sum_I * tmp_sum_I - tmp_sum_Q * tmp_sum_Q;
     return NBD / NBP;
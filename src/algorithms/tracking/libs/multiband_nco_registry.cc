@@ -0,0 +1,101 @@
+/*!
+ * \file multiband_nco_registry.cc
+ * \brief Process-wide registry sharing the carrier NCO accumulator between
+ * the tracking channels of one satellite.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "multiband_nco_registry.h"
+
+namespace
+{
+// a shared accumulator older than this no longer reflects the satellite
+// dynamics and must not drive another band
+constexpr std::chrono::milliseconds MULTIBAND_NCO_MAX_AGE(200);
+}  // namespace
+
+
+Multiband_Nco_Registry& Multiband_Nco_Registry::get_instance()
+{
+    static Multiband_Nco_Registry instance;
+    return instance;
+}
+
+
+bool Multiband_Nco_Registry::try_acquire(const std::string& sat_key, uint32_t channel_id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = entries_.find(sat_key);
+    if (entry == entries_.end())
+        {
+            Entry new_entry;
+            new_entry.owner_channel = channel_id;
+            entries_[sat_key] = new_entry;
+            return true;
+        }
+    if (entry->second.owner_channel == channel_id)
+        {
+            return true;
+        }
+    // a master whose updates went stale has stopped tracking without
+    // releasing (e.g. a retarget): the role can be taken over
+    if (entry->second.published and
+        (std::chrono::steady_clock::now() - entry->second.updated > MULTIBAND_NCO_MAX_AGE))
+        {
+            entry->second.owner_channel = channel_id;
+            entry->second.published = false;
+            return true;
+        }
+    return false;
+}
+
+
+void Multiband_Nco_Registry::release(const std::string& sat_key, uint32_t channel_id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto entry = entries_.find(sat_key);
+    if ((entry != entries_.end()) and (entry->second.owner_channel == channel_id))
+        {
+            entries_.erase(entry);
+        }
+}
+
+
+void Multiband_Nco_Registry::publish(const std::string& sat_key, uint32_t channel_id, double range_rate_hz_per_hz)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto entry = entries_.find(sat_key);
+    if ((entry != entries_.end()) and (entry->second.owner_channel == channel_id))
+        {
+            entry->second.range_rate_hz_per_hz = range_rate_hz_per_hz;
+            entry->second.updated = std::chrono::steady_clock::now();
+            entry->second.published = true;
+        }
+}
+
+
+bool Multiband_Nco_Registry::lookup(const std::string& sat_key, double& range_rate_hz_per_hz)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto entry = entries_.find(sat_key);
+    if ((entry == entries_.end()) or !entry->second.published)
+        {
+            return false;
+        }
+    if (std::chrono::steady_clock::now() - entry->second.updated > MULTIBAND_NCO_MAX_AGE)
+        {
+            return false;
+        }
+    range_rate_hz_per_hz = entry->second.range_rate_hz_per_hz;
+    return true;
+}
@@ -0,0 +1,84 @@
+/*!
+ * \file multiband_nco_registry.h
+ * \brief Process-wide registry sharing the carrier NCO accumulator between
+ * the tracking channels of one satellite.
+ *
+ * The carrier Dopplers of the bands transmitted by one satellite are
+ * rationally related: they are the common geometric range rate scaled by
+ * each carrier frequency. One band per satellite (the first channel that
+ * registers, typically the most robust one) acts as the master and
+ * publishes its Doppler normalized by its carrier frequency; the channels
+ * of the other bands read the shared accumulator back, scaled by their own
+ * carrier frequency, to seed their loops at pull-in and to drive their NCO
+ * while coasting through a fade on that band.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MULTIBAND_NCO_REGISTRY_H
+#define GNSS_SDR_MULTIBAND_NCO_REGISTRY_H
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Process-wide shared carrier NCO accumulators, keyed by satellite
+ * ("System PRN"). Thread-safe: publishers and readers run on different
+ * channel threads.
+ */
+class Multiband_Nco_Registry
+{
+public:
+    static Multiband_Nco_Registry& get_instance();
+
+    //! Claims the master role for the satellite. Returns true if this
+    //! channel is now the master, false if another channel already is
+    bool try_acquire(const std::string& sat_key, uint32_t channel_id);
+
+    //! Releases the master role, if held by this channel
+    void release(const std::string& sat_key, uint32_t channel_id);
+
+    //! Publishes the shared accumulator: the carrier Doppler of the master
+    //! band divided by its carrier frequency [Hz/Hz]. Only the master writes
+    void publish(const std::string& sat_key, uint32_t channel_id, double range_rate_hz_per_hz);
+
+    //! Reads the shared accumulator back. Returns false if no master has
+    //! published, or if the entry is stale (the master stopped updating)
+    bool lookup(const std::string& sat_key, double& range_rate_hz_per_hz);
+
+private:
+    Multiband_Nco_Registry() = default;
+
+    struct Entry
+    {
+        std::chrono::steady_clock::time_point updated;
+        double range_rate_hz_per_hz = 0.0;
+        uint32_t owner_channel = 0;
+        bool published = false;
+    };
+
+    std::map<std::string, Entry> entries_;
+    std::mutex mutex_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MULTIBAND_NCO_REGISTRY_H
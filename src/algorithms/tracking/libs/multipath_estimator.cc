@@ -0,0 +1,293 @@
+/*!
+ * \file multipath_estimator.cc
+ * \brief Implementation of a budgeted MEDLL-style multipath estimator
+ * working on multicorrelator outputs
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "multipath_estimator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+// line-of-sight delay candidates around the prompt, in chips
+const float t0_min = -0.2F;
+const float t0_max = 0.2F;
+// reflection delay candidates, in chips (reflections beyond one chip are
+// decorrelated and do not bias the DLL)
+const float t1_max = 1.0F;
+const float grid_step = 0.05F;
+// minimum delay separation so the two basis vectors stay well conditioned
+const float min_separation = 0.1F;
+// reflections weaker than this fraction of the direct path are treated as noise
+const float min_amplitude_ratio = 0.05F;
+// magnitude snapshots are prefiltered with this exponential factor
+const float snapshot_alpha = 0.1F;
+// epochs of magnitude averaging before the first search pass is trusted
+const int warmup_epochs = 10;
+}  // namespace
+
+
+void Multipath_Estimator::init(const std::vector<float>& tap_offsets_chips, float spc, float slope, float y_intercept,
+    int evaluations_per_epoch, float smoother_alpha)
+{
+    d_tap_offsets_chips = tap_offsets_chips;
+    d_spc = spc;
+    d_slope = slope;
+    d_y_intercept = y_intercept;
+    d_evaluations_per_epoch = std::max(evaluations_per_epoch, 1);
+    d_bias_smoother.set_alpha(smoother_alpha);
+    d_bias_smoother.set_samples_for_initialization(1);
+
+    const size_t n_taps = d_tap_offsets_chips.size();
+    d_y.assign(n_taps, 0.0F);
+
+    d_t0_grid.clear();
+    for (float t0 = t0_min; t0 <= t0_max + grid_step / 2.0F; t0 += grid_step)
+        {
+            d_t0_grid.push_back(t0);
+        }
+    d_t1_grid.clear();
+    for (float t1 = min_separation; t1 <= t1_max + grid_step / 2.0F; t1 += grid_step)
+        {
+            d_t1_grid.push_back(t1);
+        }
+
+    // precompute the basis vectors and their Gram products so that each
+    // candidate evaluation reduces to two dot products and a 2x2 solve
+    d_basis0.assign(d_t0_grid.size() * n_taps, 0.0F);
+    d_b00.assign(d_t0_grid.size(), 0.0F);
+    for (size_t i0 = 0; i0 < d_t0_grid.size(); i0++)
+        {
+            for (size_t k = 0; k < n_taps; k++)
+                {
+                    const float value = triangle(d_tap_offsets_chips[k] - d_t0_grid[i0]);
+                    d_basis0[i0 * n_taps + k] = value;
+                    d_b00[i0] += value * value;
+                }
+        }
+    d_basis1.assign(d_t1_grid.size() * n_taps, 0.0F);
+    d_b11.assign(d_t1_grid.size(), 0.0F);
+    for (size_t i1 = 0; i1 < d_t1_grid.size(); i1++)
+        {
+            for (size_t k = 0; k < n_taps; k++)
+                {
+                    const float value = triangle(d_tap_offsets_chips[k] - d_t1_grid[i1]);
+                    d_basis1[i1 * n_taps + k] = value;
+                    d_b11[i1] += value * value;
+                }
+        }
+    d_pairs.clear();
+    d_b01.clear();
+    for (size_t i0 = 0; i0 < d_t0_grid.size(); i0++)
+        {
+            for (size_t i1 = 0; i1 < d_t1_grid.size(); i1++)
+                {
+                    if (d_t1_grid[i1] - d_t0_grid[i0] < min_separation)
+                        {
+                            continue;
+                        }
+                    float b01 = 0.0F;
+                    for (size_t k = 0; k < n_taps; k++)
+                        {
+                            b01 += d_basis0[i0 * n_taps + k] * d_basis1[i1 * n_taps + k];
+                        }
+                    d_pairs.emplace_back(static_cast<int>(i0), static_cast<int>(i1));
+                    d_b01.push_back(b01);
+                }
+        }
+    d_yb0_cache.assign(d_t0_grid.size(), 0.0F);
+    reset();
+}
+
+
+void Multipath_Estimator::reset()
+{
+    std::fill(d_y.begin(), d_y.end(), 0.0F);
+    d_bias_smoother.reset();
+    d_bias_chips = 0.0F;
+    d_best_residual = std::numeric_limits<float>::max();
+    d_best_a0 = 0.0F;
+    d_best_a1 = 0.0F;
+    d_best_t0 = 0.0F;
+    d_best_t1 = 0.0F;
+    d_amplitude_ratio = 0.0F;
+    d_delay_chips = 0.0F;
+    d_epochs_fed = 0;
+    d_next_pair = 0;
+}
+
+
+float Multipath_Estimator::triangle(float x)
+{
+    return std::max(0.0F, 1.0F - std::fabs(x));
+}
+
+
+float Multipath_Estimator::discriminator(float early_mag, float late_mag) const
+{
+    const float e_plus_l = early_mag + late_mag;
+    if (e_plus_l <= 0.0F)
+        {
+            return 0.0F;
+        }
+    // same normalized non-coherent early-minus-late form as the DLL
+    return ((d_y_intercept - d_slope * d_spc) / d_slope) * (early_mag - late_mag) / e_plus_l;
+}
+
+
+float Multipath_Estimator::model_bias(float a0, float t0, float a1, float t1) const
+{
+    // discriminator value seen with the reflection present minus the value
+    // the direct path alone would produce: this is the bias the reflection
+    // injects into the code loop
+    const float early_total = a0 * triangle(-d_spc - t0) + a1 * triangle(-d_spc - t1);
+    const float late_total = a0 * triangle(d_spc - t0) + a1 * triangle(d_spc - t1);
+    const float early_los = a0 * triangle(-d_spc - t0);
+    const float late_los = a0 * triangle(d_spc - t0);
+    return discriminator(early_total, late_total) - discriminator(early_los, late_los);
+}
+
+
+float Multipath_Estimator::update(const float* correlator_mags, size_t n_taps)
+{
+    if (n_taps != d_tap_offsets_chips.size() or d_pairs.empty())
+        {
+            return 0.0F;
+        }
+    // prompt-normalized magnitude snapshot, prefiltered to tame the noise of
+    // single-epoch correlations before the model fit
+    float prompt_mag = 0.0F;
+    for (size_t k = 0; k < n_taps; k++)
+        {
+            if (d_tap_offsets_chips[k] == 0.0F)
+                {
+                    prompt_mag = correlator_mags[k];
+                    break;
+                }
+        }
+    if (prompt_mag <= 0.0F)
+        {
+            return d_bias_chips;
+        }
+    for (size_t k = 0; k < n_taps; k++)
+        {
+            d_y[k] = (1.0F - snapshot_alpha) * d_y[k] + snapshot_alpha * (correlator_mags[k] / prompt_mag);
+        }
+    d_epochs_fed++;
+    if (d_epochs_fed < warmup_epochs)
+        {
+            return d_bias_chips;
+        }
+
+    float yy = 0.0F;
+    for (size_t k = 0; k < n_taps; k++)
+        {
+            yy += d_y[k] * d_y[k];
+        }
+    // advance the grid search by at most the per-epoch budget
+    int last_i0 = -1;
+    for (int evaluations = 0; evaluations < d_evaluations_per_epoch; evaluations++)
+        {
+            const int i0 = d_pairs[d_next_pair].first;
+            const int i1 = d_pairs[d_next_pair].second;
+            if (i0 != last_i0)
+                {
+                    // <y,b0> only depends on t0: reuse it along the t1 sweep
+                    float yb0 = 0.0F;
+                    const float* b0 = &d_basis0[static_cast<size_t>(i0) * n_taps];
+                    for (size_t k = 0; k < n_taps; k++)
+                        {
+                            yb0 += d_y[k] * b0[k];
+                        }
+                    d_yb0_cache[i0] = yb0;
+                    last_i0 = i0;
+                }
+            float yb1 = 0.0F;
+            const float* b1 = &d_basis1[static_cast<size_t>(i1) * n_taps];
+            for (size_t k = 0; k < n_taps; k++)
+                {
+                    yb1 += d_y[k] * b1[k];
+                }
+            const float yb0 = d_yb0_cache[i0];
+            const float b00 = d_b00[i0];
+            const float b11 = d_b11[i1];
+            const float b01 = d_b01[d_next_pair];
+            const float det = b00 * b11 - b01 * b01;
+            float a0;
+            float a1;
+            if (det > 0.0F)
+                {
+                    a0 = (yb0 * b11 - yb1 * b01) / det;
+                    a1 = (yb1 * b00 - yb0 * b01) / det;
+                }
+            else
+                {
+                    a0 = yb0 / b00;
+                    a1 = 0.0F;
+                }
+            if (a1 < 0.0F)
+                {
+                    // reflection amplitudes are non-negative: fall back to the
+                    // single-path least-squares fit
+                    a0 = yb0 / b00;
+                    a1 = 0.0F;
+                }
+            const float residual = yy - a0 * yb0 - a1 * yb1;
+            if (residual < d_best_residual)
+                {
+                    d_best_residual = residual;
+                    d_best_a0 = a0;
+                    d_best_a1 = a1;
+                    d_best_t0 = d_t0_grid[i0];
+                    d_best_t1 = d_t1_grid[i1];
+                }
+            d_next_pair++;
+            if (d_next_pair == d_pairs.size())
+                {
+                    // search pass complete: publish the fitted bias and restart
+                    float bias_raw = 0.0F;
+                    if (d_best_a0 > 0.0F and d_best_a1 > min_amplitude_ratio * d_best_a0)
+                        {
+                            bias_raw = model_bias(d_best_a0, d_best_t0, d_best_a1, d_best_t1);
+                            d_amplitude_ratio = d_best_a1 / d_best_a0;
+                            d_delay_chips = d_best_t1 - d_best_t0;
+                        }
+                    else
+                        {
+                            d_amplitude_ratio = 0.0F;
+                            d_delay_chips = 0.0F;
+                        }
+                    const float bias_limit = d_spc;
+                    d_bias_chips = std::max(-bias_limit, std::min(bias_limit, d_bias_smoother.smooth(bias_raw)));
+                    d_best_residual = std::numeric_limits<float>::max();
+                    d_next_pair = 0;
+                    break;
+                }
+        }
+    return d_bias_chips;
+}
+
+
+float Multipath_Estimator::multipath_amplitude_ratio() const
+{
+    return d_amplitude_ratio;
+}
+
+
+float Multipath_Estimator::multipath_delay_chips() const
+{
+    return d_delay_chips;
+}
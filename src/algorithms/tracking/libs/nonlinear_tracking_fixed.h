@@ -0,0 +1,568 @@
+/*!
+ * \file nonlinear_tracking_fixed.h
+ * \brief Fixed-dimension versions of the nonlinear tracking filters
+ *
+ * CubatureFilterFixed and UnscentedFilterFixed mirror the CubatureFilter and
+ * UnscentedFilter classes of nonlinear_tracking.h for state dimensions known
+ * at compile time. The state and the covariances live in std::array storage,
+ * the Cholesky factorizations and the triangular solves are written out
+ * explicitly, and the sigma-point loops have compile-time bounds, so a full
+ * predict/update cycle performs no dynamic allocation and no LAPACK call and
+ * the compiler can unroll and vectorize the matrix operations. For the 2-4
+ * state models used in carrier tracking this brings the per-epoch filter cost
+ * close to that of a conventional DLL/PLL iteration.
+ *
+ * The model functions are passed as callables taking and returning
+ * std::array instead of deriving from ModelFunction, so the sigma-point
+ * propagation does not pay a virtual call nor an armadillo temporary per
+ * point.
+ *
+ * [1] I Arasaratnam and S Haykin. Cubature kalman filters. IEEE
+ * Transactions on Automatic Control, 54(6):1254–1269,2009.
+ *
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_NONLINEAR_TRACKING_FIXED_H
+#define GNSS_SDR_NONLINEAR_TRACKING_FIXED_H
+
+#include <array>
+#include <cmath>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*
+ * Lower Cholesky factorization of a symmetric positive definite N x N matrix
+ * stored row-major in a std::array.
+ */
+template <int N>
+inline void fixed_chol_lower(const std::array<double, N * N>& A, std::array<double, N * N>& L)
+{
+    for (int j = 0; j < N; j++)
+        {
+            double diag = A[j * N + j];
+            for (int k = 0; k < j; k++)
+                {
+                    diag -= L[j * N + k] * L[j * N + k];
+                }
+            diag = std::sqrt(diag);
+            L[j * N + j] = diag;
+            for (int k = j + 1; k < N; k++)
+                {
+                    L[j * N + k] = 0.0;
+                }
+            for (int i = j + 1; i < N; i++)
+                {
+                    double sum = A[i * N + j];
+                    for (int k = 0; k < j; k++)
+                        {
+                            sum -= L[i * N + k] * L[j * N + k];
+                        }
+                    L[i * N + j] = sum / diag;
+                }
+        }
+}
+
+
+/*
+ * Solves A * X = B for X, where A is symmetric positive definite and given by
+ * its lower Cholesky factor L (N x N), and B is N x M, all row-major.
+ */
+template <int N, int M>
+inline void fixed_chol_solve(const std::array<double, N * N>& L, const std::array<double, N * M>& B, std::array<double, N * M>& X)
+{
+    for (int col = 0; col < M; col++)
+        {
+            // forward substitution: L * y = b
+            for (int i = 0; i < N; i++)
+                {
+                    double sum = B[i * M + col];
+                    for (int k = 0; k < i; k++)
+                        {
+                            sum -= L[i * N + k] * X[k * M + col];
+                        }
+                    X[i * M + col] = sum / L[i * N + i];
+                }
+            // back substitution: L^T * x = y
+            for (int i = N - 1; i >= 0; i--)
+                {
+                    double sum = X[i * M + col];
+                    for (int k = i + 1; k < N; k++)
+                        {
+                            sum -= L[k * N + i] * X[k * M + col];
+                        }
+                    X[i * M + col] = sum / L[i * N + i];
+                }
+        }
+}
+
+
+template <int Nx>
+class UnscentedFilterFixed;
+
+template <int Nx>
+class CubatureFilterFixed
+{
+public:
+    using state_vector = std::array<double, Nx>;
+    using state_matrix = std::array<double, Nx * Nx>;
+
+    CubatureFilterFixed()
+    {
+        x_pred_out.fill(0.0);
+        P_x_pred_out.fill(0.0);
+        for (int i = 0; i < Nx; i++)
+            {
+                P_x_pred_out[i * Nx + i] = static_cast<double>(Nx + 1);
+            }
+        x_est = x_pred_out;
+        P_x_est = P_x_pred_out;
+    }
+
+    // Reinitialization function
+    void initialize(const state_vector& x_pred_0, const state_matrix& P_x_pred_0)
+    {
+        x_pred_out = x_pred_0;
+        P_x_pred_out = P_x_pred_0;
+        x_est = x_pred_out;
+        P_x_est = P_x_pred_out;
+    }
+
+    /*
+     * Perform the prediction step of the cubature Kalman filter
+     */
+    template <typename TransitionFunction>
+    void predict_sequential(const state_vector& x_post, const state_matrix& P_x_post, TransitionFunction&& transition_fcn, const state_matrix& noise_covariance)
+    {
+        constexpr int np = 2 * Nx;
+        const double scale = std::sqrt(static_cast<double>(Nx));
+
+        // Factorize posterior covariance
+        state_matrix Sm_post;
+        fixed_chol_lower<Nx>(P_x_post, Sm_post);
+
+        state_vector x_pred;
+        state_matrix P_x_pred;
+        x_pred.fill(0.0);
+        P_x_pred.fill(0.0);
+
+        // Propagate and evaluate cubature points
+        state_vector Xi_post;
+        state_vector Xi_pred;
+        for (int p = 0; p < np; p++)
+            {
+                const int col = p % Nx;
+                const double sign = (p < Nx) ? 1.0 : -1.0;
+                for (int i = 0; i < Nx; i++)
+                    {
+                        Xi_post[i] = sign * scale * Sm_post[i * Nx + col] + x_post[i];
+                    }
+                Xi_pred = transition_fcn(Xi_post);
+
+                for (int i = 0; i < Nx; i++)
+                    {
+                        x_pred[i] += Xi_pred[i];
+                        for (int j = 0; j < Nx; j++)
+                            {
+                                P_x_pred[i * Nx + j] += Xi_pred[i] * Xi_pred[j];
+                            }
+                    }
+            }
+
+        // Compute predicted mean and error covariance
+        for (int i = 0; i < Nx; i++)
+            {
+                x_pred[i] /= static_cast<double>(np);
+            }
+        for (int i = 0; i < Nx; i++)
+            {
+                for (int j = 0; j < Nx; j++)
+                    {
+                        P_x_pred[i * Nx + j] = P_x_pred[i * Nx + j] / static_cast<double>(np) - x_pred[i] * x_pred[j] + noise_covariance[i * Nx + j];
+                    }
+            }
+
+        x_pred_out = x_pred;
+        P_x_pred_out = P_x_pred;
+    }
+
+    /*
+     * Perform the update step of the cubature Kalman filter
+     */
+    template <int Nz, typename MeasurementFunction>
+    void update_sequential(const std::array<double, Nz>& z_upd, const state_vector& x_pred, const state_matrix& P_x_pred, MeasurementFunction&& measurement_fcn, const std::array<double, Nz * Nz>& noise_covariance)
+    {
+        constexpr int np = 2 * Nx;
+        const double scale = std::sqrt(static_cast<double>(Nx));
+
+        // Factorize predicted covariance
+        state_matrix Sm_pred;
+        fixed_chol_lower<Nx>(P_x_pred, Sm_pred);
+
+        std::array<double, Nz> z_pred;
+        std::array<double, Nz * Nz> P_zz_pred;
+        std::array<double, Nx * Nz> P_xz_pred;
+        z_pred.fill(0.0);
+        P_zz_pred.fill(0.0);
+        P_xz_pred.fill(0.0);
+
+        // Propagate and evaluate cubature points
+        state_vector Xi_pred;
+        std::array<double, Nz> Zi_pred;
+        for (int p = 0; p < np; p++)
+            {
+                const int col = p % Nx;
+                const double sign = (p < Nx) ? 1.0 : -1.0;
+                for (int i = 0; i < Nx; i++)
+                    {
+                        Xi_pred[i] = sign * scale * Sm_pred[i * Nx + col] + x_pred[i];
+                    }
+                Zi_pred = measurement_fcn(Xi_pred);
+
+                for (int i = 0; i < Nz; i++)
+                    {
+                        z_pred[i] += Zi_pred[i];
+                        for (int j = 0; j < Nz; j++)
+                            {
+                                P_zz_pred[i * Nz + j] += Zi_pred[i] * Zi_pred[j];
+                            }
+                    }
+                for (int i = 0; i < Nx; i++)
+                    {
+                        for (int j = 0; j < Nz; j++)
+                            {
+                                P_xz_pred[i * Nz + j] += Xi_pred[i] * Zi_pred[j];
+                            }
+                    }
+            }
+
+        // Compute measurement mean, covariance and cross covariance
+        for (int i = 0; i < Nz; i++)
+            {
+                z_pred[i] /= static_cast<double>(np);
+            }
+        for (int i = 0; i < Nz; i++)
+            {
+                for (int j = 0; j < Nz; j++)
+                    {
+                        P_zz_pred[i * Nz + j] = P_zz_pred[i * Nz + j] / static_cast<double>(np) - z_pred[i] * z_pred[j] + noise_covariance[i * Nz + j];
+                    }
+            }
+        for (int i = 0; i < Nx; i++)
+            {
+                for (int j = 0; j < Nz; j++)
+                    {
+                        P_xz_pred[i * Nz + j] = P_xz_pred[i * Nz + j] / static_cast<double>(np) - x_pred[i] * z_pred[j];
+                    }
+            }
+
+        apply_gain<Nz>(z_upd, z_pred, P_zz_pred, P_xz_pred, x_pred, P_x_pred);
+    }
+
+    // Getters
+    const state_vector& get_x_pred() const
+    {
+        return x_pred_out;
+    }
+
+    const state_matrix& get_P_x_pred() const
+    {
+        return P_x_pred_out;
+    }
+
+    const state_vector& get_x_est() const
+    {
+        return x_est;
+    }
+
+    const state_matrix& get_P_x_est() const
+    {
+        return P_x_est;
+    }
+
+private:
+    /*
+     * Compute the Kalman gain W_k = P_xz * inv(P_zz) by solving
+     * P_zz * W_k^T = P_xz^T, and apply it to obtain the updated mean and
+     * error covariance.
+     */
+    template <int Nz>
+    void apply_gain(const std::array<double, Nz>& z_upd, const std::array<double, Nz>& z_pred,
+        const std::array<double, Nz * Nz>& P_zz_pred, const std::array<double, Nx * Nz>& P_xz_pred,
+        const state_vector& x_pred, const state_matrix& P_x_pred)
+    {
+        std::array<double, Nz * Nz> Sm_zz;
+        fixed_chol_lower<Nz>(P_zz_pred, Sm_zz);
+
+        std::array<double, Nz * Nx> P_xz_t;
+        for (int i = 0; i < Nx; i++)
+            {
+                for (int j = 0; j < Nz; j++)
+                    {
+                        P_xz_t[j * Nx + i] = P_xz_pred[i * Nz + j];
+                    }
+            }
+        std::array<double, Nz * Nx> W_k_t;
+        fixed_chol_solve<Nz, Nx>(Sm_zz, P_xz_t, W_k_t);
+
+        // Updated mean: x_est = x_pred + W_k * (z_upd - z_pred)
+        for (int i = 0; i < Nx; i++)
+            {
+                double innov = 0.0;
+                for (int k = 0; k < Nz; k++)
+                    {
+                        innov += W_k_t[k * Nx + i] * (z_upd[k] - z_pred[k]);
+                    }
+                x_est[i] = x_pred[i] + innov;
+            }
+
+        // Updated covariance: P_x_est = P_x_pred - W_k * P_zz * W_k^T
+        std::array<double, Nx * Nz> WP;
+        for (int i = 0; i < Nx; i++)
+            {
+                for (int j = 0; j < Nz; j++)
+                    {
+                        double acc = 0.0;
+                        for (int k = 0; k < Nz; k++)
+                            {
+                                acc += W_k_t[k * Nx + i] * P_zz_pred[k * Nz + j];
+                            }
+                        WP[i * Nz + j] = acc;
+                    }
+            }
+        for (int i = 0; i < Nx; i++)
+            {
+                for (int j = 0; j < Nx; j++)
+                    {
+                        double acc = 0.0;
+                        for (int k = 0; k < Nz; k++)
+                            {
+                                acc += WP[i * Nz + k] * W_k_t[k * Nx + j];
+                            }
+                        P_x_est[i * Nx + j] = P_x_pred[i * Nx + j] - acc;
+                    }
+            }
+    }
+
+    template <int Mx>
+    friend class UnscentedFilterFixed;
+
+    state_vector x_pred_out;
+    state_matrix P_x_pred_out;
+    state_vector x_est;
+    state_matrix P_x_est;
+};
+
+
+template <int Nx>
+class UnscentedFilterFixed
+{
+public:
+    using state_vector = std::array<double, Nx>;
+    using state_matrix = std::array<double, Nx * Nx>;
+
+    UnscentedFilterFixed() = default;
+
+    // Reinitialization function
+    void initialize(const state_vector& x_pred_0, const state_matrix& P_x_pred_0)
+    {
+        inner.initialize(x_pred_0, P_x_pred_0);
+    }
+
+    /*
+     * Perform the prediction step of the Unscented Kalman filter. The matrix
+     * square root of the covariance is taken as its lower Cholesky factor,
+     * which is the usual choice for the unscented transform and, unlike
+     * sqrtmat_sympd(), needs no eigendecomposition workspace.
+     */
+    template <typename TransitionFunction>
+    void predict_sequential(const state_vector& x_post, const state_matrix& P_x_post, TransitionFunction&& transition_fcn, const state_matrix& noise_covariance)
+    {
+        constexpr int np = 2 * Nx + 1;
+        const double lambda = compute_lambda();
+        const double W0_m = lambda / (static_cast<double>(Nx) + lambda);
+        const double W0_c = W0_m + (1.0 - ALPHA * ALPHA + BETA);
+        const double Wi_m = 1.0 / (2.0 * (static_cast<double>(Nx) + lambda));
+        const double scale = std::sqrt(static_cast<double>(Nx) + lambda);
+
+        state_matrix Sm_post;
+        fixed_chol_lower<Nx>(P_x_post, Sm_post);
+
+        // Propagate and evaluate sigma points
+        std::array<state_vector, np> Xi_pred;
+        Xi_pred[0] = transition_fcn(x_post);
+        state_vector Xi_post;
+        for (int j = 0; j < Nx; j++)
+            {
+                for (int i = 0; i < Nx; i++)
+                    {
+                        Xi_post[i] = x_post[i] + scale * Sm_post[i * Nx + j];
+                    }
+                Xi_pred[1 + j] = transition_fcn(Xi_post);
+                for (int i = 0; i < Nx; i++)
+                    {
+                        Xi_post[i] = x_post[i] - scale * Sm_post[i * Nx + j];
+                    }
+                Xi_pred[1 + Nx + j] = transition_fcn(Xi_post);
+            }
+
+        // Compute predicted mean
+        state_vector x_pred;
+        for (int i = 0; i < Nx; i++)
+            {
+                double acc = W0_m * Xi_pred[0][i];
+                for (int p = 1; p < np; p++)
+                    {
+                        acc += Wi_m * Xi_pred[p][i];
+                    }
+                x_pred[i] = acc;
+            }
+
+        // Compute predicted error covariance
+        state_matrix P_x_pred;
+        for (int i = 0; i < Nx; i++)
+            {
+                for (int j = 0; j < Nx; j++)
+                    {
+                        double acc = W0_c * (Xi_pred[0][i] - x_pred[i]) * (Xi_pred[0][j] - x_pred[j]);
+                        for (int p = 1; p < np; p++)
+                            {
+                                acc += Wi_m * (Xi_pred[p][i] - x_pred[i]) * (Xi_pred[p][j] - x_pred[j]);
+                            }
+                        P_x_pred[i * Nx + j] = acc + noise_covariance[i * Nx + j];
+                    }
+            }
+
+        inner.x_pred_out = x_pred;
+        inner.P_x_pred_out = P_x_pred;
+    }
+
+    /*
+     * Perform the update step of the Unscented Kalman filter
+     */
+    template <int Nz, typename MeasurementFunction>
+    void update_sequential(const std::array<double, Nz>& z_upd, const state_vector& x_pred, const state_matrix& P_x_pred, MeasurementFunction&& measurement_fcn, const std::array<double, Nz * Nz>& noise_covariance)
+    {
+        constexpr int np = 2 * Nx + 1;
+        const double lambda = compute_lambda();
+        const double W0_m = lambda / (static_cast<double>(Nx) + lambda);
+        const double W0_c = W0_m + (1.0 - ALPHA * ALPHA + BETA);
+        const double Wi_m = 1.0 / (2.0 * (static_cast<double>(Nx) + lambda));
+        const double scale = std::sqrt(static_cast<double>(Nx) + lambda);
+
+        state_matrix Sm_pred;
+        fixed_chol_lower<Nx>(P_x_pred, Sm_pred);
+
+        // Propagate and evaluate sigma points
+        std::array<state_vector, np> Xi_pred;
+        std::array<std::array<double, Nz>, np> Zi_pred;
+        Xi_pred[0] = x_pred;
+        Zi_pred[0] = measurement_fcn(x_pred);
+        for (int j = 0; j < Nx; j++)
+            {
+                for (int i = 0; i < Nx; i++)
+                    {
+                        Xi_pred[1 + j][i] = x_pred[i] + scale * Sm_pred[i * Nx + j];
+                        Xi_pred[1 + Nx + j][i] = x_pred[i] - scale * Sm_pred[i * Nx + j];
+                    }
+                Zi_pred[1 + j] = measurement_fcn(Xi_pred[1 + j]);
+                Zi_pred[1 + Nx + j] = measurement_fcn(Xi_pred[1 + Nx + j]);
+            }
+
+        // Compute measurement mean
+        std::array<double, Nz> z_pred;
+        for (int i = 0; i < Nz; i++)
+            {
+                double acc = W0_m * Zi_pred[0][i];
+                for (int p = 1; p < np; p++)
+                    {
+                        acc += Wi_m * Zi_pred[p][i];
+                    }
+                z_pred[i] = acc;
+            }
+
+        // Compute measurement covariance and cross covariance
+        std::array<double, Nz * Nz> P_zz_pred;
+        std::array<double, Nx * Nz> P_xz_pred;
+        for (int i = 0; i < Nz; i++)
+            {
+                for (int j = 0; j < Nz; j++)
+                    {
+                        double acc = W0_c * (Zi_pred[0][i] - z_pred[i]) * (Zi_pred[0][j] - z_pred[j]);
+                        for (int p = 1; p < np; p++)
+                            {
+                                acc += Wi_m * (Zi_pred[p][i] - z_pred[i]) * (Zi_pred[p][j] - z_pred[j]);
+                            }
+                        P_zz_pred[i * Nz + j] = acc + noise_covariance[i * Nz + j];
+                    }
+            }
+        for (int i = 0; i < Nx; i++)
+            {
+                for (int j = 0; j < Nz; j++)
+                    {
+                        double acc = W0_c * (Xi_pred[0][i] - x_pred[i]) * (Zi_pred[0][j] - z_pred[j]);
+                        for (int p = 1; p < np; p++)
+                            {
+                                acc += Wi_m * (Xi_pred[p][i] - x_pred[i]) * (Zi_pred[p][j] - z_pred[j]);
+                            }
+                        P_xz_pred[i * Nz + j] = acc;
+                    }
+            }
+
+        inner.template apply_gain<Nz>(z_upd, z_pred, P_zz_pred, P_xz_pred, x_pred, P_x_pred);
+    }
+
+    // Getters
+    const state_vector& get_x_pred() const
+    {
+        return inner.get_x_pred();
+    }
+
+    const state_matrix& get_P_x_pred() const
+    {
+        return inner.get_P_x_pred();
+    }
+
+    const state_vector& get_x_est() const
+    {
+        return inner.get_x_est();
+    }
+
+    const state_matrix& get_P_x_est() const
+    {
+        return inner.get_P_x_est();
+    }
+
+private:
+    static constexpr double ALPHA = 0.001;
+    static constexpr double KAPPA = 0.0;
+    static constexpr double BETA = 2.0;
+
+    static double compute_lambda()
+    {
+        return ALPHA * ALPHA * (static_cast<double>(Nx) + KAPPA) - static_cast<double>(Nx);
+    }
+
+    // The gain computation and the storage of the estimates are identical to
+    // the cubature case, so they are reused from CubatureFilterFixed
+    CubatureFilterFixed<Nx> inner;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_NONLINEAR_TRACKING_FIXED_H
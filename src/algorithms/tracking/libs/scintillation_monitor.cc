@@ -0,0 +1,158 @@
+/*!
+ * \file scintillation_monitor.cc
+ * \brief Computes scintillation indices from the tracking prompt correlator
+ * and streams them over UDP.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "scintillation_monitor.h"
+#include <glog/logging.h>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+
+void Scintillation_Monitor::init(const std::string& address, uint16_t port, double window_s)
+{
+    if (window_s > 0.0)
+        {
+            d_window_s = window_s;
+        }
+    d_io_context = std::make_unique<b_sc_io_context>();
+    d_socket = std::make_unique<boost::asio::ip::udp::socket>(*d_io_context);
+    boost::system::error_code ec;
+    d_endpoint = boost::asio::ip::udp::endpoint(boost::asio::ip::address::from_string(address, ec), port);
+    if (ec)
+        {
+            LOG(WARNING) << "Invalid scintillation monitor address " << address << ": " << ec.message();
+            return;
+        }
+    d_socket->open(d_endpoint.protocol(), ec);
+    if (ec)
+        {
+            LOG(WARNING) << "Could not open scintillation monitor socket: " << ec.message();
+            return;
+        }
+    d_enabled = true;
+    LOG(INFO) << "Scintillation indices will be published to " << address << ":" << port
+              << " every " << d_window_s << " s";
+}
+
+
+void Scintillation_Monitor::start(uint32_t channel_id, char system, const char signal[3], uint32_t prn)
+{
+    d_channel_id = channel_id;
+    d_system = system;
+    d_signal[0] = signal[0];
+    d_signal[1] = signal[1];
+    d_signal[2] = '\0';
+    d_prn = prn;
+    reset_window();
+}
+
+
+void Scintillation_Monitor::push(double prompt_mag, double carrier_phase_rad, double cn0_db_hz, double t_int_s)
+{
+    if (!d_enabled)
+        {
+            return;
+        }
+    const double intensity = prompt_mag * prompt_mag;
+    const double t = d_elapsed_s;
+    d_sum_i += intensity;
+    d_sum_i2 += intensity * intensity;
+    d_sum_t += t;
+    d_sum_t2 += t * t;
+    d_sum_p += carrier_phase_rad;
+    d_sum_tp += t * carrier_phase_rad;
+    d_sum_p2 += carrier_phase_rad * carrier_phase_rad;
+    d_sum_cn0 += cn0_db_hz;
+    d_epochs++;
+    d_elapsed_s += t_int_s;
+    if (d_elapsed_s >= d_window_s)
+        {
+            publish();
+            reset_window();
+        }
+}
+
+
+void Scintillation_Monitor::publish()
+{
+    if (d_epochs < 16)
+        {
+            return;  // not enough epochs for meaningful statistics
+        }
+    const auto n = static_cast<double>(d_epochs);
+
+    // S4: normalized intensity standard deviation
+    const double mean_i = d_sum_i / n;
+    double s4 = 0.0;
+    if (mean_i > 0.0)
+        {
+            const double var_i = d_sum_i2 / n - mean_i * mean_i;
+            s4 = var_i > 0.0 ? std::sqrt(var_i) / mean_i : 0.0;
+        }
+
+    // sigma-phi: phase standard deviation after removing the linear trend
+    // (Doppler and clock drift); all terms come from the running sums
+    const double stt = d_sum_t2 - d_sum_t * d_sum_t / n;
+    double sigma_phi = 0.0;
+    if (stt > 0.0)
+        {
+            const double stp = d_sum_tp - d_sum_t * d_sum_p / n;
+            const double spp = d_sum_p2 - d_sum_p * d_sum_p / n;
+            const double residual = spp - stp * stp / stt;
+            sigma_phi = residual > 0.0 ? std::sqrt(residual / n) : 0.0;
+        }
+
+    Scintillation_Report report{};
+    report.magic = 0x5343494E;  // "SCIN"
+    report.version = 1;
+    report.system = d_system;
+    report.signal[0] = d_signal[0];
+    report.signal[1] = d_signal[1];
+    report.prn = d_prn;
+    report.channel_id = d_channel_id;
+    report.epochs = d_epochs;
+    report.window_s = d_elapsed_s;
+    report.s4 = s4;
+    report.sigma_phi_rad = sigma_phi;
+    report.cn0_db_hz_mean = d_sum_cn0 / n;
+    report.host_time_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+
+    boost::system::error_code ec;
+    d_socket->send_to(boost::asio::buffer(&report, sizeof(report)), d_endpoint, 0, ec);
+    if (ec)
+        {
+            LOG(WARNING) << "Failed to publish scintillation report: " << ec.message();
+        }
+}
+
+
+void Scintillation_Monitor::reset_window()
+{
+    d_sum_i = 0.0;
+    d_sum_i2 = 0.0;
+    d_sum_t = 0.0;
+    d_sum_t2 = 0.0;
+    d_sum_p = 0.0;
+    d_sum_tp = 0.0;
+    d_sum_p2 = 0.0;
+    d_sum_cn0 = 0.0;
+    d_elapsed_s = 0.0;
+    d_epochs = 0;
+}
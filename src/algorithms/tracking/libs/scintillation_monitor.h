@@ -0,0 +1,116 @@
+/*!
+ * \file scintillation_monitor.h
+ * \brief Computes scintillation indices from the tracking prompt correlator
+ * and streams them over UDP.
+ *
+ * Monitoring stations need S4 and sigma-phi but not the raw tracking dumps
+ * they are derived from. This class accumulates the 50 Hz (or faster) prompt
+ * amplitude and carrier phase with constant-memory running sums and, once
+ * per window, emits one small datagram with the indices — kilobytes per day
+ * instead of the gigabytes of the full dump path.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SCINTILLATION_MONITOR_H
+#define GNSS_SDR_SCINTILLATION_MONITOR_H
+
+#include <boost/asio.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+#if USE_BOOST_ASIO_IO_CONTEXT
+using b_sc_io_context = boost::asio::io_context;
+#else
+using b_sc_io_context = boost::asio::io_service;
+#endif
+
+/*!
+ * \brief One scintillation report datagram. Native byte order.
+ */
+struct Scintillation_Report
+{
+    uint32_t magic;    //!< "SCIN" = 0x5343494E
+    uint8_t version;   //!< format version, currently 1
+    char system;       //!< constellation of the tracked signal
+    char signal[2];    //!< signal identifier, e.g. "1C"
+    uint32_t prn;
+    uint32_t channel_id;
+    uint32_t epochs;        //!< integration epochs in this window
+    double window_s;        //!< effective window length [s]
+    double s4;              //!< amplitude scintillation index
+    double sigma_phi_rad;   //!< phase scintillation index, linear detrend [rad]
+    double cn0_db_hz_mean;  //!< mean C/N0 over the window
+    uint64_t host_time_ns;  //!< wall-clock time at window end
+};
+
+/*!
+ * \brief Per-channel scintillation index accumulator.
+ *
+ * S4 is the normalized standard deviation of the prompt signal intensity;
+ * sigma-phi is the standard deviation of the carrier phase after removing a
+ * linear trend (Doppler and drift) over the window. Both are maintained with
+ * running sums, so the cost per integration epoch is O(1) and no sample
+ * history is kept.
+ */
+class Scintillation_Monitor
+{
+public:
+    Scintillation_Monitor() = default;
+
+    //! Opens the UDP socket; indices are streamed to address:port
+    void init(const std::string& address, uint16_t port, double window_s);
+
+    //! Identifies the tracked signal in the reports; resets the window
+    void start(uint32_t channel_id, char system, const char signal[3], uint32_t prn);
+
+    //! Accumulates one integration epoch of the prompt correlator
+    void push(double prompt_mag, double carrier_phase_rad, double cn0_db_hz, double t_int_s);
+
+private:
+    void publish();
+    void reset_window();
+
+    std::unique_ptr<b_sc_io_context> d_io_context;
+    std::unique_ptr<boost::asio::ip::udp::socket> d_socket;
+    boost::asio::ip::udp::endpoint d_endpoint;
+
+    // running sums over the current window
+    double d_sum_i = 0.0;    // intensity
+    double d_sum_i2 = 0.0;
+    double d_sum_t = 0.0;    // time and phase, for the linear detrend
+    double d_sum_t2 = 0.0;
+    double d_sum_p = 0.0;
+    double d_sum_tp = 0.0;
+    double d_sum_p2 = 0.0;
+    double d_sum_cn0 = 0.0;
+    double d_elapsed_s = 0.0;
+    double d_window_s = 60.0;
+    uint32_t d_epochs = 0;
+    uint32_t d_channel_id = 0;
+    uint32_t d_prn = 0;
+    char d_system = 'G';
+    char d_signal[3] = "1C";
+    bool d_enabled = false;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SCINTILLATION_MONITOR_H
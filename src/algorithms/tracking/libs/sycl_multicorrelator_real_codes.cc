@@ -0,0 +1,252 @@
+/*!
+ * \file sycl_multicorrelator_real_codes.cc
+ * \brief SYCL vector multiTAP correlator class using real-valued local codes
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "sycl_multicorrelator_real_codes.h"
+#include <CL/sycl.hpp>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+// number of partial accumulators per correlator tap; one work-group reduces
+// its partials in local memory and a final host-side sum of this many values
+// is negligible
+constexpr int SYCL_MC_ACCUM_N = 128;
+}  // namespace
+
+
+struct Sycl_Multicorrelator_Real_Codes::Impl
+{
+    cl::sycl::queue queue;
+
+    // device-resident data
+    cl::sycl::float2* sig_in_dev = nullptr;
+    float* local_code_dev = nullptr;
+    float* shifts_chips_dev = nullptr;
+    // partial accumulators, in shared USM so the host reads them directly
+    cl::sycl::float2* partial_sums = nullptr;
+
+    // host pointers handed over by the tracking block
+    const std::complex<float>* sig_in = nullptr;
+    std::complex<float>* corr_out = nullptr;
+
+    int max_signal_length_samples = 0;
+    int code_length_chips = 0;
+    int n_correlators = 0;
+    bool use_high_dynamics_resampler = true;
+};
+
+
+Sycl_Multicorrelator_Real_Codes::Sycl_Multicorrelator_Real_Codes()
+    : d_impl(std::make_unique<Impl>())
+{
+    try
+        {
+            d_impl->queue = cl::sycl::queue(cl::sycl::default_selector());
+        }
+    catch (const cl::sycl::exception& e)
+        {
+            throw std::runtime_error(std::string("No SYCL device available: ") + e.what());
+        }
+}
+
+
+Sycl_Multicorrelator_Real_Codes::~Sycl_Multicorrelator_Real_Codes()
+{
+    if (d_impl->sig_in_dev != nullptr)
+        {
+            Sycl_Multicorrelator_Real_Codes::free();
+        }
+}
+
+
+std::string Sycl_Multicorrelator_Real_Codes::device_name() const
+{
+    return d_impl->queue.get_device().get_info<cl::sycl::info::device::name>();
+}
+
+
+void Sycl_Multicorrelator_Real_Codes::set_high_dynamics_resampler(bool use_high_dynamics_resampler)
+{
+    d_impl->use_high_dynamics_resampler = use_high_dynamics_resampler;
+}
+
+
+bool Sycl_Multicorrelator_Real_Codes::init(int max_signal_length_samples, int n_correlators)
+{
+    d_impl->max_signal_length_samples = max_signal_length_samples;
+    d_impl->n_correlators = n_correlators;
+    d_impl->sig_in_dev = cl::sycl::malloc_device<cl::sycl::float2>(max_signal_length_samples, d_impl->queue);
+    d_impl->shifts_chips_dev = cl::sycl::malloc_device<float>(n_correlators, d_impl->queue);
+    d_impl->partial_sums = cl::sycl::malloc_shared<cl::sycl::float2>(n_correlators * SYCL_MC_ACCUM_N, d_impl->queue);
+    return (d_impl->sig_in_dev != nullptr) and (d_impl->shifts_chips_dev != nullptr) and (d_impl->partial_sums != nullptr);
+}
+
+
+bool Sycl_Multicorrelator_Real_Codes::set_local_code_and_taps(int code_length_chips, const float* local_code_in, float* shifts_chips)
+{
+    if (code_length_chips > d_impl->code_length_chips)
+        {
+            if (d_impl->local_code_dev != nullptr)
+                {
+                    cl::sycl::free(d_impl->local_code_dev, d_impl->queue);
+                }
+            d_impl->local_code_dev = cl::sycl::malloc_device<float>(code_length_chips, d_impl->queue);
+        }
+    d_impl->code_length_chips = code_length_chips;
+    d_impl->queue.memcpy(d_impl->local_code_dev, local_code_in, code_length_chips * sizeof(float));
+    d_impl->queue.memcpy(d_impl->shifts_chips_dev, shifts_chips, d_impl->n_correlators * sizeof(float));
+    d_impl->queue.wait();
+    return true;
+}
+
+
+bool Sycl_Multicorrelator_Real_Codes::set_input_output_vectors(std::complex<float>* corr_out, const std::complex<float>* sig_in)
+{
+    d_impl->sig_in = sig_in;
+    d_impl->corr_out = corr_out;
+    return true;
+}
+
+
+bool Sycl_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float phase_rate_step_rad,
+    float rem_code_phase_chips,
+    float code_phase_step_chips,
+    float code_phase_rate_step_chips,
+    int signal_length_samples)
+{
+    Impl* impl = d_impl.get();
+
+    // upload the epoch; the kernel below is queued behind the copy
+    impl->queue.memcpy(impl->sig_in_dev, impl->sig_in, signal_length_samples * sizeof(cl::sycl::float2));
+
+    cl::sycl::float2* sig = impl->sig_in_dev;
+    const float* code = impl->local_code_dev;
+    const float* shifts = impl->shifts_chips_dev;
+    cl::sycl::float2* partials = impl->partial_sums;
+    const int code_length = impl->code_length_chips;
+    const int n_correlators = impl->n_correlators;
+
+    // one work-group per correlator tap: the carrier wipe-off and the local
+    // code resampling are computed on the fly, so no intermediate vector
+    // touches device memory and the raw samples are read exactly once per tap
+    impl->queue.submit([&](cl::sycl::handler& cgh) {
+        cl::sycl::accessor<cl::sycl::float2, 1, cl::sycl::access::mode::read_write, cl::sycl::access::target::local>
+            local_acc(cl::sycl::range<1>(SYCL_MC_ACCUM_N), cgh);
+        cgh.parallel_for(
+            cl::sycl::nd_range<1>(cl::sycl::range<1>(n_correlators * SYCL_MC_ACCUM_N),
+                cl::sycl::range<1>(SYCL_MC_ACCUM_N)),
+            [=](cl::sycl::nd_item<1> item) {
+                const int tap = static_cast<int>(item.get_group(0));
+                const int lane = static_cast<int>(item.get_local_id(0));
+
+                float acc_re = 0.0F;
+                float acc_im = 0.0F;
+                for (int n = lane; n < signal_length_samples; n += SYCL_MC_ACCUM_N)
+                    {
+                        const float fn = static_cast<float>(n);
+                        // carrier wipe-off, NCO computed on the fly
+                        const float phase = rem_carrier_phase_in_rad + phase_step_rad * fn + phase_rate_step_rad * fn * fn;
+                        const float c = cl::sycl::cos(phase);
+                        const float s = cl::sycl::sin(phase);
+                        // local code resampling for this tap
+                        float chip_idx = cl::sycl::fmod(code_phase_step_chips * fn + code_phase_rate_step_chips * fn * fn + shifts[tap] - rem_code_phase_chips,
+                            static_cast<float>(code_length));
+                        if (chip_idx < 0.0F)
+                            {
+                                chip_idx += static_cast<float>(code_length);
+                            }
+                        const float code_value = code[static_cast<int>(chip_idx)];
+                        const cl::sycl::float2 x = sig[n];
+                        // x * exp(-j*phase) * code
+                        acc_re += (x.x() * c + x.y() * s) * code_value;
+                        acc_im += (x.y() * c - x.x() * s) * code_value;
+                    }
+                local_acc[lane] = cl::sycl::float2(acc_re, acc_im);
+
+                // tree reduction inside the work-group
+                for (int stride = SYCL_MC_ACCUM_N / 2; stride > 0; stride >>= 1)
+                    {
+                        item.barrier(cl::sycl::access::fence_space::local_space);
+                        if (lane < stride)
+                            {
+                                const cl::sycl::float2 other = local_acc[lane + stride];
+                                local_acc[lane] = cl::sycl::float2(local_acc[lane].x() + other.x(),
+                                    local_acc[lane].y() + other.y());
+                            }
+                    }
+                if (lane == 0)
+                    {
+                        partials[tap] = local_acc[0];
+                    }
+            });
+    });
+    impl->queue.wait();
+
+    for (int tap = 0; tap < n_correlators; tap++)
+        {
+            impl->corr_out[tap] = std::complex<float>(partials[tap].x(), partials[tap].y());
+        }
+    return true;
+}
+
+
+bool Sycl_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float rem_code_phase_chips,
+    float code_phase_step_chips,
+    float code_phase_rate_step_chips,
+    int signal_length_samples)
+{
+    return Carrier_wipeoff_multicorrelator_resampler(rem_carrier_phase_in_rad,
+        phase_step_rad,
+        0.0F,
+        rem_code_phase_chips,
+        code_phase_step_chips,
+        d_impl->use_high_dynamics_resampler ? code_phase_rate_step_chips : 0.0F,
+        signal_length_samples);
+}
+
+
+bool Sycl_Multicorrelator_Real_Codes::free()
+{
+    Impl* impl = d_impl.get();
+    if (impl->sig_in_dev != nullptr)
+        {
+            cl::sycl::free(impl->sig_in_dev, impl->queue);
+            impl->sig_in_dev = nullptr;
+        }
+    if (impl->local_code_dev != nullptr)
+        {
+            cl::sycl::free(impl->local_code_dev, impl->queue);
+            impl->local_code_dev = nullptr;
+        }
+    if (impl->shifts_chips_dev != nullptr)
+        {
+            cl::sycl::free(impl->shifts_chips_dev, impl->queue);
+            impl->shifts_chips_dev = nullptr;
+        }
+    if (impl->partial_sums != nullptr)
+        {
+            cl::sycl::free(impl->partial_sums, impl->queue);
+            impl->partial_sums = nullptr;
+        }
+    return true;
+}
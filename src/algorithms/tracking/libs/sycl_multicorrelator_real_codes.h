@@ -0,0 +1,70 @@
+/*!
+ * \file sycl_multicorrelator_real_codes.h
+ * \brief SYCL vector multiTAP correlator class using real-valued local codes
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * Accelerator backend for Cpu_Multicorrelator_Real_Codes targeting SYCL
+ * devices (Intel integrated GPUs through oneAPI, and any other device with a
+ * SYCL runtime). It mirrors the CPU class interface so the tracking blocks
+ * can delegate to it without changing their hot loop.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SYCL_MULTICORRELATOR_REAL_CODES_H
+#define GNSS_SDR_SYCL_MULTICORRELATOR_REAL_CODES_H
+
+#include <complex>
+#include <memory>
+#include <string>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Class that implements carrier wipe-off and correlators on a SYCL device.
+ *
+ * The local code is resampled on the fly inside the correlation kernel, so
+ * only the raw code chips are uploaded (once per satellite retarget) and only
+ * the correlator outputs travel back per epoch. The SYCL headers stay out of
+ * this header on purpose: the class body lives behind an opaque
+ * implementation so that including files do not need the SYCL compiler.
+ */
+class Sycl_Multicorrelator_Real_Codes
+{
+public:
+    //! Throws std::runtime_error if no SYCL device is available
+    Sycl_Multicorrelator_Real_Codes();
+    ~Sycl_Multicorrelator_Real_Codes();
+
+    void set_high_dynamics_resampler(bool use_high_dynamics_resampler);
+    bool init(int max_signal_length_samples, int n_correlators);
+    bool set_local_code_and_taps(int code_length_chips, const float* local_code_in, float* shifts_chips);
+    bool set_input_output_vectors(std::complex<float>* corr_out, const std::complex<float>* sig_in);
+    bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
+    bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
+    bool free();
+
+    //! Name of the selected SYCL device, for logging
+    std::string device_name() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> d_impl;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SYCL_MULTICORRELATOR_REAL_CODES_H
@@ -0,0 +1,83 @@
+/*!
+ * \file tracking_hot_state.h
+ * \brief Cache-line-aligned container for the per-sample tracking loop state.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_HOT_STATE_H
+#define GNSS_SDR_TRACKING_HOT_STATE_H
+
+#include <gnuradio/gr_complex.h>  // for gr_complex
+#include <cstdint>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief State touched by the tracking loop on every correlate-update
+ * iteration: NCO phases and steps, loop outputs and correlator
+ * accumulators.
+ *
+ * Keeping this set packed in consecutive cache lines, instead of spread
+ * across the tracking block object between cold configuration and dump
+ * members, keeps the correlate-update working set to a handful of lines
+ * and makes it cheap to prefetch before entering the loop.
+ */
+struct alignas(64) Tracking_Hot_State
+{
+    // carrier and code NCO state
+    double carrier_phase_step_rad;
+    double carrier_phase_rate_step_rad;
+    double code_phase_step_chips;
+    double code_phase_rate_step_chips;
+    double rem_code_phase_chips;
+    double rem_code_phase_samples;
+
+    // loop filter outputs
+    double carrier_doppler_hz;
+    double code_freq_chips;
+    double acc_carrier_phase_rad;
+
+    // correlator accumulators
+    gr_complex VE_accu;
+    gr_complex E_accu;
+    gr_complex P_accu;
+    gr_complex P_accu_old;
+    gr_complex L_accu;
+    gr_complex VL_accu;
+    gr_complex P_data_accu;
+
+    float rem_carr_phase_rad;
+    int32_t current_prn_length_samples;
+};
+
+static_assert(sizeof(Tracking_Hot_State) <= 3 * 64, "Tracking_Hot_State must stay within three cache lines");
+
+
+//! Pulls the hot tracking state into cache before entering the loop
+inline void tracking_hot_state_prefetch(const Tracking_Hot_State* state)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(state);
+    __builtin_prefetch(reinterpret_cast<const char*>(state) + 64);
+    __builtin_prefetch(reinterpret_cast<const char*>(state) + 128);
+#endif
+}
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_HOT_STATE_H
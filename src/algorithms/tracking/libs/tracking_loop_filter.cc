@@ -38,6 +38,10 @@ Tracking_loop_filter::Tracking_loop_filter(float update_interval,
 {
     d_inputs.resize(MAX_LOOP_HISTORY_LENGTH, 0.0);
     d_outputs.resize(MAX_LOOP_HISTORY_LENGTH, 0.0);
+    // reserve the maximum order up front so later reconfigurations
+    // (e.g. switching to the narrow bandwidths) do not allocate
+    d_input_coefficients.reserve(MAX_LOOP_ORDER);
+    d_output_coefficients.reserve(MAX_LOOP_ORDER);
     update_coefficients();
 }
 
@@ -51,6 +55,10 @@ Tracking_loop_filter::Tracking_loop_filter()
 {
     d_inputs.resize(MAX_LOOP_HISTORY_LENGTH, 0.0);
     d_outputs.resize(MAX_LOOP_HISTORY_LENGTH, 0.0);
+    // reserve the maximum order up front so later reconfigurations
+    // (e.g. switching to the narrow bandwidths) do not allocate
+    d_input_coefficients.reserve(MAX_LOOP_ORDER);
+    d_output_coefficients.reserve(MAX_LOOP_ORDER);
     update_coefficients();
 }
 
@@ -60,6 +60,12 @@ public:
     {
         return;
     }
+    //! Arm the diagnostic export for the next n attempts. No-op for
+    //! implementations without diagnostic support
+    virtual void arm_diagnostics(unsigned int n_attempts __attribute__((unused)))
+    {
+        return;
+    }
     virtual void init() = 0;
     virtual void set_local_code() = 0;
     virtual void set_state(int state) = 0;
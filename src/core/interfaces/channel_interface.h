@@ -25,6 +25,7 @@
 
 #include "gnss_block_interface.h"
 #include "gnss_signal.h"
+#include <string>
 
 /** \addtogroup Core
  * \{ */
@@ -54,6 +55,14 @@ public:
     virtual void assist_acquisition_doppler(double Carrier_Doppler_hz) = 0;
     virtual void stop_channel() = 0;
     virtual void set_signal(const Gnss_Signal&) = 0;
+    virtual bool set_runtime_parameter(const std::string& name __attribute__((unused)), double value __attribute__((unused)))
+    {
+        return false;
+    }
+    virtual bool get_runtime_parameter(const std::string& name __attribute__((unused)), double* value __attribute__((unused)))
+    {
+        return false;
+    }
 };
 
 
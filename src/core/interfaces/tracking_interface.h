@@ -25,6 +25,7 @@
 
 #include "gnss_block_interface.h"
 #include "gnss_synchro.h"
+#include <string>
 
 /** \addtogroup Core
  * \{ */
@@ -51,6 +52,14 @@ public:
     virtual void stop_tracking() = 0;
     virtual void set_gnss_synchro(Gnss_Synchro* gnss_synchro) = 0;
     virtual void set_channel(unsigned int channel) = 0;
+    virtual bool set_runtime_parameter(const std::string& name __attribute__((unused)), double value __attribute__((unused)))
+    {
+        return false;
+    }
+    virtual bool get_runtime_parameter(const std::string& name __attribute__((unused)), double* value __attribute__((unused)))
+    {
+        return false;
+    }
 };
 
 
@@ -62,6 +62,12 @@ int64_t INIReader::GetInteger(const std::string& section, const std::string& nam
 }
 
 
+const std::map<std::string, std::string>& INIReader::Values() const
+{
+    return _values;
+}
+
+
 std::string INIReader::MakeKey(const std::string& section, const std::string& name)
 {
     std::string key = section + "." + name;
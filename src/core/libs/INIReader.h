@@ -58,6 +58,9 @@ public:
     //! Get an integer (long) value from INI file, returning default_value if not found.
     int64_t GetInteger(const std::string& section, const std::string& name, int64_t default_value);
 
+    //! All parsed name/value pairs, keyed by the lower-cased "section.name".
+    const std::map<std::string, std::string>& Values() const;
+
 private:
     static std::string MakeKey(const std::string& section, const std::string& name);
     static int ValueHandler(void* user, const char* section, const char* name,
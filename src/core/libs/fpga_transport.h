@@ -0,0 +1,105 @@
+/*!
+ * \file fpga_transport.h
+ * \brief Interface of a transport between the host and an FPGA accelerator.
+ * \author Marc Majoral, 2020. mmajoral(at)cttc.es
+ *
+ * A transport gives access to the register map of a hardware accelerator,
+ * signals the completion of an operation, and owns a preallocated ring of
+ * DMA buffers. The blocks that drive an accelerator (e.g. the FPGA
+ * multicorrelator) program it through this interface only, so a different
+ * board plugs in by providing another implementation.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_FPGA_TRANSPORT_H
+#define GNSS_SDR_FPGA_TRANSPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library
+ * \{ */
+
+
+/*!
+ * \brief Abstract transport between the host and an FPGA accelerator device.
+ */
+class Fpga_Transport
+{
+public:
+    virtual ~Fpga_Transport() = default;
+
+    /*!
+     * \brief Open the accelerator given its device name and device number.
+     * Returns 0 on success.
+     */
+    virtual int32_t open_device(const std::string &device_name, uint32_t device_num) = 0;
+
+    /*!
+     * \brief Open the accelerator given an already resolved device file name
+     * (e.g. /dev/uio3). Returns 0 on success.
+     */
+    virtual int32_t open_device_file(const std::string &device_file_name) = 0;
+
+    //! Close the accelerator and release its resources
+    virtual void close_device() = 0;
+
+    //! Memory-mapped register map of the accelerator
+    virtual volatile uint32_t *register_map() = 0;
+
+    //! Enable the completion notification of the next operation
+    virtual void arm_interrupt() = 0;
+
+    /*!
+     * \brief Block until the accelerator signals the completion of the
+     * current operation. Returns false on a device error.
+     */
+    virtual bool wait_for_completion() = 0;
+
+    /*!
+     * \brief Preallocate a ring of num_buffers DMA buffers of buffer_bytes
+     * each. Returns 0 on success.
+     */
+    virtual int32_t allocate_dma_ring(uint32_t num_buffers, size_t buffer_bytes) = 0;
+
+    //! Number of buffers of the DMA ring
+    virtual uint32_t dma_ring_buffers() const = 0;
+
+    //! Size of each DMA buffer, in bytes
+    virtual size_t dma_buffer_bytes() const = 0;
+
+    /*!
+     * \brief Next free buffer of the DMA ring, for the producer to fill.
+     * Returns nullptr when the ring is full.
+     */
+    virtual int8_t *claim_dma_buffer() = 0;
+
+    //! Publish the buffer obtained with claim_dma_buffer() to the consumer
+    virtual void commit_dma_buffer() = 0;
+
+    /*!
+     * \brief Oldest committed buffer of the DMA ring, for the consumer to
+     * drain. Returns nullptr when the ring is empty.
+     */
+    virtual const int8_t *front_dma_buffer() const = 0;
+
+    //! Return the buffer obtained with front_dma_buffer() to the free pool
+    virtual void release_dma_buffer() = 0;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_FPGA_TRANSPORT_H
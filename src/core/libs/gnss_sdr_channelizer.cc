@@ -0,0 +1,260 @@
+/*!
+ * \file gnss_sdr_channelizer.cc
+ * \brief Block that splits one wideband stream into several frequency bands
+ * sharing a single forward FFT.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_channelizer.h"
+#include "MATH_CONSTANTS.h"  // for TWO_PI
+#include "configuration_interface.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <cmath>
+#include <cstring>  // for memcpy
+#include <stdexcept>
+
+gnss_sdr_channelizer_sptr gnss_sdr_make_channelizer(
+    double fs_in,
+    int32_t fft_size,
+    const std::vector<Gnss_Sdr_Channelizer_Band>& bands)
+{
+    return gnss_sdr_channelizer_sptr(new gnss_sdr_channelizer(fs_in, fft_size, bands));
+}
+
+
+gnss_sdr_channelizer_sptr gnss_sdr_make_channelizer_from_conf(
+    const ConfigurationInterface* configuration,
+    const std::string& role,
+    int32_t nbands)
+{
+    const double fs_in = configuration->property(role + ".sampling_frequency", static_cast<double>(0.0));
+    if (fs_in <= 0.0)
+        {
+            throw std::invalid_argument("Set " + role + ".sampling_frequency to use the channelizer");
+        }
+    const int32_t fft_size = configuration->property(role + ".channelizer_fft_size", 4096);
+    std::vector<Gnss_Sdr_Channelizer_Band> bands(nbands);
+    for (int32_t j = 0; j < nbands; j++)
+        {
+            const std::string prefix = role + ".channelizer_band" + std::to_string(j);
+            bands[j].center_freq_hz = configuration->property(prefix + "_freq", static_cast<double>(0.0));
+            bands[j].decimation = configuration->property(prefix + "_decimation", 1);
+            // default cutoff: 80% of the output Nyquist frequency
+            const double default_cutoff = 0.4 * fs_in / static_cast<double>(bands[j].decimation);
+            bands[j].cutoff_hz = configuration->property(prefix + "_cutoff", default_cutoff);
+        }
+    return gnss_sdr_make_channelizer(fs_in, fft_size, bands);
+}
+
+
+gnss_sdr_channelizer::gnss_sdr_channelizer(double fs_in,
+    int32_t fft_size,
+    const std::vector<Gnss_Sdr_Channelizer_Band>& bands)
+    : gr::block("gnss_sdr_channelizer",
+          gr::io_signature::make(1, 1, sizeof(gr_complex)),
+          gr::io_signature::make(static_cast<int>(bands.size()), static_cast<int>(bands.size()), sizeof(gr_complex))),
+      d_fs_in(fs_in),
+      d_fft_size(fft_size)
+{
+    if (bands.empty())
+        {
+            throw std::invalid_argument("Channelizer needs at least one band");
+        }
+    if ((d_fft_size < 64) or ((d_fft_size % 4) != 0))
+        {
+            throw std::invalid_argument("Channelizer FFT size must be >= 64 and a multiple of 4");
+        }
+    d_overlap = d_fft_size / 4;
+    d_hop = d_fft_size - d_overlap;
+
+    d_fft = std::make_unique<gr::fft::fft_complex>(d_fft_size, true);
+
+    int32_t min_decimation = bands[0].decimation;
+    d_bands.resize(bands.size());
+    for (size_t j = 0; j < bands.size(); j++)
+        {
+            const Gnss_Sdr_Channelizer_Band& conf = bands[j];
+            Band_State& band = d_bands[j];
+            if (conf.decimation < 1)
+                {
+                    throw std::invalid_argument("Channelizer band decimation must be >= 1");
+                }
+            if ((d_overlap % conf.decimation) != 0)
+                {
+                    throw std::invalid_argument("Channelizer band decimation must divide fft_size / 4");
+                }
+            if ((conf.cutoff_hz <= 0.0) or (conf.cutoff_hz > 0.5 * fs_in / static_cast<double>(conf.decimation)))
+                {
+                    throw std::invalid_argument("Channelizer band cutoff must lie inside the decimated bandwidth");
+                }
+            band.decimation = conf.decimation;
+            band.out_size = d_fft_size / conf.decimation;
+            band.out_per_hop = d_hop / conf.decimation;
+            band.ifft = std::make_unique<gr::fft::fft_complex>(band.out_size, false);
+            band.folded.resize(band.out_size);
+
+            // integer-bin part of the frequency translation, applied in the
+            // frequency domain; the sub-bin remainder is removed by a rotator
+            // at the decimated rate
+            const int64_t bin = std::lround(conf.center_freq_hz / fs_in * static_cast<double>(d_fft_size));
+            const double residual_hz = conf.center_freq_hz - static_cast<double>(bin) * fs_in / static_cast<double>(d_fft_size);
+            band.center_bin = static_cast<int32_t>(((bin % d_fft_size) + d_fft_size) % d_fft_size);
+            const double phase_step = -TWO_PI * residual_hz * static_cast<double>(band.decimation) / fs_in;
+            band.rotator_increment = gr_complex(static_cast<float>(std::cos(phase_step)), static_cast<float>(std::sin(phase_step)));
+            band.rotator_phase = gr_complex(1.0F, 0.0F);
+
+            // the frequency-domain shift is relative to each window start, so
+            // hops need an extra phase step to keep the translation coherent
+            // from one window to the next; the first window starts one overlap
+            // before the first input sample
+            const int64_t hop_shift = (static_cast<int64_t>(band.center_bin) * static_cast<int64_t>(d_hop)) % static_cast<int64_t>(d_fft_size);
+            const double hop_phase_step = -TWO_PI * static_cast<double>(hop_shift) / static_cast<double>(d_fft_size);
+            band.hop_increment = gr_complex(static_cast<float>(std::cos(hop_phase_step)), static_cast<float>(std::sin(hop_phase_step)));
+            const int64_t init_shift = (static_cast<int64_t>(band.center_bin) * static_cast<int64_t>(d_overlap)) % static_cast<int64_t>(d_fft_size);
+            const double init_phase = TWO_PI * static_cast<double>(init_shift) / static_cast<double>(d_fft_size);
+            band.hop_phase = gr_complex(static_cast<float>(std::cos(init_phase)), static_cast<float>(std::sin(init_phase)));
+
+            // Hamming-windowed sinc lowpass modulated to the sub-bin frequency
+            // remainder (so the passband sits exactly on the requested center)
+            // and transformed once with the shared FFT. Filter length =
+            // overlap + 1 so the circular convolution is exact after
+            // discarding the overlap region of every hop
+            const int32_t ntaps = d_overlap + 1;
+            const double fc = conf.cutoff_hz / fs_in;
+            std::vector<double> taps(ntaps);
+            double taps_sum = 0.0;
+            for (int32_t n = 0; n < ntaps; n++)
+                {
+                    const double m = static_cast<double>(n) - static_cast<double>(ntaps - 1) / 2.0;
+                    const double sinc = (m == 0.0) ? 2.0 * fc : std::sin(TWO_PI * fc * m) / (GNSS_PI * m);
+                    const double window = 0.54 - 0.46 * std::cos(TWO_PI * static_cast<double>(n) / static_cast<double>(ntaps - 1));
+                    taps[n] = sinc * window;
+                    taps_sum += taps[n];
+                }
+            gr_complex* fft_in = d_fft->get_inbuf();
+            std::fill_n(fft_in, d_fft_size, gr_complex(0.0F, 0.0F));
+            for (int32_t n = 0; n < ntaps; n++)
+                {
+                    const double mod_phase = TWO_PI * residual_hz * static_cast<double>(n) / fs_in;
+                    fft_in[n] = gr_complex(static_cast<float>(taps[n] / taps_sum * std::cos(mod_phase)),
+                        static_cast<float>(taps[n] / taps_sum * std::sin(mod_phase)));
+                }
+            d_fft->execute();
+            band.freq_response.resize(d_fft_size);
+            std::memcpy(band.freq_response.data(), d_fft->get_outbuf(), d_fft_size * sizeof(gr_complex));
+
+            if (conf.decimation < min_decimation)
+                {
+                    min_decimation = conf.decimation;
+                }
+            DLOG(INFO) << "Channelizer band " << j << ": center " << conf.center_freq_hz
+                       << " Hz (bin " << band.center_bin << ", residual " << residual_hz
+                       << " Hz), decimation " << band.decimation << ", cutoff " << conf.cutoff_hz << " Hz";
+        }
+
+    set_history(d_overlap + 1);
+    set_relative_rate(1.0 / static_cast<double>(min_decimation));
+    set_output_multiple(d_hop / min_decimation);
+}
+
+
+void gnss_sdr_channelizer::forecast(int noutput_items __attribute__((unused)), gr_vector_int& ninput_items_required)
+{
+    // enough input for one hop, counting the history samples
+    ninput_items_required[0] = d_fft_size;
+}
+
+
+void gnss_sdr_channelizer::extract_band(Band_State& band, gr_complex* out)
+{
+    const gr_complex* spectrum = d_fft->get_outbuf();
+    std::fill(band.folded.begin(), band.folded.end(), gr_complex(0.0F, 0.0F));
+
+    // multiply the shifted spectrum by the band response and fold the
+    // aliases of the decimated rate on the fly
+    int32_t k = band.center_bin;
+    int32_t m = 0;
+    for (int32_t n = 0; n < d_fft_size; n++)
+        {
+            band.folded[m] += spectrum[k] * band.freq_response[n];
+            k++;
+            if (k == d_fft_size)
+                {
+                    k = 0;
+                }
+            m++;
+            if (m == band.out_size)
+                {
+                    m = 0;
+                }
+        }
+
+    std::memcpy(band.ifft->get_inbuf(), band.folded.data(), band.out_size * sizeof(gr_complex));
+    band.ifft->execute();
+
+    // drop the overlap region, normalize the FFT/IFFT pair and remove the
+    // sub-bin frequency remainder
+    const gr_complex* time_out = band.ifft->get_outbuf() + d_overlap / band.decimation;
+    const float scale = 1.0F / static_cast<float>(d_fft_size);
+    for (int32_t n = 0; n < band.out_per_hop; n++)
+        {
+            out[n] = time_out[n] * scale * band.hop_phase * band.rotator_phase;
+            band.rotator_phase *= band.rotator_increment;
+        }
+    band.rotator_phase /= std::abs(band.rotator_phase);
+    band.hop_phase *= band.hop_increment;
+    band.hop_phase /= std::abs(band.hop_phase);
+}
+
+
+int gnss_sdr_channelizer::general_work(int noutput_items,
+    gr_vector_int& ninput_items,
+    gr_vector_const_void_star& input_items,
+    gr_vector_void_star& output_items)
+{
+    const auto* in = reinterpret_cast<const gr_complex*>(input_items[0]);
+
+    // how many hops fit in the input and in every output buffer
+    int32_t hops = (ninput_items[0] - d_overlap) / d_hop;
+    for (auto& band : d_bands)
+        {
+            const int32_t band_hops = noutput_items / band.out_per_hop;
+            if (band_hops < hops)
+                {
+                    hops = band_hops;
+                }
+        }
+    if (hops <= 0)
+        {
+            return 0;
+        }
+
+    for (int32_t h = 0; h < hops; h++)
+        {
+            std::memcpy(d_fft->get_inbuf(), in + h * d_hop, d_fft_size * sizeof(gr_complex));
+            d_fft->execute();
+            for (size_t j = 0; j < d_bands.size(); j++)
+                {
+                    auto* out = reinterpret_cast<gr_complex*>(output_items[j]);
+                    extract_band(d_bands[j], out + h * d_bands[j].out_per_hop);
+                }
+        }
+
+    consume(0, hops * d_hop);
+    for (size_t j = 0; j < d_bands.size(); j++)
+        {
+            produce(static_cast<int>(j), hops * d_bands[j].out_per_hop);
+        }
+    return WORK_CALLED_PRODUCE;
+}
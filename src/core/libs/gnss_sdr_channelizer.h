@@ -0,0 +1,134 @@
+/*!
+ * \file gnss_sdr_channelizer.h
+ * \brief Block that splits one wideband stream into several frequency bands
+ * sharing a single forward FFT.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * Frequency-domain (overlap-save) channelizer: every hop, one forward FFT
+ * of the wideband input is computed and then reused by all configured
+ * bands, which apply their lowpass response, fold the spectrum down to the
+ * decimated rate and run a small inverse FFT. Extracting N bands from the
+ * same capture therefore costs one large FFT plus N small ones, instead of
+ * N independent frequency-translating FIR passes over the full-rate input.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_CHANNELIZER_H
+#define GNSS_SDR_GNSS_SDR_CHANNELIZER_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/block.h>
+#include <gnuradio/fft/fft.h>
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/types.h>  // for gr_vector_const_void_star
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library
+ * \{ */
+
+
+class ConfigurationInterface;
+
+//! One output band of the channelizer
+struct Gnss_Sdr_Channelizer_Band
+{
+    double center_freq_hz;  //!< Band center, relative to the wideband stream center [Hz]
+    double cutoff_hz;       //!< Lowpass cutoff at the wideband rate [Hz]
+    int32_t decimation;     //!< Output sample rate is fs_in / decimation
+};
+
+class gnss_sdr_channelizer;
+
+using gnss_sdr_channelizer_sptr = gnss_shared_ptr<gnss_sdr_channelizer>;
+
+gnss_sdr_channelizer_sptr gnss_sdr_make_channelizer(
+    double fs_in,
+    int32_t fft_size,
+    const std::vector<Gnss_Sdr_Channelizer_Band>& bands);
+
+/*!
+ * \brief Builds a channelizer from the configuration keys of a signal source.
+ *
+ * Reads \<role\>.sampling_frequency, \<role\>.channelizer_fft_size and, for
+ * every band j in [0, nbands), \<role\>.channelizer_bandj_freq,
+ * \<role\>.channelizer_bandj_decimation and \<role\>.channelizer_bandj_cutoff.
+ */
+gnss_sdr_channelizer_sptr gnss_sdr_make_channelizer_from_conf(
+    const ConfigurationInterface* configuration,
+    const std::string& role,
+    int32_t nbands);
+
+/*!
+ * \brief Shared-FFT multiband frequency-translating decimator.
+ *
+ * Takes one gr_complex stream and emits one decimated baseband stream per
+ * configured band. Band j appears on output port j. All output ports must
+ * be connected.
+ */
+class gnss_sdr_channelizer : public gr::block
+{
+public:
+    ~gnss_sdr_channelizer() = default;
+
+    void forecast(int noutput_items, gr_vector_int& ninput_items_required);
+
+    int general_work(int noutput_items,
+        gr_vector_int& ninput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+private:
+    friend gnss_sdr_channelizer_sptr gnss_sdr_make_channelizer(
+        double fs_in,
+        int32_t fft_size,
+        const std::vector<Gnss_Sdr_Channelizer_Band>& bands);
+
+    gnss_sdr_channelizer(double fs_in,
+        int32_t fft_size,
+        const std::vector<Gnss_Sdr_Channelizer_Band>& bands);
+
+    struct Band_State
+    {
+        volk_gnsssdr::vector<gr_complex> freq_response;  // lowpass response over fft_size bins
+        volk_gnsssdr::vector<gr_complex> folded;         // band spectrum folded to out_size bins
+        std::unique_ptr<gr::fft::fft_complex> ifft;      // small inverse FFT, out_size points
+        gr_complex rotator_phase;                        // removes the sub-bin part of the translation
+        gr_complex rotator_increment;
+        gr_complex hop_phase;  // keeps the integer-bin translation coherent between hops
+        gr_complex hop_increment;
+        int32_t center_bin;
+        int32_t decimation;
+        int32_t out_size;     // fft_size / decimation
+        int32_t out_per_hop;  // hop / decimation
+    };
+
+    void extract_band(Band_State& band, gr_complex* out);
+
+    std::unique_ptr<gr::fft::fft_complex> d_fft;  // forward FFT shared by all bands
+    std::vector<Band_State> d_bands;
+
+    double d_fs_in;
+    int32_t d_fft_size;
+    int32_t d_overlap;  // samples of history reprocessed every hop
+    int32_t d_hop;      // new input samples per hop
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_CHANNELIZER_H
@@ -19,6 +19,8 @@
 
 #include "gnss_sdr_supl_client.h"
 #include "GPS_L1_CA.h"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/xml_iarchive.hpp>
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/serialization/map.hpp>
@@ -30,6 +32,67 @@
 #include <utility>    // for pair
 #include <vector>
 
+namespace
+{
+// File names ending in .gbs select the compact binary assistance cache;
+// any other extension keeps the boost XML interchange format
+bool use_binary_format(const std::string& file_name)
+{
+    const std::string binary_extension(".gbs");
+    if (file_name.size() <= binary_extension.size())
+        {
+            return false;
+        }
+    return file_name.compare(file_name.size() - binary_extension.size(), binary_extension.size(), binary_extension) == 0;
+}
+
+
+void open_assistance_output(std::ofstream& ofs, const std::string& file_name)
+{
+    if (use_binary_format(file_name))
+        {
+            ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out | std::ofstream::binary);
+        }
+    else
+        {
+            ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
+        }
+}
+
+
+template <class T>
+void read_assistance_archive(std::ifstream& ifs, const std::string& file_name, const char* tag, T& data)
+{
+    if (use_binary_format(file_name))
+        {
+            boost::archive::binary_iarchive bin(ifs);
+            bin >> boost::serialization::make_nvp(tag, data);
+        }
+    else
+        {
+            boost::archive::xml_iarchive xml(ifs);
+            xml >> boost::serialization::make_nvp(tag, data);
+        }
+}
+
+
+template <class T>
+void write_assistance_archive(std::ofstream& ofs, const std::string& file_name, const char* tag, T& data)
+{
+    if (use_binary_format(file_name))
+        {
+            boost::archive::binary_oarchive bin(ofs);
+            bin << boost::serialization::make_nvp(tag, data);
+        }
+    else
+        {
+            boost::archive::xml_oarchive xml(ofs);
+            xml << boost::serialization::make_nvp(tag, data);
+        }
+}
+}  // namespace
+
+
 Gnss_Sdr_Supl_Client::Gnss_Sdr_Supl_Client()
 {
     mcc = 0;
@@ -40,6 +103,7 @@ Gnss_Sdr_Supl_Client::Gnss_Sdr_Supl_Client()
     assist = supl_assist_t();
     server_port = 0;
     request = 0;
+    network_timeout_s = 0;
 }
 
 
@@ -164,6 +228,7 @@ int Gnss_Sdr_Supl_Client::get_assistance(int i_mcc, int i_mns, int i_lac, int i_
 
     int err;
     ctx.p.request = request;  // select assistance info request from a pre-defined set
+    supl_set_network_timeout(network_timeout_s);
 
     err = supl_get_assist(&ctx, cstr.data(), &assist);
     if (err == 0)
@@ -367,9 +432,8 @@ bool Gnss_Sdr_Supl_Client::load_ephemeris_xml(const std::string& file_name)
     try
         {
             ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
             gps_ephemeris_map.clear();
-            xml >> boost::serialization::make_nvp("GNSS-SDR_ephemeris_map", this->gps_ephemeris_map);
+            read_assistance_archive(ifs, file_name, "GNSS-SDR_ephemeris_map", this->gps_ephemeris_map);
             LOG(INFO) << "Loaded Ephemeris map data with " << this->gps_ephemeris_map.size() << " satellites";
         }
     catch (std::exception& e)
@@ -388,9 +452,8 @@ bool Gnss_Sdr_Supl_Client::save_ephemeris_map_xml(const std::string& file_name,
             std::ofstream ofs;
             try
                 {
-                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_ephemeris_map", eph_map);
+                    open_assistance_output(ofs, file_name);
+                    write_assistance_archive(ofs, file_name, "GNSS-SDR_ephemeris_map", eph_map);
                     LOG(INFO) << "Saved Ephemeris map data";
                 }
             catch (std::exception& e)
@@ -414,9 +477,8 @@ bool Gnss_Sdr_Supl_Client::load_gal_ephemeris_xml(const std::string& file_name)
     try
         {
             ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
             gal_ephemeris_map.clear();
-            xml >> boost::serialization::make_nvp("GNSS-SDR_gal_ephemeris_map", this->gal_ephemeris_map);
+            read_assistance_archive(ifs, file_name, "GNSS-SDR_gal_ephemeris_map", this->gal_ephemeris_map);
             LOG(INFO) << "Loaded Ephemeris map data with " << this->gal_ephemeris_map.size() << " satellites";
         }
     catch (std::exception& e)
@@ -435,9 +497,8 @@ bool save_gal_ephemeris_map_xml(const std::string& file_name, std::map<int, Gali
             std::ofstream ofs;
             try
                 {
-                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_gal_ephemeris_map", eph_map);
+                    open_assistance_output(ofs, file_name);
+                    write_assistance_archive(ofs, file_name, "GNSS-SDR_gal_ephemeris_map", eph_map);
                     LOG(INFO) << "Saved Galileo ephemeris map data";
                 }
             catch (std::exception& e)
@@ -461,9 +522,8 @@ bool Gnss_Sdr_Supl_Client::load_cnav_ephemeris_xml(const std::string& file_name)
     try
         {
             ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
             gps_cnav_ephemeris_map.clear();
-            xml >> boost::serialization::make_nvp("GNSS-SDR_cnav_ephemeris_map", this->gps_cnav_ephemeris_map);
+            read_assistance_archive(ifs, file_name, "GNSS-SDR_cnav_ephemeris_map", this->gps_cnav_ephemeris_map);
             LOG(INFO) << "Loaded Ephemeris map data with " << this->gps_cnav_ephemeris_map.size() << " satellites";
         }
     catch (std::exception& e)
@@ -482,9 +542,8 @@ bool save_cnav_ephemeris_map_xml(const std::string& file_name, std::map<int, Gps
             std::ofstream ofs;
             try
                 {
-                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_cnav_ephemeris_map", eph_map);
+                    open_assistance_output(ofs, file_name);
+                    write_assistance_archive(ofs, file_name, "GNSS-SDR_cnav_ephemeris_map", eph_map);
                     LOG(INFO) << "Saved GPS CNAV ephemeris map data";
                 }
             catch (std::exception& e)
@@ -508,9 +567,8 @@ bool Gnss_Sdr_Supl_Client::load_gnav_ephemeris_xml(const std::string& file_name)
     try
         {
             ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
             gps_cnav_ephemeris_map.clear();
-            xml >> boost::serialization::make_nvp("GNSS-SDR_gnav_ephemeris_map", this->glonass_gnav_ephemeris_map);
+            read_assistance_archive(ifs, file_name, "GNSS-SDR_gnav_ephemeris_map", this->glonass_gnav_ephemeris_map);
             LOG(INFO) << "Loaded GLONASS ephemeris map data with " << this->gps_cnav_ephemeris_map.size() << " satellites";
         }
     catch (std::exception& e)
@@ -529,9 +587,8 @@ bool save_gnav_ephemeris_map_xml(const std::string& file_name, std::map<int, Glo
             std::ofstream ofs;
             try
                 {
-                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_gnav_ephemeris_map", eph_map);
+                    open_assistance_output(ofs, file_name);
+                    write_assistance_archive(ofs, file_name, "GNSS-SDR_gnav_ephemeris_map", eph_map);
                     LOG(INFO) << "Saved GLONASS GNAV ephemeris map data";
                 }
             catch (std::exception& e)
@@ -555,8 +612,7 @@ bool Gnss_Sdr_Supl_Client::load_utc_xml(const std::string& file_name)
     try
         {
             ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_utc_model", this->gps_utc);
+            read_assistance_archive(ifs, file_name, "GNSS-SDR_utc_model", this->gps_utc);
             LOG(INFO) << "Loaded UTC model data";
         }
     catch (std::exception& e)
@@ -575,9 +631,8 @@ bool Gnss_Sdr_Supl_Client::save_utc_xml(const std::string& file_name, Gps_Utc_Mo
             std::ofstream ofs;
             try
                 {
-                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_utc_model", utc);
+                    open_assistance_output(ofs, file_name);
+                    write_assistance_archive(ofs, file_name, "GNSS-SDR_utc_model", utc);
                     LOG(INFO) << "Saved GPS UTC Model data";
                 }
             catch (std::exception& e)
@@ -601,8 +656,7 @@ bool Gnss_Sdr_Supl_Client::load_cnav_utc_xml(const std::string& file_name)
     try
         {
             ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_cnav_utc_model", this->gps_cnav_utc);
+            read_assistance_archive(ifs, file_name, "GNSS-SDR_cnav_utc_model", this->gps_cnav_utc);
             LOG(INFO) << "Loaded CNAV UTC model data";
         }
     catch (std::exception& e)
@@ -621,9 +675,8 @@ bool Gnss_Sdr_Supl_Client::save_cnav_utc_xml(const std::string& file_name, Gps_C
             std::ofstream ofs;
             try
                 {
-                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_cnav_utc_model", utc);
+                    open_assistance_output(ofs, file_name);
+                    write_assistance_archive(ofs, file_name, "GNSS-SDR_cnav_utc_model", utc);
                     LOG(INFO) << "Saved GPS CNAV UTC model data";
                 }
             catch (std::exception& e)
@@ -647,8 +700,7 @@ bool Gnss_Sdr_Supl_Client::load_gal_utc_xml(const std::string& file_name)
     try
         {
             ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_gal_utc_model", this->gal_utc);
+            read_assistance_archive(ifs, file_name, "GNSS-SDR_gal_utc_model", this->gal_utc);
             LOG(INFO) << "Loaded Galileo UTC model data";
         }
     catch (std::exception& e)
@@ -667,9 +719,8 @@ bool Gnss_Sdr_Supl_Client::save_gal_utc_xml(const std::string& file_name, Galile
             std::ofstream ofs;
             try
                 {
-                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_gal_utc_model", utc);
+                    open_assistance_output(ofs, file_name);
+                    write_assistance_archive(ofs, file_name, "GNSS-SDR_gal_utc_model", utc);
                     LOG(INFO) << "Saved Galileo UTC Model data";
                 }
             catch (std::exception& e)
@@ -693,8 +744,7 @@ bool Gnss_Sdr_Supl_Client::load_iono_xml(const std::string& file_name)
     try
         {
             ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_iono_model", this->gps_iono);
+            read_assistance_archive(ifs, file_name, "GNSS-SDR_iono_model", this->gps_iono);
             LOG(INFO) << "Loaded IONO model data";
         }
     catch (std::exception& e)
@@ -713,9 +763,8 @@ bool Gnss_Sdr_Supl_Client::save_iono_xml(const std::string& file_name, Gps_Iono&
             std::ofstream ofs;
             try
                 {
-                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_iono_model", iono);
+                    open_assistance_output(ofs, file_name);
+                    write_assistance_archive(ofs, file_name, "GNSS-SDR_iono_model", iono);
                     LOG(INFO) << "Saved IONO Model data";
                 }
             catch (std::exception& e)
@@ -739,8 +788,7 @@ bool Gnss_Sdr_Supl_Client::load_gal_iono_xml(const std::string& file_name)
     try
         {
             ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_gal_iono_model", this->gal_iono);
+            read_assistance_archive(ifs, file_name, "GNSS-SDR_gal_iono_model", this->gal_iono);
             LOG(INFO) << "Loaded Galileo IONO model data";
         }
     catch (std::exception& e)
@@ -759,9 +807,8 @@ bool Gnss_Sdr_Supl_Client::save_gal_iono_xml(const std::string& file_name, Galil
             std::ofstream ofs;
             try
                 {
-                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_gal_iono_model", iono);
+                    open_assistance_output(ofs, file_name);
+                    write_assistance_archive(ofs, file_name, "GNSS-SDR_gal_iono_model", iono);
                     LOG(INFO) << "Saved Galileo IONO Model data";
                 }
             catch (std::exception& e)
@@ -785,9 +832,8 @@ bool Gnss_Sdr_Supl_Client::load_gps_almanac_xml(const std::string& file_name)
     try
         {
             ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
             gps_almanac_map.clear();
-            xml >> boost::serialization::make_nvp("GNSS-SDR_gps_almanac_map", this->gps_almanac_map);
+            read_assistance_archive(ifs, file_name, "GNSS-SDR_gps_almanac_map", this->gps_almanac_map);
             LOG(INFO) << "Loaded GPS almanac map data with " << this->gps_almanac_map.size() << " satellites";
         }
     catch (std::exception& e)
@@ -806,9 +852,8 @@ bool Gnss_Sdr_Supl_Client::save_gps_almanac_xml(const std::string& file_name, st
             std::ofstream ofs;
             try
                 {
-                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_gps_almanac_map", gps_almanac_map_to_save);
+                    open_assistance_output(ofs, file_name);
+                    write_assistance_archive(ofs, file_name, "GNSS-SDR_gps_almanac_map", gps_almanac_map_to_save);
                     LOG(INFO) << "Saved GPS almanac data";
                 }
             catch (std::exception& e)
@@ -832,9 +877,8 @@ bool Gnss_Sdr_Supl_Client::load_gal_almanac_xml(const std::string& file_name)
     try
         {
             ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
             gal_almanac_map.clear();
-            xml >> boost::serialization::make_nvp("GNSS-SDR_gal_almanac_map", this->gal_almanac_map);
+            read_assistance_archive(ifs, file_name, "GNSS-SDR_gal_almanac_map", this->gal_almanac_map);
         }
     catch (std::exception& e)
         {
@@ -903,9 +947,8 @@ bool Gnss_Sdr_Supl_Client::save_gal_almanac_xml(const std::string& file_name, st
             std::ofstream ofs;
             try
                 {
-                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_gal_almanac_map", galileo_almanac_map_to_save);
+                    open_assistance_output(ofs, file_name);
+                    write_assistance_archive(ofs, file_name, "GNSS-SDR_gal_almanac_map", galileo_almanac_map_to_save);
                     LOG(INFO) << "Saved Galileo almanac data";
                 }
             catch (std::exception& e)
@@ -929,8 +972,7 @@ bool Gnss_Sdr_Supl_Client::load_glo_utc_xml(const std::string& file_name)
     try
         {
             ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_glo_utc_model", this->glo_gnav_utc);
+            read_assistance_archive(ifs, file_name, "GNSS-SDR_glo_utc_model", this->glo_gnav_utc);
             LOG(INFO) << "Loaded UTC model data";
         }
     catch (std::exception& e)
@@ -949,9 +991,8 @@ bool Gnss_Sdr_Supl_Client::save_glo_utc_xml(const std::string& file_name, Glonas
             std::ofstream ofs;
             try
                 {
-                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_glo_utc_model", utc);
+                    open_assistance_output(ofs, file_name);
+                    write_assistance_archive(ofs, file_name, "GNSS-SDR_glo_utc_model", utc);
                     LOG(INFO) << "Saved Glonass UTC Model data";
                 }
             catch (std::exception& e)
@@ -975,8 +1016,7 @@ bool Gnss_Sdr_Supl_Client::load_ref_time_xml(const std::string& file_name)
     try
         {
             ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_ref_time", this->gps_time);
+            read_assistance_archive(ifs, file_name, "GNSS-SDR_ref_time", this->gps_time);
             LOG(INFO) << "Loaded Ref Time data";
         }
     catch (std::exception& e)
@@ -995,9 +1035,8 @@ bool Gnss_Sdr_Supl_Client::save_ref_time_xml(const std::string& file_name, Agnss
             std::ofstream ofs;
             try
                 {
-                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_ref_time", ref_time);
+                    open_assistance_output(ofs, file_name);
+                    write_assistance_archive(ofs, file_name, "GNSS-SDR_ref_time", ref_time);
                     LOG(INFO) << "Saved Ref Time data";
                 }
             catch (std::exception& e)
@@ -1021,8 +1060,7 @@ bool Gnss_Sdr_Supl_Client::load_ref_location_xml(const std::string& file_name)
     try
         {
             ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_ref_location", this->gps_ref_loc);
+            read_assistance_archive(ifs, file_name, "GNSS-SDR_ref_location", this->gps_ref_loc);
             LOG(INFO) << "Loaded Ref Location data";
         }
     catch (std::exception& e)
@@ -1041,9 +1079,8 @@ bool Gnss_Sdr_Supl_Client::save_ref_location_xml(const std::string& file_name, A
             std::ofstream ofs;
             try
                 {
-                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_ref_location", ref_location);
+                    open_assistance_output(ofs, file_name);
+                    write_assistance_archive(ofs, file_name, "GNSS-SDR_ref_location", ref_location);
                     LOG(INFO) << "Saved Ref Location data";
                 }
             catch (std::exception& e)
@@ -51,6 +51,11 @@ extern "C"
 
 /*!
  * \brief class that implements a C++ interface to external Secure User Location Protocol (SUPL) client library..
+ *
+ * The load/save methods keep the boost XML format for interchange, but when
+ * the configured file name ends in .gbs they switch to a compact binary
+ * archive of the same data, which is much cheaper to write and parse and is
+ * therefore the recommended format for the local assistance cache.
  */
 class Gnss_Sdr_Supl_Client
 {
@@ -62,6 +67,7 @@ public:
     std::string server_name;
     int server_port;
     int request;
+    int network_timeout_s;  // per-request network timeout, in seconds (0 = no timeout)
     // ephemeris map
     std::map<int, Gps_Ephemeris> gps_ephemeris_map;
     std::map<int, Galileo_Ephemeris> gal_ephemeris_map;
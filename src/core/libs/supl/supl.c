@@ -42,6 +42,8 @@ static struct supl_debug_s
 } debug;
 #endif
 
+static int network_timeout_s = 0;
+
 static int server_connect(char *server);
 static int pdu_make_ulp_start(supl_ctx_t *ctx, supl_ulp_t *pdu);
 static int pdu_make_ulp_pos_init(supl_ctx_t *ctx, supl_ulp_t *pdu);
@@ -332,6 +334,16 @@ static int server_connect(char *server)
                 {
                     err = errno;
                 }
+            if (network_timeout_s > 0)
+                {
+                    /* bound connect() and every read/write so that a dead
+                       server cannot hang the caller indefinitely */
+                    struct timeval tv;
+                    tv.tv_sec = network_timeout_s;
+                    tv.tv_usec = 0;
+                    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+                    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+                }
             if (connect(fd, aip->ai_addr, aip->ai_addrlen) != 0)
                 {
                     freeaddrinfo(aip);
@@ -1097,6 +1109,12 @@ void EXPORT supl_request(supl_ctx_t *ctx, int request)
 }
 
 
+void EXPORT supl_set_network_timeout(int timeout_s)
+{
+    network_timeout_s = timeout_s;
+}
+
+
 void EXPORT supl_set_debug(FILE *log, int flags)
 {
 #ifdef SUPL_DEBUG
@@ -258,6 +258,7 @@ void supl_request(supl_ctx_t *ctx, int request);
 
 int supl_get_assist(supl_ctx_t *ctx, char *server, supl_assist_t *assist);
 void supl_set_debug(FILE *log, int flags);
+void supl_set_network_timeout(int timeout_s);
 
 /*
 ** stuff above should be enough for supl client implementation
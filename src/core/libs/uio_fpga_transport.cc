@@ -0,0 +1,256 @@
+/*!
+ * \file uio_fpga_transport.cc
+ * \brief FPGA transport over the uio device driver.
+ * \author Marc Majoral, 2020. mmajoral(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "uio_fpga_transport.h"
+#include "uio_fpga.h"
+#include <glog/logging.h>
+#include <chrono>
+#include <cstdlib>   // for free
+#include <fcntl.h>   // for open, O_RDWR, O_SYNC
+#include <iostream>  // for cout
+#include <poll.h>    // for poll, pollfd, POLLIN
+#include <sys/mman.h>  // for mmap
+#include <unistd.h>    // for close, read, write, sysconf
+
+
+Uio_Fpga_Transport::Uio_Fpga_Transport(size_t register_map_bytes)
+    : d_register_map_bytes(register_map_bytes),
+      d_dma_buffer_bytes(0),
+      d_map_base(nullptr),
+      d_ewma_wait_us(0.0),
+      d_ring_write_index(0),
+      d_ring_read_index(0),
+      d_device_descriptor(-1),
+      d_spin_threshold_us(default_spin_threshold_us)
+{
+}
+
+
+Uio_Fpga_Transport::~Uio_Fpga_Transport()
+{
+    close_device();
+    free_dma_ring();
+}
+
+
+int32_t Uio_Fpga_Transport::open_device(const std::string &device_name, uint32_t device_num)
+{
+    std::string device_file_name;
+    if (find_uio_dev_file_name(device_file_name, device_name, device_num) < 0)
+        {
+            LOG(WARNING) << "Cannot find a uio device for " << device_name << " number " << device_num;
+            return -1;
+        }
+    return open_device_file(device_file_name);
+}
+
+
+int32_t Uio_Fpga_Transport::open_device_file(const std::string &device_file_name)
+{
+    d_device_descriptor = open(device_file_name.c_str(), O_RDWR | O_SYNC);
+    if (d_device_descriptor == -1)
+        {
+            LOG(WARNING) << "Cannot open deviceio" << device_file_name;
+            return -1;
+        }
+    d_map_base = reinterpret_cast<volatile uint32_t *>(mmap(nullptr, d_register_map_bytes,
+        PROT_READ | PROT_WRITE, MAP_SHARED, d_device_descriptor, 0));
+    if (d_map_base == reinterpret_cast<void *>(-1))
+        {
+            LOG(WARNING) << "Cannot map the registers of " << device_file_name << " into user memory";
+            d_map_base = nullptr;
+            close(d_device_descriptor);
+            d_device_descriptor = -1;
+            return -1;
+        }
+    d_device_file_name = device_file_name;
+    return 0;
+}
+
+
+void Uio_Fpga_Transport::close_device()
+{
+    if (d_map_base != nullptr)
+        {
+            auto *aux = const_cast<uint32_t *>(d_map_base);
+            if (munmap(static_cast<void *>(aux), d_register_map_bytes) == -1)
+                {
+                    std::cout << "Failed to unmap memory uio\n";
+                }
+            d_map_base = nullptr;
+        }
+    if (d_device_descriptor != -1)
+        {
+            close(d_device_descriptor);
+            d_device_descriptor = -1;
+        }
+}
+
+
+void Uio_Fpga_Transport::arm_interrupt()
+{
+    int32_t reenable = 1;
+    const ssize_t nbytes = write(d_device_descriptor, reinterpret_cast<void *>(&reenable), sizeof(int32_t));
+    if (nbytes != sizeof(int32_t))
+        {
+            std::cerr << "Error enabling the interrupt of " << d_device_file_name << '\n';
+        }
+}
+
+
+bool Uio_Fpga_Transport::wait_for_completion()
+{
+    const auto wait_start = std::chrono::steady_clock::now();
+    pollfd device_poll{};
+    device_poll.fd = d_device_descriptor;
+    device_poll.events = POLLIN;
+    bool ready = false;
+
+    // sleep on the interrupt through the predictable part of the wait ...
+    if (d_ewma_wait_us > static_cast<double>(d_spin_threshold_us))
+        {
+            const int sleep_ms = static_cast<int>((d_ewma_wait_us - static_cast<double>(d_spin_threshold_us)) / 1000.0);
+            if (sleep_ms > 0)
+                {
+                    const int rc = poll(&device_poll, 1, sleep_ms);
+                    ready = (rc > 0) and ((device_poll.revents & POLLIN) != 0);
+                }
+        }
+
+    // ... spin through the remaining microseconds to dodge the interrupt
+    // wakeup latency, with a bounded budget ...
+    if (!ready and (d_spin_threshold_us > 0))
+        {
+            const auto spin_deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(4U * d_spin_threshold_us);
+            while (!ready and (std::chrono::steady_clock::now() < spin_deadline))
+                {
+                    const int rc = poll(&device_poll, 1, 0);
+                    ready = (rc > 0) and ((device_poll.revents & POLLIN) != 0);
+                }
+        }
+
+    // ... and fall back to a plain blocking wait when the estimate was off
+    // (or on the first operations, when there is no estimate yet)
+    if (!ready)
+        {
+            const int rc = poll(&device_poll, 1, -1);
+            ready = (rc > 0) and ((device_poll.revents & POLLIN) != 0);
+        }
+
+    if (ready)
+        {
+            // clear the uio interrupt counter
+            int32_t irq_count = 0;
+            const ssize_t nb = read(d_device_descriptor, &irq_count, sizeof(irq_count));
+            if (nb != sizeof(irq_count))
+                {
+                    std::cout << "Failed to retrieve the interrupt counter of " << d_device_file_name << '\n';
+                    return false;
+                }
+        }
+    else
+        {
+            return false;
+        }
+
+    const double wait_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - wait_start).count();
+    if (d_ewma_wait_us == 0.0)
+        {
+            d_ewma_wait_us = wait_us;
+        }
+    else
+        {
+            d_ewma_wait_us = 0.875 * d_ewma_wait_us + 0.125 * wait_us;
+        }
+    return true;
+}
+
+
+int32_t Uio_Fpga_Transport::allocate_dma_ring(uint32_t num_buffers, size_t buffer_bytes)
+{
+    free_dma_ring();
+    const auto page_bytes = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (uint32_t buffer = 0; buffer < num_buffers; buffer++)
+        {
+            void *mem = nullptr;
+            if (posix_memalign(&mem, page_bytes, buffer_bytes) != 0)
+                {
+                    LOG(WARNING) << "Cannot allocate the DMA buffer ring (" << num_buffers << " x " << buffer_bytes << " bytes)";
+                    free_dma_ring();
+                    return -1;
+                }
+            d_dma_buffers.push_back(static_cast<int8_t *>(mem));
+        }
+    d_dma_buffer_bytes = buffer_bytes;
+    d_ring_write_index = 0;
+    d_ring_read_index = 0;
+    return 0;
+}
+
+
+void Uio_Fpga_Transport::free_dma_ring()
+{
+    for (auto *buffer : d_dma_buffers)
+        {
+            free(buffer);
+        }
+    d_dma_buffers.clear();
+    d_dma_buffer_bytes = 0;
+}
+
+
+int8_t *Uio_Fpga_Transport::claim_dma_buffer()
+{
+    if (d_dma_buffers.empty())
+        {
+            return nullptr;
+        }
+    const uint32_t write_index = d_ring_write_index.load(std::memory_order_relaxed);
+    const uint32_t read_index = d_ring_read_index.load(std::memory_order_acquire);
+    if (write_index - read_index >= d_dma_buffers.size())
+        {
+            return nullptr;  // ring full, the consumer has not caught up
+        }
+    return d_dma_buffers[write_index % d_dma_buffers.size()];
+}
+
+
+void Uio_Fpga_Transport::commit_dma_buffer()
+{
+    d_ring_write_index.fetch_add(1, std::memory_order_release);
+}
+
+
+const int8_t *Uio_Fpga_Transport::front_dma_buffer() const
+{
+    if (d_dma_buffers.empty())
+        {
+            return nullptr;
+        }
+    const uint32_t read_index = d_ring_read_index.load(std::memory_order_relaxed);
+    const uint32_t write_index = d_ring_write_index.load(std::memory_order_acquire);
+    if (read_index == write_index)
+        {
+            return nullptr;  // ring empty
+        }
+    return d_dma_buffers[read_index % d_dma_buffers.size()];
+}
+
+
+void Uio_Fpga_Transport::release_dma_buffer()
+{
+    d_ring_read_index.fetch_add(1, std::memory_order_release);
+}
@@ -0,0 +1,98 @@
+/*!
+ * \file uio_fpga_transport.h
+ * \brief FPGA transport over the uio device driver.
+ * \author Marc Majoral, 2020. mmajoral(at)cttc.es
+ *
+ * Implements the Fpga_Transport interface on top of a uio device: the
+ * register map is mmap'ed from the device file, completion is signaled
+ * through the uio interrupt counter, and the DMA ring is a preallocated
+ * pool of page-aligned buffers.
+ *
+ * The completion wait is adaptive: the expected duration of the operation
+ * is learned from the previous ones, the thread sleeps on the interrupt
+ * through the predictable part of the wait and only spins through the last
+ * few microseconds, so a tracking channel no longer burns a core while the
+ * accelerator integrates.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_UIO_FPGA_TRANSPORT_H
+#define GNSS_SDR_UIO_FPGA_TRANSPORT_H
+
+#include "fpga_transport.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library
+ * \{ */
+
+
+/*!
+ * \brief Fpga_Transport implementation over a uio device driver.
+ */
+class Uio_Fpga_Transport : public Fpga_Transport
+{
+public:
+    //! Constructor. register_map_bytes is the size of the mmap'ed register window
+    explicit Uio_Fpga_Transport(size_t register_map_bytes = default_register_map_bytes);
+
+    ~Uio_Fpga_Transport() override;
+
+    // Fpga_Transport API
+    int32_t open_device(const std::string &device_name, uint32_t device_num) override;
+    int32_t open_device_file(const std::string &device_file_name) override;
+    void close_device() override;
+    volatile uint32_t *register_map() override { return d_map_base; }
+    void arm_interrupt() override;
+    bool wait_for_completion() override;
+    int32_t allocate_dma_ring(uint32_t num_buffers, size_t buffer_bytes) override;
+    uint32_t dma_ring_buffers() const override { return static_cast<uint32_t>(d_dma_buffers.size()); }
+    size_t dma_buffer_bytes() const override { return d_dma_buffer_bytes; }
+    int8_t *claim_dma_buffer() override;
+    void commit_dma_buffer() override;
+    const int8_t *front_dma_buffer() const override;
+    void release_dma_buffer() override;
+
+    //! Expected completion latencies below this threshold are spun through
+    //! instead of slept through. 0 disables spinning (pure interrupt mode)
+    void set_spin_threshold_us(uint32_t spin_threshold_us) { d_spin_threshold_us = spin_threshold_us; }
+
+private:
+    static const size_t default_register_map_bytes = 0x10000;
+    static const uint32_t default_spin_threshold_us = 200;
+
+    void free_dma_ring();
+
+    std::vector<int8_t *> d_dma_buffers;
+    std::string d_device_file_name;
+    size_t d_register_map_bytes;
+    size_t d_dma_buffer_bytes;
+    volatile uint32_t *d_map_base;
+    double d_ewma_wait_us;  // learned completion latency
+
+    // single producer / single consumer ring indices
+    std::atomic<uint32_t> d_ring_write_index;
+    std::atomic<uint32_t> d_ring_read_index;
+
+    int32_t d_device_descriptor;
+    uint32_t d_spin_threshold_us;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_UIO_FPGA_TRANSPORT_H
@@ -28,13 +28,19 @@ gnss_synchro_monitor_sptr gnss_synchro_make_monitor(int n_channels,
     int decimation_factor,
     int udp_port,
     const std::vector<std::string>& udp_addresses,
-    bool enable_protobuf)
+    bool enable_protobuf,
+    bool enable_raw_struct,
+    int batch_size,
+    int subscription_port)
 {
     return gnss_synchro_monitor_sptr(new gnss_synchro_monitor(n_channels,
         decimation_factor,
         udp_port,
         udp_addresses,
-        enable_protobuf));
+        enable_protobuf,
+        enable_raw_struct,
+        batch_size,
+        subscription_port));
 }
 
 
@@ -42,14 +48,19 @@ gnss_synchro_monitor::gnss_synchro_monitor(int n_channels,
     int decimation_factor,
     int udp_port,
     const std::vector<std::string>& udp_addresses,
-    bool enable_protobuf) : gr::block("gnss_synchro_monitor",
-                                gr::io_signature::make(n_channels, n_channels, sizeof(Gnss_Synchro)),
-                                gr::io_signature::make(0, 0, 0))
+    bool enable_protobuf,
+    bool enable_raw_struct,
+    int batch_size,
+    int subscription_port) : gr::block("gnss_synchro_monitor",
+                                 gr::io_signature::make(n_channels, n_channels, sizeof(Gnss_Synchro)),
+                                 gr::io_signature::make(0, 0, 0))
 {
     d_decimation_factor = decimation_factor;
     d_nchannels = n_channels;
+    d_batch_size = std::max(batch_size, 1);
+    d_batch.reserve(d_batch_size);
 
-    udp_sink_ptr = std::make_unique<Gnss_Synchro_Udp_Sink>(udp_addresses, udp_port, enable_protobuf);
+    udp_sink_ptr = std::make_unique<Gnss_Synchro_Udp_Sink>(udp_addresses, udp_port, enable_protobuf, enable_raw_struct, static_cast<uint16_t>(std::max(subscription_port, 0)));
 }
 
 void gnss_synchro_monitor::forecast(int noutput_items __attribute__((unused)), gr_vector_int& ninput_items_required)
@@ -78,10 +89,16 @@ int gnss_synchro_monitor::general_work(int noutput_items __attribute__((unused))
                     count++;
                     if (count >= d_decimation_factor)
                         {
-                            // Convert to a vector and write to the UDP sink
-                            std::vector<Gnss_Synchro> stocks;
-                            stocks.push_back(in[channel_index][item_index]);
-                            udp_sink_ptr->write_gnss_synchro(stocks);
+                            // Accumulate into the batch and flush one datagram
+                            // per d_batch_size observables. With the default
+                            // batch size of 1, each observable is sent on its
+                            // own, as before
+                            d_batch.push_back(in[channel_index][item_index]);
+                            if (static_cast<int>(d_batch.size()) >= d_batch_size)
+                                {
+                                    udp_sink_ptr->write_gnss_synchro(d_batch);
+                                    d_batch.clear();
+                                }
                             // Reset count variable
                             count = 0;
                         }
@@ -21,6 +21,7 @@
 #define GNSS_SDR_GNSS_SYNCHRO_MONITOR_H
 
 #include "gnss_block_interface.h"
+#include "gnss_synchro.h"
 #include "gnss_synchro_udp_sink.h"
 #include <gnuradio/block.h>
 #include <gnuradio/runtime_types.h>  // for gr_vector_void_star
@@ -43,7 +44,10 @@ gnss_synchro_monitor_sptr gnss_synchro_make_monitor(int n_channels,
     int decimation_factor,
     int udp_port,
     const std::vector<std::string>& udp_addresses,
-    bool enable_protobuf);
+    bool enable_protobuf,
+    bool enable_raw_struct = false,
+    int batch_size = 1,
+    int subscription_port = 0);
 
 /*!
  * \brief This class implements a monitoring block which allows sending
@@ -63,16 +67,24 @@ private:
         int decimation_factor,
         int udp_port,
         const std::vector<std::string>& udp_addresses,
-        bool enable_protobuf);
+        bool enable_protobuf,
+        bool enable_raw_struct,
+        int batch_size,
+        int subscription_port);
 
     gnss_synchro_monitor(int n_channels,
         int decimation_factor,
         int udp_port,
         const std::vector<std::string>& udp_addresses,
-        bool enable_protobuf);
+        bool enable_protobuf,
+        bool enable_raw_struct,
+        int batch_size,
+        int subscription_port);
 
+    std::vector<Gnss_Synchro> d_batch;  // observables accumulated until the next flush
     int d_nchannels;
     int d_decimation_factor;
+    int d_batch_size;
     std::unique_ptr<Gnss_Synchro_Udp_Sink> udp_sink_ptr;
 };
 
@@ -16,14 +16,30 @@
  */
 
 #include "gnss_synchro_udp_sink.h"
+#include "gnss_sdr_make_unique.h"
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/serialization/vector.hpp>
+#include <array>
+#include <cstring>
 #include <iostream>
 #include <sstream>
+#include <type_traits>
 
-Gnss_Synchro_Udp_Sink::Gnss_Synchro_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port, bool enable_protobuf) : socket{io_context}
+namespace
+{
+// appends the in-memory representation of a trivially copyable value
+template <typename T>
+void append_pod(std::string& buffer, const T& value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+}  // namespace
+
+
+Gnss_Synchro_Udp_Sink::Gnss_Synchro_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port, bool enable_protobuf, bool enable_raw_struct, uint16_t subscription_port) : socket{io_context}
 {
     use_protobuf = enable_protobuf;
+    use_raw_struct = enable_raw_struct;
     if (enable_protobuf)
         {
             serdes = Serdes_Gnss_Synchro();
@@ -33,13 +49,292 @@ Gnss_Synchro_Udp_Sink::Gnss_Synchro_Udp_Sink(const std::vector<std::string>& add
             boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(address, error), port);
             endpoints.push_back(endpoint);
         }
+    if (subscription_port > 0)
+        {
+            control_socket = std::make_unique<boost::asio::ip::udp::socket>(io_context);
+            control_socket->open(boost::asio::ip::udp::v4(), error);
+            if (!error)
+                {
+                    control_socket->bind(boost::asio::ip::udp::endpoint(boost::asio::ip::udp::v4(), subscription_port), error);
+                }
+            if (error)
+                {
+                    std::cerr << "Monitor subscription socket could not bind to port " << subscription_port << ": subscriptions disabled\n";
+                    control_socket.reset();
+                }
+            else
+                {
+                    control_socket->non_blocking(true, error);
+                }
+        }
+}
+
+
+void Gnss_Synchro_Udp_Sink::poll_subscriptions()
+{
+    std::array<char, 256> command_buffer{};
+    boost::asio::ip::udp::endpoint sender;
+    while (true)
+        {
+            boost::system::error_code ec;
+            const size_t bytes = control_socket->receive_from(boost::asio::buffer(command_buffer), sender, 0, ec);
+            if (ec)
+                {
+                    break;  // would block: no pending command
+                }
+            std::istringstream command(std::string(command_buffer.data(), bytes));
+            std::string verb;
+            command >> verb;
+            if (verb == "SUB")
+                {
+                    uint16_t data_port = 0;
+                    uint32_t rate_divisor = 0;
+                    std::string channels_str;
+                    std::string fields_str;
+                    command >> data_port >> rate_divisor >> channels_str >> fields_str;
+                    if ((data_port == 0) or (rate_divisor == 0) or channels_str.empty() or fields_str.empty())
+                        {
+                            continue;  // malformed command
+                        }
+                    Subscriber subscriber;
+                    subscriber.data_endpoint = boost::asio::ip::udp::endpoint(sender.address(), data_port);
+                    subscriber.rate_divisor = rate_divisor;
+                    if (channels_str != "all")
+                        {
+                            std::istringstream channel_list(channels_str);
+                            std::string token;
+                            while (std::getline(channel_list, token, ','))
+                                {
+                                    try
+                                        {
+                                            subscriber.channels.insert(std::stoi(token));
+                                        }
+                                    catch (const std::exception& e)
+                                        {
+                                            // skip the malformed entry
+                                        }
+                                }
+                        }
+                    if (fields_str != "all")
+                        {
+                            try
+                                {
+                                    subscriber.field_mask = static_cast<uint32_t>(std::stoul(fields_str, nullptr, 16));
+                                }
+                            catch (const std::exception& e)
+                                {
+                                    subscriber.field_mask = 0xFFFFFFFFU;
+                                }
+                        }
+                    // a new SUB from the same data endpoint replaces the old subscription
+                    for (auto it = subscribers.begin(); it != subscribers.end(); ++it)
+                        {
+                            if (it->data_endpoint == subscriber.data_endpoint)
+                                {
+                                    subscribers.erase(it);
+                                    break;
+                                }
+                        }
+                    subscribers.push_back(subscriber);
+                }
+            else if (verb == "UNSUB")
+                {
+                    uint16_t data_port = 0;
+                    command >> data_port;
+                    for (auto it = subscribers.begin(); it != subscribers.end(); ++it)
+                        {
+                            if ((it->data_endpoint.address() == sender.address()) and (it->data_endpoint.port() == data_port))
+                                {
+                                    subscribers.erase(it);
+                                    break;
+                                }
+                        }
+                }
+        }
+}
+
+
+void Gnss_Synchro_Udp_Sink::write_subscriber_datagrams(const std::vector<Gnss_Synchro>& stocks)
+{
+    for (auto& subscriber : subscribers)
+        {
+            subscriber.epoch_count++;
+            if (subscriber.epoch_count < subscriber.rate_divisor)
+                {
+                    continue;
+                }
+            subscriber.epoch_count = 0;
+            const bool keyframe = (subscriber.sent_count % MONITOR_V2_KEYFRAME_INTERVAL) == 0;
+
+            v2_outbound.clear();
+            v2_outbound.append("MON2", 4);
+            v2_outbound.push_back(static_cast<char>(2));  // protocol version
+            v2_outbound.push_back(keyframe ? 1 : 0);
+            uint16_t num_records = 0;
+            const size_t num_records_offset = v2_outbound.size();
+            append_pod(v2_outbound, num_records);  // patched below
+            append_pod(v2_outbound, subscriber.sequence);
+
+            for (const auto& stock : stocks)
+                {
+                    if (!subscriber.channels.empty() and (subscriber.channels.count(stock.Channel_ID) == 0))
+                        {
+                            continue;
+                        }
+                    const auto last = subscriber.last_sent.find(stock.Channel_ID);
+                    // a keyframe, a channel never sent or a satellite swap on
+                    // the channel all force a full record
+                    const bool full_record = keyframe or (last == subscriber.last_sent.end()) or (last->second.PRN != stock.PRN) or (last->second.System != stock.System);
+                    const Gnss_Synchro* prev = full_record ? nullptr : &last->second;
+                    const uint32_t mask = subscriber.field_mask;
+                    uint32_t present = 0;
+                    if ((mask & MONITOR_V2_FIELD_CN0) and ((prev == nullptr) or (prev->CN0_dB_hz != stock.CN0_dB_hz)))
+                        {
+                            present |= MONITOR_V2_FIELD_CN0;
+                        }
+                    if ((mask & MONITOR_V2_FIELD_DOPPLER) and ((prev == nullptr) or (prev->Carrier_Doppler_hz != stock.Carrier_Doppler_hz)))
+                        {
+                            present |= MONITOR_V2_FIELD_DOPPLER;
+                        }
+                    if ((mask & MONITOR_V2_FIELD_CARRIER_PHASE) and ((prev == nullptr) or (prev->Carrier_phase_rads != stock.Carrier_phase_rads)))
+                        {
+                            present |= MONITOR_V2_FIELD_CARRIER_PHASE;
+                        }
+                    if ((mask & MONITOR_V2_FIELD_CODE_PHASE) and ((prev == nullptr) or (prev->Code_phase_samples != stock.Code_phase_samples)))
+                        {
+                            present |= MONITOR_V2_FIELD_CODE_PHASE;
+                        }
+                    if ((mask & MONITOR_V2_FIELD_PROMPT_I) and ((prev == nullptr) or (prev->Prompt_I != stock.Prompt_I)))
+                        {
+                            present |= MONITOR_V2_FIELD_PROMPT_I;
+                        }
+                    if ((mask & MONITOR_V2_FIELD_PROMPT_Q) and ((prev == nullptr) or (prev->Prompt_Q != stock.Prompt_Q)))
+                        {
+                            present |= MONITOR_V2_FIELD_PROMPT_Q;
+                        }
+                    if ((mask & MONITOR_V2_FIELD_ACQ_DOPPLER) and ((prev == nullptr) or (prev->Acq_doppler_hz != stock.Acq_doppler_hz)))
+                        {
+                            present |= MONITOR_V2_FIELD_ACQ_DOPPLER;
+                        }
+                    if ((mask & MONITOR_V2_FIELD_ACQ_DELAY) and ((prev == nullptr) or (prev->Acq_delay_samples != stock.Acq_delay_samples)))
+                        {
+                            present |= MONITOR_V2_FIELD_ACQ_DELAY;
+                        }
+                    if ((mask & MONITOR_V2_FIELD_SAMPLE_COUNTER) and ((prev == nullptr) or (prev->Tracking_sample_counter != stock.Tracking_sample_counter)))
+                        {
+                            present |= MONITOR_V2_FIELD_SAMPLE_COUNTER;
+                        }
+                    if ((mask & MONITOR_V2_FIELD_TOW) and ((prev == nullptr) or (prev->TOW_at_current_symbol_ms != stock.TOW_at_current_symbol_ms)))
+                        {
+                            present |= MONITOR_V2_FIELD_TOW;
+                        }
+                    if ((mask & MONITOR_V2_FIELD_PSEUDORANGE) and ((prev == nullptr) or (prev->Pseudorange_m != stock.Pseudorange_m)))
+                        {
+                            present |= MONITOR_V2_FIELD_PSEUDORANGE;
+                        }
+                    if ((mask & MONITOR_V2_FIELD_RX_TIME) and ((prev == nullptr) or (prev->RX_time != stock.RX_time)))
+                        {
+                            present |= MONITOR_V2_FIELD_RX_TIME;
+                        }
+                    if ((present == 0) and !full_record)
+                        {
+                            // no subscribed field changed on this channel
+                            subscriber.last_sent[stock.Channel_ID] = stock;
+                            continue;
+                        }
+
+                    append_pod(v2_outbound, stock.Channel_ID);
+                    v2_outbound.push_back(stock.System);
+                    v2_outbound.append(stock.Signal, 2);
+                    append_pod(v2_outbound, stock.PRN);
+                    const uint8_t flags = (stock.Flag_valid_symbol_output ? 1U : 0U) |
+                                          (stock.Flag_valid_word ? 2U : 0U) |
+                                          (stock.Flag_valid_pseudorange ? 4U : 0U);
+                    append_pod(v2_outbound, flags);
+                    append_pod(v2_outbound, present);
+                    if (present & MONITOR_V2_FIELD_CN0)
+                        {
+                            append_pod(v2_outbound, stock.CN0_dB_hz);
+                        }
+                    if (present & MONITOR_V2_FIELD_DOPPLER)
+                        {
+                            append_pod(v2_outbound, stock.Carrier_Doppler_hz);
+                        }
+                    if (present & MONITOR_V2_FIELD_CARRIER_PHASE)
+                        {
+                            append_pod(v2_outbound, stock.Carrier_phase_rads);
+                        }
+                    if (present & MONITOR_V2_FIELD_CODE_PHASE)
+                        {
+                            append_pod(v2_outbound, stock.Code_phase_samples);
+                        }
+                    if (present & MONITOR_V2_FIELD_PROMPT_I)
+                        {
+                            append_pod(v2_outbound, stock.Prompt_I);
+                        }
+                    if (present & MONITOR_V2_FIELD_PROMPT_Q)
+                        {
+                            append_pod(v2_outbound, stock.Prompt_Q);
+                        }
+                    if (present & MONITOR_V2_FIELD_ACQ_DOPPLER)
+                        {
+                            append_pod(v2_outbound, stock.Acq_doppler_hz);
+                        }
+                    if (present & MONITOR_V2_FIELD_ACQ_DELAY)
+                        {
+                            append_pod(v2_outbound, stock.Acq_delay_samples);
+                        }
+                    if (present & MONITOR_V2_FIELD_SAMPLE_COUNTER)
+                        {
+                            append_pod(v2_outbound, stock.Tracking_sample_counter);
+                        }
+                    if (present & MONITOR_V2_FIELD_TOW)
+                        {
+                            append_pod(v2_outbound, stock.TOW_at_current_symbol_ms);
+                        }
+                    if (present & MONITOR_V2_FIELD_PSEUDORANGE)
+                        {
+                            append_pod(v2_outbound, stock.Pseudorange_m);
+                        }
+                    if (present & MONITOR_V2_FIELD_RX_TIME)
+                        {
+                            append_pod(v2_outbound, stock.RX_time);
+                        }
+                    subscriber.last_sent[stock.Channel_ID] = stock;
+                    num_records++;
+                }
+
+            if (num_records == 0)
+                {
+                    // nothing changed for this subscriber: hold the datagram
+                    // (and the keyframe cadence) until there is something new
+                    continue;
+                }
+            std::memcpy(&v2_outbound[num_records_offset], &num_records, sizeof(num_records));
+            subscriber.sequence++;
+            subscriber.sent_count++;
+            boost::system::error_code ec;
+            control_socket->send_to(boost::asio::buffer(v2_outbound), subscriber.data_endpoint, 0, ec);
+        }
 }
 
 
 bool Gnss_Synchro_Udp_Sink::write_gnss_synchro(const std::vector<Gnss_Synchro>& stocks)
 {
-    std::string outbound_data;
-    if (use_protobuf == false)
+    if (control_socket)
+        {
+            poll_subscriptions();
+            write_subscriber_datagrams(stocks);
+        }
+    if (use_raw_struct)
+        {
+            // Fixed-layout wire mode for same-architecture consumers: the
+            // datagram carries the in-memory representation of the structs
+            static_assert(std::is_standard_layout<Gnss_Synchro>::value,
+                "Gnss_Synchro must keep a fixed layout for the raw-struct wire mode");
+            outbound_data.assign(reinterpret_cast<const char*>(stocks.data()), stocks.size() * sizeof(Gnss_Synchro));
+        }
+    else if (use_protobuf == false)
         {
             std::ostringstream archive_stream;
             boost::archive::binary_oarchive oa{archive_stream};
@@ -48,7 +343,7 @@ bool Gnss_Synchro_Udp_Sink::write_gnss_synchro(const std::vector<Gnss_Synchro>&
         }
     else
         {
-            outbound_data = serdes.createProtobuffer(stocks);
+            serdes.createProtobuffer(stocks, &outbound_data);
         }
     for (const auto& endpoint : endpoints)
         {
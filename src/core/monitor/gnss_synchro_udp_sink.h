@@ -23,6 +23,9 @@
 #include <boost/asio.hpp>
 #include <boost/system/error_code.hpp>
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -38,23 +41,76 @@ using b_io_context = boost::asio::io_context;
 using b_io_context = boost::asio::io_service;
 #endif
 
+// Field mask bits of the v2 subscription protocol, in wire order
+inline constexpr uint32_t MONITOR_V2_FIELD_CN0 = 1U << 0;             // CN0_dB_hz (double)
+inline constexpr uint32_t MONITOR_V2_FIELD_DOPPLER = 1U << 1;         // Carrier_Doppler_hz (double)
+inline constexpr uint32_t MONITOR_V2_FIELD_CARRIER_PHASE = 1U << 2;   // Carrier_phase_rads (double)
+inline constexpr uint32_t MONITOR_V2_FIELD_CODE_PHASE = 1U << 3;      // Code_phase_samples (double)
+inline constexpr uint32_t MONITOR_V2_FIELD_PROMPT_I = 1U << 4;        // Prompt_I (double)
+inline constexpr uint32_t MONITOR_V2_FIELD_PROMPT_Q = 1U << 5;        // Prompt_Q (double)
+inline constexpr uint32_t MONITOR_V2_FIELD_ACQ_DOPPLER = 1U << 6;     // Acq_doppler_hz (double)
+inline constexpr uint32_t MONITOR_V2_FIELD_ACQ_DELAY = 1U << 7;       // Acq_delay_samples (double)
+inline constexpr uint32_t MONITOR_V2_FIELD_SAMPLE_COUNTER = 1U << 8;  // Tracking_sample_counter (uint64)
+inline constexpr uint32_t MONITOR_V2_FIELD_TOW = 1U << 9;             // TOW_at_current_symbol_ms (uint32)
+inline constexpr uint32_t MONITOR_V2_FIELD_PSEUDORANGE = 1U << 10;    // Pseudorange_m (double)
+inline constexpr uint32_t MONITOR_V2_FIELD_RX_TIME = 1U << 11;        // RX_time (double)
+
+// A full (non-delta) record of every subscribed channel is sent once per this
+// many datagrams, so a client joining late or losing datagrams resynchronizes
+inline constexpr uint32_t MONITOR_V2_KEYFRAME_INTERVAL = 50U;
+
 /*!
  * \brief This class sends serialized Gnss_Synchro objects
  * over UDP to one or multiple endpoints.
+ *
+ * When a subscription port is configured it additionally serves the v2
+ * protocol: clients send ASCII commands to the control port,
+ *
+ *     SUB <data_port> <rate_divisor> <channels|all> <field_mask_hex|all>
+ *     UNSUB <data_port>
+ *
+ * and receive delta-encoded binary datagrams on data_port, at the epoch rate
+ * divided by rate_divisor, restricted to the requested channel list
+ * (comma-separated) and field mask. Each datagram carries the magic "MON2",
+ * a version byte, a keyframe byte, the record count and a sequence number,
+ * followed by one record per channel whose subscribed fields changed since
+ * the last datagram: channel ID, system, signal, PRN, validity flags, the
+ * per-record presence mask, and the present field values in mask-bit order.
  */
 class Gnss_Synchro_Udp_Sink
 {
 public:
-    Gnss_Synchro_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port, bool enable_protobuf);
+    Gnss_Synchro_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port, bool enable_protobuf, bool enable_raw_struct = false, uint16_t subscription_port = 0);
     bool write_gnss_synchro(const std::vector<Gnss_Synchro>& stocks);
 
 private:
+    // One v2 subscription, keyed by the client data endpoint
+    struct Subscriber
+    {
+        boost::asio::ip::udp::endpoint data_endpoint;
+        std::map<int32_t, Gnss_Synchro> last_sent;  // per-channel state of the last datagram, for delta encoding
+        std::set<int32_t> channels;                 // empty: all channels
+        uint32_t field_mask = 0xFFFFFFFFU;
+        uint32_t rate_divisor = 1;
+        uint32_t epoch_count = 0;
+        uint32_t sent_count = 0;
+        uint32_t sequence = 0;
+    };
+
+    void poll_subscriptions();
+    void write_subscriber_datagrams(const std::vector<Gnss_Synchro>& stocks);
+
     b_io_context io_context;
     boost::asio::ip::udp::socket socket;
     boost::system::error_code error;
     std::vector<boost::asio::ip::udp::endpoint> endpoints;
     Serdes_Gnss_Synchro serdes;
+    std::string outbound_data;  // reused across epochs, so steady-state sends do not allocate
+    std::unique_ptr<boost::asio::ip::udp::socket> control_socket;  // v2 control endpoint (nullptr: v2 disabled)
+    std::vector<Subscriber> subscribers;
+    std::string v2_outbound;  // reused across epochs, like outbound_data
     bool use_protobuf;
+    bool use_raw_struct;
 };
 
 
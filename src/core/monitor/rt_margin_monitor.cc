@@ -0,0 +1,58 @@
+/*!
+ * \file rt_margin_monitor.cc
+ * \brief Implementation of a real-time margin metrics exporter with a binary
+ * UDP publisher
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rt_margin_monitor.h"
+#include <glog/logging.h>
+#include <sstream>
+
+void Rt_Margin_Monitor::configure(const std::string& address_string, uint16_t port)
+{
+    io_context_ = std::make_unique<b_io_context_rtm>();
+    socket_ = std::make_unique<boost::asio::ip::udp::socket>(*io_context_);
+    std::stringstream ss(address_string);
+    std::string address;
+    while (std::getline(ss, address, '_'))
+        {
+            boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(address, error_), port);
+            endpoints_.push_back(endpoint);
+        }
+    enabled_ = true;
+    LOG(INFO) << "Real-time margin monitor enabled on UDP port " << port;
+}
+
+
+void Rt_Margin_Monitor::publish(Rt_Margin_Record& record)
+{
+    if (!enabled_)
+        {
+            return;
+        }
+    record.sequence = sequence_++;
+    for (const auto& endpoint : endpoints_)
+        {
+            socket_->open(endpoint.protocol(), error_);
+            socket_->connect(endpoint, error_);
+            try
+                {
+                    socket_->send(boost::asio::buffer(&record, sizeof(record)));
+                }
+            catch (const boost::system::system_error& e)
+                {
+                    DLOG(INFO) << "Real-time margin monitor endpoint not reachable: " << e.what();
+                }
+        }
+}
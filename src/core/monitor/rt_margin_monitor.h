@@ -0,0 +1,91 @@
+/*!
+ * \file rt_margin_monitor.h
+ * \brief Interface of a real-time margin metrics exporter with a binary
+ * UDP publisher
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RT_MARGIN_MONITOR_H
+#define GNSS_SDR_RT_MARGIN_MONITOR_H
+
+#include <boost/asio.hpp>
+#include <boost/system/error_code.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Gnss_Synchro_Monitor
+ * \{ */
+
+
+#if USE_BOOST_ASIO_IO_CONTEXT
+using b_io_context_rtm = boost::asio::io_context;
+#else
+using b_io_context_rtm = boost::asio::io_service;
+#endif
+
+/*!
+ * \brief Fixed-size binary record with the real-time margin of one signal
+ * conditioner over one watchdog interval. This is the wire format of the
+ * UDP exporter.
+ */
+struct Rt_Margin_Record
+{
+    uint64_t total_samples;     // samples delivered by the conditioner since start-up
+    double interval_s;          // length of the measurement interval
+    double sample_rate_sps;     // observed delivery rate over the interval
+    double expected_rate_sps;   // configured sample rate of the conditioner output
+    double margin;              // observed rate / expected rate; below 1.0 the receiver falls behind
+    uint32_t conditioner;       // signal conditioner index
+    uint32_t sequence;          // record sequence number
+    uint32_t alert;             // 1 if the margin is below the alert threshold
+    uint32_t reserved;          // keeps the record size a multiple of 8 bytes
+};
+
+/*!
+ * \brief This class publishes the per-conditioner real-time margin computed
+ * by the control thread watchdog over UDP, as fixed-size binary records,
+ * following the same conventions as the other monitor exporters.
+ */
+class Rt_Margin_Monitor
+{
+public:
+    Rt_Margin_Monitor() = default;
+
+    /*!
+     * \brief Enables the publisher. The address string holds one or more IPv4
+     * addresses separated by '_', as in the other monitor blocks.
+     */
+    void configure(const std::string& address_string, uint16_t port);
+
+    inline bool enabled() const { return enabled_; }
+
+    //! Sends one record to every configured endpoint
+    void publish(Rt_Margin_Record& record);
+
+private:
+    std::unique_ptr<b_io_context_rtm> io_context_;
+    std::unique_ptr<boost::asio::ip::udp::socket> socket_;
+    std::vector<boost::asio::ip::udp::endpoint> endpoints_;
+    boost::system::error_code error_;
+    uint32_t sequence_ = 0;
+    bool enabled_ = false;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RT_MARGIN_MONITOR_H
@@ -71,9 +71,18 @@ public:
 
     inline std::string createProtobuffer(const std::vector<Gnss_Synchro>& vgs)  //!< Serialization into a string
     {
-        observables.Clear();
         std::string data;
-        for (auto gs : vgs)
+        createProtobuffer(vgs, &data);
+        return data;
+    }
+
+    //! Serialization into a caller-owned string, whose capacity is reused across calls.
+    //! The internal Observables message is also reused, so steady-state serialization
+    //! performs no heap allocation
+    inline void createProtobuffer(const std::vector<Gnss_Synchro>& vgs, std::string* data)
+    {
+        observables.Clear();
+        for (const auto& gs : vgs)
             {
                 gnss_sdr::GnssSynchro* obs = observables.add_observable();
                 char c = gs.System;
@@ -113,8 +122,7 @@ public:
                 obs->set_flag_valid_pseudorange(gs.Flag_valid_pseudorange);
                 obs->set_interp_tow_ms(gs.interp_TOW_ms);
             }
-        observables.SerializeToString(&data);
-        return data;
+        observables.SerializeToString(data);
     }
 
     inline std::vector<Gnss_Synchro> readProtobuffer(const gnss_sdr::Observables& obs) const  //!< Deserialization
@@ -0,0 +1,164 @@
+/*!
+ * \file trace_writer.cc
+ * \brief Implementation of a process-wide Chrome-trace (Perfetto compatible)
+ * JSON writer with dual wall-clock / sample-count timestamps
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "trace_writer.h"
+#include <array>
+#include <atomic>
+#include <ctime>
+#include <fstream>
+#include <mutex>
+
+namespace
+{
+std::atomic<bool> trace_enabled(false);
+
+struct Trace_State
+{
+    std::ofstream file;
+    std::chrono::steady_clock::time_point steady_origin;
+    // wall-clock microseconds corresponding to steady_origin, so steady
+    // timestamps taken inside work() can be mapped to absolute time
+    int64_t wall_origin_us = 0;
+    bool first_event = true;
+};
+
+Trace_State& state()
+{
+    static Trace_State trace_state;
+    return trace_state;
+}
+
+std::mutex& trace_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+// caller holds the trace mutex
+void write_event_prefix(Trace_State& trace)
+{
+    if (trace.first_event)
+        {
+            trace.first_event = false;
+        }
+    else
+        {
+            trace.file << ",";
+        }
+    trace.file << "\n";
+}
+
+int64_t to_trace_us(const Trace_State& trace, std::chrono::steady_clock::time_point tp)
+{
+    return trace.wall_origin_us + std::chrono::duration_cast<std::chrono::microseconds>(tp - trace.steady_origin).count();
+}
+}  // namespace
+
+
+bool Trace_Writer::start(const std::string& filename)
+{
+    std::lock_guard<std::mutex> lock(trace_mutex());
+    Trace_State& trace = state();
+    if (trace.file.is_open())
+        {
+            return false;
+        }
+    trace.file.open(filename, std::ios::out | std::ios::trunc);
+    if (!trace.file.is_open())
+        {
+            return false;
+        }
+    trace.steady_origin = std::chrono::steady_clock::now();
+    trace.wall_origin_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    trace.first_event = true;
+    trace.file << "[";
+
+    // metadata event with the trace start epoch, for offline correlation
+    const auto start_time = static_cast<std::time_t>(trace.wall_origin_us / 1000000);
+    std::array<char, 40> time_buffer{};
+    std::strftime(time_buffer.data(), time_buffer.size(), "%FT%TZ", std::gmtime(&start_time));
+    write_event_prefix(trace);
+    trace.file << R"({"name":"trace_start","cat":"metadata","ph":"i","s":"g","pid":0,"tid":0,"ts":)"
+               << trace.wall_origin_us
+               << R"(,"args":{"utc_time":")" << time_buffer.data()
+               << R"(","unix_epoch_us":)" << trace.wall_origin_us << "}}";
+
+    trace_enabled.store(true, std::memory_order_release);
+    return true;
+}
+
+
+void Trace_Writer::stop()
+{
+    std::lock_guard<std::mutex> lock(trace_mutex());
+    trace_enabled.store(false, std::memory_order_release);
+    Trace_State& trace = state();
+    if (trace.file.is_open())
+        {
+            trace.file << "\n]\n";
+            trace.file.close();
+        }
+}
+
+
+bool Trace_Writer::enabled()
+{
+    return trace_enabled.load(std::memory_order_acquire);
+}
+
+
+void Trace_Writer::complete_event(const std::string& category,
+    const std::string& name,
+    uint32_t tid,
+    std::chrono::steady_clock::time_point start,
+    uint64_t duration_ns,
+    uint64_t sample_count)
+{
+    std::lock_guard<std::mutex> lock(trace_mutex());
+    Trace_State& trace = state();
+    if (!trace.file.is_open())
+        {
+            return;
+        }
+    write_event_prefix(trace);
+    trace.file << R"({"name":")" << name
+               << R"(","cat":")" << category
+               << R"(","ph":"X","pid":0,"tid":)" << tid
+               << R"(,"ts":)" << to_trace_us(trace, start)
+               << R"(,"dur":)" << (duration_ns / 1000)
+               << R"(,"args":{"sample_count":)" << sample_count << "}}";
+}
+
+
+void Trace_Writer::instant_event(const std::string& category,
+    const std::string& name,
+    uint32_t tid,
+    uint64_t sample_count)
+{
+    std::lock_guard<std::mutex> lock(trace_mutex());
+    Trace_State& trace = state();
+    if (!trace.file.is_open())
+        {
+            return;
+        }
+    write_event_prefix(trace);
+    trace.file << R"({"name":")" << name
+               << R"(","cat":")" << category
+               << R"(","ph":"i","s":"t","pid":0,"tid":)" << tid
+               << R"(,"ts":)" << to_trace_us(trace, std::chrono::steady_clock::now())
+               << R"(,"args":{"sample_count":)" << sample_count << "}}";
+}
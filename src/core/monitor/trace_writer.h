@@ -0,0 +1,76 @@
+/*!
+ * \file trace_writer.h
+ * \brief Interface of a process-wide Chrome-trace (Perfetto compatible) JSON
+ * writer with dual wall-clock / sample-count timestamps
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACE_WRITER_H
+#define GNSS_SDR_TRACE_WRITER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Gnss_Synchro_Monitor
+ * \{ */
+
+
+/*!
+ * \brief Process-wide writer of Chrome trace events, so perf captures can be
+ * correlated with receiver events (block work() calls, channel FSM
+ * transitions, PVT epochs) from a single artifact.
+ *
+ * Every event carries the wall-clock timestamp in the standard ts field and
+ * the absolute sample count (as delivered by gnss_sdr_sample_counter through
+ * the Gnss_Synchro stream) in its args, so spans can be aligned both with
+ * external profilers and with the sample-domain receiver logs. Tracing is
+ * disabled by default and is toggled at runtime through the telecommand TCP
+ * interface; a disabled writer reduces to one atomic load per call site.
+ */
+class Trace_Writer
+{
+public:
+    //! Starts a trace, truncating filename. Returns false if the file cannot be opened
+    static bool start(const std::string& filename);
+
+    //! Closes the JSON event array and the file. Safe to call when not tracing
+    static void stop();
+
+    //! True while a trace file is open
+    static bool enabled();
+
+    /*!
+     * \brief Writes a complete ("ph":"X") event. The span start is given as a
+     * steady clock time point, as taken by Work_Monitor_Scope.
+     */
+    static void complete_event(const std::string& category,
+        const std::string& name,
+        uint32_t tid,
+        std::chrono::steady_clock::time_point start,
+        uint64_t duration_ns,
+        uint64_t sample_count);
+
+    //! Writes an instant ("ph":"i") event, e.g. a channel FSM transition
+    static void instant_event(const std::string& category,
+        const std::string& name,
+        uint32_t tid,
+        uint64_t sample_count);
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACE_WRITER_H
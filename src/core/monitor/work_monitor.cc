@@ -0,0 +1,152 @@
+/*!
+ * \file work_monitor.cc
+ * \brief Implementation of a lightweight per-block work() latency and input
+ * occupancy monitor with a binary UDP exporter
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "work_monitor.h"
+#include <glog/logging.h>
+#include <cstring>
+#include <sstream>
+
+Work_Monitor::~Work_Monitor()
+{
+    if (enabled_ && (lifetime_calls_ > 0))
+        {
+            LOG(INFO) << "Work monitor " << block_id_ << " instance " << instance_
+                      << ": " << lifetime_calls_ << " work() calls, mean "
+                      << (lifetime_ns_ / lifetime_calls_) / 1000.0 << " us, max "
+                      << lifetime_max_ns_ / 1000.0 << " us";
+        }
+}
+
+
+void Work_Monitor::configure(const std::string& block_id,
+    uint32_t instance,
+    const std::string& address_string,
+    uint16_t port,
+    uint32_t report_interval_calls)
+{
+    block_id_ = block_id;
+    instance_ = instance;
+    report_interval_calls_ = (report_interval_calls > 0 ? report_interval_calls : 1);
+    ring_.reserve(RING_SIZE);
+    io_context_ = std::make_unique<b_io_context>();
+    socket_ = std::make_unique<boost::asio::ip::udp::socket>(*io_context_);
+    std::stringstream ss(address_string);
+    std::string address;
+    while (std::getline(ss, address, '_'))
+        {
+            boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(address, error_), port);
+            endpoints_.push_back(endpoint);
+        }
+    enabled_ = true;
+    LOG(INFO) << "Work monitor enabled for " << block_id_ << " instance " << instance_
+              << ", reporting every " << report_interval_calls_ << " work() calls on UDP port " << port;
+}
+
+
+void Work_Monitor::set_identity(const std::string& block_id, uint32_t instance)
+{
+    block_id_ = block_id;
+    instance_ = instance;
+}
+
+
+void Work_Monitor::set_instance(uint32_t instance)
+{
+    instance_ = instance;
+}
+
+
+void Work_Monitor::record(uint64_t duration_ns, uint32_t input_items)
+{
+    calls_++;
+    total_ns_ += duration_ns;
+    if ((duration_ns < min_ns_) || (calls_ == 1))
+        {
+            min_ns_ = duration_ns;
+        }
+    if (duration_ns > max_ns_)
+        {
+            max_ns_ = duration_ns;
+        }
+    input_items_ += input_items;
+    if (input_items > max_input_items_)
+        {
+            max_input_items_ = input_items;
+        }
+    lifetime_calls_++;
+    lifetime_ns_ += duration_ns;
+    if (duration_ns > lifetime_max_ns_)
+        {
+            lifetime_max_ns_ = duration_ns;
+        }
+    if (calls_ >= report_interval_calls_)
+        {
+            publish();
+            reset_accumulators();
+        }
+}
+
+
+void Work_Monitor::publish()
+{
+    Work_Stats_Record record{};
+    std::strncpy(record.block_id, block_id_.c_str(), sizeof(record.block_id) - 1);
+    record.instance = instance_;
+    record.sequence = sequence_;
+    record.calls = calls_;
+    record.max_input_items = max_input_items_;
+    record.total_ns = total_ns_;
+    record.min_ns = min_ns_;
+    record.max_ns = max_ns_;
+    record.input_items = input_items_;
+
+    // ring log of past intervals, kept for post-mortem inspection
+    if (ring_.size() < RING_SIZE)
+        {
+            ring_.push_back(record);
+        }
+    else
+        {
+            ring_[sequence_ % RING_SIZE] = record;
+        }
+    sequence_++;
+
+    for (const auto& endpoint : endpoints_)
+        {
+            socket_->open(endpoint.protocol(), error_);
+            socket_->connect(endpoint, error_);
+            try
+                {
+                    socket_->send(boost::asio::buffer(&record, sizeof(record)));
+                }
+            catch (const boost::system::system_error& e)
+                {
+                    DLOG(INFO) << "Work monitor endpoint not reachable: " << e.what();
+                }
+        }
+}
+
+
+void Work_Monitor::reset_accumulators()
+{
+    calls_ = 0;
+    total_ns_ = 0;
+    min_ns_ = 0;
+    max_ns_ = 0;
+    input_items_ = 0;
+    max_input_items_ = 0;
+}
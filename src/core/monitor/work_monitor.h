@@ -0,0 +1,171 @@
+/*!
+ * \file work_monitor.h
+ * \brief Interface of a lightweight per-block work() latency and input
+ * occupancy monitor with a binary UDP exporter
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_WORK_MONITOR_H
+#define GNSS_SDR_WORK_MONITOR_H
+
+#include "trace_writer.h"
+#include <boost/asio.hpp>
+#include <boost/system/error_code.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Gnss_Synchro_Monitor
+ * \{ */
+
+
+#if USE_BOOST_ASIO_IO_CONTEXT
+using b_io_context = boost::asio::io_context;
+#else
+using b_io_context = boost::asio::io_service;
+#endif
+
+/*!
+ * \brief Fixed-size binary record with the work() statistics accumulated
+ * over one report interval. This is the wire format of the UDP exporter.
+ */
+struct Work_Stats_Record
+{
+    char block_id[16];        // short block identifier, null padded
+    uint32_t instance;        // channel number, or 0 for single-instance blocks
+    uint32_t sequence;        // record sequence number
+    uint32_t calls;           // number of work() calls in the interval
+    uint32_t max_input_items; // largest input buffer occupancy seen
+    uint64_t total_ns;        // accumulated work() duration
+    uint64_t min_ns;          // shortest work() call
+    uint64_t max_ns;          // longest work() call
+    uint64_t input_items;     // accumulated input buffer occupancy
+};
+
+/*!
+ * \brief This class accumulates per-call duration and input buffer occupancy
+ * of a processing block, keeps a ring log of past report intervals, and
+ * exports each completed record over UDP as a fixed-size binary struct.
+ *
+ * A disabled monitor reduces to a single branch per work() call. Each block
+ * instance owns its monitor and records from its own work thread, so no
+ * locking is required.
+ */
+class Work_Monitor
+{
+public:
+    Work_Monitor() = default;
+    ~Work_Monitor();
+
+    /*!
+     * \brief Enables the monitor. The address string holds one or more IPv4
+     * addresses separated by '_', as in the other monitor blocks.
+     */
+    void configure(const std::string& block_id,
+        uint32_t instance,
+        const std::string& address_string,
+        uint16_t port,
+        uint32_t report_interval_calls);
+
+    inline bool enabled() const { return enabled_; }
+
+    /*!
+     * \brief Sets the block identifier and instance without enabling the UDP
+     * exporter, so the trace writer can label spans of unmonitored blocks.
+     */
+    void set_identity(const std::string& block_id, uint32_t instance);
+
+    //! Sets the reported instance number (e.g. when the channel is assigned)
+    void set_instance(uint32_t instance);
+
+    inline const std::string& block_id() const { return block_id_; }
+    inline uint32_t instance() const { return instance_; }
+
+    //! Accumulates one work() call; publishes a record every report interval
+    void record(uint64_t duration_ns, uint32_t input_items);
+
+private:
+    static const size_t RING_SIZE = 256;
+    void publish();
+    void reset_accumulators();
+    std::vector<Work_Stats_Record> ring_;
+    std::unique_ptr<b_io_context> io_context_;
+    std::unique_ptr<boost::asio::ip::udp::socket> socket_;
+    std::vector<boost::asio::ip::udp::endpoint> endpoints_;
+    boost::system::error_code error_;
+    std::string block_id_;
+    uint64_t total_ns_ = 0;
+    uint64_t min_ns_ = 0;
+    uint64_t max_ns_ = 0;
+    uint64_t input_items_ = 0;
+    uint64_t lifetime_calls_ = 0;
+    uint64_t lifetime_ns_ = 0;
+    uint64_t lifetime_max_ns_ = 0;
+    uint32_t calls_ = 0;
+    uint32_t max_input_items_ = 0;
+    uint32_t sequence_ = 0;
+    uint32_t instance_ = 0;
+    uint32_t report_interval_calls_ = 1000;
+    bool enabled_ = false;
+};
+
+/*!
+ * \brief Scope helper that times one work() call and hands the result to a
+ * Work_Monitor when it goes out of scope. Place it at the top of work().
+ */
+class Work_Monitor_Scope
+{
+public:
+    Work_Monitor_Scope(Work_Monitor& monitor, uint32_t input_items, uint64_t sample_count = 0) : monitor_(monitor),
+                                                                                                 sample_count_(sample_count),
+                                                                                                 input_items_(input_items),
+                                                                                                 trace_(Trace_Writer::enabled())
+    {
+        if (monitor_.enabled() or trace_)
+            {
+                start_ = std::chrono::steady_clock::now();
+            }
+    }
+    ~Work_Monitor_Scope()
+    {
+        if (monitor_.enabled() or trace_)
+            {
+                const auto elapsed = std::chrono::steady_clock::now() - start_;
+                const auto elapsed_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+                if (monitor_.enabled())
+                    {
+                        monitor_.record(elapsed_ns, input_items_);
+                    }
+                if (trace_)
+                    {
+                        Trace_Writer::complete_event("work", monitor_.block_id(), monitor_.instance(), start_, elapsed_ns, sample_count_);
+                    }
+            }
+    }
+
+private:
+    Work_Monitor& monitor_;
+    std::chrono::steady_clock::time_point start_;
+    uint64_t sample_count_;
+    uint32_t input_items_;
+    bool trace_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_WORK_MONITOR_H
@@ -0,0 +1,252 @@
+/*!
+ * \file batch_orchestrator.cc
+ * \brief Batch reprocessing of capture archives with concurrent flowgraphs
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "batch_orchestrator.h"
+#include "control_thread.h"
+#include "file_configuration.h"
+#include "gnss_sdr_flags.h"
+#include <boost/exception/diagnostic_information.hpp>
+#include <glog/logging.h>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+
+Batch_Orchestrator::Batch_Orchestrator()
+{
+    if (FLAGS_c != "-")
+        {
+            config_file_ = FLAGS_c;
+        }
+    else
+        {
+            config_file_ = FLAGS_config_file;
+        }
+    results_file_ = FLAGS_batch_results;
+    max_jobs_ = FLAGS_batch_jobs;
+    if (max_jobs_ < 1)
+        {
+            max_jobs_ = 1;
+        }
+    mem_budget_mb_ = static_cast<double>(FLAGS_batch_mem_budget_mb);
+    default_job_mb_ = static_cast<double>(FLAGS_batch_job_mem_mb);
+    mem_in_flight_mb_ = 0.0;
+    next_job_ = 0;
+    jobs_running_ = 0;
+    jobs_failed_ = 0;
+}
+
+
+bool Batch_Orchestrator::parse_manifest(const std::string& manifest_path)
+{
+    std::ifstream manifest(manifest_path);
+    if (!manifest.is_open())
+        {
+            std::cerr << "Could not open the batch manifest " << manifest_path << '\n';
+            return false;
+        }
+    std::string line;
+    while (std::getline(manifest, line))
+        {
+            // trim leading / trailing whitespace
+            const auto first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos)
+                {
+                    continue;
+                }
+            const auto last = line.find_last_not_of(" \t\r");
+            line = line.substr(first, last - first + 1);
+            if (line.front() == '#')
+                {
+                    continue;
+                }
+            Batch_Job job;
+            job.estimated_mb = default_job_mb_;
+            std::stringstream fields(line);
+            std::string field;
+            while (std::getline(fields, field, '|'))
+                {
+                    if (job.capture_file.empty())
+                        {
+                            job.capture_file = field;
+                            continue;
+                        }
+                    const auto eq = field.find('=');
+                    if (eq == std::string::npos)
+                        {
+                            LOG(WARNING) << "Batch manifest: ignoring malformed override '" << field << "' for " << job.capture_file;
+                            continue;
+                        }
+                    const std::string key = field.substr(0, eq);
+                    const std::string value = field.substr(eq + 1);
+                    if (key == "mem_mb")
+                        {
+                            // scheduler hint, not a configuration property
+                            try
+                                {
+                                    job.estimated_mb = std::stod(value);
+                                }
+                            catch (const std::exception&)
+                                {
+                                    LOG(WARNING) << "Batch manifest: invalid mem_mb value '" << value << "' for " << job.capture_file;
+                                }
+                        }
+                    else
+                        {
+                            job.overrides.emplace_back(key, value);
+                        }
+                }
+            if (!job.capture_file.empty())
+                {
+                    jobs_.push_back(std::move(job));
+                }
+        }
+    return !jobs_.empty();
+}
+
+
+void Batch_Orchestrator::run_job(Batch_Job& job)
+{
+    const auto job_start = std::chrono::steady_clock::now();
+    try
+        {
+            auto configuration = std::make_shared<FileConfiguration>(config_file_);
+            configuration->set_property("SignalSource.filename", job.capture_file);
+            for (const auto& override_pair : job.overrides)
+                {
+                    configuration->set_property(override_pair.first, override_pair.second);
+                }
+            auto control_thread = std::make_unique<ControlThread>(configuration);
+            job.return_code = control_thread->run();
+            job.status = (job.return_code == 0) ? "ok" : "error";
+        }
+    catch (const boost::exception& e)
+        {
+            LOG(WARNING) << "Batch job " << job.capture_file << " threw: " << boost::diagnostic_information(e);
+            job.return_code = -1;
+            job.status = "exception";
+        }
+    catch (const std::exception& ex)
+        {
+            LOG(WARNING) << "Batch job " << job.capture_file << " threw: " << ex.what();
+            job.return_code = -1;
+            job.status = "exception";
+        }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - job_start;
+    job.elapsed_s = elapsed.count();
+}
+
+
+void Batch_Orchestrator::append_result(const Batch_Job& job)
+{
+    std::lock_guard<std::mutex> lock(results_mutex_);
+    results_out_ << job.capture_file << ','
+                 << job.status << ','
+                 << job.return_code << ','
+                 << job.elapsed_s << '\n';
+    results_out_.flush();  // one row per finished job survives a crash
+}
+
+
+void Batch_Orchestrator::worker_loop()
+{
+    while (true)
+        {
+            size_t my_job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (next_job_ >= jobs_.size())
+                    {
+                        return;
+                    }
+                // claim the next job in manifest order, then wait until its
+                // footprint estimate fits in the budget. A claimed job blocks
+                // later (possibly smaller) jobs, so admission stays in order
+                // and every job eventually runs
+                my_job = next_job_;
+                next_job_++;
+                const double estimate = jobs_[my_job].estimated_mb;
+                admission_cv_.wait(lock, [this, estimate] {
+                    return (jobs_running_ == 0) or (mem_budget_mb_ <= 0.0) or (mem_in_flight_mb_ + estimate <= mem_budget_mb_);
+                });
+                jobs_running_++;
+                mem_in_flight_mb_ += estimate;
+            }
+
+            std::cout << "Batch job " << (my_job + 1) << " of " << jobs_.size()
+                      << ": processing " << jobs_[my_job].capture_file << " ...\n";
+            run_job(jobs_[my_job]);
+            append_result(jobs_[my_job]);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                jobs_running_--;
+                mem_in_flight_mb_ -= jobs_[my_job].estimated_mb;
+                if (jobs_[my_job].return_code != 0)
+                    {
+                        jobs_failed_++;
+                    }
+            }
+            admission_cv_.notify_all();
+        }
+}
+
+
+int Batch_Orchestrator::run()
+{
+    if (!parse_manifest(FLAGS_batch_manifest))
+        {
+            std::cerr << "The batch manifest " << FLAGS_batch_manifest << " contains no jobs.\n";
+            return 1;
+        }
+    results_out_.open(results_file_);
+    if (!results_out_.is_open())
+        {
+            std::cerr << "Could not create the batch results file " << results_file_ << '\n';
+            return 1;
+        }
+    results_out_ << "capture,status,return_code,elapsed_s\n";
+
+    const int num_workers = std::min(max_jobs_, static_cast<int>(jobs_.size()));
+    std::cout << "Batch mode: " << jobs_.size() << " captures, up to "
+              << num_workers << " concurrent flowgraphs";
+    if (mem_budget_mb_ > 0.0)
+        {
+            std::cout << ", memory budget " << mem_budget_mb_ << " MB";
+        }
+    std::cout << ".\n";
+
+    std::vector<std::thread> workers;
+    workers.reserve(num_workers);
+    for (int i = 0; i < num_workers; i++)
+        {
+            workers.emplace_back(&Batch_Orchestrator::worker_loop, this);
+        }
+    for (auto& worker : workers)
+        {
+            worker.join();
+        }
+
+    results_out_.close();
+    std::cout << "Batch done: " << (jobs_.size() - static_cast<size_t>(jobs_failed_))
+              << " of " << jobs_.size() << " captures processed successfully. Results written to "
+              << results_file_ << '\n';
+    return jobs_failed_;
+}
@@ -0,0 +1,125 @@
+/*!
+ * \file channel_fs_configuration.cc
+ * \brief Implementation of the ConfigurationInterface for decimated channel groups
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "channel_fs_configuration.h"
+#include <utility>
+
+
+ChannelFsConfiguration::ChannelFsConfiguration(std::shared_ptr<ConfigurationInterface> base, int64_t fs_sps)
+    : base_(std::move(base)),
+      fs_sps_(fs_sps)
+{
+}
+
+
+bool ChannelFsConfiguration::is_fs_property(const std::string& property_name) const
+{
+    return (property_name == "GNSS-SDR.internal_fs_sps") or (property_name == "GNSS-SDR.internal_fs_hz");
+}
+
+
+std::string ChannelFsConfiguration::property(std::string property_name, std::string default_value) const
+{
+    if (is_fs_property(property_name))
+        {
+            return std::to_string(fs_sps_);
+        }
+    return base_->property(std::move(property_name), std::move(default_value));
+}
+
+
+bool ChannelFsConfiguration::property(std::string property_name, bool default_value) const
+{
+    return base_->property(std::move(property_name), default_value);
+}
+
+
+int64_t ChannelFsConfiguration::property(std::string property_name, int64_t default_value) const
+{
+    if (is_fs_property(property_name))
+        {
+            return fs_sps_;
+        }
+    return base_->property(std::move(property_name), default_value);
+}
+
+
+uint64_t ChannelFsConfiguration::property(std::string property_name, uint64_t default_value) const
+{
+    if (is_fs_property(property_name))
+        {
+            return static_cast<uint64_t>(fs_sps_);
+        }
+    return base_->property(std::move(property_name), default_value);
+}
+
+
+int32_t ChannelFsConfiguration::property(std::string property_name, int32_t default_value) const
+{
+    if (is_fs_property(property_name))
+        {
+            return static_cast<int32_t>(fs_sps_);
+        }
+    return base_->property(std::move(property_name), default_value);
+}
+
+
+uint32_t ChannelFsConfiguration::property(std::string property_name, uint32_t default_value) const
+{
+    if (is_fs_property(property_name))
+        {
+            return static_cast<uint32_t>(fs_sps_);
+        }
+    return base_->property(std::move(property_name), default_value);
+}
+
+
+int16_t ChannelFsConfiguration::property(std::string property_name, int16_t default_value) const
+{
+    return base_->property(std::move(property_name), default_value);
+}
+
+
+uint16_t ChannelFsConfiguration::property(std::string property_name, uint16_t default_value) const
+{
+    return base_->property(std::move(property_name), default_value);
+}
+
+
+float ChannelFsConfiguration::property(std::string property_name, float default_value) const
+{
+    if (is_fs_property(property_name))
+        {
+            return static_cast<float>(fs_sps_);
+        }
+    return base_->property(std::move(property_name), default_value);
+}
+
+
+double ChannelFsConfiguration::property(std::string property_name, double default_value) const
+{
+    if (is_fs_property(property_name))
+        {
+            return static_cast<double>(fs_sps_);
+        }
+    return base_->property(std::move(property_name), default_value);
+}
+
+
+void ChannelFsConfiguration::set_property(std::string property_name, std::string value)
+{
+    base_->set_property(std::move(property_name), std::move(value));
+}
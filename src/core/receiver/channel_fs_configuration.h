@@ -0,0 +1,72 @@
+/*!
+ * \file channel_fs_configuration.h
+ * \brief A ConfigurationInterface that overrides the sampling rate seen by a channel.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * When GNSSFlowgraph inserts a decimation stage in front of a group of
+ * channels, the blocks of those channels must be configured with the
+ * decimated rate instead of GNSS-SDR.internal_fs_sps. This decorator
+ * intercepts the sampling rate lookups and forwards everything else to the
+ * base configuration, so the channel adapters do not need to know whether
+ * they run at the full conditioner rate or behind a decimator.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CHANNEL_FS_CONFIGURATION_H
+#define GNSS_SDR_CHANNEL_FS_CONFIGURATION_H
+
+#include "configuration_interface.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief This class is an implementation of the interface ConfigurationInterface
+ *
+ * Derived from ConfigurationInterface, this class decorates another
+ * configuration and makes GNSS-SDR.internal_fs_sps (and the deprecated
+ * GNSS-SDR.internal_fs_hz) resolve to the sampling rate of the decimated
+ * stream feeding a group of channels.
+ */
+class ChannelFsConfiguration : public ConfigurationInterface
+{
+public:
+    ChannelFsConfiguration(std::shared_ptr<ConfigurationInterface> base, int64_t fs_sps);
+    ~ChannelFsConfiguration() = default;
+    std::string property(std::string property_name, std::string default_value) const override;
+    bool property(std::string property_name, bool default_value) const override;
+    int64_t property(std::string property_name, int64_t default_value) const override;
+    uint64_t property(std::string property_name, uint64_t default_value) const override;
+    int32_t property(std::string property_name, int32_t default_value) const override;
+    uint32_t property(std::string property_name, uint32_t default_value) const override;
+    int16_t property(std::string property_name, int16_t default_value) const override;
+    uint16_t property(std::string property_name, uint16_t default_value) const override;
+    float property(std::string property_name, float default_value) const override;
+    double property(std::string property_name, double default_value) const override;
+    void set_property(std::string property_name, std::string value) override;
+
+private:
+    bool is_fs_property(const std::string& property_name) const;
+    std::shared_ptr<ConfigurationInterface> base_;
+    int64_t fs_sps_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CHANNEL_FS_CONFIGURATION_H
@@ -36,6 +36,7 @@
 #include "gnss_flowgraph.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_flags.h"
+#include "instance_configuration.h"
 #include "gps_acq_assist.h"        // for Gps_Acq_Assist
 #include "gps_almanac.h"           // for Gps_Almanac
 #include "gps_cnav_ephemeris.h"    // for Gps_CNAV_Ephemeris
@@ -43,7 +44,9 @@
 #include "gps_ephemeris.h"         // for Gps_Ephemeris
 #include "gps_iono.h"              // for Gps_Iono
 #include "gps_utc_model.h"         // for Gps_Utc_Model
+#include "memory_registry.h"       // for Memory_Registry
 #include "pvt_interface.h"         // for PvtInterface
+#include "rt_margin_monitor.h"     // for Rt_Margin_Monitor
 #include "rtklib.h"                // for gtime_t, alm_t
 #include "rtklib_conversions.h"    // for alm_to_rtklib
 #include "rtklib_ephemeris.h"      // for alm2pos, eph2pos
@@ -53,17 +56,22 @@
 #include <glog/logging.h>          // for LOG
 #include <pmt/pmt.h>               // for make_any
 #include <algorithm>               // for find, min
+#include <cctype>                  // for toupper
 #include <chrono>                  // for milliseconds
 #include <cmath>                   // for floor, fmod, log
 #include <ctime>                   // for time_t, gmtime, strftime
 #include <exception>               // for exception
+#include <fstream>                 // for ifstream
 #include <iostream>                // for operator<<
 #include <limits>                  // for numeric_limits
 #include <map>                     // for map
 #include <pthread.h>               // for pthread_cancel
+#include <set>                     // for set
+#include <sstream>                 // for ostringstream
 #include <stdexcept>               // for invalid_argument
 #include <sys/ipc.h>               // for IPC_CREAT
 #include <sys/msg.h>               // for msgctl, msgget
+#include <sys/stat.h>              // for stat
 
 #ifdef ENABLE_FPGA
 #include <boost/chrono.hpp>  // for steady_clock
@@ -99,19 +107,111 @@ ControlThread::ControlThread(std::shared_ptr<ConfigurationInterface> configurati
 void ControlThread::init()
 {
     telecommand_enabled_ = configuration_->property("GNSS-SDR.telecommand_enabled", false);
+    // OPTIONAL: graceful degradation governor. When the CPU stays saturated, it sheds
+    // the lowest priority tracking channels instead of letting all of them lose lock
+    enable_load_governor_ = configuration_->property("GNSS-SDR.enable_load_governor", false);
+    load_governor_cpu_threshold_ = configuration_->property("GNSS-SDR.load_governor_cpu_threshold", 0.90);
+    load_governor_recovery_threshold_ = configuration_->property("GNSS-SDR.load_governor_recovery_threshold", 0.70);
+    load_governor_min_channels_ = configuration_->property("GNSS-SDR.load_governor_min_channels", 8);
+    // OPTIONAL: memory ceiling for the whole process. When the resident set
+    // exceeds it, channels are shed through the same priority order as on a
+    // CPU overload. 0 disables the check
+    load_governor_rss_ceiling_mb_ = configuration_->property("GNSS-SDR.load_governor_rss_ceiling_mb", 0.0);
+    load_governor_interval_s_ = configuration_->property("GNSS-SDR.load_governor_interval_s", 2);
+    if (load_governor_interval_s_ < 1)
+        {
+            load_governor_interval_s_ = 1;
+        }
+    load_governor_prev_busy_ = 0;
+    load_governor_prev_total_ = 0;
+    load_governor_overload_ticks_ = 0;
+    load_governor_recovery_ticks_ = 0;
+    // OPTIONAL: real-time margin watchdog. Tracks the delivered sample rate of each
+    // signal conditioner against the configured rate and publishes the margin over UDP
+    enable_rt_margin_watchdog_ = configuration_->property("GNSS-SDR.enable_rt_margin_watchdog", false);
+    rt_margin_interval_s_ = configuration_->property("GNSS-SDR.rt_margin_watchdog_interval_s", 5);
+    if (rt_margin_interval_s_ < 1)
+        {
+            rt_margin_interval_s_ = 1;
+        }
+    rt_margin_alert_threshold_ = configuration_->property("GNSS-SDR.rt_margin_watchdog_alert_threshold", 1.0);
+    if (enable_rt_margin_watchdog_)
+        {
+            rt_margin_monitor_ = std::make_unique<Rt_Margin_Monitor>();
+            rt_margin_monitor_->configure(
+                configuration_->property("GNSS-SDR.rt_margin_watchdog_address", std::string("127.0.0.1")),
+                static_cast<uint16_t>(configuration_->property("GNSS-SDR.rt_margin_watchdog_port", 1238)));
+        }
+    // OPTIONAL: configuration hot-reload. Polls the configuration file and
+    // applies runtime-safe property changes (tracking loop bandwidths,
+    // acquisition thresholds and Doppler ranges) without flowgraph restart
+    enable_config_hot_reload_ = configuration_->property("GNSS-SDR.enable_config_hot_reload", false);
+    config_reload_interval_s_ = configuration_->property("GNSS-SDR.config_reload_interval_s", 5);
+    if (config_reload_interval_s_ < 1)
+        {
+            config_reload_interval_s_ = 1;
+        }
+    config_file_mtime_ = 0;
+    if (enable_config_hot_reload_)
+        {
+            config_filename_ = (FLAGS_c == "-") ? FLAGS_config_file : FLAGS_c;
+            const auto file_configuration = std::dynamic_pointer_cast<FileConfiguration>(configuration_);
+            if (file_configuration)
+                {
+                    config_snapshot_ = file_configuration->resolved_properties();
+                    struct stat st
+                    {
+                    };
+                    if (stat(config_filename_.c_str(), &st) == 0)
+                        {
+                            config_file_mtime_ = st.st_mtime;
+                        }
+                }
+            else
+                {
+                    LOG(WARNING) << "Configuration hot-reload requires a file-based configuration, disabling it";
+                    enable_config_hot_reload_ = false;
+                }
+        }
     // OPTIONAL: specify a custom year to override the system time in order to postprocess old gnss records and avoid wrong week rollover
     pre_2009_file_ = configuration_->property("GNSS-SDR.pre_2009_file", false);
+    // OPTIONAL: several receiver instances in one process. They share the
+    // read-only assets (PRN replica and FFT plan caches, SUPL assistance, volk
+    // profiles) and read their parameters through per-instance configuration
+    // namespaces: Receiver<N>.<property> overrides <property> for instance N
+    receiver_instances_ = configuration_->property("GNSS-SDR.num_receiver_instances", 1);
+    if (receiver_instances_ < 1)
+        {
+            receiver_instances_ = 1;
+        }
     // Instantiates a control queue, a GNSS flowgraph, and a control message factory
     control_queue_ = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
     cmd_interface_.set_msg_queue(control_queue_);  // set also the queue pointer for the telecommand thread
     try
         {
-            flowgraph_ = std::make_shared<GNSSFlowgraph>(configuration_, control_queue_);
+            if (receiver_instances_ > 1)
+                {
+                    flowgraph_ = std::make_shared<GNSSFlowgraph>(std::make_shared<InstanceConfiguration>(configuration_, 0), control_queue_);
+                    for (int i = 1; i < receiver_instances_; i++)
+                        {
+                            auto instance_queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+                            extra_control_queues_.push_back(instance_queue);
+                            extra_flowgraphs_.push_back(std::make_shared<GNSSFlowgraph>(std::make_shared<InstanceConfiguration>(configuration_, i), instance_queue));
+                        }
+                }
+            else
+                {
+                    flowgraph_ = std::make_shared<GNSSFlowgraph>(configuration_, control_queue_);
+                }
         }
     catch (const boost::bad_lexical_cast &e)
         {
             std::cout << "Caught bad lexical cast with error " << e.what() << '\n';
         }
+    if (enable_load_governor_)
+        {
+            build_governor_shed_order();
+        }
     stop_ = false;
     processed_control_messages_ = 0;
     applied_actions_ = 0;
@@ -303,6 +403,31 @@ int ControlThread::run()
             LOG(ERROR) << "Unable to connect flowgraph";
             return 0;
         }
+    // At this point all the blocks have been instantiated and have reported
+    // their dominant buffers, so the memory budget is complete
+    std::ostringstream memory_budget;
+    Memory_Registry::print_budget(memory_budget);
+    LOG(INFO) << memory_budget.str();
+    if (configuration_->property("GNSS-SDR.print_memory_budget", false))
+        {
+            std::cout << memory_budget.str();
+        }
+    if (configuration_->property("GNSS-SDR.deterministic_replay", false))
+        {
+            std::cout << "Deterministic replay mode enabled: buffer depths are bounded and receiver time is driven by the sample counter\n";
+        }
+    if (configuration_->property("GNSS-SDR.enable_warm_start_snapshot", false))
+        {
+            // Seed the acquisition with the Doppler estimates saved by the
+            // previous run, so a watchdog-triggered restart reacquires in a
+            // narrow search instead of starting from scratch
+            const std::string snapshot_filename = configuration_->property("GNSS-SDR.warm_start_snapshot_file", std::string("./warm_start_snapshot.dat"));
+            const double snapshot_max_age_s = configuration_->property("GNSS-SDR.warm_start_max_age_s", 300.0);
+            if (flowgraph_->apply_warm_start_snapshot(snapshot_filename, snapshot_max_age_s))
+                {
+                    std::cout << "Warm start: acquisition assisted with the Doppler estimates of the previous run\n";
+                }
+        }
     // Start the flowgraph
     flowgraph_->start();
     if (flowgraph_->running())
@@ -315,14 +440,41 @@ int ControlThread::run()
             return 0;
         }
 
-    // launch GNSS assistance process AFTER the flowgraph is running because the GNU Radio asynchronous queues must be already running to transport msgs
-    assist_GNSS();
+    // Connect and start the secondary receiver instances, each one with its own event loop
+    for (size_t i = 0; i < extra_flowgraphs_.size(); i++)
+        {
+            extra_flowgraphs_[i]->connect();
+            if (!extra_flowgraphs_[i]->connected())
+                {
+                    LOG(ERROR) << "Unable to connect flowgraph of receiver instance " << i + 1;
+                    continue;
+                }
+            extra_flowgraphs_[i]->start();
+            if (extra_flowgraphs_[i]->running())
+                {
+                    LOG(INFO) << "Flowgraph of receiver instance " << i + 1 << " started";
+                    extra_instance_threads_.emplace_back(&ControlThread::instance_event_loop, this, i);
+                }
+            else
+                {
+                    LOG(ERROR) << "Unable to start flowgraph of receiver instance " << i + 1;
+                }
+        }
+
+    // launch GNSS assistance process AFTER the flowgraph is running because the GNU Radio asynchronous queues must be already running to transport msgs.
+    // It runs in its own thread so that SUPL network latency never delays the
+    // first samples: assistance results stream in through the telemetry
+    // message path while the receiver is already acquiring
+    agnss_thread_ = std::thread(&ControlThread::assist_GNSS, this);
     // start the keyboard_listener thread
     keyboard_thread_ = std::thread(&ControlThread::keyboard_listener, this);
     sysv_queue_thread_ = std::thread(&ControlThread::sysv_queue_listener, this);
 
     // start the telecommand listener thread
     cmd_interface_.set_pvt(flowgraph_->get_pvt());
+    cmd_interface_.set_channel_parameter_callbacks(
+        [this](int channel, const std::string &name, double value) { return flowgraph_->set_channel_parameter(channel, name, value); },
+        [this](int channel, const std::string &name, double *value) { return flowgraph_->get_channel_parameter(channel, name, value); });
     cmd_interface_thread_ = std::thread(&ControlThread::telecommand_listener, this);
 
 #ifdef ENABLE_FPGA
@@ -338,12 +490,54 @@ int ControlThread::run()
             bool valid_event = control_queue_->timed_wait_and_pop(msg, 100);
             // call the new sat dispatcher and receiver controller
             event_dispatcher(valid_event, msg);
+            if (enable_load_governor_)
+                {
+                    load_governor_tick();
+                }
+            if (enable_rt_margin_watchdog_)
+                {
+                    rt_margin_watchdog_tick();
+                }
+            if (enable_config_hot_reload_)
+                {
+                    config_hot_reload_tick();
+                }
         }
     std::cout << "Stopping GNSS-SDR, please wait!\n";
+    if (configuration_->property("GNSS-SDR.enable_warm_start_snapshot", false))
+        {
+            flowgraph_->save_warm_start_snapshot(configuration_->property("GNSS-SDR.warm_start_snapshot_file", std::string("./warm_start_snapshot.dat")));
+        }
     flowgraph_->stop();
     stop_ = true;
     flowgraph_->disconnect();
 
+    // Stop and disconnect the secondary receiver instances
+    for (auto &fg : extra_flowgraphs_)
+        {
+            fg->stop();
+        }
+    for (auto &instance_thread : extra_instance_threads_)
+        {
+            if (instance_thread.joinable())
+                {
+                    instance_thread.join();
+                }
+        }
+    for (auto &fg : extra_flowgraphs_)
+        {
+            if (fg->connected())
+                {
+                    fg->disconnect();
+                }
+        }
+
+    // Wait for the assistance thread; the per-request network timeout bounds this join
+    if (agnss_thread_.joinable())
+        {
+            agnss_thread_.join();
+        }
+
 #ifdef ENABLE_FPGA
     // trigger a HW reset
     // The HW reset causes any HW accelerator module that is waiting for more samples to complete its calculations
@@ -392,6 +586,440 @@ void ControlThread::set_control_queue(std::shared_ptr<Concurrent_Queue<pmt::pmt_
 }
 
 
+void ControlThread::instance_event_loop(size_t instance)
+{
+    const std::shared_ptr<GNSSFlowgraph> fg = extra_flowgraphs_[instance];
+    const std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> queue = extra_control_queues_[instance];
+    pmt::pmt_t msg;
+    while (fg->running() && !stop_)
+        {
+            if (queue->timed_wait_and_pop(msg, 100))
+                {
+                    if (pmt::any_ref(msg).type().hash_code() == channel_event_type_hash_code_)
+                        {
+                            const auto new_event = boost::any_cast<channel_event_sptr>(pmt::any_ref(msg));
+                            DLOG(INFO) << "Receiver instance " << instance + 1
+                                       << ": channel event rx from ch id: " << new_event->channel_id
+                                       << " what: " << new_event->event_type;
+                            fg->apply_action(new_event->channel_id, new_event->event_type);
+                        }
+                }
+            else
+                {
+                    // perform non-priority tasks
+                    fg->acquisition_manager(0);  // start acquisition of untracked satellites
+                }
+        }
+}
+
+
+bool ControlThread::send_telemetry_msg(const pmt::pmt_t &msg)
+{
+    bool result = flowgraph_->send_telemetry_msg(msg);
+    for (auto &fg : extra_flowgraphs_)
+        {
+            result = fg->send_telemetry_msg(msg) && result;
+        }
+    return result;
+}
+
+
+bool ControlThread::read_cpu_counters(uint64_t *busy, uint64_t *total)
+{
+    // aggregated first line of /proc/stat: cpu user nice system idle iowait irq softirq steal
+    std::ifstream proc_stat("/proc/stat");
+    if (!proc_stat.is_open())
+        {
+            return false;
+        }
+    std::string cpu_label;
+    uint64_t user = 0;
+    uint64_t nice = 0;
+    uint64_t system = 0;
+    uint64_t idle = 0;
+    uint64_t iowait = 0;
+    uint64_t irq = 0;
+    uint64_t softirq = 0;
+    uint64_t steal = 0;
+    proc_stat >> cpu_label >> user >> nice >> system >> idle >> iowait >> irq >> softirq >> steal;
+    if (proc_stat.fail() || (cpu_label != "cpu"))
+        {
+            return false;
+        }
+    *total = user + nice + system + idle + iowait + irq + softirq + steal;
+    *busy = *total - idle - iowait;
+    return true;
+}
+
+
+bool ControlThread::read_own_rss_mb(double *rss_mb)
+{
+    std::ifstream proc_status("/proc/self/status");
+    if (!proc_status.is_open())
+        {
+            return false;
+        }
+    std::string line;
+    while (std::getline(proc_status, line))
+        {
+            if (line.compare(0, 6, "VmRSS:") == 0)
+                {
+                    std::stringstream field(line.substr(6));
+                    uint64_t rss_kb = 0;
+                    field >> rss_kb;
+                    if (field.fail())
+                        {
+                            return false;
+                        }
+                    *rss_mb = static_cast<double>(rss_kb) / 1024.0;
+                    return true;
+                }
+        }
+    return false;
+}
+
+
+void ControlThread::build_governor_shed_order()
+{
+    governor_shed_order_.clear();
+    if (!flowgraph_)
+        {
+            return;
+        }
+    for (int instance = 0; instance < receiver_instances_; instance++)
+        {
+            std::shared_ptr<ConfigurationInterface> instance_configuration = configuration_;
+            if (receiver_instances_ > 1)
+                {
+                    instance_configuration = std::make_shared<InstanceConfiguration>(configuration_, instance);
+                }
+            Governor_Instance entry{};
+            entry.flowgraph = (instance == 0) ? flowgraph_ : extra_flowgraphs_[instance - 1];
+            entry.instance_id = instance;
+            // by default later instances are less protected, so the production
+            // receiver goes in Receiver0 and the experimental ones after it.
+            // Receiver<N>.GNSS-SDR.instance_priority overrides the ordering
+            entry.priority = instance_configuration->property("GNSS-SDR.instance_priority", instance);
+            entry.min_channels = instance_configuration->property("GNSS-SDR.load_governor_min_channels", load_governor_min_channels_);
+            governor_shed_order_.push_back(entry);
+        }
+    // least protected (largest priority value) first; ties shed the
+    // youngest instance first
+    std::stable_sort(governor_shed_order_.begin(), governor_shed_order_.end(),
+        [](const Governor_Instance &a, const Governor_Instance &b) {
+            if (a.priority != b.priority)
+                {
+                    return a.priority > b.priority;
+                }
+            return a.instance_id > b.instance_id;
+        });
+}
+
+
+void ControlThread::load_governor_tick()
+{
+    if (receiver_on_standby_)
+        {
+            return;
+        }
+    const auto now = std::chrono::steady_clock::now();
+    if (now - load_governor_last_tick_ < std::chrono::seconds(load_governor_interval_s_))
+        {
+            return;
+        }
+    load_governor_last_tick_ = now;
+
+    uint64_t busy = 0;
+    uint64_t total = 0;
+    if (!read_cpu_counters(&busy, &total))
+        {
+            return;  // no Linux-style procfs, the governor stays inert
+        }
+    const uint64_t busy_delta = busy - load_governor_prev_busy_;
+    const uint64_t total_delta = total - load_governor_prev_total_;
+    const bool first_sample = (load_governor_prev_total_ == 0);
+    load_governor_prev_busy_ = busy;
+    load_governor_prev_total_ = total;
+    if (first_sample || (total_delta == 0))
+        {
+            return;
+        }
+    const double cpu_load = static_cast<double>(busy_delta) / static_cast<double>(total_delta);
+    DLOG(INFO) << "Load governor: CPU load " << cpu_load;
+
+    bool mem_overload = false;
+    if (load_governor_rss_ceiling_mb_ > 0.0)
+        {
+            double rss_mb = 0.0;
+            if (read_own_rss_mb(&rss_mb) and (rss_mb >= load_governor_rss_ceiling_mb_))
+                {
+                    mem_overload = true;
+                    DLOG(INFO) << "Load governor: resident set " << rss_mb
+                               << " MB exceeds the " << load_governor_rss_ceiling_mb_ << " MB ceiling";
+                }
+        }
+
+    if ((cpu_load >= load_governor_cpu_threshold_) or mem_overload)
+        {
+            load_governor_recovery_ticks_ = 0;
+            load_governor_overload_ticks_++;
+            // shed only after three consecutive saturated intervals, so that a
+            // transient burst (e.g. a RINEX dump) does not drop a channel
+            if (load_governor_overload_ticks_ >= 3)
+                {
+                    // rank the tracked satellites by elevation when a PVT fix is available
+                    std::vector<std::pair<int, Gnss_Satellite>> visible_satellites;
+                    double longitude_deg = 0.0;
+                    double latitude_deg = 0.0;
+                    double height_m = 0.0;
+                    double ground_speed_kmh = 0.0;
+                    double course_over_ground_deg = 0.0;
+                    time_t utc_time = 0;
+                    if (flowgraph_->get_pvt()->get_latest_PVT(&longitude_deg, &latitude_deg, &height_m,
+                            &ground_speed_kmh, &course_over_ground_deg, &utc_time))
+                        {
+                            const std::array<float, 3> LLH = {static_cast<float>(latitude_deg),
+                                static_cast<float>(longitude_deg),
+                                static_cast<float>(height_m)};
+                            visible_satellites = get_visible_sats(utc_time, LLH);
+                        }
+                    // least protected instance first: an already shed instance
+                    // at its channel floor returns -1 and the next one is tried
+                    for (const auto &instance : governor_shed_order_)
+                        {
+                            const int shed_channel = instance.flowgraph->shed_lowest_priority_channel(visible_satellites, instance.min_channels);
+                            if (shed_channel >= 0)
+                                {
+                                    std::cout << "Load governor: "
+                                              << (mem_overload ? "memory ceiling exceeded"
+                                                               : "CPU load at " + std::to_string(static_cast<int>(cpu_load * 100.0)) + " %")
+                                              << ", channel " << shed_channel;
+                                    if (governor_shed_order_.size() > 1)
+                                        {
+                                            std::cout << " of receiver instance " << instance.instance_id;
+                                        }
+                                    std::cout << " set to standby\n";
+                                    break;
+                                }
+                        }
+                    // require a new sustained overload before shedding the next channel
+                    load_governor_overload_ticks_ = 0;
+                }
+        }
+    else if (cpu_load <= load_governor_recovery_threshold_)
+        {
+            load_governor_overload_ticks_ = 0;
+            load_governor_recovery_ticks_++;
+            if (load_governor_recovery_ticks_ >= 3)
+                {
+                    // most protected instance recovers first, one instance per
+                    // recovery interval so the load is re-checked in between
+                    for (auto it = governor_shed_order_.rbegin(); it != governor_shed_order_.rend(); ++it)
+                        {
+                            if (it->flowgraph->restore_shed_channels())
+                                {
+                                    std::cout << "Load governor: CPU load recovered, shed channels";
+                                    if (governor_shed_order_.size() > 1)
+                                        {
+                                            std::cout << " of receiver instance " << it->instance_id;
+                                        }
+                                    std::cout << " returned to acquisition\n";
+                                    break;
+                                }
+                        }
+                    load_governor_recovery_ticks_ = 0;
+                }
+        }
+    else
+        {
+            // between thresholds: hold the current channel set
+            load_governor_overload_ticks_ = 0;
+            load_governor_recovery_ticks_ = 0;
+        }
+}
+
+
+void ControlThread::rt_margin_watchdog_tick()
+{
+    if (receiver_on_standby_)
+        {
+            return;
+        }
+    const auto now = std::chrono::steady_clock::now();
+    if (now - rt_margin_last_tick_ < std::chrono::seconds(rt_margin_interval_s_))
+        {
+            return;
+        }
+    const double interval_s = std::chrono::duration<double>(now - rt_margin_last_tick_).count();
+    const bool first_sample = rt_margin_prev_counts_.empty();
+    rt_margin_last_tick_ = now;
+
+    const std::vector<uint64_t> counts = flowgraph_->get_conditioner_sample_counts();
+    if (counts.empty())
+        {
+            return;  // flowgraph not connected yet
+        }
+    if (first_sample || (counts.size() != rt_margin_prev_counts_.size()))
+        {
+            rt_margin_prev_counts_ = counts;
+            return;
+        }
+
+    const auto expected_rate_sps = static_cast<double>(configuration_->property("GNSS-SDR.internal_fs_sps", 0));
+    for (size_t conditioner = 0; conditioner < counts.size(); conditioner++)
+        {
+            const uint64_t delivered = counts[conditioner] - rt_margin_prev_counts_[conditioner];
+            const double sample_rate_sps = static_cast<double>(delivered) / interval_s;
+            const double margin = (expected_rate_sps > 0.0) ? (sample_rate_sps / expected_rate_sps) : 0.0;
+
+            Rt_Margin_Record record{};
+            record.total_samples = counts[conditioner];
+            record.interval_s = interval_s;
+            record.sample_rate_sps = sample_rate_sps;
+            record.expected_rate_sps = expected_rate_sps;
+            record.margin = margin;
+            record.conditioner = static_cast<uint32_t>(conditioner);
+            record.alert = (margin < rt_margin_alert_threshold_) ? 1 : 0;
+            rt_margin_monitor_->publish(record);
+
+            if (record.alert == 1)
+                {
+                    std::cout << "Real-time margin watchdog: signal conditioner " << conditioner
+                              << " delivered " << sample_rate_sps / 1.0e6 << " Msps against "
+                              << expected_rate_sps / 1.0e6 << " Msps expected (margin "
+                              << margin << ")\n";
+                    LOG(WARNING) << "Real-time margin of conditioner " << conditioner
+                                 << " below threshold: " << margin
+                                 << ". Check the per-block work() statistics on the work monitor "
+                                 << "stream to locate the block exceeding its budget";
+                }
+            else
+                {
+                    DLOG(INFO) << "Real-time margin of conditioner " << conditioner << ": " << margin;
+                }
+        }
+    rt_margin_prev_counts_ = counts;
+}
+
+
+bool ControlThread::apply_runtime_property(const std::string &key, const std::string &value)
+{
+    // resolved keys arrive lower-cased and prefixed by the INI section, e.g.
+    // "gnss-sdr.tracking_1c.pll_bw_hz"
+    const std::string prefix("gnss-sdr.");
+    if (key.compare(0, prefix.size(), prefix) != 0)
+        {
+            return false;
+        }
+    const std::string property = key.substr(prefix.size());
+    const auto dot = property.find('.');
+    if (dot == std::string::npos)
+        {
+            return false;
+        }
+    const std::string block = property.substr(0, dot);
+    const std::string parameter = property.substr(dot + 1);
+
+    static const std::set<std::string> runtime_tracking_parameters = {"pll_bw_hz", "pll_bw_narrow_hz", "dll_bw_hz", "dll_bw_narrow_hz", "fll_bw_hz"};
+    static const std::set<std::string> runtime_acquisition_parameters = {"threshold", "doppler_max", "doppler_step"};
+
+    const bool is_tracking = (block.compare(0, 9, "tracking_") == 0) and (runtime_tracking_parameters.count(parameter) > 0);
+    const bool is_acquisition = (block.compare(0, 12, "acquisition_") == 0) and (runtime_acquisition_parameters.count(parameter) > 0);
+    if (!is_tracking and !is_acquisition)
+        {
+            return false;
+        }
+
+    double numeric_value;
+    try
+        {
+            numeric_value = std::stod(value);
+        }
+    catch (const std::exception &)
+        {
+            LOG(WARNING) << "Configuration hot-reload: " << property << "=" << value << " is not a number, ignored";
+            return false;
+        }
+
+    // map the block suffix back to the signal identifier ("1c" -> "1C")
+    std::string signal_str = property.substr(property.find('_') + 1, dot - property.find('_') - 1);
+    for (char &c : signal_str)
+        {
+            c = toupper(c);
+        }
+    const int updated = flowgraph_->set_signal_group_parameter(signal_str, parameter, numeric_value);
+    if (updated > 0)
+        {
+            LOG(INFO) << "Configuration hot-reload: " << property << "=" << value << " applied to " << updated << " channel(s)";
+        }
+    return updated > 0;
+}
+
+
+void ControlThread::config_hot_reload_tick()
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (now - config_reload_last_tick_ < std::chrono::seconds(config_reload_interval_s_))
+        {
+            return;
+        }
+    config_reload_last_tick_ = now;
+
+    struct stat st
+    {
+    };
+    if (stat(config_filename_.c_str(), &st) != 0)
+        {
+            return;
+        }
+    if (st.st_mtime == config_file_mtime_)
+        {
+            return;
+        }
+    config_file_mtime_ = st.st_mtime;
+
+    const FileConfiguration reloaded(config_filename_);
+    const std::map<std::string, std::string> &fresh = reloaded.resolved_properties();
+    int applied = 0;
+    int deferred = 0;
+    for (const auto &entry : fresh)
+        {
+            const auto old_entry = config_snapshot_.find(entry.first);
+            if (old_entry != config_snapshot_.end() and old_entry->second == entry.second)
+                {
+                    continue;
+                }
+            if (apply_runtime_property(entry.first, entry.second))
+                {
+                    applied++;
+                }
+            else
+                {
+                    deferred++;
+                    LOG(INFO) << "Configuration hot-reload: " << entry.first << " changed, but it takes effect on the next receiver restart";
+                }
+        }
+    for (const auto &entry : config_snapshot_)
+        {
+            if (fresh.count(entry.first) == 0)
+                {
+                    deferred++;
+                    LOG(INFO) << "Configuration hot-reload: " << entry.first << " removed, restoring its default requires a receiver restart";
+                }
+        }
+    config_snapshot_ = fresh;
+    if (applied > 0 or deferred > 0)
+        {
+            std::cout << "Configuration file reloaded: " << applied << " propert" << (applied == 1 ? "y" : "ies") << " applied at runtime";
+            if (deferred > 0)
+                {
+                    std::cout << ", " << deferred << " deferred to the next restart";
+                }
+            std::cout << '\n';
+        }
+}
+
+
 /*
  * Returns true if reading was successful
  */
@@ -446,7 +1074,7 @@ bool ControlThread::read_assistance_from_XML()
                         {
                             std::cout << "From XML file: Read NAV ephemeris for satellite " << Gnss_Satellite("GPS", gps_eph_iter->second.i_satellite_PRN) << '\n';
                             const std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(gps_eph_iter->second);
-                            flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                            send_telemetry_msg(pmt::make_any(tmp_obj));
                         }
                     ret = true;
                 }
@@ -454,7 +1082,7 @@ bool ControlThread::read_assistance_from_XML()
             if (supl_client_acquisition_.load_utc_xml(utc_xml_filename) == true)
                 {
                     const std::shared_ptr<Gps_Utc_Model> tmp_obj = std::make_shared<Gps_Utc_Model>(supl_client_acquisition_.gps_utc);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    send_telemetry_msg(pmt::make_any(tmp_obj));
                     std::cout << "From XML file: Read GPS UTC model parameters.\n";
                     ret = true;
                 }
@@ -462,7 +1090,7 @@ bool ControlThread::read_assistance_from_XML()
             if (supl_client_acquisition_.load_iono_xml(iono_xml_filename) == true)
                 {
                     const std::shared_ptr<Gps_Iono> tmp_obj = std::make_shared<Gps_Iono>(supl_client_acquisition_.gps_iono);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    send_telemetry_msg(pmt::make_any(tmp_obj));
                     std::cout << "From XML file: Read GPS ionosphere model parameters.\n";
                     ret = true;
                 }
@@ -476,7 +1104,7 @@ bool ControlThread::read_assistance_from_XML()
                         {
                             std::cout << "From XML file: Read GPS almanac for satellite " << Gnss_Satellite("GPS", gps_alm_iter->second.i_satellite_PRN) << '\n';
                             const std::shared_ptr<Gps_Almanac> tmp_obj = std::make_shared<Gps_Almanac>(gps_alm_iter->second);
-                            flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                            send_telemetry_msg(pmt::make_any(tmp_obj));
                         }
                     ret = true;
                 }
@@ -493,7 +1121,7 @@ bool ControlThread::read_assistance_from_XML()
                         {
                             std::cout << "From XML file: Read ephemeris for satellite " << Gnss_Satellite("Galileo", gal_eph_iter->second.i_satellite_PRN) << '\n';
                             const std::shared_ptr<Galileo_Ephemeris> tmp_obj = std::make_shared<Galileo_Ephemeris>(gal_eph_iter->second);
-                            flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                            send_telemetry_msg(pmt::make_any(tmp_obj));
                         }
                     ret = true;
                 }
@@ -501,7 +1129,7 @@ bool ControlThread::read_assistance_from_XML()
             if (supl_client_acquisition_.load_gal_iono_xml(gal_iono_xml_filename) == true)
                 {
                     const std::shared_ptr<Galileo_Iono> tmp_obj = std::make_shared<Galileo_Iono>(supl_client_acquisition_.gal_iono);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    send_telemetry_msg(pmt::make_any(tmp_obj));
                     std::cout << "From XML file: Read Galileo ionosphere model parameters.\n";
                     ret = true;
                 }
@@ -509,7 +1137,7 @@ bool ControlThread::read_assistance_from_XML()
             if (supl_client_acquisition_.load_gal_utc_xml(gal_utc_xml_filename) == true)
                 {
                     const std::shared_ptr<Galileo_Utc_Model> tmp_obj = std::make_shared<Galileo_Utc_Model>(supl_client_acquisition_.gal_utc);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    send_telemetry_msg(pmt::make_any(tmp_obj));
                     std::cout << "From XML file: Read Galileo UTC model parameters.\n";
                     ret = true;
                 }
@@ -523,7 +1151,7 @@ bool ControlThread::read_assistance_from_XML()
                         {
                             std::cout << "From XML file: Read Galileo almanac for satellite " << Gnss_Satellite("Galileo", gal_alm_iter->second.i_satellite_PRN) << '\n';
                             const std::shared_ptr<Galileo_Almanac> tmp_obj = std::make_shared<Galileo_Almanac>(gal_alm_iter->second);
-                            flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                            send_telemetry_msg(pmt::make_any(tmp_obj));
                         }
                     ret = true;
                 }
@@ -540,7 +1168,7 @@ bool ControlThread::read_assistance_from_XML()
                         {
                             std::cout << "From XML file: Read CNAV ephemeris for satellite " << Gnss_Satellite("GPS", gps_cnav_eph_iter->second.i_satellite_PRN) << '\n';
                             const std::shared_ptr<Gps_CNAV_Ephemeris> tmp_obj = std::make_shared<Gps_CNAV_Ephemeris>(gps_cnav_eph_iter->second);
-                            flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                            send_telemetry_msg(pmt::make_any(tmp_obj));
                         }
                     ret = true;
                 }
@@ -548,7 +1176,7 @@ bool ControlThread::read_assistance_from_XML()
             if (supl_client_acquisition_.load_cnav_utc_xml(cnav_utc_xml_filename) == true)
                 {
                     const std::shared_ptr<Gps_CNAV_Utc_Model> tmp_obj = std::make_shared<Gps_CNAV_Utc_Model>(supl_client_acquisition_.gps_cnav_utc);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    send_telemetry_msg(pmt::make_any(tmp_obj));
                     std::cout << "From XML file: Read GPS CNAV UTC model parameters.\n";
                     ret = true;
                 }
@@ -565,7 +1193,7 @@ bool ControlThread::read_assistance_from_XML()
                         {
                             std::cout << "From XML file: Read GLONASS GNAV ephemeris for satellite " << Gnss_Satellite("GLONASS", glo_gnav_eph_iter->second.i_satellite_PRN) << '\n';
                             const std::shared_ptr<Glonass_Gnav_Ephemeris> tmp_obj = std::make_shared<Glonass_Gnav_Ephemeris>(glo_gnav_eph_iter->second);
-                            flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                            send_telemetry_msg(pmt::make_any(tmp_obj));
                         }
                     ret = true;
                 }
@@ -573,7 +1201,7 @@ bool ControlThread::read_assistance_from_XML()
             if (supl_client_acquisition_.load_glo_utc_xml(glo_utc_xml_filename) == true)
                 {
                     const std::shared_ptr<Glonass_Gnav_Utc_Model> tmp_obj = std::make_shared<Glonass_Gnav_Utc_Model>(supl_client_acquisition_.glo_gnav_utc);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    send_telemetry_msg(pmt::make_any(tmp_obj));
                     std::cout << "From XML file: Read GLONASS UTC model parameters.\n";
                     ret = true;
                 }
@@ -594,7 +1222,7 @@ bool ControlThread::read_assistance_from_XML()
                 {
                     LOG(INFO) << "SUPL: Read XML Ref Time";
                     const std::shared_ptr<Agnss_Ref_Time> tmp_obj = std::make_shared<Agnss_Ref_Time>(supl_client_acquisition_.gps_time);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    send_telemetry_msg(pmt::make_any(tmp_obj));
                 }
             else
                 {
@@ -606,7 +1234,7 @@ bool ControlThread::read_assistance_from_XML()
                 {
                     LOG(INFO) << "SUPL: Read XML Ref Location";
                     const std::shared_ptr<Agnss_Ref_Location> tmp_obj = std::make_shared<Agnss_Ref_Location>(supl_client_acquisition_.gps_ref_loc);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    send_telemetry_msg(pmt::make_any(tmp_obj));
                 }
             else
                 {
@@ -633,6 +1261,9 @@ void ControlThread::assist_GNSS()
             supl_client_acquisition_.server_name = configuration_->property("GNSS-SDR.SUPL_gps_acquisition_server", default_eph_server);
             supl_client_ephemeris_.server_port = configuration_->property("GNSS-SDR.SUPL_gps_ephemeris_port", 7275);
             supl_client_acquisition_.server_port = configuration_->property("GNSS-SDR.SUPL_gps_acquisition_port", 7275);
+            const int supl_timeout_s = configuration_->property("GNSS-SDR.SUPL_network_timeout_s", 20);
+            supl_client_ephemeris_.network_timeout_s = supl_timeout_s;
+            supl_client_acquisition_.network_timeout_s = supl_timeout_s;
             supl_mcc_ = configuration_->property("GNSS-SDR.SUPL_MCC", 244);
             supl_mns_ = configuration_->property("GNSS-SDR.SUPL_MNC ", 5);
 
@@ -694,7 +1325,7 @@ void ControlThread::assist_GNSS()
                                 {
                                     std::cout << "SUPL: Received ephemeris data for satellite " << Gnss_Satellite("GPS", gps_eph_iter->second.i_satellite_PRN) << '\n';
                                     const std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(gps_eph_iter->second);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                                    send_telemetry_msg(pmt::make_any(tmp_obj));
                                 }
                             // Save ephemeris to XML file
                             const std::string eph_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_ephemeris_xml", eph_default_xml_filename_);
@@ -718,6 +1349,10 @@ void ControlThread::assist_GNSS()
                                 }
                         }
 
+                    if (stop_)
+                        {
+                            return;
+                        }
                     // Request almanac, IONO and UTC Model data
                     supl_client_ephemeris_.request = 0;
                     std::cout << "SUPL: Try to read Almanac, Iono, Utc Model, Ref Time and Ref Location data from SUPL server...\n";
@@ -731,20 +1366,20 @@ void ControlThread::assist_GNSS()
                                 {
                                     std::cout << "SUPL: Received almanac data for satellite " << Gnss_Satellite("GPS", gps_alm_iter->second.i_satellite_PRN) << '\n';
                                     const std::shared_ptr<Gps_Almanac> tmp_obj = std::make_shared<Gps_Almanac>(gps_alm_iter->second);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                                    send_telemetry_msg(pmt::make_any(tmp_obj));
                                 }
                             supl_client_ephemeris_.save_gps_almanac_xml("gps_almanac_map.xml", supl_client_ephemeris_.gps_almanac_map);
                             if (supl_client_ephemeris_.gps_iono.valid == true)
                                 {
                                     std::cout << "SUPL: Received GPS Ionosphere model parameters\n";
                                     const std::shared_ptr<Gps_Iono> tmp_obj = std::make_shared<Gps_Iono>(supl_client_ephemeris_.gps_iono);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                                    send_telemetry_msg(pmt::make_any(tmp_obj));
                                 }
                             if (supl_client_ephemeris_.gps_utc.valid == true)
                                 {
                                     std::cout << "SUPL: Received GPS UTC model parameters\n";
                                     const std::shared_ptr<Gps_Utc_Model> tmp_obj = std::make_shared<Gps_Utc_Model>(supl_client_ephemeris_.gps_utc);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                                    send_telemetry_msg(pmt::make_any(tmp_obj));
                                 }
                             // Save iono and UTC model data to xml file
                             const std::string iono_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_iono_xml", iono_default_xml_filename_);
@@ -772,6 +1407,10 @@ void ControlThread::assist_GNSS()
                             std::cout << "Please check your network connectivity and SUPL server configuration\n";
                         }
 
+                    if (stop_)
+                        {
+                            return;
+                        }
                     // Request acquisition assistance
                     supl_client_acquisition_.request = 2;
                     std::cout << "SUPL: Try to read acquisition assistance data from SUPL server...\n";
@@ -791,7 +1430,7 @@ void ControlThread::assist_GNSS()
                                     std::cout << "SUPL: Received Ref Location data (Acquisition Assistance)\n";
                                     agnss_ref_location_ = supl_client_acquisition_.gps_ref_loc;
                                     const std::shared_ptr<Agnss_Ref_Location> tmp_obj = std::make_shared<Agnss_Ref_Location>(agnss_ref_location_);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                                    send_telemetry_msg(pmt::make_any(tmp_obj));
                                     supl_client_acquisition_.save_ref_location_xml("agnss_ref_location.xml", agnss_ref_location_);
                                 }
                             if (supl_client_acquisition_.gps_time.valid == true)
@@ -799,7 +1438,7 @@ void ControlThread::assist_GNSS()
                                     std::cout << "SUPL: Received Ref Time data (Acquisition Assistance)\n";
                                     agnss_ref_time_ = supl_client_acquisition_.gps_time;
                                     const std::shared_ptr<Agnss_Ref_Time> tmp_obj = std::make_shared<Agnss_Ref_Time>(agnss_ref_time_);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                                    send_telemetry_msg(pmt::make_any(tmp_obj));
                                     supl_client_acquisition_.save_ref_time_xml("agnss_ref_time.xml", agnss_ref_time_);
                                 }
                         }
@@ -920,6 +1559,18 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
     utc_gtime.sec = 0.0;
     const gtime_t gps_gtime = utc2gpst(utc_gtime);
 
+    // second evaluation epoch, used to estimate the Doppler from the range rate
+    constexpr double dt_s = 10.0;
+    gtime_t gps_gtime2 = gps_gtime;
+    gps_gtime2.time += static_cast<time_t>(dt_s);
+
+    // predicted Doppler at L1/E1 for a static receiver, from the range rate
+    const auto predicted_doppler_hz = [&](double range_now_m, const std::array<double, 3> &r_later) {
+        const double range_later_m = arma::norm(arma::vec{r_later[0], r_later[1], r_later[2]} - r_eb_e);
+        return -((range_later_m - range_now_m) / dt_s) * (FREQ1 / SPEED_OF_LIGHT_M_S);
+    };
+    std::map<std::string, double> doppler_hints_hz;
+
     // 3. loop through all the available ephemeris or almanac and compute satellite positions and elevations
     // store visible satellites in a vector of pairs <int,Gnss_Satellite> to associate an elevation to the each satellite
     std::vector<std::pair<int, Gnss_Satellite>> available_satellites;
@@ -945,6 +1596,9 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
             double sat_pos_variance_m2;
             eph2pos(gps_gtime, &rtklib_eph, r_sat.data(), &clock_bias_s,
                 &sat_pos_variance_m2);
+            std::array<double, 3> r_sat2{};
+            eph2pos(gps_gtime2, &rtklib_eph, r_sat2.data(), &clock_bias_s,
+                &sat_pos_variance_m2);
             double Az;
             double El;
             double dist_m;
@@ -958,6 +1612,7 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
                     available_satellites.emplace_back(floor(El),
                         (Gnss_Satellite(std::string("GPS"), it.second.i_satellite_PRN)));
                     visible_gps.push_back(it.second.i_satellite_PRN);
+                    doppler_hints_hz["GPS " + std::to_string(it.second.i_satellite_PRN)] = predicted_doppler_hz(dist_m, r_sat2);
                 }
         }
 
@@ -970,6 +1625,9 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
             double sat_pos_variance_m2;
             eph2pos(gps_gtime, &rtklib_eph, r_sat.data(), &clock_bias_s,
                 &sat_pos_variance_m2);
+            std::array<double, 3> r_sat2{};
+            eph2pos(gps_gtime2, &rtklib_eph, r_sat2.data(), &clock_bias_s,
+                &sat_pos_variance_m2);
             double Az;
             double El;
             double dist_m;
@@ -983,6 +1641,7 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
                     available_satellites.emplace_back(floor(El),
                         (Gnss_Satellite(std::string("Galileo"), it.second.i_satellite_PRN)));
                     visible_gal.push_back(it.second.i_satellite_PRN);
+                    doppler_hints_hz["Galileo " + std::to_string(it.second.i_satellite_PRN)] = predicted_doppler_hz(dist_m, r_sat2);
                 }
         }
 
@@ -996,6 +1655,10 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
             aux_gtime.time = fmod(utc2gpst(gps_gtime).time + 345600, 604800);
             aux_gtime.sec = 0.0;
             alm2pos(aux_gtime, &rtklib_alm, r_sat.data(), &clock_bias_s);
+            std::array<double, 3> r_sat2{};
+            gtime_t aux_gtime2 = aux_gtime;
+            aux_gtime2.time += static_cast<time_t>(dt_s);
+            alm2pos(aux_gtime2, &rtklib_alm, r_sat2.data(), &clock_bias_s);
             double Az;
             double El;
             double dist_m;
@@ -1012,6 +1675,7 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
                             std::cout << "Using GPS Almanac:  Sat " << it.second.i_satellite_PRN << " Az: " << Az << " El: " << El << '\n';
                             available_satellites.emplace_back(floor(El),
                                 (Gnss_Satellite(std::string("GPS"), it.second.i_satellite_PRN)));
+                            doppler_hints_hz["GPS " + std::to_string(it.second.i_satellite_PRN)] = predicted_doppler_hz(dist_m, r_sat2);
                         }
                 }
         }
@@ -1026,6 +1690,10 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
             gal_gtime.time = fmod(utc2gpst(gps_gtime).time + 345600, 604800);
             gal_gtime.sec = 0.0;
             alm2pos(gal_gtime, &rtklib_alm, r_sat.data(), &clock_bias_s);
+            std::array<double, 3> r_sat2{};
+            gtime_t gal_gtime2 = gal_gtime;
+            gal_gtime2.time += static_cast<time_t>(dt_s);
+            alm2pos(gal_gtime2, &rtklib_alm, r_sat2.data(), &clock_bias_s);
             double Az;
             double El;
             double dist_m;
@@ -1042,6 +1710,7 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
                             std::cout << "Using Galileo Almanac:  Sat " << it.second.i_satellite_PRN << " Az: " << Az << " El: " << El << '\n';
                             available_satellites.emplace_back(floor(El),
                                 (Gnss_Satellite(std::string("Galileo"), it.second.i_satellite_PRN)));
+                            doppler_hints_hz["Galileo " + std::to_string(it.second.i_satellite_PRN)] = predicted_doppler_hz(dist_m, r_sat2);
                         }
                 }
         }
@@ -1052,6 +1721,11 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
     });
     // provide list starting from satellites with higher elevation
     std::reverse(available_satellites.begin(), available_satellites.end());
+
+    // load the predicted Doppler of each visible satellite into the flowgraph,
+    // so cold-start acquisitions center their search on the expected shift
+    flowgraph_->set_acquisition_doppler_hints(doppler_hints_hz);
+
     return available_satellites;
 }
 
@@ -1104,7 +1778,9 @@ void ControlThread::sysv_queue_listener()
     double received_message = 0.0;
     const int msgrcv_size = sizeof(msg.stop_message);
 
-    const key_t key = 1102;
+    // Key of the System V message queue listening for stop orders. Overriding
+    // the default allows several receiver instances to run on the same machine
+    const key_t key = configuration_->property("GNSS-SDR.sysv_stop_queue_key", 1102);
 
     if ((msqid_ = msgget(key, 0644 | IPC_CREAT)) == -1)
         {
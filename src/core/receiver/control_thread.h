@@ -30,7 +30,11 @@
 #include "tcp_cmd_interface.h"     // for TcpCmdInterface
 #include <pmt/pmt.h>
 #include <array>     // for array
+#include <chrono>    // for steady_clock
 #include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t
+#include <ctime>     // for time_t
+#include <map>       // for map
 #include <memory>    // for shared_ptr
 #include <string>    // for string
 #include <thread>    // for std::thread
@@ -53,6 +57,7 @@
 class ConfigurationInterface;
 class GNSSFlowgraph;
 class Gnss_Satellite;
+class Rt_Margin_Monitor;
 
 /*!
  * \brief This class represents the main thread of the application, so the name is ControlThread.
@@ -146,7 +151,9 @@ private:
     std::vector<std::pair<int, Gnss_Satellite>> get_visible_sats(time_t rx_utc_time, const std::array<float, 3> &LLH);
 
     /*
-     * Read initial GNSS assistance from SUPL server or local XML files
+     * Read initial GNSS assistance from SUPL server or local XML files.
+     * Executed on agnss_thread_, concurrently with the running flowgraph,
+     * so slow SUPL servers do not delay the reception of the first samples
      */
     void assist_GNSS();
 
@@ -154,6 +161,76 @@ private:
     void keyboard_listener();
     void sysv_queue_listener();
 
+    /*
+     * Event loop of a secondary receiver instance: reads the channel events of
+     * its flowgraph and applies the corresponding actions. The primary
+     * instance keeps the full event_dispatcher() path.
+     */
+    void instance_event_loop(size_t instance);
+
+    /*
+     * Sends a GNU Radio asynchronous message from telemetry to the PVT block
+     * of every receiver instance, so one SUPL client assists all of them
+     */
+    bool send_telemetry_msg(const pmt::pmt_t &msg);
+
+    /*
+     * Load governor: when the CPU stays saturated or the process exceeds its
+     * memory ceiling, sheds the lowest priority tracking channels so that the
+     * surviving ones keep meeting their deadlines, and returns them to
+     * acquisition once the load recovers. With several receiver instances,
+     * shedding starts at the instance with the highest
+     * GNSS-SDR.instance_priority value (largest number = least protected),
+     * so an experimental instance degrades before the production one.
+     * Called from the run() loop at every event timeout.
+     */
+    void load_governor_tick();
+
+    /*
+     * Orders the receiver instances by shedding preference (least protected
+     * first) according to their GNSS-SDR.instance_priority
+     */
+    void build_governor_shed_order();
+
+    /*
+     * Configuration hot-reload: polls the configuration file for changes and
+     * applies the properties that are safe to change at runtime (tracking
+     * loop bandwidths, acquisition thresholds and Doppler ranges) through
+     * the runtime-control API, without restarting the flowgraph. Any other
+     * changed property is reported once as requiring a restart.
+     * Called from the run() loop at every event timeout.
+     */
+    void config_hot_reload_tick();
+
+    // Applies one changed configuration property at runtime if it is safe to
+    // do so. Returns false when the property requires a receiver restart
+    bool apply_runtime_property(const std::string &key, const std::string &value);
+
+    /*
+     * Real-time margin watchdog: tracks the ratio of delivered samples to
+     * wall clock per signal conditioner and publishes the margin over the
+     * monitor socket, warning before the input buffers are exhausted.
+     * Called from the run() loop at every event timeout.
+     */
+    void rt_margin_watchdog_tick();
+
+    // Reads the aggregated busy and total jiffy counters from /proc/stat.
+    // Returns false on systems without a Linux-style procfs.
+    static bool read_cpu_counters(uint64_t *busy, uint64_t *total);
+
+    // Reads the resident set size of this process from /proc/self/status.
+    // Returns false on systems without a Linux-style procfs.
+    static bool read_own_rss_mb(double *rss_mb);
+
+    // one receiver instance as seen by the load governor
+    struct Governor_Instance
+    {
+        std::shared_ptr<GNSSFlowgraph> flowgraph;
+        int instance_id;
+        int priority;      // larger number = shed earlier
+        int min_channels;  // channels this instance always keeps
+    };
+
     // default filename for assistance data
     const std::string eph_default_xml_filename_ = "./gps_ephemeris.xml";
     const std::string utc_default_xml_filename_ = "./gps_utc_model.xml";
@@ -177,6 +254,13 @@ private:
     std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue_;
     std::shared_ptr<GNSSFlowgraph> flowgraph_;
 
+    // secondary receiver instances (GNSS-SDR.num_receiver_instances > 1),
+    // each with its own flowgraph, control queue and event loop thread
+    std::vector<std::shared_ptr<GNSSFlowgraph>> extra_flowgraphs_;
+    std::vector<std::shared_ptr<Concurrent_Queue<pmt::pmt_t>>> extra_control_queues_;
+    std::vector<std::thread> extra_instance_threads_;
+
+    std::thread agnss_thread_;
     std::thread cmd_interface_thread_;
     std::thread keyboard_thread_;
     std::thread sysv_queue_thread_;
@@ -199,14 +283,42 @@ private:
     Agnss_Ref_Location agnss_ref_location_;
     Agnss_Ref_Time agnss_ref_time_;
 
+    std::map<std::string, std::string> config_snapshot_;  // resolved configuration at the last (re)load
+    std::string config_filename_;
+    std::chrono::steady_clock::time_point config_reload_last_tick_;
+    time_t config_file_mtime_;
+    int config_reload_interval_s_;
+    bool enable_config_hot_reload_;
+
+    std::unique_ptr<Rt_Margin_Monitor> rt_margin_monitor_;
+    std::chrono::steady_clock::time_point rt_margin_last_tick_;
+    std::vector<uint64_t> rt_margin_prev_counts_;
+    double rt_margin_alert_threshold_;
+    int rt_margin_interval_s_;
+
+    std::vector<Governor_Instance> governor_shed_order_;
+    std::chrono::steady_clock::time_point load_governor_last_tick_;
+    uint64_t load_governor_prev_busy_;
+    uint64_t load_governor_prev_total_;
+    double load_governor_cpu_threshold_;
+    double load_governor_recovery_threshold_;
+    double load_governor_rss_ceiling_mb_;
+    int load_governor_min_channels_;
+    int load_governor_interval_s_;
+    int load_governor_overload_ticks_;
+    int load_governor_recovery_ticks_;
+
     unsigned int processed_control_messages_;
     unsigned int applied_actions_;
+    int receiver_instances_;
     int msqid_;
 
     bool receiver_on_standby_;
     bool stop_;
     bool restart_;
     bool telecommand_enabled_;
+    bool enable_load_governor_;
+    bool enable_rt_margin_watchdog_;
     bool pre_2009_file_;  // to override the system time to postprocess old gnss records and avoid wrong week rollover
 };
 
@@ -0,0 +1,107 @@
+/*!
+ * \file device_placement.cc
+ * \brief Assigns block implementations to accelerator devices per channel.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "device_placement.h"
+#include "configuration_interface.h"
+#include <glog/logging.h>
+#include <sstream>
+
+
+Device_Placement::Device_Placement(const ConfigurationInterface* configuration)
+{
+    const std::string inventory = configuration->property("GNSS-SDR.device_inventory", std::string(""));
+    std::stringstream devices(inventory);
+    std::string device;
+    while (std::getline(devices, device, ','))
+        {
+            if (device.empty())
+                {
+                    continue;
+                }
+            Device_Slots entry{};
+            const auto colon = device.find(':');
+            if (colon == std::string::npos)
+                {
+                    entry.name = device;
+                    entry.free_slots = -1;
+                }
+            else
+                {
+                    entry.name = device.substr(0, colon);
+                    const std::string slots = device.substr(colon + 1);
+                    if (slots == "*")
+                        {
+                            entry.free_slots = -1;
+                        }
+                    else
+                        {
+                            try
+                                {
+                                    entry.free_slots = std::stoi(slots);
+                                }
+                            catch (const std::exception&)
+                                {
+                                    LOG(WARNING) << "Device placement: invalid slot count '" << slots << "' for device " << entry.name;
+                                    continue;
+                                }
+                        }
+                }
+            LOG(INFO) << "Device placement: device " << entry.name << " offers "
+                      << ((entry.free_slots < 0) ? std::string("unlimited") : std::to_string(entry.free_slots))
+                      << " slots";
+            inventory_.push_back(entry);
+        }
+    if (inventory_.empty())
+        {
+            LOG(WARNING) << "Device placement enabled but GNSS-SDR.device_inventory is empty";
+        }
+}
+
+
+std::string Device_Placement::resolve(const ConfigurationInterface* configuration,
+    const std::string& role,
+    const std::string& configured_implementation)
+{
+    for (auto& device : inventory_)
+        {
+            const std::string alternative = configuration->property(role + "." + device.name + "_implementation", std::string(""));
+            if (alternative.empty())
+                {
+                    continue;
+                }
+            int slots = configuration->property(role + "." + device.name + "_slots", 1);
+            if (slots < 1)
+                {
+                    slots = 1;
+                }
+            std::lock_guard<std::mutex> lock(mutex_);
+            if ((device.free_slots < 0) or (device.free_slots >= slots))
+                {
+                    if (device.free_slots >= slots)
+                        {
+                            device.free_slots -= slots;
+                        }
+                    LOG(INFO) << "Device placement: " << role << " -> " << alternative
+                              << " on " << device.name
+                              << ((device.free_slots < 0) ? std::string("")
+                                                          : (", " + std::to_string(device.free_slots) + " slots left"));
+                    return alternative;
+                }
+            DLOG(INFO) << "Device placement: " << device.name << " is full, "
+                       << role << " overflows to the next device";
+        }
+    return configured_implementation;
+}
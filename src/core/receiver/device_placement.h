@@ -0,0 +1,91 @@
+/*!
+ * \file device_placement.h
+ * \brief Assigns block implementations to accelerator devices per channel.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * On a heterogeneous box the CPU, GPU and FPGA variants of acquisition and
+ * tracking are separate adapter classes, and distributing channels over
+ * them by hand requires one per-channel implementation key per channel.
+ * This class turns the distribution into configuration: a device inventory
+ * declares how many slots each accelerator offers, each role declares its
+ * implementation alternative (and slot cost) per device, and the factory
+ * asks for a placement every time it instantiates a block. When a device
+ * runs out of slots the next channel overflows to the next device, and
+ * finally to the implementation configured in the plain .implementation key.
+ *
+ * Example: eight tracking channels on the FPGA, the overflow on the CPU:
+ *
+ *     GNSS-SDR.enable_device_placement=true
+ *     GNSS-SDR.device_inventory=FPGA:8
+ *     Tracking_1C.FPGA_implementation=GPS_L1_CA_DLL_PLL_Tracking_FPGA
+ *     Tracking_1C.implementation=GPS_L1_CA_DLL_PLL_Tracking
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_DEVICE_PLACEMENT_H
+#define GNSS_SDR_DEVICE_PLACEMENT_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+class ConfigurationInterface;
+
+/*!
+ * \brief This class keeps the slot accounting of the accelerator devices of
+ * the box and resolves which implementation each block instantiation gets.
+ */
+class Device_Placement
+{
+public:
+    /*!
+     * \brief Constructor. Reads the device inventory from
+     * GNSS-SDR.device_inventory, a comma-separated list of device:slots
+     * pairs in preference order (e.g. "FPGA:8,GPU:2"). A * slot count
+     * means unlimited.
+     */
+    explicit Device_Placement(const ConfigurationInterface* configuration);
+
+    /*!
+     * \brief Returns the implementation that the given role must
+     * instantiate. The first device of the inventory for which the role
+     * declares a <role>.<device>_implementation alternative and which still
+     * has enough free slots wins; the block claims
+     * <role>.<device>_slots slots (default 1, so a heavier block can
+     * declare a larger footprint). When no device matches, the configured
+     * implementation is returned unchanged. Thread-safe, so channels can be
+     * instantiated concurrently.
+     */
+    std::string resolve(const ConfigurationInterface* configuration,
+        const std::string& role,
+        const std::string& configured_implementation);
+
+private:
+    struct Device_Slots
+    {
+        std::string name;
+        int free_slots;  // -1 means unlimited
+    };
+
+    std::vector<Device_Slots> inventory_;
+    std::mutex mutex_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_DEVICE_PLACEMENT_H
@@ -22,7 +22,9 @@
 #include "file_configuration.h"
 #include "gnss_sdr_make_unique.h"
 #include <glog/logging.h>
+#include <cctype>  // for tolower
 #include <utility>
+#include <vector>
 
 
 FileConfiguration::FileConfiguration(std::string filename)
@@ -57,6 +59,78 @@ void FileConfiguration::init()
         {
             LOG(WARNING) << "Unable to open configuration file " << filename_;
         }
+    resolve_profile_chain();
+}
+
+
+void FileConfiguration::resolve_profile_chain()
+{
+    const auto extends_of = [](const INIReader& reader) {
+        const auto entry = reader.Values().find("gnss-sdr.extends");
+        return (entry != reader.Values().end()) ? entry->second : std::string("");
+    };
+
+    // Walk the inheritance chain, most derived file first
+    std::vector<std::unique_ptr<INIReader>> base_profiles;
+    std::string declaring_file = filename_;
+    std::string base_filename = extends_of(*ini_reader_);
+    int depth = 0;
+    while (!base_filename.empty() and depth < 8)
+        {
+            // relative paths are resolved against the file that declares them
+            if (base_filename.front() != '/')
+                {
+                    const auto slash = declaring_file.find_last_of('/');
+                    if (slash != std::string::npos)
+                        {
+                            base_filename = declaring_file.substr(0, slash + 1) + base_filename;
+                        }
+                }
+            auto base = std::make_unique<INIReader>(base_filename);
+            const int base_error = base->ParseError();
+            if (base_error < 0)
+                {
+                    LOG(WARNING) << "Unable to open base configuration profile " << base_filename;
+                    break;
+                }
+            if (base_error > 0)
+                {
+                    LOG(WARNING) << "Base configuration profile " << base_filename << " contains errors in line " << base_error;
+                }
+            declaring_file = base_filename;
+            base_filename = extends_of(*base);
+            base_profiles.push_back(std::move(base));
+            depth++;
+        }
+    if (!base_filename.empty() and depth >= 8)
+        {
+            LOG(WARNING) << "Configuration profile chain deeper than 8 levels (or circular), stopped at " << declaring_file;
+        }
+
+    // Flatten base profiles first and the most derived file last, so each
+    // overlay wins over the profiles it extends
+    for (auto base = base_profiles.rbegin(); base != base_profiles.rend(); ++base)
+        {
+            for (const auto& entry : (*base)->Values())
+                {
+                    resolved_[entry.first] = entry.second;
+                }
+        }
+    size_t overridden = 0;
+    for (const auto& entry : ini_reader_->Values())
+        {
+            if (!base_profiles.empty() and resolved_.count(entry.first) > 0)
+                {
+                    overridden++;
+                }
+            resolved_[entry.first] = entry.second;
+        }
+    if (!base_profiles.empty())
+        {
+            LOG(INFO) << "Configuration " << filename_ << " extends " << base_profiles.size()
+                      << " base profile(s), " << overridden << " properties overridden, "
+                      << resolved_.size() << " resolved";
+        }
 }
 
 
@@ -66,7 +140,13 @@ std::string FileConfiguration::property(std::string property_name, std::string d
         {
             return overrided_->property(property_name, default_value);
         }
-    return ini_reader_->Get("GNSS-SDR", property_name, default_value);
+    std::string key = "gnss-sdr." + property_name;
+    for (char& c : key)
+        {
+            c = tolower(c);
+        }
+    const auto entry = resolved_.find(key);
+    return (entry != resolved_.end()) ? entry->second : default_value;
 }
 
 
@@ -179,3 +259,9 @@ bool FileConfiguration::is_present(const std::string& property_name) const
 {
     return (overrided_->is_present(property_name));
 }
+
+
+const std::map<std::string, std::string>& FileConfiguration::resolved_properties() const
+{
+    return resolved_;
+}
@@ -27,6 +27,7 @@
 #include "in_memory_configuration.h"
 #include "string_converter.h"
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
 
@@ -44,6 +45,12 @@
  * for the values of the parameters.
  * The file is in the INI format, containing sections and pairs of names and values.
  * For more information about the INI format, see https://en.wikipedia.org/wiki/INI_file
+ *
+ * A file can declare GNSS-SDR.extends=<path> to inherit from a base profile
+ * (relative paths are resolved against the declaring file). Chains of
+ * profiles (base + site overlay + run overlay) are resolved once at load
+ * time into a single flat map, with the most derived file winning, so
+ * property lookups cost one map access regardless of the chain depth.
  */
 class FileConfiguration : public ConfigurationInterface
 {
@@ -64,8 +71,14 @@ public:
     void set_property(std::string property_name, std::string value) override;
     bool is_present(const std::string& property_name) const;
 
+    //! Resolved view of the configuration (profile chain flattened), keyed by
+    //! the lower-cased "gnss-sdr."-prefixed property names
+    const std::map<std::string, std::string>& resolved_properties() const;
+
 private:
     void init();
+    void resolve_profile_chain();
+    std::map<std::string, std::string> resolved_;  // flattened inheritance chain, lower-cased keys
     std::string filename_;
     std::unique_ptr<INIReader> ini_reader_;
     std::unique_ptr<InMemoryConfiguration> overrided_;
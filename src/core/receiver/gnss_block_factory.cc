@@ -37,6 +37,7 @@
 #include "channel.h"
 #include "configuration_interface.h"
 #include "direct_resampler_conditioner.h"
+#include "compressed_file_signal_source.h"
 #include "file_signal_source.h"
 #include "fir_filter.h"
 #include "freq_xlating_fir_filter.h"
@@ -73,6 +74,7 @@
 #include "gps_l1_ca_pcps_acquisition.h"
 #include "gps_l1_ca_pcps_acquisition_fine_doppler.h"
 #include "gps_l1_ca_pcps_assisted_acquisition.h"
+#include "gps_l1_ca_pcps_folding_acquisition.h"
 #include "gps_l1_ca_pcps_quicksync_acquisition.h"
 #include "gps_l1_ca_pcps_tong_acquisition.h"
 #include "gps_l1_ca_tcp_connector_tracking.h"
@@ -88,12 +90,14 @@
 #include "ibyte_to_complex.h"
 #include "ibyte_to_cshort.h"
 #include "in_memory_configuration.h"
+#include "interference_injector.h"
 #include "ishort_to_complex.h"
 #include "ishort_to_cshort.h"
 #include "labsat_signal_source.h"
 #include "mmse_resampler_conditioner.h"
 #include "multichannel_file_signal_source.h"
 #include "notch_filter.h"
+#include "notch_filter_bank.h"
 #include "notch_filter_lite.h"
 #include "nsr_file_signal_source.h"
 #include "pass_through.h"
@@ -101,7 +105,12 @@
 #include "rtklib_pvt.h"
 #include "rtl_tcp_signal_source.h"
 #include "sbas_l1_telemetry_decoder.h"
+#include "shared_memory_signal_source.h"
+#include "shm_sample_publisher.h"
 #include "signal_conditioner.h"
+#include "signal_generator.h"
+#include "signal_stats_probe.h"
+#include "spectral_excision_filter.h"
 #include "spir_file_signal_source.h"
 #include "spir_gss6450_file_signal_source.h"
 #include "telemetry_decoder_interface.h"
@@ -109,7 +118,12 @@
 #include "two_bit_cpx_file_signal_source.h"
 #include "two_bit_packed_file_signal_source.h"
 #include <glog/logging.h>
+#include <atomic>     // for atomic
 #include <exception>  // for exception
+#include <iostream>   // for cerr
+#include <mutex>      // for mutex
+#include <set>        // for set
+#include <thread>     // for thread
 #include <utility>    // for move
 
 #if RAW_UDP
@@ -268,12 +282,43 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetSignalConditioner(
             return conditioner_;
         }
 
+    // optional in-stream statistics probe, inserted after the data type
+    // adapter so the accumulation runs over cache-hot samples
+    gr::basic_block_sptr stats_probe;
+    if (configuration->property(role_conditioner + ".enable_stats_monitor", false))
+        {
+            const double fs = configuration->property("GNSS-SDR.internal_fs_sps", 4000000.0);
+            const double report_interval_s = configuration->property(role_conditioner + ".stats_report_interval_s", 1.0);
+            const double saturation_value = configuration->property(role_conditioner + ".stats_saturation_value", 1.0);
+            stats_probe = make_signal_stats_probe(
+                static_cast<uint64_t>(fs * report_interval_s),
+                static_cast<float>(saturation_value));
+            LOG(INFO) << "Signal statistics monitor enabled for " << role_conditioner;
+        }
+
+    // optional shared-memory publisher, appended after the resampler so
+    // that band receiver processes get the fully conditioned stream
+    gr::basic_block_sptr shm_publisher;
+    if (configuration->property(role_conditioner + ".enable_shm_publish", false))
+        {
+            const double fs = configuration->property("GNSS-SDR.internal_fs_sps", 4000000.0);
+            const std::string default_shm_name = "/gnsssdr_band_" + std::to_string(ID < 0 ? 0 : ID);
+            const std::string shm_name = configuration->property(role_conditioner + ".shm_publish_name", default_shm_name);
+            const double depth_ms = configuration->property(role_conditioner + ".shm_publish_depth_ms", 500.0);
+            shm_publisher = make_shm_sample_publisher(shm_name,
+                static_cast<size_t>(fs * depth_ms / 1000.0),
+                fs);
+            LOG(INFO) << "Shared memory sample publishing enabled for " << role_conditioner << " on " << shm_name;
+        }
+
     // single-antenna version
     std::unique_ptr<GNSSBlockInterface> conditioner_ = std::make_unique<SignalConditioner>(
         GetBlock(configuration, role_datatypeadapter, 1, 1),
         GetBlock(configuration, role_inputfilter, 1, 1),
         GetBlock(configuration, role_resampler, 1, 1),
-        role_conditioner);
+        role_conditioner,
+        stats_probe,
+        shm_publisher);
     return conditioner_;
 }
 
@@ -400,186 +445,352 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetChannel(
 
 std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GNSSBlockFactory::GetChannels(
     const ConfigurationInterface* configuration,
-    Concurrent_Queue<pmt::pmt_t>* queue)
+    Concurrent_Queue<pmt::pmt_t>* queue,
+    const std::map<std::string, const ConfigurationInterface*>& group_configurations)
 {
-    int channel_absolute_id = 0;
-
-    const unsigned int Channels_1C_count = configuration->property("Channels_1C.count", 0);
-    const unsigned int Channels_1B_count = configuration->property("Channels_1B.count", 0);
-    const unsigned int Channels_1G_count = configuration->property("Channels_1G.count", 0);
-    const unsigned int Channels_2G_count = configuration->property("Channels_2G.count", 0);
-    const unsigned int Channels_2S_count = configuration->property("Channels_2S.count", 0);
-    const unsigned int Channels_5X_count = configuration->property("Channels_5X.count", 0);
-    const unsigned int Channels_L5_count = configuration->property("Channels_L5.count", 0);
-    const unsigned int Channels_B1_count = configuration->property("Channels_B1.count", 0);
-    const unsigned int Channels_B3_count = configuration->property("Channels_B3.count", 0);
-    const unsigned int Channels_7X_count = configuration->property("Channels_7X.count", 0);
-    const unsigned int Channels_E6_count = configuration->property("Channels_E6.count", 0);
-
-    const unsigned int total_channels = Channels_1C_count +
-                                        Channels_1B_count +
-                                        Channels_1G_count +
-                                        Channels_2S_count +
-                                        Channels_2G_count +
-                                        Channels_5X_count +
-                                        Channels_L5_count +
-                                        Channels_B1_count +
-                                        Channels_B3_count +
-                                        Channels_7X_count +
-                                        Channels_E6_count;
-
-    auto channels = std::make_unique<std::vector<std::unique_ptr<GNSSBlockInterface>>>(total_channels);
-    try
-        {
-            // **************** GPS L1 C/A CHANNELS ****************************
-            LOG(INFO) << "Getting " << Channels_1C_count << " GPS L1 C/A channels";
-
-            for (unsigned int i = 0; i < Channels_1C_count; i++)
+    // OPTIONAL: heterogeneous device placement. The inventory is shared by
+    // all the channels, so the slot accounting spans every signal group
+    if (!placement_ and configuration->property("GNSS-SDR.enable_device_placement", false))
+        {
+            placement_ = std::make_unique<Device_Placement>(configuration);
+        }
+    // resolves the configuration that the channels of a signal group read
+    const auto channel_configuration = [&](const std::string& signal) {
+        const auto group_config = group_configurations.find(signal);
+        return (group_config != group_configurations.end()) ? group_config->second : configuration;
+    };
+    // Channel families, in instantiation order. The order determines the
+    // absolute channel indices, so it must not be modified
+    const std::vector<std::pair<std::string, std::string>> channel_families = {
+        {"1C", "GPS L1 C/A"},
+        {"2S", "GPS L2C (M)"},
+        {"L5", "GPS L5"},
+        {"1B", "GALILEO E1 B (I/NAV OS)"},
+        {"5X", "GALILEO E5a I (F/NAV OS)"},
+        {"E6", "GALILEO E6 (B/C HAS)"},
+        {"1G", "GLONASS L1 C/A"},
+        {"2G", "GLONASS L2 C/A"},
+        {"B1", "BEIDOU B1I"},
+        {"B3", "BEIDOU B3I"},
+        {"7X", "GALILEO E5b I (I/NAV OS)"}};
+
+    std::vector<std::string> channel_signals;
+    for (const auto& family : channel_families)
+        {
+            const unsigned int count = configuration->property("Channels_" + family.first + ".count", 0);
+            LOG(INFO) << "Getting " << count << " " << family.second << " channels";
+            for (unsigned int i = 0; i < count; i++)
                 {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("1C"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
+                    channel_signals.push_back(family.first);
                 }
+        }
 
-            // **************** GPS L2C (M) CHANNELS ***************************
-            LOG(INFO) << "Getting " << Channels_2S_count << " GPS L2C (M) channels";
-
-            for (unsigned int i = 0; i < Channels_2S_count; i++)
-                {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("2S"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
-                }
-
-            // **************** GPS L5 CHANNELS ********************************
-            LOG(INFO) << "Getting " << Channels_L5_count << " GPS L5 channels";
-
-            for (unsigned int i = 0; i < Channels_L5_count; i++)
-                {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("L5"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
-                }
+    const auto total_channels = static_cast<unsigned int>(channel_signals.size());
+    auto channels = std::make_unique<std::vector<std::unique_ptr<GNSSBlockInterface>>>(total_channels);
 
-            // **************** GALILEO E1 B (I/NAV OS) CHANNELS ***************
-            LOG(INFO) << "Getting " << Channels_1B_count << " GALILEO E1 B (I/NAV OS) channels";
+    unsigned int num_threads = configuration->property("GNSS-SDR.channel_instantiation_threads", 1);
+    if (num_threads == 0)
+        {
+            num_threads = std::thread::hardware_concurrency();
+        }
+    if ((total_channels != 0) && (num_threads > total_channels))
+        {
+            num_threads = total_channels;
+        }
 
-            for (unsigned int i = 0; i < Channels_1B_count; i++)
+    if (num_threads <= 1)
+        {
+            try
                 {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("1B"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
+                    for (unsigned int ch = 0; ch < total_channels; ch++)
+                        {
+                            // Store the channel into the vector of channels
+                            channels->at(ch) = GetChannel(channel_configuration(channel_signals[ch]),
+                                channel_signals[ch],
+                                static_cast<int>(ch),
+                                queue);
+                        }
                 }
-
-            // **************** GALILEO E5a I (F/NAV OS) CHANNELS **************
-            LOG(INFO) << "Getting " << Channels_5X_count << " GALILEO E5a I (F/NAV OS) channels";
-
-            for (unsigned int i = 0; i < Channels_5X_count; i++)
+            catch (const std::exception& e)
                 {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("5X"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
+                    LOG(WARNING) << e.what();
                 }
+            return channels;
+        }
+
+    // Channels do not depend on each other, so they can be built
+    // concurrently. Each worker writes into a disjoint set of slots of the
+    // preallocated vector, so no synchronization is needed on the results
+    std::atomic<unsigned int> next_channel(0);
+    std::mutex error_mutex;
+    std::string first_error;
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (unsigned int i = 0; i < num_threads; i++)
+        {
+            workers.emplace_back([&]() {
+                unsigned int ch;
+                while ((ch = next_channel.fetch_add(1)) < total_channels)
+                    {
+                        try
+                            {
+                                channels->at(ch) = GetChannel(channel_configuration(channel_signals[ch]),
+                                    channel_signals[ch],
+                                    static_cast<int>(ch),
+                                    queue);
+                            }
+                        catch (const std::exception& e)
+                            {
+                                std::lock_guard<std::mutex> lock(error_mutex);
+                                if (first_error.empty())
+                                    {
+                                        first_error = e.what();
+                                    }
+                            }
+                    }
+            });
+        }
+    for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    if (!first_error.empty())
+        {
+            LOG(WARNING) << first_error;
+        }
+    LOG(INFO) << "Instantiated " << total_channels << " channels with " << num_threads << " threads";
+    return channels;
+}
 
-            // **************** GALILEO E6 (B/C HAS) CHANNELS **************
-            LOG(INFO) << "Getting " << Channels_E6_count << " GALILEO E6 (B/C HAS) channels";
 
-            for (unsigned int i = 0; i < Channels_E6_count; i++)
-                {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("E6"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
-                }
-
-            // **************** GLONASS L1 C/A CHANNELS ************************
-            LOG(INFO) << "Getting " << Channels_1G_count << " GLONASS L1 C/A channels";
+bool GNSSBlockFactory::ValidateConfiguration(const ConfigurationInterface* configuration)
+{
+    // Every implementation name known by GetBlock(). Names behind optional
+    // drivers are accepted here unconditionally; GetBlock() reports at run
+    // time whether the required driver was compiled in
+    static const std::set<std::string> known_implementations = {
+        "Ad9361_Fpga_Signal_Source",
+        "Array_Signal_Conditioner",
+        "BEIDOU_B1I_DLL_PLL_Tracking",
+        "BEIDOU_B1I_PCPS_Acquisition",
+        "BEIDOU_B1I_Telemetry_Decoder",
+        "BEIDOU_B3I_DLL_PLL_Tracking",
+        "BEIDOU_B3I_PCPS_Acquisition",
+        "BEIDOU_B3I_Telemetry_Decoder",
+        "Beamformer_Filter",
+        "Byte_To_Short",
+        "Compressed_File_Signal_Source",
+        "Custom_UDP_Signal_Source",
+        "Direct_Resampler",
+        "File_Signal_Source",
+        "Fir_Filter",
+        "Flexiband_Signal_Source",
+        "Fmcomms2_Signal_Source",
+        "Fractional_Resampler",
+        "Freq_Xlating_Fir_Filter",
+        "GLONASS_L1_CA_DLL_PLL_C_Aid_Tracking",
+        "GLONASS_L1_CA_DLL_PLL_Tracking",
+        "GLONASS_L1_CA_PCPS_Acquisition",
+        "GLONASS_L1_CA_Telemetry_Decoder",
+        "GLONASS_L2_CA_DLL_PLL_C_Aid_Tracking",
+        "GLONASS_L2_CA_DLL_PLL_Tracking",
+        "GLONASS_L2_CA_PCPS_Acquisition",
+        "GLONASS_L2_CA_Telemetry_Decoder",
+        "GN3S_Signal_Source",
+        "GNSSSignalGenerator",
+        "GPS_L1_CA_DLL_PLL_Tracking",
+        "GPS_L1_CA_DLL_PLL_Tracking_Fpga",
+        "GPS_L1_CA_DLL_PLL_Tracking_GPU",
+        "GPS_L1_CA_KF_Tracking",
+        "GPS_L1_CA_Observables",
+        "GPS_L1_CA_PCPS_Acquisition",
+        "GPS_L1_CA_PCPS_Acquisition_Fine_Doppler",
+        "GPS_L1_CA_PCPS_Acquisition_Fpga",
+        "GPS_L1_CA_PCPS_Assisted_Acquisition",
+        "GPS_L1_CA_PCPS_Folding_Acquisition",
+        "GPS_L1_CA_PCPS_OpenCl_Acquisition",
+        "GPS_L1_CA_PCPS_QuickSync_Acquisition",
+        "GPS_L1_CA_PCPS_Tong_Acquisition",
+        "GPS_L1_CA_PVT",
+        "GPS_L1_CA_TCP_CONNECTOR_Tracking",
+        "GPS_L1_CA_Telemetry_Decoder",
+        "GPS_L2C_Observables",
+        "GPS_L2C_Telemetry_Decoder",
+        "GPS_L2_M_DLL_PLL_Tracking",
+        "GPS_L2_M_DLL_PLL_Tracking_Fpga",
+        "GPS_L2_M_PCPS_Acquisition",
+        "GPS_L2_M_PCPS_Acquisition_Fpga",
+        "GPS_L5_DLL_PLL_Tracking",
+        "GPS_L5_DLL_PLL_Tracking_Fpga",
+        "GPS_L5_Telemetry_Decoder",
+        "GPS_L5i_DLL_PLL_Tracking",
+        "GPS_L5i_DLL_PLL_Tracking_Fpga",
+        "GPS_L5i_PCPS_Acquisition",
+        "GPS_L5i_PCPS_Acquisition_Fpga",
+        "Galileo_E1B_Telemetry_Decoder",
+        "Galileo_E1_DLL_PLL_VEML_Tracking",
+        "Galileo_E1_DLL_PLL_VEML_Tracking_Fpga",
+        "Galileo_E1_PCPS_8ms_Ambiguous_Acquisition",
+        "Galileo_E1_PCPS_Ambiguous_Acquisition",
+        "Galileo_E1_PCPS_Ambiguous_Acquisition_Fpga",
+        "Galileo_E1_PCPS_CCCWSR_Ambiguous_Acquisition",
+        "Galileo_E1_PCPS_QuickSync_Ambiguous_Acquisition",
+        "Galileo_E1_PCPS_Tong_Ambiguous_Acquisition",
+        "Galileo_E1_PVT",
+        "Galileo_E1_TCP_CONNECTOR_Tracking",
+        "Galileo_E5A_Observables",
+        "Galileo_E5a_DLL_PLL_Tracking",
+        "Galileo_E5a_DLL_PLL_Tracking_Fpga",
+        "Galileo_E5a_Noncoherent_IQ_Acquisition_CAF",
+        "Galileo_E5a_Pcps_Acquisition",
+        "Galileo_E5a_Pcps_Acquisition_Fpga",
+        "Galileo_E5a_Telemetry_Decoder",
+        "Galileo_E5b_DLL_PLL_Tracking",
+        "Galileo_E5b_PCPS_Acquisition",
+        "Galileo_E5b_PCPS_Acquisition_FPGA",
+        "Galileo_E5b_Telemetry_Decoder",
+        "Galileo_E6_DLL_PLL_Tracking",
+        "Galileo_E6_PCPS_Acquisition",
+        "Galileo_E6_Telemetry_Decoder",
+        "Hybrid_Observables",
+        "Hybrid_PVT",
+        "Ibyte_To_Cbyte",
+        "Ibyte_To_Complex",
+        "Ibyte_To_Cshort",
+        "Interference_Injector",
+        "Ishort_To_Complex",
+        "Ishort_To_Cshort",
+        "Labsat_Signal_Source",
+        "Mmse_Resampler",
+        "Multichannel_File_Signal_Source",
+        "Notch_Filter",
+        "Notch_Filter_Bank",
+        "Notch_Filter_Lite",
+        "Nsr_File_Signal_Source",
+        "Osmosdr_Signal_Source",
+        "Pass_Through",
+        "Plutosdr_Signal_Source",
+        "Pulse_Blanking_Filter",
+        "RTKLIB_PVT",
+        "Raw_Array_Signal_Source",
+        "RtlTcp_Signal_Source",
+        "SBAS_L1_Telemetry_Decoder",
+        "SharedMemory_Signal_Source",
+        "Signal_Conditioner",
+        "Spectral_Excision_Filter",
+        "Spir_File_Signal_Source",
+        "Spir_GSS6450_File_Signal_Source",
+        "Two_Bit_Cpx_File_Signal_Source",
+        "Two_Bit_Packed_File_Signal_Source",
+        "UHD_Signal_Source"};
 
-            for (unsigned int i = 0; i < Channels_1G_count; i++)
+    const std::string empty_implementation;
+    int problems = 0;
+
+    const auto report = [&problems](const std::string& description) {
+        std::cerr << "Configuration error: " << description << '\n';
+        LOG(ERROR) << "Configuration error: " << description;
+        problems++;
+    };
+
+    const auto check_role = [&](const std::string& role, bool required) {
+        const std::string implementation = configuration->property(role + ".implementation", std::string(""));
+        if (implementation.empty())
+            {
+                if (required)
+                    {
+                        report(role + ".implementation is not defined");
+                    }
+                return;
+            }
+        if (known_implementations.count(implementation) == 0)
+            {
+                report(role + ".implementation is set to " + implementation + ", which is not a known implementation");
+            }
+    };
+
+    const auto check_conditioner = [&](int id) {
+        const std::string suffix = (id != -1) ? std::to_string(id) : "";
+        check_role("SignalConditioner" + suffix, false);
+        const std::string conditioner = configuration->property("SignalConditioner" + suffix + ".implementation", empty_implementation);
+        if (conditioner == "Pass_Through")
+            {
+                return;
+            }
+        check_role("DataTypeAdapter" + suffix, false);
+        check_role("InputFilter" + suffix, false);
+        check_role("Resampler" + suffix, false);
+    };
+
+    // 1. Signal sources and their signal conditioners
+    const int sources_count = configuration->property("Receiver.sources_count", 1);
+    int signal_conditioner_id = 0;
+    if (sources_count > 1)
+        {
+            for (int i = 0; i < sources_count; i++)
                 {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("1G"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
+                    check_role("SignalSource" + std::to_string(i), true);
+                    const int rf_channels = configuration->property("SignalSource" + std::to_string(i) + ".RF_channels", 1);
+                    for (int j = 0; j < rf_channels; j++)
+                        {
+                            check_conditioner(signal_conditioner_id);
+                            signal_conditioner_id++;
+                        }
                 }
-
-            // **************** GLONASS L2 C/A CHANNELS ************************
-            LOG(INFO) << "Getting " << Channels_2G_count << " GLONASS L2 C/A channels";
-
-            for (unsigned int i = 0; i < Channels_2G_count; i++)
+        }
+    else
+        {
+            check_role("SignalSource", true);
+            const int rf_channels = configuration->property("SignalSource.RF_channels", 0);
+            if (rf_channels != 0)
                 {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("2G"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
+                    for (int j = 0; j < rf_channels; j++)
+                        {
+                            check_conditioner(signal_conditioner_id);
+                            signal_conditioner_id++;
+                        }
                 }
-
-            // **************** BEIDOU B1I CHANNELS ****************************
-            LOG(INFO) << "Getting " << Channels_B1_count << " BEIDOU B1I channels";
-
-            for (unsigned int i = 0; i < Channels_B1_count; i++)
+            else
                 {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("B1"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
+                    // backwards compatibility for old config files
+                    check_conditioner(-1);
                 }
+        }
 
-            // **************** BEIDOU B3I CHANNELS ****************************
-            LOG(INFO) << "Getting " << Channels_B3_count << " BEIDOU B3I channels";
-
-            for (unsigned int i = 0; i < Channels_B3_count; i++)
+    // 2. Channels. The family order must match the one used by GetChannels()
+    const std::vector<std::string> channel_families = {"1C", "2S", "L5", "1B", "5X", "E6", "1G", "2G", "B1", "B3", "7X"};
+    const std::vector<std::string> channel_stages = {"Acquisition_", "Tracking_", "TelemetryDecoder_"};
+    int channel_absolute_id = 0;
+    for (const auto& signal : channel_families)
+        {
+            const unsigned int count = configuration->property("Channels_" + signal + ".count", 0);
+            for (unsigned int i = 0; i < count; i++)
                 {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("B3"),
-                        channel_absolute_id,
-                        queue);
+                    for (const auto& stage : channel_stages)
+                        {
+                            // per-channel configurations take precedence, as in GetChannel()
+                            std::string role = stage + signal + std::to_string(channel_absolute_id);
+                            if (configuration->property(role + ".implementation", empty_implementation).empty())
+                                {
+                                    role = stage + signal;
+                                }
+                            check_role(role, true);
+                        }
                     channel_absolute_id++;
                 }
+        }
 
-            // **************** GALILEO E5b I (I/NAV OS) CHANNELS **************
-            LOG(INFO) << "Getting " << Channels_7X_count << " GALILEO E5b I (I/NAV OS) channels";
+    // 3. Observables and PVT
+    check_role("Observables", true);
+    check_role("PVT", true);
 
-            for (unsigned int i = 0; i < Channels_7X_count; i++)
-                {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("7X"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
-                }
-        }
-    catch (const std::exception& e)
+    if (problems == 0)
         {
-            LOG(WARNING) << e.what();
+            LOG(INFO) << "The configuration check did not find any problem";
+            return true;
         }
-
-    return channels;
+    std::cerr << "The configuration check found " << problems << " problem(s), the receiver may not work as expected\n";
+    return false;
 }
 
 
@@ -620,6 +831,36 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                     block = std::move(block_);
                 }
 
+            catch (const std::exception& e)
+                {
+                    std::cout << "GNSS-SDR program ended.\n";
+                    exit(1);
+                }
+        }
+    else if (implementation == "GNSSSignalGenerator")
+        {
+            try
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<SignalGenerator>(configuration, role, in_streams,
+                        out_streams, queue);
+                    block = std::move(block_);
+                }
+
+            catch (const std::exception& e)
+                {
+                    std::cout << "GNSS-SDR program ended.\n";
+                    exit(1);
+                }
+        }
+    else if (implementation == "Compressed_File_Signal_Source")
+        {
+            try
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<CompressedFileSignalSource>(configuration, role, in_streams,
+                        out_streams, queue);
+                    block = std::move(block_);
+                }
+
             catch (const std::exception& e)
                 {
                     std::cout << "GNSS-SDR program ended.\n";
@@ -641,6 +882,21 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                     exit(1);
                 }
         }
+    else if (implementation == "SharedMemory_Signal_Source")
+        {
+            try
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<SharedMemorySignalSource>(configuration, role, in_streams,
+                        out_streams, queue);
+                    block = std::move(block_);
+                }
+
+            catch (const std::exception& e)
+                {
+                    std::cout << "GNSS-SDR program ended: " << e.what() << '\n';
+                    exit(1);
+                }
+        }
 #if RAW_UDP
     else if (implementation == "Custom_UDP_Signal_Source")
         {
@@ -905,6 +1161,24 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                 out_streams);
             block = std::move(block_);
         }
+    else if (implementation == "Notch_Filter_Bank")
+        {
+            std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<NotchFilterBank>(configuration, role, in_streams,
+                out_streams);
+            block = std::move(block_);
+        }
+    else if (implementation == "Spectral_Excision_Filter")
+        {
+            std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<SpectralExcisionFilter>(configuration, role, in_streams,
+                out_streams);
+            block = std::move(block_);
+        }
+    else if (implementation == "Interference_Injector")
+        {
+            std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<InterferenceInjectorFilter>(configuration, role, in_streams,
+                out_streams);
+            block = std::move(block_);
+        }
 
     // RESAMPLER ---------------------------------------------------------------
     else if (implementation == "Direct_Resampler")
@@ -952,6 +1226,12 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                 out_streams);
             block = std::move(block_);
         }
+    else if (implementation == "GPS_L1_CA_PCPS_Folding_Acquisition")
+        {
+            std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<GpsL1CaPcpsFoldingAcquisition>(configuration, role, in_streams,
+                out_streams);
+            block = std::move(block_);
+        }
     else if (implementation == "GPS_L2_M_PCPS_Acquisition")
         {
             std::unique_ptr<AcquisitionInterface> block_ = std::make_unique<GpsL2MPcpsAcquisition>(configuration, role, in_streams,
@@ -1342,7 +1622,11 @@ std::unique_ptr<AcquisitionInterface> GNSSBlockFactory::GetAcqBlock(
 {
     std::unique_ptr<AcquisitionInterface> block;
     const std::string default_impl("Wrong");
-    const std::string implementation = configuration->property(role + ".implementation", default_impl);
+    std::string implementation = configuration->property(role + ".implementation", default_impl);
+    if (placement_)
+        {
+            implementation = placement_->resolve(configuration, role, implementation);
+        }
 
     // ACQUISITION BLOCKS ------------------------------------------------------
     if (implementation == "GPS_L1_CA_PCPS_Acquisition")
@@ -1375,6 +1659,12 @@ std::unique_ptr<AcquisitionInterface> GNSSBlockFactory::GetAcqBlock(
                 out_streams);
             block = std::move(block_);
         }
+    else if (implementation == "GPS_L1_CA_PCPS_Folding_Acquisition")
+        {
+            std::unique_ptr<AcquisitionInterface> block_ = std::make_unique<GpsL1CaPcpsFoldingAcquisition>(configuration, role, in_streams,
+                out_streams);
+            block = std::move(block_);
+        }
     else if (implementation == "GPS_L2_M_PCPS_Acquisition")
         {
             std::unique_ptr<AcquisitionInterface> block_ = std::make_unique<GpsL2MPcpsAcquisition>(configuration, role, in_streams,
@@ -1530,7 +1820,11 @@ std::unique_ptr<TrackingInterface> GNSSBlockFactory::GetTrkBlock(
 {
     std::unique_ptr<TrackingInterface> block;
     const std::string default_impl("Wrong");
-    const std::string implementation = configuration->property(role + ".implementation", default_impl);
+    std::string implementation = configuration->property(role + ".implementation", default_impl);
+    if (placement_)
+        {
+            implementation = placement_->resolve(configuration, role, implementation);
+        }
 
     // TRACKING BLOCKS ---------------------------------------------------------
     if (implementation == "GPS_L1_CA_DLL_PLL_Tracking")
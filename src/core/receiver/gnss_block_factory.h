@@ -25,7 +25,9 @@
 #define GNSS_SDR_BLOCK_FACTORY_H
 
 #include "concurrent_queue.h"
+#include "device_placement.h"
 #include <pmt/pmt.h>
+#include <map>     // for map
 #include <memory>  // for unique_ptr
 #include <string>  // for string
 #include <vector>  // for vector
@@ -56,8 +58,15 @@ public:
 
     std::unique_ptr<GNSSBlockInterface> GetSignalConditioner(const ConfigurationInterface* configuration, int ID = -1);
 
+    /*!
+     * \brief Returns the vector of channels. If group_configurations holds an
+     * entry for a signal (e.g. "1C"), the channels of that group are built
+     * from that configuration instead of the plain one, so GNSSFlowgraph can
+     * hand decimated sampling rates to selected channel groups.
+     */
     std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GetChannels(const ConfigurationInterface* configuration,
-        Concurrent_Queue<pmt::pmt_t>* queue);
+        Concurrent_Queue<pmt::pmt_t>* queue,
+        const std::map<std::string, const ConfigurationInterface*>& group_configurations = std::map<std::string, const ConfigurationInterface*>());
 
     std::unique_ptr<GNSSBlockInterface> GetObservables(const ConfigurationInterface* configuration);
 
@@ -72,6 +81,15 @@ public:
         unsigned int out_streams,
         Concurrent_Queue<pmt::pmt_t>* queue = nullptr);
 
+    /*!
+     * \brief Checks the whole configuration for missing or unknown block
+     * implementations without instantiating any block, so configuration
+     * errors are reported before the (possibly long) receiver start-up.
+     * Problems are reported via LOG(ERROR) and the standard error stream.
+     * Returns true if no problem was found.
+     */
+    static bool ValidateConfiguration(const ConfigurationInterface* configuration);
+
 private:
     std::unique_ptr<GNSSBlockInterface> GetChannel(
         const ConfigurationInterface* configuration,
@@ -96,6 +114,11 @@ private:
         const std::string& role,
         unsigned int in_streams,
         unsigned int out_streams);
+
+    // OPTIONAL: heterogeneous device placement. When
+    // GNSS-SDR.enable_device_placement is set, acquisition and tracking
+    // implementations are assigned per channel from the device inventory
+    std::unique_ptr<Device_Placement> placement_;
 };
 
 
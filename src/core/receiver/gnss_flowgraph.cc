@@ -27,10 +27,13 @@
 #include "Galileo_E5a.h"
 #include "Galileo_E5b.h"
 #include "Galileo_E6.h"
+#include "acq_fft.h"
 #include "channel.h"
+#include "channel_fs_configuration.h"
 #include "channel_fsm.h"
 #include "channel_interface.h"
 #include "configuration_interface.h"
+#include "dump_budget.h"
 #include "gnss_block_factory.h"
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
@@ -40,14 +43,18 @@
 #include <boost/tokenizer.hpp>       // for boost::tokenizer
 #include <glog/logging.h>            // for LOG
 #include <gnuradio/basic_block.h>    // for basic_block
+#include <gnuradio/block.h>          // for block
 #include <gnuradio/filter/firdes.h>  // for gr::filter::firdes
 #include <gnuradio/io_signature.h>   // for io_signature
 #include <gnuradio/top_block.h>      // for top_block, make_top_block
 #include <pmt/pmt_sugar.h>           // for mp
 #include <algorithm>                 // for transform, sort, unique
+#include <chrono>                    // for system_clock
 #include <cmath>                     // for floor
 #include <cstddef>                   // for size_t
 #include <exception>                 // for exception
+#include <fstream>                   // for ifstream, ofstream
+#include <iomanip>                   // for setprecision
 #include <iostream>                  // for operator<<
 #include <iterator>                  // for insert_iterator, inserter
 #include <memory>                    // for std::shared_ptr
@@ -252,37 +259,54 @@ void GNSSFlowgraph::connect()
                             // read the number of RF channels for each front-end
                             RF_Channels = configuration_->property(sig_source_.at(i)->role() + ".RF_channels", 1);
 
-                            for (int j = 0; j < RF_Channels; j++)
+                            if (configuration_->property(sig_source_.at(i)->role() + ".enable_channelizer", false))
                                 {
-                                    // Connect the multichannel signal source to multiple signal conditioners
-                                    // GNURADIO max_streams=-1 means infinite ports!
-                                    DLOG(INFO) << "sig_source_.at(i)->get_right_block()->output_signature()->max_streams()=" << sig_source_.at(i)->get_right_block()->output_signature()->max_streams();
-                                    DLOG(INFO) << "sig_conditioner_.at(signal_conditioner_ID)->get_left_block()->input_signature()=" << sig_conditioner_.at(signal_conditioner_ID)->get_left_block()->input_signature()->max_streams();
-
-                                    if (sig_source_.at(i)->get_right_block()->output_signature()->max_streams() > 1 or sig_source_.at(i)->get_right_block()->output_signature()->max_streams() == -1)
+                                    // A shared-FFT channelizer splits the wideband stream of this
+                                    // source into RF_channels bands in a single pass over the input,
+                                    // and band j feeds the signal conditioner of RF channel j
+                                    channelizers_[i] = gnss_sdr_make_channelizer_from_conf(configuration_.get(), sig_source_.at(i)->role(), RF_Channels);
+                                    top_block_->connect(sig_source_.at(i)->get_right_block(), 0, channelizers_.at(i), 0);
+                                    for (int j = 0; j < RF_Channels; j++)
                                         {
-                                            if (sig_conditioner_.size() > signal_conditioner_ID)
-                                                {
-                                                    LOG(INFO) << "connecting sig_source_ " << i << " stream " << j << " to conditioner " << j;
-                                                    top_block_->connect(sig_source_.at(i)->get_right_block(), j, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
-                                                }
+                                            LOG(INFO) << "connecting channelizer band " << j << " of sig_source_ " << i << " to conditioner " << signal_conditioner_ID;
+                                            top_block_->connect(channelizers_.at(i), j, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                            signal_conditioner_ID++;
                                         }
-                                    else
+                                }
+                            else
+                                {
+                                    for (int j = 0; j < RF_Channels; j++)
                                         {
-                                            if (j == 0)
+                                            // Connect the multichannel signal source to multiple signal conditioners
+                                            // GNURADIO max_streams=-1 means infinite ports!
+                                            DLOG(INFO) << "sig_source_.at(i)->get_right_block()->output_signature()->max_streams()=" << sig_source_.at(i)->get_right_block()->output_signature()->max_streams();
+                                            DLOG(INFO) << "sig_conditioner_.at(signal_conditioner_ID)->get_left_block()->input_signature()=" << sig_conditioner_.at(signal_conditioner_ID)->get_left_block()->input_signature()->max_streams();
+
+                                            if (sig_source_.at(i)->get_right_block()->output_signature()->max_streams() > 1 or sig_source_.at(i)->get_right_block()->output_signature()->max_streams() == -1)
                                                 {
-                                                    // RF_channel 0 backward compatibility with single channel sources
-                                                    LOG(INFO) << "connecting sig_source_ " << i << " stream " << 0 << " to conditioner " << j;
-                                                    top_block_->connect(sig_source_.at(i)->get_right_block(), 0, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                                    if (sig_conditioner_.size() > signal_conditioner_ID)
+                                                        {
+                                                            LOG(INFO) << "connecting sig_source_ " << i << " stream " << j << " to conditioner " << j;
+                                                            top_block_->connect(sig_source_.at(i)->get_right_block(), j, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                                        }
                                                 }
                                             else
                                                 {
-                                                    // Multiple channel sources using multiple output blocks of single channel (requires RF_channel selector in call)
-                                                    LOG(INFO) << "connecting sig_source_ " << i << " stream " << j << " to conditioner " << j;
-                                                    top_block_->connect(sig_source_.at(i)->get_right_block(j), 0, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                                    if (j == 0)
+                                                        {
+                                                            // RF_channel 0 backward compatibility with single channel sources
+                                                            LOG(INFO) << "connecting sig_source_ " << i << " stream " << 0 << " to conditioner " << j;
+                                                            top_block_->connect(sig_source_.at(i)->get_right_block(), 0, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                                        }
+                                                    else
+                                                        {
+                                                            // Multiple channel sources using multiple output blocks of single channel (requires RF_channel selector in call)
+                                                            LOG(INFO) << "connecting sig_source_ " << i << " stream " << j << " to conditioner " << j;
+                                                            top_block_->connect(sig_source_.at(i)->get_right_block(j), 0, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                                        }
                                                 }
+                                            signal_conditioner_ID++;
                                         }
-                                    signal_conditioner_ID++;
                                 }
                         }
                 }
@@ -382,6 +406,7 @@ void GNSSFlowgraph::connect()
         {
             signal_conditioner_connected.push_back(false);
         }
+    channel_edges_.assign(channels_count_, ChannelEdges());
     for (int i = 0; i < channels_count_; i++)
         {
 #ifndef ENABLE_FPGA
@@ -398,6 +423,40 @@ void GNSSFlowgraph::connect()
                         {
                             LOG(WARNING) << e.what();
                         }
+                    // Per-signal-group decimation stage, shared by all the
+                    // channels of the group fed from the same RF chain
+                    gr::basic_block_sptr channel_feed = sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block();
+                    uint32_t channel_fs = fs;
+                    const auto group_decimation = channel_group_decimation_.find(channels_.at(i)->get_signal().get_signal_str());
+                    if (group_decimation != channel_group_decimation_.end())
+                        {
+                            const std::string decimator_key = channels_.at(i)->get_signal().get_signal_str() + std::to_string(selected_signal_conditioner_ID);
+                            channel_fs = fs / group_decimation->second;
+                            try
+                                {
+                                    if (channel_decimators_.find(decimator_key) == channel_decimators_.end())
+                                        {
+                                            // create a FIR low pass filter
+                                            std::vector<float> taps = gr::filter::firdes::low_pass(1.0,
+                                                fs,
+                                                static_cast<double>(channel_fs) / 2.1,
+                                                static_cast<double>(channel_fs) / 2.0);
+                                            channel_decimators_[decimator_key] = gr::filter::fir_filter_ccf::make(static_cast<int>(group_decimation->second), taps);
+                                            top_block_->connect(channel_feed, 0, channel_decimators_.at(decimator_key), 0);
+                                            LOG(INFO) << "Created "
+                                                      << channels_.at(i)->get_signal().get_signal_str()
+                                                      << " channel decimator for RF channel " << std::to_string(selected_signal_conditioner_ID) << " with " << taps.size() << " taps and decimation factor of " << group_decimation->second;
+                                        }
+                                    channel_feed = channel_decimators_.at(decimator_key);
+                                }
+                            catch (const std::exception& e)
+                                {
+                                    LOG(WARNING) << "Can't insert channel decimator for channel " << i;
+                                    LOG(ERROR) << e.what();
+                                    top_block_->disconnect_all();
+                                    return;
+                                }
+                        }
                     try
                         {
                             // Enable automatic resampler for the acquisition, if required
@@ -405,7 +464,7 @@ void GNSSFlowgraph::connect()
                                 {
                                     // create acquisition resamplers if required
                                     double resampler_ratio = 1.0;
-                                    double acq_fs = fs;
+                                    double acq_fs = channel_fs;
                                     // find the signal associated to this channel
                                     switch (mapStringValues_[channels_.at(i)->get_signal().get_signal_str()])
                                         {
@@ -437,29 +496,29 @@ void GNSSFlowgraph::connect()
                                         case evGLO_2G:
                                         case evBDS_B1:
                                         case evBDS_B3:
-                                            acq_fs = fs;
+                                            acq_fs = channel_fs;
                                             break;
                                         default:
                                             break;
                                         }
 
-                                    if (acq_fs < fs)
+                                    if (acq_fs < channel_fs)
                                         {
                                             // check if the resampler is already created for the channel system/signal and for the specific RF Channel
                                             const std::string map_key = channels_.at(i)->get_signal().get_signal_str() + std::to_string(selected_signal_conditioner_ID);
-                                            resampler_ratio = static_cast<double>(fs) / acq_fs;
+                                            resampler_ratio = static_cast<double>(channel_fs) / acq_fs;
                                             int decimation = floor(resampler_ratio);
-                                            while (fs % decimation > 0)
+                                            while (channel_fs % decimation > 0)
                                                 {
                                                     decimation--;
                                                 };
-                                            const double acq_fs_decimated = static_cast<double>(fs) / static_cast<double>(decimation);
+                                            const double acq_fs_decimated = static_cast<double>(channel_fs) / static_cast<double>(decimation);
 
                                             if (decimation > 1)
                                                 {
                                                     // create a FIR low pass filter
                                                     std::vector<float> taps = gr::filter::firdes::low_pass(1.0,
-                                                        fs,
+                                                        channel_fs,
                                                         acq_fs_decimated / 2.1,
                                                         acq_fs_decimated / 2);
 
@@ -469,7 +528,7 @@ void GNSSFlowgraph::connect()
                                                     ret = acq_resamplers_.insert(std::pair<std::string, gr::basic_block_sptr>(map_key, fir_filter_ccf_));
                                                     if (ret.second == true)
                                                         {
-                                                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                                            top_block_->connect(channel_feed, 0,
                                                                 acq_resamplers_.at(map_key), 0);
                                                             LOG(INFO) << "Created "
                                                                       << channels_.at(i)->get_signal().get_signal_str()
@@ -484,6 +543,7 @@ void GNSSFlowgraph::connect()
 
                                                     top_block_->connect(acq_resamplers_.at(map_key), 0,
                                                         channels_.at(i)->get_left_block_acq(), 0);
+                                                    channel_edges_.at(i).acq_feed = acq_resamplers_.at(map_key);
 
                                                     std::shared_ptr<Channel> channel_ptr = std::dynamic_pointer_cast<Channel>(channels_.at(i));
                                                     channel_ptr->acquisition()->set_resampler_latency((taps.size() - 1) / 2);
@@ -492,23 +552,23 @@ void GNSSFlowgraph::connect()
                                                 {
                                                     LOG(INFO) << "Disabled acquisition resampler because the input sampling frequency is too low";
                                                     // resampler not required!
-                                                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                                    top_block_->connect(channel_feed, 0,
                                                         channels_.at(i)->get_left_block_acq(), 0);
                                                 }
                                         }
                                     else
                                         {
                                             LOG(INFO) << "Disabled acquisition resampler because the input sampling frequency is too low";
-                                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                            top_block_->connect(channel_feed, 0,
                                                 channels_.at(i)->get_left_block_acq(), 0);
                                         }
                                 }
                             else
                                 {
-                                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                    top_block_->connect(channel_feed, 0,
                                         channels_.at(i)->get_left_block_acq(), 0);
                                 }
-                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                            top_block_->connect(channel_feed, 0,
                                 channels_.at(i)->get_left_block_trk(), 0);
                         }
                     catch (const std::exception& e)
@@ -518,6 +578,11 @@ void GNSSFlowgraph::connect()
                             top_block_->disconnect_all();
                             return;
                         }
+                    if (!channel_edges_.at(i).acq_feed)
+                        {
+                            channel_edges_.at(i).acq_feed = channel_feed;
+                        }
+                    channel_edges_.at(i).trk_feed = channel_feed;
                     signal_conditioner_connected.at(selected_signal_conditioner_ID) = true;  // notify that this signal conditioner is connected
                     DLOG(INFO) << "signal conditioner " << selected_signal_conditioner_ID << " connected to channel " << i;
                 }
@@ -599,84 +664,19 @@ void GNSSFlowgraph::connect()
                 }
             else
                 {
-                    std::string gnss_system;
                     Gnss_Signal signal_value;
-                    switch (mapStringValues_[gnss_signal])
+                    const Gnss_Signal* interned = intern_signal(gnss_signal, sat);
+                    if (interned != nullptr)
                         {
-                        case evGPS_1C:
-                            gnss_system = "GPS";
-                            signal_value = Gnss_Signal(Gnss_Satellite(gnss_system, sat), gnss_signal);
-                            available_GPS_1C_signals_.remove(signal_value);
-                            break;
-
-                        case evGPS_2S:
-                            gnss_system = "GPS";
-                            signal_value = Gnss_Signal(Gnss_Satellite(gnss_system, sat), gnss_signal);
-                            available_GPS_2S_signals_.remove(signal_value);
-                            break;
-
-                        case evGPS_L5:
-                            gnss_system = "GPS";
-                            signal_value = Gnss_Signal(Gnss_Satellite(gnss_system, sat), gnss_signal);
-                            available_GPS_L5_signals_.remove(signal_value);
-                            break;
-
-                        case evGAL_1B:
-                            gnss_system = "Galileo";
-                            signal_value = Gnss_Signal(Gnss_Satellite(gnss_system, sat), gnss_signal);
-                            available_GAL_1B_signals_.remove(signal_value);
-                            break;
-
-                        case evGAL_5X:
-                            gnss_system = "Galileo";
-                            signal_value = Gnss_Signal(Gnss_Satellite(gnss_system, sat), gnss_signal);
-                            available_GAL_5X_signals_.remove(signal_value);
-                            break;
-
-                        case evGAL_7X:
-                            gnss_system = "Galileo";
-                            signal_value = Gnss_Signal(Gnss_Satellite(gnss_system, sat), gnss_signal);
-                            available_GAL_7X_signals_.remove(signal_value);
-                            break;
-
-                        case evGAL_E6:
-                            gnss_system = "Galileo";
-                            signal_value = Gnss_Signal(Gnss_Satellite(gnss_system, sat), gnss_signal);
-                            available_GAL_E6_signals_.remove(signal_value);
-                            break;
-
-                        case evGLO_1G:
-                            gnss_system = "Glonass";
-                            signal_value = Gnss_Signal(Gnss_Satellite(gnss_system, sat), gnss_signal);
-                            available_GLO_1G_signals_.remove(signal_value);
-                            break;
-
-                        case evGLO_2G:
-                            gnss_system = "Glonass";
-                            signal_value = Gnss_Signal(Gnss_Satellite(gnss_system, sat), gnss_signal);
-                            available_GLO_2G_signals_.remove(signal_value);
-                            break;
-
-                        case evBDS_B1:
-                            gnss_system = "Beidou";
-                            signal_value = Gnss_Signal(Gnss_Satellite(gnss_system, sat), gnss_signal);
-                            available_BDS_B1_signals_.remove(signal_value);
-                            break;
-
-                        case evBDS_B3:
-                            gnss_system = "Beidou";
-                            signal_value = Gnss_Signal(Gnss_Satellite(gnss_system, sat), gnss_signal);
-                            available_BDS_B3_signals_.remove(signal_value);
-                            break;
-
-                        default:
-                            LOG(ERROR) << "This should not happen :-(";
-                            gnss_system = "GPS";
-                            signal_value = Gnss_Signal(Gnss_Satellite(gnss_system, sat), gnss_signal);
-                            available_GPS_1C_signals_.remove(signal_value);
-                            break;
+                            signal_value = *interned;
+                            remove_signal(signal_value);
+                        }
+                    else
+                        {
+                            // the requested satellite is outside the configured
+                            // universe (e.g. a banned PRN): build the signal on the spot
+                            signal_value = Gnss_Signal(Gnss_Satellite(signal_to_system(gnss_signal), sat), gnss_signal);
                         }
-
                     channels_.at(i)->set_signal(signal_value);
                 }
         }
@@ -775,12 +775,466 @@ void GNSSFlowgraph::connect()
                 }
         }
 #endif
+    if (enable_deterministic_replay_)
+        {
+            // Bound every buffer between blocks so upstream blocks cannot run
+            // arbitrarily far ahead of the channels. This has to be applied
+            // before top_block_->start(), when the scheduler allocates the
+            // buffers
+            const int max_buffer_items = configuration_->property("GNSS-SDR.replay_max_buffer_items", 8192);
+            top_block_->set_max_output_buffer(max_buffer_items);
+            LOG(INFO) << "Deterministic replay: max output buffer bounded to " << max_buffer_items << " items";
+
+            // Optionally pin all block threads to a single CPU, which
+            // serializes their execution and makes the block interleaving
+            // repeatable at the cost of throughput
+            const int replay_cpu = configuration_->property("GNSS-SDR.replay_cpu", -1);
+            if (replay_cpu >= 0)
+                {
+                    top_block_->set_processor_affinity(std::vector<int>{replay_cpu});
+                    LOG(INFO) << "Deterministic replay: all blocks pinned to CPU " << replay_cpu;
+                }
+        }
+
+    apply_buffer_sizing_plan();
+
+    apply_scheduling_policy();
+
     connected_ = true;
     LOG(INFO) << "Flowgraph connected";
     top_block_->dump();
 }
 
 
+std::vector<int> GNSSFlowgraph::parse_core_list(const std::string& core_list)
+{
+    std::vector<int> cores;
+    std::stringstream ss(core_list);
+    std::string core;
+    while (std::getline(ss, core, ','))
+        {
+            try
+                {
+                    cores.push_back(std::stoi(core));
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Ignoring malformed core list entry " << core;
+                }
+        }
+    return cores;
+}
+
+
+void GNSSFlowgraph::apply_scheduling_policy()
+{
+    if (!configuration_->property("GNSS-SDR.scheduling_policy", false))
+        {
+            return;
+        }
+
+    // The GNU Radio scheduler spawns one thread per block. Affinities and
+    // priorities have to be set before top_block_->start(), and are applied
+    // per category so e.g. the acquisition bursts can be isolated from the
+    // cores running the tracking loops (core lists are comma-separated,
+    // e.g. GNSS-SDR.acquisition_core_affinity=6,7)
+    const auto pin = [](const gr::basic_block_sptr& bb, const std::vector<int>& cores) {
+        if (bb && !cores.empty())
+            {
+                auto blk = std::dynamic_pointer_cast<gr::block>(bb);
+                if (blk)
+                    {
+                        blk->set_processor_affinity(cores);
+                    }
+            }
+    };
+    const auto prioritize = [](const gr::basic_block_sptr& bb, int priority) {
+        if (bb && priority > 0)
+            {
+                auto blk = std::dynamic_pointer_cast<gr::block>(bb);
+                if (blk)
+                    {
+                        blk->set_thread_priority(priority);
+                    }
+            }
+    };
+
+    const std::vector<int> source_cores = parse_core_list(configuration_->property("GNSS-SDR.signal_source_core_affinity", std::string("")));
+    const std::vector<int> conditioner_cores = parse_core_list(configuration_->property("GNSS-SDR.signal_conditioner_core_affinity", std::string("")));
+    const std::vector<int> acquisition_cores = parse_core_list(configuration_->property("GNSS-SDR.acquisition_core_affinity", std::string("")));
+    const std::vector<int> tracking_cores = parse_core_list(configuration_->property("GNSS-SDR.tracking_core_affinity", std::string("")));
+    const std::vector<int> telemetry_cores = parse_core_list(configuration_->property("GNSS-SDR.telemetry_core_affinity", std::string("")));
+    const std::vector<int> observables_cores = parse_core_list(configuration_->property("GNSS-SDR.observables_core_affinity", std::string("")));
+    const std::vector<int> pvt_cores = parse_core_list(configuration_->property("GNSS-SDR.pvt_core_affinity", std::string("")));
+
+    // Priorities are handed to the scheduler backend; on Linux they map to
+    // real-time scheduling classes and require the process to have the
+    // CAP_SYS_NICE capability or a suitable rtprio limit
+    const int tracking_priority = configuration_->property("GNSS-SDR.tracking_thread_priority", 0);
+    const int observables_priority = configuration_->property("GNSS-SDR.observables_thread_priority", 0);
+
+    for (auto& source : sig_source_)
+        {
+            pin(source->get_right_block(), source_cores);
+        }
+    for (auto& conditioner : sig_conditioner_)
+        {
+            pin(conditioner->get_right_block(), conditioner_cores);
+        }
+    for (int i = 0; i < channels_count_; i++)
+        {
+            pin(channels_.at(i)->get_left_block_acq(), acquisition_cores);
+            pin(channels_.at(i)->get_right_block_acq(), acquisition_cores);
+            pin(channels_.at(i)->get_left_block_trk(), tracking_cores);
+            pin(channels_.at(i)->get_right_block_trk(), tracking_cores);
+            pin(channels_.at(i)->get_right_block(), telemetry_cores);
+            prioritize(channels_.at(i)->get_left_block_trk(), tracking_priority);
+            prioritize(channels_.at(i)->get_right_block_trk(), tracking_priority);
+        }
+    pin(observables_->get_right_block(), observables_cores);
+    prioritize(observables_->get_right_block(), observables_priority);
+    pin(pvt_->get_left_block(), pvt_cores);
+
+    LOG(INFO) << "Flowgraph scheduling policy applied";
+}
+
+
+void GNSSFlowgraph::apply_buffer_sizing_plan()
+{
+    if (!configuration_->property("GNSS-SDR.enable_buffer_sizing_model", false))
+        {
+            return;
+        }
+    if (enable_deterministic_replay_)
+        {
+            LOG(WARNING) << "Buffer sizing model not applied: deterministic replay already bounds every buffer";
+            return;
+        }
+    const double fs = static_cast<double>(configuration_->property("GNSS-SDR.internal_fs_sps", 0));
+    if (fs <= 0.0)
+        {
+            LOG(WARNING) << "Buffer sizing model not applied: GNSS-SDR.internal_fs_sps is not set";
+            return;
+        }
+
+    // The GNU Radio scheduler sizes every link the same by default, which
+    // overbuys the kHz observables links and underbuys the sample-rate ones.
+    // The plan instead derives the full-rate depths from the worst-case stall
+    // of a downstream block (e.g. an acquisition burst stealing the cores)
+    // that has to be absorbed without backpressuring the source, bounded by a
+    // total memory budget for those buffers. It has to be applied before
+    // top_block_->start(), when the buffers are allocated
+    const int stall_budget_ms = configuration_->property("GNSS-SDR.buffer_stall_budget_ms", 50);
+    const int memory_budget_mb = configuration_->property("GNSS-SDR.buffer_memory_budget_mb", 128);
+
+    const auto round_up_pow2 = [](uint64_t items) {
+        uint64_t pow2 = 1;
+        while (pow2 < items)
+            {
+                pow2 <<= 1;
+            }
+        return pow2;
+    };
+    const auto as_block = [](const gr::basic_block_sptr& bb) {
+        return std::dynamic_pointer_cast<gr::block>(bb);
+    };
+
+    // One single-writer buffer per signal source output and per signal
+    // conditioner output, shared by all the readers of that link
+    struct Planned_Link
+    {
+        gr::basic_block_sptr feed;
+        std::string name;
+        size_t item_size;
+    };
+    std::vector<Planned_Link> full_rate_links;
+    for (int i = 0; i < sources_count_; i++)
+        {
+            const auto feed = sig_source_.at(i)->get_right_block();
+            if (feed)
+                {
+                    full_rate_links.push_back({feed, "SignalSource" + std::to_string(i), feed->output_signature()->sizeof_stream_item(0)});
+                }
+        }
+    for (size_t n = 0; n < sig_conditioner_.size(); n++)
+        {
+            const auto feed = sig_conditioner_.at(n)->get_right_block();
+            if (feed)
+                {
+                    full_rate_links.push_back({feed, "SignalConditioner" + std::to_string(n), feed->output_signature()->sizeof_stream_item(0)});
+                }
+        }
+
+    uint64_t depth_items = round_up_pow2(static_cast<uint64_t>(fs * static_cast<double>(stall_budget_ms) / 1000.0));
+    uint64_t plan_bytes = 0;
+    for (const auto& link : full_rate_links)
+        {
+            plan_bytes += depth_items * link.item_size;
+        }
+    const uint64_t budget_bytes = static_cast<uint64_t>(memory_budget_mb) * 1048576ULL;
+    while (plan_bytes > budget_bytes and depth_items > 8192)
+        {
+            depth_items >>= 1;
+            plan_bytes >>= 1;
+        }
+    if (plan_bytes > budget_bytes)
+        {
+            LOG(WARNING) << "Buffer sizing model: " << memory_budget_mb
+                         << " MiB cannot cover a " << stall_budget_ms << " ms stall at " << fs
+                         << " Sps; keeping a minimum depth of " << depth_items << " items per link";
+        }
+    for (const auto& link : full_rate_links)
+        {
+            const auto blk = as_block(link.feed);
+            if (blk)
+                {
+                    blk->set_min_output_buffer(static_cast<long>(depth_items));
+                    LOG(INFO) << "Buffer sizing model: " << link.name << " output buffer >= "
+                              << depth_items << " items ("
+                              << (depth_items * link.item_size) / 1024 << " KiB, "
+                              << static_cast<double>(depth_items) / fs * 1000.0 << " ms of stall headroom)";
+                }
+            else
+                {
+                    LOG(WARNING) << "Buffer sizing model: cannot size the " << link.name << " output buffer";
+                }
+        }
+
+    // The Gnss_Synchro links from the channels into the observables block and
+    // onwards run at the observables rate, so the default depth holds minutes
+    // of data there; a shallow bound returns that memory. The floor keeps the
+    // buffers well above any noutput_items request the scheduler can make
+    const int observable_interval_ms = configuration_->property("GNSS-SDR.observable_interval_ms", 20);
+    const double synchro_rate = 1000.0 / static_cast<double>(observable_interval_ms);
+    const auto low_rate_depth = std::max(static_cast<uint64_t>(4096), round_up_pow2(static_cast<uint64_t>(synchro_rate * static_cast<double>(stall_budget_ms) / 1000.0)));
+    int bounded_links = 0;
+    for (int i = 0; i < channels_count_; i++)
+        {
+            const auto blk = as_block(channels_.at(i)->get_right_block());
+            if (blk)
+                {
+                    blk->set_max_output_buffer(static_cast<long>(low_rate_depth));
+                    bounded_links++;
+                }
+        }
+    const auto obs_blk = as_block(observables_->get_right_block());
+    if (obs_blk)
+        {
+            obs_blk->set_max_output_buffer(static_cast<long>(low_rate_depth));
+            bounded_links++;
+        }
+    LOG(INFO) << "Buffer sizing model: " << bounded_links
+              << " observables-rate links bounded to " << low_rate_depth << " items";
+}
+
+
+bool GNSSFlowgraph::set_channel_parameter(int channel_index, const std::string& name, double value)
+{
+    if ((channel_index < 0) || (channel_index >= channels_count_))
+        {
+            LOG(WARNING) << "Invalid channel index " << channel_index;
+            return false;
+        }
+    return channels_.at(channel_index)->set_runtime_parameter(name, value);
+}
+
+
+int GNSSFlowgraph::set_signal_group_parameter(const std::string& signal_str, const std::string& name, double value)
+{
+    int updated = 0;
+    for (int n = 0; n < channels_count_; n++)
+        {
+            if (channels_.at(n)->get_signal().get_signal_str() == signal_str)
+                {
+                    if (channels_.at(n)->set_runtime_parameter(name, value))
+                        {
+                            updated++;
+                        }
+                }
+        }
+    return updated;
+}
+
+
+bool GNSSFlowgraph::get_channel_parameter(int channel_index, const std::string& name, double* value)
+{
+    if ((channel_index < 0) || (channel_index >= channels_count_))
+        {
+            LOG(WARNING) << "Invalid channel index " << channel_index;
+            return false;
+        }
+    return channels_.at(channel_index)->get_runtime_parameter(name, value);
+}
+
+
+bool GNSSFlowgraph::reassign_channel_rf_chain(int channel_index, int rf_channel_id)
+{
+    if (!connected_)
+        {
+            LOG(WARNING) << "Cannot reassign channel: flowgraph is not connected";
+            return false;
+        }
+    if (channel_index < 0 || channel_index >= channels_count_ ||
+        rf_channel_id < 0 || static_cast<size_t>(rf_channel_id) >= sig_conditioner_.size())
+        {
+            LOG(WARNING) << "Cannot reassign channel " << channel_index << " to RF channel " << rf_channel_id << ": index out of range";
+            return false;
+        }
+    auto& edges = channel_edges_.at(channel_index);
+    if (!edges.acq_feed || !edges.trk_feed)
+        {
+            LOG(WARNING) << "Cannot reassign channel " << channel_index << ": no recorded stream edges";
+            return false;
+        }
+    gr::basic_block_sptr new_feed = sig_conditioner_.at(rf_channel_id)->get_right_block();
+    const std::string signal_str = channels_.at(channel_index)->get_signal().get_signal_str();
+    const auto decimator = channel_decimators_.find(signal_str + std::to_string(rf_channel_id));
+    if (decimator != channel_decimators_.end())
+        {
+            new_feed = decimator->second;
+        }
+    else if (channel_group_decimation_.find(signal_str) != channel_group_decimation_.end())
+        {
+            // the channel was configured for the decimated rate of its group,
+            // so it cannot be spliced onto a full-rate conditioner output
+            LOG(WARNING) << "Cannot reassign channel " << channel_index << ": RF channel " << rf_channel_id << " has no " << signal_str << " decimation stage";
+            return false;
+        }
+    if (new_feed == edges.acq_feed && new_feed == edges.trk_feed)
+        {
+            return true;  // already fed from that RF chain
+        }
+
+    // Lock the scheduler, splice the two edges that feed this channel, and
+    // unlock. Only the affected subgraph is rebuilt, so the other channels
+    // keep their buffers and tracking state instead of going through the
+    // multi-second disconnect() / connect() cycle
+    top_block_->lock();
+    try
+        {
+            top_block_->disconnect(edges.acq_feed, 0, channels_.at(channel_index)->get_left_block_acq(), 0);
+            top_block_->disconnect(edges.trk_feed, 0, channels_.at(channel_index)->get_left_block_trk(), 0);
+            // no per-band acquisition resampler is created on this path; the
+            // acquisition runs on the full-rate conditioner output until the
+            // next full connect()
+            top_block_->connect(new_feed, 0, channels_.at(channel_index)->get_left_block_acq(), 0);
+            top_block_->connect(new_feed, 0, channels_.at(channel_index)->get_left_block_trk(), 0);
+        }
+    catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Failed to splice channel " << channel_index << " onto RF channel " << rf_channel_id << ": " << e.what();
+            top_block_->unlock();
+            return false;
+        }
+    top_block_->unlock();
+    edges.acq_feed = new_feed;
+    edges.trk_feed = new_feed;
+    LOG(INFO) << "Channel " << channel_index << " spliced onto RF channel " << rf_channel_id << " without a full flowgraph reconnection";
+    return true;
+}
+
+
+bool GNSSFlowgraph::save_warm_start_snapshot(const std::string& filename)
+{
+    const auto status_map = channels_status_->get_current_status_map();
+    if (status_map.empty())
+        {
+            LOG(INFO) << "Warm start snapshot not written: no channel reported valid telemetry";
+            return false;
+        }
+    std::ofstream snapshot_file(filename);
+    if (!snapshot_file)
+        {
+            LOG(WARNING) << "Could not write the warm start snapshot to " << filename;
+            return false;
+        }
+    const auto now_s = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+    snapshot_file << "GNSS-SDR warm_start 1\n";
+    snapshot_file << now_s << '\n';
+    snapshot_file << std::setprecision(15);
+    int entries = 0;
+    for (const auto& status : status_map)
+        {
+            if (status.second)
+                {
+                    snapshot_file << status.second->System << ' '
+                                  << status.second->Signal << ' '
+                                  << status.second->PRN << ' '
+                                  << status.second->Carrier_Doppler_hz << ' '
+                                  << status.second->CN0_dB_hz << ' '
+                                  << status.second->RX_time << '\n';
+                    entries++;
+                }
+        }
+    LOG(INFO) << "Warm start snapshot with " << entries << " entries written to " << filename;
+    return entries > 0;
+}
+
+
+bool GNSSFlowgraph::apply_warm_start_snapshot(const std::string& filename, double max_age_s)
+{
+    std::ifstream snapshot_file(filename);
+    if (!snapshot_file)
+        {
+            LOG(INFO) << "No warm start snapshot found at " << filename;
+            return false;
+        }
+    std::string magic;
+    std::string tag;
+    int version = 0;
+    snapshot_file >> magic >> tag >> version;
+    if (magic != "GNSS-SDR" || tag != "warm_start" || version != 1)
+        {
+            LOG(WARNING) << "Discarding warm start snapshot " << filename << ": unrecognized format";
+            return false;
+        }
+    int64_t written_s = 0;
+    snapshot_file >> written_s;
+    const auto now_s = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+    const double age_s = static_cast<double>(now_s - written_s);
+    if (age_s < 0.0 || age_s > max_age_s)
+        {
+            LOG(INFO) << "Discarding warm start snapshot " << filename << ": " << age_s << " s old (limit is " << max_age_s << " s)";
+            return false;
+        }
+
+    std::map<std::string, double> doppler_map;
+    char system;
+    std::string signal;
+    uint32_t prn;
+    double doppler_hz;
+    double cn0_dbhz;
+    double rx_time;
+    while (snapshot_file >> system >> signal >> prn >> doppler_hz >> cn0_dbhz >> rx_time)
+        {
+            doppler_map[std::string(1, system) + signal + std::to_string(prn)] = doppler_hz;
+        }
+
+    // Seed the acquisition of every channel whose assigned signal was being
+    // tracked when the snapshot was taken. The Doppler barely moves over the
+    // few seconds a watchdog restart takes, so the assisted search converges
+    // almost immediately
+    int assisted = 0;
+    for (int i = 0; i < channels_count_; i++)
+        {
+            const Gnss_Signal gs = channels_.at(i)->get_signal();
+            const std::string key = gs.get_satellite().get_system_short() + gs.get_signal_str() + std::to_string(gs.get_satellite().get_PRN());
+            const auto entry = doppler_map.find(key);
+            if (entry != doppler_map.end())
+                {
+                    channels_.at(i)->assist_acquisition_doppler(entry->second);
+                    assisted++;
+                }
+        }
+    LOG(INFO) << "Warm start snapshot " << filename << " (" << age_s << " s old) assisted " << assisted << " channel(s)";
+    return assisted > 0;
+}
+
+
 void GNSSFlowgraph::disconnect()
 {
     LOG(INFO) << "Disconnecting flowgraph";
@@ -791,6 +1245,7 @@ void GNSSFlowgraph::disconnect()
             return;
         }
     connected_ = false;
+    channel_edges_.clear();
     // Signal Source (i) >  Signal conditioner (i) >
     int RF_Channels = 0;
     int signal_conditioner_ID = 0;
@@ -871,26 +1326,38 @@ void GNSSFlowgraph::disconnect()
                             // read the number of RF channels for each front-end
                             RF_Channels = configuration_->property(sig_source_.at(i)->role() + ".RF_channels", 1);
 
-                            for (int j = 0; j < RF_Channels; j++)
+                            if (channelizers_.find(i) != channelizers_.end())
                                 {
-                                    if (sig_source_.at(i)->get_right_block()->output_signature()->max_streams() > 1 or sig_source_.at(i)->get_right_block()->output_signature()->max_streams() == -1)
+                                    top_block_->disconnect(sig_source_.at(i)->get_right_block(), 0, channelizers_.at(i), 0);
+                                    for (int j = 0; j < RF_Channels; j++)
                                         {
-                                            top_block_->disconnect(sig_source_.at(i)->get_right_block(), j, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                            top_block_->disconnect(channelizers_.at(i), j, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                            signal_conditioner_ID++;
                                         }
-                                    else
+                                }
+                            else
+                                {
+                                    for (int j = 0; j < RF_Channels; j++)
                                         {
-                                            if (j == 0)
+                                            if (sig_source_.at(i)->get_right_block()->output_signature()->max_streams() > 1 or sig_source_.at(i)->get_right_block()->output_signature()->max_streams() == -1)
                                                 {
-                                                    // RF_channel 0 backward compatibility with single channel sources
-                                                    top_block_->disconnect(sig_source_.at(i)->get_right_block(), 0, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                                    top_block_->disconnect(sig_source_.at(i)->get_right_block(), j, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
                                                 }
                                             else
                                                 {
-                                                    // Multiple channel sources using multiple output blocks of single channel (requires RF_channel selector in call)
-                                                    top_block_->disconnect(sig_source_.at(i)->get_right_block(j), 0, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                                    if (j == 0)
+                                                        {
+                                                            // RF_channel 0 backward compatibility with single channel sources
+                                                            top_block_->disconnect(sig_source_.at(i)->get_right_block(), 0, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                                        }
+                                                    else
+                                                        {
+                                                            // Multiple channel sources using multiple output blocks of single channel (requires RF_channel selector in call)
+                                                            top_block_->disconnect(sig_source_.at(i)->get_right_block(j), 0, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                                        }
                                                 }
+                                            signal_conditioner_ID++;
                                         }
-                                    signal_conditioner_ID++;
                                 }
                         }
                 }
@@ -968,7 +1435,14 @@ void GNSSFlowgraph::disconnect()
                 }
             try
                 {
-                    top_block_->disconnect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                    // the channel is fed from its group decimator, if one was inserted
+                    gr::basic_block_sptr trk_feed = sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block();
+                    const auto decimator = channel_decimators_.find(channels_.at(i)->get_signal().get_signal_str() + std::to_string(selected_signal_conditioner_ID));
+                    if (decimator != channel_decimators_.end())
+                        {
+                            trk_feed = decimator->second;
+                        }
+                    top_block_->disconnect(trk_feed, 0,
                         channels_.at(i)->get_left_block_trk(), 0);
                 }
             catch (const std::exception& e)
@@ -1115,61 +1589,67 @@ bool GNSSFlowgraph::send_telemetry_msg(const pmt::pmt_t& msg)
 
 void GNSSFlowgraph::push_back_signal(const Gnss_Signal& gs)
 {
+    const Gnss_Signal* gs_ptr = intern_signal(gs.get_signal_str(), gs.get_satellite().get_PRN());
+    if (gs_ptr == nullptr)
+        {
+            DLOG(INFO) << "Signal " << gs << " is outside the configured universe";
+            return;
+        }
     switch (mapStringValues_[gs.get_signal_str()])
         {
         case evGPS_1C:
-            available_GPS_1C_signals_.remove(gs);
-            available_GPS_1C_signals_.push_back(gs);
+            available_GPS_1C_signals_.remove(gs_ptr);
+            available_GPS_1C_signals_.push_back(gs_ptr);
             break;
 
         case evGPS_2S:
-            available_GPS_2S_signals_.remove(gs);
-            available_GPS_2S_signals_.push_back(gs);
+            available_GPS_2S_signals_.remove(gs_ptr);
+            available_GPS_2S_signals_.push_back(gs_ptr);
             break;
 
         case evGPS_L5:
-            available_GPS_L5_signals_.remove(gs);
-            available_GPS_L5_signals_.push_back(gs);
+            available_GPS_L5_signals_.remove(gs_ptr);
+            available_GPS_L5_signals_.push_back(gs_ptr);
             break;
 
         case evGAL_1B:
-            available_GAL_1B_signals_.remove(gs);
-            available_GAL_1B_signals_.push_back(gs);
+            available_GAL_1B_signals_.remove(gs_ptr);
+            available_GAL_1B_signals_.push_back(gs_ptr);
             break;
 
         case evGAL_5X:
-            available_GAL_5X_signals_.remove(gs);
-            available_GAL_5X_signals_.push_back(gs);
+            available_GAL_5X_signals_.remove(gs_ptr);
+            available_GAL_5X_signals_.push_back(gs_ptr);
             break;
 
         case evGAL_7X:
-            available_GAL_7X_signals_.remove(gs);
-            available_GAL_7X_signals_.push_back(gs);
+            available_GAL_7X_signals_.remove(gs_ptr);
+            available_GAL_7X_signals_.push_back(gs_ptr);
             break;
 
         case evGAL_E6:
-            available_GAL_E6_signals_.remove(gs);
-            available_GAL_E6_signals_.push_back(gs);
+            available_GAL_E6_signals_.remove(gs_ptr);
+            available_GAL_E6_signals_.push_back(gs_ptr);
             break;
 
         case evGLO_1G:
-            available_GLO_1G_signals_.remove(gs);
-            available_GLO_1G_signals_.push_back(gs);
+            available_GLO_1G_signals_.remove(gs_ptr);
+            available_GLO_1G_signals_.push_back(gs_ptr);
             break;
 
         case evGLO_2G:
-            available_GLO_2G_signals_.remove(gs);
-            available_GLO_2G_signals_.push_back(gs);
+            available_GLO_2G_signals_.remove(gs_ptr);
+            available_GLO_2G_signals_.push_back(gs_ptr);
             break;
 
         case evBDS_B1:
-            available_BDS_B1_signals_.remove(gs);
-            available_BDS_B1_signals_.push_back(gs);
+            available_BDS_B1_signals_.remove(gs_ptr);
+            available_BDS_B1_signals_.push_back(gs_ptr);
             break;
 
         case evBDS_B3:
-            available_BDS_B3_signals_.remove(gs);
-            available_BDS_B3_signals_.push_back(gs);
+            available_BDS_B3_signals_.remove(gs_ptr);
+            available_BDS_B3_signals_.push_back(gs_ptr);
             break;
 
         default:
@@ -1181,80 +1661,205 @@ void GNSSFlowgraph::push_back_signal(const Gnss_Signal& gs)
 
 void GNSSFlowgraph::remove_signal(const Gnss_Signal& gs)
 {
+    const Gnss_Signal* gs_ptr = intern_signal(gs.get_signal_str(), gs.get_satellite().get_PRN());
+    if (gs_ptr == nullptr)
+        {
+            DLOG(INFO) << "Signal " << gs << " is outside the configured universe";
+            return;
+        }
     switch (mapStringValues_[gs.get_signal_str()])
         {
         case evGPS_1C:
-            available_GPS_1C_signals_.remove(gs);
+            available_GPS_1C_signals_.remove(gs_ptr);
             break;
 
         case evGPS_2S:
-            available_GPS_2S_signals_.remove(gs);
+            available_GPS_2S_signals_.remove(gs_ptr);
             break;
 
         case evGPS_L5:
-            available_GPS_L5_signals_.remove(gs);
+            available_GPS_L5_signals_.remove(gs_ptr);
             break;
 
         case evGAL_1B:
-            available_GAL_1B_signals_.remove(gs);
+            available_GAL_1B_signals_.remove(gs_ptr);
+            break;
+
+        case evGAL_5X:
+            available_GAL_5X_signals_.remove(gs_ptr);
+            break;
+
+        case evGAL_7X:
+            available_GAL_7X_signals_.remove(gs_ptr);
+            break;
+
+        case evGAL_E6:
+            available_GAL_E6_signals_.remove(gs_ptr);
             break;
 
+        case evGLO_1G:
+            available_GLO_1G_signals_.remove(gs_ptr);
+            break;
+
+        case evGLO_2G:
+            available_GLO_2G_signals_.remove(gs_ptr);
+            break;
+
+        case evBDS_B1:
+            available_BDS_B1_signals_.remove(gs_ptr);
+            break;
+
+        case evBDS_B3:
+            available_BDS_B3_signals_.remove(gs_ptr);
+            break;
+
+        default:
+            LOG(ERROR) << "This should not happen :-(";
+            break;
+        }
+}
+
+
+const Gnss_Signal* GNSSFlowgraph::intern_signal(const std::string& signal_str, uint32_t prn) const
+{
+    const auto it = signal_lookup_.find(std::make_pair(signal_str, prn));
+    if (it == signal_lookup_.cend())
+        {
+            return nullptr;
+        }
+    return it->second;
+}
+
+
+std::string GNSSFlowgraph::signal_to_system(const std::string& signal_str)
+{
+    switch (mapStringValues_[signal_str])
+        {
+        case evGPS_1C:
+        case evGPS_2S:
+        case evGPS_L5:
+            return std::string("GPS");
+
+        case evSBAS_1C:
+            return std::string("SBAS");
+
+        case evGAL_1B:
+        case evGAL_5X:
+        case evGAL_7X:
+        case evGAL_E6:
+            return std::string("Galileo");
+
+        case evGLO_1G:
+        case evGLO_2G:
+            return std::string("Glonass");
+
+        case evBDS_B1:
+        case evBDS_B3:
+            return std::string("Beidou");
+
+        default:
+            LOG(ERROR) << "This should not happen :-(";
+            return std::string("GPS");
+        }
+}
+
+
+// project Doppler from primary frequency to secondary frequency
+double GNSSFlowgraph::project_doppler(const std::string& searched_signal, double primary_freq_doppler_hz)
+{
+    switch (mapStringValues_[searched_signal])
+        {
+        case evGPS_L5:
+        case evGAL_5X:
+            return (primary_freq_doppler_hz / FREQ1) * FREQ5;
+            break;
+        case evGAL_7X:
+            return (primary_freq_doppler_hz / FREQ1) * FREQ7;
+            break;
+        case evGPS_2S:
+            return (primary_freq_doppler_hz / FREQ1) * FREQ2;
+            break;
+        case evGAL_E6:
+            return (primary_freq_doppler_hz / FREQ1) * FREQ6;
+            break;
+        default:
+            return primary_freq_doppler_hz;
+        }
+}
+
+
+int GNSSFlowgraph::active_channels_count() const
+{
+    int active = 0;
+    for (int n = 0; n < channels_count_; n++)
+        {
+            if (channels_state_[n] != 0)
+                {
+                    active++;
+                }
+        }
+    return active;
+}
+
+
+bool GNSSFlowgraph::signal_queue_has_candidates(const std::string& searched_signal)
+{
+    const std::list<const Gnss_Signal*>* queue;
+    switch (mapStringValues_[searched_signal])
+        {
+        case evGPS_1C:
+            queue = &available_GPS_1C_signals_;
+            break;
+        case evGPS_2S:
+            queue = &available_GPS_2S_signals_;
+            break;
+        case evGPS_L5:
+            queue = &available_GPS_L5_signals_;
+            break;
+        case evSBAS_1C:
+            queue = &available_SBAS_1C_signals_;
+            break;
+        case evGAL_1B:
+            queue = &available_GAL_1B_signals_;
+            break;
         case evGAL_5X:
-            available_GAL_5X_signals_.remove(gs);
+            queue = &available_GAL_5X_signals_;
             break;
-
         case evGAL_7X:
-            available_GAL_7X_signals_.remove(gs);
+            queue = &available_GAL_7X_signals_;
             break;
-
         case evGAL_E6:
-            available_GAL_E6_signals_.remove(gs);
+            queue = &available_GAL_E6_signals_;
             break;
-
         case evGLO_1G:
-            available_GLO_1G_signals_.remove(gs);
+            queue = &available_GLO_1G_signals_;
             break;
-
         case evGLO_2G:
-            available_GLO_2G_signals_.remove(gs);
+            queue = &available_GLO_2G_signals_;
             break;
-
         case evBDS_B1:
-            available_BDS_B1_signals_.remove(gs);
+            queue = &available_BDS_B1_signals_;
             break;
-
         case evBDS_B3:
-            available_BDS_B3_signals_.remove(gs);
+            queue = &available_BDS_B3_signals_;
             break;
-
         default:
-            LOG(ERROR) << "This should not happen :-(";
-            break;
+            return false;
         }
-}
-
-
-// project Doppler from primary frequency to secondary frequency
-double GNSSFlowgraph::project_doppler(const std::string& searched_signal, double primary_freq_doppler_hz)
-{
-    switch (mapStringValues_[searched_signal])
+    if (queue->empty())
         {
-        case evGPS_L5:
-        case evGAL_5X:
-            return (primary_freq_doppler_hz / FREQ1) * FREQ5;
-            break;
-        case evGAL_7X:
-            return (primary_freq_doppler_hz / FREQ1) * FREQ7;
-            break;
-        case evGPS_2S:
-            return (primary_freq_doppler_hz / FREQ1) * FREQ2;
-            break;
-        case evGAL_E6:
-            return (primary_freq_doppler_hz / FREQ1) * FREQ6;
-            break;
-        default:
-            return primary_freq_doppler_hz;
+            return false;
+        }
+    if (acq_doppler_hints_.empty())
+        {
+            // no prior state: any queued satellite justifies a budget slot
+            return true;
         }
+    // the visibility predictor has run: only spend a slot if a satellite
+    // predicted to be above the horizon is still queued for this signal
+    return std::any_of(queue->begin(), queue->end(), [&](const Gnss_Signal* gs) {
+        return acq_doppler_hints_.count(gs->get_satellite().get_system() + " " + std::to_string(gs->get_satellite().get_PRN())) > 0;
+    });
 }
 
 
@@ -1273,7 +1878,15 @@ void GNSSFlowgraph::acquisition_manager(unsigned int who)
                 {
                     LOG(WARNING) << e.what();
                 }
-            if ((acq_channels_count_ < max_acq_channels_) && (channels_state_[current_channel] == 0))
+            bool budget_allows = true;
+            if (channel_pool_budget_ > 0 and channels_state_[current_channel] == 0)
+                {
+                    // elastic pool: only spend a budget slot on a channel whose
+                    // constellation still has satellites worth searching
+                    budget_allows = (active_channels_count() < channel_pool_budget_) and
+                                    (sat_ != 0 or signal_queue_has_candidates(channels_[current_channel]->get_signal().get_signal_str()));
+                }
+            if ((acq_channels_count_ < max_acq_channels_) && (channels_state_[current_channel] == 0) && !channel_shed_[current_channel] && budget_allows)
                 {
                     bool is_primary_freq = true;
                     bool assistance_available = false;
@@ -1312,8 +1925,19 @@ void GNSSFlowgraph::acquisition_manager(unsigned int who)
                                 }
                             else
                                 {
-                                    // set Doppler center to 0 Hz
-                                    channels_[current_channel]->assist_acquisition_doppler(0);
+                                    // without live assistance, center the search grid on the
+                                    // Doppler predicted by the visibility predictor, if any
+                                    const Gnss_Satellite sat = channels_[current_channel]->get_signal().get_satellite();
+                                    const auto hint = acq_doppler_hints_.find(sat.get_system() + " " + std::to_string(sat.get_PRN()));
+                                    if (hint != acq_doppler_hints_.end())
+                                        {
+                                            channels_[current_channel]->assist_acquisition_doppler(project_doppler(channels_[current_channel]->get_signal().get_signal_str(), hint->second));
+                                        }
+                                    else
+                                        {
+                                            // set Doppler center to 0 Hz
+                                            channels_[current_channel]->assist_acquisition_doppler(0);
+                                        }
                                 }
 #ifndef ENABLE_FPGA
                             channels_[current_channel]->start_acquisition();
@@ -1334,6 +1958,87 @@ void GNSSFlowgraph::acquisition_manager(unsigned int who)
                 }
             DLOG(INFO) << "Channel " << current_channel << " in state " << channels_state_[current_channel];
         }
+    if (channel_pool_budget_ > 0 and active_channels_count() == 0 and !acq_doppler_hints_.empty())
+        {
+            // stale visibility predictions must not starve the pool: discard
+            // them so any queued satellite qualifies again, and run one more
+            // pass (bounded, since the hint map is now empty)
+            LOG(WARNING) << "Elastic channel pool: no predicted-visible satellite queued for any idle channel, discarding stale Doppler predictions";
+            acq_doppler_hints_.clear();
+            acquisition_manager(who);
+        }
+}
+
+
+bool GNSSFlowgraph::steal_channel_for_fpga(unsigned int fpga_channel)
+{
+    // Hybrid FPGA+CPU scheduling: the hardware correlators are essentially
+    // free, so an idle FPGA slot is better spent on a satellite currently
+    // burning CPU cycles in a software channel. The handoff is warm: the
+    // hardware channel reacquires with its search grid centered on the
+    // Doppler last reported by the software channel, and the freed software
+    // channel goes back to the acquisition manager for the next satellite
+    if (!hybrid_scheduler_enabled_ or !channel_is_fpga_[fpga_channel])
+        {
+            return false;
+        }
+    if ((channels_state_[fpga_channel] != 0) or channel_shed_[fpga_channel] or (acq_channels_count_ >= max_acq_channels_))
+        {
+            return false;
+        }
+    const auto status_map = channels_status_->get_current_status_map();
+    int donor = -1;
+    double donor_doppler_hz = 0.0;
+    double donor_cn0_dbhz = 0.0;
+    for (int n = 0; n < channels_count_; n++)
+        {
+            if (channel_is_fpga_[n] or (channels_state_[n] != 2))
+                {
+                    continue;
+                }
+            double doppler_hz = 0.0;
+            double cn0_dbhz = 0.0;
+            const auto status = status_map.find(n);
+            if ((status != status_map.end()) and status->second)
+                {
+                    doppler_hz = status->second->Carrier_Doppler_hz;
+                    cn0_dbhz = status->second->CN0_dB_hz;
+                }
+            // migrate the healthiest satellite: its assisted reacquisition on
+            // the hardware channel converges fastest
+            if ((donor < 0) or (cn0_dbhz > donor_cn0_dbhz))
+                {
+                    donor = n;
+                    donor_doppler_hz = doppler_hz;
+                    donor_cn0_dbhz = cn0_dbhz;
+                }
+        }
+    if (donor < 0)
+        {
+            return false;
+        }
+    const Gnss_Signal gs_donor = channels_[donor]->get_signal();
+    channels_[donor]->stop_channel();
+    channels_state_[donor] = 0;
+    channels_[fpga_channel]->set_signal(gs_donor);
+    channels_[fpga_channel]->assist_acquisition_doppler(donor_doppler_hz);
+    channels_state_[fpga_channel] = 1;
+    acq_channels_count_++;
+#ifndef ENABLE_FPGA
+    channels_[fpga_channel]->start_acquisition();
+#else
+    // create a task for the FPGA such that it doesn't stop the flow
+    std::thread tmp_thread(&ChannelInterface::start_acquisition, channels_[fpga_channel]);
+    tmp_thread.detach();
+#endif
+    LOG(INFO) << "Hybrid scheduler: satellite " << gs_donor.get_satellite()
+              << ", Signal " << gs_donor.get_signal_str()
+              << " migrated from software channel " << donor
+              << " to FPGA channel " << fpga_channel;
+    // hand the freed software channel to the acquisition manager, so it picks
+    // up the next queued satellite (possibly the one the FPGA channel lost)
+    acquisition_manager(donor);
+    return true;
 }
 
 
@@ -1394,6 +2099,12 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
                 {
                     push_back_signal(gs);
                 }
+            // a hardware slot left idle (signal queue exhausted) can take over
+            // a satellite currently tracked by a software channel
+            if (channels_state_[who] == 0)
+                {
+                    steal_channel_for_fpga(who);
+                }
             break;
         case 1:
             gs = channels_[who]->get_signal();
@@ -1436,6 +2147,9 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
                         {
                             push_back_signal(channels_[who]->get_signal());
                         }
+                    // a hardware slot going idle can take over a satellite
+                    // currently tracked by a software channel
+                    steal_channel_for_fpga(who);
                 }
             break;
         case 10:  // request standby mode
@@ -1459,73 +2173,225 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
 }
 
 
+void GNSSFlowgraph::set_acquisition_doppler_hints(const std::map<std::string, double>& doppler_hints_hz)
+{
+    std::lock_guard<std::mutex> lock(signal_list_mutex_);
+    acq_doppler_hints_ = doppler_hints_hz;
+}
+
+
 void GNSSFlowgraph::priorize_satellites(const std::vector<std::pair<int, Gnss_Satellite>>& visible_satellites)
 {
+    // may be called from the assistance thread while channel events are being
+    // dispatched, so the signal queues must be protected
+    std::lock_guard<std::mutex> lock(signal_list_mutex_);
     size_t old_size;
-    Gnss_Signal gs;
+    const Gnss_Signal* gs;
     for (const auto& visible_satellite : visible_satellites)
         {
             if (visible_satellite.second.get_system() == "GPS")
                 {
-                    gs = Gnss_Signal(visible_satellite.second, "1C");
-                    old_size = available_GPS_1C_signals_.size();
-                    available_GPS_1C_signals_.remove(gs);
-                    if (old_size > available_GPS_1C_signals_.size())
+                    gs = intern_signal("1C", visible_satellite.second.get_PRN());
+                    if (gs != nullptr)
                         {
-                            available_GPS_1C_signals_.push_front(gs);
+                            old_size = available_GPS_1C_signals_.size();
+                            available_GPS_1C_signals_.remove(gs);
+                            if (old_size > available_GPS_1C_signals_.size())
+                                {
+                                    available_GPS_1C_signals_.push_front(gs);
+                                }
                         }
 
-                    gs = Gnss_Signal(visible_satellite.second, "2S");
-                    old_size = available_GPS_2S_signals_.size();
-                    available_GPS_2S_signals_.remove(gs);
-                    if (old_size > available_GPS_2S_signals_.size())
+                    gs = intern_signal("2S", visible_satellite.second.get_PRN());
+                    if (gs != nullptr)
                         {
-                            available_GPS_2S_signals_.push_front(gs);
+                            old_size = available_GPS_2S_signals_.size();
+                            available_GPS_2S_signals_.remove(gs);
+                            if (old_size > available_GPS_2S_signals_.size())
+                                {
+                                    available_GPS_2S_signals_.push_front(gs);
+                                }
                         }
 
-                    gs = Gnss_Signal(visible_satellite.second, "L5");
-                    old_size = available_GPS_L5_signals_.size();
-                    available_GPS_L5_signals_.remove(gs);
-                    if (old_size > available_GPS_L5_signals_.size())
+                    gs = intern_signal("L5", visible_satellite.second.get_PRN());
+                    if (gs != nullptr)
                         {
-                            available_GPS_L5_signals_.push_front(gs);
+                            old_size = available_GPS_L5_signals_.size();
+                            available_GPS_L5_signals_.remove(gs);
+                            if (old_size > available_GPS_L5_signals_.size())
+                                {
+                                    available_GPS_L5_signals_.push_front(gs);
+                                }
                         }
                 }
             else if (visible_satellite.second.get_system() == "Galileo")
                 {
-                    gs = Gnss_Signal(visible_satellite.second, "1B");
-                    old_size = available_GAL_1B_signals_.size();
-                    available_GAL_1B_signals_.remove(gs);
-                    if (old_size > available_GAL_1B_signals_.size())
+                    gs = intern_signal("1B", visible_satellite.second.get_PRN());
+                    if (gs != nullptr)
                         {
-                            available_GAL_1B_signals_.push_front(gs);
+                            old_size = available_GAL_1B_signals_.size();
+                            available_GAL_1B_signals_.remove(gs);
+                            if (old_size > available_GAL_1B_signals_.size())
+                                {
+                                    available_GAL_1B_signals_.push_front(gs);
+                                }
+                        }
+
+                    gs = intern_signal("5X", visible_satellite.second.get_PRN());
+                    if (gs != nullptr)
+                        {
+                            old_size = available_GAL_5X_signals_.size();
+                            available_GAL_5X_signals_.remove(gs);
+                            if (old_size > available_GAL_5X_signals_.size())
+                                {
+                                    available_GAL_5X_signals_.push_front(gs);
+                                }
+                        }
+
+                    gs = intern_signal("7X", visible_satellite.second.get_PRN());
+                    if (gs != nullptr)
+                        {
+                            old_size = available_GAL_7X_signals_.size();
+                            available_GAL_7X_signals_.remove(gs);
+                            if (old_size > available_GAL_7X_signals_.size())
+                                {
+                                    available_GAL_7X_signals_.push_front(gs);
+                                }
                         }
 
-                    gs = Gnss_Signal(visible_satellite.second, "5X");
-                    old_size = available_GAL_5X_signals_.size();
-                    available_GAL_5X_signals_.remove(gs);
-                    if (old_size > available_GAL_5X_signals_.size())
+                    gs = intern_signal("E6", visible_satellite.second.get_PRN());
+                    if (gs != nullptr)
                         {
-                            available_GAL_5X_signals_.push_front(gs);
+                            old_size = available_GAL_E6_signals_.size();
+                            available_GAL_E6_signals_.remove(gs);
+                            if (old_size > available_GAL_E6_signals_.size())
+                                {
+                                    available_GAL_E6_signals_.push_front(gs);
+                                }
                         }
+                }
+        }
+}
+
+
+int GNSSFlowgraph::shed_lowest_priority_channel(const std::vector<std::pair<int, Gnss_Satellite>>& visible_satellites, int min_channels_to_keep)
+{
+    std::lock_guard<std::mutex> lock(signal_list_mutex_);
+    std::vector<int> tracking_channels;
+    for (int n = 0; n < channels_count_; n++)
+        {
+            if ((channels_state_[n] == 2) && !channel_shed_[n])
+                {
+                    tracking_channels.push_back(n);
+                }
+        }
+    if (static_cast<int>(tracking_channels.size()) <= min_channels_to_keep)
+        {
+            return -1;
+        }
 
-                    gs = Gnss_Signal(visible_satellite.second, "7X");
-                    old_size = available_GAL_7X_signals_.size();
-                    available_GAL_7X_signals_.remove(gs);
-                    if (old_size > available_GAL_7X_signals_.size())
+    // rank the candidates by elevation when the satellite appears in the
+    // visibility list, falling back to the reported CN0 otherwise
+    const auto status_map = channels_status_->get_current_status_map();
+    int worst_channel = -1;
+    bool worst_has_elevation = false;
+    double worst_score = 0.0;
+    for (const int n : tracking_channels)
+        {
+            const Gnss_Satellite sat = channels_[n]->get_signal().get_satellite();
+            bool has_elevation = false;
+            double score = 0.0;
+            for (const auto& visible_satellite : visible_satellites)
+                {
+                    if (visible_satellite.second == sat)
                         {
-                            available_GAL_7X_signals_.push_front(gs);
+                            has_elevation = true;
+                            score = static_cast<double>(visible_satellite.first);
+                            break;
                         }
+                }
+            if (!has_elevation)
+                {
+                    const auto status = status_map.find(n);
+                    score = (status != status_map.cend() ? static_cast<double>(status->second->CN0_dB_hz) : 0.0);
+                }
+            // an elevation-ranked candidate is preferred over a CN0-ranked one
+            // only while no elevation data has been seen yet
+            if ((worst_channel == -1) ||
+                (has_elevation && !worst_has_elevation) ||
+                ((has_elevation == worst_has_elevation) && (score < worst_score)))
+                {
+                    worst_channel = n;
+                    worst_has_elevation = has_elevation;
+                    worst_score = score;
+                }
+        }
+
+    const Gnss_Signal gs = channels_[worst_channel]->get_signal();
+    LOG(INFO) << "Load governor: channel " << worst_channel << " (" << gs.get_satellite()
+              << ", Signal " << gs.get_signal_str() << ") set to standby, "
+              << (worst_has_elevation ? "elevation " : "CN0 ") << worst_score;
+    push_back_signal(gs);
+    channels_[worst_channel]->stop_channel();
+    channels_state_[worst_channel] = 0;
+    channel_shed_[worst_channel] = true;
+    return worst_channel;
+}
+
+
+bool GNSSFlowgraph::restore_shed_channels()
+{
+    std::lock_guard<std::mutex> lock(signal_list_mutex_);
+    bool restored = false;
+    for (int n = 0; n < channels_count_; n++)
+        {
+            if (channel_shed_[n])
+                {
+                    channel_shed_[n] = false;
+                    restored = true;
+                }
+        }
+    if (restored)
+        {
+            LOG(INFO) << "Load governor: shed channels returned to the acquisition pool";
+            acquisition_manager(0);
+        }
+    return restored;
+}
+
+
+std::map<int, std::shared_ptr<Gnss_Synchro>> GNSSFlowgraph::get_channels_status()
+{
+    if (!channels_status_)
+        {
+            return std::map<int, std::shared_ptr<Gnss_Synchro>>();
+        }
+    return channels_status_->get_current_status_map();
+}
+
 
-                    gs = Gnss_Signal(visible_satellite.second, "E6");
-                    old_size = available_GAL_E6_signals_.size();
-                    available_GAL_E6_signals_.remove(gs);
-                    if (old_size > available_GAL_E6_signals_.size())
+std::vector<uint64_t> GNSSFlowgraph::get_conditioner_sample_counts()
+{
+    std::vector<uint64_t> counts;
+    if (!connected_)
+        {
+            return counts;
+        }
+    counts.reserve(sig_conditioner_.size());
+    for (auto& conditioner : sig_conditioner_)
+        {
+            uint64_t count = 0;
+            if (conditioner)
+                {
+                    const auto right_block = std::dynamic_pointer_cast<gr::block>(conditioner->get_right_block());
+                    if (right_block)
                         {
-                            available_GAL_E6_signals_.push_front(gs);
+                            count = right_block->nitems_written(0);
                         }
                 }
+            counts.push_back(count);
         }
+    return counts;
 }
 
 
@@ -1581,6 +2447,50 @@ void GNSSFlowgraph::init()
     /*
      * Instantiates the receiver blocks
      */
+    // Surface configuration problems before any block is instantiated, so
+    // errors show up right away instead of after a long partial start-up
+    if (!GNSSBlockFactory::ValidateConfiguration(configuration_.get()))
+        {
+            std::cerr << "The GNSS-SDR configuration contains errors (see log file). Trying to continue anyway...\n";
+        }
+
+    // Global byte budget for the block dump paths, enforced while the blocks
+    // set up their dumps below (0 = no enforcement)
+    Dump_Budget::configure(
+        static_cast<uint64_t>(configuration_->property("GNSS-SDR.max_dump_memory_mb", 0)) * 1048576ULL,
+        static_cast<uint64_t>(configuration_->property("GNSS-SDR.dump_block_quota_mb", 8)) * 1048576ULL);
+
+    // OPTIONAL: FFTW wisdom persistence and FFT pre-planning. Importing the
+    // wisdom accumulated by a previous run makes the FFTW_MEASURE planning
+    // performed while the blocks are instantiated almost instantaneous
+    const std::string fftw_wisdom_file = configuration_->property("GNSS-SDR.fftw_wisdom_file", std::string(""));
+    if (!fftw_wisdom_file.empty())
+        {
+            if (Acq_Fft_Plan_Cache::get_instance().load_wisdom(fftw_wisdom_file))
+                {
+                    LOG(INFO) << "FFTW wisdom imported from " << fftw_wisdom_file;
+                }
+        }
+    const std::string preplan_sizes_str = configuration_->property("GNSS-SDR.preplan_fft_sizes", std::string(""));
+    if (!preplan_sizes_str.empty())
+        {
+            // plan the forward and inverse transforms of the listed sizes
+            // before any block is instantiated (e.g. "16384_32768")
+            std::vector<uint32_t> preplan_sizes;
+            for (const auto& size_str : split_string(preplan_sizes_str, '_'))
+                {
+                    try
+                        {
+                            preplan_sizes.push_back(static_cast<uint32_t>(std::stoul(size_str)));
+                        }
+                    catch (const std::exception& e)
+                        {
+                            LOG(WARNING) << "Malformed GNSS-SDR.preplan_fft_sizes entry: " << size_str;
+                        }
+                }
+            Acq_Fft_Plan_Cache::get_instance().preplan(preplan_sizes);
+        }
+
     auto block_factory = std::make_unique<GNSSBlockFactory>();
 
     channels_status_ = channel_status_msg_receiver_make();
@@ -1636,7 +2546,16 @@ void GNSSFlowgraph::init()
 
     pvt_ = block_factory->GetPVT(configuration_.get());
 
-    auto channels = block_factory->GetChannels(configuration_.get(), queue_.get());
+    // Per-signal-group decimation: the channels of a decimated group must be
+    // built against a configuration that reports the decimated rate
+    set_channel_group_decimation();
+    std::map<std::string, const ConfigurationInterface*> group_configurations;
+    for (const auto& group_config : channel_group_configs_)
+        {
+            group_configurations[group_config.first] = group_config.second.get();
+        }
+
+    auto channels = block_factory->GetChannels(configuration_.get(), queue_.get(), group_configurations);
 
     channels_count_ = static_cast<int>(channels->size());
     for (int i = 0; i < channels_count_; i++)
@@ -1664,6 +2583,67 @@ void GNSSFlowgraph::init()
     set_channels_state();
     DLOG(INFO) << "Blocks instantiated. " << channels_count_ << " channels.";
 
+    // Hybrid FPGA+CPU channel scheduling: record which channels run their
+    // tracking loop on the FPGA, so a freed hardware slot can steal the
+    // satellite of a software channel. The family order mirrors the channel
+    // instantiation order of the block factory, so the absolute indices match
+    hybrid_scheduler_enabled_ = configuration_->property("GNSS-SDR.enable_hybrid_channel_scheduler", false);
+    channel_is_fpga_ = std::vector<bool>(channels_count_, false);
+    if (hybrid_scheduler_enabled_)
+        {
+            const std::vector<std::string> channel_families = {"1C", "2S", "L5", "1B", "5X", "E6", "1G", "2G", "B1", "B3", "7X"};
+            int absolute_channel = 0;
+            int fpga_channels = 0;
+            for (const auto& family : channel_families)
+                {
+                    const int count = configuration_->property("Channels_" + family + ".count", 0);
+                    for (int i = 0; i < count; i++)
+                        {
+                            std::string tracking_implementation = configuration_->property("Tracking_" + family + std::to_string(absolute_channel) + ".implementation", std::string());
+                            if (tracking_implementation.empty())
+                                {
+                                    tracking_implementation = configuration_->property("Tracking_" + family + ".implementation", std::string());
+                                }
+                            if ((absolute_channel < channels_count_) and (tracking_implementation.find("_FPGA") != std::string::npos))
+                                {
+                                    channel_is_fpga_[absolute_channel] = true;
+                                    fpga_channels++;
+                                }
+                            absolute_channel++;
+                        }
+                }
+            if ((fpga_channels == 0) or (fpga_channels == channels_count_))
+                {
+                    LOG(WARNING) << "Hybrid channel scheduler disabled: the channel set is not a mix of FPGA and software tracking channels";
+                    hybrid_scheduler_enabled_ = false;
+                }
+            else
+                {
+                    LOG(INFO) << "Hybrid channel scheduler enabled: " << fpga_channels << " FPGA and "
+                              << channels_count_ - fpga_channels << " software tracking channels";
+                }
+        }
+
+    // export the wisdom gathered by the plans made during instantiation, so
+    // the next boot skips the measurement phase
+    if (!fftw_wisdom_file.empty())
+        {
+            if (Acq_Fft_Plan_Cache::get_instance().save_wisdom(fftw_wisdom_file))
+                {
+                    LOG(INFO) << "FFTW wisdom exported to " << fftw_wisdom_file;
+                }
+            else
+                {
+                    LOG(WARNING) << "Could not write FFTW wisdom to " << fftw_wisdom_file;
+                }
+        }
+
+    // OPTIONAL: deterministic replay mode for post-processing A/B comparisons.
+    // Receiver time is already derived from sample counts, so bounding the
+    // buffer depths and (optionally) serializing the block threads makes two
+    // runs over the same file process the epochs in a reproducible order
+    enable_deterministic_replay_ = configuration_->property("GNSS-SDR.deterministic_replay", false);
+
     /*
      * Instantiate the receiver monitor block, if required
      */
@@ -1685,7 +2665,10 @@ void GNSSFlowgraph::init()
             GnssSynchroMonitor_ = gnss_synchro_make_monitor(channels_count_,
                 configuration_->property("Monitor.decimation_factor", 1),
                 configuration_->property("Monitor.udp_port", 1234),
-                udp_addr_vec, enable_protobuf);
+                udp_addr_vec, enable_protobuf,
+                configuration_->property("Monitor.enable_raw_struct", false),
+                configuration_->property("Monitor.batch_size", 1),
+                configuration_->property("Monitor.subscription_port", 0));
         }
 
     /*
@@ -1708,7 +2691,10 @@ void GNSSFlowgraph::init()
             GnssSynchroAcquisitionMonitor_ = gnss_synchro_make_monitor(channels_count_,
                 configuration_->property("AcquisitionMonitor.decimation_factor", 1),
                 configuration_->property("AcquisitionMonitor.udp_port", 1235),
-                udp_addr_vec, enable_protobuf);
+                udp_addr_vec, enable_protobuf,
+                configuration_->property("AcquisitionMonitor.enable_raw_struct", false),
+                configuration_->property("AcquisitionMonitor.batch_size", 1),
+                configuration_->property("AcquisitionMonitor.subscription_port", 0));
         }
 
     /*
@@ -1731,7 +2717,10 @@ void GNSSFlowgraph::init()
             GnssSynchroTrackingMonitor_ = gnss_synchro_make_monitor(channels_count_,
                 configuration_->property("TrackingMonitor.decimation_factor", 1),
                 configuration_->property("TrackingMonitor.udp_port", 1236),
-                udp_addr_vec, enable_protobuf);
+                udp_addr_vec, enable_protobuf,
+                configuration_->property("TrackingMonitor.enable_raw_struct", false),
+                configuration_->property("TrackingMonitor.batch_size", 1),
+                configuration_->property("TrackingMonitor.subscription_port", 0));
         }
 }
 
@@ -1751,6 +2740,52 @@ std::vector<std::string> GNSSFlowgraph::split_string(const std::string& s, char
 }
 
 
+void GNSSFlowgraph::set_channel_group_decimation()
+{
+    channel_group_decimation_.clear();
+    channel_group_configs_.clear();
+    if (configuration_->property("GNSS-SDR.use_channel_decimation", false) == false)
+        {
+            return;
+        }
+    const uint32_t fs = configuration_->property("GNSS-SDR.internal_fs_sps", 0);
+    if (fs == 0)
+        {
+            LOG(WARNING) << "Channel decimation disabled: GNSS-SDR.internal_fs_sps is not set";
+            return;
+        }
+    // signal group naming used by the Channels_XX.count parameters
+    const std::vector<std::string> signals = {"1C", "2S", "L5", "1B", "5X", "E6", "1G", "2G", "B1", "B3", "7X"};
+    for (const auto& signal : signals)
+        {
+            if (configuration_->property("Channels_" + signal + ".count", 0) == 0)
+                {
+                    continue;
+                }
+            // minimum rate that preserves the declared bandwidth of the group
+            const uint32_t required_fs = configuration_->property("Channels_" + signal + ".required_fs_sps", 0);
+            if ((required_fs == 0) or (required_fs >= fs))
+                {
+                    continue;
+                }
+            // the decimated rate must be an integer fraction of the conditioner rate
+            uint32_t decimation = fs / required_fs;
+            while (fs % decimation > 0)
+                {
+                    decimation--;
+                }
+            if (decimation <= 1)
+                {
+                    continue;
+                }
+            const uint32_t decimated_fs = fs / decimation;
+            channel_group_decimation_[signal] = decimation;
+            channel_group_configs_[signal] = std::make_shared<ChannelFsConfiguration>(configuration_, static_cast<int64_t>(decimated_fs));
+            LOG(INFO) << "Channels_" << signal << " will run at " << decimated_fs << " sps (decimation factor of " << decimation << ")";
+        }
+}
+
+
 void GNSSFlowgraph::set_signals_list()
 {
     // Set a sequential list of GNSS satellites
@@ -1975,6 +3010,9 @@ void GNSSFlowgraph::set_signals_list()
                 }
         }
 
+    signal_universe_.clear();
+    signal_lookup_.clear();
+
     if (configuration_->property("Channels_1C.count", 0) > 0)
         {
             // Loop to create GPS L1 C/A signals
@@ -1982,7 +3020,7 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_gps_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GPS_1C_signals_.emplace_back(
+                    signal_universe_.emplace_back(
                         Gnss_Satellite(std::string("GPS"), *available_gnss_prn_iter),
                         std::string("1C"));
                 }
@@ -1995,7 +3033,7 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_gps_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GPS_2S_signals_.emplace_back(
+                    signal_universe_.emplace_back(
                         Gnss_Satellite(std::string("GPS"), *available_gnss_prn_iter),
                         std::string("2S"));
                 }
@@ -2008,7 +3046,7 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_gps_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GPS_L5_signals_.emplace_back(
+                    signal_universe_.emplace_back(
                         Gnss_Satellite(std::string("GPS"), *available_gnss_prn_iter),
                         std::string("L5"));
                 }
@@ -2021,7 +3059,7 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_sbas_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_SBAS_1C_signals_.emplace_back(
+                    signal_universe_.emplace_back(
                         Gnss_Satellite(std::string("SBAS"), *available_gnss_prn_iter),
                         std::string("1C"));
                 }
@@ -2034,7 +3072,7 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_galileo_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GAL_1B_signals_.emplace_back(
+                    signal_universe_.emplace_back(
                         Gnss_Satellite(std::string("Galileo"), *available_gnss_prn_iter),
                         std::string("1B"));
                 }
@@ -2047,7 +3085,7 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_galileo_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GAL_5X_signals_.emplace_back(
+                    signal_universe_.emplace_back(
                         Gnss_Satellite(std::string("Galileo"), *available_gnss_prn_iter),
                         std::string("5X"));
                 }
@@ -2060,7 +3098,7 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_galileo_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GAL_7X_signals_.emplace_back(
+                    signal_universe_.emplace_back(
                         Gnss_Satellite(std::string("Galileo"), *available_gnss_prn_iter),
                         std::string("7X"));
                 }
@@ -2073,7 +3111,7 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_galileo_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GAL_E6_signals_.emplace_back(
+                    signal_universe_.emplace_back(
                         Gnss_Satellite(std::string("Galileo"), *available_gnss_prn_iter),
                         std::string("E6"));
                 }
@@ -2086,7 +3124,7 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_glonass_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GLO_1G_signals_.emplace_back(
+                    signal_universe_.emplace_back(
                         Gnss_Satellite(std::string("Glonass"), *available_gnss_prn_iter),
                         std::string("1G"));
                 }
@@ -2099,7 +3137,7 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_glonass_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GLO_2G_signals_.emplace_back(
+                    signal_universe_.emplace_back(
                         Gnss_Satellite(std::string("Glonass"), *available_gnss_prn_iter),
                         std::string("2G"));
                 }
@@ -2112,7 +3150,7 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_beidou_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_BDS_B1_signals_.emplace_back(
+                    signal_universe_.emplace_back(
                         Gnss_Satellite(std::string("Beidou"), *available_gnss_prn_iter),
                         std::string("B1"));
                 }
@@ -2125,11 +3163,74 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_beidou_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_BDS_B3_signals_.emplace_back(
+                    signal_universe_.emplace_back(
                         Gnss_Satellite(std::string("Beidou"), *available_gnss_prn_iter),
                         std::string("B3"));
                 }
         }
+
+    // Index the flyweight universe and seed the per-signal availability
+    // lists: from here on the retargeting logic references these instances
+    // by pointer instead of constructing satellite/signal objects
+    for (const auto& signal : signal_universe_)
+        {
+            signal_lookup_[std::make_pair(signal.get_signal_str(), signal.get_satellite().get_PRN())] = &signal;
+            if (signal.get_satellite().get_system() == "SBAS")
+                {
+                    available_SBAS_1C_signals_.push_back(&signal);
+                    continue;
+                }
+            switch (mapStringValues_[signal.get_signal_str()])
+                {
+                case evGPS_1C:
+                    available_GPS_1C_signals_.push_back(&signal);
+                    break;
+
+                case evGPS_2S:
+                    available_GPS_2S_signals_.push_back(&signal);
+                    break;
+
+                case evGPS_L5:
+                    available_GPS_L5_signals_.push_back(&signal);
+                    break;
+
+                case evGAL_1B:
+                    available_GAL_1B_signals_.push_back(&signal);
+                    break;
+
+                case evGAL_5X:
+                    available_GAL_5X_signals_.push_back(&signal);
+                    break;
+
+                case evGAL_7X:
+                    available_GAL_7X_signals_.push_back(&signal);
+                    break;
+
+                case evGAL_E6:
+                    available_GAL_E6_signals_.push_back(&signal);
+                    break;
+
+                case evGLO_1G:
+                    available_GLO_1G_signals_.push_back(&signal);
+                    break;
+
+                case evGLO_2G:
+                    available_GLO_2G_signals_.push_back(&signal);
+                    break;
+
+                case evBDS_B1:
+                    available_BDS_B1_signals_.push_back(&signal);
+                    break;
+
+                case evBDS_B3:
+                    available_BDS_B3_signals_.push_back(&signal);
+                    break;
+
+                default:
+                    LOG(ERROR) << "This should not happen :-(";
+                    break;
+                }
+        }
 }
 
 
@@ -2142,10 +3243,23 @@ void GNSSFlowgraph::set_channels_state()
             max_acq_channels_ = channels_count_;
             LOG(WARNING) << "Channels_in_acquisition is bigger than number of channels. Variable acq_channels_count_ is set to " << channels_count_;
         }
+    channel_pool_budget_ = configuration_->property("Channels.total_budget", 0);
+    if (channel_pool_budget_ > channels_count_)
+        {
+            LOG(WARNING) << "Channels.total_budget is bigger than the number of instantiated channels, disabling the elastic pool";
+            channel_pool_budget_ = 0;
+        }
+    if (channel_pool_budget_ > 0)
+        {
+            LOG(INFO) << "Elastic channel pool enabled: " << channel_pool_budget_
+                      << " budget slots shared by " << channels_count_ << " channels";
+        }
+    const int initial_active = (channel_pool_budget_ > 0) ? std::min(max_acq_channels_, channel_pool_budget_) : max_acq_channels_;
     channels_state_.reserve(channels_count_);
+    channel_shed_ = std::vector<bool>(channels_count_, false);
     for (int i = 0; i < channels_count_; i++)
         {
-            if (i < max_acq_channels_)
+            if (i < initial_active)
                 {
                     channels_state_.push_back(1);
                 }
@@ -2155,7 +3269,7 @@ void GNSSFlowgraph::set_channels_state()
                 }
             DLOG(INFO) << "Channel " << i << " in state " << channels_state_[i];
         }
-    acq_channels_count_ = max_acq_channels_;
+    acq_channels_count_ = initial_active;
     DLOG(INFO) << acq_channels_count_ << " channels in acquisition state";
 }
 
@@ -2222,12 +3336,12 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
         {
         case evGPS_1C:
             // todo: assist the satellite selection with almanac and current PVT here (rehuse priorize_satellite function used in control_thread)
-            result = available_GPS_1C_signals_.front();
-            available_GPS_1C_signals_.pop_front();
             if (!pop)
                 {
-                    available_GPS_1C_signals_.push_back(result);
+                    available_GPS_1C_signals_.push_back(available_GPS_1C_signals_.front());
                 }
+            result = *available_GPS_1C_signals_.front();
+            available_GPS_1C_signals_.pop_front();
             is_primary_frequency = true;  // indicate that the searched satellite signal belongs to "primary" link (L1, E1, B1, etc..)
             break;
 
@@ -2241,16 +3355,16 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
                         {
                             if (std::string(current_status.second->Signal) == "1C")
                                 {
-                                    std::list<Gnss_Signal>::iterator it2;
+                                    std::list<const Gnss_Signal*>::iterator it2;
                                     it2 = std::find_if(std::begin(available_GPS_2S_signals_), std::end(available_GPS_2S_signals_),
-                                        [&](Gnss_Signal const& sig) { return sig.get_satellite().get_PRN() == current_status.second->PRN; });
+                                        [&](const Gnss_Signal* sig) { return sig->get_satellite().get_PRN() == current_status.second->PRN; });
 
                                     if (it2 != available_GPS_2S_signals_.end())
                                         {
                                             estimated_doppler = static_cast<float>(current_status.second->Carrier_Doppler_hz);
                                             RX_time = current_status.second->RX_time;
                                             // 3. return the GPS L2 satellite and remove it from list
-                                            result = *it2;
+                                            result = **it2;
                                             if (pop)
                                                 {
                                                     available_GPS_2S_signals_.erase(it2);
@@ -2264,22 +3378,22 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
                     // fallback: pick the front satellite because there is no tracked satellites in L1 to assist L2
                     if (found_signal == false)
                         {
-                            result = available_GPS_2S_signals_.front();
-                            available_GPS_2S_signals_.pop_front();
                             if (!pop)
                                 {
-                                    available_GPS_2S_signals_.push_back(result);
+                                    available_GPS_2S_signals_.push_back(available_GPS_2S_signals_.front());
                                 }
+                            result = *available_GPS_2S_signals_.front();
+                            available_GPS_2S_signals_.pop_front();
                         }
                 }
             else
                 {
-                    result = available_GPS_2S_signals_.front();
-                    available_GPS_2S_signals_.pop_front();
                     if (!pop)
                         {
-                            available_GPS_2S_signals_.push_back(result);
+                            available_GPS_2S_signals_.push_back(available_GPS_2S_signals_.front());
                         }
+                    result = *available_GPS_2S_signals_.front();
+                    available_GPS_2S_signals_.pop_front();
                 }
             break;
 
@@ -2293,9 +3407,9 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
                         {
                             if (std::string(current_status.second->Signal) == "1C")
                                 {
-                                    std::list<Gnss_Signal>::iterator it2;
+                                    std::list<const Gnss_Signal*>::iterator it2;
                                     it2 = std::find_if(std::begin(available_GPS_L5_signals_), std::end(available_GPS_L5_signals_),
-                                        [&](Gnss_Signal const& sig) { return sig.get_satellite().get_PRN() == current_status.second->PRN; });
+                                        [&](const Gnss_Signal* sig) { return sig->get_satellite().get_PRN() == current_status.second->PRN; });
 
                                     if (it2 != available_GPS_L5_signals_.end())
                                         {
@@ -2303,7 +3417,7 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
                                             RX_time = current_status.second->RX_time;
                                             // std::cout << " Channel: " << it->first << " => Doppler: " << estimated_doppler << "[Hz] \n";
                                             // 3. return the GPS L5 satellite and remove it from list
-                                            result = *it2;
+                                            result = **it2;
                                             if (pop)
                                                 {
                                                     available_GPS_L5_signals_.erase(it2);
@@ -2318,22 +3432,22 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
             // fallback: pick the front satellite because there is no tracked satellites in L1 to assist L5
             if (found_signal == false)
                 {
-                    result = available_GPS_L5_signals_.front();
-                    available_GPS_L5_signals_.pop_front();
                     if (!pop)
                         {
-                            available_GPS_L5_signals_.push_back(result);
+                            available_GPS_L5_signals_.push_back(available_GPS_L5_signals_.front());
                         }
+                    result = *available_GPS_L5_signals_.front();
+                    available_GPS_L5_signals_.pop_front();
                 }
             break;
 
         case evGAL_1B:
-            result = available_GAL_1B_signals_.front();
-            available_GAL_1B_signals_.pop_front();
             if (!pop)
                 {
-                    available_GAL_1B_signals_.push_back(result);
+                    available_GAL_1B_signals_.push_back(available_GAL_1B_signals_.front());
                 }
+            result = *available_GAL_1B_signals_.front();
+            available_GAL_1B_signals_.pop_front();
             is_primary_frequency = true;  // indicate that the searched satellite signal belongs to "primary" link (L1, E1, B1, etc..)
             break;
 
@@ -2347,9 +3461,9 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
                         {
                             if (std::string(current_status.second->Signal) == "1B")
                                 {
-                                    std::list<Gnss_Signal>::iterator it2;
+                                    std::list<const Gnss_Signal*>::iterator it2;
                                     it2 = std::find_if(std::begin(available_GAL_5X_signals_), std::end(available_GAL_5X_signals_),
-                                        [&](Gnss_Signal const& sig) { return sig.get_satellite().get_PRN() == current_status.second->PRN; });
+                                        [&](const Gnss_Signal* sig) { return sig->get_satellite().get_PRN() == current_status.second->PRN; });
 
                                     if (it2 != available_GAL_5X_signals_.end())
                                         {
@@ -2357,7 +3471,7 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
                                             RX_time = current_status.second->RX_time;
                                             // std::cout << " Channel: " << it->first << " => Doppler: " << estimated_doppler << "[Hz] \n";
                                             // 3. return the Gal 5X satellite and remove it from list
-                                            result = *it2;
+                                            result = **it2;
                                             if (pop)
                                                 {
                                                     available_GAL_5X_signals_.erase(it2);
@@ -2372,12 +3486,12 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
             // fallback: pick the front satellite because there is no tracked satellites in E1 to assist E5
             if (found_signal == false)
                 {
-                    result = available_GAL_5X_signals_.front();
-                    available_GAL_5X_signals_.pop_front();
                     if (!pop)
                         {
-                            available_GAL_5X_signals_.push_back(result);
+                            available_GAL_5X_signals_.push_back(available_GAL_5X_signals_.front());
                         }
+                    result = *available_GAL_5X_signals_.front();
+                    available_GAL_5X_signals_.pop_front();
                 }
             break;
 
@@ -2391,9 +3505,9 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
                         {
                             if (std::string(current_status.second->Signal) == "1B")
                                 {
-                                    std::list<Gnss_Signal>::iterator it2;
+                                    std::list<const Gnss_Signal*>::iterator it2;
                                     it2 = std::find_if(std::begin(available_GAL_7X_signals_), std::end(available_GAL_7X_signals_),
-                                        [&](Gnss_Signal const& sig) { return sig.get_satellite().get_PRN() == current_status.second->PRN; });
+                                        [&](const Gnss_Signal* sig) { return sig->get_satellite().get_PRN() == current_status.second->PRN; });
 
                                     if (it2 != available_GAL_7X_signals_.end())
                                         {
@@ -2401,7 +3515,7 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
                                             RX_time = current_status.second->RX_time;
                                             // std::cout << " Channel: " << it->first << " => Doppler: " << estimated_doppler << "[Hz] \n";
                                             // 3. return the Gal 7X satellite and remove it from list
-                                            result = *it2;
+                                            result = **it2;
                                             if (pop)
                                                 {
                                                     available_GAL_7X_signals_.erase(it2);
@@ -2416,12 +3530,12 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
             // fallback: pick the front satellite because there is no tracked satellites in E1 to assist E5
             if (found_signal == false)
                 {
-                    result = available_GAL_7X_signals_.front();
-                    available_GAL_7X_signals_.pop_front();
                     if (!pop)
                         {
-                            available_GAL_7X_signals_.push_back(result);
+                            available_GAL_7X_signals_.push_back(available_GAL_7X_signals_.front());
                         }
+                    result = *available_GAL_7X_signals_.front();
+                    available_GAL_7X_signals_.pop_front();
                 }
             break;
 
@@ -2435,9 +3549,9 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
                         {
                             if (std::string(current_status.second->Signal) == "1B")
                                 {
-                                    std::list<Gnss_Signal>::iterator it2;
+                                    std::list<const Gnss_Signal*>::iterator it2;
                                     it2 = std::find_if(std::begin(available_GAL_E6_signals_), std::end(available_GAL_E6_signals_),
-                                        [&](Gnss_Signal const& sig) { return sig.get_satellite().get_PRN() == current_status.second->PRN; });
+                                        [&](const Gnss_Signal* sig) { return sig->get_satellite().get_PRN() == current_status.second->PRN; });
 
                                     if (it2 != available_GAL_E6_signals_.end())
                                         {
@@ -2445,7 +3559,7 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
                                             RX_time = current_status.second->RX_time;
                                             // std::cout << " Channel: " << it->first << " => Doppler: " << estimated_doppler << "[Hz] \n";
                                             // 3. return the Gal E6 satellite and remove it from list
-                                            result = *it2;
+                                            result = **it2;
                                             if (pop)
                                                 {
                                                     available_GAL_E6_signals_.erase(it2);
@@ -2460,56 +3574,56 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
             // fallback: pick the front satellite because there is no tracked satellites in E1 to assist E6
             if (found_signal == false)
                 {
-                    result = available_GAL_E6_signals_.front();
-                    available_GAL_E6_signals_.pop_front();
                     if (!pop)
                         {
-                            available_GAL_E6_signals_.push_back(result);
+                            available_GAL_E6_signals_.push_back(available_GAL_E6_signals_.front());
                         }
+                    result = *available_GAL_E6_signals_.front();
+                    available_GAL_E6_signals_.pop_front();
                 }
             break;
 
         case evGLO_1G:
-            result = available_GLO_1G_signals_.front();
-            available_GLO_1G_signals_.pop_front();
             if (!pop)
                 {
-                    available_GLO_1G_signals_.push_back(result);
+                    available_GLO_1G_signals_.push_back(available_GLO_1G_signals_.front());
                 }
+            result = *available_GLO_1G_signals_.front();
+            available_GLO_1G_signals_.pop_front();
             is_primary_frequency = true;  // indicate that the searched satellite signal belongs to "primary" link (L1, E1, B1, etc..)
             break;
 
         case evGLO_2G:
-            result = available_GLO_2G_signals_.front();
-            available_GLO_2G_signals_.pop_front();
             if (!pop)
                 {
-                    available_GLO_2G_signals_.push_back(result);
+                    available_GLO_2G_signals_.push_back(available_GLO_2G_signals_.front());
                 }
+            result = *available_GLO_2G_signals_.front();
+            available_GLO_2G_signals_.pop_front();
             break;
 
         case evBDS_B1:
-            result = available_BDS_B1_signals_.front();
-            available_BDS_B1_signals_.pop_front();
             if (!pop)
                 {
-                    available_BDS_B1_signals_.push_back(result);
+                    available_BDS_B1_signals_.push_back(available_BDS_B1_signals_.front());
                 }
+            result = *available_BDS_B1_signals_.front();
+            available_BDS_B1_signals_.pop_front();
             is_primary_frequency = true;  // indicate that the searched satellite signal belongs to "primary" link (L1, E1, B1, etc..)
             break;
 
         case evBDS_B3:
-            result = available_BDS_B3_signals_.front();
-            available_BDS_B3_signals_.pop_front();
             if (!pop)
                 {
-                    available_BDS_B3_signals_.push_back(result);
+                    available_BDS_B3_signals_.push_back(available_BDS_B3_signals_.front());
                 }
+            result = *available_BDS_B3_signals_.front();
+            available_BDS_B3_signals_.pop_front();
             break;
 
         default:
             LOG(ERROR) << "This should not happen :-(";
-            result = available_GPS_1C_signals_.front();
+            result = *available_GPS_1C_signals_.front();
             if (pop)
                 {
                     available_GPS_1C_signals_.pop_front();
@@ -26,6 +26,7 @@
 
 #include "channel_status_msg_receiver.h"
 #include "concurrent_queue.h"
+#include "gnss_sdr_channelizer.h"
 #include "gnss_sdr_sample_counter.h"
 #include "gnss_signal.h"
 #include "pvt_interface.h"
@@ -153,6 +154,88 @@ public:
      */
     void priorize_satellites(const std::vector<std::pair<int, Gnss_Satellite>>& visible_satellites);
 
+    /*!
+     * \brief Load predicted Doppler shifts at L1/E1 (in Hz, keyed by
+     * "System PRN") computed by the visibility predictor. Channels starting a
+     * cold acquisition without live assistance center their search grid on
+     * the predicted shift instead of 0 Hz
+     */
+    void set_acquisition_doppler_hints(const std::map<std::string, double>& doppler_hints_hz);
+
+    /*!
+     * \brief Moves a channel onto another RF chain by splicing its input
+     * edges while the scheduler is locked, instead of going through a full
+     * disconnect() / connect() cycle. The other channels keep their buffers
+     * and tracking state. Returns true on success.
+     */
+    bool reassign_channel_rf_chain(int channel_index, int rf_channel_id);
+
+    /*!
+     * \brief Updates a published acquisition or tracking parameter of a
+     * channel while the receiver is running. Returns false if the channel
+     * index is invalid or the parameter is not published.
+     */
+    bool set_channel_parameter(int channel_index, const std::string& name, double value);
+
+    /*!
+     * \brief Applies a runtime parameter to every channel of the given signal
+     * ("1C", "1B", "L5", ...). Returns the number of channels updated
+     */
+    int set_signal_group_parameter(const std::string& signal_str, const std::string& name, double value);
+
+    /*!
+     * \brief Gets the current value of a published acquisition or tracking
+     * parameter of a channel. Returns false if the channel index is invalid
+     * or the parameter is not published.
+     */
+    bool get_channel_parameter(int channel_index, const std::string& name, double* value);
+
+    /*!
+     * \brief Writes a warm-start snapshot with the Doppler, CN0 and receiver
+     * time of every channel that currently reports valid telemetry.
+     * Returns true if at least one entry was written.
+     */
+    bool save_warm_start_snapshot(const std::string& filename);
+
+    /*!
+     * \brief Reads a warm-start snapshot written by a previous run and, if it
+     * is not older than max_age_s seconds, seeds the acquisition of every
+     * channel whose assigned signal appears in it with the stored Doppler.
+     * Returns true if at least one channel was assisted.
+     */
+    bool apply_warm_start_snapshot(const std::string& filename, double max_age_s);
+
+    /*!
+     * \brief Sets the lowest priority tracking channel to standby so that the
+     * surviving channels keep meeting their processing deadlines under
+     * sustained CPU overload. Channels whose satellite appears in
+     * visible_satellites are ranked by elevation; channels without elevation
+     * data are ranked by their reported CN0. The shed channel is excluded from
+     * the acquisition manager until restore_shed_channels() is called.
+     * Returns the index of the shed channel, or -1 if no more than
+     * min_channels_to_keep channels are currently tracking.
+     */
+    int shed_lowest_priority_channel(const std::vector<std::pair<int, Gnss_Satellite>>& visible_satellites, int min_channels_to_keep);
+
+    /*!
+     * \brief Returns the channels shed by shed_lowest_priority_channel() to
+     * the acquisition pool. Returns true if at least one channel was restored.
+     */
+    bool restore_shed_channels();
+
+    /*!
+     * \brief Returns the most recent status reported by each channel, keyed
+     * by channel number. Used by the monitoring and benchmarking tools.
+     */
+    std::map<int, std::shared_ptr<Gnss_Synchro>> get_channels_status();
+
+    /*!
+     * \brief Returns the number of samples delivered so far by each signal
+     * conditioner, in conditioner order. Used by the real-time margin
+     * watchdog to detect when the receiver falls behind the sample stream.
+     */
+    std::vector<uint64_t> get_conditioner_sample_counts();
+
 #ifdef ENABLE_FPGA
     void start_acquisition_helper();
 
@@ -164,6 +247,8 @@ private:
     void set_signals_list();
     void set_channels_state();  // Initializes the channels state (start acquisition or keep standby)
                                 // using the configuration parameters (number of channels and max channels in acquisition)
+    void set_channel_group_decimation();  // Computes the per-signal-group decimation factors and the
+                                          // configurations that expose the decimated rate to the channels
     Gnss_Signal search_next_signal(const std::string& searched_signal,
         const bool pop,
         bool& is_primary_frequency,
@@ -174,9 +259,46 @@ private:
     void push_back_signal(const Gnss_Signal& gs);
     void remove_signal(const Gnss_Signal& gs);
 
+    // Hybrid FPGA+CPU scheduling: when the FPGA tracking channel fpga_channel
+    // goes idle, migrate a satellite currently tracked by a software channel
+    // onto it, warm-starting the hardware channel from the software channel's
+    // last reported Doppler, and hand the freed software channel back to the
+    // acquisition manager. Returns true if a satellite was migrated
+    bool steal_channel_for_fpga(unsigned int fpga_channel);
+
+    // Elastic channel pool (Channels.total_budget): number of channels
+    // currently acquiring or tracking, i.e. spending a budget slot
+    int active_channels_count() const;
+
+    // Elastic channel pool: true if the availability queue of the given
+    // signal still holds a satellite worth a budget slot (any satellite, or
+    // a predicted-visible one when the visibility predictor has run)
+    bool signal_queue_has_candidates(const std::string& searched_signal);
+
+    // Flyweight lookup into signal_universe_: returns the interned instance
+    // for a (signal, PRN) pair, or nullptr if it is outside the configured
+    // universe. The retargeting logic moves these pointers between the
+    // availability lists instead of constructing satellite/signal strings
+    const Gnss_Signal* intern_signal(const std::string& signal_str, uint32_t prn) const;
+    std::string signal_to_system(const std::string& signal_str);
+
     double project_doppler(const std::string& searched_signal, double primary_freq_doppler_hz);
     bool is_multiband() const;
 
+    void apply_scheduling_policy();  // Pins block categories to core sets and raises thread priorities, if so configured
+
+    void apply_buffer_sizing_plan();  // Sizes the inter-block buffers from the configured rates instead of the GNU Radio defaults, if so configured
+
+    static std::vector<int> parse_core_list(const std::string& core_list);
+
+    // Stream edges feeding each channel, recorded while connect() builds the
+    // graph so reassign_channel_rf_chain() can splice them later
+    struct ChannelEdges
+    {
+        gr::basic_block_sptr acq_feed;
+        gr::basic_block_sptr trk_feed;
+    };
+
     std::vector<std::string> split_string(const std::string& s, char delim);
 
     gr::top_block_sptr top_block_;
@@ -191,6 +313,11 @@ private:
     std::shared_ptr<GNSSBlockInterface> pvt_;
 
     std::map<std::string, gr::basic_block_sptr> acq_resamplers_;
+    std::map<std::string, gr::basic_block_sptr> channel_decimators_;       // per-signal/RF-chain shared decimation stages, keyed by signal + RF channel ID
+    std::map<std::string, uint32_t> channel_group_decimation_;             // decimation factor applied to each decimated signal group
+    std::map<std::string, std::shared_ptr<ConfigurationInterface>> channel_group_configs_;  // configurations exposing the decimated rate to each group
+    std::map<int, gnss_sdr_channelizer_sptr> channelizers_;  // per-source shared-FFT band splitters, keyed by source index
+    std::vector<ChannelEdges> channel_edges_;
     std::vector<gr::blocks::null_sink::sptr> null_sinks_;
 
     gr::basic_block_sptr GnssSynchroMonitor_;
@@ -203,19 +330,27 @@ private:
 #endif
 
     std::vector<unsigned int> channels_state_;
-
-    std::list<Gnss_Signal> available_GPS_1C_signals_;
-    std::list<Gnss_Signal> available_GPS_2S_signals_;
-    std::list<Gnss_Signal> available_GPS_L5_signals_;
-    std::list<Gnss_Signal> available_SBAS_1C_signals_;
-    std::list<Gnss_Signal> available_GAL_1B_signals_;
-    std::list<Gnss_Signal> available_GAL_5X_signals_;
-    std::list<Gnss_Signal> available_GAL_7X_signals_;
-    std::list<Gnss_Signal> available_GAL_E6_signals_;
-    std::list<Gnss_Signal> available_GLO_1G_signals_;
-    std::list<Gnss_Signal> available_GLO_2G_signals_;
-    std::list<Gnss_Signal> available_BDS_B1_signals_;
-    std::list<Gnss_Signal> available_BDS_B3_signals_;
+    std::vector<bool> channel_shed_;  // channels set to standby by the load governor, excluded from acquisition
+    std::vector<bool> channel_is_fpga_;  // channels whose tracking loop runs on the FPGA (hybrid scheduler)
+
+    // Full PRN/signal universe, built once by set_signals_list(). The
+    // availability lists below reference these flyweight instances, so
+    // rising/setting satellites cost list splices, not object churn
+    std::vector<Gnss_Signal> signal_universe_;
+    std::map<std::pair<std::string, uint32_t>, const Gnss_Signal*> signal_lookup_;
+
+    std::list<const Gnss_Signal*> available_GPS_1C_signals_;
+    std::list<const Gnss_Signal*> available_GPS_2S_signals_;
+    std::list<const Gnss_Signal*> available_GPS_L5_signals_;
+    std::list<const Gnss_Signal*> available_SBAS_1C_signals_;
+    std::list<const Gnss_Signal*> available_GAL_1B_signals_;
+    std::list<const Gnss_Signal*> available_GAL_5X_signals_;
+    std::list<const Gnss_Signal*> available_GAL_7X_signals_;
+    std::list<const Gnss_Signal*> available_GAL_E6_signals_;
+    std::list<const Gnss_Signal*> available_GLO_1G_signals_;
+    std::list<const Gnss_Signal*> available_GLO_2G_signals_;
+    std::list<const Gnss_Signal*> available_BDS_B1_signals_;
+    std::list<const Gnss_Signal*> available_BDS_B3_signals_;
 
     enum StringValue
     {
@@ -233,6 +368,7 @@ private:
         evBDS_B3
     };
     std::map<std::string, StringValue> mapStringValues_;
+    std::map<std::string, double> acq_doppler_hints_;  // predicted Doppler at L1/E1 per "System PRN", from the visibility predictor
 
     std::string config_file_;
 
@@ -242,10 +378,13 @@ private:
     int channels_count_;
     int acq_channels_count_;
     int max_acq_channels_;
+    int channel_pool_budget_;  // Channels.total_budget: max channels active at once (0 = no limit)
 
     bool connected_;
     bool running_;
     bool multiband_;
+    bool hybrid_scheduler_enabled_;
+    bool enable_deterministic_replay_;
     bool enable_monitor_;
     bool enable_acquisition_monitor_;
     bool enable_tracking_monitor_;
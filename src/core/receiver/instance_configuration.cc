@@ -0,0 +1,99 @@
+/*!
+ * \file instance_configuration.cc
+ * \brief Implementation of the ConfigurationInterface for multi-instance receivers
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "instance_configuration.h"
+#include <utility>
+
+
+InstanceConfiguration::InstanceConfiguration(std::shared_ptr<ConfigurationInterface> base, int instance_id)
+    : base_(std::move(base)),
+      namespace_prefix_("Receiver" + std::to_string(instance_id) + ".")
+{
+}
+
+
+std::string InstanceConfiguration::scoped(const std::string& property_name) const
+{
+    return namespace_prefix_ + property_name;
+}
+
+
+// Every lookup resolves the namespaced key first, with the plain key acting as
+// the default. A key that is absent in both places yields the caller's default.
+std::string InstanceConfiguration::property(std::string property_name, std::string default_value) const
+{
+    return base_->property(scoped(property_name), base_->property(property_name, std::move(default_value)));
+}
+
+
+bool InstanceConfiguration::property(std::string property_name, bool default_value) const
+{
+    return base_->property(scoped(property_name), base_->property(property_name, default_value));
+}
+
+
+int64_t InstanceConfiguration::property(std::string property_name, int64_t default_value) const
+{
+    return base_->property(scoped(property_name), base_->property(property_name, default_value));
+}
+
+
+uint64_t InstanceConfiguration::property(std::string property_name, uint64_t default_value) const
+{
+    return base_->property(scoped(property_name), base_->property(property_name, default_value));
+}
+
+
+int32_t InstanceConfiguration::property(std::string property_name, int32_t default_value) const
+{
+    return base_->property(scoped(property_name), base_->property(property_name, default_value));
+}
+
+
+uint32_t InstanceConfiguration::property(std::string property_name, uint32_t default_value) const
+{
+    return base_->property(scoped(property_name), base_->property(property_name, default_value));
+}
+
+
+int16_t InstanceConfiguration::property(std::string property_name, int16_t default_value) const
+{
+    return base_->property(scoped(property_name), base_->property(property_name, default_value));
+}
+
+
+uint16_t InstanceConfiguration::property(std::string property_name, uint16_t default_value) const
+{
+    return base_->property(scoped(property_name), base_->property(property_name, default_value));
+}
+
+
+float InstanceConfiguration::property(std::string property_name, float default_value) const
+{
+    return base_->property(scoped(property_name), base_->property(property_name, default_value));
+}
+
+
+double InstanceConfiguration::property(std::string property_name, double default_value) const
+{
+    return base_->property(scoped(property_name), base_->property(property_name, default_value));
+}
+
+
+void InstanceConfiguration::set_property(std::string property_name, std::string value)
+{
+    base_->set_property(scoped(property_name), std::move(value));
+}
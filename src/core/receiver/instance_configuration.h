@@ -0,0 +1,70 @@
+/*!
+ * \file instance_configuration.h
+ * \brief A ConfigurationInterface that scopes property lookups to a receiver instance.
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * When several receiver instances run in the same process, each one reads its
+ * parameters through this decorator. A property lookup first tries the
+ * namespaced key Receiver<N>.<property> and falls back to the plain key, so a
+ * single configuration file can hold the common parameters once and override
+ * only what differs between instances (e.g. the signal source device).
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_INSTANCE_CONFIGURATION_H
+#define GNSS_SDR_INSTANCE_CONFIGURATION_H
+
+#include "configuration_interface.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief This class is an implementation of the interface ConfigurationInterface
+ *
+ * Derived from ConfigurationInterface, this class decorates another
+ * configuration and resolves every property for a given receiver instance:
+ * Receiver<N>.<property> takes precedence over <property>.
+ */
+class InstanceConfiguration : public ConfigurationInterface
+{
+public:
+    InstanceConfiguration(std::shared_ptr<ConfigurationInterface> base, int instance_id);
+    ~InstanceConfiguration() = default;
+    std::string property(std::string property_name, std::string default_value) const override;
+    bool property(std::string property_name, bool default_value) const override;
+    int64_t property(std::string property_name, int64_t default_value) const override;
+    uint64_t property(std::string property_name, uint64_t default_value) const override;
+    int32_t property(std::string property_name, int32_t default_value) const override;
+    uint32_t property(std::string property_name, uint32_t default_value) const override;
+    int16_t property(std::string property_name, int16_t default_value) const override;
+    uint16_t property(std::string property_name, uint16_t default_value) const override;
+    float property(std::string property_name, float default_value) const override;
+    double property(std::string property_name, double default_value) const override;
+    void set_property(std::string property_name, std::string value) override;
+
+private:
+    std::string scoped(const std::string& property_name) const;
+    std::shared_ptr<ConfigurationInterface> base_;
+    std::string namespace_prefix_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_INSTANCE_CONFIGURATION_H
@@ -18,6 +18,7 @@
 #include "tcp_cmd_interface.h"
 #include "command_event.h"
 #include "pvt_interface.h"
+#include "trace_writer.h"
 #include <boost/asio.hpp>
 #include <cmath>      // for isnan
 #include <exception>  // for exception
@@ -53,6 +54,10 @@ void TcpCmdInterface::register_functions()
     functions_["warmstart"] = [&](auto &s) { return TcpCmdInterface::warmstart(s); };
     functions_["coldstart"] = [&](auto &s) { return TcpCmdInterface::coldstart(s); };
     functions_["set_ch_satellite"] = [&](auto &s) { return TcpCmdInterface::set_ch_satellite(s); };
+    functions_["set_parameter"] = [&](auto &s) { return TcpCmdInterface::set_parameter(s); };
+    functions_["get_parameter"] = [&](auto &s) { return TcpCmdInterface::get_parameter(s); };
+    functions_["tracestart"] = [&](auto &s) { return TcpCmdInterface::tracestart(s); };
+    functions_["tracestop"] = [&](auto &s) { return TcpCmdInterface::tracestop(s); };
 #else
     functions_["status"] = std::bind(&TcpCmdInterface::status, this, std::placeholders::_1);
     functions_["standby"] = std::bind(&TcpCmdInterface::standby, this, std::placeholders::_1);
@@ -61,10 +66,129 @@ void TcpCmdInterface::register_functions()
     functions_["warmstart"] = std::bind(&TcpCmdInterface::warmstart, this, std::placeholders::_1);
     functions_["coldstart"] = std::bind(&TcpCmdInterface::coldstart, this, std::placeholders::_1);
     functions_["set_ch_satellite"] = std::bind(&TcpCmdInterface::set_ch_satellite, this, std::placeholders::_1);
+    functions_["set_parameter"] = std::bind(&TcpCmdInterface::set_parameter, this, std::placeholders::_1);
+    functions_["get_parameter"] = std::bind(&TcpCmdInterface::get_parameter, this, std::placeholders::_1);
+    functions_["tracestart"] = std::bind(&TcpCmdInterface::tracestart, this, std::placeholders::_1);
+    functions_["tracestop"] = std::bind(&TcpCmdInterface::tracestop, this, std::placeholders::_1);
 #endif
 }
 
 
+void TcpCmdInterface::set_channel_parameter_callbacks(
+    std::function<bool(int, const std::string &, double)> set_callback,
+    std::function<bool(int, const std::string &, double *)> get_callback)
+{
+    set_channel_parameter_callback_ = std::move(set_callback);
+    get_channel_parameter_callback_ = std::move(get_callback);
+}
+
+
+std::string TcpCmdInterface::set_parameter(const std::vector<std::string> &commandLine)
+{
+    std::string response;
+    if (commandLine.size() < 4)
+        {
+            response = "ERROR: usage: set_parameter <channel> <name> <value>\n";
+            return response;
+        }
+    if (!set_channel_parameter_callback_)
+        {
+            response = "ERROR: the receiver is not running\n";
+            return response;
+        }
+    try
+        {
+            const int channel = std::stoi(commandLine.at(1));
+            const double value = std::stod(commandLine.at(3));
+            if (set_channel_parameter_callback_(channel, commandLine.at(2), value))
+                {
+                    response = "OK\n";
+                }
+            else
+                {
+                    response = "ERROR: unknown channel or parameter not published\n";
+                }
+        }
+    catch (const std::exception &e)
+        {
+            response = "ERROR: parameter malformed\n";
+        }
+    return response;
+}
+
+
+std::string TcpCmdInterface::get_parameter(const std::vector<std::string> &commandLine)
+{
+    std::string response;
+    if (commandLine.size() < 3)
+        {
+            response = "ERROR: usage: get_parameter <channel> <name>\n";
+            return response;
+        }
+    if (!get_channel_parameter_callback_)
+        {
+            response = "ERROR: the receiver is not running\n";
+            return response;
+        }
+    try
+        {
+            const int channel = std::stoi(commandLine.at(1));
+            double value = 0.0;
+            if (get_channel_parameter_callback_(channel, commandLine.at(2), &value))
+                {
+                    std::stringstream str_stream;
+                    str_stream << commandLine.at(2) << "=" << value << '\n';
+                    response = str_stream.str();
+                }
+            else
+                {
+                    response = "ERROR: unknown channel or parameter not published\n";
+                }
+        }
+    catch (const std::exception &e)
+        {
+            response = "ERROR: parameter malformed\n";
+        }
+    return response;
+}
+
+
+std::string TcpCmdInterface::tracestart(const std::vector<std::string> &commandLine)
+{
+    std::string response;
+    const std::string filename = (commandLine.size() > 1) ? commandLine.at(1) : std::string("gnss_sdr_trace.json");
+    if (Trace_Writer::enabled())
+        {
+            response = "ERROR: a trace is already being recorded, stop it with tracestop\n";
+        }
+    else if (Trace_Writer::start(filename))
+        {
+            response = "OK: recording trace to " + filename + "\n";
+        }
+    else
+        {
+            response = "ERROR: could not open " + filename + "\n";
+        }
+    return response;
+}
+
+
+std::string TcpCmdInterface::tracestop(const std::vector<std::string> &commandLine __attribute__((unused)))
+{
+    std::string response;
+    if (Trace_Writer::enabled())
+        {
+            Trace_Writer::stop();
+            response = "OK\n";
+        }
+    else
+        {
+            response = "ERROR: no trace is being recorded\n";
+        }
+    return response;
+}
+
+
 void TcpCmdInterface::set_pvt(std::shared_ptr<PvtInterface> PVT_sptr)
 {
     PVT_sptr_ = std::move(PVT_sptr);
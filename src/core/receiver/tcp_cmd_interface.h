@@ -58,6 +58,14 @@ public:
 
     void set_pvt(std::shared_ptr<PvtInterface> PVT_sptr);
 
+    /*!
+     * \brief sets the callbacks used by the set_parameter / get_parameter
+     * telecommands to access the published runtime parameters of the channels
+     */
+    void set_channel_parameter_callbacks(
+        std::function<bool(int, const std::string &, double)> set_callback,
+        std::function<bool(int, const std::string &, double *)> get_callback);
+
 private:
     std::unordered_map<std::string, std::function<std::string(const std::vector<std::string> &)>>
         functions_;
@@ -68,12 +76,19 @@ private:
     std::string warmstart(const std::vector<std::string> &commandLine);
     std::string coldstart(const std::vector<std::string> &commandLine);
     std::string set_ch_satellite(const std::vector<std::string> &commandLine);
+    std::string set_parameter(const std::vector<std::string> &commandLine);
+    std::string get_parameter(const std::vector<std::string> &commandLine);
+    std::string tracestart(const std::vector<std::string> &commandLine);
+    std::string tracestop(const std::vector<std::string> &commandLine);
 
     void register_functions();
 
     std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue_;
     std::shared_ptr<PvtInterface> PVT_sptr_;
 
+    std::function<bool(int, const std::string &, double)> set_channel_parameter_callback_;
+    std::function<bool(int, const std::string &, double *)> get_channel_parameter_callback_;
+
     float rx_latitude_;
     float rx_longitude_;
     float rx_altitude_;
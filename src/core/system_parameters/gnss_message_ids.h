@@ -0,0 +1,95 @@
+/*!
+ * \file gnss_message_ids.h
+ * \brief Interned port symbols and preallocated payloads for block events
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * The event messages exchanged between the processing blocks and the
+ * channel/flowgraph recur with a handful of fixed payloads, yet each
+ * publication built a fresh pmt symbol and integer object. The accessors
+ * below intern the port symbol and the recurring payloads once, so
+ * steady-state event traffic (acquisition bursts, telemetry events)
+ * allocates nothing.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_MESSAGE_IDS_H
+#define GNSS_SDR_GNSS_MESSAGE_IDS_H
+
+#include <pmt/pmt.h>
+#include <pmt/pmt_sugar.h>
+#include <cstdint>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup System_Parameters core_system_parameters
+ * GNSS parameters
+ * \{ */
+
+namespace msg_ids
+{
+//! Interned symbol of the "events" message port
+inline const pmt::pmt_t& events_port()
+{
+    static const pmt::pmt_t port = pmt::mp("events");
+    return port;
+}
+
+//! Interned symbol of the "telemetry" message port
+inline const pmt::pmt_t& telemetry_port()
+{
+    static const pmt::pmt_t port = pmt::mp("telemetry");
+    return port;
+}
+
+//! Preallocated payload of a positive acquisition event
+inline const pmt::pmt_t& positive_acquisition()
+{
+    static const pmt::pmt_t msg = pmt::from_long(1);
+    return msg;
+}
+
+//! Preallocated payload of a negative acquisition event
+inline const pmt::pmt_t& negative_acquisition()
+{
+    static const pmt::pmt_t msg = pmt::from_long(2);
+    return msg;
+}
+
+//! Preallocated payload of a telemetry failure / loss-of-lock event
+inline const pmt::pmt_t& telemetry_failure()
+{
+    static const pmt::pmt_t msg = pmt::from_long(3);
+    return msg;
+}
+
+//! Payload for an event code: the recurring codes return the preallocated
+//! object (a reference count bump), other codes fall back to construction
+inline pmt::pmt_t event(int64_t code)
+{
+    switch (code)
+        {
+        case 1:
+            return positive_acquisition();
+        case 2:
+            return negative_acquisition();
+        case 3:
+            return telemetry_failure();
+        default:
+            return pmt::from_long(code);
+        }
+}
+}  // namespace msg_ids
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_MESSAGE_IDS_H
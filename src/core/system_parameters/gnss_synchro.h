@@ -63,21 +63,24 @@ public:
     double Carrier_phase_rads{};         //!< Set by Tracking processing block
     double Code_phase_samples{};         //!< Set by Tracking processing block
     uint64_t Tracking_sample_counter{};  //!< Set by Tracking processing block
+    uint64_t Ingest_time_ns{};           //!< Set by Tracking processing block (host wall clock when the epoch left tracking)
     int32_t correlation_length_ms{};     //!< Set by Tracking processing block
 
     // Telemetry Decoder
     uint32_t TOW_at_current_symbol_ms{};  //!< Set by Telemetry Decoder processing block
 
     // Observables
-    double Pseudorange_m{};  //!< Set by Observables processing block
-    double RX_time{};        //!< Set by Observables processing block
-    double interp_TOW_ms{};  //!< Set by Observables processing block
+    double Pseudorange_m{};   //!< Set by Observables processing block
+    double RX_time{};         //!< Set by Observables processing block
+    double interp_TOW_ms{};   //!< Set by Observables processing block
+    uint64_t Obs_time_ns{};   //!< Set by Observables processing block (host wall clock when the epoch left observables)
 
     // Flags
     bool Flag_valid_acquisition{};    //!< Set by Acquisition processing block
     bool Flag_valid_symbol_output{};  //!< Set by Tracking processing block
     bool Flag_valid_word{};           //!< Set by Telemetry Decoder processing block
     bool Flag_valid_pseudorange{};    //!< Set by Observables processing block
+    bool Flag_cycle_slip{};           //!< Set by Observables processing block
 
     /// Copy constructor
     Gnss_Synchro(const Gnss_Synchro& other) noexcept
@@ -109,15 +112,18 @@ public:
                 this->Carrier_phase_rads = rhs.Carrier_phase_rads;
                 this->Code_phase_samples = rhs.Code_phase_samples;
                 this->Tracking_sample_counter = rhs.Tracking_sample_counter;
+                this->Ingest_time_ns = rhs.Ingest_time_ns;
                 this->correlation_length_ms = rhs.correlation_length_ms;
                 this->TOW_at_current_symbol_ms = rhs.TOW_at_current_symbol_ms;
                 this->Pseudorange_m = rhs.Pseudorange_m;
                 this->RX_time = rhs.RX_time;
                 this->interp_TOW_ms = rhs.interp_TOW_ms;
+                this->Obs_time_ns = rhs.Obs_time_ns;
                 this->Flag_valid_acquisition = rhs.Flag_valid_acquisition;
                 this->Flag_valid_symbol_output = rhs.Flag_valid_symbol_output;
                 this->Flag_valid_word = rhs.Flag_valid_word;
                 this->Flag_valid_pseudorange = rhs.Flag_valid_pseudorange;
+                this->Flag_cycle_slip = rhs.Flag_cycle_slip;
             }
         return *this;
     };
@@ -151,15 +157,18 @@ public:
                 this->Carrier_phase_rads = other.Carrier_phase_rads;
                 this->Code_phase_samples = other.Code_phase_samples;
                 this->Tracking_sample_counter = other.Tracking_sample_counter;
+                this->Ingest_time_ns = other.Ingest_time_ns;
                 this->correlation_length_ms = other.correlation_length_ms;
                 this->TOW_at_current_symbol_ms = other.TOW_at_current_symbol_ms;
                 this->Pseudorange_m = other.Pseudorange_m;
                 this->RX_time = other.RX_time;
                 this->interp_TOW_ms = other.interp_TOW_ms;
+                this->Obs_time_ns = other.Obs_time_ns;
                 this->Flag_valid_acquisition = other.Flag_valid_acquisition;
                 this->Flag_valid_symbol_output = other.Flag_valid_symbol_output;
                 this->Flag_valid_word = other.Flag_valid_word;
                 this->Flag_valid_pseudorange = other.Flag_valid_pseudorange;
+                this->Flag_cycle_slip = other.Flag_cycle_slip;
             }
         return *this;
     };
@@ -194,6 +203,7 @@ public:
         ar& BOOST_SERIALIZATION_NVP(Carrier_phase_rads);
         ar& BOOST_SERIALIZATION_NVP(Code_phase_samples);
         ar& BOOST_SERIALIZATION_NVP(Tracking_sample_counter);
+        ar& BOOST_SERIALIZATION_NVP(Ingest_time_ns);
         ar& BOOST_SERIALIZATION_NVP(correlation_length_ms);
         // Telemetry Decoder
         ar& BOOST_SERIALIZATION_NVP(TOW_at_current_symbol_ms);
@@ -201,11 +211,13 @@ public:
         ar& BOOST_SERIALIZATION_NVP(Pseudorange_m);
         ar& BOOST_SERIALIZATION_NVP(RX_time);
         ar& BOOST_SERIALIZATION_NVP(interp_TOW_ms);
+        ar& BOOST_SERIALIZATION_NVP(Obs_time_ns);
         // Flags
         ar& BOOST_SERIALIZATION_NVP(Flag_valid_acquisition);
         ar& BOOST_SERIALIZATION_NVP(Flag_valid_symbol_output);
         ar& BOOST_SERIALIZATION_NVP(Flag_valid_word);
         ar& BOOST_SERIALIZATION_NVP(Flag_valid_pseudorange);
+        ar& BOOST_SERIALIZATION_NVP(Flag_cycle_slip);
     }
 };
 
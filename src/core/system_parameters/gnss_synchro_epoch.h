@@ -0,0 +1,304 @@
+/*!
+ * \file gnss_synchro_epoch.h
+ * \brief Structure-of-arrays container for one epoch of Gnss_Synchro data
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * Gnss_Synchro is a fat mixed struct copied through
+ * tracking->observables->PVT->monitor while each consumer touches only a
+ * few fields. This container stores one epoch (one element per channel) as
+ * parallel per-field arrays grouped by producer, so consumers iterate only
+ * the columns they need and the serializers can walk contiguous memory.
+ * The load() / get() / store() shims convert from and to the existing
+ * array-of-structs interfaces.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SYNCHRO_EPOCH_H
+#define GNSS_SDR_GNSS_SYNCHRO_EPOCH_H
+
+#include "gnss_synchro.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup System_Parameters core_system_parameters
+ * GNSS parameters
+ * \{ */
+
+
+/*!
+ * \brief Structure-of-arrays storage for one epoch of per-channel
+ * Gnss_Synchro data, with field-group views over the columns.
+ */
+class Gnss_Synchro_Epoch
+{
+public:
+    //! Satellite and signal info columns, set by Channel
+    struct Satellite_View
+    {
+        const char* system;
+        const std::array<char, 3>* signal;
+        const uint32_t* prn;
+        const int32_t* channel_id;
+        size_t n_channels;
+    };
+
+    //! Acquisition columns
+    struct Acquisition_View
+    {
+        const double* acq_delay_samples;
+        const double* acq_doppler_hz;
+        const uint64_t* acq_samplestamp_samples;
+        const uint32_t* acq_doppler_step;
+        size_t n_channels;
+    };
+
+    //! Tracking columns
+    struct Tracking_View
+    {
+        const int64_t* fs;
+        const double* prompt_i;
+        const double* prompt_q;
+        const double* cn0_db_hz;
+        const double* carrier_doppler_hz;
+        const double* carrier_phase_rads;
+        const double* code_phase_samples;
+        const uint64_t* tracking_sample_counter;
+        const int32_t* correlation_length_ms;
+        size_t n_channels;
+    };
+
+    //! Telemetry and observables columns: the timestamps and ranges
+    struct Observables_View
+    {
+        const uint32_t* tow_at_current_symbol_ms;
+        const double* pseudorange_m;
+        const double* rx_time;
+        const double* interp_tow_ms;
+        size_t n_channels;
+    };
+
+    //! Validity flag columns, stored as bytes so scans stay vectorizable
+    struct Flags_View
+    {
+        const uint8_t* valid_acquisition;
+        const uint8_t* valid_symbol_output;
+        const uint8_t* valid_word;
+        const uint8_t* valid_pseudorange;
+        size_t n_channels;
+    };
+
+    Gnss_Synchro_Epoch() = default;
+
+    explicit Gnss_Synchro_Epoch(size_t n_channels)
+    {
+        resize(n_channels);
+    }
+
+    size_t size() const
+    {
+        return system_.size();
+    }
+
+    void resize(size_t n_channels)
+    {
+        system_.resize(n_channels);
+        signal_.resize(n_channels);
+        prn_.resize(n_channels);
+        channel_id_.resize(n_channels);
+        acq_delay_samples_.resize(n_channels);
+        acq_doppler_hz_.resize(n_channels);
+        acq_samplestamp_samples_.resize(n_channels);
+        acq_doppler_step_.resize(n_channels);
+        fs_.resize(n_channels);
+        prompt_i_.resize(n_channels);
+        prompt_q_.resize(n_channels);
+        cn0_db_hz_.resize(n_channels);
+        carrier_doppler_hz_.resize(n_channels);
+        carrier_phase_rads_.resize(n_channels);
+        code_phase_samples_.resize(n_channels);
+        tracking_sample_counter_.resize(n_channels);
+        correlation_length_ms_.resize(n_channels);
+        tow_at_current_symbol_ms_.resize(n_channels);
+        pseudorange_m_.resize(n_channels);
+        rx_time_.resize(n_channels);
+        interp_tow_ms_.resize(n_channels);
+        valid_acquisition_.resize(n_channels);
+        valid_symbol_output_.resize(n_channels);
+        valid_word_.resize(n_channels);
+        valid_pseudorange_.resize(n_channels);
+    }
+
+    //! Scatter one array-of-structs element into the columns
+    void set(size_t ch, const Gnss_Synchro& in)
+    {
+        system_[ch] = in.System;
+        signal_[ch] = {in.Signal[0], in.Signal[1], in.Signal[2]};
+        prn_[ch] = in.PRN;
+        channel_id_[ch] = in.Channel_ID;
+        acq_delay_samples_[ch] = in.Acq_delay_samples;
+        acq_doppler_hz_[ch] = in.Acq_doppler_hz;
+        acq_samplestamp_samples_[ch] = in.Acq_samplestamp_samples;
+        acq_doppler_step_[ch] = in.Acq_doppler_step;
+        fs_[ch] = in.fs;
+        prompt_i_[ch] = in.Prompt_I;
+        prompt_q_[ch] = in.Prompt_Q;
+        cn0_db_hz_[ch] = in.CN0_dB_hz;
+        carrier_doppler_hz_[ch] = in.Carrier_Doppler_hz;
+        carrier_phase_rads_[ch] = in.Carrier_phase_rads;
+        code_phase_samples_[ch] = in.Code_phase_samples;
+        tracking_sample_counter_[ch] = in.Tracking_sample_counter;
+        correlation_length_ms_[ch] = in.correlation_length_ms;
+        tow_at_current_symbol_ms_[ch] = in.TOW_at_current_symbol_ms;
+        pseudorange_m_[ch] = in.Pseudorange_m;
+        rx_time_[ch] = in.RX_time;
+        interp_tow_ms_[ch] = in.interp_TOW_ms;
+        valid_acquisition_[ch] = in.Flag_valid_acquisition ? 1 : 0;
+        valid_symbol_output_[ch] = in.Flag_valid_symbol_output ? 1 : 0;
+        valid_word_[ch] = in.Flag_valid_word ? 1 : 0;
+        valid_pseudorange_[ch] = in.Flag_valid_pseudorange ? 1 : 0;
+    }
+
+    //! Load an epoch from the array-of-structs block input
+    void load(const Gnss_Synchro** in, size_t n_channels)
+    {
+        resize(n_channels);
+        for (size_t ch = 0; ch < n_channels; ch++)
+            {
+                set(ch, in[ch][0]);
+            }
+    }
+
+    //! Load an epoch from a vector of Gnss_Synchro
+    void load(const std::vector<Gnss_Synchro>& in)
+    {
+        resize(in.size());
+        for (size_t ch = 0; ch < in.size(); ch++)
+            {
+                set(ch, in[ch]);
+            }
+    }
+
+    //! Reassemble the array-of-structs element of one channel
+    Gnss_Synchro get(size_t ch) const
+    {
+        Gnss_Synchro out{};
+        out.System = system_[ch];
+        out.Signal[0] = signal_[ch][0];
+        out.Signal[1] = signal_[ch][1];
+        out.Signal[2] = signal_[ch][2];
+        out.PRN = prn_[ch];
+        out.Channel_ID = channel_id_[ch];
+        out.Acq_delay_samples = acq_delay_samples_[ch];
+        out.Acq_doppler_hz = acq_doppler_hz_[ch];
+        out.Acq_samplestamp_samples = acq_samplestamp_samples_[ch];
+        out.Acq_doppler_step = acq_doppler_step_[ch];
+        out.fs = fs_[ch];
+        out.Prompt_I = prompt_i_[ch];
+        out.Prompt_Q = prompt_q_[ch];
+        out.CN0_dB_hz = cn0_db_hz_[ch];
+        out.Carrier_Doppler_hz = carrier_doppler_hz_[ch];
+        out.Carrier_phase_rads = carrier_phase_rads_[ch];
+        out.Code_phase_samples = code_phase_samples_[ch];
+        out.Tracking_sample_counter = tracking_sample_counter_[ch];
+        out.correlation_length_ms = correlation_length_ms_[ch];
+        out.TOW_at_current_symbol_ms = tow_at_current_symbol_ms_[ch];
+        out.Pseudorange_m = pseudorange_m_[ch];
+        out.RX_time = rx_time_[ch];
+        out.interp_TOW_ms = interp_tow_ms_[ch];
+        out.Flag_valid_acquisition = (valid_acquisition_[ch] != 0);
+        out.Flag_valid_symbol_output = (valid_symbol_output_[ch] != 0);
+        out.Flag_valid_word = (valid_word_[ch] != 0);
+        out.Flag_valid_pseudorange = (valid_pseudorange_[ch] != 0);
+        return out;
+    }
+
+    //! Reassemble the whole epoch into a vector of Gnss_Synchro
+    void store(std::vector<Gnss_Synchro>& out) const
+    {
+        out.resize(size());
+        for (size_t ch = 0; ch < size(); ch++)
+            {
+                out[ch] = get(ch);
+            }
+    }
+
+    Satellite_View satellite() const
+    {
+        return {system_.data(), signal_.data(), prn_.data(), channel_id_.data(), size()};
+    }
+
+    Acquisition_View acquisition() const
+    {
+        return {acq_delay_samples_.data(), acq_doppler_hz_.data(),
+            acq_samplestamp_samples_.data(), acq_doppler_step_.data(), size()};
+    }
+
+    Tracking_View tracking() const
+    {
+        return {fs_.data(), prompt_i_.data(), prompt_q_.data(), cn0_db_hz_.data(),
+            carrier_doppler_hz_.data(), carrier_phase_rads_.data(), code_phase_samples_.data(),
+            tracking_sample_counter_.data(), correlation_length_ms_.data(), size()};
+    }
+
+    Observables_View observables() const
+    {
+        return {tow_at_current_symbol_ms_.data(), pseudorange_m_.data(),
+            rx_time_.data(), interp_tow_ms_.data(), size()};
+    }
+
+    Flags_View flags() const
+    {
+        return {valid_acquisition_.data(), valid_symbol_output_.data(),
+            valid_word_.data(), valid_pseudorange_.data(), size()};
+    }
+
+private:
+    // Satellite and signal info
+    std::vector<char> system_;
+    std::vector<std::array<char, 3>> signal_;
+    std::vector<uint32_t> prn_;
+    std::vector<int32_t> channel_id_;
+    // Acquisition
+    std::vector<double> acq_delay_samples_;
+    std::vector<double> acq_doppler_hz_;
+    std::vector<uint64_t> acq_samplestamp_samples_;
+    std::vector<uint32_t> acq_doppler_step_;
+    // Tracking
+    std::vector<int64_t> fs_;
+    std::vector<double> prompt_i_;
+    std::vector<double> prompt_q_;
+    std::vector<double> cn0_db_hz_;
+    std::vector<double> carrier_doppler_hz_;
+    std::vector<double> carrier_phase_rads_;
+    std::vector<double> code_phase_samples_;
+    std::vector<uint64_t> tracking_sample_counter_;
+    std::vector<int32_t> correlation_length_ms_;
+    // Telemetry Decoder and Observables
+    std::vector<uint32_t> tow_at_current_symbol_ms_;
+    std::vector<double> pseudorange_m_;
+    std::vector<double> rx_time_;
+    std::vector<double> interp_tow_ms_;
+    // Flags
+    std::vector<uint8_t> valid_acquisition_;
+    std::vector<uint8_t> valid_symbol_output_;
+    std::vector<uint8_t> valid_word_;
+    std::vector<uint8_t> valid_pseudorange_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SYNCHRO_EPOCH_H
@@ -25,9 +25,11 @@
 #define GOOGLE_STRIP_LOG 0
 #endif
 
+#include "batch_orchestrator.h"
 #include "concurrent_map.h"
 #include "concurrent_queue.h"
 #include "control_thread.h"
+#include "gnss_sdr_flags.h"
 #include "gnss_sdr_make_unique.h"
 #include "gps_acq_assist.h"
 #include <boost/exception/diagnostic_information.hpp>  // for diagnostic_information
@@ -144,10 +146,21 @@ int main(int argc, char** argv)
     int return_code = 0;
     try
         {
-            auto control_thread = std::make_unique<ControlThread>();
-            // record startup time
-            start = std::chrono::system_clock::now();
-            return_code = control_thread->run();
+            if (FLAGS_batch_manifest != "-")
+                {
+                    // batch mode: reprocess a manifest of capture files with
+                    // concurrent flowgraphs sharing this process
+                    auto orchestrator = std::make_unique<Batch_Orchestrator>();
+                    start = std::chrono::system_clock::now();
+                    return_code = orchestrator->run();
+                }
+            else
+                {
+                    auto control_thread = std::make_unique<ControlThread>();
+                    // record startup time
+                    start = std::chrono::system_clock::now();
+                    return_code = control_thread->run();
+                }
         }
     catch (const boost::thread_resource_error& e)
         {
@@ -0,0 +1,423 @@
+/*!
+ * \file benchmark_receiver_paths.cc
+ * \brief Regression-tracked benchmark of the hot composite receiver paths
+ * \author Javier Arribas, 2020. jarribas(at)gmail.com
+ *
+ * Exercises the per-epoch computations of the receiver chain with
+ * fixed-seed inputs: the conditioner conversion + filtering kernels, one
+ * tracking channel epoch (carrier wipeoff, multicorrelation, discriminators
+ * and loop filters), an observables interpolation epoch over twelve
+ * channels, and an iterated least-squares position solve. The process is
+ * pinned to one core and the measured ns/op figures are compared against a
+ * committed baseline file with a tolerance, so performance changes show up
+ * in CI as numbers instead of anecdotes. Set GNSSSDR_BENCH_WRITE_BASELINE
+ * to refresh the baseline on the reference machine.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "cpu_multicorrelator_real_codes.h"
+#include "gnss_synchro.h"
+#include "gps_sdr_signal_replica.h"
+#include "tracking_2nd_DLL_filter.h"
+#include "tracking_FLL_PLL_filter.h"
+#include "tracking_discriminators.h"
+#include <armadillo>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#ifndef GNSSSDR_BENCH_BASELINE_FILE
+#define GNSSSDR_BENCH_BASELINE_FILE ""
+#endif
+
+namespace
+{
+constexpr unsigned int fixed_seed = 20;
+constexpr int conditioner_input_samples = 32768;
+constexpr int tracking_epoch_samples = 2048;  // 1 ms at 2.048 Msps
+constexpr int observables_channels = 12;
+constexpr int observables_history_depth = 400;
+constexpr int pvt_satellites = 8;
+
+
+// Conditioner chain kernels: interleaved short -> complex float conversion
+// followed by a 32-tap FIR with decimation by two, the arithmetic performed
+// per input buffer by a typical ishort -> gr_complex conditioner
+void bm_conditioner_chain(benchmark::State& state)
+{
+    std::mt19937 gen(fixed_seed);
+    std::uniform_int_distribution<int16_t> sample_dist(-8192, 8191);
+    std::vector<int16_t> input(2 * conditioner_input_samples);
+    for (auto& sample : input)
+        {
+            sample = sample_dist(gen);
+        }
+    std::vector<std::complex<float>> converted(conditioner_input_samples);
+    std::vector<std::complex<float>> filtered(conditioner_input_samples / 2);
+    std::vector<float> taps(32);
+    for (size_t k = 0; k < taps.size(); k++)
+        {
+            taps[k] = 0.03125F * std::cos(static_cast<float>(k) * 0.1F);
+        }
+
+    while (state.KeepRunning())
+        {
+            const float scale = 1.0F / 8192.0F;
+            for (int n = 0; n < conditioner_input_samples; n++)
+                {
+                    converted[n] = std::complex<float>(static_cast<float>(input[2 * n]) * scale,
+                        static_cast<float>(input[2 * n + 1]) * scale);
+                }
+            for (size_t n = 0; n < filtered.size(); n++)
+                {
+                    std::complex<float> acc(0.0F, 0.0F);
+                    const size_t base = 2 * n;
+                    for (size_t k = 0; (k < taps.size()) && (base + k < converted.size()); k++)
+                        {
+                            acc += converted[base + k] * taps[k];
+                        }
+                    filtered[n] = acc;
+                }
+            benchmark::DoNotOptimize(filtered.data());
+        }
+}
+
+
+// One tracking channel epoch: carrier wipeoff and five-correlator code
+// correlation over 1 ms of signal, followed by the discriminators and the
+// loop filters, the per-epoch work of dll_pll_veml_tracking
+void bm_tracking_channel_epoch(benchmark::State& state)
+{
+    std::mt19937 gen(fixed_seed);
+    std::normal_distribution<float> noise(0.0F, 0.3F);
+    std::vector<std::complex<float>> signal(tracking_epoch_samples);
+    for (auto& sample : signal)
+        {
+            sample = std::complex<float>(1.0F + noise(gen), noise(gen));
+        }
+    const int code_length_chips = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    std::vector<float> local_code(code_length_chips);
+    std::vector<std::complex<float>> local_code_complex(code_length_chips);
+    gps_l1_ca_code_gen_complex(local_code_complex, 1, 0);
+    for (int k = 0; k < code_length_chips; k++)
+        {
+            local_code[k] = local_code_complex[k].real();
+        }
+    std::vector<float> shifts_chips = {-0.5F, -0.25F, 0.0F, 0.25F, 0.5F};
+    std::vector<std::complex<float>> correlator_outs(shifts_chips.size());
+
+    Cpu_Multicorrelator_Real_Codes multicorrelator;
+    multicorrelator.init(tracking_epoch_samples, static_cast<int>(shifts_chips.size()));
+    multicorrelator.set_local_code_and_taps(code_length_chips, local_code.data(), shifts_chips.data());
+    multicorrelator.set_input_output_vectors(correlator_outs.data(), signal.data());
+
+    Tracking_2nd_DLL_filter code_loop_filter(0.001F);
+    code_loop_filter.set_DLL_BW(2.0F);
+    code_loop_filter.initialize();
+    Tracking_FLL_PLL_filter carrier_loop_filter;
+    carrier_loop_filter.set_params(10.0F, 35.0F, 3);
+    carrier_loop_filter.initialize(1000.0F);
+
+    const float code_phase_step_chips = static_cast<float>(GPS_L1_CA_CODE_RATE_CPS) / 2048000.0F;
+    float carr_error_filt_hz = 0.0F;
+    while (state.KeepRunning())
+        {
+            multicorrelator.Carrier_wipeoff_multicorrelator_resampler(
+                0.25F, 0.003F, 0.1F, code_phase_step_chips, 0.0F, tracking_epoch_samples);
+            const float carr_error_hz = pll_cloop_two_quadrant_atan(correlator_outs[2]) / TWO_PI;
+            carr_error_filt_hz = carrier_loop_filter.get_carrier_error(0.0F, carr_error_hz, 0.001F);
+            const float code_error_chips = dll_nc_e_minus_l_normalized(correlator_outs[1], correlator_outs[3]);
+            const float code_error_filt_chips = code_loop_filter.get_code_nco(code_error_chips);
+            benchmark::DoNotOptimize(carr_error_filt_hz);
+            benchmark::DoNotOptimize(code_error_filt_chips);
+        }
+    multicorrelator.free();
+}
+
+
+// One observables epoch: for each channel, locate the pair of history
+// entries bracketing the common reception sample count and interpolate the
+// time of week, carrier phase and Doppler at it, the per-epoch work of
+// hybrid_observables_gs
+void bm_observables_epoch(benchmark::State& state)
+{
+    std::mt19937 gen(fixed_seed);
+    std::uniform_int_distribution<uint64_t> offset_dist(0, 1999);
+    std::vector<std::deque<Gnss_Synchro>> history(observables_channels);
+    for (auto& channel_history : history)
+        {
+            uint64_t sample_counter = offset_dist(gen);
+            for (int k = 0; k < observables_history_depth; k++)
+                {
+                    Gnss_Synchro gs{};
+                    gs.Flag_valid_word = true;
+                    gs.Tracking_sample_counter = sample_counter;
+                    gs.fs = 2048000LL;
+                    gs.TOW_at_current_symbol_ms = 100000U + static_cast<uint32_t>(k);
+                    gs.Carrier_phase_rads = 0.001 * static_cast<double>(sample_counter);
+                    gs.Carrier_Doppler_hz = 1000.0 + 0.01 * static_cast<double>(k);
+                    sample_counter += 2048;
+                    channel_history.push_back(gs);
+                }
+        }
+    const uint64_t rx_sample_count = 2048ULL * (observables_history_depth / 2);
+
+    while (state.KeepRunning())
+        {
+            double accumulated_tow_s = 0.0;
+            for (const auto& channel_history : history)
+                {
+                    // locate the bracketing pair
+                    size_t low = 0;
+                    size_t high = channel_history.size() - 1;
+                    while (high - low > 1)
+                        {
+                            const size_t mid = (low + high) / 2;
+                            if (channel_history[mid].Tracking_sample_counter <= rx_sample_count)
+                                {
+                                    low = mid;
+                                }
+                            else
+                                {
+                                    high = mid;
+                                }
+                        }
+                    const Gnss_Synchro& early = channel_history[low];
+                    const Gnss_Synchro& late = channel_history[high];
+                    const double fraction = static_cast<double>(rx_sample_count - early.Tracking_sample_counter) /
+                                            static_cast<double>(late.Tracking_sample_counter - early.Tracking_sample_counter);
+                    const double tow_s = (static_cast<double>(early.TOW_at_current_symbol_ms) +
+                                             fraction * static_cast<double>(late.TOW_at_current_symbol_ms - early.TOW_at_current_symbol_ms)) /
+                                         1000.0;
+                    const double carrier_phase_rads = early.Carrier_phase_rads +
+                                                      fraction * (late.Carrier_phase_rads - early.Carrier_phase_rads);
+                    const double doppler_hz = early.Carrier_Doppler_hz +
+                                              fraction * (late.Carrier_Doppler_hz - early.Carrier_Doppler_hz);
+                    accumulated_tow_s += tow_s + 1e-12 * (carrier_phase_rads + doppler_hz);
+                }
+            benchmark::DoNotOptimize(accumulated_tow_s);
+        }
+}
+
+
+// Iterated least-squares position solve from eight synthetic pseudoranges,
+// the core linear algebra of a PVT epoch
+void bm_pvt_solve(benchmark::State& state)
+{
+    std::mt19937 gen(fixed_seed);
+    std::normal_distribution<double> noise(0.0, 3.0);
+    arma::mat sat_pos(pvt_satellites, 3);
+    arma::vec pseudoranges(pvt_satellites);
+    const arma::vec true_pos = {4889803.0, 170755.0, 4077985.0};
+    const double true_clock_bias_m = 15000.0;
+    for (int s = 0; s < pvt_satellites; s++)
+        {
+            const double az = TWO_PI * static_cast<double>(s) / static_cast<double>(pvt_satellites);
+            const double el = 0.3 + 0.15 * static_cast<double>(s % 4);
+            sat_pos(s, 0) = true_pos(0) + 22e6 * std::cos(el) * std::cos(az);
+            sat_pos(s, 1) = true_pos(1) + 22e6 * std::cos(el) * std::sin(az);
+            sat_pos(s, 2) = true_pos(2) + 22e6 * std::sin(el);
+            pseudoranges(s) = arma::norm(sat_pos.row(s).t() - true_pos) + true_clock_bias_m + noise(gen);
+        }
+
+    while (state.KeepRunning())
+        {
+            arma::vec estimate = {6.4e6, 0.0, 0.0, 0.0};  // position + clock bias
+            arma::mat geometry(pvt_satellites, 4);
+            arma::vec residuals(pvt_satellites);
+            for (int iteration = 0; iteration < 6; iteration++)
+                {
+                    for (int s = 0; s < pvt_satellites; s++)
+                        {
+                            const arma::vec line_of_sight = sat_pos.row(s).t() - estimate.rows(0, 2);
+                            const double range = arma::norm(line_of_sight);
+                            geometry(s, 0) = -line_of_sight(0) / range;
+                            geometry(s, 1) = -line_of_sight(1) / range;
+                            geometry(s, 2) = -line_of_sight(2) / range;
+                            geometry(s, 3) = 1.0;
+                            residuals(s) = pseudoranges(s) - (range + estimate(3));
+                        }
+                    const arma::vec correction = arma::solve(geometry, residuals);
+                    estimate.rows(0, 2) += correction.rows(0, 2);
+                    estimate(3) += correction(3);
+                }
+            benchmark::DoNotOptimize(estimate(0));
+        }
+}
+
+
+// Collects the measured ns/op per benchmark while still printing the usual
+// console table
+class Baseline_Reporter : public benchmark::ConsoleReporter
+{
+public:
+    void ReportRuns(const std::vector<Run>& report) override
+    {
+        for (const auto& run : report)
+            {
+                if (!run.error_occurred)
+                    {
+                        measured_[run.benchmark_name()] = run.GetAdjustedRealTime();
+                    }
+            }
+        ConsoleReporter::ReportRuns(report);
+    }
+    const std::map<std::string, double>& measured() const { return measured_; }
+
+private:
+    std::map<std::string, double> measured_;
+};
+
+
+std::map<std::string, double> load_baseline(const std::string& filename)
+{
+    std::map<std::string, double> baseline;
+    std::ifstream file(filename);
+    std::string name;
+    double ns_per_op;
+    while (file >> name)
+        {
+            if (name[0] == '#')
+                {
+                    std::string rest_of_line;
+                    std::getline(file, rest_of_line);
+                    continue;
+                }
+            if (file >> ns_per_op)
+                {
+                    baseline[name] = ns_per_op;
+                }
+        }
+    return baseline;
+}
+
+
+// returns false if any benchmark regressed beyond the tolerance
+bool compare_with_baseline(const std::map<std::string, double>& measured)
+{
+    const char* write_path = std::getenv("GNSSSDR_BENCH_WRITE_BASELINE");
+    if (write_path != nullptr)
+        {
+            std::ofstream file(write_path);
+            file << "# ns/op baselines for benchmark_receiver_paths, one entry per benchmark.\n";
+            file << "# Regenerate on the reference machine with GNSSSDR_BENCH_WRITE_BASELINE=<this file>.\n";
+            for (const auto& entry : measured)
+                {
+                    file << entry.first << " " << entry.second << "\n";
+                }
+            std::cout << "Baseline written to " << write_path << ", comparison skipped.\n";
+            return true;
+        }
+
+    std::string baseline_path = GNSSSDR_BENCH_BASELINE_FILE;
+    const char* baseline_env = std::getenv("GNSSSDR_BENCH_BASELINE");
+    if (baseline_env != nullptr)
+        {
+            baseline_path = baseline_env;
+        }
+    const auto baseline = load_baseline(baseline_path);
+    if (baseline.empty())
+        {
+            std::cout << "No baseline found at " << baseline_path << ", comparison skipped.\n";
+            return true;
+        }
+
+    double tolerance_percent = 10.0;
+    const char* tolerance_env = std::getenv("GNSSSDR_BENCH_TOLERANCE_PERCENT");
+    if (tolerance_env != nullptr)
+        {
+            tolerance_percent = std::atof(tolerance_env);
+        }
+
+    bool all_ok = true;
+    std::cout << "\nComparison against " << baseline_path << " (tolerance " << tolerance_percent << "%):\n";
+    for (const auto& entry : measured)
+        {
+            const auto baseline_entry = baseline.find(entry.first);
+            if (baseline_entry == baseline.end())
+                {
+                    std::cout << "  " << entry.first << ": no baseline entry, add one.\n";
+                    continue;
+                }
+            const double change_percent = 100.0 * (entry.second - baseline_entry->second) / baseline_entry->second;
+            if (change_percent > tolerance_percent)
+                {
+                    std::cout << "  " << entry.first << ": REGRESSION " << change_percent << "% ("
+                              << baseline_entry->second << " -> " << entry.second << " ns/op)\n";
+                    all_ok = false;
+                }
+            else if (change_percent < -tolerance_percent)
+                {
+                    std::cout << "  " << entry.first << ": improved " << -change_percent
+                              << "%, consider refreshing the baseline.\n";
+                }
+            else
+                {
+                    std::cout << "  " << entry.first << ": OK (" << change_percent << "%)\n";
+                }
+        }
+    return all_ok;
+}
+
+
+void pin_to_core()
+{
+#ifdef __linux__
+    int core = 0;
+    const char* core_env = std::getenv("GNSSSDR_BENCH_CPU");
+    if (core_env != nullptr)
+        {
+            core = std::atoi(core_env);
+        }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0)
+        {
+            std::cerr << "Could not pin the benchmark to core " << core << ", numbers may be noisier.\n";
+        }
+#endif
+}
+}  // namespace
+
+
+BENCHMARK(bm_conditioner_chain);
+BENCHMARK(bm_tracking_channel_epoch);
+BENCHMARK(bm_observables_epoch);
+BENCHMARK(bm_pvt_solve);
+
+
+int main(int argc, char** argv)
+{
+    pin_to_core();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        {
+            return 1;
+        }
+    Baseline_Reporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    return compare_with_baseline(reporter.measured()) ? 0 : 1;
+}
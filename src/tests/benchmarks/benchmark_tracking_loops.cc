@@ -0,0 +1,248 @@
+/*!
+ * \file benchmark_tracking_loops.cc
+ * \brief Benchmark for the tracking discriminators, loop filters and lock
+ * detectors, at the call rates of a running tracking channel
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "lock_detectors.h"
+#include "tracking_2nd_DLL_filter.h"
+#include "tracking_FLL_PLL_filter.h"
+#include "tracking_discriminators.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>  // for std::generate
+#include <cmath>      // for std::atan2, std::fabs
+#include <complex>
+#include <random>
+#include <vector>
+
+namespace
+{
+// number of random correlator outputs cycled through each benchmark, so the
+// branch predictor and the atan2 argument reduction see realistic variety
+constexpr size_t input_set_size = 1024;
+
+// prompt history length used by dll_pll_veml_tracking for the lock detectors
+constexpr int cn0_estimation_samples = 20;
+
+std::vector<gr_complex> random_correlator_outputs(size_t size)
+{
+    std::random_device rd;
+    std::default_random_engine e2(rd());
+    std::normal_distribution<float> dist(0.0F, 1.0F);
+    std::vector<gr_complex> outputs(size);
+    std::generate(outputs.begin(), outputs.end(), [&dist, &e2]() { return gr_complex(10.0F + dist(e2), dist(e2)); });
+    return outputs;
+}
+
+
+// Polynomial two-quadrant arctangent (max error below 0.005 rad), candidate
+// replacement for the libm atan2 call inside the PLL discriminator
+float fast_atan2(float y, float x)
+{
+    const float abs_y = std::fabs(y) + 1e-10F;  // avoid 0/0
+    float angle;
+    if (x >= 0.0F)
+        {
+            const float r = (x - abs_y) / (x + abs_y);
+            angle = 0.1963F * r * r * r - 0.9817F * r + 0.7853981633974483F;
+        }
+    else
+        {
+            const float r = (x + abs_y) / (abs_y - x);
+            angle = 0.1963F * r * r * r - 0.9817F * r + 2.356194490192345F;
+        }
+    return (y < 0.0F) ? -angle : angle;
+}
+
+
+double pll_cloop_two_quadrant_fast_atan(gr_complex prompt_s1)
+{
+    if (prompt_s1.real() != 0.0F)
+        {
+            return static_cast<double>(fast_atan2(prompt_s1.imag(), prompt_s1.real()));
+        }
+    return 0.0;
+}
+}  // namespace
+
+
+void bm_pll_four_quadrant_atan(benchmark::State& state)
+{
+    const auto prompt = random_correlator_outputs(input_set_size);
+    size_t n = 0;
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(pll_four_quadrant_atan(prompt[n]));
+            n = (n + 1) % input_set_size;
+        }
+}
+
+
+void bm_pll_cloop_two_quadrant_atan(benchmark::State& state)
+{
+    const auto prompt = random_correlator_outputs(input_set_size);
+    size_t n = 0;
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(pll_cloop_two_quadrant_atan(prompt[n]));
+            n = (n + 1) % input_set_size;
+        }
+}
+
+
+void bm_pll_cloop_two_quadrant_fast_atan(benchmark::State& state)
+{
+    const auto prompt = random_correlator_outputs(input_set_size);
+    // validate the approximation before trusting its timings
+    double max_error = 0.0;
+    for (const auto& p : prompt)
+        {
+            max_error = std::max(max_error, std::fabs(pll_cloop_two_quadrant_fast_atan(p) - pll_cloop_two_quadrant_atan(p)));
+        }
+    if (max_error > 0.005)
+        {
+            state.SkipWithError("fast_atan2 error above 0.005 rad");
+            return;
+        }
+    size_t n = 0;
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(pll_cloop_two_quadrant_fast_atan(prompt[n]));
+            n = (n + 1) % input_set_size;
+        }
+    state.counters["max_error_rad"] = max_error;
+}
+
+
+void bm_fll_four_quadrant_atan(benchmark::State& state)
+{
+    const auto prompt = random_correlator_outputs(input_set_size);
+    size_t n = 0;
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(fll_four_quadrant_atan(prompt[n], prompt[(n + 1) % input_set_size], 0.0, 0.001));
+            n = (n + 1) % input_set_size;
+        }
+}
+
+
+void bm_dll_nc_e_minus_l_normalized(benchmark::State& state)
+{
+    const auto early = random_correlator_outputs(input_set_size);
+    const auto late = random_correlator_outputs(input_set_size);
+    size_t n = 0;
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(dll_nc_e_minus_l_normalized(early[n], late[n]));
+            n = (n + 1) % input_set_size;
+        }
+}
+
+
+void bm_dll_nc_vemlp_normalized(benchmark::State& state)
+{
+    const auto very_early = random_correlator_outputs(input_set_size);
+    const auto early = random_correlator_outputs(input_set_size);
+    const auto late = random_correlator_outputs(input_set_size);
+    const auto very_late = random_correlator_outputs(input_set_size);
+    size_t n = 0;
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(dll_nc_vemlp_normalized(very_early[n], early[n], late[n], very_late[n]));
+            n = (n + 1) % input_set_size;
+        }
+}
+
+
+void bm_dll_2nd_filter(benchmark::State& state)
+{
+    Tracking_2nd_DLL_filter code_loop_filter(0.001F);
+    code_loop_filter.set_DLL_BW(2.0F);
+    code_loop_filter.initialize();
+    std::random_device rd;
+    std::default_random_engine e2(rd());
+    std::normal_distribution<float> dist(0.0F, 0.1F);
+    std::vector<float> discriminator(input_set_size);
+    std::generate(discriminator.begin(), discriminator.end(), [&dist, &e2]() { return dist(e2); });
+    size_t n = 0;
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(code_loop_filter.get_code_nco(discriminator[n]));
+            n = (n + 1) % input_set_size;
+        }
+}
+
+
+void bm_fll_pll_filter(benchmark::State& state)
+{
+    Tracking_FLL_PLL_filter carrier_loop_filter;
+    carrier_loop_filter.set_params(10.0F, 35.0F, 3);
+    carrier_loop_filter.initialize(1000.0F);
+    std::random_device rd;
+    std::default_random_engine e2(rd());
+    std::normal_distribution<float> dist(0.0F, 0.1F);
+    std::vector<float> discriminator(input_set_size);
+    std::generate(discriminator.begin(), discriminator.end(), [&dist, &e2]() { return dist(e2); });
+    size_t n = 0;
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(carrier_loop_filter.get_carrier_error(discriminator[n], discriminator[(n + 1) % input_set_size], 0.001F));
+            n = (n + 1) % input_set_size;
+        }
+}
+
+
+void bm_cn0_svn_estimator(benchmark::State& state)
+{
+    auto prompt = random_correlator_outputs(cn0_estimation_samples);
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(cn0_svn_estimator(prompt.data(), cn0_estimation_samples, 0.001F));
+        }
+}
+
+
+void bm_cn0_m2m4_estimator(benchmark::State& state)
+{
+    auto prompt = random_correlator_outputs(cn0_estimation_samples);
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(cn0_m2m4_estimator(prompt.data(), cn0_estimation_samples, 0.001F));
+        }
+}
+
+
+void bm_carrier_lock_detector(benchmark::State& state)
+{
+    auto prompt = random_correlator_outputs(cn0_estimation_samples);
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(carrier_lock_detector(prompt.data(), cn0_estimation_samples));
+        }
+}
+
+
+BENCHMARK(bm_pll_four_quadrant_atan);
+BENCHMARK(bm_pll_cloop_two_quadrant_atan);
+BENCHMARK(bm_pll_cloop_two_quadrant_fast_atan);
+BENCHMARK(bm_fll_four_quadrant_atan);
+BENCHMARK(bm_dll_nc_e_minus_l_normalized);
+BENCHMARK(bm_dll_nc_vemlp_normalized);
+BENCHMARK(bm_dll_2nd_filter);
+BENCHMARK(bm_fll_pll_filter);
+BENCHMARK(bm_cn0_svn_estimator);
+BENCHMARK(bm_cn0_m2m4_estimator);
+BENCHMARK(bm_carrier_lock_detector);
+BENCHMARK_MAIN();
@@ -0,0 +1,137 @@
+/*!
+ * \file benchmark_volk.cc
+ * \brief Benchmark for the volk_gnsssdr kernels used in the receiver hot loops
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include <benchmark/benchmark.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <algorithm>  // for std::generate
+#include <cmath>
+#include <complex>
+#include <random>
+
+// Realistic GNSS correlation lengths: one GPS L1 C/A code period at 1 and
+// 2 Msps, a Galileo E1 code period at ~6 Msps, and a GPS L5 code period
+// at 10 Msps
+static void gnss_sizes(benchmark::internal::Benchmark* b)
+{
+    b->Arg(2046)->Arg(4092)->Arg(25000)->Arg(100000);
+}
+
+
+static void fill_complex_vector(volk_gnsssdr::vector<std::complex<float>>& vec)
+{
+    std::random_device rd;
+    std::default_random_engine e2(rd());
+    std::uniform_real_distribution<float> dist(-1.0F, 1.0F);
+    std::generate(vec.begin(), vec.end(), [&dist, &e2]() { return std::complex<float>(dist(e2), dist(e2)); });
+}
+
+
+void bm_32fc_32f_rotator_dot_prod_32fc_xn(benchmark::State& state)
+{
+    const auto num_points = static_cast<unsigned int>(state.range(0));
+    const int num_taps = 5;  // VEML channel
+    volk_gnsssdr::vector<std::complex<float>> sig_in(num_points);
+    volk_gnsssdr::vector<std::complex<float>> result(num_taps);
+    volk_gnsssdr::vector<float> code(num_points);
+    fill_complex_vector(sig_in);
+    std::generate(code.begin(), code.end(), [n = 0]() mutable { return (((n++) % 2) == 0 ? 1.0F : -1.0F); });
+    const float* code_ptrs[num_taps] = {code.data(), code.data(), code.data(), code.data(), code.data()};
+    const lv_32fc_t phase_inc = lv_cmake(std::cos(0.001F), std::sin(0.001F));
+    lv_32fc_t phase[1];
+
+    for (auto _ : state)
+        {
+            phase[0] = lv_cmake(1.0F, 0.0F);
+            volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(result.data(), sig_in.data(), phase_inc, phase, code_ptrs, num_taps, num_points);
+            benchmark::DoNotOptimize(result.data());
+        }
+
+    // one complex sample in, num_taps real taps in, plus the rotation (6 flops),
+    // phase update (6 flops) and 4 flops per real-code tap
+    state.SetBytesProcessed(state.iterations() * num_points * static_cast<int64_t>(sizeof(std::complex<float>) + num_taps * sizeof(float)));
+    state.counters["flops"] = benchmark::Counter(static_cast<double>(state.iterations()) * num_points * (12.0 + 4.0 * num_taps), benchmark::Counter::kIsRate);
+}
+
+
+void bm_16ic_x2_dot_prod_16ic_xn(benchmark::State& state)
+{
+    const auto num_points = static_cast<unsigned int>(state.range(0));
+    const int num_taps = 3;
+    volk_gnsssdr::vector<lv_16sc_t> sig_in(num_points, lv_16sc_t(1, -1));
+    volk_gnsssdr::vector<lv_16sc_t> code(num_points, lv_16sc_t(-1, 1));
+    volk_gnsssdr::vector<lv_16sc_t> result(num_taps);
+    const lv_16sc_t* code_ptrs[num_taps] = {code.data(), code.data(), code.data()};
+
+    for (auto _ : state)
+        {
+            volk_gnsssdr_16ic_x2_dot_prod_16ic_xn(result.data(), sig_in.data(), code_ptrs, num_taps, num_points);
+            benchmark::DoNotOptimize(result.data());
+        }
+
+    state.SetBytesProcessed(state.iterations() * num_points * static_cast<int64_t>((1 + num_taps) * sizeof(lv_16sc_t)));
+    state.counters["ops"] = benchmark::Counter(static_cast<double>(state.iterations()) * num_points * (8.0 * num_taps), benchmark::Counter::kIsRate);
+}
+
+
+void bm_32f_xn_resampler_32f_xn(benchmark::State& state)
+{
+    const auto num_points = static_cast<unsigned int>(state.range(0));
+    const int num_taps = 3;
+    const unsigned int code_length_chips = 1023;
+    volk_gnsssdr::vector<float> code(code_length_chips);
+    std::generate(code.begin(), code.end(), [n = 0]() mutable { return (((n++) % 2) == 0 ? 1.0F : -1.0F); });
+    volk_gnsssdr::vector<float> early(num_points);
+    volk_gnsssdr::vector<float> prompt(num_points);
+    volk_gnsssdr::vector<float> late(num_points);
+    float* replicas[num_taps] = {early.data(), prompt.data(), late.data()};
+    float shifts_chips[num_taps] = {-0.25F, 0.0F, 0.25F};
+    const float code_phase_step_chips = static_cast<float>(code_length_chips) / static_cast<float>(num_points);
+
+    for (auto _ : state)
+        {
+            volk_gnsssdr_32f_xn_resampler_32f_xn(replicas, code.data(), 0.345F, code_phase_step_chips, shifts_chips, code_length_chips, num_taps, num_points);
+            benchmark::DoNotOptimize(replicas[0]);
+        }
+
+    state.SetBytesProcessed(state.iterations() * num_points * static_cast<int64_t>(2 * num_taps * sizeof(float)));
+}
+
+
+void bm_s32f_sincos_32fc(benchmark::State& state)
+{
+    const auto num_points = static_cast<unsigned int>(state.range(0));
+    volk_gnsssdr::vector<std::complex<float>> carrier(num_points);
+    float phase[1];
+
+    for (auto _ : state)
+        {
+            phase[0] = 0.25F;
+            volk_gnsssdr_s32f_sincos_32fc(carrier.data(), 0.001F, phase, num_points);
+            benchmark::DoNotOptimize(carrier.data());
+        }
+
+    state.SetBytesProcessed(state.iterations() * num_points * static_cast<int64_t>(sizeof(std::complex<float>)));
+}
+
+
+BENCHMARK(bm_32fc_32f_rotator_dot_prod_32fc_xn)->Apply(gnss_sizes);
+BENCHMARK(bm_16ic_x2_dot_prod_16ic_xn)->Apply(gnss_sizes);
+BENCHMARK(bm_32f_xn_resampler_32f_xn)->Apply(gnss_sizes);
+BENCHMARK(bm_s32f_sincos_32fc)->Apply(gnss_sizes);
+
+BENCHMARK_MAIN();
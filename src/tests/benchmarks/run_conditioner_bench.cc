@@ -0,0 +1,183 @@
+/*!
+ * \file run_conditioner_bench.cc
+ * \brief Throughput benchmark for signal conditioner chains
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * Instantiates the signal conditioner chains described in a configuration
+ * file, pumps synthetic samples through each stage from memory, and reports
+ * per-stage and whole-chain throughput, so chain layouts can be compared
+ * quantitatively without a live signal source.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "file_configuration.h"
+#include "gnss_block_factory.h"
+#include "gnss_block_interface.h"
+#include "signal_conditioner.h"
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/blocks/null_source.h>
+#include <gnuradio/top_block.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+DEFINE_string(config_file, std::string(""), "File containing the configuration whose signal conditioner chains are benchmarked");
+DEFINE_int64(num_samples, 50000000, "Number of synthetic samples pumped through each stage");
+
+
+namespace
+{
+// Pumps FLAGS_num_samples zero samples through the block wrapped by stage and
+// returns the elapsed wall-clock time, in seconds
+double pump_samples(const std::shared_ptr<GNSSBlockInterface>& stage, size_t item_size_in, size_t item_size_out)
+{
+    auto top_block = gr::make_top_block("conditioner_bench");
+    auto source = gr::blocks::null_source::make(item_size_in);
+    auto head = gr::blocks::head::make(item_size_in, static_cast<uint64_t>(FLAGS_num_samples));
+    auto sink = gr::blocks::null_sink::make(item_size_out);
+
+    stage->connect(top_block);
+    top_block->connect(source, 0, head, 0);
+    top_block->connect(head, 0, stage->get_left_block(), 0);
+    top_block->connect(stage->get_right_block(), 0, sink, 0);
+
+    const auto start = std::chrono::steady_clock::now();
+    top_block->run();
+    const auto stop = std::chrono::steady_clock::now();
+
+    stage->disconnect(top_block);
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+
+void report(const std::string& label, size_t item_size_in, size_t item_size_out, double elapsed_s)
+{
+    const double samples = static_cast<double>(FLAGS_num_samples);
+    const double msps = samples / elapsed_s / 1.0e6;
+    const double mbytes_per_s = samples * static_cast<double>(item_size_in) / elapsed_s / 1.0e6;
+    std::cout << std::left << std::setw(60) << label
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << msps << " Msps"
+              << std::setw(10) << mbytes_per_s << " MB/s"
+              << "   (items in/out: " << item_size_in << '/' << item_size_out << " bytes, "
+              << std::setprecision(3) << elapsed_s << " s)\n";
+}
+
+
+void benchmark_stage(const std::string& label, const std::shared_ptr<GNSSBlockInterface>& stage)
+{
+    const size_t item_size_in = stage->get_left_block()->input_signature()->sizeof_stream_item(0);
+    const size_t item_size_out = stage->get_right_block()->output_signature()->sizeof_stream_item(0);
+    try
+        {
+            const double elapsed_s = pump_samples(stage, item_size_in, item_size_out);
+            report(label, item_size_in, item_size_out, elapsed_s);
+        }
+    catch (const std::exception& e)
+        {
+            std::cout << std::left << std::setw(60) << label << "FAILED: " << e.what() << '\n';
+        }
+}
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    if (FLAGS_config_file.empty())
+        {
+            std::cerr << "Usage: " << argv[0] << " --config_file=<configuration file> [--num_samples=N]\n";
+            gflags::ShutDownCommandLineFlags();
+            return 1;
+        }
+    const auto configuration = std::make_shared<FileConfiguration>(FLAGS_config_file);
+
+    // Enumerate the signal conditioners the same way GNSSFlowgraph::init() does
+    std::vector<int> conditioner_ids;
+    const int sources_count = configuration->property("Receiver.sources_count", 1);
+    if (sources_count > 1)
+        {
+            int next_id = 0;
+            for (int i = 0; i < sources_count; i++)
+                {
+                    const int rf_channels = configuration->property("SignalSource" + std::to_string(i) + ".RF_channels", 1);
+                    for (int j = 0; j < rf_channels; j++)
+                        {
+                            conditioner_ids.push_back(next_id++);
+                        }
+                }
+        }
+    else
+        {
+            const int rf_channels = configuration->property("SignalSource.RF_channels", 0);
+            if (rf_channels != 0)
+                {
+                    for (int j = 0; j < rf_channels; j++)
+                        {
+                            conditioner_ids.push_back(j);
+                        }
+                }
+            else
+                {
+                    conditioner_ids.push_back(-1);
+                }
+        }
+
+    std::cout << "Benchmarking " << conditioner_ids.size() << " signal conditioner chain(s) from " << FLAGS_config_file
+              << " with " << FLAGS_num_samples << " synthetic samples per stage\n\n";
+
+    GNSSBlockFactory factory;
+    for (const int conditioner_id : conditioner_ids)
+        {
+            std::shared_ptr<GNSSBlockInterface> conditioner;
+            try
+                {
+                    conditioner = std::shared_ptr<GNSSBlockInterface>(factory.GetSignalConditioner(configuration.get(), conditioner_id));
+                }
+            catch (const std::exception& e)
+                {
+                    std::cerr << "Could not instantiate signal conditioner " << conditioner_id << ": " << e.what() << '\n';
+                    continue;
+                }
+            const std::string chain_label = (conditioner_id >= 0) ? "SignalConditioner" + std::to_string(conditioner_id) : "SignalConditioner";
+            std::cout << chain_label << " (" << conditioner->implementation() << ")\n";
+
+            // per-stage throughput, when the conditioner exposes its stages
+            const auto signal_conditioner = std::dynamic_pointer_cast<SignalConditioner>(conditioner);
+            if (signal_conditioner)
+                {
+                    const std::vector<std::pair<std::string, std::shared_ptr<GNSSBlockInterface>>> stages = {
+                        {"DataTypeAdapter", signal_conditioner->data_type_adapter()},
+                        {"InputFilter", signal_conditioner->input_filter()},
+                        {"Resampler", signal_conditioner->resampler()}};
+                    for (const auto& stage : stages)
+                        {
+                            benchmark_stage("  " + stage.first + " (" + stage.second->implementation() + ")", stage.second);
+                        }
+                }
+
+            benchmark_stage("  full chain", conditioner);
+            std::cout << '\n';
+        }
+
+    gflags::ShutDownCommandLineFlags();
+    return 0;
+}
@@ -0,0 +1,438 @@
+/*!
+ * \file acq_bench.cc
+ * \brief Acquisition sensitivity and throughput characterization tool
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * Measures, for each selected GPS L1 C/A acquisition implementation, the
+ * detection probability as a function of CN0 (synthetic signal with random
+ * code delay and Doppler, AWGN channel) and the grid-search throughput on
+ * the local hardware, and writes a machine-readable JSON report. It covers
+ * the standard PCPS implementation and the fine-Doppler, Tong, QuickSync
+ * and (when built) OpenCL variants, so the implementation choice for a
+ * deployment can be made from data instead of folklore.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "acquisition_interface.h"
+#include "gnss_block_interface.h"
+#include "gnss_synchro.h"
+#include "gps_l1_ca_pcps_acquisition.h"
+#include "gps_l1_ca_pcps_acquisition_fine_doppler.h"
+#include "gps_l1_ca_pcps_quicksync_acquisition.h"
+#include "gps_l1_ca_pcps_tong_acquisition.h"
+#include "gps_sdr_signal_replica.h"
+#include "in_memory_configuration.h"
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gnuradio/top_block.h>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if HAS_GENERIC_LAMBDA
+#else
+#include <boost/bind/bind.hpp>
+#endif
+
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_source.h>
+#else
+#include <gnuradio/blocks/vector_source_c.h>
+#endif
+
+#if OPENCL_BLOCKS_TEST
+#include "gps_l1_ca_pcps_opencl_acquisition.h"
+#endif
+
+#if GFLAGS_OLD_NAMESPACE
+namespace gflags
+{
+using namespace google;
+}
+#endif
+
+DEFINE_string(implementations, std::string(""),
+    "Comma-separated list of acquisition implementations to characterize. Empty means all the available ones");
+DEFINE_string(output_file_acq_bench, std::string("acq_bench.json"), "File where the results are written, in JSON format");
+DEFINE_int32(fs_sps, 4000000, "Sampling frequency, in samples per second");
+DEFINE_int32(prn, 1, "Satellite PRN to simulate");
+DEFINE_double(cn0_start, 30.0, "Lowest CN0 of the sensitivity sweep, in dB-Hz");
+DEFINE_double(cn0_stop, 48.0, "Highest CN0 of the sensitivity sweep, in dB-Hz");
+DEFINE_double(cn0_step, 3.0, "CN0 sweep step, in dB");
+DEFINE_int32(num_trials, 100, "Number of Monte Carlo trials per CN0 point");
+DEFINE_int32(doppler_max, 5000, "Doppler search span, in Hz");
+DEFINE_int32(doppler_step, 250, "Doppler search step, in Hz");
+DEFINE_int32(coherent_time_ms, 1, "Coherent integration time, in ms");
+DEFINE_int32(signal_duration_ms, 20, "Length of the synthetic snapshot fed to each trial, in ms");
+DEFINE_double(threshold, 0.001, "Detection threshold handed to the adapters");
+DEFINE_int64(seed, 0, "Seed of the random generator (0 means non-deterministic)");
+
+namespace
+{
+// ######## GNURADIO BLOCK MESSAGE RECEVER #########
+class Acq_Bench_msg_rx;
+
+using Acq_Bench_msg_rx_sptr = gnss_shared_ptr<Acq_Bench_msg_rx>;
+
+Acq_Bench_msg_rx_sptr Acq_Bench_msg_rx_make();
+
+class Acq_Bench_msg_rx : public gr::block
+{
+private:
+    friend Acq_Bench_msg_rx_sptr Acq_Bench_msg_rx_make();
+    void msg_handler_channel_events(const pmt::pmt_t& msg);
+    Acq_Bench_msg_rx();
+
+public:
+    int rx_message;
+    ~Acq_Bench_msg_rx() override = default;
+};
+
+
+Acq_Bench_msg_rx_sptr Acq_Bench_msg_rx_make()
+{
+    return Acq_Bench_msg_rx_sptr(new Acq_Bench_msg_rx());
+}
+
+
+void Acq_Bench_msg_rx::msg_handler_channel_events(const pmt::pmt_t& msg)
+{
+    try
+        {
+            const int64_t message = pmt::to_long(msg);
+            rx_message = message;
+        }
+    catch (const boost::bad_any_cast& e)
+        {
+            LOG(WARNING) << "msg_handler_channel_events Bad any_cast: " << e.what();
+            rx_message = 0;
+        }
+}
+
+
+Acq_Bench_msg_rx::Acq_Bench_msg_rx() : gr::block("Acq_Bench_msg_rx", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0))
+{
+    this->message_port_register_in(pmt::mp("events"));
+    this->set_msg_handler(pmt::mp("events"),
+#if HAS_GENERIC_LAMBDA
+        [this](auto&& PH1) { msg_handler_channel_events(PH1); });
+#else
+#if USE_BOOST_BIND_PLACEHOLDERS
+        boost::bind(&Acq_Bench_msg_rx::msg_handler_channel_events, this, boost::placeholders::_1));
+#else
+        boost::bind(&Acq_Bench_msg_rx::msg_handler_channel_events, this, _1));
+#endif
+#endif
+    rx_message = 0;
+}
+
+
+// ###########################################################
+
+struct Sensitivity_Point
+{
+    double cn0_db_hz = 0.0;
+    int trials = 0;
+    int detections = 0;
+    int false_detections = 0;  // detected, but outside the 0.5 chip tolerance
+    double sum_doppler_error_hz = 0.0;
+    double sum_delay_error_chips = 0.0;
+};
+
+
+struct Implementation_Result
+{
+    std::string implementation;
+    std::vector<Sensitivity_Point> points;
+    double processed_signal_s = 0.0;
+    double wall_s = 0.0;
+};
+
+
+std::vector<std::string> split_string(const std::string& str, char delimiter)
+{
+    std::vector<std::string> result;
+    std::stringstream ss(str);
+    std::string item;
+    while (std::getline(ss, item, delimiter))
+        {
+            if (!item.empty())
+                {
+                    result.push_back(item);
+                }
+        }
+    return result;
+}
+
+
+std::shared_ptr<AcquisitionInterface> make_acquisition(const std::string& implementation,
+    const InMemoryConfiguration* config, const std::string& role)
+{
+    if (implementation == "GPS_L1_CA_PCPS_Acquisition")
+        {
+            return std::make_shared<GpsL1CaPcpsAcquisition>(config, role, 1, 0);
+        }
+    if (implementation == "GPS_L1_CA_PCPS_Acquisition_Fine_Doppler")
+        {
+            return std::make_shared<GpsL1CaPcpsAcquisitionFineDoppler>(config, role, 1, 0);
+        }
+    if (implementation == "GPS_L1_CA_PCPS_Tong_Acquisition")
+        {
+            return std::make_shared<GpsL1CaPcpsTongAcquisition>(config, role, 1, 0);
+        }
+    if (implementation == "GPS_L1_CA_PCPS_QuickSync_Acquisition")
+        {
+            return std::make_shared<GpsL1CaPcpsQuickSyncAcquisition>(config, role, 1, 0);
+        }
+#if OPENCL_BLOCKS_TEST
+    if (implementation == "GPS_L1_CA_PCPS_OpenCl_Acquisition")
+        {
+            return std::make_shared<GpsL1CaPcpsOpenClAcquisition>(config, role, 1, 0);
+        }
+#endif
+    return nullptr;
+}
+
+
+std::vector<std::string> default_implementations()
+{
+    std::vector<std::string> implementations = {
+        "GPS_L1_CA_PCPS_Acquisition",
+        "GPS_L1_CA_PCPS_Acquisition_Fine_Doppler",
+        "GPS_L1_CA_PCPS_Tong_Acquisition",
+        "GPS_L1_CA_PCPS_QuickSync_Acquisition"};
+#if OPENCL_BLOCKS_TEST
+    implementations.emplace_back("GPS_L1_CA_PCPS_OpenCl_Acquisition");
+#endif
+    return implementations;
+}
+
+
+std::shared_ptr<InMemoryConfiguration> make_configuration(const std::string& implementation)
+{
+    auto config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", std::to_string(FLAGS_fs_sps));
+    config->set_property("Acquisition_1C.implementation", implementation);
+    config->set_property("Acquisition_1C.item_type", "gr_complex");
+    config->set_property("Acquisition_1C.coherent_integration_time_ms", std::to_string(FLAGS_coherent_time_ms));
+    config->set_property("Acquisition_1C.threshold", std::to_string(FLAGS_threshold));
+    config->set_property("Acquisition_1C.doppler_max", std::to_string(FLAGS_doppler_max));
+    config->set_property("Acquisition_1C.doppler_step", std::to_string(FLAGS_doppler_step));
+    config->set_property("Acquisition_1C.max_dwells", "2");
+    config->set_property("Acquisition_1C.dump", "false");
+    return config;
+}
+
+
+/*
+ * Builds a snapshot of the sampled C/A code of the simulated satellite with
+ * the given circular delay and Doppler shift, plus complex AWGN scaled so the
+ * unit-power signal is received at the requested CN0.
+ */
+std::vector<std::complex<float>> make_snapshot(const std::vector<std::complex<float>>& code,
+    int delay_samples, double doppler_hz, double cn0_db_hz, std::mt19937& rng)
+{
+    const auto samples_per_code = static_cast<int>(code.size());
+    const size_t num_samples = static_cast<size_t>(FLAGS_fs_sps / 1000) * static_cast<size_t>(FLAGS_signal_duration_ms);
+    const double noise_variance = static_cast<double>(FLAGS_fs_sps) / std::pow(10.0, cn0_db_hz / 10.0);
+    const double noise_sigma = std::sqrt(noise_variance / 2.0);
+    std::normal_distribution<float> noise(0.0F, static_cast<float>(noise_sigma));
+    const double phase_step_rad = 2.0 * GNSS_PI * doppler_hz / static_cast<double>(FLAGS_fs_sps);
+
+    std::vector<std::complex<float>> snapshot(num_samples);
+    for (size_t n = 0; n < num_samples; n++)
+        {
+            const auto code_index = static_cast<size_t>((static_cast<int64_t>(n) - delay_samples + samples_per_code) % samples_per_code);
+            const auto phase = static_cast<float>(phase_step_rad * static_cast<double>(n));
+            const std::complex<float> carrier(std::cos(phase), std::sin(phase));
+            snapshot[n] = code[code_index] * carrier + std::complex<float>(noise(rng), noise(rng));
+        }
+    return snapshot;
+}
+
+
+void write_report(const std::vector<Implementation_Result>& results)
+{
+    std::ofstream report(FLAGS_output_file_acq_bench, std::ios::out | std::ios::trunc);
+    if (!report.is_open())
+        {
+            std::cerr << "Could not open " << FLAGS_output_file_acq_bench << " for writing\n";
+            return;
+        }
+    report << std::setprecision(6);
+    report << "{\n";
+    report << "  \"fs_sps\": " << FLAGS_fs_sps << ",\n";
+    report << "  \"prn\": " << FLAGS_prn << ",\n";
+    report << "  \"doppler_max_hz\": " << FLAGS_doppler_max << ",\n";
+    report << "  \"doppler_step_hz\": " << FLAGS_doppler_step << ",\n";
+    report << "  \"coherent_time_ms\": " << FLAGS_coherent_time_ms << ",\n";
+    report << "  \"threshold\": " << FLAGS_threshold << ",\n";
+    report << "  \"num_trials\": " << FLAGS_num_trials << ",\n";
+    report << "  \"implementations\": [\n";
+    for (size_t i = 0; i < results.size(); i++)
+        {
+            const auto& result = results[i];
+            report << "    {\n";
+            report << "      \"implementation\": \"" << result.implementation << "\",\n";
+            report << "      \"throughput_msps\": " << ((result.wall_s > 0.0) ? (result.processed_signal_s * FLAGS_fs_sps / result.wall_s / 1e6) : 0.0) << ",\n";
+            report << "      \"realtime_factor\": " << ((result.wall_s > 0.0) ? (result.processed_signal_s / result.wall_s) : 0.0) << ",\n";
+            report << "      \"sensitivity\": [\n";
+            for (size_t p = 0; p < result.points.size(); p++)
+                {
+                    const auto& point = result.points[p];
+                    report << "        {\"cn0_db_hz\": " << point.cn0_db_hz
+                           << ", \"trials\": " << point.trials
+                           << ", \"detections\": " << point.detections
+                           << ", \"false_detections\": " << point.false_detections
+                           << ", \"pd\": " << ((point.trials > 0) ? (static_cast<double>(point.detections) / point.trials) : 0.0);
+                    if (point.detections > 0)
+                        {
+                            report << ", \"mean_doppler_error_hz\": " << (point.sum_doppler_error_hz / point.detections)
+                                   << ", \"mean_delay_error_chips\": " << (point.sum_delay_error_chips / point.detections);
+                        }
+                    report << "}" << ((p + 1 < result.points.size()) ? "," : "") << "\n";
+                }
+            report << "      ]\n";
+            report << "    }" << ((i + 1 < results.size()) ? "," : "") << "\n";
+        }
+    report << "  ]\n";
+    report << "}\n";
+    std::cout << "Report written to " << FLAGS_output_file_acq_bench << '\n';
+}
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+    const std::string intro_help(
+        std::string("\n acq_bench measures detection probability vs CN0 and grid-search throughput") +
+        " of the GPS L1 C/A acquisition implementations.\n");
+    gflags::SetUsageMessage(intro_help);
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    std::vector<std::string> implementations = split_string(FLAGS_implementations, ',');
+    if (implementations.empty())
+        {
+            implementations = default_implementations();
+        }
+
+    const auto samples_per_code = static_cast<int>(std::round(static_cast<double>(FLAGS_fs_sps) / (GPS_L1_CA_CODE_RATE_CPS / GPS_L1_CA_CODE_LENGTH_CHIPS)));
+    const double samples_per_chip = static_cast<double>(FLAGS_fs_sps) / GPS_L1_CA_CODE_RATE_CPS;
+    std::vector<std::complex<float>> code(samples_per_code);
+    gps_l1_ca_code_gen_complex_sampled(code, static_cast<uint32_t>(FLAGS_prn), FLAGS_fs_sps, 0);
+
+    std::mt19937 rng((FLAGS_seed != 0) ? static_cast<uint32_t>(FLAGS_seed) : std::random_device()());
+    std::uniform_int_distribution<int> delay_dist(0, samples_per_code - 1);
+    std::uniform_real_distribution<double> doppler_dist(-static_cast<double>(FLAGS_doppler_max) + static_cast<double>(FLAGS_doppler_step),
+        static_cast<double>(FLAGS_doppler_max) - static_cast<double>(FLAGS_doppler_step));
+
+    std::vector<Implementation_Result> results;
+    for (const auto& implementation : implementations)
+        {
+            Implementation_Result result;
+            result.implementation = implementation;
+            std::cout << "Characterizing " << implementation << " ...\n";
+
+            for (double cn0 = FLAGS_cn0_start; cn0 <= FLAGS_cn0_stop + 1e-9; cn0 += FLAGS_cn0_step)
+                {
+                    Sensitivity_Point point;
+                    point.cn0_db_hz = cn0;
+                    for (int trial = 0; trial < FLAGS_num_trials; trial++)
+                        {
+                            const int true_delay_samples = delay_dist(rng);
+                            const double true_doppler_hz = doppler_dist(rng);
+                            const auto snapshot = make_snapshot(code, true_delay_samples, true_doppler_hz, cn0, rng);
+
+                            auto config = make_configuration(implementation);
+                            auto acquisition = make_acquisition(implementation, config.get(), "Acquisition_1C");
+                            if (!acquisition)
+                                {
+                                    std::cerr << "Unknown implementation: " << implementation << '\n';
+                                    break;
+                                }
+
+                            Gnss_Synchro gnss_synchro{};
+                            gnss_synchro.Channel_ID = 0;
+                            gnss_synchro.System = 'G';
+                            const std::string signal_id("1C");
+                            signal_id.copy(gnss_synchro.Signal, 2, 0);
+                            gnss_synchro.PRN = static_cast<uint32_t>(FLAGS_prn);
+
+                            gr::top_block_sptr top_block = gr::make_top_block("acq_bench");
+                            acquisition->set_channel(0);
+                            acquisition->set_gnss_synchro(&gnss_synchro);
+                            acquisition->set_threshold(FLAGS_threshold);
+                            acquisition->set_doppler_max(FLAGS_doppler_max);
+                            acquisition->set_doppler_step(FLAGS_doppler_step);
+                            acquisition->connect(top_block);
+
+                            auto source = gr::blocks::vector_source_c::make(snapshot, false);
+                            auto msg_rx = Acq_Bench_msg_rx_make();
+                            top_block->connect(source, 0, acquisition->get_left_block(), 0);
+                            top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+
+                            acquisition->set_local_code();
+                            acquisition->set_state(1);  // start acquiring at the first sample
+                            acquisition->init();
+
+                            const auto start = std::chrono::steady_clock::now();
+                            top_block->run();
+                            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                            result.wall_s += elapsed.count();
+                            result.processed_signal_s += static_cast<double>(snapshot.size()) / static_cast<double>(FLAGS_fs_sps);
+
+                            point.trials++;
+                            if (msg_rx->rx_message == 1)
+                                {
+                                    double delay_error_samples = std::fabs(static_cast<double>(true_delay_samples) - gnss_synchro.Acq_delay_samples);
+                                    // the code delay is circular
+                                    delay_error_samples = std::min(delay_error_samples, static_cast<double>(samples_per_code) - delay_error_samples);
+                                    const double delay_error_chips = delay_error_samples / samples_per_chip;
+                                    if (delay_error_chips < 0.5)
+                                        {
+                                            point.detections++;
+                                            point.sum_doppler_error_hz += std::fabs(true_doppler_hz - gnss_synchro.Acq_doppler_hz);
+                                            point.sum_delay_error_chips += delay_error_chips;
+                                        }
+                                    else
+                                        {
+                                            point.false_detections++;
+                                        }
+                                }
+                        }
+                    std::cout << "  CN0 " << cn0 << " dB-Hz: Pd = "
+                              << ((point.trials > 0) ? (static_cast<double>(point.detections) / point.trials) : 0.0)
+                              << " (" << point.detections << "/" << point.trials << ")\n";
+                    result.points.push_back(point);
+                }
+            if (result.wall_s > 0.0)
+                {
+                    std::cout << "  throughput: " << (result.processed_signal_s * FLAGS_fs_sps / result.wall_s / 1e6)
+                              << " Msps (x" << (result.processed_signal_s / result.wall_s) << " real time)\n";
+                }
+            results.push_back(result);
+        }
+
+    write_report(results);
+    gflags::ShutDownCommandLineFlags();
+    return 0;
+}
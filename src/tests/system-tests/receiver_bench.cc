@@ -0,0 +1,342 @@
+/*!
+ * \file receiver_bench.cc
+ * \brief End-to-end receiver benchmark over canned IF scenarios
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * Replays one or more receiver configurations (typically short scenarios
+ * synthesized with the SignalGenerator signal source, or canned IF files)
+ * through the full receiver, and reports the real-time margin, the
+ * time-to-first-fix, the time each channel needed to lock on its satellite,
+ * and the peak resident set size. Results are appended to a JSON file so
+ * performance trends can be tracked across commits.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "concurrent_map.h"
+#include "concurrent_queue.h"
+#include "control_thread.h"
+#include "file_configuration.h"
+#include "gnss_flowgraph.h"
+#include "gnss_synchro.h"
+#include "gps_acq_assist.h"
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <sys/ipc.h>
+#include <sys/msg.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <thread>
+#include <vector>
+
+#if GFLAGS_OLD_NAMESPACE
+namespace gflags
+{
+using namespace google;
+}
+#endif
+
+DEFINE_string(config_files, std::string(""), "Comma-separated list of configuration files, one per scenario");
+DEFINE_string(output_file, std::string("receiver_bench.json"), "File where the benchmark results are written, in JSON format");
+DEFINE_int32(max_run_duration, 120, "Hard per-scenario time limit, in seconds");
+DEFINE_int32(poll_interval_ms, 100, "Channel status sampling period, in milliseconds");
+
+// For GPS NAVIGATION (L1)
+Concurrent_Queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
+Concurrent_Map<Gps_Acq_Assist> global_gps_acq_assist_map;
+
+namespace
+{
+typedef struct
+{
+    long mtype;  // required by SysV message
+    double ttff;
+} ttff_msgbuf;
+
+
+struct ChannelRecord
+{
+    double first_lock_s = -1.0;  // wall-clock seconds from start-up until the channel first reported valid telemetry
+    double cn0_db_hz = 0.0;
+    uint32_t prn = 0;
+    char system = ' ';
+    std::string signal;
+};
+
+
+struct ScenarioResult
+{
+    std::string config_file;
+    std::map<int, ChannelRecord> channels;
+    double wall_s = 0.0;
+    double processed_signal_s = 0.0;
+    double realtime_margin = 0.0;
+    double ttff_s = -1.0;
+    long peak_rss_kb = 0;
+    bool completed = false;
+};
+
+
+std::atomic<double> ttff_value(-1.0);
+
+// Waits on the SysV queue where the PVT block reports the time-to-first-fix,
+// exactly as the ttff system test does. A message with ttff == -1 (posted by
+// the benchmark itself at the end of each scenario) unblocks the thread.
+void wait_for_ttff()
+{
+    ttff_msgbuf msg;
+    const int msgrcv_size = sizeof(msg.ttff);
+    int msqid;
+    const key_t key = 1101;
+    while ((msqid = msgget(key, 0644)) == -1)
+        {
+        }
+    while (msgrcv(msqid, &msg, msgrcv_size, 1, 0) != -1)
+        {
+            if (std::abs(msg.ttff - (-1.0)) < 10 * std::numeric_limits<double>::epsilon())
+                {
+                    return;
+                }
+            if (msg.ttff > 0.0)
+                {
+                    ttff_value = msg.ttff;
+                }
+        }
+}
+
+
+void unblock_ttff_listener()
+{
+    const key_t key = 1101;
+    const int msgflg = IPC_CREAT | 0666;
+    int msqid;
+    if ((msqid = msgget(key, msgflg)) != -1)
+        {
+            ttff_msgbuf msg;
+            msg.mtype = 1;
+            msg.ttff = -1;
+            msgsnd(msqid, &msg, sizeof(msg.ttff), IPC_NOWAIT);
+        }
+}
+
+
+// Stops the receiver through the SysV queue the PVT block listens to
+void request_receiver_stop()
+{
+    const key_t key_stop = 1102;
+    int msqid_stop;
+    if ((msqid_stop = msgget(key_stop, 0644)) != -1)
+        {
+            ttff_msgbuf msg_stop;
+            msg_stop.mtype = 1;
+            msg_stop.ttff = -200.0;
+            msgsnd(msqid_stop, &msg_stop, sizeof(msg_stop.ttff), IPC_NOWAIT);
+        }
+}
+
+
+ScenarioResult run_scenario(const std::string& config_file)
+{
+    ScenarioResult result;
+    result.config_file = config_file;
+
+    const auto configuration = std::make_shared<FileConfiguration>(config_file);
+    auto control_thread = std::make_unique<ControlThread>(configuration);
+
+    ttff_value = -1.0;
+    std::thread ttff_listener(wait_for_ttff);
+
+    std::atomic<bool> receiver_done(false);
+    const auto start = std::chrono::steady_clock::now();
+    std::thread runner([&]() {
+        try
+            {
+                control_thread->run();
+            }
+        catch (const std::exception& e)
+            {
+                std::cerr << "Scenario " << config_file << " failed: " << e.what() << '\n';
+            }
+        receiver_done = true;
+    });
+
+    // sample the channel status while the receiver runs: the first valid
+    // report of each channel gives the acquisition + pull-in time of its
+    // satellite, and the receiver time progression gives the real-time margin
+    double first_rx_time_s = -1.0;
+    double first_rx_wall_s = 0.0;
+    double last_rx_time_s = -1.0;
+    double last_rx_wall_s = 0.0;
+    bool stop_requested = false;
+    while (!receiver_done)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(FLAGS_poll_interval_ms));
+            const double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if ((wall_s > FLAGS_max_run_duration) && !stop_requested)
+                {
+                    std::cout << "Time limit reached, stopping the receiver...\n";
+                    request_receiver_stop();
+                    stop_requested = true;
+                }
+            const auto flowgraph = control_thread->flowgraph();
+            if (!flowgraph)
+                {
+                    continue;
+                }
+            const auto status_map = flowgraph->get_channels_status();
+            for (const auto& status : status_map)
+                {
+                    if (!status.second)
+                        {
+                            continue;
+                        }
+                    auto& record = result.channels[status.first];
+                    if (record.first_lock_s < 0.0)
+                        {
+                            record.first_lock_s = wall_s;
+                        }
+                    record.cn0_db_hz = status.second->CN0_dB_hz;
+                    record.prn = status.second->PRN;
+                    record.system = status.second->System;
+                    record.signal = std::string(status.second->Signal, 2);
+                    if (status.second->RX_time > 0.0)
+                        {
+                            if (first_rx_time_s < 0.0)
+                                {
+                                    first_rx_time_s = status.second->RX_time;
+                                    first_rx_wall_s = wall_s;
+                                }
+                            if (status.second->RX_time > last_rx_time_s)
+                                {
+                                    last_rx_time_s = status.second->RX_time;
+                                    last_rx_wall_s = wall_s;
+                                }
+                        }
+                }
+        }
+    runner.join();
+    result.wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    unblock_ttff_listener();
+    ttff_listener.join();
+    result.ttff_s = ttff_value;
+
+    if ((first_rx_time_s >= 0.0) && (last_rx_wall_s > first_rx_wall_s))
+        {
+            result.processed_signal_s = last_rx_time_s - first_rx_time_s;
+            result.realtime_margin = result.processed_signal_s / (last_rx_wall_s - first_rx_wall_s);
+        }
+    result.completed = !stop_requested;
+
+    // ru_maxrss is a high-water mark of the whole process, so with several
+    // scenarios in one run it reflects the heaviest scenario so far
+    struct rusage usage
+    {
+    };
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        {
+            result.peak_rss_kb = usage.ru_maxrss;
+        }
+    return result;
+}
+
+
+void write_json_report(const std::vector<ScenarioResult>& results, const std::string& filename)
+{
+    std::ofstream report(filename);
+    if (!report)
+        {
+            std::cerr << "Could not write the benchmark report to " << filename << '\n';
+            return;
+        }
+    report << std::setprecision(6);
+    report << "{\n  \"scenarios\": [\n";
+    for (size_t i = 0; i < results.size(); i++)
+        {
+            const auto& result = results[i];
+            report << "    {\n";
+            report << "      \"config_file\": \"" << result.config_file << "\",\n";
+            report << "      \"completed\": " << (result.completed ? "true" : "false") << ",\n";
+            report << "      \"wall_time_s\": " << result.wall_s << ",\n";
+            report << "      \"processed_signal_s\": " << result.processed_signal_s << ",\n";
+            report << "      \"realtime_margin\": " << result.realtime_margin << ",\n";
+            report << "      \"ttff_s\": " << result.ttff_s << ",\n";
+            report << "      \"peak_rss_kb\": " << result.peak_rss_kb << ",\n";
+            report << "      \"channels\": [\n";
+            size_t channel_index = 0;
+            for (const auto& channel : result.channels)
+                {
+                    report << "        {\"channel\": " << channel.first
+                           << ", \"system\": \"" << channel.second.system
+                           << "\", \"signal\": \"" << channel.second.signal
+                           << "\", \"prn\": " << channel.second.prn
+                           << ", \"first_lock_s\": " << channel.second.first_lock_s
+                           << ", \"cn0_db_hz\": " << channel.second.cn0_db_hz << '}'
+                           << ((++channel_index < result.channels.size()) ? ",\n" : "\n");
+                }
+            report << "      ]\n";
+            report << "    }" << ((i + 1 < results.size()) ? ",\n" : "\n");
+        }
+    report << "  ]\n}\n";
+    std::cout << "Benchmark report written to " << filename << '\n';
+}
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    if (FLAGS_config_files.empty())
+        {
+            std::cerr << "Usage: " << argv[0] << " --config_files=<scenario1.conf[,scenario2.conf,...]> [--output_file=report.json]\n";
+            gflags::ShutDownCommandLineFlags();
+            return 1;
+        }
+
+    std::vector<std::string> config_files;
+    std::stringstream config_list(FLAGS_config_files);
+    std::string config_file;
+    while (std::getline(config_list, config_file, ','))
+        {
+            if (!config_file.empty())
+                {
+                    config_files.push_back(config_file);
+                }
+        }
+
+    std::vector<ScenarioResult> results;
+    for (const auto& scenario : config_files)
+        {
+            std::cout << "Running scenario " << scenario << " ...\n";
+            results.push_back(run_scenario(scenario));
+            const auto& result = results.back();
+            std::cout << "  wall time: " << result.wall_s << " s, real-time margin: " << result.realtime_margin
+                      << ", TTFF: " << result.ttff_s << " s, channels locked: " << result.channels.size()
+                      << ", peak RSS: " << result.peak_rss_kb << " kB\n";
+        }
+    write_json_report(results, FLAGS_output_file);
+
+    gflags::ShutDownCommandLineFlags();
+    return 0;
+}
@@ -0,0 +1,401 @@
+/*!
+ * \file soak_test.cc
+ * \brief Sustained-rate soak test with leak and drift detection
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ * Loops a receiver scenario in-process for a configurable duration (using
+ * the deterministic replay mode, so every pass processes the same samples),
+ * samples the resident set size, the open file descriptor count and the
+ * receiver time progression periodically, and fails when the resources grow
+ * monotonically or the per-pass processed signal time drifts beyond bounds.
+ * Intended for overnight runs through the `soak` build target, replacing
+ * the per-release tmux-and-shell-script procedure.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "concurrent_map.h"
+#include "concurrent_queue.h"
+#include "control_thread.h"
+#include "file_configuration.h"
+#include "gnss_flowgraph.h"
+#include "gnss_synchro.h"
+#include "gps_acq_assist.h"
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <dirent.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <sys/ipc.h>
+#include <sys/msg.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#if GFLAGS_OLD_NAMESPACE
+namespace gflags
+{
+using namespace google;
+}
+#endif
+
+DEFINE_string(config_file_soak, std::string(""), "Configuration file of the scenario to loop");
+DEFINE_string(output_file_soak, std::string("soak_test.json"), "File where the soak results are written, in JSON format");
+DEFINE_int32(soak_duration_s, 28800, "Total soak duration, in seconds (default: 8 hours)");
+DEFINE_int32(max_pass_duration_s, 600, "Hard per-pass time limit, in seconds");
+DEFINE_int32(sample_interval_s, 30, "Resource sampling period, in seconds");
+DEFINE_int32(poll_interval_ms, 200, "Receiver time polling period, in milliseconds");
+DEFINE_double(rss_growth_limit_kb_per_hour, 4096.0, "Maximum tolerated RSS growth rate after the first pass, in kB/hour");
+DEFINE_int32(fd_growth_limit, 8, "Maximum tolerated net growth of open file descriptors after the first pass");
+DEFINE_double(rx_drift_limit_s, 0.5, "Maximum tolerated difference of processed signal time between passes, in seconds");
+
+// For GPS NAVIGATION (L1)
+Concurrent_Queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
+Concurrent_Map<Gps_Acq_Assist> global_gps_acq_assist_map;
+
+namespace
+{
+typedef struct
+{
+    long mtype;  // required by SysV message
+    double ttff;
+} ttff_msgbuf;
+
+
+struct Resource_Sample
+{
+    double wall_s = 0.0;
+    int pass = 0;
+    long rss_kb = 0;
+    int fd_count = 0;
+};
+
+
+struct Pass_Result
+{
+    double wall_s = 0.0;
+    double processed_signal_s = 0.0;
+    double realtime_margin = 0.0;
+    double max_epoch_gap_s = 0.0;  // longest wall-clock gap between receiver time advances
+    long rss_kb_after = 0;
+    int fd_count_after = 0;
+    bool completed = false;
+};
+
+
+// Stops the receiver through the SysV queue the control thread listens to
+void request_receiver_stop()
+{
+    const key_t key_stop = 1102;
+    int msqid_stop;
+    if ((msqid_stop = msgget(key_stop, 0644)) != -1)
+        {
+            ttff_msgbuf msg_stop;
+            msg_stop.mtype = 1;
+            msg_stop.ttff = -200.0;
+            msgsnd(msqid_stop, &msg_stop, sizeof(msg_stop.ttff), IPC_NOWAIT);
+        }
+}
+
+
+// The PVT block posts one TTFF message per pass; drain them so the kernel
+// queue does not fill up over a multi-day run
+void drain_ttff_queue()
+{
+    const key_t key = 1101;
+    int msqid;
+    if ((msqid = msgget(key, 0644)) != -1)
+        {
+            ttff_msgbuf msg;
+            while (msgrcv(msqid, &msg, sizeof(msg.ttff), 1, IPC_NOWAIT) != -1)
+                {
+                }
+        }
+}
+
+
+long current_rss_kb()
+{
+    // second field of /proc/self/statm is the resident set, in pages
+    std::ifstream statm("/proc/self/statm");
+    long size_pages = 0;
+    long resident_pages = 0;
+    if (statm >> size_pages >> resident_pages)
+        {
+            return resident_pages * (sysconf(_SC_PAGESIZE) / 1024);
+        }
+    return 0;
+}
+
+
+int current_fd_count()
+{
+    int count = 0;
+    DIR* fd_dir = opendir("/proc/self/fd");
+    if (fd_dir != nullptr)
+        {
+            while (readdir(fd_dir) != nullptr)
+                {
+                    count++;
+                }
+            closedir(fd_dir);
+            count -= 3;  // ".", ".." and the directory fd itself
+        }
+    return count;
+}
+
+
+Pass_Result run_pass(const std::string& config_file, int pass_number,
+    double soak_start_wall_s, std::vector<Resource_Sample>& samples)
+{
+    Pass_Result result;
+
+    const auto configuration = std::make_shared<FileConfiguration>(config_file);
+    // every pass replays the same samples with bounded buffers, so the
+    // resource footprint is comparable from pass to pass
+    configuration->set_property("GNSS-SDR.deterministic_replay", "true");
+    auto control_thread = std::make_unique<ControlThread>(configuration);
+
+    std::atomic<bool> receiver_done(false);
+    const auto start = std::chrono::steady_clock::now();
+    std::thread runner([&]() {
+        try
+            {
+                control_thread->run();
+            }
+        catch (const std::exception& e)
+            {
+                std::cerr << "Pass " << pass_number << " failed: " << e.what() << '\n';
+            }
+        receiver_done = true;
+    });
+
+    double first_rx_time_s = -1.0;
+    double first_rx_wall_s = 0.0;
+    double last_rx_time_s = -1.0;
+    double last_rx_wall_s = 0.0;
+    double last_sample_wall_s = -1e9;
+    bool stop_requested = false;
+    while (!receiver_done)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(FLAGS_poll_interval_ms));
+            const double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if ((wall_s > FLAGS_max_pass_duration_s) && !stop_requested)
+                {
+                    request_receiver_stop();
+                    stop_requested = true;
+                }
+            if (wall_s + soak_start_wall_s - last_sample_wall_s >= FLAGS_sample_interval_s)
+                {
+                    last_sample_wall_s = wall_s + soak_start_wall_s;
+                    Resource_Sample sample;
+                    sample.wall_s = last_sample_wall_s;
+                    sample.pass = pass_number;
+                    sample.rss_kb = current_rss_kb();
+                    sample.fd_count = current_fd_count();
+                    samples.push_back(sample);
+                }
+            const auto flowgraph = control_thread->flowgraph();
+            if (!flowgraph)
+                {
+                    continue;
+                }
+            const auto status_map = flowgraph->get_channels_status();
+            for (const auto& status : status_map)
+                {
+                    if (!status.second || (status.second->RX_time <= 0.0))
+                        {
+                            continue;
+                        }
+                    if (first_rx_time_s < 0.0)
+                        {
+                            first_rx_time_s = status.second->RX_time;
+                            first_rx_wall_s = wall_s;
+                        }
+                    if (status.second->RX_time > last_rx_time_s)
+                        {
+                            if (last_rx_time_s > 0.0)
+                                {
+                                    result.max_epoch_gap_s = std::max(result.max_epoch_gap_s, wall_s - last_rx_wall_s);
+                                }
+                            last_rx_time_s = status.second->RX_time;
+                            last_rx_wall_s = wall_s;
+                        }
+                }
+        }
+    runner.join();
+    result.wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if ((first_rx_time_s >= 0.0) && (last_rx_wall_s > first_rx_wall_s))
+        {
+            result.processed_signal_s = last_rx_time_s - first_rx_time_s;
+            result.realtime_margin = result.processed_signal_s / (last_rx_wall_s - first_rx_wall_s);
+        }
+    result.completed = !stop_requested;
+    drain_ttff_queue();
+    result.rss_kb_after = current_rss_kb();
+    result.fd_count_after = current_fd_count();
+    return result;
+}
+
+
+// Least-squares slope of the RSS samples taken after the first pass, in kB/hour.
+// The first pass is treated as warm-up: allocators, caches and the dump
+// buffers reach their steady-state footprint there.
+double rss_slope_kb_per_hour(const std::vector<Resource_Sample>& samples)
+{
+    double sum_t = 0.0;
+    double sum_r = 0.0;
+    double sum_tt = 0.0;
+    double sum_tr = 0.0;
+    int n = 0;
+    for (const auto& sample : samples)
+        {
+            if (sample.pass < 2)
+                {
+                    continue;
+                }
+            const double t = sample.wall_s / 3600.0;
+            sum_t += t;
+            sum_r += static_cast<double>(sample.rss_kb);
+            sum_tt += t * t;
+            sum_tr += t * static_cast<double>(sample.rss_kb);
+            n++;
+        }
+    if (n < 2)
+        {
+            return 0.0;
+        }
+    const double denominator = static_cast<double>(n) * sum_tt - sum_t * sum_t;
+    if (std::fabs(denominator) < 1e-12)
+        {
+            return 0.0;
+        }
+    return (static_cast<double>(n) * sum_tr - sum_t * sum_r) / denominator;
+}
+
+
+void write_json_report(const std::vector<Pass_Result>& passes,
+    const std::vector<Resource_Sample>& samples,
+    double rss_slope, bool rss_ok, bool fd_ok, bool drift_ok)
+{
+    std::ofstream report(FLAGS_output_file_soak);
+    if (!report)
+        {
+            std::cerr << "Could not write the soak report to " << FLAGS_output_file_soak << '\n';
+            return;
+        }
+    report << std::setprecision(6);
+    report << "{\n";
+    report << "  \"config_file\": \"" << FLAGS_config_file_soak << "\",\n";
+    report << "  \"passes\": [\n";
+    for (size_t i = 0; i < passes.size(); i++)
+        {
+            const auto& pass = passes[i];
+            report << "    {\"pass\": " << (i + 1)
+                   << ", \"completed\": " << (pass.completed ? "true" : "false")
+                   << ", \"wall_s\": " << pass.wall_s
+                   << ", \"processed_signal_s\": " << pass.processed_signal_s
+                   << ", \"realtime_margin\": " << pass.realtime_margin
+                   << ", \"max_epoch_gap_s\": " << pass.max_epoch_gap_s
+                   << ", \"rss_kb\": " << pass.rss_kb_after
+                   << ", \"fd_count\": " << pass.fd_count_after << '}'
+                   << ((i + 1 < passes.size()) ? ",\n" : "\n");
+        }
+    report << "  ],\n";
+    report << "  \"resource_samples\": [\n";
+    for (size_t i = 0; i < samples.size(); i++)
+        {
+            report << "    {\"wall_s\": " << samples[i].wall_s
+                   << ", \"pass\": " << samples[i].pass
+                   << ", \"rss_kb\": " << samples[i].rss_kb
+                   << ", \"fd_count\": " << samples[i].fd_count << '}'
+                   << ((i + 1 < samples.size()) ? ",\n" : "\n");
+        }
+    report << "  ],\n";
+    report << "  \"rss_slope_kb_per_hour\": " << rss_slope << ",\n";
+    report << "  \"checks\": {\n";
+    report << "    \"rss_growth\": \"" << (rss_ok ? "PASS" : "FAIL") << "\",\n";
+    report << "    \"fd_growth\": \"" << (fd_ok ? "PASS" : "FAIL") << "\",\n";
+    report << "    \"rx_time_drift\": \"" << (drift_ok ? "PASS" : "FAIL") << "\"\n";
+    report << "  }\n";
+    report << "}\n";
+    std::cout << "Soak report written to " << FLAGS_output_file_soak << '\n';
+}
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    if (FLAGS_config_file_soak.empty())
+        {
+            std::cerr << "Usage: " << argv[0] << " --config_file_soak=<scenario.conf> [--soak_duration_s=28800]\n";
+            gflags::ShutDownCommandLineFlags();
+            return 1;
+        }
+
+    std::vector<Pass_Result> passes;
+    std::vector<Resource_Sample> samples;
+    const auto soak_start = std::chrono::steady_clock::now();
+    int pass_number = 0;
+    while (std::chrono::duration<double>(std::chrono::steady_clock::now() - soak_start).count() < FLAGS_soak_duration_s)
+        {
+            pass_number++;
+            const double soak_wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - soak_start).count();
+            std::cout << "Pass " << pass_number << " (soak time " << std::fixed << std::setprecision(0)
+                      << soak_wall_s << " / " << FLAGS_soak_duration_s << " s)...\n"
+                      << std::defaultfloat << std::setprecision(6);
+            passes.push_back(run_pass(FLAGS_config_file_soak, pass_number, soak_wall_s, samples));
+            const auto& pass = passes.back();
+            std::cout << "  wall: " << pass.wall_s << " s, signal: " << pass.processed_signal_s
+                      << " s, RSS: " << pass.rss_kb_after << " kB, fds: " << pass.fd_count_after << '\n';
+        }
+
+    // verdicts
+    const double rss_slope = rss_slope_kb_per_hour(samples);
+    const bool rss_ok = rss_slope <= FLAGS_rss_growth_limit_kb_per_hour;
+
+    bool fd_ok = true;
+    if (passes.size() > 1)
+        {
+            fd_ok = (passes.back().fd_count_after - passes.front().fd_count_after) <= FLAGS_fd_growth_limit;
+        }
+
+    bool drift_ok = true;
+    for (size_t i = 1; i < passes.size(); i++)
+        {
+            // only completed passes replayed the whole file
+            if (passes[i].completed && passes.front().completed &&
+                (std::fabs(passes[i].processed_signal_s - passes.front().processed_signal_s) > FLAGS_rx_drift_limit_s))
+                {
+                    drift_ok = false;
+                }
+        }
+
+    write_json_report(passes, samples, rss_slope, rss_ok, fd_ok, drift_ok);
+
+    std::cout << "RSS growth:    " << (rss_ok ? "PASS" : "FAIL") << " (" << rss_slope << " kB/hour)\n";
+    std::cout << "FD growth:     " << (fd_ok ? "PASS" : "FAIL") << '\n';
+    std::cout << "Rx time drift: " << (drift_ok ? "PASS" : "FAIL") << '\n';
+
+    gflags::ShutDownCommandLineFlags();
+    return (rss_ok && fd_ok && drift_ok) ? 0 : 1;
+}
@@ -0,0 +1,432 @@
+/*!
+ * \file ttff_sweep.cc
+ * \brief Parallel time-to-first-fix tuning harness
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * Runs dozens of randomized-start TTFF trials in parallel worker processes,
+ * optionally sweeping one acquisition parameter across a list of values, and
+ * aggregates the TTFF distribution (median and 95th percentile) per sweep
+ * point. Each worker process runs a full receiver with private System V
+ * message queues, so trials do not interfere with each other. Results are
+ * written to a JSON file for trend tracking across tuning campaigns.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "concurrent_map.h"
+#include "concurrent_queue.h"
+#include "control_thread.h"
+#include "file_configuration.h"
+#include "gps_acq_assist.h"
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <sys/ipc.h>
+#include <sys/msg.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#if GFLAGS_OLD_NAMESPACE
+namespace gflags
+{
+using namespace google;
+}
+#endif
+
+DEFINE_string(config_file_sweep, std::string(""), "File containing the configuration parameters used for the trials");
+DEFINE_int32(num_trials, 16, "Number of randomized-start trials per sweep point");
+DEFINE_int32(num_workers, 4, "Number of parallel worker processes");
+DEFINE_int32(max_trial_duration, 120, "Hard per-trial time limit, in seconds");
+DEFINE_double(randomize_skip_max_s, 0.0, "If > 0, each trial sets SignalSource.seconds_to_skip to a uniform random value below this bound, so trials start at different points of the recording");
+DEFINE_string(sweep_param, std::string(""), "Configuration parameter swept across the trials, e.g. Acquisition_1C.pfa");
+DEFINE_string(sweep_values, std::string(""), "Comma-separated values assigned to sweep_param, one batch of trials per value");
+DEFINE_string(output_file_sweep, std::string("ttff_sweep.json"), "File where the sweep results are written, in JSON format");
+
+// Internal flags used by the worker processes, not meant to be set by the user
+DEFINE_bool(worker_trial, false, "Run a single trial and exit (set internally by the parent process)");
+DEFINE_string(worker_overrides, std::string(""), "Semicolon-separated key=value configuration overrides for a single trial (set internally)");
+
+// For GPS NAVIGATION (L1)
+Concurrent_Queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
+Concurrent_Map<Gps_Acq_Assist> global_gps_acq_assist_map;
+
+namespace
+{
+typedef struct
+{
+    long mtype;  // required by SysV message
+    double ttff;
+} ttff_msgbuf;
+
+// Each worker slot gets a private pair of System V keys, far away from the
+// default 1101/1102 pair so a concurrently running receiver is not disturbed
+const key_t ttff_key_base = 2101;
+
+key_t worker_ttff_key(int worker)
+{
+    return ttff_key_base + 2 * worker;
+}
+
+key_t worker_stop_key(int worker)
+{
+    return ttff_key_base + 2 * worker + 1;
+}
+
+
+struct TrialResult
+{
+    double ttff_s = -1.0;  // negative if the trial timed out without a fix
+    double skip_s = 0.0;
+};
+
+
+struct SweepPoint
+{
+    std::string value;
+    std::vector<TrialResult> trials;
+};
+
+
+// Entry point of the worker processes: applies the per-trial configuration
+// overrides and runs the receiver until it stops or is stopped by the parent
+int run_worker_trial()
+{
+    auto configuration = std::make_shared<FileConfiguration>(FLAGS_config_file_sweep);
+    std::stringstream override_list(FLAGS_worker_overrides);
+    std::string override_item;
+    while (std::getline(override_list, override_item, ';'))
+        {
+            const size_t separator = override_item.find('=');
+            if (separator != std::string::npos)
+                {
+                    configuration->set_property(override_item.substr(0, separator), override_item.substr(separator + 1));
+                }
+        }
+    try
+        {
+            auto control_thread = std::make_unique<ControlThread>(configuration);
+            control_thread->run();
+        }
+    catch (const std::exception& e)
+        {
+            std::cerr << "Trial failed: " << e.what() << '\n';
+            return 1;
+        }
+    return 0;
+}
+
+
+std::string executable_path(const char* argv0)
+{
+    char resolved[1024];
+    const ssize_t len = readlink("/proc/self/exe", resolved, sizeof(resolved) - 1);
+    if (len > 0)
+        {
+            resolved[len] = '\0';
+            return std::string(resolved);
+        }
+    return std::string(argv0);
+}
+
+
+// Spawns a worker process running a single trial, waits for its TTFF report
+// on the worker's private queue, and stops the worker if it exceeds the time
+// limit. Returns the measured TTFF, or -1 if no fix was obtained.
+double run_trial(const std::string& self_path, int worker, const std::string& overrides)
+{
+    const key_t key = worker_ttff_key(worker);
+    const int msgflg = IPC_CREAT | 0666;
+    int msqid;
+    if ((msqid = msgget(key, msgflg)) == -1)
+        {
+            std::cerr << "Cannot create the SysV message queue of worker " << worker << '\n';
+            return -1.0;
+        }
+    // drain stale reports left over from a crashed run
+    ttff_msgbuf msg;
+    while (msgrcv(msqid, &msg, sizeof(msg.ttff), 1, IPC_NOWAIT) != -1)
+        {
+        }
+
+    const pid_t pid = fork();
+    if (pid == -1)
+        {
+            std::cerr << "Cannot fork a worker process\n";
+            return -1.0;
+        }
+    if (pid == 0)
+        {
+            const std::string worker_trial_arg = "--worker_trial";
+            const std::string config_arg = "--config_file_sweep=" + FLAGS_config_file_sweep;
+            const std::string overrides_arg = "--worker_overrides=" + overrides;
+            execl(self_path.c_str(), self_path.c_str(),
+                worker_trial_arg.c_str(), config_arg.c_str(), overrides_arg.c_str(),
+                static_cast<char*>(nullptr));
+            _exit(127);  // only reached if execl failed
+        }
+
+    double ttff = -1.0;
+    bool stop_sent = false;
+    const auto start = std::chrono::steady_clock::now();
+    while (true)
+        {
+            if (msgrcv(msqid, &msg, sizeof(msg.ttff), 1, IPC_NOWAIT) != -1)
+                {
+                    if (msg.ttff > 0.0)
+                        {
+                            ttff = msg.ttff;
+                            break;
+                        }
+                }
+            int status = 0;
+            if (waitpid(pid, &status, WNOHANG) == pid)
+                {
+                    // receiver ended (end of file, or stop order honored)
+                    if (msgrcv(msqid, &msg, sizeof(msg.ttff), 1, IPC_NOWAIT) != -1)
+                        {
+                            if (msg.ttff > 0.0)
+                                {
+                                    ttff = msg.ttff;
+                                }
+                        }
+                    msgctl(msqid, IPC_RMID, nullptr);
+                    return ttff;
+                }
+            const double elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if ((elapsed_s > FLAGS_max_trial_duration) && !stop_sent)
+                {
+                    int msqid_stop;
+                    if ((msqid_stop = msgget(worker_stop_key(worker), msgflg)) != -1)
+                        {
+                            ttff_msgbuf msg_stop;
+                            msg_stop.mtype = 1;
+                            msg_stop.ttff = -200.0;
+                            msgsnd(msqid_stop, &msg_stop, sizeof(msg_stop.ttff), IPC_NOWAIT);
+                        }
+                    stop_sent = true;
+                }
+            if (elapsed_s > (FLAGS_max_trial_duration + 30))
+                {
+                    // the stop order was not honored, kill the worker
+                    kill(pid, SIGKILL);
+                }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    waitpid(pid, nullptr, 0);
+    msgctl(msqid, IPC_RMID, nullptr);
+    return ttff;
+}
+
+
+double percentile(std::vector<double> values, double fraction)
+{
+    if (values.empty())
+        {
+            return -1.0;
+        }
+    std::sort(values.begin(), values.end());
+    const auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(values.size())));
+    return values[std::min(values.size() - 1, (rank > 0) ? (rank - 1) : 0)];
+}
+
+
+void write_json_report(const std::vector<SweepPoint>& points, const std::string& filename)
+{
+    std::ofstream report(filename);
+    if (!report)
+        {
+            std::cerr << "Could not write the sweep report to " << filename << '\n';
+            return;
+        }
+    report << std::setprecision(6);
+    report << "{\n";
+    report << "  \"config_file\": \"" << FLAGS_config_file_sweep << "\",\n";
+    report << "  \"sweep_param\": \"" << FLAGS_sweep_param << "\",\n";
+    report << "  \"num_trials\": " << FLAGS_num_trials << ",\n";
+    report << "  \"sweep_points\": [\n";
+    for (size_t i = 0; i < points.size(); i++)
+        {
+            const auto& point = points[i];
+            std::vector<double> fixes;
+            for (const auto& trial : point.trials)
+                {
+                    if (trial.ttff_s > 0.0)
+                        {
+                            fixes.push_back(trial.ttff_s);
+                        }
+                }
+            report << "    {\n";
+            report << "      \"value\": \"" << point.value << "\",\n";
+            report << "      \"fixes\": " << fixes.size() << ",\n";
+            report << "      \"ttff_median_s\": " << percentile(fixes, 0.5) << ",\n";
+            report << "      \"ttff_p95_s\": " << percentile(fixes, 0.95) << ",\n";
+            report << "      \"trials\": [\n";
+            for (size_t j = 0; j < point.trials.size(); j++)
+                {
+                    report << "        {\"ttff_s\": " << point.trials[j].ttff_s
+                           << ", \"skip_s\": " << point.trials[j].skip_s << '}'
+                           << ((j + 1 < point.trials.size()) ? ",\n" : "\n");
+                }
+            report << "      ]\n";
+            report << "    }" << ((i + 1 < points.size()) ? ",\n" : "\n");
+        }
+    report << "  ]\n}\n";
+    std::cout << "Sweep report written to " << filename << '\n';
+}
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    if (FLAGS_worker_trial)
+        {
+            const int trial_result = run_worker_trial();
+            gflags::ShutDownCommandLineFlags();
+            return trial_result;
+        }
+
+    if (FLAGS_config_file_sweep.empty())
+        {
+            std::cerr << "Usage: " << argv[0] << " --config_file_sweep=<configuration file> [--sweep_param=<name> --sweep_values=v1,v2,...] [--num_trials=N] [--num_workers=N]\n";
+            gflags::ShutDownCommandLineFlags();
+            return 1;
+        }
+
+    std::vector<std::string> sweep_values;
+    if (!FLAGS_sweep_param.empty())
+        {
+            std::stringstream value_list(FLAGS_sweep_values);
+            std::string value;
+            while (std::getline(value_list, value, ','))
+                {
+                    if (!value.empty())
+                        {
+                            sweep_values.push_back(value);
+                        }
+                }
+            if (sweep_values.empty())
+                {
+                    std::cerr << "No values given for the swept parameter " << FLAGS_sweep_param << '\n';
+                    gflags::ShutDownCommandLineFlags();
+                    return 1;
+                }
+        }
+    else
+        {
+            sweep_values.emplace_back("");  // a single batch with the configuration as-is
+        }
+
+    const std::string self_path = executable_path(argv[0]);
+    const int num_workers = std::max(1, FLAGS_num_workers);
+    std::mt19937 rng(std::random_device{}());
+    std::uniform_real_distribution<double> skip_dist(0.0, FLAGS_randomize_skip_max_s);
+
+    std::vector<SweepPoint> points;
+    for (const auto& value : sweep_values)
+        {
+            SweepPoint point;
+            point.value = value;
+            point.trials.resize(FLAGS_num_trials);
+
+            // draw the randomized start offsets up front, in the parent,
+            // so the trial list is reproducible within a batch
+            for (auto& trial : point.trials)
+                {
+                    trial.skip_s = (FLAGS_randomize_skip_max_s > 0.0) ? skip_dist(rng) : 0.0;
+                }
+
+            if (value.empty())
+                {
+                    std::cout << "Running " << FLAGS_num_trials << " trials with " << num_workers << " workers...\n";
+                }
+            else
+                {
+                    std::cout << "Running " << FLAGS_num_trials << " trials with " << num_workers
+                              << " workers for " << FLAGS_sweep_param << "=" << value << " ...\n";
+                }
+
+            std::atomic<int> next_trial(0);
+            std::vector<std::thread> workers;
+            workers.reserve(num_workers);
+            for (int worker = 0; worker < num_workers; worker++)
+                {
+                    workers.emplace_back([&, worker]() {
+                        int trial_index;
+                        while ((trial_index = next_trial.fetch_add(1)) < FLAGS_num_trials)
+                            {
+                                auto& trial = point.trials[trial_index];
+                                std::ostringstream overrides;
+                                overrides << "PVT.sysv_msg_key=" << worker_ttff_key(worker)
+                                          << ";GNSS-SDR.sysv_stop_queue_key=" << worker_stop_key(worker);
+                                if (!value.empty())
+                                    {
+                                        overrides << ';' << FLAGS_sweep_param << '=' << value;
+                                    }
+                                if (trial.skip_s > 0.0)
+                                    {
+                                        overrides << ";SignalSource.seconds_to_skip=" << trial.skip_s;
+                                    }
+                                trial.ttff_s = run_trial(self_path, worker, overrides.str());
+                                std::cout << "  trial " << trial_index << ": "
+                                          << ((trial.ttff_s > 0.0) ? (std::to_string(trial.ttff_s) + " s") : std::string("no fix")) << '\n';
+                            }
+                    });
+                }
+            for (auto& worker : workers)
+                {
+                    worker.join();
+                }
+            points.push_back(std::move(point));
+        }
+
+    std::cout << "\nResults:\n";
+    for (const auto& point : points)
+        {
+            std::vector<double> fixes;
+            for (const auto& trial : point.trials)
+                {
+                    if (trial.ttff_s > 0.0)
+                        {
+                            fixes.push_back(trial.ttff_s);
+                        }
+                }
+            if (!point.value.empty())
+                {
+                    std::cout << FLAGS_sweep_param << "=" << point.value << ": ";
+                }
+            std::cout << fixes.size() << "/" << point.trials.size() << " fixes"
+                      << ", median TTFF: " << percentile(fixes, 0.5) << " s"
+                      << ", p95 TTFF: " << percentile(fixes, 0.95) << " s\n";
+        }
+    write_json_report(points, FLAGS_output_file_sweep);
+
+    gflags::ShutDownCommandLineFlags();
+    return 0;
+}
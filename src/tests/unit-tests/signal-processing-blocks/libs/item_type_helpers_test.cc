@@ -87,6 +87,8 @@ TEST_F(ItemTypeHelpersTest, CheckSizes)
     EXPECT_EQ(item_type_size("float"), 4);
     EXPECT_EQ(item_type_size("gr_complex"), 8);
 
+    EXPECT_EQ(item_type_size("c4bits"), 1);
+
     for (auto &invalid_type : invalid_item_types)
         {
             EXPECT_EQ(item_type_size(invalid_type), 0);
@@ -248,3 +250,64 @@ TEST_F(ItemTypeHelpersTest, CheckConversionsComplex)
     converter(float_array_out.data(), float_array_in.data(), N);
     EXPECT_TRUE(std::equal(float_array_in.begin(), float_array_in.begin() + N, float_array_out.begin()));
 }
+
+
+TEST_F(ItemTypeHelpersTest, CheckConversionsPacked)
+{
+    EXPECT_TRUE(item_type_valid("c4bits"));
+    EXPECT_TRUE(item_type_is_complex("c4bits"));
+
+    // two packed samples: (-3, 5) and (7, -8), real part in the low nibble
+    std::array<uint8_t, 2> packed = {0x5D, 0x87};
+    std::array<int8_t, 4> unpacked_bytes{};
+    std::array<int16_t, 4> unpacked_shorts{};
+    std::array<float, 4> unpacked_floats{};
+    const std::array<int8_t, 4> expected = {-3, 5, 7, -8};
+
+    item_type_converter_t converter = make_vector_converter("c4bits", "cbyte");
+    EXPECT_NE(converter, nullptr);
+    converter(unpacked_bytes.data(), packed.data(), packed.size());
+    for (size_t i = 0; i < expected.size(); i++)
+        {
+            EXPECT_EQ(unpacked_bytes[i], expected[i]);
+        }
+
+    converter = make_vector_converter("c4bits", "cshort");
+    EXPECT_NE(converter, nullptr);
+    converter(unpacked_shorts.data(), packed.data(), packed.size());
+    for (size_t i = 0; i < expected.size(); i++)
+        {
+            EXPECT_EQ(unpacked_shorts[i], expected[i]);
+        }
+
+    converter = make_vector_converter("c4bits", "gr_complex");
+    EXPECT_NE(converter, nullptr);
+    converter(unpacked_floats.data(), packed.data(), packed.size());
+    for (size_t i = 0; i < expected.size(); i++)
+        {
+            EXPECT_EQ(unpacked_floats[i], static_cast<float>(expected[i]));
+        }
+
+    // packing is not provided, only unpacking
+    EXPECT_THROW(converter = make_vector_converter("cbyte", "c4bits"), std::runtime_error);
+}
+
+
+TEST_F(ItemTypeHelpersTest, CheckConversionStats)
+{
+    item_type_conversion_stats_reset();
+
+    item_type_converter_t converter = make_vector_converter("byte", "float");
+    EXPECT_NE(converter, nullptr);
+    converter(float_array_out.data(), byte_array_in.data(), N);
+    converter(float_array_out.data(), byte_array_in.data(), N);
+
+    auto stats = item_type_conversion_stats();
+    EXPECT_EQ(stats["byte->float"].calls, 2U);
+    EXPECT_EQ(stats["byte->float"].bytes_in, 2U * N * item_type_size("byte"));
+
+    item_type_conversion_stats_reset();
+    stats = item_type_conversion_stats();
+    EXPECT_EQ(stats["byte->float"].calls, 0U);
+    EXPECT_EQ(stats["byte->float"].bytes_in, 0U);
+}
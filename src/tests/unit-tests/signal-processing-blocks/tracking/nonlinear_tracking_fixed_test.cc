@@ -0,0 +1,192 @@
+/*!
+ * \file nonlinear_tracking_fixed_test.cc
+ * \brief This file implements numerical accuracy tests for the
+ * fixed-dimension nonlinear tracking filters.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "nonlinear_tracking_fixed.h"
+#include <armadillo>
+#include <gtest/gtest.h>
+#include <array>
+
+#define NONLINEAR_FIXED_TEST_N_TRIALS 1000
+#define NONLINEAR_FIXED_TEST_TOLERANCE 0.01
+
+namespace
+{
+constexpr int TEST_NX = 2;
+constexpr int TEST_NZ = 2;
+
+std::array<double, TEST_NX> to_fixed_vec(const arma::vec& v)
+{
+    std::array<double, TEST_NX> out{};
+    for (int i = 0; i < TEST_NX; i++)
+        {
+            out[i] = v(i);
+        }
+    return out;
+}
+
+std::array<double, TEST_NX * TEST_NX> to_fixed_mat(const arma::mat& m)
+{
+    std::array<double, TEST_NX * TEST_NX> out{};
+    for (int i = 0; i < TEST_NX; i++)
+        {
+            for (int j = 0; j < TEST_NX; j++)
+                {
+                    out[i * TEST_NX + j] = m(i, j);
+                }
+        }
+    return out;
+}
+
+bool fixed_vec_near(const std::array<double, TEST_NX>& a, const arma::vec& b, double tol)
+{
+    for (int i = 0; i < TEST_NX; i++)
+        {
+            if (std::abs(a[i] - b(i)) > tol)
+                {
+                    return false;
+                }
+        }
+    return true;
+}
+
+bool fixed_mat_near(const std::array<double, TEST_NX * TEST_NX>& a, const arma::mat& b, double tol)
+{
+    for (int i = 0; i < TEST_NX; i++)
+        {
+            for (int j = 0; j < TEST_NX; j++)
+                {
+                    if (std::abs(a[i * TEST_NX + j] - b(i, j)) > tol)
+                        {
+                            return false;
+                        }
+                }
+        }
+    return true;
+}
+
+// Linear state transition and measurement models: for them the sigma-point
+// filters must reproduce the conventional Kalman filter recursion
+template <int N>
+std::array<double, N> linear_model(const arma::mat& coeff_mat, const std::array<double, TEST_NX>& input)
+{
+    std::array<double, N> out{};
+    for (int i = 0; i < N; i++)
+        {
+            for (int j = 0; j < TEST_NX; j++)
+                {
+                    out[i] += coeff_mat(i, j) * input[j];
+                }
+        }
+    return out;
+}
+}  // namespace
+
+
+TEST(NonlinearTrackingFixedTest, CubatureFilterFixedTest)
+{
+    CubatureFilterFixed<TEST_NX> ckf;
+
+    for (uint16_t k = 0; k < NONLINEAR_FIXED_TEST_N_TRIALS; k++)
+        {
+            arma::vec kf_x_post = arma::randn<arma::vec>(TEST_NX, 1);
+            arma::mat kf_P_x_post = 5.0 * arma::diagmat(arma::randu<arma::vec>(TEST_NX, 1)) + 0.1 * arma::eye(TEST_NX, TEST_NX);
+
+            ckf.initialize(to_fixed_vec(kf_x_post), to_fixed_mat(kf_P_x_post));
+
+            // Prediction Step
+            arma::mat kf_F = arma::randu<arma::mat>(TEST_NX, TEST_NX);
+            arma::mat kf_Q = arma::diagmat(arma::randu<arma::vec>(TEST_NX, 1));
+
+            auto transition_fcn = [&kf_F](const std::array<double, TEST_NX>& input) {
+                return linear_model<TEST_NX>(kf_F, input);
+            };
+            ckf.predict_sequential(to_fixed_vec(kf_x_post), to_fixed_mat(kf_P_x_post), transition_fcn, to_fixed_mat(kf_Q));
+
+            arma::vec kf_x_pre = kf_F * kf_x_post;
+            arma::mat kf_P_x_pre = kf_F * kf_P_x_post * kf_F.t() + kf_Q;
+
+            EXPECT_TRUE(fixed_vec_near(ckf.get_x_pred(), kf_x_pre, NONLINEAR_FIXED_TEST_TOLERANCE));
+            EXPECT_TRUE(fixed_mat_near(ckf.get_P_x_pred(), kf_P_x_pre, NONLINEAR_FIXED_TEST_TOLERANCE));
+
+            // Update Step
+            arma::mat kf_H = arma::randu<arma::mat>(TEST_NZ, TEST_NX);
+            arma::mat kf_R = arma::diagmat(arma::randu<arma::vec>(TEST_NZ, 1));
+            arma::vec kf_y = kf_H * kf_x_pre + arma::randn<arma::vec>(TEST_NZ, 1);
+
+            auto measurement_fcn = [&kf_H](const std::array<double, TEST_NX>& input) {
+                return linear_model<TEST_NZ>(kf_H, input);
+            };
+            ckf.update_sequential<TEST_NZ>(to_fixed_vec(kf_y), ckf.get_x_pred(), ckf.get_P_x_pred(), measurement_fcn, to_fixed_mat(kf_R));
+
+            arma::mat kf_P_y = kf_H * kf_P_x_pre * kf_H.t() + kf_R;
+            arma::mat kf_K = (kf_P_x_pre * kf_H.t()) * arma::inv(kf_P_y);
+
+            arma::vec kf_x_post_ref = kf_x_pre + kf_K * (kf_y - kf_H * kf_x_pre);
+            arma::mat kf_P_x_post_ref = (arma::eye(TEST_NX, TEST_NX) - kf_K * kf_H) * kf_P_x_pre;
+
+            EXPECT_TRUE(fixed_vec_near(ckf.get_x_est(), kf_x_post_ref, NONLINEAR_FIXED_TEST_TOLERANCE));
+            EXPECT_TRUE(fixed_mat_near(ckf.get_P_x_est(), kf_P_x_post_ref, NONLINEAR_FIXED_TEST_TOLERANCE));
+        }
+}
+
+
+TEST(NonlinearTrackingFixedTest, UnscentedFilterFixedTest)
+{
+    UnscentedFilterFixed<TEST_NX> ukf;
+
+    for (uint16_t k = 0; k < NONLINEAR_FIXED_TEST_N_TRIALS; k++)
+        {
+            arma::vec kf_x_post = arma::randn<arma::vec>(TEST_NX, 1);
+            arma::mat kf_P_x_post = 5.0 * arma::diagmat(arma::randu<arma::vec>(TEST_NX, 1)) + 0.1 * arma::eye(TEST_NX, TEST_NX);
+
+            ukf.initialize(to_fixed_vec(kf_x_post), to_fixed_mat(kf_P_x_post));
+
+            // Prediction Step
+            arma::mat kf_F = arma::randu<arma::mat>(TEST_NX, TEST_NX);
+            arma::mat kf_Q = arma::diagmat(arma::randu<arma::vec>(TEST_NX, 1));
+
+            auto transition_fcn = [&kf_F](const std::array<double, TEST_NX>& input) {
+                return linear_model<TEST_NX>(kf_F, input);
+            };
+            ukf.predict_sequential(to_fixed_vec(kf_x_post), to_fixed_mat(kf_P_x_post), transition_fcn, to_fixed_mat(kf_Q));
+
+            arma::vec kf_x_pre = kf_F * kf_x_post;
+            arma::mat kf_P_x_pre = kf_F * kf_P_x_post * kf_F.t() + kf_Q;
+
+            EXPECT_TRUE(fixed_vec_near(ukf.get_x_pred(), kf_x_pre, NONLINEAR_FIXED_TEST_TOLERANCE));
+            EXPECT_TRUE(fixed_mat_near(ukf.get_P_x_pred(), kf_P_x_pre, NONLINEAR_FIXED_TEST_TOLERANCE));
+
+            // Update Step
+            arma::mat kf_H = arma::randu<arma::mat>(TEST_NZ, TEST_NX);
+            arma::mat kf_R = arma::diagmat(arma::randu<arma::vec>(TEST_NZ, 1));
+            arma::vec kf_y = kf_H * kf_x_pre + arma::randn<arma::vec>(TEST_NZ, 1);
+
+            auto measurement_fcn = [&kf_H](const std::array<double, TEST_NX>& input) {
+                return linear_model<TEST_NZ>(kf_H, input);
+            };
+            ukf.update_sequential<TEST_NZ>(to_fixed_vec(kf_y), ukf.get_x_pred(), ukf.get_P_x_pred(), measurement_fcn, to_fixed_mat(kf_R));
+
+            arma::mat kf_P_y = kf_H * kf_P_x_pre * kf_H.t() + kf_R;
+            arma::mat kf_K = (kf_P_x_pre * kf_H.t()) * arma::inv(kf_P_y);
+
+            arma::vec kf_x_post_ref = kf_x_pre + kf_K * (kf_y - kf_H * kf_x_pre);
+            arma::mat kf_P_x_post_ref = (arma::eye(TEST_NX, TEST_NX) - kf_K * kf_H) * kf_P_x_pre;
+
+            EXPECT_TRUE(fixed_vec_near(ukf.get_x_est(), kf_x_post_ref, NONLINEAR_FIXED_TEST_TOLERANCE));
+            EXPECT_TRUE(fixed_mat_near(ukf.get_P_x_est(), kf_P_x_post_ref, NONLINEAR_FIXED_TEST_TOLERANCE));
+        }
+}
@@ -0,0 +1,151 @@
+/*!
+ * \file gnss_synchro_epoch_test.cc
+ * \brief Test for the structure-of-arrays Gnss_Synchro epoch container
+ * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_synchro.h"
+#include "gnss_synchro_epoch.h"
+#include <vector>
+
+namespace
+{
+Gnss_Synchro make_synchro(int ch)
+{
+    Gnss_Synchro gs{};
+    gs.System = 'G';
+    gs.Signal[0] = '1';
+    gs.Signal[1] = 'C';
+    gs.Signal[2] = '\0';
+    gs.PRN = 1 + static_cast<uint32_t>(ch);
+    gs.Channel_ID = ch;
+    gs.Acq_delay_samples = 100.5 + ch;
+    gs.Acq_doppler_hz = -1250.0 + 10.0 * ch;
+    gs.Acq_samplestamp_samples = 4000000ULL * static_cast<uint64_t>(ch + 1);
+    gs.Acq_doppler_step = 250;
+    gs.fs = 4000000LL;
+    gs.Prompt_I = 1000.0 + ch;
+    gs.Prompt_Q = -3.0 * ch;
+    gs.CN0_dB_hz = 44.0 - 0.5 * ch;
+    gs.Carrier_Doppler_hz = -1234.5 + ch;
+    gs.Carrier_phase_rads = 0.125 * ch;
+    gs.Code_phase_samples = 512.25 + ch;
+    gs.Tracking_sample_counter = 123456789ULL + static_cast<uint64_t>(ch);
+    gs.correlation_length_ms = 1;
+    gs.TOW_at_current_symbol_ms = 345600000U + static_cast<uint32_t>(ch);
+    gs.Pseudorange_m = 21000000.0 + 100.0 * ch;
+    gs.RX_time = 345600.123 + 0.001 * ch;
+    gs.interp_TOW_ms = 345600123.0 + ch;
+    gs.Flag_valid_acquisition = true;
+    gs.Flag_valid_symbol_output = ((ch % 2) == 0);
+    gs.Flag_valid_word = true;
+    gs.Flag_valid_pseudorange = ((ch % 3) != 0);
+    return gs;
+}
+}  // namespace
+
+
+TEST(GnssSynchroEpochTest, AosRoundTrip)
+{
+    const int n_channels = 12;
+    std::vector<Gnss_Synchro> epoch_in(n_channels);
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            epoch_in[ch] = make_synchro(ch);
+        }
+
+    Gnss_Synchro_Epoch epoch;
+    epoch.load(epoch_in);
+    ASSERT_EQ(epoch.size(), static_cast<size_t>(n_channels));
+
+    std::vector<Gnss_Synchro> epoch_out;
+    epoch.store(epoch_out);
+    ASSERT_EQ(epoch_out.size(), epoch_in.size());
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            EXPECT_EQ(epoch_out[ch].System, epoch_in[ch].System);
+            EXPECT_EQ(epoch_out[ch].Signal[0], epoch_in[ch].Signal[0]);
+            EXPECT_EQ(epoch_out[ch].Signal[1], epoch_in[ch].Signal[1]);
+            EXPECT_EQ(epoch_out[ch].PRN, epoch_in[ch].PRN);
+            EXPECT_EQ(epoch_out[ch].Channel_ID, epoch_in[ch].Channel_ID);
+            EXPECT_DOUBLE_EQ(epoch_out[ch].Acq_delay_samples, epoch_in[ch].Acq_delay_samples);
+            EXPECT_DOUBLE_EQ(epoch_out[ch].Acq_doppler_hz, epoch_in[ch].Acq_doppler_hz);
+            EXPECT_EQ(epoch_out[ch].Acq_samplestamp_samples, epoch_in[ch].Acq_samplestamp_samples);
+            EXPECT_EQ(epoch_out[ch].Acq_doppler_step, epoch_in[ch].Acq_doppler_step);
+            EXPECT_EQ(epoch_out[ch].fs, epoch_in[ch].fs);
+            EXPECT_DOUBLE_EQ(epoch_out[ch].Prompt_I, epoch_in[ch].Prompt_I);
+            EXPECT_DOUBLE_EQ(epoch_out[ch].Prompt_Q, epoch_in[ch].Prompt_Q);
+            EXPECT_DOUBLE_EQ(epoch_out[ch].CN0_dB_hz, epoch_in[ch].CN0_dB_hz);
+            EXPECT_DOUBLE_EQ(epoch_out[ch].Carrier_Doppler_hz, epoch_in[ch].Carrier_Doppler_hz);
+            EXPECT_DOUBLE_EQ(epoch_out[ch].Carrier_phase_rads, epoch_in[ch].Carrier_phase_rads);
+            EXPECT_DOUBLE_EQ(epoch_out[ch].Code_phase_samples, epoch_in[ch].Code_phase_samples);
+            EXPECT_EQ(epoch_out[ch].Tracking_sample_counter, epoch_in[ch].Tracking_sample_counter);
+            EXPECT_EQ(epoch_out[ch].correlation_length_ms, epoch_in[ch].correlation_length_ms);
+            EXPECT_EQ(epoch_out[ch].TOW_at_current_symbol_ms, epoch_in[ch].TOW_at_current_symbol_ms);
+            EXPECT_DOUBLE_EQ(epoch_out[ch].Pseudorange_m, epoch_in[ch].Pseudorange_m);
+            EXPECT_DOUBLE_EQ(epoch_out[ch].RX_time, epoch_in[ch].RX_time);
+            EXPECT_DOUBLE_EQ(epoch_out[ch].interp_TOW_ms, epoch_in[ch].interp_TOW_ms);
+            EXPECT_EQ(epoch_out[ch].Flag_valid_acquisition, epoch_in[ch].Flag_valid_acquisition);
+            EXPECT_EQ(epoch_out[ch].Flag_valid_symbol_output, epoch_in[ch].Flag_valid_symbol_output);
+            EXPECT_EQ(epoch_out[ch].Flag_valid_word, epoch_in[ch].Flag_valid_word);
+            EXPECT_EQ(epoch_out[ch].Flag_valid_pseudorange, epoch_in[ch].Flag_valid_pseudorange);
+        }
+}
+
+
+TEST(GnssSynchroEpochTest, FieldGroupViews)
+{
+    const int n_channels = 8;
+    std::vector<Gnss_Synchro> epoch_in(n_channels);
+    std::vector<const Gnss_Synchro*> in_pointers(n_channels);
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            epoch_in[ch] = make_synchro(ch);
+            in_pointers[ch] = &epoch_in[ch];
+        }
+
+    Gnss_Synchro_Epoch epoch;
+    epoch.load(in_pointers.data(), n_channels);
+
+    const auto sat = epoch.satellite();
+    const auto trk = epoch.tracking();
+    const auto obs = epoch.observables();
+    const auto flags = epoch.flags();
+    ASSERT_EQ(sat.n_channels, static_cast<size_t>(n_channels));
+    ASSERT_EQ(trk.n_channels, static_cast<size_t>(n_channels));
+    ASSERT_EQ(obs.n_channels, static_cast<size_t>(n_channels));
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            EXPECT_EQ(sat.prn[ch], epoch_in[ch].PRN);
+            EXPECT_EQ(sat.signal[ch][0], epoch_in[ch].Signal[0]);
+            EXPECT_DOUBLE_EQ(trk.cn0_db_hz[ch], epoch_in[ch].CN0_dB_hz);
+            EXPECT_EQ(trk.tracking_sample_counter[ch], epoch_in[ch].Tracking_sample_counter);
+            EXPECT_DOUBLE_EQ(obs.rx_time[ch], epoch_in[ch].RX_time);
+            EXPECT_DOUBLE_EQ(obs.pseudorange_m[ch], epoch_in[ch].Pseudorange_m);
+            EXPECT_EQ(flags.valid_word[ch] != 0, epoch_in[ch].Flag_valid_word);
+        }
+
+    // a column scan over valid flags touches one contiguous byte array
+    int n_valid = 0;
+    for (size_t ch = 0; ch < flags.n_channels; ch++)
+        {
+            n_valid += (flags.valid_pseudorange[ch] != 0) ? 1 : 0;
+        }
+    int n_valid_expected = 0;
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            n_valid_expected += epoch_in[ch].Flag_valid_pseudorange ? 1 : 0;
+        }
+    EXPECT_EQ(n_valid, n_valid_expected);
+}
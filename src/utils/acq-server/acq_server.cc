@@ -0,0 +1,55 @@
+/*!
+ * \file acq_server.cc
+ * \brief Standalone acquisition offload server.
+ *
+ * Runs the PCPS grid search on snapshots shipped by edge receivers
+ * configured with AcquisitionOffload.server_address, and returns
+ * (delay, Doppler, test statistic) to each requester. Uploaded
+ * replicas are cached by content hash, so retargeting among the
+ * served receivers reuses codes seen earlier.
+ *
+ * usage: acq_server [port]   (default port 1262)
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_offload.h"
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+    uint16_t port = 1262;
+    if (argc > 1)
+        {
+            const int parsed_port = std::atoi(argv[1]);
+            if (parsed_port <= 0 or parsed_port > 65535)
+                {
+                    std::cerr << "Usage: " << argv[0] << " [port]\n";
+                    return 1;
+                }
+            port = static_cast<uint16_t>(parsed_port);
+        }
+    try
+        {
+            Acq_Offload_Server server(port);
+            std::cout << "Acquisition offload server listening on port " << port << '\n';
+            server.run();
+        }
+    catch (const std::exception& e)
+        {
+            std::cerr << "Acquisition offload server error: " << e.what() << '\n';
+            return 1;
+        }
+    return 0;
+}
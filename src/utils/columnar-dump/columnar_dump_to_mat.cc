@@ -0,0 +1,214 @@
+/*!
+ * \file columnar_dump_to_mat.cc
+ * \brief Offline converter from the streaming columnar dump format written
+ * by Columnar_Dump_Writer to a MATLAB .mat file
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include <matio.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Column
+{
+    std::string name;
+    std::vector<uint8_t> data;
+    uint8_t type;
+    uint8_t elem_size;
+};
+
+uint8_t type_size(uint8_t type)
+{
+    switch (type)
+        {
+        case 1:  // f32
+        case 3:  // i32
+        case 4:  // u32
+            return 4;
+        case 2:  // f64
+        case 5:  // i64
+        case 6:  // u64
+            return 8;
+        default:
+            return 0;
+        }
+}
+
+void mat_types(uint8_t type, matio_classes* class_type, matio_types* data_type)
+{
+    switch (type)
+        {
+        case 1:
+            *class_type = MAT_C_SINGLE;
+            *data_type = MAT_T_SINGLE;
+            break;
+        case 2:
+            *class_type = MAT_C_DOUBLE;
+            *data_type = MAT_T_DOUBLE;
+            break;
+        case 3:
+            *class_type = MAT_C_INT32;
+            *data_type = MAT_T_INT32;
+            break;
+        case 4:
+            *class_type = MAT_C_UINT32;
+            *data_type = MAT_T_UINT32;
+            break;
+        case 5:
+            *class_type = MAT_C_INT64;
+            *data_type = MAT_T_INT64;
+            break;
+        default:
+            *class_type = MAT_C_UINT64;
+            *data_type = MAT_T_UINT64;
+            break;
+        }
+}
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 or argc > 3)
+        {
+            std::cerr << "Usage: columnar_dump_to_mat <dump_file> [output.mat]\n";
+            return 1;
+        }
+    const std::string input_filename(argv[1]);
+    std::string output_filename;
+    if (argc == 3)
+        {
+            output_filename = argv[2];
+        }
+    else
+        {
+            output_filename = input_filename + ".mat";
+        }
+
+    std::ifstream file(input_filename, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        {
+            std::cerr << "Could not open " << input_filename << '\n';
+            return 1;
+        }
+
+    // File header
+    std::array<char, 4> magic{};
+    uint8_t version = 0;
+    uint8_t codec = 0;
+    uint16_t column_count = 0;
+    uint32_t rows_per_chunk = 0;
+    file.read(magic.data(), 4);
+    file.read(reinterpret_cast<char*>(&version), 1);
+    file.read(reinterpret_cast<char*>(&codec), 1);
+    file.read(reinterpret_cast<char*>(&column_count), 2);
+    file.read(reinterpret_cast<char*>(&rows_per_chunk), 4);
+    if (!file.good() or std::memcmp(magic.data(), "GSCD", 4) != 0)
+        {
+            std::cerr << input_filename << " is not a columnar dump file\n";
+            return 1;
+        }
+    if (version != 1 or codec != 0)
+        {
+            std::cerr << "Unsupported columnar dump version " << static_cast<int>(version)
+                      << " / codec " << static_cast<int>(codec) << '\n';
+            return 1;
+        }
+
+    std::vector<Column> columns(column_count);
+    for (auto& col : columns)
+        {
+            uint8_t name_len = 0;
+            file.read(reinterpret_cast<char*>(&col.type), 1);
+            file.read(reinterpret_cast<char*>(&name_len), 1);
+            col.name.resize(name_len);
+            file.read(col.name.data(), name_len);
+            col.elem_size = type_size(col.type);
+            if (!file.good() or col.elem_size == 0)
+                {
+                    std::cerr << "Corrupted column table in " << input_filename << '\n';
+                    return 1;
+                }
+        }
+
+    // Chunks, until EOF. A truncated trailing chunk is ignored
+    uint64_t total_rows = 0;
+    for (;;)
+        {
+            uint32_t rows = 0;
+            file.read(reinterpret_cast<char*>(&rows), 4);
+            if (!file.good() or rows == 0)
+                {
+                    break;
+                }
+            bool truncated = false;
+            for (auto& col : columns)
+                {
+                    const std::size_t chunk_bytes = static_cast<std::size_t>(rows) * col.elem_size;
+                    const std::size_t offset = col.data.size();
+                    col.data.resize(offset + chunk_bytes);
+                    file.read(reinterpret_cast<char*>(col.data.data() + offset), static_cast<std::streamsize>(chunk_bytes));
+                    if (!file.good())
+                        {
+                            col.data.resize(offset);
+                            truncated = true;
+                            break;
+                        }
+                }
+            if (truncated)
+                {
+                    std::cerr << "Warning: ignoring truncated trailing chunk\n";
+                    // roll back the columns already grown for this chunk
+                    for (auto& col : columns)
+                        {
+                            col.data.resize(static_cast<std::size_t>(total_rows) * col.elem_size);
+                        }
+                    break;
+                }
+            total_rows += rows;
+        }
+
+    if (total_rows == 0)
+        {
+            std::cerr << "No complete chunks found in " << input_filename << '\n';
+            return 1;
+        }
+
+    mat_t* matfp = Mat_CreateVer(output_filename.c_str(), nullptr, MAT_FT_MAT73);
+    if (matfp == nullptr)
+        {
+            std::cerr << "Could not create " << output_filename << '\n';
+            return 1;
+        }
+    std::array<std::size_t, 2> dims{1, static_cast<std::size_t>(total_rows)};
+    for (auto& col : columns)
+        {
+            matio_classes class_type;
+            matio_types data_type;
+            mat_types(col.type, &class_type, &data_type);
+            matvar_t* matvar = Mat_VarCreate(col.name.c_str(), class_type, data_type, 2, dims.data(), col.data.data(), 0);
+            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+            Mat_VarFree(matvar);
+        }
+    Mat_Close(matfp);
+
+    std::cout << "Wrote " << total_rows << " rows and " << columns.size() << " variables to " << output_filename << '\n';
+    return 0;
+}
@@ -0,0 +1,47 @@
+#!/bin/sh
+# GNSS-SDR shell script that flags by-value Gnss_Synchro copies in the epoch
+# path (observables and PVT blocks) using clang-query, so a silent copy of the
+# struct at epoch rates fails the copy-audit build target instead of landing.
+# Matches in whitelisted sinks (see gnss-sdr-copy-audit.allow) are accepted.
+# usage: ./gnss-sdr-copy-audit.sh [clang-query] [build-dir-with-compile_commands.json]
+
+# SPDX-FileCopyrightText: Carles Fernandez-Prades <cfernandez(at)cttc.es>
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+CLANG_QUERY=${1:-clang-query}
+BUILD_DIR=${2:-build}
+SCRIPT_DIR=$(dirname "$0")
+MATCHERS=$SCRIPT_DIR/gnss-sdr-copy-audit.matchers
+ALLOWLIST=$SCRIPT_DIR/gnss-sdr-copy-audit.allow
+
+AUDITED_FILES="src/algorithms/observables/gnuradio_blocks/hybrid_observables_gs.cc \
+src/algorithms/PVT/gnuradio_blocks/rtklib_pvt_gs.cc"
+
+if [ ! -f "$BUILD_DIR/compile_commands.json" ]
+then
+    echo "copy-audit: $BUILD_DIR/compile_commands.json not found."
+    echo "copy-audit: configure with -DCMAKE_EXPORT_COMPILE_COMMANDS=ON first."
+    exit 1
+fi
+
+ALLOW_PATTERNS=$(mktemp)
+trap 'rm -f "$ALLOW_PATTERNS"' EXIT
+sed -e '/^#/d' -e '/^[ \t]*$/d' "$ALLOWLIST" > "$ALLOW_PATTERNS"
+
+# Pair every match location with its source line so the allowlist patterns
+# can be written against the offending code instead of line numbers.
+MATCHES=$("$CLANG_QUERY" -p "$BUILD_DIR" -f "$MATCHERS" $AUDITED_FILES 2>/dev/null |
+    awk '/\.(cc|h):[0-9]+:[0-9]+: note/ { loc = $1; getline code; sub(/^[ \t]+/, "", code); print loc " " code }' |
+    sort -u |
+    grep -v -f "$ALLOW_PATTERNS")
+
+if [ -n "$MATCHES" ]
+then
+    echo "copy-audit: by-value Gnss_Synchro copies outside whitelisted sinks:"
+    echo "$MATCHES"
+    echo "copy-audit: pass by reference or move, or whitelist the sink in gnss-sdr-copy-audit.allow"
+    exit 1
+fi
+
+echo "copy-audit: no unexpected Gnss_Synchro copies in the epoch path."
+exit 0
@@ -0,0 +1,107 @@
+/*!
+ * \file tlm_journal_dump.cc
+ * \brief Prints the content of a telemetry event journal file in
+ * chronological order. See tlm_event_journal.h for the file format.
+ * \author Javier Arribas, 2020. jarribas(at)cttc.es
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_event_journal.h"
+#include <algorithm>  // for sort
+#include <cstring>    // for memcmp
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+static const char* event_name(uint8_t event)
+{
+    switch (static_cast<Tlm_Event>(event))
+        {
+        case Tlm_Event::preamble_detected:
+            return "PREAMBLE";
+        case Tlm_Event::frame_sync:
+            return "FRAME_SYNC";
+        case Tlm_Event::frame_sync_lost:
+            return "SYNC_LOST";
+        case Tlm_Event::crc_pass:
+            return "CRC_PASS";
+        case Tlm_Event::crc_fail:
+            return "CRC_FAIL";
+        case Tlm_Event::tow_update:
+            return "TOW_UPDATE";
+        default:
+            return "UNKNOWN";
+        }
+}
+
+
+int main(int argc, char** argv)
+{
+    if (argc != 2)
+        {
+            std::cerr << "Usage: " << argv[0] << " <journal_file>\n";
+            return 1;
+        }
+    std::ifstream file(argv[1], std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        {
+            std::cerr << "Could not open " << argv[1] << '\n';
+            return 1;
+        }
+    Tlm_Journal_Header header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file or std::memcmp(header.magic, "GSTJ", 4) != 0)
+        {
+            std::cerr << argv[1] << " is not a telemetry event journal\n";
+            return 1;
+        }
+    if (header.record_size != sizeof(Tlm_Journal_Record))
+        {
+            std::cerr << "Unsupported record size " << header.record_size << '\n';
+            return 1;
+        }
+    std::vector<Tlm_Journal_Record> records;
+    records.reserve(header.capacity);
+    Tlm_Journal_Record record{};
+    for (uint32_t i = 0; i < header.capacity; i++)
+        {
+            file.read(reinterpret_cast<char*>(&record), sizeof(record));
+            if (!file)
+                {
+                    break;
+                }
+            if (record.seq != 0)  // zero marks an empty or torn slot
+                {
+                    records.push_back(record);
+                }
+        }
+    std::sort(records.begin(), records.end(),
+        [](const Tlm_Journal_Record& a, const Tlm_Journal_Record& b) { return a.seq < b.seq; });
+
+    std::cout << "# journal version " << header.version
+              << ", " << header.total_records << " events recorded, "
+              << records.size() << " available\n";
+    std::cout << "# seq system prn channel sample_counter event value\n";
+    for (const auto& r : records)
+        {
+            std::cout << r.seq << ' '
+                      << r.system << ' '
+                      << r.prn << ' '
+                      << r.channel << ' '
+                      << r.sample_counter << ' '
+                      << event_name(r.event) << ' '
+                      << r.value << '\n';
+        }
+    return 0;
+}